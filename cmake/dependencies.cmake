@@ -11,6 +11,18 @@ install(FILES "${CMAKE_SOURCE_DIR}/cmake/Modules/FindTensorRT.cmake" DESTINATION
 # CUDA
 find_package(CUDAToolkit REQUIRED)
 
+# zstd, for compressed engines
+find_path(ZSTD_INCLUDE_DIR zstd.h)
+find_library(ZSTD_LIBRARY zstd)
+if (NOT ZSTD_INCLUDE_DIR OR NOT ZSTD_LIBRARY)
+    message(FATAL_ERROR "zstd was not found, install it (e.g. libzstd-dev) or point CMAKE_PREFIX_PATH to it")
+endif()
+add_library(zstd::zstd UNKNOWN IMPORTED)
+set_target_properties(zstd::zstd PROPERTIES
+    IMPORTED_LOCATION "${ZSTD_LIBRARY}"
+    INTERFACE_INCLUDE_DIRECTORIES "${ZSTD_INCLUDE_DIR}"
+)
+
 # libtorch
 find_package(Torch REQUIRED)
 find_package(Threads REQUIRED)
@@ -1,6 +1,13 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <cuda_runtime.h>
@@ -8,6 +15,7 @@
 
 #include "ATen/core/function_schema.h"
 #include "ATen/core/jit_type.h"
+#include "c10/cuda/CUDAGuard.h"
 
 #include "torch/csrc/jit/frontend/function_schema_parser.h"
 #include "torch/csrc/jit/ir/ir.h"
@@ -22,6 +30,9 @@
 #include "core/conversion/conversion.h"
 #include "core/lowering/lowering.h"
 #include "core/partitioning/partitioning.h"
+#include "core/partitioning/partitioning_report.h"
+#include "core/partitioning/segment_calibration.h"
+#include "core/runtime/FusedTorchSegment.h"
 #include "core/runtime/runtime.h"
 
 namespace torch_tensorrt {
@@ -30,20 +41,29 @@ namespace core {
 void AddEngineToGraph(
     torch::jit::script::Module mod,
     std::shared_ptr<torch::jit::Graph>& g,
-    const std::string& serialized_engine,
+    const util::SerializedEngine& serialized_engine,
     runtime::RTDevice& device_info,
     const std::vector<std::string>& input_binding_names,
     const std::vector<std::string>& output_binding_names,
     std::string engine_id = "",
-    bool fallback = false) {
+    bool fallback = false,
+    std::shared_ptr<runtime::DeviceMemoryArena> device_memory = nullptr,
+    std::shared_ptr<runtime::CudaGraphPool> cudagraph_pool = nullptr) {
   auto engine_ptr = c10::make_intrusive<runtime::TRTEngine>(
       mod._ivalue()->name() + "_engine_" + engine_id,
       serialized_engine,
       device_info,
       input_binding_names,
       output_binding_names);
+  if (device_memory) {
+    engine_ptr->set_shared_device_memory(device_memory);
+  }
+  if (cudagraph_pool) {
+    engine_ptr->set_cudagraph_pool(cudagraph_pool);
+  }
   // Get required metadata about the engine out
   auto num_io = engine_ptr->num_io;
+  auto num_outputs = engine_ptr->num_outputs();
   auto name = engine_ptr->name;
 
   //..
@@ -99,7 +119,7 @@ void AddEngineToGraph(
   // there being only one tensor, the tensor will be returned, otherwise they
   // are returned as a tuple of tensors. Creates: prim::ListUnpack(<engine
   // output>)
-  auto unpack_node = g->createListUnpack(execute_node->outputs()[0], num_io.second);
+  auto unpack_node = g->createListUnpack(execute_node->outputs()[0], num_outputs);
   g->block()->appendNode(unpack_node);
 
   // If there are multiple output tensors from TensorRT we wrap them in a tuple
@@ -123,9 +143,185 @@ void AddEngineToGraph(
   return;
 }
 
-bool CheckMethodOperatorSupport(const torch::jit::script::Module& mod, std::string method_name) {
-  // Go through Lowering to simplify graph
-  auto graph_and_parameters = lowering::Lower(mod, method_name, lowering::LowerInfo());
+// Replaces the graph of a Torch segment with a call to a FusedTorchSegment holding fused_g, registered on mod
+void AddFusedTorchSegmentToGraph(
+    torch::jit::script::Module mod,
+    partitioning::SegmentedBlock& seg_block,
+    std::shared_ptr<torch::jit::Graph> fused_g,
+    const std::string& segment_id) {
+  auto segment = c10::make_intrusive<runtime::FusedTorchSegment>(
+      mod._ivalue()->name() + "_fused_torch_segment_" + segment_id, fused_g);
+  auto name = segment->name;
+  auto num_inputs = fused_g->inputs().size();
+  auto num_outputs = fused_g->outputs().size();
+  mod.register_attribute(
+      name,
+      c10::getCustomClassType<c10::intrusive_ptr<runtime::FusedTorchSegment>>(),
+      c10::IValue(std::move(segment)),
+      false);
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  auto self = g->addInput("self_1");
+  self->setType(mod.type());
+  auto segment_node = g->appendNode(g->createGetAttr(self, name));
+  std::vector<torch::jit::Value*> inputs;
+  for (size_t i = 0; i < num_inputs; i++) {
+    auto in = g->addInput(std::string("input_") + std::to_string(i));
+    in->setType(c10::TensorType::get());
+    inputs.push_back(in);
+  }
+  auto input_list = g->appendNode(g->createList(c10::TensorType::get(), inputs));
+  auto execute_node = g->appendNode(g->create(
+      c10::Symbol::fromQualString("tensorrt::execute_fused_torch_segment"),
+      {input_list->output(), segment_node->output()},
+      1));
+  execute_node->output()->setType(c10::ListType::ofTensors());
+  auto unpack_node = g->appendNode(g->createListUnpack(execute_node->output(), num_outputs));
+  for (auto out : unpack_node->outputs()) {
+    g->registerOutput(out);
+  }
+  LOG_DEBUG(*g << "(AddFusedTorchSegmentToGraph)\n");
+  seg_block.update_graph(g);
+}
+
+// Places the tensors the TensorRT engines of the stitched graph g pass only to each other in one activation arena,
+// registered on mod
+void AddActivationArenaToGraph(torch::jit::script::Module mod, std::shared_ptr<torch::jit::Graph>& g) {
+  auto name = mod._ivalue()->name() + "_activation_arena";
+  for (size_t n = 1; mod.hasattr(name); n++) {
+    name = mod._ivalue()->name() + "_activation_arena_" + std::to_string(n);
+  }
+  auto plan = partitioning::planSegmentActivations(g, name);
+  if (plan.empty()) {
+    return;
+  }
+  std::vector<runtime::ActivationLifetime> lifetimes;
+  for (auto& a : plan) {
+    lifetimes.push_back({a.step, a.output, a.last_use});
+  }
+  mod.register_attribute(
+      name,
+      c10::getCustomClassType<c10::intrusive_ptr<runtime::SegmentActivationArena>>(),
+      c10::IValue(c10::make_intrusive<runtime::SegmentActivationArena>(name, std::move(lifetimes))),
+      false);
+}
+
+// Everything the lowering passes read from the lower info
+std::string LoweringKey(const std::string& method_name, const lowering::LowerInfo& lower_info) {
+  std::ostringstream key;
+  key << method_name << "\n"
+      << lower_info.unfreeze_module << lower_info.disable_cse << lower_info.converting_to_trt_engine << "\n"
+      << static_cast<int>(lower_info.target_device.device_type) << " " << lower_info.target_device.gpu_id << " "
+      << lower_info.target_device.dla_core << "\n"
+      << lower_info.max_unroll_trip_count << " " << lower_info.max_unroll_body_size << "\n";
+  for (auto& m : lower_info.forced_fallback_modules) {
+    key << m << "\n";
+  }
+  return key.str();
+}
+
+// State of the method and the attributes of mod which freezing folds into the lowered graph, a lowering is only
+// reused while it is unchanged
+std::string ModuleFingerprint(const torch::jit::Module& mod, const std::string& method_name) {
+  std::ostringstream fingerprint;
+  fingerprint << mod.get_method(method_name).graph().get() << "\n";
+  for (const auto& attr : mod.named_attributes(/*recurse=*/true)) {
+    fingerprint << attr.name << " ";
+    if (attr.value.isTensor()) {
+      const auto& t = attr.value.toTensor();
+      fingerprint << t.unsafeGetTensorImpl();
+      // Inference tensors do not track in place updates
+      if (t.defined() && !t.is_inference()) {
+        fingerprint << " " << t._version();
+      }
+    } else if (attr.value.isInt() || attr.value.isDouble() || attr.value.isBool() || attr.value.isString()) {
+      fingerprint << attr.value;
+    }
+    fingerprint << "\n";
+  }
+  return fingerprint.str();
+}
+
+// Lowered graphs of the modules which went through a support check, so that converting or compiling the same module
+// afterwards (as to_backend does from preprocess to compile) does not freeze and lower it again
+class LoweringCache {
+ public:
+  static LoweringCache& Get() {
+    static LoweringCache cache;
+    return cache;
+  }
+
+  // Lowers method_name of mod, or reuses a kept lowering of the same module with the same key. keep leaves the
+  // lowering in the cache for a later conversion, conversions take it out as they only use it once
+  std::pair<std::shared_ptr<torch::jit::Graph>, std::vector<torch::jit::IValue>> lower(
+      const torch::jit::Module& mod,
+      const std::string& method_name,
+      const lowering::LowerInfo& lower_info,
+      bool keep) {
+    auto key = LoweringKey(method_name, lower_info);
+    auto fingerprint = ModuleFingerprint(mod, method_name);
+    {
+      std::lock_guard<std::mutex> lock(mu);
+      // Entries of destroyed modules are dropped, their address may be reused by a new module
+      entries.erase(
+          std::remove_if(entries.begin(), entries.end(), [](const Entry& e) { return e.module.expired(); }),
+          entries.end());
+      for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (it->module._unsafe_get_target() != mod._ivalue().get() || it->key != key) {
+          continue;
+        }
+        if (it->fingerprint != fingerprint) {
+          LOG_DEBUG("The module changed since " << method_name << " was lowered, lowering it again");
+          entries.erase(it);
+          break;
+        }
+        LOG_DEBUG("Reusing the lowered graph of " << method_name << " from its support check");
+        auto lowered = std::make_pair(it->lowering.first->copy(), it->lowering.second);
+        if (!keep) {
+          entries.erase(it);
+        }
+        return lowered;
+      }
+    }
+
+    // Loops are only unrolled if their whole body converts
+    auto info = lower_info;
+    if (!info.unroll_node_supported) {
+      info.unroll_node_supported = [](const torch::jit::Node* n) { return conversion::OpSupported(n); };
+    }
+    auto lowered = lowering::Lower(mod, method_name, info);
+    if (keep) {
+      std::lock_guard<std::mutex> lock(mu);
+      if (entries.size() == kMaxEntries) {
+        entries.erase(entries.begin());
+      }
+      entries.push_back({c10::weak_intrusive_ptr<c10::ivalue::Object>(mod._ivalue()), key, fingerprint, lowered});
+      return {lowered.first->copy(), lowered.second};
+    }
+    return lowered;
+  }
+
+ private:
+  struct Entry {
+    c10::weak_intrusive_ptr<c10::ivalue::Object> module;
+    std::string key;
+    std::string fingerprint;
+    std::pair<std::shared_ptr<torch::jit::Graph>, std::vector<torch::jit::IValue>> lowering;
+  };
+
+  // Lowerings hold their folded weights, so only the most recent support checks are kept
+  static constexpr size_t kMaxEntries = 4;
+  std::mutex mu;
+  std::vector<Entry> entries;
+};
+
+bool CheckMethodOperatorSupport(
+    const torch::jit::script::Module& mod,
+    std::string method_name,
+    const lowering::LowerInfo& lower_info) {
+  util::logging::ScopedLogger log_scope;
+  // Go through Lowering to simplify graph, kept for a following conversion of the module
+  auto graph_and_parameters = LoweringCache::Get().lower(mod, method_name, lower_info, /*keep=*/true);
 
   auto g = graph_and_parameters.first;
   LOG_DEBUG(*g << "(CheckMethodOperatorSupport)\n");
@@ -133,57 +329,394 @@ bool CheckMethodOperatorSupport(const torch::jit::script::Module& mod, std::stri
   return conversion::VerifyConverterSupportForBlock(g->block());
 }
 
-partitioning::GraphAndMapping BuildHybridGraph(
-    torch::jit::script::Module& new_mod,
+struct EngineBuild {
+  // Segment the engine is built for, nullptr if it is built for the whole graph
+  partitioning::SegmentedBlock* seg_block;
+  torch::jit::Block* block;
+  conversion::ConversionInfo convert_info;
+  util::SerializedEngine engine;
+  // EngineCacheKey of the build, stable across compilations of unchanged segments
+  std::string fingerprint = "";
+};
+
+// Device the engine of a module targeting device runs on, gpu_id is the GPU of the target device
+runtime::RTDevice ToRTDevice(int64_t gpu_id, const ir::Device& device) {
+  auto cuda_device = runtime::RTDevice(gpu_id, device.device_type);
+  if (device.device_type == nvinfer1::DeviceType::kDLA) {
+    cuda_device.dla_core = device.dla_core;
+  }
+  return cuda_device;
+}
+
+// GPU the engine of a build runs on. Builds spread over build_gpu_ids have the GPU of their settings overwritten with
+// the build GPU, their engines run on the target GPU
+int64_t PlacedGPU(const CompileSpec& cfg, const EngineBuild& build) {
+  return cfg.build_gpu_ids.empty() ? build.convert_info.engine_settings.device.gpu_id
+                                   : cfg.convert_info.engine_settings.device.gpu_id;
+}
+
+// Engines are only portable between GPUs of the same model
+void CheckSameGPUModel(int64_t target_gpu, int64_t gpu, const std::string& role) {
+  cudaDeviceProp target_prop;
+  TORCHTRT_CHECK(
+      cudaGetDeviceProperties(&target_prop, target_gpu) == cudaSuccess,
+      "Unable to query the properties of GPU " << target_gpu);
+  cudaDeviceProp prop;
+  TORCHTRT_CHECK(
+      cudaGetDeviceProperties(&prop, gpu) == cudaSuccess, "Unable to query the properties of " << role << " " << gpu);
+  TORCHTRT_CHECK(
+      std::string(prop.name) == target_prop.name && prop.major == target_prop.major && prop.minor == target_prop.minor,
+      role << " " << gpu << " (" << prop.name << ") is not the same model as the target GPU " << target_gpu << " ("
+           << target_prop.name << ")");
+}
+
+// Segments can be placed on the DLA cores of the target device, which share its memory, and on other GPUs of the same
+// model as pipeline stages
+void CheckSegmentDevices(const CompileSpec& cfg) {
+  auto& target = cfg.convert_info.engine_settings.device;
+  auto& segment_devices = cfg.partitioning_info.segment_devices;
+  bool mixed_devices = false;
+  bool other_gpus = false;
+  for (auto& d : segment_devices) {
+    if (d.gpu_id != target.gpu_id) {
+      TORCHTRT_CHECK(
+          d.device_type == nvinfer1::DeviceType::kGPU && target.device_type == nvinfer1::DeviceType::kGPU,
+          "Segments can only be placed on the DLA cores of the target GPU " << target.gpu_id << ", found a DLA core "
+                                                                            << "of GPU " << d.gpu_id);
+      CheckSameGPUModel(target.gpu_id, d.gpu_id, "Segment GPU");
+      other_gpus = true;
+    }
+    TORCHTRT_CHECK(
+        d.device_type == nvinfer1::DeviceType::kGPU || cfg.build_gpu_ids.empty(),
+        "build_gpu_ids cannot be used when segments are placed on a DLA core");
+    mixed_devices |= d.device_type != target.device_type || d.dla_core != target.dla_core;
+  }
+  if (other_gpus) {
+    TORCHTRT_CHECK(cfg.build_gpu_ids.empty(), "build_gpu_ids cannot be used when segments are placed on other GPUs");
+    TORCHTRT_CHECK(
+        !cfg.share_device_memory && !cfg.share_cudagraph_pool,
+        "Segments placed on other GPUs cannot share a device memory arena or CUDA graph pool with the target GPU");
+    if (!runtime::get_multi_device_safe_mode()) {
+      LOG_WARNING(
+          "Segments are placed on other GPUs but multi device safe mode is off, enable it so the engines of each stage "
+          << "switch to their GPU at runtime");
+    }
+  }
+  if (mixed_devices && cfg.share_device_memory) {
+    LOG_WARNING(
+        "Segments placed on different devices share one device memory arena, so the segments of consecutive "
+        << "executions cannot overlap");
+  }
+}
+
+// Engines are only portable between GPUs of the same model, so every GPU builds are spread across has to match the
+// target device
+void CheckBuildDevices(const CompileSpec& cfg) {
+  auto target = cfg.convert_info.engine_settings.device;
+  TORCHTRT_CHECK(
+      target.device_type == nvinfer1::DeviceType::kGPU, "build_gpu_ids is only supported when targeting a GPU");
+  for (auto id : cfg.build_gpu_ids) {
+    CheckSameGPUModel(target.gpu_id, id, "Build GPU");
+  }
+}
+
+// Engines built for DLA standalone are loadables which TensorRT cannot deserialize, they are marked so the runtime
+// executes them through cuDLA
+util::SerializedEngine MarkDLALoadable(util::SerializedEngine engine, const conversion::BuilderSettings& settings) {
+  if (settings.capability != TRT_ENGINE_CAPABILITY_DLA_STANDALONE) {
+    return engine;
+  }
+  return util::SerializedEngine(runtime::wrap_dla_loadable(engine.data(), engine.size()));
+}
+
+// Caps the workspace of an engine at its share of device_memory_budget, the only part of the memory of an engine the
+// builder can be bounded by. Its tactics are selected under that limit, steering it toward lower memory kernels
+void ApplyDeviceMemoryBudget(conversion::BuilderSettings& settings, uint64_t share, const CompileSpec& cfg) {
+  settings.workspace_size = settings.workspace_size == 0 ? share : std::min(settings.workspace_size, share);
+  if (cfg.device_memory_report) {
+    cfg.device_memory_report->engines.push_back({static_cast<int64_t>(share)});
+  }
+}
+
+// Splits device_memory_budget across the TensorRT segments in proportion to the estimated memory of their activations.
+// Segments sharing one device memory arena run one at a time, so each of them can use all of it
+void SplitDeviceMemoryBudget(std::vector<EngineBuild>& builds, const CompileSpec& cfg) {
+  if (cfg.device_memory_budget == 0 || builds.empty()) {
+    return;
+  }
+  std::vector<double> sizes;
+  double total = 0;
+  for (auto& build : builds) {
+    // Segments whose activations cannot be estimated still get a share
+    sizes.push_back(std::max<double>(partitioning::estimateActivationBytes(*build.seg_block), 1));
+    total += sizes.back();
+  }
+  for (size_t i = 0; i < builds.size(); i++) {
+    auto share = cfg.share_device_memory
+        ? cfg.device_memory_budget
+        : std::max<uint64_t>(static_cast<uint64_t>(cfg.device_memory_budget * (sizes[i] / total)), 1);
+    ApplyDeviceMemoryBudget(builds[i].convert_info.engine_settings, share, cfg);
+    LOG_INFO("TensorRT segment " << i << " is budgeted " << share << " bytes of device memory");
+  }
+}
+
+// Compares the device memory the execution contexts of the engines of the module need to device_memory_budget
+void ReportDeviceMemoryBudget(const torch::jit::Module& mod, const CompileSpec& cfg) {
+  auto& report = *cfg.device_memory_report;
+  report.budget = static_cast<int64_t>(cfg.device_memory_budget);
+  report.shared = cfg.share_device_memory && report.engines.size() > 1;
+  auto engines = runtime::collect_engines(mod);
+  if (engines.size() != report.engines.size()) {
+    // Engines built in the background are only measured once they are all built
+    LOG_WARNING(
+        "Only " << engines.size() << " of " << report.engines.size() << " TensorRT engines are built, the device "
+                << "memory they need cannot be checked against the budget");
+    return;
+  }
+  report.device_memory = 0;
+  for (size_t i = 0; i < engines.size(); i++) {
+    auto& engine = engines[i];
+    // DLA loadables run out of the memory of their DLA core
+    int64_t size = 0;
+    if (engine->is_engine_loaded() && !engine->dla_loadable) {
+      size = engine->cuda_engine->getDeviceMemorySizeV2();
+    }
+    report.engines[i].device_memory = size;
+    report.device_memory = report.shared ? std::max(report.device_memory, size) : report.device_memory + size;
+  }
+  report.met = report.device_memory <= report.budget;
+  if (report.met) {
+    LOG_INFO(
+        "TensorRT engines need " << report.device_memory << " bytes of device memory, within the budget of "
+                                 << report.budget << " bytes");
+  } else {
+    LOG_WARNING(
+        "TensorRT engines need " << report.device_memory << " bytes of device memory, over the budget of "
+                                 << report.budget << " bytes. Activation memory cannot be bounded, lower the "
+                                 << "batch size or max input shapes, or share the device memory of the segments");
+  }
+}
+
+// Builds the engines of independent segments on a bounded pool of workers. Each worker runs its own builder, worker w
+// builds on build_gpu_ids[w % build_gpu_ids.size()] if any are given. on_built is called with the index of each build
+// as soon as its engine is built, on the worker that built it
+void BuildEngines(
+    std::vector<EngineBuild>& builds,
+    const CompileSpec& cfg,
+    ir::StaticParams& static_params,
+    const std::function<void(size_t)>& on_built = nullptr) {
+  if (builds.empty()) {
+    return;
+  }
+  if (!cfg.build_gpu_ids.empty()) {
+    CheckBuildDevices(cfg);
+  }
+
+  size_t num_workers =
+      cfg.num_build_workers > 0 ? static_cast<size_t>(cfg.num_build_workers) : std::thread::hardware_concurrency();
+  num_workers = std::max<size_t>(1, std::min(num_workers, builds.size()));
+  LOG_DEBUG("Building " << builds.size() << " TensorRT engines on " << num_workers << " threads");
+
+  // Worker 0 runs on this thread, the device guards of the workers give it its device back
+  auto& logger = util::logging::get_logger();
+  std::atomic<size_t> next = {0};
+  std::vector<std::exception_ptr> errors(num_workers);
+  auto worker = [&](size_t worker_id) {
+    util::logging::ScopedLogger log_scope(logger);
+    c10::cuda::OptionalCUDAGuard device_guard;
+    try {
+      c10::optional<int64_t> build_gpu_id;
+      if (!cfg.build_gpu_ids.empty()) {
+        build_gpu_id = cfg.build_gpu_ids[worker_id % cfg.build_gpu_ids.size()];
+        device_guard.set_index(static_cast<c10::DeviceIndex>(build_gpu_id.value()));
+      }
+      for (size_t i = next++; i < builds.size(); i = next++) {
+        auto& build = builds[i];
+        util::CompileProfileScope profile_scope(cfg.profiler.get(), "segment_" + std::to_string(i));
+        // Keyed by the target device, the build GPUs are the same model so the engine is the same
+        build.fingerprint = conversion::EngineCacheKey(
+            build.block,
+            build.convert_info.engine_settings,
+            build.convert_info.inputs,
+            build.convert_info.collection_input_spec_map,
+            static_params);
+        if (build_gpu_id) {
+          build.convert_info.engine_settings.device.gpu_id = build_gpu_id.value();
+        } else {
+          // Segments placed on other GPUs are built there
+          device_guard.set_index(static_cast<c10::DeviceIndex>(build.convert_info.engine_settings.device.gpu_id));
+        }
+        build.engine = MarkDLALoadable(
+            conversion::ConvertBlockToEngine(build.block, build.convert_info, static_params, build.fingerprint),
+            build.convert_info.engine_settings);
+        if (on_built) {
+          on_built(i);
+        }
+      }
+    } catch (...) {
+      errors[worker_id] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t w = 1; w < num_workers; w++) {
+    threads.emplace_back(worker, w);
+  }
+  worker(0);
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (auto& e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+}
+
+// Partitions the block of partitioning_ctx into TensorRT and Torch segments and returns the TensorRT segments in
+// order, each with the conversion info it is built with
+// Minimum rank of a tensor in a channel last format, which needs the channels and two (three for DHWC8) spatial dims
+int32_t MinRankOfFormat(nvinfer1::TensorFormat format) {
+  return format == nvinfer1::TensorFormat::kDHWC8 ? 4 : 3;
+}
+
+bool CanUseFormat(const ir::Input& spec, nvinfer1::TensorFormat format) {
+  auto rank = spec.input_shape.nbDims;
+  if (rank < MinRankOfFormat(format) ||
+      !ir::valid_dtype_format_combo(util::ScalarTypeToTRTDataType(spec.dtype), format)) {
+    return false;
+  }
+  // The channels are padded to a multiple of the vector width, which requires a static channel count
+  auto channel_dim = rank - MinRankOfFormat(format);
+  return spec.input_shape.d[channel_dim] > 0 && spec.min.d[channel_dim] == spec.max.d[channel_dim];
+}
+
+// Picks the formats the TensorRT segments of block exchange their inputs and outputs in. Outputs of the block keep the
+// formats the user asked for, tensors passed from one TensorRT segment to another use the segment boundary format, so
+// the consuming engine binds the strided output of the producing engine without either of them reformatting it
+void AssignSegmentFormats(
+    std::vector<EngineBuild>& builds,
+    size_t first,
     torch::jit::Block* block,
-    CompileSpec cfg,
-    ir::StaticParams static_params,
+    const CompileSpec& cfg) {
+  const auto& user_formats = cfg.convert_info.engine_settings.output_formats;
+  std::unordered_map<const torch::jit::Value*, nvinfer1::TensorFormat> block_output_formats;
+  for (size_t i = 0; i < block->outputs().size() && i < user_formats.size(); i++) {
+    block_output_formats[block->outputs()[i]] = user_formats[i];
+  }
+
+  // Build and output index of the values computed by the TensorRT segments
+  std::unordered_map<const torch::jit::Value*, std::pair<size_t, size_t>> producers;
+  for (size_t b = first; b < builds.size(); b++) {
+    auto& settings = builds[b].convert_info.engine_settings;
+    const auto& raw_outputs = builds[b].seg_block->raw_outputs();
+    settings.output_formats.assign(raw_outputs.size(), nvinfer1::TensorFormat::kLINEAR);
+    for (size_t o = 0; o < raw_outputs.size(); o++) {
+      producers[raw_outputs[o]] = {b, o};
+      auto user_format = block_output_formats.find(raw_outputs[o]);
+      if (user_format != block_output_formats.end()) {
+        settings.output_formats[o] = user_format->second;
+      }
+    }
+  }
+
+  auto format = cfg.segment_boundary_format;
+  if (format == nvinfer1::TensorFormat::kLINEAR) {
+    return;
+  }
+  for (size_t b = first; b < builds.size(); b++) {
+    const auto& raw_inputs = builds[b].seg_block->raw_inputs();
+    for (size_t i = 0; i < raw_inputs.size(); i++) {
+      auto producer = producers.find(raw_inputs[i]);
+      if (producer == producers.end() || block_output_formats.count(raw_inputs[i])) {
+        continue;
+      }
+      auto spec = builds[b].convert_info.inputs.find(builds[b].seg_block->inputs()[i]);
+      if (spec == builds[b].convert_info.inputs.end() || !CanUseFormat(spec->second, format)) {
+        continue;
+      }
+      spec->second.format = format;
+      auto& producer_settings = builds[producer->second.first].convert_info.engine_settings;
+      producer_settings.output_formats[producer->second.second] = format;
+      LOG_DEBUG(
+          "Passing " << raw_inputs[i]->debugName() << " between TensorRT segments in format " << format
+                     << " (AssignSegmentFormats)");
+    }
+  }
+}
+
+std::vector<EngineBuild> PartitionTensorRTSegments(
+    partitioning::PartitioningCtx* partitioning_ctx,
+    const CompileSpec& cfg,
+    ir::StaticParams& static_params,
     ir::CollectionTypeMap first_use_types,
-    bool expect_full_compilation = false) {
+    bool expect_full_compilation) {
   auto convert_info = cfg.convert_info;
-  auto partitioning_info = cfg.partitioning_info;
+  CheckSegmentDevices(cfg);
+  auto& segment_devices = cfg.partitioning_info.segment_devices;
+  size_t num_placed_segments = 0;
 
-  auto partitioning_ctx = partitioning::PartitioningCtx(block, partitioning_info);
-  partitioning_ctx.input_types_map = first_use_types;
+  for (auto& in : convert_info.collection_input_spec_map) {
+    for (auto& spec : in.second) {
+      if (spec.num_profiles() > 1) {
+        LOG_WARNING(
+            "Input " << in.first->debugName() << " describes multiple optimization profiles, TensorRT segments of "
+                     << "partitioned graphs are only built for its primary (min, opt, max) range");
+      }
+    }
+  }
+
+  partitioning_ctx->input_types_map = first_use_types;
 
   // Generate a dictionary of input torch::jit::Value's to their min, opt, max tensors and store in ctx
   // TODO: Combine this within partition call
-  partitioning::populateInputIValues(&partitioning_ctx);
-
-  partitioning::partition(&partitioning_ctx, expect_full_compilation);
+  partitioning::populateInputIValues(partitioning_ctx);
+
+  partitioning::partition(partitioning_ctx, expect_full_compilation);
+  partitioning::eliminateBoundaryCasts(partitioning_ctx);
+  if (cfg.partitioning_info.share_segment_weights) {
+    // The weights of refittable engines have to be part of the engines to be refit
+    if (cfg.convert_info.engine_settings.refit) {
+      LOG_WARNING("share_segment_weights is ignored for refittable engines, each engine keeps its own weights");
+    } else {
+      partitioning::shareSegmentWeights(partitioning_ctx);
+    }
+  }
+  if (!cfg.partitioning_info.report_path.empty()) {
+    partitioning::writePartitioningReport(
+        partitioning::generatePartitioningReport(partitioning_ctx), cfg.partitioning_info.report_path);
+  }
 
-  for (auto& partitioned_block : partitioning_ctx.partitioned_blocks) {
+  std::vector<EngineBuild> builds;
+  for (auto& partitioned_block : partitioning_ctx->partitioned_blocks) {
     partitioning::PartitionedGraph& segmented_blocks = partitioned_block.second;
+    auto first_build = builds.size();
     int num_torch_segments = 0;
     int num_trt_segments = 0;
 
     for (auto& seg_block : segmented_blocks) {
       LOG_INFO("Block segment:" << seg_block);
-      std::ostringstream trt_engine_id;
-      trt_engine_id << reinterpret_cast<const int*>(&seg_block);
 
       if (seg_block.target() == partitioning::SegmentedBlock::kTensorRT) {
         num_trt_segments++;
         auto inputs = seg_block.construct_inputs_spec();
         // update the input ranges for each segments
         convert_info.inputs = ir::associate_specs_with_inputs(seg_block.g(), inputs, static_params);
+        // Only the order of the segments of the top level block is well defined for placement
+        convert_info.engine_settings.device = cfg.convert_info.engine_settings.device;
+        if (partitioned_block.first == partitioning_ctx->original_blocks.front() &&
+            num_placed_segments < segment_devices.size()) {
+          auto& device = segment_devices[num_placed_segments++];
+          convert_info.engine_settings.device = device;
+          if (device.device_type == nvinfer1::DeviceType::kDLA) {
+            LOG_INFO("Placing TensorRT segment " << num_placed_segments - 1 << " on DLA core " << device.dla_core);
+          } else {
+            LOG_INFO("Placing TensorRT segment " << num_placed_segments - 1 << " on GPU " << device.gpu_id);
+          }
+        }
 
         // TODO mapping Inputs Ivalue to flatten one here
-        auto engine = conversion::ConvertBlockToEngine(seg_block.block(), convert_info, static_params);
-        auto temp_g = std::make_shared<torch::jit::Graph>();
-        auto device_spec = convert_info.engine_settings.device;
-        auto cuda_device = runtime::RTDevice(device_spec.gpu_id, device_spec.device_type);
-        AddEngineToGraph(
-            new_mod,
-            temp_g,
-            engine,
-            cuda_device,
-            std::vector<std::string>(),
-            std::vector<std::string>(),
-            trt_engine_id.str(),
-            true);
-
-        seg_block.update_graph(temp_g);
+        builds.push_back({&seg_block, seg_block.block(), convert_info, ""});
       } else {
         num_torch_segments++;
 
@@ -210,9 +743,365 @@ partitioning::GraphAndMapping BuildHybridGraph(
           "Full compilation was requested but unable to convert all operations to TensorRT."
           << " Try recompiling with require_full_compilation=False.");
     }
+
+    AssignSegmentFormats(builds, first_build, partitioned_block.first, cfg);
   }
 
-  return partitioning::stitch(&partitioning_ctx, block);
+  if (num_placed_segments < segment_devices.size()) {
+    LOG_WARNING(
+        segment_devices.size() << " segment devices were given but the graph only has " << num_placed_segments
+                               << " TensorRT segments in its top level block, the remaining devices are unused");
+  }
+  return builds;
+}
+
+// Partitions the block like a compilation would, including shape analysis, and reports the segments without converting
+// them. Fully supported graphs are partitioned too, into the TensorRT segment they would be built as
+partitioning::PartitioningReport DryRunPartition(
+    torch::jit::Block* block,
+    CompileSpec cfg,
+    ir::StaticParams& static_params,
+    ir::CollectionTypeMap first_use_types,
+    bool expect_full_compilation) {
+  cfg.partitioning_info.enabled = true;
+  cfg.partitioning_info.report_path = "";
+  auto partitioning_ctx = partitioning::PartitioningCtx(block, cfg.partitioning_info);
+  PartitionTensorRTSegments(&partitioning_ctx, cfg, static_params, first_use_types, expect_full_compilation);
+  auto report = partitioning::generatePartitioningReport(&partitioning_ctx);
+
+  size_t num_trt_segments = 0;
+  size_t num_torch_segments = 0;
+  int64_t weight_bytes = 0;
+  for (const auto& b : report.blocks) {
+    for (const auto& seg : b.segments) {
+      if (seg.target == partitioning::SegmentedBlock::kTensorRT) {
+        num_trt_segments++;
+      } else {
+        num_torch_segments++;
+      }
+      weight_bytes += seg.weight_bytes;
+    }
+  }
+  LOG_INFO(
+      "Dry run: " << num_trt_segments << " TensorRT and " << num_torch_segments << " Torch segments, "
+                  << report.boundary_bytes << "B crossing their boundaries, " << weight_bytes
+                  << "B of weights in the engines");
+  return report;
+}
+
+// Replaces the graph of the segment of each build with a DeferredEngineSegment running its Torch graph, registered on
+// mod, then builds the engines on a background thread. Each segment switches to its engine as soon as it is built,
+// segments whose build fails keep running in Torch
+void StartBackgroundBuild(
+    torch::jit::script::Module mod,
+    std::vector<EngineBuild> builds,
+    CompileSpec cfg,
+    ir::StaticParams static_params,
+    std::shared_ptr<runtime::DeviceMemoryArena> device_memory,
+    std::shared_ptr<runtime::CudaGraphPool> cudagraph_pool) {
+  auto mod_name = mod._ivalue()->name();
+  std::vector<c10::intrusive_ptr<runtime::DeferredEngineSegment>> segments;
+  // The builds convert the original graphs of the segments, which are kept alive once they are replaced
+  std::vector<std::shared_ptr<torch::jit::Graph>> segment_graphs;
+  for (auto& build : builds) {
+    auto& seg_block = *build.seg_block;
+    auto name = mod_name + "_deferred_engine_" + std::to_string(segments.size());
+    for (size_t n = 1; mod.hasattr(name); n++) {
+      name = mod_name + "_deferred_engine_" + std::to_string(segments.size()) + "_" + std::to_string(n);
+    }
+    auto segment = c10::make_intrusive<runtime::DeferredEngineSegment>(name, seg_block.g()->copy());
+    auto num_inputs = seg_block.g()->inputs().size();
+    auto num_outputs = seg_block.g()->outputs().size();
+    mod.register_attribute(
+        name,
+        c10::getCustomClassType<c10::intrusive_ptr<runtime::DeferredEngineSegment>>(),
+        c10::IValue(segment),
+        false);
+
+    auto g = std::make_shared<torch::jit::Graph>();
+    auto self = g->addInput("self_1");
+    self->setType(mod.type());
+    auto segment_node = g->appendNode(g->createGetAttr(self, name));
+    std::vector<torch::jit::Value*> inputs;
+    for (size_t i = 0; i < num_inputs; i++) {
+      auto in = g->addInput(std::string("input_") + std::to_string(i));
+      in->setType(c10::TensorType::get());
+      inputs.push_back(in);
+    }
+    auto input_list = g->appendNode(g->createList(c10::TensorType::get(), inputs));
+    auto execute_node = g->appendNode(g->create(
+        c10::Symbol::fromQualString("tensorrt::execute_deferred_engine_segment"),
+        {input_list->output(), segment_node->output()},
+        1));
+    execute_node->output()->setType(c10::ListType::ofTensors());
+    auto unpack_node = g->appendNode(g->createListUnpack(execute_node->output(), num_outputs));
+    for (auto out : unpack_node->outputs()) {
+      g->registerOutput(out);
+    }
+    LOG_DEBUG(*g << "(StartBackgroundBuild)\n");
+
+    segment_graphs.push_back(seg_block.g());
+    seg_block.update_graph(g);
+    build.seg_block = nullptr;
+    segments.push_back(segment);
+  }
+  // Phases of the background build are not part of the compilation the profiler records
+  cfg.profiler = nullptr;
+  LOG_INFO(
+      "Building " << builds.size() << " TensorRT engines in the background, their segments run in Torch until then");
+
+  // The background thread outlives the compilation and its logger, it logs with a copy of it
+  std::thread([mod_name,
+               logger = util::logging::get_logger(),
+               builds = std::move(builds),
+               cfg = std::move(cfg),
+               static_params = std::move(static_params),
+               device_memory = std::move(device_memory),
+               cudagraph_pool = std::move(cudagraph_pool),
+               segments = std::move(segments),
+               segment_graphs = std::move(segment_graphs)]() mutable {
+    util::logging::ScopedLogger log_scope(logger);
+    auto device_spec = cfg.convert_info.engine_settings.device;
+    std::vector<char> built(builds.size(), 0);
+    std::string error = "an earlier build on the same worker failed";
+    try {
+      c10::cuda::CUDAGuard device_guard(static_cast<c10::DeviceIndex>(device_spec.gpu_id));
+      BuildEngines(builds, cfg, static_params, [&](size_t i) {
+        auto& build = builds[i];
+        auto cuda_device = ToRTDevice(PlacedGPU(cfg, build), build.convert_info.engine_settings.device);
+        auto engine = c10::make_intrusive<runtime::TRTEngine>(
+            mod_name + "_engine_" + build.fingerprint,
+            build.engine,
+            cuda_device,
+            std::vector<std::string>(),
+            std::vector<std::string>());
+        engine->weights_stripped = build.convert_info.engine_settings.strip_weights;
+        if (device_memory) {
+          engine->set_shared_device_memory(device_memory);
+        }
+        if (cudagraph_pool) {
+          engine->set_cudagraph_pool(cudagraph_pool);
+        }
+        build.engine = util::SerializedEngine();
+        segments[i]->set_engine(std::move(engine));
+        built[i] = 1;
+      });
+    } catch (const std::exception& e) {
+      error = e.what();
+    }
+    for (size_t i = 0; i < segments.size(); i++) {
+      if (!built[i]) {
+        segments[i]->set_build_failed(error);
+      }
+    }
+    if (cfg.convert_info.engine_settings.timing_cache) {
+      cfg.convert_info.engine_settings.timing_cache->save();
+    }
+    if (cfg.convert_info.engine_settings.tactic_record) {
+      cfg.convert_info.engine_settings.tactic_record->save();
+    }
+  }).detach();
+}
+
+// Drops the tensors of the constants and static params feeding segment_nodes which are only used by nodes of built
+// TensorRT segments, their engines hold their own copy of the weights. Constants keep an empty tensor of the same
+// type, except for shared_weights the engines read from the stitched graph. Returns the size of the tensors let go of,
+// their memory is only freed if nothing else holds them
+size_t ReleaseBuiltWeights(
+    const std::vector<torch::jit::Node*>& segment_nodes,
+    const std::unordered_set<torch::jit::Node*>& built_nodes,
+    const std::unordered_set<torch::jit::Value*>& shared_weights,
+    ir::StaticParams& static_params) {
+  auto only_used_by_built = [&](torch::jit::Value* v) {
+    for (auto use : v->uses()) {
+      if (!built_nodes.count(use.user)) {
+        return false;
+      }
+    }
+    return true;
+  };
+  size_t released = 0;
+  for (auto n : segment_nodes) {
+    for (auto in : n->inputs()) {
+      auto producer = in->node();
+      if (producer->kind() == torch::jit::prim::Constant && producer->hasAttribute(torch::jit::attr::value) &&
+          producer->kindOf(torch::jit::attr::value) == torch::jit::AttributeKind::t) {
+        auto t = producer->t(torch::jit::attr::value);
+        if (t.numel() > 0 && !shared_weights.count(in) && only_used_by_built(in)) {
+          released += t.nbytes();
+          producer->t_(torch::jit::attr::value, at::empty({0}, t.options()));
+        }
+        continue;
+      }
+      auto param = static_params.find(in);
+      if (param != static_params.end() && param->second.isTensor() && only_used_by_built(in)) {
+        released += param->second.toTensor().nbytes();
+        static_params.erase(param);
+      }
+    }
+  }
+  return released;
+}
+
+partitioning::GraphAndMapping BuildHybridGraph(
+    torch::jit::script::Module& new_mod,
+    torch::jit::Block* block,
+    CompileSpec cfg,
+    ir::StaticParams& static_params,
+    ir::CollectionTypeMap first_use_types,
+    bool expect_full_compilation = false) {
+  if (cfg.background_build) {
+    TORCHTRT_CHECK(
+        !cfg.shared_segment_calibration, "background_build cannot be combined with shared_segment_calibration");
+    // A segment still running in Torch would hand its neighbours linear tensors
+    if (cfg.segment_boundary_format != nvinfer1::TensorFormat::kLINEAR) {
+      LOG_WARNING("TensorRT segments built in the background pass linear tensors to each other");
+      cfg.segment_boundary_format = nvinfer1::TensorFormat::kLINEAR;
+    }
+    // The segments run their Torch graphs, and so need their weights, until their engines are built
+    if (cfg.low_memory) {
+      LOG_WARNING("low_memory is ignored for TensorRT segments built in the background");
+      cfg.low_memory = false;
+    }
+  }
+  if (cfg.low_memory) {
+    // Only one segment's host copies of its weights exist at a time
+    cfg.num_build_workers = 1;
+  }
+  auto partitioning_ctx = partitioning::PartitioningCtx(block, cfg.partitioning_info);
+  auto builds =
+      PartitionTensorRTSegments(&partitioning_ctx, cfg, static_params, first_use_types, expect_full_compilation);
+  SplitDeviceMemoryBudget(builds, cfg);
+
+  // TensorRT segments of the hybrid graph run strictly one after another, so they can share their scratch memory
+  std::shared_ptr<runtime::DeviceMemoryArena> device_memory = nullptr;
+  if (cfg.share_device_memory && cfg.partitioning_info.concurrent_segment_streams > 1) {
+    LOG_WARNING(
+        "TensorRT segments scheduled on concurrent streams share one device memory arena, so they still run one after "
+        << "another");
+  }
+  if (cfg.share_device_memory) {
+    device_memory = std::make_shared<runtime::DeviceMemoryArena>(cfg.convert_info.engine_settings.device.gpu_id);
+  }
+  // For the same reason the persistent buffers of their CUDA graphs can alias each other
+  std::shared_ptr<runtime::CudaGraphPool> cudagraph_pool = nullptr;
+  if (cfg.share_cudagraph_pool) {
+    cudagraph_pool = std::make_shared<runtime::CudaGraphPool>(cfg.convert_info.engine_settings.device.gpu_id);
+  }
+
+  // Every TensorRT segment is calibrated from one pass of the calibration data over the hybrid graph
+  std::unique_ptr<partitioning::SharedSegmentCalibration> shared_calibration = nullptr;
+  if (cfg.shared_segment_calibration && cfg.convert_info.engine_settings.calibrator) {
+    std::vector<partitioning::SegmentedBlock*> trt_segments;
+    std::vector<std::vector<at::ScalarType>> input_types;
+    for (auto& build : builds) {
+      trt_segments.push_back(build.seg_block);
+      std::vector<at::ScalarType> types;
+      for (auto in : build.seg_block->g()->inputs()) {
+        auto spec = build.convert_info.inputs.find(in);
+        if (spec != build.convert_info.inputs.end()) {
+          types.push_back(spec->second.dtype);
+        }
+      }
+      input_types.push_back(types);
+    }
+    shared_calibration = partitioning::SharedSegmentCalibration::create(
+        cfg.convert_info.engine_settings.calibrator, &partitioning_ctx, block, trt_segments, input_types);
+    if (shared_calibration) {
+      for (size_t i = 0; i < builds.size(); i++) {
+        builds[i].convert_info.engine_settings.calibrator = shared_calibration->calibrator(i);
+      }
+    }
+  }
+
+  // Engines are added to the module in segment order regardless of the order they finished building in. Each keeps the
+  // device it was placed on, the GPU it was built on may differ when build_gpu_ids are given. Engines are named after
+  // the fingerprint of their segment so that later compilations can find the engines of unchanged segments in this
+  // module (see CompileSpec::previous_module)
+  auto add_engine = [&](EngineBuild& build) {
+    auto cuda_device = ToRTDevice(PlacedGPU(cfg, build), build.convert_info.engine_settings.device);
+    std::string engine_id = build.fingerprint;
+    for (size_t n = 1; new_mod.hasattr(new_mod._ivalue()->name() + "_engine_" + engine_id); n++) {
+      engine_id = build.fingerprint + "_" + std::to_string(n);
+    }
+    auto temp_g = std::make_shared<torch::jit::Graph>();
+    AddEngineToGraph(
+        new_mod,
+        temp_g,
+        build.engine,
+        cuda_device,
+        std::vector<std::string>(),
+        std::vector<std::string>(),
+        engine_id,
+        true,
+        device_memory,
+        cudagraph_pool);
+    // The plan is only held on to by the TRTEngine from here on
+    build.engine = util::SerializedEngine();
+
+    build.seg_block->update_graph(temp_g);
+  };
+
+  auto device_spec = cfg.convert_info.engine_settings.device;
+  if (cfg.background_build) {
+    StartBackgroundBuild(new_mod, std::move(builds), cfg, static_params, device_memory, cudagraph_pool);
+    builds.clear();
+  } else if (cfg.low_memory) {
+    // The single worker builds the segments in order on this thread, so each engine is added as soon as it is built,
+    // which also releases the segment graph
+    std::unordered_set<torch::jit::Node*> built_nodes;
+    std::unordered_set<torch::jit::Value*> shared_weights;
+    for (auto& build : builds) {
+      for (auto in : build.seg_block->raw_inputs()) {
+        if (in->node()->kind() == torch::jit::prim::Constant) {
+          shared_weights.insert(in);
+        }
+      }
+    }
+    size_t released = 0;
+    BuildEngines(builds, cfg, static_params, [&](size_t i) {
+      const auto& segment_nodes = builds[i].seg_block->raw_nodes();
+      built_nodes.insert(segment_nodes.begin(), segment_nodes.end());
+      add_engine(builds[i]);
+      released += ReleaseBuiltWeights(segment_nodes, built_nodes, shared_weights, static_params);
+    });
+    LOG_INFO("Dropped the compiler's references to " << released << " bytes of weights of built TensorRT segments");
+    builds.clear();
+  } else {
+    BuildEngines(builds, cfg, static_params);
+  }
+
+  if (shared_calibration) {
+    shared_calibration->write_cache();
+  }
+
+  for (auto& build : builds) {
+    add_engine(build);
+  }
+
+  // Torch segments NNC can compile into one kernel skip the per op dispatch of the interpreter
+  if (cfg.fuse_torch_segments) {
+    at::Device device(at::kCUDA, device_spec.gpu_id);
+    size_t num_fused = 0;
+    for (auto& blocks : partitioning_ctx.partitioned_blocks) {
+      for (auto& seg_block : blocks.second) {
+        if (auto fused_g = partitioning::fusibleTorchSegmentGraph(seg_block, device)) {
+          AddFusedTorchSegmentToGraph(new_mod, seg_block, fused_g, std::to_string(num_fused++));
+        }
+      }
+    }
+    LOG_INFO("Fused " << num_fused << " Torch segments into NNC kernels");
+  }
+
+  auto graph_and_mapping = partitioning::stitch(&partitioning_ctx, block);
+  partitioning::scheduleSegmentStreams(graph_and_mapping.first, cfg.partitioning_info);
+  // Engines on concurrent streams may still read a tensor once the caller's stream moves on to the next engine
+  if (cfg.plan_segment_activations && cfg.partitioning_info.concurrent_segment_streams > 1) {
+    LOG_WARNING("Activations of TensorRT segments scheduled on concurrent streams are not planned into an arena");
+  } else if (cfg.plan_segment_activations) {
+    AddActivationArenaToGraph(new_mod, graph_and_mapping.first);
+  }
+  return graph_and_mapping;
 }
 
 ir::TypeMap MapInputsAndDetermineDTypes(
@@ -297,9 +1186,14 @@ ir::TypeMap MapInputsAndDetermineDTypes(
   return inferred_dtypes;
 }
 
-std::string ConvertGraphToTRTEngine(const torch::jit::script::Module& mod, std::string method_name, CompileSpec cfg) {
+util::SerializedEngine ConvertGraphToTRTEngine(
+    const torch::jit::script::Module& mod,
+    std::string method_name,
+    CompileSpec cfg) {
+  util::logging::ScopedLogger log_scope;
+  conversion::NodeDispatchCache dispatch_cache;
   // Go through Lowering to simplify graph and extract weight parameters
-  auto graph_and_parameters = lowering::Lower(mod, method_name, cfg.lower_info);
+  auto graph_and_parameters = LoweringCache::Get().lower(mod, method_name, cfg.lower_info, /*keep=*/false);
 
   auto g = graph_and_parameters.first;
   TORCHTRT_CHECK(
@@ -311,7 +1205,9 @@ std::string ConvertGraphToTRTEngine(const torch::jit::script::Module& mod, std::
   auto first_use_types = ir::get_block_first_calc_dtypes_opt_collection(g->block());
 
   MapInputsAndDetermineDTypes(cfg, g, static_params, first_use_types);
+  lowering::FoldStaticShapes(g, cfg.convert_info.collection_input_spec_map);
 
+#if NV_TENSORRT_MAJOR < 10
   // Ensure none of the specified types are of acceptable input types incompatible with TRT
   // Currently, only at::kLong is an acceptable, though TRT-incompatible type
   for (auto value_to_dtypes : first_use_types) {
@@ -320,7 +1216,13 @@ std::string ConvertGraphToTRTEngine(const torch::jit::script::Module& mod, std::
           !dtype || dtype.value() != at::kLong, "Cannot specify Int64 input for a model fully compiled in TRT");
     }
   }
+#endif
 
+  if (cfg.device_memory_budget != 0) {
+    ApplyDeviceMemoryBudget(cfg.convert_info.engine_settings, cfg.device_memory_budget, cfg);
+  }
+  // The plan is handed to TensorRT as is, so it binds every output
+  cfg.convert_info.engine_settings.alias_outputs = false;
   auto engine = conversion::ConvertBlockToEngine(g->block(), cfg.convert_info, static_params);
 
   return engine;
@@ -331,71 +1233,169 @@ bool userRequestedFallback(CompileSpec& cfg) {
       cfg.partitioning_info.forced_fallback_operators.size() != 0;
 }
 
-torch::jit::Module CompileGraph(const torch::jit::Module& mod, CompileSpec cfg) {
-  torch::jit::Module new_mod(mod._ivalue()->name() + "_trt");
+// Result of lowering one method of a module for compilation
+struct LoweredMethod {
+  std::shared_ptr<torch::jit::Graph> g;
+  ir::StaticParams static_params;
+  ir::CollectionTypeMap first_use_types;
+  // Whether the graph is partitioned into TensorRT and Torch segments, instead of being built as one engine
+  bool partitioned;
+  bool expect_full_compilation;
+};
+
+// Lowers method_name of mod and resolves its input specs in cfg. RefitGraph relies on this producing the same graph
+// (and so the same partitioning) every time it is given the same module architecture and spec
+LoweredMethod LowerMethod(const torch::jit::Module& mod, const std::string& method_name, CompileSpec& cfg) {
+  auto graph_and_parameters = cfg.shared_lowering
+      ? cfg.shared_lowering->get(mod, method_name, cfg.lower_info)
+      : LoweringCache::Get().lower(mod, method_name, cfg.lower_info, /*keep=*/false);
 
-  auto device_spec = cfg.convert_info.engine_settings.device;
-  auto cuda_device = runtime::RTDevice(device_spec.gpu_id, device_spec.device_type);
+  auto g = graph_and_parameters.first;
+  auto params = graph_and_parameters.second;
+  auto static_params = ir::get_static_params(g->inputs(), params);
+  // Infer the type of an input from the weights of the calculation
+  auto first_use_types = ir::get_block_first_calc_dtypes_opt_collection(g->block());
 
-  for (const torch::jit::Method& method : mod.get_methods()) {
-    if (method.name().compare("forward") == 0) {
-      auto new_g = std::make_shared<torch::jit::Graph>();
+  // Determine if the block is convertible/has collection output, and based on the result,
+  // whether full compilation can be expected
+  auto isBlockConvertible = conversion::VerifyConverterSupportForBlock(g->block(), true);
+  auto inputIsCollection = conversion::InputIsCollection(g->block());
+  auto outputIsCollection = conversion::OutputIsCollection(g->block());
+  auto requires_collection_handling = (isBlockConvertible && (inputIsCollection || outputIsCollection));
+
+  // Determine whether user specifications necessitate partitioning
+  auto isFallbackRequested = userRequestedFallback(cfg);
+
+  // Extract map of IValue to DType
+  auto type_map = MapInputsAndDetermineDTypes(cfg, g, static_params, first_use_types, requires_collection_handling);
+  lowering::FoldStaticShapes(g, cfg.convert_info.collection_input_spec_map);
+
+  // Check whether any of the input types are Long
+  bool user_requested_long = false;
+#if NV_TENSORRT_MAJOR >= 10
+  // Engines bind Long inputs as Int64 and narrow them at the network input, so they need no casts in Torch
+#else
+  for (auto dtype : type_map) {
+    user_requested_long |= dtype.second && (dtype.second.value() == at::kLong);
+  }
 
-      auto graph_and_parameters = lowering::Lower(mod, method.name(), cfg.lower_info);
+  // Use dtype map to autocast Tensor-type inputs to Long dtype as necessary
+  if (cfg.partitioning_info.enabled && cfg.partitioning_info.truncate_long_and_double && user_requested_long) {
+    auto casts_inserted = lowering::AutocastLongInputs(g, type_map, cfg.lower_info.getGPUDeviceString());
+    user_requested_long &= (casts_inserted > 0);
+  }
+#endif
+
+  // Partitioning is required if:
+  // 1. User requested some modules/operators fallback
+  // 2. The block (graph) cannot be converted due to operator coverage
+  // 3. The output of the graph is a collection
+  // 4. The user requested a non-TRT data type input
+  auto isPartitioningRequired =
+      (isFallbackRequested || !isBlockConvertible || outputIsCollection || user_requested_long);
+
+  // The user did not require full compilation, but the model can be fully compiled
+  if (cfg.partitioning_info.enabled && !isPartitioningRequired) {
+    LOG_INFO("Skipping partitioning since model is fully supported");
+  }
+
+  // The user did not require full compilation, and the model can be fully compiled
+  // or, the user required full compilation but the I/O of the graph use collections
+  // Background builds need Torch segments to fall back on, so even fully supported graphs are partitioned
+  auto partitioned = (cfg.partitioning_info.enabled && (isPartitioningRequired || cfg.background_build)) ||
+      requires_collection_handling;
+  // If the model is fully-compilable and the user has specified full compilation, run partitioning
+  // to generate collection-processing code in Torch
+  auto expect_full_compilation = (requires_collection_handling && !cfg.partitioning_info.enabled);
+
+  return {g, static_params, first_use_types, partitioned, expect_full_compilation};
+}
+
+// Engines of a module compiled before by the fingerprint their name ends with, engines named otherwise are skipped
+std::unordered_map<std::string, util::SerializedEngine> CollectEngineFingerprints(const torch::jit::Module& mod) {
+  const std::string tag = "_engine_";
+  std::unordered_map<std::string, util::SerializedEngine> engines;
+  for (auto& engine : runtime::collect_engines(mod)) {
+    auto pos = engine->name.rfind(tag);
+    if (pos == std::string::npos) {
+      continue;
+    }
+    // Engines of identical segments are suffixed with _<n>
+    auto fingerprint = engine->name.substr(pos + tag.size());
+    fingerprint = fingerprint.substr(0, fingerprint.find('_'));
+    if (!fingerprint.empty() && !engines.count(fingerprint)) {
+      engines.emplace(fingerprint, engine->get_serialized_engine());
+    }
+  }
+  return engines;
+}
 
-      auto g = graph_and_parameters.first;
-      auto params = graph_and_parameters.second;
-      auto static_params = ir::get_static_params(g->inputs(), params);
-      // Infer the type of an input from the weights of the calculation
-      auto first_use_types = ir::get_block_first_calc_dtypes_opt_collection(g->block());
+torch::jit::Module CompileGraph(const torch::jit::Module& mod, CompileSpec cfg) {
+  TORCHTRT_NVTX_RANGE("torch_tensorrt::CompileGraph");
+  // Compilations running concurrently on other threads log with their own settings
+  util::logging::ScopedLogger log_scope;
+  util::CompileProfileScope profile_scope(cfg.profiler.get(), "");
+  TORCHTRT_COMPILE_PHASE("compile");
+  // The support checks, partitioning and conversion below look up the dispatch of each node once
+  conversion::NodeDispatchCache dispatch_cache;
+  torch::jit::Module new_mod(mod._ivalue()->name() + "_trt");
 
-      // Determine if the block is convertible/has collection output, and based on the result,
-      // whether full compilation can be expected
-      auto isBlockConvertible = conversion::VerifyConverterSupportForBlock(g->block(), true);
-      auto inputIsCollection = conversion::InputIsCollection(g->block());
-      auto outputIsCollection = conversion::OutputIsCollection(g->block());
-      auto requires_collection_handling = (isBlockConvertible && (inputIsCollection || outputIsCollection));
+  auto device_spec = cfg.convert_info.engine_settings.device;
+  auto cuda_device = ToRTDevice(device_spec.gpu_id, device_spec);
+  TORCHTRT_CHECK(
+      !cfg.background_build || cfg.partitioning_info.enabled,
+      "background_build requires partial compilation, TensorRT segments run in Torch until their engines are built");
+
+  // All engines of the module (e.g. the TensorRT segments of a partitioned graph) share one timing cache, which is
+  // saved once they are all built
+  auto& engine_settings = cfg.convert_info.engine_settings;
+  if (!engine_settings.timing_cache_path.empty() && !engine_settings.timing_cache) {
+    engine_settings.timing_cache = std::make_shared<conversion::TimingCache>(engine_settings.timing_cache_path);
+  }
+  // Same for the tactic files, every engine is a separate entry keyed by its fingerprint
+  if (!engine_settings.tactic_record_path.empty() && !engine_settings.tactic_record) {
+    engine_settings.tactic_record = std::make_shared<conversion::TacticFile>(engine_settings.tactic_record_path);
+  }
+  if (!engine_settings.tactic_replay_path.empty() && !engine_settings.tactic_replay) {
+    engine_settings.tactic_replay = std::make_shared<conversion::TacticFile>(engine_settings.tactic_replay_path);
+  }
 
-      // Determine whether user specifications necessitate partitioning
-      auto isFallbackRequested = userRequestedFallback(cfg);
+  if (cfg.device_memory_budget != 0) {
+    cfg.device_memory_report = cfg.device_memory_report ? cfg.device_memory_report
+                                                        : std::make_shared<DeviceMemoryBudgetReport>();
+    cfg.device_memory_report->engines.clear();
+  }
 
-      // Extract map of IValue to DType
-      auto type_map = MapInputsAndDetermineDTypes(cfg, g, static_params, first_use_types, requires_collection_handling);
+  // Blocks whose fingerprint matches an engine of the previous module reuse that engine instead of being rebuilt,
+  // the others still go through the engine cache if there is one
+  std::shared_ptr<conversion::MemoryEngineCache> previous_engines = nullptr;
+  if (cfg.previous_module) {
+    previous_engines = std::make_shared<conversion::MemoryEngineCache>(
+        CollectEngineFingerprints(*cfg.previous_module), cfg.convert_info.engine_cache);
+    cfg.convert_info.engine_cache = previous_engines;
+    LOG_DEBUG("Found " << previous_engines->size() << " reusable TensorRT engines in the previous module");
+  }
 
-      // Check whether any of the input types are Long
-      bool user_requested_long = false;
-      for (auto dtype : type_map) {
-        user_requested_long |= dtype.second && (dtype.second.value() == at::kLong);
-      }
+  for (const torch::jit::Method& method : mod.get_methods()) {
+    if (method.name().compare("forward") == 0) {
+      auto new_g = std::make_shared<torch::jit::Graph>();
 
-      // Use dtype map to autocast Tensor-type inputs to Long dtype as necessary
-      if (cfg.partitioning_info.enabled && cfg.partitioning_info.truncate_long_and_double && user_requested_long) {
-        auto casts_inserted = lowering::AutocastLongInputs(g, type_map, cfg.lower_info.getGPUDeviceString());
-        user_requested_long &= (casts_inserted > 0);
-      }
+      auto lowered = LowerMethod(mod, method.name(), cfg);
+      auto& g = lowered.g;
+      auto& static_params = lowered.static_params;
 
-      // Partitioning is required if:
-      // 1. User requested some modules/operators fallback
-      // 2. The block (graph) cannot be converted due to operator coverage
-      // 3. The output of the graph is a collection
-      // 4. The user requested a non-TRT data type input
-      auto isPartitioningRequired =
-          (isFallbackRequested || !isBlockConvertible || outputIsCollection || user_requested_long);
-
-      // The user did not require full compilation, but the model can be fully compiled
-      if (cfg.partitioning_info.enabled && !isPartitioningRequired) {
-        LOG_INFO("Skipping partitioning since model is fully supported");
+      if (cfg.dry_run_report) {
+        if (!cfg.partitioning_info.enabled && !conversion::VerifyConverterSupportForBlock(g->block(), true)) {
+          LOG_WARNING("Not all operations in graph are supported by the compiler, the compilation would fail");
+        }
+        *cfg.dry_run_report = DryRunPartition(
+            g->block(), cfg, static_params, lowered.first_use_types, lowered.expect_full_compilation);
+        return mod;
       }
 
-      // The user did not require full compilation, and the model can be fully compiled
-      // or, the user required full compilation but the I/O of the graph use collections
-      if ((cfg.partitioning_info.enabled && isPartitioningRequired) || requires_collection_handling) {
-        // If the model is fully-compilable and the user has specified full compilation, run partitioning
-        // to generate collection-processing code in Torch
-        auto expect_full_compilation = (requires_collection_handling && !cfg.partitioning_info.enabled);
-
-        auto graph_and_mapping =
-            BuildHybridGraph(new_mod, g->block(), cfg, static_params, first_use_types, expect_full_compilation);
+      if (lowered.partitioned) {
+        auto graph_and_mapping = BuildHybridGraph(
+            new_mod, g->block(), cfg, static_params, lowered.first_use_types, lowered.expect_full_compilation);
         new_g = graph_and_mapping.first;
         // renaming the input name of graph after fallback to ensure pytorch deserialize it correctly
         for (size_t i = 0; i < new_g->inputs().size(); ++i) {
@@ -413,9 +1413,31 @@ torch::jit::Module CompileGraph(const torch::jit::Module& mod, CompileSpec cfg)
         TORCHTRT_CHECK(
             conversion::VerifyConverterSupportForBlock(g->block()),
             "Not all operations in graph are supported by the compiler");
-        // TODO find the right
-        auto engine = conversion::ConvertBlockToEngine(g->block(), cfg.convert_info, static_params);
-        AddEngineToGraph(new_mod, new_g, engine, cuda_device, std::vector<std::string>(), std::vector<std::string>());
+        if (cfg.device_memory_budget != 0) {
+          ApplyDeviceMemoryBudget(engine_settings, cfg.device_memory_budget, cfg);
+        }
+        auto fingerprint = conversion::EngineCacheKey(
+            g->block(),
+            engine_settings,
+            cfg.convert_info.inputs,
+            cfg.convert_info.collection_input_spec_map,
+            static_params);
+        // Keyed by the target device like the segments of a partitioned module, the build GPU is the same model
+        auto convert_info = cfg.convert_info;
+        util::SerializedEngine engine;
+        {
+          c10::cuda::OptionalCUDAGuard device_guard;
+          if (!cfg.build_gpu_ids.empty()) {
+            CheckBuildDevices(cfg);
+            convert_info.engine_settings.device.gpu_id = cfg.build_gpu_ids[0];
+            device_guard.set_index(static_cast<c10::DeviceIndex>(cfg.build_gpu_ids[0]));
+          }
+          engine = MarkDLALoadable(
+              conversion::ConvertBlockToEngine(g->block(), convert_info, static_params, fingerprint),
+              convert_info.engine_settings);
+        }
+        AddEngineToGraph(
+            new_mod, new_g, engine, cuda_device, std::vector<std::string>(), std::vector<std::string>(), fingerprint);
       }
       auto new_method = new_mod._ivalue()->compilation_unit()->create_function(method.name(), new_g);
       auto schema = util::GenerateGraphSchema(new_method->name(), new_g);
@@ -423,9 +1445,159 @@ torch::jit::Module CompileGraph(const torch::jit::Module& mod, CompileSpec cfg)
       new_method->setSchema(schema);
     }
   }
+  if (engine_settings.timing_cache) {
+    engine_settings.timing_cache->save();
+  }
+  if (engine_settings.tactic_record) {
+    engine_settings.tactic_record->save();
+  }
+  if (cfg.device_memory_budget != 0) {
+    ReportDeviceMemoryBudget(new_mod, cfg);
+  }
+  if (engine_settings.strip_weights) {
+    // The engines keep their weights in memory, they are left out when the module is saved
+    for (auto& engine : runtime::collect_engines(new_mod)) {
+      engine->weights_stripped = true;
+    }
+  }
+  if (previous_engines) {
+    auto num_engines = runtime::collect_engines(new_mod).size();
+    auto num_reused = previous_engines->num_hits();
+    LOG_INFO(
+        "Reused " << num_reused << " of " << num_engines << " TensorRT engines from the previous module, "
+                  << num_engines - num_reused << " were rebuilt or loaded from the engine cache");
+  }
   return new_mod;
 }
 
+std::pair<std::shared_ptr<torch::jit::Graph>, std::vector<torch::jit::IValue>> SharedLowering::get(
+    const torch::jit::Module& mod,
+    const std::string& method_name,
+    const lowering::LowerInfo& lower_info) {
+  auto key = LoweringKey(method_name, lower_info);
+
+  // Held while lowering so that concurrent specs with the same key wait for the first instead of lowering again
+  std::lock_guard<std::mutex> lock(mu);
+  auto entry = lowered.find(key);
+  if (entry == lowered.end()) {
+    entry = lowered.emplace(key, LoweringCache::Get().lower(mod, method_name, lower_info, /*keep=*/false)).first;
+  } else {
+    LOG_DEBUG("Reusing the lowered graph of " << method_name);
+  }
+  return {entry->second.first->copy(), entry->second.second};
+}
+
+std::vector<torch::jit::Module> CompileVariants(
+    const torch::jit::Module& mod,
+    std::vector<CompileSpec> cfgs,
+    const std::vector<int64_t>& gpu_ids) {
+  TORCHTRT_NVTX_RANGE("torch_tensorrt::CompileVariants");
+  util::logging::ScopedLogger log_scope;
+  auto shared_lowering = std::make_shared<SharedLowering>();
+  std::unordered_map<std::string, std::shared_ptr<conversion::TimingCache>> timing_caches;
+  std::unordered_map<std::string, std::shared_ptr<conversion::TacticFile>> tactic_files;
+  auto share_tactic_file = [&](const std::string& path, std::shared_ptr<conversion::TacticFile>& file) {
+    if (!path.empty() && !file) {
+      auto& shared = tactic_files[path];
+      if (!shared) {
+        shared = std::make_shared<conversion::TacticFile>(path);
+      }
+      file = shared;
+    }
+  };
+  for (auto& cfg : cfgs) {
+    cfg.shared_lowering = shared_lowering;
+    auto& engine_settings = cfg.convert_info.engine_settings;
+    if (!engine_settings.timing_cache_path.empty() && !engine_settings.timing_cache) {
+      auto& cache = timing_caches[engine_settings.timing_cache_path];
+      if (!cache) {
+        cache = std::make_shared<conversion::TimingCache>(engine_settings.timing_cache_path);
+      }
+      engine_settings.timing_cache = cache;
+    }
+    share_tactic_file(engine_settings.tactic_record_path, engine_settings.tactic_record);
+    share_tactic_file(engine_settings.tactic_replay_path, engine_settings.tactic_replay);
+  }
+
+  int caller_device = 0;
+  TORCHTRT_CHECK(cudaGetDevice(&caller_device) == cudaSuccess, "Unable to get the current CUDA device");
+  std::vector<int64_t> workers = gpu_ids;
+  if (workers.empty()) {
+    workers.push_back(caller_device);
+  }
+  workers.resize(std::min(workers.size(), cfgs.size()));
+  LOG_INFO("Compiling " << cfgs.size() << " variants of the module on " << workers.size() << " GPUs");
+
+  std::vector<torch::jit::Module> modules(cfgs.size());
+  std::atomic<size_t> next = {0};
+  std::vector<std::exception_ptr> errors(workers.size());
+  auto& logger = util::logging::get_logger();
+  auto worker = [&](size_t worker_id) {
+    util::logging::ScopedLogger log_scope(logger);
+    try {
+      auto gpu_id = workers[worker_id];
+      c10::cuda::CUDAGuard device_guard(static_cast<c10::DeviceIndex>(gpu_id));
+      for (size_t i = next++; i < cfgs.size(); i = next++) {
+        auto& cfg = cfgs[i];
+        if (cfg.build_gpu_ids.empty() &&
+            cfg.convert_info.engine_settings.device.device_type == nvinfer1::DeviceType::kGPU) {
+          cfg.build_gpu_ids = {gpu_id};
+        }
+        LOG_DEBUG("Compiling variant " << i << " on GPU " << gpu_id);
+        modules[i] = CompileGraph(mod, cfg);
+      }
+    } catch (...) {
+      errors[worker_id] = std::current_exception();
+      // Stop handing out variants, the other workers finish the one they are building
+      next = cfgs.size();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t w = 1; w < workers.size(); w++) {
+    threads.emplace_back(worker, w);
+  }
+  worker(0);
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (auto& e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+  return modules;
+}
+
+void RefitGraph(torch::jit::Module& compiled_mod, const torch::jit::Module& new_mod, CompileSpec cfg) {
+  TORCHTRT_NVTX_RANGE("torch_tensorrt::RefitGraph");
+  util::logging::ScopedLogger log_scope;
+  auto lowered = LowerMethod(new_mod, "forward", cfg);
+  auto& static_params = lowered.static_params;
+
+  // Reproduce the TensorRT blocks the compiled module was built from, in the order its engines were registered
+  std::vector<EngineBuild> builds;
+  std::unique_ptr<partitioning::PartitioningCtx> partitioning_ctx;
+  if (lowered.partitioned) {
+    partitioning_ctx = std::make_unique<partitioning::PartitioningCtx>(lowered.g->block(), cfg.partitioning_info);
+    builds = PartitionTensorRTSegments(
+        partitioning_ctx.get(), cfg, static_params, lowered.first_use_types, lowered.expect_full_compilation);
+  } else {
+    builds.push_back({nullptr, lowered.g->block(), cfg.convert_info, ""});
+  }
+
+  auto engines = runtime::collect_engines(compiled_mod);
+  TORCHTRT_CHECK(
+      engines.size() == builds.size(),
+      "The compiled module holds " << engines.size() << " TensorRT engines but the new module produces "
+                                   << builds.size() << " TensorRT blocks, it can only be refit from a module with "
+                                   << "the same architecture and compile spec");
+
+  for (size_t i = 0; i < builds.size(); i++) {
+    engines[i]->refit(conversion::ConvertBlockToRefitWeights(builds[i].block, builds[i].convert_info, static_params));
+  }
+}
+
 torch::jit::script::Module EmbedEngineInNewModule(
     const std::string& engine,
     runtime::RTDevice cuda_device,
@@ -1,11 +1,17 @@
 #pragma once
 
 #include <cuda_runtime.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
 #include <vector>
 #include "core/conversion/conversion.h"
 #include "core/ir/ir.h"
 #include "core/lowering/lowering.h"
 #include "core/partitioning/partitioning.h"
+#include "core/partitioning/partitioning_report.h"
 #include "core/runtime/runtime.h"
 #include "torch/csrc/jit/api/module.h"
 #include "torch/csrc/jit/ir/ir.h"
@@ -13,6 +19,36 @@
 namespace torch_tensorrt {
 namespace core {
 
+// Lowered graphs of a module shared between the compile specs it is built for, so that each method is lowered once
+// per lowering configuration rather than once per spec. Every get returns a copy of the graph, which the caller is
+// free to mutate
+struct SharedLowering {
+  std::pair<std::shared_ptr<torch::jit::Graph>, std::vector<torch::jit::IValue>> get(
+      const torch::jit::Module& mod,
+      const std::string& method_name,
+      const lowering::LowerInfo& lower_info);
+
+ private:
+  std::mutex mu;
+  std::map<std::string, std::pair<std::shared_ptr<torch::jit::Graph>, std::vector<torch::jit::IValue>>> lowered;
+};
+
+// Device memory the TensorRT engines of a compilation were budgeted and need for their activations and scratch
+struct DeviceMemoryBudgetReport {
+  struct Engine {
+    int64_t budget = 0;
+    // Device memory of the execution context of the engine, -1 if its engine is not built yet (background builds)
+    int64_t device_memory = -1;
+  };
+  int64_t budget = 0;
+  // Engines sharing one device memory arena run one at a time, the module needs as much as the largest of them
+  bool shared = false;
+  // In the order of the segments of the module
+  std::vector<Engine> engines;
+  int64_t device_memory = 0;
+  bool met = true;
+};
+
 struct CompileSpec {
   CompileSpec(std::vector<ir::Input> inputs) : graph_inputs(inputs) {}
   CompileSpec(torch::jit::IValue& input_signature) : graph_inputs(input_signature) {}
@@ -20,14 +56,77 @@ struct CompileSpec {
   conversion::ConversionInfo convert_info;
   lowering::LowerInfo lower_info;
   partitioning::PartitioningInfo partitioning_info;
+  // Run all TensorRT engines of a partitioned module out of one shared device memory arena
+  bool share_device_memory = false;
+  // Capture the CUDA graphs of all TensorRT engines of a partitioned module into one graph pool, their persistent
+  // buffers aliasing each other
+  bool share_cudagraph_pool = false;
+  // Compile the Torch segments of a partitioned module which NNC supports into single kernels
+  bool fuse_torch_segments = false;
+  // Return the module as soon as it is partitioned, its TensorRT segments run their Torch graphs until their engines,
+  // built on a background thread, are ready. Requires partitioning
+  bool background_build = false;
+  // Place the tensors TensorRT segments of a partitioned module only pass to each other in one preallocated arena
+  bool plan_segment_activations = false;
+  // Build the TensorRT segments of a partitioned module one at a time and drop the weights of each segment once its
+  // engine is built, trading build parallelism for peak host memory
+  bool low_memory = false;
+  // Number of TensorRT segments of a partitioned module built concurrently, 0 uses one worker per hardware thread
+  int64_t num_build_workers = 1;
+  // GPUs the workers build on, round robin, a fully compiled module builds on the first. They must be the same model
+  // as the target device. Empty builds every engine on the target device
+  std::vector<int64_t> build_gpu_ids;
+  // Calibrate all TensorRT segments of a partitioned module from a single pass over the calibration data, sharing one
+  // calibration cache
+  bool shared_segment_calibration = false;
+  // Format of the tensors TensorRT segments of a partitioned module pass to each other, e.g. kHWC8 for FP16
+  // convolutional networks. Tensors whose type or shape the format does not support stay linear
+  nvinfer1::TensorFormat segment_boundary_format = nvinfer1::TensorFormat::kLINEAR;
+  // Device memory all TensorRT engines of the module may use together for their activations and scratch, 0 leaves
+  // each engine to workspace_size. The TensorRT segments of a partitioned module are given shares in proportion to the
+  // memory of their activations (each gets all of it with share_device_memory), which caps the workspace their tactics
+  // are selected under. TensorRT cannot be bound to a total, whether it was met is logged and reported
+  uint64_t device_memory_budget = 0;
+  // Filled with the budget of each engine and the memory it needs if set, with device_memory_budget
+  std::shared_ptr<DeviceMemoryBudgetReport> device_memory_report = nullptr;
+  // Records the wall time and memory of each compilation phase if set
+  std::shared_ptr<util::CompileProfiler> profiler = nullptr;
+  // If set, compilation stops after lowering and partitioning and fills this report of the segments instead of
+  // building their engines, the module is returned as is
+  std::shared_ptr<partitioning::PartitioningReport> dry_run_report = nullptr;
+  // Module previously compiled from an earlier revision of the model. TensorRT blocks whose graph, weights, input specs
+  // and settings are unchanged reuse its engines instead of being rebuilt
+  c10::optional<torch::jit::Module> previous_module = {};
+  // Lowering shared with other specs the same module is compiled for, the module is lowered by this spec if unset
+  std::shared_ptr<SharedLowering> shared_lowering = nullptr;
 };
 
-bool CheckMethodOperatorSupport(const torch::jit::script::Module& mod, std::string method_name);
+// Checks the lowering of method_name under lower_info, which stays cached for a following conversion or compilation of
+// the same (unchanged) module with the same lowering settings
+bool CheckMethodOperatorSupport(
+    const torch::jit::script::Module& mod,
+    std::string method_name,
+    const lowering::LowerInfo& lower_info = lowering::LowerInfo());
 
-std::string ConvertGraphToTRTEngine(const torch::jit::script::Module& mod, std::string method_name, CompileSpec cfg);
+util::SerializedEngine ConvertGraphToTRTEngine(
+    const torch::jit::script::Module& mod,
+    std::string method_name,
+    CompileSpec cfg);
 
 torch::jit::script::Module CompileGraph(const torch::jit::script::Module& module, CompileSpec cfg);
 
+// Compiles module once for each of cfgs, on one worker per GPU of gpu_ids (the current device if empty). The specs
+// share the lowering of the module and a timing cache per timing_cache_path, and variants built on a GPU other than
+// their target use it as their build GPU. Modules are returned in the order of cfgs
+std::vector<torch::jit::script::Module> CompileVariants(
+    const torch::jit::script::Module& module,
+    std::vector<CompileSpec> cfgs,
+    const std::vector<int64_t>& gpu_ids);
+
+// Refits the engines of a module produced by CompileGraph with the weights of new_mod, which has to lower and
+// partition into the same TensorRT blocks under cfg
+void RefitGraph(torch::jit::script::Module& compiled_mod, const torch::jit::script::Module& new_mod, CompileSpec cfg);
+
 torch::jit::script::Module EmbedEngineInNewModule(
     const std::string& engine,
     runtime::RTDevice cuda_device,
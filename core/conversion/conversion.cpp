@@ -1,7 +1,12 @@
 #include "core/conversion/conversion.h"
 #include <ATen/core/operator_name.h>
 #include <torch/torch.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <sstream>
+#include <unordered_set>
+#include <vector>
 #include "c10/util/intrusive_ptr.h"
 #include "core/conversion/conversionctx/ConversionCtx.h"
 #include "core/conversion/converters/converter_util.h"
@@ -19,57 +24,211 @@ namespace conversion {
 // Defined in core/conversion/conversion_ignorelist.cpp
 bool isNodeConversionIgnored(const torch::jit::Node* n);
 
+namespace {
+// Module path of a node, e.g. layer1.0.conv1, from the call stack recorded when the module methods were inlined
+std::string module_path(const torch::jit::Node* n) {
+  std::string path;
+  auto callstack = n->callstack();
+  if (!callstack) {
+    return path;
+  }
+  for (auto& entry : (*callstack)->vec()) {
+    auto& module_info = std::get<2>(entry);
+    if (module_info) {
+      path += (path.empty() ? "" : ".") + module_info->instance_name();
+    }
+  }
+  return path;
+}
+
+// Precision the user pinned the layers of n to. Node kinds take priority over module paths, of which the longest
+// matching path wins
+c10::optional<nvinfer1::DataType> layer_precision(ConversionCtx* ctx, const torch::jit::Node* n) {
+  auto& constraints = ctx->settings.layer_precisions;
+  if (constraints.empty()) {
+    return {};
+  }
+  auto by_kind = constraints.find(n->kind().toQualString());
+  if (by_kind != constraints.end()) {
+    return by_kind->second;
+  }
+  auto path = module_path(n);
+  c10::optional<nvinfer1::DataType> precision;
+  size_t longest = 0;
+  for (auto& c : constraints) {
+    auto& prefix = c.first;
+    if (path.empty() || prefix.find("::") != std::string::npos || prefix.size() < longest) {
+      continue;
+    }
+    bool matches = path.compare(0, prefix.size(), prefix) == 0 &&
+        (path.size() == prefix.size() || path[prefix.size()] == '.');
+    if (matches) {
+      precision = c.second;
+      longest = prefix.size();
+    }
+  }
+  return precision;
+}
+
+// Constrains the floating point layers added to the network from first_layer on to precision
+void constrain_layer_precision(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    int32_t first_layer,
+    nvinfer1::DataType precision) {
+  int32_t num_constrained = 0;
+  for (int32_t i = first_layer; i < ctx->net->getNbLayers(); i++) {
+    auto layer = ctx->net->getLayer(i);
+    auto type = layer->getType();
+    if (type == nvinfer1::LayerType::kCONSTANT || type == nvinfer1::LayerType::kSHAPE) {
+      continue;
+    }
+    bool computes_in_float = false;
+    for (int32_t o = 0; o < layer->getNbOutputs(); o++) {
+      auto out_type = layer->getOutput(o)->getType();
+      if (out_type == nvinfer1::DataType::kFLOAT || out_type == nvinfer1::DataType::kHALF ||
+          out_type == nvinfer1::DataType::kBF16) {
+        layer->setOutputType(o, precision);
+        computes_in_float = true;
+      }
+    }
+    if (computes_in_float) {
+      layer->setPrecision(precision);
+      num_constrained++;
+    }
+  }
+  LOG_DEBUG(
+      ctx->logger, "Constrained " << num_constrained << " layers of " << util::node_info(n) << " to " << precision);
+}
+} // namespace
+
+namespace {
+thread_local NodeDispatchCache* active_dispatch_cache = nullptr;
+
+NodeDispatch LookupNodeDispatch(const torch::jit::Node* n) {
+  if (evaluators::shouldEvalAtConversionTime(n)) {
+    return NodeDispatch::kEvaluator;
+  }
+  return converters::node_is_convertable(n) ? NodeDispatch::kConverter : NodeDispatch::kUnsupported;
+}
+} // namespace
+
+NodeDispatchCache::NodeDispatchCache() : previous_(active_dispatch_cache) {
+  active_dispatch_cache = this;
+}
+
+NodeDispatchCache::~NodeDispatchCache() {
+  active_dispatch_cache = previous_;
+}
+
+NodeDispatch NodeDispatchCache::get(const torch::jit::Node* n) {
+  auto schema = n->maybeSchema();
+  auto it = entries_.find(n);
+  if (it != entries_.end() && it->second.kind == n->kind() && it->second.schema == schema &&
+      it->second.output_types.size() == n->outputs().size() &&
+      std::equal(
+          n->outputs().begin(), n->outputs().end(), it->second.output_types.begin(), [](auto out, auto& type) {
+            return out->type() == type;
+          })) {
+    return it->second.dispatch;
+  }
+  Entry entry{n->kind(), schema, {}, LookupNodeDispatch(n)};
+  for (auto out : n->outputs()) {
+    entry.output_types.push_back(out->type());
+  }
+  auto dispatch = entry.dispatch;
+  entries_[n] = std::move(entry);
+  return dispatch;
+}
+
+NodeDispatch GetNodeDispatch(const torch::jit::Node* n) {
+  return active_dispatch_cache ? active_dispatch_cache->get(n) : LookupNodeDispatch(n);
+}
+
 bool OpSupported(const torch::jit::Node* n) {
-  return evaluators::shouldEvalAtConversionTime(n) || converters::node_is_convertable(n);
+  return GetNodeDispatch(n) != NodeDispatch::kUnsupported;
 }
 
 bool SpecialCaseSupport(const torch::jit::Node* n) {
   return n->kind() == torch::jit::prim::Loop || n->kind() == torch::jit::prim::If;
 }
 
-c10::optional<torch::jit::IValue> EvaluateNode(ConversionCtx* ctx, const torch::jit::Node* n, int level, int limit) {
-  // Check to see if you can just go through and eval all of these AOT (saves
-  // the recursion) Also probably a better way to deal with the two error cases;
-  TORCHTRT_CHECK(
-      level < limit,
-      "Failed to evaluate node: " << *n << "Reason: Exceeded evaluation stack limit (limit=" << limit << ")");
-
-  LOG_DEBUG(ctx->logger, "Evaluating " << util::node_info(n));
-  evaluators::kwargs eval_args;
-  for (auto eval_in : n->inputs()) {
-    if (eval_args.find(eval_in) != eval_args.end()) {
-      // No need to evaluate nodes that already have been entered in the
-      // args dict
+c10::optional<torch::jit::IValue> EvaluateNode(ConversionCtx* ctx, const torch::jit::Node* n) {
+  // Inputs which still need to be evaluated are evaluated first, depth first with an explicit stack so long chains
+  // (e.g. of aten::size arithmetic) do not recurse. Every value is evaluated at most once: results are memoized in
+  // the context, the same as the values of evaluated nodes, so later nodes reuse them too
+  struct Frame {
+    const torch::jit::Node* node;
+    // Input of another frame the node is evaluated for, nullptr for n itself
+    const torch::jit::Value* value;
+    bool expanded;
+  };
+
+  // Evaluators returning None leave the value out of the args of its users, it is not memoized in the context
+  std::unordered_set<const torch::jit::Value*> evaluated_to_none;
+  auto is_evaluated = [&](const torch::jit::Value* v) {
+    return ctx->evaluated_value_map.find(v) != ctx->evaluated_value_map.end() ||
+        ctx->value_tensor_map.find(v) != ctx->value_tensor_map.end() ||
+        evaluated_to_none.find(v) != evaluated_to_none.end();
+  };
+
+  std::vector<Frame> stack = {{n, nullptr, false}};
+  while (true) {
+    if (!stack.back().expanded) {
+      stack.back().expanded = true;
+      auto node = stack.back().node;
+      auto inputs = node->inputs();
+      // Pushed in reverse so inputs are evaluated in order. A value can be pushed by several frames, only the first
+      // one to be popped evaluates it
+      for (auto it = inputs.rbegin(); it != inputs.rend(); ++it) {
+        auto eval_in = *it;
+        if (is_evaluated(eval_in)) {
+          continue;
+        }
+        if (GetNodeDispatch(eval_in->node()) != NodeDispatch::kEvaluator) {
+          TORCHTRT_THROW_ERROR(
+              "Failed to evaluate node: " << *node << "Reason: Node inputs cannot be evaluated at conversion time\n"
+                                          << "File a bug: https://www.github.com/NVIDIA/Torch-TensorRT/issues");
+        }
+        stack.push_back({eval_in->node(), eval_in, false});
+      }
       continue;
     }
-    if (ctx->evaluated_value_map.find(eval_in) != ctx->evaluated_value_map.end()) {
-      eval_args[eval_in] = &(ctx->evaluated_value_map[eval_in]);
-    } else if (ctx->value_tensor_map.find(eval_in) != ctx->value_tensor_map.end()) {
-      eval_args[eval_in] = ctx->value_tensor_map[eval_in];
-    } else if (evaluators::shouldEvalAtConversionTime(eval_in->node())) {
-      auto result = EvaluateNode(ctx, eval_in->node(), level++, limit);
-      if (result) {
-        // WARN: If the converter returns None then should pass through
-        // but if repeated dep this section will get called each time
-        auto val = result.value();
-        if (val.isCustomClass()) {
-          auto cont = val.toCustomClass<TensorContainer>();
-          ctx->AssociateValueAndTensor(eval_in, cont->tensor());
-          eval_args[eval_in] = ctx->value_tensor_map[eval_in];
-        } else {
-          ctx->AssociateValueAndIValue(eval_in, val);
-          eval_args[eval_in] = &(ctx->evaluated_value_map[eval_in]);
-        }
+
+    auto frame = stack.back();
+    stack.pop_back();
+    if (frame.value && is_evaluated(frame.value)) {
+      continue;
+    }
+
+    LOG_DEBUG(ctx->logger, "Evaluating " << util::node_info(frame.node));
+    evaluators::kwargs eval_args;
+    for (auto eval_in : frame.node->inputs()) {
+      if (eval_args.find(eval_in) != eval_args.end()) {
+        // No need to look up inputs that already have been entered in the
+        // args dict
+        continue;
+      }
+      if (ctx->evaluated_value_map.find(eval_in) != ctx->evaluated_value_map.end()) {
+        eval_args[eval_in] = &(ctx->evaluated_value_map[eval_in]);
+      } else if (ctx->value_tensor_map.find(eval_in) != ctx->value_tensor_map.end()) {
+        eval_args[eval_in] = ctx->value_tensor_map[eval_in];
       }
+    }
+    auto eval = evaluators::EvalNode(ctx, frame.node, eval_args);
+    if (!frame.value) {
+      return eval;
+    }
+
+    if (!eval) {
+      evaluated_to_none.insert(frame.value);
+    } else if (eval.value().isCustomClass()) {
+      auto cont = eval.value().toCustomClass<TensorContainer>();
+      ctx->AssociateValueAndTensor(frame.value, cont->tensor());
     } else {
-      TORCHTRT_THROW_ERROR(
-          "Failed to evaluate node: " << *n << "Reason: Node inputs cannot be evaluated at conversion time\n"
-                                      << "File a bug: https://www.github.com/NVIDIA/Torch-TensorRT/issues");
-      return {};
+      ctx->AssociateValueAndIValue(frame.value, eval.value());
     }
   }
-  auto eval = evaluators::EvalNode(ctx, n, eval_args);
-  return eval;
 }
 
 void AddLayer(ConversionCtx* ctx, const torch::jit::Node* n) {
@@ -85,7 +244,7 @@ void AddLayer(ConversionCtx* ctx, const torch::jit::Node* n) {
       // Node input is a value that has already been evaluated
       LOG_DEBUG(ctx->logger, "Node input is a result of a previously evaluated value");
       node_args.push_back(&(ctx->evaluated_value_map[input]));
-    } else if (evaluators::shouldEvalAtConversionTime(input_node)) {
+    } else if (GetNodeDispatch(input_node) == NodeDispatch::kEvaluator) {
       // Node input is a node that needs to be evaluated before
       // the node can be converted
       LOG_DEBUG(ctx->logger, "Node input is a value that needs to be evaluated");
@@ -121,7 +280,13 @@ void AddLayer(ConversionCtx* ctx, const torch::jit::Node* n) {
   auto schema = n->maybeSchema();
   TORCHTRT_CHECK(schema, "Unable to get schema for Node " << util::node_info(n) << " (conversion.AddLayer)");
 
-  auto converter = converters::get_node_converter_for(schema);
+  converters::OpConverter converter;
+  if (n->hasAttribute(converters::kTorchOpPluginAttr) && !converters::node_is_convertable(n)) {
+    // Kept in the segment by the partitioner, its Torch kernel runs inside the engine
+    converter = converters::convert_with_torch_op_plugin;
+  } else {
+    converter = converters::get_node_converter_for(schema);
+  }
   TORCHTRT_CHECK(
       converter,
       "Unable to convert node: "
@@ -129,10 +294,21 @@ void AddLayer(ConversionCtx* ctx, const torch::jit::Node* n) {
           << " requested, but no such converter was found.\nIf you need a converter for this operator, you can try implementing one yourself\n"
           << "or request a converter: https://www.github.com/NVIDIA/Torch-TensorRT/issues");
 
+  auto first_layer = ctx->net->getNbLayers();
   TORCHTRT_CHECK(
       converter(ctx, n, node_args),
       "Converter for " << *schema << " failed to convert node: " << util::node_info(n)
                        << "please report this error to https://www.github.com/NVIDIA/Torch-TensorRT/issues");
+  if (auto precision = layer_precision(ctx, n)) {
+    constrain_layer_precision(ctx, n, first_layer, *precision);
+  }
+#if NV_TENSORRT_MAJOR >= 10
+  // Reported by the engine inspector, maps the (possibly fused) layers of the engine back to their nodes
+  auto node_info = util::node_info(n);
+  for (int32_t i = first_layer; i < ctx->net->getNbLayers(); i++) {
+    ctx->net->getLayer(i)->setMetadata(node_info.c_str());
+  }
+#endif
 }
 
 void AddInputs(ConversionCtx* ctx, c10::ArrayRef<const torch::jit::Value*> inputs, ConversionInfo& conversion_info) {
@@ -162,20 +338,37 @@ void AddInputs(ConversionCtx* ctx, c10::ArrayRef<const torch::jit::Value*> input
   auto dbg_str = ss.str();
   LOG_DEBUG(ctx->logger, dbg_str);
 
-  auto profile = ctx->builder->createOptimizationProfile();
-
-  for (auto input : input_tensors) {
-    const torch::jit::Value* in = input;
+  // Inputs either describe the same number of optimization profiles or a single range, which is then used for every
+  // profile
+  size_t num_profiles = 1;
+  auto input_spec = [&](const torch::jit::Value* in) -> ir::Input {
     TORCHTRT_CHECK(
         input_specs.find(in) != input_specs.end() || collection_input_spec.find(in) != collection_input_spec.end(),
         "Cannot find an input spec associated with input: " << in->debugName());
-    ir::Input spec;
     if (input_specs.find(in) != input_specs.end()) {
-      spec = input_specs.find(in)->second;
-    } else {
-      spec = collection_input_spec.find(in)->second[0]; // assume input is tensor
+      return input_specs.find(in)->second;
+    }
+    return collection_input_spec.find(in)->second[0]; // assume input is tensor
+  };
+  for (auto input : input_tensors) {
+    auto spec_profiles = input_spec(input).num_profiles();
+    if (spec_profiles > 1) {
+      TORCHTRT_CHECK(
+          num_profiles == 1 || num_profiles == spec_profiles,
+          "All inputs with multiple optimization profiles must describe the same number of profiles, found "
+              << num_profiles << " and " << spec_profiles << " (conversion.AddInputs)");
+      num_profiles = spec_profiles;
     }
-    // ir::Input& spec = input_specs.find(in)->second;
+  }
+
+  std::vector<nvinfer1::IOptimizationProfile*> profiles;
+  for (size_t p = 0; p < num_profiles; p++) {
+    profiles.push_back(ctx->builder->createOptimizationProfile());
+  }
+
+  for (auto input : input_tensors) {
+    const torch::jit::Value* in = input;
+    ir::Input spec = input_spec(in);
 
     std::string name = std::string("input_") + std::to_string(ctx->num_inputs);
     LOG_INFO(
@@ -183,36 +376,118 @@ void AddInputs(ConversionCtx* ctx, c10::ArrayRef<const torch::jit::Value*> input
         "Adding Input " << in->debugName() << " (named: " << name << "): " << spec
                         << " in engine (conversion.AddInputs)");
 
-    auto trt_in = ctx->net->addInput(name.c_str(), util::ScalarTypeToTRTDataType(spec.dtype), spec.input_shape);
+    // Byte inputs are bound as UINT8 (other Byte tensors are INT8 in TensorRT), which only a cast may consume
+    auto trt_type =
+        spec.dtype == at::kByte ? nvinfer1::DataType::kUINT8 : util::ScalarTypeToTRTDataType(spec.dtype);
+    auto trt_in = ctx->net->addInput(name.c_str(), trt_type, spec.input_shape);
     TORCHTRT_CHECK(trt_in, "Failed to add input node: " << in->debugName() << " (conversion.AddInputs)");
     trt_in->setAllowedFormats(1U << static_cast<int>(spec.format));
 
-    profile->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kMIN, spec.min);
-    profile->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kOPT, spec.opt);
-    profile->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kMAX, spec.max);
+    for (size_t p = 0; p < num_profiles; p++) {
+      auto range = spec.profile(spec.num_profiles() > 1 ? p : 0);
+      profiles[p]->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kMIN, range.min);
+      profiles[p]->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kOPT, range.opt);
+      profiles[p]->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kMAX, range.max);
+    }
 
     if (spec.input_is_dynamic) {
       ctx->input_is_dynamic = true;
     }
 
-    ctx->RecordNewITensor(in, trt_in);
+    if (spec.dtype == at::kLong) {
+      // Long tensors handed over by Torch segments are narrowed in the engine, converters work on Int32
+      auto narrowed = converters::castITensor(ctx, trt_in, nvinfer1::DataType::kINT32, name + "_to_int32");
+      ctx->RecordNewITensor(in, narrowed);
+    } else if (spec.dtype == at::kByte) {
+      // e.g. image frames, normalized by the first layers of the engine instead of a Torch preprocessing step
+      auto widened = converters::castITensor(ctx, trt_in, nvinfer1::DataType::kFLOAT, name + "_to_float");
+      ctx->RecordNewITensor(in, widened);
+    } else {
+      ctx->RecordNewITensor(in, trt_in);
+    }
     ctx->num_inputs += 1;
   }
 
-  TORCHTRT_CHECK(
-      profile->isValid(),
-      "Optimization profile is invalid, please check the input range provided (conversion.AddInputs)");
-
-  ctx->cfg->addOptimizationProfile(profile);
+  for (size_t p = 0; p < num_profiles; p++) {
+    TORCHTRT_CHECK(
+        profiles[p]->isValid(),
+        "Optimization profile " << p
+                                << " is invalid, please check the input range provided (conversion.AddInputs)");
+    ctx->cfg->addOptimizationProfile(profiles[p]);
+  }
+  if (num_profiles > 1) {
+    LOG_INFO(ctx->logger, "Building engine with " << num_profiles << " optimization profiles");
+  }
 #if NV_TENSORRT_MAJOR > 7 || (NV_TENSORRT_MAJOR == 7 && NV_TENSORRT_MINOR >= 1)
   if (ctx->enabled_precisions.find(nvinfer1::DataType::kINT8) != ctx->enabled_precisions.end()) {
-    ctx->cfg->setCalibrationProfile(profile);
+    ctx->cfg->setCalibrationProfile(profiles[0]);
   }
 #endif
 }
 
+bool IsLayerInput(nvinfer1::INetworkDefinition* net, const nvinfer1::ITensor* tensor) {
+  for (int32_t l = 0; l < net->getNbLayers(); l++) {
+    auto layer = net->getLayer(l);
+    for (int32_t i = 0; i < layer->getNbInputs(); i++) {
+      if (layer->getInput(i) == tensor) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// util::OutputAliasName of each output which is returned again or is an input of the block, empty for the outputs the
+// engine binds. An engine binds at least one output
+std::vector<std::string> FindOutputAliases(ConversionCtx* ctx, at::ArrayRef<const torch::jit::Value*> outputs) {
+  std::vector<std::string> aliases(outputs.size());
+  // DLA loadables are run by cuDLA, which only knows the bindings of the loadable
+  if (!ctx->settings.alias_outputs || ctx->settings.device.device_type == nvinfer1::DeviceType::kDLA) {
+    return aliases;
+  }
+  auto& formats = ctx->settings.output_formats;
+  bool any_bound = false;
+  for (size_t o = 0; o < outputs.size(); o++) {
+    // Outputs requested in another format are laid out by TensorRT
+    if (o < formats.size() && formats[o] != nvinfer1::TensorFormat::kLINEAR) {
+      any_bound = true;
+      continue;
+    }
+    auto first = std::find(outputs.begin(), outputs.begin() + o, outputs[o]);
+    auto it = ctx->value_tensor_map.find(outputs[o]);
+    if (first != outputs.begin() + o) {
+      aliases[o] = util::OutputAliasName(false, first - outputs.begin());
+    } else if (outputs[o]->node()->kind() == torch::jit::prim::Param && it != ctx->value_tensor_map.end()) {
+      // Inputs converted on the way in (e.g. Long inputs narrowed to Int32) are returned as converted. TensorRT drops
+      // inputs no layer reads, those are still bound through an identity layer
+      for (int32_t i = 0; i < ctx->net->getNbInputs(); i++) {
+        if (it->second == ctx->net->getInput(i) && IsLayerInput(ctx->net.get(), it->second)) {
+          aliases[o] = util::OutputAliasName(true, i);
+        }
+      }
+    }
+    any_bound |= aliases[o].empty();
+  }
+  if (!any_bound && !aliases.empty()) {
+    // The first output is then an input, which is copied like before
+    aliases[0] = "";
+  }
+  return aliases;
+}
+
 void MarkOutputs(ConversionCtx* ctx, at::ArrayRef<const torch::jit::Value*> outputs) {
-  for (auto out : outputs) {
+  auto aliases = FindOutputAliases(ctx, outputs);
+  bool aliased = std::any_of(aliases.begin(), aliases.end(), [](const std::string& a) { return !a.empty(); });
+  // Returned index of each output bound by the engine
+  std::vector<size_t> bound;
+  for (size_t o = 0; o < outputs.size(); o++) {
+    auto out = outputs[o];
+    if (!aliases[o].empty()) {
+      LOG_INFO(ctx->logger, "Returning output " << out->debugName() << " as " << aliases[o] << " (ctx.MarkOutput)");
+      ctx->returned_outputs.push_back(aliases[o]);
+      continue;
+    }
+    auto num_outputs = ctx->num_outputs;
     auto it = ctx->value_tensor_map.find(out);
     if (it == ctx->value_tensor_map.end()) {
       if (ctx->evaluated_value_map.find(out) != ctx->evaluated_value_map.end()) {
@@ -235,8 +510,9 @@ void MarkOutputs(ConversionCtx* ctx, at::ArrayRef<const torch::jit::Value*> outp
         } else if (out_ivalue.isTensor()) {
           // prim::NumToTensor will go to here
           std::string name = std::string("output_") + std::to_string(ctx->num_outputs);
-          auto out_tensor = converters::tensor_to_const(ctx, out_ivalue.toTensor(), "");
-          out_tensor->setName(name.c_str());
+          // The frozen tensor may be interned and used by other layers, so its own identity is the output
+          auto const_tensor = converters::tensor_to_const(ctx, out_ivalue.toTensor(), "");
+          auto out_tensor = converters::applyIdentityOp(ctx, const_tensor, name);
           ctx->net->markOutput(*out_tensor);
           LOG_INFO(
               ctx->logger, "Marking Output " << out->debugName() << " named " << name << " in engine (ctx.MarkOutput)");
@@ -251,8 +527,18 @@ void MarkOutputs(ConversionCtx* ctx, at::ArrayRef<const torch::jit::Value*> outp
       auto out_tensor = it->second;
       std::string name = std::string("output_") + std::to_string(ctx->num_outputs);
 
-      // Check if the output tensor is one of the inputs to the network. If so, apply an identity layer to it.
-      for (int64_t i = 0; i < num_inputs; i++) {
+      // Check if the output tensor is one of the inputs to the network or an (interned) constant which already is an
+      // output. If so, apply an identity layer to it.
+      if (out_tensor->isNetworkOutput()) {
+        LOG_DEBUG(
+            "The tensor named " << out_tensor->getName()
+                                << " is already marked as an output. Applying an identity layer and marking this "
+                                << "tensor as output");
+        auto id_out_tensor = converters::applyIdentityOp(ctx, out_tensor, name);
+        ctx->net->markOutput(*id_out_tensor);
+        setOutput = true;
+      }
+      for (int64_t i = 0; !setOutput && i < num_inputs; i++) {
         if (out_tensor == ctx->net->getInput(i)) {
           LOG_DEBUG(
               "One of the inputs named "
@@ -272,6 +558,32 @@ void MarkOutputs(ConversionCtx* ctx, at::ArrayRef<const torch::jit::Value*> outp
           ctx->logger, "Marking Output " << out->debugName() << " named " << name << " in engine (ctx.MarkOutput)");
       ctx->num_outputs += 1;
     }
+    TORCHTRT_CHECK(
+        !aliased || ctx->num_outputs == num_outputs + 1,
+        "Unable to mark output " << out->debugName() << " of a block whose other outputs alias its inputs");
+    ctx->returned_outputs.push_back("output_" + std::to_string(num_outputs));
+    bound.push_back(o);
+  }
+  if (!aliased) {
+    ctx->returned_outputs.clear();
+  }
+
+  auto& formats = ctx->settings.output_formats;
+  for (int32_t i = 0; i < ctx->net->getNbOutputs() && i < static_cast<int32_t>(bound.size()); i++) {
+    auto o = bound[i];
+    if (o >= formats.size() || formats[o] == nvinfer1::TensorFormat::kLINEAR) {
+      continue;
+    }
+    auto out_tensor = ctx->net->getOutput(i);
+    auto min_rank = formats[o] == nvinfer1::TensorFormat::kDHWC8 ? 4 : 3;
+    TORCHTRT_CHECK(
+        ir::valid_dtype_format_combo(out_tensor->getType(), formats[o]) &&
+            out_tensor->getDimensions().nbDims >= min_rank,
+        "Output " << out_tensor->getName() << " of type " << out_tensor->getType() << " and rank "
+                  << out_tensor->getDimensions().nbDims << " cannot use tensor format " << formats[o]
+                  << " (conversion.MarkOutputs)");
+    out_tensor->setAllowedFormats(1U << static_cast<int>(formats[o]));
+    LOG_DEBUG(ctx->logger, "Output " << out_tensor->getName() << " is bound in format " << formats[o]);
   }
 }
 
@@ -282,6 +594,7 @@ void AddParamsToCtxValueMap(ConversionCtx* ctx, ir::StaticParams& params) {
 }
 
 void EvaluateLoopBlock(ConversionCtx* ctx, const torch::jit::Node* n);
+void ConvertNode(ConversionCtx* ctx, const torch::jit::Node* n);
 
 void MapIValues(
     ConversionCtx* ctx,
@@ -311,7 +624,189 @@ void MapIValues(
   }
 }
 
+// Whether v is produced inside one of the blocks of n, at any depth
+bool DefinedInside(const torch::jit::Value* v, const torch::jit::Node* n) {
+  for (auto b = v->node()->owningBlock(); b && b->owningNode(); b = b->owningNode()->owningBlock()) {
+    if (b->owningNode() == n) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// ITensors produced outside of n that the nodes or outputs of its blocks consume
+std::vector<const torch::jit::Value*> ExternalTensors(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    const torch::jit::Block* b) {
+  std::vector<const torch::jit::Value*> externals;
+  auto add = [&](const torch::jit::Value* v) {
+    if (!DefinedInside(v, n) && ctx->value_tensor_map.count(v) &&
+        std::find(externals.begin(), externals.end(), v) == externals.end()) {
+      externals.push_back(v);
+    }
+  };
+  for (auto bn : b->nodes()) {
+    for (auto in : bn->inputs()) {
+      add(in);
+    }
+    for (auto sub_b : bn->blocks()) {
+      for (auto v : ExternalTensors(ctx, n, sub_b)) {
+        add(v);
+      }
+    }
+  }
+  for (auto out : b->outputs()) {
+    add(out);
+  }
+  return externals;
+}
+
+// ITensor of a block output, frozen into a constant if the output was evaluated to a tensor
+nvinfer1::ITensor* BlockOutputTensor(ConversionCtx* ctx, const torch::jit::Node* n, const torch::jit::Value* v) {
+  auto it = ctx->value_tensor_map.find(v);
+  if (it != ctx->value_tensor_map.end()) {
+    return it->second;
+  }
+  auto eval = ctx->evaluated_value_map.find(v);
+  TORCHTRT_CHECK(
+      eval != ctx->evaluated_value_map.end() && eval->second.isTensor(),
+      "Output " << v->debugName() << " of " << util::node_info(n)
+                << " is not a tensor, TensorRT control flow can only produce tensors");
+  return converters::tensor_to_const(ctx, eval->second.toTensor());
+}
+
+// Converts a conditional whose condition is only known at runtime (an ITensor) to an IIfConditional. Both branches
+// are converted, the tensors they consume from outside the conditional enter through conditional inputs
+void ConvertConditionalBlock(ConversionCtx* ctx, const torch::jit::Node* n) {
+  LOG_DEBUG(ctx->logger, "(Conditional Conversion) Converting data dependent conditional " << *n);
+  auto condition = ctx->value_tensor_map[n->input(0)];
+  TORCHTRT_CHECK(
+      condition->getDimensions().nbDims == 0 && condition->getType() == nvinfer1::DataType::kBOOL,
+      "The condition of " << util::node_info(n) << " must be a scalar boolean tensor, found a tensor of type "
+                          << condition->getType() << " and shape " << condition->getDimensions());
+
+  auto conditional = ctx->net->addIfConditional();
+  TORCHTRT_CHECK(conditional, "Unable to create conditional from node: " << *n);
+  conditional->setName(util::node_info(n).c_str());
+  conditional->setCondition(*condition);
+
+  std::unordered_map<const torch::jit::Value*, nvinfer1::ITensor*> outside;
+  for (auto b : n->blocks()) {
+    for (auto v : ExternalTensors(ctx, n, b)) {
+      if (!outside.count(v)) {
+        outside[v] = ctx->value_tensor_map[v];
+        auto input = conditional->addInput(*outside[v]);
+        TORCHTRT_CHECK(input, "Unable to create conditional input from node: " << *n);
+        ctx->value_tensor_map[v] = input->getOutput(0);
+      }
+    }
+  }
+
+  std::vector<std::vector<nvinfer1::ITensor*>> branch_outputs;
+  for (auto b : n->blocks()) {
+    for (auto bn : b->nodes()) {
+      ConvertNode(ctx, bn);
+    }
+    std::vector<nvinfer1::ITensor*> outputs;
+    for (auto out : b->outputs()) {
+      outputs.push_back(BlockOutputTensor(ctx, n, out));
+    }
+    branch_outputs.push_back(std::move(outputs));
+  }
+
+  for (auto& o : outside) {
+    ctx->value_tensor_map[o.first] = o.second;
+  }
+  for (size_t i = 0; i < n->outputs().size(); i++) {
+    auto output = conditional->addOutput(*branch_outputs[0][i], *branch_outputs[1][i]);
+    TORCHTRT_CHECK(output, "Unable to create conditional output from node: " << *n);
+    ctx->AssociateValueAndTensor(n->outputs()[i], output->getOutput(0));
+  }
+}
+
+// Converts a loop carrying tensors computed at runtime to an ILoop. Only counted loops are supported: the body must not
+// change the loop condition or read the iteration count, and carried values that are not tensors must not change
+void ConvertLoopBlock(ConversionCtx* ctx, const torch::jit::Node* n) {
+  LOG_DEBUG(ctx->logger, "(Loop Conversion) Converting loop " << *n);
+  auto body = n->blocks()[0];
+  TORCHTRT_CHECK(
+      body->inputs()[0]->uses().empty(),
+      "Torch-TensorRT.TorchScript cannot convert loop " << util::node_info(n) << " which reads its iteration count");
+  auto body_cond = torch::jit::toIValue(body->outputs()[0]);
+  TORCHTRT_CHECK(
+      body_cond && body_cond->isBool() && body_cond->toBool(),
+      "Torch-TensorRT.TorchScript can only convert counted loops, loop " << util::node_info(n)
+                                                                         << " updates its condition");
+  auto start_cond = ctx->evaluated_value_map.find(n->input(1));
+  TORCHTRT_CHECK(
+      start_cond != ctx->evaluated_value_map.end(),
+      "The start condition of loop " << util::node_info(n) << " must be known at conversion time");
+  if (!start_cond->second.toBool()) {
+    MapIValues(ctx, n->inputs(), n->outputs(), 2, 0);
+    return;
+  }
+
+  auto loop = ctx->net->addLoop();
+  TORCHTRT_CHECK(loop, "Unable to create loop from node: " << *n);
+  loop->setName(util::node_info(n).c_str());
+  nvinfer1::ITensor* trip_limit = nullptr;
+  auto max_trip_count = ctx->evaluated_value_map.find(n->input(0));
+  if (max_trip_count != ctx->evaluated_value_map.end()) {
+    auto count = std::min<int64_t>(max_trip_count->second.toInt(), std::numeric_limits<int32_t>::max());
+    trip_limit = converters::tensor_to_const(ctx, torch::tensor(static_cast<int32_t>(count), torch::kInt32));
+  } else {
+    trip_limit = converters::castITensor(ctx, ctx->value_tensor_map[n->input(0)], nvinfer1::DataType::kINT32);
+    TORCHTRT_CHECK(
+        trip_limit->getDimensions().nbDims == 0,
+        "The trip count of loop " << util::node_info(n) << " must be a scalar, found shape "
+                                  << trip_limit->getDimensions());
+  }
+  loop->addTripLimit(*trip_limit, nvinfer1::TripLimit::kCOUNT);
+
+  // Carried values are the inputs after the trip count and start condition and the block inputs after the iteration
+  // count
+  std::vector<nvinfer1::IRecurrenceLayer*> recurrences;
+  for (size_t i = 0; i < n->outputs().size(); i++) {
+    auto in = n->input(i + 2);
+    auto block_in = body->inputs()[i + 1];
+    if (ctx->value_tensor_map.count(in)) {
+      auto recurrence = loop->addRecurrence(*ctx->value_tensor_map[in]);
+      TORCHTRT_CHECK(recurrence, "Unable to create recurrence from node: " << *n);
+      ctx->value_tensor_map[block_in] = recurrence->getOutput(0);
+      recurrences.push_back(recurrence);
+    } else {
+      TORCHTRT_CHECK(
+          body->outputs()[i + 1] == block_in,
+          "Loop " << util::node_info(n) << " changes non tensor value " << in->debugName()
+                  << ", only tensors can be carried by TensorRT loops");
+      ctx->evaluated_value_map[block_in] = ctx->evaluated_value_map[in];
+      recurrences.push_back(nullptr);
+    }
+  }
+
+  for (auto bn : body->nodes()) {
+    ConvertNode(ctx, bn);
+  }
+
+  for (size_t i = 0; i < n->outputs().size(); i++) {
+    if (recurrences[i]) {
+      auto next = BlockOutputTensor(ctx, n, body->outputs()[i + 1]);
+      recurrences[i]->setInput(1, *next);
+      auto output = loop->addLoopOutput(*next, nvinfer1::LoopOutput::kLAST_VALUE);
+      TORCHTRT_CHECK(output, "Unable to create loop output from node: " << *n);
+      ctx->AssociateValueAndTensor(n->outputs()[i], output->getOutput(0));
+    } else {
+      ctx->AssociateValueAndIValue(n->outputs()[i], ctx->evaluated_value_map[n->input(i + 2)]);
+    }
+  }
+}
+
 void EvaluateConditionalBlock(ConversionCtx* ctx, const torch::jit::Node* n, bool contained_in_loop = false) {
+  if (!ctx->evaluated_value_map.count(n->input(0)) && ctx->value_tensor_map.count(n->input(0))) {
+    ConvertConditionalBlock(ctx, n);
+    return;
+  }
   bool output_type_includes_tensor = false;
   for (auto o : n->outputs()) {
     if (o->type()->isSubtypeOf(c10::TensorType::get())) {
@@ -331,7 +826,7 @@ void EvaluateConditionalBlock(ConversionCtx* ctx, const torch::jit::Node* n, boo
       EvaluateLoopBlock(ctx, bn);
     } else if (bn->kind() == torch::jit::prim::If) {
       EvaluateConditionalBlock(ctx, bn, contained_in_loop);
-    } else if (evaluators::shouldEvalAtConversionTime(bn)) {
+    } else if (GetNodeDispatch(bn) == NodeDispatch::kEvaluator) {
       auto eval = EvaluateNode(ctx, bn);
       if (!eval.value().isTensor()) {
         LOG_DEBUG(ctx->logger, "(Conditional Evaluation) Found the value to be: " << eval.value());
@@ -345,7 +840,7 @@ void EvaluateConditionalBlock(ConversionCtx* ctx, const torch::jit::Node* n, boo
                                                                               << ')');
       }
       ctx->AssociateValueAndIValue(bn->output(0), eval.value());
-    } else if (converters::node_is_convertable(bn)) {
+    } else if (GetNodeDispatch(bn) == NodeDispatch::kConverter) {
       AddLayer(ctx, bn);
     } else {
       TORCHTRT_THROW_ERROR(
@@ -360,6 +855,12 @@ void EvaluateConditionalBlock(ConversionCtx* ctx, const torch::jit::Node* n, boo
 // TODO: With functionalization pass we may be able to make this into a regular
 // evaluator later
 void EvaluateLoopBlock(ConversionCtx* ctx, const torch::jit::Node* n) {
+  for (size_t i = 2; i < n->inputs().size(); i++) {
+    if (ctx->value_tensor_map.count(n->input(i))) {
+      ConvertLoopBlock(ctx, n);
+      return;
+    }
+  }
   auto max_trip_count = ctx->evaluated_value_map[n->input(0)];
   auto start_cond = ctx->evaluated_value_map[n->input(1)];
   ctx->evaluated_value_map[n->blocks()[0]->inputs()[0]] = torch::jit::IValue(0);
@@ -381,7 +882,7 @@ void EvaluateLoopBlock(ConversionCtx* ctx, const torch::jit::Node* n) {
         EvaluateConditionalBlock(ctx, bn, true);
       } else {
         TORCHTRT_CHECK(
-            evaluators::shouldEvalAtConversionTime(bn),
+            GetNodeDispatch(bn) == NodeDispatch::kEvaluator,
             "Torch-TensorRT.TorchScript currently can only compile loops that are evaluatable at conversion time but node "
                 << *bn << " cannot be evaluated.");
         auto eval = EvaluateNode(ctx, bn);
@@ -405,6 +906,71 @@ void EvaluateLoopBlock(ConversionCtx* ctx, const torch::jit::Node* n) {
   }
 }
 
+// Evaluates or converts a single node, control flow nodes are evaluated at conversion time or converted to TensorRT
+// control flow
+void ConvertNode(ConversionCtx* ctx, const torch::jit::Node* n) {
+  bool to_eval = GetNodeDispatch(n) == NodeDispatch::kEvaluator;
+  bool ignored = isNodeConversionIgnored(n);
+  if (n->kind() == torch::jit::prim::Loop) {
+    EvaluateLoopBlock(ctx, n);
+  } else if (n->kind() == torch::jit::prim::If) {
+    EvaluateConditionalBlock(ctx, n);
+  } else if (to_eval) {
+    auto eval = EvaluateNode(ctx, n);
+    if (eval) {
+      if (n->outputs().size() > 1) { // For ListUnpack scenario
+        if (eval.value().isTuple()) {
+          auto eval_list = eval.value().toTuple();
+          TORCHTRT_CHECK(
+              eval_list->elements().size() == n->outputs().size(),
+              "Size of evaluated results: " << eval_list->elements().size()
+                                            << " and node outputs size: " << n->outputs().size() << " must match.");
+          for (size_t i = 0; i < eval_list->elements().size(); i++) {
+            auto eval_output = eval_list.get()->elements()[i];
+            if (eval_output.isCustomClass()) {
+              auto container = eval_output.toCustomClass<TensorContainer>();
+              auto tensor = container->tensor();
+              LOG_DEBUG(
+                  ctx->logger, "Found the evaluated value(s) to be an ITensor of shape: " << tensor->getDimensions());
+              ctx->AssociateValueAndTensor(n->output(i), tensor);
+            } else {
+              LOG_DEBUG(
+                  ctx->logger,
+                  "Found the evaluated value(s) to be " << eval_output << " for node: " << util::node_info(n));
+              ctx->AssociateValueAndIValue(n->output(i), eval_output);
+            }
+          }
+        } else {
+          TORCHTRT_THROW_ERROR("Unsupported return type for evaluated node");
+        }
+      } else if (eval.value().isCustomClass()) {
+        auto container = eval.value().toCustomClass<TensorContainer>();
+        auto tensor = container->tensor();
+        LOG_DEBUG(ctx->logger, "Found the value to be an ITensor of shape: " << tensor->getDimensions());
+        ctx->AssociateValueAndTensor(n->output(0), tensor);
+      } else if (!eval.value().isTensor()) {
+        LOG_DEBUG(ctx->logger, "Found the value to be: " << eval.value());
+        ctx->AssociateValueAndIValue(n->output(0), eval.value());
+      } else {
+        LOG_DEBUG(ctx->logger, "Found the value to be a tensor (shape " << eval.value().toTensor().sizes() << ')');
+        ctx->AssociateValueAndIValue(n->output(0), eval.value());
+      }
+    }
+  } else if (!ignored) {
+    // Should error out if something fails
+    AddLayer(ctx, n);
+  } else {
+    std::string reason = "";
+    if (to_eval) {
+      reason += " (to be evaluated)";
+    }
+    if (ignored) {
+      reason += " (explicitly ignored)";
+    }
+    LOG_DEBUG(ctx->logger, "Skipping Node: " << util::node_info(n) << reason);
+  }
+}
+
 void ConvertBlockToNetDef(
     ConversionCtx* ctx,
     const torch::jit::Block* b,
@@ -420,66 +986,7 @@ void ConvertBlockToNetDef(
   auto nodes = b->nodes();
 
   for (const auto n : nodes) {
-    bool to_eval = evaluators::shouldEvalAtConversionTime(n);
-    bool ignored = isNodeConversionIgnored(n);
-    if (n->kind() == torch::jit::prim::Loop) {
-      EvaluateLoopBlock(ctx, n);
-    } else if (n->kind() == torch::jit::prim::If) {
-      EvaluateConditionalBlock(ctx, n);
-    } else if (to_eval) {
-      auto eval = EvaluateNode(ctx, n);
-      if (eval) {
-        if (n->outputs().size() > 1) { // For ListUnpack scenario
-          if (eval.value().isTuple()) {
-            auto eval_list = eval.value().toTuple();
-            TORCHTRT_CHECK(
-                eval_list->elements().size() == n->outputs().size(),
-                "Size of evaluated results: " << eval_list->elements().size()
-                                              << " and node outputs size: " << n->outputs().size() << " must match.");
-            for (size_t i = 0; i < eval_list->elements().size(); i++) {
-              auto eval_output = eval_list.get()->elements()[i];
-              if (eval_output.isCustomClass()) {
-                auto container = eval_output.toCustomClass<TensorContainer>();
-                auto tensor = container->tensor();
-                LOG_DEBUG(
-                    ctx->logger, "Found the evaluated value(s) to be an ITensor of shape: " << tensor->getDimensions());
-                ctx->AssociateValueAndTensor(n->output(i), tensor);
-              } else {
-                LOG_DEBUG(
-                    ctx->logger,
-                    "Found the evaluated value(s) to be " << eval_output << " for node: " << util::node_info(n));
-                ctx->AssociateValueAndIValue(n->output(i), eval_output);
-              }
-            }
-          } else {
-            TORCHTRT_THROW_ERROR("Unsupported return type for evaluated node");
-          }
-        } else if (eval.value().isCustomClass()) {
-          auto container = eval.value().toCustomClass<TensorContainer>();
-          auto tensor = container->tensor();
-          LOG_DEBUG(ctx->logger, "Found the value to be an ITensor of shape: " << tensor->getDimensions());
-          ctx->AssociateValueAndTensor(n->output(0), tensor);
-        } else if (!eval.value().isTensor()) {
-          LOG_DEBUG(ctx->logger, "Found the value to be: " << eval.value());
-          ctx->AssociateValueAndIValue(n->output(0), eval.value());
-        } else {
-          LOG_DEBUG(ctx->logger, "Found the value to be a tensor (shape " << eval.value().toTensor().sizes() << ')');
-          ctx->AssociateValueAndIValue(n->output(0), eval.value());
-        }
-      }
-    } else if (!ignored) {
-      // Should error out if something fails
-      AddLayer(ctx, n);
-    } else {
-      std::string reason = "";
-      if (to_eval) {
-        reason += " (to be evaluated)";
-      }
-      if (ignored) {
-        reason += " (explicitly ignored)";
-      }
-      LOG_DEBUG(ctx->logger, "Skipping Node: " << util::node_info(n) << reason);
-    }
+    ConvertNode(ctx, n);
   }
 
   for (const auto n : nodes) {
@@ -494,16 +1001,118 @@ void ConvertBlockToNetDef(
 // a serialized TensorRT engine that can be deserialized and run
 
 // Probably should consolidate these two functions
-std::string ConvertBlockToEngine(
+util::SerializedEngine ConvertBlockToEngine(
     const torch::jit::Block* b,
     ConversionInfo build_info,
-    ir::StaticParams& static_params) {
+    ir::StaticParams& static_params,
+    const std::string& known_cache_key) {
+  std::string cache_key;
+  bool selects_tactics = !build_info.engine_settings.tactic_record_path.empty() ||
+      !build_info.engine_settings.tactic_replay_path.empty();
+  if (build_info.engine_cache) {
+    if (build_info.engine_settings.calibrator) {
+      // The calibration data is not part of the key
+      LOG_DEBUG("Engine cache is not used for engines built with an INT8 calibrator");
+    } else if (selects_tactics) {
+      // A cached engine would neither report its tactics nor be built with the replayed ones
+      LOG_DEBUG("Engine cache is not used for engines whose tactics are recorded or replayed");
+    } else {
+      cache_key = !known_cache_key.empty()
+          ? known_cache_key
+          : EngineCacheKey(
+                b, build_info.engine_settings, build_info.inputs, build_info.collection_input_spec_map, static_params);
+      if (auto cached = build_info.engine_cache->load(cache_key)) {
+        LOG_INFO("Reusing engine " << cache_key << " from the engine cache");
+        return *cached;
+      }
+    }
+  }
+
   ConversionCtx ctx(build_info.engine_settings);
-  ConvertBlockToNetDef(&ctx, b, build_info, static_params);
-  std::string engine = ctx.SerializeEngine();
+  if (selects_tactics) {
+    // Keyed like the engine cache so the tactics of a segment are found again as long as it is unchanged
+    ctx.AttachTacticSelector(
+        !known_cache_key.empty()
+            ? known_cache_key
+            : EngineCacheKey(
+                  b, build_info.engine_settings, build_info.inputs, build_info.collection_input_spec_map, static_params));
+  }
+  {
+    TORCHTRT_NVTX_RANGE("torch_tensorrt::conversion");
+    TORCHTRT_COMPILE_PHASE("conversion");
+    ConvertBlockToNetDef(&ctx, b, build_info, static_params);
+  }
+  auto engine = ctx.SerializeEngine();
+  if (!cache_key.empty()) {
+    build_info.engine_cache->save(cache_key, engine);
+  }
   return engine;
 }
 
+namespace {
+void AddRefitWeights(
+    std::unordered_map<std::string, at::Tensor>& refit_weights,
+    const nvinfer1::ILayer* layer,
+    const std::string& role,
+    const nvinfer1::Weights& w) {
+  if (w.count == 0 || w.values == nullptr) {
+    return;
+  }
+  auto dtype = util::TRTDataTypeToScalarType(w.type);
+  auto t = at::empty({w.count}, at::TensorOptions().dtype(dtype));
+  memcpy(t.data_ptr(), w.values, t.nbytes());
+  refit_weights[std::string(layer->getName()) + " " + role] = std::move(t);
+}
+} // namespace
+
+std::unordered_map<std::string, at::Tensor> ConvertBlockToRefitWeights(
+    const torch::jit::Block* b,
+    ConversionInfo build_info,
+    ir::StaticParams& static_params) {
+  ConversionCtx ctx(build_info.engine_settings);
+  {
+    TORCHTRT_NVTX_RANGE("torch_tensorrt::conversion");
+    ConvertBlockToNetDef(&ctx, b, build_info, static_params);
+  }
+  ctx.SyncWeightCopies();
+
+  // The weights are copied out since the network only points at buffers owned by the context
+  std::unordered_map<std::string, at::Tensor> refit_weights;
+  for (int32_t i = 0; i < ctx.net->getNbLayers(); i++) {
+    auto layer = ctx.net->getLayer(i);
+    switch (layer->getType()) {
+      case nvinfer1::LayerType::kCONVOLUTION: {
+        auto conv = static_cast<nvinfer1::IConvolutionLayer*>(layer);
+        AddRefitWeights(refit_weights, layer, "KERNEL", conv->getKernelWeights());
+        AddRefitWeights(refit_weights, layer, "BIAS", conv->getBiasWeights());
+        break;
+      }
+      case nvinfer1::LayerType::kDECONVOLUTION: {
+        auto deconv = static_cast<nvinfer1::IDeconvolutionLayer*>(layer);
+        AddRefitWeights(refit_weights, layer, "KERNEL", deconv->getKernelWeights());
+        AddRefitWeights(refit_weights, layer, "BIAS", deconv->getBiasWeights());
+        break;
+      }
+      case nvinfer1::LayerType::kSCALE: {
+        auto scale = static_cast<nvinfer1::IScaleLayer*>(layer);
+        AddRefitWeights(refit_weights, layer, "SCALE", scale->getScale());
+        AddRefitWeights(refit_weights, layer, "SHIFT", scale->getShift());
+        AddRefitWeights(refit_weights, layer, "POWER", scale->getPower());
+        break;
+      }
+      case nvinfer1::LayerType::kCONSTANT: {
+        auto constant = static_cast<nvinfer1::IConstantLayer*>(layer);
+        AddRefitWeights(refit_weights, layer, "CONSTANT", constant->getWeights());
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  LOG_DEBUG(ctx.logger, "Found " << refit_weights.size() << " refittable weights in the converted block");
+  return refit_weights;
+}
+
 std::unordered_map<c10::OperatorName, std::string> GetUnsupportedOpsInBlock(const torch::jit::Block* b) {
   std::unordered_map<c10::OperatorName, std::string> unsupported_ops;
   for (const auto n : b->nodes()) {
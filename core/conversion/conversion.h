@@ -1,9 +1,12 @@
 #pragma once
 
 #include <map>
+#include <string>
+#include <unordered_map>
 
 #include "NvInfer.h"
 #include "core/conversion/conversionctx/ConversionCtx.h"
+#include "core/conversion/conversionctx/EngineCache.h"
 #include "core/ir/ir.h"
 #include "torch/csrc/jit/ir/ir.h"
 
@@ -15,15 +18,57 @@ struct ConversionInfo {
   ir::InputSpecMap inputs;
   ir::CollectionInputSpecMap collection_input_spec_map;
   BuilderSettings engine_settings;
+  // Engines are looked up in and added to the cache if set
+  std::shared_ptr<BaseEngineCache> engine_cache = nullptr;
 };
 
 // Converts a already lowered block (blocks with no sub blocks) to
-// a serialized TensorRT engine that can be deserialized and run
-std::string ConvertBlockToEngine(
+// a serialized TensorRT engine that can be deserialized and run. cache_key is the EngineCacheKey of the build if the
+// caller already computed it
+util::SerializedEngine ConvertBlockToEngine(
+    const torch::jit::Block* b,
+    ConversionInfo build_info,
+    ir::StaticParams& static_params,
+    const std::string& cache_key = "");
+
+// Converts a lowered block like ConvertBlockToEngine but stops at the network definition and returns the weights of
+// its layers, copied to host tensors, by the names TensorRT gives them in a refittable engine ("<layer name> KERNEL",
+// "BIAS", "SCALE", "SHIFT", "POWER" or "CONSTANT"). Converting the block an engine was built from with new weights
+// gives the weights to refit the engine with
+std::unordered_map<std::string, at::Tensor> ConvertBlockToRefitWeights(
     const torch::jit::Block* b,
     ConversionInfo build_info,
     ir::StaticParams& static_params);
 
+// How conversion handles a node: evaluated at conversion time, converted to layers, or neither
+enum class NodeDispatch { kEvaluator, kConverter, kUnsupported };
+
+// Dispatch of n, looked up in the evaluator and converter registries unless a NodeDispatchCache has it
+NodeDispatch GetNodeDispatch(const torch::jit::Node* n);
+
+// Remembers the dispatch of each node on the current thread while it is alive, so the support checks, partitioning
+// and conversion of a compilation resolve every node through the registries once. Entries are revalidated against the
+// kind, schema and output types of the node, which is all the dispatch depends on, so the graphs may change meanwhile
+class NodeDispatchCache {
+ public:
+  NodeDispatchCache();
+  ~NodeDispatchCache();
+  NodeDispatchCache(const NodeDispatchCache&) = delete;
+  NodeDispatchCache& operator=(const NodeDispatchCache&) = delete;
+
+  NodeDispatch get(const torch::jit::Node* n);
+
+ private:
+  struct Entry {
+    torch::jit::NodeKind kind;
+    const c10::FunctionSchema* schema;
+    std::vector<c10::TypePtr> output_types;
+    NodeDispatch dispatch;
+  };
+  std::unordered_map<const torch::jit::Node*, Entry> entries_;
+  NodeDispatchCache* previous_;
+};
+
 bool OpSupported(const torch::jit::Node* n);
 
 bool InputIsCollection(const torch::jit::Block* b);
@@ -32,11 +77,8 @@ bool OutputIsCollection(const torch::jit::Block* b);
 
 bool VerifyConverterSupportForBlock(const torch::jit::Block* b, bool suppress_errors = false);
 
-c10::optional<torch::jit::IValue> EvaluateNode(
-    ConversionCtx* ctx,
-    const torch::jit::Node* n,
-    int level = 0,
-    int limit = 10);
+// Evaluates n, first evaluating (and memoizing in ctx) every input of it which has not been evaluated yet
+c10::optional<torch::jit::IValue> EvaluateNode(ConversionCtx* ctx, const torch::jit::Node* n);
 
 } // namespace conversion
 } // namespace core
@@ -1,12 +1,74 @@
 #include "core/conversion/conversionctx/ConversionCtx.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <sstream>
 #include <utility>
 
+#include "ATen/cuda/CUDAEvent.h"
+
 namespace torch_tensorrt {
 namespace core {
 namespace conversion {
 
+#if NV_TENSORRT_MAJOR >= 10
+namespace {
+// Records the phases of the TensorRT builder as "build/<phase>" compile phases and samples the device memory at every
+// builder step, which gives the build phase a much closer GPU memory peak than its start and end alone
+class CompileProgressMonitor : public nvinfer1::IProgressMonitor {
+ public:
+  CompileProgressMonitor(util::CompileProfiler* profiler, std::string segment)
+      : profiler(profiler), segment(std::move(segment)) {}
+
+  void phaseStart(const char* phase_name, const char* parent_phase, int32_t nb_steps) noexcept override {
+    try {
+      open_phases[phase_name] = {std::chrono::steady_clock::now(), util::gpu_memory_in_use()};
+    } catch (...) {
+    }
+  }
+
+  bool stepComplete(const char* phase_name, int32_t step) noexcept override {
+    auto gpu_bytes = util::gpu_memory_in_use();
+    for (auto& p : open_phases) {
+      p.second.peak_gpu_bytes = std::max(p.second.peak_gpu_bytes, gpu_bytes);
+    }
+    util::sample_compile_gpu_memory();
+    return true;
+  }
+
+  void phaseFinish(const char* phase_name) noexcept override {
+    try {
+      auto it = open_phases.find(phase_name);
+      if (it == open_phases.end()) {
+        return;
+      }
+      util::CompilePhaseRecord r;
+      r.phase = std::string("build/") + phase_name;
+      r.segment = segment;
+      r.wall_time_ns =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - it->second.start)
+              .count();
+      r.peak_host_bytes = util::host_peak_rss_bytes();
+      r.peak_gpu_bytes = std::max(it->second.peak_gpu_bytes, util::gpu_memory_in_use());
+      open_phases.erase(it);
+      profiler->record(std::move(r));
+    } catch (...) {
+    }
+  }
+
+ private:
+  struct OpenPhase {
+    std::chrono::steady_clock::time_point start;
+    int64_t peak_gpu_bytes;
+  };
+
+  util::CompileProfiler* profiler;
+  std::string segment;
+  std::map<std::string, OpenPhase> open_phases;
+};
+} // namespace
+#endif
+
 // clang-format off
 std::ostream& operator<<(std::ostream& os, const BuilderSettings& s) {
     os << "Settings requested for TensorRT engine:"                                        \
@@ -17,14 +79,26 @@ std::ostream& operator<<(std::ostream& os, const BuilderSettings& s) {
     os << "\n    TF32 Floating Point Computation Enabled: " << !s.disable_tf32             \
        << "\n    Truncate Long and Double: " << s.truncate_long_and_double                 \
        << "\n    Make Refittable Engine: " << s.refit                                      \
+       << "\n    Strip Engine Weights: " << s.strip_weights                                \
        << "\n    Debuggable Engine: " << s.debug                                           \
+       << "\n    Detailed Layer Info: " << s.detailed_layer_info                           \
        << "\n    GPU ID: " << s.device.gpu_id                                              \
        << "\n    Allow GPU Fallback (if running on DLA): " << s.device.allow_gpu_fallback  \
        << "\n    Avg Timing Iterations: " << s.num_avg_timing_iters                        \
+       << "\n    Fast Build: " << s.fast_build                                             \
+       << "\n    Max Aux Streams: " << s.max_aux_streams                                   \
+       << "\n    Version Compatible: " << s.version_compatible                             \
+       << "\n    Exclude Lean Runtime: " << s.exclude_lean_runtime                         \
+       << "\n    Strongly Typed: " << s.strongly_typed                                     \
+       << "\n    Weight Streaming: " << s.weight_streaming                                 \
+       << "\n    Alias Outputs: " << s.alias_outputs                                       \
        << "\n    Max Workspace Size: " << s.workspace_size                                 \
        << "\n    DLA SRAM Size: " << s.dla_sram_size                                       \
        << "\n    DLA Local DRAM Size: " << s.dla_local_dram_size                           \
-       << "\n    DLA Global DRAM Size: " << s.dla_global_dram_size;
+       << "\n    DLA Global DRAM Size: " << s.dla_global_dram_size                         \
+       << "\n    Timing Cache Path: " << s.timing_cache_path                             \
+       << "\n    Tactic Record Path: " << s.tactic_record_path                           \
+       << "\n    Tactic Replay Path: " << s.tactic_replay_path;
 
     os << "\n    Device Type: " << s.device.device_type                                    \
        << "\n    GPU ID: " << s.device.gpu_id;
@@ -33,71 +107,164 @@ std::ostream& operator<<(std::ostream& os, const BuilderSettings& s) {
     }
     os << "\n    Engine Capability: " << s.capability                                      \
        << "\n    Calibrator Created: " << (s.calibrator != nullptr);
+    for (auto& c : s.layer_precisions) {
+    os << "\n    Layer Precision: " << c.first << " -> " << c.second;
+    }
+    for (size_t i = 0; i < s.output_formats.size(); i++) {
+    os << "\n    Output " << i << " Format: " << s.output_formats[i];
+    }
     return os;
 }
 // clang-format on
 
 ConversionCtx::ConversionCtx(BuilderSettings build_settings)
-    : settings(build_settings),
+    : device_guard(static_cast<c10::DeviceIndex>(build_settings.device.gpu_id)),
+      settings(build_settings),
       logger(
           "[Torch-TensorRT TorchScript Conversion Context] - ",
           util::logging::get_logger().get_reportable_severity(),
           util::logging::get_logger().get_is_colored_output_on()) {
   // TODO: Support FP16 and FP32 from JIT information
-  if (settings.device.gpu_id) {
-    TORCHTRT_CHECK(
-        cudaSetDevice(settings.device.gpu_id) == cudaSuccess, "Unable to set gpu id: " << settings.device.gpu_id);
-  }
-
   builder = make_trt(nvinfer1::createInferBuilder(logger));
-  net = make_trt(
-      builder->createNetworkV2(1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH)));
+  util::apply_torch_gpu_allocator(*builder);
+  auto network_flags = 1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH);
+#if NV_TENSORRT_MAJOR >= 10
+  if (settings.strongly_typed) {
+    network_flags |= 1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kSTRONGLY_TYPED);
+  }
+#else
+  TORCHTRT_CHECK(!settings.strongly_typed, "Strongly typed networks require TensorRT 10 or later");
+#endif
+  net = make_trt(builder->createNetworkV2(network_flags));
 
   LOG_INFO(settings);
   cfg = make_trt(builder->createBuilderConfig());
 
-  for (auto p = settings.enabled_precisions.begin(); p != settings.enabled_precisions.end(); ++p) {
-    switch (*p) {
-      case nvinfer1::DataType::kHALF:
-        TORCHTRT_CHECK(
-            builder->platformHasFastFp16(), "Requested inference in FP16 but platform does not support FP16");
-        cfg->setFlag(nvinfer1::BuilderFlag::kFP16);
-        break;
-      case nvinfer1::DataType::kINT8:
-        TORCHTRT_CHECK(
-            builder->platformHasFastInt8(), "Requested inference in INT8 but platform does not support INT8");
-        cfg->setFlag(nvinfer1::BuilderFlag::kINT8);
-        if (!settings.calibrator) {
-          LOG_INFO(
-              "Int8 precision has been enabled but no calibrator provided. This assumes the network has Q/DQ nodes obtained from Quantization aware training. For more details, refer to https://docs.nvidia.com/deeplearning/tensorrt/developer-guide/index.html#work-with-qat-networks");
-        } else {
-          cfg->setInt8Calibrator(settings.calibrator);
+  if (settings.strongly_typed) {
+    // TensorRT rejects precision flags and per layer precisions for strongly typed networks, the types of the
+    // network tensors decide the precision of each layer
+    TORCHTRT_CHECK(
+        settings.layer_precisions.empty(), "Layer precisions cannot be combined with a strongly typed network");
+    TORCHTRT_CHECK(
+        !settings.calibrator, "Strongly typed networks cannot be calibrated, quantize them with Q/DQ nodes instead");
+    LOG_INFO("Building a strongly typed network, enabled precisions are taken from the tensor types of the graph");
+  } else {
+    for (auto p = settings.enabled_precisions.begin(); p != settings.enabled_precisions.end(); ++p) {
+      switch (*p) {
+        case nvinfer1::DataType::kHALF:
+          TORCHTRT_CHECK(
+              builder->platformHasFastFp16(), "Requested inference in FP16 but platform does not support FP16");
+          cfg->setFlag(nvinfer1::BuilderFlag::kFP16);
+          break;
+        case nvinfer1::DataType::kBF16: {
+          // BF16 tensor cores start with Ampere (compute capability 8.0)
+          cudaDeviceProp prop;
+          TORCHTRT_CHECK(
+              cudaGetDeviceProperties(&prop, settings.device.gpu_id) == cudaSuccess,
+              "Unable to query the properties of gpu id: " << settings.device.gpu_id);
+          TORCHTRT_CHECK(
+              prop.major >= 8,
+              "Requested inference in BF16 but platform (compute capability " << prop.major << '.' << prop.minor
+                                                                           << ") does not support BF16");
+          cfg->setFlag(nvinfer1::BuilderFlag::kBF16);
+          break;
+        }
+        case nvinfer1::DataType::kINT8:
+          TORCHTRT_CHECK(
+              builder->platformHasFastInt8(), "Requested inference in INT8 but platform does not support INT8");
+          cfg->setFlag(nvinfer1::BuilderFlag::kINT8);
+          if (!settings.calibrator) {
+            LOG_INFO(
+                "Int8 precision has been enabled but no calibrator provided. This assumes the network has Q/DQ nodes obtained from Quantization aware training. For more details, refer to https://docs.nvidia.com/deeplearning/tensorrt/developer-guide/index.html#work-with-qat-networks");
+          } else {
+            cfg->setInt8Calibrator(settings.calibrator);
+          }
+          break;
+#if NV_TENSORRT_MAJOR >= 10
+        case nvinfer1::DataType::kFP8: {
+          // FP8 tensor cores start with Ada (compute capability 8.9)
+          cudaDeviceProp prop;
+          TORCHTRT_CHECK(
+              cudaGetDeviceProperties(&prop, settings.device.gpu_id) == cudaSuccess,
+              "Unable to query the properties of gpu id: " << settings.device.gpu_id);
+          TORCHTRT_CHECK(
+              prop.major * 10 + prop.minor >= 89,
+              "Requested inference in FP8 but platform (compute capability " << prop.major << '.' << prop.minor
+                                                                           << ") does not support FP8");
+          cfg->setFlag(nvinfer1::BuilderFlag::kFP8);
+          break;
         }
-        break;
-      case nvinfer1::DataType::kFLOAT:
-        break;
-      case nvinfer1::DataType::kINT32:
-      case nvinfer1::DataType::kBOOL:
-      default:
-        TORCHTRT_THROW_ERROR(
-            "Requested kernel precision that is unsupported: " << *p << " options are float, half, int8");
+        case nvinfer1::DataType::kINT4:
+          // INT4 is only used for weights, which the network dequantizes with block Q/DQ layers
+          cfg->setFlag(nvinfer1::BuilderFlag::kINT4);
+          break;
+#endif
+        case nvinfer1::DataType::kFLOAT:
+          break;
+        case nvinfer1::DataType::kINT32:
+        case nvinfer1::DataType::kBOOL:
+        default:
+          TORCHTRT_THROW_ERROR(
+              "Requested kernel precision that is unsupported: "
+              << *p << " options are float, half, bfloat16, int8, fp8, int4");
+      }
     }
   }
 
   enabled_precisions = settings.enabled_precisions;
 
+  for (auto& c : settings.layer_precisions) {
+    TORCHTRT_CHECK(
+        c.second == nvinfer1::DataType::kFLOAT ||
+            ((c.second == nvinfer1::DataType::kHALF || c.second == nvinfer1::DataType::kBF16) &&
+             enabled_precisions.count(c.second)),
+        "Layer precision " << c.second << " requested for " << c.first
+                           << " has to be float, or half or bfloat16 when it is in the enabled precisions");
+  }
+  if (!settings.layer_precisions.empty()) {
+    cfg->setFlag(nvinfer1::BuilderFlag::kOBEY_PRECISION_CONSTRAINTS);
+  }
+
   if (settings.disable_tf32) {
     cfg->clearFlag(nvinfer1::BuilderFlag::kTF32);
   }
 #if NV_TENSORRT_MAJOR > 7
   if (settings.sparse_weights) {
     cfg->setFlag(nvinfer1::BuilderFlag::kSPARSE_WEIGHTS);
+    // Records the tactic of every layer in the engine, so the layers that run sparse tactics can be found
+    cfg->setProfilingVerbosity(nvinfer1::ProfilingVerbosity::kDETAILED);
+  }
+  if (settings.detailed_layer_info) {
+    cfg->setProfilingVerbosity(nvinfer1::ProfilingVerbosity::kDETAILED);
   }
 #endif
   if (settings.refit) {
     cfg->setFlag(nvinfer1::BuilderFlag::kREFIT);
   }
 
+  if (settings.strip_weights) {
+    TORCHTRT_CHECK(
+        settings.capability != TRT_ENGINE_CAPABILITY_DLA_STANDALONE,
+        "Weights cannot be stripped from DLA standalone loadables, they are not refittable");
+#if NV_TENSORRT_MAJOR >= 10
+    // Lets the builder optimize for the weights it builds with, which are the ones the engine is refit with
+    if (!settings.refit) {
+      cfg->setFlag(nvinfer1::BuilderFlag::kREFIT_IDENTICAL);
+    }
+#else
+    TORCHTRT_THROW_ERROR("Weight stripped engines require TensorRT 10 or later");
+#endif
+  }
+
+  if (settings.weight_streaming) {
+    TORCHTRT_CHECK(settings.strongly_typed, "Weight streaming requires a strongly typed network");
+#if NV_TENSORRT_MAJOR >= 10
+    cfg->setFlag(nvinfer1::BuilderFlag::kWEIGHT_STREAMING);
+#else
+    TORCHTRT_THROW_ERROR("Weight streaming requires TensorRT 10 or later");
+#endif
+  }
+
   if (settings.debug) {
     cfg->setFlag(nvinfer1::BuilderFlag::kDEBUG);
   }
@@ -107,10 +274,50 @@ ConversionCtx::ConversionCtx(BuilderSettings build_settings)
   }
 
   cfg->setAvgTimingIterations(settings.num_avg_timing_iters);
+  if (settings.fast_build) {
+    // Level 0 skips most of the tactic search, restricting the tactic sources to TensorRT's own kernels avoids
+    // loading and timing the cuBLAS/cuDNN/JIT tactics for whatever search remains
+    cfg->setBuilderOptimizationLevel(0);
+    cfg->setTacticSources(0);
+    cfg->setAvgTimingIterations(1);
+  }
+  TORCHTRT_CHECK(
+      settings.max_aux_streams >= -1,
+      "Max aux streams must be -1 (chosen by TensorRT) or greater, got " << settings.max_aux_streams);
+  if (settings.max_aux_streams >= 0) {
+    cfg->setMaxAuxStreams(static_cast<int32_t>(settings.max_aux_streams));
+  }
+  TORCHTRT_CHECK(
+      settings.version_compatible || !settings.exclude_lean_runtime,
+      "Excluding the lean runtime from engines requires building them version compatible");
+  if (settings.version_compatible) {
+    TORCHTRT_CHECK(
+        settings.device.device_type == nvinfer1::DeviceType::kGPU,
+        "Version compatible engines can only be built for GPUs");
+    cfg->setFlag(nvinfer1::BuilderFlag::kVERSION_COMPATIBLE);
+    if (settings.exclude_lean_runtime) {
+      cfg->setFlag(nvinfer1::BuilderFlag::kEXCLUDE_LEAN_RUNTIME);
+    }
+  }
   if (settings.workspace_size != 0) {
     cfg->setMemoryPoolLimit(nvinfer1::MemoryPoolType::kWORKSPACE, settings.workspace_size);
   }
 
+  if (!settings.timing_cache_path.empty()) {
+    if (!settings.timing_cache) {
+      settings.timing_cache = std::make_shared<TimingCache>(settings.timing_cache_path);
+      owns_timing_cache = true;
+    }
+    settings.timing_cache->attach(*cfg);
+  }
+
+#if NV_TENSORRT_MAJOR >= 10
+  if (auto profiler = util::current_compile_profiler()) {
+    progress_monitor = std::make_unique<CompileProgressMonitor>(profiler, util::current_compile_segment());
+    cfg->setProgressMonitor(progress_monitor.get());
+  }
+#endif
+
   cfg->setDefaultDeviceType(settings.device.device_type);
   cfg->setEngineCapability(settings.capability);
 
@@ -136,6 +343,18 @@ ConversionCtx::ConversionCtx(BuilderSettings build_settings)
   }
 }
 
+void ConversionCtx::AttachTacticSelector(const std::string& engine_key) {
+  if (!settings.tactic_replay_path.empty() && !settings.tactic_replay) {
+    settings.tactic_replay = std::make_shared<TacticFile>(settings.tactic_replay_path);
+  }
+  if (!settings.tactic_record_path.empty() && !settings.tactic_record) {
+    settings.tactic_record = std::make_shared<TacticFile>(settings.tactic_record_path);
+    owns_tactic_record = true;
+  }
+  tactic_selector = std::make_unique<TacticSelector>(engine_key, settings.tactic_replay, settings.tactic_record);
+  cfg->setAlgorithmSelector(tactic_selector.get());
+}
+
 ConversionCtx::~ConversionCtx() {
   for (auto ptr : builder_resources) {
     free(ptr);
@@ -162,7 +381,50 @@ void ConversionCtx::RecordNewITensor(const torch::jit::Value* value, nvinfer1::I
   }
 }
 
-std::string ConversionCtx::SerializeEngine() {
+std::string TensorInternKey(const at::Tensor& t) {
+  if (!t.defined() || !t.has_storage()) {
+    return "";
+  }
+  std::stringstream ss;
+  ss << t.storage().unsafeGetStorageImpl() << ' ' << t.data_ptr() << ' ' << t.sizes() << ' ' << t.strides() << ' '
+     << t.scalar_type() << ' ' << t.device();
+  return ss.str();
+}
+
+at::Tensor ConversionCtx::StageWeightOnHost(const at::Tensor& t) {
+  if (!t.is_cuda() || t.device().index() != device_guard.current_device().index()) {
+    // Host tensors are made contiguous by ATen's multithreaded kernels, weights on another GPU take the blocking path
+    return t.to(at::kCPU).contiguous();
+  }
+  // The layout is fixed on the GPU so the host copy is a single transfer of the final bytes
+  auto src = t.contiguous();
+  if (!weight_copy_stream) {
+    weight_copy_stream = c10::cuda::getStreamFromPool(false, src.device().index());
+  }
+  auto current = c10::cuda::getCurrentCUDAStream(src.device().index());
+  at::cuda::CUDAEvent src_ready;
+  src_ready.record(current);
+  src_ready.block(*weight_copy_stream);
+
+  c10::cuda::CUDAStreamGuard stream_guard(*weight_copy_stream);
+  auto host = at::empty(src.sizes(), src.options().device(at::kCPU).pinned_memory(true));
+  host.copy_(src, /*non_blocking=*/true);
+  // Keeps the caching allocator from handing src out again before the copy read it
+  src.record_stream(*weight_copy_stream);
+  return host;
+}
+
+void ConversionCtx::SyncWeightCopies() {
+  if (weight_copy_stream) {
+    TORCHTRT_NVTX_RANGE("torch_tensorrt::SyncWeightCopies");
+    weight_copy_stream->synchronize();
+  }
+}
+
+util::SerializedEngine ConversionCtx::SerializeEngine() {
+  TORCHTRT_NVTX_RANGE("torch_tensorrt::SerializeEngine");
+  TORCHTRT_COMPILE_PHASE("build");
+  SyncWeightCopies();
 #if NV_TENSORRT_MAJOR > 7
   auto serialized_network = make_trt(builder->buildSerializedNetwork(*net, *cfg));
   if (!serialized_network) {
@@ -173,11 +435,24 @@ std::string ConversionCtx::SerializeEngine() {
   if (!engine) {
     TORCHTRT_THROW_ERROR("Building TensorRT engine failed");
   }
-  auto serialized_network = engine->serialize();
+  auto serialized_network = make_trt(engine->serialize());
   engine->destroy();
 #endif
-  auto engine_str = std::string((const char*)serialized_network->data(), serialized_network->size());
-  return engine_str;
+  if (owns_timing_cache) {
+    settings.timing_cache->save();
+  }
+  if (owns_tactic_record) {
+    settings.tactic_record->save();
+  }
+  if (!returned_outputs.empty()) {
+    std::vector<std::string> input_names;
+    for (uint64_t i = 0; i < num_inputs; i++) {
+      input_names.push_back("input_" + std::to_string(i));
+    }
+    return util::AddOutputAliases(util::SerializedEngine(std::move(serialized_network)), input_names, returned_outputs);
+  }
+  // The engine is handed on as the builder's buffer instead of a copy of it
+  return util::SerializedEngine(std::move(serialized_network));
 }
 
 bool ConversionCtx::CheckLayerAddition(const torch::jit::Node* n) {
@@ -3,12 +3,17 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
 #include <unordered_map>
 
 #include "NvInfer.h"
+#include "c10/cuda/CUDAGuard.h"
+#include "c10/cuda/CUDAStream.h"
 #include "torch/csrc/jit/ir/ir.h"
 
 #include <cuda_runtime.h>
+#include "core/conversion/conversionctx/TacticSelector.h"
+#include "core/conversion/conversionctx/TimingCache.h"
 #include "core/ir/ir.h"
 #include "core/util/prelude.h"
 
@@ -21,17 +26,62 @@ struct BuilderSettings {
   bool sparse_weights = false;
   bool disable_tf32 = false;
   bool refit = false;
+  // Build refittable engines which are saved without their weights and refit from the weights of the source module
+  // once loaded (see TRTEngine::weights_stripped). Unless refit is set, they can only be refit with the weights they
+  // were built with
+  bool strip_weights = false;
   bool debug = false;
+  // Record the type, formats, tactic and source node of every layer in the engine for the engine inspector
+  bool detailed_layer_info = false;
   bool truncate_long_and_double = false;
   bool allow_shape_tensors = false;
   ir::Device device;
   nvinfer1::EngineCapability capability = TRT_ENGINE_CAPABILITY_STANDARD;
   nvinfer1::IInt8Calibrator* calibrator = nullptr;
   uint64_t num_avg_timing_iters = 1;
+  // Trade runtime performance for build time: lowest builder optimization level, only TensorRT's own tactics and a
+  // single timing iteration
+  bool fast_build = false;
+  // Auxiliary streams TensorRT may run independent branches of the engine on, -1: chosen by TensorRT, 0: none
+  int64_t max_aux_streams = -1;
+  // Build engines later TensorRT versions can run (BuilderFlag::kVERSION_COMPATIBLE), through the lean runtime
+  // embedded in the plan unless exclude_lean_runtime is set, in which case the runtime has to load one (see
+  // TRTEngine::lean_runtime_path)
+  bool version_compatible = false;
+  bool exclude_lean_runtime = false;
   uint64_t workspace_size = 0;
   uint64_t dla_sram_size = DLA_SRAM_SIZE;
   uint64_t dla_local_dram_size = DLA_LOCAL_DRAM_SIZE;
   uint64_t dla_global_dram_size = DLA_GLOBAL_DRAM_SIZE;
+  // TensorRT timing cache file loaded before building and written back afterwards, empty: no timing cache
+  std::string timing_cache_path = "";
+  // Cache opened from timing_cache_path shared by all engines of one compilation. If unset, each ConversionCtx opens
+  // (and saves) its own
+  std::shared_ptr<TimingCache> timing_cache = nullptr;
+  // Tactic file the tactics TensorRT chooses for every layer are recorded to once the engine is built, empty: none
+  std::string tactic_record_path = "";
+  // Tactic file every layer is restricted to the recorded tactic of, reproducing the engine the tactics were recorded
+  // from. Empty: TensorRT chooses the tactics
+  std::string tactic_replay_path = "";
+  // Files opened from the tactic paths shared by all engines of one compilation. If unset, each ConversionCtx opens
+  // (and saves) its own
+  std::shared_ptr<TacticFile> tactic_record = nullptr;
+  std::shared_ptr<TacticFile> tactic_replay = nullptr;
+  // Precision the TensorRT layers of matching nodes are constrained to, keyed by node kind (e.g. aten::layer_norm) or
+  // by module path (e.g. encoder.layers.0, which also covers the submodules of the path)
+  std::map<std::string, nvinfer1::DataType> layer_precisions = {};
+  // Create the network strongly typed: every layer runs in the type of its inputs as given by the Torch graph instead
+  // of the builder choosing among enabled_precisions
+  bool strongly_typed = false;
+  // Build engines whose weights can be streamed from host memory while they run, so engines larger than the device
+  // memory can execute. Requires a strongly typed network
+  bool weight_streaming = false;
+  // Formats the engine outputs are bound in, by output index. Outputs past the end are linear
+  std::vector<nvinfer1::TensorFormat> output_formats = {};
+  // Outputs returned a second time, or which are an input of the block, are returned by the runtime as the tensor they
+  // alias instead of being copied into a binding of their own (see util::OUTPUT_ALIASES_MAGIC). Engines handed out as
+  // plans for other runtimes are built without
+  bool alias_outputs = true;
 
   BuilderSettings() = default;
   BuilderSettings(const BuilderSettings& other) = default;
@@ -40,7 +90,15 @@ struct BuilderSettings {
 
 struct ConversionCtx {
   ConversionCtx(BuilderSettings settings);
-  std::string SerializeEngine();
+  // Records and / or replays the tactics of the engine, engine_key (its EngineCacheKey) identifies the engine in the
+  // tactic files
+  void AttachTacticSelector(const std::string& engine_key);
+  util::SerializedEngine SerializeEngine();
+  // Contiguous host copy of a weight for the builder to read. Tensors on the target GPU are made contiguous there and
+  // copied asynchronously into pinned memory, the copies are only complete after SyncWeightCopies
+  at::Tensor StageWeightOnHost(const at::Tensor& t);
+  // Waits for the weight copies started by StageWeightOnHost, called before anything reads the weights
+  void SyncWeightCopies();
   nvinfer1::ITensor* AssociateValueAndTensor(const torch::jit::Value* value, nvinfer1::ITensor* tensor);
   void RecordNewITensor(const torch::jit::Value* value, nvinfer1::ITensor* tensor);
   torch::jit::IValue* AssociateValueAndIValue(const torch::jit::Value* value, torch::jit::IValue tensor);
@@ -48,29 +106,64 @@ struct ConversionCtx {
 
   ~ConversionCtx();
 
+  // Keeps the target GPU current on the converting thread while the context lives (so the TensorRT objects below are
+  // created and destroyed on it) and gives the thread its previous device back afterwards
+  c10::cuda::CUDAGuard device_guard;
   uint64_t num_inputs = 0;
   uint64_t num_outputs = 0;
+  // Binding name or util::OutputAliasName of each output of the block, empty if no output is an alias
+  std::vector<std::string> returned_outputs;
   bool input_is_dynamic = false;
   std::shared_ptr<nvinfer1::IBuilder> builder;
   std::shared_ptr<nvinfer1::INetworkDefinition> net;
   std::shared_ptr<nvinfer1::IBuilderConfig> cfg;
   std::set<nvinfer1::DataType> enabled_precisions;
   BuilderSettings settings;
+  // Whether settings.timing_cache was opened by this context, in which case it is saved once the engine is built
+  bool owns_timing_cache = false;
+  std::unique_ptr<TacticSelector> tactic_selector;
+  // Whether settings.tactic_record was opened by this context, in which case it is saved once the engine is built
+  bool owns_tactic_record = false;
+#if NV_TENSORRT_MAJOR >= 10
+  // Reports the builder phases to the compile profiler of the thread the context was created on, if any
+  std::unique_ptr<nvinfer1::IProgressMonitor> progress_monitor;
+#endif
   util::logging::TorchTRTLogger logger;
   // Pointers to data that needs to remain alive until conversion is done
   // All data will be freed when the destructor is called
-  // The weights class is the main consumer of this, each time a weight object
-  // is constructed from a PyTorch Tensor it allocates the data here to store a
-  // copy of the values
+  // The weights class uses this for the values of weights constructed from
+  // scalars
   std::vector<void*> builder_resources;
+  // Contiguous CPU tensors backing weights constructed from PyTorch Tensors,
+  // TensorRT reads their storage directly when the engine is built
+  std::vector<at::Tensor> builder_tensors;
+  // Stream the weight copies to the host are queued on, created by the first copy
+  c10::optional<c10::cuda::CUDAStream> weight_copy_stream;
+  // Constants are interned so a tensor or scalar used by several nodes (e.g.
+  // tied weights) is only added to the network and copied to the host once.
+  // Tensors are keyed by TensorInternKey and held along with the result so
+  // their storage cannot be reused by another tensor during conversion
+  std::unordered_map<std::string, std::pair<at::Tensor, nvinfer1::ITensor*>> interned_tensor_constants;
+  std::unordered_map<std::string, nvinfer1::ITensor*> interned_scalar_constants;
+  std::unordered_map<std::string, std::pair<at::Tensor, at::Tensor>> interned_weight_tensors;
+  // Number of tensors frozen into IConstantLayers so far, used to name them
+  uint64_t num_frozen_tensors = 0;
 
   std::unordered_map<const torch::jit::Value*, nvinfer1::ITensor*> value_tensor_map;
   std::unordered_map<const torch::jit::Value*, torch::jit::IValue> evaluated_value_map;
 
+  // Outputs of expands mapped to the rank aligned tensor they broadcast, so elementwise layers can broadcast it
+  // natively instead of reading the materialized expansion
+  std::unordered_map<nvinfer1::ITensor*, nvinfer1::ITensor*> broadcast_sources;
+
   // record already named ITensors to prevent rewriting another name to the same tensor
   std::unordered_set<nvinfer1::ITensor*> seen_itensors;
 };
 
+// Identity of a tensor view: its storage, data pointer, shape, strides, dtype and device. Empty for tensors without
+// storage, which are not interned
+std::string TensorInternKey(const at::Tensor& t);
+
 } // namespace conversion
 } // namespace core
 } // namespace torch_tensorrt
@@ -0,0 +1,344 @@
+#include "core/conversion/conversionctx/EngineCache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#include "c10/util/hash.h"
+#include "cuda_runtime_api.h"
+
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace conversion {
+
+namespace {
+namespace fs = std::filesystem;
+
+const std::string kEngineExtension = ".engine";
+
+// Exclusive lock on a file held for the lifetime of the object, shared with other processes using the same file
+class FileLock {
+ public:
+  explicit FileLock(const std::string& path) {
+#ifdef _WIN32
+    handle = CreateFileA(
+        path.c_str(),
+        GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr,
+        OPEN_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    TORCHTRT_CHECK(handle != INVALID_HANDLE_VALUE, "Unable to open engine cache lock " << path);
+    OVERLAPPED overlapped = {};
+    TORCHTRT_CHECK(
+        LockFileEx(handle, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped),
+        "Unable to lock engine cache lock " << path);
+#else
+    fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    TORCHTRT_CHECK(fd >= 0, "Unable to open engine cache lock " << path);
+    TORCHTRT_CHECK(flock(fd, LOCK_EX) == 0, "Unable to lock engine cache lock " << path);
+#endif
+  }
+
+  ~FileLock() {
+#ifdef _WIN32
+    OVERLAPPED overlapped = {};
+    UnlockFileEx(handle, 0, MAXDWORD, MAXDWORD, &overlapped);
+    CloseHandle(handle);
+#else
+    flock(fd, LOCK_UN);
+    close(fd);
+#endif
+  }
+
+  FileLock(const FileLock&) = delete;
+  FileLock& operator=(const FileLock&) = delete;
+
+ private:
+#ifdef _WIN32
+  HANDLE handle;
+#else
+  int fd;
+#endif
+};
+
+std::string sha1(const std::string& data) {
+  return c10::sha1(data).str();
+}
+
+void hash_tensor(std::ostream& os, const at::Tensor& t) {
+  auto c = t.contiguous().cpu();
+  os << "Tensor(" << c.scalar_type() << ", " << c.sizes() << ", "
+     << sha1(std::string(static_cast<const char*>(c.data_ptr()), c.nbytes())) << ')';
+}
+
+void hash_ivalue(std::ostream& os, const torch::jit::IValue& v) {
+  if (v.isTensor()) {
+    hash_tensor(os, v.toTensor());
+  } else if (v.isTensorList()) {
+    for (const auto& t : v.toTensorVector()) {
+      hash_tensor(os, t);
+    }
+  } else {
+    os << v;
+  }
+}
+
+// The printed graph with value names replaced by their order of appearance, so graphs which only differ in the names
+// chosen by lowering and partitioning hash the same
+std::string canonical_graph(const torch::jit::Graph& g) {
+  auto printed = g.toString(/*print_source_locations=*/false);
+  auto is_name_char = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.'; };
+  std::unordered_map<std::string, size_t> names;
+  std::string canonical;
+  canonical.reserve(printed.size());
+  for (size_t i = 0; i < printed.size();) {
+    if (printed[i] != '%') {
+      canonical += printed[i++];
+      continue;
+    }
+    size_t end = i + 1;
+    while (end < printed.size() && is_name_char(printed[end])) {
+      end++;
+    }
+    auto name = printed.substr(i + 1, end - i - 1);
+    auto id = names.emplace(name, names.size()).first->second;
+    canonical += '%' + std::to_string(id);
+    i = end;
+  }
+  return canonical;
+}
+
+// Constant tensors are only printed as <Tensor> so their contents are hashed separately
+void hash_tensor_attributes(std::ostream& os, const torch::jit::Block* b) {
+  for (const auto n : b->nodes()) {
+    for (const auto& name : n->attributeNames()) {
+      if (n->kindOf(name) == torch::jit::AttributeKind::t) {
+        hash_tensor(os, n->t(name));
+      } else if (n->kindOf(name) == torch::jit::AttributeKind::ts) {
+        for (const auto& t : n->ts(name)) {
+          hash_tensor(os, t);
+        }
+      }
+    }
+    for (const auto sub_b : n->blocks()) {
+      hash_tensor_attributes(os, sub_b);
+    }
+  }
+}
+
+void hash_input(std::ostream& os, const ir::Input& in) {
+  os << in << " domain: [";
+  for (auto d : in.tensor_domain) {
+    os << d << ',';
+  }
+  os << ']';
+}
+
+void hash_settings(std::ostream& os, const BuilderSettings& s) {
+  // The timing cache only speeds up building, it is not part of the key
+  os << "precisions: [";
+  for (auto p : s.enabled_precisions) {
+    os << p << ',';
+  }
+  os << "] sparse_weights: " << s.sparse_weights << " disable_tf32: " << s.disable_tf32 << " refit: " << s.refit
+     << " strip_weights: " << s.strip_weights << " debug: " << s.debug << " detailed_layer_info: " << s.detailed_layer_info
+     << " truncate_long_and_double: " << s.truncate_long_and_double
+     << " allow_shape_tensors: " << s.allow_shape_tensors << " capability: " << s.capability
+     << " num_avg_timing_iters: " << s.num_avg_timing_iters << " fast_build: " << s.fast_build
+     << " max_aux_streams: " << s.max_aux_streams << " version_compatible: " << s.version_compatible
+     << " exclude_lean_runtime: " << s.exclude_lean_runtime << " strongly_typed: " << s.strongly_typed
+     << " weight_streaming: " << s.weight_streaming << " alias_outputs: " << s.alias_outputs
+     << " workspace_size: " << s.workspace_size
+     << " dla_sram_size: " << s.dla_sram_size << " dla_local_dram_size: " << s.dla_local_dram_size
+     << " dla_global_dram_size: " << s.dla_global_dram_size << " device_type: " << s.device.device_type
+     << " dla_core: " << s.device.dla_core << " allow_gpu_fallback: " << s.device.allow_gpu_fallback
+     << " layer_precisions: [";
+  for (auto& c : s.layer_precisions) {
+    os << c.first << ": " << c.second << ',';
+  }
+  os << "] output_formats: [";
+  for (auto f : s.output_formats) {
+    os << f << ',';
+  }
+  os << ']';
+}
+} // namespace
+
+DiskEngineCache::DiskEngineCache(std::string dir, uint64_t max_size) : dir(std::move(dir)), max_size(max_size) {
+  std::error_code ec;
+  fs::create_directories(this->dir, ec);
+  TORCHTRT_CHECK(!ec, "Unable to create engine cache directory " << this->dir << ": " << ec.message());
+}
+
+std::string DiskEngineCache::engine_path(const std::string& hash) const {
+  return (fs::path(dir) / (hash + kEngineExtension)).string();
+}
+
+std::optional<util::SerializedEngine> DiskEngineCache::load(const std::string& hash) {
+  auto path = engine_path(hash);
+  FileLock lock((fs::path(dir) / ".lock").string());
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) {
+    return std::nullopt;
+  }
+  std::stringstream contents;
+  contents << in.rdbuf();
+  in.close();
+  // The modification time is the last use of the engine for eviction
+  std::error_code ec;
+  fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+  return util::SerializedEngine(contents.str());
+}
+
+void DiskEngineCache::save(const std::string& hash, const util::SerializedEngine& engine) {
+  if (engine.size() > max_size) {
+    LOG_WARNING(
+        "Engine " << hash << " (" << engine.size() << "B) is larger than the engine cache (" << max_size
+                  << "B), it is not cached");
+    return;
+  }
+  auto path = engine_path(hash);
+  std::stringstream tmp_path;
+  tmp_path << path << '.' << std::hex << std::random_device{}() << ".tmp";
+
+  FileLock lock((fs::path(dir) / ".lock").string());
+  {
+    std::ofstream out(tmp_path.str(), std::ios::binary | std::ios::trunc);
+    TORCHTRT_CHECK(out.is_open(), "Unable to open " << tmp_path.str() << " to write a cached engine");
+    out.write(engine.data(), engine.size());
+    out.close();
+    TORCHTRT_CHECK(!out.fail(), "Unable to write a cached engine to " << tmp_path.str());
+  }
+  std::error_code ec;
+  fs::rename(tmp_path.str(), path, ec);
+  if (ec) {
+    std::remove(tmp_path.str().c_str());
+    TORCHTRT_THROW_ERROR("Unable to add engine " << path << " to the engine cache: " << ec.message());
+  }
+  LOG_DEBUG("Saved engine " << hash << " to the engine cache " << dir);
+  evict();
+}
+
+void DiskEngineCache::evict() {
+  struct Entry {
+    fs::path path;
+    fs::file_time_type last_used;
+    uint64_t size;
+  };
+  std::vector<Entry> entries;
+  uint64_t total = 0;
+  std::error_code ec;
+  for (const auto& f : fs::directory_iterator(dir, ec)) {
+    if (!f.is_regular_file(ec) || f.path().extension() != kEngineExtension) {
+      continue;
+    }
+    Entry e = {f.path(), f.last_write_time(ec), f.file_size(ec)};
+    total += e.size;
+    entries.push_back(std::move(e));
+  }
+  std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.last_used < b.last_used; });
+  for (const auto& e : entries) {
+    if (total <= max_size) {
+      break;
+    }
+    LOG_DEBUG("Evicting " << e.path.string() << " from the engine cache");
+    if (fs::remove(e.path, ec)) {
+      total -= e.size;
+    }
+  }
+}
+
+const std::string& DiskEngineCache::get_dir() const {
+  return dir;
+}
+
+MemoryEngineCache::MemoryEngineCache(
+    std::unordered_map<std::string, util::SerializedEngine> engines,
+    std::shared_ptr<BaseEngineCache> backing)
+    : engines(std::move(engines)), backing(std::move(backing)) {}
+
+std::optional<util::SerializedEngine> MemoryEngineCache::load(const std::string& hash) {
+  auto it = engines.find(hash);
+  if (it != engines.end()) {
+    hits++;
+    return it->second;
+  }
+  return backing ? backing->load(hash) : std::nullopt;
+}
+
+void MemoryEngineCache::save(const std::string& hash, const util::SerializedEngine& engine) {
+  if (backing) {
+    backing->save(hash, engine);
+  }
+}
+
+size_t MemoryEngineCache::size() const {
+  return engines.size();
+}
+
+size_t MemoryEngineCache::num_hits() const {
+  return hits;
+}
+
+std::string EngineCacheKey(
+    const torch::jit::Block* b,
+    const BuilderSettings& settings,
+    const ir::InputSpecMap& inputs,
+    const ir::CollectionInputSpecMap& collection_inputs,
+    const ir::StaticParams& static_params) {
+  std::stringstream ss;
+  ss << "TensorRT " << NV_TENSORRT_MAJOR << '.' << NV_TENSORRT_MINOR << '.' << NV_TENSORRT_PATCH << '\n';
+  if (settings.device.device_type == nvinfer1::DeviceType::kGPU || settings.device.allow_gpu_fallback) {
+    cudaDeviceProp prop;
+    TORCHTRT_CHECK(
+        cudaGetDeviceProperties(&prop, settings.device.gpu_id) == cudaSuccess,
+        "Unable to query the properties of GPU " << settings.device.gpu_id);
+    ss << "GPU " << prop.name << " sm_" << prop.major << prop.minor << '\n';
+  }
+  hash_settings(ss, settings);
+  ss << '\n' << canonical_graph(*b->owningGraph());
+  hash_tensor_attributes(ss, b);
+
+  for (const auto in : b->inputs()) {
+    ss << '\n';
+    auto spec = inputs.find(in);
+    if (spec != inputs.end()) {
+      hash_input(ss, spec->second);
+    }
+    auto collection_spec = collection_inputs.find(in);
+    if (collection_spec != collection_inputs.end()) {
+      for (const auto& s : collection_spec->second) {
+        hash_input(ss, s);
+      }
+    }
+    auto param = static_params.find(const_cast<torch::jit::Value*>(in));
+    if (param != static_params.end()) {
+      hash_ivalue(ss, param->second);
+    }
+  }
+  return sha1(ss.str());
+}
+
+} // namespace conversion
+} // namespace core
+} // namespace torch_tensorrt
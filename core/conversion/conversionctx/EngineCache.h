@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "torch/csrc/jit/ir/ir.h"
+
+#include "core/conversion/conversionctx/ConversionCtx.h"
+#include "core/ir/ir.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace conversion {
+
+// Storage for serialized engines keyed by the hash of everything their build depends on (see EngineCacheKey), the
+// TorchScript counterpart of torch_tensorrt.dynamo._engine_cache.BaseEngineCache
+class BaseEngineCache {
+ public:
+  virtual ~BaseEngineCache() = default;
+  virtual std::optional<util::SerializedEngine> load(const std::string& hash) = 0;
+  virtual void save(const std::string& hash, const util::SerializedEngine& engine) = 0;
+};
+
+// Engines stored as <hash>.engine files in a directory which may be shared between processes. Every access holds an
+// exclusive lock on <dir>/.lock, loading an engine marks it as recently used and saving one evicts the least recently
+// used engines until the directory fits in max_size bytes
+class DiskEngineCache : public BaseEngineCache {
+ public:
+  DiskEngineCache(std::string dir, uint64_t max_size);
+
+  std::optional<util::SerializedEngine> load(const std::string& hash) override;
+  void save(const std::string& hash, const util::SerializedEngine& engine) override;
+  const std::string& get_dir() const;
+
+ private:
+  std::string engine_path(const std::string& hash) const;
+  // Removes the least recently used engines until the cache fits in max_size. Expects the lock to be held
+  void evict();
+
+  std::string dir;
+  uint64_t max_size;
+};
+
+// Engines held in memory by hash, e.g. the engines of a previously compiled module, in front of an optional backing
+// cache which misses are looked up in and new engines are saved to. The held engines are fixed at construction so
+// concurrent builds can load from it without locking
+class MemoryEngineCache : public BaseEngineCache {
+ public:
+  MemoryEngineCache(
+      std::unordered_map<std::string, util::SerializedEngine> engines,
+      std::shared_ptr<BaseEngineCache> backing = nullptr);
+
+  std::optional<util::SerializedEngine> load(const std::string& hash) override;
+  void save(const std::string& hash, const util::SerializedEngine& engine) override;
+  size_t size() const;
+  // Number of loads served by the held engines
+  size_t num_hits() const;
+
+ private:
+  std::unordered_map<std::string, util::SerializedEngine> engines;
+  std::shared_ptr<BaseEngineCache> backing;
+  std::atomic<size_t> hits = {0};
+};
+
+// Canonical hash of the inputs of an engine build: the graph of b (independent of value names and source locations),
+// its constant tensors and static params, the input specs, the builder settings and the TensorRT version and GPU the
+// engine is built for
+std::string EngineCacheKey(
+    const torch::jit::Block* b,
+    const BuilderSettings& settings,
+    const ir::InputSpecMap& inputs,
+    const ir::CollectionInputSpecMap& collection_inputs,
+    const ir::StaticParams& static_params);
+
+} // namespace conversion
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,186 @@
+#include "core/conversion/conversionctx/TacticSelector.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace conversion {
+namespace {
+
+// Tabs and newlines separate the fields and lines of a tactic file
+std::string escape(std::string s) {
+  for (auto& c : s) {
+    if (c == '\t' || c == '\n' || c == '\r') {
+      c = ' ';
+    }
+  }
+  return s;
+}
+
+std::string tactic_signature(const nvinfer1::IAlgorithmContext& context, const nvinfer1::IAlgorithm& algorithm) {
+  std::stringstream ss;
+  auto& variant = algorithm.getAlgorithmVariant();
+  ss << variant.getImplementation() << ':' << variant.getTactic();
+  auto num_io = context.getNbInputs() + context.getNbOutputs();
+  for (int32_t i = 0; i < num_io; i++) {
+    auto io = algorithm.getAlgorithmIOInfoByIndex(i);
+    if (!io) {
+      continue;
+    }
+    ss << ' ' << static_cast<int32_t>(io->getDataType()) << '/' << io->getVectorizedDim() << '/'
+       << io->getComponentsPerElement() << '/';
+    auto strides = io->getStrides();
+    for (int32_t d = 0; d < strides.nbDims; d++) {
+      ss << (d ? "," : "") << strides.d[d];
+    }
+  }
+  return ss.str();
+}
+
+} // namespace
+
+TacticFile::TacticFile(std::string path) : path(std::move(path)) {
+  std::ifstream in(this->path);
+  if (!in.is_open()) {
+    LOG_INFO("No tactic file found at " << this->path << ", starting without recorded tactics");
+    return;
+  }
+  std::string line;
+  size_t num_tactics = 0;
+  while (std::getline(in, line)) {
+    auto first = line.find('\t');
+    auto second = first == std::string::npos ? std::string::npos : line.find('\t', first + 1);
+    if (second == std::string::npos) {
+      LOG_WARNING("Skipping malformed line of tactic file " << this->path << ": " << line);
+      continue;
+    }
+    tactics[line.substr(0, first)][line.substr(first + 1, second - first - 1)] = line.substr(second + 1);
+    num_tactics++;
+  }
+  LOG_INFO("Loaded " << num_tactics << " tactics of " << tactics.size() << " engines from " << this->path);
+}
+
+bool TacticFile::has_engine(const std::string& engine) const {
+  std::lock_guard<std::mutex> lock(mu);
+  return tactics.count(engine);
+}
+
+std::string TacticFile::find(const std::string& engine, const std::string& layer) const {
+  std::lock_guard<std::mutex> lock(mu);
+  auto e = tactics.find(engine);
+  if (e == tactics.end()) {
+    return "";
+  }
+  auto l = e->second.find(escape(layer));
+  return l == e->second.end() ? "" : l->second;
+}
+
+void TacticFile::set(const std::string& engine, const std::string& layer, const std::string& tactic) {
+  std::lock_guard<std::mutex> lock(mu);
+  tactics[engine][escape(layer)] = tactic;
+}
+
+void TacticFile::save() {
+  std::lock_guard<std::mutex> lock(mu);
+  std::stringstream tmp_path;
+  tmp_path << path << '.' << std::hex << std::random_device{}() << ".tmp";
+  size_t num_tactics = 0;
+  {
+    std::ofstream out(tmp_path.str(), std::ios::trunc);
+    TORCHTRT_CHECK(out.is_open(), "Unable to open " << tmp_path.str() << " to write the tactic file");
+    for (const auto& e : tactics) {
+      for (const auto& l : e.second) {
+        out << e.first << '\t' << l.first << '\t' << l.second << '\n';
+        num_tactics++;
+      }
+    }
+    out.close();
+    TORCHTRT_CHECK(!out.fail(), "Unable to write the tactic file to " << tmp_path.str());
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp_path.str(), path, ec);
+  if (ec) {
+    std::remove(tmp_path.str().c_str());
+    TORCHTRT_THROW_ERROR("Unable to replace tactic file " << path << ": " << ec.message());
+  }
+  LOG_INFO("Saved " << num_tactics << " tactics to " << path);
+}
+
+const std::string& TacticFile::get_path() const {
+  return path;
+}
+
+TacticSelector::TacticSelector(
+    std::string engine,
+    std::shared_ptr<TacticFile> replay,
+    std::shared_ptr<TacticFile> record)
+    : engine(std::move(engine)), replay(std::move(replay)), record(std::move(record)) {
+  if (this->replay && !this->replay->has_engine(this->engine)) {
+    LOG_WARNING(
+        "Tactic file " << this->replay->get_path() << " has no tactics for engine " << this->engine
+                       << " (the segment, its inputs or the build settings changed), TensorRT chooses its tactics");
+    this->replay = nullptr;
+  }
+}
+
+int32_t TacticSelector::selectAlgorithms(
+    const nvinfer1::IAlgorithmContext& context,
+    const nvinfer1::IAlgorithm* const* choices,
+    int32_t nb_choices,
+    int32_t* selection) noexcept {
+  auto recorded = replay ? replay->find(engine, context.getName()) : "";
+  if (!recorded.empty()) {
+    for (int32_t i = 0; i < nb_choices; i++) {
+      if (tactic_signature(context, *choices[i]) == recorded) {
+        selection[0] = i;
+        replayed++;
+        return 1;
+      }
+    }
+    LOG_DEBUG("Recorded tactic " << recorded << " of layer " << context.getName() << " is not available");
+  }
+  if (replay) {
+    missed++;
+  }
+  for (int32_t i = 0; i < nb_choices; i++) {
+    selection[i] = i;
+  }
+  return nb_choices;
+}
+
+void TacticSelector::reportAlgorithms(
+    const nvinfer1::IAlgorithmContext* const* contexts,
+    const nvinfer1::IAlgorithm* const* choices,
+    int32_t nb_algorithms) noexcept {
+  if (replay && missed > 0) {
+    LOG_WARNING(
+        "Replayed " << replayed << " tactics from " << replay->get_path() << ", " << missed
+                    << " layers were left to TensorRT");
+  } else if (replay) {
+    LOG_INFO("Replayed all " << replayed << " tactics from " << replay->get_path());
+  }
+  if (!record) {
+    return;
+  }
+  for (int32_t i = 0; i < nb_algorithms; i++) {
+    record->set(engine, contexts[i]->getName(), tactic_signature(*contexts[i], *choices[i]));
+  }
+}
+
+int64_t TacticSelector::num_replayed() const {
+  return replayed;
+}
+
+int64_t TacticSelector::num_missed() const {
+  return missed;
+}
+
+} // namespace conversion
+} // namespace core
+} // namespace torch_tensorrt
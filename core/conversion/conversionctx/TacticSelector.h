@@ -0,0 +1,66 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "NvInfer.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace conversion {
+
+// Tactics TensorRT chose for the layers of the engines of one or more builds, persisted to a file. Tactics are keyed by
+// the EngineCacheKey of their engine and by layer, each line of the file holding engine, layer and tactic separated by
+// tabs. The tactic is the implementation, tactic id and the type, strides and vectorization of every input and output
+class TacticFile {
+ public:
+  // Reads path if it exists, a missing file starts empty
+  explicit TacticFile(std::string path);
+
+  bool has_engine(const std::string& engine) const;
+  // Empty if no tactic is recorded for the layer
+  std::string find(const std::string& engine, const std::string& layer) const;
+  void set(const std::string& engine, const std::string& layer, const std::string& tactic);
+  // Writes to a temporary file next to path and renames it over path, like TimingCache::save
+  void save();
+  const std::string& get_path() const;
+
+ private:
+  std::string path;
+  std::map<std::string, std::map<std::string, std::string>> tactics;
+  mutable std::mutex mu;
+};
+
+// Algorithm selector of one engine build. Records the tactics the builder chose into record, and restricts every layer
+// with a tactic in replay to that tactic so a later build reproduces the engine. Layers without a recorded tactic, or
+// whose recorded tactic is not among the choices (e.g. on another GPU or TensorRT version), are left to the builder
+class TacticSelector : public nvinfer1::IAlgorithmSelector {
+ public:
+  TacticSelector(std::string engine, std::shared_ptr<TacticFile> replay, std::shared_ptr<TacticFile> record);
+
+  int32_t selectAlgorithms(
+      const nvinfer1::IAlgorithmContext& context,
+      const nvinfer1::IAlgorithm* const* choices,
+      int32_t nb_choices,
+      int32_t* selection) noexcept override;
+  void reportAlgorithms(
+      const nvinfer1::IAlgorithmContext* const* contexts,
+      const nvinfer1::IAlgorithm* const* choices,
+      int32_t nb_algorithms) noexcept override;
+
+  int64_t num_replayed() const;
+  int64_t num_missed() const;
+
+ private:
+  std::string engine;
+  std::shared_ptr<TacticFile> replay;
+  std::shared_ptr<TacticFile> record;
+  int64_t replayed = 0;
+  int64_t missed = 0;
+};
+
+} // namespace conversion
+} // namespace core
+} // namespace torch_tensorrt
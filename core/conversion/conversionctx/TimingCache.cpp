@@ -0,0 +1,76 @@
+#include "core/conversion/conversionctx/TimingCache.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace conversion {
+
+TimingCache::TimingCache(std::string path) : path(std::move(path)) {
+  std::ifstream in(this->path, std::ios::binary);
+  if (!in.is_open()) {
+    LOG_INFO("No timing cache found at " << this->path << ", starting from an empty timing cache");
+    return;
+  }
+  std::stringstream contents;
+  contents << in.rdbuf();
+  serialized = contents.str();
+  LOG_INFO("Loaded timing cache from " << this->path << " (" << serialized.size() << "B)");
+}
+
+void TimingCache::attach(nvinfer1::IBuilderConfig& cfg) {
+  std::lock_guard<std::mutex> lock(mu);
+  if (!cache) {
+    cache = make_trt(cfg.createTimingCache(serialized.data(), serialized.size()));
+    if (!cache && !serialized.empty()) {
+      LOG_WARNING("Timing cache " << path << " could not be read, starting from an empty timing cache");
+      cache = make_trt(cfg.createTimingCache(nullptr, 0));
+    }
+    TORCHTRT_CHECK(cache, "Unable to create a TensorRT timing cache");
+    // The ITimingCache now holds the contents
+    std::string().swap(serialized);
+  }
+  if (!cfg.setTimingCache(*cache, false)) {
+    LOG_WARNING("Timing cache " << path << " does not match the current device or TensorRT version, it is not used");
+  }
+}
+
+void TimingCache::save() {
+  std::lock_guard<std::mutex> lock(mu);
+  if (!cache) {
+    return;
+  }
+  auto blob = make_trt(cache->serialize());
+  TORCHTRT_CHECK(blob, "Unable to serialize the timing cache");
+
+  std::stringstream tmp_path;
+  tmp_path << path << '.' << std::hex << std::random_device{}() << ".tmp";
+  {
+    std::ofstream out(tmp_path.str(), std::ios::binary | std::ios::trunc);
+    TORCHTRT_CHECK(out.is_open(), "Unable to open " << tmp_path.str() << " to write the timing cache");
+    out.write(static_cast<const char*>(blob->data()), blob->size());
+    out.close();
+    TORCHTRT_CHECK(!out.fail(), "Unable to write the timing cache to " << tmp_path.str());
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp_path.str(), path, ec);
+  if (ec) {
+    std::remove(tmp_path.str().c_str());
+    TORCHTRT_THROW_ERROR("Unable to replace timing cache " << path << ": " << ec.message());
+  }
+  LOG_INFO("Saved timing cache to " << path << " (" << blob->size() << "B)");
+}
+
+const std::string& TimingCache::get_path() const {
+  return path;
+}
+
+} // namespace conversion
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "NvInfer.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace conversion {
+
+// TensorRT timing cache persisted to a file. The file is read once and a single ITimingCache is shared by every
+// builder config the cache is attached to, so the engines built in one compilation (e.g. the TensorRT segments of a
+// partitioned graph) reuse each other's tactic timings as well as those of earlier compilations
+class TimingCache {
+ public:
+  // Reads path if it exists, a missing file starts an empty cache
+  explicit TimingCache(std::string path);
+
+  // The ITimingCache is created from the first config it is attached to
+  void attach(nvinfer1::IBuilderConfig& cfg);
+  // Writes the cache to a temporary file next to path and renames it over path, so other processes never read a
+  // partially written cache. Concurrent writers do not merge their caches, the last one to finish wins
+  void save();
+  const std::string& get_path() const;
+
+ private:
+  std::string path;
+  std::string serialized;
+  std::shared_ptr<nvinfer1::ITimingCache> cache;
+  std::mutex mu;
+};
+
+} // namespace conversion
+} // namespace core
+} // namespace torch_tensorrt
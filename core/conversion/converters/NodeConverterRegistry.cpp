@@ -1,3 +1,7 @@
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+
 #include "core/conversion/converters/converters.h"
 #include "core/util/prelude.h"
 #include "torch/csrc/jit/frontend/function_schema_parser.h"
@@ -45,19 +49,24 @@ using ConverterLUT = std::unordered_map<c10::OperatorName, OpConverter>;
 
 class NodeConverterRegistry {
  public:
+  // Patterns are registered by static initializers when the library loads, their schemas are only parsed once a
+  // converter is looked up so processes which never convert anything don't pay for parsing them
+  void DeferConverter(ConversionPattern p) {
+    std::unique_lock<std::shared_mutex> lock(mu_);
+    pending_patterns_.push_back(std::move(p));
+    has_pending_ = true;
+  }
+
   bool RegisterConverter(torch::jit::FunctionSchema* signature, OpConverter& converter) {
-    LOG_DEBUG("Registering converter for " << canonical_schema_string(*signature));
-    registered_converter_schemas_.insert(c10::toString(*signature));
-    auto name = signature->operator_name();
-    auto iter = converter_lut_.find(name);
-    if (iter != converter_lut_.end()) {
-      LOG_WARNING("Overriding already registered converter " << signature->name() << ", unexpected behavior may occur");
-    }
-    converter_lut_[name] = std::move(converter);
-    return true;
+    // Keeps the registration order, a later registration overrides an earlier one
+    RegisterPendingConverters();
+    std::unique_lock<std::shared_mutex> lock(mu_);
+    return AddConverter(signature, converter);
   }
 
   OpConverter GetConverter(const torch::jit::FunctionSchema* signature) {
+    RegisterPendingConverters();
+    std::shared_lock<std::shared_mutex> lock(mu_);
     auto name = signature->operator_name();
     auto iter = converter_lut_.find(name);
     if (iter == converter_lut_.end()) {
@@ -69,8 +78,10 @@ class NodeConverterRegistry {
   }
 
   bool Convertable(const torch::jit::Node* n) {
+    RegisterPendingConverters();
     auto schema = n->maybeSchema();
     if (schema) {
+      std::shared_lock<std::shared_mutex> lock(mu_);
       auto name = schema->operator_name();
       auto iter = converter_lut_.find(name);
       if (iter == converter_lut_.end()) {
@@ -85,6 +96,8 @@ class NodeConverterRegistry {
   }
 
   std::vector<std::string> GetRegisteredConverterList() {
+    RegisterPendingConverters();
+    std::shared_lock<std::shared_mutex> lock(mu_);
     std::vector<std::string> converter_list;
     std::copy(
         registered_converter_schemas_.begin(), registered_converter_schemas_.end(), std::back_inserter(converter_list));
@@ -92,8 +105,40 @@ class NodeConverterRegistry {
   }
 
  private:
+  // Called with mu_ held exclusively
+  bool AddConverter(torch::jit::FunctionSchema* signature, OpConverter& converter) {
+    LOG_DEBUG("Registering converter for " << canonical_schema_string(*signature));
+    registered_converter_schemas_.insert(c10::toString(*signature));
+    auto name = signature->operator_name();
+    auto iter = converter_lut_.find(name);
+    if (iter != converter_lut_.end()) {
+      LOG_WARNING("Overriding already registered converter " << signature->name() << ", unexpected behavior may occur");
+    }
+    converter_lut_[name] = std::move(converter);
+    return true;
+  }
+
+  void RegisterPendingConverters() {
+    if (!has_pending_) {
+      return;
+    }
+    std::unique_lock<std::shared_mutex> lock(mu_);
+    auto patterns = std::move(pending_patterns_);
+    pending_patterns_.clear();
+    has_pending_ = false;
+    for (auto& p : patterns) {
+      auto schema = torch::jit::parseSchema(p.signature);
+      AddConverter(&schema, p.converter);
+    }
+  }
+
+  // Compilations look converters up concurrently, registrations (e.g. of a custom converter library loaded later)
+  // take the lock exclusively
+  std::shared_mutex mu_;
   ConverterLUT converter_lut_;
   std::set<std::string> registered_converter_schemas_;
+  std::vector<ConversionPattern> pending_patterns_;
+  std::atomic<bool> has_pending_{false};
 };
 
 NodeConverterRegistry& get_converter_registry() {
@@ -113,7 +158,7 @@ void register_node_converter(std::string signature, OpConverter& converter) {
 }
 
 void register_node_converter(ConversionPattern p) {
-  register_node_converter(p.signature, p.converter);
+  get_converter_registry().DeferConverter(std::move(p));
 }
 
 OpConverter get_node_converter_for(const torch::jit::FunctionSchema* signature) {
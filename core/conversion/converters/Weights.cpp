@@ -71,44 +71,43 @@ Weights::Weights(ConversionCtx* ctx, at::Tensor t) {
     this->kernel_shape.nbDims = 1;
     this->kernel_shape.d[0] = 1;
   }
-  auto t_cpu = t.to(at::kCPU);
-  t_cpu = t_cpu.contiguous();
+  // Only tensors on another device or with a non contiguous layout are copied here, once per tensor. Copies of GPU
+  // tensors are asynchronous, nothing may read t_cpu before ctx->SyncWeightCopies()
+  auto key = TensorInternKey(t);
+  auto interned = ctx->interned_weight_tensors.find(key);
+  bool is_interned = !key.empty() && interned != ctx->interned_weight_tensors.end();
+  auto t_cpu = is_interned ? interned->second.second : ctx->StageWeightOnHost(t);
   auto dtype_optional = util::optScalarTypeToTRTDataType(t_cpu.scalar_type());
   if (!dtype_optional) {
     TORCHTRT_THROW_ERROR(
         "The tensor requested to be converted to nvinfer1::Weights is of an unsupported type: "
-        << dtype_optional.value());
+        << t_cpu.scalar_type());
   }
 
-  // Store the data in the conversion context so it remains until building is
-  // complete
-
-  void* buf = nullptr;
-
-  if (dtype_optional.value() == nvinfer1::DataType::kFLOAT) {
-    buf = malloc(t_cpu.numel() * sizeof(float));
-    memcpy(buf, t_cpu.data_ptr(), t_cpu.numel() * sizeof(float));
-  } else if (dtype_optional.value() == nvinfer1::DataType::kHALF) {
-    buf = malloc(t_cpu.numel() * (sizeof(float) / 2));
-    memcpy(buf, t_cpu.data_ptr(), t_cpu.numel() * (sizeof(float) / 2));
-  } else if (dtype_optional.value() == nvinfer1::DataType::kINT8) {
-    buf = malloc(t_cpu.numel() * sizeof(char));
-    memcpy(buf, t_cpu.data_ptr(), t_cpu.numel() * sizeof(char));
-  } else if (dtype_optional.value() == nvinfer1::DataType::kINT32) {
-    buf = malloc(t_cpu.numel() * sizeof(int));
-    memcpy(buf, t_cpu.data_ptr(), t_cpu.numel() * sizeof(int));
-  } else if (dtype_optional.value() == nvinfer1::DataType::kBOOL) {
-    buf = malloc(t_cpu.numel() * sizeof(bool));
-    memcpy(buf, t_cpu.data_ptr(), t_cpu.numel() * sizeof(bool));
-  } else {
-    TORCHTRT_THROW_ERROR("Found unsupported data type for tensor to weight conversion");
+  switch (dtype_optional.value()) {
+    case nvinfer1::DataType::kFLOAT:
+    case nvinfer1::DataType::kHALF:
+    case nvinfer1::DataType::kBF16:
+    case nvinfer1::DataType::kINT8:
+    case nvinfer1::DataType::kINT32:
+    case nvinfer1::DataType::kBOOL:
+      break;
+    default:
+      TORCHTRT_THROW_ERROR("Found unsupported data type for tensor to weight conversion");
   }
 
-  ctx->builder_resources.push_back(buf);
+  // Keep a reference to the tensor in the conversion context so its storage remains until building is complete, the
+  // weights point straight at it instead of a copy
+  if (!is_interned) {
+    ctx->builder_tensors.push_back(t_cpu);
+    if (!key.empty()) {
+      ctx->interned_weight_tensors[key] = {t, t_cpu};
+    }
+  }
 
   this->data.type = dtype_optional.value();
   this->data.count = t_cpu.numel();
-  this->data.values = buf;
+  this->data.values = t_cpu.data_ptr();
 
   LOG_DEBUG(*this);
 }
@@ -1,4 +1,6 @@
 #include "core/conversion/converters/converter_util.h"
+#include <cstring>
+#include <limits>
 #include "core/util/prelude.h"
 #include "torch/torch.h"
 
@@ -83,12 +85,44 @@ nvinfer1::DataType promote_types(nvinfer1::DataType type_a, nvinfer1::DataType t
   return trt_promo_type;
 }
 
+namespace {
+
+nvinfer1::ITensor* skip_broadcast_expand(ConversionCtx* ctx, nvinfer1::ITensor* in, nvinfer1::ITensor* other) {
+  auto source = ctx->broadcast_sources.find(in);
+  if (source == ctx->broadcast_sources.end()) {
+    return in;
+  }
+  // The elementwise layer broadcasts the unexpanded tensor to the same output shape if every expanded dim is already
+  // that size in the other operand
+  auto expanded_dims = util::toVec(in->getDimensions());
+  auto source_dims = util::toVec(source->second->getDimensions());
+  auto other_dims = util::toVec(other->getDimensions());
+  auto offset = static_cast<int64_t>(expanded_dims.size()) - static_cast<int64_t>(other_dims.size());
+  for (size_t i = 0; i < expanded_dims.size(); i++) {
+    if (expanded_dims[i] == source_dims[i] && expanded_dims[i] != -1) {
+      continue;
+    }
+    auto j = static_cast<int64_t>(i) - offset;
+    if (source_dims[i] != 1 || expanded_dims[i] == -1 || j < 0 || other_dims[j] != expanded_dims[i]) {
+      return in;
+    }
+  }
+  LOG_DEBUG("Broadcasting " << source->second->getDimensions() << " in the elementwise layer instead of expanding it");
+  return source->second;
+}
+
+} // namespace
+
 nvinfer1::ILayer* add_elementwise(
     ConversionCtx* ctx,
     nvinfer1::ElementWiseOperation op,
     nvinfer1::ITensor* self,
     nvinfer1::ITensor* other,
     const std::string& name) {
+  // Expands feeding only elementwise layers are left without consumers and pruned when the engine is built
+  self = skip_broadcast_expand(ctx, self, other);
+  other = skip_broadcast_expand(ctx, other, self);
+
   if (self->getType() == nvinfer1::DataType::kFLOAT && other->getType() == nvinfer1::DataType::kINT32) {
     LOG_DEBUG("Type mismatch, casting other to " << self->getType());
     other = castITensor(ctx, other, self->getType(), name);
@@ -220,10 +254,20 @@ nvinfer1::ITensor* castITensor(
     std::ostringstream tensor_id;
     tensor_id << reinterpret_cast<int*>(tensor);
 
-    auto id_layer = ctx->net->addIdentity(*tensor);
-    TORCHTRT_CHECK(id_layer, "Unable to create identity layer for ITensor: " << tensor_id.str());
-    // layer->setOutputType should be used for casting and not manually setting output_tensor->setType()
-    id_layer->setOutputType(0, dtype);
+    nvinfer1::ILayer* id_layer = nullptr;
+#if NV_TENSORRT_MAJOR >= 10
+    if (ctx->settings.strongly_typed) {
+      // Strongly typed networks do not allow setting output types, only cast layers change the type of a tensor
+      id_layer = ctx->net->addCast(*tensor, dtype);
+      TORCHTRT_CHECK(id_layer, "Unable to create cast layer for ITensor: " << tensor_id.str());
+    }
+#endif
+    if (!id_layer) {
+      id_layer = ctx->net->addIdentity(*tensor);
+      TORCHTRT_CHECK(id_layer, "Unable to create identity layer for ITensor: " << tensor_id.str());
+      // layer->setOutputType should be used for casting and not manually setting output_tensor->setType()
+      id_layer->setOutputType(0, dtype);
+    }
 
     auto casted_tensor = id_layer->getOutput(0);
     LOG_DEBUG(ctx->logger, "Casting ITensor " << tensor_id.str() << " from " << tensor->getType() << " to " << dtype);
@@ -240,7 +284,95 @@ nvinfer1::ITensor* castITensor(
   }
 }
 
+namespace {
+
+// Frozen tensors with fewer elements are always stored as constants
+constexpr int64_t kMinGeneratedTensorNumel = 1024;
+
+// Generates t in the network if it is uniform (zeros, ones, full) or an arithmetic sequence in its flattened order
+// (arange), instead of storing its data in the engine. Returns nullptr if t has to be stored
+nvinfer1::ITensor* generate_regular_tensor(ConversionCtx* ctx, const at::Tensor& t, const std::string& name) {
+  if (t.dim() == 0 || t.numel() < kMinGeneratedTensorNumel) {
+    return nullptr;
+  }
+  auto layer_name = "[Generate Tensor " + (name.empty() ? std::to_string(ctx->num_frozen_tensors) : name) + " ]";
+  auto flat = t.flatten();
+  auto first = flat[0];
+  if (flat.eq(first).all().item<bool>()) {
+    // A single element expanded to the shape, which elementwise layers broadcast natively
+    auto element = tensor_to_const(ctx, first.reshape(std::vector<int64_t>(t.dim(), 1)).clone());
+    auto out = add_expand(ctx, element, util::toDims(t.sizes()));
+    LOG_DEBUG(ctx->logger, "Generating uniform tensor " << layer_name << " of shape " << t.sizes());
+    return out;
+  }
+
+  // Sequences are generated as 32 bit values, Int64/Float64 ones only when they would be truncated anyway
+  auto type = t.scalar_type();
+  bool truncate = ctx->settings.truncate_long_and_double;
+  if (!(type == at::kFloat || type == at::kInt || (truncate && (type == at::kLong || type == at::kDouble)))) {
+    return nullptr;
+  }
+  bool integral = !t.is_floating_point();
+  auto values = flat.to(at::kDouble);
+  auto start = values[0].item<double>();
+  auto delta = values[1].item<double>() - start;
+  auto expected = at::arange(t.numel(), values.options()) * delta + start;
+  bool arithmetic = integral ? at::equal(values, expected) : at::allclose(values, expected, 1e-6, 1e-6);
+  if (!arithmetic) {
+    return nullptr;
+  }
+  if (integral &&
+      (values.min().item<double>() < std::numeric_limits<int32_t>::min() ||
+       values.max().item<double>() > std::numeric_limits<int32_t>::max())) {
+    return nullptr;
+  }
+
+  auto fill_layer = ctx->net->addFill(
+      util::toDims(std::vector<int64_t>{t.numel()}),
+      nvinfer1::FillOperation::kLINSPACE,
+      integral ? nvinfer1::DataType::kINT32 : nvinfer1::DataType::kFLOAT);
+  TORCHTRT_CHECK(fill_layer, "Unable to create fill layer for " << layer_name);
+  fill_layer->setAlpha(start);
+  fill_layer->setBeta(delta);
+  fill_layer->setName(layer_name.c_str());
+  ctx->num_frozen_tensors++;
+  auto out = fill_layer->getOutput(0);
+  if (t.dim() > 1) {
+    auto shuffle_layer = ctx->net->addShuffle(*out);
+    TORCHTRT_CHECK(shuffle_layer, "Unable to create shuffle layer for " << layer_name);
+    shuffle_layer->setReshapeDimensions(util::toDims(t.sizes()));
+    shuffle_layer->setName((layer_name + "_reshape").c_str());
+    out = shuffle_layer->getOutput(0);
+  }
+  LOG_DEBUG(ctx->logger, "Generating arithmetic tensor " << layer_name << " of shape " << t.sizes());
+  return out;
+}
+
+} // namespace
+
 nvinfer1::ITensor* tensor_to_const(ConversionCtx* ctx, at::Tensor t, const std::string& name) {
+  // A tensor used by several nodes is only frozen once
+  auto key = TensorInternKey(t);
+  if (!key.empty()) {
+    auto interned = ctx->interned_tensor_constants.find(key);
+    if (interned != ctx->interned_tensor_constants.end()) {
+      LOG_DEBUG(ctx->logger, "Reusing the IConstantLayer of an already frozen tensor");
+      return interned->second.second;
+    }
+  }
+  auto src = t;
+
+  // Refittable engines keep every tensor as a constant, refitting looks their weights up by layer name
+  if (!ctx->settings.refit) {
+    auto generated = generate_regular_tensor(ctx, t, name);
+    if (generated) {
+      if (!key.empty()) {
+        ctx->interned_tensor_constants[key] = {src, generated};
+      }
+      return generated;
+    }
+  }
+
   bool post_freeze_cast = false;
   nvinfer1::DataType post_freeze_cast_type = nvinfer1::DataType::kFLOAT;
   // Other "unsupported weights types" can be added to this check here
@@ -271,15 +403,15 @@ nvinfer1::ITensor* tensor_to_const(ConversionCtx* ctx, at::Tensor t, const std::
 
   auto out = const_layer->getOutput(0);
 
-  std::ostringstream tensor_id;
-  tensor_id << reinterpret_cast<int*>(out);
+  // Unnamed constants are numbered in the order they are frozen so converting the same graph again gives the same
+  // layer names, which the weights of refittable engines are looked up by
   std::string tensor_name;
-
   if (!name.empty()) {
     tensor_name = name;
   } else {
-    tensor_name = tensor_id.str();
+    tensor_name = std::to_string(ctx->num_frozen_tensors);
   }
+  ctx->num_frozen_tensors++;
   LOG_DEBUG(ctx->logger, "Freezing tensor " << tensor_name << " as an IConstantLayer");
   const_layer->setName(("[Freeze Tensor " + tensor_name + " ]").c_str());
 
@@ -287,6 +419,9 @@ nvinfer1::ITensor* tensor_to_const(ConversionCtx* ctx, at::Tensor t, const std::
     out = castITensor(ctx, out, post_freeze_cast_type);
   }
 
+  if (!key.empty()) {
+    ctx->interned_tensor_constants[key] = {src, out};
+  }
   return out;
 }
 
@@ -418,23 +553,33 @@ nvinfer1::ITensor* get_slice_size(
 }
 
 nvinfer1::ITensor* scalar_to_tensor(ConversionCtx* ctx, at::Scalar s) {
-  nvinfer1::ITensor* out;
+  // Scalars are interned by the value of the constant they are frozen into
+  std::string key;
+  at::Tensor s_t;
   if (s.isIntegral(false)) {
     auto s_int = s.to<int64_t>();
-    auto s_t = torch::tensor({s_int}).to(at::kInt);
-    out = tensor_to_const(ctx, s_t);
+    key = "Int " + std::to_string(static_cast<int32_t>(s_int));
+    s_t = torch::tensor({s_int}).to(at::kInt);
   } else if (s.isBoolean()) {
     auto s_bool = s.to<bool>();
-    auto s_t = torch::tensor({s_bool}).to(at::kBool);
-    out = tensor_to_const(ctx, s_t);
+    key = "Bool " + std::to_string(s_bool);
+    s_t = torch::tensor({s_bool}).to(at::kBool);
   } else if (s.isFloatingPoint()) {
     auto other_float = s.to<float>();
-    auto s_t = torch::tensor({other_float});
-    out = tensor_to_const(ctx, s_t);
+    uint32_t bits;
+    memcpy(&bits, &other_float, sizeof(bits));
+    key = "Float " + std::to_string(bits);
+    s_t = torch::tensor({other_float});
   } else {
-    out = nullptr;
     TORCHTRT_THROW_ERROR("Unsupported data type for scalar. Found: (" << s.type() << ")");
   }
+
+  auto interned = ctx->interned_scalar_constants.find(key);
+  if (interned != ctx->interned_scalar_constants.end()) {
+    return interned->second;
+  }
+  auto out = tensor_to_const(ctx, s_t);
+  ctx->interned_scalar_constants[key] = out;
   return out;
 }
 
@@ -506,7 +651,66 @@ nvinfer1::ITensor* add_expand(ConversionCtx* ctx, nvinfer1::ITensor* in, nvinfer
   auto slice_layer = ctx->net->addSlice(*in, start_offset, expandedDims, strides);
   LOG_DEBUG(ctx->logger, "Expand Tensor: " << in->getName());
 
-  return slice_layer->getOutput(0);
+  auto out = slice_layer->getOutput(0);
+  ctx->broadcast_sources[out] = in;
+  return out;
+}
+
+nvinfer1::ISliceLayer* add_padding_slice(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    nvinfer1::ITensor* in,
+    const std::vector<int64_t>& padding,
+    nvinfer1::SampleMode mode) {
+  auto in_dims = in->getDimensions();
+  int64_t in_rank = in_dims.nbDims;
+  TORCHTRT_CHECK(padding.size() % 2 == 0, "Length of pad must be even but instead it equals " << padding.size());
+  TORCHTRT_CHECK(
+      (int64_t)padding.size() / 2 <= in_rank,
+      "Padding " << padding << " pads more dimensions than the " << in_rank << " of the input");
+
+  std::vector<int64_t> start(in_rank, 0);
+  std::vector<int64_t> total_padding(in_rank, 0);
+  std::vector<int64_t> stride(in_rank, 1);
+  for (size_t i = 0UL; i < padding.size(); i += 2) {
+    auto before = padding[i];
+    TORCHTRT_CHECK(before >= 0, "Unsupported negative pad at index " << i);
+    auto after = padding[i + 1];
+    TORCHTRT_CHECK(after >= 0, "Unsupported negative pad at index " << i + 1);
+    auto idx = in_rank - ((i / 2) + 1);
+    start[idx] = -before;
+    total_padding[idx] = before + after;
+  }
+
+  bool is_dynamic = false;
+  auto size = total_padding;
+  for (int64_t i = 0; i < in_rank; i++) {
+    is_dynamic |= in_dims.d[i] == -1;
+    size[i] += in_dims.d[i];
+  }
+  if (is_dynamic) {
+    // Placeholder replaced by the size computed from the shape of in
+    size = stride;
+  }
+
+  auto slice_layer = ctx->net->addSlice(
+      *in,
+      util::toDims(c10::IntArrayRef(start)),
+      util::toDims(c10::IntArrayRef(size)),
+      util::toDims(c10::IntArrayRef(stride)));
+  TORCHTRT_CHECK(slice_layer, "Unable to create slice layer from node: " << *n);
+  slice_layer->setName((util::node_info(n) + "_slice").c_str());
+  slice_layer->setMode(mode);
+
+  if (is_dynamic) {
+    auto total_padding_itensor = tensor_to_const(ctx, torch::tensor(total_padding, torch::kInt32));
+    nvinfer1::ITensor* shape = getShapeOutput(ctx, in, (util::node_info(n) + "_shape").c_str());
+    auto add_layer = ctx->net->addElementWise(*shape, *total_padding_itensor, nvinfer1::ElementWiseOperation::kSUM);
+    TORCHTRT_CHECK(add_layer, "Unable to create add layer from node: " << *n);
+    add_layer->setName((util::node_info(n) + "_add").c_str());
+    slice_layer->setInput(2, *add_layer->getOutput(0));
+  }
+  return slice_layer;
 }
 
 } // namespace converters
@@ -65,7 +65,7 @@ nvinfer1::ITensor* castITensor(
 // Get the shape of the input tensor and cast it to INT32 type
 nvinfer1::ITensor* getShapeOutput(ConversionCtx* ctx, nvinfer1::ITensor* input_tensor, const std::string& name = "");
 
-// Freeze an at::Tensor in a IConstant layer
+// Freeze an at::Tensor in a IConstant layer, large uniform or arithmetic tensors are generated by the network instead
 nvinfer1::ITensor* tensor_to_const(ConversionCtx* ctx, at::Tensor t, const std::string& name = std::string());
 
 nvinfer1::ITensor* clamp(
@@ -103,6 +103,16 @@ nvinfer1::DataType promote_types(nvinfer1::DataType type_a, nvinfer1::DataType t
 
 nvinfer1::ITensor* add_expand(ConversionCtx* ctx, nvinfer1::ITensor* in, nvinfer1::Dims expandedDims);
 
+// Pads in with a single slice layer starting before and ending after the tensor, which samples the out of bounds
+// coordinates with mode (kREFLECT, kCLAMP or kFILL, whose value is then set as input 4 by the caller). padding holds
+// (before, after) pairs starting from the last dimension, as in PyTorch
+nvinfer1::ISliceLayer* add_padding_slice(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    nvinfer1::ITensor* in,
+    const std::vector<int64_t>& padding,
+    nvinfer1::SampleMode mode);
+
 } // namespace converters
 } // namespace conversion
 } // namespace core
@@ -42,6 +42,15 @@ bool node_is_convertable(const torch::jit::Node* n);
 OpConverter get_node_converter_for(const torch::jit::FunctionSchema* signature);
 std::vector<std::string> get_converter_list();
 
+// Set by the partitioner on nodes without a converter which it keeps in a TensorRT segment, they are converted to a
+// TorchOp plugin calling their Torch kernel
+const c10::Symbol kTorchOpPluginAttr = c10::Symbol::attr("torch_op_plugin");
+
+// Whether the TorchOp plugin can run the node: an operator of the Torch dispatcher which does not write to its inputs,
+// returning only tensors and taking at least one tensor, with all its other arguments constant
+bool torch_op_plugin_supports(const torch::jit::Node* n);
+bool convert_with_torch_op_plugin(ConversionCtx* ctx, const torch::jit::Node* n, args& args);
+
 } // namespace converters
 } // namespace conversion
 } // namespace core
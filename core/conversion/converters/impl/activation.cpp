@@ -192,6 +192,30 @@ auto acthardtanh TORCHTRT_UNUSED =
                LOG_DEBUG("Output shape: " << out_tensor->getDimensions());
                return true;
              }});
+
+#if NV_TENSORRT_MAJOR >= 10
+// Older versions of TensorRT have no GELU activation, aten::gelu is lowered to pointwise ops for those (ReduceGelu)
+auto actgelu TORCHTRT_UNUSED =
+    RegisterNodeConversionPatterns().pattern(
+        {"aten::gelu(Tensor self, *, str approximate='none') -> (Tensor)",
+         [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+           auto in = args[0].ITensorOrFreeze(ctx);
+           auto approximate = args[1].unwrapToString();
+           TORCHTRT_CHECK(
+               approximate == "none" || approximate == "tanh",
+               "Unsupported approximation " << approximate << " for aten::gelu in node: " << *n);
+
+           auto type =
+               approximate == "tanh" ? nvinfer1::ActivationType::kGELU_TANH : nvinfer1::ActivationType::kGELU_ERF;
+           auto new_layer = ctx->net->addActivation(*in, type);
+           TORCHTRT_CHECK(new_layer, "Unable to create layer for aten::gelu");
+
+           new_layer->setName(util::node_info(n).c_str());
+           auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], new_layer->getOutput(0));
+           LOG_DEBUG("Output shape: " << out_tensor->getDimensions());
+           return true;
+         }});
+#endif
 } // namespace
 } // namespace impl
 } // namespace converters
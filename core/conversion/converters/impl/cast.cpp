@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <torch/torch.h>
 #include "core/conversion/converters/converter_util.h"
 #include "core/conversion/converters/converters.h"
@@ -81,6 +82,34 @@ auto cast_registrations TORCHTRT_UNUSED =
                auto output = ctx->AssociateValueAndTensor(n->outputs()[0], casted_itensor);
                LOG_DEBUG("[aten::to.prim_Device] Output tensor shape: " << output->getDimensions());
 
+               return true;
+             }})
+        .pattern(
+            {"aten::Bool.Tensor(Tensor a) -> (bool)",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               // Produces the scalar boolean tensor data dependent conditionals are converted with
+               auto self = args[0].ITensorOrFreeze(ctx);
+               auto dims = self->getDimensions();
+               TORCHTRT_CHECK(
+                   util::volume(dims) == 1 || std::any_of(dims.d, dims.d + dims.nbDims, [](int64_t d) { return d < 0; }),
+                   "Boolean value of tensor of shape " << dims << " with more than one value is ambiguous");
+               auto scalar = ctx->net->addShuffle(*self);
+               TORCHTRT_CHECK(scalar, "Unable to create shuffle layer from node: " << *n);
+               scalar->setReshapeDimensions(nvinfer1::Dims{0, {}});
+               scalar->setName((util::node_info(n) + "_scalar").c_str());
+               auto out = scalar->getOutput(0);
+               if (out->getType() != nvinfer1::DataType::kBOOL) {
+                 auto zero = castITensor(ctx, scalar_to_tensor(ctx, 0), out->getType());
+                 auto is_zero = add_elementwise(
+                     ctx, nvinfer1::ElementWiseOperation::kEQUAL, out, zero, util::node_info(n) + "_is_zero");
+                 TORCHTRT_CHECK(is_zero, "Unable to create equal layer from node: " << *n);
+                 auto non_zero = ctx->net->addUnary(*is_zero->getOutput(0), nvinfer1::UnaryOperation::kNOT);
+                 TORCHTRT_CHECK(non_zero, "Unable to create not layer from node: " << *n);
+                 non_zero->setName((util::node_info(n) + "_non_zero").c_str());
+                 out = non_zero->getOutput(0);
+               }
+               auto output = ctx->AssociateValueAndTensor(n->outputs()[0], out);
+               LOG_DEBUG("[aten::Bool.Tensor] Output tensor shape: " << output->getDimensions());
                return true;
              }});
 // clang-format on
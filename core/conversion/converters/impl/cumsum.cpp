@@ -6,6 +6,7 @@
 #include "torch/torch.h"
 
 #include <ATen/ATen.h>
+#include <algorithm>
 #include <vector>
 
 namespace torch_tensorrt {
@@ -15,6 +16,172 @@ namespace converters {
 namespace impl {
 namespace {
 
+// Dense triangular scans are used up to this axis length, longer axes are scanned in blocks of kScanBlock positions
+constexpr int64_t kMaxTriangularScan = 1024;
+constexpr int64_t kScanBlock = 128;
+
+nvinfer1::ITensor* reshape(
+    ConversionCtx* ctx,
+    nvinfer1::ITensor* in,
+    std::vector<int64_t> dims,
+    const std::string& name) {
+  auto shuffle = ctx->net->addShuffle(*in);
+  shuffle->setReshapeDimensions(util::toDims(dims));
+  shuffle->setName(name.c_str());
+  return shuffle->getOutput(0);
+}
+
+// Inclusive scan along the last axis of a tensor of rank >= 2 as one matmul with an upper triangular matrix of ones,
+// which is independent of every other dim
+nvinfer1::ITensor* triangular_scan(ConversionCtx* ctx, nvinfer1::ITensor* in, const std::string& name) {
+  auto dims = util::toVec(in->getDimensions());
+  auto len = dims.back();
+  std::vector<int64_t> tri_dims(dims.size() - 2, 1);
+  tri_dims.push_back(len);
+  tri_dims.push_back(len);
+  auto tri = at::triu(at::ones({len, len}, at::kFloat))
+                 .to(util::TRTDataTypeToScalarType(in->getType()))
+                 .reshape(tri_dims);
+  auto mm = ctx->net->addMatrixMultiply(
+      *in,
+      nvinfer1::MatrixOperation::kNONE,
+      *tensor_to_const(ctx, tri, name + "_triangle"),
+      nvinfer1::MatrixOperation::kNONE);
+  mm->setName((name + "_scan").c_str());
+  return mm->getOutput(0);
+}
+
+// Inclusive scan along the last axis of a static tensor of rank >= 2. Long axes are split into blocks which are scanned
+// on their own, the scan of the block totals then gives the offset of each block
+nvinfer1::ITensor* static_scan(ConversionCtx* ctx, nvinfer1::ITensor* in, const std::string& name) {
+  auto dims = util::toVec(in->getDimensions());
+  auto len = dims.back();
+  if (len <= kMaxTriangularScan) {
+    return triangular_scan(ctx, in, name);
+  }
+
+  auto num_blocks = (len + kScanBlock - 1) / kScanBlock;
+  auto padded = in;
+  if (num_blocks * kScanBlock != len) {
+    auto pad_dims = dims;
+    pad_dims.back() = num_blocks * kScanBlock - len;
+    auto zeros = at::zeros(pad_dims, at::kFloat).to(util::TRTDataTypeToScalarType(in->getType()));
+    std::vector<nvinfer1::ITensor*> parts = {in, tensor_to_const(ctx, zeros, name + "_pad")};
+    auto concat = ctx->net->addConcatenation(parts.data(), parts.size());
+    concat->setAxis(dims.size() - 1);
+    concat->setName((name + "_padded").c_str());
+    padded = concat->getOutput(0);
+  }
+
+  auto block_dims = dims;
+  block_dims.back() = num_blocks;
+  block_dims.push_back(kScanBlock);
+  auto blocks = triangular_scan(ctx, reshape(ctx, padded, block_dims, name + "_blocks"), name + "_block");
+
+  // The last position of each block holds its total
+  std::vector<int64_t> start(block_dims.size(), 0);
+  start.back() = kScanBlock - 1;
+  auto total_dims = block_dims;
+  total_dims.back() = 1;
+  std::vector<int64_t> stride(block_dims.size(), 1);
+  auto totals_slice = ctx->net->addSlice(*blocks, util::toDims(start), util::toDims(total_dims), util::toDims(stride));
+  totals_slice->setName((name + "_block_totals").c_str());
+  auto totals_dims = dims;
+  totals_dims.back() = num_blocks;
+  auto totals = reshape(ctx, totals_slice->getOutput(0), totals_dims, name + "_totals");
+  auto offsets = add_elementwise(
+      ctx,
+      nvinfer1::ElementWiseOperation::kSUB,
+      static_scan(ctx, totals, name + "_totals"),
+      totals,
+      name + "_offsets");
+  auto scanned = add_elementwise(
+      ctx,
+      nvinfer1::ElementWiseOperation::kSUM,
+      blocks,
+      reshape(ctx, offsets->getOutput(0), total_dims, name + "_block_offsets"),
+      name + "_add_offsets");
+
+  auto padded_dims = dims;
+  padded_dims.back() = num_blocks * kScanBlock;
+  auto out = reshape(ctx, scanned->getOutput(0), padded_dims, name + "_flat");
+  if (num_blocks * kScanBlock != len) {
+    std::vector<int64_t> out_start(dims.size(), 0);
+    std::vector<int64_t> out_stride(dims.size(), 1);
+    auto unpad = ctx->net->addSlice(*out, util::toDims(out_start), util::toDims(dims), util::toDims(out_stride));
+    unpad->setName((name + "_unpad").c_str());
+    out = unpad->getOutput(0);
+  }
+  return out;
+}
+
+// Moves dim to the back, or back to its place when inverse is set
+nvinfer1::ITensor* move_to_back(
+    ConversionCtx* ctx,
+    nvinfer1::ITensor* in,
+    int dim,
+    bool inverse,
+    const std::string& name) {
+  auto rank = in->getDimensions().nbDims;
+  if (dim == rank - 1) {
+    return in;
+  }
+  nvinfer1::Permutation perm;
+  for (int i = 0, j = 0; i < rank; i++) {
+    if (i != dim) {
+      perm.order[j++] = i;
+    }
+  }
+  perm.order[rank - 1] = dim;
+  if (inverse) {
+    nvinfer1::Permutation inv;
+    for (int i = 0; i < rank; i++) {
+      inv.order[perm.order[i]] = i;
+    }
+    perm = inv;
+  }
+  auto shuffle = ctx->net->addShuffle(*in);
+  shuffle->setFirstTranspose(perm);
+  shuffle->setName(name.c_str());
+  return shuffle->getOutput(0);
+}
+
+// Scan through each slice across summation axis and add it to the running sum
+nvinfer1::ITensor* loop_scan(ConversionCtx* ctx, nvinfer1::ITensor* in, int dim) {
+  auto input_dims = in->getDimensions();
+  auto loop = ctx->net->addLoop();
+  nvinfer1::ITensor* tripLimit = NULL;
+  if (input_dims.d[dim] > 0) {
+    torch::Tensor axis = torch::tensor(input_dims.d[dim], torch::kInt32);
+    tripLimit = tensor_to_const(ctx, axis);
+  } else {
+    nvinfer1::ITensor* inpShape = getShapeOutput(ctx, in);
+    torch::Tensor dimValue = torch::tensor(dim, torch::kInt32);
+    nvinfer1::ITensor* axis = tensor_to_const(ctx, dimValue);
+    tripLimit = ctx->net->addGather(*inpShape, *axis, 0)->getOutput(0);
+  }
+
+  loop->addTripLimit(*tripLimit, nvinfer1::TripLimit::kCOUNT);
+
+  auto iterator = loop->addIterator(*in, dim, false);
+  auto data = iterator->getOutput(0);
+  auto newDims = data->getDimensions();
+
+  torch::Tensor zeroValue =
+      at::full(util::toVec(newDims), 0, torch_tensorrt::core::util::TRTDataTypeToScalarType(in->getType()));
+  auto zeroTensor = tensor_to_const(ctx, zeroValue);
+  auto runningSum = loop->addRecurrence(*zeroTensor);
+  auto runningSumTensor = runningSum->getOutput(0);
+
+  auto curSum = ctx->net->addElementWise(*data, *runningSumTensor, nvinfer1::ElementWiseOperation::kSUM);
+  runningSum->setInput(1, *curSum->getOutput(0));
+
+  nvinfer1::ILoopOutputLayer* loopOut =
+      loop->addLoopOutput(*curSum->getOutput(0), nvinfer1::LoopOutput::kCONCATENATE, dim);
+  loopOut->setInput(1, *tripLimit);
+  return loopOut->getOutput(0);
+}
+
 auto cumsum_registrations TORCHTRT_UNUSED = RegisterNodeConversionPatterns().pattern(
     {"aten::cumsum(Tensor self, int dim, *, int? dtype=None) -> (Tensor)",
      [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
@@ -29,39 +196,29 @@ auto cumsum_registrations TORCHTRT_UNUSED = RegisterNodeConversionPatterns().pat
          dim += input_dims.nbDims;
        }
 
-       // Scan through each slice across summation axis and add it to the running sum
-       auto loop = ctx->net->addLoop();
-       nvinfer1::ITensor* tripLimit = NULL;
-       if (input_dims.d[dim] > 0) {
-         torch::Tensor axis = torch::tensor(input_dims.d[dim], torch::kInt32);
-         tripLimit = tensor_to_const(ctx, axis);
+       // Floating point scans over a static axis are matmuls, integer types and dynamic axes keep the ILoop
+       auto dims = util::toVec(input_dims);
+       bool is_float = in->getType() == nvinfer1::DataType::kFLOAT || in->getType() == nvinfer1::DataType::kHALF;
+       bool is_static = std::find(dims.begin(), dims.end(), -1) == dims.end();
+       auto len = input_dims.d[dim];
+       nvinfer1::ITensor* out = nullptr;
+       auto name = util::node_info(n);
+       if (is_float && len > 0 && (is_static || len <= kMaxTriangularScan)) {
+         LOG_DEBUG("Scanning an axis of length " << len << " with matrix multiplies");
+         auto scan_in = move_to_back(ctx, in, dim, false, name + "_to_back");
+         if (input_dims.nbDims == 1) {
+           scan_in = reshape(ctx, scan_in, {1, len}, name + "_as_row");
+         }
+         auto scanned = is_static ? static_scan(ctx, scan_in, name) : triangular_scan(ctx, scan_in, name);
+         if (input_dims.nbDims == 1) {
+           scanned = reshape(ctx, scanned, {len}, name + "_as_vector");
+         }
+         out = move_to_back(ctx, scanned, dim, true, name + "_from_back");
        } else {
-         nvinfer1::ITensor* inpShape = getShapeOutput(ctx, in);
-         torch::Tensor dimValue = torch::tensor(dim, torch::kInt32);
-         nvinfer1::ITensor* axis = tensor_to_const(ctx, dimValue);
-         tripLimit = ctx->net->addGather(*inpShape, *axis, 0)->getOutput(0);
+         out = loop_scan(ctx, in, dim);
        }
 
-       loop->addTripLimit(*tripLimit, nvinfer1::TripLimit::kCOUNT);
-
-       auto iterator = loop->addIterator(*in, dim, false);
-       auto data = iterator->getOutput(0);
-       auto newDims = data->getDimensions();
-
-       torch::Tensor zeroValue =
-           at::full(util::toVec(newDims), 0, torch_tensorrt::core::util::TRTDataTypeToScalarType(in->getType()));
-       auto zeroTensor = tensor_to_const(ctx, zeroValue);
-       auto runningSum = loop->addRecurrence(*zeroTensor);
-       auto runningSumTensor = runningSum->getOutput(0);
-
-       auto curSum = ctx->net->addElementWise(*data, *runningSumTensor, nvinfer1::ElementWiseOperation::kSUM);
-       runningSum->setInput(1, *curSum->getOutput(0));
-
-       nvinfer1::ILoopOutputLayer* loopOut =
-           loop->addLoopOutput(*curSum->getOutput(0), nvinfer1::LoopOutput::kCONCATENATE, dim);
-       loopOut->setInput(1, *tripLimit);
-
-       auto layer_output = ctx->AssociateValueAndTensor(n->outputs()[0], loopOut->getOutput(0));
+       auto layer_output = ctx->AssociateValueAndTensor(n->outputs()[0], out);
 
        LOG_DEBUG("Output tensor shape: " << layer_output->getDimensions());
        return true;
@@ -1,7 +1,15 @@
+#include "core/conversion/converters/converter_util.h"
 #include "core/conversion/converters/converters.h"
 #include "core/conversion/tensorcontainer/TensorContainer.h"
 #include "core/util/prelude.h"
 
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
 #include <vector>
 
 namespace torch_tensorrt {
@@ -11,6 +19,415 @@ namespace converters {
 namespace impl {
 namespace {
 
+// Exhaustive search over contraction orders is only done up to this many operands, beyond it pairs are picked greedily
+constexpr size_t kMaxOptimalOperands = 8;
+// Size assumed for dynamic dimensions when comparing the cost of contraction orders
+constexpr double kDynamicDimCost = 32;
+
+struct Operand {
+  nvinfer1::ITensor* tensor;
+  // One label per dimension of tensor
+  std::string labels;
+};
+
+struct Equation {
+  std::vector<std::string> inputs;
+  std::string output;
+};
+
+// Splits the equation into the labels of each operand and of the output. Ellipses are expanded to unused labels,
+// right aligned across operands like broadcasting, and the implicit output is the ellipsis followed by the labels
+// that appear once in alphabetical order
+Equation parse_equation(const std::string& eq, const std::vector<nvinfer1::ITensor*>& tensors) {
+  std::string equation;
+  for (auto c : eq) {
+    if (c != ' ') {
+      equation.push_back(c);
+    }
+  }
+  auto arrow = equation.find("->");
+  auto lhs = equation.substr(0, arrow);
+
+  std::vector<std::string> terms;
+  size_t start = 0;
+  for (auto comma = lhs.find(','); comma != std::string::npos; comma = lhs.find(',', start)) {
+    terms.push_back(lhs.substr(start, comma - start));
+    start = comma + 1;
+  }
+  terms.push_back(lhs.substr(start));
+  TORCHTRT_CHECK(
+      terms.size() == tensors.size(),
+      "Einsum equation " << eq << " has " << terms.size() << " operands but " << tensors.size()
+                         << " tensors were given");
+
+  std::set<char> used(equation.begin(), equation.end());
+  std::string ellipsis_labels;
+  for (char c = 'A'; c <= 'Z'; c++) {
+    if (!used.count(c)) {
+      ellipsis_labels.push_back(c);
+    }
+  }
+
+  int64_t ellipsis_dims = 0;
+  for (size_t i = 0; i < terms.size(); i++) {
+    if (terms[i].find("...") != std::string::npos) {
+      auto explicit_dims = static_cast<int64_t>(terms[i].size()) - 3;
+      ellipsis_dims = std::max(ellipsis_dims, tensors[i]->getDimensions().nbDims - explicit_dims);
+    }
+  }
+  TORCHTRT_CHECK(
+      ellipsis_dims <= static_cast<int64_t>(ellipsis_labels.size()),
+      "Einsum equation " << eq << " has too many dimensions covered by an ellipsis");
+  auto broadcast_labels = ellipsis_labels.substr(0, ellipsis_dims);
+
+  Equation parsed;
+  for (size_t i = 0; i < terms.size(); i++) {
+    auto term = terms[i];
+    auto pos = term.find("...");
+    if (pos != std::string::npos) {
+      auto dims = tensors[i]->getDimensions().nbDims - static_cast<int64_t>(term.size() - 3);
+      term.replace(pos, 3, broadcast_labels.substr(ellipsis_dims - dims));
+    }
+    TORCHTRT_CHECK(
+        static_cast<int64_t>(term.size()) == tensors[i]->getDimensions().nbDims,
+        "Einsum operand " << terms[i] << " does not match the rank of its tensor " << tensors[i]->getDimensions());
+    for (auto c : term) {
+      TORCHTRT_CHECK(std::isalpha(c), "Unsupported label " << c << " in einsum equation " << eq);
+    }
+    parsed.inputs.push_back(term);
+  }
+
+  if (arrow != std::string::npos) {
+    parsed.output = equation.substr(arrow + 2);
+    auto pos = parsed.output.find("...");
+    if (pos != std::string::npos) {
+      parsed.output.replace(pos, 3, broadcast_labels);
+    }
+  } else {
+    std::map<char, int> count;
+    for (auto& term : parsed.inputs) {
+      for (auto c : term) {
+        count[c]++;
+      }
+    }
+    parsed.output = broadcast_labels;
+    for (auto& c : count) {
+      if (c.second == 1 && broadcast_labels.find(c.first) == std::string::npos) {
+        parsed.output.push_back(c.first);
+      }
+    }
+  }
+  for (auto c : parsed.output) {
+    auto found = std::any_of(parsed.inputs.begin(), parsed.inputs.end(), [&](const std::string& t) {
+      return t.find(c) != std::string::npos;
+    });
+    TORCHTRT_CHECK(found, "Output label " << c << " of einsum equation " << eq << " does not appear in any operand");
+  }
+  return parsed;
+}
+
+bool has_repeated_labels(const std::string& labels) {
+  return std::set<char>(labels.begin(), labels.end()).size() != labels.size();
+}
+
+// Dimension of the output, the product of the listed dimensions of other tensors. An empty list stands for 1
+using DimProduct = std::vector<std::pair<nvinfer1::ITensor*, int32_t>>;
+
+// Transposes in by perm and reshapes the result to dims, using a shape tensor if any of the dimensions is dynamic
+nvinfer1::ITensor* transpose_and_reshape(
+    ConversionCtx* ctx,
+    nvinfer1::ITensor* in,
+    const std::vector<int32_t>& perm,
+    const std::vector<DimProduct>& dims,
+    const std::string& name) {
+  std::vector<int64_t> static_dims;
+  bool dynamic = false;
+  for (auto& d : dims) {
+    int64_t size = 1;
+    for (auto& src : d) {
+      auto s = src.first->getDimensions().d[src.second];
+      dynamic |= s < 0;
+      size *= s;
+    }
+    static_dims.push_back(size);
+  }
+
+  auto shuffle = ctx->net->addShuffle(*in);
+  TORCHTRT_CHECK(shuffle, "Unable to create shuffle layer for " << name);
+  nvinfer1::Permutation permutation;
+  for (size_t i = 0; i < perm.size(); i++) {
+    permutation.order[i] = perm[i];
+  }
+  shuffle->setFirstTranspose(permutation);
+  if (!dynamic) {
+    shuffle->setReshapeDimensions(util::toDims(static_dims));
+  } else {
+    std::vector<nvinfer1::ITensor*> sizes;
+    for (size_t i = 0; i < dims.size(); i++) {
+      nvinfer1::ITensor* size = nullptr;
+      for (auto& src : dims[i]) {
+        auto shape = getShapeOutput(ctx, src.first, name + "_shape");
+        auto idx = tensor_to_const(ctx, torch::tensor({src.second}, torch::kInt32));
+        auto s = ctx->net->addGather(*shape, *idx, 0)->getOutput(0);
+        size = size ? add_elementwise(ctx, nvinfer1::ElementWiseOperation::kPROD, size, s, name + "_dim")->getOutput(0)
+                    : s;
+      }
+      sizes.push_back(size ? size : tensor_to_const(ctx, torch::tensor({1}, torch::kInt32)));
+    }
+    auto concat = ctx->net->addConcatenation(sizes.data(), sizes.size());
+    concat->setAxis(0);
+    shuffle->setInput(1, *concat->getOutput(0));
+  }
+  shuffle->setName(name.c_str());
+  return shuffle->getOutput(0);
+}
+
+// Sums out the labels of op that keep does not contain
+Operand reduce_labels(ConversionCtx* ctx, Operand op, const std::string& keep, const std::string& name) {
+  uint32_t axes = 0;
+  std::string labels;
+  for (size_t i = 0; i < op.labels.size(); i++) {
+    if (keep.find(op.labels[i]) == std::string::npos) {
+      axes |= 1 << i;
+    } else {
+      labels.push_back(op.labels[i]);
+    }
+  }
+  if (!axes) {
+    return op;
+  }
+  auto reduce = ctx->net->addReduce(*op.tensor, nvinfer1::ReduceOperation::kSUM, axes, false);
+  TORCHTRT_CHECK(reduce, "Unable to create reduce layer for " << name);
+  reduce->setName((name + "_sum").c_str());
+  return {reduce->getOutput(0), labels};
+}
+
+// Contracts a and b keeping the labels in keep. a is brought to [batch..., M, K] and b to [batch..., K, N] where batch
+// are the shared labels kept, K the shared labels summed over and M, N the labels of only one side, so the pair runs
+// as one batched matrix multiply
+Operand contract_pair(ConversionCtx* ctx, Operand a, Operand b, const std::string& keep, const std::string& name) {
+  a = reduce_labels(ctx, a, keep + b.labels, name + "_lhs");
+  b = reduce_labels(ctx, b, keep + a.labels, name + "_rhs");
+
+  std::string batch, contract, left, right;
+  for (auto c : a.labels) {
+    if (b.labels.find(c) == std::string::npos) {
+      left.push_back(c);
+    } else if (keep.find(c) != std::string::npos) {
+      batch.push_back(c);
+    } else {
+      contract.push_back(c);
+    }
+  }
+  for (auto c : b.labels) {
+    if (a.labels.find(c) == std::string::npos) {
+      right.push_back(c);
+    }
+  }
+
+  auto axes = [](const Operand& op, const std::string& labels) {
+    std::vector<int32_t> axes;
+    for (auto c : labels) {
+      axes.push_back(static_cast<int32_t>(op.labels.find(c)));
+    }
+    return axes;
+  };
+  auto product = [](const Operand& op, const std::vector<int32_t>& axes) {
+    DimProduct p;
+    for (auto axis : axes) {
+      p.push_back({op.tensor, axis});
+    }
+    return p;
+  };
+
+  // Same labels on both sides, a plain elementwise product
+  if (contract.empty() && left.empty() && right.empty()) {
+    auto b_perm = axes(b, a.labels);
+    std::vector<DimProduct> dims;
+    for (auto axis : b_perm) {
+      dims.push_back({{b.tensor, axis}});
+    }
+    auto b_t = transpose_and_reshape(ctx, b.tensor, b_perm, dims, name + "_rhs_transpose");
+    auto prod = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kPROD, a.tensor, b_t, name + "_prod");
+    return {prod->getOutput(0), a.labels};
+  }
+
+  auto a_batch = axes(a, batch), a_left = axes(a, left), a_contract = axes(a, contract);
+  auto b_batch = axes(b, batch), b_right = axes(b, right), b_contract = axes(b, contract);
+
+  std::vector<int32_t> a_perm(a_batch);
+  a_perm.insert(a_perm.end(), a_left.begin(), a_left.end());
+  a_perm.insert(a_perm.end(), a_contract.begin(), a_contract.end());
+  std::vector<DimProduct> a_dims;
+  for (auto axis : a_batch) {
+    a_dims.push_back({{a.tensor, axis}});
+  }
+  a_dims.push_back(product(a, a_left));
+  a_dims.push_back(product(a, a_contract));
+  auto lhs = transpose_and_reshape(ctx, a.tensor, a_perm, a_dims, name + "_lhs_matrix");
+
+  std::vector<int32_t> b_perm(b_batch);
+  b_perm.insert(b_perm.end(), b_contract.begin(), b_contract.end());
+  b_perm.insert(b_perm.end(), b_right.begin(), b_right.end());
+  std::vector<DimProduct> b_dims;
+  for (auto axis : b_batch) {
+    b_dims.push_back({{b.tensor, axis}});
+  }
+  b_dims.push_back(product(b, b_contract));
+  b_dims.push_back(product(b, b_right));
+  auto rhs = transpose_and_reshape(ctx, b.tensor, b_perm, b_dims, name + "_rhs_matrix");
+
+  auto mm = ctx->net->addMatrixMultiply(*lhs, nvinfer1::MatrixOperation::kNONE, *rhs, nvinfer1::MatrixOperation::kNONE);
+  TORCHTRT_CHECK(mm, "Unable to create matrix multiply layer for " << name);
+  mm->setName((name + "_mm").c_str());
+  auto out = mm->getOutput(0);
+
+  // Batch dimensions come from the product so that size 1 dimensions broadcast
+  std::vector<int32_t> out_perm;
+  std::vector<DimProduct> out_dims;
+  for (size_t i = 0; i < batch.size() + 2; i++) {
+    out_perm.push_back(static_cast<int32_t>(i));
+  }
+  for (size_t i = 0; i < batch.size(); i++) {
+    out_dims.push_back({{out, static_cast<int32_t>(i)}});
+  }
+  for (auto axis : a_left) {
+    out_dims.push_back({{a.tensor, axis}});
+  }
+  for (auto axis : b_right) {
+    out_dims.push_back({{b.tensor, axis}});
+  }
+  out = transpose_and_reshape(ctx, out, out_perm, out_dims, name + "_unflatten");
+  return {out, batch + left + right};
+}
+
+double contraction_cost(const std::string& labels, const std::map<char, double>& sizes) {
+  double cost = 1;
+  for (auto c : labels) {
+    cost *= sizes.at(c);
+  }
+  return cost;
+}
+
+std::string label_union(const std::string& a, const std::string& b) {
+  std::string u(a);
+  for (auto c : b) {
+    if (u.find(c) == std::string::npos) {
+      u.push_back(c);
+    }
+  }
+  return u;
+}
+
+// Pairs of positions in the list of pending operands. Each step removes the pair and appends its product, the format of
+// torch.einsum's path argument and of opt_einsum
+using ContractionPath = std::vector<std::pair<size_t, size_t>>;
+
+// Finds the contraction order of least total cost, the cost of one pairwise contraction being the product of the sizes
+// of the labels involved. Uses dynamic programming over subsets of the operands for small operand counts and picks
+// the cheapest pair at every step otherwise
+ContractionPath find_contraction_path(
+    const std::vector<std::string>& labels,
+    const std::string& output,
+    const std::map<char, double>& sizes) {
+  auto n = labels.size();
+  // Labels of the product of the operands in s that are still needed by the other operands or the output
+  auto kept_labels = [&](const std::vector<std::string>& ops, const std::vector<bool>& in_s) {
+    std::string needed(output);
+    for (size_t i = 0; i < ops.size(); i++) {
+      if (!in_s[i]) {
+        needed += ops[i];
+      }
+    }
+    std::string kept;
+    for (size_t i = 0; i < ops.size(); i++) {
+      if (in_s[i]) {
+        for (auto c : ops[i]) {
+          if (needed.find(c) != std::string::npos && kept.find(c) == std::string::npos) {
+            kept.push_back(c);
+          }
+        }
+      }
+    }
+    return kept;
+  };
+
+  ContractionPath path;
+  if (n <= kMaxOptimalOperands) {
+    size_t full = (size_t(1) << n) - 1;
+    std::vector<std::string> kept(full + 1);
+    std::vector<double> cost(full + 1, std::numeric_limits<double>::infinity());
+    std::vector<size_t> split(full + 1, 0);
+    for (size_t s = 1; s <= full; s++) {
+      std::vector<bool> in_s(n);
+      for (size_t i = 0; i < n; i++) {
+        in_s[i] = s & (size_t(1) << i);
+      }
+      kept[s] = kept_labels(labels, in_s);
+      if ((s & (s - 1)) == 0) {
+        cost[s] = 0;
+        continue;
+      }
+      for (size_t a = (s - 1) & s; a > 0; a = (a - 1) & s) {
+        auto b = s ^ a;
+        if (a < b) {
+          continue;
+        }
+        auto c = cost[a] + cost[b] + contraction_cost(label_union(kept[a], kept[b]), sizes);
+        if (c < cost[s]) {
+          cost[s] = c;
+          split[s] = a;
+        }
+      }
+    }
+
+    // Replays the best split of every subset as a path over the pending operands
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < n; i++) {
+      pending.push_back(size_t(1) << i);
+    }
+    std::function<void(size_t)> emit = [&](size_t s) {
+      if ((s & (s - 1)) == 0) {
+        return;
+      }
+      emit(split[s]);
+      emit(s ^ split[s]);
+      auto i = std::find(pending.begin(), pending.end(), split[s]) - pending.begin();
+      auto j = std::find(pending.begin(), pending.end(), s ^ split[s]) - pending.begin();
+      path.push_back({static_cast<size_t>(i), static_cast<size_t>(j)});
+      pending.erase(pending.begin() + std::max(i, j));
+      pending.erase(pending.begin() + std::min(i, j));
+      pending.push_back(s);
+    };
+    emit(full);
+    return path;
+  }
+
+  auto ops = labels;
+  while (ops.size() > 1) {
+    double best = std::numeric_limits<double>::infinity();
+    std::pair<size_t, size_t> best_pair = {0, 1};
+    std::string best_kept;
+    for (size_t i = 0; i < ops.size(); i++) {
+      for (size_t j = i + 1; j < ops.size(); j++) {
+        std::vector<bool> in_s(ops.size(), false);
+        in_s[i] = in_s[j] = true;
+        auto c = contraction_cost(label_union(ops[i], ops[j]), sizes);
+        if (c < best) {
+          best = c;
+          best_pair = {i, j};
+          best_kept = kept_labels(ops, in_s);
+        }
+      }
+    }
+    path.push_back(best_pair);
+    ops.erase(ops.begin() + best_pair.second);
+    ops.erase(ops.begin() + best_pair.first);
+    ops.push_back(best_kept);
+  }
+  return path;
+}
+
 auto einsum_registrations TORCHTRT_UNUSED = RegisterNodeConversionPatterns().pattern(
     {"aten::einsum(str equation, Tensor[] tensors, *, int[]? path=None) -> (Tensor)",
      [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
@@ -18,13 +435,6 @@ auto einsum_registrations TORCHTRT_UNUSED = RegisterNodeConversionPatterns().pat
        auto equation = args[0].unwrapToString();
        auto in = args[1].IValue()->toListRef();
 
-       TORCHTRT_CHECK(
-           in.size() <= 2,
-           "TensorRT currently supports up to 2 input tensors "
-               << "to einsum but operation had " << in.size()
-               << " input tensors, please specify torch_executed_ops=[\"aten::einsum\"] "
-               << "at compilation time to avoid this error.");
-
        std::vector<nvinfer1::ITensor*> tensors;
 
        // Populate vector of ITensor pointers
@@ -47,13 +457,83 @@ auto einsum_registrations TORCHTRT_UNUSED = RegisterNodeConversionPatterns().pat
          tensors.push_back(itensor);
        }
 
-       // Add TensorRT Einsum layer
-       auto einsum_layer = ctx->net->addEinsum(tensors.data(), tensors.size(), equation.c_str());
-       TORCHTRT_CHECK(einsum_layer, "Unable to create einsum layer from node: " << *n);
+       auto parsed = parse_equation(equation, tensors);
+       auto diagonal = has_repeated_labels(parsed.output) ||
+           std::any_of(parsed.inputs.begin(), parsed.inputs.end(), has_repeated_labels);
+       if (diagonal) {
+         // Diagonals are left to the TensorRT Einsum layer, which takes up to 2 operands
+         TORCHTRT_CHECK(
+             in.size() <= 2,
+             "TensorRT currently supports repeated labels within an operand of einsum for up to 2 input tensors "
+                 << "but operation had " << in.size() << " input tensors, please specify "
+                 << "torch_executed_ops=[\"aten::einsum\"] at compilation time to avoid this error.");
+         auto einsum_layer = ctx->net->addEinsum(tensors.data(), tensors.size(), equation.c_str());
+         TORCHTRT_CHECK(einsum_layer, "Unable to create einsum layer from node: " << *n);
+
+         einsum_layer->setName(util::node_info(n).c_str());
+         auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], einsum_layer->getOutput(0));
+
+         LOG_DEBUG("Output tensor shape: " << out_tensor->getDimensions());
+         return true;
+       }
+
+       std::map<char, double> sizes;
+       for (size_t i = 0; i < tensors.size(); i++) {
+         auto dims = tensors[i]->getDimensions();
+         for (size_t d = 0; d < parsed.inputs[i].size(); d++) {
+           auto size = dims.d[d] < 0 ? kDynamicDimCost : static_cast<double>(dims.d[d]);
+           sizes[parsed.inputs[i][d]] = std::max(sizes[parsed.inputs[i][d]], size);
+         }
+       }
+
+       ContractionPath path;
+       auto user_path = args[2].IValue();
+       if (!user_path->isNone()) {
+         auto flat = user_path->toIntVector();
+         TORCHTRT_CHECK(
+             flat.size() == 2 * (tensors.size() - 1),
+             "Einsum contraction path must hold " << tensors.size() - 1 << " pairs of operands for node: " << *n);
+         for (size_t i = 0; i < flat.size(); i += 2) {
+           path.push_back({static_cast<size_t>(flat[i]), static_cast<size_t>(flat[i + 1])});
+         }
+       } else {
+         path = find_contraction_path(parsed.inputs, parsed.output, sizes);
+       }
 
-       einsum_layer->setName(util::node_info(n).c_str());
-       auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], einsum_layer->getOutput(0));
+       std::vector<Operand> ops;
+       for (size_t i = 0; i < tensors.size(); i++) {
+         ops.push_back({tensors[i], parsed.inputs[i]});
+       }
+       auto name = util::node_info(n);
+       for (size_t step = 0; step < path.size(); step++) {
+         auto i = path[step].first, j = path[step].second;
+         TORCHTRT_CHECK(
+             i != j && i < ops.size() && j < ops.size(),
+             "Invalid einsum contraction path step (" << i << ", " << j << ") for node: " << *n);
+         std::string needed(parsed.output);
+         for (size_t k = 0; k < ops.size(); k++) {
+           if (k != i && k != j) {
+             needed += ops[k].labels;
+           }
+         }
+         auto product = contract_pair(ctx, ops[i], ops[j], needed, name + "_contract_" + std::to_string(step));
+         ops.erase(ops.begin() + std::max(i, j));
+         ops.erase(ops.begin() + std::min(i, j));
+         ops.push_back(product);
+       }
+
+       auto result = reduce_labels(ctx, ops[0], parsed.output, name);
+       std::vector<int32_t> perm;
+       std::vector<DimProduct> dims;
+       for (auto c : parsed.output) {
+         auto axis = static_cast<int32_t>(result.labels.find(c));
+         perm.push_back(axis);
+         dims.push_back({{result.tensor, axis}});
+       }
+       auto out = transpose_and_reshape(ctx, result.tensor, perm, dims, name + "_output");
+       auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], out);
 
+       LOG_DEBUG("Einsum " << equation << " contracted as " << path.size() << " matrix multiplies");
        LOG_DEBUG("Output tensor shape: " << out_tensor->getDimensions());
        return true;
      }});
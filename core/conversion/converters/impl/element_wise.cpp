@@ -468,13 +468,12 @@ auto element_wise_registrations TORCHTRT_UNUSED =
                auto options = torch::TensorOptions().dtype(torch::kFloat32);
                auto ones = at::full({1}, 1, {options});
                auto ones_tensor = tensor_to_const(ctx, ones);
-               nvinfer1::IIdentityLayer* cast_layer = ctx->net->addIdentity(*ones_tensor);
-               cast_layer->setOutputType(0, nvinfer1::DataType::kBOOL);
+               auto bool_ones = castITensor(ctx, ones_tensor, nvinfer1::DataType::kBOOL);
 
                auto sub = add_elementwise(
                    ctx,
                    nvinfer1::ElementWiseOperation::kXOR,
-                   cast_layer->getOutput(0),
+                   bool_ones,
                    equal->getOutput(0),
                    util::node_info(n));
                TORCHTRT_CHECK(sub, "Unable to create ne (not equal) layer from node: " << *n);
@@ -500,13 +499,12 @@ auto element_wise_registrations TORCHTRT_UNUSED =
                auto options = torch::TensorOptions().dtype(torch::kFloat32);
                auto ones = at::full({1}, 1, {options});
                auto ones_tensor = tensor_to_const(ctx, ones);
-               nvinfer1::IIdentityLayer* cast_layer = ctx->net->addIdentity(*ones_tensor);
-               cast_layer->setOutputType(0, nvinfer1::DataType::kBOOL);
+               auto bool_ones = castITensor(ctx, ones_tensor, nvinfer1::DataType::kBOOL);
 
                auto sub = add_elementwise(
                    ctx,
                    nvinfer1::ElementWiseOperation::kXOR,
-                   cast_layer->getOutput(0),
+                   bool_ones,
                    equal->getOutput(0),
                    util::node_info(n));
                TORCHTRT_CHECK(sub, "Unable to create ne (not equal) layer from node: " << *n);
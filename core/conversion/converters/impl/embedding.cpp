@@ -0,0 +1,224 @@
+#include <limits>
+#include "core/conversion/converters/converter_util.h"
+#include "core/conversion/converters/converters.h"
+#include "core/util/prelude.h"
+#include "torch/torch.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace conversion {
+namespace converters {
+namespace impl {
+namespace {
+
+enum class BagMode { kSUM = 0, kMEAN = 1, kMAX = 2 };
+
+// Gathers the rows of the table selected by indices. Frozen FP32 tables are stored in FP16 when FP16 is enabled,
+// which halves the memory the gather reads, and the rows are cast back to FP32 after the gather
+nvinfer1::ITensor* gather_rows(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    args& args,
+    nvinfer1::ITensor* indices,
+    const std::string& name) {
+  nvinfer1::ITensor* table = nullptr;
+  auto store_half = false;
+  if (args[0].isIValue() && args[0].IValue()->isTensor()) {
+    auto weight = args[0].IValue()->toTensor();
+    store_half = weight.scalar_type() == at::kFloat && ctx->enabled_precisions.count(nvinfer1::DataType::kHALF);
+    table = tensor_to_const(ctx, store_half ? weight.to(at::kHalf) : weight, name + "_table");
+  } else {
+    table = args[0].ITensorOrFreeze(ctx);
+  }
+  indices = castITensor(ctx, indices, nvinfer1::DataType::kINT32, name + "_indices");
+
+  auto gather_layer = ctx->net->addGather(*table, *indices, 0);
+  TORCHTRT_CHECK(gather_layer, "Unable to create gather layer from node: " << *n);
+  gather_layer->setName((name + "_gather").c_str());
+  auto rows = gather_layer->getOutput(0);
+  if (store_half) {
+    rows = castITensor(ctx, rows, nvinfer1::DataType::kFLOAT, name + "_rows");
+  }
+  return rows;
+}
+
+// Positions [0, len) as a float vector, len being a one element shape tensor
+nvinfer1::ITensor* positions(ConversionCtx* ctx, nvinfer1::ITensor* len, const std::string& name) {
+  auto fill_layer =
+      ctx->net->addFill(nvinfer1::Dims{1, {0}}, nvinfer1::FillOperation::kLINSPACE, nvinfer1::DataType::kFLOAT);
+  TORCHTRT_CHECK(fill_layer, "Unable to create fill layer for " << name);
+  fill_layer->setInput(0, *len);
+  fill_layer->setAlpha(0);
+  fill_layer->setBeta(1);
+  fill_layer->setName((name + "_fill").c_str());
+  return fill_layer->getOutput(0);
+}
+
+nvinfer1::ITensor* reshape(ConversionCtx* ctx, nvinfer1::ITensor* in, std::vector<int64_t> dims) {
+  auto shuffle_layer = ctx->net->addShuffle(*in);
+  TORCHTRT_CHECK(shuffle_layer, "Unable to create shuffle layer");
+  shuffle_layer->setReshapeDimensions(util::toDims(dims));
+  return shuffle_layer->getOutput(0);
+}
+
+// [num_bags, num_indices] float mask of the indices each bag reduces. Index i belongs to the bag of the last offset
+// not past it, so bag_of[i] = count(offsets <= i) - 1. Computed at build time when the offsets are frozen and the
+// number of indices is static
+nvinfer1::ITensor* bag_mask(
+    ConversionCtx* ctx,
+    args& args,
+    nvinfer1::ITensor* indices,
+    bool include_last_offset,
+    const std::string& name) {
+  auto num_indices = indices->getDimensions().d[0];
+  if (args[2].isIValue() && args[2].IValue()->isTensor() && num_indices >= 0) {
+    auto offsets = args[2].IValue()->toTensor().to(at::kCPU, at::kLong);
+    auto starts = include_last_offset ? offsets.narrow(0, 0, offsets.size(0) - 1) : offsets;
+    auto pos = torch::arange(num_indices, torch::kLong);
+    auto bag_of = starts.unsqueeze(1).le(pos.unsqueeze(0)).sum(0) - 1;
+    auto bags = torch::arange(starts.size(0), torch::kLong);
+    auto mask = bags.unsqueeze(1).eq(bag_of.unsqueeze(0)).to(at::kFloat);
+    return tensor_to_const(ctx, mask, name + "_bag_mask");
+  }
+
+  auto offsets = castITensor(ctx, args[2].ITensorOrFreeze(ctx), nvinfer1::DataType::kFLOAT, name + "_offsets");
+  auto num_offsets = getShapeOutput(ctx, offsets, name + "_num_offsets");
+  auto num_bags = num_offsets;
+  if (include_last_offset) {
+    auto one = tensor_to_const(ctx, torch::tensor({1}, torch::kInt32));
+    num_bags = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kSUB, num_offsets, one, name + "_num_bags")
+                   ->getOutput(0);
+  }
+  auto pos = reshape(ctx, positions(ctx, getShapeOutput(ctx, indices, name + "_num_indices"), name + "_pos"), {1, -1});
+
+  // starts[b] <= i as 1.0, summed over the offsets
+  auto starts = reshape(ctx, offsets, {-1, 1});
+  auto past = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kGREATER, starts, pos, name + "_past");
+  auto not_past = ctx->net->addUnary(*past->getOutput(0), nvinfer1::UnaryOperation::kNOT);
+  TORCHTRT_CHECK(not_past, "Unable to create not layer for " << name);
+  auto started = castITensor(ctx, not_past->getOutput(0), nvinfer1::DataType::kFLOAT, name + "_started");
+  auto count = ctx->net->addReduce(*started, nvinfer1::ReduceOperation::kSUM, 1, true);
+  TORCHTRT_CHECK(count, "Unable to create reduce layer for " << name);
+  auto one = tensor_to_const(ctx, torch::tensor({{1.0f}}, torch::kFloat));
+  auto bag_of =
+      add_elementwise(ctx, nvinfer1::ElementWiseOperation::kSUB, count->getOutput(0), one, name + "_bag_of");
+
+  auto bags = reshape(ctx, positions(ctx, num_bags, name + "_bags"), {-1, 1});
+  auto mask = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kEQUAL, bags, bag_of->getOutput(0), name + "_mask");
+  return castITensor(ctx, mask->getOutput(0), nvinfer1::DataType::kFLOAT, name + "_bag_mask");
+}
+
+// Converts both embedding_bag overloads, padding_idx is only given by the newer one
+bool convert_embedding_bag(ConversionCtx* ctx, const torch::jit::Node* n, args& args, bool has_padding_idx) {
+  for (size_t i = 1; i < n->outputs().size(); i++) {
+    TORCHTRT_CHECK(
+        !n->outputs()[i]->hasUses(),
+        "Only the first output of aten::embedding_bag is supported in TensorRT, node: " << *n);
+  }
+  auto mode = static_cast<BagMode>(args[4].unwrapToInt());
+  auto include_last_offset = args[7].unwrapToBool();
+  auto name = util::node_info(n);
+
+  auto indices = args[1].ITensorOrFreeze(ctx);
+  TORCHTRT_CHECK(
+      indices->getDimensions().nbDims == 1,
+      "aten::embedding_bag expects 1D indices with offsets in TensorRT, got " << indices->getDimensions());
+  auto rows = gather_rows(ctx, n, args, indices, name);
+  auto mask = bag_mask(ctx, args, indices, include_last_offset, name);
+
+  // Indices equal to padding_idx are left out of their bag
+  if (has_padding_idx && !args[8].IValue()->isNone()) {
+    auto padding_idx = static_cast<float>(args[8].unwrapToInt());
+    auto idx = reshape(ctx, castITensor(ctx, indices, nvinfer1::DataType::kFLOAT, name + "_idx"), {1, -1});
+    auto pad = tensor_to_const(ctx, torch::tensor({{padding_idx}}, torch::kFloat));
+    auto is_pad = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kEQUAL, idx, pad, name + "_is_pad");
+    auto not_pad = ctx->net->addUnary(*is_pad->getOutput(0), nvinfer1::UnaryOperation::kNOT);
+    TORCHTRT_CHECK(not_pad, "Unable to create not layer from node: " << *n);
+    auto keep = castITensor(ctx, not_pad->getOutput(0), nvinfer1::DataType::kFLOAT, name + "_keep");
+    mask = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kPROD, mask, keep, name + "_unpadded")->getOutput(0);
+  }
+
+  nvinfer1::ITensor* out = nullptr;
+  if (mode == BagMode::kMAX) {
+    TORCHTRT_CHECK(
+        args[6].IValue()->isNone(), "aten::embedding_bag only supports per_sample_weights in sum mode, node: " << *n);
+    // [B, N, 1] mask against [1, N, D] rows, masked out rows are -inf and empty bags are 0 like PyTorch
+    auto neg_inf = tensor_to_const(ctx, torch::tensor({{{-std::numeric_limits<float>::infinity()}}}, torch::kFloat));
+    auto zero = tensor_to_const(ctx, torch::tensor({{0.0f}}, torch::kFloat));
+    auto mask_3d = reshape(ctx, mask, {0, 0, 1});
+    auto in_bag = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kGREATER, mask_3d, zero, name + "_in_bag");
+    auto rows_3d = reshape(ctx, rows, {1, -1, rows->getDimensions().d[1]});
+    auto select_layer = ctx->net->addSelect(*in_bag->getOutput(0), *rows_3d, *neg_inf);
+    TORCHTRT_CHECK(select_layer, "Unable to create select layer from node: " << *n);
+    auto max_layer = ctx->net->addReduce(*select_layer->getOutput(0), nvinfer1::ReduceOperation::kMAX, 1 << 1, false);
+    TORCHTRT_CHECK(max_layer, "Unable to create reduce layer from node: " << *n);
+
+    auto size = ctx->net->addReduce(*mask, nvinfer1::ReduceOperation::kSUM, 1 << 1, true);
+    TORCHTRT_CHECK(size, "Unable to create reduce layer from node: " << *n);
+    auto non_empty = add_elementwise(
+        ctx, nvinfer1::ElementWiseOperation::kGREATER, size->getOutput(0), zero, name + "_non_empty");
+    auto empty_layer = ctx->net->addSelect(*non_empty->getOutput(0), *max_layer->getOutput(0), *zero);
+    TORCHTRT_CHECK(empty_layer, "Unable to create select layer from node: " << *n);
+    empty_layer->setName((name + "_max").c_str());
+    out = empty_layer->getOutput(0);
+  } else {
+    // Sums and means are folded into the mask, which turns the reduction into a single [B, N] x [N, D] product
+    if (!args[6].IValue()->isNone()) {
+      TORCHTRT_CHECK(
+          mode == BagMode::kSUM, "aten::embedding_bag only supports per_sample_weights in sum mode, node: " << *n);
+      auto weights = castITensor(ctx, args[6].ITensorOrFreeze(ctx), nvinfer1::DataType::kFLOAT, name + "_weights");
+      weights = reshape(ctx, weights, {1, -1});
+      mask =
+          add_elementwise(ctx, nvinfer1::ElementWiseOperation::kPROD, mask, weights, name + "_weighted")->getOutput(0);
+    }
+    if (mode == BagMode::kMEAN) {
+      auto size = ctx->net->addReduce(*mask, nvinfer1::ReduceOperation::kSUM, 1 << 1, true);
+      TORCHTRT_CHECK(size, "Unable to create reduce layer from node: " << *n);
+      auto one = tensor_to_const(ctx, torch::tensor({{1.0f}}, torch::kFloat));
+      auto clamped =
+          add_elementwise(ctx, nvinfer1::ElementWiseOperation::kMAX, size->getOutput(0), one, name + "_size");
+      mask = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kDIV, mask, clamped->getOutput(0), name + "_mean")
+                 ->getOutput(0);
+    }
+    auto mm_layer =
+        ctx->net->addMatrixMultiply(*mask, nvinfer1::MatrixOperation::kNONE, *rows, nvinfer1::MatrixOperation::kNONE);
+    TORCHTRT_CHECK(mm_layer, "Unable to create matrix multiply layer from node: " << *n);
+    mm_layer->setName((name + "_reduce").c_str());
+    out = mm_layer->getOutput(0);
+  }
+
+  auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], out);
+  LOG_DEBUG("Output tensor shape: " << out_tensor->getDimensions());
+  return true;
+}
+
+auto embedding_registrations TORCHTRT_UNUSED =
+    RegisterNodeConversionPatterns()
+        .pattern(
+            {"aten::embedding(Tensor weight, Tensor indices, int padding_idx=-1, bool scale_grad_by_freq=False, bool sparse=False) -> (Tensor)",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               // padding_idx only affects the gradient
+               auto rows = gather_rows(ctx, n, args, args[1].ITensorOrFreeze(ctx), util::node_info(n));
+               auto out = ctx->AssociateValueAndTensor(n->outputs()[0], rows);
+
+               LOG_DEBUG("Output tensor shape: " << out->getDimensions());
+
+               return true;
+             }})
+        .pattern(
+            {"aten::embedding_bag(Tensor weight, Tensor indices, Tensor offsets, bool scale_grad_by_freq=False, int mode=0, bool sparse=False, Tensor? per_sample_weights=None, bool include_last_offset=False) -> (Tensor, Tensor, Tensor, Tensor)",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               return convert_embedding_bag(ctx, n, args, false);
+             }})
+        .pattern(
+            {"aten::embedding_bag.padding_idx(Tensor weight, Tensor indices, Tensor offsets, bool scale_grad_by_freq, int mode, bool sparse, Tensor? per_sample_weights, bool include_last_offset, int? padding_idx) -> (Tensor, Tensor, Tensor, Tensor)",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               return convert_embedding_bag(ctx, n, args, true);
+             }});
+
+} // namespace
+} // namespace impl
+} // namespace converters
+} // namespace conversion
+} // namespace core
+} // namespace torch_tensorrt
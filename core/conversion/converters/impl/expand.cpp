@@ -123,6 +123,7 @@ bool add_expand_dynamic(
   slice->setInput(2, *sizes);
   slice->setInput(3, *strides);
 
+  ctx->broadcast_sources[slice->getOutput(0)] = shuffle->getOutput(0);
   auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], slice->getOutput(0));
 
   LOG_DEBUG("Expand layer output tensor shape: " << out_tensor->getDimensions());
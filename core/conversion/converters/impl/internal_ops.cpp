@@ -1,3 +1,4 @@
+#include <cmath>
 #include "core/conversion/converters/converters.h"
 #include "core/util/prelude.h"
 #include "torch/torch.h"
@@ -9,6 +10,122 @@ namespace converters {
 namespace impl {
 namespace {
 
+// Constant of the given rank with every dimension 1, so it broadcasts against any tensor of that rank
+nvinfer1::ITensor* broadcastable_scalar(
+    ConversionCtx* ctx,
+    float value,
+    int nbDims,
+    nvinfer1::DataType dtype,
+    const std::string& name) {
+  auto t = tensor_to_const(ctx, torch::full(std::vector<int64_t>(nbDims, 1), value, torch::kFloat), name);
+  return castITensor(ctx, t, dtype, name);
+}
+
+// Positions [0, n) along dim of in, reshaped to reshape_dims
+nvinfer1::ITensor* positions(
+    ConversionCtx* ctx,
+    nvinfer1::ITensor* in,
+    int dim,
+    nvinfer1::Dims reshape_dims,
+    const std::string& name) {
+  auto shape = getShapeOutput(ctx, in, name + "_shape");
+  auto dim_index = tensor_to_const(ctx, torch::tensor({dim}, torch::kInt32));
+  auto len = ctx->net->addGather(*shape, *dim_index, 0)->getOutput(0);
+  auto fill_layer =
+      ctx->net->addFill(nvinfer1::Dims{1, {0}}, nvinfer1::FillOperation::kLINSPACE, nvinfer1::DataType::kFLOAT);
+  TORCHTRT_CHECK(fill_layer, "Unable to create fill layer for " << name);
+  fill_layer->setInput(0, *len);
+  fill_layer->setAlpha(0);
+  fill_layer->setBeta(1);
+  fill_layer->setName((name + "_fill").c_str());
+  auto shuffle_layer = ctx->net->addShuffle(*fill_layer->getOutput(0));
+  TORCHTRT_CHECK(shuffle_layer, "Unable to create shuffle layer for " << name);
+  shuffle_layer->setReshapeDimensions(reshape_dims);
+  shuffle_layer->setName((name + "_reshape").c_str());
+  return shuffle_layer->getOutput(0);
+}
+
+// Positions [0, n) along the sequence dim (second to last) of in, reshaped to reshape_dims
+nvinfer1::ITensor* sequence_positions(
+    ConversionCtx* ctx,
+    nvinfer1::ITensor* in,
+    nvinfer1::Dims reshape_dims,
+    const std::string& name) {
+  return positions(ctx, in, in->getDimensions().nbDims - 2, reshape_dims, name);
+}
+
+// Elements [start, start + size(in) - 1) of the 1D tensor in
+nvinfer1::ITensor* drop_one(ConversionCtx* ctx, nvinfer1::ITensor* in, int64_t start, const std::string& name) {
+  auto shape = getShapeOutput(ctx, in, name + "_shape");
+  auto size = add_elementwise(
+                  ctx,
+                  nvinfer1::ElementWiseOperation::kSUB,
+                  shape,
+                  tensor_to_const(ctx, torch::tensor({1}, torch::kInt32)),
+                  name + "_size")
+                  ->getOutput(0);
+  auto slice_layer =
+      ctx->net->addSlice(*in, nvinfer1::Dims{1, {start}}, nvinfer1::Dims{1, {0}}, nvinfer1::Dims{1, {1}});
+  TORCHTRT_CHECK(slice_layer, "Unable to create slice layer for " << name);
+  slice_layer->setInput(2, *size);
+  slice_layer->setName((name + "_slice").c_str());
+  return slice_layer->getOutput(0);
+}
+
+nvinfer1::ITensor* shuffle_reshape(
+    ConversionCtx* ctx,
+    nvinfer1::ITensor* in,
+    std::vector<int64_t> dims,
+    const std::string& name) {
+  auto shuffle_layer = ctx->net->addShuffle(*in);
+  TORCHTRT_CHECK(shuffle_layer, "Unable to create shuffle layer for " << name);
+  shuffle_layer->setReshapeDimensions(util::toDims(c10::IntArrayRef(dims)));
+  shuffle_layer->setName(name.c_str());
+  return shuffle_layer->getOutput(0);
+}
+
+nvinfer1::ITensor* shuffle_transpose(
+    ConversionCtx* ctx,
+    nvinfer1::ITensor* in,
+    nvinfer1::Permutation perm,
+    const std::string& name) {
+  auto shuffle_layer = ctx->net->addShuffle(*in);
+  TORCHTRT_CHECK(shuffle_layer, "Unable to create shuffle layer for " << name);
+  shuffle_layer->setFirstTranspose(perm);
+  shuffle_layer->setName(name.c_str());
+  return shuffle_layer->getOutput(0);
+}
+
+// [L, S] additive bias which masks out keys past the position of each query, aligned to the top left like PyTorch
+nvinfer1::ITensor* causal_attn_bias(
+    ConversionCtx* ctx,
+    nvinfer1::ITensor* query,
+    nvinfer1::ITensor* key,
+    nvinfer1::DataType dtype,
+    const std::string& name) {
+  auto q_dims = query->getDimensions();
+  auto k_dims = key->getDimensions();
+  auto tgt_len = q_dims.d[q_dims.nbDims - 2];
+  auto src_len = k_dims.d[k_dims.nbDims - 2];
+  auto neg_inf = -std::numeric_limits<float>::infinity();
+  if (tgt_len != -1 && src_len != -1) {
+    auto future = torch::ones({tgt_len, src_len}, torch::kBool).triu(1);
+    auto bias = torch::zeros({tgt_len, src_len}, torch::kFloat).masked_fill(future, neg_inf);
+    return castITensor(ctx, tensor_to_const(ctx, bias, name), dtype, name);
+  }
+
+  auto rows = sequence_positions(ctx, query, util::toDims(std::vector<int64_t>({-1, 1})), name + "_rows");
+  auto cols = sequence_positions(ctx, key, util::toDims(std::vector<int64_t>({1, -1})), name + "_cols");
+  auto future = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kGREATER, cols, rows, name + "_future");
+  auto select_layer = ctx->net->addSelect(
+      *future->getOutput(0),
+      *broadcastable_scalar(ctx, neg_inf, 2, nvinfer1::DataType::kFLOAT, name + "_neg_inf"),
+      *broadcastable_scalar(ctx, 0, 2, nvinfer1::DataType::kFLOAT, name + "_zero"));
+  TORCHTRT_CHECK(select_layer, "Unable to create select layer for " << name);
+  select_layer->setName((name + "_select").c_str());
+  return castITensor(ctx, select_layer->getOutput(0), dtype, name);
+}
+
 auto linear_registrations TORCHTRT_UNUSED = RegisterNodeConversionPatterns().pattern(
     {"trt::attn_bias_from_attn_mask(Tensor attn_mask) -> Tensor",
      [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
@@ -37,7 +154,254 @@ auto linear_registrations TORCHTRT_UNUSED = RegisterNodeConversionPatterns().pat
        LOG_DEBUG("Output tensor shape: " << out_tensor->getDimensions());
        LOG_DEBUG("Output tensor type: " << out_tensor->getType());
        return true;
-     }});
+     }})
+        .pattern(
+            {"trt::scaled_dot_product_attention(Tensor query, Tensor key, Tensor value, Tensor? attn_mask, bool is_causal, float? scale) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               // Converter for internal op produced by fuse_scaled_dot_product_attention
+               // Emits matmul -> scale -> bias -> softmax -> matmul in the form TensorRT matches to its fused
+               // multi-head attention kernels, so the [L, S] attention matrix is never written to memory
+               auto query = args[0].ITensorOrFreeze(ctx);
+               auto key = args[1].ITensorOrFreeze(ctx);
+               auto value = args[2].ITensorOrFreeze(ctx);
+               auto is_causal = args[4].unwrapToBool();
+               auto name = util::node_info(n);
+               auto nbDims = query->getDimensions().nbDims;
+               TORCHTRT_CHECK(
+                   nbDims >= 2 && key->getDimensions().nbDims == nbDims && value->getDimensions().nbDims == nbDims,
+                   "Expected query, key and value of the same rank (at least 2) for " << *n);
+               auto dtype = query->getType();
+
+               auto qk_layer = ctx->net->addMatrixMultiply(
+                   *query, nvinfer1::MatrixOperation::kNONE, *key, nvinfer1::MatrixOperation::kTRANSPOSE);
+               TORCHTRT_CHECK(qk_layer, "Unable to create matrix multiplication node: " << *n);
+               qk_layer->setName((name + "_qk").c_str());
+               auto attn_weight = qk_layer->getOutput(0);
+
+               nvinfer1::ITensor* scale_factor = nullptr;
+               auto embed_dim = query->getDimensions().d[nbDims - 1];
+               if (args[5].isIValue() && !args[5].IValue()->isNone()) {
+                 scale_factor =
+                     broadcastable_scalar(ctx, args[5].unwrapToDouble(), nbDims, dtype, name + "_scale_factor");
+               } else if (embed_dim != -1) {
+                 scale_factor =
+                     broadcastable_scalar(ctx, 1.0 / std::sqrt(embed_dim), nbDims, dtype, name + "_scale_factor");
+               } else {
+                 auto shape = getShapeOutput(ctx, query, name + "_shape");
+                 auto last_dim = tensor_to_const(ctx, torch::tensor({nbDims - 1}, torch::kInt32));
+                 auto embed_dim_tensor = ctx->net->addGather(*shape, *last_dim, 0)->getOutput(0);
+                 embed_dim_tensor = castITensor(ctx, embed_dim_tensor, nvinfer1::DataType::kFLOAT, name + "_embed_dim");
+                 auto sqrt_layer = ctx->net->addUnary(*embed_dim_tensor, nvinfer1::UnaryOperation::kSQRT);
+                 TORCHTRT_CHECK(sqrt_layer, "Unable to create sqrt layer from node: " << *n);
+                 sqrt_layer->setName((name + "_sqrt").c_str());
+                 auto recip_layer = ctx->net->addUnary(*sqrt_layer->getOutput(0), nvinfer1::UnaryOperation::kRECIP);
+                 TORCHTRT_CHECK(recip_layer, "Unable to create reciprocal layer from node: " << *n);
+                 recip_layer->setName((name + "_recip").c_str());
+                 scale_factor = castITensor(ctx, recip_layer->getOutput(0), dtype, name + "_scale_factor");
+               }
+               attn_weight = add_elementwise(
+                                 ctx, nvinfer1::ElementWiseOperation::kPROD, attn_weight, scale_factor, name + "_scale")
+                                 ->getOutput(0);
+
+               nvinfer1::ITensor* attn_bias = nullptr;
+               if (is_causal) {
+                 attn_bias = causal_attn_bias(ctx, query, key, dtype, name + "_causal_bias");
+               } else if (args[3].isITensor() || !args[3].IValue()->isNone()) {
+                 auto attn_mask = args[3].ITensorOrFreeze(ctx);
+                 if (attn_mask->getType() == nvinfer1::DataType::kBOOL) {
+                   auto mask_dims = attn_mask->getDimensions().nbDims;
+                   auto select_layer = ctx->net->addSelect(
+                       *attn_mask,
+                       *broadcastable_scalar(ctx, 0, mask_dims, dtype, name + "_zero"),
+                       *broadcastable_scalar(
+                           ctx, -std::numeric_limits<float>::infinity(), mask_dims, dtype, name + "_neg_inf"));
+                   TORCHTRT_CHECK(select_layer, "Unable to create select layer from node: " << *n);
+                   select_layer->setName((name + "_attn_bias").c_str());
+                   attn_bias = select_layer->getOutput(0);
+                 } else {
+                   attn_bias = castITensor(ctx, attn_mask, dtype, name + "_attn_bias");
+                 }
+               }
+               if (attn_bias) {
+                 attn_weight =
+                     add_elementwise(ctx, nvinfer1::ElementWiseOperation::kSUM, attn_weight, attn_bias, name + "_bias")
+                         ->getOutput(0);
+               }
+
+               auto softmax_layer = ctx->net->addSoftMax(*attn_weight);
+               TORCHTRT_CHECK(softmax_layer, "Unable to create softmax layer from node: " << *n);
+               softmax_layer->setAxes(1 << (nbDims - 1));
+               softmax_layer->setName((name + "_softmax").c_str());
+
+               auto out_layer = ctx->net->addMatrixMultiply(
+                   *softmax_layer->getOutput(0),
+                   nvinfer1::MatrixOperation::kNONE,
+                   *value,
+                   nvinfer1::MatrixOperation::kNONE);
+               TORCHTRT_CHECK(out_layer, "Unable to create matrix multiplication node: " << *n);
+               out_layer->setName((name + "_out").c_str());
+
+               auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], out_layer->getOutput(0));
+               LOG_DEBUG("Output tensor shape: " << out_tensor->getDimensions());
+               return true;
+             }})
+        .pattern(
+            {"trt::varlen_attention(Tensor query, Tensor key, Tensor value, Tensor cu_seqlens, int max_seqlen, float? scale) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               // query, key and value are the [T, H, D] tokens of B sequences packed one after the other, sequence b
+               // being tokens [cu_seqlens[b], cu_seqlens[b + 1]). Only attention needs the sequences apart, so the
+               // tokens are gathered into [B, H, L, D] blocks of max_seqlen L for it and scattered back after it
+               auto query = args[0].ITensorOrFreeze(ctx);
+               auto key = args[1].ITensorOrFreeze(ctx);
+               auto value = args[2].ITensorOrFreeze(ctx);
+               auto max_seqlen = args[4].unwrapToInt();
+               auto name = util::node_info(n);
+               TORCHTRT_CHECK(
+                   query->getDimensions().nbDims == 3 && key->getDimensions().nbDims == 3 &&
+                       value->getDimensions().nbDims == 3,
+                   "Expected packed [tokens, heads, head_dim] query, key and value for " << *n);
+               TORCHTRT_CHECK(max_seqlen > 0, "Expected a positive max_seqlen for " << *n);
+               auto dtype = query->getType();
+               auto int32 = nvinfer1::DataType::kINT32;
+
+               auto cu_seqlens = castITensor(ctx, args[3].ITensorOrFreeze(ctx), int32, name + "_cu_seqlens");
+               auto starts = drop_one(ctx, cu_seqlens, 0, name + "_starts");
+               auto ends = drop_one(ctx, cu_seqlens, 1, name + "_ends");
+               auto lens = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kSUB, ends, starts, name + "_lens")
+                               ->getOutput(0);
+
+               // [B, L] token of each position of the blocks, positions past the end of their sequence read token 0
+               // and are masked out as keys
+               auto block_pos = tensor_to_const(
+                   ctx, torch::arange(max_seqlen, torch::kInt32).reshape({1, max_seqlen}), name + "_block_pos");
+               auto block_tokens = add_elementwise(
+                                       ctx,
+                                       nvinfer1::ElementWiseOperation::kSUM,
+                                       shuffle_reshape(ctx, starts, {-1, 1}, name + "_starts_col"),
+                                       block_pos,
+                                       name + "_block_tokens")
+                                       ->getOutput(0);
+               auto valid = add_elementwise(
+                                ctx,
+                                nvinfer1::ElementWiseOperation::kLESS,
+                                block_pos,
+                                shuffle_reshape(ctx, lens, {-1, 1}, name + "_lens_col"),
+                                name + "_valid")
+                                ->getOutput(0);
+               auto pad_select = ctx->net->addSelect(
+                   *valid, *block_tokens, *tensor_to_const(ctx, torch::zeros({1, 1}, torch::kInt32), name + "_pad"));
+               TORCHTRT_CHECK(pad_select, "Unable to create select layer from node: " << *n);
+               pad_select->setName((name + "_block_index").c_str());
+               auto block_index = pad_select->getOutput(0);
+
+               auto to_blocks = [&](nvinfer1::ITensor* in, const std::string& suffix) {
+                 auto gather_layer = ctx->net->addGather(*in, *block_index, 0);
+                 TORCHTRT_CHECK(gather_layer, "Unable to create gather layer from node: " << *n);
+                 gather_layer->setName((name + suffix + "_gather").c_str());
+                 return shuffle_transpose(ctx, gather_layer->getOutput(0), {{0, 2, 1, 3}}, name + suffix + "_blocks");
+               };
+               auto q = to_blocks(query, "_query");
+               auto k = to_blocks(key, "_key");
+               auto v = to_blocks(value, "_value");
+
+               auto qk_layer = ctx->net->addMatrixMultiply(
+                   *q, nvinfer1::MatrixOperation::kNONE, *k, nvinfer1::MatrixOperation::kTRANSPOSE);
+               TORCHTRT_CHECK(qk_layer, "Unable to create matrix multiplication node: " << *n);
+               qk_layer->setName((name + "_qk").c_str());
+
+               double scale = 0;
+               if (args[5].isIValue() && !args[5].IValue()->isNone()) {
+                 scale = args[5].unwrapToDouble();
+               } else {
+                 auto head_dim = query->getDimensions().d[2];
+                 TORCHTRT_CHECK(head_dim != -1, "Expected a static head_dim or an explicit scale for " << *n);
+                 scale = 1.0 / std::sqrt(head_dim);
+               }
+               auto attn_weight = add_elementwise(
+                                      ctx,
+                                      nvinfer1::ElementWiseOperation::kPROD,
+                                      qk_layer->getOutput(0),
+                                      broadcastable_scalar(ctx, scale, 4, dtype, name + "_scale_factor"),
+                                      name + "_scale")
+                                      ->getOutput(0);
+
+               auto bias_select = ctx->net->addSelect(
+                   *shuffle_reshape(ctx, valid, {-1, 1, 1, max_seqlen}, name + "_key_valid"),
+                   *broadcastable_scalar(ctx, 0, 4, dtype, name + "_zero"),
+                   *broadcastable_scalar(ctx, -std::numeric_limits<float>::infinity(), 4, dtype, name + "_neg_inf"));
+               TORCHTRT_CHECK(bias_select, "Unable to create select layer from node: " << *n);
+               bias_select->setName((name + "_key_padding_bias").c_str());
+               attn_weight = add_elementwise(
+                                 ctx,
+                                 nvinfer1::ElementWiseOperation::kSUM,
+                                 attn_weight,
+                                 bias_select->getOutput(0),
+                                 name + "_bias")
+                                 ->getOutput(0);
+
+               auto softmax_layer = ctx->net->addSoftMax(*attn_weight);
+               TORCHTRT_CHECK(softmax_layer, "Unable to create softmax layer from node: " << *n);
+               softmax_layer->setAxes(1 << 3);
+               softmax_layer->setName((name + "_softmax").c_str());
+               auto av_layer = ctx->net->addMatrixMultiply(
+                   *softmax_layer->getOutput(0),
+                   nvinfer1::MatrixOperation::kNONE,
+                   *v,
+                   nvinfer1::MatrixOperation::kNONE);
+               TORCHTRT_CHECK(av_layer, "Unable to create matrix multiplication node: " << *n);
+               av_layer->setName((name + "_av").c_str());
+               auto blocks = shuffle_transpose(ctx, av_layer->getOutput(0), {{0, 2, 1, 3}}, name + "_out_blocks");
+
+               // Token t belongs to the sequence b of the ends it is past, at position t - starts[b] of its block
+               auto tokens = positions(ctx, query, 0, util::toDims(std::vector<int64_t>({-1, 1})), name + "_tokens");
+               tokens = castITensor(ctx, tokens, int32, name + "_tokens_int");
+               auto next_tokens = add_elementwise(
+                                      ctx,
+                                      nvinfer1::ElementWiseOperation::kSUM,
+                                      tokens,
+                                      tensor_to_const(ctx, torch::ones({1, 1}, torch::kInt32)),
+                                      name + "_next_tokens")
+                                      ->getOutput(0);
+               auto past_end = add_elementwise(
+                                   ctx,
+                                   nvinfer1::ElementWiseOperation::kLESS,
+                                   shuffle_reshape(ctx, ends, {1, -1}, name + "_ends_row"),
+                                   next_tokens,
+                                   name + "_past_end")
+                                   ->getOutput(0);
+               auto sum_layer = ctx->net->addReduce(
+                   *castITensor(ctx, past_end, nvinfer1::DataType::kFLOAT, name + "_past_end_float"),
+                   nvinfer1::ReduceOperation::kSUM,
+                   1 << 1,
+                   true);
+               TORCHTRT_CHECK(sum_layer, "Unable to create reduce layer from node: " << *n);
+               sum_layer->setName((name + "_seq").c_str());
+               auto seq = castITensor(ctx, sum_layer->getOutput(0), int32, name + "_seq_index");
+               auto seq_start = ctx->net->addGather(*starts, *shuffle_reshape(ctx, seq, {-1}, name + "_seq_flat"), 0);
+               TORCHTRT_CHECK(seq_start, "Unable to create gather layer from node: " << *n);
+               seq_start->setName((name + "_seq_start").c_str());
+               auto pos = add_elementwise(
+                              ctx,
+                              nvinfer1::ElementWiseOperation::kSUB,
+                              tokens,
+                              shuffle_reshape(ctx, seq_start->getOutput(0), {-1, 1}, name + "_seq_start_col"),
+                              name + "_pos")
+                              ->getOutput(0);
+               std::vector<nvinfer1::ITensor*> nd_index = {seq, pos};
+               auto concat_layer = ctx->net->addConcatenation(nd_index.data(), nd_index.size());
+               TORCHTRT_CHECK(concat_layer, "Unable to create concatenation layer from node: " << *n);
+               concat_layer->setAxis(1);
+               concat_layer->setName((name + "_unpad_index").c_str());
+               auto unpad_layer = ctx->net->addGather(*blocks, *concat_layer->getOutput(0), 0);
+               TORCHTRT_CHECK(unpad_layer, "Unable to create gather layer from node: " << *n);
+               unpad_layer->setMode(nvinfer1::GatherMode::kND);
+               unpad_layer->setNbElementWiseDims(0);
+               unpad_layer->setName((name + "_unpad").c_str());
+
+               auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], unpad_layer->getOutput(0));
+               LOG_DEBUG("Output tensor shape: " << out_tensor->getDimensions());
+               return true;
+             }});
 } // namespace
 } // namespace impl
 } // namespace converters
@@ -41,8 +41,14 @@ auto linear_registrations TORCHTRT_UNUSED = RegisterNodeConversionPatterns().pat
        }
 
        // Convert w_tensor to ITensor and broadcast 2d to 4d if needed
-       auto weight = args[1].IValue()->toTensor();
-       auto weight_tensor = tensor_to_const(ctx, weight, util::node_info(n) + "_weight");
+       nvinfer1::ITensor* weight_tensor = nullptr;
+       if (args[1].isITensor()) {
+         // Weights computed in the network, e.g. dequantized from block quantized INT4
+         weight_tensor = args[1].ITensor();
+       } else {
+         auto weight = args[1].IValue()->toTensor();
+         weight_tensor = tensor_to_const(ctx, weight, util::node_info(n) + "_weight");
+       }
        auto weight_shape = util::toVec(weight_tensor->getDimensions());
        weight_tensor = addPadding(ctx, n, weight_tensor, in->getDimensions().nbDims, false, false);
 
@@ -1,3 +1,4 @@
+#include <cmath>
 #include "NvInfer.h"
 #include "NvInferRuntimeCommon.h"
 #include "core/conversion/converters/converters.h"
@@ -11,48 +12,6 @@ namespace converters {
 namespace impl {
 namespace {
 
-/*
- * Helper functions
- */
-void create_plugin(
-    ConversionCtx* ctx,
-    const torch::jit::Node* n,
-    nvinfer1::ITensor* in,
-    int64_t order,
-    std::vector<int32_t> axes,
-    bool keep_dims,
-    const char* name) {
-  LOG_WARNING("Normalize layer will be run through ATen, not TensorRT. Performance may be lower than expected");
-  nvinfer1::PluginFieldCollection fc;
-  std::vector<nvinfer1::PluginField> f;
-  f.emplace_back(nvinfer1::PluginField("order", &order, nvinfer1::PluginFieldType::kINT32, 1));
-  f.emplace_back(nvinfer1::PluginField("axes", axes.data(), nvinfer1::PluginFieldType::kINT32, axes.size()));
-  f.emplace_back(nvinfer1::PluginField("keep_dims", &keep_dims, nvinfer1::PluginFieldType::kINT32, 1));
-  fc.nbFields = f.size();
-  fc.fields = f.data();
-
-  auto inputnbDims = in->getDimensions().nbDims;
-  for (int64_t i = 0; i < (int64_t)axes.size(); i++) {
-    if (axes[i] < 0) {
-      axes[i] += inputnbDims;
-    }
-    if (axes[i] > inputnbDims - 1) {
-      TORCHTRT_THROW_ERROR("Axis of normalization layer cannot exceed input rank");
-    }
-  }
-
-  auto creator = getPluginRegistry()->getPluginCreator("NormalizePlugin", "1", "torch_tensorrt");
-  auto plugin = creator->createPlugin(name, &fc);
-  auto normalize_layer = ctx->net->addPluginV2(reinterpret_cast<nvinfer1::ITensor* const*>(&in), 1, *plugin);
-  TORCHTRT_CHECK(normalize_layer, "Unable to create normalization plugin from node" << *n);
-
-  normalize_layer->setName(util::node_info(n).c_str());
-
-  auto layer_output = ctx->AssociateValueAndTensor(n->outputs()[0], normalize_layer->getOutput(0));
-
-  LOG_DEBUG("Normalize layer output tensor shape: " << layer_output->getDimensions());
-}
-
 int32_t axes_mask_from_axes_values(
     const torch::jit::Node* n,
     int32_t nb_dims,
@@ -94,25 +53,78 @@ nvinfer1::ITensor* frobenius_norm(
   return sqrt_output;
 }
 
+// Vector p-norm of self over the axes in axes_mask: max or min of |x| for p = +/-inf, the number of non zero values for
+// p = 0 and (sum |x|^p)^(1/p) otherwise
+nvinfer1::ITensor* p_norm(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    nvinfer1::ITensor* self,
+    double order,
+    int32_t axes_mask,
+    bool keep_dims) {
+  if (order == 2.0) {
+    return frobenius_norm(ctx, n, self, axes_mask, keep_dims);
+  }
+  auto name = util::node_info(n);
+  auto dtype = self->getType();
+  auto abs_layer = ctx->net->addUnary(*self, nvinfer1::UnaryOperation::kABS);
+  TORCHTRT_CHECK(abs_layer, "Unable to create abs layer from node: " << *n);
+  abs_layer->setName((name + "_abs").c_str());
+  auto abs_output = abs_layer->getOutput(0);
+
+  auto reduce = [&](nvinfer1::ITensor* in, nvinfer1::ReduceOperation op) {
+    auto reduce_layer = ctx->net->addReduce(*in, op, axes_mask, keep_dims);
+    TORCHTRT_CHECK(reduce_layer, "Unable to create reduce layer from node: " << *n);
+    reduce_layer->setName((name + "_reduce").c_str());
+    return reduce_layer->getOutput(0);
+  };
+  auto constant = [&](double value) { return castITensor(ctx, scalar_to_tensor(ctx, value), dtype); };
+
+  if (std::isinf(order)) {
+    return reduce(abs_output, order > 0 ? nvinfer1::ReduceOperation::kMAX : nvinfer1::ReduceOperation::kMIN);
+  } else if (order == 0.0) {
+    auto is_zero = add_elementwise(
+        ctx, nvinfer1::ElementWiseOperation::kEQUAL, abs_output, constant(0.0), name + "_is_zero");
+    TORCHTRT_CHECK(is_zero, "Unable to create equal layer from node: " << *n);
+    auto non_zero_layer = ctx->net->addUnary(*is_zero->getOutput(0), nvinfer1::UnaryOperation::kNOT);
+    TORCHTRT_CHECK(non_zero_layer, "Unable to create not layer from node: " << *n);
+    non_zero_layer->setName((name + "_non_zero").c_str());
+    return reduce(castITensor(ctx, non_zero_layer->getOutput(0), dtype), nvinfer1::ReduceOperation::kSUM);
+  } else if (order == 1.0) {
+    return reduce(abs_output, nvinfer1::ReduceOperation::kSUM);
+  }
+
+  auto pow_layer =
+      add_elementwise(ctx, nvinfer1::ElementWiseOperation::kPOW, abs_output, constant(order), name + "_pow");
+  TORCHTRT_CHECK(pow_layer, "Unable to create pow layer from node: " << *n);
+  auto sum_output = reduce(pow_layer->getOutput(0), nvinfer1::ReduceOperation::kSUM);
+  auto root_layer =
+      add_elementwise(ctx, nvinfer1::ElementWiseOperation::kPOW, sum_output, constant(1.0 / order), name + "_root");
+  TORCHTRT_CHECK(root_layer, "Unable to create pow layer from node: " << *n);
+  return root_layer->getOutput(0);
+}
+
 auto normalize_registrations TORCHTRT_UNUSED =
     RegisterNodeConversionPatterns()
         .pattern(
             {"aten::norm.ScalarOpt_dim(Tensor self, Scalar? p, int[1] dim, bool keepdim=False) -> (Tensor)",
              [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
-               auto in = args[0].ITensorOrFreeze(ctx);
-               auto in_shape = util::toVec(in->getDimensions());
-               auto order = args[1].unwrapToScalar().to<int32_t>();
+               auto self = args[0].ITensorOrFreeze(ctx);
+               // p defaults to the 2-norm
+               auto order = args[1].IValue()->isNone() ? 2.0 : args[1].unwrapToScalar().to<double>();
                auto axes_values = args[2].unwrapToIntList().vec();
-               std::vector<int32_t> axes(axes_values.begin(), axes_values.end());
-               auto keep_dims = (int32_t)args[3].unwrapToBool();
-               LOG_DEBUG("Order of normalize_plugin: " << order);
-               LOG_DEBUG("Axis: " << axes);
+               auto keep_dims = args[3].unwrapToBool();
+               LOG_DEBUG("Order of norm: " << order);
+               LOG_DEBUG("Axis: " << axes_values);
                LOG_DEBUG("keep_dims: " << keep_dims);
-               create_plugin(ctx, n, in, order, axes, keep_dims, "NormalizePluginTorchTRT");
-               return true;
-             }
 
-            })
+               auto axes_mask = axes_mask_from_axes_values(n, self->getDimensions().nbDims, axes_values);
+
+               auto norm = p_norm(ctx, n, self, order, axes_mask, keep_dims);
+               auto out = ctx->AssociateValueAndTensor(n->outputs()[0], norm);
+               LOG_DEBUG("Output tensor shape: " << out->getDimensions());
+               return true;
+             }})
         .pattern(
             {"aten::frobenius_norm.dim(Tensor self, int[1] dim, bool keepdim=False) -> (Tensor)",
              [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "core/conversion/converters/converter_util.h"
 #include "core/conversion/converters/converters.h"
 #include "core/util/prelude.h"
@@ -37,12 +39,93 @@ bool GlobalPoolingConverter(
   return true;
 }
 
+// Pools the bins of adaptive pooling along axis, bin i covers [floor(i * L / out_len), ceil((i + 1) * L / out_len)).
+// Adaptive pooling over several axes is separable since its bins are the products of the bins of each axis
+nvinfer1::ITensor* AdaptivePoolAxis(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    nvinfer1::ITensor* in,
+    int32_t axis,
+    int64_t out_len,
+    nvinfer1::PoolingType pool_type) {
+  auto dims = in->getDimensions();
+  auto reduce_op =
+      pool_type == nvinfer1::PoolingType::kMAX ? nvinfer1::ReduceOperation::kMAX : nvinfer1::ReduceOperation::kAVG;
+  auto name = util::node_info(n) + "_axis_" + std::to_string(axis);
+  bool is_static = std::all_of(dims.d, dims.d + dims.nbDims, [](int64_t d) { return d >= 0; });
+
+  // The bounds of the bins of dynamic axes are computed from the runtime shape
+  nvinfer1::ITensor* len = nullptr;
+  nvinfer1::ITensor* onehot = nullptr;
+  nvinfer1::ITensor* other_dims = nullptr;
+  if (!is_static) {
+    auto shape = getShapeOutput(ctx, in, name + "_shape");
+    len = ctx->net->addGather(*shape, *tensor_to_const(ctx, torch::tensor({axis}, torch::kInt32)), 0)->getOutput(0);
+    auto onehot_mask = torch::zeros({dims.nbDims}, torch::kInt32);
+    onehot_mask[axis] = 1;
+    onehot = tensor_to_const(ctx, onehot_mask);
+    other_dims = add_elementwise(
+                     ctx,
+                     nvinfer1::ElementWiseOperation::kPROD,
+                     shape,
+                     tensor_to_const(ctx, 1 - onehot_mask),
+                     name + "_other_dims")
+                     ->getOutput(0);
+  }
+  auto int_const = [&](int64_t v) { return tensor_to_const(ctx, torch::tensor({v}, torch::kInt32)); };
+  int64_t num_shape_ops = 0;
+  auto op = [&](nvinfer1::ElementWiseOperation o, nvinfer1::ITensor* a, nvinfer1::ITensor* b) {
+    return add_elementwise(ctx, o, a, b, name + "_bounds_" + std::to_string(num_shape_ops++))->getOutput(0);
+  };
+
+  std::vector<nvinfer1::ITensor*> bins;
+  for (int64_t i = 0; i < out_len; i++) {
+    auto bin_name = name + "_bin_" + std::to_string(i);
+    nvinfer1::ISliceLayer* slice = nullptr;
+    if (is_static) {
+      auto start = (i * dims.d[axis]) / out_len;
+      auto end = ((i + 1) * dims.d[axis] + out_len - 1) / out_len;
+      auto start_dims = util::toDims(std::vector<int64_t>(dims.nbDims, 0));
+      auto size_dims = dims;
+      start_dims.d[axis] = start;
+      size_dims.d[axis] = end - start;
+      slice = ctx->net->addSlice(*in, start_dims, size_dims, util::toDims(std::vector<int64_t>(dims.nbDims, 1)));
+    } else {
+      using Op = nvinfer1::ElementWiseOperation;
+      // start = floor(i * L / out_len), end = ceil((i + 1) * L / out_len)
+      auto start = op(Op::kFLOOR_DIV, op(Op::kPROD, len, int_const(i)), int_const(out_len));
+      auto end = op(Op::kPROD, len, int_const(i + 1));
+      end = op(Op::kFLOOR_DIV, op(Op::kSUM, end, int_const(out_len - 1)), int_const(out_len));
+      auto start_vec = op(Op::kPROD, onehot, start);
+      auto size_vec = op(Op::kSUM, other_dims, op(Op::kPROD, onehot, op(Op::kSUB, end, start)));
+      auto ones = util::toDims(std::vector<int64_t>(dims.nbDims, 1));
+      slice = ctx->net->addSlice(*in, ones, ones, ones);
+      slice->setInput(1, *start_vec);
+      slice->setInput(2, *size_vec);
+    }
+    TORCHTRT_CHECK(slice, "Unable to create slice layer from node: " << *n);
+    slice->setName(bin_name.c_str());
+    auto reduce = ctx->net->addReduce(*slice->getOutput(0), reduce_op, 1u << axis, /*keepDimensions=*/true);
+    TORCHTRT_CHECK(reduce, "Unable to create reduce layer from node: " << *n);
+    reduce->setName((bin_name + "_reduce").c_str());
+    bins.push_back(reduce->getOutput(0));
+  }
+
+  if (bins.size() == 1) {
+    return bins[0];
+  }
+  auto concat = ctx->net->addConcatenation(bins.data(), bins.size());
+  TORCHTRT_CHECK(concat, "Unable to create concatenation layer from node: " << *n);
+  concat->setAxis(axis);
+  concat->setName((name + "_concat").c_str());
+  return concat->getOutput(0);
+}
+
 bool AdaptivePoolingConverter(
     ConversionCtx* ctx,
     const torch::jit::Node* n,
     args& args,
-    nvinfer1::PoolingType pool_type,
-    const std::string& mode) {
+    nvinfer1::PoolingType pool_type) {
   auto in = args[0].ITensorOrFreeze(ctx);
   auto out_size = util::toDims(args[1].unwrapToIntList());
 
@@ -53,60 +136,35 @@ bool AdaptivePoolingConverter(
   }
 
   auto orig_dims = in->getDimensions();
-  TORCHTRT_CHECK(orig_dims.nbDims > 1, "Unable to create pooling layer from node: " << *n);
-
-  auto in_shape = util::toVec(in->getDimensions());
-  nvinfer1::ILayer* new_layer = nullptr;
-
-  /*======CONFIGURE PLUGIN PARAMETERS======*/
-  nvinfer1::PluginFieldCollection fc;
-  std::vector<nvinfer1::PluginField> f;
-
-  auto out_shape = in_shape;
-  auto out_size_vec = util::toVec(out_size);
-
-  std::copy(out_size_vec.begin(), out_size_vec.end(), out_shape.begin() + (in_shape.size() - out_size_vec.size()));
-
-  std::vector<int32_t> in_shape_casted(in_shape.begin(), in_shape.end());
-  f.emplace_back(
-      nvinfer1::PluginField("in_shape", in_shape_casted.data(), nvinfer1::PluginFieldType::kINT32, in_shape.size()));
-
-  std::vector<int32_t> out_shape_casted(out_shape.begin(), out_shape.end());
-  f.emplace_back(
-      nvinfer1::PluginField("out_shape", out_shape_casted.data(), nvinfer1::PluginFieldType::kINT32, out_shape.size()));
-
-  std::vector<int32_t> out_size_casted(out_size_vec.begin(), out_size_vec.end());
-  f.emplace_back(nvinfer1::PluginField(
-      "out_size", out_size_casted.data(), nvinfer1::PluginFieldType::kINT32, out_size_vec.size()));
-
-  f.emplace_back(nvinfer1::PluginField("scales", nullptr, nvinfer1::PluginFieldType::kFLOAT64, 0));
-
-  int32_t align_corners_casted = 0;
-  f.emplace_back(nvinfer1::PluginField("align_corners", &align_corners_casted, nvinfer1::PluginFieldType::kINT32, 1));
-
-  int32_t use_scales_casted = 0;
-  f.emplace_back(nvinfer1::PluginField("use_scales", &use_scales_casted, nvinfer1::PluginFieldType::kINT32, 1));
-
-  f.emplace_back(nvinfer1::PluginField("mode", &mode, nvinfer1::PluginFieldType::kCHAR, 1));
-
-  fc.nbFields = f.size();
-  fc.fields = f.data();
-  /*====== PLUGIN PARAMETERS CONFIGURATION COMPLETED ======*/
-
-  LOG_WARNING(
-      "Adaptive pooling layer will be using Aten library kernels in pytorch for execution. TensorRT does not support adaptive pooling natively. Consider switching to non-adaptive pooling if this is an issue");
-
-  auto creator = getPluginRegistry()->getPluginCreator("Interpolate", "1", "torch_tensorrt");
-  auto interpolate_plugin = creator->createPlugin(mode.c_str(), &fc);
-
-  new_layer = ctx->net->addPluginV2(reinterpret_cast<nvinfer1::ITensor* const*>(&in), 1, *interpolate_plugin);
-  TORCHTRT_CHECK(new_layer, "Unable to create pooling (interpolation) plugin from node" << *n);
+  TORCHTRT_CHECK(orig_dims.nbDims > out_size.nbDims, "Unable to create pooling layer from node: " << *n);
+  auto first_axis = orig_dims.nbDims - out_size.nbDims;
+
+  // Bins of equal size which do not overlap are a plain pooling window
+  bool uniform_bins = orig_dims.nbDims == out_size.nbDims + 2 && out_size.nbDims >= 2;
+  std::vector<int64_t> window;
+  for (int32_t i = 0; i < out_size.nbDims && uniform_bins; i++) {
+    auto len = orig_dims.d[first_axis + i];
+    uniform_bins = len > 0 && len % out_size.d[i] == 0;
+    window.push_back(len / out_size.d[i]);
+  }
 
-  new_layer->setName(util::node_info(n).c_str());
-  auto layer_output = new_layer->getOutput(0);
+  nvinfer1::ITensor* out = nullptr;
+  if (uniform_bins) {
+    auto window_dims = util::toDims(window);
+    auto pooling_layer = ctx->net->addPoolingNd(*in, pool_type, window_dims);
+    TORCHTRT_CHECK(pooling_layer, "Unable to create pooling layer from node: " << *n);
+    pooling_layer->setStrideNd(window_dims);
+    pooling_layer->setName(util::node_info(n).c_str());
+    out = pooling_layer->getOutput(0);
+  } else {
+    out = in;
+    for (int32_t i = 0; i < out_size.nbDims; i++) {
+      out = AdaptivePoolAxis(ctx, n, out, first_axis + i, out_size.d[i], pool_type);
+    }
+  }
 
-  ctx->AssociateValueAndTensor(n->outputs()[0], layer_output);
-  LOG_DEBUG("Output tensor shape: " << layer_output->getDimensions());
+  ctx->AssociateValueAndTensor(n->outputs()[0], out);
+  LOG_DEBUG("Output tensor shape: " << out->getDimensions());
 
   return true;
 }
@@ -232,32 +290,32 @@ auto pooling_registrations TORCHTRT_UNUSED =
         .pattern(
             {"aten::adaptive_avg_pool1d(Tensor self, int[1] output_size) -> (Tensor)",
              [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
-               return AdaptivePoolingConverter(ctx, n, args, nvinfer1::PoolingType::kAVERAGE, "adaptive_avg_pool1d");
+               return AdaptivePoolingConverter(ctx, n, args, nvinfer1::PoolingType::kAVERAGE);
              }})
         .pattern(
             {"aten::adaptive_max_pool1d(Tensor self, int[2] output_size) -> (Tensor, Tensor)",
              [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
-               return AdaptivePoolingConverter(ctx, n, args, nvinfer1::PoolingType::kMAX, "adaptive_max_pool1d");
+               return AdaptivePoolingConverter(ctx, n, args, nvinfer1::PoolingType::kMAX);
              }})
         .pattern(
             {"aten::adaptive_avg_pool2d(Tensor self, int[2] output_size) -> (Tensor)",
              [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
-               return AdaptivePoolingConverter(ctx, n, args, nvinfer1::PoolingType::kAVERAGE, "adaptive_avg_pool2d");
+               return AdaptivePoolingConverter(ctx, n, args, nvinfer1::PoolingType::kAVERAGE);
              }})
         .pattern(
             {"aten::adaptive_max_pool2d(Tensor self, int[2] output_size) -> (Tensor, Tensor)",
              [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
-               return AdaptivePoolingConverter(ctx, n, args, nvinfer1::PoolingType::kMAX, "adaptive_max_pool2d");
+               return AdaptivePoolingConverter(ctx, n, args, nvinfer1::PoolingType::kMAX);
              }})
         .pattern(
             {"aten::adaptive_avg_pool3d(Tensor self, int[3] output_size) -> (Tensor)",
              [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
-               return AdaptivePoolingConverter(ctx, n, args, nvinfer1::PoolingType::kAVERAGE, "adaptive_avg_pool3d");
+               return AdaptivePoolingConverter(ctx, n, args, nvinfer1::PoolingType::kAVERAGE);
              }})
         .pattern(
             {"aten::adaptive_max_pool3d(Tensor self, int[3] output_size) -> (Tensor, Tensor)",
              [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
-               return AdaptivePoolingConverter(ctx, n, args, nvinfer1::PoolingType::kMAX, "adaptive_max_pool3d");
+               return AdaptivePoolingConverter(ctx, n, args, nvinfer1::PoolingType::kMAX);
              }});
 } // namespace
 } // namespace impl
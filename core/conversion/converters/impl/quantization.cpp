@@ -27,6 +27,33 @@ bool add_qdq(ConversionCtx *ctx, const torch::jit::Node* n, nvinfer1::ITensor* i
   return true;
 }
 
+#if NV_TENSORRT_MAJOR >= 10
+// Q/DQ scales have to be of the type of the tensor they dequantize to
+nvinfer1::ITensor* scale_of_type(ConversionCtx* ctx, nvinfer1::ITensor* scale, nvinfer1::DataType type, const torch::jit::Node* n) {
+  if (scale->getType() == type) {
+    return scale;
+  }
+  return castITensor(ctx, scale, type, util::node_info(n) + "_scale_cast");
+}
+
+// Packs the int4 values [-8, 7] held one per byte in an int8 tensor two per byte, lowest index in the low nibble, as
+// TensorRT expects kINT4 weights. The packing runs as tensor ops on the device of the weight, only the packed bytes are
+// copied to the host
+nvinfer1::Weights pack_int4_weights(ConversionCtx* ctx, const at::Tensor& weight) {
+  auto w = weight.to(at::kChar).flatten();
+  TORCHTRT_CHECK(!w.lt(-8).logical_or(w.gt(7)).any().item<bool>(), "INT4 weights have to be in the range [-8, 7]");
+  auto count = w.numel();
+  if (count % 2) {
+    w = at::constant_pad_nd(w, {0, 1}, 0);
+  }
+  auto nibbles = w.to(at::kByte).bitwise_and(0xF).view({-1, 2});
+  auto packed = nibbles.select(1, 0).bitwise_or(at::bitwise_left_shift(nibbles.select(1, 1), 4));
+  auto packed_cpu = ctx->StageWeightOnHost(packed);
+  ctx->builder_tensors.push_back(packed_cpu);
+  return nvinfer1::Weights{nvinfer1::DataType::kINT4, packed_cpu.data_ptr(), count};
+}
+#endif
+
 auto quantization_registrations TORCHTRT_UNUSED = RegisterNodeConversionPatterns()
   .pattern({"aten::fake_quantize_per_tensor_affine(Tensor self, float scale, int zero_point, int quant_min, int quant_max) -> (Tensor)",
             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
@@ -66,7 +93,72 @@ auto quantization_registrations TORCHTRT_UNUSED = RegisterNodeConversionPatterns
               LOG_DEBUG("[fake_quantize_per_channel_affine] Ouput tensor shape: " << qdq_out->getDimensions());
 
               return true;
-            }});
+            }})
+#if NV_TENSORRT_MAJOR >= 10
+  .pattern({"trt::fake_quantize_fp8(Tensor self, Tensor scale, int axis) -> (Tensor)",
+            [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+              // Quantizes to FP8 (E4M3) and back. A single element scale quantizes per tensor, otherwise per channel
+              // along axis
+              auto input = args[0].ITensorOrFreeze(ctx);
+              auto scale = scale_of_type(ctx, args[1].ITensorOrFreeze(ctx), input->getType(), n);
+              int64_t axis = args[2].unwrapToInt();
+              auto nbDims = input->getDimensions().nbDims;
+              axis = axis < 0 ? axis + nbDims : axis;
+              TORCHTRT_CHECK(axis >= 0 && axis < nbDims, "Invalid quantization axis " << args[2].unwrapToInt() << " for node: " << *n);
+
+              auto quantize_layer = ctx->net->addQuantize(*input, *scale, nvinfer1::DataType::kFP8);
+              TORCHTRT_CHECK(quantize_layer, "Unable to create QuantizeLayer from node: " << *n);
+              quantize_layer->setAxis(axis);
+              quantize_layer->setName((util::node_info(n) + "_quantize").c_str());
+
+              auto dequantize_layer = ctx->net->addDequantize(*quantize_layer->getOutput(0), *scale, input->getType());
+              TORCHTRT_CHECK(dequantize_layer, "Unable to create DequantizeLayer from node: " << *n);
+              dequantize_layer->setAxis(axis);
+              dequantize_layer->setName((util::node_info(n) + "_dequantize").c_str());
+
+              auto qdq_out = ctx->AssociateValueAndTensor(n->outputs()[0], dequantize_layer->getOutput(0));
+              LOG_DEBUG("[trt::fake_quantize_fp8] Output tensor shape: " << qdq_out->getDimensions());
+              return true;
+            }})
+  .pattern({"trt::dequantize_int4(Tensor weight, Tensor scale, int block_size) -> (Tensor)",
+            [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+              // Weight only quantization: the [N, K] weight holds int4 values, each block of block_size values along
+              // K shares one scale of the [N, K / block_size] scale tensor. The weight stays in INT4 in the engine
+              // and is dequantized by TensorRT, usually fused into the consuming matrix multiply
+              TORCHTRT_CHECK(
+                  args[0].isIValue() && args[0].IValue()->isTensor(),
+                  "INT4 weights have to be constant at conversion time, node: " << *n);
+              auto weight = args[0].unwrapToTensor();
+              int64_t block_size = args[2].unwrapToInt();
+              TORCHTRT_CHECK(weight.dim() == 2, "INT4 block quantization expects a 2D weight, got " << weight.sizes());
+              TORCHTRT_CHECK(
+                  block_size > 0 && weight.size(1) % block_size == 0,
+                  "Block size " << block_size << " does not divide the weight dimension " << weight.size(1));
+
+              auto scale = args[1].ITensorOrFreeze(ctx);
+              auto scale_dims = scale->getDimensions();
+              TORCHTRT_CHECK(
+                  scale_dims.nbDims == 2 && scale_dims.d[0] == weight.size(0) &&
+                      scale_dims.d[1] == weight.size(1) / block_size,
+                  "INT4 block scales have to have the shape [" << weight.size(0) << ", " << weight.size(1) / block_size
+                      << "], got " << scale_dims);
+
+              auto weight_layer = ctx->net->addConstant(util::toDims(weight.sizes()), pack_int4_weights(ctx, weight));
+              TORCHTRT_CHECK(weight_layer, "Unable to create INT4 constant from node: " << *n);
+              weight_layer->setName((util::node_info(n) + "_int4_weight").c_str());
+
+              // The blocked dimension is the one the scale is smaller in, TensorRT derives the block size from it
+              auto dequantize_layer =
+                  ctx->net->addDequantize(*weight_layer->getOutput(0), *scale, scale->getType());
+              TORCHTRT_CHECK(dequantize_layer, "Unable to create DequantizeLayer from node: " << *n);
+              dequantize_layer->setName((util::node_info(n) + "_dequantize").c_str());
+
+              auto dq_out = ctx->AssociateValueAndTensor(n->outputs()[0], dequantize_layer->getOutput(0));
+              LOG_DEBUG("[trt::dequantize_int4] Output tensor shape: " << dq_out->getDimensions());
+              return true;
+            }})
+#endif
+  ;
 // clang-format on
 #endif
 } // namespace
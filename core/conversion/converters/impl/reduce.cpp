@@ -39,6 +39,136 @@ nvinfer1::ITensor* anyDimImplementation(
   return out_tensor;
 }
 
+// Variance of in over dims in a single reduction: x and x * x are stacked on a new leading axis so that one average
+// gives E[x] and E[x^2], var = E[x^2] - E[x]^2 scaled by N / (N - correction). The moments are accumulated in FP32
+// whatever the type of in, and the difference is clamped at zero since it can cancel to a small negative value
+nvinfer1::ITensor* varianceImplementation(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    nvinfer1::ITensor* in_tensor,
+    c10::optional<c10::List<int64_t>> dims,
+    double correction,
+    bool keepdim) {
+  auto name = util::node_info(n);
+  auto out_type = in_tensor->getType();
+  if (out_type != nvinfer1::DataType::kFLOAT) {
+    in_tensor = castITensor(ctx, in_tensor, nvinfer1::DataType::kFLOAT, name + "_in");
+  }
+  auto in_dims = in_tensor->getDimensions();
+
+  // No dims (or an empty list) reduces over every axis
+  std::vector<int64_t> reduced;
+  if (dims && dims->size() > 0) {
+    for (auto d : *dims) {
+      reduced.push_back(d < 0 ? in_dims.nbDims + d : d);
+    }
+  } else {
+    for (int64_t d = 0; d < in_dims.nbDims; d++) {
+      reduced.push_back(d);
+    }
+  }
+  uint32_t axis_mask = 0;
+  for (auto d : reduced) {
+    TORCHTRT_CHECK(d >= 0 && d < in_dims.nbDims, "Dim to reduce is out of range in node: " << *n);
+    axis_mask |= 1 << d;
+  }
+  LOG_DEBUG("Axis Mask: " << std::bitset<32>(axis_mask));
+
+  auto sqrd = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kPROD, in_tensor, in_tensor, name + "_sqrd")
+                  ->getOutput(0);
+  // Dynamic dims are copied from the input by zeros, so the unsqueeze also holds for dynamic shapes
+  auto stack_dims = util::unsqueezeDims(in_dims, 0);
+  std::vector<nvinfer1::ITensor*> moments_in;
+  for (auto t : {in_tensor, sqrd}) {
+    auto unsqueeze = ctx->net->addShuffle(*t);
+    TORCHTRT_CHECK(unsqueeze, "Unable to create shuffle layer from node: " << *n);
+    unsqueeze->setReshapeDimensions(stack_dims);
+    moments_in.push_back(unsqueeze->getOutput(0));
+  }
+  auto stack = ctx->net->addConcatenation(moments_in.data(), moments_in.size());
+  TORCHTRT_CHECK(stack, "Unable to create concatenation layer from node: " << *n);
+  stack->setAxis(0);
+  stack->setName((name + "_stack").c_str());
+
+  auto moments_layer =
+      ctx->net->addReduce(*stack->getOutput(0), nvinfer1::ReduceOperation::kAVG, axis_mask << 1, keepdim);
+  TORCHTRT_CHECK(moments_layer, "Unable to create reduce layer from node: " << *n);
+  moments_layer->setName((name + "_moments").c_str());
+  auto moments = moments_layer->getOutput(0);
+
+  auto moment = [&](int32_t i) {
+    auto gather = ctx->net->addGather(*moments, *tensor_to_const(ctx, torch::tensor(i, torch::kInt32)), 0);
+    TORCHTRT_CHECK(gather, "Unable to create gather layer from node: " << *n);
+    return gather->getOutput(0);
+  };
+  auto mean = moment(0);
+  auto sqrdmean = moment(1);
+  auto meansqrd =
+      add_elementwise(ctx, nvinfer1::ElementWiseOperation::kPROD, mean, mean, name + "_meansqrd")->getOutput(0);
+  auto diff = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kSUB, sqrdmean, meansqrd, name + "_diff")
+                  ->getOutput(0);
+  auto clamp_layer = ctx->net->addActivation(*diff, nvinfer1::ActivationType::kRELU);
+  TORCHTRT_CHECK(clamp_layer, "Unable to create activation layer from node: " << *n);
+  clamp_layer->setName((name + "_clamp").c_str());
+  auto var = clamp_layer->getOutput(0);
+
+  if (correction != 0) {
+    // Bessel's correction, from the number of elements each variance is computed over
+    int64_t static_numel = 1;
+    for (auto d : reduced) {
+      static_numel = in_dims.d[d] < 0 || static_numel < 0 ? -1 : static_numel * in_dims.d[d];
+    }
+    nvinfer1::ITensor* scale = nullptr;
+    if (static_numel >= 0) {
+      double numel = static_cast<double>(static_numel);
+      scale = tensor_to_const(ctx, torch::tensor({static_cast<float>(numel / (numel - correction))}));
+    } else {
+      auto shape = getShapeOutput(ctx, in_tensor, name + "_shape");
+      auto reduced_shape =
+          ctx->net->addGather(*shape, *tensor_to_const(ctx, torch::tensor(reduced, torch::kInt32)), 0)->getOutput(0);
+      auto numel_layer = ctx->net->addReduce(*reduced_shape, nvinfer1::ReduceOperation::kPROD, 1, true);
+      TORCHTRT_CHECK(numel_layer, "Unable to create reduce layer from node: " << *n);
+      auto numel = castITensor(ctx, numel_layer->getOutput(0), nvinfer1::DataType::kFLOAT, name + "_numel");
+      auto dof = add_elementwise(
+                     ctx,
+                     nvinfer1::ElementWiseOperation::kSUB,
+                     numel,
+                     tensor_to_const(ctx, torch::tensor({static_cast<float>(correction)})),
+                     name + "_dof")
+                     ->getOutput(0);
+      scale = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kDIV, numel, dof, name + "_scale")->getOutput(0);
+    }
+    var = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kPROD, var, scale, name + "_corrected")->getOutput(0);
+  }
+
+  if (out_type != nvinfer1::DataType::kFLOAT) {
+    var = castITensor(ctx, var, out_type, name + "_out");
+  }
+  return var;
+}
+
+c10::optional<c10::List<int64_t>> optionalDims(Var& dims) {
+  if (dims.isIValue() && dims.IValue()->isNone()) {
+    return {};
+  }
+  return dims.unwrapToIntList();
+}
+
+// Correction defaults to Bessel's
+double optionalCorrection(Var& correction) {
+  if (correction.isIValue() && correction.IValue()->isNone()) {
+    return 1.0;
+  }
+  return correction.unwrapToScalar().to<double>();
+}
+
+nvinfer1::ITensor* addSqrt(ConversionCtx* ctx, const torch::jit::Node* n, nvinfer1::ITensor* var) {
+  auto sqrt_layer = ctx->net->addUnary(*var, nvinfer1::UnaryOperation::kSQRT);
+  TORCHTRT_CHECK(sqrt_layer, "Unable to create sqrt layer from node: " << *n);
+  sqrt_layer->setName((util::node_info(n) + "_sqrt").c_str());
+  return sqrt_layer->getOutput(0);
+}
+
 auto reduce_registrations TORCHTRT_UNUSED =
     RegisterNodeConversionPatterns()
         .pattern(
@@ -95,6 +225,70 @@ auto reduce_registrations TORCHTRT_UNUSED =
                LOG_DEBUG("Output shape: " << out_tensor->getDimensions());
                return true;
              }})
+        .pattern(
+            {"aten::var(Tensor self, bool unbiased=True) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               auto in_tensor = args[0].ITensorOrFreeze(ctx);
+               auto correction = args[1].unwrapToBool() ? 1.0 : 0.0;
+               auto out = varianceImplementation(ctx, n, in_tensor, {}, correction, false);
+               auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], out);
+               LOG_DEBUG("Output shape: " << out_tensor->getDimensions());
+               return true;
+             }})
+        .pattern(
+            {"aten::var.dim(Tensor self, int[1]? dim, bool unbiased=True, bool keepdim=False) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               auto in_tensor = args[0].ITensorOrFreeze(ctx);
+               auto correction = args[2].unwrapToBool() ? 1.0 : 0.0;
+               auto keepdim = args[3].unwrapToBool();
+               auto out = varianceImplementation(ctx, n, in_tensor, optionalDims(args[1]), correction, keepdim);
+               auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], out);
+               LOG_DEBUG("Output shape: " << out_tensor->getDimensions());
+               return true;
+             }})
+        .pattern(
+            {"aten::var.correction(Tensor self, int[1]? dim=None, *, Scalar? correction=None, bool keepdim=False) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               auto in_tensor = args[0].ITensorOrFreeze(ctx);
+               auto correction = optionalCorrection(args[2]);
+               auto keepdim = args[3].unwrapToBool();
+               auto out = varianceImplementation(ctx, n, in_tensor, optionalDims(args[1]), correction, keepdim);
+               auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], out);
+               LOG_DEBUG("Output shape: " << out_tensor->getDimensions());
+               return true;
+             }})
+        .pattern(
+            {"aten::std(Tensor self, bool unbiased=True) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               auto in_tensor = args[0].ITensorOrFreeze(ctx);
+               auto correction = args[1].unwrapToBool() ? 1.0 : 0.0;
+               auto out = addSqrt(ctx, n, varianceImplementation(ctx, n, in_tensor, {}, correction, false));
+               auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], out);
+               LOG_DEBUG("Output shape: " << out_tensor->getDimensions());
+               return true;
+             }})
+        .pattern(
+            {"aten::std.dim(Tensor self, int[1]? dim, bool unbiased=True, bool keepdim=False) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               auto in_tensor = args[0].ITensorOrFreeze(ctx);
+               auto correction = args[2].unwrapToBool() ? 1.0 : 0.0;
+               auto keepdim = args[3].unwrapToBool();
+               auto var = varianceImplementation(ctx, n, in_tensor, optionalDims(args[1]), correction, keepdim);
+               auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], addSqrt(ctx, n, var));
+               LOG_DEBUG("Output shape: " << out_tensor->getDimensions());
+               return true;
+             }})
+        .pattern(
+            {"aten::std.correction(Tensor self, int[1]? dim=None, *, Scalar? correction=None, bool keepdim=False) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               auto in_tensor = args[0].ITensorOrFreeze(ctx);
+               auto correction = optionalCorrection(args[2]);
+               auto keepdim = args[3].unwrapToBool();
+               auto var = varianceImplementation(ctx, n, in_tensor, optionalDims(args[1]), correction, keepdim);
+               auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], addSqrt(ctx, n, var));
+               LOG_DEBUG("Output shape: " << out_tensor->getDimensions());
+               return true;
+             }})
         .pattern(
             {"aten::sum(Tensor self, *, ScalarType? dtype=None) -> Tensor",
              [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
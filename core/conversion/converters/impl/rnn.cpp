@@ -0,0 +1,322 @@
+#include "NvInfer.h"
+#include "core/conversion/converters/converters.h"
+#include "core/conversion/tensorcontainer/TensorContainer.h"
+#include "core/util/prelude.h"
+#include "torch/torch.h"
+
+#include <ATen/ATen.h>
+#include <vector>
+
+namespace torch_tensorrt {
+namespace core {
+namespace conversion {
+namespace converters {
+namespace impl {
+namespace {
+
+enum class RNNType { kLSTM, kGRU };
+
+struct DirectionOutputs {
+  // Hidden state of every step, (seq, batch, hidden)
+  nvinfer1::ITensor* output;
+  // Hidden and cell state after the last step, (batch, hidden)
+  nvinfer1::ITensor* h;
+  nvinfer1::ITensor* c;
+};
+
+nvinfer1::ITensor* state_tensor(ConversionCtx* ctx, const c10::IValue& v) {
+  if (v.isTensor()) {
+    return tensor_to_const(ctx, v.toTensor());
+  }
+  return v.toCustomClass<TensorContainer>()->tensor();
+}
+
+// Slice idx of dimension axis, dropping the dimension. Gather keeps dynamic dimensions dynamic
+nvinfer1::ITensor* select(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    nvinfer1::ITensor* in,
+    int32_t axis,
+    int32_t idx,
+    const std::string& name) {
+  auto gather = ctx->net->addGather(*in, *tensor_to_const(ctx, torch::tensor(idx, torch::kInt32)), axis);
+  TORCHTRT_CHECK(gather, "Unable to create gather layer from node: " << *n);
+  gather->setName(name.c_str());
+  return gather->getOutput(0);
+}
+
+nvinfer1::ITensor* elementwise(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    nvinfer1::ElementWiseOperation op,
+    nvinfer1::ITensor* a,
+    nvinfer1::ITensor* b,
+    const std::string& name) {
+  auto layer = add_elementwise(ctx, op, a, b, name);
+  TORCHTRT_CHECK(layer, "Unable to create ElementWise layer from node: " << *n);
+  return layer->getOutput(0);
+}
+
+nvinfer1::ITensor* activation(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    nvinfer1::ITensor* in,
+    nvinfer1::ActivationType type,
+    const std::string& name) {
+  auto layer = ctx->net->addActivation(*in, type);
+  TORCHTRT_CHECK(layer, "Unable to create activation layer from node: " << *n);
+  layer->setName(name.c_str());
+  return layer->getOutput(0);
+}
+
+// x * w^T + b with the gates split out of the last dimension, (..., hidden * num_gates) -> (..., num_gates, hidden)
+nvinfer1::ITensor* project(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    nvinfer1::ITensor* x,
+    at::Tensor w,
+    c10::optional<at::Tensor> b,
+    int64_t num_gates,
+    const std::string& name) {
+  auto dtype = util::TRTDataTypeToScalarType(x->getType());
+  auto nb_dims = x->getDimensions().nbDims;
+  // Leading dimensions of size 1 broadcast the weight over the batch dimensions of x
+  auto w_sizes = w.sizes().vec();
+  w_sizes.insert(w_sizes.begin(), nb_dims - 2, 1);
+  auto w_t = tensor_to_const(ctx, w.to(dtype).reshape(w_sizes), name + "_weight");
+  auto mm =
+      ctx->net->addMatrixMultiply(*x, nvinfer1::MatrixOperation::kNONE, *w_t, nvinfer1::MatrixOperation::kTRANSPOSE);
+  TORCHTRT_CHECK(mm, "Unable to create matrix multiplication layer from node: " << *n);
+  mm->setName(name.c_str());
+  auto out = mm->getOutput(0);
+  if (b) {
+    out = elementwise(
+        ctx, n, nvinfer1::ElementWiseOperation::kSUM, out, tensor_to_const(ctx, b->to(dtype)), name + "_bias");
+  }
+
+  auto split = ctx->net->addShuffle(*out);
+  TORCHTRT_CHECK(split, "Unable to create shuffle layer from node: " << *n);
+  std::vector<int64_t> split_dims(nb_dims - 1, 0);
+  split_dims.push_back(num_gates);
+  split_dims.push_back(w.size(0) / num_gates);
+  split->setReshapeDimensions(util::toDims(split_dims));
+  split->setName((name + "_split_gates").c_str());
+  return split->getOutput(0);
+}
+
+// Runs one direction of one layer over the time major sequence x as a TensorRT loop. The input projection of every
+// step is computed before the loop in a single matrix multiply, the loop body only holds the recurrent projection and
+// the gates
+DirectionOutputs add_direction(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    RNNType type,
+    nvinfer1::ITensor* x,
+    nvinfer1::ITensor* h0,
+    nvinfer1::ITensor* c0,
+    const std::vector<at::Tensor>& weights,
+    bool reverse,
+    const std::string& name) {
+  auto num_gates = type == RNNType::kLSTM ? 4 : 3;
+  auto has_biases = weights.size() == 4;
+  auto b_ih = has_biases ? c10::optional<at::Tensor>(weights[2]) : c10::nullopt;
+  auto b_hh = has_biases ? c10::optional<at::Tensor>(weights[3]) : c10::nullopt;
+
+  auto x_gates = project(ctx, n, x, weights[0], b_ih, num_gates, name + "_input_projection");
+
+  auto loop = ctx->net->addLoop();
+  TORCHTRT_CHECK(loop, "Unable to create loop from node: " << *n);
+  loop->setName(name.c_str());
+  nvinfer1::ITensor* trip_limit = nullptr;
+  auto seq_len = x->getDimensions().d[0];
+  if (seq_len > 0) {
+    trip_limit = tensor_to_const(ctx, torch::tensor(static_cast<int32_t>(seq_len), torch::kInt32));
+  } else {
+    trip_limit = select(ctx, n, getShapeOutput(ctx, x, name + "_shape"), 0, 0, name + "_seq_len");
+  }
+  loop->addTripLimit(*trip_limit, nvinfer1::TripLimit::kCOUNT);
+
+  auto x_t = loop->addIterator(*x_gates, 0, reverse)->getOutput(0);
+  auto h_rec = loop->addRecurrence(*h0);
+  auto h = h_rec->getOutput(0);
+  auto h_gates = project(ctx, n, h, weights[1], b_hh, num_gates, name + "_hidden_projection");
+  auto gate = [&](nvinfer1::ITensor* gates, int32_t idx, const std::string& gate_name) {
+    return select(ctx, n, gates, 1, idx, name + "_" + gate_name);
+  };
+  auto sum = [&](nvinfer1::ITensor* a, nvinfer1::ITensor* b, const std::string& sum_name) {
+    return elementwise(ctx, n, nvinfer1::ElementWiseOperation::kSUM, a, b, name + "_" + sum_name);
+  };
+  auto prod = [&](nvinfer1::ITensor* a, nvinfer1::ITensor* b, const std::string& prod_name) {
+    return elementwise(ctx, n, nvinfer1::ElementWiseOperation::kPROD, a, b, name + "_" + prod_name);
+  };
+  auto sigmoid = nvinfer1::ActivationType::kSIGMOID;
+  auto tanh = nvinfer1::ActivationType::kTANH;
+
+  DirectionOutputs result{nullptr, nullptr, nullptr};
+  nvinfer1::ITensor* h_next = nullptr;
+  if (type == RNNType::kLSTM) {
+    // Gates are ordered input, forget, cell, output
+    auto gates = sum(x_t, h_gates, "gates");
+    auto i = activation(ctx, n, gate(gates, 0, "i"), sigmoid, name + "_ingate");
+    auto f = activation(ctx, n, gate(gates, 1, "f"), sigmoid, name + "_forgetgate");
+    auto g = activation(ctx, n, gate(gates, 2, "g"), tanh, name + "_cellgate");
+    auto o = activation(ctx, n, gate(gates, 3, "o"), sigmoid, name + "_outgate");
+
+    auto c_rec = loop->addRecurrence(*c0);
+    auto c_next = sum(prod(f, c_rec->getOutput(0), "forget_cx"), prod(i, g, "in_cell"), "cy");
+    h_next = prod(o, activation(ctx, n, c_next, tanh, name + "_cy_tanh"), "hy");
+    c_rec->setInput(1, *c_next);
+    result.c = loop->addLoopOutput(*c_next, nvinfer1::LoopOutput::kLAST_VALUE)->getOutput(0);
+  } else {
+    // Gates are ordered reset, update, new. The reset gate only scales the recurrent part of the new gate
+    auto r = activation(ctx, n, sum(gate(x_t, 0, "x_r"), gate(h_gates, 0, "h_r"), "r"), sigmoid, name + "_resetgate");
+    auto z = activation(ctx, n, sum(gate(x_t, 1, "x_z"), gate(h_gates, 1, "h_z"), "z"), sigmoid, name + "_updategate");
+    auto n_gate = activation(
+        ctx, n, sum(gate(x_t, 2, "x_n"), prod(r, gate(h_gates, 2, "h_n"), "reset_h_n"), "n"), tanh, name + "_newgate");
+    // (1 - z) * n + z * h
+    auto h_minus_n = elementwise(ctx, n, nvinfer1::ElementWiseOperation::kSUB, h, n_gate, name + "_h_minus_n");
+    h_next = sum(n_gate, prod(z, h_minus_n, "update"), "hy");
+  }
+  h_rec->setInput(1, *h_next);
+
+  auto output = loop->addLoopOutput(
+      *h_next, reverse ? nvinfer1::LoopOutput::kREVERSE : nvinfer1::LoopOutput::kCONCATENATE, 0);
+  output->setInput(1, *trip_limit);
+  result.output = output->getOutput(0);
+  result.h = loop->addLoopOutput(*h_next, nvinfer1::LoopOutput::kLAST_VALUE)->getOutput(0);
+  return result;
+}
+
+// Stacks the final states of every layer and direction, each (batch, hidden), into (num_layers * num_directions,
+// batch, hidden)
+nvinfer1::ITensor* stack_states(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    std::vector<nvinfer1::ITensor*> states,
+    int64_t hidden,
+    const std::string& name) {
+  auto concat = ctx->net->addConcatenation(states.data(), states.size());
+  TORCHTRT_CHECK(concat, "Unable to create concatenation layer from node: " << *n);
+  concat->setAxis(1);
+  concat->setName((name + "_concat").c_str());
+  auto shuffle = ctx->net->addShuffle(*concat->getOutput(0));
+  TORCHTRT_CHECK(shuffle, "Unable to create shuffle layer from node: " << *n);
+  shuffle->setReshapeDimensions(util::toDims(std::vector<int64_t>({0, static_cast<int64_t>(states.size()), hidden})));
+  shuffle->setSecondTranspose(nvinfer1::Permutation{1, 0, 2});
+  shuffle->setName(name.c_str());
+  return shuffle->getOutput(0);
+}
+
+nvinfer1::ITensor* swap_batch_and_seq(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    nvinfer1::ITensor* in,
+    const std::string& name) {
+  auto shuffle = ctx->net->addShuffle(*in);
+  TORCHTRT_CHECK(shuffle, "Unable to create shuffle layer from node: " << *n);
+  shuffle->setFirstTranspose(nvinfer1::Permutation{1, 0, 2});
+  shuffle->setName(name.c_str());
+  return shuffle->getOutput(0);
+}
+
+// Converts aten::lstm / aten::gru over padded sequences, hx holds [h0, c0] for LSTM and h0 for GRU
+bool convert_rnn(ConversionCtx* ctx, const torch::jit::Node* n, args& args, RNNType type) {
+  auto input = args[0].ITensorOrFreeze(ctx);
+  auto params = args[2].IValue()->toListRef();
+  auto has_biases = args[3].unwrapToBool();
+  auto num_layers = args[4].unwrapToInt();
+  auto dropout = args[5].unwrapToDouble();
+  auto train = args[6].unwrapToBool();
+  auto bidirectional = args[7].unwrapToBool();
+  auto batch_first = args[8].unwrapToBool();
+  auto name = util::node_info(n);
+
+  TORCHTRT_CHECK(
+      input->getDimensions().nbDims == 3,
+      "Only batched (3D) inputs are supported by the " << n->kind().toQualString() << " converter, found input shape "
+                                                       << input->getDimensions());
+  if (train && dropout > 0) {
+    LOG_WARNING("Dropout between the layers of " << name << " is not applied by TensorRT");
+  }
+
+  int64_t num_directions = bidirectional ? 2 : 1;
+  int64_t weights_per_direction = has_biases ? 4 : 2;
+  auto num_weights = num_layers * num_directions * weights_per_direction;
+  TORCHTRT_CHECK(
+      static_cast<int64_t>(params.size()) == num_weights,
+      "Expected " << num_weights << " weights for " << name << ", found " << params.size()
+                  << ". Projections (proj_size > 0) are not supported");
+  std::vector<at::Tensor> weights;
+  for (auto& p : params) {
+    TORCHTRT_CHECK(p.isTensor(), "Weights of " << name << " must be constants");
+    weights.push_back(p.toTensor());
+  }
+  auto hidden = weights[1].size(1);
+
+  nvinfer1::ITensor* h0 = nullptr;
+  nvinfer1::ITensor* c0 = nullptr;
+  if (type == RNNType::kLSTM) {
+    auto hx = args[1].IValue()->toListRef();
+    TORCHTRT_CHECK(hx.size() == 2, "Expected hx of " << name << " to hold h0 and c0");
+    h0 = state_tensor(ctx, hx[0]);
+    c0 = state_tensor(ctx, hx[1]);
+  } else {
+    h0 = args[1].ITensorOrFreeze(ctx);
+  }
+
+  auto x = batch_first ? swap_batch_and_seq(ctx, n, input, name + "_to_seq_first") : input;
+  std::vector<nvinfer1::ITensor*> h_n, c_n;
+  for (int64_t l = 0; l < num_layers; l++) {
+    std::vector<nvinfer1::ITensor*> outputs;
+    for (int64_t d = 0; d < num_directions; d++) {
+      auto idx = static_cast<int32_t>(l * num_directions + d);
+      auto direction_name = name + "_layer_" + std::to_string(l) + (d ? "_reverse" : "");
+      auto first = weights.begin() + idx * weights_per_direction;
+      std::vector<at::Tensor> direction_weights(first, first + weights_per_direction);
+      auto h0_d = select(ctx, n, h0, 0, idx, direction_name + "_h0");
+      auto c0_d = c0 ? select(ctx, n, c0, 0, idx, direction_name + "_c0") : nullptr;
+      auto out = add_direction(ctx, n, type, x, h0_d, c0_d, direction_weights, d == 1, direction_name);
+      outputs.push_back(out.output);
+      h_n.push_back(out.h);
+      c_n.push_back(out.c);
+    }
+    if (num_directions == 1) {
+      x = outputs[0];
+    } else {
+      auto concat = ctx->net->addConcatenation(outputs.data(), outputs.size());
+      TORCHTRT_CHECK(concat, "Unable to create concatenation layer from node: " << *n);
+      concat->setAxis(2);
+      concat->setName((name + "_layer_" + std::to_string(l) + "_concat").c_str());
+      x = concat->getOutput(0);
+    }
+  }
+
+  auto output = batch_first ? swap_batch_and_seq(ctx, n, x, name + "_to_batch_first") : x;
+  auto out = ctx->AssociateValueAndTensor(n->outputs()[0], output);
+  LOG_DEBUG("Output tensor shape: " << out->getDimensions());
+  ctx->AssociateValueAndTensor(n->outputs()[1], stack_states(ctx, n, h_n, hidden, name + "_h_n"));
+  if (type == RNNType::kLSTM) {
+    ctx->AssociateValueAndTensor(n->outputs()[2], stack_states(ctx, n, c_n, hidden, name + "_c_n"));
+  }
+  return true;
+}
+
+auto rnn_registrations TORCHTRT_UNUSED =
+    RegisterNodeConversionPatterns()
+        .pattern(
+            {"aten::lstm.input(Tensor input, Tensor[] hx, Tensor[] params, bool has_biases, int num_layers, float dropout, bool train, bool bidirectional, bool batch_first) -> (Tensor, Tensor, Tensor)",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               return convert_rnn(ctx, n, args, RNNType::kLSTM);
+             }})
+        .pattern(
+            {"aten::gru.input(Tensor input, Tensor hx, Tensor[] params, bool has_biases, int num_layers, float dropout, bool train, bool bidirectional, bool batch_first) -> (Tensor, Tensor)",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               return convert_rnn(ctx, n, args, RNNType::kGRU);
+             }});
+
+} // namespace
+} // namespace impl
+} // namespace converters
+} // namespace conversion
+} // namespace core
+} // namespace torch_tensorrt
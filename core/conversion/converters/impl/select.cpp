@@ -1,4 +1,5 @@
 #include <ATen/ATen.h>
+#include <algorithm>
 #include <vector>
 #include "NvInfer.h"
 #include "c10/util/intrusive_ptr.h"
@@ -116,6 +117,242 @@ nvinfer1::ITensor* roll(
   return out;
 }
 
+// Broadcasts in, padded with leading 1s to the rank of shape, to shape. static_shape holds -1 for the dimensions only
+// known at runtime
+nvinfer1::ITensor* broadcast_to(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    nvinfer1::ITensor* in,
+    nvinfer1::ITensor* shape,
+    nvinfer1::Dims static_shape,
+    const std::string& name) {
+  in = addPadding(ctx, n, in, static_shape.nbDims, false, true, name + "_pad");
+  auto in_dims = in->getDimensions();
+  bool is_static = true;
+  for (int i = 0; i < static_shape.nbDims; i++) {
+    is_static &= static_shape.d[i] != -1 && in_dims.d[i] != -1;
+  }
+  if (is_static) {
+    return util::toVec(in_dims) == util::toVec(static_shape) ? in : add_expand(ctx, in, static_shape);
+  }
+
+  // Stride 0 repeats the dimensions of size 1, min(size - 1, 1) computes it at runtime
+  auto one = tensor_to_const(ctx, torch::tensor({1}, torch::kInt32));
+  auto in_shape = getShapeOutput(ctx, in, name + "_shape");
+  auto size_minus_one =
+      add_elementwise(ctx, nvinfer1::ElementWiseOperation::kSUB, in_shape, one, name + "_size_minus_one");
+  auto stride =
+      add_elementwise(ctx, nvinfer1::ElementWiseOperation::kMIN, size_minus_one->getOutput(0), one, name + "_stride");
+  auto zeros = util::toDims(std::vector<int64_t>(static_shape.nbDims, 0));
+  auto slice_layer = ctx->net->addSlice(*in, zeros, zeros, zeros);
+  TORCHTRT_CHECK(slice_layer, "Unable to create slice layer from node: " << *n);
+  slice_layer->setInput(2, *shape);
+  slice_layer->setInput(3, *stride->getOutput(0));
+  slice_layer->setName((name + "_broadcast").c_str());
+  return slice_layer->getOutput(0);
+}
+
+// Advanced indexing of self by one index tensor per axis in axes, as a single kND gather or scatter
+struct AdvancedIndex {
+  // self transposed to [axes..., other axes...]
+  nvinfer1::ITensor* self;
+  // [S..., axes.size()] coordinates, S being the broadcast shape of the index tensors
+  nvinfer1::ITensor* coordinates;
+  // Axes of self in the order of the transposed self
+  std::vector<int32_t> order;
+  int32_t index_rank;
+};
+
+AdvancedIndex linearize_advanced_index(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    nvinfer1::ITensor* self,
+    std::vector<nvinfer1::ITensor*> indices,
+    const std::vector<int32_t>& axes) {
+  auto name = util::node_info(n);
+  auto self_dims = self->getDimensions();
+  auto self_shape = getShapeOutput(ctx, self, name + "_self_shape");
+
+  AdvancedIndex adv;
+  adv.order = axes;
+  for (int32_t i = 0; i < self_dims.nbDims; i++) {
+    if (std::find(axes.begin(), axes.end(), i) == axes.end()) {
+      adv.order.push_back(i);
+    }
+  }
+  auto transpose_layer = ctx->net->addShuffle(*self);
+  TORCHTRT_CHECK(transpose_layer, "Unable to create shuffle layer from node: " << *n);
+  nvinfer1::Permutation permute;
+  std::copy(adv.order.begin(), adv.order.end(), permute.order);
+  transpose_layer->setFirstTranspose(permute);
+  adv.self = transpose_layer->getOutput(0);
+
+  // Negative indices count from the end of their axis
+  for (size_t i = 0; i < indices.size(); i++) {
+    auto idx_name = name + "_index_" + std::to_string(i);
+    auto dim = ctx->net->addGather(*self_shape, *tensor_to_const(ctx, torch::tensor({axes[i]}, torch::kInt32)), 0)
+                   ->getOutput(0);
+    auto zero = tensor_to_const(ctx, torch::tensor({0}, torch::kInt32));
+    auto negative = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kLESS, indices[i], zero, idx_name + "_neg");
+    auto wrap = castITensor(ctx, negative->getOutput(0), nvinfer1::DataType::kINT32, idx_name + "_wrap");
+    auto offset = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kPROD, wrap, dim, idx_name + "_offset");
+    indices[i] = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kSUM, indices[i], offset->getOutput(0), idx_name)
+                     ->getOutput(0);
+  }
+
+  // Broadcast shape of the index tensors
+  adv.index_rank = 0;
+  for (auto idx : indices) {
+    adv.index_rank = std::max(adv.index_rank, idx->getDimensions().nbDims);
+  }
+  nvinfer1::Dims static_shape;
+  static_shape.nbDims = adv.index_rank;
+  std::fill(static_shape.d, static_shape.d + adv.index_rank, 1);
+  nvinfer1::ITensor* shape = nullptr;
+  for (auto& idx : indices) {
+    idx = addPadding(ctx, n, idx, adv.index_rank, false, true, name + "_index_pad");
+    auto dims = idx->getDimensions();
+    for (int32_t d = 0; d < adv.index_rank; d++) {
+      if (static_shape.d[d] == -1 || dims.d[d] == -1) {
+        static_shape.d[d] = -1;
+      } else {
+        static_shape.d[d] = std::max(static_shape.d[d], dims.d[d]);
+      }
+    }
+    auto idx_shape = getShapeOutput(ctx, idx, name + "_index_shape");
+    shape = shape ? add_elementwise(ctx, nvinfer1::ElementWiseOperation::kMAX, shape, idx_shape, name + "_index_shape")
+                        ->getOutput(0)
+                  : idx_shape;
+  }
+
+  std::vector<nvinfer1::ITensor*> coordinates;
+  for (size_t i = 0; i < indices.size(); i++) {
+    auto idx_name = name + "_index_" + std::to_string(i);
+    auto idx = broadcast_to(ctx, n, indices[i], shape, static_shape, idx_name);
+    coordinates.push_back(addPadding(ctx, n, idx, adv.index_rank + 1, true, true, idx_name + "_unsqueeze"));
+  }
+  if (coordinates.size() == 1) {
+    adv.coordinates = coordinates[0];
+  } else {
+    auto concat_layer = ctx->net->addConcatenation(coordinates.data(), coordinates.size());
+    TORCHTRT_CHECK(concat_layer, "Unable to create concatenation layer from node: " << *n);
+    concat_layer->setAxis(adv.index_rank);
+    concat_layer->setName((name + "_coordinates").c_str());
+    adv.coordinates = concat_layer->getOutput(0);
+  }
+  return adv;
+}
+
+// Permutation moving the index dimensions of a [S..., other axes...] result to where PyTorch puts them: in place of
+// the indexed axes if those are consecutive and in front otherwise
+std::vector<int32_t> advanced_index_result_order(const AdvancedIndex& adv, const std::vector<int32_t>& axes) {
+  auto num_other = static_cast<int32_t>(adv.order.size() - axes.size());
+  std::vector<int32_t> order;
+  auto consecutive = axes.back() - axes.front() + 1 == static_cast<int32_t>(axes.size());
+  auto before = consecutive ? axes.front() : 0;
+  for (int32_t i = 0; i < before; i++) {
+    order.push_back(adv.index_rank + i);
+  }
+  for (int32_t i = 0; i < adv.index_rank; i++) {
+    order.push_back(i);
+  }
+  for (int32_t i = before; i < num_other; i++) {
+    order.push_back(adv.index_rank + i);
+  }
+  return order;
+}
+
+nvinfer1::ITensor* transpose(ConversionCtx* ctx, nvinfer1::ITensor* in, const std::vector<int32_t>& order) {
+  if (std::is_sorted(order.begin(), order.end())) {
+    return in;
+  }
+  auto transpose_layer = ctx->net->addShuffle(*in);
+  TORCHTRT_CHECK(transpose_layer, "Unable to create shuffle layer");
+  nvinfer1::Permutation permute;
+  std::copy(order.begin(), order.end(), permute.order);
+  transpose_layer->setFirstTranspose(permute);
+  return transpose_layer->getOutput(0);
+}
+
+std::vector<int32_t> inverse_order(const std::vector<int32_t>& order) {
+  std::vector<int32_t> inverse(order.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    inverse[order[i]] = static_cast<int32_t>(i);
+  }
+  return inverse;
+}
+
+// Index tensors of aten::index and aten::index_put, skipping the None entries of axes that are not indexed
+std::vector<nvinfer1::ITensor*> index_tensors(
+    ConversionCtx* ctx,
+    c10::ArrayRef<torch::jit::IValue> ts,
+    std::vector<int32_t>& axes) {
+  std::vector<nvinfer1::ITensor*> tensors;
+  for (size_t i = 0; i < ts.size(); i++) {
+    auto t = ts[i];
+    if (t.isTensor()) {
+      auto torch_tensor = t.toTensor().to(torch::kInt32);
+      tensors.push_back(tensor_to_const(ctx, torch_tensor));
+      axes.push_back(i);
+    } else if (!t.isNone()) {
+      axes.push_back(i);
+      auto cont = t.toCustomClass<TensorContainer>();
+      // Set datatype for indices tensor to INT32
+      tensors.push_back(castITensor(ctx, cont->tensor(), nvinfer1::DataType::kINT32));
+    }
+  }
+  return tensors;
+}
+
+bool add_index_put(ConversionCtx* ctx, const torch::jit::Node* n, args& args) {
+  auto self = args[0].ITensorOrFreeze(ctx);
+  std::vector<int32_t> axes;
+  auto indices = index_tensors(ctx, args[1].IValue()->toListRef(), axes);
+  auto values = args[2].ITensorOrFreeze(ctx);
+  auto accumulate = args[3].unwrapToBool();
+  auto name = util::node_info(n);
+  if (values->getType() != self->getType()) {
+    values = castITensor(ctx, values, self->getType(), name + "_values");
+  }
+  if (indices.empty()) {
+    auto out = broadcast_to(ctx, n, values, getShapeOutput(ctx, self), self->getDimensions(), name);
+    if (accumulate) {
+      out = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kSUM, self, out, name + "_accumulate")->getOutput(0);
+    }
+    auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], out);
+    LOG_DEBUG("Output tensor shape: " << out_tensor->getDimensions());
+    return true;
+  }
+
+  auto adv = linearize_advanced_index(ctx, n, self, indices, axes);
+  auto gather_layer = ctx->net->addGather(*adv.self, *adv.coordinates, 0);
+  TORCHTRT_CHECK(gather_layer, "Unable to create gather layer from node: " << *n);
+  gather_layer->setMode(nvinfer1::GatherMode::kND);
+  gather_layer->setNbElementWiseDims(0);
+  auto selected = gather_layer->getOutput(0);
+
+  // values broadcast against the result of indexing self, brought to the [S..., other axes...] layout of the update
+  auto result_order = advanced_index_result_order(adv, axes);
+  auto update_dims = selected->getDimensions();
+  values = addPadding(ctx, n, values, update_dims.nbDims, false, true, name + "_values_pad");
+  values = transpose(ctx, values, inverse_order(result_order));
+  auto updates = broadcast_to(ctx, n, values, getShapeOutput(ctx, selected), update_dims, name + "_values");
+  if (accumulate) {
+    LOG_WARNING(
+        "If indices of index_put with accumulate=True repeat, the converted graph will produce incorrect results.");
+    updates = add_elementwise(ctx, nvinfer1::ElementWiseOperation::kSUM, selected, updates, name + "_accumulate")
+                  ->getOutput(0);
+  }
+
+  auto scatter_layer = ctx->net->addScatter(*adv.self, *adv.coordinates, *updates, nvinfer1::ScatterMode::kND);
+  TORCHTRT_CHECK(scatter_layer, "Unable to create scatter layer from node: " << *n);
+  scatter_layer->setName(name.c_str());
+  auto out = transpose(ctx, scatter_layer->getOutput(0), inverse_order(adv.order));
+  auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], out);
+  LOG_DEBUG("Output tensor shape: " << out_tensor->getDimensions());
+  return true;
+}
+
 auto select_registrations TORCHTRT_UNUSED =
     RegisterNodeConversionPatterns()
         .pattern(
@@ -273,27 +510,6 @@ auto select_registrations TORCHTRT_UNUSED =
                return true;
              }})
         .pattern(
-            {"aten::embedding(Tensor weight, Tensor indices, int padding_idx=-1, bool scale_grad_by_freq=False, bool sparse=False) -> (Tensor)",
-             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
-               auto embeddingTensor = args[0].ITensorOrFreeze(ctx);
-               auto indicesTensor = args[1].ITensorOrFreeze(ctx);
-               // Set datatype for indices tensor to INT32
-               auto identity = ctx->net->addIdentity(*indicesTensor);
-               identity->setOutputType(0, nvinfer1::DataType::kINT32);
-               indicesTensor = identity->getOutput(0);
-
-               // IGatherLayer takes in input tensor, the indices, and the axis of input tensor to take indices from
-               auto gather_layer = ctx->net->addGather(*embeddingTensor, *indicesTensor, 0);
-               TORCHTRT_CHECK(gather_layer, "Unable to create gather layer from node: " << *n);
-               auto gather_out = gather_layer->getOutput(0);
-
-               auto out = ctx->AssociateValueAndTensor(n->outputs()[0], gather_out);
-
-               LOG_DEBUG("Output tensor shape: " << out->getDimensions());
-
-               return true;
-             }})
-        .pattern(
             {"aten::roll(Tensor self, int[1] shifts, int[1] dims=[]) -> (Tensor)",
              [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
                auto in = args[0].ITensor();
@@ -318,31 +534,9 @@ auto select_registrations TORCHTRT_UNUSED =
         .pattern(
             {"aten::index.Tensor(Tensor self, Tensor?[] indices) -> (Tensor)",
              [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
-               // refer to
-               // https://github.com/pytorch/pytorch/blob/974ad8fa6cc63b89234beb5ebff54c2d42711932/torch/onnx/symbolic_opset9.py#L4627
                auto in = args[0].ITensorOrFreeze(ctx);
-               auto ts = args[1].IValue()->toListRef();
-
-               std::vector<nvinfer1::ITensor*> tensors;
                std::vector<int32_t> adv_idx_indices;
-               for (size_t i = 0; i < ts.size(); i++) {
-                 auto t = ts[i];
-                 if (t.isTensor()) {
-                   auto torch_tensor = t.toTensor().to(torch::kInt32);
-                   tensors.push_back(tensor_to_const(ctx, torch_tensor));
-                   adv_idx_indices.push_back(i);
-                 } else {
-                   // IValue
-                   if (!t.isNone()) {
-                     adv_idx_indices.push_back(i);
-                     auto cont = t.toCustomClass<TensorContainer>();
-                     // Set datatype for indices tensor to INT32
-                     auto identity = ctx->net->addIdentity(*cont->tensor());
-                     identity->setOutputType(0, nvinfer1::DataType::kINT32);
-                     tensors.push_back(identity->getOutput(0));
-                   }
-                 }
-               }
+               auto tensors = index_tensors(ctx, args[1].IValue()->toListRef(), adv_idx_indices);
 
                if (tensors.size() == 0) {
                  auto identity_out = ctx->net->addIdentity(*in)->getOutput(0);
@@ -350,10 +544,6 @@ auto select_registrations TORCHTRT_UNUSED =
                  LOG_DEBUG("Output tensor shape: " << out->getDimensions());
                } else if (tensors.size() == 1) {
                  auto indicesTensor = tensors[0];
-                 // Set datatype for indices tensor to INT32
-                 auto identity = ctx->net->addIdentity(*indicesTensor);
-                 identity->setOutputType(0, nvinfer1::DataType::kINT32);
-                 indicesTensor = identity->getOutput(0);
 
                  // IGatherLayer takes in input tensor, the indices, and the axis of input tensor to take indices
                  // from
@@ -364,191 +554,32 @@ auto select_registrations TORCHTRT_UNUSED =
                  auto out = ctx->AssociateValueAndTensor(n->outputs()[0], gather_out);
                  LOG_DEBUG("Output tensor shape: " << out->getDimensions());
                } else {
-                 auto inDims = in->getDimensions();
-                 int rank = inDims.nbDims;
-                 LOG_WARNING("If indices include negative values, the exported graph will produce incorrect results.");
-                 int adv_idx_count = adv_idx_indices.size();
-                 nvinfer1::ITensor* in_shape_itensor = getShapeOutput(ctx, in);
-                 std::vector<nvinfer1::ITensor*> dim_tensor_list;
-                 for (int i = 0; i < rank; i++) {
-                   auto dim_tensor =
-                       ctx->net
-                           ->addGather(*in_shape_itensor, *tensor_to_const(ctx, torch::tensor({i}, torch::kInt32)), 0)
-                           ->getOutput(0);
-                   dim_tensor_list.push_back(dim_tensor);
-                 }
-
-                 // t: [x_1, y_1, y_2, ..., x_m, ..., y_n] -> t: [x_1, x_2, ..., x_m, y_1, y_2, ..., y_n],
-                 // where t is a tensor of rank m+n, {x_i} are axes where tensor index is provided, and {y_i} are axes
-                 // for ":".
-                 auto in_transpose_layer = ctx->net->addShuffle(*in);
-                 TORCHTRT_CHECK(in_transpose_layer, "Unable to create shuffle layer from node: " << *n);
-                 nvinfer1::Permutation permute;
-                 std::vector<int32_t> new_order;
-                 for (int i = 0; i < adv_idx_count; i++) {
-                   new_order.push_back(adv_idx_indices[i]);
-                 }
-                 for (int i = 0; i < rank; i++) {
-                   if (std::find(adv_idx_indices.begin(), adv_idx_indices.end(), i) == adv_idx_indices.end()) {
-                     new_order.push_back(i);
-                   }
-                 }
-                 std::copy(new_order.begin(), new_order.end(), permute.order);
-                 in_transpose_layer->setSecondTranspose(permute);
-                 auto shuffle_out = in_transpose_layer->getOutput(0);
-
-                 //  t: [x_1, x_2, ..., x_m, y_1, y_2, ..., y_n] -> t: [x_1*x_2* ...*x_m, y_1*y_2* ...*y_n]
-                 nvinfer1::ITensor* flatten_tensor = NULL;
-                 {
-                   nvinfer1::ITensor* shuffle_shape_tensor = getShapeOutput(ctx, shuffle_out);
-                   auto d0 = tensor_to_const(ctx, torch::tensor({1}, torch::kInt32));
-                   for (int i = 0; i < adv_idx_count; i++) {
-                     auto dim_tensor =
-                         ctx->net
-                             ->addGather(
-                                 *shuffle_shape_tensor, *tensor_to_const(ctx, torch::tensor({i}, torch::kInt32)), 0)
-                             ->getOutput(0);
-                     d0 = add_elementwise(
-                              ctx,
-                              nvinfer1::ElementWiseOperation::kPROD,
-                              d0,
-                              dim_tensor,
-                              util::node_info(n) + std::string("_compute_dim0_") + std::to_string(i))
-                              ->getOutput(0);
-                   }
-
-                   auto d1 = tensor_to_const(ctx, torch::tensor({1}, torch::kInt32));
-                   for (int i = adv_idx_count; i < rank; i++) {
-                     auto dim_tensor =
-                         ctx->net
-                             ->addGather(
-                                 *shuffle_shape_tensor, *tensor_to_const(ctx, torch::tensor({i}, torch::kInt32)), 0)
-                             ->getOutput(0);
-                     d1 = add_elementwise(
-                              ctx,
-                              nvinfer1::ElementWiseOperation::kPROD,
-                              d1,
-                              dim_tensor,
-                              util::node_info(n) + std::string("_compute_dim1_") + std::to_string(i))
-                              ->getOutput(0);
-                   }
-
-                   std::vector<nvinfer1::ITensor*> concat_tensors;
-                   concat_tensors.push_back(d0);
-                   concat_tensors.push_back(d1);
-                   auto concat_layer = ctx->net->addConcatenation(concat_tensors.data(), concat_tensors.size());
-
-                   auto shuffle = ctx->net->addShuffle(*shuffle_out);
-                   shuffle->setInput(1, *concat_layer->getOutput(0));
-                   flatten_tensor = shuffle->getOutput(0);
-                   LOG_DEBUG(flatten_tensor->getDimensions());
-                 }
-
-                 // tensor index = \sum_{i=1}^m (ind_i * \prod_{j=i+1}^m (x_j)),  ind_i is input indices[i], x_j is the
-                 // j dimension of input x.
-                 nvinfer1::ITensor* multiplier = dim_tensor_list[adv_idx_indices[adv_idx_count - 1]];
-                 nvinfer1::ITensor* cum_adv_index = tensors[adv_idx_count - 1];
-                 for (int i = adv_idx_count - 2; i >= 0; i--) {
-                   nvinfer1::ITensor* adv_index =
-                       add_elementwise(
-                           ctx,
-                           nvinfer1::ElementWiseOperation::kPROD,
-                           tensors[i],
-                           multiplier,
-                           util::node_info(n) + std::string("_adv_index_") + std::to_string(i))
-                           ->getOutput(0);
-                   cum_adv_index = add_elementwise(
-                                       ctx,
-                                       nvinfer1::ElementWiseOperation::kSUM,
-                                       cum_adv_index,
-                                       adv_index,
-                                       util::node_info(n) + std::string("_cum_adv_index_") + std::to_string(i))
-                                       ->getOutput(0);
-                   multiplier = add_elementwise(
-                                    ctx,
-                                    nvinfer1::ElementWiseOperation::kPROD,
-                                    multiplier,
-                                    dim_tensor_list[adv_idx_indices[i]],
-                                    util::node_info(n) + std::string("_multiplier_") + std::to_string(i))
-                                    ->getOutput(0);
-                 }
-
-                 // perform gather
-                 auto gather_out = ctx->net->addGather(*flatten_tensor, *cum_adv_index, 0)->getOutput(0);
-
-                 nvinfer1::ITensor* reshape_output = NULL;
-                 {
-                   nvinfer1::ITensor* cum_adv_index_shape_tensor = getShapeOutput(ctx, cum_adv_index);
-                   // check if all advanced indices are consecutive.
-                   if (adv_idx_count == (adv_idx_indices[adv_idx_count - 1] - adv_idx_indices[0] + 1)) {
-                     // unfold regular index axes
-                     std::vector<nvinfer1::ITensor*> concat_tensors;
-                     concat_tensors.push_back(tensor_to_const(ctx, torch::tensor({-1}, torch::kInt32)));
-                     for (int i = 0; i < rank; i++) {
-                       if (std::find(adv_idx_indices.begin(), adv_idx_indices.end(), i) == adv_idx_indices.end()) {
-                         nvinfer1::ITensor* current_dim = dim_tensor_list[i];
-                         concat_tensors.push_back(current_dim);
-                       }
-                     }
-                     auto concat_layer = ctx->net->addConcatenation(concat_tensors.data(), concat_tensors.size());
-                     auto regular_index_shuffle_layer = ctx->net->addShuffle(*gather_out);
-                     regular_index_shuffle_layer->setInput(1, *concat_layer->getOutput(0));
-                     auto unfold_tensor = regular_index_shuffle_layer->getOutput(0);
-
-                     // Transpose folded advanced indexed axis to its original location.
-                     auto transpose_advanced_shuffle_layer = ctx->net->addShuffle(*unfold_tensor);
-                     nvinfer1::Permutation permute;
-                     std::vector<int32_t> new_order;
-                     for (int i = 1; i < adv_idx_indices[0] + 1; i++) {
-                       new_order.push_back(i);
-                     }
-                     new_order.push_back(0);
-                     for (int i = adv_idx_indices[0] + 1; i < rank - adv_idx_count + 1; i++) {
-                       new_order.push_back(i);
-                     }
-                     std::copy(new_order.begin(), new_order.end(), permute.order);
-                     transpose_advanced_shuffle_layer->setSecondTranspose(permute);
-                     auto shuffle_out = transpose_advanced_shuffle_layer->getOutput(0);
-
-                     // unfold advanced index axes
-                     std::vector<nvinfer1::ITensor*> concat_final_tensors;
-                     for (int i = 0; i < adv_idx_indices[0]; i++) {
-                       nvinfer1::ITensor* current_dim = dim_tensor_list[i];
-                       concat_final_tensors.push_back(current_dim);
-                     }
-                     concat_final_tensors.push_back(cum_adv_index_shape_tensor);
-                     for (int i = adv_idx_indices[0]; i < rank; i++) {
-                       if (std::find(adv_idx_indices.begin(), adv_idx_indices.end(), i) == adv_idx_indices.end()) {
-                         nvinfer1::ITensor* current_dim = dim_tensor_list[i];
-                         concat_final_tensors.push_back(current_dim);
-                       }
-                     }
-                     auto concat_final_shape_layer =
-                         ctx->net->addConcatenation(concat_final_tensors.data(), concat_final_tensors.size());
-                     auto unfold_advanced_shuffle_layer = ctx->net->addShuffle(*shuffle_out);
-                     unfold_advanced_shuffle_layer->setInput(1, *concat_final_shape_layer->getOutput(0));
-                     reshape_output = unfold_advanced_shuffle_layer->getOutput(0);
-                   } else {
-                     std::vector<nvinfer1::ITensor*> concat_tensors;
-                     concat_tensors.push_back(cum_adv_index_shape_tensor);
-                     for (int i = 0; i < rank; i++) {
-                       if (std::find(adv_idx_indices.begin(), adv_idx_indices.end(), i) == adv_idx_indices.end()) {
-                         nvinfer1::ITensor* current_dim = dim_tensor_list[i];
-                         concat_tensors.push_back(current_dim);
-                       }
-                     }
-                     auto concat_layer = ctx->net->addConcatenation(concat_tensors.data(), concat_tensors.size());
-                     auto shuffle_layer = ctx->net->addShuffle(*gather_out);
-                     shuffle_layer->setInput(1, *concat_layer->getOutput(0));
-                     reshape_output = shuffle_layer->getOutput(0);
-                   }
-                 }
+                 // The index tensors are stacked into [S..., m] coordinates of the m indexed axes, moved to the
+                 // front of the input, so that a single kND gather produces [S..., other axes...]
+                 auto adv = linearize_advanced_index(ctx, n, in, tensors, adv_idx_indices);
+                 auto gather_layer = ctx->net->addGather(*adv.self, *adv.coordinates, 0);
+                 TORCHTRT_CHECK(gather_layer, "Unable to create gather layer from node: " << *n);
+                 gather_layer->setMode(nvinfer1::GatherMode::kND);
+                 gather_layer->setNbElementWiseDims(0);
+                 gather_layer->setName(util::node_info(n).c_str());
+                 auto gather_out = transpose(
+                     ctx, gather_layer->getOutput(0), advanced_index_result_order(adv, adv_idx_indices));
 
-                 auto out = ctx->AssociateValueAndTensor(n->outputs()[0], reshape_output);
+                 auto out = ctx->AssociateValueAndTensor(n->outputs()[0], gather_out);
                  LOG_DEBUG("Output tensor shape: " << out->getDimensions());
                }
                return true;
              }})
+        .pattern(
+            {"aten::index_put(Tensor self, Tensor?[] indices, Tensor values, bool accumulate=False) -> (Tensor)",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               return add_index_put(ctx, n, args);
+             }})
+        .pattern(
+            {"aten::index_put_(Tensor(a!) self, Tensor?[] indices, Tensor values, bool accumulate=False) -> (Tensor(a!))",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               return add_index_put(ctx, n, args);
+             }})
         .pattern(
             {"aten::slice.Tensor(Tensor(a) self, int dim=0, int? start=None, int? end=None, int step=1) -> Tensor(a)",
              [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
@@ -5,6 +5,7 @@
 #include "torch/torch.h"
 
 #include <ATen/ATen.h>
+#include <algorithm>
 #include <vector>
 
 namespace torch_tensorrt {
@@ -14,59 +15,334 @@ namespace converters {
 namespace impl {
 namespace {
 
-auto topk_registrations TORCHTRT_UNUSED = RegisterNodeConversionPatterns().pattern(
-    {"aten::topk(Tensor self, int k, int dim=-1, bool largest=True, bool sorted=True) -> (Tensor values, Tensor indices)",
-     [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
-       auto self = args[0].ITensorOrFreeze(ctx);
-       auto k = args[1].unwrapToInt();
-       auto dim = args[2].unwrapToInt();
-       auto largest = args[3].unwrapToBool();
-       LOG_DEBUG(
-           "Note: sorted argument is not used in TensorRT for aten::topk, results will depend on the value of largest");
-       // auto sorted = args[4].unwrapToBool(); # Currently unused
+// Largest k an ITopKLayer supports
+constexpr int64_t kMaxTopK = 3840;
+// Length of the chunks the first stage of a hierarchical topk reduces. A topk layer reduces each row on its own, so a
+// single long row leaves most of the GPU idle
+constexpr int64_t kTopKChunkLength = 16384;
 
-       auto selfDim = util::toVec(self->getDimensions());
+struct TopKOutputs {
+  nvinfer1::ITensor* values;
+  nvinfer1::ITensor* indices;
+};
 
-       // reduceAxes	The reduction dimensions. The bit in position i of bitmask reduceAxes corresponds to explicit
-       // dimension i of the result. E.g., the least significant bit corresponds to the first explicit dimension and the
-       // next to least significant bit corresponds to the second explicit dimension.
+// Top k of in along dim in a single topk layer, with k given by the 0D shape tensor dynamic_k if set
+TopKOutputs add_topk(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    nvinfer1::ITensor* in,
+    nvinfer1::TopKOperation op,
+    int64_t k,
+    int64_t dim,
+    const std::string& name,
+    nvinfer1::ITensor* dynamic_k = nullptr) {
+  // The topk layer requires at least 2 input dimensions
+  auto nbDims = in->getDimensions().nbDims;
+  if (nbDims == 1) {
+    in = addPadding(ctx, n, in, 2, true, true, name + "_unsqueeze");
+  }
+  auto topk_layer = ctx->net->addTopK(*in, op, k, 1 << dim);
+  TORCHTRT_CHECK(topk_layer, "Unable to create topk layer from node: " << *n);
+  if (dynamic_k) {
+    topk_layer->setInput(1, *dynamic_k);
+  }
+  topk_layer->setName(name.c_str());
 
-       if (dim < 0) {
-         dim = selfDim.size() + dim;
-       }
+  TopKOutputs out = {topk_layer->getOutput(0), topk_layer->getOutput(1)};
+  // If we expanded the input, squeeze the outputs
+  if (nbDims == 1) {
+    out.values = addUnpadding(ctx, n, out.values, 1, true, true, name + "_squeeze_values");
+    out.indices = addUnpadding(ctx, n, out.indices, 1, true, true, name + "_squeeze_indices");
+  }
+  return out;
+}
 
-       uint32_t shiftDim = 1 << dim;
+// Elements [start, start + size) of the last dim of in
+nvinfer1::ITensor* slice_last_dim(
+    ConversionCtx* ctx,
+    nvinfer1::ITensor* in,
+    int64_t start,
+    int64_t size,
+    const std::string& name) {
+  auto dims = in->getDimensions();
+  auto nbDims = dims.nbDims;
+  auto start_dims = util::toDims(std::vector<int64_t>(nbDims, 0));
+  auto size_dims = dims;
+  auto stride_dims = util::toDims(std::vector<int64_t>(nbDims, 1));
+  start_dims.d[nbDims - 1] = start;
+  size_dims.d[nbDims - 1] = size;
+  auto slice_layer = ctx->net->addSlice(*in, start_dims, size_dims, stride_dims);
+  TORCHTRT_CHECK(slice_layer, "Unable to create slice layer for " << name);
+  if (std::find(dims.d, dims.d + nbDims - 1, -1) != dims.d + nbDims - 1) {
+    // Leading dims keep their runtime size
+    std::vector<int32_t> keep(nbDims, 1);
+    keep.back() = 0;
+    std::vector<int32_t> last(nbDims, 0);
+    last.back() = static_cast<int32_t>(size);
+    auto shape = getShapeOutput(ctx, in, name + "_shape");
+    auto kept = add_elementwise(
+                    ctx,
+                    nvinfer1::ElementWiseOperation::kPROD,
+                    shape,
+                    tensor_to_const(ctx, torch::tensor(keep, torch::kInt32)),
+                    name + "_keep")
+                    ->getOutput(0);
+    auto size_tensor = add_elementwise(
+                           ctx,
+                           nvinfer1::ElementWiseOperation::kSUM,
+                           kept,
+                           tensor_to_const(ctx, torch::tensor(last, torch::kInt32)),
+                           name + "_size")
+                           ->getOutput(0);
+    slice_layer->setInput(2, *size_tensor);
+  }
+  slice_layer->setName(name.c_str());
+  return slice_layer->getOutput(0);
+}
 
-       LOG_DEBUG("Output topk reduce dim: " << dim);
+// Replaces the last dim of in by dims, leading dims are copied
+nvinfer1::ITensor* reshape_last_dim(
+    ConversionCtx* ctx,
+    nvinfer1::ITensor* in,
+    std::vector<int64_t> dims,
+    const std::string& name) {
+  std::vector<int64_t> shape(in->getDimensions().nbDims - 1, 0);
+  shape.insert(shape.end(), dims.begin(), dims.end());
+  auto shuffle_layer = ctx->net->addShuffle(*in);
+  TORCHTRT_CHECK(shuffle_layer, "Unable to create shuffle layer for " << name);
+  shuffle_layer->setReshapeDimensions(util::toDims(c10::IntArrayRef(shape)));
+  shuffle_layer->setName(name.c_str());
+  return shuffle_layer->getOutput(0);
+}
 
-       // The topk layer requires at least 2 input dimensions
-       auto nbDims = self->getDimensions().nbDims;
-       if (nbDims == 1) {
-         self = addPadding(ctx, n, self, 2, true, true);
-       }
+nvinfer1::ITensor* add_index_offset(
+    ConversionCtx* ctx,
+    nvinfer1::ITensor* indices,
+    at::Tensor offsets,
+    const std::string& name) {
+  return add_elementwise(
+             ctx, nvinfer1::ElementWiseOperation::kSUM, indices, tensor_to_const(ctx, offsets, name + "_offsets"), name)
+      ->getOutput(0);
+}
 
-       auto TopKOperation = largest ? (nvinfer1::TopKOperation::kMAX) : (nvinfer1::TopKOperation::kMIN);
+// Top k along the last dim of in, whose length is static, in two stages: the top k of every chunk of the dim, then the
+// top k of these candidates. Elements past the last full chunk are a shorter chunk of their own
+TopKOutputs add_hierarchical_topk(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    nvinfer1::ITensor* in,
+    nvinfer1::TopKOperation op,
+    int64_t k,
+    const std::string& name) {
+  auto nbDims = in->getDimensions().nbDims;
+  auto len = in->getDimensions().d[nbDims - 1];
+  auto chunk_len = std::max(kTopKChunkLength, k);
+  auto num_chunks = len / chunk_len;
+  auto tail_len = len - num_chunks * chunk_len;
+  LOG_DEBUG("Hierarchical topk over " << num_chunks << " chunks of " << chunk_len << " elements and " << tail_len);
 
-       auto new_layer = ctx->net->addTopK(*self, TopKOperation, k, shiftDim);
+  auto chunks = tail_len ? slice_last_dim(ctx, in, 0, num_chunks * chunk_len, name + "_chunks") : in;
+  chunks = reshape_last_dim(ctx, chunks, {num_chunks, chunk_len}, name + "_split");
+  auto chunk_top = add_topk(ctx, n, chunks, op, k, nbDims, name + "_chunk_topk");
+  // Chunk c starts at c * chunk_len
+  std::vector<int64_t> offset_shape(nbDims + 1, 1);
+  offset_shape[nbDims - 1] = num_chunks;
+  auto chunk_offsets = (torch::arange(num_chunks, torch::kInt32) * chunk_len).reshape(offset_shape);
+  std::vector<nvinfer1::ITensor*> values = {reshape_last_dim(ctx, chunk_top.values, {num_chunks * k}, name + "_v")};
+  auto chunk_indices = add_index_offset(ctx, chunk_top.indices, chunk_offsets, name + "_chunk_index");
+  std::vector<nvinfer1::ITensor*> indices = {reshape_last_dim(ctx, chunk_indices, {num_chunks * k}, name + "_i")};
 
-       TORCHTRT_CHECK(new_layer, "Unable to create topk layer from node: " << *n);
+  if (tail_len) {
+    auto tail = slice_last_dim(ctx, in, num_chunks * chunk_len, tail_len, name + "_tail");
+    auto tail_top = add_topk(ctx, n, tail, op, std::min(k, tail_len), nbDims - 1, name + "_tail_topk");
+    auto tail_offset = torch::full(std::vector<int64_t>(nbDims, 1), num_chunks * chunk_len, torch::kInt32);
+    values.push_back(tail_top.values);
+    indices.push_back(add_index_offset(ctx, tail_top.indices, tail_offset, name + "_tail_index"));
+  }
+  auto concat = [&](std::vector<nvinfer1::ITensor*>& tensors, const std::string& suffix) {
+    if (tensors.size() == 1) {
+      return tensors[0];
+    }
+    auto concat_layer = ctx->net->addConcatenation(tensors.data(), tensors.size());
+    TORCHTRT_CHECK(concat_layer, "Unable to create concatenation layer from node: " << *n);
+    concat_layer->setAxis(nbDims - 1);
+    concat_layer->setName((name + suffix).c_str());
+    return concat_layer->getOutput(0);
+  };
+  auto candidate_values = concat(values, "_candidate_values");
+  auto candidate_indices = concat(indices, "_candidate_indices");
 
-       auto values = new_layer->getOutput(0);
-       auto indices = new_layer->getOutput(1);
+  auto merged = add_topk(ctx, n, candidate_values, op, k, nbDims - 1, name + "_merge_topk");
+  auto gather_layer = ctx->net->addGather(*candidate_indices, *merged.indices, nbDims - 1);
+  TORCHTRT_CHECK(gather_layer, "Unable to create gather layer from node: " << *n);
+  gather_layer->setMode(nvinfer1::GatherMode::kELEMENT);
+  gather_layer->setName((name + "_merge_index").c_str());
+  return {merged.values, gather_layer->getOutput(0)};
+}
 
-       // If we expanded the input, squeeze the outputs
-       if (nbDims == 1) {
-         values = addUnpadding(ctx, n, values, 1, true, true, util::node_info(n) + "_squeeze_values");
-         indices = addUnpadding(ctx, n, indices, 1, true, true, util::node_info(n) + "_squeeze_indices");
-       }
+// Permutation moving dim to the end, or with inverse the last dim back to dim
+nvinfer1::Permutation move_dim_to_end(int nbDims, int64_t dim, bool inverse) {
+  nvinfer1::Permutation perm;
+  for (int i = 0; i < nbDims; i++) {
+    if (inverse) {
+      perm.order[i] = i == dim ? nbDims - 1 : (i < dim ? i : i - 1);
+    } else {
+      perm.order[i] = i == nbDims - 1 ? dim : (i < dim ? i : i + 1);
+    }
+  }
+  return perm;
+}
 
-       auto out0 = ctx->AssociateValueAndTensor(n->outputs()[0], values);
-       auto out1 = ctx->AssociateValueAndTensor(n->outputs()[1], indices);
-       LOG_DEBUG("Output tensor(0) shape: " << out0->getDimensions());
-       LOG_DEBUG("Output tensor(1) shape: " << out1->getDimensions());
+nvinfer1::ITensor* transpose(
+    ConversionCtx* ctx,
+    nvinfer1::ITensor* in,
+    nvinfer1::Permutation perm,
+    const std::string& name) {
+  auto shuffle_layer = ctx->net->addShuffle(*in);
+  TORCHTRT_CHECK(shuffle_layer, "Unable to create shuffle layer for " << name);
+  shuffle_layer->setFirstTranspose(perm);
+  shuffle_layer->setName(name.c_str());
+  return shuffle_layer->getOutput(0);
+}
 
-       return true;
-     }});
+// The TorchOp plugin needs static shapes
+bool is_static(nvinfer1::ITensor* in) {
+  auto dims = in->getDimensions();
+  return std::find(dims.d, dims.d + dims.nbDims, -1) == dims.d + dims.nbDims;
+}
+
+bool associate_outputs(ConversionCtx* ctx, const torch::jit::Node* n, TopKOutputs out, bool indices_only) {
+  if (indices_only) {
+    auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], out.indices);
+    LOG_DEBUG("Output tensor shape: " << out_tensor->getDimensions());
+    return true;
+  }
+  auto out0 = ctx->AssociateValueAndTensor(n->outputs()[0], out.values);
+  auto out1 = ctx->AssociateValueAndTensor(n->outputs()[1], out.indices);
+  LOG_DEBUG("Output tensor(0) shape: " << out0->getDimensions());
+  LOG_DEBUG("Output tensor(1) shape: " << out1->getDimensions());
+  return true;
+}
+
+// Axes up to kMaxTopK long are sorted by a topk layer over all of their elements. Longer axes run the Torch kernel in
+// a TorchOp plugin, keeping the engine whole
+bool convert_sort(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    args& args,
+    int64_t dim,
+    bool descending,
+    bool stable,
+    bool indices_only) {
+  auto self = args[0].ITensorOrFreeze(ctx);
+  auto nbDims = self->getDimensions().nbDims;
+  dim = dim < 0 ? dim + nbDims : dim;
+  auto len = self->getDimensions().d[dim];
+  auto op = descending ? nvinfer1::TopKOperation::kMAX : nvinfer1::TopKOperation::kMIN;
+  auto name = util::node_info(n);
+
+  // The topk layer does not order equal elements
+  if ((stable || len > kMaxTopK) && is_static(self) && torch_op_plugin_supports(n)) {
+    LOG_DEBUG("Sorting " << self->getDimensions() << " along dim " << dim << " in a TorchOp plugin for " << *n);
+    return convert_with_torch_op_plugin(ctx, n, args);
+  }
+  if (stable) {
+    LOG_WARNING("Equal elements may not keep their order in the TensorRT sort of " << *n);
+  }
+  if (len != -1) {
+    TORCHTRT_CHECK(
+        len <= kMaxTopK,
+        "Sorting an axis of " << len << " elements needs a TorchOp plugin, which needs static shapes and constant "
+                              << "arguments, for " << *n);
+    return associate_outputs(ctx, n, add_topk(ctx, n, self, op, len, dim, name), indices_only);
+  }
+#if NV_TENSORRT_MAJOR >= 10
+  LOG_WARNING("The dynamic axis sorted by " << *n << " must not be longer than " << kMaxTopK << " elements at runtime");
+  auto shape = getShapeOutput(ctx, self, name + "_shape");
+  auto len_tensor =
+      ctx->net->addGather(*shape, *tensor_to_const(ctx, torch::tensor({dim}, torch::kInt32)), 0)->getOutput(0);
+  auto scalar_layer = ctx->net->addShuffle(*len_tensor);
+  TORCHTRT_CHECK(scalar_layer, "Unable to create shuffle layer from node: " << *n);
+  scalar_layer->setReshapeDimensions(nvinfer1::Dims{0, {}});
+  scalar_layer->setName((name + "_k").c_str());
+  return associate_outputs(
+      ctx, n, add_topk(ctx, n, self, op, 1, dim, name, scalar_layer->getOutput(0)), indices_only);
+#else
+  TORCHTRT_THROW_ERROR("Sorting along a dynamic axis requires TensorRT 10 or later, node: " << *n);
+#endif
+}
+
+auto topk_registrations TORCHTRT_UNUSED =
+    RegisterNodeConversionPatterns()
+        .pattern(
+            {"aten::topk(Tensor self, int k, int dim=-1, bool largest=True, bool sorted=True) -> (Tensor values, Tensor indices)",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               auto self = args[0].ITensorOrFreeze(ctx);
+               auto k = args[1].unwrapToInt();
+               auto dim = args[2].unwrapToInt();
+               auto largest = args[3].unwrapToBool();
+               LOG_DEBUG(
+                   "Note: sorted argument is not used in TensorRT for aten::topk, results will depend on the value of "
+                   << "largest");
+               // auto sorted = args[4].unwrapToBool(); # Currently unused
+
+               auto nbDims = self->getDimensions().nbDims;
+               if (dim < 0) {
+                 dim = nbDims + dim;
+               }
+               LOG_DEBUG("Output topk reduce dim: " << dim);
+
+               // The Torch kernel selects any k in a TorchOp plugin
+               if (k > kMaxTopK) {
+                 TORCHTRT_CHECK(
+                     is_static(self) && torch_op_plugin_supports(n),
+                     "k = " << k << " is larger than the " << kMaxTopK << " TensorRT supports and needs a TorchOp "
+                            << "plugin, which needs static shapes and constant arguments, for " << *n);
+                 return convert_with_torch_op_plugin(ctx, n, args);
+               }
+
+               auto op = largest ? nvinfer1::TopKOperation::kMAX : nvinfer1::TopKOperation::kMIN;
+               auto name = util::node_info(n);
+               auto len = self->getDimensions().d[dim];
+               TopKOutputs out;
+               if (len != -1 && len >= 2 * std::max(kTopKChunkLength, k)) {
+                 // Long axes are reduced chunk by chunk first, along the last dim
+                 auto in = dim == nbDims - 1
+                     ? self
+                     : transpose(ctx, self, move_dim_to_end(nbDims, dim, false), name + "_to_last");
+                 out = add_hierarchical_topk(ctx, n, in, op, k, name);
+                 if (dim != nbDims - 1) {
+                   auto back = move_dim_to_end(nbDims, dim, true);
+                   out.values = transpose(ctx, out.values, back, name + "_values_from_last");
+                   out.indices = transpose(ctx, out.indices, back, name + "_indices_from_last");
+                 }
+               } else {
+                 out = add_topk(ctx, n, self, op, k, dim, name);
+               }
+               return associate_outputs(ctx, n, out, false);
+             }})
+        .pattern(
+            {"aten::sort(Tensor self, int dim=-1, bool descending=False) -> (Tensor values, Tensor indices)",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               return convert_sort(ctx, n, args, args[1].unwrapToInt(), args[2].unwrapToBool(), false, false);
+             }})
+        .pattern(
+            {"aten::sort.stable(Tensor self, *, bool? stable, int dim=-1, bool descending=False) -> (Tensor values, Tensor indices)",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               auto stable = args[1].isIValue() && args[1].IValue()->isBool() && args[1].unwrapToBool();
+               return convert_sort(ctx, n, args, args[2].unwrapToInt(), args[3].unwrapToBool(), stable, false);
+             }})
+        .pattern(
+            {"aten::argsort(Tensor self, int dim=-1, bool descending=False) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               return convert_sort(ctx, n, args, args[1].unwrapToInt(), args[2].unwrapToBool(), false, true);
+             }})
+        .pattern(
+            {"aten::argsort.stable(Tensor self, *, bool stable, int dim=-1, bool descending=False) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               return convert_sort(
+                   ctx, n, args, args[2].unwrapToInt(), args[3].unwrapToBool(), args[1].unwrapToBool(), true);
+             }});
 
 } // namespace
 } // namespace impl
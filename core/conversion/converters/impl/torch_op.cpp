@@ -0,0 +1,110 @@
+#include "ATen/core/dispatch/Dispatcher.h"
+#include "NvInfer.h"
+#include "core/conversion/converters/converters.h"
+#include "core/plugins/impl/torch_op_plugin.h"
+#include "core/util/prelude.h"
+#include "torch/torch.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace torch_tensorrt {
+namespace core {
+namespace conversion {
+namespace converters {
+
+bool torch_op_plugin_supports(const torch::jit::Node* n) {
+  auto schema = n->maybeSchema();
+  // The kernel reads the engine buffers in place, so it must not write to its inputs
+  if (!schema || schema->is_mutable() || n->blocks().size() > 0 || n->outputs().size() == 0) {
+    return false;
+  }
+  if (!c10::Dispatcher::singleton().findSchema(schema->operator_name())) {
+    return false;
+  }
+  bool has_tensor_input = false;
+  for (auto in : n->inputs()) {
+    if (in->type()->isSubtypeOf(c10::TensorType::get())) {
+      has_tensor_input = true;
+    } else if (in->node()->kind() != torch::jit::prim::Constant) {
+      // Other arguments are stored in the plugin
+      return false;
+    }
+  }
+  for (auto out : n->outputs()) {
+    if (!out->type()->isSubtypeOf(c10::TensorType::get())) {
+      return false;
+    }
+  }
+  return has_tensor_input;
+}
+
+bool convert_with_torch_op_plugin(ConversionCtx* ctx, const torch::jit::Node* n, args& args) {
+  auto schema = n->maybeSchema();
+  TORCHTRT_CHECK(schema, "Unable to get schema for Node " << util::node_info(n) << " (TorchOp plugin)");
+  auto op = c10::Dispatcher::singleton().findSchema(schema->operator_name());
+  TORCHTRT_CHECK(op, "Operator " << schema->operator_name() << " of " << util::node_info(n) << " is not registered");
+
+  std::vector<nvinfer1::ITensor*> inputs;
+  std::vector<int64_t> input_positions;
+  std::vector<at::ScalarType> input_dtypes;
+  std::vector<c10::IValue> op_args;
+  // The operator runs once on zeros to find the shapes and types of its outputs
+  torch::jit::Stack example_stack;
+  auto options = at::TensorOptions().device(at::Device(at::kCUDA, ctx->settings.device.gpu_id));
+  for (size_t i = 0; i < args.size(); i++) {
+    if (args[i].isITensor() || (args[i].isIValue() && args[i].IValue()->isTensor())) {
+      auto in = args[i].ITensorOrFreeze(ctx);
+      auto dims = util::toVec(in->getDimensions());
+      TORCHTRT_CHECK(
+          std::find(dims.begin(), dims.end(), -1) == dims.end(),
+          "The TorchOp plugin needs static input shapes, input " << i << " of " << util::node_info(n) << " has shape "
+                                                                 << in->getDimensions());
+      auto dtype = util::TRTDataTypeToScalarType(in->getType());
+      inputs.push_back(in);
+      input_positions.push_back(i);
+      input_dtypes.push_back(dtype);
+      op_args.push_back(c10::IValue());
+      example_stack.push_back(at::zeros(dims, options.dtype(dtype)));
+    } else {
+      auto arg = args[i].isIValue() ? *args[i].IValue() : c10::IValue();
+      op_args.push_back(arg);
+      example_stack.push_back(arg);
+    }
+  }
+
+  op->callBoxed(&example_stack);
+  std::vector<std::vector<int64_t>> output_shapes;
+  std::vector<at::ScalarType> output_dtypes;
+  for (const auto& out : example_stack) {
+    auto t = out.toTensor();
+    TORCHTRT_CHECK(
+        util::optScalarTypeToTRTDataType(t.scalar_type()),
+        util::node_info(n) << " returns a " << t.scalar_type() << " tensor, which TensorRT does not support");
+    output_shapes.push_back(t.sizes().vec());
+    output_dtypes.push_back(t.scalar_type());
+  }
+
+  auto plugin = new plugins::impl::TorchOpPlugin(
+      schema->name(),
+      schema->overload_name(),
+      std::move(op_args),
+      std::move(input_positions),
+      std::move(input_dtypes),
+      std::move(output_shapes),
+      std::move(output_dtypes));
+  auto new_layer = ctx->net->addPluginV2(inputs.data(), inputs.size(), *plugin);
+  TORCHTRT_CHECK(new_layer, "Unable to create TorchOp plugin layer from node" << *n);
+  new_layer->setName(util::node_info(n).c_str());
+
+  for (size_t i = 0; i < n->outputs().size(); i++) {
+    auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[i], new_layer->getOutput(i));
+    LOG_DEBUG("Output tensor shape: " << out_tensor->getDimensions());
+  }
+  return true;
+}
+
+} // namespace converters
+} // namespace conversion
+} // namespace core
+} // namespace torch_tensorrt
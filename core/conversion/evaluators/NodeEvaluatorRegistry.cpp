@@ -1,9 +1,13 @@
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 
 #include "ATen/core/List.h"
 #include "ATen/core/functional.h"
 #include "ATen/core/ivalue.h"
 #include "ATen/core/stack.h"
+#include "torch/csrc/jit/frontend/function_schema_parser.h"
 #include "torch/csrc/jit/ir/constants.h"
 #include "torch/csrc/jit/ir/ir.h"
 
@@ -28,27 +32,23 @@ bool FindInVec(std::vector<c10::OperatorName>& names, c10::OperatorName target)
 
 class NodeEvaluatorRegistry {
  public:
-  void RegisterEvaluator(torch::jit::NodeKind node_kind, EvalRegistration eval_reg) {
-    LOG_DEBUG("Registering evaluator for " << node_kind.toQualString());
-    auto iter = evaluator_lut_.find(node_kind);
-    if (iter != evaluator_lut_.end()) {
-      TORCHTRT_THROW_ERROR(
-          "Attempting to override already registered evaluator " << node_kind.toQualString()
-                                                                 << ", merge implementations instead");
-    }
-    for (auto const& e : eval_reg.options.supported_variants) {
-      registered_evaluator_schemas_.insert(e);
-    }
-    evaluator_lut_[node_kind] = std::move(eval_reg);
+  // Like converters, evaluators registered when the library loads only have their schemas parsed on the first lookup
+  void DeferEvaluator(EvalRegistration eval_reg) {
+    std::unique_lock<std::shared_mutex> lock(mu_);
+    pending_evaluators_.push_back(std::move(eval_reg));
+    has_pending_ = true;
   }
 
   NodeEvaluator FindEvaluator(const torch::jit::Node* n) {
+    RegisterPendingEvaluators();
+    std::shared_lock<std::shared_mutex> lock(mu_);
     auto node_kind = n->kind();
     auto iter = evaluator_lut_.find(node_kind);
     if (iter == evaluator_lut_.end()) {
       return nullptr;
     }
-    auto eval_reg = iter->second;
+    // Looked up for every node during support checks, partitioning and conversion, so the registration is not copied
+    auto& eval_reg = iter->second;
     if (eval_reg.options.use()) {
       for (auto o : n->outputs()) {
         if (eval_reg.options.blacklisted_output_types.find(o->type()) !=
@@ -80,6 +80,8 @@ class NodeEvaluatorRegistry {
   }
 
   std::vector<std::string> GetRegisteredEvaluatorList() {
+    RegisterPendingEvaluators();
+    std::shared_lock<std::shared_mutex> lock(mu_);
     std::vector<std::string> evaluator_list;
     std::copy(
         registered_evaluator_schemas_.begin(), registered_evaluator_schemas_.end(), std::back_inserter(evaluator_list));
@@ -96,8 +98,44 @@ class NodeEvaluatorRegistry {
   }
 
  private:
+  // Called with mu_ held exclusively
+  void AddEvaluator(torch::jit::NodeKind node_kind, EvalRegistration eval_reg) {
+    LOG_DEBUG("Registering evaluator for " << node_kind.toQualString());
+    auto iter = evaluator_lut_.find(node_kind);
+    if (iter != evaluator_lut_.end()) {
+      TORCHTRT_THROW_ERROR(
+          "Attempting to override already registered evaluator " << node_kind.toQualString()
+                                                                 << ", merge implementations instead");
+    }
+    for (auto const& e : eval_reg.options.supported_variants) {
+      registered_evaluator_schemas_.insert(e);
+    }
+    evaluator_lut_[node_kind] = std::move(eval_reg);
+  }
+
+  void RegisterPendingEvaluators() {
+    if (!has_pending_) {
+      return;
+    }
+    std::unique_lock<std::shared_mutex> lock(mu_);
+    auto evaluators = std::move(pending_evaluators_);
+    pending_evaluators_.clear();
+    has_pending_ = false;
+    for (auto& eval_reg : evaluators) {
+      for (const auto& s : eval_reg.options.supported_variants) {
+        eval_reg.options.valid_schemas.push_back(torch::jit::parseSchema(s).operator_name());
+      }
+      auto node_kind = eval_reg.kind;
+      AddEvaluator(node_kind, std::move(eval_reg));
+    }
+  }
+
+  // Looked up concurrently by compilations, registrations take the lock exclusively
+  std::shared_mutex mu_;
   EvaluatorLUT evaluator_lut_;
   std::set<std::string> registered_evaluator_schemas_;
+  std::vector<EvalRegistration> pending_evaluators_;
+  std::atomic<bool> has_pending_{false};
 };
 
 NodeEvaluatorRegistry& get_evaluator_registry() {
@@ -119,12 +157,8 @@ c10::optional<torch::jit::IValue> EvalNode(ConversionCtx* ctx, const torch::jit:
   return evaluator(ctx, n, args);
 }
 
-void register_node_evaluator(torch::jit::NodeKind node_kind, EvalRegistration eval_reg) {
-  get_evaluator_registry().RegisterEvaluator(node_kind, std::move(eval_reg));
-}
-
 void register_node_evaluator(EvalRegistration r) {
-  register_node_evaluator(r.kind, std::move(r));
+  get_evaluator_registry().DeferEvaluator(std::move(r));
 }
 
 RegisterNodeEvaluators&& RegisterNodeEvaluators::evaluator(EvalRegistration r) && {
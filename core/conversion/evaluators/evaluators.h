@@ -40,6 +40,7 @@ typedef std::function<c10::optional<torch::jit::IValue>(ConversionCtx*, const to
 
 struct EvalOptions {
   std::set<c10::TypePtr> blacklisted_output_types;
+  // Parsed from supported_variants by the registry once an evaluator is looked up, not when the library loads
   std::vector<c10::OperatorName> valid_schemas;
   std::vector<std::string> supported_variants;
   EvalOptions() = default;
@@ -51,9 +52,6 @@ struct EvalOptions {
   EvalOptions& validSchemas(std::set<std::string> schemas) {
     std::copy(schemas.begin(), schemas.end(), std::back_inserter(supported_variants));
     use_options = true;
-    for (auto s : schemas) {
-      valid_schemas.push_back(torch::jit::parseSchema(s).operator_name());
-    }
     return *this;
   }
   bool use() {
@@ -0,0 +1,436 @@
+#include "core/engine_lint.h"
+
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace {
+
+// Minimum number of connected layers computing shape tensors on the host flagged as a shape subgraph
+constexpr size_t SHAPE_SUBGRAPH_MIN_LAYERS = 4;
+
+struct JsonValue {
+  enum class Type { kScalar, kString, kObject, kArray };
+  Type type = Type::kScalar;
+  // Strings and the text of numbers and literals
+  std::string str;
+  std::vector<std::pair<std::string, JsonValue>> members;
+  std::vector<JsonValue> elements;
+
+  const JsonValue* find(const std::string& key) const {
+    for (const auto& m : members) {
+      if (m.first == key) {
+        return &m.second;
+      }
+    }
+    return nullptr;
+  }
+};
+
+// Parser for the JSON the engine inspector produces
+class JsonParser {
+ public:
+  explicit JsonParser(const std::string& json) : json(json) {}
+
+  JsonValue parse() {
+    auto v = parse_value();
+    skip_space();
+    TORCHTRT_CHECK(pos == json.size(), "Unexpected character at offset " << pos << " of the engine layer information");
+    return v;
+  }
+
+ private:
+  void skip_space() {
+    while (pos < json.size() && std::isspace(static_cast<unsigned char>(json[pos]))) {
+      pos++;
+    }
+  }
+
+  void expect(char c) {
+    skip_space();
+    TORCHTRT_CHECK(
+        pos < json.size() && json[pos] == c,
+        "Expected '" << c << "' at offset " << pos << " of the engine layer information");
+    pos++;
+  }
+
+  bool consume(char c) {
+    skip_space();
+    if (pos < json.size() && json[pos] == c) {
+      pos++;
+      return true;
+    }
+    return false;
+  }
+
+  std::string parse_string() {
+    expect('"');
+    std::string s;
+    while (pos < json.size() && json[pos] != '"') {
+      auto c = json[pos++];
+      if (c != '\\') {
+        s.push_back(c);
+        continue;
+      }
+      TORCHTRT_CHECK(pos < json.size(), "Truncated escape sequence in the engine layer information");
+      c = json[pos++];
+      switch (c) {
+        case 'b':
+          s.push_back('\b');
+          break;
+        case 'f':
+          s.push_back('\f');
+          break;
+        case 'n':
+          s.push_back('\n');
+          break;
+        case 'r':
+          s.push_back('\r');
+          break;
+        case 't':
+          s.push_back('\t');
+          break;
+        case 'u': {
+          TORCHTRT_CHECK(pos + 4 <= json.size(), "Truncated escape sequence in the engine layer information");
+          auto code = std::stoul(json.substr(pos, 4), nullptr, 16);
+          pos += 4;
+          // UTF-8 encoding of the code point, surrogate pairs are not expected in layer names
+          if (code < 0x80) {
+            s.push_back(static_cast<char>(code));
+          } else if (code < 0x800) {
+            s.push_back(static_cast<char>(0xC0 | (code >> 6)));
+            s.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+          } else {
+            s.push_back(static_cast<char>(0xE0 | (code >> 12)));
+            s.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            s.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+          }
+          break;
+        }
+        default:
+          s.push_back(c);
+      }
+    }
+    expect('"');
+    return s;
+  }
+
+  JsonValue parse_value() {
+    skip_space();
+    TORCHTRT_CHECK(pos < json.size(), "Truncated engine layer information");
+    JsonValue v;
+    if (json[pos] == '"') {
+      v.type = JsonValue::Type::kString;
+      v.str = parse_string();
+    } else if (consume('{')) {
+      v.type = JsonValue::Type::kObject;
+      if (!consume('}')) {
+        do {
+          auto key = parse_string();
+          expect(':');
+          v.members.emplace_back(std::move(key), parse_value());
+        } while (consume(','));
+        expect('}');
+      }
+    } else if (consume('[')) {
+      v.type = JsonValue::Type::kArray;
+      if (!consume(']')) {
+        do {
+          v.elements.push_back(parse_value());
+        } while (consume(','));
+        expect(']');
+      }
+    } else {
+      auto start = pos;
+      while (pos < json.size() && json[pos] != ',' && json[pos] != '}' && json[pos] != ']' &&
+             !std::isspace(static_cast<unsigned char>(json[pos]))) {
+        pos++;
+      }
+      TORCHTRT_CHECK(pos > start, "Unexpected character at offset " << pos << " of the engine layer information");
+      v.str = json.substr(start, pos - start);
+    }
+    return v;
+  }
+
+  const std::string& json;
+  size_t pos = 0;
+};
+
+std::vector<EngineLayerIO> parse_layer_io(const JsonValue* tensors) {
+  std::vector<EngineLayerIO> io;
+  if (!tensors || tensors->type != JsonValue::Type::kArray) {
+    return io;
+  }
+  for (const auto& t : tensors->elements) {
+    EngineLayerIO tensor;
+    if (auto name = t.find("Name")) {
+      tensor.name = name->str;
+    }
+    if (auto location = t.find("Location")) {
+      tensor.location = location->str;
+    }
+    if (auto format = t.find("Format/Datatype")) {
+      tensor.format = format->str;
+    }
+    io.push_back(std::move(tensor));
+  }
+  return io;
+}
+
+bool contains(const std::string& s, const std::string& part) {
+  return s.find(part) != std::string::npos;
+}
+
+// TensorRT layer types (as reported by the inspector) of the fusable pointwise operations
+bool is_pointwise(const std::string& type) {
+  return type == "ElementWise" || type == "PointWise" || type == "PointWiseV2" || type == "Activation" ||
+      type == "Unary" || type == "Scale";
+}
+
+bool is_reformat(const EngineLayer& layer, const std::string& type) {
+  auto name = layer.fields.find("Name");
+  return type == "Reformat" || contains(type, "Copy") ||
+      (name != layer.fields.end() && contains(name->second, "Reformatting CopyNode"));
+}
+
+bool is_shape_layer(const EngineLayer& layer, const std::string& type) {
+  if (contains(type, "Shape")) {
+    return true;
+  }
+  return !layer.outputs.empty() && std::all_of(layer.outputs.begin(), layer.outputs.end(), [](const auto& o) {
+    return o.location == "Host";
+  });
+}
+
+// Layers whose precision follows their inputs or which do not compute, an FP32 output of theirs is not their doing
+bool moves_data(const std::string& type) {
+  return type == "Constant" || type == "NoOp" || type == "Shuffle" || type == "Slice" || type == "Concatenation" ||
+      type == "Gather" || contains(type, "Plugin");
+}
+
+bool computes_in_fp32(const EngineLayer& layer) {
+  return std::any_of(layer.outputs.begin(), layer.outputs.end(), [](const auto& o) {
+    return contains(o.format, "FP32") || contains(o.format, "Float");
+  });
+}
+
+std::string field(const EngineLayer& layer, const std::string& key) {
+  auto it = layer.fields.find(key);
+  return it == layer.fields.end() ? "" : it->second;
+}
+
+// TorchScript nodes a layer was converted from. Fused layers join the metadata of their layers with a record
+// separator, engines without layer metadata fall back to the layer name which for fused layers is "<a> + <b>"
+std::vector<std::string> source_nodes(const EngineLayer& layer) {
+  auto metadata = field(layer, "Metadata");
+  std::string separator = "\x1E";
+  if (metadata.empty()) {
+    metadata = field(layer, "Name");
+    separator = " + ";
+  }
+  std::vector<std::string> nodes;
+  size_t start = 0;
+  while (start <= metadata.size()) {
+    auto end = metadata.find(separator, start);
+    if (end == std::string::npos) {
+      end = metadata.size();
+    }
+    auto node = metadata.substr(start, end - start);
+    if (!node.empty() && std::find(nodes.begin(), nodes.end(), node) == nodes.end()) {
+      nodes.push_back(node);
+    }
+    start = end + separator.size();
+  }
+  return nodes;
+}
+
+void add_nodes(EngineLintFinding& finding, const std::vector<std::string>& nodes) {
+  for (const auto& n : nodes) {
+    if (std::find(finding.nodes.begin(), finding.nodes.end(), n) == finding.nodes.end()) {
+      finding.nodes.push_back(n);
+    }
+  }
+}
+
+class EngineLinter {
+ public:
+  EngineLinter(
+      std::string engine,
+      std::vector<EngineLayer> layers,
+      std::map<std::string, runtime::TRTEngineProfiler::Record> times,
+      bool half_enabled)
+      : engine(std::move(engine)), layers(std::move(layers)), times(std::move(times)), half_enabled(half_enabled) {
+    for (size_t i = 0; i < this->layers.size(); i++) {
+      types.push_back(field(this->layers[i], "LayerType"));
+      for (const auto& o : this->layers[i].outputs) {
+        producers[o.name] = i;
+      }
+    }
+  }
+
+  std::vector<EngineLintFinding> lint() {
+    std::vector<EngineLintFinding> findings;
+    for (size_t i = 0; i < layers.size(); i++) {
+      const auto& layer = layers[i];
+      const auto& type = types[i];
+      if (is_reformat(layer, type)) {
+        findings.push_back(reformat_finding(i));
+      } else if (contains(type, "Plugin")) {
+        auto f = make_finding("plugin", {i});
+        f.message = "Runs a plugin (" + type + "), which TensorRT never fuses with the layers around it";
+        findings.push_back(std::move(f));
+      } else if (half_enabled && !moves_data(type) && !is_shape_layer(layer, type) && computes_in_fp32(layer)) {
+        auto f = make_finding("fp32_layer", {i});
+        f.message = "Computes in FP32 although FP16 is enabled, outputs " + layer.outputs[0].format;
+        findings.push_back(std::move(f));
+      }
+    }
+
+    for (auto& group : connected_groups([&](size_t i) { return is_pointwise(types[i]); })) {
+      if (group.size() >= 2) {
+        auto f = make_finding("unfused_elementwise", group);
+        f.message = "Chain of " + std::to_string(group.size()) + " elementwise layers TensorRT did not fuse";
+        findings.push_back(std::move(f));
+      }
+    }
+    for (auto& group : connected_groups([&](size_t i) { return is_shape_layer(layers[i], types[i]); })) {
+      if (group.size() >= SHAPE_SUBGRAPH_MIN_LAYERS) {
+        auto f = make_finding("shape_subgraph", group);
+        f.message = std::to_string(group.size()) +
+            " layers compute shape tensors on the host, which synchronizes every execution with the host";
+        findings.push_back(std::move(f));
+      }
+    }
+    return findings;
+  }
+
+ private:
+  EngineLintFinding make_finding(const std::string& kind, const std::vector<size_t>& group) {
+    EngineLintFinding f;
+    f.engine = engine;
+    f.kind = kind;
+    for (auto i : group) {
+      auto name = field(layers[i], "Name");
+      f.layers.push_back(name);
+      add_nodes(f, source_nodes(layers[i]));
+      auto t = times.find(name);
+      if (t != times.end() && t->second.count > 0) {
+        f.time_ms = std::max(f.time_ms, 0.0) + t->second.time / t->second.count;
+      }
+    }
+    return f;
+  }
+
+  EngineLintFinding reformat_finding(size_t i) {
+    const auto& layer = layers[i];
+    EngineLintFinding f = make_finding("reformat", {i});
+    // Reformats are inserted by TensorRT and have no node of their own, they are attributed to the layer whose output
+    // they reformat
+    f.nodes.clear();
+    if (!layer.inputs.empty()) {
+      auto producer = producers.find(layer.inputs[0].name);
+      if (producer != producers.end()) {
+        add_nodes(f, source_nodes(layers[producer->second]));
+      }
+    }
+    f.message = "Copies or reformats " + (layer.inputs.empty() ? std::string("a tensor") : layer.inputs[0].name);
+    if (!layer.inputs.empty() && !layer.outputs.empty()) {
+      f.message += " from " + layer.inputs[0].format + " to " + layer.outputs[0].format;
+    }
+    return f;
+  }
+
+  // Groups of layers selected by pred connected through the tensors they produce for each other. Layers of the
+  // inspector are in execution order so producers are always visited before their consumers
+  template <typename F>
+  std::vector<std::vector<size_t>> connected_groups(F pred) {
+    std::vector<int64_t> group_of(layers.size(), -1);
+    std::vector<std::vector<size_t>> groups;
+    for (size_t i = 0; i < layers.size(); i++) {
+      if (!pred(i)) {
+        continue;
+      }
+      for (const auto& in : layers[i].inputs) {
+        auto producer = producers.find(in.name);
+        if (producer != producers.end() && producer->second < i && group_of[producer->second] >= 0) {
+          group_of[i] = group_of[producer->second];
+          break;
+        }
+      }
+      if (group_of[i] < 0) {
+        group_of[i] = groups.size();
+        groups.emplace_back();
+      }
+      groups[group_of[i]].push_back(i);
+    }
+    return groups;
+  }
+
+  std::string engine;
+  std::vector<EngineLayer> layers;
+  std::vector<std::string> types;
+  std::map<std::string, runtime::TRTEngineProfiler::Record> times;
+  std::map<std::string, size_t> producers;
+  bool half_enabled;
+};
+
+} // namespace
+
+std::vector<EngineLayer> ParseEngineLayers(const std::string& json) {
+  auto root = JsonParser(json).parse();
+  std::vector<EngineLayer> layers;
+  auto entries = root.find("Layers");
+  if (!entries || entries->type != JsonValue::Type::kArray) {
+    return layers;
+  }
+  for (const auto& entry : entries->elements) {
+    EngineLayer layer;
+    if (entry.type == JsonValue::Type::kString) {
+      layer.fields["Name"] = entry.str;
+    } else {
+      for (const auto& m : entry.members) {
+        if (m.second.type == JsonValue::Type::kString) {
+          layer.fields[m.first] = m.second.str;
+        }
+      }
+      layer.inputs = parse_layer_io(entry.find("Inputs"));
+      layer.outputs = parse_layer_io(entry.find("Outputs"));
+    }
+    layers.push_back(std::move(layer));
+  }
+  return layers;
+}
+
+std::vector<EngineLintFinding> LintEngines(const torch::jit::Module& compiled_mod, bool half_enabled) {
+  std::vector<EngineLintFinding> findings;
+  for (auto& engine : runtime::collect_engines(compiled_mod)) {
+    auto layers = ParseEngineLayers(engine->get_engine_layer_info());
+    if (std::none_of(layers.begin(), layers.end(), [](const auto& l) { return l.fields.count("LayerType"); })) {
+      LOG_WARNING(
+          "Engine " << engine->name << " only records the names of its layers, build it with detailed_layer_info "
+                    << "enabled to lint it");
+      continue;
+    }
+    std::map<std::string, runtime::TRTEngineProfiler::Record> times;
+    {
+      std::lock_guard<std::mutex> lock(engine->profiling_mu);
+      if (engine->trt_engine_profiler) {
+        times = engine->trt_engine_profiler->get_layer_times();
+      }
+    }
+    auto engine_findings = EngineLinter(engine->name, std::move(layers), std::move(times), half_enabled).lint();
+    LOG_DEBUG("Found " << engine_findings.size() << " performance problems in engine " << engine->name);
+    findings.insert(findings.end(), engine_findings.begin(), engine_findings.end());
+  }
+  std::stable_sort(
+      findings.begin(), findings.end(), [](const auto& a, const auto& b) { return a.time_ms > b.time_ms; });
+  return findings;
+}
+
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "torch/csrc/jit/api/module.h"
+
+namespace torch_tensorrt {
+namespace core {
+
+// Input or output tensor of a layer as reported by the engine inspector
+struct EngineLayerIO {
+  std::string name;
+  // "Device" or "Host"
+  std::string location;
+  // e.g. "Row major linear FP32"
+  std::string format;
+};
+
+// Layer of the JSON the engine inspector produces, which has the form
+// {"Layers": [{"Name": ..., "LayerType": ..., "Inputs": [{...}], "Outputs": [{...}], ...}, ...], "Bindings": [...]}.
+// Engines built without detailed profiling verbosity only record the names of their layers
+struct EngineLayer {
+  // String valued keys of the layer, e.g. Name, LayerType, TacticName and Metadata
+  std::map<std::string, std::string> fields;
+  std::vector<EngineLayerIO> inputs;
+  std::vector<EngineLayerIO> outputs;
+};
+
+std::vector<EngineLayer> ParseEngineLayers(const std::string& json);
+
+// Performance problem found in the layers of an engine
+struct EngineLintFinding {
+  std::string engine;
+  // "reformat", "fp32_layer", "unfused_elementwise", "shape_subgraph" or "plugin"
+  std::string kind;
+  std::vector<std::string> layers;
+  std::string message;
+  // TorchScript nodes the layers were converted from (util::node_info), recorded as layer metadata at conversion
+  std::vector<std::string> nodes;
+  // Average time of the layers per execution from the engine profiler, -1 if the engine was not profiled
+  double time_ms = -1;
+};
+
+// Checks the layers of the engines in compiled_mod for reformats and copies, FP32 layers (flagged if half_enabled),
+// chains of elementwise layers TensorRT did not fuse, subgraphs computing shape tensors on the host and plugins.
+// Layers of engines built without detailed_layer_info cannot be checked. Findings of profiled engines are sorted by
+// time, slowest first
+std::vector<EngineLintFinding> LintEngines(const torch::jit::Module& compiled_mod, bool half_enabled);
+
+} // namespace core
+} // namespace torch_tensorrt
@@ -31,11 +31,14 @@ bool valid_dtype_format_combo(nvinfer1::DataType dtype, nvinfer1::TensorFormat f
         default:
           return false;
       }
-    case nvinfer1::DataType::kHALF: // Supports just Linear (NCHW)
+    case nvinfer1::DataType::kHALF: // Supports Linear (NCHW), channel last (NHWC) and channel last padded to 8 or 16
       switch (format) {
         case nvinfer1::TensorFormat::kLINEAR:
-          return true;
         case nvinfer1::TensorFormat::kHWC:
+        case nvinfer1::TensorFormat::kHWC8:
+        case nvinfer1::TensorFormat::kHWC16:
+        case nvinfer1::TensorFormat::kDHWC8:
+          return true;
         default:
           return false;
       }
@@ -48,6 +51,7 @@ bool valid_dtype_format_combo(nvinfer1::DataType dtype, nvinfer1::TensorFormat f
         default:
           return false;
       }
+    case nvinfer1::DataType::kBF16: // Supports Linear (NCHW)
     case nvinfer1::DataType::kBOOL: // Supports Linear (NCHW)
       switch (format) {
         case nvinfer1::TensorFormat::kLINEAR:
@@ -68,6 +72,8 @@ bool valid_input_dtype(nvinfer1::DataType dtype) {
       return true;
     case nvinfer1::DataType::kHALF:
       return true;
+    case nvinfer1::DataType::kBF16:
+      return true;
     case nvinfer1::DataType::kINT8:
       return true;
     case nvinfer1::DataType::kINT32:
@@ -105,7 +111,7 @@ Input::Input(
       valid_dtype_format_combo(util::ScalarTypeToTRTDataType(dtype), format),
       "Unsupported combination of dtype and tensor format: ("
           << dtype << ", " << format
-          << "), Torch-TensorRT only supports contiguous format (NCHW) except with input type Float32 where channel last (NHWC) is also supported");
+          << "), Torch-TensorRT supports contiguous format (NCHW) for every type, channel last (NHWC) for Float32 and Float16 and the padded channel last formats (HWC8, HWC16, DHWC8) for Float16");
   this->format = format;
   this->dtype_is_user_defined = dtype_is_user_defined;
 
@@ -164,7 +170,7 @@ Input::Input(
       valid_dtype_format_combo(util::ScalarTypeToTRTDataType(dtype), format),
       "Unsupported combination of dtype and tensor format: ("
           << dtype << ", " << format
-          << "), Torch-TensorRT only supports contiguous format (NCHW) except with input type Float32 where channel last (NHWC) is also supported");
+          << "), Torch-TensorRT supports contiguous format (NCHW) for every type, channel last (NHWC) for Float32 and Float16 and the padded channel last formats (HWC8, HWC16, DHWC8) for Float16");
   this->format = format;
   this->dtype_is_user_defined = dtype_is_user_defined;
   TORCHTRT_CHECK(
@@ -173,12 +179,48 @@ Input::Input(
   this->tensor_domain = tensor_domain;
 }
 
+void Input::add_profile(
+    std::vector<int64_t> min_shape,
+    std::vector<int64_t> opt_shape,
+    std::vector<int64_t> max_shape) {
+  TORCHTRT_CHECK(
+      static_cast<int64_t>(min_shape.size()) == input_shape.nbDims &&
+          static_cast<int64_t>(opt_shape.size()) == input_shape.nbDims &&
+          static_cast<int64_t>(max_shape.size()) == input_shape.nbDims,
+      "Expected all optimization profiles of an input to have the same number of dimensions ("
+          << input_shape.nbDims << "), but found dimensions: min(" << min_shape.size() << "), opt("
+          << opt_shape.size() << "), max(" << max_shape.size() << ")");
+
+  for (int64_t i = 0; i < input_shape.nbDims; i++) {
+    if (input_shape.d[i] != min_shape[i] || input_shape.d[i] != opt_shape[i] || input_shape.d[i] != max_shape[i]) {
+      input_shape.d[i] = -1;
+      input_is_dynamic = true;
+    }
+  }
+  additional_profiles.push_back({util::toDims(min_shape), util::toDims(opt_shape), util::toDims(max_shape)});
+}
+
+size_t Input::num_profiles() const {
+  return 1 + additional_profiles.size();
+}
+
+InputProfile Input::profile(size_t i) const {
+  if (i == 0) {
+    return {min, opt, max};
+  }
+  return additional_profiles.at(i - 1);
+}
+
 std::ostream& operator<<(std::ostream& os, const Input& input) {
   if (!input.input_is_dynamic) {
     os << "Input(shape: " << input.input_shape << ", dtype: " << input.dtype << ", format: " << input.format << ')';
   } else {
     os << "Input(shape: " << input.input_shape << ", min: " << input.min << ", opt: " << input.opt
-       << ", max: " << input.max << ", dtype: " << input.dtype << ", format: " << input.format << ')';
+       << ", max: " << input.max;
+    for (auto& p : input.additional_profiles) {
+      os << ", profile: (" << p.min << ", " << p.opt << ", " << p.max << ')';
+    }
+    os << ", dtype: " << input.dtype << ", format: " << input.format << ')';
   }
   return os;
 }
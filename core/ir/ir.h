@@ -25,6 +25,13 @@ struct Device {
   Device() : device_type(nvinfer1::DeviceType::kGPU), gpu_id(0), dla_core(0), allow_gpu_fallback(false) {}
 };
 
+// Shape range of one optimization profile of an input
+struct InputProfile {
+  nvinfer1::Dims min;
+  nvinfer1::Dims opt;
+  nvinfer1::Dims max;
+};
+
 struct Input : torch::CustomClassHolder {
   Input(){};
   Input(
@@ -42,6 +49,14 @@ struct Input : torch::CustomClassHolder {
       bool dtype_is_user_defined = false,
       std::vector<double> tensor_domain = std::vector<double>{0, 2});
 
+  // Adds an optimization profile on top of the min / opt / max range (profile 0), dimensions which vary between
+  // profiles become dynamic in input_shape
+  void add_profile(std::vector<int64_t> min_shape, std::vector<int64_t> opt_shape, std::vector<int64_t> max_shape);
+  // Number of optimization profiles described by this input
+  size_t num_profiles() const;
+  // Range of profile i, 0 is the min / opt / max range
+  InputProfile profile(size_t i) const;
+
   friend std::ostream& operator<<(std::ostream& os, const Input& input);
 
   bool input_is_dynamic = false;
@@ -54,6 +69,7 @@ struct Input : torch::CustomClassHolder {
   at::ScalarType dtype;
   nvinfer1::TensorFormat format;
   int id;
+  std::vector<InputProfile> additional_profiles;
 };
 
 // Add to spec
@@ -85,6 +101,8 @@ CollectionInputSpecMap associate_specs_with_collection_inputs(
     ir::GraphInputs graph_inputs,
     StaticParams& static_params);
 InputSpecMap pair_input_vals_with_specs(std::vector<const torch::jit::Value*> vals, std::vector<Input> specs);
+// Whether TensorRT supports binding tensors of dtype in format
+bool valid_dtype_format_combo(nvinfer1::DataType dtype, nvinfer1::TensorFormat format);
 CollectionInputSpecMap pair_input_vals_with_specs_collection(
     std::vector<const torch::jit::Value*> vals,
     std::vector<std::vector<Input>>& specs);
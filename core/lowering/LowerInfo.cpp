@@ -14,7 +14,9 @@ std::ostream& operator<<(std::ostream& os, const LowerInfo& l) {
   for (auto i : l.forced_fallback_modules) {
     os << "      " << i << std::endl;
   }
-  os << "    ]";
+  os << "    ]" << std::endl;
+  os << "    Max Unroll Trip Count: " << l.max_unroll_trip_count << std::endl;
+  os << "    Max Unroll Body Size: " << l.max_unroll_body_size;
   return os;
 }
 
@@ -0,0 +1,160 @@
+#include <unordered_map>
+
+#include "torch/csrc/jit/ir/ir.h"
+#include "torch/csrc/jit/passes/constant_propagation.h"
+#include "torch/csrc/jit/passes/dead_code_elimination.h"
+#include "torch/csrc/jit/passes/symbolic_shape_analysis.h"
+
+#include "core/lowering/lowering.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace lowering {
+namespace {
+
+std::vector<torch::jit::Node*> collect_nodes(torch::jit::Block* b) {
+  std::vector<torch::jit::Node*> nodes;
+  for (auto n : b->nodes()) {
+    nodes.push_back(n);
+    for (auto sub : n->blocks()) {
+      auto sub_nodes = collect_nodes(sub);
+      nodes.insert(nodes.end(), sub_nodes.begin(), sub_nodes.end());
+    }
+  }
+  return nodes;
+}
+
+c10::optional<std::vector<c10::ShapeSymbol>> symbolic_sizes(torch::jit::Value* v) {
+  auto type = v->type()->cast<c10::TensorType>();
+  if (!type) {
+    return {};
+  }
+  auto sizes = type->symbolic_sizes().sizes();
+  if (!sizes) {
+    return {};
+  }
+  return sizes;
+}
+
+} // namespace
+
+int FoldStaticShapes(std::shared_ptr<torch::jit::Graph>& g, const ir::CollectionInputSpecMap& input_specs) {
+  auto nodes = collect_nodes(g->block());
+
+  // Shape propagation annotates the graph with symbolic shapes, the original types are put back once the shape
+  // queries are resolved
+  std::unordered_map<torch::jit::Value*, c10::TypePtr> original_types;
+  for (auto in : g->inputs()) {
+    original_types[in] = in->type();
+  }
+  for (auto n : nodes) {
+    for (auto out : n->outputs()) {
+      original_types[out] = out->type();
+    }
+  }
+
+  // Dims which are the same in every profile of an input are constants, the others get a symbol of their own
+  bool any_input = false;
+  for (auto in : g->inputs()) {
+    auto spec = input_specs.find(in);
+    if (spec == input_specs.end() || spec->second.size() != 1 || !in->type()->isSubtypeOf(c10::TensorType::get())) {
+      continue;
+    }
+    auto& shape = spec->second[0].input_shape;
+    std::vector<c10::optional<int64_t>> dims;
+    for (int i = 0; i < shape.nbDims; i++) {
+      dims.push_back(shape.d[i] == -1 ? c10::nullopt : c10::optional<int64_t>(shape.d[i]));
+    }
+    in->setType(c10::TensorType::get()->withSymbolicShapes(c10::SymbolicShape(dims)));
+    any_input = true;
+  }
+  if (!any_input) {
+    return 0;
+  }
+  torch::jit::PropagateShapesOnGraph(g);
+
+  // Queries answered by a constant, or by an earlier query of the same symbolic dim
+  std::vector<std::pair<torch::jit::Node*, c10::IValue>> constants;
+  std::vector<std::pair<torch::jit::Node*, torch::jit::Value*>> duplicates;
+  std::unordered_map<int64_t, torch::jit::Value*> symbol_queries;
+  for (auto n : nodes) {
+    if (n->kind() != torch::jit::aten::size && n->kind() != torch::jit::aten::dim) {
+      continue;
+    }
+    auto sizes = symbolic_sizes(n->input(0));
+    if (!sizes) {
+      continue;
+    }
+    auto rank = static_cast<int64_t>(sizes->size());
+    if (n->kind() == torch::jit::aten::dim) {
+      constants.push_back({n, rank});
+    } else if (n->inputs().size() == 1) {
+      std::vector<int64_t> static_sizes;
+      for (auto& s : *sizes) {
+        if (!s.is_static()) {
+          break;
+        }
+        static_sizes.push_back(s.static_size());
+      }
+      if (static_cast<int64_t>(static_sizes.size()) == rank) {
+        constants.push_back({n, c10::IValue(static_sizes)});
+      }
+    } else {
+      auto dim_ivalue = torch::jit::toIValue(n->input(1));
+      if (!dim_ivalue || !dim_ivalue->isInt()) {
+        continue;
+      }
+      auto dim = dim_ivalue->toInt();
+      dim = dim < 0 ? dim + rank : dim;
+      if (dim < 0 || dim >= rank) {
+        continue;
+      }
+      auto& s = (*sizes)[dim];
+      if (s.is_static()) {
+        constants.push_back({n, s.static_size()});
+        continue;
+      }
+      auto query = symbol_queries.find(s.value());
+      if (query != symbol_queries.end()) {
+        duplicates.push_back({n, query->second});
+      } else if (n->owningBlock() == g->block()) {
+        // Only queries of the top level block dominate every later one
+        symbol_queries[s.value()] = n->output();
+      }
+    }
+  }
+
+  for (auto& t : original_types) {
+    t.first->setType(t.second);
+  }
+
+  for (auto& c : constants) {
+    torch::jit::WithInsertPoint guard(c.first);
+    auto constant = g->insertConstant(c.second);
+    LOG_GRAPH("Folding " << util::node_info(c.first) << " to " << c.second);
+    c.first->output()->replaceAllUsesWith(constant);
+    c.first->destroy();
+  }
+  for (auto& d : duplicates) {
+    LOG_GRAPH("Replacing " << util::node_info(d.first) << " with the same dim queried by %" << d.second->debugName());
+    d.first->output()->replaceAllUsesWith(d.second);
+    d.first->destroy();
+  }
+
+  auto num_folded = static_cast<int>(constants.size() + duplicates.size());
+  if (num_folded > 0) {
+    // Collapses the shape arithmetic on the folded dims
+    torch::jit::ConstantPropagationImmutableTypes(g);
+    torch::jit::EliminateDeadCode(g);
+    LOG_DEBUG(
+        "Resolved " << constants.size() << " shape queries to constants and merged " << duplicates.size()
+                    << " queries of the same dynamic dim");
+    LOG_GRAPH("Graph after folding static shapes: " << *g);
+  }
+  return num_folded;
+}
+
+} // namespace lowering
+} // namespace core
+} // namespace torch_tensorrt
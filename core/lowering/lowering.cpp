@@ -96,67 +96,97 @@ int AutocastLongInputs(
   return num_autocasts;
 }
 
+// Records a lowering pass as its own compile phase, so the passes slowing down the lowering of a graph show up in the
+// compile profile
+#define LOWERING_PASS(name, ...)               \
+  {                                            \
+    TORCHTRT_COMPILE_PHASE("lowering/" name); \
+    __VA_ARGS__;                               \
+  }
+
 void LowerGraph(std::shared_ptr<torch::jit::Graph>& g, std::vector<torch::jit::IValue>& params, LowerInfo lower_info) {
-  torch::jit::EliminateRedundantGuards(g);
-  torch::jit::RemoveListMutation(g);
-  torch::jit::RemoveTensorMutation(g);
-  torch::jit::CreateFunctionalGraphs(g);
-  torch::jit::InlineFunctionalGraphs(g);
-  torch::jit::PeepholeOptimize(g, false);
-  torch::jit::FuseLinear(g);
-  passes::EliminateExceptionsSafe(g);
+  LOWERING_PASS("EliminateRedundantGuards", torch::jit::EliminateRedundantGuards(g));
+  LOWERING_PASS("RemoveListMutation", torch::jit::RemoveListMutation(g));
+  LOWERING_PASS("RemoveTensorMutation", torch::jit::RemoveTensorMutation(g));
+  LOWERING_PASS("CreateFunctionalGraphs", torch::jit::CreateFunctionalGraphs(g));
+  LOWERING_PASS("InlineFunctionalGraphs", torch::jit::InlineFunctionalGraphs(g));
+  LOWERING_PASS("PeepholeOptimize", torch::jit::PeepholeOptimize(g, false));
+  LOWERING_PASS("FuseLinear", torch::jit::FuseLinear(g));
+  LOWERING_PASS("RemoveIntermediateCollections", passes::RemoveIntermediateCollections(g));
+  LOWERING_PASS("EliminateExceptionsSafe", passes::EliminateExceptionsSafe(g));
   if (!lower_info.disable_cse) {
-    torch::jit::EliminateCommonSubexpression(g);
+    LOWERING_PASS("EliminateCommonSubexpression", torch::jit::EliminateCommonSubexpression(g));
   }
-  torch::jit::EliminateDeadCode(g);
+  LOWERING_PASS("EliminateDeadCode", torch::jit::EliminateDeadCode(g));
   if (lower_info.forced_fallback_modules.size() > 0) {
-    passes::MarkNodesForFallback(g, true);
+    LOWERING_PASS("MarkNodesForFallback", passes::MarkNodesForFallback(g, true));
   }
-  passes::UnpackHardSwish(g);
-  passes::UnpackHardSigmoid(g);
-  passes::EliminateExceptionOrPassPattern(g);
-  passes::ReduceToOperation(g);
-  passes::ReduceGelu(g);
-  passes::ReduceRemainder(g);
-  passes::RemoveContiguous(g);
-  passes::ViewToReshape(g);
-  passes::RemoveDropout(g);
-  passes::LinearToAddMM(g);
-  passes::Conv1DToConvolution(g);
-  passes::ConvTransposed1DToConvolution(g);
-  passes::Conv2DToConvolution(g);
-  passes::ConvTransposed2DToConvolution(g);
-  passes::Conv3DToConvolution(g);
-  passes::ConvTransposed3DToConvolution(g);
-  passes::FuseAddMMBranches(g);
-  passes::RemoveBNDimCheck(g);
-  // torch::jit::UnrollLoops(g);
-  passes::UnpackAddMM(g);
+  LOWERING_PASS("EliminateExceptionOrPassPattern", passes::EliminateExceptionOrPassPattern(g));
+  {
+    // The pattern-based passes which do not depend on the passes around them, matched together. Each one records
+    // its own compile phase
+    passes::PatternRewriter rewriter;
+    passes::AddUnpackHardSwishPatterns(rewriter);
+    passes::AddUnpackHardSigmoidPatterns(rewriter);
+    passes::AddReduceToOperationPatterns(rewriter);
+#if NV_TENSORRT_MAJOR < 10
+    // TensorRT 10 converts aten::gelu to its native GELU activation
+    passes::AddReduceGeluPatterns(rewriter);
+#endif
+    passes::AddReduceRemainderPatterns(rewriter);
+    passes::AddRemoveContiguousPatterns(rewriter);
+    passes::AddViewToReshapePatterns(rewriter);
+    passes::AddUnpackLogSoftmaxPatterns(rewriter);
+    passes::AddUnpackRsqrtPatterns(rewriter);
+    passes::AddAliasOperatorsPatterns(rewriter);
+    passes::AddSiluToSigmoidMultipicationPatterns(rewriter);
+    rewriter.runOnGraph(g);
+    LOG_GRAPH("Post lowering patterns: " << *g);
+  }
+  LOWERING_PASS("CoalesceShuffles", passes::CoalesceShuffles(g));
+  LOWERING_PASS("OptimizeQDQPlacement", passes::OptimizeQDQPlacement(g));
+  LOWERING_PASS("RemoveDropout", passes::RemoveDropout(g));
+  LOWERING_PASS("LinearToAddMM", passes::LinearToAddMM(g));
+  LOWERING_PASS("Conv1DToConvolution", passes::Conv1DToConvolution(g));
+  LOWERING_PASS("ConvTransposed1DToConvolution", passes::ConvTransposed1DToConvolution(g));
+  LOWERING_PASS("Conv2DToConvolution", passes::Conv2DToConvolution(g));
+  LOWERING_PASS("ConvTransposed2DToConvolution", passes::ConvTransposed2DToConvolution(g));
+  LOWERING_PASS("Conv3DToConvolution", passes::Conv3DToConvolution(g));
+  LOWERING_PASS("ConvTransposed3DToConvolution", passes::ConvTransposed3DToConvolution(g));
+  LOWERING_PASS("FuseAddMMBranches", passes::FuseAddMMBranches(g));
+  LOWERING_PASS("RemoveBNDimCheck", passes::RemoveBNDimCheck(g));
+  LOWERING_PASS(
+      "UnrollStaticLoops",
+      passes::UnrollStaticLoops(
+          g, lower_info.max_unroll_trip_count, lower_info.max_unroll_body_size, lower_info.unroll_node_supported));
+  LOWERING_PASS("UnpackAddMM", passes::UnpackAddMM(g));
   // passes::UnpackBatchNorm(g);
-  passes::UnpackLogSoftmax(g);
-  passes::UnpackRsqrt(g);
-  passes::UnpackStd(g);
-  passes::UnpackVar(g);
-  passes::RemoveNOPs(g);
-  passes::AliasOperators(g);
-  passes::SiluToSigmoidMultipication(g);
-  passes::RemoveSingleUse0DTensors(g);
-  passes::RemoveUnnecessaryCasts(g);
-  passes::UnpackScaledDotProductAttention(g);
-  passes::ReplaceAtenInt(g);
+  // aten::var and aten::std convert to a single reduction, unpacking them would reduce the input twice
+  // passes::UnpackStd(g);
+  // passes::UnpackVar(g);
+  LOWERING_PASS("RemoveNOPs", passes::RemoveNOPs(g));
+  LOWERING_PASS("RemoveSingleUse0DTensors", passes::RemoveSingleUse0DTensors(g));
+  LOWERING_PASS("RemoveUnnecessaryCasts", passes::RemoveUnnecessaryCasts(g));
+  LOWERING_PASS("FoldInputNormalization", passes::FoldInputNormalization(g));
+  LOWERING_PASS("FuseScaledDotProductAttention", passes::FuseScaledDotProductAttention(g));
+  LOWERING_PASS("UnpackScaledDotProductAttention", passes::UnpackScaledDotProductAttention(g));
+  LOWERING_PASS("ReplaceAtenInt", passes::ReplaceAtenInt(g));
   if (lower_info.converting_to_trt_engine) {
-    passes::RemoveCollectionCast(g);
+    LOWERING_PASS("RemoveCollectionCast", passes::RemoveCollectionCast(g));
   }
-  passes::UnpackAndCastMaskedFill(g, lower_info.getGPUDeviceString());
-  passes::UnpackAndCastNumToTensor(g, lower_info.getGPUDeviceString());
-  passes::UnpackAndCastFull(g, lower_info.getGPUDeviceString());
-  passes::ReplaceScalarImplicit(g);
-  passes::RewriteInputsWithParams(g, params);
-  passes::ReplaceAtenPad(g);
-  passes::ReplaceTileWithRepeat(g);
+  LOWERING_PASS("UnpackAndCastMaskedFill", passes::UnpackAndCastMaskedFill(g, lower_info.getGPUDeviceString()));
+  LOWERING_PASS("UnpackAndCastNumToTensor", passes::UnpackAndCastNumToTensor(g, lower_info.getGPUDeviceString()));
+  LOWERING_PASS("UnpackAndCastFull", passes::UnpackAndCastFull(g, lower_info.getGPUDeviceString()));
+  LOWERING_PASS("ReplaceScalarImplicit", passes::ReplaceScalarImplicit(g));
+  LOWERING_PASS("RewriteInputsWithParams", passes::RewriteInputsWithParams(g, params));
+  LOWERING_PASS("ReplaceAtenPad", passes::ReplaceAtenPad(g));
+  LOWERING_PASS("ReplaceTileWithRepeat", passes::ReplaceTileWithRepeat(g));
+  LOWERING_PASS("FoldParamSubgraphs", passes::FoldParamSubgraphs(g));
   LOG_GRAPH(*g);
 }
 
+#undef LOWERING_PASS
+
 torch::jit::Module LowerModule(const torch::jit::Module& mod, std::string method_name, const LowerInfo& lower_info) {
   std::unordered_set<std::string> forced_fallback_modules(
       lower_info.forced_fallback_modules.begin(), lower_info.forced_fallback_modules.end());
@@ -173,6 +203,8 @@ std::pair<std::shared_ptr<torch::jit::Graph>, std::vector<torch::jit::IValue>> L
     const torch::jit::Module& mod,
     std::string method_name,
     const LowerInfo& lower_info) {
+  TORCHTRT_NVTX_RANGE("torch_tensorrt::lowering");
+  TORCHTRT_COMPILE_PHASE("lowering");
   LOG_DEBUG(lower_info);
   LOG_GRAPH("Before lowering: " << *mod.get_method(method_name).graph());
   auto lowered_mod = lower_info.unfreeze_module ? mod : LowerModule(mod, method_name, lower_info);
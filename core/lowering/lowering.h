@@ -1,4 +1,5 @@
 #pragma once
+#include <functional>
 #include <memory>
 #include "core/ir/ir.h"
 #include "torch/csrc/jit/ir/ir.h"
@@ -20,6 +21,13 @@ struct LowerInfo {
   // Whether the originating caller is `convert_method_to_trt_engine` (true) or `compile` (false)
   bool converting_to_trt_engine = false;
 
+  // Loops with a constant trip count up to max_unroll_trip_count (0 disables unrolling) and at most
+  // max_unroll_body_size nodes in their body are unrolled, if unroll_node_supported accepts every node of the body.
+  // The compiler sets unroll_node_supported to the converter support check, lowering does not know the converters
+  uint64_t max_unroll_trip_count = 16;
+  uint64_t max_unroll_body_size = 32;
+  std::function<bool(const torch::jit::Node*)> unroll_node_supported;
+
   ir::Device target_device;
   std::vector<std::string> forced_fallback_modules;
   friend std::ostream& operator<<(std::ostream& os, const LowerInfo& l);
@@ -35,6 +43,10 @@ int AutocastLongInputs(
     std::shared_ptr<torch::jit::Graph>& g,
     ir::TypeMap input_type_map,
     std::string target_device_name);
+// Resolves aten::size and aten::dim queries whose result is the same for every profile of the graph inputs to
+// constants, by symbolic shape propagation from input_specs, and merges queries of the same dynamic dim. Returns the
+// number of queries removed
+int FoldStaticShapes(std::shared_ptr<torch::jit::Graph>& g, const ir::CollectionInputSpecMap& input_specs);
 torch::jit::Module LowerModule(
     const torch::jit::Module& mod,
     std::string method_name,
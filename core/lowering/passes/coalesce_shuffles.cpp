@@ -0,0 +1,176 @@
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/passes/dead_code_elimination.h"
+
+#include "core/util/prelude.h"
+
+#include <numeric>
+#include <vector>
+
+namespace torch_tensorrt {
+namespace core {
+namespace lowering {
+namespace passes {
+namespace {
+
+c10::optional<std::vector<int64_t>> constant_int_list(torch::jit::Value* v) {
+  auto ivalue = torch::jit::toIValue(v);
+  if (!ivalue || !ivalue->isIntList()) {
+    return {};
+  }
+  return ivalue->toIntVector();
+}
+
+c10::optional<int64_t> constant_int(torch::jit::Value* v) {
+  auto ivalue = torch::jit::toIValue(v);
+  if (!ivalue || !ivalue->isInt()) {
+    return {};
+  }
+  return ivalue->toInt();
+}
+
+bool is_transpose(const torch::jit::Node* n) {
+  return n->kind() == torch::jit::aten::transpose && n->inputs().size() == 3 &&
+      n->input(1)->type()->isSubtypeOf(c10::IntType::get());
+}
+
+// Permutation applied by a permute, or by a transpose given the rank, normalized to non negative dims
+c10::optional<std::vector<int64_t>> permutation(const torch::jit::Node* n, c10::optional<int64_t> rank = {}) {
+  if (n->kind() == torch::jit::aten::permute) {
+    auto dims = constant_int_list(n->input(1));
+    if (!dims) {
+      return {};
+    }
+    auto r = static_cast<int64_t>(dims->size());
+    for (auto& d : *dims) {
+      d = d < 0 ? d + r : d;
+    }
+    return dims;
+  }
+  if (is_transpose(n) && rank) {
+    auto d0 = constant_int(n->input(1));
+    auto d1 = constant_int(n->input(2));
+    if (!d0 || !d1) {
+      return {};
+    }
+    std::vector<int64_t> dims(*rank);
+    std::iota(dims.begin(), dims.end(), 0);
+    auto a = *d0 < 0 ? *d0 + *rank : *d0;
+    auto b = *d1 < 0 ? *d1 + *rank : *d1;
+    if (a < 0 || a >= *rank || b < 0 || b >= *rank) {
+      return {};
+    }
+    std::swap(dims[a], dims[b]);
+    return dims;
+  }
+  return {};
+}
+
+bool is_identity(const std::vector<int64_t>& perm) {
+  for (size_t i = 0; i < perm.size(); i++) {
+    if (perm[i] != static_cast<int64_t>(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// A transpose of a dim with itself or a permute that keeps every dim in place
+bool is_identity_shuffle(const torch::jit::Node* n) {
+  if (is_transpose(n)) {
+    auto d0 = constant_int(n->input(1));
+    auto d1 = constant_int(n->input(2));
+    return d0 && d1 && *d0 == *d1;
+  }
+  auto perm = permutation(n);
+  return perm && is_identity(*perm);
+}
+
+// Ops whose output is the data of their input in the same order, so a reshape of their output is a reshape of their
+// input
+bool is_reshape_like(const torch::jit::Node* n) {
+  auto kind = n->kind();
+  return kind == torch::jit::aten::reshape || kind == torch::jit::aten::flatten ||
+      kind == torch::jit::aten::unsqueeze || kind == torch::jit::aten::squeeze;
+}
+
+bool CoalesceBlock(std::shared_ptr<torch::jit::Graph>& graph, torch::jit::Block* b) {
+  bool changed = false;
+  std::vector<torch::jit::Node*> nodes(b->nodes().begin(), b->nodes().end());
+  for (auto n : nodes) {
+    for (auto sub : n->blocks()) {
+      changed |= CoalesceBlock(graph, sub);
+    }
+
+    if (n->kind() == torch::jit::aten::permute || is_transpose(n)) {
+      if (is_identity_shuffle(n)) {
+        LOG_GRAPH("Removing identity shuffle " << util::node_info(n));
+        n->output()->replaceAllUsesWith(n->input(0));
+        n->destroy();
+        changed = true;
+        continue;
+      }
+
+      // The rank comes from whichever of the two is a permute
+      auto producer = n->input(0)->node();
+      if (producer->kind() != torch::jit::aten::permute && !is_transpose(producer)) {
+        continue;
+      }
+      c10::optional<int64_t> rank;
+      if (auto p = permutation(n)) {
+        rank = static_cast<int64_t>(p->size());
+      } else if (auto p = permutation(producer)) {
+        rank = static_cast<int64_t>(p->size());
+      }
+      auto outer = permutation(n, rank);
+      auto inner = permutation(producer, rank);
+      if (!outer || !inner || outer->size() != inner->size()) {
+        continue;
+      }
+
+      // out[i] = mid[outer[i]] = in[inner[outer[i]]]
+      std::vector<int64_t> composed;
+      for (auto d : *outer) {
+        composed.push_back((*inner)[d]);
+      }
+      LOG_GRAPH("Composing " << util::node_info(producer) << " and " << util::node_info(n));
+      if (is_identity(composed)) {
+        n->output()->replaceAllUsesWith(producer->input(0));
+      } else {
+        torch::jit::WithInsertPoint guard(n);
+        auto dims = graph->insertConstant(c10::List<int64_t>(composed));
+        auto permute = graph->create(torch::jit::aten::permute, {producer->input(0), dims});
+        permute->copyAttributes(*n);
+        permute->setScope(n->scope());
+        permute->insertBefore(n);
+        permute->output()->setType(n->output()->type());
+        n->output()->replaceAllUsesWith(permute->output());
+      }
+      n->destroy();
+      changed = true;
+    } else if (n->kind() == torch::jit::aten::reshape) {
+      // A reshape only depends on the number of elements and the order of the data it reshapes
+      auto producer = n->input(0)->node();
+      while (is_reshape_like(producer) && producer->input(0)->type()->isSubtypeOf(c10::TensorType::get())) {
+        LOG_GRAPH("Folding " << util::node_info(producer) << " into " << util::node_info(n));
+        n->replaceInput(0, producer->input(0));
+        producer = n->input(0)->node();
+        changed = true;
+      }
+    }
+  }
+  return changed;
+}
+
+} // namespace
+
+void CoalesceShuffles(std::shared_ptr<torch::jit::Graph>& graph) {
+  while (CoalesceBlock(graph, graph->block())) {
+    torch::jit::EliminateDeadCode(graph);
+  }
+  LOG_GRAPH("After CoalesceShuffles: " << *graph);
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,57 @@
+#include "torch/csrc/jit/passes/subgraph_rewrite.h"
+
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace lowering {
+namespace passes {
+
+namespace {
+bool is_constant_tensor(const torch::jit::Value* v) {
+  return v->node()->kind() == at::prim::Constant && v->type()->isSubtypeOf(c10::TensorType::get());
+}
+} // namespace
+
+// Rewrites the usual image preprocessing (x / 255 - mean) / std into (x - mean * 255) / (std * 255). The products
+// only depend on constants and are folded when the network is built, which leaves the engine two pointwise layers
+// on the (often uint8) input instead of three
+void FoldInputNormalization(std::shared_ptr<torch::jit::Graph>& graph) {
+  std::string normalize_pattern = R"IR(
+    graph(%x, %scale, %mean, %alpha, %std):
+      %scaled: Tensor = aten::div(%x, %scale)
+      %centered: Tensor = aten::sub(%scaled, %mean, %alpha)
+      %out: Tensor = aten::div(%centered, %std)
+      return (%out))IR";
+
+  std::string folded_pattern = R"IR(
+    graph(%x, %scale, %mean, %alpha, %std):
+      %scaled_mean: Tensor = aten::mul(%mean, %scale)
+      %scaled_std: Tensor = aten::mul(%std, %scale)
+      %centered: Tensor = aten::sub(%x, %scaled_mean, %alpha)
+      %out: Tensor = aten::div(%centered, %scaled_std)
+      return (%out))IR";
+
+  torch::jit::SubgraphRewriter normalize_rewriter;
+  normalize_rewriter.RegisterRewritePattern(normalize_pattern, folded_pattern);
+  normalize_rewriter.runOnGraph(
+      graph, [](const torch::jit::Match& match, const std::unordered_map<std::string, torch::jit::Value*>& vmap) {
+        auto mean = match.values_map.at(vmap.at("mean"));
+        auto std = match.values_map.at(vmap.at("std"));
+        auto scale = match.values_map.at(vmap.at("scale"));
+        // Scalar mean or std would need scalar multiplication, per channel constants are the common case
+        if (!is_constant_tensor(mean) || !is_constant_tensor(std) || scale->node()->kind() != at::prim::Constant) {
+          return false;
+        }
+        auto mean_type = mean->type()->cast<c10::TensorType>()->scalarType();
+        auto std_type = std->type()->cast<c10::TensorType>()->scalarType();
+        // Integer constants would change the result through integer multiplication
+        return mean_type && std_type && c10::isFloatingType(*mean_type) && c10::isFloatingType(*std_type);
+      });
+  LOG_GRAPH("Post fold input normalization: " << *graph);
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,132 @@
+#include "ATen/core/grad_mode.h"
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/passes/constant_propagation.h"
+#include "torch/csrc/jit/passes/dead_code_elimination.h"
+
+#include "core/lowering/passes/passes.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace lowering {
+namespace passes {
+namespace {
+using namespace torch::jit;
+
+// Q/DQ and dequantize ops have to reach the converters with constant weights for TensorRT to build INT8, FP8 and
+// INT4 layers from them
+bool isQuantization(const Node* n) {
+  static const std::unordered_set<c10::Symbol> quantization_ops = {
+      aten::fake_quantize_per_tensor_affine,
+      aten::fake_quantize_per_channel_affine,
+      aten::quantize_per_tensor,
+      aten::quantize_per_channel,
+      aten::dequantize,
+      c10::Symbol::fromQualString("trt::fake_quantize_fp8"),
+      c10::Symbol::fromQualString("trt::dequantize_int4")};
+  return quantization_ops.count(n->kind());
+}
+
+// Nodes computing tensors from constant tensors only, which are evaluated once here instead of in the engine
+bool isFoldable(const Node* n) {
+  if (n->kind() == prim::Constant || !n->blocks().empty() || n->outputs().empty() || isQuantization(n) ||
+      n->isNondeterministic() || n->hasSideEffects()) {
+    return false;
+  }
+  auto schema = n->maybeSchema();
+  if (!schema || schema->is_mutable()) {
+    return false;
+  }
+  for (auto out : n->outputs()) {
+    if (!out->type()->isSubtypeOf(c10::TensorType::get())) {
+      return false;
+    }
+  }
+  bool has_tensor_input = false;
+  for (auto in : n->inputs()) {
+    if (in->node()->kind() != prim::Constant) {
+      return false;
+    }
+    has_tensor_input |= in->type()->isSubtypeOf(c10::TensorType::get());
+  }
+  return has_tensor_input;
+}
+
+int64_t constantNumel(const Node* n) {
+  int64_t numel = 0;
+  for (auto in : n->inputs()) {
+    auto ivalue = toIValue(in);
+    if (ivalue && ivalue->isTensor()) {
+      numel += ivalue->toTensor().numel();
+    }
+  }
+  return numel;
+}
+
+bool foldParamSubgraphs(Block* b) {
+  bool changed = false;
+  for (auto it = b->nodes().begin(); it != b->nodes().end();) {
+    auto n = *it;
+    ++it;
+    for (auto sub_block : n->blocks()) {
+      changed |= foldParamSubgraphs(sub_block);
+    }
+    if (!isFoldable(n)) {
+      continue;
+    }
+    auto outputs = runNodeIfInputsAreConstant(n);
+    if (!outputs) {
+      continue;
+    }
+    // Broadcasts (expand, repeat) of weights are cheaper to compute in the engine than to store
+    int64_t out_numel = 0;
+    for (auto& out : *outputs) {
+      out_numel += out.isTensor() ? out.toTensor().numel() : 0;
+    }
+    if (out_numel > constantNumel(n)) {
+      continue;
+    }
+
+    WithInsertPoint guard(n);
+    std::vector<Value*> folded;
+    for (auto& out : *outputs) {
+      // Views (e.g. of a transposed weight) are materialized, so the engine gets the layout it converts
+      auto value = out.isTensor() ? IValue(out.toTensor().contiguous()) : out;
+      auto constant = tryInsertConstant(*n->owningGraph(), value);
+      if (!constant) {
+        break;
+      }
+      folded.push_back(*constant);
+    }
+    if (folded.size() != n->outputs().size()) {
+      for (auto c : folded) {
+        c->node()->destroy();
+      }
+      continue;
+    }
+    LOG_GRAPH("Folding " << util::node_info(n) << " on parameters into a constant");
+    for (size_t i = 0; i < folded.size(); i++) {
+      folded[i]->copyMetadata(n->outputs()[i]);
+      n->outputs()[i]->replaceAllUsesWith(folded[i]);
+    }
+    n->destroy();
+    changed = true;
+  }
+  return changed;
+}
+
+} // namespace
+
+void FoldParamSubgraphs(std::shared_ptr<Graph>& graph) {
+  at::NoGradGuard no_grad;
+  // Nodes are visited in order, so whole chains of ops on parameters fold in one sweep
+  if (foldParamSubgraphs(graph->block())) {
+    EliminateDeadCode(graph);
+  }
+  LOG_GRAPH("Post fold parameter subgraphs: " << *graph);
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,55 @@
+#include "torch/csrc/jit/ir/subgraph_matcher.h"
+#include "torch/csrc/jit/passes/subgraph_rewrite.h"
+
+#include "core/util/prelude.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace lowering {
+namespace passes {
+
+// Replaces scaled_dot_product_attention with an internal op which is converted as a single attention subgraph
+// TensorRT fuses into a flash attention kernel, so the full attention matrix is never materialized. Variants the
+// converter cannot express (non constant is_causal, grouped query attention) are left for
+// UnpackScaledDotProductAttention
+void FuseScaledDotProductAttention(std::shared_ptr<torch::jit::Graph>& graph) {
+  std::string sdpa_pattern = R"IR(
+    graph(%query, %key, %value, %attn_mask, %dropout_p, %is_causal, %scale, %enable_gqa):
+      %out: Tensor = aten::scaled_dot_product_attention(%query, %key, %value, %attn_mask, %dropout_p, %is_causal, %scale, %enable_gqa)
+      return (%out))IR";
+
+  std::string fused_sdpa_pattern = R"IR(
+    graph(%query, %key, %value, %attn_mask, %dropout_p, %is_causal, %scale, %enable_gqa):
+      %out: Tensor = trt::scaled_dot_product_attention(%query, %key, %value, %attn_mask, %is_causal, %scale)
+      return (%out))IR";
+
+  torch::jit::SubgraphRewriter sdpa_rewriter;
+  sdpa_rewriter.RegisterRewritePattern(sdpa_pattern, fused_sdpa_pattern);
+  sdpa_rewriter.runOnGraph(
+      graph, [](const torch::jit::Match& match, const std::unordered_map<std::string, torch::jit::Value*>&) {
+        auto is_causal_node = match.anchor->inputs().at(5)->node();
+        if (is_causal_node->kind() != at::prim::Constant) {
+          LOG_DEBUG("Could not fuse scaled_dot_product_attention with non constant is_causal: " << *is_causal_node);
+          return false;
+        }
+        auto attn_mask_node = match.anchor->inputs().at(3)->node();
+        if (is_causal_node->i(at::attr::value) == 1 &&
+            (attn_mask_node->kind() != at::prim::Constant || !attn_mask_node->mustBeNone())) {
+          // PyTorch rejects an explicit mask together with is_causal = True
+          return false;
+        }
+        auto enable_gqa_node = match.anchor->inputs().at(7)->node();
+        if (enable_gqa_node->kind() != at::prim::Constant || enable_gqa_node->i(at::attr::value) == 1) {
+          LOG_DEBUG("Could not fuse scaled_dot_product_attention with enable_gqa: " << *enable_gqa_node);
+          return false;
+        }
+        return true;
+      });
+  LOG_GRAPH("Post fuse scaled_dot_product_attention: " << *graph);
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace torch_tensorrt
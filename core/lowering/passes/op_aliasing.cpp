@@ -1,4 +1,4 @@
-#include <torch/csrc/jit/passes/subgraph_rewrite.h>
+#include "core/lowering/passes/passes.h"
 
 #include "core/util/prelude.h"
 
@@ -7,7 +7,7 @@ namespace core {
 namespace lowering {
 namespace passes {
 
-void AliasOperators(std::shared_ptr<torch::jit::Graph>& graph) {
+void AddAliasOperatorsPatterns(PatternRewriter& rewriter) {
   std::string true_divide_pattern = R"IR(
         graph(%s, %o):
             %1 : Tensor = aten::true_divide(%s, %o)
@@ -16,11 +16,7 @@ void AliasOperators(std::shared_ptr<torch::jit::Graph>& graph) {
         graph(%s, %o):
             %1 : Tensor = aten::div(%s, %o)
             return (%1))IR";
-
-  torch::jit::SubgraphRewriter true_divide_to_div;
-  true_divide_to_div.RegisterRewritePattern(true_divide_pattern, div_pattern);
-  true_divide_to_div.runOnGraph(graph);
-  LOG_GRAPH("Post map true_divide -> div: " << *graph);
+  rewriter.RegisterRewritePattern("AliasOperators", true_divide_pattern, div_pattern);
 
   std::string scatter_sub_pattern = R"IR(
         graph(%data, %dim, %index, %value):
@@ -30,11 +26,7 @@ void AliasOperators(std::shared_ptr<torch::jit::Graph>& graph) {
         graph(%data, %dim, %index, %value):
             %o : Tensor = aten::scatter(%data, %dim, %index, %value)
             return (%o))IR";
-
-  torch::jit::SubgraphRewriter rewrite_scatter;
-  rewrite_scatter.RegisterRewritePattern(scatter_sub_pattern, scatter_pattern);
-  rewrite_scatter.runOnGraph(graph);
-  LOG_GRAPH("Post map scatter_ -> scatter: " << *graph);
+  rewriter.RegisterRewritePattern("AliasOperators", scatter_sub_pattern, scatter_pattern);
 
   std::string multiply_pattern = R"IR(
         graph(%self, %other):
@@ -44,11 +36,14 @@ void AliasOperators(std::shared_ptr<torch::jit::Graph>& graph) {
         graph(%self, %other):
             %o : Tensor = aten::mul(%self, %other)
             return (%o))IR";
+  rewriter.RegisterRewritePattern("AliasOperators", multiply_pattern, mul_pattern);
+}
 
-  torch::jit::SubgraphRewriter rewrite_multiply;
-  rewrite_multiply.RegisterRewritePattern(multiply_pattern, mul_pattern);
-  rewrite_multiply.runOnGraph(graph);
-  LOG_GRAPH("Post map multiply -> mul: " << *graph);
+void AliasOperators(std::shared_ptr<torch::jit::Graph>& graph) {
+  PatternRewriter rewriter;
+  AddAliasOperatorsPatterns(rewriter);
+  rewriter.runOnGraph(graph);
+  LOG_GRAPH("Post alias operators: " << *graph);
 }
 
 } // namespace passes
@@ -0,0 +1,161 @@
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/passes/dead_code_elimination.h"
+
+#include "core/lowering/passes/passes.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace lowering {
+namespace passes {
+namespace {
+using namespace torch::jit;
+
+struct QParams {
+  double scale;
+  int64_t zero_point;
+  int64_t quant_min;
+  int64_t quant_max;
+};
+
+// Quantization parameters of a per tensor fake quantize with constant parameters, converted to a Q/DQ pair
+c10::optional<QParams> constantQParams(const Node* n) {
+  if (n->kind() != aten::fake_quantize_per_tensor_affine || n->inputs().size() != 5) {
+    return {};
+  }
+  std::vector<IValue> params;
+  for (size_t i = 1; i < 5; i++) {
+    auto ivalue = toIValue(n->inputs()[i]);
+    if (!ivalue || (i == 1 ? !ivalue->isDouble() : !ivalue->isInt())) {
+      return {};
+    }
+    params.push_back(*ivalue);
+  }
+  return QParams{params[0].toDouble(), params[1].toInt(), params[2].toInt(), params[3].toInt()};
+}
+
+bool sameRange(const QParams& a, const QParams& b) {
+  return a.zero_point == b.zero_point && a.quant_min == b.quant_min && a.quant_max == b.quant_max;
+}
+
+// Ops which commute with per tensor quantization, TensorRT runs them in INT8 when their input is quantized
+bool isQuantizationAgnostic(const Node* n) {
+  switch (n->kind()) {
+    case aten::view:
+    case aten::reshape:
+    case aten::flatten:
+    case aten::permute:
+    case aten::transpose:
+    case aten::squeeze:
+    case aten::unsqueeze:
+    case aten::max_pool1d:
+    case aten::max_pool2d:
+    case aten::max_pool3d:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Quantizing a value which was just quantized with the same parameters does not change it
+bool removeRedundantPair(Node* n) {
+  auto params = constantQParams(n);
+  auto producer_params = constantQParams(n->inputs()[0]->node());
+  if (!params || !producer_params || !sameRange(*params, *producer_params) ||
+      params->scale != producer_params->scale) {
+    return false;
+  }
+  LOG_GRAPH("Removing " << util::node_info(n) << " which repeats the quantization of its input");
+  n->output()->replaceAllUsesWith(n->inputs()[0]);
+  n->destroy();
+  return true;
+}
+
+// Moves the Q/DQ pair following a quantization agnostic op in front of it, so the quantization fuses into the layer
+// producing the input and the op runs in INT8 instead of FP32 between reformats
+bool hoistAcross(Node* n) {
+  auto op = n->inputs()[0]->node();
+  if (!constantQParams(n) || !isQuantizationAgnostic(op) || op->output()->uses().size() != 1 ||
+      op->inputs()[0]->uses().size() != 1) {
+    return false;
+  }
+  LOG_GRAPH("Moving " << util::node_info(n) << " in front of " << util::node_info(op));
+  auto hoisted = n->owningGraph()->create(n->kind(), 1);
+  hoisted->insertBefore(op);
+  hoisted->addInput(op->inputs()[0]);
+  for (size_t i = 1; i < n->inputs().size(); i++) {
+    if (!n->inputs()[i]->node()->isBefore(hoisted)) {
+      n->inputs()[i]->node()->moveBefore(hoisted);
+    }
+    hoisted->addInput(n->inputs()[i]);
+  }
+  hoisted->output()->setType(op->inputs()[0]->type());
+  op->replaceInput(0, hoisted->output());
+  n->output()->replaceAllUsesWith(op->output());
+  n->destroy();
+  return true;
+}
+
+// TensorRT only keeps a concatenation in INT8 (writing the inputs into the output in place) if all inputs share a
+// scale. The largest scale is used so none of the inputs is clipped
+bool unifyConcatScales(Node* cat) {
+  auto list = cat->inputs()[0]->node();
+  if (list->kind() != prim::ListConstruct || list->output()->uses().size() != 1 || list->inputs().size() < 2) {
+    return false;
+  }
+  std::vector<Node*> quantizations;
+  c10::optional<QParams> first;
+  double max_scale = 0;
+  bool differ = false;
+  for (auto in : list->inputs()) {
+    auto params = constantQParams(in->node());
+    if (!params || in->uses().size() != 1 || (first && !sameRange(*first, *params))) {
+      return false;
+    }
+    differ |= first && first->scale != params->scale;
+    first = first ? first : params;
+    max_scale = std::max(max_scale, params->scale);
+    quantizations.push_back(in->node());
+  }
+  if (!differ) {
+    return false;
+  }
+  LOG_GRAPH("Unifying the input scales of " << util::node_info(cat) << " to " << max_scale);
+  for (auto q : quantizations) {
+    WithInsertPoint guard(q);
+    q->replaceInput(1, q->owningGraph()->insertConstant(max_scale));
+  }
+  return true;
+}
+
+bool optimizeQDQPlacement(Block* b) {
+  bool changed = false;
+  for (auto it = b->nodes().begin(); it != b->nodes().end();) {
+    auto n = *it;
+    ++it;
+    for (auto sub_block : n->blocks()) {
+      changed |= optimizeQDQPlacement(sub_block);
+    }
+    if (n->kind() == aten::fake_quantize_per_tensor_affine) {
+      changed |= removeRedundantPair(n) || hoistAcross(n);
+    } else if (n->kind() == aten::cat) {
+      changed |= unifyConcatScales(n);
+    }
+  }
+  return changed;
+}
+
+} // namespace
+
+void OptimizeQDQPlacement(std::shared_ptr<Graph>& graph) {
+  // Chains of agnostic ops are crossed one op per iteration
+  while (optimizeQDQPlacement(graph->block())) {
+  }
+  EliminateDeadCode(graph);
+  LOG_GRAPH("Post optimize Q/DQ placement: " << *graph);
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace torch_tensorrt
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <functional>
+
 #include "torch/csrc/jit/ir/ir.h"
 
+#include "core/lowering/passes/pattern_rewriter.h"
+
 namespace torch_tensorrt {
 namespace core {
 namespace lowering {
@@ -18,7 +22,12 @@ void Conv2DToConvolution(std::shared_ptr<torch::jit::Graph>& graph);
 void ConvTransposed2DToConvolution(std::shared_ptr<torch::jit::Graph>& graph);
 void Conv3DToConvolution(std::shared_ptr<torch::jit::Graph>& graph);
 void ConvTransposed3DToConvolution(std::shared_ptr<torch::jit::Graph>& graph);
+void FoldInputNormalization(std::shared_ptr<torch::jit::Graph>& graph);
+// Evaluates the ops which only depend on (frozen) parameters, e.g. transposes and scaling of weights, and replaces
+// them with their results
+void FoldParamSubgraphs(std::shared_ptr<torch::jit::Graph>& graph);
 void FuseAddMMBranches(std::shared_ptr<torch::jit::Graph> graph);
+void FuseScaledDotProductAttention(std::shared_ptr<torch::jit::Graph>& graph);
 void LinearToAddMM(std::shared_ptr<torch::jit::Graph>& graph);
 void EliminateExceptionsSafe(std::shared_ptr<torch::jit::Graph>& graph);
 void EliminateExceptionOrPassPattern(std::shared_ptr<torch::jit::Graph> graph);
@@ -29,8 +38,15 @@ void MarkNodesForFallback(std::shared_ptr<torch::jit::Graph>& g, bool delete_del
 void RemoveBNDimCheck(std::shared_ptr<torch::jit::Graph> graph);
 void RemoveContiguous(std::shared_ptr<torch::jit::Graph>& graph);
 void ViewToReshape(std::shared_ptr<torch::jit::Graph>& graph);
+void CoalesceShuffles(std::shared_ptr<torch::jit::Graph>& graph);
 void RemoveDropout(std::shared_ptr<torch::jit::Graph>& graph);
+// Forwards the elements of tuples and read-only lists to their unpacks and constant-index accessors, so that TensorRT
+// regions connected through packing and unpacking are not split into separate segments
+void RemoveIntermediateCollections(std::shared_ptr<torch::jit::Graph>& graph);
 void RemoveNOPs(std::shared_ptr<torch::jit::Graph> graph);
+// Moves Q/DQ pairs of QAT graphs in front of shape ops and max pooling, removes repeated pairs and unifies the scales
+// of concatenated inputs, following the Q/DQ placement recommendations of TensorRT
+void OptimizeQDQPlacement(std::shared_ptr<torch::jit::Graph>& graph);
 void RemoveSingleUse0DTensors(std::shared_ptr<torch::jit::Graph>& g);
 void RemoveUnnecessaryCasts(std::shared_ptr<torch::jit::Graph>& graph);
 void ReplaceAtenInt(std::shared_ptr<torch::jit::Graph>& g);
@@ -53,6 +69,27 @@ void UnpackScaledDotProductAttention(std::shared_ptr<torch::jit::Graph>& graph);
 void ReplaceScalarImplicit(std::shared_ptr<torch::jit::Graph>& graph);
 void ReplaceAtenPad(std::shared_ptr<torch::jit::Graph>& graph);
 void ReplaceTileWithRepeat(std::shared_ptr<torch::jit::Graph>& graph);
+// Unrolls the for loops with a constant trip count of at most max_trip_count whose body has at most max_body_size
+// nodes, all of them is_supported, so their iterations can be converted into one engine
+void UnrollStaticLoops(
+    std::shared_ptr<torch::jit::Graph>& graph,
+    uint64_t max_trip_count,
+    uint64_t max_body_size,
+    const std::function<bool(const torch::jit::Node*)>& is_supported);
+
+// Register the rewrite patterns of the pattern-based passes above, so they can be applied together by one
+// PatternRewriter
+void AddAliasOperatorsPatterns(PatternRewriter& rewriter);
+void AddReduceGeluPatterns(PatternRewriter& rewriter);
+void AddReduceRemainderPatterns(PatternRewriter& rewriter);
+void AddReduceToOperationPatterns(PatternRewriter& rewriter);
+void AddRemoveContiguousPatterns(PatternRewriter& rewriter);
+void AddSiluToSigmoidMultipicationPatterns(PatternRewriter& rewriter);
+void AddUnpackHardSigmoidPatterns(PatternRewriter& rewriter);
+void AddUnpackHardSwishPatterns(PatternRewriter& rewriter);
+void AddUnpackLogSoftmaxPatterns(PatternRewriter& rewriter);
+void AddUnpackRsqrtPatterns(PatternRewriter& rewriter);
+void AddViewToReshapePatterns(PatternRewriter& rewriter);
 
 // utility functions exposed for testing
 std::string unmangle_cls_name(const std::string& name);
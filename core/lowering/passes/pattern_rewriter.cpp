@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <chrono>
+#include <map>
+
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/csrc/jit/passes/subgraph_rewrite.h"
+
+#include "core/lowering/passes/pattern_rewriter.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace lowering {
+namespace passes {
+namespace {
+
+// Patterns whose replacements rebuild one another would rewrite the graph forever
+constexpr size_t kMaxRounds = 16;
+
+void countKinds(torch::jit::Block* b, std::unordered_map<c10::Symbol, size_t>& census) {
+  for (auto n : b->nodes()) {
+    census[n->kind()]++;
+    for (auto sub_block : n->blocks()) {
+      countKinds(sub_block, census);
+    }
+  }
+}
+
+} // namespace
+
+void PatternRewriter::RegisterRewritePattern(
+    const std::string& pass,
+    const std::string& pattern,
+    const std::string& replacement) {
+  auto pattern_graph = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(pattern, pattern_graph.get());
+  Pattern p{pass, pattern, replacement, {}};
+  c10::optional<c10::Symbol> root;
+  for (auto n : pattern_graph->nodes()) {
+    p.kinds.insert(n->kind());
+    if (n->kind() != torch::jit::prim::Constant) {
+      root = n->kind();
+    }
+  }
+  TORCHTRT_CHECK(root, "Rewrite pattern of lowering pass " << pass << " has no node to match");
+  by_root[*root].push_back(patterns.size());
+  patterns.push_back(std::move(p));
+}
+
+void PatternRewriter::runOnGraph(std::shared_ptr<torch::jit::Graph>& graph) {
+  // Pass -> time spent matching and rewriting its patterns over all rounds
+  std::map<std::string, std::chrono::steady_clock::duration> pass_time;
+  std::unordered_map<c10::Symbol, size_t> census;
+  countKinds(graph->block(), census);
+  // Kinds whose count changed in the last round, a pattern only matches anew if some of its kinds were rewritten
+  c10::optional<std::unordered_set<c10::Symbol>> changed;
+  size_t round = 0;
+  for (; round < kMaxRounds; round++) {
+    std::vector<size_t> candidates;
+    for (auto& root : by_root) {
+      if (census.count(root.first)) {
+        candidates.insert(candidates.end(), root.second.begin(), root.second.end());
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    size_t attempted = 0;
+    for (auto i : candidates) {
+      auto& p = patterns[i];
+      bool present = std::all_of(
+          p.kinds.begin(), p.kinds.end(), [&](const c10::Symbol& kind) { return census.count(kind) > 0; });
+      bool touched = !changed || std::any_of(p.kinds.begin(), p.kinds.end(), [&](const c10::Symbol& kind) {
+                       return changed->count(kind) > 0;
+                     });
+      if (!present || !touched) {
+        continue;
+      }
+      auto start = std::chrono::steady_clock::now();
+      torch::jit::SubgraphRewriter rewriter;
+      rewriter.RegisterRewritePattern(p.pattern, p.replacement);
+      rewriter.runOnGraph(graph);
+      pass_time[p.pass] += std::chrono::steady_clock::now() - start;
+      attempted++;
+    }
+
+    std::unordered_map<c10::Symbol, size_t> next_census;
+    countKinds(graph->block(), next_census);
+    changed = std::unordered_set<c10::Symbol>();
+    for (auto& kind : next_census) {
+      auto prev = census.find(kind.first);
+      if (prev == census.end() || prev->second != kind.second) {
+        changed->insert(kind.first);
+      }
+    }
+    for (auto& kind : census) {
+      if (!next_census.count(kind.first)) {
+        changed->insert(kind.first);
+      }
+    }
+    census = std::move(next_census);
+    if (attempted == 0 || changed->empty()) {
+      break;
+    }
+  }
+  if (round == kMaxRounds) {
+    LOG_WARNING("Lowering patterns were still rewriting the graph after " << kMaxRounds << " rounds");
+  }
+
+  auto profiler = util::current_compile_profiler();
+  for (auto& t : pass_time) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t.second).count();
+    LOG_DEBUG("Lowering pass " << t.first << " took " << ns / 1e6 << "ms");
+    if (profiler) {
+      util::CompilePhaseRecord r;
+      r.phase = "lowering/" + t.first;
+      r.segment = util::current_compile_segment();
+      r.wall_time_ns = ns;
+      r.peak_host_bytes = util::host_peak_rss_bytes();
+      r.peak_gpu_bytes = util::gpu_memory_in_use();
+      profiler->record(std::move(r));
+    }
+  }
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,40 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "torch/csrc/jit/ir/ir.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace lowering {
+namespace passes {
+
+// Applies the rewrite patterns of several lowering passes together. Each pattern is indexed by the kind of its root
+// (its last node) and the kinds of the other nodes it is made of. A round takes one census of the node kinds in the
+// graph and only matches the patterns whose kinds are all present. Rounds repeat until no rewrite changes the census,
+// retrying only the patterns with a kind the previous round added or removed, so a pattern whose root is produced by
+// another one registered after it is still applied
+class PatternRewriter {
+ public:
+  void RegisterRewritePattern(const std::string& pass, const std::string& pattern, const std::string& replacement);
+  void runOnGraph(std::shared_ptr<torch::jit::Graph>& graph);
+
+ private:
+  struct Pattern {
+    std::string pass;
+    std::string pattern;
+    std::string replacement;
+    std::unordered_set<c10::Symbol> kinds;
+  };
+  std::vector<Pattern> patterns;
+  // Root kind -> index into patterns, in registration order
+  std::unordered_map<c10::Symbol, std::vector<size_t>> by_root;
+};
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace torch_tensorrt
@@ -1,4 +1,4 @@
-#include <torch/csrc/jit/passes/subgraph_rewrite.h>
+#include "core/lowering/passes/passes.h"
 #include "core/util/prelude.h"
 
 namespace torch_tensorrt {
@@ -6,7 +6,7 @@ namespace core {
 namespace lowering {
 namespace passes {
 
-void ReduceGelu(std::shared_ptr<torch::jit::Graph>& graph) {
+void AddReduceGeluPatterns(PatternRewriter& rewriter) {
   std::string gelu_pattern = R"IR(
         graph(%x : Tensor):
             %out : Tensor = aten::gelu(%x)
@@ -59,15 +59,14 @@ void ReduceGelu(std::shared_ptr<torch::jit::Graph>& graph) {
         return (%15))IR";
 
   // replace aten::gelu with pointwise operations
-  torch::jit::SubgraphRewriter map_gelu_to_pointwise_ops;
-  map_gelu_to_pointwise_ops.RegisterRewritePattern(gelu_pattern, gelu_reduce_pattern);
-  map_gelu_to_pointwise_ops.runOnGraph(graph);
-
-  torch::jit::SubgraphRewriter map_gelu_approximate_to_pointwise_ops;
-  map_gelu_approximate_to_pointwise_ops.RegisterRewritePattern(
-      gelu_approximate_pattern, gelu_reduce_multi_input_pattern);
-  map_gelu_approximate_to_pointwise_ops.runOnGraph(graph);
+  rewriter.RegisterRewritePattern("ReduceGelu", gelu_pattern, gelu_reduce_pattern);
+  rewriter.RegisterRewritePattern("ReduceGelu", gelu_approximate_pattern, gelu_reduce_multi_input_pattern);
+}
 
+void ReduceGelu(std::shared_ptr<torch::jit::Graph>& graph) {
+  PatternRewriter rewriter;
+  AddReduceGeluPatterns(rewriter);
+  rewriter.runOnGraph(graph);
   LOG_GRAPH("Post lowering of [aten::gelu] -> " << *graph);
 }
 
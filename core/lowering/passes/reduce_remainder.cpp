@@ -1,4 +1,4 @@
-#include <torch/csrc/jit/passes/subgraph_rewrite.h>
+#include "core/lowering/passes/passes.h"
 #include "core/util/prelude.h"
 
 namespace torch_tensorrt {
@@ -6,7 +6,7 @@ namespace core {
 namespace lowering {
 namespace passes {
 
-void ReduceRemainder(std::shared_ptr<torch::jit::Graph>& graph) {
+void AddReduceRemainderPatterns(PatternRewriter& rewriter) {
   std::string remainder_pattern = R"IR(
         graph(%self : Tensor, %other : Tensor):
             %out : Tensor = aten::remainder(%self, %other)
@@ -34,11 +34,14 @@ void ReduceRemainder(std::shared_ptr<torch::jit::Graph>& graph) {
             return (%out))IR";
 
   // replace aten::remainder with pointwise operations
-  torch::jit::SubgraphRewriter map_remainder_to_pointwise_ops;
-  map_remainder_to_pointwise_ops.RegisterRewritePattern(remainder_pattern, remainder_reduce_pattern);
-  map_remainder_to_pointwise_ops.RegisterRewritePattern(remainder_scalar_pattern, remainder_scalar_reduce_pattern);
-  map_remainder_to_pointwise_ops.runOnGraph(graph);
+  rewriter.RegisterRewritePattern("ReduceRemainder", remainder_pattern, remainder_reduce_pattern);
+  rewriter.RegisterRewritePattern("ReduceRemainder", remainder_scalar_pattern, remainder_scalar_reduce_pattern);
+}
 
+void ReduceRemainder(std::shared_ptr<torch::jit::Graph>& graph) {
+  PatternRewriter rewriter;
+  AddReduceRemainderPatterns(rewriter);
+  rewriter.runOnGraph(graph);
   LOG_GRAPH("Post lowering of [aten::remainder] -> " << *graph);
 }
 
@@ -1,4 +1,4 @@
-#include <torch/csrc/jit/passes/subgraph_rewrite.h>
+#include "core/lowering/passes/passes.h"
 
 #include "core/util/prelude.h"
 
@@ -7,7 +7,7 @@ namespace core {
 namespace lowering {
 namespace passes {
 
-void ReduceToOperation(std::shared_ptr<torch::jit::Graph>& graph) {
+void AddReduceToOperationPatterns(PatternRewriter& rewriter) {
   std::string to_type_as_pattern = R"IR(
         graph(%input, %other):
             %out : Tensor = aten::type_as(%input, %other)
@@ -21,10 +21,13 @@ void ReduceToOperation(std::shared_ptr<torch::jit::Graph>& graph) {
             return (%out))IR";
 
   // replace aten::type_as with aten::to.other
-  torch::jit::SubgraphRewriter map_aten_type_as_to_other;
-  map_aten_type_as_to_other.RegisterRewritePattern(to_type_as_pattern, to_other_pattern);
-  map_aten_type_as_to_other.runOnGraph(graph);
+  rewriter.RegisterRewritePattern("ReduceToOperation", to_type_as_pattern, to_other_pattern);
+}
 
+void ReduceToOperation(std::shared_ptr<torch::jit::Graph>& graph) {
+  PatternRewriter rewriter;
+  AddReduceToOperationPatterns(rewriter);
+  rewriter.runOnGraph(graph);
   LOG_GRAPH("Post lowering of [aten::to.device|aten::type_as] -> " << *graph);
 }
 
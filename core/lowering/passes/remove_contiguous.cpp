@@ -1,4 +1,4 @@
-#include <torch/csrc/jit/passes/subgraph_rewrite.h>
+#include "core/lowering/passes/passes.h"
 
 #include "core/util/prelude.h"
 
@@ -7,7 +7,7 @@ namespace core {
 namespace lowering {
 namespace passes {
 
-void RemoveContiguous(std::shared_ptr<torch::jit::Graph>& graph) {
+void AddRemoveContiguousPatterns(PatternRewriter& rewriter) {
   std::string contiguous_pattern = R"IR(
         graph(%input, %1):
             %2 = aten::contiguous(%input, %1)
@@ -17,9 +17,13 @@ void RemoveContiguous(std::shared_ptr<torch::jit::Graph>& graph) {
             return (%input))IR";
 
   // remove contiguous
-  torch::jit::SubgraphRewriter remove_contiguous;
-  remove_contiguous.RegisterRewritePattern(contiguous_pattern, no_contiguous_pattern);
-  remove_contiguous.runOnGraph(graph);
+  rewriter.RegisterRewritePattern("RemoveContiguous", contiguous_pattern, no_contiguous_pattern);
+}
+
+void RemoveContiguous(std::shared_ptr<torch::jit::Graph>& graph) {
+  PatternRewriter rewriter;
+  AddRemoveContiguousPatterns(rewriter);
+  rewriter.runOnGraph(graph);
   LOG_GRAPH("Post remove contiguous: " << *graph);
 }
 
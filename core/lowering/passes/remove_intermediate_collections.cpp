@@ -0,0 +1,118 @@
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/passes/dead_code_elimination.h"
+
+#include "core/lowering/passes/passes.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace lowering {
+namespace passes {
+namespace {
+using namespace torch::jit;
+
+// Element of the collection built by construct an accessor reads, normalizing negative indices
+c10::optional<int64_t> constantIndex(Value* idx, size_t size) {
+  auto ivalue = toIValue(idx);
+  if (!ivalue || !ivalue->isInt()) {
+    return {};
+  }
+  auto i = ivalue->toInt();
+  i = i < 0 ? i + static_cast<int64_t>(size) : i;
+  if (i < 0 || i >= static_cast<int64_t>(size)) {
+    return {};
+  }
+  return i;
+}
+
+// Lists are mutable, so their elements are only forwarded if every use of the list just reads it
+bool listIsReadOnly(Value* list) {
+  for (auto& use : list->uses()) {
+    auto n = use.user;
+    if (n->kind() == prim::Return || !n->blocks().empty()) {
+      return false;
+    }
+    auto schema = n->maybeSchema();
+    if (!schema) {
+      // Lists packed into other collections may be mutated through them
+      if (n->kind() != prim::ListUnpack) {
+        return false;
+      }
+      continue;
+    }
+    auto& args = schema->arguments();
+    if (use.offset < args.size() && args[use.offset].alias_info() && args[use.offset].alias_info()->isWrite()) {
+      return false;
+    }
+    // Outputs aliasing the list (other than its elements) could be mutated later
+    if (n->kind() != aten::__getitem__) {
+      for (auto& ret : schema->returns()) {
+        if (ret.alias_info()) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Replaces the outputs of the accessors of the collection built by construct with the values it was built from.
+// Returns true if any accessor was removed
+bool forwardElements(Node* construct) {
+  auto collection = construct->output();
+  auto elements = construct->inputs();
+  std::vector<Node*> accessors;
+  for (auto& use : collection->uses()) {
+    auto n = use.user;
+    if (n->kind() == prim::TupleUnpack || n->kind() == prim::ListUnpack) {
+      if (n->outputs().size() == elements.size()) {
+        accessors.push_back(n);
+      }
+    } else if (
+        (n->kind() == prim::TupleIndex || n->kind() == aten::__getitem__) && n->inputs().size() == 2 &&
+        n->inputs()[0] == collection && constantIndex(n->inputs()[1], elements.size())) {
+      accessors.push_back(n);
+    }
+  }
+
+  for (auto n : accessors) {
+    LOG_GRAPH("Forwarding the elements of " << util::node_info(construct) << " to " << util::node_info(n));
+    if (n->kind() == prim::TupleUnpack || n->kind() == prim::ListUnpack) {
+      for (size_t i = 0; i < elements.size(); i++) {
+        n->outputs()[i]->replaceAllUsesWith(elements[i]);
+      }
+    } else {
+      n->output()->replaceAllUsesWith(elements[*constantIndex(n->inputs()[1], elements.size())]);
+    }
+    n->destroy();
+  }
+  return !accessors.empty();
+}
+
+bool removeIntermediateCollections(Block* b) {
+  bool changed = false;
+  for (auto n : b->nodes()) {
+    for (auto sub_block : n->blocks()) {
+      changed |= removeIntermediateCollections(sub_block);
+    }
+    if (n->kind() == prim::TupleConstruct || (n->kind() == prim::ListConstruct && listIsReadOnly(n->output()))) {
+      changed |= forwardElements(n);
+    }
+  }
+  return changed;
+}
+
+} // namespace
+
+void RemoveIntermediateCollections(std::shared_ptr<Graph>& graph) {
+  // Collections of collections are unpacked one level per iteration
+  while (removeIntermediateCollections(graph->block())) {
+  }
+  EliminateDeadCode(graph);
+  LOG_GRAPH("Post remove intermediate collections: " << *graph);
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace torch_tensorrt
@@ -1,4 +1,4 @@
-#include <torch/csrc/jit/passes/subgraph_rewrite.h>
+#include "core/lowering/passes/passes.h"
 
 #include "core/util/prelude.h"
 
@@ -7,7 +7,7 @@ namespace core {
 namespace lowering {
 namespace passes {
 
-void SiluToSigmoidMultipication(std::shared_ptr<torch::jit::Graph>& graph) {
+void AddSiluToSigmoidMultipicationPatterns(PatternRewriter& rewriter) {
   std::string silu_pattern = R"IR(
         graph(%x):
             %1 : Tensor = aten::silu(%x)
@@ -18,10 +18,13 @@ void SiluToSigmoidMultipication(std::shared_ptr<torch::jit::Graph>& graph) {
             %2 : Tensor = aten::mul(%x, %1)
             return (%2))IR";
   ;
+  rewriter.RegisterRewritePattern("SiluToSigmoidMultipication", silu_pattern, sigmoid_multiplication_pattern);
+}
 
-  torch::jit::SubgraphRewriter map_silu_to_sigmoid_multiplication;
-  map_silu_to_sigmoid_multiplication.RegisterRewritePattern(silu_pattern, sigmoid_multiplication_pattern);
-  map_silu_to_sigmoid_multiplication.runOnGraph(graph);
+void SiluToSigmoidMultipication(std::shared_ptr<torch::jit::Graph>& graph) {
+  PatternRewriter rewriter;
+  AddSiluToSigmoidMultipicationPatterns(rewriter);
+  rewriter.runOnGraph(graph);
   LOG_GRAPH("Post map silu -> x * sigmoid(x): " << *graph);
 }
 
@@ -1,4 +1,4 @@
-#include "torch/csrc/jit/passes/subgraph_rewrite.h"
+#include "core/lowering/passes/passes.h"
 
 #include "core/util/prelude.h"
 
@@ -7,7 +7,7 @@ namespace core {
 namespace lowering {
 namespace passes {
 
-void UnpackHardSigmoid(std::shared_ptr<torch::jit::Graph>& graph) {
+void AddUnpackHardSigmoidPatterns(PatternRewriter& rewriter) {
   std::string hardsigmoid_pattern = R"IR(
         graph(%input):
             %result = aten::hardsigmoid(%input)
@@ -28,12 +28,14 @@ void UnpackHardSigmoid(std::shared_ptr<torch::jit::Graph>& graph) {
             %9 : Tensor = aten::add(%4, %22, %5)
             %21 : Tensor = aten::clamp(%9, %10, %5)
             return (%21))IR";
+  rewriter.RegisterRewritePattern("UnpackHardSigmoid", hardsigmoid_pattern, new_pattern);
+  rewriter.RegisterRewritePattern("UnpackHardSigmoid", hardsigmoid_pattern_inplace, new_pattern);
+}
 
-  torch::jit::SubgraphRewriter rewriter;
-  rewriter.RegisterRewritePattern(hardsigmoid_pattern, new_pattern);
-  rewriter.RegisterRewritePattern(hardsigmoid_pattern_inplace, new_pattern);
+void UnpackHardSigmoid(std::shared_ptr<torch::jit::Graph>& graph) {
+  PatternRewriter rewriter;
+  AddUnpackHardSigmoidPatterns(rewriter);
   rewriter.runOnGraph(graph);
-
   LOG_GRAPH("Post unpack hardsigmoid: " << *graph);
 }
 
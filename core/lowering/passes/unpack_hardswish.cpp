@@ -1,4 +1,4 @@
-#include "torch/csrc/jit/passes/subgraph_rewrite.h"
+#include "core/lowering/passes/passes.h"
 
 #include "core/util/prelude.h"
 
@@ -7,7 +7,7 @@ namespace core {
 namespace lowering {
 namespace passes {
 
-void UnpackHardSwish(std::shared_ptr<torch::jit::Graph>& graph) {
+void AddUnpackHardSwishPatterns(PatternRewriter& rewriter) {
   std::string hardswish_pattern = R"IR(
         graph(%input):
             %result = aten::hardswish(%input)
@@ -29,12 +29,14 @@ void UnpackHardSwish(std::shared_ptr<torch::jit::Graph>& graph) {
             %7 = aten::div(%6, %5)
             %8 = aten::mul(%input, %7)
             return (%8))IR";
+  rewriter.RegisterRewritePattern("UnpackHardSwish", hardswish_pattern, new_pattern);
+  rewriter.RegisterRewritePattern("UnpackHardSwish", hardswish_pattern_inplace, new_pattern);
+}
 
-  torch::jit::SubgraphRewriter rewriter;
-  rewriter.RegisterRewritePattern(hardswish_pattern, new_pattern);
-  rewriter.RegisterRewritePattern(hardswish_pattern_inplace, new_pattern);
+void UnpackHardSwish(std::shared_ptr<torch::jit::Graph>& graph) {
+  PatternRewriter rewriter;
+  AddUnpackHardSwishPatterns(rewriter);
   rewriter.runOnGraph(graph);
-
   LOG_GRAPH("Post unpack hardswish: " << *graph);
 }
 
@@ -1,4 +1,4 @@
-#include "torch/csrc/jit/passes/subgraph_rewrite.h"
+#include "core/lowering/passes/passes.h"
 
 #include "core/util/prelude.h"
 
@@ -7,7 +7,7 @@ namespace core {
 namespace lowering {
 namespace passes {
 
-void UnpackLogSoftmax(std::shared_ptr<torch::jit::Graph>& graph) {
+void AddUnpackLogSoftmaxPatterns(PatternRewriter& rewriter) {
   // Its easier for TensorRT if we seperate softmax and log
   // There might need to be a reshape inserted see:
   // https://github.com/onnx/onnx-tensorrt/blob/5dca8737851118f6ab8a33ea1f7bcb7c9f06caf5/builtin_op_importers.cpp#L1593
@@ -33,14 +33,14 @@ void UnpackLogSoftmax(std::shared_ptr<torch::jit::Graph>& graph) {
             %softmax = aten::softmax(%input, %dim, %dtype)
             %log_softmax = aten::log(%softmax)
             return (%log_softmax))IR";
+  rewriter.RegisterRewritePattern("UnpackLogSoftmax", logsoftmax_pattern, softmax_log_pattern);
+  rewriter.RegisterRewritePattern("UnpackLogSoftmax", logsoftmax_none_pattern, softmax_log_none_pattern);
+}
 
-  torch::jit::SubgraphRewriter logsoftmax_to_softmax_log;
-  logsoftmax_to_softmax_log.RegisterRewritePattern(logsoftmax_pattern, softmax_log_pattern);
-  logsoftmax_to_softmax_log.runOnGraph(graph);
-
-  torch::jit::SubgraphRewriter logsoftmax_none_to_softmax_log_none;
-  logsoftmax_none_to_softmax_log_none.RegisterRewritePattern(logsoftmax_none_pattern, softmax_log_none_pattern);
-  logsoftmax_none_to_softmax_log_none.runOnGraph(graph);
+void UnpackLogSoftmax(std::shared_ptr<torch::jit::Graph>& graph) {
+  PatternRewriter rewriter;
+  AddUnpackLogSoftmaxPatterns(rewriter);
+  rewriter.runOnGraph(graph);
   LOG_GRAPH("Post unpack logsoftmax: " << *graph);
 }
 
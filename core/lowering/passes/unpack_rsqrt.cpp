@@ -1,4 +1,4 @@
-#include "torch/csrc/jit/passes/subgraph_rewrite.h"
+#include "core/lowering/passes/passes.h"
 
 #include "core/util/prelude.h"
 
@@ -7,7 +7,7 @@ namespace core {
 namespace lowering {
 namespace passes {
 
-void UnpackRsqrt(std::shared_ptr<torch::jit::Graph>& graph) {
+void AddUnpackRsqrtPatterns(PatternRewriter& rewriter) {
   std::string rsqrt_pattern = R"IR(
     graph(%1):
       %out: Tensor = aten::rsqrt(%1)
@@ -17,10 +17,13 @@ void UnpackRsqrt(std::shared_ptr<torch::jit::Graph>& graph) {
       %intermediate: Tensor = aten::sqrt(%1)
       %out: Tensor = aten::reciprocal(%intermediate)
       return (%out))IR";
+  rewriter.RegisterRewritePattern("UnpackRsqrt", rsqrt_pattern, unpacked_pattern);
+}
 
-  torch::jit::SubgraphRewriter rsqrt_rewriter;
-  rsqrt_rewriter.RegisterRewritePattern(rsqrt_pattern, unpacked_pattern);
-  rsqrt_rewriter.runOnGraph(graph);
+void UnpackRsqrt(std::shared_ptr<torch::jit::Graph>& graph) {
+  PatternRewriter rewriter;
+  AddUnpackRsqrtPatterns(rewriter);
+  rewriter.runOnGraph(graph);
   LOG_GRAPH("Post unpack rsqrt: " << *graph);
 }
 
@@ -0,0 +1,138 @@
+#include <unordered_map>
+
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/passes/dead_code_elimination.h"
+
+#include "core/lowering/passes/passes.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace lowering {
+namespace passes {
+namespace {
+using namespace torch::jit;
+
+struct StaticLoopUnroller {
+  StaticLoopUnroller(
+      std::shared_ptr<Graph> graph,
+      uint64_t max_trip_count,
+      uint64_t max_body_size,
+      const std::function<bool(const Node*)>& is_supported)
+      : graph_(std::move(graph)),
+        max_trip_count_(max_trip_count),
+        max_body_size_(max_body_size),
+        is_supported_(is_supported) {}
+
+  void run() {
+    auto unrolled = unrollBlock(graph_->block());
+    if (unrolled) {
+      EliminateDeadCode(graph_);
+      LOG_DEBUG("Unrolled " << unrolled << " loops with static trip counts");
+    }
+    LOG_GRAPH("Post unroll static loops: " << *graph_);
+  }
+
+ private:
+  // Inner loops are unrolled first, their outer loop can then be unrolled as well if it is small enough
+  size_t unrollBlock(Block* b) {
+    size_t unrolled = 0;
+    for (auto it = b->nodes().begin(); it != b->nodes().end();) {
+      auto n = *it;
+      // The unrolled iterations are inserted before n, so it can be destroyed after the iterator moved on
+      it++;
+      for (auto sub_block : n->blocks()) {
+        unrolled += unrollBlock(sub_block);
+      }
+      if (n->kind() == prim::Loop && unrollable(n)) {
+        unroll(n);
+        unrolled++;
+      }
+    }
+    return unrolled;
+  }
+
+  // A for loop (the condition is constant true) with a constant trip count, whose body is small, free of control flow
+  // and converts entirely to TensorRT
+  bool unrollable(Node* loop) {
+    auto body = loop->blocks()[0];
+    auto trip_count = constant_as<int64_t>(loop->inputs()[0]);
+    auto initial_cond = constant_as<bool>(loop->inputs()[1]);
+    auto body_cond = constant_as<bool>(body->outputs()[0]);
+    if (!trip_count || !initial_cond || !*initial_cond || !body_cond || !*body_cond || *trip_count < 0 ||
+        static_cast<uint64_t>(*trip_count) > max_trip_count_) {
+      return false;
+    }
+    uint64_t body_size = 0;
+    for (auto n : body->nodes()) {
+      if (n->kind() == prim::Constant) {
+        continue;
+      }
+      if (!n->blocks().empty() || !is_supported_(n)) {
+        LOG_GRAPH("Not unrolling loop " << util::node_info(loop) << ", its body runs " << util::node_info(n));
+        return false;
+      }
+      body_size++;
+    }
+    if (body_size > max_body_size_) {
+      LOG_GRAPH("Not unrolling loop " << util::node_info(loop) << ", its body has " << body_size << " nodes");
+      return false;
+    }
+    return true;
+  }
+
+  void unroll(Node* loop) {
+    auto body = loop->blocks()[0];
+    auto trip_count = *constant_as<int64_t>(loop->inputs()[0]);
+    LOG_GRAPH("Unrolling the " << trip_count << " iterations of loop " << util::node_info(loop));
+
+    WithInsertPoint guard(loop);
+    std::vector<Value*> carried(loop->inputs().begin() + 2, loop->inputs().end());
+    std::unordered_map<Value*, Value*> env;
+    auto lookup = [&](Value* v) {
+      auto mapped = env.find(v);
+      return mapped == env.end() ? v : mapped->second;
+    };
+    for (int64_t i = 0; i < trip_count; i++) {
+      env[body->inputs()[0]] = graph_->insertConstant(i);
+      for (size_t j = 0; j < carried.size(); j++) {
+        env[body->inputs()[j + 1]] = carried[j];
+      }
+      for (auto n : body->nodes()) {
+        auto clone = graph_->insertNode(graph_->createClone(n, lookup));
+        for (size_t k = 0; k < n->outputs().size(); k++) {
+          env[n->outputs()[k]] = clone->outputs()[k];
+        }
+      }
+      for (size_t j = 0; j < carried.size(); j++) {
+        carried[j] = lookup(body->outputs()[j + 1]);
+      }
+    }
+    for (size_t j = 0; j < carried.size(); j++) {
+      loop->outputs()[j]->replaceAllUsesWith(carried[j]);
+    }
+    loop->destroy();
+  }
+
+  std::shared_ptr<Graph> graph_;
+  uint64_t max_trip_count_;
+  uint64_t max_body_size_;
+  const std::function<bool(const Node*)>& is_supported_;
+};
+} // namespace
+
+void UnrollStaticLoops(
+    std::shared_ptr<torch::jit::Graph>& graph,
+    uint64_t max_trip_count,
+    uint64_t max_body_size,
+    const std::function<bool(const torch::jit::Node*)>& is_supported) {
+  if (max_trip_count == 0 || !is_supported) {
+    return;
+  }
+  StaticLoopUnroller(graph, max_trip_count, max_body_size, is_supported).run();
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace torch_tensorrt
@@ -1,4 +1,4 @@
-#include <torch/csrc/jit/passes/subgraph_rewrite.h>
+#include "core/lowering/passes/passes.h"
 #include "core/util/prelude.h"
 
 namespace torch_tensorrt {
@@ -6,7 +6,7 @@ namespace core {
 namespace lowering {
 namespace passes {
 
-void ViewToReshape(std::shared_ptr<torch::jit::Graph>& graph) {
+void AddViewToReshapePatterns(PatternRewriter& rewriter) {
   std::string view_pattern = R"IR(
         graph(%x, %1):
             %out : Tensor = aten::view(%x, %1)
@@ -18,10 +18,13 @@ void ViewToReshape(std::shared_ptr<torch::jit::Graph>& graph) {
             return (%out))IR";
 
   // replace aten::view with aten::reshape
-  torch::jit::SubgraphRewriter map_view_to_reshape;
-  map_view_to_reshape.RegisterRewritePattern(view_pattern, reshape_pattern);
-  map_view_to_reshape.runOnGraph(graph);
+  rewriter.RegisterRewritePattern("ViewToReshape", view_pattern, reshape_pattern);
+}
 
+void ViewToReshape(std::shared_ptr<torch::jit::Graph>& graph) {
+  PatternRewriter rewriter;
+  AddViewToReshapePatterns(rewriter);
+  rewriter.runOnGraph(graph);
   LOG_GRAPH("Post lowering of aten::view -> " << *graph);
 }
 
@@ -1,4 +1,6 @@
 #include <limits>
+#include <vector>
+#include "ATen/ATen.h"
 #include "torch/csrc/jit/runtime/custom_operator.h"
 
 namespace torch {
@@ -26,6 +28,76 @@ RegisterOperators trt_placeholder_ops_reg({
           return attn_mask;
         },
         c10::AliasAnalysisKind::CONSERVATIVE),
+    /// Op produced by FuseScaledDotProductAttention, runs as scaled_dot_product_attention when it falls back to Torch
+    Operator(
+        "trt::scaled_dot_product_attention(Tensor query, Tensor key, Tensor value, Tensor? attn_mask, bool is_causal, float? scale) -> Tensor",
+        [](Stack& stack) {
+          auto scale = pop(stack).toOptional<double>();
+          auto is_causal = pop(stack).toBool();
+          auto attn_mask = pop(stack).toOptional<at::Tensor>();
+          auto value = pop(stack).to<at::Tensor>();
+          auto key = pop(stack).to<at::Tensor>();
+          auto query = pop(stack).to<at::Tensor>();
+          push(stack, at::scaled_dot_product_attention(query, key, value, attn_mask, 0.0, is_causal, scale));
+        },
+        aliasAnalysisFromSchema()),
+    /// Attention over B sequences packed along the first dim of [T, H, D] query, key and value, sequence b being
+    /// tokens [cu_seqlens[b], cu_seqlens[b + 1]) and no longer than max_seqlen. Lets encoders run on packed tokens
+    /// without padding, every other op of their layers is independent of the sequence a token belongs to
+    Operator(
+        "trt::varlen_attention(Tensor query, Tensor key, Tensor value, Tensor cu_seqlens, int max_seqlen, float? scale) -> Tensor",
+        [](Stack& stack) {
+          auto scale = pop(stack).toOptional<double>();
+          auto max_seqlen = pop(stack).toInt();
+          auto cu_seqlens = pop(stack).to<at::Tensor>().to(at::kCPU, at::kLong);
+          auto value = pop(stack).to<at::Tensor>();
+          auto key = pop(stack).to<at::Tensor>();
+          auto query = pop(stack).to<at::Tensor>();
+          auto offsets = cu_seqlens.accessor<int64_t, 1>();
+          std::vector<at::Tensor> outs;
+          for (int64_t b = 0; b + 1 < offsets.size(0); b++) {
+            auto start = offsets[b];
+            auto len = offsets[b + 1] - start;
+            TORCH_CHECK(
+                len <= max_seqlen, "Sequence ", b, " of length ", len, " is longer than max_seqlen ", max_seqlen);
+            // [L, H, D] -> [H, L, D]
+            auto seq = [&](const at::Tensor& t) { return t.narrow(0, start, len).transpose(0, 1); };
+            auto out = at::scaled_dot_product_attention(seq(query), seq(key), seq(value), {}, 0.0, false, scale);
+            outs.push_back(out.transpose(0, 1));
+          }
+          push(stack, outs.empty() ? at::empty_like(query) : at::cat(outs, 0));
+        },
+        aliasAnalysisFromSchema()),
+    /// Quantizes to FP8 (E4M3) and back, per tensor for a single element scale and per channel along axis otherwise
+    Operator(
+        "trt::fake_quantize_fp8(Tensor self, Tensor scale, int axis) -> Tensor",
+        [](Stack& stack) {
+          auto axis = pop(stack).toInt();
+          auto scale = pop(stack).to<at::Tensor>();
+          auto self = pop(stack).to<at::Tensor>();
+          if (scale.numel() > 1) {
+            axis = axis < 0 ? axis + self.dim() : axis;
+            std::vector<int64_t> shape(self.dim(), 1);
+            shape[axis] = scale.numel();
+            scale = scale.reshape(shape);
+          }
+          // 448 is the largest finite E4M3 value
+          auto q = (self / scale).clamp(-448.0, 448.0).to(at::kFloat8_e4m3fn);
+          push(stack, q.to(self.scalar_type()) * scale);
+        },
+        aliasAnalysisFromSchema()),
+    /// Dequantizes a [N, K] weight of int4 values stored one per int8, every block_size values along K share a scale
+    /// of the [N, K / block_size] scale tensor
+    Operator(
+        "trt::dequantize_int4(Tensor weight, Tensor scale, int block_size) -> Tensor",
+        [](Stack& stack) {
+          auto block_size = pop(stack).toInt();
+          auto scale = pop(stack).to<at::Tensor>();
+          auto weight = pop(stack).to<at::Tensor>();
+          auto blocks = weight.reshape({weight.size(0), -1, block_size}).to(scale.scalar_type());
+          push(stack, (blocks * scale.unsqueeze(-1)).reshape(weight.sizes()));
+        },
+        aliasAnalysisFromSchema()),
 });
 
 } // namespace jit
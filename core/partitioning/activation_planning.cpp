@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <unordered_map>
+
+#include "torch/csrc/jit/ir/ir.h"
+
+#include "core/partitioning/partitioning.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace partitioning {
+namespace {
+
+const c10::Symbol kExecuteEngineInArena = c10::Symbol::fromQualString("tensorrt::execute_engine_in_arena");
+
+} // namespace
+
+std::vector<PlannedActivation> planSegmentActivations(
+    std::shared_ptr<torch::jit::Graph>& g,
+    const std::string& arena_name) {
+  std::vector<PlannedActivation> plan;
+  if (g->inputs().empty() || !g->inputs()[0]->type()->cast<c10::ClassType>()) {
+    LOG_DEBUG("Hybrid graph does not take its module, the activations of its TensorRT segments are not planned");
+    return plan;
+  }
+
+  std::vector<EngineNodes> engines;
+  // Input list of each engine by the step it runs at
+  std::unordered_map<torch::jit::Node*, int64_t> input_list_step;
+  for (auto n : g->nodes()) {
+    if (auto engine = matchEngine(n)) {
+      input_list_step[engine->inputs] = engines.size();
+      engines.push_back(*engine);
+    }
+  }
+
+  // Outputs read by anything but a later engine (Torch ops, nested blocks, the graph outputs) escape the arena
+  std::vector<bool> uses_arena(engines.size(), false);
+  for (size_t step = 0; step < engines.size(); step++) {
+    auto outputs = engines[step].outputs->outputs();
+    for (size_t i = 0; i < outputs.size(); i++) {
+      auto last_use = static_cast<int64_t>(step);
+      bool planned = outputs[i]->type()->isSubtypeOf(c10::TensorType::get());
+      for (auto& use : outputs[i]->uses()) {
+        auto consumer = input_list_step.find(use.user);
+        if (consumer == input_list_step.end() || consumer->second <= static_cast<int64_t>(step)) {
+          planned = false;
+          break;
+        }
+        last_use = std::max(last_use, consumer->second);
+      }
+      if (planned) {
+        plan.push_back({static_cast<int64_t>(step), static_cast<int64_t>(i), last_use});
+        uses_arena[step] = true;
+      }
+    }
+  }
+  if (plan.empty()) {
+    LOG_DEBUG("No tensors are passed only between the TensorRT segments of the hybrid graph");
+    return plan;
+  }
+
+  torch::jit::Value* arena = nullptr;
+  {
+    torch::jit::WithInsertPoint guard(*g->nodes().begin());
+    arena = g->insertNode(g->createGetAttr(g->inputs()[0], arena_name))->output();
+  }
+  for (size_t step = 0; step < engines.size(); step++) {
+    if (!uses_arena[step]) {
+      continue;
+    }
+    auto execute = engines[step].execute;
+    torch::jit::WithInsertPoint guard(execute);
+    auto step_id = g->insertConstant(static_cast<int64_t>(step));
+    auto in_arena =
+        g->insertNode(g->create(kExecuteEngineInArena, {execute->input(0), execute->input(1), arena, step_id}));
+    in_arena->output()->setType(c10::ListType::ofTensors());
+    execute->output()->replaceAllUsesWith(in_arena->output());
+    execute->destroy();
+  }
+
+  LOG_INFO(
+      "Planned " << plan.size() << " tensors passed between " << engines.size()
+                 << " TensorRT segments into one activation arena");
+  LOG_GRAPH("Hybrid graph after planning segment activations: " << *g);
+  return plan;
+}
+
+} // namespace partitioning
+} // namespace core
+} // namespace torch_tensorrt
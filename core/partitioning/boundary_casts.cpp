@@ -0,0 +1,144 @@
+#include <algorithm>
+
+#include "torch/csrc/jit/passes/dead_code_elimination.h"
+
+#include "core/partitioning/partitioning.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace partitioning {
+namespace {
+
+// Target dtype of an aten::to with a constant dtype argument
+c10::optional<at::ScalarType> castDType(const torch::jit::Node* n) {
+  if (n->kind() != torch::jit::aten::to || n->inputs().size() < 2) {
+    return {};
+  }
+  auto dtype_idx = n->input(1)->type()->kind() == torch::jit::TypeKind::DeviceObjType ? 2 : 1;
+  if (n->inputs().size() <= static_cast<size_t>(dtype_idx)) {
+    return {};
+  }
+  auto dtype = torch::jit::toIValue(n->input(dtype_idx));
+  if (!dtype || !dtype->isInt()) {
+    return {};
+  }
+  return static_cast<at::ScalarType>(dtype->toInt());
+}
+
+// Node of block which contains n, n itself if it is directly in block
+torch::jit::Node* ownerInBlock(torch::jit::Node* n, torch::jit::Block* block) {
+  while (n && n->owningBlock() != block) {
+    n = n->owningBlock()->owningNode();
+  }
+  return n;
+}
+
+// Position of raw among the tensor inputs of a segment, which its input types are registered for
+c10::optional<size_t> tensorInputIndex(const SegmentedBlock& seg, torch::jit::Value* raw) {
+  size_t tensor_idx = 0;
+  for (auto in : seg.raw_inputs()) {
+    if (in == raw) {
+      return tensor_idx < seg.in_types().size() ? c10::optional<size_t>(tensor_idx) : c10::nullopt;
+    }
+    tensor_idx += in->type()->isSubtypeOf(c10::TensorType::get());
+  }
+  return {};
+}
+
+bool canRestoreLong(torch::jit::Value* raw, torch::jit::Block* block, PartitionedGraph& segments, size_t producer) {
+  std::unordered_set<torch::jit::Node*> consumer_nodes;
+  for (size_t s = 0; s < segments.size(); s++) {
+    if (s == producer) {
+      continue;
+    }
+    auto& seg = segments[s];
+    auto& raw_inputs = seg.raw_inputs();
+    if (std::find(raw_inputs.begin(), raw_inputs.end(), raw) == raw_inputs.end()) {
+      continue;
+    }
+    if (seg.target() == SegmentedBlock::kTensorRT) {
+#if NV_TENSORRT_MAJOR >= 10
+      if (!tensorInputIndex(seg, raw)) {
+        return false;
+      }
+#else
+      // Engines before TensorRT 10 cannot take Int64 inputs
+      return false;
+#endif
+    }
+    consumer_nodes.insert(seg.raw_nodes().begin(), seg.raw_nodes().end());
+  }
+  // Every use has to be in a segment which is updated here, returning the value keeps the cast
+  for (auto& use : raw->uses()) {
+    auto user = ownerInBlock(use.user, block);
+    if (!user || user == block->return_node() || !consumer_nodes.count(user)) {
+      return false;
+    }
+  }
+  return !consumer_nodes.empty();
+}
+
+} // namespace
+
+void eliminateBoundaryCasts(PartitioningCtx* ctx) {
+  for (auto& partitioned_block : ctx->partitioned_blocks) {
+    auto block = partitioned_block.first;
+    auto& segments = partitioned_block.second;
+    for (size_t p = 0; p < segments.size(); p++) {
+      auto& producer = segments[p];
+      if (producer.target() != SegmentedBlock::kTorch) {
+        continue;
+      }
+      bool changed = false;
+      for (size_t i = 0; i < producer.outputs().size(); i++) {
+        auto raw = producer.raw_outputs()[i];
+        auto truncation = producer.outputs()[i]->node();
+        if (!producer.is_truncated_output(raw) || castDType(truncation) != at::kInt ||
+            !canRestoreLong(raw, block, segments, p)) {
+          continue;
+        }
+
+        LOG_DEBUG("Passing " << raw->debugName() << " across segment boundaries as Long instead of casting it to Int");
+        producer.block()->replaceOutput(i, truncation->input(0));
+        changed = true;
+
+        for (size_t c = 0; c < segments.size(); c++) {
+          auto& consumer = segments[c];
+          auto& raw_inputs = consumer.raw_inputs();
+          auto idx = std::find(raw_inputs.begin(), raw_inputs.end(), raw) - raw_inputs.begin();
+          if (c == p || idx == static_cast<int64_t>(raw_inputs.size())) {
+            continue;
+          }
+          if (consumer.target() == SegmentedBlock::kTorch) {
+            // The casts back to Long undo the truncation which is now gone
+            auto in = consumer.inputs()[idx];
+            std::vector<torch::jit::Node*> widenings;
+            for (auto& use : in->uses()) {
+              if (use.offset == 0 && castDType(use.user) == at::kLong) {
+                widenings.push_back(use.user);
+              }
+            }
+            for (auto n : widenings) {
+              n->output()->replaceAllUsesWith(in);
+              n->destroy();
+            }
+            torch::jit::EliminateDeadCode(consumer.g());
+          } else {
+            // The engine takes the Long tensor and casts it in an ICastLayer at the network input
+            auto in_types = consumer.in_types();
+            in_types[tensorInputIndex(consumer, raw).value()] = at::kLong;
+            consumer.register_intypes(in_types);
+          }
+        }
+      }
+      if (changed) {
+        torch::jit::EliminateDeadCode(producer.g());
+      }
+    }
+  }
+}
+
+} // namespace partitioning
+} // namespace core
+} // namespace torch_tensorrt
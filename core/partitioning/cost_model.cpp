@@ -0,0 +1,115 @@
+#include <unordered_set>
+
+#include "core/partitioning/partitioning.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace partitioning {
+namespace {
+
+// Fixed cost of a TensorRT segment in microseconds: engine enqueue, a stream sync with Torch and the packing of its
+// inputs and outputs
+constexpr double kSegmentOverheadUs = 20.0;
+// Cost of each tensor crossing a Torch <-> TensorRT boundary, for its binding and the casts and copies it may need
+constexpr double kBoundaryTensorCostUs = 3.0;
+// Kernel launch saved by ops which TensorRT fuses into a neighbouring kernel
+constexpr double kFusedOpSavingsUs = 5.0;
+
+// Latency saved per op when run in TensorRT instead of Torch, for ops which differ from kFusedOpSavingsUs
+const std::unordered_map<std::string, double>& defaultOpSavings() {
+  static const std::unordered_map<std::string, double> savings = {
+      // Tactic selection and fused epilogues make the heavy ops the main source of speedup
+      {"aten::_convolution", 50.0},
+      {"aten::conv1d", 50.0},
+      {"aten::conv2d", 50.0},
+      {"aten::conv3d", 50.0},
+      {"aten::conv_transpose2d", 50.0},
+      {"aten::linear", 30.0},
+      {"aten::addmm", 30.0},
+      {"aten::matmul", 30.0},
+      {"aten::mm", 30.0},
+      {"aten::bmm", 30.0},
+      {"aten::baddbmm", 30.0},
+      {"aten::einsum", 30.0},
+      {"aten::scaled_dot_product_attention", 60.0},
+      {"aten::lstm", 60.0},
+      {"aten::gru", 60.0},
+      {"aten::batch_norm", 10.0},
+      {"aten::layer_norm", 10.0},
+      {"aten::softmax", 10.0},
+      {"aten::max_pool2d", 10.0},
+      {"aten::avg_pool2d", 10.0},
+      {"aten::adaptive_avg_pool2d", 10.0},
+      // Views and shape queries cost next to nothing in Torch
+      {"aten::size", 0.5},
+      {"aten::dim", 0.5},
+      {"aten::view", 1.0},
+      {"aten::reshape", 1.0},
+      {"aten::flatten", 1.0},
+      {"aten::squeeze", 1.0},
+      {"aten::unsqueeze", 1.0},
+      {"aten::permute", 1.0},
+      {"aten::transpose", 1.0},
+      {"aten::t", 1.0},
+      {"aten::select", 1.0},
+      {"aten::slice", 1.0},
+      {"aten::__getitem__", 0.5},
+      {"prim::ListConstruct", 0.5},
+      {"prim::ListUnpack", 0.5},
+      {"prim::TupleConstruct", 0.5},
+      {"prim::TupleUnpack", 0.5},
+      {"prim::NumToTensor", 0.5},
+  };
+  return savings;
+}
+
+double opSavings(const PartitioningInfo& settings, const torch::jit::Node* n) {
+  std::string kind = n->kind().toQualString();
+  auto measured = settings.op_latency_savings_us.find(kind);
+  if (measured != settings.op_latency_savings_us.end()) {
+    return measured->second;
+  }
+  auto estimate = defaultOpSavings().find(kind);
+  return estimate != defaultOpSavings().end() ? estimate->second : kFusedOpSavingsUs;
+}
+
+bool isBoundaryTensor(const torch::jit::Value* v) {
+  return v->type()->isSubtypeOf(c10::TensorType::get()) && v->node()->kind() != torch::jit::prim::Constant;
+}
+
+} // namespace
+
+double estimateSegmentBenefit(const PartitioningInfo& settings, const std::vector<torch::jit::Node*>& nodes) {
+  std::unordered_set<const torch::jit::Node*> segment(nodes.begin(), nodes.end());
+  double savings = 0.0;
+  std::unordered_set<const torch::jit::Value*> boundary_tensors;
+  for (auto n : nodes) {
+    savings += opSavings(settings, n);
+    for (auto in : n->inputs()) {
+      if (isBoundaryTensor(in) && !segment.count(in->node())) {
+        boundary_tensors.insert(in);
+      }
+    }
+    for (auto out : n->outputs()) {
+      if (!isBoundaryTensor(out)) {
+        continue;
+      }
+      for (auto& use : out->uses()) {
+        if (!segment.count(use.user)) {
+          boundary_tensors.insert(out);
+          break;
+        }
+      }
+    }
+  }
+  auto overhead = kSegmentOverheadUs + kBoundaryTensorCostUs * boundary_tensors.size();
+  LOG_GRAPH(
+      "Estimated TensorRT segment of " << nodes.size() << " nodes to save " << savings << "us at a boundary cost of "
+                                       << overhead << "us");
+  return savings - overhead;
+}
+
+} // namespace partitioning
+} // namespace core
+} // namespace torch_tensorrt
@@ -1,6 +1,10 @@
 #include "core/partitioning/partitioning.h"
 #include <queue>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include "core/conversion/conversion.h"
+#include "core/conversion/converters/converters.h"
 #include "core/conversion/evaluators/evaluators.h"
 #include "torch/csrc/jit/passes/constant_pooling.h"
 #include "torch/csrc/jit/passes/dead_code_elimination.h"
@@ -56,12 +60,79 @@ bool checkLoopEvaluatable(torch::jit::Node* n) {
     } else if (bn->kind() == torch::jit::prim::If) {
       compile_to_trt = compile_to_trt && containNonTensorOutputs(bn);
     } else {
-      compile_to_trt = compile_to_trt && core::conversion::evaluators::shouldEvalAtConversionTime(bn);
+      compile_to_trt =
+          compile_to_trt && conversion::GetNodeDispatch(bn) == conversion::NodeDispatch::kEvaluator;
     }
   }
   return compile_to_trt;
 }
 
+bool checkConditionalConvertible(PartitioningCtx* ctx, torch::jit::Node* n);
+bool checkLoopConvertible(PartitioningCtx* ctx, torch::jit::Node* n);
+
+// Whether every node of b can be converted, which lets the control flow node owning b run in TensorRT as a whole
+bool checkBlockConvertible(PartitioningCtx* ctx, torch::jit::Block* b) {
+  const auto to_compile_sym = c10::Symbol::attr("to_compile");
+  for (auto bn : b->nodes()) {
+    if (bn->kind() == torch::jit::prim::Constant) {
+      continue;
+    }
+    bool convertible = false;
+    if (bn->kind() == torch::jit::prim::Loop) {
+      convertible = checkLoopEvaluatable(bn) || checkLoopConvertible(ctx, bn);
+    } else if (bn->kind() == torch::jit::prim::If) {
+      convertible = checkConditionalConvertible(ctx, bn);
+    } else {
+      convertible = conversion::OpSupported(bn) &&
+          ctx->forced_fallback_ops.find(bn->kind().toQualString()) == ctx->forced_fallback_ops.end() &&
+          !(bn->hasAttribute(to_compile_sym) && bn->i(to_compile_sym) == (int64_t) false);
+    }
+    if (!convertible) {
+      LOG_DEBUG("Node " << util::node_info(bn) << " keeps " << util::node_info(b->owningNode()) << " out of TensorRT");
+      return false;
+    }
+  }
+  return true;
+}
+
+// Conditionals producing tensors whose branches convert become TensorRT conditionals, or are evaluated during
+// conversion if the condition is known then
+bool checkConditionalConvertible(PartitioningCtx* ctx, torch::jit::Node* n) {
+  if (n->outputs().empty() || containNonTensorOutputs(n)) {
+    return false;
+  }
+  for (auto b : n->blocks()) {
+    if (!checkBlockConvertible(ctx, b)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Counted loops carrying tensors whose body converts become TensorRT loops. The body may not update the loop condition
+// or read the iteration count
+bool checkLoopConvertible(PartitioningCtx* ctx, torch::jit::Node* n) {
+  auto body = n->blocks()[0];
+  auto body_cond = torch::jit::toIValue(body->outputs()[0]);
+  if (!body_cond || !body_cond->isBool() || !body_cond->toBool() || !body->inputs()[0]->uses().empty()) {
+    return false;
+  }
+  if (n->outputs().empty() || containNonTensorOutputs(n)) {
+    return false;
+  }
+  return checkBlockConvertible(ctx, body);
+}
+
+// Whether b is nested in a control flow node that runs in TensorRT as a whole, such blocks are not partitioned
+bool isInConvertedControlFlow(PartitioningCtx* ctx, torch::jit::Block* b) {
+  for (auto owner = b->owningNode(); owner; owner = owner->owningBlock()->owningNode()) {
+    if (ctx->shouldNodeRunInTensorRT(owner)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // Find and set all explicit fallback nodes (nodes that are unsupported or forced fallback)
 // we use a map to indicate the reason why it's fallback to torch
 // For any node that's not explicitly fallback, we set it to run in TensorRT for now
@@ -74,7 +145,9 @@ void setExplicitFallbackNodes(PartitioningCtx* ctx, torch::jit::Block* block) {
       continue;
     }
 
-    if (n->kind() == torch::jit::prim::Loop && checkLoopEvaluatable(n)) {
+    if (n->kind() == torch::jit::prim::Loop && (checkLoopEvaluatable(n) || checkLoopConvertible(ctx, n))) {
+      ctx->setNodeExecutorDecision(n, NodeExecutorDecision::kCONVERT);
+    } else if (n->kind() == torch::jit::prim::If && checkConditionalConvertible(ctx, n)) {
       ctx->setNodeExecutorDecision(n, NodeExecutorDecision::kCONVERT);
     } else if (!conversion::OpSupported(n)) {
       // If the op is not supported by the conversion phase it should run in PyTorch
@@ -93,9 +166,60 @@ void setExplicitFallbackNodes(PartitioningCtx* ctx, torch::jit::Block* block) {
   return;
 }
 
+bool isModifyingNodes(torch::jit::Node* node, torch::jit::Value* val);
+
+// Whether the nonTensor value v, used in block, can be recomputed by a TensorRT segment which consumes it. Every node
+// it is computed from by nonTensor values has to be convertible, their tensor inputs must not be produced by excluded
+// nodes. resolveTRTNonTensorInputs copies these nodes into the consuming segment
+bool isRecomputableInTensorRT(
+    PartitioningCtx* ctx,
+    torch::jit::Block* block,
+    torch::jit::Value* v,
+    const std::unordered_set<torch::jit::Node*>& excluded = {}) {
+  std::queue<torch::jit::Value*> q;
+  q.push(v);
+  std::unordered_set<torch::jit::Node*> visited;
+  while (!q.empty()) {
+    auto cur_val = q.front();
+    q.pop();
+    auto node = cur_val->node();
+    if (isTensor(cur_val)) {
+      if (excluded.count(node)) {
+        return false;
+      }
+      continue;
+    }
+    if (node->kind() == torch::jit::prim::Constant || !visited.insert(node).second) {
+      continue;
+    }
+    auto decision = ctx->node_executor_decision_map.find(node);
+    if (node->owningBlock() != block || decision == ctx->node_executor_decision_map.end() ||
+        !node->blocks().empty() || node->hasSideEffects()) {
+      return false;
+    }
+    // Nodes which fall back for their connections or their segment size convert, explicit fallbacks do not
+    if (decision->second != NodeExecutorDecision::kCONVERT && decision->second != NodeExecutorDecision::kNON_TENSOR &&
+        decision->second != NodeExecutorDecision::kMIN_BLOCK_FALLBACK &&
+        decision->second != NodeExecutorDecision::kCOST_MODEL_FALLBACK) {
+      return false;
+    }
+    for (auto input : node->inputs()) {
+      if (isModifyingNodes(node, input)) {
+        return false;
+      }
+      q.push(input);
+    }
+  }
+  return true;
+}
+
 // For a given set of fallback nodes, check their inputs/outputs, if any inputs/outputs of them are NonTensor,
-// then the nodes that produces/consumes those values should also fallback
-void setNonTensorConnectedNodes(PartitioningCtx* ctx, std::vector<torch::jit::Node*>& initial_fallback_nodes) {
+// then the nodes that produces/consumes those values should also fallback. The nodes this makes fallback are appended
+// to new_fallback_nodes if given
+void setNonTensorConnectedNodes(
+    PartitioningCtx* ctx,
+    std::vector<torch::jit::Node*>& initial_fallback_nodes,
+    std::vector<torch::jit::Node*>* new_fallback_nodes = nullptr) {
   // initial_fallback_nodes are the fallback nodes that we have before we run BFS in this function
   std::queue<torch::jit::Node*> q;
   for (auto& node : initial_fallback_nodes) {
@@ -110,16 +234,28 @@ void setNonTensorConnectedNodes(PartitioningCtx* ctx, std::vector<torch::jit::No
       if (!isTensor(input) && input->node()->kind() != torch::jit::prim::Constant &&
           ctx->shouldNodeRunInTensorRT(input->node())) {
         ctx->setNodeExecutorDecision(input->node(), NodeExecutorDecision::kNON_TENSOR);
+        if (new_fallback_nodes) {
+          new_fallback_nodes->push_back(input->node());
+        }
         q.push(input->node());
       }
     }
     // for every node that consumes this fallback node's NonTensor output, they should fallback too
     for (auto output : cur_node->outputs()) {
+      // unless the output only runs in Torch because of its connections, then TensorRT consumers can recompute it
+      if (!isTensor(output) && ctx->settings.merge_non_tensor_boundaries &&
+          ctx->node_executor_decision_map[cur_node] == NodeExecutorDecision::kNON_TENSOR &&
+          isRecomputableInTensorRT(ctx, cur_node->owningBlock(), output)) {
+        continue;
+      }
       if (!isTensor(output)) {
         for (auto use : output->uses()) {
           auto node = use.user;
           if (node->kind() != torch::jit::prim::Constant && ctx->shouldNodeRunInTensorRT(node)) {
             ctx->setNodeExecutorDecision(node, NodeExecutorDecision::kNON_TENSOR);
+            if (new_fallback_nodes) {
+              new_fallback_nodes->push_back(node);
+            }
             q.push(node);
           }
         }
@@ -132,7 +268,12 @@ std::set<torch::jit::Node*> getDependentNodes(torch::jit::Node* n) {
   std::set<torch::jit::Node*> dependent_nodes;
   for (auto val : n->outputs()) {
     for (auto use : val->uses()) {
-      dependent_nodes.insert(use.user);
+      // A use inside the blocks of a control flow node makes the control flow node itself dependent
+      auto user = use.user;
+      while (user->owningBlock() != n->owningBlock() && user->owningBlock()->owningNode()) {
+        user = user->owningBlock()->owningNode();
+      }
+      dependent_nodes.insert(user);
     }
   }
   if (const auto* schema = n->maybeSchema()) {
@@ -151,25 +292,61 @@ std::set<torch::jit::Node*> getDependentNodes(torch::jit::Node* n) {
   return dependent_nodes;
 }
 
-// Sub-function that traverses the entire block and check if TensorRT node sequence satisfy min_block_size
-std::vector<torch::jit::Node*> traverseNodesForMinBlockSize(PartitioningCtx* ctx, torch::jit::Block* block) {
-  auto nodes = block->nodes();
+// Whether a sequence of TensorRT nodes is converted: it holds at least min_block_size nodes or, with the cost model,
+// its estimated savings outweigh the overhead of its boundaries
+bool isWorthConverting(PartitioningCtx* ctx, const std::vector<torch::jit::Node*>& nodes) {
+  if (nodes.empty()) {
+    return false;
+  }
+  if (ctx->settings.cost_model_partitioning) {
+    return estimateSegmentBenefit(ctx->settings, nodes) > 0.0;
+  }
+  return nodes.size() >= ctx->settings.min_block_size;
+}
+
+// Non constant nodes of a block in order, with the positions between them the min_block_size traversal reaches
+// without an open TensorRT node sequence, from which it can be resumed
+struct MinBlockTraversal {
+  std::vector<torch::jit::Node*> nodes;
+  std::unordered_map<torch::jit::Node*, size_t> positions;
+  std::vector<std::set<torch::jit::Node*>> dependent_nodes;
+  std::set<size_t> boundaries;
+};
+
+// Sub-function that traverses the block and check if TensorRT node sequence satisfy min_block_size. Only the part of
+// the block whose fallback decisions changed is traversed again: starting at the last boundary before the first dirty
+// position, up to the first boundary of the previous traversal after the dirty positions passed, from which on the
+// traversal would find the same sequences as before
+std::vector<torch::jit::Node*> traverseNodesForMinBlockSize(
+    PartitioningCtx* ctx,
+    MinBlockTraversal& traversal,
+    std::set<size_t>& dirty) {
+  auto begin = *std::prev(traversal.boundaries.upper_bound(*dirty.begin()));
+  auto last_dirty = begin;
   std::vector<torch::jit::Node*> cur_trt_nodes;
   std::unordered_set<torch::jit::Node*> cur_trt_nodes_uses;
   std::vector<torch::jit::Node*> min_block_fallback_nodes;
-  for (const auto n : nodes) {
-    if (n->kind() == torch::jit::prim::Constant) {
-      continue;
+  for (auto i = begin; i < traversal.nodes.size(); i++) {
+    if (dirty.erase(i)) {
+      last_dirty = i;
+    }
+    if (cur_trt_nodes.empty()) {
+      if (i > last_dirty && traversal.boundaries.count(i)) {
+        return min_block_fallback_nodes;
+      }
+      traversal.boundaries.insert(i);
+    } else {
+      traversal.boundaries.erase(i);
     }
 
     // check if current node fallback or not
+    auto n = traversal.nodes[i];
     if (!ctx->shouldNodeRunInTorch(n)) {
       cur_trt_nodes.push_back(n);
-      auto dependent_nodes = getDependentNodes(n);
-      cur_trt_nodes_uses.insert(dependent_nodes.begin(), dependent_nodes.end());
+      cur_trt_nodes_uses.insert(traversal.dependent_nodes[i].begin(), traversal.dependent_nodes[i].end());
     } else {
       if (cur_trt_nodes_uses.count(n)) {
-        if (cur_trt_nodes.size() < ctx->settings.min_block_size) {
+        if (!isWorthConverting(ctx, cur_trt_nodes)) {
           min_block_fallback_nodes.insert(min_block_fallback_nodes.end(), cur_trt_nodes.begin(), cur_trt_nodes.end());
         }
         cur_trt_nodes.clear();
@@ -177,26 +354,94 @@ std::vector<torch::jit::Node*> traverseNodesForMinBlockSize(PartitioningCtx* ctx
       }
     }
   }
-  if (cur_trt_nodes.size() < ctx->settings.min_block_size) {
+  if (!cur_trt_nodes.empty() && !isWorthConverting(ctx, cur_trt_nodes)) {
     min_block_fallback_nodes.insert(min_block_fallback_nodes.end(), cur_trt_nodes.begin(), cur_trt_nodes.end());
   }
   return min_block_fallback_nodes;
 }
 
+bool isInputDynamic(PartitioningCtx* ctx);
+
+// Keeps unsupported nodes which the TorchOp plugin can run in TensorRT when they sit between two runs of TensorRT
+// nodes that are each worth converting, so one node does not cost two extra engines and the copies at their boundaries
+void setBridgedUnsupportedNodes(PartitioningCtx* ctx, torch::jit::Block* block) {
+  if (!ctx->settings.bridge_unsupported_ops) {
+    return;
+  }
+  if (isInputDynamic(ctx)) {
+    LOG_DEBUG("Unsupported nodes are not bridged with the TorchOp plugin since the inputs have dynamic shapes");
+    return;
+  }
+  std::vector<torch::jit::Node*> nodes;
+  for (const auto n : block->nodes()) {
+    if (n->kind() != torch::jit::prim::Constant) {
+      nodes.push_back(n);
+    }
+  }
+
+  // TensorRT nodes right before the current node, including the nodes bridged so far
+  std::vector<torch::jit::Node*> trt_run;
+  for (size_t i = 0; i < nodes.size(); i++) {
+    auto n = nodes[i];
+    if (ctx->shouldNodeRunInTensorRT(n)) {
+      trt_run.push_back(n);
+      continue;
+    }
+    if (ctx->node_executor_decision_map[n] == NodeExecutorDecision::kUNSUPPORTED &&
+        conversion::converters::torch_op_plugin_supports(n) && isWorthConverting(ctx, trt_run)) {
+      std::vector<torch::jit::Node*> next_trt_run;
+      for (size_t j = i + 1; j < nodes.size() && ctx->shouldNodeRunInTensorRT(nodes[j]); j++) {
+        next_trt_run.push_back(nodes[j]);
+      }
+      if (isWorthConverting(ctx, next_trt_run)) {
+        LOG_DEBUG("Bridging " << util::node_info(n) << " with the TorchOp plugin");
+        n->i_(conversion::converters::kTorchOpPluginAttr, 1);
+        ctx->setNodeExecutorDecision(n, NodeExecutorDecision::kCONVERT);
+        trt_run.push_back(n);
+        continue;
+      }
+    }
+    trt_run.clear();
+  }
+}
+
 // Set the nodes that fallback because of min_block_size
 void setMinBlockFallbackNodes(PartitioningCtx* ctx, torch::jit::Block* block) {
-  // first traverse all the nodes to find the initial nodes that don't meet the min_block_size requirement
-  auto min_block_fallback_nodes = traverseNodesForMinBlockSize(ctx, block);
+  MinBlockTraversal traversal;
+  for (const auto n : block->nodes()) {
+    if (n->kind() != torch::jit::prim::Constant) {
+      traversal.positions[n] = traversal.nodes.size();
+      traversal.nodes.push_back(n);
+      traversal.dependent_nodes.push_back(getDependentNodes(n));
+    }
+  }
+  if (traversal.nodes.empty()) {
+    return;
+  }
 
-  // keep fallback until all segments meet the min_block_size requirement
-  while (!min_block_fallback_nodes.empty()) {
+  // first traverse all the nodes to find the initial nodes that don't meet the min_block_size requirement
+  traversal.boundaries.insert(0);
+  std::set<size_t> dirty = {0};
+  // keep fallback until all segments meet the min_block_size requirement. A sequence falling back only leaves Torch
+  // nodes where it was, so only the nodes falling back because of their NonTensor connections to it change the
+  // sequences around them and are traversed again
+  while (!dirty.empty()) {
+    auto min_block_fallback_nodes = traverseNodesForMinBlockSize(ctx, traversal, dirty);
     for (const auto i : min_block_fallback_nodes) {
-      ctx->setNodeExecutorDecision(i, NodeExecutorDecision::kMIN_BLOCK_FALLBACK);
+      ctx->setNodeExecutorDecision(
+          i,
+          ctx->settings.cost_model_partitioning ? NodeExecutorDecision::kCOST_MODEL_FALLBACK
+                                                : NodeExecutorDecision::kMIN_BLOCK_FALLBACK);
     }
     // find the fallback nodes because of dependency with min_block_size caused fallback nodes
-    setNonTensorConnectedNodes(ctx, min_block_fallback_nodes);
-    // keep traverse the graph until there is no node fallback because of min_block_size
-    min_block_fallback_nodes = traverseNodesForMinBlockSize(ctx, block);
+    std::vector<torch::jit::Node*> non_tensor_fallback_nodes;
+    setNonTensorConnectedNodes(ctx, min_block_fallback_nodes, &non_tensor_fallback_nodes);
+    for (const auto n : non_tensor_fallback_nodes) {
+      auto position = traversal.positions.find(n);
+      if (position != traversal.positions.end()) {
+        dirty.insert(position->second);
+      }
+    }
   }
 }
 
@@ -286,6 +531,15 @@ void resolveTRTNonTensorInputs(PartitioningCtx* ctx, torch::jit::Block* block) {
             dependency_nodes.end(),
             cur_partitioned_block[i].raw_nodes().begin(),
             cur_partitioned_block[i].raw_nodes().end());
+        if (ctx->settings.merge_non_tensor_boundaries) {
+          // Recomputed values may depend on tensors computed in the segment itself, so the nodes keep the order of
+          // the block
+          std::sort(dependency_nodes.begin(), dependency_nodes.end(), [](torch::jit::Node* a, torch::jit::Node* b) {
+            return a->isBefore(b);
+          });
+          dependency_nodes.erase(
+              std::unique(dependency_nodes.begin(), dependency_nodes.end()), dependency_nodes.end());
+        }
         cur_partitioned_block[i] =
             SegmentedBlock(cur_partitioned_block[i].get_id(), SegmentedBlock::kTensorRT, dependency_nodes);
       }
@@ -382,8 +636,11 @@ void setNodeExecutorLUT(PartitioningCtx* ctx, torch::jit::Block* block) {
   auto cur_fallback_nodes = ctx->getNodesRunInTorch();
   setNonTensorConnectedNodes(ctx, cur_fallback_nodes);
 
+  // Fourth, keep the single unsupported nodes between large TensorRT runs in TensorRT with the TorchOp plugin
+  setBridgedUnsupportedNodes(ctx, block);
+
   // Finally, check if all current tensorrt blocks satisfy the min_block_size requirement.
-  // We need to traverse the whole graph many times here
+  // Only the parts of the graph whose nodes fallback meanwhile are traversed again
   setMinBlockFallbackNodes(ctx, block);
 }
 
@@ -440,6 +697,63 @@ PartitionedGraph merge_adjacent_segments_of_same_type(PartitionedGraph& original
   return new_partition;
 }
 
+// Whether seg, a Torch segment, can run after next, a TensorRT segment. next may only use nonTensor values of seg which
+// it can recompute, seg may not have effects next could observe
+bool canRunAfter(
+    PartitioningCtx* ctx,
+    torch::jit::Block* block,
+    const SegmentedBlock& seg,
+    const SegmentedBlock& next) {
+  std::unordered_set<torch::jit::Node*> seg_nodes(seg.raw_nodes().begin(), seg.raw_nodes().end());
+  for (auto n : seg.raw_nodes()) {
+    if (!n->blocks().empty() || n->hasSideEffects()) {
+      return false;
+    }
+    for (auto input : n->inputs()) {
+      if (isModifyingNodes(n, input)) {
+        return false;
+      }
+    }
+  }
+  for (auto input : next.raw_inputs()) {
+    if (!seg_nodes.count(input->node())) {
+      continue;
+    }
+    if (isTensor(input) || !isRecomputableInTensorRT(ctx, block, input, seg_nodes)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Moves Torch segments behind the TensorRT segments which follow them when the TensorRT segment does not depend on
+// them, so the TensorRT segments on either side of the Torch segment merge into one engine
+PartitionedGraph merge_segments_across_non_tensor_boundaries(
+    PartitioningCtx* ctx,
+    torch::jit::Block* block,
+    PartitionedGraph segmented_blocks) {
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (size_t i = 1; i + 1 < segmented_blocks.size(); ++i) {
+      auto& prev = segmented_blocks[i - 1];
+      auto& torch_seg = segmented_blocks[i];
+      auto& next = segmented_blocks[i + 1];
+      if (prev.target() != SegmentedBlock::kTensorRT || torch_seg.target() != SegmentedBlock::kTorch ||
+          next.target() != SegmentedBlock::kTensorRT || torch_seg.do_not_merge() || next.do_not_merge() ||
+          !canRunAfter(ctx, block, torch_seg, next)) {
+        continue;
+      }
+      LOG_DEBUG("Moving Torch segment " << i << " behind the next TensorRT segment to merge the ones around it");
+      std::swap(segmented_blocks[i], segmented_blocks[i + 1]);
+      segmented_blocks = merge_adjacent_segments_of_same_type(segmented_blocks);
+      changed = true;
+      break;
+    }
+  }
+  return segmented_blocks;
+}
+
 void segmentGraph(PartitioningCtx* ctx, torch::jit::Block* block) {
   // Find all the fallback nodes and build execution decision LUT for all nodes
   setNodeExecutorLUT(ctx, block);
@@ -475,13 +789,15 @@ void segmentGraph(PartitioningCtx* ctx, torch::jit::Block* block) {
       if (cur_trt_nodes_uses.count(n)) {
         // If there is an active TRT block that is valid segment and reset the active TRT block
         // otherwise add it to the active PyTorch block and reset
-        if (in_prog_trt_blk_nodes.size() >= ctx->settings.min_block_size) {
+        if (isWorthConverting(ctx, in_prog_trt_blk_nodes)) {
           finalizeNewBlock(segmented_blocks, SegmentedBlock::kTensorRT, in_prog_trt_blk_nodes);
         } else {
           LOG_DEBUG(
-              "In progress TRT block does not meet minimum block size requirements ("
-              << in_prog_trt_blk_nodes.size() << ", expected at least " << ctx->settings.min_block_size
-              << "), therefore folding into in progress PyTorch block");
+              "In progress TRT block of " << in_prog_trt_blk_nodes.size()
+                                          << " nodes does not meet the segment requirements (min_block_size: "
+                                          << ctx->settings.min_block_size << ", cost model: "
+                                          << ctx->settings.cost_model_partitioning
+                                          << "), therefore folding into in progress PyTorch block");
           in_prog_pyt_blk_nodes.insert(
               in_prog_pyt_blk_nodes.end(), in_prog_trt_blk_nodes.begin(), in_prog_trt_blk_nodes.end());
           cur_pyt_nodes_uses.insert(cur_trt_nodes_uses.begin(), cur_trt_nodes_uses.end());
@@ -510,7 +826,7 @@ void segmentGraph(PartitioningCtx* ctx, torch::jit::Block* block) {
 
   // if there is any kTorch nodes left, then either the last nodes are kTorch or last nodes are kTensorRT but num <
   // min_block_size
-  if (in_prog_trt_blk_nodes.size() >= ctx->settings.min_block_size) {
+  if (isWorthConverting(ctx, in_prog_trt_blk_nodes)) {
     finalizeNewBlock(segmented_blocks, SegmentedBlock::kTensorRT, in_prog_trt_blk_nodes);
   }
 
@@ -521,6 +837,9 @@ void segmentGraph(PartitioningCtx* ctx, torch::jit::Block* block) {
   }
 
   segmented_blocks = merge_adjacent_segments_of_same_type(segmented_blocks);
+  if (ctx->settings.merge_non_tensor_boundaries) {
+    segmented_blocks = merge_segments_across_non_tensor_boundaries(ctx, block, segmented_blocks);
+  }
   ctx->partitioned_blocks.insert({block, segmented_blocks});
   return;
 }
@@ -565,6 +884,8 @@ void populateInputIValues(PartitioningCtx* ctx) {
 }
 
 void partition(PartitioningCtx* ctx, bool expect_full_compilation) {
+  TORCHTRT_NVTX_RANGE("torch_tensorrt::partitioning");
+  TORCHTRT_COMPILE_PHASE("partitioning");
   // If full compilation is expected, overwrite minimum block size
   // Any nonzero block size is valid if full compilation to TRT is desired
   // Override the default min_block_size to ensure all TRT-supported operations are
@@ -577,12 +898,17 @@ void partition(PartitioningCtx* ctx, bool expect_full_compilation) {
           << "disregarding min_block_size.");
     }
     ctx->settings.min_block_size = 1;
+    ctx->settings.cost_model_partitioning = false;
   }
 
   LOG_DEBUG(ctx->settings);
 
   // Go through all the blocks to do the partitioning
   for (torch::jit::Block* block : ctx->original_blocks) {
+    if (isInConvertedControlFlow(ctx, block)) {
+      LOG_DEBUG("Block of " << util::node_info(block->owningNode()) << " is converted with its control flow node");
+      continue;
+    }
     // segment lowering global graph into blocks
     segmentGraph(ctx, block);
 
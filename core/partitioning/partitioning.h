@@ -3,6 +3,7 @@
 #include <iostream>
 #include <vector>
 
+#include "torch/csrc/jit/api/module.h"
 #include "torch/csrc/jit/ir/ir.h"
 
 #include "core/ir/ir.h"
@@ -45,12 +46,70 @@ void runShapeAnalysis(
     ExampleIValues& ivalues_maps,
     const ir::ShapeMode& shape_mode);
 
+// Wraps the graph of seg_block in a module which runs it in Torch
+torch::jit::script::Module buildSegmentModule(SegmentedBlock& seg_block);
+
+// Runs mod, built from seg_block, on the values of the segment's raw inputs in ivalues_maps and records the values of
+// its raw outputs there
+void runSegmentModule(torch::jit::script::Module& mod, SegmentedBlock& seg_block, ExampleIValues& ivalues_maps);
+
 void segmentGraph(PartitioningCtx* ctx, torch::jit::Block* block);
 
+// Estimated latency in microseconds saved by running nodes as one TensorRT segment instead of in Torch, less the cost
+// of the segment and of the tensors crossing its boundaries. Negative if the segment is not worth converting
+double estimateSegmentBenefit(const PartitioningInfo& settings, const std::vector<torch::jit::Node*>& nodes);
+
 GraphAndMapping stitch(PartitioningCtx* ctx, torch::jit::Block* block);
 
+const c10::Symbol kExecuteEngine = c10::Symbol::fromQualString("tensorrt::execute_engine");
+
+// An engine of the stitched graph: ListConstruct(inputs) -> tensorrt::execute_engine -> ListUnpack(outputs)
+struct EngineNodes {
+  torch::jit::Node* inputs;
+  torch::jit::Node* execute;
+  torch::jit::Node* outputs;
+};
+
+c10::optional<EngineNodes> matchEngine(torch::jit::Node* n);
+
+// Spreads the TensorRT engines of the top level block of a stitched graph over settings.concurrent_segment_streams
+// streams, so that engines which do not depend on each other run concurrently, and joins each stream back to the
+// caller's stream before the first node using its outputs. Returns the number of engines scheduled, 0 if the graph
+// has fewer than two
+size_t scheduleSegmentStreams(std::shared_ptr<torch::jit::Graph>& g, const PartitioningInfo& settings);
+
+// Output output of the step-th engine (in execution order) of the top level block of a stitched graph, which is only
+// read by the engines up to step last_use
+struct PlannedActivation {
+  int64_t step;
+  int64_t output;
+  int64_t last_use;
+};
+
+// Finds the engine outputs of the top level block of a stitched graph which are only consumed by later engines and
+// moves the engines producing them to tensorrt::execute_engine_in_arena, with the SegmentActivationArena held by the
+// module attribute arena_name, so that these outputs are placed in one preallocated arena. Returns the activations
+// the arena has to be planned for, the graph is left as is if there are none
+std::vector<PlannedActivation> planSegmentActivations(
+    std::shared_ptr<torch::jit::Graph>& g,
+    const std::string& arena_name);
+
 void partition(PartitioningCtx* ctx, bool expect_full_compilation = false);
 
+// Copy of the graph of a Torch segment with its inputs typed for the opt shapes and types from shape analysis on
+// device, if all of its nodes can be compiled into a single NNC kernel. nullptr otherwise, or if the segment has
+// fewer than two ops
+std::shared_ptr<torch::jit::Graph> fusibleTorchSegmentGraph(SegmentedBlock& seg, const at::Device& device);
+
+// Drops the Long to Int truncation of Torch segment outputs when every consumer takes the Long tensor as is: Torch
+// segments lose their cast back to Long and, from TensorRT 10, engines cast the Int64 input in the network
+void eliminateBoundaryCasts(PartitioningCtx* ctx);
+
+// Passes large weights which are read by several TensorRT segments of a block, e.g. tied input and output embeddings
+// split by a fallback op, to these segments as an input instead of freezing a copy into each of their engines, so one
+// device copy held by the stitched graph is bound to all of them. Returns the number of weights shared
+size_t shareSegmentWeights(PartitioningCtx* ctx);
+
 } // namespace partitioning
 } // namespace core
 } // namespace torch_tensorrt
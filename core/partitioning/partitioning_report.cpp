@@ -0,0 +1,365 @@
+#include <algorithm>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "c10/core/ScalarType.h"
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/passes/shape_analysis.h"
+
+#include "core/partitioning/partitioning_report.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace partitioning {
+namespace {
+
+const char* decisionName(NodeExecutorDecision decision) {
+  switch (decision) {
+    case kUNSUPPORTED:
+      return "unsupported";
+    case kOPERATOR_FALLBACK:
+      return "operator_fallback";
+    case kMODULE_FALLBACK:
+      return "module_fallback";
+    case kMIN_BLOCK_FALLBACK:
+      return "min_block_fallback";
+    case kCOST_MODEL_FALLBACK:
+      return "cost_model_fallback";
+    case kNON_TENSOR:
+      return "non_tensor";
+    case kCONVERT:
+      return "convert";
+    case kUNKNOWN:
+    default:
+      return "unknown";
+  }
+}
+
+std::string escape(const std::string& s) {
+  std::string escaped;
+  for (auto c : s) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (c == '\n') {
+      escaped += "\\n";
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped += ' ';
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+bool isTensor(const torch::jit::Value* v) {
+  return v->type()->isSubtypeOf(c10::TensorType::get());
+}
+
+bool isCast(const torch::jit::Node* n) {
+  return n->kind() == torch::jit::aten::to;
+}
+
+// Casts shape analysis appended to the producer and prepended to a Torch consumer, found as casts of the segment
+// graphs which have no counterpart in the original nodes
+int64_t insertedCasts(
+    SegmentedBlock& producer,
+    SegmentedBlock& consumer,
+    size_t consumer_input,
+    torch::jit::Value* raw) {
+  int64_t casts = 0;
+  auto& raw_outputs = producer.raw_outputs();
+  for (size_t i = 0; i < raw_outputs.size(); i++) {
+    if (raw_outputs[i] == raw && isCast(producer.outputs()[i]->node()) && !isCast(raw->node())) {
+      casts++;
+    }
+  }
+  if (consumer.target() == SegmentedBlock::kTorch && consumer_input < consumer.inputs().size()) {
+    std::unordered_set<const torch::jit::Node*> raw_nodes(consumer.raw_nodes().begin(), consumer.raw_nodes().end());
+    for (auto& use : consumer.inputs()[consumer_input]->uses()) {
+      casts += isCast(use.user);
+    }
+    for (auto& use : raw->uses()) {
+      casts -= isCast(use.user) && raw_nodes.count(use.user);
+    }
+  }
+  return std::max<int64_t>(casts, 0);
+}
+
+int64_t product(const std::vector<int64_t>& sizes, size_t begin = 0) {
+  int64_t p = 1;
+  for (size_t i = begin; i < sizes.size(); i++) {
+    p *= sizes[i];
+  }
+  return p;
+}
+
+c10::optional<std::vector<int64_t>> concreteSizes(const torch::jit::Value* v) {
+  auto type = v->type()->cast<c10::TensorType>();
+  return type ? type->sizes().concrete_sizes() : c10::nullopt;
+}
+
+// Multiply-accumulates per output element of convolutions and matrix multiplications, 0 for other ops
+int64_t macsPerOutput(const torch::jit::Node* n) {
+  auto kind = n->kind();
+  if (kind == torch::jit::aten::_convolution || kind == torch::jit::aten::conv1d || kind == torch::jit::aten::conv2d ||
+      kind == torch::jit::aten::conv3d) {
+    // Weights are [out channels, in channels / groups, kernel...]
+    auto weight = concreteSizes(n->input(1));
+    return weight && weight->size() > 1 ? product(*weight, 1) : 0;
+  }
+  // Reduced over the last dimension of the first matrix
+  const torch::jit::Value* lhs = nullptr;
+  if (kind == torch::jit::aten::matmul || kind == torch::jit::aten::mm || kind == torch::jit::aten::bmm ||
+      kind == torch::jit::aten::linear) {
+    lhs = n->input(0);
+  } else if (kind == torch::jit::aten::addmm || kind == torch::jit::aten::baddbmm) {
+    lhs = n->input(1);
+  }
+  auto lhs_sizes = lhs ? concreteSizes(lhs) : c10::nullopt;
+  return lhs_sizes && !lhs_sizes->empty() ? lhs_sizes->back() : 0;
+}
+
+// Copy of the segment graph with the opt input shapes propagated through it, nullptr if they cannot be
+std::shared_ptr<torch::jit::Graph> propagateOptShapes(SegmentedBlock& seg) {
+  auto g = seg.g()->copy();
+  auto shapes = seg.in_opt_shapes();
+  auto& types = seg.in_types();
+  size_t tensor_idx = 0;
+  for (auto in : g->inputs()) {
+    if (!isTensor(in)) {
+      continue;
+    }
+    if (tensor_idx < shapes.size() && tensor_idx < types.size()) {
+      in->setType(c10::TensorType::createContiguous(types[tensor_idx], at::kCUDA, shapes[tensor_idx]));
+    }
+    tensor_idx++;
+  }
+  try {
+    torch::jit::PropagateInputShapes(g);
+  } catch (const std::exception& e) {
+    LOG_DEBUG("Unable to propagate the shapes of segment graph: " << e.what());
+    return nullptr;
+  }
+  return g;
+}
+
+// Nodes whose output shape stays unknown count nothing
+double estimateFlops(SegmentedBlock& seg) {
+  auto g = propagateOptShapes(seg);
+  if (!g) {
+    return 0;
+  }
+  double flops = 0;
+  for (auto n : g->nodes()) {
+    if (n->kind() == torch::jit::prim::Constant || n->outputs().empty()) {
+      continue;
+    }
+    auto out = concreteSizes(n->output(0));
+    if (!out) {
+      continue;
+    }
+    auto macs = macsPerOutput(n);
+    flops += static_cast<double>(product(*out)) * (macs ? 2 * macs : 1);
+  }
+  return flops;
+}
+
+int64_t weightBytes(SegmentedBlock& seg) {
+  int64_t bytes = 0;
+  for (auto n : seg.g()->nodes()) {
+    if (n->kind() == torch::jit::prim::Constant && isTensor(n->output())) {
+      auto weight = torch::jit::toIValue(n->output());
+      if (weight && weight->isTensor()) {
+        bytes += static_cast<int64_t>(weight->toTensor().nbytes());
+      }
+    }
+  }
+  return bytes;
+}
+
+} // namespace
+
+int64_t estimateActivationBytes(SegmentedBlock& seg) {
+  auto g = propagateOptShapes(seg);
+  if (!g) {
+    return 0;
+  }
+  int64_t bytes = 0;
+  for (auto n : g->nodes()) {
+    if (n->kind() == torch::jit::prim::Constant) {
+      continue;
+    }
+    for (auto out : n->outputs()) {
+      auto type = out->type()->cast<c10::TensorType>();
+      auto sizes = type ? type->sizes().concrete_sizes() : c10::nullopt;
+      if (sizes && type->scalarType()) {
+        bytes += product(*sizes) * static_cast<int64_t>(c10::elementSize(*type->scalarType()));
+      }
+    }
+  }
+  return bytes;
+}
+
+PartitioningReport generatePartitioningReport(PartitioningCtx* ctx) {
+  PartitioningReport report;
+  for (auto block : ctx->original_blocks) {
+    auto partitioned = ctx->partitioned_blocks.find(block);
+    if (partitioned == ctx->partitioned_blocks.end()) {
+      continue;
+    }
+    auto& segments = partitioned->second;
+    BlockReport block_report;
+    block_report.owner = block->owningNode() ? util::node_info(block->owningNode()) : "graph";
+
+    std::unordered_map<const torch::jit::Value*, size_t> producers;
+    for (size_t s = 0; s < segments.size(); s++) {
+      for (auto out : segments[s].raw_outputs()) {
+        producers[out] = s;
+      }
+    }
+
+    std::vector<int64_t> segment_boundary_bytes(segments.size(), 0);
+    for (size_t s = 0; s < segments.size(); s++) {
+      auto& seg = segments[s];
+      SegmentReport seg_report;
+      seg_report.id = s;
+      seg_report.target = seg.target();
+      seg_report.num_nodes = seg.raw_nodes().size();
+      seg_report.flops = estimateFlops(seg);
+      if (seg.target() == SegmentedBlock::kTensorRT) {
+        seg_report.weight_bytes = weightBytes(seg);
+      }
+
+      // Shapes and types are registered for the tensor inputs, in order
+      auto shapes = seg.in_opt_shapes();
+      auto& types = seg.in_types();
+      size_t tensor_idx = 0;
+      for (size_t i = 0; i < seg.raw_inputs().size(); i++) {
+        auto raw = seg.raw_inputs()[i];
+        if (!isTensor(raw)) {
+          continue;
+        }
+        BoundaryTensorReport in;
+        in.name = raw->debugName();
+        auto producer = producers.find(raw);
+        if (producer != producers.end()) {
+          in.producer = static_cast<int64_t>(producer->second);
+          in.crossing = segments[producer->second].target() != seg.target();
+          in.casts = insertedCasts(segments[producer->second], seg, i, raw);
+        }
+        if (tensor_idx < shapes.size() && tensor_idx < types.size()) {
+          in.shape = shapes[tensor_idx];
+          in.dtype = types[tensor_idx];
+          int64_t numel = 1;
+          for (auto d : in.shape) {
+            numel *= d;
+          }
+          in.bytes = numel * static_cast<int64_t>(c10::elementSize(in.dtype));
+        }
+        tensor_idx++;
+
+        if (in.crossing) {
+          report.num_boundaries++;
+          report.boundary_bytes += in.bytes;
+          report.boundary_casts += in.casts;
+          segment_boundary_bytes[s] += in.bytes;
+          segment_boundary_bytes[in.producer] += in.bytes;
+        }
+        seg_report.inputs.push_back(in);
+      }
+
+      if (seg.target() == SegmentedBlock::kTorch) {
+        for (auto n : seg.raw_nodes()) {
+          auto decision = ctx->node_executor_decision_map.find(n);
+          NodeReport node_report;
+          node_report.node = util::node_info(n);
+          node_report.kind = n->kind().toQualString();
+          node_report.decision =
+              decision != ctx->node_executor_decision_map.end() ? decision->second : NodeExecutorDecision::kUNKNOWN;
+          seg_report.fallback_nodes.push_back(node_report);
+        }
+      }
+      block_report.segments.push_back(seg_report);
+    }
+
+    for (auto& seg_report : block_report.segments) {
+      std::unordered_set<std::string> kinds;
+      for (auto& n : seg_report.fallback_nodes) {
+        auto& op = report.fallback_ops[n.kind];
+        op.num_nodes++;
+        op.decisions[n.decision]++;
+        if (kinds.insert(n.kind).second) {
+          op.num_segments++;
+          op.boundary_bytes += segment_boundary_bytes[seg_report.id];
+        }
+      }
+    }
+    report.blocks.push_back(block_report);
+  }
+  return report;
+}
+
+std::ostream& operator<<(std::ostream& os, const PartitioningReport& r) {
+  os << "{\n  \"num_boundaries\": " << r.num_boundaries << ",\n  \"boundary_bytes\": " << r.boundary_bytes
+     << ",\n  \"boundary_casts\": " << r.boundary_casts << ",\n  \"fallback_ops\": {";
+  bool first_op = true;
+  for (auto& op : r.fallback_ops) {
+    os << (first_op ? "" : ",") << "\n    \"" << escape(op.first) << "\": {\"num_nodes\": " << op.second.num_nodes
+       << ", \"num_segments\": " << op.second.num_segments << ", \"boundary_bytes\": " << op.second.boundary_bytes
+       << ", \"decisions\": {";
+    bool first_decision = true;
+    for (auto& d : op.second.decisions) {
+      os << (first_decision ? "" : ", ") << "\"" << decisionName(d.first) << "\": " << d.second;
+      first_decision = false;
+    }
+    os << "}}";
+    first_op = false;
+  }
+  os << "\n  },\n  \"blocks\": [";
+  for (size_t b = 0; b < r.blocks.size(); b++) {
+    auto& block = r.blocks[b];
+    os << (b ? "," : "") << "\n    {\"owner\": \"" << escape(block.owner) << "\", \"segments\": [";
+    for (size_t s = 0; s < block.segments.size(); s++) {
+      auto& seg = block.segments[s];
+      os << (s ? "," : "") << "\n      {\"id\": " << seg.id << ", \"target\": \""
+         << SegmentedBlock::target_to_str(seg.target) << "\", \"num_nodes\": " << seg.num_nodes
+         << ", \"flops\": " << seg.flops << ", \"weight_bytes\": " << seg.weight_bytes << ", \"inputs\": [";
+      for (size_t i = 0; i < seg.inputs.size(); i++) {
+        auto& in = seg.inputs[i];
+        os << (i ? "," : "") << "\n        {\"name\": \"" << escape(in.name) << "\", \"producer\": " << in.producer
+           << ", \"crossing\": " << (in.crossing ? "true" : "false") << ", \"shape\": [";
+        for (size_t d = 0; d < in.shape.size(); d++) {
+          os << (d ? ", " : "") << in.shape[d];
+        }
+        os << "], \"dtype\": \"" << in.dtype << "\", \"bytes\": " << in.bytes << ", \"casts\": " << in.casts << "}";
+      }
+      os << (seg.inputs.empty() ? "" : "\n      ") << "], \"fallback_nodes\": [";
+      for (size_t n = 0; n < seg.fallback_nodes.size(); n++) {
+        auto& node = seg.fallback_nodes[n];
+        os << (n ? "," : "") << "\n        {\"node\": \"" << escape(node.node) << "\", \"kind\": \""
+           << escape(node.kind) << "\", \"reason\": \"" << decisionName(node.decision) << "\"}";
+      }
+      os << (seg.fallback_nodes.empty() ? "" : "\n      ") << "]}";
+    }
+    os << "\n    ]}";
+  }
+  os << "\n  ]\n}\n";
+  return os;
+}
+
+void writePartitioningReport(const PartitioningReport& r, const std::string& path) {
+  std::ofstream out(path);
+  TORCHTRT_CHECK(out.good(), "Unable to open " << path << " to write the partitioning report");
+  out << r;
+  LOG_INFO(
+      "Wrote the partitioning report to " << path << ": " << r.num_boundaries << " tensors cross Torch <-> TensorRT "
+                                          << "boundaries moving " << r.boundary_bytes << "B with " << r.boundary_casts
+                                          << " casts");
+}
+
+} // namespace partitioning
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "core/partitioning/partitioning.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace partitioning {
+
+// A tensor input of a segment
+struct BoundaryTensorReport {
+  std::string name;
+  // Index of the producing segment in the same block, -1 for inputs of the block
+  int64_t producer = -1;
+  // Produced by a segment of the other target, so the tensor moves between Torch and TensorRT
+  bool crossing = false;
+  std::vector<int64_t> shape; // Shape for the opt input shapes
+  at::ScalarType dtype = at::kFloat;
+  int64_t bytes = 0;
+  // Casts inserted to pass the tensor across the boundary, e.g. truncating Long to Int
+  int64_t casts = 0;
+};
+
+struct NodeReport {
+  std::string node;
+  std::string kind;
+  NodeExecutorDecision decision = kUNKNOWN;
+};
+
+struct SegmentReport {
+  size_t id = 0;
+  SegmentedBlock::SegmentedBlockTarget target = SegmentedBlock::kTorch;
+  size_t num_nodes = 0;
+  // FLOPs at the opt input shapes, estimated from the shapes propagated through the segment graph. Convolutions and
+  // matrix multiplications count two per multiply-accumulate, other ops one per output element
+  double flops = 0;
+  // Bytes of the weights the engine of a TensorRT segment embeds, 0 for Torch segments
+  int64_t weight_bytes = 0;
+  std::vector<BoundaryTensorReport> inputs;
+  // Nodes of Torch segments and why each of them runs in Torch
+  std::vector<NodeReport> fallback_nodes;
+};
+
+struct BlockReport {
+  // "graph" for the top level block, the node owning the block otherwise
+  std::string owner;
+  std::vector<SegmentReport> segments;
+};
+
+// Cost of the nodes of one op kind which run in Torch
+struct FallbackOpReport {
+  int64_t num_nodes = 0;
+  int64_t num_segments = 0;
+  // Bytes crossing the boundaries of the Torch segments containing the op, shared by all ops of those segments
+  int64_t boundary_bytes = 0;
+  std::map<NodeExecutorDecision, int64_t> decisions;
+};
+
+struct PartitioningReport {
+  std::vector<BlockReport> blocks;
+  int64_t num_boundaries = 0;
+  int64_t boundary_bytes = 0;
+  int64_t boundary_casts = 0;
+  std::map<std::string, FallbackOpReport> fallback_ops;
+};
+
+// Bytes of the tensors the nodes of the segment produce at its opt input shapes, propagated like the FLOPs of its
+// report. The tensors are counted as if none of them reused the memory of another, expects shape analysis to have run
+int64_t estimateActivationBytes(SegmentedBlock& seg);
+
+// Summarizes the segments of every partitioned block of ctx, expects shape analysis to have run
+PartitioningReport generatePartitioningReport(PartitioningCtx* ctx);
+
+// Writes the report as JSON
+std::ostream& operator<<(std::ostream& os, const PartitioningReport& r);
+
+void writePartitioningReport(const PartitioningReport& r, const std::string& path);
+
+} // namespace partitioning
+} // namespace core
+} // namespace torch_tensorrt
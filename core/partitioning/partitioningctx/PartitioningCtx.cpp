@@ -91,6 +91,8 @@ std::ostream& operator<<(std::ostream& os, const NodeExecutorDecision& format) {
       return os << "to run torch due to being a member of a module user has requested to run in torch";
     case NodeExecutorDecision::kMIN_BLOCK_FALLBACK:
       return os << "to run torch due owning block not large enough to exceed user specified min_block_size";
+    case NodeExecutorDecision::kCOST_MODEL_FALLBACK:
+      return os << "to run torch due to owning block not saving more latency than its boundaries cost";
     case NodeExecutorDecision::kNON_TENSOR:
       return os << "to run torch due to producing or consuming non-tensor values";
     case NodeExecutorDecision::kCONVERT:
@@ -22,6 +22,9 @@ enum NodeExecutorDecision {
   /// This node is in a TRT segment which does not satisfy min_block_size
   /// and hence is forced to fallback.
   kMIN_BLOCK_FALLBACK,
+  /// This node is in a TRT segment whose estimated savings do not pay for the
+  /// cost of its boundaries and hence is forced to fallback.
+  kCOST_MODEL_FALLBACK,
   /// This node produces/consumes non-tensor inputs
   kNON_TENSOR,
   /// This node is going to be converted
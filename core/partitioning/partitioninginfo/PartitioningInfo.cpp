@@ -14,11 +14,39 @@ std::ostream& operator<<(std::ostream& os, const PartitioningInfo& s) {
   if (s.enabled) {
     os << "True";
     os << "\n    \"min_block_size\": " << s.min_block_size \
-       << "\n    \"torch_executed_operators\": [";
+       << "\n    \"cost_model_partitioning\": " << (s.cost_model_partitioning ? "True" : "False") \
+       << "\n    \"symbolic_shape_analysis\": " << (s.symbolic_shape_analysis ? "True" : "False") \
+       << "\n    \"num_shape_analysis_workers\": " << s.num_shape_analysis_workers \
+       << "\n    \"merge_non_tensor_boundaries\": " << (s.merge_non_tensor_boundaries ? "True" : "False") \
+       << "\n    \"bridge_unsupported_ops\": " << (s.bridge_unsupported_ops ? "True" : "False") \
+       << "\n    \"concurrent_segment_streams\": " << s.concurrent_segment_streams \
+       << "\n    \"overlap_torch_segments\": " << (s.overlap_torch_segments ? "True" : "False") \
+       << "\n    \"share_segment_weights\": " << (s.share_segment_weights ? "True" : "False") \
+       << "\n    \"report_path\": " << s.report_path;
+    if (!s.op_latency_savings_us.empty()) {
+      os << "\n    \"op_latency_savings_us\": {";
+      for (auto& i : s.op_latency_savings_us) {
+        os << "\n        " << i.first << ": " << i.second << ',';
+      }
+      os << "\n     }";
+    }
+    os << "\n    \"torch_executed_operators\": [";
     for (auto i : s.forced_fallback_operators) {
       os <<"\n        " << i << ',';
     }
     os << "\n     ]";
+    if (!s.segment_devices.empty()) {
+      os << "\n    \"segment_devices\": [";
+      for (auto& d : s.segment_devices) {
+        os << "\n        ";
+        if (d.device_type == nvinfer1::DeviceType::kDLA) {
+          os << "DLA:" << d.dla_core << ',';
+        } else {
+          os << "GPU:" << d.gpu_id << ',';
+        }
+      }
+      os << "\n     ]";
+    }
   } else {
     os << "False";
   }
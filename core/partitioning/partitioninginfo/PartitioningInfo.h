@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "core/ir/ir.h"
@@ -14,10 +15,46 @@ struct PartitioningInfo {
   ir::CollectionInputSpecMap collection_input_spec_map;
   bool enabled = false;
   uint64_t min_block_size = 1;
+  // Convert a TensorRT segment only if its estimated latency savings exceed the overhead of its boundaries (engine
+  // launch, syncs, casts, input and output packing) instead of requiring min_block_size nodes
+  bool cost_model_partitioning = false;
+  // Measured latency saved by running an op kind (e.g. "aten::conv2d") in TensorRT, in microseconds, used by the cost
+  // model in place of its built-in estimates
+  std::unordered_map<std::string, double> op_latency_savings_us;
+  // Infer the shapes and dtypes of segment outputs with the TorchScript shape and dtype functions, running only the
+  // segments with outputs those functions cannot resolve instead of every segment for each input shape
+  bool symbolic_shape_analysis = false;
+  // Number of threads running independent segments concurrently during shape analysis, each on a CUDA stream of its
+  // own, 0 uses one per hardware thread
+  int64_t num_shape_analysis_workers = 1;
+  // Keep nodes consuming nonTensor values which only run in Torch because of their connections in TensorRT, where
+  // they are recomputed, and merge the TensorRT segments around Torch segments they do not depend on
+  bool merge_non_tensor_boundaries = false;
+  // Keep a single unsupported node between two runs of TensorRT nodes which are each worth converting in TensorRT,
+  // running its Torch kernel in the engine through the TorchOp plugin, instead of splitting the graph around it. Only
+  // for static input shapes
+  bool bridge_unsupported_ops = false;
+  // Number of CUDA streams the TensorRT segments of the top level block are spread over so that segments which do not
+  // depend on each other run concurrently, 0 or 1 runs them one after another on the caller's stream
+  int64_t concurrent_segment_streams = 0;
+  // Let Torch segments run while TensorRT segments they do not depend on are still executing on other streams, instead
+  // of waiting for all of them first
+  bool overlap_torch_segments = false;
+  // Pass large weights read by several TensorRT segments, e.g. tied embeddings split by a fallback op, to their engines
+  // as inputs bound to one device copy instead of building a copy of them into each engine
+  bool share_segment_weights = false;
+  // When non empty, a JSON report of the segments, their boundary tensors and why each node runs in Torch is written
+  // to this file once shape analysis is done
+  std::string report_path;
   std::vector<std::string> forced_fallback_operators;
   bool truncate_long_and_double;
   ir::Device target_device;
   bool cast_int8_inputs = false;
+  // Device each TensorRT segment of the top level block is built for, in segment order, e.g. a DLA core for the
+  // backbone and the GPU for the rest. Segments past the end of the list and segments of nested blocks are built for
+  // target_device. Every device has to be a DLA core of the target device or a GPU of the same model, segments on
+  // other GPUs form the stages of a pipeline
+  std::vector<ir::Device> segment_devices;
 
   std::string getGPUDeviceString() const {
     return "cuda:" + std::to_string(target_device.gpu_id);
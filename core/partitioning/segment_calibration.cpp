@@ -0,0 +1,274 @@
+#include "core/partitioning/segment_calibration.h"
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace partitioning {
+namespace {
+
+const std::string kCacheHeader = "torchtrt_segment_calibration_cache\n";
+
+// Engine inputs are named input_<i> in conversion::AddInputs
+size_t engine_input_index(const char* name, size_t fallback) {
+  const std::string prefix = "input_";
+  std::string n(name);
+  if (n.compare(0, prefix.size(), prefix) == 0) {
+    try {
+      return std::stoul(n.substr(prefix.size()));
+    } catch (...) {
+    }
+  }
+  return fallback;
+}
+
+// Replays the recorded inputs of one segment to TensorRT with the calibration algorithm of the user calibrator
+template <typename Algorithm>
+class SegmentCalibrator : public Algorithm {
+ public:
+  SegmentCalibrator(SegmentCalibrationData* data, int64_t gpu_id)
+      : data_(data), device_(torch::Device(torch::kCUDA, gpu_id)) {}
+
+  int32_t getBatchSize() const noexcept override {
+    // Explicit batch networks take the batch size from the bindings
+    return 1;
+  }
+
+  bool getBatch(void* bindings[], const char* names[], int32_t nbBindings) noexcept override {
+    try {
+      staged_.clear();
+      if (next_ >= data_->batches.size()) {
+        // Start over in case the calibrator is used again
+        next_ = 0;
+        return false;
+      }
+      auto& batch = data_->batches[next_++];
+      for (size_t i = 0; i < batch.size(); i++) {
+        staged_.push_back(batch[i].to(device_, data_->input_types[i]).contiguous());
+      }
+      for (int32_t b = 0; b < nbBindings; b++) {
+        auto idx = engine_input_index(names[b], b);
+        TORCHTRT_CHECK(
+            idx < staged_.size(),
+            "Calibration data holds " << staged_.size() << " inputs for this segment, no data for " << names[b]);
+        bindings[b] = staged_[idx].data_ptr();
+      }
+      return true;
+    } catch (const std::exception& e) {
+      LOG_ERROR("Failed to feed calibration batch to TensorRT segment: " << e.what());
+      return false;
+    }
+  }
+
+  const void* readCalibrationCache(std::size_t& length) noexcept override {
+    length = data_->cache.size();
+    return length ? data_->cache.data() : nullptr;
+  }
+
+  void writeCalibrationCache(const void* cache, std::size_t length) noexcept override {
+    data_->cache.assign(static_cast<const char*>(cache), length);
+  }
+
+ private:
+  SegmentCalibrationData* data_;
+  torch::Device device_;
+  size_t next_ = 0;
+  // Inputs of the batch TensorRT is reading, kept alive until it asks for the next one
+  std::vector<at::Tensor> staged_;
+};
+
+} // namespace
+
+SharedSegmentCalibration::SharedSegmentCalibration(nvinfer1::IInt8Calibrator* calibrator, size_t num_segments)
+    : user_calibrator_(calibrator), data_(num_segments) {}
+
+SharedSegmentCalibration::~SharedSegmentCalibration() = default;
+
+std::unique_ptr<SharedSegmentCalibration> SharedSegmentCalibration::create(
+    nvinfer1::IInt8Calibrator* calibrator,
+    PartitioningCtx* ctx,
+    torch::jit::Block* block,
+    const std::vector<SegmentedBlock*>& trt_segments,
+    const std::vector<std::vector<at::ScalarType>>& input_types) {
+  if (!calibrator || trt_segments.empty()) {
+    return nullptr;
+  }
+  auto algorithm = calibrator->getAlgorithm();
+  if (algorithm == nvinfer1::CalibrationAlgoType::kLEGACY_CALIBRATION) {
+    LOG_WARNING(
+        "Shared segment calibration does not support the legacy calibrator, calibrating each segment on its own");
+    return nullptr;
+  }
+  for (auto in : block->inputs()) {
+    auto kind = in->type()->kind();
+    if (kind == c10::TypeKind::TupleType || kind == c10::TypeKind::ListType || kind == c10::TypeKind::DictType) {
+      LOG_WARNING(
+          "Shared segment calibration does not support collection input " << in->debugName()
+                                                                           << ", calibrating each segment on its own");
+      return nullptr;
+    }
+  }
+  auto& segments = ctx->partitioned_blocks[block];
+  for (auto seg : trt_segments) {
+    auto in_block = std::any_of(segments.begin(), segments.end(), [&](SegmentedBlock& s) { return &s == seg; });
+    if (!in_block) {
+      LOG_WARNING(
+          "Shared segment calibration only supports TensorRT segments of the top level block, calibrating each "
+          << "segment on its own");
+      return nullptr;
+    }
+  }
+
+  auto shared =
+      std::unique_ptr<SharedSegmentCalibration>(new SharedSegmentCalibration(calibrator, trt_segments.size()));
+  auto gpu_id = ctx->settings.target_device.gpu_id;
+  for (size_t i = 0; i < trt_segments.size(); i++) {
+    auto data = &shared->data_[i];
+    data->input_types = input_types[i];
+    if (algorithm == nvinfer1::CalibrationAlgoType::kENTROPY_CALIBRATION) {
+      shared->calibrators_.push_back(
+          std::make_unique<SegmentCalibrator<nvinfer1::IInt8EntropyCalibrator>>(data, gpu_id));
+    } else if (algorithm == nvinfer1::CalibrationAlgoType::kMINMAX_CALIBRATION) {
+      shared->calibrators_.push_back(
+          std::make_unique<SegmentCalibrator<nvinfer1::IInt8MinMaxCalibrator>>(data, gpu_id));
+    } else {
+      shared->calibrators_.push_back(
+          std::make_unique<SegmentCalibrator<nvinfer1::IInt8EntropyCalibrator2>>(data, gpu_id));
+    }
+  }
+
+  if (!shared->read_cache()) {
+    shared->capture(ctx, block, trt_segments);
+  }
+  return shared;
+}
+
+nvinfer1::IInt8Calibrator* SharedSegmentCalibration::calibrator(size_t i) {
+  TORCHTRT_CHECK(i < calibrators_.size(), "No calibrator for TensorRT segment " << i);
+  return calibrators_[i].get();
+}
+
+bool SharedSegmentCalibration::read_cache() {
+  size_t length = 0;
+  auto cache = static_cast<const char*>(user_calibrator_->readCalibrationCache(length));
+  if (!cache || length == 0) {
+    return false;
+  }
+  std::string contents(cache, length);
+  if (contents.compare(0, kCacheHeader.size(), kCacheHeader) != 0) {
+    LOG_WARNING("Calibration cache was not written by shared segment calibration, recalibrating");
+    return false;
+  }
+
+  std::istringstream ss(contents.substr(kCacheHeader.size()));
+  size_t num_segments = 0;
+  ss >> num_segments;
+  ss.get();
+  if (!ss || num_segments != data_.size()) {
+    LOG_WARNING(
+        "Calibration cache holds " << num_segments << " segments but the graph has " << data_.size()
+                                   << " TensorRT segments, recalibrating");
+    return false;
+  }
+  std::vector<std::string> caches(num_segments);
+  for (auto& c : caches) {
+    size_t size = 0;
+    ss >> size;
+    ss.get();
+    c.resize(size);
+    ss.read(&c[0], size);
+    if (!ss) {
+      LOG_WARNING("Calibration cache is truncated, recalibrating");
+      return false;
+    }
+  }
+  for (size_t i = 0; i < num_segments; i++) {
+    data_[i].cache = std::move(caches[i]);
+  }
+  from_cache_ = true;
+  LOG_INFO("Using the shared calibration cache for " << num_segments << " TensorRT segments");
+  return true;
+}
+
+void SharedSegmentCalibration::capture(
+    PartitioningCtx* ctx,
+    torch::jit::Block* block,
+    const std::vector<SegmentedBlock*>& trt_segments) {
+  TORCHTRT_COMPILE_PHASE("calibration");
+  auto ivalues = ctx->opt_input_ivalues_map;
+
+  // The user calibrator sees the graph inputs under the names they would have in a single engine
+  std::vector<const torch::jit::Value*> graph_inputs;
+  for (auto in : block->inputs()) {
+    if (in->type()->isSubtypeOf(c10::TensorType::get()) && ivalues.count(in)) {
+      graph_inputs.push_back(in);
+    }
+  }
+  std::vector<std::string> names;
+  std::vector<const char*> name_ptrs;
+  for (size_t i = 0; i < graph_inputs.size(); i++) {
+    names.push_back("input_" + std::to_string(i));
+  }
+  for (auto& n : names) {
+    name_ptrs.push_back(n.c_str());
+  }
+  std::vector<void*> bindings(graph_inputs.size(), nullptr);
+
+  auto& segments = ctx->partitioned_blocks[block];
+  std::unordered_map<const SegmentedBlock*, size_t> trt_index;
+  for (size_t i = 0; i < trt_segments.size(); i++) {
+    trt_index[trt_segments[i]] = i;
+  }
+  std::vector<torch::jit::script::Module> modules;
+  for (auto& seg : segments) {
+    modules.push_back(buildSegmentModule(seg));
+  }
+
+  size_t num_batches = 0;
+  while (user_calibrator_->getBatch(bindings.data(), name_ptrs.data(), static_cast<int32_t>(bindings.size()))) {
+    for (size_t i = 0; i < graph_inputs.size(); i++) {
+      auto example = ivalues[graph_inputs[i]].toTensor();
+      ivalues[graph_inputs[i]] = at::from_blob(bindings[i], example.sizes(), example.options()).clone();
+    }
+    for (size_t s = 0; s < segments.size(); s++) {
+      auto trt = trt_index.find(&segments[s]);
+      if (trt != trt_index.end()) {
+        std::vector<at::Tensor> inputs;
+        for (auto in : segments[s].raw_inputs()) {
+          if (in->type()->isSubtypeOf(c10::TensorType::get())) {
+            inputs.push_back(ivalues[in].toTensor().to(at::kCPU));
+          }
+        }
+        data_[trt->second].batches.push_back(std::move(inputs));
+      }
+      runSegmentModule(modules[s], segments[s], ivalues);
+    }
+    num_batches++;
+  }
+  LOG_INFO(
+      "Captured " << num_batches << " calibration batches for " << trt_segments.size()
+                  << " TensorRT segments in a single pass");
+}
+
+void SharedSegmentCalibration::write_cache() {
+  if (from_cache_) {
+    return;
+  }
+  std::ostringstream ss;
+  ss << kCacheHeader << data_.size() << '\n';
+  for (auto& d : data_) {
+    if (d.cache.empty()) {
+      LOG_WARNING("Not every TensorRT segment produced a calibration cache, the shared cache is not written");
+      return;
+    }
+    ss << d.cache.size() << '\n' << d.cache;
+  }
+  auto contents = ss.str();
+  user_calibrator_->writeCalibrationCache(contents.data(), contents.size());
+}
+
+} // namespace partitioning
+} // namespace core
+} // namespace torch_tensorrt
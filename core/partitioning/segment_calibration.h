@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "NvInfer.h"
+#include "core/partitioning/partitioning.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace partitioning {
+
+// Inputs of one TensorRT segment for every calibration batch and the calibration cache of the segment
+struct SegmentCalibrationData {
+  // One entry per batch, the tensors follow the order of the engine inputs and are kept on the host
+  std::vector<std::vector<at::Tensor>> batches;
+  // Types the engine inputs are built with
+  std::vector<at::ScalarType> input_types;
+  // Cache read from the shared calibration cache, or written by TensorRT when the segment is calibrated
+  std::string cache;
+};
+
+// Calibrates all TensorRT segments of a partitioned block from a single pass over the calibration data instead of one
+// per segment. The hybrid graph runs in Torch once for each batch of the user calibrator, recording the inputs of every
+// TensorRT segment, and each segment build replays its own inputs. The per segment caches are kept together in one
+// cache handed to the user calibrator, which lets later compilations skip calibration for every segment
+class SharedSegmentCalibration {
+ public:
+  // Returns nullptr, after logging why, if the segments cannot be calibrated this way (segments in nested blocks,
+  // collection inputs or the legacy calibration algorithm)
+  static std::unique_ptr<SharedSegmentCalibration> create(
+      nvinfer1::IInt8Calibrator* calibrator,
+      PartitioningCtx* ctx,
+      torch::jit::Block* block,
+      const std::vector<SegmentedBlock*>& trt_segments,
+      const std::vector<std::vector<at::ScalarType>>& input_types);
+
+  ~SharedSegmentCalibration();
+
+  // Calibrator the build of the i-th TensorRT segment uses
+  nvinfer1::IInt8Calibrator* calibrator(size_t i);
+
+  // Hands the caches written by the segment builds to the user calibrator as one cache
+  void write_cache();
+
+ private:
+  SharedSegmentCalibration(nvinfer1::IInt8Calibrator* calibrator, size_t num_segments);
+  bool read_cache();
+  void capture(PartitioningCtx* ctx, torch::jit::Block* block, const std::vector<SegmentedBlock*>& trt_segments);
+
+  nvinfer1::IInt8Calibrator* user_calibrator_;
+  std::vector<SegmentCalibrationData> data_;
+  std::vector<std::unique_ptr<nvinfer1::IInt8Calibrator>> calibrators_;
+  bool from_cache_ = false;
+};
+
+} // namespace partitioning
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "torch/csrc/jit/ir/ir.h"
+
+#include "core/partitioning/partitioning.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace partitioning {
+
+c10::optional<EngineNodes> matchEngine(torch::jit::Node* n) {
+  if (n->kind() != kExecuteEngine) {
+    return {};
+  }
+  auto inputs = n->input(0)->node();
+  if (inputs->kind() != torch::jit::prim::ListConstruct || inputs->owningBlock() != n->owningBlock() ||
+      inputs->output()->uses().size() != 1 || n->output()->uses().size() != 1) {
+    return {};
+  }
+  auto outputs = n->output()->uses()[0].user;
+  if (outputs->kind() != torch::jit::prim::ListUnpack || outputs->owningBlock() != n->owningBlock()) {
+    return {};
+  }
+  return EngineNodes{inputs, n, outputs};
+}
+
+namespace {
+
+const c10::Symbol kEnterSegmentStream = c10::Symbol::fromQualString("tensorrt::enter_segment_stream");
+const c10::Symbol kExitSegmentStream = c10::Symbol::fromQualString("tensorrt::exit_segment_stream");
+const c10::Symbol kJoinSegmentStream = c10::Symbol::fromQualString("tensorrt::join_segment_stream");
+
+// Nodes which may change values engines on other streams are still reading, or whose effects have to be ordered
+// after all previous work
+bool needsAllBranches(torch::jit::Node* n) {
+  if (n->hasSideEffects() || !n->blocks().empty()) {
+    return true;
+  }
+  auto schema = n->maybeSchema();
+  if (!schema) {
+    return false;
+  }
+  for (auto& arg : schema->arguments()) {
+    if (arg.alias_info() && arg.alias_info()->isWrite()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Host side nodes which do not read the data of their inputs
+bool isHostOnly(torch::jit::Node* n) {
+  return CollectionNodeKinds.count(n->kind()) || n->kind() == torch::jit::prim::GetAttr;
+}
+
+class SegmentStreamScheduler {
+ public:
+  SegmentStreamScheduler(std::shared_ptr<torch::jit::Graph>& g, const PartitioningInfo& settings)
+      : g(g), settings(settings) {}
+
+  size_t run() {
+    std::vector<EngineNodes> engines;
+    std::unordered_set<torch::jit::Node*> engine_nodes;
+    for (auto n : g->nodes()) {
+      if (auto engine = matchEngine(n)) {
+        engines.push_back(*engine);
+        engine_nodes.insert({engine->inputs, engine->execute, engine->outputs});
+      }
+    }
+    if (engines.size() < 2) {
+      LOG_DEBUG("Less than two TensorRT segments in the hybrid graph, they are not scheduled on separate streams");
+      return 0;
+    }
+
+    std::vector<torch::jit::Node*> nodes(g->nodes().begin(), g->nodes().end());
+    size_t engine_idx = 0;
+    for (auto n : nodes) {
+      if (n->kind() == kExecuteEngine && engine_nodes.count(n)) {
+        schedule(engines[engine_idx++]);
+      } else if (engine_nodes.count(n)) {
+        // The input lists and output unpacks of engines are handled with their engine
+        continue;
+      } else if (needsAllBranches(n) || (!settings.overlap_torch_segments && !isHostOnly(n))) {
+        joinAll(n);
+      } else {
+        joinInputs(n->inputs(), n);
+      }
+    }
+    joinAll(g->return_node());
+    return engines.size();
+  }
+
+ private:
+  void schedule(const EngineNodes& engine) {
+    // An engine consuming the outputs of the last engine of a branch continues that branch, the outputs of earlier
+    // engines are left joined to the caller's stream so that the other consumers of those can run alongside
+    c10::optional<int64_t> branch;
+    std::set<int64_t> input_branches;
+    for (auto in : engine.inputs->inputs()) {
+      auto b = value_branch.find(in);
+      if (b == value_branch.end()) {
+        continue;
+      }
+      input_branches.insert(b->second);
+      if (in->node() == tail[b->second]) {
+        branch = b->second;
+      }
+    }
+    if (!branch || input_branches.size() > 1) {
+      branch = next_branch++ % settings.concurrent_segment_streams;
+    }
+    for (auto b : input_branches) {
+      if (b != *branch) {
+        join(b, engine.inputs);
+      }
+    }
+
+    torch::jit::WithInsertPoint guard(engine.execute);
+    auto branch_id = g->insertConstant(*branch);
+    auto enter = g->insertNode(g->create(kEnterSegmentStream, {engine.execute->input(0), branch_id}));
+    enter->output()->setType(c10::ListType::ofTensors());
+    engine.execute->replaceInput(0, enter->output());
+    auto exit_node = g->create(kExitSegmentStream, {engine.execute->output(), branch_id});
+    exit_node->output()->setType(c10::ListType::ofTensors());
+    exit_node->insertAfter(engine.execute);
+    engine.outputs->replaceInput(0, exit_node->output());
+
+    LOG_GRAPH("Scheduling " << util::node_info(engine.execute) << " on segment stream " << *branch);
+    auto& branch_values = pending[*branch];
+    for (auto out : engine.outputs->outputs()) {
+      value_branch[out] = *branch;
+      branch_values.push_back(out);
+    }
+    tail[*branch] = engine.outputs;
+  }
+
+  void joinInputs(at::ArrayRef<torch::jit::Value*> inputs, torch::jit::Node* before) {
+    std::set<int64_t> branches;
+    for (auto in : inputs) {
+      auto b = value_branch.find(in);
+      if (b != value_branch.end()) {
+        branches.insert(b->second);
+      }
+    }
+    for (auto b : branches) {
+      join(b, before);
+    }
+  }
+
+  void joinAll(torch::jit::Node* before) {
+    auto branches = pending;
+    for (auto& b : branches) {
+      join(b.first, before);
+    }
+  }
+
+  // Waits for branch before the node, the values of the branch are then used through the join
+  void join(int64_t branch, torch::jit::Node* before) {
+    auto values = pending[branch];
+    pending.erase(branch);
+    torch::jit::WithInsertPoint guard(before);
+    auto list = g->insertNode(g->createList(c10::TensorType::get(), values));
+    auto join_node = g->insertNode(g->create(kJoinSegmentStream, {list->output(), g->insertConstant(branch)}));
+    join_node->output()->setType(c10::ListType::ofTensors());
+    auto unpack = g->insertNode(g->createListUnpack(join_node->output(), values.size()));
+    for (size_t i = 0; i < values.size(); i++) {
+      values[i]->replaceAllUsesAfterNodeWith(unpack, unpack->output(i));
+      value_branch.erase(values[i]);
+    }
+  }
+
+  std::shared_ptr<torch::jit::Graph>& g;
+  const PartitioningInfo& settings;
+  int64_t next_branch = 0;
+  // Outputs of engines not joined to the caller's stream yet, by the branch they were produced on
+  std::unordered_map<torch::jit::Value*, int64_t> value_branch;
+  // Branches with work which has not been joined yet and their outputs
+  std::map<int64_t, std::vector<torch::jit::Value*>> pending;
+  // Output unpack of the last engine of each branch
+  std::unordered_map<int64_t, torch::jit::Node*> tail;
+};
+
+} // namespace
+
+size_t scheduleSegmentStreams(std::shared_ptr<torch::jit::Graph>& g, const PartitioningInfo& settings) {
+  if (settings.concurrent_segment_streams < 2) {
+    return 0;
+  }
+  auto num_scheduled = SegmentStreamScheduler(g, settings).run();
+  if (num_scheduled > 0) {
+    LOG_INFO(
+        "Scheduled " << num_scheduled << " TensorRT segments on "
+                     << std::min<int64_t>(settings.concurrent_segment_streams, num_scheduled) << " streams");
+    LOG_GRAPH("Hybrid graph after scheduling segment streams: " << *g);
+  }
+  return num_scheduled;
+}
+
+} // namespace partitioning
+} // namespace core
+} // namespace torch_tensorrt
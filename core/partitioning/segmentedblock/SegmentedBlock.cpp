@@ -36,6 +36,29 @@ void SegmentedBlock::eraseOutput(size_t i) {
   g_->eraseOutput(i);
 }
 
+void SegmentedBlock::promoteConstantToInput(torch::jit::Value* raw_const) {
+  TORCHTRT_CHECK(
+      raw_const->node()->kind() == torch::jit::prim::Constant && old_to_new_.count(raw_const),
+      "Only constants cloned into the segment can become its inputs");
+  auto t = raw_const->node()->t(torch::jit::attr::value);
+  auto clone = old_to_new_[raw_const];
+  auto new_value = g_->block()->addInput();
+  new_value->copyMetadata(raw_const);
+  clone->replaceAllUsesWith(new_value);
+  clone->node()->destroy();
+  inputs_.push_back(raw_const);
+  old_to_new_[raw_const] = new_value;
+
+  // Shapes and types are registered per tensor input, in the order of the inputs
+  auto num_tensor_inputs = in_types_.size();
+  for (auto shapes : {&min_shapes_, &opt_shapes_, &max_shapes_}) {
+    if (shapes->size() == num_tensor_inputs) {
+      shapes->push_back(t.sizes().vec());
+    }
+  }
+  in_types_.push_back(t.scalar_type());
+}
+
 torch::jit::Value* SegmentedBlock::getOrAddInputForValue(torch::jit::Value* old_value) {
   if (old_to_new_.count(old_value) == 0) {
     auto node = old_value->node();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ostream>
+#include <unordered_set>
 #include <vector>
 
 #include "NvInfer.h"
@@ -68,6 +69,9 @@ struct SegmentedBlock {
   const std::vector<torch::jit::Value*>& raw_outputs() const {
     return outputs_;
   }
+  // Replaces the clone of the constant raw_const by an input of the segment, registered with the shape and type of its
+  // tensor, so that the segment reads the constant of the stitched graph instead of holding a copy of it
+  void promoteConstantToInput(torch::jit::Value* raw_const);
   void eraseInput(size_t i);
   void eraseOutput(size_t i);
   bool contain_raw_value(torch::jit::Value* input) const {
@@ -97,6 +101,13 @@ struct SegmentedBlock {
   const std::vector<at::ScalarType>& in_types() const {
     return in_types_;
   }
+  // Outputs which are only cast from Long to Int so they can be passed to TensorRT
+  void register_truncated_output(torch::jit::Value* raw_output) {
+    truncated_outputs_.insert(raw_output);
+  }
+  bool is_truncated_output(torch::jit::Value* raw_output) const {
+    return truncated_outputs_.count(raw_output);
+  }
 
   BlockID get_id() {
     return id_;
@@ -133,6 +144,7 @@ struct SegmentedBlock {
   std::vector<torch::jit::Node*> nodes_;
   std::shared_ptr<torch::jit::Graph> g_;
   std::unordered_map<torch::jit::Value*, torch::jit::Value*> old_to_new_;
+  std::unordered_set<torch::jit::Value*> truncated_outputs_;
   bool do_not_merge_ = false;
 };
 
@@ -1,7 +1,16 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <queue>
+#include <thread>
 #include "ATen/ATen.h"
+#include "ATen/ThreadLocalState.h"
+#include "c10/cuda/CUDAGuard.h"
+#include "c10/cuda/CUDAStream.h"
 #include "torch/csrc/jit/api/module.h"
 #include "torch/csrc/jit/passes/constant_pooling.h"
+#include "torch/csrc/jit/passes/dtype_analysis.h"
+#include "torch/csrc/jit/passes/symbolic_shape_analysis.h"
 
 #include "core/partitioning/partitioning.h"
 #include "core/util/prelude.h"
@@ -147,11 +156,7 @@ torch::jit::Node* createCastNode(
   return cast_node;
 }
 
-void getSegmentsOutputByRunning(
-    SegmentedBlock& seg_block,
-    std::unordered_map<const torch::jit::Value*, torch::jit::IValue>& ivalues_maps,
-    const PartitioningInfo& partitioning_info,
-    const ir::ShapeMode& shape_mode) {
+torch::jit::script::Module buildSegmentModule(SegmentedBlock& seg_block) {
   // create a module to run the graph
   auto g = seg_block.g();
   auto copy_g = g->copy();
@@ -175,7 +180,10 @@ void getSegmentsOutputByRunning(
   auto schema = util::GenerateGraphSchema(cur_method->name(), copy_g);
   cur_mod.type()->addMethod(cur_method);
   cur_method->setSchema(schema);
+  return cur_mod;
+}
 
+void runSegmentModule(torch::jit::script::Module& mod, SegmentedBlock& seg_block, ExampleIValues& ivalues_maps) {
   std::vector<torch::jit::IValue> jit_inputs_ivalues;
 
   // set inputs ivalues, now supports Tensor/Int to pass argumentes between different segments
@@ -219,7 +227,7 @@ void getSegmentsOutputByRunning(
 
   // run segments to get outputs for later segments input shape, and other arguments such as Int
   std::vector<torch::jit::IValue> jit_results;
-  torch::jit::IValue jit_results_ivalues = cur_mod.forward(jit_inputs_ivalues);
+  torch::jit::IValue jit_results_ivalues = mod.forward(jit_inputs_ivalues);
 
   if (jit_results_ivalues.isTuple()) {
     auto results = jit_results_ivalues.toTuple()->elements();
@@ -234,6 +242,106 @@ void getSegmentsOutputByRunning(
   for (auto& output : seg_block.raw_outputs()) {
     ivalues_maps[output] = jit_results[idx++];
   }
+}
+
+namespace {
+
+void collectValues(torch::jit::Block* b, std::vector<torch::jit::Value*>& values) {
+  for (auto n : b->nodes()) {
+    for (auto out : n->outputs()) {
+      values.push_back(out);
+    }
+    for (auto sub : n->blocks()) {
+      collectValues(sub, values);
+    }
+  }
+}
+
+// Meta tensors with the shape and dtype of every value of the graph of block which the TorchScript shape and dtype
+// functions resolve from the example inputs
+ExampleIValues propagateSymbolicShapes(torch::jit::Block* block, ExampleIValues& example_tensor_map) {
+  auto g = block->owningGraph()->shared_from_this();
+  std::vector<torch::jit::Value*> values(g->inputs().begin(), g->inputs().end());
+  collectValues(g->block(), values);
+
+  // The graph is annotated with the propagated types only for the analysis, the original types are put back after
+  std::unordered_map<torch::jit::Value*, c10::TypePtr> original_types;
+  for (auto v : values) {
+    original_types[v] = v->type();
+  }
+  for (auto in : g->inputs()) {
+    auto example = example_tensor_map.find(in);
+    if (example != example_tensor_map.end() && example->second.isTensor()) {
+      in->setType(c10::TensorType::create(example->second.toTensor()));
+    }
+  }
+
+  ExampleIValues symbolic_values;
+  try {
+    torch::jit::PropagateShapesOnGraph(g);
+    torch::jit::DtypePropagation(g);
+    for (auto v : values) {
+      auto type = v->type()->cast<c10::TensorType>();
+      if (!type || v->node()->kind() == torch::jit::prim::Param) {
+        continue;
+      }
+      auto sizes = type->sizes().concrete_sizes();
+      auto dtype = type->scalarType();
+      if (sizes && dtype) {
+        symbolic_values[v] = at::empty(*sizes, at::TensorOptions().dtype(*dtype).device(at::kMeta));
+      }
+    }
+  } catch (const std::exception& e) {
+    LOG_DEBUG("Symbolic shape analysis failed, running every segment instead: " << e.what());
+    symbolic_values.clear();
+  }
+
+  for (auto& t : original_types) {
+    t.first->setType(t.second);
+  }
+  return symbolic_values;
+}
+
+// Replaces tensors of symbolically resolved values, which only carry a shape and dtype, by tensors the segment can run
+// on
+void materializeInputs(SegmentedBlock& seg_block, ExampleIValues& ivalues_maps, const std::string& device) {
+  for (auto in : seg_block.raw_inputs()) {
+    auto ivalue = ivalues_maps.find(in);
+    if (ivalue == ivalues_maps.end() || !ivalue->second.isTensor() || !ivalue->second.toTensor().is_meta()) {
+      continue;
+    }
+    auto meta = ivalue->second.toTensor();
+    auto options = at::TensorOptions().dtype(meta.scalar_type()).device(device);
+    // Zeros are valid indices for integer inputs such as the indices of a gather or an embedding
+    ivalue->second = at::isFloatingType(meta.scalar_type()) ? at::randn(meta.sizes(), options)
+                                                            : at::zeros(meta.sizes(), options);
+  }
+}
+
+} // namespace
+
+// Returns whether the segment had to be run for the values of its outputs
+bool getSegmentsOutputByRunning(
+    SegmentedBlock& seg_block,
+    std::unordered_map<const torch::jit::Value*, torch::jit::IValue>& ivalues_maps,
+    const PartitioningInfo& partitioning_info,
+    const ir::ShapeMode& shape_mode,
+    const ExampleIValues& symbolic_values) {
+  // A segment is only run if the shape and dtype functions do not cover all of its outputs
+  bool resolved = !symbolic_values.empty();
+  for (auto out : seg_block.raw_outputs()) {
+    resolved &= symbolic_values.count(out) > 0;
+  }
+  if (resolved) {
+    LOG_GRAPH("Resolved the outputs of the segment symbolically");
+    for (auto out : seg_block.raw_outputs()) {
+      ivalues_maps[out] = symbolic_values.at(out);
+    }
+  } else {
+    materializeInputs(seg_block, ivalues_maps, partitioning_info.getGPUDeviceString());
+    auto cur_mod = buildSegmentModule(seg_block);
+    runSegmentModule(cur_mod, seg_block, ivalues_maps);
+  }
 
   auto target_device = partitioning_info.getGPUDeviceString();
 
@@ -280,6 +388,7 @@ void getSegmentsOutputByRunning(
           auto cast_node = createCastNode(seg_block, i, false, at::kInt, target_device);
           seg_block.g()->appendNode(cast_node);
           seg_block.g()->block()->replaceOutput(i, cast_node->outputs()[0]);
+          seg_block.register_truncated_output(seg_block.raw_outputs()[i]);
         } else if (t == at::kByte && partitioning_info.cast_int8_inputs) {
           LOG_DEBUG(
               "Detected graph Byte tensor output type during shape analysis, "
@@ -307,7 +416,15 @@ void getSegmentsOutputByRunning(
       auto cur_ivalue = ivalues_maps[current_input];
       at::ScalarType t = cur_ivalue.toTensor().scalar_type();
 
-      if (!partitioning_info.truncate_long_and_double && (t == at::kLong || t == at::kDouble)) {
+#if NV_TENSORRT_MAJOR >= 10
+      // Engines take Long inputs natively and narrow them in an ICastLayer at the network input
+      bool native_long = seg_block.target() == SegmentedBlock::kTensorRT && t == at::kLong;
+#else
+      bool native_long = false;
+#endif
+      if (native_long) {
+        LOG_DEBUG("Binding graph input " << current_input->debugName() << " as an Int64 engine input");
+      } else if (!partitioning_info.truncate_long_and_double && (t == at::kLong || t == at::kDouble)) {
         TORCHTRT_THROW_ERROR(
             "Unable to process subgraph input type of at::kLong/at::kDouble, try to compile model with truncate_long_and_double enabled");
       } else if (partitioning_info.truncate_long_and_double && t == at::kLong) {
@@ -340,18 +457,191 @@ void getSegmentsOutputByRunning(
 
   seg_block.register_inshapes(input_shapes, shape_mode);
   seg_block.register_intypes(input_types);
+  return !resolved;
 }
 
+namespace {
+
+// Groups the segments of block into waves, the segments of a wave only consume values of earlier waves so they can be
+// analyzed concurrently. Without concurrency every segment is a wave of its own, in order
+std::vector<std::vector<size_t>> scheduleSegments(const PartitionedGraph& segments, bool concurrent) {
+  std::unordered_map<const torch::jit::Value*, size_t> producer;
+  std::vector<size_t> wave_of(segments.size(), 0);
+  size_t num_waves = 0;
+  for (size_t i = 0; i < segments.size(); i++) {
+    if (!concurrent) {
+      wave_of[i] = i;
+    } else {
+      for (auto in : segments[i].raw_inputs()) {
+        auto p = producer.find(in);
+        if (p != producer.end()) {
+          wave_of[i] = std::max(wave_of[i], wave_of[p->second] + 1);
+        }
+      }
+    }
+    for (auto out : segments[i].raw_outputs()) {
+      producer[out] = i;
+    }
+    num_waves = std::max(num_waves, wave_of[i] + 1);
+  }
+  std::vector<std::vector<size_t>> waves(num_waves);
+  for (size_t i = 0; i < segments.size(); i++) {
+    waves[wave_of[i]].push_back(i);
+  }
+  return waves;
+}
+
+// Wave after which each value used only by the segments of block is no longer needed. Graph inputs, values returned
+// by block and values used in nested blocks, which are analyzed later, are kept
+std::unordered_map<const torch::jit::Value*, size_t> lastUseWaves(
+    torch::jit::Block* block,
+    const PartitionedGraph& segments,
+    const std::vector<std::vector<size_t>>& waves) {
+  std::unordered_map<const torch::jit::Value*, size_t> last_use;
+  for (size_t w = 0; w < waves.size(); w++) {
+    for (auto i : waves[w]) {
+      for (auto in : segments[i].raw_inputs()) {
+        bool releasable = in->node()->kind() != torch::jit::prim::Param;
+        for (auto& use : in->uses()) {
+          releasable &= use.user->owningBlock() == block && use.user != block->return_node();
+        }
+        if (releasable) {
+          last_use[in] = std::max(last_use[in], w);
+        }
+      }
+    }
+  }
+  return last_use;
+}
+
+// Analyzes the segments of a wave on a pool of workers, each running its segments on a stream of its own. Workers see
+// a copy of the inputs of their segments so the shared map is only updated once the wave is done. Returns the number of
+// segments which were run
+size_t runWaveConcurrently(
+    PartitionedGraph& segments,
+    const std::vector<size_t>& wave,
+    ExampleIValues& ivalues_maps,
+    const PartitioningInfo& settings,
+    const ir::ShapeMode& shape_mode,
+    const ExampleIValues& symbolic_values,
+    size_t num_workers) {
+  std::vector<ExampleIValues> local_maps(wave.size());
+  for (size_t k = 0; k < wave.size(); k++) {
+    for (auto in : segments[wave[k]].raw_inputs()) {
+      auto ivalue = ivalues_maps.find(in);
+      if (ivalue != ivalues_maps.end()) {
+        local_maps[k].insert(*ivalue);
+      }
+    }
+  }
+
+  // The worker streams do not wait on the stream the inputs were computed on
+  c10::cuda::getCurrentCUDAStream(settings.target_device.gpu_id).synchronize();
+
+  // Grad mode and the other thread local settings of the caller apply to the segments run by the workers
+  at::ThreadLocalState caller_state;
+  std::atomic<size_t> next = {0};
+  std::atomic<size_t> num_run = {0};
+  num_workers = std::min(num_workers, wave.size());
+  std::vector<std::exception_ptr> errors(num_workers);
+  auto& logger = util::logging::get_logger();
+  auto worker = [&](size_t worker_id) {
+    util::logging::ScopedLogger log_scope(logger);
+    try {
+      at::ThreadLocalStateGuard state_guard(caller_state);
+      auto stream = c10::cuda::getStreamFromPool(false, settings.target_device.gpu_id);
+      c10::cuda::CUDAStreamGuard stream_guard(stream);
+      for (size_t k = next++; k < wave.size(); k = next++) {
+        num_run += getSegmentsOutputByRunning(segments[wave[k]], local_maps[k], settings, shape_mode, symbolic_values);
+      }
+      stream.synchronize();
+    } catch (...) {
+      errors[worker_id] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t w = 1; w < num_workers; w++) {
+    threads.emplace_back(worker, w);
+  }
+  worker(0);
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (auto& e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+
+  // Inputs materialized by a worker are kept so later consumers do not materialize them again
+  for (auto& local : local_maps) {
+    for (auto& ivalue : local) {
+      ivalues_maps[ivalue.first] = ivalue.second;
+    }
+  }
+  return num_run;
+}
+
+} // namespace
+
 void runShapeAnalysis(
     PartitioningCtx* ctx,
     torch::jit::Block* block,
     ExampleIValues& example_tensor_map,
     const ir::ShapeMode& shape_mode) {
+  TORCHTRT_NVTX_RANGE("torch_tensorrt::shape_analysis");
+  TORCHTRT_COMPILE_PHASE(
+      shape_mode == ir::ShapeMode::kMIN       ? "shape_analysis/min"
+          : shape_mode == ir::ShapeMode::kMAX ? "shape_analysis/max"
+                                              : "shape_analysis/opt");
+  // Shape functions are only propagated over the whole graph, nested blocks have no example inputs of their own
+  ExampleIValues symbolic_values;
+  if (ctx->settings.symbolic_shape_analysis && block == block->owningGraph()->block()) {
+    symbolic_values = propagateSymbolicShapes(block, example_tensor_map);
+  }
+
+  auto& segments = ctx->partitioned_blocks[block];
+  size_t num_workers = ctx->settings.num_shape_analysis_workers > 0
+      ? static_cast<size_t>(ctx->settings.num_shape_analysis_workers)
+      : std::thread::hardware_concurrency();
+  num_workers = std::max<size_t>(1, num_workers);
+  auto waves = scheduleSegments(segments, num_workers > 1);
+  auto last_use = lastUseWaves(block, segments, waves);
+  LOG_DEBUG("Running shape analysis on " << segments.size() << " segments in " << waves.size() << " waves");
+
   // register every segment's input shape, and it's running output IValues
-  for (auto& seg_block : ctx->partitioned_blocks[block]) {
-    LOG_GRAPH("Running shape analysis on block " << seg_block);
-    torch::jit::ConstantPooling(seg_block.g());
-    getSegmentsOutputByRunning(seg_block, example_tensor_map, ctx->settings, shape_mode);
+  size_t num_run = 0;
+  for (size_t w = 0; w < waves.size(); w++) {
+    for (auto i : waves[w]) {
+      LOG_GRAPH("Running shape analysis on block " << segments[i]);
+      torch::jit::ConstantPooling(segments[i].g());
+    }
+    if (waves[w].size() > 1 && num_workers > 1) {
+      num_run += runWaveConcurrently(
+          segments, waves[w], example_tensor_map, ctx->settings, shape_mode, symbolic_values, num_workers);
+    } else {
+      for (auto i : waves[w]) {
+        num_run +=
+            getSegmentsOutputByRunning(segments[i], example_tensor_map, ctx->settings, shape_mode, symbolic_values);
+      }
+    }
+
+    // Intermediate values are released once their last consumer is analyzed, bounding the example values alive to
+    // the working set of the segments in flight
+    for (auto i : waves[w]) {
+      for (auto in : segments[i].raw_inputs()) {
+        auto last = last_use.find(in);
+        if (last != last_use.end() && last->second == w) {
+          example_tensor_map.erase(in);
+        }
+      }
+    }
+  }
+  if (ctx->settings.symbolic_shape_analysis) {
+    LOG_DEBUG(
+        "Shape analysis ran " << num_run << " of " << segments.size()
+                              << " segments, the others were resolved symbolically");
   }
   return;
 }
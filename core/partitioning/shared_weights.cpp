@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <map>
+#include <set>
+
+#include "core/partitioning/partitioning.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace partitioning {
+namespace {
+
+// Smaller weights are cheaper to copy into each engine than to bind as an input
+constexpr size_t kMinSharedWeightBytes = 1 << 20;
+
+// Ops whose converters take the weight at this position as an ITensor, -1 for any position
+const std::map<torch::jit::NodeKind, int> kWeightTensorReaders = {
+    {torch::jit::aten::embedding, 0},
+    {torch::jit::aten::embedding_bag, 0},
+    {torch::jit::aten::linear, 1},
+    {torch::jit::aten::matmul, -1},
+    {torch::jit::aten::mm, -1},
+    {torch::jit::aten::bmm, -1},
+    {torch::jit::aten::t, 0},
+    {torch::jit::aten::transpose, 0},
+    {torch::jit::aten::permute, 0},
+};
+
+bool readsWeightTensor(const torch::jit::Use& use) {
+  auto reader = kWeightTensorReaders.find(use.user->kind());
+  return reader != kWeightTensorReaders.end() &&
+      (reader->second == -1 || reader->second == static_cast<int>(use.offset));
+}
+
+bool isShareableWeight(const torch::jit::Node* n) {
+  if (n->kind() != torch::jit::prim::Constant || !n->hasAttribute(torch::jit::attr::value) ||
+      n->kindOf(torch::jit::attr::value) != torch::jit::AttributeKind::t) {
+    return false;
+  }
+  // The engines bind the tensor as is, a copy on every execution would cost more than it saves
+  auto t = n->t(torch::jit::attr::value);
+  return t.is_cuda() && t.is_floating_point() && t.is_contiguous() && t.nbytes() >= kMinSharedWeightBytes;
+}
+
+} // namespace
+
+size_t shareSegmentWeights(PartitioningCtx* ctx) {
+  size_t num_shared = 0;
+  for (auto& partitioned_block : ctx->partitioned_blocks) {
+    auto block = partitioned_block.first;
+    auto& segments = partitioned_block.second;
+    std::unordered_map<torch::jit::Node*, size_t> segment_of;
+    for (size_t s = 0; s < segments.size(); s++) {
+      for (auto n : segments[s].raw_nodes()) {
+        segment_of[n] = s;
+      }
+    }
+
+    for (auto n : block->nodes()) {
+      if (!isShareableWeight(n)) {
+        continue;
+      }
+      auto weight = n->output();
+      std::set<size_t> trt_segments;
+      bool shareable = true;
+      for (auto use : weight->uses()) {
+        auto owner = use.user;
+        while (owner && owner->owningBlock() != block) {
+          owner = owner->owningBlock()->owningNode();
+        }
+        auto seg = segment_of.find(owner);
+        if (seg == segment_of.end() || segments[seg->second].target() != SegmentedBlock::kTensorRT) {
+          continue;
+        }
+        trt_segments.insert(seg->second);
+        shareable = shareable && owner == use.user && readsWeightTensor(use);
+      }
+      if (trt_segments.size() < 2 || !shareable) {
+        continue;
+      }
+      for (auto s : trt_segments) {
+        auto& outputs = segments[s].raw_outputs();
+        shareable = shareable && std::find(outputs.begin(), outputs.end(), weight) == outputs.end();
+      }
+      if (!shareable) {
+        continue;
+      }
+
+      for (auto s : trt_segments) {
+        segments[s].promoteConstantToInput(weight);
+      }
+      num_shared++;
+      LOG_DEBUG(
+          "Passing weight " << weight->debugName() << " (" << n->t(torch::jit::attr::value).nbytes()
+                            << " bytes) to the " << trt_segments.size()
+                            << " TensorRT segments reading it instead of copying it into each engine");
+    }
+  }
+  if (num_shared) {
+    LOG_INFO("TensorRT segments share " << num_shared << " weights through a single device copy");
+  }
+  return num_shared;
+}
+
+} // namespace partitioning
+} // namespace core
+} // namespace torch_tensorrt
@@ -9,6 +9,17 @@ namespace torch_tensorrt {
 namespace core {
 namespace partitioning {
 
+namespace {
+// TensorRT segments and fused Torch segments run objects held by the module, which they take as their first input
+bool takesModule(partitioning::SegmentedBlock& seg) {
+  if (seg.target() == partitioning::SegmentedBlock::kTensorRT) {
+    return true;
+  }
+  auto cls = seg.inputs().empty() ? nullptr : seg.inputs()[0]->type()->cast<c10::ClassType>();
+  return cls && cls->is_module();
+}
+} // namespace
+
 void addSegmentedBlockToGraph(
     std::shared_ptr<torch::jit::Graph>& g,
     partitioning::SegmentedBlock& seg,
@@ -17,7 +28,8 @@ void addSegmentedBlockToGraph(
   // mini_to_new_g: mini graph value -> new graph value
   std::unordered_map<torch::jit::Value*, torch::jit::Value*> mini_to_new_g;
   size_t input_idx = 0;
-  if (seg.target() == partitioning::SegmentedBlock::kTensorRT && g->inputs().size() > 0) {
+  bool takes_module = takesModule(seg);
+  if (takes_module && g->inputs().size() > 0) {
     if (g->inputs()[0]->type()->str().find("__torch__") == std::string::npos) {
       auto self = g->insertInput(0, "self_1");
       self->setType(seg.inputs()[0]->type());
@@ -26,6 +38,12 @@ void addSegmentedBlockToGraph(
   }
 
   for (auto& raw_input : seg.raw_inputs()) {
+    // Weights shared by TensorRT segments are read from a single constant of the stitched graph
+    if (!old_to_new_g.count(raw_input) && raw_input->node()->kind() == torch::jit::prim::Constant) {
+      auto new_const = g->createClone(raw_input->node(), {nullptr});
+      g->block()->prependNode(new_const);
+      old_to_new_g[raw_input] = new_const->output();
+    }
     if (old_to_new_g.count(raw_input)) {
       mini_to_new_g[seg.inputs()[input_idx++]] = old_to_new_g[raw_input];
     }
@@ -39,7 +57,7 @@ void addSegmentedBlockToGraph(
   for (size_t i = 0; i < seg.raw_outputs().size(); ++i) {
     old_to_new_g[seg.raw_outputs()[i]] = mini_to_new_g[seg.outputs()[i]];
   }
-  size_t offset = seg.target() == partitioning::SegmentedBlock::kTensorRT ? 1 : 0;
+  size_t offset = takes_module ? 1 : 0;
   for (size_t i = 0; i < seg.raw_inputs().size(); ++i) {
     if (!old_to_new_g.count(seg.raw_inputs()[i])) {
       old_to_new_g[seg.raw_inputs()[i]] = mini_to_new_g[seg.inputs()[i + offset]];
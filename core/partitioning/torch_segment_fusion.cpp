@@ -0,0 +1,86 @@
+#include "torch/csrc/jit/ir/ir.h"
+#include "torch/csrc/jit/passes/shape_analysis.h"
+#include "torch/csrc/jit/passes/tensorexpr_fuser.h"
+
+#include "core/partitioning/partitioning.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace partitioning {
+namespace {
+
+bool isTensor(const torch::jit::Value* v) {
+  return v->type()->isSubtypeOf(c10::TensorType::get());
+}
+
+bool isComplete(const torch::jit::Value* v) {
+  auto type = v->type()->cast<c10::TensorType>();
+  return type && type->isComplete();
+}
+
+} // namespace
+
+std::shared_ptr<torch::jit::Graph> fusibleTorchSegmentGraph(SegmentedBlock& seg, const at::Device& device) {
+  if (seg.target() != SegmentedBlock::kTorch) {
+    return nullptr;
+  }
+  auto shapes = seg.in_opt_shapes();
+  auto& types = seg.in_types();
+  if (shapes.size() != seg.inputs().size() || types.size() != seg.inputs().size()) {
+    return nullptr;
+  }
+  for (auto in : seg.inputs()) {
+    if (!isTensor(in)) {
+      return nullptr;
+    }
+  }
+  for (auto out : seg.outputs()) {
+    if (!isTensor(out)) {
+      return nullptr;
+    }
+  }
+
+  // Shape analysis ran the segment on inputs of the opt shapes, the kernel is specialized for those
+  auto g = seg.g()->copy();
+  for (size_t i = 0; i < g->inputs().size(); i++) {
+    for (auto d : shapes[i]) {
+      if (d < 0) {
+        return nullptr;
+      }
+    }
+    g->inputs()[i]->setType(c10::TensorType::createContiguous(types[i], device, shapes[i]));
+  }
+  torch::jit::PropagateInputShapes(g);
+
+  size_t num_ops = 0;
+  for (auto n : g->nodes()) {
+    if (n->kind() == torch::jit::prim::Constant) {
+      // Tensor constants cannot be serialized with the graph IR
+      if (isTensor(n->output())) {
+        return nullptr;
+      }
+      continue;
+    }
+    if (!n->blocks().empty() || !torch::jit::tensorexpr::isSupported(n)) {
+      LOG_GRAPH("Torch segment is not fused, NNC does not support " << util::node_info(n));
+      return nullptr;
+    }
+    for (auto out : n->outputs()) {
+      if (!isComplete(out)) {
+        LOG_GRAPH("Torch segment is not fused, the shape of " << out->debugName() << " is not known");
+        return nullptr;
+      }
+    }
+    num_ops++;
+  }
+  // A single op already runs as one kernel
+  if (num_ops < 2) {
+    return nullptr;
+  }
+  return g;
+}
+
+} // namespace partitioning
+} // namespace core
+} // namespace torch_tensorrt
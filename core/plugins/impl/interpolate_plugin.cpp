@@ -37,7 +37,6 @@ InterpolatePlugin::InterpolatePlugin(
       output = at::upsample_linear1d(input, c10::nullopt, align_corners_, scales_[0]);
     } else if (mode_ == "bilinear") {
       output = at::upsample_bilinear2d(input, c10::nullopt, align_corners_, scales_);
-      std::cout << output.sizes() << std::endl;
     } else if (mode_ == "trilinear") {
       output = at::upsample_trilinear3d(input, c10::nullopt, align_corners_, scales_);
     }
@@ -166,7 +165,7 @@ nvinfer1::DimsExprs InterpolatePlugin::getOutputDimensions(
 
 nvinfer1::DataType InterpolatePlugin::getOutputDataType(int index, const nvinfer1::DataType* inputTypes, int nbInputs)
     const noexcept {
-  return nvinfer1::DataType::kFLOAT;
+  return inputTypes[0];
 }
 
 int InterpolatePlugin::initialize() noexcept {
@@ -228,7 +227,8 @@ bool InterpolatePlugin::supportsFormatCombination(
   const nvinfer1::PluginTensorDesc& in = inOut[0];
 
   if (pos == 0) {
-    return (in.type == nvinfer1::DataType::kFLOAT) && (in.format == nvinfer1::TensorFormat::kLINEAR);
+    return (in.type == nvinfer1::DataType::kFLOAT || in.type == nvinfer1::DataType::kHALF) &&
+        (in.format == nvinfer1::TensorFormat::kLINEAR);
   }
 
   // pos == 1, accessing information about output tensor
@@ -242,7 +242,7 @@ void InterpolatePlugin::configurePlugin(
     int nbInputs,
     const nvinfer1::DynamicPluginTensorDesc* out,
     int nbOutputs) noexcept {
-  dtype_ = nvinfer1::DataType::kFLOAT;
+  dtype_ = in[0].desc.type;
 }
 
 size_t InterpolatePlugin::getWorkspaceSize(
@@ -260,60 +260,66 @@ int InterpolatePlugin::enqueue(
     void* const* outputs,
     void* workspace,
     cudaStream_t stream) noexcept {
-  at::Tensor input =
-      at::from_blob((void*)inputs[0], util::toVec(inputDesc->dims), [](void*) {}, {at::kCUDA}).to(torch::kFloat);
-  at::Tensor output =
-      at::from_blob(outputs[0], util::toVec(outputDesc->dims), [](void*) {}, {at::kCUDA}).to(torch::kFloat);
-
-  at::cuda::CUDAStream torch_stream = at::cuda::getStreamFromPool();
-  at::cuda::CUDAStreamGuard torch_guard(torch_stream);
-
-  cudaEvent_t event;
-  cudaEventCreate(&event);
-  cudaEventRecord(event, stream);
-
-  cudaStreamWaitEvent(torch_stream.stream(), event, 0);
-  at::Tensor out;
-  if (use_scales_) {
-    if (mode_ == "linear") {
-      out = at::upsample_linear1d(input, c10::nullopt, align_corners_, {scales_[0]});
-    } else if (mode_ == "bilinear") {
-      out = at::upsample_bilinear2d(input, c10::nullopt, align_corners_, scales_);
-    } else if (mode_ == "trilinear") {
-      out = at::upsample_trilinear3d(input, c10::nullopt, align_corners_, scales_);
-    }
-  } else {
-    if (mode_ == "linear") {
-      out = at::upsample_linear1d(input, {size_[0]}, align_corners_);
-    } else if (mode_ == "bilinear") {
-      out = at::upsample_bilinear2d(input, {size_[0], size_[1]}, align_corners_);
-    } else if (mode_ == "trilinear") {
-      out = at::upsample_trilinear3d(input, {size_[0], size_[1], size_[2]}, align_corners_);
-    } else if (mode_ == "adaptive_avg_pool1d") {
-      out = at::adaptive_avg_pool1d(input, {size_[0]});
-    } else if (mode_ == "adaptive_max_pool1d") {
-      out = std::get<0>(at::adaptive_max_pool1d(input, {size_[0]}));
-    } else if (mode_ == "adaptive_avg_pool2d") {
-      out = at::adaptive_avg_pool2d(input, {size_[0], size_[1]});
-    } else if (mode_ == "adaptive_max_pool2d") {
-      out = std::get<0>(at::adaptive_max_pool2d(input, {size_[0], size_[1]}));
-    } else if (mode_ == "adaptive_avg_pool3d") {
-      out = at::adaptive_avg_pool3d(input, {size_[0], size_[1], size_[2]});
-    } else if (mode_ == "adaptive_max_pool3d") {
-      out = std::get<0>(at::adaptive_max_pool3d(input, {size_[0], size_[1], size_[2]}));
+  int device = 0;
+  if (cudaGetDevice(&device) != cudaSuccess) {
+    return 1;
+  }
+  // The ATen kernels run on the stream of the engine and write straight into the engine buffers
+  at::cuda::CUDAStreamGuard torch_guard(at::cuda::getStreamFromExternal(stream, device));
+  auto options = at::TensorOptions()
+                     .device(at::Device(at::kCUDA, device))
+                     .dtype(util::TRTDataTypeToScalarType(inputDesc->type));
+  at::Tensor input = at::from_blob((void*)inputs[0], util::toVec(inputDesc->dims), [](void*) {}, options);
+  at::Tensor output = at::from_blob(outputs[0], util::toVec(outputDesc->dims), [](void*) {}, options);
+
+  try {
+    if (use_scales_) {
+      // The output size the scales produce was fixed when the plugin was built
+      auto out_size = util::toVec(outputDesc->dims);
+      auto spatial = [&](size_t i, size_t num_spatial) { return out_size[out_size.size() - num_spatial + i]; };
+      if (mode_ == "linear") {
+        at::upsample_linear1d_out(output, input, {spatial(0, 1)}, align_corners_, scales_[0]);
+      } else if (mode_ == "bilinear") {
+        at::upsample_bilinear2d_out(
+            output, input, {spatial(0, 2), spatial(1, 2)}, align_corners_, scales_[0], scales_[1]);
+      } else if (mode_ == "trilinear") {
+        at::upsample_trilinear3d_out(
+            output,
+            input,
+            {spatial(0, 3), spatial(1, 3), spatial(2, 3)},
+            align_corners_,
+            scales_[0],
+            scales_[1],
+            scales_[2]);
+      }
+    } else {
+      if (mode_ == "linear") {
+        at::upsample_linear1d_out(output, input, {size_[0]}, align_corners_);
+      } else if (mode_ == "bilinear") {
+        at::upsample_bilinear2d_out(output, input, {size_[0], size_[1]}, align_corners_);
+      } else if (mode_ == "trilinear") {
+        at::upsample_trilinear3d_out(output, input, {size_[0], size_[1], size_[2]}, align_corners_);
+      } else if (mode_ == "adaptive_avg_pool1d") {
+        output.copy_(at::adaptive_avg_pool1d(input, {size_[0]}));
+      } else if (mode_ == "adaptive_max_pool1d") {
+        output.copy_(std::get<0>(at::adaptive_max_pool1d(input, {size_[0]})));
+      } else if (mode_ == "adaptive_avg_pool2d") {
+        at::adaptive_avg_pool2d_out(output, input, {size_[0], size_[1]});
+      } else if (mode_ == "adaptive_max_pool2d") {
+        auto indices = at::empty(output.sizes(), options.dtype(at::kLong));
+        at::adaptive_max_pool2d_out(output, indices, input, {size_[0], size_[1]});
+      } else if (mode_ == "adaptive_avg_pool3d") {
+        at::adaptive_avg_pool3d_out(output, input, {size_[0], size_[1], size_[2]});
+      } else if (mode_ == "adaptive_max_pool3d") {
+        auto indices = at::empty(output.sizes(), options.dtype(at::kLong));
+        at::adaptive_max_pool3d_out(output, indices, input, {size_[0], size_[1], size_[2]});
+      }
     }
+  } catch (const std::exception& e) {
+    LOG_ERROR("Interpolate plugin failed: " << e.what());
+    return 1;
   }
 
-  output.copy_(out);
-  cudaEvent_t torch_event;
-  cudaEventCreate(&torch_event);
-  cudaEventRecord(torch_event, torch_stream.stream());
-
-  cudaStreamWaitEvent(stream, torch_event, 0);
-
-  cudaEventDestroy(event);
-  cudaEventDestroy(torch_event);
-
   return 0;
 }
 
@@ -99,7 +99,7 @@ nvinfer1::DimsExprs NormalizePlugin::getOutputDimensions(
 
 nvinfer1::DataType NormalizePlugin::getOutputDataType(int index, const nvinfer1::DataType* inputTypes, int nbInputs)
     const noexcept {
-  return nvinfer1::DataType::kFLOAT;
+  return inputTypes[0];
 }
 
 int NormalizePlugin::initialize() noexcept {
@@ -146,7 +146,8 @@ bool NormalizePlugin::supportsFormatCombination(
   const nvinfer1::PluginTensorDesc& in = inOut[0];
 
   if (pos == 0) {
-    return (in.type == nvinfer1::DataType::kFLOAT) && (in.format == nvinfer1::TensorFormat::kLINEAR);
+    return (in.type == nvinfer1::DataType::kFLOAT || in.type == nvinfer1::DataType::kHALF) &&
+        (in.format == nvinfer1::TensorFormat::kLINEAR);
   }
 
   // pos == 1, accessing information about output tensor
@@ -160,7 +161,7 @@ void NormalizePlugin::configurePlugin(
     int nbInputs,
     const nvinfer1::DynamicPluginTensorDesc* out,
     int nbOutputs) noexcept {
-  dtype_ = nvinfer1::DataType::kFLOAT;
+  dtype_ = in[0].desc.type;
 }
 
 size_t NormalizePlugin::getWorkspaceSize(
@@ -178,31 +179,25 @@ int NormalizePlugin::enqueue(
     void* const* outputs,
     void* workspace,
     cudaStream_t stream) noexcept {
-  at::Tensor input =
-      at::from_blob((void*)inputs[0], util::toVec(inputDesc->dims), [](void*) {}, {at::kCUDA}).to(torch::kFloat);
-  at::Tensor output =
-      at::from_blob(outputs[0], util::toVec(outputDesc->dims), [](void*) {}, {at::kCUDA}).to(torch::kFloat);
-
-  at::cuda::CUDAStream torch_stream = at::cuda::getStreamFromPool();
-  at::cuda::CUDAStreamGuard torch_guard(torch_stream);
-
-  cudaEvent_t event;
-  cudaEventCreate(&event);
-  cudaEventRecord(event, stream);
-
-  cudaStreamWaitEvent(torch_stream.stream(), event, 0);
-
-  std::vector<int64_t> axes_double(axes_.begin(), axes_.end());
-  at::Tensor result = at::norm(input, (int64_t)order_, axes_double, (bool)keep_dims_);
-  output.copy_(result);
-  cudaEvent_t torch_event;
-  cudaEventCreate(&torch_event);
-  cudaEventRecord(torch_event, torch_stream.stream());
-
-  cudaStreamWaitEvent(stream, torch_event, 0);
-
-  cudaEventDestroy(event);
-  cudaEventDestroy(torch_event);
+  int device = 0;
+  if (cudaGetDevice(&device) != cudaSuccess) {
+    return 1;
+  }
+  // The ATen kernels run on the stream of the engine and write straight into the engine buffers
+  at::cuda::CUDAStreamGuard torch_guard(at::cuda::getStreamFromExternal(stream, device));
+  auto options = at::TensorOptions()
+                     .device(at::Device(at::kCUDA, device))
+                     .dtype(util::TRTDataTypeToScalarType(inputDesc->type));
+  at::Tensor input = at::from_blob((void*)inputs[0], util::toVec(inputDesc->dims), [](void*) {}, options);
+  at::Tensor output = at::from_blob(outputs[0], util::toVec(outputDesc->dims), [](void*) {}, options);
+
+  try {
+    std::vector<int64_t> axes(axes_.begin(), axes_.end());
+    at::norm_out(output, input, (int64_t)order_, axes, (bool)keep_dims_);
+  } catch (const std::exception& e) {
+    LOG_ERROR("Normalize plugin failed: " << e.what());
+    return 1;
+  }
   return 0;
 }
 
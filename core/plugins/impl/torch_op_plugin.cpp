@@ -0,0 +1,323 @@
+#include "core/plugins/impl/torch_op_plugin.h"
+#include <ATen/cuda/CUDAContext.h>
+#include <c10/cuda/CUDAGuard.h>
+#include "core/plugins/plugins.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace plugins {
+namespace impl {
+namespace {
+bool isFloatingBinding(at::ScalarType dtype) {
+  return dtype == at::kFloat || dtype == at::kHalf;
+}
+
+std::vector<int64_t> fromDtypes(const std::vector<at::ScalarType>& dtypes) {
+  std::vector<int64_t> values;
+  for (auto dtype : dtypes) {
+    values.push_back(static_cast<int64_t>(dtype));
+  }
+  return values;
+}
+
+std::vector<at::ScalarType> toDtypes(const std::vector<int64_t>& values) {
+  std::vector<at::ScalarType> dtypes;
+  for (auto value : values) {
+    dtypes.push_back(static_cast<at::ScalarType>(value));
+  }
+  return dtypes;
+}
+} // namespace
+
+/*
+ * TorchOpPlugin class implementations
+ */
+
+TorchOpPlugin::TorchOpPlugin(
+    std::string op_name,
+    std::string overload_name,
+    std::vector<c10::IValue> args,
+    std::vector<int64_t> input_positions,
+    std::vector<at::ScalarType> input_dtypes,
+    std::vector<std::vector<int64_t>> output_shapes,
+    std::vector<at::ScalarType> output_dtypes)
+    : op_name_(std::move(op_name)),
+      overload_name_(std::move(overload_name)),
+      args_(std::move(args)),
+      input_positions_(std::move(input_positions)),
+      input_dtypes_(std::move(input_dtypes)),
+      output_shapes_(std::move(output_shapes)),
+      output_dtypes_(std::move(output_dtypes)) {
+  TORCHTRT_CHECK(
+      input_positions_.size() == input_dtypes_.size(), "Expected a dtype for every input of the TorchOp plugin");
+  TORCHTRT_CHECK(
+      output_shapes_.size() == output_dtypes_.size(), "Expected a dtype for every output of the TorchOp plugin");
+  resolveOp();
+}
+
+TorchOpPlugin::TorchOpPlugin(const char* data, size_t length) {
+  auto state = torch::pickle_load(std::vector<char>(data, data + length)).toTuple();
+  const auto& elements = state->elements();
+  op_name_ = elements[0].toStringRef();
+  overload_name_ = elements[1].toStringRef();
+  args_ = elements[2].toListRef().vec();
+  input_positions_ = elements[3].toIntVector();
+  input_dtypes_ = toDtypes(elements[4].toIntVector());
+  for (const auto& shape : elements[5].toListRef()) {
+    output_shapes_.push_back(shape.toIntVector());
+  }
+  output_dtypes_ = toDtypes(elements[6].toIntVector());
+  resolveOp();
+}
+
+void TorchOpPlugin::resolveOp() {
+  op_ = c10::Dispatcher::singleton().findSchema({op_name_, overload_name_});
+  TORCHTRT_CHECK(
+      op_,
+      "Operator " << op_name_ << (overload_name_.empty() ? "" : ".") << overload_name_
+                  << " of the TorchOp plugin is not registered with Torch, the library defining it has to be loaded");
+  for (auto position : input_positions_) {
+    TORCHTRT_CHECK(
+        position >= 0 && position < (int64_t)args_.size(),
+        "TorchOp plugin input is passed as argument " << position << " of " << op_name_ << " which takes "
+                                                      << args_.size());
+  }
+}
+
+at::ScalarType TorchOpPlugin::getBindingDtype(int pos) const {
+  return pos < (int)input_dtypes_.size() ? input_dtypes_[pos] : output_dtypes_[pos - input_dtypes_.size()];
+}
+
+int TorchOpPlugin::getNbOutputs() const noexcept {
+  return output_shapes_.size();
+}
+
+const char* TorchOpPlugin::getPluginType() const noexcept {
+  return "TorchOp";
+}
+
+const char* TorchOpPlugin::getPluginVersion() const noexcept {
+  return "1";
+}
+
+const char* TorchOpPlugin::getPluginNamespace() const noexcept {
+  return "torch_tensorrt";
+}
+
+nvinfer1::IPluginV2DynamicExt* TorchOpPlugin::clone() const noexcept {
+  return new TorchOpPlugin(*this);
+}
+
+nvinfer1::DimsExprs TorchOpPlugin::getOutputDimensions(
+    int outputIndex,
+    const nvinfer1::DimsExprs* inputs,
+    int nbInputs,
+    nvinfer1::IExprBuilder& exprBuilder) noexcept {
+  const auto& shape = output_shapes_[outputIndex];
+  nvinfer1::DimsExprs output;
+  output.nbDims = shape.size();
+  for (size_t i = 0; i < shape.size(); i++) {
+    output.d[i] = exprBuilder.constant(shape[i]);
+  }
+  return output;
+}
+
+nvinfer1::DataType TorchOpPlugin::getOutputDataType(int index, const nvinfer1::DataType* inputTypes, int nbInputs)
+    const noexcept {
+  // Floating point outputs take the type negotiated for the floating point inputs
+  if (isFloatingBinding(output_dtypes_[index])) {
+    for (int i = 0; i < nbInputs; i++) {
+      if (isFloatingBinding(input_dtypes_[i])) {
+        return inputTypes[i];
+      }
+    }
+  }
+  return util::ScalarTypeToTRTDataType(output_dtypes_[index]);
+}
+
+int TorchOpPlugin::initialize() noexcept {
+  return 0;
+}
+
+void TorchOpPlugin::serialize(void* buffer) const noexcept {
+  std::string data = serializeToString();
+  size_t size = getSerializationSize();
+
+  data.copy((char*)buffer, size);
+}
+
+std::string TorchOpPlugin::serializeToString() const {
+  c10::impl::GenericList args(c10::AnyType::get());
+  for (const auto& arg : args_) {
+    args.push_back(arg);
+  }
+  c10::impl::GenericList output_shapes(c10::ListType::ofInts());
+  for (const auto& shape : output_shapes_) {
+    output_shapes.push_back(shape);
+  }
+  std::vector<c10::IValue> state = {
+      op_name_,
+      overload_name_,
+      args,
+      input_positions_,
+      fromDtypes(input_dtypes_),
+      output_shapes,
+      fromDtypes(output_dtypes_)};
+  auto data = torch::pickle_save(c10::ivalue::Tuple::create(std::move(state)));
+  return std::string(data.begin(), data.end());
+}
+
+size_t TorchOpPlugin::getSerializationSize() const noexcept {
+  return serializeToString().size();
+}
+
+bool TorchOpPlugin::supportsFormatCombination(
+    int pos,
+    const nvinfer1::PluginTensorDesc* inOut,
+    int nbInputs,
+    int nbOutputs) noexcept {
+  if (nbInputs != (int)input_dtypes_.size() || nbOutputs != (int)output_dtypes_.size()) {
+    LOG_ERROR(
+        "Expected " << input_dtypes_.size() << " inputs and " << output_dtypes_.size()
+                    << " outputs for the TorchOp plugin of " << op_name_);
+    return false;
+  }
+
+  const nvinfer1::PluginTensorDesc& desc = inOut[pos];
+  if (desc.format != nvinfer1::TensorFormat::kLINEAR) {
+    return false;
+  }
+  auto dtype = getBindingDtype(pos);
+  if (!isFloatingBinding(dtype)) {
+    return desc.type == util::ScalarTypeToTRTDataType(dtype);
+  }
+  if (desc.type != nvinfer1::DataType::kFLOAT && desc.type != nvinfer1::DataType::kHALF) {
+    return false;
+  }
+  // Every floating point tensor is bound in the type of the first one, which TensorRT picks first
+  for (int i = 0; i < pos; i++) {
+    if (isFloatingBinding(getBindingDtype(i))) {
+      return inOut[i].type == desc.type;
+    }
+  }
+  return true;
+}
+
+size_t TorchOpPlugin::getWorkspaceSize(
+    const nvinfer1::PluginTensorDesc* inputs,
+    int nbInputs,
+    const nvinfer1::PluginTensorDesc* outputs,
+    int nbOutputs) const noexcept {
+  return 0;
+}
+
+int TorchOpPlugin::enqueue(
+    const nvinfer1::PluginTensorDesc* inputDesc,
+    const nvinfer1::PluginTensorDesc* outputDesc,
+    const void* const* inputs,
+    void* const* outputs,
+    void* workspace,
+    cudaStream_t stream) noexcept {
+  int device = 0;
+  if (cudaGetDevice(&device) != cudaSuccess) {
+    return 1;
+  }
+  // The kernel runs on the stream of the engine and reads the engine buffers in place
+  at::cuda::CUDAStreamGuard torch_guard(at::cuda::getStreamFromExternal(stream, device));
+  auto options = at::TensorOptions().device(at::Device(at::kCUDA, device));
+
+  try {
+    torch::jit::Stack stack(args_.begin(), args_.end());
+    for (size_t i = 0; i < input_positions_.size(); i++) {
+      stack[input_positions_[i]] = at::from_blob(
+          const_cast<void*>(inputs[i]),
+          util::toVec(inputDesc[i].dims),
+          [](void*) {},
+          options.dtype(util::TRTDataTypeToScalarType(inputDesc[i].type)));
+    }
+    op_->callBoxed(&stack);
+    TORCHTRT_CHECK(
+        stack.size() == output_shapes_.size(),
+        op_name_ << " returned " << stack.size() << " values, the TorchOp plugin expects " << output_shapes_.size());
+
+    // Operators allocate their results, which are copied (and cast if needed) to the engine buffers
+    for (size_t i = 0; i < output_shapes_.size(); i++) {
+      auto result = stack[i].toTensor();
+      auto output = at::from_blob(
+          outputs[i],
+          util::toVec(outputDesc[i].dims),
+          [](void*) {},
+          options.dtype(util::TRTDataTypeToScalarType(outputDesc[i].type)));
+      TORCHTRT_CHECK(
+          result.sizes() == output.sizes(),
+          "Output " << i << " of " << op_name_ << " has shape " << result.sizes() << " instead of "
+                    << output.sizes() << " as when the engine was built");
+      output.copy_(result);
+    }
+  } catch (const std::exception& e) {
+    LOG_ERROR("TorchOp plugin of " << op_name_ << " failed: " << e.what());
+    return 1;
+  }
+
+  return 0;
+}
+
+/*
+ * TorchOpPluginCreator class implementations
+ */
+
+TorchOpPluginCreator::TorchOpPluginCreator() {
+  mPluginAttributes.emplace_back(nvinfer1::PluginField("state", nullptr, nvinfer1::PluginFieldType::kCHAR, 1));
+
+  mFC.nbFields = mPluginAttributes.size();
+  mFC.fields = mPluginAttributes.data();
+}
+
+const char* TorchOpPluginCreator::getPluginNamespace() const noexcept {
+  return "torch_tensorrt";
+}
+
+const char* TorchOpPluginCreator::getPluginName() const noexcept {
+  return "TorchOp";
+}
+
+const char* TorchOpPluginCreator::getPluginVersion() const noexcept {
+  return "1";
+}
+
+nvinfer1::IPluginV2* TorchOpPluginCreator::createPlugin(
+    const char* name,
+    const nvinfer1::PluginFieldCollection* fc) noexcept {
+  for (int i = 0; i < fc->nbFields; i++) {
+    if (std::string(fc->fields[i].name).compare("state") == 0) {
+      return deserializePlugin(name, fc->fields[i].data, fc->fields[i].length);
+    }
+  }
+  LOG_ERROR("The TorchOp plugin is created from its serialized state, which was not provided");
+  return nullptr;
+}
+
+nvinfer1::IPluginV2* TorchOpPluginCreator::deserializePlugin(
+    const char* name,
+    const void* serialData,
+    size_t serialLength) noexcept {
+  name_ = name;
+  try {
+    return new TorchOpPlugin((const char*)serialData, serialLength);
+  } catch (const std::exception& e) {
+    LOG_ERROR("Unable to deserialize TorchOp plugin " << name << ": " << e.what());
+    return nullptr;
+  }
+}
+
+const nvinfer1::PluginFieldCollection* TorchOpPluginCreator::getFieldNames() noexcept {
+  return &mFC;
+}
+
+REGISTER_TORCHTRT_PLUGIN(TorchOpPluginCreator);
+
+} // namespace impl
+} // namespace plugins
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/core/dispatch/Dispatcher.h>
+#include <cuda_runtime_api.h>
+#include <string>
+#include <vector>
+
+#include "NvInfer.h"
+#include "core/util/prelude.h"
+#include "torch/torch.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace plugins {
+namespace impl {
+
+// Runs any operator registered with the Torch dispatcher inside an engine, on the stream of the engine, so a node
+// without a converter does not split the graph. The tensor inputs of the plugin are passed to the kernel as views of
+// the engine buffers, in the types the plugin negotiated with TensorRT: every floating point tensor of the plugin is
+// bound as FP32 or FP16, the other tensors in the types they have in the network. The output shapes are fixed when the
+// plugin is built
+class TorchOpPlugin : public nvinfer1::IPluginV2DynamicExt {
+ private:
+  std::string op_name_;
+  std::string overload_name_;
+  // Arguments of the operator, in schema order, with None in place of the inputs of the plugin
+  std::vector<c10::IValue> args_;
+  // Argument each input of the plugin is passed as
+  std::vector<int64_t> input_positions_;
+  std::vector<at::ScalarType> input_dtypes_;
+  std::vector<std::vector<int64_t>> output_shapes_;
+  std::vector<at::ScalarType> output_dtypes_;
+  c10::optional<c10::OperatorHandle> op_;
+
+  void resolveOp();
+
+  at::ScalarType getBindingDtype(int pos) const;
+
+ public:
+  TorchOpPlugin(
+      std::string op_name,
+      std::string overload_name,
+      std::vector<c10::IValue> args,
+      std::vector<int64_t> input_positions,
+      std::vector<at::ScalarType> input_dtypes,
+      std::vector<std::vector<int64_t>> output_shapes,
+      std::vector<at::ScalarType> output_dtypes);
+
+  TorchOpPlugin(const char* data, size_t length);
+
+  TorchOpPlugin() = delete;
+
+  int getNbOutputs() const noexcept override;
+
+  const char* getPluginType() const noexcept override;
+
+  const char* getPluginVersion() const noexcept override;
+
+  const char* getPluginNamespace() const noexcept override;
+
+  void setPluginNamespace(const char* pluginNamespace) noexcept override{};
+
+  nvinfer1::IPluginV2DynamicExt* clone() const noexcept override;
+
+  nvinfer1::DimsExprs getOutputDimensions(
+      int outputIndex,
+      const nvinfer1::DimsExprs* inputs,
+      int nbInputs,
+      nvinfer1::IExprBuilder& exprBuilder) noexcept override;
+
+  nvinfer1::DataType getOutputDataType(int index, const nvinfer1::DataType* inputTypes, int nbInputs)
+      const noexcept override;
+
+  int initialize() noexcept override;
+
+  void terminate() noexcept override {}
+
+  void serialize(void* buffer) const noexcept override;
+
+  std::string serializeToString() const;
+
+  size_t getSerializationSize() const noexcept override;
+
+  void destroy() noexcept override {}
+
+  bool supportsFormatCombination(int pos, const nvinfer1::PluginTensorDesc* inOut, int nbInputs, int nbOutputs) noexcept
+      override;
+
+  void configurePlugin(
+      const nvinfer1::DynamicPluginTensorDesc* in,
+      int nbInputs,
+      const nvinfer1::DynamicPluginTensorDesc* out,
+      int nbOutputs) noexcept override {}
+
+  size_t getWorkspaceSize(
+      const nvinfer1::PluginTensorDesc* inputs,
+      int nbInputs,
+      const nvinfer1::PluginTensorDesc* outputs,
+      int nbOutputs) const noexcept override;
+
+  int enqueue(
+      const nvinfer1::PluginTensorDesc* inputDesc,
+      const nvinfer1::PluginTensorDesc* outputDesc,
+      const void* const* inputs,
+      void* const* outputs,
+      void* workspace,
+      cudaStream_t stream) noexcept override;
+};
+
+class TorchOpPluginCreator : public nvinfer1::IPluginCreator {
+ private:
+  std::string name_;
+  std::vector<nvinfer1::PluginField> mPluginAttributes;
+  nvinfer1::PluginFieldCollection mFC;
+
+ public:
+  TorchOpPluginCreator();
+
+  const char* getPluginNamespace() const noexcept override;
+
+  void setPluginNamespace(const char* libNamespace) noexcept override{};
+
+  const char* getPluginName() const noexcept override;
+
+  const char* getPluginVersion() const noexcept override;
+
+  // Takes the serialized plugin as its "state" field
+  nvinfer1::IPluginV2* createPlugin(const char* name, const nvinfer1::PluginFieldCollection* fc) noexcept override;
+
+  nvinfer1::IPluginV2* deserializePlugin(const char* name, const void* serialData, size_t serialLength) noexcept
+      override;
+
+  const nvinfer1::PluginFieldCollection* getFieldNames() noexcept override;
+};
+
+} // namespace impl
+} // namespace plugins
+} // namespace core
+} // namespace torch_tensorrt
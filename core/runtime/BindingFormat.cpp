@@ -0,0 +1,132 @@
+#include "core/runtime/BindingFormat.h"
+
+#include "ATen/ATen.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+namespace {
+
+int64_t padded_channels(c10::IntArrayRef sizes, const BindingFormat& format) {
+  auto channels = sizes[format.channel_dim];
+  return (channels + format.components - 1) / format.components * format.components;
+}
+
+// Number of elements of the storage of a tensor of the given sizes in format, including the padding
+int64_t storage_numel(c10::IntArrayRef sizes, const BindingFormat& format) {
+  if (format.is_linear()) {
+    return c10::multiply_integers(sizes);
+  }
+  int64_t numel = padded_channels(sizes, format);
+  for (int64_t d = 0; d < static_cast<int64_t>(sizes.size()); d++) {
+    if (d != format.channel_dim) {
+      numel *= sizes[d];
+    }
+  }
+  return numel;
+}
+
+} // namespace
+
+bool is_strided_format(nvinfer1::TensorFormat format) {
+  switch (format) {
+    case nvinfer1::TensorFormat::kLINEAR:
+    case nvinfer1::TensorFormat::kHWC:
+    case nvinfer1::TensorFormat::kHWC8:
+    case nvinfer1::TensorFormat::kHWC16:
+    case nvinfer1::TensorFormat::kDHWC8:
+      return true;
+    default:
+      // Channel major vectorized formats (kCHW2, kCHW4, kCHW32, ...) interleave groups of channels with the spatial
+      // dimensions, which no set of strides describes
+      return false;
+  }
+}
+
+BindingFormat get_binding_format(const nvinfer1::ICudaEngine& engine, const char* name) {
+  BindingFormat format;
+  format.format = engine.getTensorFormat(name);
+  if (format.is_linear()) {
+    return format;
+  }
+  TORCHTRT_CHECK(
+      is_strided_format(format.format),
+      "Binding " << name << " of the engine uses tensor format " << engine.getTensorFormatDesc(name)
+                 << ", which cannot be represented as a Torch tensor");
+  auto rank = engine.getTensorShape(name).nbDims;
+  auto spatial_dims = format.format == nvinfer1::TensorFormat::kDHWC8 ? 3 : 2;
+  TORCHTRT_CHECK(
+      rank > spatial_dims,
+      "Binding " << name << " of rank " << rank << " cannot use tensor format " << engine.getTensorFormatDesc(name));
+  auto vectorized_dim = engine.getTensorVectorizedDim(name);
+  format.channel_dim = vectorized_dim >= 0 ? vectorized_dim : rank - spatial_dims - 1;
+  format.components = std::max(engine.getTensorComponentsPerElement(name), 1);
+  return format;
+}
+
+std::vector<int64_t> format_strides(c10::IntArrayRef sizes, const BindingFormat& format) {
+  int64_t rank = sizes.size();
+  std::vector<int64_t> strides(rank, 1);
+  if (format.is_linear()) {
+    int64_t stride = 1;
+    for (int64_t d = rank - 1; d >= 0; d--) {
+      strides[d] = stride;
+      stride *= std::max<int64_t>(sizes[d], 1);
+    }
+    return strides;
+  }
+  // The padded channels are innermost, followed by the dimensions after and then before the channels
+  int64_t stride = padded_channels(sizes, format);
+  for (int64_t d = rank - 1; d > format.channel_dim; d--) {
+    strides[d] = stride;
+    stride *= std::max<int64_t>(sizes[d], 1);
+  }
+  for (int64_t d = format.channel_dim - 1; d >= 0; d--) {
+    strides[d] = stride;
+    stride *= std::max<int64_t>(sizes[d], 1);
+  }
+  return strides;
+}
+
+bool has_format(const at::Tensor& t, const BindingFormat& format) {
+  if (format.is_linear()) {
+    return t.is_contiguous();
+  }
+  if (t.dim() <= format.channel_dim || t.strides() != c10::IntArrayRef(format_strides(t.sizes(), format))) {
+    return false;
+  }
+  // The engine reads and writes the padding of the last channel group as well
+  auto needed = (t.storage_offset() + storage_numel(t.sizes(), format)) * static_cast<int64_t>(t.element_size());
+  return static_cast<int64_t>(t.storage().nbytes()) >= needed;
+}
+
+at::Tensor empty_in_format(c10::IntArrayRef sizes, const at::TensorOptions& options, const BindingFormat& format) {
+  if (format.is_linear()) {
+    return at::empty(sizes, options);
+  }
+  auto numel = storage_numel(sizes, format);
+  bool padded = padded_channels(sizes, format) != sizes[format.channel_dim];
+  auto storage = padded ? at::zeros({numel}, options) : at::empty({numel}, options);
+  return storage.as_strided(sizes, format_strides(sizes, format));
+}
+
+at::Tensor to_format(const at::Tensor& t, const BindingFormat& format) {
+  if (has_format(t, format)) {
+    return t;
+  }
+  return clone_in_format(t, format);
+}
+
+at::Tensor clone_in_format(const at::Tensor& t, const BindingFormat& format) {
+  if (format.is_linear()) {
+    return t.clone(at::MemoryFormat::Contiguous);
+  }
+  auto out = empty_in_format(t.sizes(), t.options(), format);
+  out.copy_(t);
+  return out;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "ATen/core/Tensor.h"
+#include "NvInfer.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Memory layout of an engine input or output as seen from Torch. Linear bindings are contiguous tensors. The channel
+// last formats (kHWC, kHWC8, kHWC16, kDHWC8) are channels last strided views whose channels are stored padded to a
+// multiple of components, so they can be passed between engines and to Torch ops without a reformat
+struct BindingFormat {
+  nvinfer1::TensorFormat format = nvinfer1::TensorFormat::kLINEAR;
+  // Dimension holding the channels, unused for linear bindings
+  int64_t channel_dim = -1;
+  // Channels are stored in groups of this many, the padding of the last group is zero
+  int64_t components = 1;
+
+  bool is_linear() const {
+    return format == nvinfer1::TensorFormat::kLINEAR;
+  }
+};
+
+// Whether bindings in format can be represented as a strided Torch tensor
+bool is_strided_format(nvinfer1::TensorFormat format);
+
+// Layout of the binding name of engine
+BindingFormat get_binding_format(const nvinfer1::ICudaEngine& engine, const char* name);
+
+// Strides of a tensor of the given sizes in format
+std::vector<int64_t> format_strides(c10::IntArrayRef sizes, const BindingFormat& format);
+
+// Whether t can be bound directly to a binding in format
+bool has_format(const at::Tensor& t, const BindingFormat& format);
+
+// Allocates a tensor laid out in format, including the storage of the padded channels
+at::Tensor empty_in_format(c10::IntArrayRef sizes, const at::TensorOptions& options, const BindingFormat& format);
+
+// Returns t if it is laid out in format, a copy of it laid out in format otherwise
+at::Tensor to_format(const at::Tensor& t, const BindingFormat& format);
+
+// Copy of t laid out in format
+at::Tensor clone_in_format(const at::Tensor& t, const BindingFormat& format);
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
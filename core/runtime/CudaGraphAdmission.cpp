@@ -0,0 +1,51 @@
+#include "core/runtime/CudaGraphAdmission.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+bool CudaGraphAdmission::admit(const ShapeKey& key, int64_t min_count, int64_t window) {
+  executions++;
+  if (min_count <= 1) {
+    return true;
+  }
+  auto it = sightings.find(key);
+  if (it == sightings.end()) {
+    if (sightings.size() >= kMaxTrackedKeys) {
+      prune(window);
+    }
+    it = sightings.emplace(key, std::deque<int64_t>()).first;
+  }
+  auto& seen = it->second;
+  seen.push_back(executions);
+  while (static_cast<int64_t>(seen.size()) > min_count || (window > 0 && seen.front() <= executions - window)) {
+    seen.pop_front();
+  }
+  if (static_cast<int64_t>(seen.size()) < min_count) {
+    return false;
+  }
+  sightings.erase(it);
+  return true;
+}
+
+void CudaGraphAdmission::tick() {
+  executions++;
+}
+
+void CudaGraphAdmission::clear() {
+  sightings.clear();
+}
+
+void CudaGraphAdmission::prune(int64_t window) {
+  for (auto it = sightings.begin(); it != sightings.end();) {
+    if (window == 0 || it->second.back() <= executions - window) {
+      it = sightings.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
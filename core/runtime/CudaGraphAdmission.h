@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+
+#include "core/runtime/ShapeKey.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Decides which input shapes of an execution slot are worth capturing a CUDA graph for. A shape key is admitted once
+// the slot has executed it min_count times within its last window executions, so shapes which only appear once or
+// rarely keep running with plain enqueueV3 instead of paying for a capture and its persistent buffers. Not thread
+// safe, each execution slot owns its own
+class CudaGraphAdmission {
+ public:
+  // Records an execution of key which has no captured graph and returns whether one should be captured now.
+  // min_count <= 1 admits every key, window 0 counts every execution since the key was first seen
+  bool admit(const ShapeKey& key, int64_t min_count, int64_t window);
+  // Records an execution which replayed a graph, only advancing the window
+  void tick();
+  void clear();
+
+ private:
+  // Drops the keys which were not seen within the window, or all of them if there is none
+  void prune(int64_t window);
+
+  static constexpr size_t kMaxTrackedKeys = 256;
+  int64_t executions = 0;
+  // Execution indices of the most recent sightings of every key not admitted yet, at most min_count each
+  std::unordered_map<ShapeKey, std::deque<int64_t>> sightings;
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
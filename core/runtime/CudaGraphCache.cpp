@@ -0,0 +1,110 @@
+#include "core/runtime/CudaGraphCache.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+namespace {
+std::atomic<int64_t>& process_bytes() {
+  static std::atomic<int64_t> bytes = {0};
+  return bytes;
+}
+} // namespace
+
+CudaGraphCache::~CudaGraphCache() {
+  process_bytes() -= total_bytes;
+}
+
+int64_t CudaGraphCache::process_total_bytes() {
+  return process_bytes();
+}
+
+void CudaGraphCache::add_bytes(int64_t nbytes) {
+  total_bytes += nbytes;
+  process_bytes() += nbytes;
+}
+
+CudaGraphCacheEntry* CudaGraphCache::find(const ShapeKey& key) {
+  auto it = index.find(key);
+  if (it == index.end()) {
+    misses++;
+    return nullptr;
+  }
+  hits++;
+  entries.splice(entries.begin(), entries, it->second);
+  return &it->second->second;
+}
+
+CudaGraphCacheEntry& CudaGraphCache::emplace(const ShapeKey& key) {
+  auto it = index.find(key);
+  if (it != index.end()) {
+    add_bytes(-it->second->second.nbytes);
+    it->second->second.cudagraph->reset();
+    entries.erase(it->second);
+    index.erase(it);
+  }
+  entries.emplace_front(key, CudaGraphCacheEntry());
+  index[key] = entries.begin();
+  num_entries = entries.size();
+  return entries.front().second;
+}
+
+void CudaGraphCache::commit(CudaGraphCacheEntry& entry, int64_t nbytes, int64_t max_entries, int64_t max_bytes) {
+  entry.nbytes = nbytes;
+  add_bytes(nbytes);
+  while (entries.size() > 1) {
+    bool over_entries = max_entries > 0 && static_cast<int64_t>(entries.size()) > max_entries;
+    bool over_bytes = max_bytes > 0 && total_bytes > max_bytes;
+    if (!over_entries && !over_bytes) {
+      break;
+    }
+    if (&entries.back().second == &entry) {
+      break;
+    }
+    evict_lru();
+  }
+}
+
+void CudaGraphCache::evict_lru() {
+  auto& lru = entries.back();
+  LOG_DEBUG("Evicting CUDA graph for input shapes " << lru.first);
+  lru.second.cudagraph->reset();
+  add_bytes(-lru.second.nbytes);
+  index.erase(lru.first);
+  entries.pop_back();
+  num_entries = entries.size();
+  evictions++;
+}
+
+void CudaGraphCache::clear() {
+  for (auto& entry : entries) {
+    entry.second.cudagraph->reset();
+  }
+  entries.clear();
+  index.clear();
+  num_entries = 0;
+  add_bytes(-total_bytes);
+}
+
+int64_t CudaGraphCache::evict_all_except(const CudaGraphCacheEntry* keep) {
+  int64_t evicted_bytes = 0;
+  for (auto it = entries.begin(); it != entries.end();) {
+    if (&it->second == keep) {
+      it++;
+      continue;
+    }
+    it->second.cudagraph->reset();
+    evicted_bytes += it->second.nbytes;
+    add_bytes(-it->second.nbytes);
+    index.erase(it->first);
+    it = entries.erase(it);
+    evictions++;
+  }
+  num_entries = entries.size();
+  return evicted_bytes;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
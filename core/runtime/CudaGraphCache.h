@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ATen/cuda/CUDAGraph.h"
+#include "core/runtime/ShapeKey.h"
+#include "torch/custom_class.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// A captured CUDA graph along with the persistent buffers it reads from and writes to
+struct CudaGraphCacheEntry {
+  std::unique_ptr<at::cuda::CUDAGraph> cudagraph = std::make_unique<at::cuda::CUDAGraph>();
+  std::vector<at::Tensor> input_buffers = {};
+  std::vector<at::Tensor> output_buffers = {};
+  // The output buffers are the caller's tensors passed to execute_engine_out rather than persistent buffers
+  bool caller_outputs = false;
+  // Bytes held by the persistent buffers, used to enforce the memory cap
+  int64_t nbytes = 0;
+  // Generation of the shared CudaGraphPool region the buffers are views of. -1: the buffers are not pooled
+  int64_t pool_generation = -1;
+};
+
+// Bounded LRU cache from input shape key to captured CUDA graph. Entries are evicted least recently used first
+// when either the entry limit or the byte limit (over persistent I/O buffers) is exceeded. A limit of 0 means
+// unbounded. Lookups and insertions are not thread safe, each execution slot owns its own cache. The counters
+// are atomic so they can be read while the owning slot is in use.
+class CudaGraphCache {
+ public:
+  CudaGraphCache() = default;
+  ~CudaGraphCache();
+
+  // Returns the entry for key (and marks it most recently used) or nullptr on a miss
+  CudaGraphCacheEntry* find(const ShapeKey& key);
+  // Creates a new, empty entry for key as the most recently used entry, replacing any existing one
+  CudaGraphCacheEntry& emplace(const ShapeKey& key);
+  // Records the size of a populated entry and evicts other entries until the cache is within the limits,
+  // never evicts the entry being committed
+  void commit(CudaGraphCacheEntry& entry, int64_t nbytes, int64_t max_entries, int64_t max_bytes);
+  void clear();
+  // Evicts every entry but keep (which may be nullptr or not in the cache), returns the bytes their buffers held
+  int64_t evict_all_except(const CudaGraphCacheEntry* keep);
+  // Bytes held by the entries of every cache of the process
+  static int64_t process_total_bytes();
+
+  std::atomic<int64_t> hits = {0};
+  std::atomic<int64_t> misses = {0};
+  std::atomic<int64_t> evictions = {0};
+  std::atomic<int64_t> num_entries = {0};
+  std::atomic<int64_t> total_bytes = {0};
+
+ private:
+  void evict_lru();
+  void add_bytes(int64_t nbytes);
+
+  using EntryList = std::list<std::pair<ShapeKey, CudaGraphCacheEntry>>;
+  EntryList entries;
+  std::unordered_map<ShapeKey, EntryList::iterator> index;
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
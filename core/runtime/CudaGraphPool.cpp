@@ -0,0 +1,54 @@
+#include "ATen/ATen.h"
+#include "ATen/cuda/CUDAGraph.h"
+
+#include "core/runtime/CudaGraphPool.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+CudaGraphPool::CudaGraphPool(c10::DeviceIndex device)
+    : device_index(device), pool_id(at::cuda::graph_pool_handle()) {}
+
+c10::DeviceIndex CudaGraphPool::device() const {
+  return device_index;
+}
+
+c10::cuda::MempoolId_t CudaGraphPool::id() const {
+  return pool_id;
+}
+
+std::unique_lock<std::mutex> CudaGraphPool::lock() {
+  return std::unique_lock<std::mutex>(mu);
+}
+
+const at::Tensor& CudaGraphPool::region(int64_t nbytes) {
+  if (!buffer.defined() || static_cast<int64_t>(buffer.nbytes()) < nbytes) {
+    LOG_DEBUG("Shared CUDA graph buffers on device " << device_index << " grow to " << nbytes << "B");
+    // Stale graphs keep the previous region alive through their buffers until they are captured again
+    buffer = at::empty({nbytes}, at::TensorOptions().device(at::kCUDA, device_index).dtype(at::kByte));
+    region_generation++;
+  }
+  return buffer;
+}
+
+int64_t CudaGraphPool::generation() const {
+  return region_generation;
+}
+
+int64_t CudaGraphPool::size() const {
+  return buffer.defined() ? buffer.nbytes() : 0;
+}
+
+void CudaGraphPool::wait(const c10::cuda::CUDAStream& stream) {
+  last_use.block(stream);
+}
+
+void CudaGraphPool::record(const c10::cuda::CUDAStream& stream) {
+  last_use.record(stream);
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+
+#include "ATen/Tensor.h"
+#include "ATen/cuda/CUDAEvent.h"
+#include "c10/cuda/CUDAGraphsC10Utils.h"
+#include "c10/cuda/CUDAStream.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Memory shared by the CUDA graphs of several engines, for instance the TensorRT segments of a partitioned module which
+// run one after another. The graphs capture into one graph memory pool instead of a private pool each, and the
+// persistent input and output buffers of the graphs, which only hold data from the copy in before a replay until the
+// copy out after it, are views of one region sized to the largest set of buffers of any graph. Executions hold the
+// pool lock from the copy in until the copy out, and the next user of the region waits for the previous one on the GPU
+class CudaGraphPool {
+ public:
+  explicit CudaGraphPool(c10::DeviceIndex device);
+
+  c10::DeviceIndex device() const;
+  c10::cuda::MempoolId_t id() const;
+
+  std::unique_lock<std::mutex> lock();
+  // Returns the shared buffer region, (re)allocating it if it is smaller than nbytes. Graphs captured against a
+  // previous region are stale once it moves, see generation. Expects the pool lock to be held
+  const at::Tensor& region(int64_t nbytes);
+  // Incremented each time the region moves
+  int64_t generation() const;
+  int64_t size() const;
+  // Order the next use of the region after the last one. Expects the pool lock to be held
+  void wait(const c10::cuda::CUDAStream& stream);
+  void record(const c10::cuda::CUDAStream& stream);
+
+ private:
+  c10::DeviceIndex device_index;
+  c10::cuda::MempoolId_t pool_id;
+  at::Tensor buffer;
+  int64_t region_generation = 0;
+  at::cuda::CUDAEvent last_use;
+  std::mutex mu;
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
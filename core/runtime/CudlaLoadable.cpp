@@ -0,0 +1,350 @@
+#include "core/runtime/CudlaLoadable.h"
+
+#include <cstring>
+#include <mutex>
+
+#include "ATen/cuda/CUDAEvent.h"
+#include "c10/cuda/CUDAGuard.h"
+#include "c10/cuda/CUDAStream.h"
+#include "cuda_runtime.h"
+#include "torch/torch.h"
+
+#if defined(__has_include)
+#if __has_include(<cudla.h>)
+#include <dlfcn.h>
+#include "cudla.h"
+#define TORCHTRT_WITH_CUDLA 1
+#endif
+#endif
+
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+bool is_dla_loadable(const void* data, size_t size) {
+  return size >= DLA_LOADABLE_MAGIC.size() &&
+      std::memcmp(data, DLA_LOADABLE_MAGIC.data(), DLA_LOADABLE_MAGIC.size()) == 0;
+}
+
+std::string wrap_dla_loadable(const void* data, size_t size) {
+  std::string wrapped;
+  wrapped.reserve(DLA_LOADABLE_MAGIC.size() + size);
+  wrapped.append(DLA_LOADABLE_MAGIC);
+  wrapped.append(static_cast<const char*>(data), size);
+  return wrapped;
+}
+
+#ifdef TORCHTRT_WITH_CUDLA
+namespace {
+
+// libcudla is only installed on Jetson devices, it is loaded when the first loadable is instead of being linked
+struct CudlaApi {
+  decltype(&cudlaCreateDevice) create_device;
+  decltype(&cudlaDestroyDevice) destroy_device;
+  decltype(&cudlaModuleLoadFromMemory) module_load_from_memory;
+  decltype(&cudlaModuleUnload) module_unload;
+  decltype(&cudlaModuleGetAttributes) module_get_attributes;
+  decltype(&cudlaMemRegister) mem_register;
+  decltype(&cudlaMemUnregister) mem_unregister;
+  decltype(&cudlaSubmitTask) submit_task;
+};
+
+template <typename F>
+bool load_symbol(void* lib, const char* name, F& fn) {
+  fn = reinterpret_cast<F>(dlsym(lib, name));
+  return fn != nullptr;
+}
+
+const CudlaApi* get_cudla_api() {
+  static const std::unique_ptr<CudlaApi> api = []() -> std::unique_ptr<CudlaApi> {
+    void* lib = dlopen("libcudla.so.1", RTLD_NOW | RTLD_LOCAL);
+    if (!lib) {
+      lib = dlopen("libcudla.so", RTLD_NOW | RTLD_LOCAL);
+    }
+    if (!lib) {
+      LOG_DEBUG("Unable to load libcudla: " << dlerror());
+      return nullptr;
+    }
+    auto api = std::make_unique<CudlaApi>();
+    bool loaded = load_symbol(lib, "cudlaCreateDevice", api->create_device) &&
+        load_symbol(lib, "cudlaDestroyDevice", api->destroy_device) &&
+        load_symbol(lib, "cudlaModuleLoadFromMemory", api->module_load_from_memory) &&
+        load_symbol(lib, "cudlaModuleUnload", api->module_unload) &&
+        load_symbol(lib, "cudlaModuleGetAttributes", api->module_get_attributes) &&
+        load_symbol(lib, "cudlaMemRegister", api->mem_register) &&
+        load_symbol(lib, "cudlaMemUnregister", api->mem_unregister) &&
+        load_symbol(lib, "cudlaSubmitTask", api->submit_task);
+    if (!loaded) {
+      LOG_WARNING("libcudla is missing symbols the runtime needs, DLA loadables cannot be executed");
+      return nullptr;
+    }
+    return api;
+  }();
+  return api.get();
+}
+
+void check_cudla(cudlaStatus status, const std::string& what) {
+  TORCHTRT_CHECK(status == cudlaSuccess, what << " failed with cuDLA error " << static_cast<int>(status));
+}
+
+// dataType of the loadable tensor descriptors
+at::ScalarType to_scalar_type(uint8_t data_type, const char* name) {
+  switch (data_type) {
+    case 1:
+      return at::kFloat;
+    case 2:
+      return at::kHalf;
+    case 3:
+      return at::kShort;
+    case 4:
+      return at::kChar;
+    case 5:
+      return at::kByte;
+    default:
+      TORCHTRT_THROW_ERROR("Tensor " << name << " of the DLA loadable has an unsupported data type " << +data_type);
+  }
+}
+
+CudlaTensorDesc to_tensor_desc(const cudlaModuleTensorDescriptor& d) {
+  CudlaTensorDesc desc;
+  desc.name = d.name;
+  desc.shape = {
+      static_cast<int64_t>(d.n), static_cast<int64_t>(d.c), static_cast<int64_t>(d.h), static_cast<int64_t>(d.w)};
+  desc.dtype = to_scalar_type(d.dataType, d.name);
+  desc.size = d.size;
+  // Rows of linear DLA formats are padded, formats interleaving channels do not hold NCHW rows at all
+  size_t num_rows = d.n * d.c * d.h;
+  size_t row_bytes = d.w * c10::elementSize(desc.dtype);
+  TORCHTRT_CHECK(
+      num_rows > 0 && d.size % num_rows == 0 && d.size / num_rows >= row_bytes,
+      "Tensor " << desc.name << " of the DLA loadable is not in an NCHW layout (" << d.size << " bytes for shape "
+                << c10::IntArrayRef(desc.shape) << "), build its engine with the kDLA_LINEAR format");
+  desc.line_stride = d.size / num_rows;
+  return desc;
+}
+
+} // namespace
+
+struct CudlaLoadable::Impl {
+  const CudlaApi* api = nullptr;
+  int64_t gpu_id = 0;
+  cudlaDevHandle device = nullptr;
+  cudlaModule module = nullptr;
+  std::vector<CudlaTensorDesc> inputs;
+  std::vector<CudlaTensorDesc> outputs;
+  // Device buffers of the inputs then the outputs, and the pointers cuDLA registered them as
+  std::vector<at::Tensor> buffers;
+  std::vector<uint64_t*> registered;
+  std::mutex mu;
+  // Recorded after the last execution read the output buffers, the next execution may run on another stream
+  at::cuda::CUDAEvent done;
+
+  std::vector<CudlaTensorDesc> tensor_descs(bool input) {
+    cudlaModuleAttribute attr;
+    check_cudla(
+        api->module_get_attributes(module, input ? CUDLA_NUM_INPUT_TENSORS : CUDLA_NUM_OUTPUT_TENSORS, &attr),
+        "Querying the number of I/O tensors of the DLA loadable");
+    auto num_tensors = input ? attr.numInputTensors : attr.numOutputTensors;
+    std::vector<cudlaModuleTensorDescriptor> descs(num_tensors);
+    if (input) {
+      attr.inputTensorDesc = descs.data();
+    } else {
+      attr.outputTensorDesc = descs.data();
+    }
+    check_cudla(
+        api->module_get_attributes(
+            module, input ? CUDLA_INPUT_TENSOR_DESCRIPTORS : CUDLA_OUTPUT_TENSOR_DESCRIPTORS, &attr),
+        "Querying the I/O tensors of the DLA loadable");
+    std::vector<CudlaTensorDesc> out;
+    for (const auto& d : descs) {
+      out.push_back(to_tensor_desc(d));
+    }
+    return out;
+  }
+
+  void release() {
+    done.synchronize();
+    for (auto ptr : registered) {
+      api->mem_unregister(device, ptr);
+    }
+    registered.clear();
+    buffers.clear();
+    if (module) {
+      api->module_unload(module, 0);
+    }
+    if (device) {
+      api->destroy_device(device);
+    }
+  }
+};
+
+bool is_cudla_available() {
+  return get_cudla_api() != nullptr;
+}
+
+CudlaLoadable::CudlaLoadable(const void* loadable, size_t size, int64_t dla_core, int64_t gpu_id)
+    : impl(std::make_unique<Impl>()) {
+  impl->api = get_cudla_api();
+  TORCHTRT_CHECK(impl->api, "DLA loadables need cuDLA, libcudla could not be loaded on this machine");
+  impl->gpu_id = gpu_id;
+  c10::cuda::CUDAGuard device_guard(gpu_id);
+  try {
+    check_cudla(
+        impl->api->create_device(static_cast<uint64_t>(dla_core), &impl->device, CUDLA_CUDA_DLA),
+        "Opening DLA core " + std::to_string(dla_core));
+    check_cudla(
+        impl->api->module_load_from_memory(
+            impl->device, static_cast<const uint8_t*>(loadable), size, &impl->module, CUDLA_MODULE_DEFAULT),
+        "Loading the DLA loadable");
+    impl->inputs = impl->tensor_descs(true);
+    impl->outputs = impl->tensor_descs(false);
+
+    auto options = at::TensorOptions().dtype(at::kByte).device(at::Device(at::kCUDA, gpu_id));
+    for (const auto* descs : {&impl->inputs, &impl->outputs}) {
+      for (const auto& d : *descs) {
+        auto buffer = at::empty({static_cast<int64_t>(d.size)}, options);
+        uint64_t* registered = nullptr;
+        check_cudla(
+            impl->api->mem_register(
+                impl->device, reinterpret_cast<const uint64_t*>(buffer.data_ptr()), d.size, &registered, 0),
+            "Registering the buffer of tensor " + d.name + " with the DLA");
+        impl->buffers.push_back(std::move(buffer));
+        impl->registered.push_back(registered);
+      }
+    }
+  } catch (...) {
+    impl->release();
+    throw;
+  }
+}
+
+CudlaLoadable::~CudlaLoadable() {
+  c10::cuda::CUDAGuard device_guard(impl->gpu_id);
+  impl->release();
+}
+
+const std::vector<CudlaTensorDesc>& CudlaLoadable::inputs() const {
+  return impl->inputs;
+}
+
+const std::vector<CudlaTensorDesc>& CudlaLoadable::outputs() const {
+  return impl->outputs;
+}
+
+std::vector<at::Tensor> CudlaLoadable::run(
+    const std::vector<at::Tensor>& inputs,
+    const std::vector<at::Tensor>* caller_outputs) {
+  TORCHTRT_CHECK(
+      inputs.size() == impl->inputs.size(),
+      "The DLA loadable takes " << impl->inputs.size() << " inputs, got " << inputs.size());
+  TORCHTRT_CHECK(
+      !caller_outputs || caller_outputs->size() == impl->outputs.size(),
+      "The DLA loadable produces " << impl->outputs.size() << " outputs, got " << caller_outputs->size()
+                                   << " tensors to write them into");
+  c10::cuda::CUDAGuard device_guard(impl->gpu_id);
+  auto stream = c10::cuda::getCurrentCUDAStream(impl->gpu_id);
+  auto device = at::Device(at::kCUDA, impl->gpu_id);
+
+  std::lock_guard<std::mutex> lock(impl->mu);
+  impl->done.block(stream);
+  for (size_t i = 0; i < inputs.size(); i++) {
+    const auto& d = impl->inputs[i];
+    auto numel = d.shape[0] * d.shape[1] * d.shape[2] * d.shape[3];
+    TORCHTRT_CHECK(
+        inputs[i].numel() == numel && inputs[i].scalar_type() == d.dtype,
+        "Input " << d.name << " of the DLA loadable expects " << numel << " elements of " << d.dtype << " (shape "
+                 << c10::IntArrayRef(d.shape) << "), got a tensor of shape " << inputs[i].sizes() << " of "
+                 << inputs[i].scalar_type());
+    auto in = inputs[i].to(device, /*non_blocking=*/true).contiguous();
+    auto row_bytes = d.shape[3] * c10::elementSize(d.dtype);
+    TORCHTRT_CHECK(
+        cudaMemcpy2DAsync(
+            impl->buffers[i].data_ptr(),
+            d.line_stride,
+            in.data_ptr(),
+            row_bytes,
+            row_bytes,
+            numel / d.shape[3],
+            cudaMemcpyDeviceToDevice,
+            stream.stream()) == cudaSuccess,
+        "Unable to copy input " << d.name << " into its DLA buffer");
+  }
+
+  std::vector<const uint64_t*> task_inputs(impl->registered.begin(), impl->registered.begin() + inputs.size());
+  std::vector<uint64_t*> task_outputs(impl->registered.begin() + inputs.size(), impl->registered.end());
+  cudlaTask task;
+  task.moduleHandle = impl->module;
+  task.inputTensor = task_inputs.data();
+  task.numInputTensors = static_cast<uint32_t>(task_inputs.size());
+  task.outputTensor = task_outputs.data();
+  task.numOutputTensors = static_cast<uint32_t>(task_outputs.size());
+  task.waitEvents = nullptr;
+  task.signalEvents = nullptr;
+  check_cudla(impl->api->submit_task(impl->device, &task, 1, stream.stream(), 0), "Submitting the DLA task");
+
+  std::vector<at::Tensor> outputs;
+  for (size_t o = 0; o < impl->outputs.size(); o++) {
+    const auto& d = impl->outputs[o];
+    auto out = caller_outputs ? (*caller_outputs)[o]
+                              : at::empty(d.shape, at::TensorOptions().dtype(d.dtype).device(device));
+    auto numel = d.shape[0] * d.shape[1] * d.shape[2] * d.shape[3];
+    TORCHTRT_CHECK(
+        out.numel() == numel && out.scalar_type() == d.dtype && out.device() == device && out.is_contiguous(),
+        "Output " << d.name << " of the DLA loadable needs a contiguous tensor of " << numel << " elements of "
+                  << d.dtype << " on " << device);
+    auto row_bytes = d.shape[3] * c10::elementSize(d.dtype);
+    TORCHTRT_CHECK(
+        cudaMemcpy2DAsync(
+            out.data_ptr(),
+            row_bytes,
+            impl->buffers[inputs.size() + o].data_ptr(),
+            d.line_stride,
+            row_bytes,
+            numel / d.shape[3],
+            cudaMemcpyDeviceToDevice,
+            stream.stream()) == cudaSuccess,
+        "Unable to copy output " << d.name << " out of its DLA buffer");
+    outputs.push_back(std::move(out));
+  }
+  impl->done.record(stream);
+  return outputs;
+}
+
+#else
+
+struct CudlaLoadable::Impl {
+  std::vector<CudlaTensorDesc> inputs;
+  std::vector<CudlaTensorDesc> outputs;
+};
+
+bool is_cudla_available() {
+  return false;
+}
+
+CudlaLoadable::CudlaLoadable(const void* loadable, size_t size, int64_t dla_core, int64_t gpu_id) {
+  TORCHTRT_THROW_ERROR("DLA loadables need cuDLA, this build of the Torch-TensorRT runtime does not include it");
+}
+
+CudlaLoadable::~CudlaLoadable() = default;
+
+const std::vector<CudlaTensorDesc>& CudlaLoadable::inputs() const {
+  return impl->inputs;
+}
+
+const std::vector<CudlaTensorDesc>& CudlaLoadable::outputs() const {
+  return impl->outputs;
+}
+
+std::vector<at::Tensor> CudlaLoadable::run(
+    const std::vector<at::Tensor>& inputs,
+    const std::vector<at::Tensor>* caller_outputs) {
+  TORCHTRT_THROW_ERROR("DLA loadables need cuDLA, this build of the Torch-TensorRT runtime does not include it");
+}
+
+#endif
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ATen/Tensor.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Engines built with the DLA standalone engine capability are DLA loadables rather than TensorRT plans, they cannot
+// be deserialized by an IRuntime. The compiler stores them behind DLA_LOADABLE_MAGIC in place of the serialized engine
+// (at ENGINE_IDX) and TRTEngine executes them through cuDLA instead of an IExecutionContext
+const std::string DLA_LOADABLE_MAGIC = "TORCHTRT_DLA_LOADABLE_1";
+
+bool is_dla_loadable(const void* data, size_t size);
+std::string wrap_dla_loadable(const void* data, size_t size);
+
+// Whether the runtime was built with cuDLA (cudla.h) and libcudla could be loaded, only the case on Jetson devices
+bool is_cudla_available();
+
+// I/O tensor of a DLA loadable, in the layout of its DLA format
+struct CudlaTensorDesc {
+  std::string name;
+  std::vector<int64_t> shape; // NCHW
+  at::ScalarType dtype;
+  size_t size; // Bytes of the tensor, including the padding of its rows
+  size_t line_stride; // Bytes between the start of two rows
+};
+
+// A DLA loadable loaded with cuDLA in hybrid mode on one DLA core. Each I/O tensor gets a device buffer which is
+// registered with the DLA once, executions copy the inputs into them and submit the task on the current CUDA stream, so
+// the DLA work is ordered with the work of that stream and GPU work on other streams runs concurrently with it.
+// Executions of one loadable share its buffers and are serialized. Only NCHW tensors (kDLA_LINEAR) are supported
+class CudlaLoadable {
+ public:
+  CudlaLoadable(const void* loadable, size_t size, int64_t dla_core, int64_t gpu_id);
+  ~CudlaLoadable();
+  CudlaLoadable(const CudlaLoadable&) = delete;
+  CudlaLoadable& operator=(const CudlaLoadable&) = delete;
+
+  const std::vector<CudlaTensorDesc>& inputs() const;
+  const std::vector<CudlaTensorDesc>& outputs() const;
+
+  // inputs are ordered like inputs(), returns the outputs ordered like outputs(). With caller_outputs, the outputs are
+  // written into (and returned as) these tensors
+  std::vector<at::Tensor> run(
+      const std::vector<at::Tensor>& inputs,
+      const std::vector<at::Tensor>* caller_outputs = nullptr);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl;
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
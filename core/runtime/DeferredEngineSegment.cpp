@@ -0,0 +1,141 @@
+#include <sstream>
+#include <utility>
+
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/csrc/jit/passes/shape_analysis.h"
+
+#include "core/runtime/DeferredEngineSegment.h"
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+namespace {
+
+void check_serialized_segment(const std::vector<std::string>& serialized_info) {
+  TORCHTRT_CHECK(serialized_info.size() >= 2, "Program to be deserialized has a malformed deferred engine segment");
+}
+
+std::string segment_name(const std::vector<std::string>& serialized_info) {
+  check_serialized_segment(serialized_info);
+  return serialized_info[0];
+}
+
+std::shared_ptr<torch::jit::Graph> parse_segment_graph(const std::vector<std::string>& serialized_info) {
+  check_serialized_segment(serialized_info);
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(serialized_info[1], g.get());
+  return g;
+}
+
+} // namespace
+
+DeferredEngineSegment::DeferredEngineSegment(std::string name, std::shared_ptr<torch::jit::Graph> graph)
+    : name(std::move(name)), graph(std::move(graph)) {
+  auto fallback_g = this->graph->copy();
+  torch::jit::EraseShapeInformation(fallback_g);
+  fallback = std::make_unique<torch::jit::GraphExecutor>(fallback_g, this->name);
+}
+
+DeferredEngineSegment::DeferredEngineSegment(std::vector<std::string> serialized_info)
+    : DeferredEngineSegment(segment_name(serialized_info), parse_segment_graph(serialized_info)) {
+  if (serialized_info.size() == 2) {
+    set_build_failed("the segment was serialized before its engine was built");
+    return;
+  }
+  // Engine info as TRTEngine::serialize produces it, with the engine base64 encoded
+  std::vector<std::string> engine_info(
+      std::make_move_iterator(serialized_info.begin() + 2), std::make_move_iterator(serialized_info.end()));
+  TRTEngine::verify_serialization_fmt(engine_info, ABI_VERSION);
+  if (!is_engine_file_reference(engine_info[ENGINE_IDX])) {
+    engine_info[ENGINE_IDX] = base64_decode(engine_info[ENGINE_IDX]);
+  }
+  set_engine(c10::make_intrusive<TRTEngine>(std::move(engine_info)));
+}
+
+void DeferredEngineSegment::set_engine(c10::intrusive_ptr<TRTEngine> engine) {
+  {
+    std::lock_guard<std::mutex> lock(mu);
+    this->engine = std::move(engine);
+    done = true;
+  }
+  cv.notify_all();
+  LOG_INFO("Segment " << name << " switched to its TensorRT engine");
+}
+
+void DeferredEngineSegment::set_build_failed(const std::string& error) {
+  {
+    std::lock_guard<std::mutex> lock(mu);
+    done = true;
+  }
+  cv.notify_all();
+  LOG_WARNING("Segment " << name << " keeps running in Torch, its TensorRT engine was not built: " << error);
+}
+
+c10::intrusive_ptr<TRTEngine> DeferredEngineSegment::get_engine() {
+  std::lock_guard<std::mutex> lock(mu);
+  return engine;
+}
+
+bool DeferredEngineSegment::is_ready() {
+  return get_engine() != nullptr;
+}
+
+bool DeferredEngineSegment::wait() {
+  std::unique_lock<std::mutex> lock(mu);
+  cv.wait(lock, [&] { return done; });
+  return engine != nullptr;
+}
+
+std::vector<at::Tensor> DeferredEngineSegment::run(std::vector<at::Tensor> inputs) {
+  // Each execution runs either the engine or the Torch graph as a whole, the engine is only swapped in between them
+  if (auto trt_engine = get_engine()) {
+    return execute_engine(std::move(inputs), trt_engine);
+  }
+  TORCHTRT_CHECK(
+      inputs.size() == graph->inputs().size(),
+      "Segment " << name << " expects " << graph->inputs().size() << " inputs, got " << inputs.size());
+  torch::jit::Stack stack(std::make_move_iterator(inputs.begin()), std::make_move_iterator(inputs.end()));
+  fallback->run(stack);
+
+  std::vector<at::Tensor> outputs;
+  outputs.reserve(stack.size());
+  for (auto& out : stack) {
+    outputs.push_back(out.toTensor());
+  }
+  return outputs;
+}
+
+std::vector<std::string> DeferredEngineSegment::serialize() {
+  std::vector<std::string> serialized_info = {name, graph->toString(false)};
+  if (auto trt_engine = get_engine()) {
+    auto engine_info = trt_engine->serialize();
+    serialized_info.insert(
+        serialized_info.end(),
+        std::make_move_iterator(engine_info.begin()),
+        std::make_move_iterator(engine_info.end()));
+  }
+  return serialized_info;
+}
+
+std::string DeferredEngineSegment::to_str() {
+  std::ostringstream ss;
+  ss << "Deferred engine segment {" << std::endl;
+  ss << "  Name: " << name << std::endl;
+  auto trt_engine = get_engine();
+  ss << "  Engine: " << (trt_engine ? trt_engine->name : "(running in Torch)") << std::endl;
+  ss << "  Graph: " << *graph;
+  ss << "}" << std::endl;
+  return ss.str();
+}
+
+std::vector<at::Tensor> execute_deferred_engine_segment(
+    std::vector<at::Tensor> inputs,
+    c10::intrusive_ptr<DeferredEngineSegment> segment) {
+  return segment->run(std::move(inputs));
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,57 @@
+#pragma once
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ATen/Tensor.h"
+#include "torch/csrc/jit/ir/ir.h"
+#include "torch/csrc/jit/runtime/graph_executor.h"
+#include "torch/custom_class.h"
+
+#include "core/runtime/TRTEngine.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// A TensorRT segment of a hybrid graph whose engine is built on a background thread after compilation returns (see
+// CompileSpec::background_build). Until the engine is set the segment runs its original Torch graph through a
+// TorchScript executor, every execution starting after set_engine runs the engine instead
+struct DeferredEngineSegment : torch::CustomClassHolder {
+  DeferredEngineSegment(std::string name, std::shared_ptr<torch::jit::Graph> graph);
+  // {name, graph IR, serialized engine info...}, the format of serialize. The engine info is empty if the engine had
+  // not been built when the segment was serialized, such segments keep running their Torch graph
+  DeferredEngineSegment(std::vector<std::string> serialized_info);
+
+  std::vector<at::Tensor> run(std::vector<at::Tensor> inputs);
+  void set_engine(c10::intrusive_ptr<TRTEngine> engine);
+  // Records that the engine will not be built, the segment keeps running its Torch graph
+  void set_build_failed(const std::string& error);
+  // nullptr until the engine is set
+  c10::intrusive_ptr<TRTEngine> get_engine();
+  bool is_ready();
+  // Blocks until the engine is set or its build failed, returns whether the segment runs the engine
+  bool wait();
+  std::vector<std::string> serialize();
+  std::string to_str();
+
+  std::string name;
+  std::shared_ptr<torch::jit::Graph> graph;
+
+ private:
+  std::mutex mu;
+  std::condition_variable cv;
+  c10::intrusive_ptr<TRTEngine> engine;
+  bool done = false;
+  std::unique_ptr<torch::jit::GraphExecutor> fallback;
+};
+
+std::vector<at::Tensor> execute_deferred_engine_segment(
+    std::vector<at::Tensor> inputs,
+    c10::intrusive_ptr<DeferredEngineSegment> segment);
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
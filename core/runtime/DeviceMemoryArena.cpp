@@ -0,0 +1,54 @@
+#include "ATen/ATen.h"
+
+#include "core/runtime/DeviceMemoryArena.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+DeviceMemoryArena::DeviceMemoryArena(c10::DeviceIndex device) : device_index(device) {}
+
+void DeviceMemoryArena::reserve(int64_t nbytes) {
+  std::lock_guard<std::mutex> guard(mu);
+  if (nbytes > reserved_bytes) {
+    LOG_DEBUG("Shared device memory arena on device " << device_index << " grows to " << nbytes << "B");
+    reserved_bytes = nbytes;
+  }
+}
+
+int64_t DeviceMemoryArena::size() const {
+  return reserved_bytes;
+}
+
+c10::DeviceIndex DeviceMemoryArena::device() const {
+  return device_index;
+}
+
+std::unique_lock<std::mutex> DeviceMemoryArena::lock() {
+  return std::unique_lock<std::mutex>(mu);
+}
+
+void* DeviceMemoryArena::data() {
+  if (!buffer.defined() || buffer.nbytes() < static_cast<size_t>(reserved_bytes)) {
+    // The previous allocation may still be read by in-flight work, it can only be released once that is done
+    if (last_use.isCreated()) {
+      last_use.synchronize();
+    }
+    buffer = at::Tensor();
+    buffer = at::empty({reserved_bytes}, at::TensorOptions().device(at::kCUDA, device_index).dtype(at::kByte));
+  }
+  return buffer.data_ptr();
+}
+
+void DeviceMemoryArena::wait(const c10::cuda::CUDAStream& stream) {
+  last_use.block(stream);
+}
+
+void DeviceMemoryArena::record(const c10::cuda::CUDAStream& stream) {
+  last_use.record(stream);
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+
+#include "ATen/Tensor.h"
+#include "ATen/cuda/CUDAEvent.h"
+#include "c10/cuda/CUDAStream.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Device scratch (activation) memory shared between the execution contexts of several engines, for instance the
+// TensorRT segments of a partitioned module which run one after another. The arena is sized to the largest
+// requirement of the engines attached to it. Executions hold the arena lock from binding the memory to their context
+// until they have enqueued their work, and the engine stream waits for the previous user of the arena before it
+// runs, so sharing is safe regardless of which streams the engines execute on.
+class DeviceMemoryArena {
+ public:
+  explicit DeviceMemoryArena(c10::DeviceIndex device);
+
+  // Raise the size of the arena to at least nbytes, the backing allocation grows lazily on next use
+  void reserve(int64_t nbytes);
+  int64_t size() const;
+  c10::DeviceIndex device() const;
+
+  std::unique_lock<std::mutex> lock();
+  // Returns the base address of the arena, (re)allocating it if it is smaller than the reserved size. Expects the
+  // arena lock to be held
+  void* data();
+  // Order the next use of the arena after the last one. Expects the arena lock to be held
+  void wait(const c10::cuda::CUDAStream& stream);
+  void record(const c10::cuda::CUDAStream& stream);
+
+ private:
+  c10::DeviceIndex device_index;
+  int64_t reserved_bytes = 0;
+  at::Tensor buffer;
+  at::cuda::CUDAEvent last_use;
+  std::mutex mu;
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
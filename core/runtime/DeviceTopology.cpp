@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "cuda_runtime.h"
+
+#include "ATen/ATen.h"
+#include "ATen/cuda/PeerToPeerAccess.h"
+
+#include "core/runtime/DeviceTopology.h"
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+namespace {
+
+int read_numa_node(int device) {
+#ifdef __linux__
+  char bus_id[64];
+  if (cudaDeviceGetPCIBusId(bus_id, sizeof(bus_id), device) != cudaSuccess) {
+    cudaGetLastError();
+    return -1;
+  }
+  std::string path = "/sys/bus/pci/devices/" + std::string(bus_id) + "/numa_node";
+  std::transform(path.begin(), path.end(), path.begin(), [](unsigned char c) { return std::tolower(c); });
+  std::ifstream file(path);
+  int node = -1;
+  if (file >> node) {
+    return node;
+  }
+#endif
+  return -1;
+}
+
+} // namespace
+
+const DeviceTopology& DeviceTopology::get() {
+  static const DeviceTopology topology;
+  return topology;
+}
+
+DeviceTopology::DeviceTopology() {
+  int num_devices = 0;
+  if (cudaGetDeviceCount(&num_devices) != cudaSuccess) {
+    cudaGetLastError();
+    num_devices = 0;
+  }
+  for (int i = 0; i < num_devices; i++) {
+    numa_nodes.push_back(read_numa_node(i));
+  }
+
+  links.resize(num_devices * num_devices);
+  for (int from = 0; from < num_devices; from++) {
+    for (int to = 0; to < num_devices; to++) {
+      auto& link = links[from * num_devices + to];
+      int peer = 0;
+      int atomics = 0;
+      if (from == to) {
+        link = SAME_DEVICE;
+      } else if (cudaDeviceCanAccessPeer(&peer, from, to) == cudaSuccess && peer) {
+        cudaDeviceGetP2PAttribute(&atomics, cudaDevP2PAttrNativeAtomicSupported, from, to);
+        link = atomics ? NVLINK : PCIE_PEER;
+      } else {
+        link = is_local(to, numa_nodes[from]) ? HOST_SAME_NUMA_NODE : HOST_CROSS_NUMA_NODE;
+      }
+    }
+  }
+  cudaGetLastError();
+  LOG_DEBUG("Device topology:\n" << dump());
+}
+
+DeviceLink DeviceTopology::link(int64_t from, int64_t to) const {
+  auto n = num_devices();
+  if (from < 0 || to < 0 || from >= n || to >= n) {
+    return from == to ? SAME_DEVICE : HOST_CROSS_NUMA_NODE;
+  }
+  return links[from * n + to];
+}
+
+bool DeviceTopology::can_access_peer(int64_t from, int64_t to) const {
+  auto l = link(from, to);
+  return l == NVLINK || l == PCIE_PEER;
+}
+
+int DeviceTopology::numa_node(int64_t device) const {
+  return device >= 0 && device < num_devices() ? numa_nodes[device] : -1;
+}
+
+bool DeviceTopology::is_local(int64_t device, int node) const {
+  auto device_node = numa_node(device);
+  return device_node < 0 || node < 0 || device_node == node;
+}
+
+void DeviceTopology::enable_peer_access(int64_t a, int64_t b) const {
+  if (a != b && can_access_peer(a, b)) {
+    at::cuda::get_p2p_access(static_cast<c10::DeviceIndex>(a), static_cast<c10::DeviceIndex>(b));
+    at::cuda::get_p2p_access(static_cast<c10::DeviceIndex>(b), static_cast<c10::DeviceIndex>(a));
+  }
+}
+
+std::string DeviceTopology::dump() const {
+  const char* names[] = {"X", "NV", "PCIE", "NODE", "SYS"};
+  std::stringstream ss;
+  for (int64_t from = 0; from < num_devices(); from++) {
+    ss << "    GPU" << from << " (NUMA node " << numa_node(from) << "):";
+    for (int64_t to = 0; to < num_devices(); to++) {
+      ss << ' ' << names[link(from, to)];
+    }
+    ss << std::endl;
+  }
+  return ss.str();
+}
+
+int current_numa_node() {
+#ifdef __linux__
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return static_cast<int>(node);
+  }
+#endif
+  return -1;
+}
+
+at::Tensor empty_pinned_host_buffer(int64_t nbytes, int64_t device) {
+  auto options = at::TensorOptions().dtype(at::kByte);
+#ifdef __linux__
+  auto node = DeviceTopology::get().numa_node(device);
+  if (NUMA_LOCAL_HOST_STAGING && node >= 0 && nbytes > 0) {
+    auto size = static_cast<size_t>(nbytes);
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr != MAP_FAILED) {
+      std::vector<unsigned long> node_mask(node / (8 * sizeof(unsigned long)) + 1, 0);
+      node_mask[node / (8 * sizeof(unsigned long))] |= 1ul << (node % (8 * sizeof(unsigned long)));
+      // Preferred rather than bound, so the buffer still gets memory if the node is full. The pages are faulted in,
+      // on the node, when CUDA pins them
+      auto max_node = node_mask.size() * 8 * sizeof(unsigned long) + 1;
+      if (syscall(SYS_mbind, ptr, size, MPOL_PREFERRED, node_mask.data(), max_node, 0) == 0 &&
+          cudaHostRegister(ptr, size, cudaHostRegisterDefault) == cudaSuccess) {
+        auto release = [size](void* p) {
+          cudaHostUnregister(p);
+          munmap(p, size);
+        };
+        return at::from_blob(ptr, {nbytes}, release, options);
+      }
+      cudaGetLastError();
+      munmap(ptr, size);
+    }
+    LOG_DEBUG("Unable to place a pinned buffer of " << nbytes << " bytes on NUMA node " << node);
+  }
+#endif
+  return at::empty({nbytes}, options.pinned_memory(true));
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,57 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "ATen/Tensor.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// How data moves between two devices, from the nearest to the farthest
+typedef enum {
+  SAME_DEVICE = 0,
+  NVLINK, // Peer access with native atomics, which PCIe peers do not offer
+  PCIE_PEER,
+  // No peer access, copies are staged through host memory which is local to both devices or not
+  HOST_SAME_NUMA_NODE,
+  HOST_CROSS_NUMA_NODE,
+} DeviceLink;
+
+// Interconnect of the GPUs visible to the process and the NUMA node their PCIe root is attached to, discovered once
+// per process. NUMA nodes are read from sysfs and unknown (-1) on other platforms or single socket machines
+class DeviceTopology {
+ public:
+  static const DeviceTopology& get();
+
+  int64_t num_devices() const {
+    return static_cast<int64_t>(numa_nodes.size());
+  }
+  DeviceLink link(int64_t from, int64_t to) const;
+  bool can_access_peer(int64_t from, int64_t to) const;
+  int numa_node(int64_t device) const;
+  // Whether the device is attached to the given NUMA node, unknown nodes are considered local
+  bool is_local(int64_t device, int node) const;
+  // Enables peer access between the two devices in both directions if they support it. Enabling is cached by PyTorch
+  // and is what makes its device to device copies run peer to peer instead of through the host
+  void enable_peer_access(int64_t a, int64_t b) const;
+  std::string dump() const;
+
+ private:
+  DeviceTopology();
+
+  std::vector<int> numa_nodes;
+  std::vector<DeviceLink> links; // num_devices x num_devices, row major by source device
+};
+
+// NUMA node of the CPU the calling thread is running on, -1 if unknown
+int current_numa_node();
+
+// Pinned host buffer of nbytes for transfers to or from device. With NUMA_LOCAL_HOST_STAGING and a known NUMA node
+// of the device, its pages are placed on that node so transfers do not cross the socket interconnect. Otherwise it
+// comes from PyTorch's pinned host allocator
+at::Tensor empty_pinned_host_buffer(int64_t nbytes, int64_t device);
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,201 @@
+#include "core/runtime/DynamicBatcher.h"
+
+#include "c10/cuda/CUDACachingAllocator.h"
+#include "c10/cuda/CUDAGuard.h"
+
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+namespace {
+thread_local bool is_batcher_worker = false;
+
+// Requests can be concatenated if they only differ in their batch dimension
+bool can_concatenate(const std::vector<at::Tensor>& a, const std::vector<at::Tensor>& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].scalar_type() != b[i].scalar_type() || a[i].device() != b[i].device() || a[i].dim() != b[i].dim() ||
+        a[i].sizes().slice(1) != b[i].sizes().slice(1)) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+DynamicBatcher::Request::Request(std::vector<at::Tensor> inputs, int64_t batch, c10::intrusive_ptr<TRTEngine> engine)
+    : inputs(std::move(inputs)),
+      batch(batch),
+      engine(std::move(engine)),
+      stream(c10::cuda::getCurrentCUDAStream(this->inputs[0].device().index())),
+      arrival(std::chrono::steady_clock::now()) {}
+
+DynamicBatcher::DynamicBatcher(int64_t window_us, int64_t max_batch_size)
+    : window_us(window_us), max_batch_size(max_batch_size) {
+  worker = std::thread([this]() { run(); });
+}
+
+DynamicBatcher::~DynamicBatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mu);
+    stop = true;
+  }
+  cv.notify_all();
+  // The worker drains the queue before exiting
+  worker.join();
+}
+
+bool DynamicBatcher::on_worker_thread() {
+  return is_batcher_worker;
+}
+
+std::optional<std::vector<at::Tensor>> DynamicBatcher::submit(
+    std::vector<at::Tensor> inputs,
+    c10::intrusive_ptr<TRTEngine> engine) {
+  if (inputs.empty() || engine->has_shape_tensor_inputs) {
+    return std::nullopt;
+  }
+  int64_t batch = -1;
+  for (const auto& in : inputs) {
+    if (!in.defined() || !in.is_cuda() || in.dim() == 0 || (batch >= 0 && in.size(0) != batch)) {
+      return std::nullopt;
+    }
+    batch = in.size(0);
+  }
+  if (batch > max_batch_size.load(std::memory_order_relaxed)) {
+    return std::nullopt;
+  }
+
+  auto request = std::make_shared<Request>(std::move(inputs), batch, std::move(engine));
+  request->ready.record(request->stream);
+  auto result = request->promise.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mu);
+    queue.push_back(request);
+    queued_batch += batch;
+  }
+  cv.notify_one();
+
+  // Rethrows the error of the batched execution if there was one
+  result.get();
+  request->done->block(request->stream);
+  return std::move(request->outputs);
+}
+
+void DynamicBatcher::run() {
+  is_batcher_worker = true;
+  std::unique_lock<std::mutex> lock(mu);
+  while (true) {
+    cv.wait(lock, [this]() { return stop || !queue.empty(); });
+    if (queue.empty()) {
+      break;
+    }
+    auto deadline = queue.front()->arrival + std::chrono::microseconds(window_us.load(std::memory_order_relaxed));
+    cv.wait_until(lock, deadline, [this]() {
+      return stop || queued_batch >= max_batch_size.load(std::memory_order_relaxed);
+    });
+    auto batch = take_batch();
+    lock.unlock();
+    execute(batch);
+    lock.lock();
+  }
+}
+
+std::vector<std::shared_ptr<DynamicBatcher::Request>> DynamicBatcher::take_batch() {
+  std::vector<std::shared_ptr<Request>> batch = {queue.front()};
+  queue.pop_front();
+  int64_t batch_size = batch[0]->batch;
+  int64_t max = max_batch_size.load(std::memory_order_relaxed);
+  for (auto it = queue.begin(); it != queue.end() && batch_size < max;) {
+    auto& request = *it;
+    if (request->engine.get() == batch[0]->engine.get() && batch_size + request->batch <= max &&
+        can_concatenate(request->inputs, batch[0]->inputs)) {
+      batch_size += request->batch;
+      batch.push_back(std::move(request));
+      it = queue.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  queued_batch -= batch_size;
+  return batch;
+}
+
+void DynamicBatcher::execute(std::vector<std::shared_ptr<Request>>& batch) {
+  // The worker must never hold the last reference to the engine since destroying the engine stops the worker. Callers
+  // keep the engine alive until their request completes, so every reference is dropped before completing them
+  auto engine = batch[0]->engine;
+  for (auto& request : batch) {
+    request->engine.reset();
+  }
+  try {
+    auto device = batch[0]->stream.device_index();
+    c10::cuda::CUDAGuard device_guard(device);
+    auto stream = c10::cuda::getStreamFromPool(engine->qos_class == QOS_LATENCY_CRITICAL, device);
+    c10::cuda::CUDAStreamGuard stream_guard(stream);
+
+    int64_t batch_size = 0;
+    for (auto& request : batch) {
+      request->ready.block(stream);
+      batch_size += request->batch;
+    }
+
+    std::vector<at::Tensor> inputs;
+    if (batch.size() == 1) {
+      inputs = std::move(batch[0]->inputs);
+    } else {
+      inputs.reserve(batch[0]->inputs.size());
+      for (size_t i = 0; i < batch[0]->inputs.size(); i++) {
+        std::vector<at::Tensor> parts;
+        parts.reserve(batch.size());
+        for (auto& request : batch) {
+          parts.push_back(request->inputs[i]);
+        }
+        inputs.push_back(at::cat(parts, 0));
+      }
+    }
+    LOG_DEBUG(
+        "Running " << batch.size() << " requests as a batch of " << batch_size << " on engine " << engine->name);
+
+    // Outputs aliasing the inputs are returned by the execution of each request
+    auto outputs = execute_engine_bindings(std::move(inputs), engine);
+    auto done = std::make_shared<at::cuda::CUDAEvent>();
+    done->record(stream);
+    increment(engine->metrics.dynamic_batches);
+    increment(engine->metrics.dynamic_batched_requests, static_cast<int64_t>(batch.size()));
+
+    int64_t offset = 0;
+    for (auto& request : batch) {
+      request->outputs.reserve(outputs.size());
+      for (auto& out : outputs) {
+        // Outputs without the batch dimension are shared by every request
+        bool batched = batch.size() > 1 && out.dim() > 0 && out.size(0) == batch_size;
+        request->outputs.push_back(batched ? out.narrow(0, offset, request->batch) : out);
+        // The outputs are allocated on the worker stream but consumed on the caller's
+        if (request->stream != stream) {
+          c10::cuda::CUDACachingAllocator::recordStream(out.storage().data_ptr(), request->stream);
+        }
+      }
+      request->done = done;
+      offset += request->batch;
+    }
+    engine.reset();
+    for (auto& request : batch) {
+      request->promise.set_value();
+    }
+  } catch (...) {
+    engine.reset();
+    for (auto& request : batch) {
+      request->promise.set_exception(std::current_exception());
+    }
+  }
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
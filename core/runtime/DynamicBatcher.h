@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "ATen/Tensor.h"
+#include "ATen/cuda/CUDAEvent.h"
+#include "c10/cuda/CUDAStream.h"
+#include "torch/custom_class.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+struct TRTEngine;
+
+// Collects concurrent executions of an engine and runs them as one. Requests are queued by the calling threads and a
+// worker thread waits up to the batching window after the oldest request for more requests to arrive, concatenates
+// the compatible ones (same trailing shapes, dtypes and devices) along the batch dimension up to the max batch size,
+// executes the engine once and scatters the outputs back to each caller. Callers and the worker are ordered with CUDA
+// events so batching is transparent to the caller's stream.
+class DynamicBatcher {
+ public:
+  DynamicBatcher(int64_t window_us, int64_t max_batch_size);
+  ~DynamicBatcher();
+  DynamicBatcher(const DynamicBatcher&) = delete;
+  DynamicBatcher& operator=(const DynamicBatcher&) = delete;
+
+  // Runs inputs as part of a batch and blocks until its outputs are ready. Returns nullopt without running anything
+  // if the inputs cannot be batched (shape tensor inputs, inputs without a common batch dimension or larger than the
+  // max batch size), in which case the caller should execute them directly
+  std::optional<std::vector<at::Tensor>> submit(std::vector<at::Tensor> inputs, c10::intrusive_ptr<TRTEngine> engine);
+  // Executions issued by the worker itself must not be batched again
+  static bool on_worker_thread();
+
+  std::atomic<int64_t> window_us;
+  std::atomic<int64_t> max_batch_size;
+
+ private:
+  struct Request {
+    std::vector<at::Tensor> inputs;
+    std::vector<at::Tensor> outputs;
+    int64_t batch;
+    c10::intrusive_ptr<TRTEngine> engine;
+    c10::cuda::CUDAStream stream;
+    at::cuda::CUDAEvent ready; // Inputs are ready on the caller stream
+    std::shared_ptr<at::cuda::CUDAEvent> done; // Outputs are ready on the worker stream
+    std::promise<void> promise;
+    std::chrono::steady_clock::time_point arrival;
+
+    Request(std::vector<at::Tensor> inputs, int64_t batch, c10::intrusive_ptr<TRTEngine> engine);
+  };
+
+  void run();
+  // Takes the oldest request and the queued requests which can be concatenated with it. Expects mu to be held
+  std::vector<std::shared_ptr<Request>> take_batch();
+  void execute(std::vector<std::shared_ptr<Request>>& batch);
+
+  std::deque<std::shared_ptr<Request>> queue;
+  int64_t queued_batch = 0;
+  bool stop = false;
+  std::mutex mu;
+  std::condition_variable cv;
+  std::thread worker;
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
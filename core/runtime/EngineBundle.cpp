@@ -0,0 +1,117 @@
+#include "core/runtime/EngineBundle.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+namespace {
+
+void write_u64(std::string& out, uint64_t v) {
+  out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+void write_bytes(std::string& out, const std::string& bytes) {
+  write_u64(out, bytes.size());
+  out.append(bytes);
+}
+
+struct BundleReader {
+  const std::string& bundle;
+  size_t pos;
+
+  uint64_t read_u64() {
+    TORCHTRT_CHECK(pos + sizeof(uint64_t) <= bundle.size(), "Engine bundle is truncated");
+    uint64_t v = 0;
+    std::memcpy(&v, bundle.data() + pos, sizeof(v));
+    pos += sizeof(v);
+    return v;
+  }
+
+  std::string read_bytes(bool skip = false) {
+    auto size = read_u64();
+    TORCHTRT_CHECK(size <= bundle.size() - pos, "Engine bundle is truncated");
+    auto bytes = skip ? std::string() : bundle.substr(pos, size);
+    pos += size;
+    return bytes;
+  }
+};
+
+} // namespace
+
+bool is_engine_bundle(const std::string& serialized_engine) {
+  return serialized_engine.compare(0, ENGINE_BUNDLE_MAGIC.size(), ENGINE_BUNDLE_MAGIC) == 0;
+}
+
+std::string serialize_engine_bundle(const std::vector<EngineBundleVariant>& variants) {
+  // Engines can be several GB, reserve (roughly) once instead of growing the bundle while appending
+  size_t size = ENGINE_BUNDLE_MAGIC.size() + sizeof(uint64_t);
+  for (const auto& v : variants) {
+    size += 2 * sizeof(uint64_t) + 1 + v.serialized_engine.size();
+  }
+  std::string bundle;
+  bundle.reserve(size);
+  bundle.append(ENGINE_BUNDLE_MAGIC);
+  write_u64(bundle, variants.size());
+  for (const auto& v : variants) {
+    auto device = v.device;
+    write_bytes(bundle, device.serialize());
+    bundle.push_back(v.hardware_compatible ? 1 : 0);
+    write_bytes(bundle, v.serialized_engine);
+  }
+  return bundle;
+}
+
+std::vector<EngineBundleVariant> deserialize_engine_bundle(const std::string& bundle, bool with_engines) {
+  TORCHTRT_CHECK(is_engine_bundle(bundle), "Serialized engine is not an engine bundle");
+  BundleReader reader{bundle, ENGINE_BUNDLE_MAGIC.size()};
+  auto num_variants = reader.read_u64();
+  std::vector<EngineBundleVariant> variants;
+  for (uint64_t i = 0; i < num_variants; i++) {
+    EngineBundleVariant v;
+    v.device = RTDevice(reader.read_bytes());
+    TORCHTRT_CHECK(reader.pos < bundle.size(), "Engine bundle is truncated");
+    v.hardware_compatible = bundle[reader.pos++] != 0;
+    v.serialized_engine = reader.read_bytes(/*skip=*/!with_engines);
+    variants.push_back(std::move(v));
+  }
+  return variants;
+}
+
+c10::optional<size_t> select_engine_bundle_variant(const std::vector<EngineBundleVariant>& variants) {
+  auto current_device = get_current_device();
+  c10::optional<size_t> best;
+  int best_rank = 0;
+  for (size_t i = 0; i < variants.size(); i++) {
+    const auto& v = variants[i];
+    // 4: exact SM on the current device, 3: exact SM on another device, 2 / 1: same for hardware compatible engines
+    int rank = 0;
+    auto devices = find_compatible_devices(v.device, false);
+    if (!devices.empty()) {
+      rank = 3;
+    } else if (v.hardware_compatible) {
+      devices = find_compatible_devices(v.device, true);
+      rank = devices.empty() ? 0 : 1;
+    }
+    for (const auto& d : devices) {
+      if (d.id == current_device.id) {
+        rank++;
+        break;
+      }
+    }
+    LOG_DEBUG("Engine bundle variant " << i << " built for " << v.device << " ranked " << rank);
+    if (rank > best_rank) {
+      best = i;
+      best_rank = rank;
+    }
+  }
+  return best;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
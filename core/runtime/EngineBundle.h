@@ -0,0 +1,37 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "c10/util/Optional.h"
+#include "core/runtime/RTDevice.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Engines built from the same segment for several GPU architectures can be stored together as a bundle in place of
+// the serialized engine (at ENGINE_IDX). The engine to load is only picked when the bundle is deserialized, so one
+// program runs with an engine built for the SM of each GPU it is deployed on. Bundles start with ENGINE_BUNDLE_MAGIC
+// followed by the number of variants and, per variant, the length prefixed serialized RTDevice, a hardware
+// compatibility byte and the length prefixed engine
+const std::string ENGINE_BUNDLE_MAGIC = "TORCHTRT_ENGINE_BUNDLE_1";
+
+struct EngineBundleVariant {
+  RTDevice device; // Device the engine was built for
+  bool hardware_compatible = false;
+  std::string serialized_engine;
+};
+
+bool is_engine_bundle(const std::string& serialized_engine);
+std::string serialize_engine_bundle(const std::vector<EngineBundleVariant>& variants);
+// Without engines, only the devices and hardware compatibility of the variants are read
+std::vector<EngineBundleVariant> deserialize_engine_bundle(const std::string& bundle, bool with_engines = true);
+
+// Picks the variant to load on this machine: first an engine built for the SM of the current device, then one built
+// for the SM of another available device, and only then a hardware compatible engine which any available device can
+// run. Returns nothing if no variant can run on this machine
+c10::optional<size_t> select_engine_bundle_variant(const std::vector<EngineBundleVariant>& variants);
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
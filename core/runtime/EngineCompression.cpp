@@ -0,0 +1,162 @@
+#include "core/runtime/EngineCompression.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "zstd.h"
+
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+namespace {
+
+struct Chunk {
+  uint64_t size = 0; // Uncompressed
+  uint64_t compressed_size = 0;
+  size_t offset = 0; // Of the chunk in the uncompressed data
+  size_t compressed_offset = 0; // Of the compressed chunk in the payload
+};
+
+void write_u64(std::string& out, uint64_t v) {
+  out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+uint64_t read_u64(const std::string& payload, size_t& pos) {
+  TORCHTRT_CHECK(pos + sizeof(uint64_t) <= payload.size(), "Compressed engine is truncated");
+  uint64_t v = 0;
+  std::memcpy(&v, payload.data() + pos, sizeof(v));
+  pos += sizeof(v);
+  return v;
+}
+
+// Runs fn(i) for i in [0, n) on up to num_threads threads, rethrowing the first error
+template <typename F>
+void parallel_for(size_t n, int64_t num_threads, F fn) {
+  size_t num_workers = num_threads > 0 ? static_cast<size_t>(num_threads) : std::thread::hardware_concurrency();
+  num_workers = std::max<size_t>(1, std::min(num_workers, n));
+  std::atomic<size_t> next = {0};
+  std::vector<std::exception_ptr> errors(num_workers);
+  auto worker = [&](size_t worker_id) {
+    try {
+      for (size_t i = next++; i < n; i = next++) {
+        fn(i);
+      }
+    } catch (...) {
+      errors[worker_id] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t w = 1; w < num_workers; w++) {
+    threads.emplace_back(worker, w);
+  }
+  worker(0);
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (auto& e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+}
+
+} // namespace
+
+bool is_compressed_engine(const void* data, size_t size) {
+  return size >= COMPRESSED_ENGINE_MAGIC.size() &&
+      std::memcmp(data, COMPRESSED_ENGINE_MAGIC.data(), COMPRESSED_ENGINE_MAGIC.size()) == 0;
+}
+
+bool is_compressed_engine(const std::string& payload) {
+  return is_compressed_engine(payload.data(), payload.size());
+}
+
+std::string compress_engine(const void* data, size_t size, int64_t level, int64_t num_threads) {
+  TORCHTRT_CHECK(
+      level >= 1 && level <= ZSTD_maxCLevel(),
+      "Engine compression level must be between 1 and " << ZSTD_maxCLevel() << ", got " << level);
+  auto src = static_cast<const char*>(data);
+  size_t num_chunks = (size + COMPRESSED_ENGINE_CHUNK_SIZE - 1) / COMPRESSED_ENGINE_CHUNK_SIZE;
+  std::vector<Chunk> chunks(num_chunks);
+  std::vector<std::string> compressed(num_chunks);
+  parallel_for(num_chunks, num_threads, [&](size_t i) {
+    auto& c = chunks[i];
+    c.offset = i * COMPRESSED_ENGINE_CHUNK_SIZE;
+    c.size = std::min(COMPRESSED_ENGINE_CHUNK_SIZE, size - c.offset);
+    compressed[i].resize(ZSTD_compressBound(c.size));
+    auto n = ZSTD_compress(&compressed[i][0], compressed[i].size(), src + c.offset, c.size, static_cast<int>(level));
+    TORCHTRT_CHECK(!ZSTD_isError(n), "Unable to compress the engine: " << ZSTD_getErrorName(n));
+    compressed[i].resize(n);
+    c.compressed_size = n;
+  });
+
+  size_t payload_size = COMPRESSED_ENGINE_MAGIC.size() + 1 + (2 + 2 * num_chunks) * sizeof(uint64_t);
+  for (const auto& c : compressed) {
+    payload_size += c.size();
+  }
+  std::string payload;
+  payload.reserve(payload_size);
+  payload.append(COMPRESSED_ENGINE_MAGIC);
+  payload.push_back(static_cast<char>(EngineCompressionCodec::kZSTD));
+  write_u64(payload, size);
+  write_u64(payload, num_chunks);
+  for (const auto& c : chunks) {
+    write_u64(payload, c.size);
+    write_u64(payload, c.compressed_size);
+  }
+  for (auto& c : compressed) {
+    payload.append(c);
+    std::string().swap(c);
+  }
+  LOG_DEBUG("Compressed a " << size << "B engine to " << payload.size() << "B in " << num_chunks << " chunks");
+  return payload;
+}
+
+std::string decompress_engine(const std::string& payload, int64_t num_threads) {
+  TORCHTRT_CHECK(is_compressed_engine(payload), "Serialized engine is not compressed");
+  size_t pos = COMPRESSED_ENGINE_MAGIC.size();
+  TORCHTRT_CHECK(pos < payload.size(), "Compressed engine is truncated");
+  auto codec = static_cast<uint8_t>(payload[pos++]);
+  TORCHTRT_CHECK(
+      codec == static_cast<uint8_t>(EngineCompressionCodec::kZSTD),
+      "Engine is compressed with codec " << static_cast<int>(codec) << " which this runtime does not support");
+  auto size = read_u64(payload, pos);
+  auto num_chunks = read_u64(payload, pos);
+  TORCHTRT_CHECK(num_chunks <= payload.size() / (2 * sizeof(uint64_t)), "Compressed engine is truncated");
+
+  std::vector<Chunk> chunks(num_chunks);
+  size_t offset = 0;
+  for (auto& c : chunks) {
+    c.size = read_u64(payload, pos);
+    c.compressed_size = read_u64(payload, pos);
+    c.offset = offset;
+    offset += c.size;
+  }
+  TORCHTRT_CHECK(offset == size, "Compressed engine is corrupted, its chunks do not add up to " << size << "B");
+  for (auto& c : chunks) {
+    TORCHTRT_CHECK(c.compressed_size <= payload.size() - pos, "Compressed engine is truncated");
+    c.compressed_offset = pos;
+    pos += c.compressed_size;
+  }
+
+  std::string engine(size, '\0');
+  parallel_for(num_chunks, num_threads, [&](size_t i) {
+    const auto& c = chunks[i];
+    auto n = ZSTD_decompress(&engine[c.offset], c.size, payload.data() + c.compressed_offset, c.compressed_size);
+    TORCHTRT_CHECK(!ZSTD_isError(n), "Unable to decompress the engine: " << ZSTD_getErrorName(n));
+    TORCHTRT_CHECK(
+        n == c.size, "Compressed engine is corrupted, chunk " << i << " is " << n << "B, expected " << c.size);
+  });
+  return engine;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Serialized engines (or engine bundles) embedded in a module can be stored compressed in place of the payload at
+// ENGINE_IDX. Compressed payloads start with COMPRESSED_ENGINE_MAGIC followed by the codec, the uncompressed size, the
+// number of chunks and, per chunk, its uncompressed and compressed sizes, then the compressed chunks. Chunks are
+// independent zstd frames so they are compressed and decompressed on several threads
+const std::string COMPRESSED_ENGINE_MAGIC = "TORCHTRT_COMPRESSED_ENGINE_1";
+// Uncompressed size of each chunk, large enough for the ratio to match compressing the engine as a whole
+constexpr size_t COMPRESSED_ENGINE_CHUNK_SIZE = 16 << 20;
+
+enum class EngineCompressionCodec : uint8_t {
+  kZSTD = 1,
+};
+
+bool is_compressed_engine(const void* data, size_t size);
+bool is_compressed_engine(const std::string& payload);
+
+// level is the zstd compression level (1 to 22), num_threads 0: one per hardware thread
+std::string compress_engine(const void* data, size_t size, int64_t level, int64_t num_threads = 0);
+std::string decompress_engine(const std::string& payload, int64_t num_threads = 0);
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
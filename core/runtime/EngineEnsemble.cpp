@@ -0,0 +1,278 @@
+#include <sstream>
+#include <utility>
+
+#include "cuda_runtime.h"
+
+#include "ATen/cuda/CUDAEvent.h"
+#include "c10/cuda/CUDAGuard.h"
+#include "c10/cuda/CUDAStream.h"
+
+#include "core/runtime/EngineEnsemble.h"
+#include "core/runtime/SegmentStreams.h"
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+namespace {
+// Outputs are placed in the arena at offsets aligned for TensorRT bindings
+constexpr int64_t kOutputAlignment = 256;
+
+// Whether the outputs of the engine can be written into tensors allocated before it runs
+bool outputs_known_ahead(const TRTEngine& engine) {
+  if (engine.dla_loadable || engine.has_data_dependent_outputs || engine.has_shape_tensor_inputs ||
+      !engine.replicas.empty() || engine.dynamic_batcher) {
+    return false;
+  }
+  for (const auto& format : engine.binding_table.output_formats) {
+    if (!format.is_linear()) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+EngineEnsemble::EngineEnsemble(std::vector<c10::intrusive_ptr<TRTEngine>> engines) : engines(std::move(engines)) {
+  TORCHTRT_CHECK(!this->engines.empty(), "An engine ensemble needs at least one engine");
+  for (size_t k = 0; k < this->engines.size(); k++) {
+    auto& engine = this->engines[k];
+    TORCHTRT_CHECK(engine, "Engine " << k << " of the engine ensemble is None");
+    TORCHTRT_CHECK(
+        engine->in_binding_names.size() == this->engines[0]->in_binding_names.size(),
+        "Engine " << engine->name << " takes " << engine->in_binding_names.size() << " inputs but engine "
+                  << this->engines[0]->name << " takes " << this->engines[0]->in_binding_names.size()
+                  << ", the members of an ensemble run on the same inputs");
+    TORCHTRT_CHECK(
+        engine->device_info.id == this->engines[0]->device_info.id,
+        "Engine " << engine->name << " is on device " << engine->device_info.id << " but engine "
+                  << this->engines[0]->name << " is on device " << this->engines[0]->device_info.id
+                  << ", the members of an ensemble share their inputs and outputs on one device");
+  }
+  num_inputs = static_cast<int64_t>(this->engines[0]->in_binding_names.size());
+}
+
+EngineEnsemble::OutputLayout EngineEnsemble::layout_outputs(const std::vector<at::Tensor>& inputs) {
+  std::vector<std::vector<int64_t>> shapes;
+  shapes.reserve(inputs.size());
+  for (const auto& in : inputs) {
+    shapes.push_back(in.sizes().vec());
+  }
+  OutputLayout layout;
+  layout.members.resize(engines.size());
+  for (size_t k = 0; k < engines.size(); k++) {
+    auto& engine = engines[k];
+    auto& outputs = layout.members[k];
+    outputs.resize(engine->num_outputs());
+    if (!outputs_known_ahead(*engine)) {
+      continue;
+    }
+    auto bound = engine->infer_outputs(shapes);
+    for (size_t o = 0; o < outputs.size(); o++) {
+      at::Tensor like;
+      if (engine->output_sources.empty()) {
+        like = bound[o];
+      } else {
+        const auto& source = engine->output_sources[o];
+        if (source.kind == TRTEngine::OutputSource::kOutput) {
+          // The engine copies the earlier output into it, which is a no-op on the same memory
+          outputs[o] = outputs[source.index];
+          continue;
+        }
+        like = source.kind == TRTEngine::OutputSource::kBinding ? bound[source.index] : inputs[source.index];
+      }
+      outputs[o].shape = like.sizes().vec();
+      outputs[o].dtype = like.scalar_type();
+      outputs[o].nbytes = like.numel() * static_cast<int64_t>(like.element_size());
+      outputs[o].offset = layout.nbytes;
+      layout.nbytes += (outputs[o].nbytes + kOutputAlignment - 1) / kOutputAlignment * kOutputAlignment;
+    }
+  }
+  return layout;
+}
+
+std::vector<at::Tensor> EngineEnsemble::arena_views(const OutputLayout& layout, size_t member, const at::Tensor& arena)
+    const {
+  std::vector<at::Tensor> views;
+  for (const auto& out : layout.members[member]) {
+    if (out.offset < 0) {
+      views.emplace_back();
+      continue;
+    }
+    views.push_back(arena.narrow(0, out.offset, out.nbytes).view(out.dtype).view(out.shape));
+  }
+  return views;
+}
+
+std::vector<std::vector<at::Tensor>> EngineEnsemble::run_members(
+    const std::vector<at::Tensor>& inputs,
+    const OutputLayout& layout,
+    const at::Tensor& arena) {
+  // Each member is enqueued on its own stream, which waits for the work enqueued so far on the current stream
+  std::vector<std::vector<at::Tensor>> outputs(engines.size());
+  for (size_t k = 0; k < engines.size(); k++) {
+    auto branch = static_cast<int64_t>(k);
+    auto member_inputs = enter_segment_stream(inputs, branch);
+    try {
+      bool in_arena = !layout.members[k].empty() && layout.members[k][0].offset >= 0;
+      if (in_arena) {
+        outputs[k] = arena_views(layout, k, arena);
+        execute_engine_out(std::move(member_inputs), outputs[k], engines[k]);
+      } else {
+        outputs[k] = execute_engine(std::move(member_inputs), engines[k]);
+      }
+    } catch (...) {
+      exit_segment_stream({}, branch);
+      throw;
+    }
+    exit_segment_stream({}, branch);
+  }
+  for (size_t k = 0; k < engines.size(); k++) {
+    outputs[k] = join_segment_stream(std::move(outputs[k]), static_cast<int64_t>(k));
+  }
+  return outputs;
+}
+
+std::vector<at::Tensor> EngineEnsemble::run_cudagraph(const std::vector<at::Tensor>& inputs) {
+  std::vector<std::vector<int64_t>> shapes;
+  for (const auto& in : inputs) {
+    shapes.push_back(in.sizes().vec());
+  }
+
+  auto device = static_cast<c10::DeviceIndex>(engines[0]->device_info.id);
+  auto options = at::TensorOptions().device(at::kCUDA, device).dtype(at::kByte);
+  std::lock_guard<std::mutex> lock(cudagraph_mu);
+  if (shapes != cudagraph_shapes) {
+    // First execution with these shapes, which initializes the members (contexts, lazy kernel loading, allocator
+    // growth) before they are captured
+    cudagraph.reset();
+    cudagraph_inputs.clear();
+    cudagraph_outputs.clear();
+    cudagraph_shapes = std::move(shapes);
+    cudagraph_layout = layout_outputs(inputs);
+    std::vector<at::Tensor> out;
+    for (auto& member : run_members(inputs, cudagraph_layout, at::empty({cudagraph_layout.nbytes}, options))) {
+      out.insert(out.end(), member.begin(), member.end());
+    }
+    return out;
+  }
+
+  c10::cuda::CUDAGuard device_guard(device);
+  auto caller_stream = c10::cuda::getCurrentCUDAStream(device);
+  bool record = !cudagraph;
+  if (record) {
+    for (const auto& in : inputs) {
+      cudagraph_inputs.push_back(in.to(at::Device(at::kCUDA, device), /*non_blocking=*/true).contiguous().clone());
+    }
+    cudagraph_arena = at::empty({cudagraph_layout.nbytes}, options);
+  } else {
+    for (size_t i = 0; i < inputs.size(); i++) {
+      cudagraph_inputs[i].copy_(inputs[i], /*non_blocking=*/true);
+    }
+  }
+
+  // Graphs cannot be captured on the legacy default stream
+  auto graph_stream = c10::cuda::getStreamFromPool(false, device);
+  at::cuda::CUDAEvent ready;
+  ready.record(caller_stream);
+  ready.block(graph_stream);
+  {
+    c10::cuda::CUDAStreamGuard stream_guard(graph_stream);
+    if (record) {
+      cudagraph = std::make_unique<at::cuda::CUDAGraph>();
+      try {
+        cudagraph->capture_begin();
+        cudagraph_outputs = run_members(cudagraph_inputs, cudagraph_layout, cudagraph_arena);
+        cudagraph->capture_end();
+      } catch (const std::exception& e) {
+        try {
+          cudagraph->capture_end();
+        } catch (const std::exception&) {
+        }
+        cudaGetLastError();
+        cudagraph.reset();
+        cudagraph_inputs.clear();
+        cudagraph_outputs.clear();
+        cudagraph_failed = true;
+        LOG_WARNING(
+            "Unable to capture the engine ensemble " << to_str() << " in a CUDA graph, its members run directly: "
+                                                     << e.what());
+      }
+    }
+    if (cudagraph) {
+      cudagraph->replay();
+    }
+  }
+  at::cuda::CUDAEvent replayed;
+  replayed.record(graph_stream);
+  replayed.block(caller_stream);
+  if (!cudagraph) {
+    std::vector<at::Tensor> out;
+    for (auto& member : run_members(inputs, cudagraph_layout, at::empty({cudagraph_layout.nbytes}, options))) {
+      out.insert(out.end(), member.begin(), member.end());
+    }
+    return out;
+  }
+
+  // The next replay overwrites the outputs of the graph, the arena is copied out at once
+  auto arena = cudagraph_arena.clone();
+  std::vector<at::Tensor> out;
+  for (size_t k = 0; k < engines.size(); k++) {
+    auto views = arena_views(cudagraph_layout, k, arena);
+    for (size_t o = 0; o < views.size(); o++) {
+      out.push_back(views[o].defined() ? views[o] : cudagraph_outputs[k][o].clone());
+    }
+  }
+  return out;
+}
+
+std::vector<at::Tensor> EngineEnsemble::run(std::vector<at::Tensor> inputs) {
+  TORCHTRT_CHECK(
+      static_cast<int64_t>(inputs.size()) == num_inputs,
+      "Engine ensemble " << to_str() << " takes " << num_inputs << " inputs, got " << inputs.size());
+  auto device = static_cast<c10::DeviceIndex>(engines[0]->device_info.id);
+  c10::cuda::CUDAGuard device_guard(device);
+  // Moved once, instead of by every member
+  for (auto& in : inputs) {
+    if (!in.is_cuda()) {
+      in = in.to(at::Device(at::kCUDA, device), /*non_blocking=*/true);
+    }
+  }
+
+  bool capturable = use_cudagraph && !cudagraph_failed;
+  for (const auto& engine : engines) {
+    engine->ensure_engine_loaded();
+    // Data dependent outputs are allocated while the engine runs, which cannot be captured
+    capturable = capturable && !engine->has_data_dependent_outputs;
+  }
+  if (capturable) {
+    return run_cudagraph(inputs);
+  }
+
+  auto layout = layout_outputs(inputs);
+  auto arena = at::empty({layout.nbytes}, at::TensorOptions().device(at::kCUDA, device).dtype(at::kByte));
+  std::vector<at::Tensor> out;
+  for (auto& member : run_members(inputs, layout, arena)) {
+    out.insert(out.end(), member.begin(), member.end());
+  }
+  return out;
+}
+
+std::string EngineEnsemble::to_str() const {
+  std::ostringstream ss;
+  ss << "[";
+  for (size_t k = 0; k < engines.size(); k++) {
+    ss << (k ? ", " : "") << engines[k]->name;
+  }
+  ss << "]";
+  return ss.str();
+}
+
+std::vector<at::Tensor> execute_ensemble(std::vector<at::Tensor> inputs, c10::intrusive_ptr<EngineEnsemble> ensemble) {
+  return ensemble->run(std::move(inputs));
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ATen/Tensor.h"
+#include "ATen/cuda/CUDAGraph.h"
+#include "torch/custom_class.h"
+
+#include "core/runtime/TRTEngine.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Independent engines run on the same inputs by one call of tensorrt::execute_ensemble, e.g. the models of an
+// ensemble. The members run concurrently, each on a stream of its own (see enter_segment_stream), so the call takes
+// about as long as its slowest member. The inputs are moved to the device once for all members and the outputs of the
+// members are placed in one arena tensor. Returns the outputs of every member, member by member. Members whose outputs
+// cannot be placed ahead of their execution (data dependent shapes, non linear formats, replicas or a dynamic batcher)
+// allocate their own
+struct EngineEnsemble : torch::CustomClassHolder {
+  explicit EngineEnsemble(std::vector<c10::intrusive_ptr<TRTEngine>> engines);
+
+  std::vector<at::Tensor> run(std::vector<at::Tensor> inputs);
+  std::string to_str() const;
+
+  // Replay the fan out to the members and the join of their streams as one CUDA graph. Like with
+  // EngineSequence::use_cudagraph, the first execution with a set of input shapes runs the members directly and the
+  // next one captures them against static input buffers and a static output arena, which is copied out in one copy.
+  // Ensembles with members which cannot be captured keep running them directly. Executions with CUDA graphs are
+  // serialized
+  bool use_cudagraph = false;
+
+  std::vector<c10::intrusive_ptr<TRTEngine>> engines;
+  int64_t num_inputs = 0;
+
+ private:
+  // Where the outputs of the members are placed in the output arena for a set of inputs
+  struct OutputLayout {
+    struct Output {
+      int64_t offset = -1; // -1: allocated by the member
+      int64_t nbytes = 0;
+      std::vector<int64_t> shape;
+      at::ScalarType dtype = at::kFloat;
+    };
+    std::vector<std::vector<Output>> members;
+    int64_t nbytes = 0;
+  };
+  OutputLayout layout_outputs(const std::vector<at::Tensor>& inputs);
+  // Views of the arena for the outputs placed in it, undefined tensors for the others
+  std::vector<at::Tensor> arena_views(const OutputLayout& layout, size_t member, const at::Tensor& arena) const;
+  std::vector<std::vector<at::Tensor>> run_members(
+      const std::vector<at::Tensor>& inputs,
+      const OutputLayout& layout,
+      const at::Tensor& arena);
+  std::vector<at::Tensor> run_cudagraph(const std::vector<at::Tensor>& inputs);
+
+  std::mutex cudagraph_mu;
+  std::vector<std::vector<int64_t>> cudagraph_shapes; // Input shapes of the graph or of the warmup execution
+  std::atomic<bool> cudagraph_failed = {false};
+  std::unique_ptr<at::cuda::CUDAGraph> cudagraph;
+  std::vector<at::Tensor> cudagraph_inputs;
+  OutputLayout cudagraph_layout;
+  at::Tensor cudagraph_arena;
+  std::vector<std::vector<at::Tensor>> cudagraph_outputs;
+};
+
+std::vector<at::Tensor> execute_ensemble(std::vector<at::Tensor> inputs, c10::intrusive_ptr<EngineEnsemble> ensemble);
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,102 @@
+#include "core/runtime/EngineFile.h"
+
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string_view>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+bool is_engine_file_reference(std::string_view serialized_engine) {
+  return serialized_engine.compare(0, ENGINE_FILE_PREFIX.size(), ENGINE_FILE_PREFIX) == 0;
+}
+
+std::string engine_file_path(std::string_view reference) {
+  TORCHTRT_ASSERT(is_engine_file_reference(reference), "Serialized engine is not an engine file reference");
+  return std::string(reference.substr(ENGINE_FILE_PREFIX.size()));
+}
+
+std::string write_engine_file(const std::string& dir, const std::string& name, const void* data, size_t size) {
+  auto hash = std::hash<std::string_view>{}(std::string_view(static_cast<const char*>(data), size));
+  std::stringstream path;
+  path << dir;
+  if (!dir.empty() && dir.back() != '/') {
+    path << '/';
+  }
+  path << name << '_' << std::hex << std::setw(16) << std::setfill('0') << hash << ".engine";
+
+  std::ofstream out(path.str(), std::ios::binary | std::ios::trunc);
+  TORCHTRT_CHECK(out.is_open(), "Unable to open engine file " << path.str() << " for writing");
+  out.write(static_cast<const char*>(data), size);
+  out.close();
+  TORCHTRT_CHECK(!out.fail(), "Unable to write engine file " << path.str());
+
+  LOG_DEBUG("Wrote engine " << name << " (" << size << "B) to " << path.str());
+  return ENGINE_FILE_PREFIX + path.str();
+}
+
+#ifdef _WIN32
+MappedEngineFile::MappedEngineFile(const std::string& path) : path(path) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  TORCHTRT_CHECK(in.is_open(), "Unable to open engine file " << path);
+  nbytes = static_cast<size_t>(in.tellg());
+  buffer.resize(nbytes);
+  in.seekg(0);
+  in.read(buffer.data(), nbytes);
+  TORCHTRT_CHECK(!in.fail(), "Unable to read engine file " << path);
+}
+
+MappedEngineFile::~MappedEngineFile() = default;
+
+const void* MappedEngineFile::data() const {
+  return buffer.data();
+}
+#else
+MappedEngineFile::MappedEngineFile(const std::string& path) : path(path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  TORCHTRT_CHECK(fd >= 0, "Unable to open engine file " << path);
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    TORCHTRT_THROW_ERROR("Unable to stat engine file " << path);
+  }
+  nbytes = static_cast<size_t>(st.st_size);
+  TORCHTRT_CHECK(nbytes > 0, "Engine file " << path << " is empty");
+  mapping = mmap(nullptr, nbytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file
+  close(fd);
+  TORCHTRT_CHECK(mapping != MAP_FAILED, "Unable to map engine file " << path);
+  // TensorRT reads the engine front to back
+  madvise(mapping, nbytes, MADV_SEQUENTIAL);
+}
+
+MappedEngineFile::~MappedEngineFile() {
+  if (mapping && mapping != MAP_FAILED) {
+    munmap(mapping, nbytes);
+  }
+}
+
+const void* MappedEngineFile::data() const {
+  return mapping;
+}
+#endif
+
+size_t MappedEngineFile::size() const {
+  return nbytes;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Serialized engines can either be embedded in the module (base64 at ENGINE_IDX) or live in a side file, in which
+// case ENGINE_IDX holds a reference of the form "file://<path>". ':' is not part of the base64 alphabet so
+// references can never be confused with an embedded engine.
+const std::string ENGINE_FILE_PREFIX = "file://";
+
+bool is_engine_file_reference(std::string_view serialized_engine);
+std::string engine_file_path(std::string_view reference);
+
+// Writes the engine to <dir>/<name>_<content hash>.engine and returns the reference to store in the module. Engines
+// with the same contents map to the same file so saving a module repeatedly does not accumulate files
+std::string write_engine_file(const std::string& dir, const std::string& name, const void* data, size_t size);
+
+// Read only view of an engine file. The file is memory mapped so it can be handed to TensorRT without being read into
+// (and copied between) host buffers first, pages are only resident while the engine is being deserialized
+class MappedEngineFile {
+ public:
+  explicit MappedEngineFile(const std::string& path);
+  ~MappedEngineFile();
+  MappedEngineFile(const MappedEngineFile&) = delete;
+  MappedEngineFile& operator=(const MappedEngineFile&) = delete;
+
+  const void* data() const;
+  size_t size() const;
+
+ private:
+  std::string path;
+  size_t nbytes = 0;
+#ifdef _WIN32
+  // No mapping on Windows, the file is read into a host buffer
+  std::string buffer;
+#else
+  void* mapping = nullptr;
+#endif
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
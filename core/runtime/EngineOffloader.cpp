@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <chrono>
+
+#include "core/runtime/EngineOffloader.h"
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+EngineOffloader::~EngineOffloader() {
+  {
+    std::lock_guard<std::mutex> lock(mu);
+    stop = true;
+  }
+  cv.notify_all();
+  if (worker.joinable()) {
+    worker.join();
+  }
+}
+
+void EngineOffloader::register_engine(TRTEngine* engine) {
+  {
+    std::lock_guard<std::mutex> lock(mu);
+    engines.insert(engine);
+    if (!worker.joinable()) {
+      worker = std::thread([this]() { run(); });
+    }
+  }
+  cv.notify_all();
+}
+
+void EngineOffloader::unregister_engine(TRTEngine* engine) {
+  // Offloading happens with mu held, so an engine being offloaded is unregistered once it is done
+  std::lock_guard<std::mutex> lock(mu);
+  engines.erase(engine);
+}
+
+void EngineOffloader::notify() {
+  cv.notify_all();
+}
+
+int64_t EngineOffloader::offload_idle_engines() {
+  std::lock_guard<std::mutex> lock(mu);
+  int64_t offloaded = 0;
+  offload_idle_engines_locked(steady_now_ns(), offloaded);
+  return offloaded;
+}
+
+int64_t EngineOffloader::offload_idle_engines_locked(int64_t now_ns, int64_t& offloaded) {
+  int64_t next_ns = 0;
+  for (auto engine : engines) {
+    int64_t timeout_ns = engine->idle_offload_ms.load() * 1000000;
+    if (timeout_ns <= 0 || !engine->is_engine_loaded()) {
+      continue;
+    }
+    int64_t idle_at_ns = engine->last_execution_ns.load() + timeout_ns;
+    if (idle_at_ns <= now_ns) {
+      bool done = false;
+      try {
+        done = engine->offload();
+      } catch (const std::exception& e) {
+        LOG_WARNING("Unable to offload idle engine " << engine->name << ": " << e.what());
+      }
+      if (done) {
+        offloaded++;
+        continue;
+      }
+      idle_at_ns = now_ns + timeout_ns;
+    }
+    next_ns = next_ns == 0 ? idle_at_ns : std::min(next_ns, idle_at_ns);
+  }
+  num_offloads += offloaded;
+  return next_ns;
+}
+
+void EngineOffloader::run() {
+  std::unique_lock<std::mutex> lock(mu);
+  while (!stop) {
+    int64_t offloaded = 0;
+    int64_t next_ns = offload_idle_engines_locked(steady_now_ns(), offloaded);
+    if (offloaded > 0) {
+      LOG_DEBUG("Offloaded " << offloaded << " idle engines");
+    }
+    if (next_ns == 0) {
+      cv.wait(lock);
+    } else {
+      // Engines which executed in the meantime are idle later, they are looked at again when this expires
+      cv.wait_for(lock, std::chrono::nanoseconds(std::max<int64_t>(next_ns - steady_now_ns(), 0)));
+    }
+  }
+}
+
+int64_t EngineOffloader::get_num_engines() {
+  std::lock_guard<std::mutex> lock(mu);
+  return static_cast<int64_t>(engines.size());
+}
+
+int64_t EngineOffloader::get_num_offloads() {
+  return num_offloads;
+}
+
+EngineOffloader& get_engine_offloader() {
+  static EngineOffloader offloader;
+  return offloader;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+struct TRTEngine;
+
+// Process wide registry of the engines with an idle offload timeout (see TRTEngine::idle_offload_ms). A background
+// thread, started by the first registration, sleeps until the earliest time one of them has been idle for its timeout
+// and offloads it (see TRTEngine::offload), which releases its execution contexts and ICudaEngine and keeps the plan in
+// pinned host memory until the next execution deserializes it again. Engines which cannot be offloaded when their
+// timeout expires (e.g. an execution is in flight) are retried once the timeout has expired again
+class EngineOffloader {
+ public:
+  ~EngineOffloader();
+
+  void register_engine(TRTEngine* engine);
+  // The engine is no longer touched by the offloader once this returns
+  void unregister_engine(TRTEngine* engine);
+  // Wakes the thread up after the timeout of a registered engine changed
+  void notify();
+  // Offloads the registered engines which have been idle for their timeout. Returns the number of engines offloaded
+  int64_t offload_idle_engines();
+  int64_t get_num_engines();
+  // Number of engines offloaded by the offloader since the process started
+  int64_t get_num_offloads();
+
+ private:
+  void run();
+  // Expects mu to be held, returns the time in ns the next engine may become idle, 0 if none can
+  int64_t offload_idle_engines_locked(int64_t now_ns, int64_t& offloaded);
+
+  std::mutex mu;
+  std::condition_variable cv;
+  std::unordered_set<TRTEngine*> engines;
+  std::thread worker;
+  bool stop = false;
+  std::atomic<int64_t> num_offloads = {0};
+};
+
+EngineOffloader& get_engine_offloader();
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
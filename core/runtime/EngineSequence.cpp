@@ -0,0 +1,201 @@
+#include <sstream>
+#include <utility>
+
+#include "cuda_runtime.h"
+
+#include "ATen/cuda/CUDAEvent.h"
+#include "c10/cuda/CUDAGuard.h"
+#include "c10/cuda/CUDAStream.h"
+
+#include "core/runtime/EngineSequence.h"
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+EngineSequence::EngineSequence(
+    int64_t num_inputs,
+    std::vector<c10::intrusive_ptr<TRTEngine>> engines,
+    std::vector<std::vector<int64_t>> engine_inputs,
+    std::vector<int64_t> outputs)
+    : engines(std::move(engines)),
+      engine_inputs(std::move(engine_inputs)),
+      outputs(std::move(outputs)),
+      num_inputs(num_inputs) {
+  TORCHTRT_CHECK(num_inputs >= 0, "An engine sequence cannot have " << num_inputs << " inputs");
+  TORCHTRT_CHECK(
+      this->engines.size() == this->engine_inputs.size(),
+      "An engine sequence of " << this->engines.size() << " engines needs as many input lists, got "
+                               << this->engine_inputs.size());
+
+  // Engine k is the last user of the values in released_after[k], outputs of the sequence are never released
+  int64_t num_values = num_inputs;
+  std::vector<int64_t> last_use;
+  for (size_t k = 0; k < this->engines.size(); k++) {
+    auto& engine = this->engines[k];
+    TORCHTRT_CHECK(engine, "Engine " << k << " of the engine sequence is None");
+    TORCHTRT_CHECK(
+        this->engine_inputs[k].size() == engine->in_binding_names.size(),
+        "Engine " << engine->name << " takes " << engine->in_binding_names.size() << " inputs but is wired to "
+                  << this->engine_inputs[k].size() << " values of the engine sequence");
+    last_use.resize(num_values, -1);
+    for (auto v : this->engine_inputs[k]) {
+      TORCHTRT_CHECK(
+          v >= 0 && v < num_values,
+          "Input " << v << " of engine " << engine->name << " is not produced before it in the engine sequence");
+      last_use[v] = k;
+    }
+    num_values += engine->num_outputs();
+  }
+  last_use.resize(num_values, -1);
+  for (auto v : this->outputs) {
+    TORCHTRT_CHECK(v >= 0 && v < num_values, "Output " << v << " is not a value of the engine sequence");
+    last_use[v] = -1;
+  }
+  released_after.resize(this->engines.size());
+  for (int64_t v = 0; v < num_values; v++) {
+    if (last_use[v] >= 0) {
+      released_after[last_use[v]].push_back(v);
+    }
+  }
+}
+
+std::vector<at::Tensor> EngineSequence::run_engines(std::vector<at::Tensor> values) {
+  for (size_t k = 0; k < engines.size(); k++) {
+    std::vector<at::Tensor> engine_in;
+    engine_in.reserve(engine_inputs[k].size());
+    for (auto v : engine_inputs[k]) {
+      engine_in.push_back(values[v]);
+    }
+    // Intermediate values are dropped as soon as their last consumer ran, so their memory can be reused by the next
+    // engines of the sequence
+    for (auto v : released_after[k]) {
+      values[v] = at::Tensor();
+    }
+    auto engine_out = execute_engine(std::move(engine_in), engines[k]);
+    values.insert(values.end(), engine_out.begin(), engine_out.end());
+  }
+
+  std::vector<at::Tensor> out;
+  out.reserve(outputs.size());
+  for (auto v : outputs) {
+    out.push_back(values[v]);
+  }
+  return out;
+}
+
+std::vector<at::Tensor> EngineSequence::run_cudagraph(const std::vector<at::Tensor>& inputs) {
+  std::vector<std::vector<int64_t>> shapes;
+  for (const auto& in : inputs) {
+    shapes.push_back(in.sizes().vec());
+  }
+
+  std::lock_guard<std::mutex> lock(cudagraph_mu);
+  if (shapes != cudagraph_shapes) {
+    // First execution with these shapes, which initializes the engines (contexts, lazy kernel loading, allocator
+    // growth) before they are captured
+    cudagraph.reset();
+    cudagraph_inputs.clear();
+    cudagraph_outputs.clear();
+    cudagraph_shapes = std::move(shapes);
+    return run_engines(inputs);
+  }
+
+  auto device = static_cast<c10::DeviceIndex>(engines[0]->device_info.id);
+  c10::cuda::CUDAGuard device_guard(device);
+  auto caller_stream = c10::cuda::getCurrentCUDAStream(device);
+  bool record = !cudagraph;
+  if (record) {
+    for (const auto& in : inputs) {
+      cudagraph_inputs.push_back(in.to(at::Device(at::kCUDA, device), /*non_blocking=*/true).contiguous().clone());
+    }
+  } else {
+    for (size_t i = 0; i < inputs.size(); i++) {
+      cudagraph_inputs[i].copy_(inputs[i], /*non_blocking=*/true);
+    }
+  }
+
+  // Graphs cannot be captured on the legacy default stream
+  auto graph_stream = c10::cuda::getStreamFromPool(false, device);
+  at::cuda::CUDAEvent ready;
+  ready.record(caller_stream);
+  ready.block(graph_stream);
+  {
+    c10::cuda::CUDAStreamGuard stream_guard(graph_stream);
+    if (record) {
+      cudagraph = std::make_unique<at::cuda::CUDAGraph>();
+      try {
+        cudagraph->capture_begin();
+        cudagraph_outputs = run_engines(cudagraph_inputs);
+        cudagraph->capture_end();
+      } catch (const std::exception& e) {
+        try {
+          cudagraph->capture_end();
+        } catch (const std::exception&) {
+        }
+        cudaGetLastError();
+        cudagraph.reset();
+        cudagraph_inputs.clear();
+        cudagraph_outputs.clear();
+        cudagraph_failed = true;
+        LOG_WARNING(
+            "Unable to capture the engine sequence " << to_str() << " in a CUDA graph, its engines run directly: "
+                                                     << e.what());
+      }
+    }
+    if (cudagraph) {
+      cudagraph->replay();
+    }
+  }
+  at::cuda::CUDAEvent replayed;
+  replayed.record(graph_stream);
+  replayed.block(caller_stream);
+  if (!cudagraph) {
+    return run_engines(inputs);
+  }
+
+  // The next replay overwrites the outputs of the graph
+  std::vector<at::Tensor> out;
+  out.reserve(cudagraph_outputs.size());
+  for (const auto& o : cudagraph_outputs) {
+    out.push_back(o.clone());
+  }
+  return out;
+}
+
+std::vector<at::Tensor> EngineSequence::run(std::vector<at::Tensor> inputs) {
+  TORCHTRT_CHECK(
+      static_cast<int64_t>(inputs.size()) == num_inputs,
+      "Engine sequence " << to_str() << " takes " << num_inputs << " inputs, got " << inputs.size());
+  if (!use_cudagraph || cudagraph_failed || engines.empty()) {
+    return run_engines(std::move(inputs));
+  }
+  for (const auto& engine : engines) {
+    // Data dependent outputs are allocated while the engine runs and an engine switching devices cannot be captured
+    // with the others
+    if (engine->has_data_dependent_outputs || engine->device_info.id != engines[0]->device_info.id) {
+      return run_engines(std::move(inputs));
+    }
+  }
+  return run_cudagraph(inputs);
+}
+
+std::string EngineSequence::to_str() const {
+  std::ostringstream ss;
+  ss << "[";
+  for (size_t k = 0; k < engines.size(); k++) {
+    ss << (k ? ", " : "") << engines[k]->name;
+  }
+  ss << "]";
+  return ss.str();
+}
+
+std::vector<at::Tensor> execute_engines(std::vector<at::Tensor> inputs, c10::intrusive_ptr<EngineSequence> sequence) {
+  return sequence->run(std::move(inputs));
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
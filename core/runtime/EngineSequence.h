@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ATen/Tensor.h"
+#include "ATen/cuda/CUDAGraph.h"
+#include "torch/custom_class.h"
+
+#include "core/runtime/TRTEngine.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Engines executed back to back by one call of tensorrt::execute_engines, so graphs made of many small engines pay
+// the interpreter, dispatcher and Python overhead once instead of once per engine. Values are numbered in order: the
+// num_inputs inputs of the sequence, then the outputs of each engine. engine_inputs[k] are the values engine k is
+// executed on, which must be produced before it, and outputs the values returned
+struct EngineSequence : torch::CustomClassHolder {
+  EngineSequence(
+      int64_t num_inputs,
+      std::vector<c10::intrusive_ptr<TRTEngine>> engines,
+      std::vector<std::vector<int64_t>> engine_inputs,
+      std::vector<int64_t> outputs);
+
+  std::vector<at::Tensor> run(std::vector<at::Tensor> inputs);
+  std::string to_str() const;
+
+  // Replay the sequence as one CUDA graph. The first execution with a set of input shapes runs the engines directly
+  // and the next one captures them against static input buffers, the outputs returned are copies of the outputs of
+  // the graph. Sequences of engines which cannot be captured, e.g. with data dependent outputs, keep running the
+  // engines directly. Executions of a sequence with CUDA graphs are serialized
+  bool use_cudagraph = false;
+
+  std::vector<c10::intrusive_ptr<TRTEngine>> engines;
+  std::vector<std::vector<int64_t>> engine_inputs;
+  std::vector<int64_t> outputs;
+  int64_t num_inputs;
+
+ private:
+  std::vector<at::Tensor> run_engines(std::vector<at::Tensor> values);
+  std::vector<at::Tensor> run_cudagraph(const std::vector<at::Tensor>& inputs);
+
+  // Values whose last use is by engine k (and which are not outputs), released once it ran
+  std::vector<std::vector<int64_t>> released_after;
+
+  std::mutex cudagraph_mu;
+  std::vector<std::vector<int64_t>> cudagraph_shapes; // Input shapes of the graph or of the warmup execution
+  std::atomic<bool> cudagraph_failed = {false};
+  std::unique_ptr<at::cuda::CUDAGraph> cudagraph;
+  std::vector<at::Tensor> cudagraph_inputs;
+  std::vector<at::Tensor> cudagraph_outputs;
+};
+
+std::vector<at::Tensor> execute_engines(std::vector<at::Tensor> inputs, c10::intrusive_ptr<EngineSequence> sequence);
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <utility>
+
+#include "core/runtime/EngineVariants.h"
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+namespace {
+// Weight of a call in the smoothed latency, and calls the latency level is held for after it changed so the smoothed
+// latency reflects the variants it lets calls run on
+constexpr double kLatencySmoothing = 1.0 / 16;
+constexpr int64_t kLatencyLevelCalls = 32;
+} // namespace
+
+EngineVariants::EngineVariants(std::vector<c10::intrusive_ptr<TRTEngine>> engines) : engines(std::move(engines)) {
+  TORCHTRT_CHECK(!this->engines.empty(), "Engine variants need at least one engine");
+  for (size_t v = 0; v < this->engines.size(); v++) {
+    auto& engine = this->engines[v];
+    TORCHTRT_CHECK(engine, "Variant " << v << " of the engine variants is None");
+    TORCHTRT_CHECK(
+        engine->in_binding_names == this->engines[0]->in_binding_names &&
+            engine->returned_output_names() == this->engines[0]->returned_output_names(),
+        "Engine " << engine->name << " does not have the same bindings as engine " << this->engines[0]->name
+                  << ", variants must be built from the same segment");
+    accuracy_costs.push_back(static_cast<double>(v));
+  }
+  routed.assign(this->engines.size(), 0);
+}
+
+int64_t EngineVariants::select(const std::vector<at::Tensor>& inputs) {
+  std::lock_guard<std::mutex> lock(mu);
+  TORCHTRT_CHECK(
+      accuracy_costs.size() == engines.size(),
+      "Engine variants " << to_str() << " have " << engines.size() << " variants but " << accuracy_costs.size()
+                         << " accuracy costs");
+  size_t wanted = std::min(latency_level, engines.size() - 1);
+  while (max_in_flight > 0 && wanted + 1 < engines.size() &&
+         engines[wanted]->in_flight_executions.load(std::memory_order_relaxed) >= max_in_flight) {
+    wanted++;
+  }
+  // Calls only move as far as the accuracy budget and the admission hook let them
+  auto weight = 1.0 / std::max<int64_t>(1, accuracy_window);
+  size_t selected = 0;
+  while (selected < wanted) {
+    auto next = selected + 1;
+    auto spent = accuracy_spent + (accuracy_costs[next] - accuracy_spent) * weight;
+    if ((accuracy_budget >= 0 && spent > accuracy_budget) || (admit && !admit(next, inputs))) {
+      break;
+    }
+    selected = next;
+  }
+  return static_cast<int64_t>(selected);
+}
+
+void EngineVariants::record(size_t variant, int64_t ns) {
+  std::lock_guard<std::mutex> lock(mu);
+  routed[variant]++;
+  accuracy_spent += (accuracy_costs[variant] - accuracy_spent) / std::max<int64_t>(1, accuracy_window);
+  if (latency_target_us <= 0) {
+    latency_level = 0;
+    return;
+  }
+  latency_us += (ns / 1e3 - latency_us) * kLatencySmoothing;
+  if (++calls_at_level < kLatencyLevelCalls) {
+    return;
+  }
+  if (latency_us > latency_target_us && latency_level + 1 < engines.size()) {
+    latency_level++;
+    calls_at_level = 0;
+  } else if (latency_us < latency_target_us / 2.0 && latency_level > 0) {
+    latency_level--;
+    calls_at_level = 0;
+  }
+}
+
+std::vector<at::Tensor> EngineVariants::run(std::vector<at::Tensor> inputs) {
+  auto variant = select(inputs);
+  return run_variant(variant, std::move(inputs));
+}
+
+std::vector<at::Tensor> EngineVariants::run_variant(int64_t variant, std::vector<at::Tensor> inputs) {
+  TORCHTRT_CHECK(
+      variant >= 0 && variant < static_cast<int64_t>(engines.size()),
+      "Engine variants " << to_str() << " have no variant " << variant);
+  auto start = std::chrono::steady_clock::now();
+  auto outputs = execute_engine(std::move(inputs), engines[variant]);
+  record(static_cast<size_t>(variant), elapsed_ns(start));
+  return outputs;
+}
+
+std::vector<int64_t> EngineVariants::get_routed_counts() {
+  std::lock_guard<std::mutex> lock(mu);
+  return routed;
+}
+
+double EngineVariants::get_accuracy_spent() {
+  std::lock_guard<std::mutex> lock(mu);
+  return accuracy_spent;
+}
+
+void EngineVariants::reset_stats() {
+  std::lock_guard<std::mutex> lock(mu);
+  routed.assign(engines.size(), 0);
+  accuracy_spent = 0;
+  latency_us = 0;
+  latency_level = 0;
+  calls_at_level = 0;
+}
+
+std::string EngineVariants::to_str() const {
+  std::ostringstream ss;
+  ss << "[";
+  for (size_t v = 0; v < engines.size(); v++) {
+    ss << (v ? ", " : "") << engines[v]->name;
+  }
+  ss << "]";
+  return ss.str();
+}
+
+std::vector<at::Tensor> execute_engine_variants(
+    std::vector<at::Tensor> inputs,
+    c10::intrusive_ptr<EngineVariants> variants) {
+  return variants->run(std::move(inputs));
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
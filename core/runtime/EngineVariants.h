@@ -0,0 +1,72 @@
+#pragma once
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ATen/Tensor.h"
+#include "torch/custom_class.h"
+
+#include "core/runtime/TRTEngine.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Precision variants of one TensorRT segment (e.g. its FP16 and INT8 builds), run by tensorrt::execute_engine_variants.
+// The variants take the same inputs and return the same outputs, ordered from the most to the least precise. Calls go
+// to the first variant and move to the faster ones while it is loaded, so traffic peaks are served at a lower precision
+// instead of queueing behind the precise variant:
+//  - max_in_flight: the executions in flight on a variant (including callers waiting in its dynamic batcher) at
+//    which calls move on to the next variant
+//  - latency_target_us: the smoothed host time of the calls (including waiting for an execution slot or the dynamic
+//    batcher) above which the calls move to the next variant. They move back once it falls below half the target
+// Both are disabled at 0. The accuracy budget bounds how much of the traffic is served by the less precise variants:
+// calls only move to a variant while the average accuracy cost of the recent calls (the last accuracy_window calls,
+// exponentially weighted) stays within accuracy_budget. A negative budget is unlimited
+struct EngineVariants : torch::CustomClassHolder {
+  explicit EngineVariants(std::vector<c10::intrusive_ptr<TRTEngine>> engines);
+
+  std::vector<at::Tensor> run(std::vector<at::Tensor> inputs);
+  // Variant the next call with the inputs runs on
+  int64_t select(const std::vector<at::Tensor>& inputs);
+  // Runs the call on the given variant, accounting it like a routed call (for routing decided by the caller)
+  std::vector<at::Tensor> run_variant(int64_t variant, std::vector<at::Tensor> inputs);
+  std::string to_str() const;
+
+  // Calls run by each variant
+  std::vector<int64_t> get_routed_counts();
+  // Average accuracy cost of the recent calls
+  double get_accuracy_spent();
+  void reset_stats();
+
+  std::vector<c10::intrusive_ptr<TRTEngine>> engines;
+  int64_t max_in_flight = 0;
+  int64_t latency_target_us = 0;
+  // Cost of serving a call from each variant, by default its index
+  std::vector<double> accuracy_costs;
+  double accuracy_budget = -1;
+  int64_t accuracy_window = 1000;
+  // Whether the variant may run the call, e.g. rejecting inputs outside of the range an INT8 variant was calibrated
+  // for. Called while routing with the lock of the variants held, it must not run them. Not serialized
+  std::function<bool(int64_t variant, const std::vector<at::Tensor>& inputs)> admit;
+
+ private:
+  void record(size_t variant, int64_t ns);
+
+  std::mutex mu;
+  std::vector<int64_t> routed;
+  double accuracy_spent = 0;
+  double latency_us = 0;
+  // First variant the latency target lets calls run on, and the calls since it last changed
+  size_t latency_level = 0;
+  int64_t calls_at_level = 0;
+};
+
+std::vector<at::Tensor> execute_engine_variants(
+    std::vector<at::Tensor> inputs,
+    c10::intrusive_ptr<EngineVariants> variants);
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,90 @@
+#include <map>
+#include <memory>
+
+#include "cuda_runtime.h"
+
+#include "core/runtime/EnqueueAdmission.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+EnqueueAdmission::Ticket::~Ticket() {
+  if (admission) {
+    admission->release(nullptr);
+  }
+}
+
+void EnqueueAdmission::Ticket::complete(const c10::cuda::CUDAStream& stream) {
+  admission->release(&stream);
+  admission = nullptr;
+}
+
+void EnqueueAdmission::retire_completed() {
+  while (!running.empty() && running.front().query()) {
+    free_events.push_back(std::move(running.front()));
+    running.pop_front();
+  }
+}
+
+EnqueueAdmission::Ticket EnqueueAdmission::acquire(int64_t max_in_flight) {
+  std::unique_lock<std::mutex> lock(mu);
+  while (true) {
+    retire_completed();
+    if (enqueuing + static_cast<int64_t>(running.size()) < max_in_flight) {
+      enqueuing++;
+      return Ticket(this);
+    }
+    if (running.empty()) {
+      // Every admitted execution is still being enqueued
+      cv.wait(lock);
+      continue;
+    }
+    // Events are only ever recycled, never destroyed, so the oldest one can be waited on without holding the lock. If
+    // it is recorded again in the meantime this just waits for newer work
+    cudaEvent_t oldest = running.front().event();
+    lock.unlock();
+    cudaEventSynchronize(oldest);
+    lock.lock();
+  }
+}
+
+void EnqueueAdmission::release(const c10::cuda::CUDAStream* stream) {
+  {
+    std::lock_guard<std::mutex> lock(mu);
+    enqueuing--;
+    if (stream) {
+      at::cuda::CUDAEvent event;
+      if (!free_events.empty()) {
+        event = std::move(free_events.back());
+        free_events.pop_back();
+      }
+      event.record(*stream);
+      running.push_back(std::move(event));
+    }
+  }
+  cv.notify_all();
+}
+
+int64_t EnqueueAdmission::in_flight() {
+  std::lock_guard<std::mutex> lock(mu);
+  retire_completed();
+  return enqueuing + static_cast<int64_t>(running.size());
+}
+
+EnqueueAdmission& get_background_admission(int64_t device_id) {
+  static std::mutex registry_mu;
+  static std::map<int64_t, std::unique_ptr<EnqueueAdmission>> registry;
+
+  std::lock_guard<std::mutex> lock(registry_mu);
+  auto& admission = registry[device_id];
+  if (!admission) {
+    admission = std::make_unique<EnqueueAdmission>();
+  }
+  return *admission;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,58 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "ATen/cuda/CUDAEvent.h"
+#include "c10/cuda/CUDAStream.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Bounds how many executions admitted through it can be queued or running on a device at once. An execution counts
+// as in flight from the moment it is admitted until the GPU reaches the end of its work, so callers are held back on
+// the host instead of queueing unbounded work ahead of other engines sharing the GPU
+class EnqueueAdmission {
+ public:
+  // Ends the admission of an execution on destruction if it was not completed, e.g. because enqueueing failed
+  class Ticket {
+   public:
+    explicit Ticket(EnqueueAdmission* admission) : admission(admission) {}
+    Ticket(Ticket&& other) noexcept : admission(other.admission) {
+      other.admission = nullptr;
+    }
+    Ticket(const Ticket&) = delete;
+    Ticket& operator=(const Ticket&) = delete;
+    ~Ticket();
+    // The execution stays in flight until stream reaches the work enqueued so far
+    void complete(const c10::cuda::CUDAStream& stream);
+
+   private:
+    EnqueueAdmission* admission;
+  };
+
+  // Waits until fewer than max_in_flight admitted executions are in flight
+  Ticket acquire(int64_t max_in_flight);
+  // Admitted executions which are still queued or running
+  int64_t in_flight();
+
+ private:
+  void release(const c10::cuda::CUDAStream* stream);
+  // Expects mu to be held
+  void retire_completed();
+
+  int64_t enqueuing = 0; // Admitted, work not enqueued yet
+  std::deque<at::cuda::CUDAEvent> running; // Oldest first
+  std::vector<at::cuda::CUDAEvent> free_events;
+  std::mutex mu;
+  std::condition_variable cv;
+};
+
+// Process wide admission control for the executions of background engines on a device
+EnqueueAdmission& get_background_admission(int64_t device_id);
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
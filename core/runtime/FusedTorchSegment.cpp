@@ -0,0 +1,110 @@
+#include <sstream>
+#include <utility>
+
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/csrc/jit/passes/shape_analysis.h"
+
+#include "core/runtime/FusedTorchSegment.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+FusedTorchSegment::FusedTorchSegment(std::string name, std::shared_ptr<torch::jit::Graph> graph)
+    : name(std::move(name)), graph(std::move(graph)) {
+  setup_kernel_inputs();
+}
+
+FusedTorchSegment::FusedTorchSegment(std::vector<std::string> serialized_info) {
+  TORCHTRT_CHECK(serialized_info.size() == 2, "Program to be deserialized has a malformed fused Torch segment");
+  name = serialized_info[0];
+  graph = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(serialized_info[1], graph.get());
+  setup_kernel_inputs();
+}
+
+void FusedTorchSegment::setup_kernel_inputs() {
+  for (auto in : graph->inputs()) {
+    auto type = in->type()->cast<c10::TensorType>();
+    TORCHTRT_CHECK(
+        type && type->isComplete() && type->device(),
+        "Inputs of fused Torch segment " << name << " must be tensors of known shape, type and device, found "
+                                         << *in->type());
+    kernel_inputs.push_back({*type->sizes().concrete_sizes(), *type->scalarType(), *type->device()});
+  }
+}
+
+void FusedTorchSegment::compile() {
+  std::call_once(compiled, [this]() {
+    // The executor runs any shape, so it does not keep the shapes the kernel is specialized for
+    auto fallback_g = graph->copy();
+    torch::jit::EraseShapeInformation(fallback_g);
+    fallback = std::make_unique<torch::jit::GraphExecutor>(fallback_g, name);
+    try {
+      kernel = std::make_unique<torch::jit::tensorexpr::TensorExprKernel>(graph->copy());
+      LOG_DEBUG("Compiled fused Torch segment " << name << " into an NNC kernel");
+    } catch (const std::exception& e) {
+      LOG_WARNING(
+          "Unable to compile fused Torch segment " << name << " with NNC, it runs in the TorchScript interpreter: "
+                                                   << e.what());
+    }
+  });
+}
+
+bool FusedTorchSegment::matches_kernel(const std::vector<at::Tensor>& inputs) const {
+  for (size_t i = 0; i < inputs.size(); i++) {
+    auto& t = inputs[i];
+    auto& spec = kernel_inputs[i];
+    if (!t.defined() || t.scalar_type() != spec.dtype || t.device() != spec.device || t.sizes() != spec.sizes ||
+        !t.is_contiguous()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<at::Tensor> FusedTorchSegment::run(std::vector<at::Tensor> inputs) {
+  TORCHTRT_CHECK(
+      inputs.size() == kernel_inputs.size(),
+      "Fused Torch segment " << name << " expects " << kernel_inputs.size() << " inputs, got " << inputs.size());
+  compile();
+
+  bool use_kernel = kernel && matches_kernel(inputs);
+  torch::jit::Stack stack(std::make_move_iterator(inputs.begin()), std::make_move_iterator(inputs.end()));
+  if (use_kernel) {
+    kernel->run(stack);
+  } else {
+    fallback->run(stack);
+  }
+
+  std::vector<at::Tensor> outputs;
+  outputs.reserve(stack.size());
+  for (auto& out : stack) {
+    outputs.push_back(out.toTensor());
+  }
+  return outputs;
+}
+
+std::vector<std::string> FusedTorchSegment::serialize() const {
+  return {name, graph->toString(false)};
+}
+
+std::string FusedTorchSegment::to_str() const {
+  std::ostringstream ss;
+  ss << "Fused Torch segment {" << std::endl;
+  ss << "  Name: " << name << std::endl;
+  ss << "  Graph: " << *graph;
+  ss << "}" << std::endl;
+  return ss.str();
+}
+
+std::vector<at::Tensor> execute_fused_torch_segment(
+    std::vector<at::Tensor> inputs,
+    c10::intrusive_ptr<FusedTorchSegment> segment) {
+  return segment->run(std::move(inputs));
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,56 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ATen/Tensor.h"
+#include "torch/csrc/jit/ir/ir.h"
+#include "torch/csrc/jit/runtime/graph_executor.h"
+#include "torch/csrc/jit/tensorexpr/kernel.h"
+#include "torch/custom_class.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// A Torch segment of a hybrid graph compiled into a single NNC (TensorExpr) kernel instead of running op by op through
+// the TorchScript interpreter. The inputs of the graph are typed with the shapes, types and device the kernel is
+// specialized for, inputs which do not match them (or segments NNC fails to compile) run the graph through a
+// TorchScript executor instead. The kernel is compiled on first use
+struct FusedTorchSegment : torch::CustomClassHolder {
+  FusedTorchSegment(std::string name, std::shared_ptr<torch::jit::Graph> graph);
+  // {name, graph IR}, the format of serialize
+  FusedTorchSegment(std::vector<std::string> serialized_info);
+
+  std::vector<at::Tensor> run(std::vector<at::Tensor> inputs);
+  std::vector<std::string> serialize() const;
+  std::string to_str() const;
+
+  std::string name;
+  std::shared_ptr<torch::jit::Graph> graph;
+
+ private:
+  void setup_kernel_inputs();
+  void compile();
+  bool matches_kernel(const std::vector<at::Tensor>& inputs) const;
+
+  struct KernelInput {
+    std::vector<int64_t> sizes;
+    at::ScalarType dtype;
+    at::Device device;
+  };
+  std::vector<KernelInput> kernel_inputs;
+  std::once_flag compiled;
+  // nullptr if NNC could not compile the segment
+  std::unique_ptr<torch::jit::tensorexpr::TensorExprKernel> kernel;
+  std::unique_ptr<torch::jit::GraphExecutor> fallback;
+};
+
+std::vector<at::Tensor> execute_fused_torch_segment(
+    std::vector<at::Tensor> inputs,
+    c10::intrusive_ptr<FusedTorchSegment> segment);
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
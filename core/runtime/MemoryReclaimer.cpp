@@ -0,0 +1,140 @@
+#include <string>
+#include <vector>
+
+#include "c10/cuda/CUDACachingAllocator.h"
+#include "c10/cuda/CUDAGuard.h"
+#include "c10/util/Exception.h"
+
+#include "core/runtime/MemoryReclaimer.h"
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+namespace {
+
+// Set while the thread reclaims memory, allocations failing on the way (e.g. recreating execution contexts for a
+// smaller weight streaming budget) must not reclaim again
+thread_local bool reclaiming = false;
+
+const char* stage_name(ReclaimStage stage) {
+  switch (stage) {
+    case RECLAIM_CUDAGRAPHS:
+      return "CUDA graphs";
+    case RECLAIM_BUFFERS:
+      return "CUDA graphs and buffers";
+    default:
+      return "CUDA graphs, buffers and weight streaming budgets";
+  }
+}
+
+bool is_out_of_memory(const c10::Error& e) {
+  if (dynamic_cast<const c10::OutOfMemoryError*>(&e) != nullptr) {
+    return true;
+  }
+  // CUDA errors (e.g. of cudaGraphInstantiate) are only reported through their message
+  return std::string(e.what_without_backtrace()).find("out of memory") != std::string::npos;
+}
+
+} // namespace
+
+void MemoryReclaimer::register_engine(TRTEngine* engine) {
+  std::call_once(observer_attached, []() {
+    // Called once the allocator has failed to allocate, after releasing the blocks it had cached. The allocation still
+    // fails but retrying it, or the next allocation, can use the memory the engines held, which stays cached by the
+    // allocator for it
+    c10::cuda::CUDACachingAllocator::attachOutOfMemoryObserver(
+        [](int64_t device, size_t allocated, size_t device_total, size_t device_free) {
+          if (RECLAIM_MEMORY_ON_OOM) {
+            LOG_DEBUG(
+                "PyTorch ran out of memory on device " << device << " allocating " << allocated << "B ("
+                                                       << device_free << "B of " << device_total << "B free)");
+            get_memory_reclaimer().reclaim(device, RECLAIM_BUFFERS, nullptr, /*empty_cache=*/false);
+          }
+        });
+  });
+  std::lock_guard<std::mutex> lock(mu);
+  engines.insert(engine);
+}
+
+void MemoryReclaimer::unregister_engine(TRTEngine* engine) {
+  std::lock_guard<std::mutex> lock(mu);
+  engines.erase(engine);
+}
+
+int64_t MemoryReclaimer::reclaim(
+    int64_t device_id,
+    ReclaimStage stage,
+    TRTExecutionSlot* requester,
+    bool empty_cache) {
+  if (reclaiming) {
+    return 0;
+  }
+  reclaiming = true;
+  int64_t released = 0;
+  try {
+    c10::cuda::CUDAGuard device_guard(static_cast<c10::DeviceIndex>(device_id));
+    {
+      std::lock_guard<std::mutex> lock(mu);
+      for (auto engine : engines) {
+        if (engine->device_info.id == device_id) {
+          released += engine->reclaim_device_memory(stage, requester);
+        }
+      }
+    }
+    if (empty_cache) {
+      c10::cuda::CUDACachingAllocator::emptyCache();
+    }
+  } catch (const std::exception& e) {
+    LOG_WARNING("Unable to reclaim the device memory held by the runtime on device " << device_id << ": " << e.what());
+  }
+  reclaiming = false;
+
+  num_reclaims++;
+  reclaimed_bytes += released;
+  LOG_DEBUG("Reclaimed " << released << "B of " << stage_name(stage) << " held by engines on device " << device_id);
+  return released;
+}
+
+int64_t MemoryReclaimer::get_num_reclaims() {
+  return num_reclaims;
+}
+
+int64_t MemoryReclaimer::get_reclaimed_bytes() {
+  return reclaimed_bytes;
+}
+
+MemoryReclaimer& get_memory_reclaimer() {
+  static MemoryReclaimer reclaimer;
+  return reclaimer;
+}
+
+bool retry_reclaiming_memory(int64_t device_id, const std::function<bool()>& attempt, TRTExecutionSlot* requester) {
+  int stage = RECLAIM_CUDAGRAPHS;
+  while (true) {
+    bool last = !RECLAIM_MEMORY_ON_OOM || stage > RECLAIM_WEIGHT_STREAMING;
+    try {
+      if (attempt()) {
+        return true;
+      }
+      if (last) {
+        return false;
+      }
+    } catch (const c10::Error& e) {
+      if (last || !is_out_of_memory(e)) {
+        throw;
+      }
+    }
+    auto reclaim_stage = static_cast<ReclaimStage>(stage);
+    auto released = get_memory_reclaimer().reclaim(device_id, reclaim_stage, requester);
+    LOG_WARNING(
+        "Out of memory on device " << device_id << ", retrying after releasing " << released << "B of "
+                                   << stage_name(reclaim_stage) << " held by the runtime");
+    stage++;
+  }
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+struct TRTEngine;
+struct TRTExecutionSlot;
+
+// Device memory the runtime holds without needing it for the execution at hand, in the order it is reclaimed. Each
+// stage also reclaims what the previous stages do
+typedef enum {
+  RECLAIM_CUDAGRAPHS = 0, // Captured CUDA graphs and their persistent buffers
+  RECLAIM_BUFFERS, // Pre-allocated outputs, output arenas, data dependent output buffers and the execution contexts of
+                   // optimization profiles which are not active
+  RECLAIM_WEIGHT_STREAMING, // Halves the weight streaming budget of engines with no execution in flight
+} ReclaimStage;
+
+// Process wide registry of the loaded engines which reclaims the memory they hold when the runtime runs out of device
+// memory (see retry_reclaiming_memory) and, through the out of memory observer of PyTorch's caching allocator, when
+// any other allocation of the process does. Reclamation never waits: engines whose slot pool is being changed and
+// slots which are checked out are skipped, except for the slot of the execution which ran out of memory, whose CUDA
+// graphs other than the one it is using are evicted
+class MemoryReclaimer {
+ public:
+  void register_engine(TRTEngine* engine);
+  // The engine is no longer touched by the reclaimer once this returns
+  void unregister_engine(TRTEngine* engine);
+  // Reclaims the memory held by the engines on device_id up to stage. With empty_cache, the memory cached by PyTorch's
+  // allocator is then returned to the driver so TensorRT can allocate it as well. requester is the slot of the
+  // execution reclaiming memory, if any. Returns the bytes of device memory the runtime let go of
+  int64_t reclaim(
+      int64_t device_id,
+      ReclaimStage stage,
+      TRTExecutionSlot* requester = nullptr,
+      bool empty_cache = true);
+  // Number of reclaims run and bytes reclaimed by them since the process started
+  int64_t get_num_reclaims();
+  int64_t get_reclaimed_bytes();
+
+ private:
+  std::mutex mu;
+  std::unordered_set<TRTEngine*> engines;
+  std::once_flag observer_attached;
+  std::atomic<int64_t> num_reclaims = {0};
+  std::atomic<int64_t> reclaimed_bytes = {0};
+};
+
+MemoryReclaimer& get_memory_reclaimer();
+
+// Runs attempt, which returns false or throws a CUDA out of memory error when it ran out of device memory. Unless
+// RECLAIM_MEMORY_ON_OOM is unset, the memory of device_id is then reclaimed one stage at a time and attempt retried
+// after each stage. Returns the result of the last attempt, an out of memory error of the last attempt and any other
+// error are rethrown
+bool retry_reclaiming_memory(
+    int64_t device_id,
+    const std::function<bool()>& attempt,
+    TRTExecutionSlot* requester = nullptr);
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
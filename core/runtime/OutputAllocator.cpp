@@ -0,0 +1,99 @@
+#include "core/runtime/OutputAllocator.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "c10/cuda/CUDAFunctions.h"
+#include "torch/torch.h"
+
+#include "core/runtime/MemoryReclaimer.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+DynamicOutputAllocator::DynamicOutputAllocator(const std::vector<std::string>& output_names)
+    : names(output_names), buffers(output_names.size()), shapes(output_names.size()) {}
+
+int64_t DynamicOutputAllocator::index_of(char const* tensor_name) const {
+  // Engines have a handful of outputs, a linear scan is cheaper than hashing the name
+  for (size_t i = 0; i < names.size(); i++) {
+    if (std::strcmp(names[i].c_str(), tensor_name) == 0) {
+      return static_cast<int64_t>(i);
+    }
+  }
+  return -1;
+}
+
+void* DynamicOutputAllocator::reallocateOutputAsync(
+    char const* tensor_name,
+    void* current_memory,
+    uint64_t size,
+    uint64_t alignment,
+    cudaStream_t stream) {
+  auto idx = index_of(tensor_name);
+  if (idx < 0) {
+    LOG_ERROR("Output allocator was asked for memory for unknown output " << tensor_name);
+    return nullptr;
+  }
+  auto& buf = buffers[idx];
+  // The caching allocator aligns allocations far beyond what TensorRT asks for
+  bool reusable = buf.defined() && static_cast<uint64_t>(buf.nbytes()) >= size && buf.use_count() == 1 &&
+      buf.storage().use_count() == 1;
+  if (!reusable) {
+    // Grow geometrically so outputs which get slightly larger on every call are not reallocated on every call. A
+    // buffer which is large enough but still held by the caller is replaced with one of the same size
+    int64_t nbytes = std::max<int64_t>(static_cast<int64_t>(size), 1);
+    if (buf.defined()) {
+      nbytes = std::max<int64_t>(nbytes, static_cast<uint64_t>(buf.nbytes()) >= size ? buf.nbytes() : 2 * buf.nbytes());
+    }
+    try {
+      retry_reclaiming_memory(c10::cuda::current_device(), [&]() {
+        buf = at::empty({nbytes}, at::TensorOptions().device(at::kCUDA).dtype(at::kByte));
+        return true;
+      });
+    } catch (const std::exception& e) {
+      LOG_ERROR("Unable to allocate " << size << "B for output " << tensor_name << ": " << e.what());
+      return nullptr;
+    }
+    LOG_DEBUG("Allocated " << nbytes << "B for data dependent output " << tensor_name);
+  }
+  return buf.data_ptr();
+}
+
+void DynamicOutputAllocator::notifyShape(char const* tensor_name, nvinfer1::Dims const& dims) noexcept {
+  auto idx = index_of(tensor_name);
+  if (idx >= 0) {
+    shapes[idx] = util::toVec(dims);
+  }
+}
+
+at::Tensor DynamicOutputAllocator::output(size_t pyt_idx, at::ScalarType type) const {
+  const auto& shape = shapes[pyt_idx];
+  int64_t numel = c10::multiply_integers(shape);
+  if (numel == 0 || !buffers[pyt_idx].defined()) {
+    return at::empty(shape, at::TensorOptions().device(at::kCUDA).dtype(type));
+  }
+  auto nbytes = numel * static_cast<int64_t>(c10::elementSize(type));
+  return buffers[pyt_idx].narrow(0, 0, nbytes).view(type).view(shape);
+}
+
+const at::Tensor& DynamicOutputAllocator::buffer(size_t pyt_idx) const {
+  return buffers[pyt_idx];
+}
+
+int64_t DynamicOutputAllocator::release_idle_buffers() {
+  int64_t released = 0;
+  for (auto& buf : buffers) {
+    if (buf.defined() && buf.use_count() == 1 && buf.storage().use_count() == 1) {
+      released += buf.nbytes();
+      buf = at::Tensor();
+    }
+  }
+  return released;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,46 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "ATen/Tensor.h"
+#include "NvInfer.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Output allocator for outputs whose shapes depend on the input data (e.g. aten::nonzero), which cannot be resolved
+// with getTensorShape before the engine runs. TensorRT requests the memory for these outputs during enqueue and
+// reports their final shapes once they are known. A buffer is kept per output and only grows; it is reused for the
+// next execution unless the caller still holds the previous outputs (which are views into it), in which case a new
+// buffer is allocated
+class DynamicOutputAllocator : public nvinfer1::IOutputAllocator {
+ public:
+  explicit DynamicOutputAllocator(const std::vector<std::string>& output_names);
+
+  void* reallocateOutputAsync(
+      char const* tensor_name,
+      void* current_memory,
+      uint64_t size,
+      uint64_t alignment,
+      cudaStream_t stream) override;
+  void notifyShape(char const* tensor_name, nvinfer1::Dims const& dims) noexcept override;
+
+  // Right sized view of the output written by the last execution
+  at::Tensor output(size_t pyt_idx, at::ScalarType type) const;
+  const at::Tensor& buffer(size_t pyt_idx) const;
+  // Drops the buffers the caller does not hold outputs of, returns their bytes. Buffers are allocated again by the
+  // next execution which needs them
+  int64_t release_idle_buffers();
+
+ private:
+  int64_t index_of(char const* tensor_name) const;
+
+  std::vector<std::string> names; // ITO: PYT IDX
+  std::vector<at::Tensor> buffers;
+  std::vector<std::vector<int64_t>> shapes;
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -1,3 +1,5 @@
+#include <iomanip>
+
 #include "cuda_runtime.h"
 
 #include "core/runtime/runtime.h"
@@ -7,7 +9,14 @@ namespace torch_tensorrt {
 namespace core {
 namespace runtime {
 
-typedef enum { ID_IDX = 0, SM_MAJOR_IDX, SM_MINOR_IDX, DEVICE_TYPE_IDX, DEVICE_NAME_IDX } SerializedDeviceInfoIndex;
+typedef enum {
+  ID_IDX = 0,
+  SM_MAJOR_IDX,
+  SM_MINOR_IDX,
+  DEVICE_TYPE_IDX,
+  DEVICE_NAME_IDX,
+  DLA_CORE_IDX
+} SerializedDeviceInfoIndex;
 
 RTDevice::RTDevice() : id{-1}, major{-1}, minor{-1}, device_type{nvinfer1::DeviceType::kGPU} {}
 
@@ -34,10 +43,26 @@ RTDevice::RTDevice(int64_t gpu_id, nvinfer1::DeviceType device_type) {
 
   // Set Device Type
   this->device_type = device_type;
+
+  this->integrated = device_prop.integrated != 0;
+
+  this->multiprocessors = device_prop.multiProcessorCount;
+
+  // Formatted like nvidia-smi lists it, 8-4-4-4-12 hex digits
+  std::stringstream uuid;
+  uuid << (getMIGProfile().empty() ? "GPU" : "MIG") << std::hex << std::setfill('0');
+  for (size_t i = 0; i < sizeof(device_prop.uuid.bytes); i++) {
+    if (i == 0 || i == 4 || i == 6 || i == 8 || i == 10) {
+      uuid << '-';
+    }
+    uuid << std::setw(2) << static_cast<int>(static_cast<unsigned char>(device_prop.uuid.bytes[i]));
+  }
+  this->uuid = uuid.str();
 }
 
 // NOTE: Serialization Format for Device Info:
-// id%major%minor%(enum)device_type%device_name
+// id%major%minor%(enum)device_type%device_name[%dla_core]
+// The DLA core is only recorded for DLA engines, device info without it is still accepted
 
 RTDevice::RTDevice(std::string device_info) {
   LOG_DEBUG("Deserializing Device Info: " << device_info);
@@ -53,13 +78,18 @@ RTDevice::RTDevice(std::string device_info) {
   }
   tokens.push_back(device_info.substr(start, end - start));
 
-  TORCHTRT_CHECK(tokens.size() == DEVICE_NAME_IDX + 1, "Unable to deserializable program target device infomation");
+  TORCHTRT_CHECK(
+      tokens.size() == DEVICE_NAME_IDX + 1 || tokens.size() == DLA_CORE_IDX + 1,
+      "Unable to deserializable program target device infomation");
 
   id = std::stoi(tokens[ID_IDX]);
   major = std::stoi(tokens[SM_MAJOR_IDX]);
   minor = std::stoi(tokens[SM_MINOR_IDX]);
   device_type = (nvinfer1::DeviceType)(std::stoi(tokens[DEVICE_TYPE_IDX]));
   device_name = tokens[DEVICE_NAME_IDX];
+  if (tokens.size() == DLA_CORE_IDX + 1) {
+    dla_core = std::stoi(tokens[DLA_CORE_IDX]);
+  }
 
   LOG_DEBUG("Deserialized Device Info: " << *this);
 }
@@ -70,6 +100,10 @@ RTDevice& RTDevice::operator=(const RTDevice& other) {
   minor = other.minor;
   device_type = other.device_type;
   device_name = other.device_name;
+  dla_core = other.dla_core;
+  integrated = other.integrated;
+  uuid = other.uuid;
+  multiprocessors = other.multiprocessors;
   return (*this);
 }
 
@@ -88,6 +122,9 @@ std::string RTDevice::serialize() {
     ss << content[i] << DEVICE_INFO_DELIM;
   }
   ss << content[DEVICE_NAME_IDX];
+  if (device_type == nvinfer1::DeviceType::kDLA && dla_core >= 0) {
+    ss << DEVICE_INFO_DELIM << dla_core;
+  }
 
   std::string serialized_device_info = ss.str();
 
@@ -102,9 +139,28 @@ std::string RTDevice::getSMCapability() const {
   return ss.str();
 }
 
+// Not a std::string, devices are already constructed during static initialization
+constexpr char MIG_NAME_DELIM[] = " MIG ";
+
+std::string RTDevice::getMIGProfile() const {
+  auto pos = device_name.find(MIG_NAME_DELIM);
+  return pos == std::string::npos ? "" : device_name.substr(pos + sizeof(MIG_NAME_DELIM) - 1);
+}
+
+std::string RTDevice::getBaseName() const {
+  return device_name.substr(0, device_name.find(MIG_NAME_DELIM));
+}
+
 std::ostream& operator<<(std::ostream& os, const RTDevice& device) {
   os << "Device(ID: " << device.id << ", Name: " << device.device_name << ", SM Capability: " << device.major << '.'
-     << device.minor << ", Type: " << device.device_type << ')';
+     << device.minor << ", Type: " << device.device_type;
+  if (device.dla_core >= 0) {
+    os << ", DLA Core: " << device.dla_core;
+  }
+  if (!device.uuid.empty()) {
+    os << ", UUID: " << device.uuid;
+  }
+  os << ')';
   return os;
 }
 
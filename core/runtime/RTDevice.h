@@ -14,6 +14,15 @@ struct RTDevice {
   int64_t minor; // CUDA compute minor version
   nvinfer1::DeviceType device_type;
   std::string device_name;
+  // DLA core the engine runs on, -1 for engines which run on the GPU
+  int64_t dla_core = -1;
+  // Whether the GPU shares its DRAM with the host (e.g. Jetson), queried from the device and not serialized
+  bool integrated = false;
+  // UUID of the GPU ("GPU-...") or of the MIG instance ("MIG-...") as nvidia-smi lists it, queried from the device
+  // and not serialized as it identifies a device of one machine
+  std::string uuid;
+  // Number of SMs of the device (of the MIG instance on MIG devices), queried and not serialized
+  int64_t multiprocessors = 0;
 
   RTDevice();
   RTDevice(int64_t gpu_id, nvinfer1::DeviceType device_type);
@@ -23,6 +32,11 @@ struct RTDevice {
   RTDevice& operator=(const RTDevice& other);
   std::string serialize();
   std::string getSMCapability() const;
+  // MIG profile of a MIG instance (e.g. "1g.10gb"), empty for a full GPU. CUDA names MIG instances after their GPU
+  // followed by "MIG <profile>", so it is known for deserialized devices too
+  std::string getMIGProfile() const;
+  // Name of the GPU model, without the MIG profile of a MIG instance
+  std::string getBaseName() const;
   friend std::ostream& operator<<(std::ostream& os, const RTDevice& device);
 };
 
@@ -0,0 +1,166 @@
+#include "core/runtime/SampledLayerProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+namespace {
+int64_t steady_now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+std::string json_escape(const std::string& s) {
+  std::stringstream ss;
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      ss << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      ss << ' ';
+    } else {
+      ss << c;
+    }
+  }
+  return ss.str();
+}
+} // namespace
+
+void SampledLayerProfiler::enable(const std::string& name, LayerSamplingConfig config) {
+  TORCHTRT_CHECK(
+      config.every_n >= 0 && config.window_ms >= 0 && (config.every_n > 0 || config.window_ms > 0),
+      "Layer sampling needs every_n or window_ms to be positive, got every_n " << config.every_n << " and window_ms "
+                                                                               << config.window_ms);
+  TORCHTRT_CHECK(
+      config.report_every > 0 && config.max_reports > 0, "Layer sampling needs positive report_every and max_reports");
+  if (!config.output_dir.empty()) {
+    std::error_code ec;
+    std::filesystem::create_directories(config.output_dir, ec);
+    TORCHTRT_CHECK(!ec, "Unable to create layer sample directory " << config.output_dir << ": " << ec.message());
+  }
+  std::lock_guard<std::mutex> lock(mu);
+  this->name = name;
+  every_n = config.every_n;
+  window_end_ns = config.window_ms > 0 ? steady_now_ns() + config.window_ms * 1000000 : 0;
+  executions = 0;
+  this->config = std::move(config);
+  enabled = true;
+  LOG_DEBUG(
+      "Sampling the layer times of engine " << name << " (every " << every_n << " executions, window "
+                                            << this->config.window_ms << "ms)");
+}
+
+void SampledLayerProfiler::disable() {
+  std::lock_guard<std::mutex> lock(mu);
+  if (!enabled.exchange(false)) {
+    return;
+  }
+  if (sampled_executions > 0) {
+    write_report_locked();
+  }
+}
+
+bool SampledLayerProfiler::is_enabled() const {
+  return enabled.load(std::memory_order_relaxed);
+}
+
+bool SampledLayerProfiler::sample() {
+  if (!enabled.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  auto n = executions.fetch_add(1, std::memory_order_relaxed);
+  auto window_end = window_end_ns.load(std::memory_order_relaxed);
+  if (window_end > 0) {
+    if (steady_now_ns() < window_end) {
+      return true;
+    }
+    // Sampling only for a window ends with it, the first execution past the window writes out the report
+    if (every_n.load(std::memory_order_relaxed) == 0) {
+      int64_t expected = window_end;
+      if (window_end_ns.compare_exchange_strong(expected, 0)) {
+        disable();
+      }
+      return false;
+    }
+  }
+  auto every = every_n.load(std::memory_order_relaxed);
+  return every > 0 && n % every == 0;
+}
+
+void SampledLayerProfiler::reportLayerTime(const char* layer_name, float ms) noexcept {
+  std::lock_guard<std::mutex> lock(mu);
+  auto it = layer_index.find(layer_name);
+  if (it == layer_index.end()) {
+    it = layer_index.emplace(layer_name, layers.size()).first;
+    LayerStats stats;
+    stats.name = layer_name;
+    stats.min_ms = ms;
+    stats.max_ms = ms;
+    layers.push_back(std::move(stats));
+  }
+  auto& stats = layers[it->second];
+  stats.count++;
+  stats.total_ms += ms;
+  stats.min_ms = std::min(stats.min_ms, ms);
+  stats.max_ms = std::max(stats.max_ms, ms);
+}
+
+void SampledLayerProfiler::end_sample() {
+  std::lock_guard<std::mutex> lock(mu);
+  sampled_executions++;
+  if (sampled_executions >= config.report_every) {
+    write_report_locked();
+  }
+}
+
+std::string SampledLayerProfiler::to_json() const {
+  std::lock_guard<std::mutex> lock(mu);
+  return to_json_locked();
+}
+
+std::string SampledLayerProfiler::to_json_locked() const {
+  std::stringstream ss;
+  ss << "{\"engine\": \"" << json_escape(name) << "\", \"report\": " << num_reports
+     << ", \"sampled_executions\": " << sampled_executions << ", \"layers\": [";
+  for (size_t i = 0; i < layers.size(); i++) {
+    const auto& l = layers[i];
+    ss << (i == 0 ? "" : ", ") << "{\"name\": \"" << json_escape(l.name) << "\", \"count\": " << l.count
+       << ", \"mean_ms\": " << l.total_ms / l.count << ", \"min_ms\": " << l.min_ms << ", \"max_ms\": " << l.max_ms
+       << "}";
+  }
+  ss << "]}";
+  return ss.str();
+}
+
+void SampledLayerProfiler::write_report_locked() {
+  if (!config.output_dir.empty()) {
+    auto path = std::filesystem::path(config.output_dir) /
+        (name + "_layer_samples_" + std::to_string(num_reports % config.max_reports) + ".json");
+    std::ofstream f(path);
+    f << to_json_locked() << std::endl;
+    if (!f) {
+      LOG_WARNING("Unable to write the layer samples of engine " << name << " to " << path.string());
+    }
+  }
+  num_reports++;
+  layers.clear();
+  layer_index.clear();
+  sampled_executions = 0;
+}
+
+void SampledLayerProfiler::reset() {
+  std::lock_guard<std::mutex> lock(mu);
+  layers.clear();
+  layer_index.clear();
+  sampled_executions = 0;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "NvInfer.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+struct LayerSamplingConfig {
+  // Profile 1 in every_n executions, 0 to only profile during the window
+  int64_t every_n = 100;
+  // Profile every execution for this long after sampling is enabled, 0 for no window
+  int64_t window_ms = 0;
+  // Directory the reports are written to, none are written if empty
+  std::string output_dir = "";
+  // Sampled executions per report, the statistics start over after each report
+  int64_t report_every = 1000;
+  // Reports kept per engine, the oldest is overwritten once there are that many
+  int64_t max_reports = 4;
+};
+
+// Layer profiler for engines serving traffic. Only sampled executions run with the profiler attached (TensorRT makes
+// them synchronous), the others are not affected. Layer times are accumulated into per layer statistics so memory is
+// bounded by the number of layers, and written to <output_dir>/<engine>_layer_samples_<n>.json with n cycling through
+// max_reports. Safe to use from concurrent execution slots
+class SampledLayerProfiler : public nvinfer1::IProfiler {
+ public:
+  SampledLayerProfiler() = default;
+  SampledLayerProfiler(const SampledLayerProfiler&) = delete;
+  SampledLayerProfiler& operator=(const SampledLayerProfiler&) = delete;
+
+  // name is the engine the reports are named after
+  void enable(const std::string& name, LayerSamplingConfig config);
+  // Writes out the statistics of the current report first
+  void disable();
+  bool is_enabled() const;
+  // Called once per execution, whether the execution should run with the profiler attached
+  bool sample();
+  void reportLayerTime(const char* layer_name, float ms) noexcept override;
+  // Called once a sampled execution was enqueued, writes the report every report_every samples
+  void end_sample();
+  // {"engine": ..., "report": ..., "sampled_executions": ..., "layers": [{"name": ..., "count": ..., "mean_ms": ...,
+  // "min_ms": ..., "max_ms": ...}, ...]} with the layers in execution order
+  std::string to_json() const;
+  void reset();
+
+ private:
+  struct LayerStats {
+    std::string name;
+    int64_t count = 0;
+    double total_ms = 0;
+    float min_ms = 0;
+    float max_ms = 0;
+  };
+  // Expects mu to be held
+  std::string to_json_locked() const;
+  void write_report_locked();
+
+  std::string name;
+  // Read by every execution without taking mu
+  std::atomic<bool> enabled = {false};
+  std::atomic<int64_t> executions = {0};
+  std::atomic<int64_t> every_n = {0};
+  std::atomic<int64_t> window_end_ns = {0}; // steady_clock, 0 if there is no window
+  mutable std::mutex mu;
+  LayerSamplingConfig config;
+  std::vector<LayerStats> layers;
+  std::unordered_map<std::string, size_t> layer_index;
+  int64_t sampled_executions = 0;
+  int64_t num_reports = 0;
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
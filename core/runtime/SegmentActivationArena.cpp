@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+#include "ATen/ATen.h"
+#include "c10/cuda/CUDAFunctions.h"
+#include "c10/util/accumulate.h"
+
+#include "core/runtime/SegmentActivationArena.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+namespace {
+
+// Alignment of the tensors placed in the arena, that of the caching allocator
+constexpr int64_t kAlignment = 512;
+
+int64_t align(int64_t nbytes) {
+  return (nbytes + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+} // namespace
+
+SegmentActivationArena::SegmentActivationArena(std::string name, std::vector<ActivationLifetime> lifetimes)
+    : name(std::move(name)), lifetimes(std::move(lifetimes)) {
+  index_lifetimes();
+}
+
+SegmentActivationArena::SegmentActivationArena(std::vector<std::string> serialized_info) {
+  TORCHTRT_CHECK(
+      serialized_info.size() == 2, "Program to be deserialized has a malformed segment activation arena");
+  name = serialized_info[0];
+  std::istringstream ss(serialized_info[1]);
+  ActivationLifetime l;
+  while (ss >> l.step >> l.output >> l.last_use) {
+    lifetimes.push_back(l);
+  }
+  index_lifetimes();
+}
+
+void SegmentActivationArena::index_lifetimes() {
+  for (size_t i = 0; i < lifetimes.size(); i++) {
+    auto& l = lifetimes[i];
+    TORCHTRT_CHECK(
+        l.step >= 0 && l.output >= 0 && l.last_use >= l.step,
+        "Segment activation arena " << name << " has an invalid lifetime: output " << l.output << " of step "
+                                    << l.step << " last used at step " << l.last_use);
+    planned[{l.step, l.output}] = i;
+  }
+}
+
+at::Tensor SegmentActivationArena::allocate(
+    int64_t step,
+    int64_t output,
+    c10::IntArrayRef shape,
+    at::ScalarType type) {
+  auto lifetime = planned.find({step, output});
+  if (lifetime == planned.end()) {
+    return {};
+  }
+  auto idx = lifetime->second;
+
+  ThreadArena* arena = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(mu);
+    arena = &thread_arenas[std::this_thread::get_id()];
+  }
+  auto device = c10::cuda::current_device();
+  auto stream = c10::cuda::getCurrentCUDAStream(device);
+  auto options = at::TensorOptions().device(at::kCUDA, device).dtype(at::kByte);
+  if (step <= arena->last_step || arena->stream != stream) {
+    arena->call++;
+    arena->placements.resize(lifetimes.size());
+    if (!arena->buffer.defined() || arena->buffer.nbytes() < static_cast<size_t>(arena->peak) ||
+        arena->stream != stream) {
+      arena->buffer = at::Tensor();
+      arena->buffer = at::empty({arena->peak}, options);
+    }
+    arena->stream = stream;
+  }
+  arena->last_step = step;
+
+  // First fit between the tensors of this call which are still live, the inputs of the step included
+  int64_t nbytes = align(c10::multiply_integers(shape) * static_cast<int64_t>(c10::elementSize(type)));
+  std::vector<std::pair<int64_t, int64_t>> live;
+  for (size_t i = 0; i < lifetimes.size(); i++) {
+    auto& p = arena->placements[i];
+    if (i != idx && p.call == arena->call && lifetimes[i].last_use >= step) {
+      live.push_back({p.offset, p.offset + p.nbytes});
+    }
+  }
+  std::sort(live.begin(), live.end());
+  int64_t offset = 0;
+  for (auto& range : live) {
+    if (offset + nbytes <= range.first) {
+      break;
+    }
+    offset = std::max(offset, range.second);
+  }
+  arena->placements[idx] = {offset, nbytes, arena->call};
+  arena->peak = std::max(arena->peak, offset + nbytes);
+
+  if (arena->buffer.nbytes() < static_cast<size_t>(offset + nbytes)) {
+    // Tensors already placed keep the previous allocation alive, the arena is sized to the peak on the next call
+    LOG_DEBUG("Segment activation arena " << name << " grows to " << arena->peak << "B");
+    arena->buffer = at::empty({arena->peak}, options);
+  }
+  auto t = at::empty({0}, options.dtype(type));
+  t.set_(arena->buffer.storage(), offset / static_cast<int64_t>(c10::elementSize(type)), shape);
+  return t;
+}
+
+int64_t SegmentActivationArena::get_size() {
+  std::lock_guard<std::mutex> guard(mu);
+  auto arena = thread_arenas.find(std::this_thread::get_id());
+  if (arena == thread_arenas.end() || !arena->second.buffer.defined()) {
+    return 0;
+  }
+  return static_cast<int64_t>(arena->second.buffer.nbytes());
+}
+
+std::vector<std::string> SegmentActivationArena::serialize() const {
+  std::ostringstream ss;
+  for (auto& l : lifetimes) {
+    ss << l.step << " " << l.output << " " << l.last_use << " ";
+  }
+  return {name, ss.str()};
+}
+
+std::string SegmentActivationArena::to_str() const {
+  std::ostringstream ss;
+  ss << "Segment activation arena {" << std::endl;
+  ss << "  Name: " << name << std::endl;
+  ss << "  Planned Tensors: [" << std::endl;
+  for (auto& l : lifetimes) {
+    ss << "    Step " << l.step << " Output " << l.output << " -> Step " << l.last_use << std::endl;
+  }
+  ss << "  ]" << std::endl;
+  ss << "}" << std::endl;
+  return ss.str();
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,74 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ATen/Tensor.h"
+#include "c10/cuda/CUDAStream.h"
+#include "torch/custom_class.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Output output of the step-th engine of a hybrid graph, last read by the engine at step last_use
+struct ActivationLifetime {
+  int64_t step;
+  int64_t output;
+  int64_t last_use;
+};
+
+// Arena the tensors passed between consecutive TensorRT segments of a hybrid graph are placed in instead of each
+// being a new allocation. Lifetimes are planned at compile time from the stitched graph, offsets are assigned first
+// fit when the engines run since shapes may be dynamic. A tensor only shares memory with tensors whose lifetimes do
+// not overlap with its own, and the arena grows to the peak of the calls seen so far. Each calling thread has its own
+// arena, bound to the stream it was last used on: a call on another stream starts from a new allocation so that the
+// caching allocator orders reuse of the old one. The engines reading planned tensors synchronize with the caller
+// stream before returning, so a call only reuses memory whose readers from previous calls have already run
+struct SegmentActivationArena : torch::CustomClassHolder {
+  SegmentActivationArena(std::string name, std::vector<ActivationLifetime> lifetimes);
+  // {name, lifetimes}, the format of serialize
+  SegmentActivationArena(std::vector<std::string> serialized_info);
+
+  // Uninitialized contiguous tensor placed in the arena, or an undefined tensor if output output of the engine at
+  // step is not planned. Steps have to be allocated in execution order, a step not after the previous one starts a
+  // new call
+  at::Tensor allocate(int64_t step, int64_t output, c10::IntArrayRef shape, at::ScalarType type);
+  // Size of the arena of the calling thread, in bytes
+  int64_t get_size();
+  std::vector<std::string> serialize() const;
+  std::string to_str() const;
+
+  std::string name;
+  std::vector<ActivationLifetime> lifetimes;
+
+ private:
+  void index_lifetimes();
+
+  struct Placement {
+    int64_t offset = 0;
+    int64_t nbytes = 0;
+    // Call the placement was made in, placements of previous calls are free
+    uint64_t call = 0;
+  };
+  struct ThreadArena {
+    at::Tensor buffer;
+    c10::optional<c10::cuda::CUDAStream> stream;
+    std::vector<Placement> placements; // ITO: lifetimes
+    int64_t last_step = -1;
+    uint64_t call = 0;
+    int64_t peak = 0;
+  };
+  // (step, output) -> index into lifetimes
+  std::map<std::pair<int64_t, int64_t>, size_t> planned;
+  std::mutex mu;
+  std::unordered_map<std::thread::id, ThreadArena> thread_arenas;
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
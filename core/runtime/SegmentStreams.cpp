@@ -0,0 +1,99 @@
+#include <map>
+#include <utility>
+
+#include "ATen/cuda/CUDAEvent.h"
+#include "c10/cuda/CUDACachingAllocator.h"
+#include "c10/cuda/CUDAFunctions.h"
+#include "c10/cuda/CUDAStream.h"
+
+#include "core/runtime/SegmentStreams.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+namespace {
+
+struct SegmentStream {
+  c10::cuda::CUDAStream stream;
+  // Recorded on the current stream at enter for the branch to wait on
+  at::cuda::CUDAEvent ready;
+  // Recorded on the branch at exit for joins to wait on
+  at::cuda::CUDAEvent done;
+};
+
+struct ThreadSegmentStreams {
+  std::map<std::pair<c10::DeviceIndex, int64_t>, SegmentStream> streams;
+  // Streams current at each enter which has not been exited yet
+  std::vector<c10::cuda::CUDAStream> callers;
+};
+
+thread_local ThreadSegmentStreams thread_segment_streams;
+
+c10::DeviceIndex deviceOf(const std::vector<at::Tensor>& tensors) {
+  for (auto& t : tensors) {
+    if (t.is_cuda()) {
+      return t.device().index();
+    }
+  }
+  return c10::cuda::current_device();
+}
+
+SegmentStream& segmentStream(c10::DeviceIndex device, int64_t branch) {
+  TORCHTRT_CHECK(branch >= 0, "Segment stream branches must not be negative, got " << branch);
+  auto& streams = thread_segment_streams.streams;
+  auto key = std::make_pair(device, branch);
+  auto it = streams.find(key);
+  if (it == streams.end()) {
+    LOG_DEBUG("Creating the stream of segment branch " << branch << " on device " << device);
+    it = streams.emplace(key, SegmentStream{c10::cuda::getStreamFromPool(false, device), {}, {}}).first;
+  }
+  return it->second;
+}
+
+// Keeps the caching allocator from reusing the memory of the tensors before the work stream enqueued on them is done
+void recordTensors(const std::vector<at::Tensor>& tensors, const c10::cuda::CUDAStream& stream) {
+  for (auto& t : tensors) {
+    if (t.defined() && t.is_cuda()) {
+      c10::cuda::CUDACachingAllocator::recordStream(t.storage().data_ptr(), stream);
+    }
+  }
+}
+
+} // namespace
+
+std::vector<at::Tensor> enter_segment_stream(std::vector<at::Tensor> inputs, int64_t branch) {
+  auto device = deviceOf(inputs);
+  auto caller = c10::cuda::getCurrentCUDAStream(device);
+  auto& seg = segmentStream(device, branch);
+  seg.ready.record(caller);
+  seg.ready.block(seg.stream);
+  recordTensors(inputs, seg.stream);
+  thread_segment_streams.callers.push_back(caller);
+  c10::cuda::setCurrentCUDAStream(seg.stream);
+  return inputs;
+}
+
+std::vector<at::Tensor> exit_segment_stream(std::vector<at::Tensor> outputs, int64_t branch) {
+  auto& callers = thread_segment_streams.callers;
+  TORCHTRT_CHECK(!callers.empty(), "Exiting segment branch " << branch << " which was not entered");
+  auto caller = callers.back();
+  callers.pop_back();
+  auto& seg = segmentStream(caller.device_index(), branch);
+  seg.done.record(seg.stream);
+  c10::cuda::setCurrentCUDAStream(caller);
+  return outputs;
+}
+
+std::vector<at::Tensor> join_segment_stream(std::vector<at::Tensor> values, int64_t branch) {
+  auto device = deviceOf(values);
+  auto current = c10::cuda::getCurrentCUDAStream(device);
+  auto& seg = segmentStream(device, branch);
+  seg.done.block(current);
+  recordTensors(values, current);
+  return values;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "ATen/Tensor.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Side streams the TensorRT segments of a hybrid graph are scheduled on so that segments which do not depend on each
+// other run concurrently. Each calling thread has one stream per device and branch.
+//
+// enter_segment_stream makes the stream of branch wait for the work enqueued so far on the current stream and makes
+// it the current stream, exit_segment_stream records the work of the branch and switches back to the stream current at
+// the matching enter. join_segment_stream makes the current stream wait for the work recorded on branch, values
+// produced on the branch must pass through a join before they are used on another stream. The tensors are returned
+// as is.
+std::vector<at::Tensor> enter_segment_stream(std::vector<at::Tensor> inputs, int64_t branch);
+std::vector<at::Tensor> exit_segment_stream(std::vector<at::Tensor> outputs, int64_t branch);
+std::vector<at::Tensor> join_segment_stream(std::vector<at::Tensor> values, int64_t branch);
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+#include "core/runtime/ShapeHistogram.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+namespace {
+
+std::vector<std::vector<int64_t>> decode_shapes(const std::vector<int64_t>& encoded) {
+  std::vector<std::vector<int64_t>> shapes;
+  size_t i = 0;
+  while (i < encoded.size()) {
+    auto rank = encoded[i++];
+    shapes.emplace_back(encoded.begin() + i, encoded.begin() + i + rank);
+    i += rank;
+  }
+  return shapes;
+}
+
+std::vector<double> flatten(const std::vector<std::vector<int64_t>>& shapes) {
+  std::vector<double> point;
+  for (const auto& shape : shapes) {
+    point.insert(point.end(), shape.begin(), shape.end());
+  }
+  return point;
+}
+
+double squared_distance(const std::vector<double>& a, const std::vector<double>& b) {
+  double d = 0;
+  for (size_t i = 0; i < a.size(); i++) {
+    d += (a[i] - b[i]) * (a[i] - b[i]);
+  }
+  return d;
+}
+
+double max_volume(const InputShapeProfile& profile) {
+  double volume = 0;
+  for (const auto& shape : profile.max) {
+    double v = 1;
+    for (auto d : shape) {
+      v *= d;
+    }
+    volume += v;
+  }
+  return volume;
+}
+
+} // namespace
+
+void InputShapeHistogram::record(const ShapeKey& key) {
+  std::vector<int64_t> encoded(key.encoded.begin(), key.encoded.end());
+  std::lock_guard<std::mutex> lock(mu);
+  counts[std::move(encoded)]++;
+}
+
+void InputShapeHistogram::reset() {
+  std::lock_guard<std::mutex> lock(mu);
+  counts.clear();
+}
+
+std::vector<InputShapeSample> InputShapeHistogram::samples() const {
+  std::lock_guard<std::mutex> lock(mu);
+  std::vector<InputShapeSample> samples;
+  for (const auto& c : counts) {
+    samples.push_back({decode_shapes(c.first), c.second});
+  }
+  return samples;
+}
+
+c10::Dict<std::string, int64_t> InputShapeHistogram::to_dict() const {
+  c10::Dict<std::string, int64_t> dict;
+  for (const auto& sample : samples()) {
+    std::stringstream ss;
+    for (const auto& shape : sample.shapes) {
+      ss << '(';
+      for (size_t i = 0; i < shape.size(); i++) {
+        ss << (i ? "," : "") << shape[i];
+      }
+      ss << ')';
+    }
+    dict.insert(ss.str(), sample.count);
+  }
+  return dict;
+}
+
+std::vector<InputShapeProfile> derive_shape_profiles(
+    const std::vector<InputShapeSample>& samples,
+    int64_t num_profiles) {
+  TORCHTRT_CHECK(num_profiles > 0, "Expected at least one optimization profile, got " << num_profiles);
+  TORCHTRT_CHECK(!samples.empty(), "Cannot derive optimization profiles without any recorded input shapes");
+  for (const auto& sample : samples) {
+    TORCHTRT_CHECK(
+        sample.shapes.size() == samples[0].shapes.size(),
+        "Recorded input shapes have different numbers of inputs, " << sample.shapes.size() << " and "
+                                                                   << samples[0].shapes.size());
+    for (size_t i = 0; i < sample.shapes.size(); i++) {
+      TORCHTRT_CHECK(
+          sample.shapes[i].size() == samples[0].shapes[i].size(),
+          "Recorded shapes of input " << i << " have different ranks");
+    }
+  }
+
+  std::vector<std::vector<double>> points;
+  for (const auto& sample : samples) {
+    points.push_back(flatten(sample.shapes));
+  }
+  auto k = std::min(static_cast<size_t>(num_profiles), samples.size());
+
+  // Deterministic k-means++ seeding: the most frequent shape, then the shape with the largest weighted distance to the
+  // centroids picked so far
+  std::vector<std::vector<double>> centroids;
+  auto heaviest = std::max_element(
+      samples.begin(), samples.end(), [](const auto& a, const auto& b) { return a.count < b.count; });
+  centroids.push_back(points[heaviest - samples.begin()]);
+  while (centroids.size() < k) {
+    size_t best = 0;
+    double best_score = -1;
+    for (size_t p = 0; p < points.size(); p++) {
+      double nearest = std::numeric_limits<double>::max();
+      for (const auto& c : centroids) {
+        nearest = std::min(nearest, squared_distance(points[p], c));
+      }
+      if (nearest * samples[p].count > best_score) {
+        best_score = nearest * samples[p].count;
+        best = p;
+      }
+    }
+    centroids.push_back(points[best]);
+  }
+
+  std::vector<size_t> assignment(points.size(), 0);
+  for (int iteration = 0; iteration < 100; iteration++) {
+    bool changed = false;
+    for (size_t p = 0; p < points.size(); p++) {
+      size_t nearest = 0;
+      for (size_t c = 1; c < k; c++) {
+        if (squared_distance(points[p], centroids[c]) < squared_distance(points[p], centroids[nearest])) {
+          nearest = c;
+        }
+      }
+      changed |= iteration == 0 || assignment[p] != nearest;
+      assignment[p] = nearest;
+    }
+    if (!changed) {
+      break;
+    }
+    for (size_t c = 0; c < k; c++) {
+      std::vector<double> sum(points[0].size(), 0);
+      double weight = 0;
+      for (size_t p = 0; p < points.size(); p++) {
+        if (assignment[p] == c) {
+          for (size_t d = 0; d < sum.size(); d++) {
+            sum[d] += points[p][d] * samples[p].count;
+          }
+          weight += samples[p].count;
+        }
+      }
+      if (weight > 0) {
+        for (auto& s : sum) {
+          s /= weight;
+        }
+        centroids[c] = sum;
+      }
+    }
+  }
+
+  std::vector<InputShapeProfile> profiles;
+  for (size_t c = 0; c < k; c++) {
+    InputShapeProfile profile;
+    int64_t opt_count = -1;
+    for (size_t p = 0; p < samples.size(); p++) {
+      if (assignment[p] != c) {
+        continue;
+      }
+      const auto& shapes = samples[p].shapes;
+      if (profile.min.empty()) {
+        profile.min = shapes;
+        profile.max = shapes;
+      }
+      for (size_t i = 0; i < shapes.size(); i++) {
+        for (size_t d = 0; d < shapes[i].size(); d++) {
+          profile.min[i][d] = std::min(profile.min[i][d], shapes[i][d]);
+          profile.max[i][d] = std::max(profile.max[i][d], shapes[i][d]);
+        }
+      }
+      if (samples[p].count > opt_count) {
+        opt_count = samples[p].count;
+        profile.opt = shapes;
+      }
+    }
+    // Clusters can end up empty when shapes repeat across seeds
+    if (!profile.min.empty()) {
+      profiles.push_back(std::move(profile));
+    }
+  }
+  std::sort(profiles.begin(), profiles.end(), [](const auto& a, const auto& b) {
+    return max_volume(a) < max_volume(b);
+  });
+  return profiles;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
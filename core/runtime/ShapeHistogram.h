@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ATen/core/Dict.h"
+#include "core/runtime/ShapeKey.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Input shapes of an execution and how many executions had them
+struct InputShapeSample {
+  std::vector<std::vector<int64_t>> shapes;
+  int64_t count = 0;
+};
+
+// Counts of the input shapes an engine is executed with, recorded while RECORD_INPUT_SHAPES is set
+class InputShapeHistogram {
+ public:
+  void record(const ShapeKey& key);
+  void reset();
+  std::vector<InputShapeSample> samples() const;
+  // Keyed by the string form of the shape key, e.g. (8,128)(8,128)
+  c10::Dict<std::string, int64_t> to_dict() const;
+
+ private:
+  mutable std::mutex mu;
+  // Keyed by ShapeKey::encoded, shape tensor values and placements are not recorded
+  std::map<std::vector<int64_t>, int64_t> counts;
+};
+
+// Shape range of each input in one optimization profile
+struct InputShapeProfile {
+  std::vector<std::vector<int64_t>> min;
+  std::vector<std::vector<int64_t>> opt;
+  std::vector<std::vector<int64_t>> max;
+};
+
+// Groups the samples into at most num_profiles optimization profiles with a k-means over the sizes of the inputs,
+// weighted by the counts. Each profile spans the shapes of its cluster and is optimized for the most frequent of them,
+// since TensorRT tunes its kernels for opt. Profiles are ordered by the volume of their max shapes. All samples need
+// the same number of inputs and ranks
+std::vector<InputShapeProfile> derive_shape_profiles(
+    const std::vector<InputShapeSample>& samples,
+    int64_t num_profiles);
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,93 @@
+#include <sstream>
+
+#include "core/runtime/ShapeKey.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+namespace {
+// 64 bit FNV-1a
+constexpr uint64_t kFNVOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t kFNVPrime = 1099511628211ULL;
+
+inline uint64_t fnv1a(uint64_t hash, int64_t value) {
+  auto v = static_cast<uint64_t>(value);
+  for (int i = 0; i < 8; i++) {
+    hash ^= (v >> (i * 8)) & 0xFF;
+    hash *= kFNVPrime;
+  }
+  return hash;
+}
+
+inline int64_t placement(const at::Tensor& input) {
+  auto device = input.device();
+  return (static_cast<int64_t>(input.scalar_type()) << 32) | (static_cast<int64_t>(device.type()) << 16) |
+      static_cast<int64_t>(static_cast<uint16_t>(device.index()));
+}
+} // namespace
+
+ShapeKey::ShapeKey(const std::vector<at::Tensor>& inputs) : valid(true), hash(kFNVOffsetBasis) {
+  for (const auto& input : inputs) {
+    auto sizes = input.sizes();
+    encoded.push_back(static_cast<int64_t>(sizes.size()));
+    hash = fnv1a(hash, static_cast<int64_t>(sizes.size()));
+    for (auto s : sizes) {
+      encoded.push_back(s);
+      hash = fnv1a(hash, s);
+    }
+    placements.push_back(placement(input));
+    hash = fnv1a(hash, placements.back());
+  }
+}
+
+void ShapeKey::append_values(const int64_t* data, int64_t n) {
+  values.push_back(n);
+  hash = fnv1a(hash, n);
+  for (int64_t i = 0; i < n; i++) {
+    values.push_back(data[i]);
+    hash = fnv1a(hash, data[i]);
+  }
+}
+
+std::string ShapeKey::str() const {
+  if (!valid) {
+    return "None";
+  }
+  std::stringstream ss;
+  size_t i = 0;
+  while (i < encoded.size()) {
+    auto rank = encoded[i++];
+    ss << "(";
+    for (int64_t d = 0; d < rank; d++) {
+      ss << encoded[i++];
+      // For all but the final dimension in the shape key, add comma separator
+      if (d < rank - 1) {
+        ss << ",";
+      }
+    }
+    ss << ")";
+  }
+  i = 0;
+  while (i < values.size()) {
+    auto n = values[i++];
+    ss << "[";
+    for (int64_t v = 0; v < n; v++) {
+      ss << values[i++];
+      if (v < n - 1) {
+        ss << ",";
+      }
+    }
+    ss << "]";
+  }
+  return ss.str();
+}
+
+std::ostream& operator<<(std::ostream& os, const ShapeKey& key) {
+  os << key.str();
+  return os;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ATen/core/Tensor.h"
+#include "c10/util/SmallVector.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Compact key identifying the input shapes of an execution. The ranks and sizes of all inputs are stored inline
+// (rank followed by sizes, for each input) so building and comparing a key on the hot path does not allocate for
+// typical engines, and the hash is computed once up front for map lookups. The dtype and device of the inputs are part
+// of the key too, so inputs which passed validation do not need to be validated again while the key is unchanged.
+struct ShapeKey {
+  ShapeKey() = default;
+  explicit ShapeKey(const std::vector<at::Tensor>& inputs);
+
+  // Appends the values of a shape tensor input to the key, engines with shape tensor inputs can produce different
+  // output shapes for the same input shapes so the values have to take part in the comparison
+  void append_values(const int64_t* data, int64_t n);
+
+  bool operator==(const ShapeKey& other) const {
+    return valid == other.valid && hash == other.hash && encoded == other.encoded && placements == other.placements &&
+        values == other.values;
+  }
+  bool operator!=(const ShapeKey& other) const {
+    return !(*this == other);
+  }
+
+  // Human readable form of the key, x: (3, 4), y: (4, 5) --> (3,4)(4,5), shape tensor values follow as [2,8]
+  std::string str() const;
+
+  // An invalid key never compares equal to a key built from inputs, used to force shape re-evaluation
+  bool valid = false;
+  uint64_t hash = 0;
+  c10::SmallVector<int64_t, 32> encoded;
+  // Scalar type, device type and device index of each input, packed in one value. Not part of the string form
+  c10::SmallVector<int64_t, 8> placements;
+  // Length followed by values, for each shape tensor input
+  c10::SmallVector<int64_t, 8> values;
+};
+
+std::ostream& operator<<(std::ostream& os, const ShapeKey& key);
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
+
+namespace std {
+template <>
+struct hash<torch_tensorrt::core::runtime::ShapeKey> {
+  size_t operator()(const torch_tensorrt::core::runtime::ShapeKey& key) const {
+    return static_cast<size_t>(key.hash);
+  }
+};
+} // namespace std
@@ -0,0 +1,171 @@
+#include "ATen/ATen.h"
+#include "c10/cuda/CUDAGuard.h"
+
+#include "core/runtime/StateBindings.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+StateBindings::StateBindings(
+    std::vector<State> states,
+    size_t num_inputs,
+    size_t num_outputs,
+    c10::DeviceIndex device)
+    : states(std::move(states)),
+      num_inputs(num_inputs),
+      input_state(num_inputs, -1),
+      output_state(num_outputs, -1),
+      device_index(device) {
+  for (size_t s = 0; s < this->states.size(); s++) {
+    input_state[this->states[s].input] = s;
+    output_state[this->states[s].output] = s;
+  }
+}
+
+std::unique_lock<std::mutex> StateBindings::lock() {
+  return std::unique_lock<std::mutex>(mu);
+}
+
+size_t StateBindings::size() const {
+  return states.size();
+}
+
+int64_t StateBindings::parity() const {
+  return current;
+}
+
+bool StateBindings::is_state_output(size_t pyt_idx) const {
+  return pyt_idx < output_state.size() && output_state[pyt_idx] >= 0;
+}
+
+bool StateBindings::is_state_buffer(size_t pyt_idx, const at::Tensor& t) const {
+  if (pyt_idx >= input_state.size() || input_state[pyt_idx] < 0) {
+    return false;
+  }
+  for (const auto& buffer : states[input_state[pyt_idx]].buffers) {
+    if (buffer.defined() && buffer.data_ptr() == t.data_ptr() && buffer.sizes() == t.sizes()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void StateBindings::wait(const c10::cuda::CUDAStream& stream) {
+  if (written.isCreated()) {
+    written.block(stream);
+  }
+}
+
+std::vector<at::Tensor> StateBindings::bind_inputs(std::vector<at::Tensor> inputs) {
+  TORCHTRT_CHECK(
+      inputs.size() + states.size() == num_inputs,
+      "Expected " << num_inputs - states.size() << " inputs for an engine with " << states.size()
+                  << " state bindings, got " << inputs.size() << ". State inputs are not passed");
+  wait(c10::cuda::getCurrentCUDAStream(device_index));
+  std::vector<at::Tensor> bound;
+  bound.reserve(num_inputs);
+  auto next = inputs.begin();
+  for (size_t i = 0; i < num_inputs; i++) {
+    if (input_state[i] < 0) {
+      bound.push_back(std::move(*next++));
+      continue;
+    }
+    auto& state = states[input_state[i]];
+    auto& buffer = state.buffers[current];
+    if (!buffer.defined()) {
+      for (auto d : state.shape) {
+        TORCHTRT_CHECK(
+            d >= 0,
+            "State input " << i << " has a dynamic shape, set its initial value with reset_state before the first "
+                           << "execution");
+      }
+      buffer = at::zeros(state.shape, at::TensorOptions().device(at::kCUDA, device_index).dtype(state.dtype));
+    }
+    bound.push_back(buffer);
+  }
+  return bound;
+}
+
+void StateBindings::bind_outputs(
+    std::vector<at::Tensor>& outputs,
+    const std::vector<std::vector<int64_t>>& output_shapes) {
+  for (auto& state : states) {
+    auto& buffer = state.buffers[current ^ 1];
+    const auto& shape = output_shapes[state.output];
+    if (!buffer.defined() || buffer.sizes() != c10::IntArrayRef(shape)) {
+      buffer = at::empty(shape, at::TensorOptions().device(at::kCUDA, device_index).dtype(state.dtype));
+    }
+    outputs[state.output] = buffer;
+  }
+}
+
+std::vector<at::Tensor> StateBindings::advance(std::vector<at::Tensor> outputs, const c10::cuda::CUDAStream& stream) {
+  // The next execution may run on another stream, and overwrites the buffers this one read
+  written.record(stream);
+  current ^= 1;
+  std::vector<at::Tensor> returned;
+  returned.reserve(outputs.size() - states.size());
+  for (size_t o = 0; o < outputs.size(); o++) {
+    if (output_state[o] < 0) {
+      returned.push_back(std::move(outputs[o]));
+    }
+  }
+  return returned;
+}
+
+void StateBindings::reset(const std::vector<at::Tensor>& initial) {
+  TORCHTRT_CHECK(
+      initial.empty() || initial.size() == states.size(),
+      "Expected " << states.size() << " initial states, got " << initial.size());
+  std::lock_guard<std::mutex> guard(mu);
+  c10::cuda::CUDAGuard device_guard(device_index);
+  auto stream = c10::cuda::getCurrentCUDAStream(device_index);
+  wait(stream);
+  for (size_t s = 0; s < states.size(); s++) {
+    auto& state = states[s];
+    auto& buffer = state.buffers[current];
+    if (initial.empty()) {
+      buffer = at::Tensor();
+      continue;
+    }
+    TORCHTRT_CHECK(
+        initial[s].scalar_type() == state.dtype && initial[s].dim() == static_cast<int64_t>(state.shape.size()),
+        "Expected initial state " << s << " to have dtype " << state.dtype << " and rank " << state.shape.size()
+                                  << ", found dtype " << initial[s].scalar_type() << " and rank " << initial[s].dim());
+    // Buffers keep their address when the shape is unchanged so captured CUDA graphs stay valid
+    if (!buffer.defined() || buffer.sizes() != initial[s].sizes()) {
+      buffer = at::empty(initial[s].sizes(), at::TensorOptions().device(at::kCUDA, device_index).dtype(state.dtype));
+    }
+    buffer.copy_(initial[s], true);
+  }
+  written.record(stream);
+}
+
+std::vector<at::Tensor> StateBindings::get() {
+  std::lock_guard<std::mutex> guard(mu);
+  c10::cuda::CUDAGuard device_guard(device_index);
+  wait(c10::cuda::getCurrentCUDAStream(device_index));
+  std::vector<at::Tensor> current_states;
+  for (auto& state : states) {
+    const auto& buffer = state.buffers[current];
+    current_states.push_back(buffer.defined() ? buffer.clone() : at::Tensor());
+  }
+  return current_states;
+}
+
+int64_t StateBindings::nbytes() {
+  std::lock_guard<std::mutex> guard(mu);
+  int64_t total = 0;
+  for (const auto& state : states) {
+    for (const auto& buffer : state.buffers) {
+      total += buffer.defined() ? static_cast<int64_t>(buffer.nbytes()) : 0;
+    }
+  }
+  return total;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
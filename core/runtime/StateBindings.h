@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "ATen/Tensor.h"
+#include "ATen/cuda/CUDAEvent.h"
+#include "c10/cuda/CUDAStream.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Output -> input pairs of an engine which carry state from one execution to the next, e.g. the hidden state of a
+// recurrent or streaming model. Each state has two device buffers executions alternate between, one bound as the input
+// of the state while the other is bound as its output, so the state never leaves the device, is never copied and
+// captured CUDA graphs read and write the buffers directly. Callers only pass and receive the other bindings
+class StateBindings {
+ public:
+  struct State {
+    size_t input; // PyTorch input index
+    size_t output; // PyTorch output index
+    at::ScalarType dtype;
+    std::vector<int64_t> shape; // Shape of the engine input, -1 for dynamic dimensions
+    std::array<at::Tensor, 2> buffers;
+  };
+
+  StateBindings(std::vector<State> states, size_t num_inputs, size_t num_outputs, c10::DeviceIndex device);
+
+  // Held for the whole execution, each one reads the state the previous one wrote
+  std::unique_lock<std::mutex> lock();
+  size_t size() const;
+  // Index of the buffer holding the current state of every state binding
+  int64_t parity() const;
+  bool is_state_output(size_t pyt_idx) const;
+  // Whether t is a buffer of the state bound to input pyt_idx
+  bool is_state_buffer(size_t pyt_idx, const at::Tensor& t) const;
+
+  // Inserts the current states into inputs, which hold every other input of the engine in order. Orders the current
+  // stream after the execution which wrote them. Expects the lock to be held
+  std::vector<at::Tensor> bind_inputs(std::vector<at::Tensor> inputs);
+  // Replaces the state outputs with the buffers the next execution reads, (re)allocated for the output shapes
+  void bind_outputs(std::vector<at::Tensor>& outputs, const std::vector<std::vector<int64_t>>& output_shapes);
+  // Makes the written buffers the current state once stream is done with the execution, returns the other outputs
+  std::vector<at::Tensor> advance(std::vector<at::Tensor> outputs, const c10::cuda::CUDAStream& stream);
+
+  // Sets the states to initial (one per state binding) or, if empty, to zeros on the next execution
+  void reset(const std::vector<at::Tensor>& initial);
+  // Copies of the current states, undefined for states which are not set yet
+  std::vector<at::Tensor> get();
+  // Bytes held by the state buffers
+  int64_t nbytes();
+
+ private:
+  void wait(const c10::cuda::CUDAStream& stream);
+
+  std::vector<State> states;
+  size_t num_inputs;
+  std::vector<int64_t> input_state; // State index of each input, -1: not a state
+  std::vector<int64_t> output_state; // State index of each output, -1: not a state
+  c10::DeviceIndex device_index;
+  int64_t current = 0;
+  at::cuda::CUDAEvent written;
+  std::mutex mu;
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
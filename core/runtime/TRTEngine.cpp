@@ -1,11 +1,21 @@
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <set>
 
 #include <cuda_runtime.h>
 #include "NvInfer.h"
+#include "c10/cuda/CUDAFunctions.h"
+#include "c10/cuda/CUDAGuard.h"
 #include "c10/cuda/CUDAStream.h"
 #include "torch/csrc/jit/frontend/function_schema_parser.h"
 #include "torch/cuda.h"
 
+#include "core/runtime/EngineCompression.h"
+#include "core/runtime/EngineOffloader.h"
+#include "core/runtime/WeightStreamingArbiter.h"
 #include "core/runtime/runtime.h"
 #include "core/util/prelude.h"
 #include "torch/torch.h"
@@ -31,7 +41,7 @@ std::vector<std::string> split(const std::string& str, char delim) {
 }
 
 TRTEngine::TRTEngine(
-    const std::string& serialized_engine,
+    const util::SerializedEngine& serialized_engine,
     const RTDevice& cuda_device,
     const std::vector<std::string>& _in_binding_names,
     const std::vector<std::string>& _out_binding_names,
@@ -48,26 +58,102 @@ TRTEngine::TRTEngine(
           hardware_compatible,
           serialized_metadata) {}
 
+namespace {
+// Decompresses the payload at ENGINE_IDX, then replaces the bundle (if any) with the variant to load on this machine
+// and returns the bundle
+std::string select_bundled_engine(std::vector<std::string>& serialized_info) {
+  if (is_compressed_engine(serialized_info[ENGINE_IDX])) {
+    serialized_info[ENGINE_IDX] = decompress_engine(serialized_info[ENGINE_IDX]);
+  }
+  if (!is_engine_bundle(serialized_info[ENGINE_IDX])) {
+    return "";
+  }
+  auto bundle = std::move(serialized_info[ENGINE_IDX]);
+  auto variants = deserialize_engine_bundle(bundle);
+  TORCHTRT_CHECK(!variants.empty(), "Engine bundle of engine " << serialized_info[NAME_IDX] << " is empty");
+  auto selected = select_engine_bundle_variant(variants);
+  if (!selected) {
+    std::stringstream built_for;
+    for (const auto& v : variants) {
+      built_for << std::endl << "    " << v.device << (v.hardware_compatible ? " (hardware compatible)" : "");
+    }
+    TORCHTRT_CHECK(
+        LOAD_INCOMPATIBLE_ENGINES,
+        "No device of this machine can run any of the engines bundled for engine "
+            << serialized_info[NAME_IDX] << ", built for:" << built_for.str() << std::endl
+            << "Available devices: " << get_available_device_list().dump_list());
+    selected = 0;
+  }
+  auto& variant = variants[selected.value()];
+  LOG_DEBUG("Loading the variant of engine bundle " << serialized_info[NAME_IDX] << " built for " << variant.device);
+  serialized_info[DEVICE_IDX] = variant.device.serialize();
+  serialized_info[HW_COMPATIBLE_IDX] = variant.hardware_compatible ? "1" : "0";
+  serialized_info[ENGINE_IDX] = std::move(variant.serialized_engine);
+  return bundle;
+}
+
+// Embedded payloads are compressed while ENGINE_COMPRESSION_LEVEL is set, uncompressed payloads are encoded straight
+// from data without an intermediate copy
+std::string encode_embedded_engine(const void* data, size_t size) {
+  if (ENGINE_COMPRESSION_LEVEL <= 0) {
+    return base64_encode(data, size);
+  }
+  return base64_encode(compress_engine(data, size, ENGINE_COMPRESSION_LEVEL));
+}
+
+bool is_weights_stripped_plan(const void* data, size_t size) {
+  return size >= WEIGHTS_STRIPPED_MAGIC.size() &&
+      std::memcmp(data, WEIGHTS_STRIPPED_MAGIC.data(), WEIGHTS_STRIPPED_MAGIC.size()) == 0;
+}
+
+// Offloaded plans are kept in page locked memory so their weights go back to the device at full bandwidth, plans which
+// do not fit in pinned memory stay where they are
+util::SerializedEngine copy_to_pinned_memory(util::SerializedEngine plan) {
+  try {
+    auto pinned = std::make_shared<at::Tensor>(at::empty(
+        {static_cast<int64_t>(plan.size())}, at::TensorOptions().dtype(at::kByte).pinned_memory(true)));
+    std::memcpy(pinned->data_ptr(), plan.data(), plan.size());
+    auto bytes = static_cast<const char*>(pinned->data_ptr());
+    return util::SerializedEngine(std::shared_ptr<const void>(std::move(pinned)), bytes, plan.size());
+  } catch (const c10::Error& e) {
+    LOG_DEBUG("Unable to copy a plan of " << plan.size() << "B to pinned memory: " << e.what_without_backtrace());
+    return plan;
+  }
+}
+} // namespace
+
+// serialized_info is bound by reference, so the delegated constructor reads it after the bundle has been resolved
 TRTEngine::TRTEngine(std::vector<std::string> serialized_info)
+    : TRTEngine(serialized_info, select_bundled_engine(serialized_info)) {}
+
+TRTEngine::TRTEngine(std::vector<std::string>& serialized_info, std::string engine_bundle)
     : TRTEngine(
           serialized_info[NAME_IDX],
-          serialized_info[ENGINE_IDX],
+          util::SerializedEngine(std::move(serialized_info[ENGINE_IDX])),
           RTDevice(serialized_info[DEVICE_IDX]),
           split(serialized_info[INPUT_BINDING_NAMES_IDX], BINDING_DELIM),
           split(serialized_info[OUTPUT_BINDING_NAMES_IDX], BINDING_DELIM),
           Platform(serialized_info[TARGET_PLATFORM_IDX]),
           static_cast<bool>(std::stoi(serialized_info[HW_COMPATIBLE_IDX])),
-          serialized_info[SERIALIZED_METADATA_IDX]) {}
+          serialized_info[SERIALIZED_METADATA_IDX],
+          LAZY_ENGINE_DESERIALIZATION) {
+  this->engine_bundle = std::move(engine_bundle);
+}
 
 TRTEngine::TRTEngine(
     const std::string& mod_name,
-    const std::string& serialized_engine,
+    const util::SerializedEngine& serialized_engine,
     const RTDevice& cuda_device,
     const std::vector<std::string>& _in_binding_names,
     const std::vector<std::string>& _out_binding_names,
     const Platform& target_platform,
     bool hardware_compatible,
-    const std::string& serialized_metadata) {
+    const std::string& serialized_metadata,
+    bool lazy_deserialization) {
+  lean_runtime_path = LEAN_RUNTIME_PATH;
+  engine_host_code_allowed = ENGINE_HOST_CODE_ALLOWED;
+  shape_sized_device_memory = SHAPE_SIZED_DEVICE_MEMORY;
+  idle_offload_ms = IDLE_OFFLOAD_MS;
   TORCHTRT_CHECK(
       is_supported_on_current_platform(target_platform),
       "This engine was not built to run on this platform (built for: " << target_platform << ", current platform: "
@@ -76,32 +162,140 @@ TRTEngine::TRTEngine(
 
   this->hardware_compatible = hardware_compatible;
   auto most_compatible_device = get_most_compatible_device(cuda_device, RTDevice(), hardware_compatible);
+  if (!most_compatible_device && LOAD_INCOMPATIBLE_ENGINES &&
+      (_in_binding_names.size() > 0 || _out_binding_names.size() > 0)) {
+    name = slugify(mod_name);
+    LOG_DEBUG("No device can run engine " << name << " built for " << cuda_device << ", it is kept serialized");
+    this->serialized_metadata = serialized_metadata;
+    device_info = cuda_device;
+    device_compatible = false;
+    pending_serialized_engine = serialized_engine;
+    in_binding_names = _in_binding_names;
+    out_binding_names = split_output_aliases(_out_binding_names, in_binding_names.size());
+    num_io = std::make_pair(in_binding_names.size(), out_binding_names.size());
+    return;
+  }
   TORCHTRT_CHECK(most_compatible_device, "No compatible device was found for instantiating TensorRT engine");
 
   this->serialized_metadata = serialized_metadata;
   device_info = most_compatible_device.value();
+  if (cuda_device.device_type == nvinfer1::DeviceType::kDLA) {
+    // The compatible device is the GPU of the SoC, the engine still runs on the DLA core it was built for
+    device_info.device_type = nvinfer1::DeviceType::kDLA;
+    device_info.dla_core = cuda_device.dla_core;
+  }
   multi_gpu_device_check();
+
+  name = slugify(mod_name);
+
+  // Binding names are needed to know the engine's I/O without deserializing it, engines which rely on binding name
+  // conventions are always loaded eagerly
+  if (lazy_deserialization && (_in_binding_names.size() > 0 || _out_binding_names.size() > 0)) {
+    pending_serialized_engine = serialized_engine;
+    in_binding_names = _in_binding_names;
+    out_binding_names = split_output_aliases(_out_binding_names, in_binding_names.size());
+    num_io = std::make_pair(in_binding_names.size(), out_binding_names.size());
+    LOG_DEBUG("Deferring deserialization of engine " << name << " until its first execution");
+    return;
+  }
+
+  load_engine(serialized_engine, _in_binding_names, _out_binding_names);
+}
+
+void TRTEngine::load_engine(
+    const util::SerializedEngine& serialized_engine,
+    const std::vector<std::string>& given_in_binding_names,
+    const std::vector<std::string>& given_out_binding_names,
+    std::shared_ptr<nvinfer1::IRuntime> runtime) {
+  TORCHTRT_NVTX_RANGE("torch_tensorrt::deserialize_engine");
   set_rt_device(device_info);
 
-  rt = make_trt(nvinfer1::createInferRuntime(util::logging::get_logger()));
+  // The mapping only needs to outlive deserialization
+  std::unique_ptr<MappedEngineFile> engine_file;
+  const void* blob = serialized_engine.data();
+  size_t blob_size = serialized_engine.size();
+  if (is_engine_file_reference(serialized_engine.view())) {
+    engine_file = std::make_unique<MappedEngineFile>(engine_file_path(serialized_engine.view()));
+    LOG_DEBUG("Deserializing engine " << name << " from " << engine_file_path(serialized_engine.view()));
+    blob = engine_file->data();
+    blob_size = engine_file->size();
+  }
 
-  name = slugify(mod_name);
+  // Engines built with aliased outputs carry the names of their inputs and returned outputs ahead of the plan, which
+  // are only used if no binding names are given (they are serialized with the engine)
+  auto _in_binding_names = given_in_binding_names;
+  auto returned_outputs = given_out_binding_names;
+  std::vector<std::string> plan_in_names, plan_out_names;
+  std::string_view plan;
+  if (util::SplitOutputAliases(
+          std::string_view(static_cast<const char*>(blob), blob_size), plan_in_names, plan_out_names, plan)) {
+    blob = plan.data();
+    blob_size = plan.size();
+    if (_in_binding_names.empty() && returned_outputs.empty()) {
+      _in_binding_names = std::move(plan_in_names);
+      returned_outputs = std::move(plan_out_names);
+    }
+  }
+  auto _out_binding_names = split_output_aliases(returned_outputs, _in_binding_names.size());
 
-  cuda_engine = make_trt(rt->deserializeCudaEngine(serialized_engine.c_str(), serialized_engine.size()));
-  TORCHTRT_CHECK((cuda_engine.get() != nullptr), "Unable to deserialize the TensorRT engine");
+  if (is_dla_loadable(blob, blob_size)) {
+    load_dla_loadable(serialized_engine, blob, blob_size, _in_binding_names, _out_binding_names);
+    return;
+  }
 
-  if (get_streamable_device_memory_budget() > 0) {
-    int64_t budget_bytes = get_automatic_device_memory_budget();
-    LOG_DEBUG("Weight streaming budget set to " << budget_bytes << "B");
-    cuda_engine->setWeightStreamingBudgetV2(budget_bytes);
+  bool stripped_plan = is_weights_stripped_plan(blob, blob_size);
+  if (stripped_plan) {
+    blob = static_cast<const char*>(blob) + WEIGHTS_STRIPPED_MAGIC.size();
+    blob_size -= WEIGHTS_STRIPPED_MAGIC.size();
   }
 
-  exec_ctx = make_trt(cuda_engine->createExecutionContext());
-  TORCHTRT_CHECK((exec_ctx.get() != nullptr), "Unable to create TensorRT execution context");
+  // The DLA core is a setting of the runtime, so DLA engines get a runtime of their own
+  bool on_dla_core = device_info.device_type == nvinfer1::DeviceType::kDLA && device_info.dla_core >= 0;
+  if (on_dla_core) {
+    rt = create_trt_runtime(util::logging::get_logger(), lean_runtime_path, engine_host_code_allowed);
+    TORCHTRT_CHECK(
+        device_info.dla_core < rt->getNbDLACores(),
+        "Engine " << name << " was built for DLA core " << device_info.dla_core << " but only " << rt->getNbDLACores()
+                  << " DLA cores are available");
+    rt->setDLACore(static_cast<int32_t>(device_info.dla_core));
+  } else if (runtime) {
+    rt = std::move(runtime);
+  } else if (SHARE_TRT_RUNTIME) {
+    rt = get_shared_trt_runtime(
+        device_info.id, util::logging::get_logger(), lean_runtime_path, engine_host_code_allowed);
+  } else {
+    rt = create_trt_runtime(util::logging::get_logger(), lean_runtime_path, engine_host_code_allowed);
+  }
 
-  runtime_states.old_cudagraphs = CUDAGRAPHS_MODE;
-  runtime_states.old_pre_allocated_outputs = false;
-  runtime_states.context_changed = false;
+  auto deserialize = [&]() -> std::shared_ptr<nvinfer1::ICudaEngine> {
+    auto engine = make_trt(rt->deserializeCudaEngine(blob, blob_size));
+    TORCHTRT_CHECK((engine.get() != nullptr), "Unable to deserialize the TensorRT engine");
+    // The streaming budget is a property of the ICudaEngine, engines shared through the registry keep the budget of
+    // the instance which deserialized them
+    if (engine->getStreamableWeightsSize() > 0) {
+      int64_t budget_bytes = engine->getWeightStreamingAutomaticBudget();
+      LOG_DEBUG("Weight streaming budget set to " << budget_bytes << "B");
+      engine->setWeightStreamingBudgetV2(budget_bytes);
+    }
+    // Keep the runtime which owns the engine alive for as long as any TRTEngine shares it
+    using EngineOwner = std::pair<std::shared_ptr<nvinfer1::IRuntime>, std::shared_ptr<nvinfer1::ICudaEngine>>;
+    auto owner = std::make_shared<EngineOwner>(rt, engine);
+    return std::shared_ptr<nvinfer1::ICudaEngine>(owner, engine.get());
+  };
+  // Plans built for different DLA cores can be identical, the engines deserialized for each core are not shared. Plans
+  // without weights are identical for any weights they are refit with
+  auto deserialize_start = std::chrono::steady_clock::now();
+  cuda_engine = DEDUPLICATE_ENGINES && !on_dla_core && !stripped_plan
+      ? get_shared_cuda_engine(device_info.id, blob, blob_size, deserialize)
+      : deserialize();
+  load_times.deserialize_ns = elapsed_ns(deserialize_start);
+  serialized_engine_size = static_cast<int64_t>(blob_size);
+  num_aux_streams = cuda_engine->getNbAuxStreams();
+  if (stripped_plan) {
+    weights_stripped = true;
+    weights_missing = true;
+    LOG_DEBUG("Engine " << name << " was saved without its weights, it runs once refit");
+  }
 
   if (_in_binding_names.size() == 0 && _out_binding_names.size() == 0) {
     uint64_t inputs = 0;
@@ -135,9 +329,7 @@ TRTEngine::TRTEngine(
 
     num_io = std::make_pair(inputs, outputs);
     in_binding_names.resize(inputs);
-    input_buffers.resize(inputs);
     out_binding_names.resize(outputs);
-    output_buffers.resize(outputs);
     for (int64_t x = 0; x < cuda_engine->getNbIOTensors(); x++) {
       std::string bind_name = cuda_engine->getIOTensorName(x);
       if (cuda_engine->getTensorIOMode(bind_name.c_str()) == nvinfer1::TensorIOMode::kINPUT) {
@@ -149,7 +341,6 @@ TRTEngine::TRTEngine(
   } else {
     uint64_t inputs_size = _in_binding_names.size();
     in_binding_names.resize(inputs_size);
-    input_buffers.resize(inputs_size);
     for (uint64_t pyt_idx = 0; pyt_idx < inputs_size; pyt_idx++) {
       auto binding_name = _in_binding_names[pyt_idx];
       // Check if the binding name provided is in the list of engine's bindings
@@ -179,7 +370,6 @@ TRTEngine::TRTEngine(
 
     uint64_t outputs = _out_binding_names.size();
     out_binding_names.resize(outputs);
-    output_buffers.resize(outputs);
     for (size_t pyt_idx = 0; pyt_idx < outputs; pyt_idx++) {
       auto binding_name = _out_binding_names[pyt_idx];
       // Check if the binding name provided is in the list of engine's bindings
@@ -211,201 +401,2137 @@ TRTEngine::TRTEngine(
     num_io = std::make_pair(inputs_size, outputs);
   }
 
+  build_binding_table();
+
+  // The primary slot is always created eagerly, additional slots are added through set_execution_context_pool_size
+  auto create_context_start = std::chrono::steady_clock::now();
+  exec_slots.push_back(make_execution_slot());
+  load_times.create_context_ns = elapsed_ns(create_context_start);
+  detect_data_dependent_outputs();
+
 #ifndef NDEBUG
   this->enable_profiling();
 #endif
+  last_execution_ns = steady_now_ns();
+  engine_loaded.store(true, std::memory_order_release);
+  get_memory_reclaimer().register_engine(this);
+  if (WEIGHT_STREAMING_ARBITER && !(DEDUPLICATE_ENGINES && !on_dla_core)) {
+    get_weight_streaming_arbiter().register_engine(this);
+  }
+  if (idle_offload_ms > 0) {
+    get_engine_offloader().register_engine(this);
+  }
   LOG_DEBUG(*this);
 }
 
-TRTEngine::~TRTEngine() {
-  trt_engine_profiler.reset();
-  exec_ctx.reset();
-  cuda_engine.reset();
-  rt.reset();
+void TRTEngine::load_dla_loadable(
+    const util::SerializedEngine& serialized_engine,
+    const void* blob,
+    size_t blob_size,
+    const std::vector<std::string>& _in_binding_names,
+    const std::vector<std::string>& _out_binding_names) {
+  TORCHTRT_CHECK(
+      device_info.device_type == nvinfer1::DeviceType::kDLA && device_info.dla_core >= 0,
+      "Engine " << name << " is a DLA loadable but was not placed on a DLA core (" << device_info << ")");
+  dla_loadable = std::make_shared<CudlaLoadable>(
+      static_cast<const char*>(blob) + DLA_LOADABLE_MAGIC.size(),
+      blob_size - DLA_LOADABLE_MAGIC.size(),
+      device_info.dla_core,
+      device_info.id);
+  serialized_engine_size = static_cast<int64_t>(blob_size);
+  // There is no plan to serialize again, the loadable is saved as it was loaded
+  pending_serialized_engine = serialized_engine;
+
+  // Torch index -> index of the tensor in the loadable, by name or following the binding name conventions
+  auto map_bindings = [&](const std::vector<CudlaTensorDesc>& descs, const std::vector<std::string>& names) {
+    std::vector<size_t> order(names.empty() ? descs.size() : names.size(), descs.size());
+    for (size_t i = 0; i < descs.size(); i++) {
+      size_t pyt_idx = i;
+      if (!names.empty()) {
+        pyt_idx = std::find(names.begin(), names.end(), descs[i].name) - names.begin();
+      } else {
+        auto delim = descs[i].name.find_last_of("._");
+        TORCHTRT_CHECK(
+            delim != std::string::npos,
+            "Unable to determine the binding index of tensor " << descs[i].name << " of DLA loadable " << name);
+        pyt_idx = std::stoul(descs[i].name.substr(delim + 1));
+      }
+      TORCHTRT_CHECK(
+          pyt_idx < order.size(), "Tensor " << descs[i].name << " of DLA loadable " << name << " has no binding");
+      order[pyt_idx] = i;
+    }
+    for (size_t pyt_idx = 0; pyt_idx < order.size(); pyt_idx++) {
+      TORCHTRT_CHECK(
+          order[pyt_idx] < descs.size(),
+          "DLA loadable " << name << " has no tensor for binding " << (names.empty() ? "" : names[pyt_idx]) << " ("
+                          << pyt_idx << ")");
+    }
+    return order;
+  };
+  dla_input_order = map_bindings(dla_loadable->inputs(), _in_binding_names);
+  dla_output_order = map_bindings(dla_loadable->outputs(), _out_binding_names);
+
+  // Loadables have static shapes, the binding table only describes them for warmup and introspection
+  binding_table = TRTBindingTable();
+  in_binding_names.clear();
+  out_binding_names.clear();
+  std::vector<nvinfer1::Dims> shapes;
+  for (auto i : dla_input_order) {
+    in_binding_names.push_back(dla_loadable->inputs()[i].name);
+  }
+  for (auto o : dla_output_order) {
+    out_binding_names.push_back(dla_loadable->outputs()[o].name);
+  }
+  for (size_t pyt_idx = 0; pyt_idx < dla_input_order.size(); pyt_idx++) {
+    const auto& desc = dla_loadable->inputs()[dla_input_order[pyt_idx]];
+    binding_table.input_names.push_back(in_binding_names[pyt_idx].c_str());
+    binding_table.input_types.push_back(desc.dtype);
+    binding_table.input_is_shape_tensor.push_back(false);
+    binding_table.input_ranks.push_back(static_cast<int32_t>(desc.shape.size()));
+    shapes.push_back(util::toDims(c10::IntArrayRef(desc.shape)));
+  }
+  for (size_t pyt_idx = 0; pyt_idx < dla_output_order.size(); pyt_idx++) {
+    const auto& desc = dla_loadable->outputs()[dla_output_order[pyt_idx]];
+    binding_table.output_names.push_back(out_binding_names[pyt_idx].c_str());
+    binding_table.output_types.push_back(desc.dtype);
+    binding_table.output_ranks.push_back(static_cast<int32_t>(desc.shape.size()));
+  }
+  num_io = std::make_pair(in_binding_names.size(), out_binding_names.size());
+  num_optimization_profiles = 1;
+  binding_table.profile_min.push_back(shapes);
+  binding_table.profile_opt.push_back(shapes);
+  binding_table.profile_max.push_back(shapes);
+
+  engine_loaded.store(true, std::memory_order_release);
+  LOG_DEBUG(*this);
 }
 
-void TRTEngine::disable_profiling() {
-  torch::cuda::synchronize(device_info.id);
-  profile_execution = false;
-  trt_engine_profiler.reset();
-  exec_ctx = make_trt(cuda_engine->createExecutionContext());
-  TORCHTRT_CHECK((exec_ctx.get() != nullptr), "Unable to recreate TensorRT execution context");
+std::vector<at::Tensor> TRTEngine::run_dla_loadable(
+    const std::vector<at::Tensor>& inputs,
+    const std::vector<at::Tensor>* caller_outputs) {
+  TORCHTRT_CHECK(
+      inputs.size() == num_io.first,
+      "Engine " << name << " takes " << num_io.first << " inputs, got " << inputs.size());
+  ScopedLatency execute_timer(metrics.execute_latency);
+  increment(metrics.executions);
+  std::vector<at::Tensor> loadable_inputs(inputs.size());
+  for (size_t pyt_idx = 0; pyt_idx < inputs.size(); pyt_idx++) {
+    loadable_inputs[dla_input_order[pyt_idx]] = inputs[pyt_idx];
+  }
+  std::vector<at::Tensor> loadable_outputs;
+  if (caller_outputs) {
+    loadable_outputs.resize(caller_outputs->size());
+    for (size_t pyt_idx = 0; pyt_idx < caller_outputs->size(); pyt_idx++) {
+      loadable_outputs[dla_output_order[pyt_idx]] = (*caller_outputs)[pyt_idx];
+    }
+  }
+  auto results = dla_loadable->run(loadable_inputs, caller_outputs ? &loadable_outputs : nullptr);
+  std::vector<at::Tensor> outputs;
+  for (auto o : dla_output_order) {
+    outputs.push_back(std::move(results[o]));
+  }
+  return outputs;
 }
 
-void TRTEngine::dump_engine_layer_info_to_file(const std::string& path) {
-  auto inspector = make_trt(cuda_engine->createEngineInspector());
-  std::ofstream f(path);
-  f << std::string(inspector->getEngineInformation(nvinfer1::LayerInformationFormat::kJSON));
-  f.close();
-  return;
+void TRTEngine::detect_data_dependent_outputs() {
+  // With every input shape set, the only output dimensions which are still unknown are the data dependent ones. The
+  // values of shape tensor inputs are not known ahead of execution, so those engines are only checked at execution
+  // time. The primary slot sets its own shapes again on first use
+  if (has_shape_tensor_inputs) {
+    return;
+  }
+  auto& ctx = exec_slots[0]->exec_ctx;
+  for (size_t i = 0; i < binding_table.input_names.size(); i++) {
+    ctx->setInputShape(binding_table.input_names[i], binding_table.profile_opt[0][i]);
+  }
+  for (size_t i = 0; i < binding_table.output_names.size(); i++) {
+    auto shape = ctx->getTensorShape(binding_table.output_names[i]);
+    for (int32_t d = 0; d < shape.nbDims; d++) {
+      if (shape.d[d] < 0) {
+        LOG_DEBUG("Output " << binding_table.output_names[i] << " of engine " << name << " is data dependent");
+        has_data_dependent_outputs = true;
+      }
+    }
+  }
 }
 
-void TRTEngine::dump_engine_layer_info() {
-  std::string layer_info_file =
-      std::filesystem::path{profile_path_prefix + "/" + name + "_layer_information.json"}.string();
-  dump_engine_layer_info_to_file(layer_info_file);
-  return;
+void TRTEngine::ensure_engine_loaded(std::shared_ptr<nvinfer1::IRuntime> runtime) {
+  // Sequentially consistent with the in flight count of executions, which offload reads after unloading the engine
+  if (engine_loaded.load()) {
+    return;
+  }
+  TORCHTRT_CHECK(
+      device_compatible,
+      "Engine " << name << " was loaded without a device able to run it (built for " << device_info
+                << "), it can only be saved or bundled");
+  std::lock_guard<std::mutex> lock(load_mu);
+  if (!engine_loaded.load(std::memory_order_relaxed)) {
+    // The binding names are rebuilt while loading, load from copies
+    auto in_names = in_binding_names;
+    auto out_names = returned_output_names();
+    load_engine(pending_serialized_engine, in_names, out_names, std::move(runtime));
+    if (!dla_loadable) {
+      pending_serialized_engine = util::SerializedEngine();
+    }
+    if (offloaded) {
+      offloaded = false;
+      if (offloaded_pool_size > 1) {
+        set_execution_context_pool_size(offloaded_pool_size);
+      }
+      increment(metrics.reloads);
+      LOG_DEBUG(
+          "Reloaded offloaded engine " << name << " in " << (load_times.deserialize_ns + load_times.create_context_ns)
+                                       << "ns");
+    }
+  }
 }
 
-void TRTEngine::enable_profiling() {
-  profile_execution = true;
-  trt_engine_profiler = std::make_unique<TRTEngineProfiler>(name);
-  exec_ctx->setProfiler(trt_engine_profiler.get());
+void TRTEngine::ensure_tensorrt_engine(const char* feature) {
+  ensure_engine_loaded();
+  TORCHTRT_CHECK(
+      !dla_loadable, feature << " is not supported by engine " << name << ", a DLA loadable executed through cuDLA");
 }
 
-std::string TRTEngine::get_engine_layer_info() {
-  auto inspector = cuda_engine->createEngineInspector();
-  return inspector->getEngineInformation(nvinfer1::LayerInformationFormat::kJSON);
+std::string TRTEngine::get_lean_runtime_path() {
+  return lean_runtime_path;
 }
 
-std::vector<at::Tensor> TRTEngine::infer_outputs(std::vector<std::vector<int64_t>> input_shapes) {
-  std::vector<at::Tensor> outputs;
+void TRTEngine::set_lean_runtime_path(std::string path) {
   TORCHTRT_CHECK(
-      (in_binding_names.size() == input_shapes.size()),
-      "The number of input shapes provided doesn't match with the number of input names registered.");
-  // Set all input shapes
-  for (size_t i = 0; i < input_shapes.size(); i++) {
-    exec_ctx->setInputShape(in_binding_names[i].c_str(), core::util::toDims(input_shapes[i]));
+      !is_engine_loaded(),
+      "The runtime of engine " << name << " can only be changed before it is deserialized, load it lazily");
+  lean_runtime_path = std::move(path);
+}
+
+bool TRTEngine::get_engine_host_code_allowed() {
+  return engine_host_code_allowed;
+}
+
+void TRTEngine::set_engine_host_code_allowed(bool allowed) {
+  TORCHTRT_CHECK(
+      !is_engine_loaded(),
+      "The runtime of engine " << name << " can only be changed before it is deserialized, load it lazily");
+  engine_host_code_allowed = allowed;
+}
+
+void TRTEngine::warmup(int64_t iterations) {
+  ensure_engine_loaded();
+  if (iterations <= 0) {
+    return;
   }
-  for (size_t i = 0; i < out_binding_names.size(); i++) {
-    auto output_shape = core::util::toVec(exec_ctx->getTensorShape(out_binding_names[i].c_str()));
-    auto output_dtype =
-        core::util::TRTDataTypeToScalarType(cuda_engine->getTensorDataType(out_binding_names[i].c_str()));
-    auto output_tensor = torch::empty(output_shape, torch::dtype(output_dtype));
-    outputs.push_back(output_tensor);
+  if (has_shape_tensor_inputs) {
+    LOG_WARNING("Engine " << name << " has shape tensor inputs, it is loaded but not run during warmup");
+    return;
+  }
+  if (state_bindings) {
+    // Warmup executions would advance the state
+    LOG_WARNING("Engine " << name << " has state bindings, it is loaded but not run during warmup");
+    return;
+  }
+
+  auto self = c10::intrusive_ptr<TRTEngine>::unsafe_reclaim_from_nonowning(this);
+  c10::cuda::CUDAGuard device_guard(device_info.id);
+  std::set<std::vector<std::vector<int64_t>>> warmed_up;
+  for (int32_t p = 0; p < num_optimization_profiles; p++) {
+    for (const auto* profile_shapes : {&binding_table.profile_opt[p], &binding_table.profile_min[p],
+                                       &binding_table.profile_max[p]}) {
+      std::vector<std::vector<int64_t>> shapes;
+      for (const auto& dims : *profile_shapes) {
+        shapes.push_back(util::toVec(dims));
+      }
+      // Static engines and profiles sharing shapes would run the same shapes several times
+      if (!warmed_up.insert(shapes).second) {
+        continue;
+      }
+      auto options = at::TensorOptions().device(at::Device(at::kCUDA, device_info.id));
+      std::vector<at::Tensor> inputs;
+      for (size_t i = 0; i < shapes.size(); i++) {
+        inputs.push_back(at::zeros(shapes[i], options.dtype(binding_table.input_types[i])));
+      }
+      LOG_DEBUG("Warming up engine " << name << " with the input shapes of optimization profile " << p);
+      for (int64_t i = 0; i < iterations; i++) {
+        execute_engine(inputs, self);
+      }
+    }
+  }
+  c10::cuda::getCurrentCUDAStream(device_info.id).synchronize();
+  metrics.reset();
+
+  for (auto& replica : replicas) {
+    replica->warmup(iterations);
   }
-  TORCHTRT_CHECK(
-      (out_binding_names.size() == outputs.size()),
-      "The number of output shapes inferred doesn't match with the number of output names registered.");
-  return outputs;
 }
 
-void TRTEngine::set_profiling_paths() {
-  device_profile_path =
-      std::filesystem::path{profile_path_prefix + "/" + name + "_device_config_profile.trace"}.string();
-  input_profile_path = std::filesystem::path{profile_path_prefix + "/" + name + "_input_profile.trace"}.string();
-  output_profile_path = std::filesystem::path{profile_path_prefix + "/" + name + "_output_profile.trace"}.string();
-  enqueue_profile_path = std::filesystem::path{profile_path_prefix + "/" + name + "_enqueue_profile.trace"}.string();
-  trt_engine_profile_path =
-      std::filesystem::path{profile_path_prefix + "/" + name + "_engine_exectuion_profile.trace"}.string();
-  cuda_graph_debug_path = std::filesystem::path{profile_path_prefix + "/" + name + "_cudagraph.dot"}.string();
+bool TRTEngine::is_engine_loaded() const {
+  return engine_loaded.load(std::memory_order_acquire);
 }
 
-int64_t TRTEngine::get_device_memory_budget() {
-  return cuda_engine->getWeightStreamingBudgetV2();
+TRTEngine::~TRTEngine() {
+  get_engine_offloader().unregister_engine(this);
+  get_memory_reclaimer().unregister_engine(this);
+  bool arbitrated = weight_streaming_arbitrated && get_weight_streaming_arbiter().unregister_engine(this);
+  trt_engine_profiler.reset();
+  exec_slots.clear();
+  cuda_engine.reset();
+  rt.reset();
+  if (arbitrated) {
+    // The weights of this engine are released, hand them to the others
+    get_weight_streaming_arbiter().rebalance(device_info.id);
+  }
 }
 
-bool TRTEngine::set_device_memory_budget(int64_t budget) {
-  // Recreating the context because weight streaming budget cannot be modified while there are active context.
-  if (exec_ctx.get() != nullptr) {
-    exec_ctx.reset();
+void TRTEngine::build_binding_table() {
+  std::unordered_map<uint64_t, uint64_t> in_pyt_to_trt, out_pyt_to_trt;
+  for (auto& m : in_binding_map) {
+    in_pyt_to_trt[m.second] = m.first;
   }
-  if (profile_execution) {
-    trt_engine_profiler.reset();
+  for (auto& m : out_binding_map) {
+    out_pyt_to_trt[m.second] = m.first;
   }
-  bool result = cuda_engine->setWeightStreamingBudgetV2(budget);
-  exec_ctx = make_trt(cuda_engine->createExecutionContext());
-  TORCHTRT_CHECK(
-      (exec_ctx.get() != nullptr),
-      "Unable to recreate TensorRT execution context after setting new device memory budget");
-  if (profile_execution) {
-    enable_profiling();
+
+  binding_table = TRTBindingTable();
+  has_shape_tensor_inputs = false;
+  for (size_t pyt_idx = 0; pyt_idx < in_binding_names.size(); pyt_idx++) {
+    const char* name = in_binding_names[pyt_idx].c_str();
+    bool is_shape_tensor = cuda_engine->isShapeInferenceIO(name);
+    has_shape_tensor_inputs |= is_shape_tensor;
+    binding_table.input_names.push_back(name);
+    binding_table.input_types.push_back(util::TRTDataTypeToScalarType(cuda_engine->getTensorDataType(name)));
+    binding_table.input_is_shape_tensor.push_back(is_shape_tensor);
+    binding_table.input_ranks.push_back(cuda_engine->getTensorShape(name).nbDims);
+    binding_table.input_trt_indices.push_back(static_cast<int32_t>(in_pyt_to_trt.at(pyt_idx)));
+    binding_table.input_formats.push_back(
+        is_shape_tensor ? BindingFormat() : get_binding_format(*cuda_engine, name));
+  }
+  for (size_t pyt_idx = 0; pyt_idx < out_binding_names.size(); pyt_idx++) {
+    const char* name = out_binding_names[pyt_idx].c_str();
+    binding_table.output_names.push_back(name);
+    binding_table.output_types.push_back(util::TRTDataTypeToScalarType(cuda_engine->getTensorDataType(name)));
+    binding_table.output_ranks.push_back(cuda_engine->getTensorShape(name).nbDims);
+    binding_table.output_trt_indices.push_back(static_cast<int32_t>(out_pyt_to_trt.at(pyt_idx)));
+    binding_table.output_formats.push_back(get_binding_format(*cuda_engine, name));
   }
-  // Indicates to reevaluate the runtime settings
-  runtime_states.context_changed = true;
 
-  return result;
+  num_optimization_profiles = cuda_engine->getNbOptimizationProfiles();
+  for (int32_t p = 0; p < num_optimization_profiles; p++) {
+    std::vector<nvinfer1::Dims> min, opt, max;
+    for (size_t pyt_idx = 0; pyt_idx < in_binding_names.size(); pyt_idx++) {
+      const char* name = binding_table.input_names[pyt_idx];
+      if (binding_table.input_is_shape_tensor[pyt_idx]) {
+        min.emplace_back();
+        opt.emplace_back();
+        max.emplace_back();
+        continue;
+      }
+      min.push_back(cuda_engine->getProfileShape(name, p, nvinfer1::OptProfileSelector::kMIN));
+      opt.push_back(cuda_engine->getProfileShape(name, p, nvinfer1::OptProfileSelector::kOPT));
+      max.push_back(cuda_engine->getProfileShape(name, p, nvinfer1::OptProfileSelector::kMAX));
+    }
+    binding_table.profile_min.push_back(std::move(min));
+    binding_table.profile_opt.push_back(std::move(opt));
+    binding_table.profile_max.push_back(std::move(max));
+  }
 }
 
-// Returns 0 if BuilderFlag::kWEIGHT_STREAMING is unset during engine building.
-int64_t TRTEngine::get_streamable_device_memory_budget() {
-  return cuda_engine->getStreamableWeightsSize();
+int32_t TRTEngine::select_optimization_profile(const std::vector<c10::IntArrayRef>& input_shapes) const {
+  int32_t best = 0;
+  int64_t best_distance = -1;
+  for (int32_t p = 0; p < num_optimization_profiles; p++) {
+    bool fits = true;
+    int64_t distance = 0;
+    for (size_t i = 0; i < input_shapes.size() && fits; i++) {
+      if (binding_table.input_is_shape_tensor[i]) {
+        continue;
+      }
+      const auto& min = binding_table.profile_min[p][i];
+      const auto& opt = binding_table.profile_opt[p][i];
+      const auto& max = binding_table.profile_max[p][i];
+      if (static_cast<int64_t>(input_shapes[i].size()) != min.nbDims) {
+        fits = false;
+        break;
+      }
+      for (int32_t d = 0; d < min.nbDims; d++) {
+        auto dim = input_shapes[i][d];
+        if (dim < min.d[d] || dim > max.d[d]) {
+          fits = false;
+          break;
+        }
+        distance += std::abs(dim - opt.d[d]);
+      }
+    }
+    if (fits && (best_distance < 0 || distance < best_distance)) {
+      best = p;
+      best_distance = distance;
+    }
+  }
+  return best;
 }
 
-int64_t TRTEngine::get_automatic_device_memory_budget() {
-  return cuda_engine->getWeightStreamingAutomaticBudget();
+std::vector<int64_t> TRTEngine::get_batch_buckets() {
+  return batch_buckets;
 }
 
-std::string TRTEngine::to_str() const {
-  // clang-format off
-  std::stringstream ss;
-  ss << "Torch-TensorRT TensorRT Engine:" << std::endl;
-  ss << "  Name: " << name << std::endl;
-  ss << "  Inputs: [" << std::endl;
-  for (uint64_t i = 0; i < num_io.first; i++) {
-    ss << "    id: " << i << std::endl;
-    ss << "      name: " << in_binding_names[i].c_str() << std::endl;
-    ss << "      shape: " << exec_ctx->getTensorShape(in_binding_names[i].c_str()) << std::endl;
-    ss << "      dtype: "
-       << util::TRTDataTypeToScalarType(exec_ctx->getEngine().getTensorDataType(in_binding_names[i].c_str()))
-       << std::endl;
+void TRTEngine::set_batch_buckets(std::vector<int64_t> buckets) {
+  std::sort(buckets.begin(), buckets.end());
+  buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+  for (auto bucket : buckets) {
+    TORCHTRT_CHECK(bucket >= 1, "Batch buckets must be at least 1, got " << bucket);
+    // Lazily deserialized engines are checked when the bucket is first run instead
+    if (!is_engine_loaded()) {
+      continue;
+    }
+    for (size_t i = 0; i < binding_table.profile_min[0].size(); i++) {
+      if (binding_table.input_is_shape_tensor[i] || binding_table.profile_min[0][i].nbDims == 0) {
+        continue;
+      }
+      bool fits = false;
+      for (int32_t p = 0; p < num_optimization_profiles && !fits; p++) {
+        fits = binding_table.profile_min[p][i].d[0] <= bucket && bucket <= binding_table.profile_max[p][i].d[0];
+      }
+      TORCHTRT_CHECK(
+          fits,
+          "Batch bucket " << bucket << " is outside of the batch range of input " << in_binding_names[i]
+                          << " of engine " << name << " in every optimization profile");
+    }
   }
-  ss << "  ]" << std::endl;
-  ss << "  Outputs: [" << std::endl;
-  for (uint64_t o = 0; o < num_io.second; o++) {
-    ss << "    id: " << o << std::endl;
-    ss << "      name: " << out_binding_names[o].c_str() << std::endl;
-    ss << "      shape: " << exec_ctx->getTensorShape(out_binding_names[o].c_str()) << std::endl;
-    ss << "      dtype: "
-       << util::TRTDataTypeToScalarType(
-              exec_ctx->getEngine().getTensorDataType(out_binding_names[o].c_str()))
-       << std::endl;
+  batch_buckets = std::move(buckets);
+  LOG_DEBUG("Batch buckets for engine " << name << " set to " << c10::IntArrayRef(batch_buckets));
+}
+
+int64_t TRTEngine::select_batch_bucket(int64_t batch) const {
+  auto it = std::lower_bound(batch_buckets.begin(), batch_buckets.end(), batch);
+  return it == batch_buckets.end() ? batch : *it;
+}
+
+namespace {
+int64_t max_profile_batch_size(const TRTBindingTable& bindings, int32_t num_profiles) {
+  int64_t max_batch = std::numeric_limits<int64_t>::max();
+  for (size_t i = 0; i < bindings.profile_max[0].size(); i++) {
+    if (bindings.input_is_shape_tensor[i] || bindings.profile_max[0][i].nbDims == 0) {
+      continue;
+    }
+    int64_t input_max = 0;
+    for (int32_t p = 0; p < num_profiles; p++) {
+      input_max = std::max(input_max, static_cast<int64_t>(bindings.profile_max[p][i].d[0]));
+    }
+    max_batch = std::min(max_batch, input_max);
   }
-  ss << "  ]" << std::endl;
-  ss << "  Device: " << device_info << std::endl;
-  ss << "  Hardware Compatibility: " << (hardware_compatible ? "Enabled" : "Disabled") << std::endl;
-  ss << "  Target Platform: " << target_platform << std::endl;
-  // clang-format on
-  return ss.str();
+  return max_batch == std::numeric_limits<int64_t>::max() ? 1 : max_batch;
 }
+} // namespace
 
-std::ostream& operator<<(std::ostream& os, const TRTEngine& engine) {
-  os << engine.to_str();
-  return os;
+int64_t TRTEngine::get_dynamic_batching_window_us() {
+  return dynamic_batcher ? dynamic_batcher->window_us.load() : 0;
 }
 
-TRTEngine& TRTEngine::operator=(const TRTEngine& other) {
-  rt = other.rt;
-  cuda_engine = other.cuda_engine;
-  device_info = other.device_info;
-  exec_ctx = other.exec_ctx;
-  num_io = other.num_io;
-  return (*this);
+void TRTEngine::set_dynamic_batching_window_us(int64_t window_us) {
+  TORCHTRT_CHECK(window_us >= 0, "Dynamic batching window must not be negative, got " << window_us);
+  if (window_us == 0) {
+    // Queued requests are still executed before the worker exits
+    dynamic_batcher.reset();
+  } else if (dynamic_batcher) {
+    dynamic_batcher->window_us = window_us;
+  } else {
+    ensure_engine_loaded();
+    auto max_batch_size = dynamic_batching_max_batch_size > 0
+        ? dynamic_batching_max_batch_size
+        : max_profile_batch_size(binding_table, num_optimization_profiles);
+    dynamic_batcher = std::make_shared<DynamicBatcher>(window_us, max_batch_size);
+  }
+  LOG_DEBUG("Dynamic batching window for engine " << name << " set to " << window_us << "us");
+}
+
+int64_t TRTEngine::get_dynamic_batching_max_batch_size() {
+  return dynamic_batching_max_batch_size;
+}
+
+void TRTEngine::set_dynamic_batching_max_batch_size(int64_t max_batch_size) {
+  TORCHTRT_CHECK(max_batch_size >= 0, "Dynamic batching max batch size must not be negative, got " << max_batch_size);
+  dynamic_batching_max_batch_size = max_batch_size;
+  if (dynamic_batcher) {
+    ensure_engine_loaded();
+    dynamic_batcher->max_batch_size =
+        max_batch_size > 0 ? max_batch_size : max_profile_batch_size(binding_table, num_optimization_profiles);
+  }
+}
+
+int64_t TRTEngine::get_qos_class() {
+  return qos_class;
 }
 
-void TRTEngine::verify_serialization_fmt(const std::vector<std::string>& serialized_info) {
+void TRTEngine::set_qos_class(int64_t qos_class) {
   TORCHTRT_CHECK(
-      serialized_info.size() == SERIALIZATION_LEN,
-      "Program to be deserialized targets an incompatible Torch-TensorRT ABI");
+      qos_class >= QOS_DEFAULT && qos_class <= QOS_BACKGROUND,
+      "Invalid QoS class " << qos_class << " for engine " << name);
+  this->qos_class = EngineQoSClass(qos_class);
+  // Engine streams are taken from the pool matching the QoS class on the next execution of each slot
+  for (auto& slot : exec_slots) {
+    slot->engine_stream = c10::cuda::getDefaultCUDAStream(device_info.id);
+  }
+  for (auto& replica : replicas) {
+    replica->set_qos_class(qos_class);
+  }
+  LOG_DEBUG("QoS class of engine " << name << " set to " << qos_class);
+}
+
+int64_t TRTEngine::get_persistent_cache_limit() {
+  return persistent_cache_limit;
+}
+
+void TRTEngine::set_persistent_cache_limit(int64_t limit) {
   TORCHTRT_CHECK(
-      serialized_info[ABI_TARGET_IDX] == ABI_VERSION,
-      "Program to be deserialized targets a different Torch-TensorRT ABI Version ("
-          << serialized_info[ABI_TARGET_IDX] << ") than the Torch-TensorRT Runtime ABI Version (" << ABI_VERSION
-          << ")");
+      limit >= -1, "Persistent cache limit of engine " << name << " must be -1 (automatic) or positive, got " << limit);
+  persistent_cache_limit = limit;
+  for (auto& replica : replicas) {
+    replica->set_persistent_cache_limit(limit);
+  }
+  LOG_DEBUG("Persistent cache limit of engine " << name << " set to " << limit);
 }
 
-FlattenedState TRTEngine::__obj_flatten__() {
-  // This method would be called by meta kernel of this custom class and it only needs to return a tuple
-  std::vector<std::string> serialized_info = this->serialize();
+int64_t TRTEngine::get_resolved_persistent_cache_limit() {
+  int max_persisting = 0;
+  if (cudaDeviceGetAttribute(&max_persisting, cudaDevAttrMaxPersistingL2CacheSize, device_info.id) != cudaSuccess) {
+    return 0;
+  }
+  auto limit = persistent_cache_limit.load();
+  return limit < 0 ? max_persisting : std::min<int64_t>(limit, max_persisting);
+}
 
-  return std::tuple(
-      std::tuple("version", serialized_info[ABI_TARGET_IDX]),
-      std::tuple("name", serialized_info[NAME_IDX]),
-      std::tuple("device_info", serialized_info[DEVICE_IDX]),
-      std::tuple("serialized_engine", serialized_info[ENGINE_IDX]),
-      std::tuple("in_binding_names", serialized_info[INPUT_BINDING_NAMES_IDX]),
-      std::tuple("out_binding_names", serialized_info[OUTPUT_BINDING_NAMES_IDX]),
-      std::tuple("hardware_compatible", serialized_info[HW_COMPATIBLE_IDX]),
-      std::tuple("serialized_metadata", serialized_info[SERIALIZED_METADATA_IDX]),
-      std::tuple("target_platform", serialized_info[TARGET_PLATFORM_IDX]));
+void TRTEngine::apply_persistent_cache_limit(TRTExecutionSlot& slot) {
+  auto limit = persistent_cache_limit.load();
+  if (slot.applied_persistent_cache_limit == limit) {
+    return;
+  }
+  auto bytes = get_resolved_persistent_cache_limit();
+  if (bytes > 0) {
+    // Only lines in the set-aside persist, the set-aside is device wide so it is only ever grown
+    size_t set_aside = 0;
+    if (cudaDeviceGetLimit(&set_aside, cudaLimitPersistingL2CacheSize) == cudaSuccess &&
+        set_aside < static_cast<size_t>(bytes)) {
+      auto err = cudaDeviceSetLimit(cudaLimitPersistingL2CacheSize, static_cast<size_t>(bytes));
+      if (err != cudaSuccess) {
+        LOG_WARNING(
+            "Unable to set aside " << bytes << "B of persisting L2 cache for engine " << name << " ("
+                                   << cudaGetErrorString(err) << ")");
+      }
+    }
+  }
+  for (auto& ctx : slot.profile_contexts) {
+    if (ctx) {
+      ctx->setPersistentCacheLimit(static_cast<size_t>(bytes));
+    }
+  }
+  LOG_DEBUG("Engine " << name << " may keep " << bytes << "B of persisting L2 cache");
+  slot.applied_persistent_cache_limit = limit;
 }
 
-std::vector<std::string> TRTEngine::serialize() {
-  // Serialize TensorRT engine
-  auto serialized_trt_engine = make_trt(this->cuda_engine->serialize());
+std::vector<int64_t> TRTEngine::get_replica_devices() {
+  std::vector<int64_t> device_ids;
+  if (!replicas.empty()) {
+    device_ids.push_back(device_info.id);
+  }
+  for (auto& replica : replicas) {
+    device_ids.push_back(replica->device_info.id);
+  }
+  return device_ids;
+}
+
+std::vector<std::string> TRTEngine::get_replica_device_uuids() {
+  std::vector<std::string> uuids;
+  if (!replicas.empty()) {
+    uuids.push_back(device_info.uuid);
+  }
+  for (auto& replica : replicas) {
+    uuids.push_back(replica->device_info.uuid);
+  }
+  return uuids;
+}
+
+void TRTEngine::set_replica_device_uuids(std::vector<std::string> uuids) {
+  std::vector<int64_t> device_ids;
+  for (const auto& uuid : uuids) {
+    auto device = find_device_by_uuid(uuid);
+    TORCHTRT_CHECK(
+        device,
+        "No device with UUID " << uuid << " is visible to this process, available devices:\n"
+                               << get_available_device_list().dump_list());
+    device_ids.push_back(device->id);
+  }
+  set_replica_devices(std::move(device_ids));
+}
+
+void TRTEngine::set_replica_devices(std::vector<int64_t> device_ids) {
+  std::sort(device_ids.begin(), device_ids.end());
+  device_ids.erase(std::unique(device_ids.begin(), device_ids.end()), device_ids.end());
+  auto num_devices = static_cast<int64_t>(c10::cuda::device_count());
+  auto on_engine_device = [&](int64_t id) { return id == device_info.id; };
+  TORCHTRT_CHECK(
+      !state_bindings || std::all_of(device_ids.begin(), device_ids.end(), on_engine_device),
+      "Engine " << name << " has state bindings, which live on its device, and cannot be replicated");
+
+  // Every replica shares the one plan
+  TORCHTRT_CHECK(!dla_loadable, "Engine " << name << " is a DLA loadable, it cannot be replicated on other GPUs");
+  // Engines without their weights are replicated as the stripped plan, the replicas are refit with the engine
+  auto serialized_engine = !is_engine_loaded()
+      ? pending_serialized_engine
+      : (weights_missing ? serialize_plan() : util::SerializedEngine(make_trt(cuda_engine->serialize())));
+
+  std::vector<c10::intrusive_ptr<TRTEngine>> new_replicas;
+  for (auto id : device_ids) {
+    TORCHTRT_CHECK(id >= 0 && id < num_devices, "Invalid replica device " << id << " for engine " << name);
+    if (id == device_info.id) {
+      continue;
+    }
+    auto replica = c10::make_intrusive<TRTEngine>(
+        name,
+        serialized_engine,
+        RTDevice(id, nvinfer1::DeviceType::kGPU),
+        in_binding_names,
+        returned_output_names(),
+        target_platform,
+        hardware_compatible,
+        serialized_metadata,
+        /*lazy_deserialization=*/true);
+    replica->lean_runtime_path = lean_runtime_path;
+    replica->engine_host_code_allowed = engine_host_code_allowed;
+    replica->shape_sized_device_memory = shape_sized_device_memory;
+    replica->idle_offload_ms = idle_offload_ms.load();
+    if (is_engine_loaded()) {
+      replica->ensure_engine_loaded();
+    }
+    TORCHTRT_CHECK(
+        replica->device_info.id == id,
+        "Device " << id << " is not compatible with engine " << name << ", it was placed on device "
+                  << replica->device_info.id << " instead");
+    replica->use_pre_allocated_outputs = use_pre_allocated_outputs;
+    replica->pre_allocated_outputs_depth = pre_allocated_outputs_depth;
+    replica->use_output_arena = use_output_arena;
+    replica->output_arena_depth = output_arena_depth;
+    replica->use_caller_stream = use_caller_stream;
+    replica->stage_host_inputs = stage_host_inputs;
+    replica->host_outputs = host_outputs;
+    replica->qos_class = qos_class;
+    replica->persistent_cache_limit = persistent_cache_limit.load();
+    replica->input_shapes = input_shapes;
+    replica->layer_sampler = layer_sampler;
+    replica->cudagraph_cache_max_entries = cudagraph_cache_max_entries.load();
+    replica->cudagraph_cache_max_bytes = cudagraph_cache_max_bytes.load();
+    replica->batch_buckets = batch_buckets;
+    replica->profile_path_prefix = profile_path_prefix;
+    new_replicas.push_back(std::move(replica));
+  }
+  replicas = std::move(new_replicas);
+  // Inputs handed between the devices are copied peer to peer where possible, enabling peer access synchronizes the
+  // devices and is done here rather than on the first execution which moves inputs
+  const auto& topology = DeviceTopology::get();
+  for (auto& replica : replicas) {
+    topology.enable_peer_access(device_info.id, replica->device_info.id);
+    for (auto& other : replicas) {
+      topology.enable_peer_access(replica->device_info.id, other->device_info.id);
+    }
+  }
+  // Creating the replicas switched the current device
+  set_rt_device(device_info);
+  LOG_DEBUG("Engine " << name << " replicated on " << replicas.size() << " additional devices");
+}
+
+void TRTEngine::set_state_bindings(std::vector<std::string> output_names, std::vector<std::string> input_names) {
+  TORCHTRT_CHECK(
+      output_names.size() == input_names.size(),
+      "Expected one input for each state output of engine " << name << ", got " << output_names.size()
+                                                             << " outputs and " << input_names.size() << " inputs");
+  if (output_names.empty()) {
+    state_bindings.reset();
+    reset_cudagraph_cache();
+    return;
+  }
+  ensure_tensorrt_engine(__func__);
+  TORCHTRT_CHECK(replicas.empty(), "Engine " << name << " has replicas, state bindings live on its device only");
+  TORCHTRT_CHECK(
+      output_sources.empty(),
+      "Engine " << name << " returns outputs which alias its inputs, it cannot have state bindings (compile with "
+                << "alias_outputs disabled)");
+  TORCHTRT_CHECK(
+      !has_data_dependent_outputs,
+      "Engine " << name << " has outputs with data dependent shapes and cannot have state bindings");
+
+  auto index_of = [](const std::vector<std::string>& names, const std::string& n) {
+    return static_cast<size_t>(std::find(names.begin(), names.end(), n) - names.begin());
+  };
+  std::vector<StateBindings::State> states;
+  std::set<size_t> bound_inputs, bound_outputs;
+  for (size_t s = 0; s < output_names.size(); s++) {
+    auto out = index_of(out_binding_names, output_names[s]);
+    auto in = index_of(in_binding_names, input_names[s]);
+    TORCHTRT_CHECK(out < out_binding_names.size(), "Engine " << name << " has no output named " << output_names[s]);
+    TORCHTRT_CHECK(in < in_binding_names.size(), "Engine " << name << " has no input named " << input_names[s]);
+    TORCHTRT_CHECK(
+        bound_inputs.insert(in).second && bound_outputs.insert(out).second,
+        "Input " << input_names[s] << " or output " << output_names[s] << " of engine " << name
+                 << " is part of several state bindings");
+    TORCHTRT_CHECK(
+        host_outputs.empty() || !host_outputs[out],
+        "Output " << output_names[s] << " of engine " << name << " is returned on the host and cannot hold a state");
+    // Both buffers of a state are bound as either binding, they need the same dtype, rank and a linear layout
+    TORCHTRT_CHECK(
+        !binding_table.input_is_shape_tensor[in] && binding_table.input_types[in] == binding_table.output_types[out] &&
+            binding_table.input_ranks[in] == binding_table.output_ranks[out] &&
+            binding_table.input_formats[in].is_linear() && binding_table.output_formats[out].is_linear(),
+        "Output " << output_names[s] << " of engine " << name << " cannot be fed back as input " << input_names[s]
+                  << ", they need the same dtype and rank and a linear layout");
+    auto dims = cuda_engine->getTensorShape(in_binding_names[in].c_str());
+    states.push_back({in, out, binding_table.input_types[in], util::toVec(dims), {}});
+  }
+  state_bindings =
+      std::make_shared<StateBindings>(std::move(states), num_io.first, num_io.second, device_info.id);
+  // Graphs are captured per buffer the states are read from
+  reset_cudagraph_cache();
+  LOG_DEBUG("Engine " << name << " has " << output_names.size() << " state bindings");
+}
+
+void TRTEngine::reset_state(std::vector<at::Tensor> initial_states) {
+  TORCHTRT_CHECK(state_bindings, "Engine " << name << " has no state bindings");
+  state_bindings->reset(initial_states);
+}
+
+std::vector<at::Tensor> TRTEngine::get_state() {
+  TORCHTRT_CHECK(state_bindings, "Engine " << name << " has no state bindings");
+  return state_bindings->get();
+}
+
+void TRTEngine::set_host_outputs(std::vector<std::string> output_names) {
+  if (output_names.empty()) {
+    host_outputs.clear();
+  } else {
+    std::vector<uint8_t> selected(out_binding_names.size(), 0);
+    for (const auto& n : output_names) {
+      auto o = static_cast<size_t>(std::find(out_binding_names.begin(), out_binding_names.end(), n) -
+                                   out_binding_names.begin());
+      TORCHTRT_CHECK(o < out_binding_names.size(), "Engine " << name << " has no output named " << n);
+      TORCHTRT_CHECK(
+          !state_bindings || !state_bindings->is_state_output(o),
+          "Output " << n << " of engine " << name << " is bound to a state and stays on the device");
+      selected[o] = 1;
+    }
+    host_outputs = std::move(selected);
+  }
+  for (auto& replica : replicas) {
+    replica->host_outputs = host_outputs;
+  }
+}
+
+std::vector<std::string> TRTEngine::get_host_outputs() {
+  std::vector<std::string> names;
+  for (size_t o = 0; o < host_outputs.size(); o++) {
+    if (host_outputs[o]) {
+      names.push_back(out_binding_names[o]);
+    }
+  }
+  return names;
+}
+
+c10::intrusive_ptr<TRTEngine> TRTEngine::select_replica(const std::vector<at::Tensor>& inputs) {
+  auto self = c10::intrusive_ptr<TRTEngine>::unsafe_reclaim_from_nonowning(this);
+  const auto& topology = DeviceTopology::get();
+  for (const auto& in : inputs) {
+    if (in.is_cuda()) {
+      // The replica on the device holding the inputs, otherwise the one the inputs have the nearest link to
+      auto device = in.device().index();
+      auto selected = self;
+      auto nearest = topology.link(device, device_info.id);
+      for (auto& replica : replicas) {
+        auto replica_link = topology.link(device, replica->device_info.id);
+        if (replica_link < nearest) {
+          selected = replica;
+          nearest = replica_link;
+        }
+      }
+      return selected;
+    }
+  }
+
+  // Host inputs can run anywhere, pick the engine with the fewest executions in flight per SM (counting the new one),
+  // so a large MIG instance takes more of them than a small one and an idle large instance is picked first. Between
+  // equally loaded engines, one on the NUMA node of the caller, whose inputs do not cross the socket interconnect
+  auto node = replicas.empty() ? -1 : current_numa_node();
+  auto load = [&](const TRTEngine& engine) {
+    auto in_flight = engine.in_flight_executions.load(std::memory_order_relaxed) + 1;
+    return std::make_pair(
+        static_cast<double>(in_flight) / std::max<int64_t>(1, engine.device_info.multiprocessors),
+        !topology.is_local(engine.device_info.id, node));
+  };
+  auto selected = self;
+  auto min_load = load(*this);
+  for (auto& replica : replicas) {
+    auto replica_load = load(*replica);
+    if (replica_load < min_load) {
+      selected = replica;
+      min_load = replica_load;
+    }
+  }
+  return selected;
+}
+
+void TRTEngine::activate_optimization_profile(TRTExecutionSlot& slot, int32_t profile) {
+  if (slot.active_profile == profile) {
+    return;
+  }
+  slot.profile_device_memory[slot.active_profile] = slot.bound_device_memory;
+  auto& ctx = slot.profile_contexts[profile];
+  if (!ctx) {
+    ctx = create_execution_context();
+    TORCHTRT_CHECK((ctx.get() != nullptr), "Unable to create TensorRT execution context");
+    if (profile_execution && trt_engine_profiler) {
+      ctx->setProfiler(trt_engine_profiler.get());
+    }
+    // Ordered before the execution on the caller stream, which the engine stream waits on
+    TORCHTRT_CHECK(
+        ctx->setOptimizationProfileAsync(profile, c10::cuda::getCurrentCUDAStream(device_info.id)),
+        "Unable to select optimization profile " << profile << " for engine " << name);
+    // The new context starts without persisting L2, have the limit applied to the contexts of the slot again
+    slot.applied_persistent_cache_limit = 0;
+  }
+  LOG_DEBUG("Engine " << name << " switching from optimization profile " << slot.active_profile << " to " << profile);
+  slot.exec_ctx = ctx;
+  slot.bound_device_memory = slot.profile_device_memory[profile];
+  slot.active_profile = profile;
+}
+
+void TRTEngine::reset_profile_contexts(TRTExecutionSlot& slot) {
+  slot.profile_contexts.assign(num_optimization_profiles, nullptr);
+  slot.profile_contexts[0] = slot.exec_ctx;
+  slot.profile_device_memory.assign(num_optimization_profiles, nullptr);
+  slot.active_profile = 0;
+}
+
+ExecutionSlotGuard::ExecutionSlotGuard(TRTEngine* engine, std::shared_ptr<TRTExecutionSlot> slot)
+    : engine(engine), slot(std::move(slot)) {}
+
+ExecutionSlotGuard::~ExecutionSlotGuard() {
+  engine->release_execution_slot(slot.get());
+}
+
+std::shared_ptr<nvinfer1::IExecutionContext> TRTEngine::create_execution_context() {
+  std::shared_ptr<nvinfer1::IExecutionContext> ctx;
+  // TensorRT returns no context when it cannot allocate the memory of one
+  retry_reclaiming_memory(device_info.id, [&]() {
+    if (shared_device_memory) {
+      // Memory is bound from the shared arena right before each execution, the requirement can change with the weight
+      // streaming budget so the arena is resized whenever contexts are created
+      shared_device_memory->reserve(cuda_engine->getDeviceMemorySizeV2());
+      ctx = make_trt(cuda_engine->createExecutionContext(nvinfer1::ExecutionContextAllocationStrategy::kUSER_MANAGED));
+    } else if (shape_sized_device_memory) {
+      // Memory is bound once the input shapes of an execution are set, see bind_shape_sized_device_memory
+      ctx = make_trt(cuda_engine->createExecutionContext(nvinfer1::ExecutionContextAllocationStrategy::kUSER_MANAGED));
+    } else {
+      ctx = make_trt(cuda_engine->createExecutionContext());
+    }
+    return ctx != nullptr;
+  });
+  return ctx;
+}
+
+std::shared_ptr<TRTExecutionSlot> TRTEngine::make_execution_slot() {
+  auto slot = std::make_shared<TRTExecutionSlot>();
+  slot->exec_ctx = create_execution_context();
+  TORCHTRT_CHECK((slot->exec_ctx.get() != nullptr), "Unable to create TensorRT execution context");
+  if (profile_execution && trt_engine_profiler) {
+    slot->exec_ctx->setProfiler(trt_engine_profiler.get());
+  }
+
+  reset_profile_contexts(*slot);
+
+  slot->runtime_states.old_cudagraphs = CUDAGRAPHS_MODE;
+  slot->runtime_states.old_pre_allocated_outputs = false;
+  slot->runtime_states.context_changed = false;
+
+  return slot;
+}
+
+void TRTEngine::recreate_execution_contexts() {
+  // Callers are expected to hold mu, execution contexts cannot be swapped out from under an in-flight execution
+  for (auto& slot : exec_slots) {
+    slot->exec_ctx.reset();
+    slot->profile_contexts.clear();
+  }
+  for (auto& slot : exec_slots) {
+    slot->exec_ctx = create_execution_context();
+    slot->bound_device_memory = nullptr;
+    slot->applied_persistent_cache_limit = 0;
+    reset_profile_contexts(*slot);
+    TORCHTRT_CHECK((slot->exec_ctx.get() != nullptr), "Unable to recreate TensorRT execution context");
+    if (profile_execution && trt_engine_profiler) {
+      slot->exec_ctx->setProfiler(trt_engine_profiler.get());
+    }
+    // Indicates to reevaluate the runtime settings
+    slot->runtime_states.context_changed = true;
+  }
+}
+
+std::shared_ptr<nvinfer1::IExecutionContext> TRTEngine::primary_exec_ctx() const {
+  return exec_slots[0]->exec_ctx;
+}
+
+int64_t TRTEngine::get_execution_context_pool_size() {
+  return static_cast<int64_t>(exec_slots.size());
+}
+
+void TRTEngine::set_execution_context_pool_size(int64_t size) {
+  TORCHTRT_CHECK(size >= 1, "Execution context pool size must be at least 1, got " << size);
+  ensure_tensorrt_engine(__func__);
+  std::unique_lock<std::mutex> lock(mu);
+  // Wait for all in-flight executions to finish so that slots can be safely added or removed
+  for (auto& slot : exec_slots) {
+    bool expected = false;
+    while (!slot->in_use.compare_exchange_strong(expected, true)) {
+      expected = false;
+      slot_waiters++;
+      slot_cv.wait(lock);
+      slot_waiters--;
+    }
+  }
+
+  while (static_cast<int64_t>(exec_slots.size()) < size) {
+    auto slot = make_execution_slot();
+    slot->in_use = true;
+    exec_slots.push_back(std::move(slot));
+  }
+  if (static_cast<int64_t>(exec_slots.size()) > size) {
+    exec_slots.resize(size);
+  }
+
+  for (auto& slot : exec_slots) {
+    slot->in_use = false;
+  }
+  LOG_DEBUG("Execution context pool size for engine " << name << " set to " << size);
+  slot_cv.notify_all();
+}
+
+std::unique_ptr<ExecutionSlotGuard> TRTEngine::acquire_execution_slot() {
+  ensure_engine_loaded();
+  if (weight_streaming_arbitrated) {
+    get_weight_streaming_arbiter().on_execution(this);
+    if (pending_device_memory_budget >= 0) {
+      apply_pending_device_memory_budget();
+    }
+  }
+  // Fast path: claim any free slot without taking the lock
+  for (auto& slot : exec_slots) {
+    bool expected = false;
+    if (slot->in_use.compare_exchange_strong(expected, true)) {
+      return std::make_unique<ExecutionSlotGuard>(this, slot);
+    }
+  }
+
+  // Slow path: every slot is checked out, wait for one to be returned
+  ScopedLatency wait_timer(metrics.slot_wait_latency);
+  std::unique_lock<std::mutex> lock(mu);
+  slot_waiters++;
+  while (true) {
+    for (auto& slot : exec_slots) {
+      bool expected = false;
+      if (slot->in_use.compare_exchange_strong(expected, true)) {
+        slot_waiters--;
+        return std::make_unique<ExecutionSlotGuard>(this, slot);
+      }
+    }
+    slot_cv.wait(lock);
+  }
+}
+
+void TRTEngine::release_execution_slot(TRTExecutionSlot* slot) {
+  slot->in_use = false;
+  if (slot_waiters.load() > 0) {
+    std::lock_guard<std::mutex> lock(mu);
+    slot_cv.notify_all();
+  }
+}
+
+int64_t TRTEngine::get_cudagraph_cache_max_entries() {
+  return cudagraph_cache_max_entries;
+}
+
+void TRTEngine::set_cudagraph_cache_max_entries(int64_t max_entries) {
+  TORCHTRT_CHECK(max_entries >= 0, "CUDA graph cache entry limit must be non-negative, got " << max_entries);
+  cudagraph_cache_max_entries = max_entries;
+}
+
+int64_t TRTEngine::get_cudagraph_cache_max_bytes() {
+  return cudagraph_cache_max_bytes;
+}
+
+void TRTEngine::set_cudagraph_cache_max_bytes(int64_t max_bytes) {
+  TORCHTRT_CHECK(max_bytes >= 0, "CUDA graph cache byte limit must be non-negative, got " << max_bytes);
+  cudagraph_cache_max_bytes = max_bytes;
+}
+
+c10::Dict<std::string, int64_t> TRTEngine::get_cudagraph_cache_stats() {
+  int64_t hits = 0, misses = 0, evictions = 0, entries = 0, bytes = 0;
+  for (auto& slot : exec_slots) {
+    hits += slot->cudagraph_cache.hits;
+    misses += slot->cudagraph_cache.misses;
+    evictions += slot->cudagraph_cache.evictions;
+    entries += slot->cudagraph_cache.num_entries;
+    bytes += slot->cudagraph_cache.total_bytes;
+  }
+  c10::Dict<std::string, int64_t> stats;
+  stats.insert("hits", hits);
+  stats.insert("misses", misses);
+  stats.insert("evictions", evictions);
+  stats.insert("entries", entries);
+  stats.insert("bytes", bytes);
+  return stats;
+}
+
+void TRTEngine::reset_cudagraph_cache() {
+  std::unique_lock<std::mutex> lock(mu);
+  // Flag every slot so that its cache is dropped by the next caller to check it out
+  for (auto& slot : exec_slots) {
+    slot->runtime_states.context_changed = true;
+  }
+}
+
+void TRTEngine::register_cudagraph_inputs(std::vector<at::Tensor> inputs) {
+  TORCHTRT_CHECK(
+      inputs.size() == num_io.first,
+      "Expected " << num_io.first << " inputs to register for CUDA graph capture, got " << inputs.size());
+  ensure_tensorrt_engine(__func__);
+  for (size_t i = 0; i < inputs.size(); i++) {
+    TORCHTRT_CHECK(
+        inputs[i].is_cuda() && has_format(inputs[i], binding_table.input_formats[i]),
+        "Registered CUDA graph inputs must be CUDA tensors laid out in the format of the engine input, contiguous "
+            << "for linear inputs (input " << i << ")");
+  }
+  registered_cudagraph_inputs = std::move(inputs);
+  // Previously captured graphs read from their own buffers, drop them to capture against the registered tensors
+  reset_cudagraph_cache();
+}
+
+void TRTEngine::clear_cudagraph_inputs() {
+  registered_cudagraph_inputs.clear();
+  reset_cudagraph_cache();
+}
+
+bool TRTEngine::is_registered_cudagraph_input(size_t pyt_idx, const at::Tensor& input) const {
+  // State buffers are owned by the engine and never move while a graph reads them
+  if (state_bindings && state_bindings->is_state_buffer(pyt_idx, input)) {
+    return true;
+  }
+  if (pyt_idx >= registered_cudagraph_inputs.size()) {
+    return false;
+  }
+  const auto& registered = registered_cudagraph_inputs[pyt_idx];
+  return registered.defined() && registered.data_ptr() == input.data_ptr() && registered.sizes() == input.sizes();
+}
+
+c10::Dict<std::string, int64_t> TRTEngine::get_runtime_metrics() {
+  return metrics.counters();
+}
+
+c10::Dict<std::string, c10::List<int64_t>> TRTEngine::get_latency_histograms() {
+  return metrics.histograms();
+}
+
+void TRTEngine::reset_runtime_metrics() {
+  metrics.reset();
+}
+
+c10::Dict<std::string, int64_t> TRTEngine::get_load_times() {
+  return load_times.to_dict();
+}
+
+c10::Dict<std::string, int64_t> TRTEngine::get_input_shape_histogram() {
+  return input_shapes->to_dict();
+}
+
+void TRTEngine::reset_input_shape_histogram() {
+  input_shapes->reset();
+}
+
+void TRTEngine::set_shared_device_memory(std::shared_ptr<DeviceMemoryArena> arena) {
+  ensure_tensorrt_engine(__func__);
+  TORCHTRT_CHECK(
+      !arena || arena->device() == device_info.id,
+      "Shared device memory for engine " << name << " must be on device " << device_info.id << ", found device "
+                                         << arena->device());
+  std::unique_lock<std::mutex> lock(mu);
+  shared_device_memory = std::move(arena);
+  recreate_execution_contexts();
+  LOG_DEBUG(
+      "Engine " << name << " now uses "
+                << (shared_device_memory ? "shared device memory" : "device memory owned by its execution contexts"));
+}
+
+void TRTEngine::share_device_memory(c10::intrusive_ptr<TRTEngine> other) {
+  if (!other->shared_device_memory) {
+    other->set_shared_device_memory(std::make_shared<DeviceMemoryArena>(other->device_info.id));
+  }
+  set_shared_device_memory(other->shared_device_memory);
+}
+
+bool TRTEngine::get_shape_sized_device_memory() {
+  return shape_sized_device_memory;
+}
+
+void TRTEngine::set_shape_sized_device_memory(bool enabled) {
+  if (!is_engine_loaded()) {
+    // Read when the contexts are created
+    shape_sized_device_memory = enabled;
+    return;
+  }
+  ensure_tensorrt_engine(__func__);
+  std::unique_lock<std::mutex> lock(mu);
+  if (shape_sized_device_memory == enabled) {
+    return;
+  }
+  shape_sized_device_memory = enabled;
+  for (auto& slot : exec_slots) {
+    slot->shape_sized_device_memory = at::Tensor();
+  }
+  recreate_execution_contexts();
+  LOG_DEBUG(
+      "Engine " << name << " now uses "
+                << (enabled ? "device memory sized to its input shapes" : "device memory sized to its largest shapes"));
+}
+
+bool TRTEngine::uses_shape_sized_device_memory() const {
+  return shape_sized_device_memory && !shared_device_memory;
+}
+
+int64_t TRTEngine::get_idle_offload_ms() {
+  return idle_offload_ms;
+}
+
+void TRTEngine::set_idle_offload_ms(int64_t timeout_ms) {
+  TORCHTRT_CHECK(
+      timeout_ms >= 0, "Idle offload timeout of engine " << name << " must not be negative, got " << timeout_ms);
+  idle_offload_ms = timeout_ms;
+  if (timeout_ms > 0) {
+    get_engine_offloader().register_engine(this);
+  } else {
+    get_engine_offloader().notify();
+  }
+}
+
+bool TRTEngine::offload() {
+  // Never waits for the engine to be loaded, the offloader holds its registry while it offloads engines
+  std::unique_lock<std::mutex> load_lock(load_mu, std::try_to_lock);
+  if (!load_lock.owns_lock() || !is_engine_loaded() || dla_loadable || weights_missing) {
+    return false;
+  }
+  // Executions count themselves in flight before they check whether the engine is loaded, so they either find it
+  // unloaded and wait for load_mu to load it again or are found in flight here
+  engine_loaded.store(false);
+  if (in_flight_executions.load() > 0) {
+    engine_loaded.store(true);
+    return false;
+  }
+  c10::cuda::CUDAGuard device_guard(device_info.id);
+  util::SerializedEngine plan;
+  try {
+    plan = copy_to_pinned_memory(util::SerializedEngine(make_trt(cuda_engine->serialize())));
+  } catch (...) {
+    engine_loaded.store(true);
+    throw;
+  }
+  if (plan.empty()) {
+    engine_loaded.store(true);
+    LOG_WARNING("Unable to serialize engine " << name << " to offload it, it stays loaded");
+    return false;
+  }
+
+  get_memory_reclaimer().unregister_engine(this);
+  bool arbitrated = weight_streaming_arbitrated && get_weight_streaming_arbiter().unregister_engine(this);
+  {
+    std::unique_lock<std::mutex> lock(mu);
+    // Slots can still be checked out by calls which are not executions (e.g. get_memory_usage)
+    for (auto& slot : exec_slots) {
+      bool expected = false;
+      while (!slot->in_use.compare_exchange_strong(expected, true)) {
+        expected = false;
+        slot_waiters++;
+        slot_cv.wait(lock);
+        slot_waiters--;
+      }
+      slot->trt_exec_complete.synchronize();
+    }
+    offloaded_pool_size = static_cast<int64_t>(exec_slots.size());
+    exec_slots.clear();
+  }
+  {
+    std::lock_guard<std::mutex> lock(shape_inference_mu);
+    shape_inference_ctx = nullptr;
+    shape_inference_engine = nullptr;
+    inferred_output_shapes.clear();
+  }
+  cuda_engine.reset();
+  pending_serialized_engine = std::move(plan);
+  offloaded = true;
+  increment(metrics.offloads);
+  if (arbitrated) {
+    get_weight_streaming_arbiter().rebalance(device_info.id);
+  }
+  LOG_DEBUG(
+      "Offloaded engine " << name << " to host memory, its plan of " << pending_serialized_engine.size()
+                          << "B is deserialized again by its next execution");
+  return true;
+}
+
+bool TRTEngine::is_offloaded() const {
+  return offloaded;
+}
+
+void TRTEngine::set_cudagraph_pool(std::shared_ptr<CudaGraphPool> pool) {
+  TORCHTRT_CHECK(
+      !pool || pool->device() == device_info.id,
+      "CUDA graph pool for engine " << name << " must be on device " << device_info.id << ", found device "
+                                    << pool->device());
+  {
+    std::unique_lock<std::mutex> lock(mu);
+    cudagraph_pool = std::move(pool);
+  }
+  reset_cudagraph_cache();
+  LOG_DEBUG(
+      "Engine " << name << " now captures CUDA graphs into "
+                << (cudagraph_pool ? "a shared graph pool" : "private graph pools"));
+}
+
+void TRTEngine::share_cudagraph_pool(c10::intrusive_ptr<TRTEngine> other) {
+  if (!other->cudagraph_pool) {
+    other->set_cudagraph_pool(std::make_shared<CudaGraphPool>(other->device_info.id));
+  }
+  set_cudagraph_pool(other->cudagraph_pool);
+}
+
+void TRTEngine::refit(const std::unordered_map<std::string, at::Tensor>& weights) {
+  ensure_tensorrt_engine(__func__);
+  TORCHTRT_CHECK(cuda_engine->isRefittable(), "Engine " << name << " was not built with refit enabled");
+  c10::cuda::CUDAGuard device_guard(device_info.id);
+  std::unique_lock<std::mutex> lock(mu);
+  // Wait for all in-flight executions to finish so that the weights do not change under them
+  for (auto& slot : exec_slots) {
+    bool expected = false;
+    while (!slot->in_use.compare_exchange_strong(expected, true)) {
+      expected = false;
+      slot_waiters++;
+      slot_cv.wait(lock);
+      slot_waiters--;
+    }
+  }
+
+  auto engine = cuda_engine;
+  // Plans without weights are never deduplicated, there are no weights of other engines to keep
+  bool is_shared = cuda_engine.use_count() > 2 && !weights_missing;
+  if (is_shared) {
+    LOG_DEBUG("Engine " << name << " shares its ICudaEngine with other engines, refitting a private copy");
+    auto plan = make_trt(cuda_engine->serialize());
+    auto copy = make_trt(rt->deserializeCudaEngine(plan->data(), plan->size()));
+    TORCHTRT_CHECK((copy.get() != nullptr), "Unable to copy engine " << name << " to refit it");
+    if (copy->getStreamableWeightsSize() > 0) {
+      copy->setWeightStreamingBudgetV2(cuda_engine->getWeightStreamingBudgetV2());
+    }
+    using EngineOwner = std::pair<std::shared_ptr<nvinfer1::IRuntime>, std::shared_ptr<nvinfer1::ICudaEngine>>;
+    auto owner = std::make_shared<EngineOwner>(rt, copy);
+    engine = std::shared_ptr<nvinfer1::ICudaEngine>(owner, copy.get());
+  }
+
+  auto refitter = make_trt(nvinfer1::createInferRefitter(*engine, util::logging::get_logger()));
+  TORCHTRT_CHECK((refitter.get() != nullptr), "Unable to create a refitter for engine " << name);
+  int32_t num_weights = refitter->getAllWeights(0, nullptr);
+  std::vector<const char*> weight_names(num_weights);
+  refitter->getAllWeights(num_weights, weight_names.data());
+  // The refitter reads the weights when refitting, keep the staged copies until then
+  std::vector<at::Tensor> staged_weights;
+  for (auto weight_name : weight_names) {
+    auto w = weights.find(weight_name);
+    TORCHTRT_CHECK(
+        w != weights.end(),
+        "No new values for weights " << weight_name << " of engine " << name
+                                     << ", the engine can only be refit from a module with the same architecture");
+#if NV_TENSORRT_MAJOR >= 10
+    // Contiguous weights already on the device of the engine are read in place
+    auto t = w->second.to(at::Device(at::kCUDA, device_info.id)).contiguous();
+    nvinfer1::Weights trt_weights{util::ScalarTypeToTRTDataType(t.scalar_type()), t.data_ptr(), t.numel()};
+    TORCHTRT_CHECK(
+        refitter->setNamedWeights(weight_name, trt_weights, nvinfer1::TensorLocation::kDEVICE),
+        "Unable to set weights " << weight_name << " of engine " << name);
+#else
+    auto t = w->second.to(at::kCPU).contiguous();
+    nvinfer1::Weights trt_weights{util::ScalarTypeToTRTDataType(t.scalar_type()), t.data_ptr(), t.numel()};
+    TORCHTRT_CHECK(
+        refitter->setNamedWeights(weight_name, trt_weights),
+        "Unable to set weights " << weight_name << " of engine " << name);
+#endif
+    staged_weights.push_back(std::move(t));
+  }
+#if NV_TENSORRT_MAJOR >= 10
+  // Ordered after the copies of the weights to the device, which are freed once the refit is done
+  auto stream = c10::cuda::getCurrentCUDAStream(device_info.id);
+  TORCHTRT_CHECK(refitter->refitCudaEngineAsync(stream.stream()), "Refitting engine " << name << " failed");
+  stream.synchronize();
+#else
+  TORCHTRT_CHECK(refitter->refitCudaEngine(), "Refitting engine " << name << " failed");
+#endif
+  weights_missing = false;
+
+  if (is_shared) {
+    cuda_engine = std::move(engine);
+    recreate_execution_contexts();
+  } else {
+    // Captured CUDA graphs are dropped by the next caller to check out each slot
+    for (auto& slot : exec_slots) {
+      slot->runtime_states.context_changed = true;
+    }
+  }
+  for (auto& slot : exec_slots) {
+    slot->in_use = false;
+  }
+  slot_cv.notify_all();
+  lock.unlock();
+  LOG_INFO("Refit " << num_weights << " weights of engine " << name);
+
+  for (auto& replica : replicas) {
+    replica->refit(weights);
+  }
+}
+
+void TRTEngine::swap_engine(c10::intrusive_ptr<TRTEngine> replacement) {
+  TORCHTRT_CHECK(replacement.get() != this, "Engine " << name << " cannot be swapped with itself");
+  ensure_tensorrt_engine(__func__);
+  replacement->ensure_engine_loaded();
+  TORCHTRT_CHECK(
+      replacement->device_info.id == device_info.id,
+      "Engine " << replacement->name << " is on device " << replacement->device_info.id << ", engine " << name
+                << " can only be swapped with engines on device " << device_info.id);
+  TORCHTRT_CHECK(
+      replicas.empty() && replacement->replicas.empty(),
+      "Engines with replicas cannot be swapped, set the replica devices again after swapping engine " << name);
+  // Executions read the binding types and shape tensor flags before they check out a slot, only what is read with
+  // a slot checked out may differ
+  const auto& bindings = binding_table;
+  const auto& other = replacement->binding_table;
+  TORCHTRT_CHECK(
+      replacement->in_binding_names == in_binding_names &&
+          replacement->returned_output_names() == returned_output_names() &&
+          other.input_types == bindings.input_types && other.input_is_shape_tensor == bindings.input_is_shape_tensor &&
+          other.input_ranks == bindings.input_ranks && other.output_types == bindings.output_types &&
+          other.output_ranks == bindings.output_ranks,
+      "Engine " << replacement->name << " does not have the same bindings as engine " << name
+                << ", engines can only be swapped with engines built from the same segment");
+
+  c10::cuda::CUDAGuard device_guard(device_info.id);
+  // Engines are locked in address order so concurrent swaps of the same pair do not deadlock
+  bool this_first = std::less<TRTEngine*>()(this, replacement.get());
+  TRTEngine* first = this_first ? this : replacement.get();
+  TRTEngine* second = this_first ? replacement.get() : this;
+  std::unique_lock<std::mutex> first_lock(first->mu);
+  std::unique_lock<std::mutex> second_lock(second->mu, std::defer_lock);
+  // Wait for all in-flight executions of both engines to finish, they complete on the engine they started with
+  for (auto [engine, lock] : {std::make_pair(first, &first_lock), std::make_pair(second, &second_lock)}) {
+    if (!lock->owns_lock()) {
+      lock->lock();
+    }
+    for (auto& slot : engine->exec_slots) {
+      bool expected = false;
+      while (!slot->in_use.compare_exchange_strong(expected, true)) {
+        expected = false;
+        engine->slot_waiters++;
+        engine->slot_cv.wait(*lock);
+        engine->slot_waiters--;
+      }
+    }
+  }
+
+  std::swap(rt, replacement->rt);
+  std::swap(cuda_engine, replacement->cuda_engine);
+  std::swap(in_binding_map, replacement->in_binding_map);
+  std::swap(out_binding_map, replacement->out_binding_map);
+  std::swap(hardware_compatible, replacement->hardware_compatible);
+  std::swap(has_data_dependent_outputs, replacement->has_data_dependent_outputs);
+  std::swap(num_optimization_profiles, replacement->num_optimization_profiles);
+  std::swap(num_aux_streams, replacement->num_aux_streams);
+  std::swap(serialized_engine_size, replacement->serialized_engine_size);
+  std::swap(serialized_metadata, replacement->serialized_metadata);
+  std::swap(target_platform, replacement->target_platform);
+  std::swap(engine_bundle, replacement->engine_bundle);
+  std::swap(binding_table.input_trt_indices, replacement->binding_table.input_trt_indices);
+  std::swap(binding_table.input_formats, replacement->binding_table.input_formats);
+  std::swap(binding_table.output_trt_indices, replacement->binding_table.output_trt_indices);
+  std::swap(binding_table.output_formats, replacement->binding_table.output_formats);
+  std::swap(binding_table.profile_min, replacement->binding_table.profile_min);
+  std::swap(binding_table.profile_opt, replacement->binding_table.profile_opt);
+  std::swap(binding_table.profile_max, replacement->binding_table.profile_max);
+
+  for (auto engine : {first, second}) {
+    // Captured CUDA graphs and output shapes are dropped with the contexts, outputs kept for reuse may have the
+    // layout of the other engine and the auxiliary streams were sized for it
+    engine->recreate_execution_contexts();
+    for (auto& slot : engine->exec_slots) {
+      slot->pre_allocated_outputs.clear();
+      slot->output_arena.clear();
+      slot->aux_streams.clear();
+      slot->aux_streams_device = -1;
+      slot->in_use = false;
+    }
+    engine->slot_cv.notify_all();
+  }
+  second_lock.unlock();
+  first_lock.unlock();
+  LOG_INFO("Swapped the TensorRT engines of " << name << " and " << replacement->name);
+
+  if (weight_streaming_arbitrated || replacement->weight_streaming_arbitrated) {
+    // The streamable weights of the arbitrated engines changed
+    get_weight_streaming_arbiter().rebalance(device_info.id);
+  }
+}
+
+void TRTEngine::disable_profiling() {
+  torch::cuda::synchronize(device_info.id);
+  std::unique_lock<std::mutex> lock(mu);
+  profile_execution = false;
+  trt_engine_profiler.reset();
+  recreate_execution_contexts();
+}
+
+void TRTEngine::dump_engine_layer_info_to_file(const std::string& path) {
+  ensure_tensorrt_engine(__func__);
+  auto inspector = make_trt(cuda_engine->createEngineInspector());
+  std::ofstream f(path);
+  f << std::string(inspector->getEngineInformation(nvinfer1::LayerInformationFormat::kJSON));
+  f.close();
+  return;
+}
+
+void TRTEngine::dump_engine_layer_info() {
+  std::string layer_info_file =
+      std::filesystem::path{profile_path_prefix + "/" + name + "_layer_information.json"}.string();
+  dump_engine_layer_info_to_file(layer_info_file);
+  return;
+}
+
+void TRTEngine::enable_profiling() {
+  profile_execution = true;
+  trt_engine_profiler = std::make_unique<TRTEngineProfiler>(name);
+  for (auto& slot : exec_slots) {
+    slot->exec_ctx->setProfiler(trt_engine_profiler.get());
+  }
+}
+
+c10::Dict<std::string, c10::Dict<std::string, double>> TRTEngine::get_layer_profile() {
+  c10::Dict<std::string, c10::Dict<std::string, double>> layers;
+  // Profiled executions report layer times while holding profiling_mu
+  std::lock_guard<std::mutex> lock(profiling_mu);
+  if (!trt_engine_profiler) {
+    return layers;
+  }
+  const auto& times = trt_engine_profiler->get_layer_times();
+  for (const auto& layer_name : trt_engine_profiler->get_layer_names()) {
+    const auto& record = times.at(layer_name);
+    c10::Dict<std::string, double> layer;
+    layer.insert("total_ms", record.time);
+    layer.insert("count", record.count);
+    layer.insert("mean_ms", record.count > 0 ? record.time / record.count : 0.0);
+    layers.insert(layer_name, std::move(layer));
+  }
+  return layers;
+}
+
+void TRTEngine::reset_layer_profile() {
+  std::lock_guard<std::mutex> lock(profiling_mu);
+  if (trt_engine_profiler) {
+    trt_engine_profiler->reset();
+  }
+}
+
+void TRTEngine::enable_layer_sampling(LayerSamplingConfig config) {
+  layer_sampler->enable(name, std::move(config));
+}
+
+void TRTEngine::disable_layer_sampling() {
+  layer_sampler->disable();
+}
+
+std::string TRTEngine::get_layer_samples() {
+  return layer_sampler->to_json();
+}
+
+std::string TRTEngine::get_engine_layer_info() {
+  ensure_tensorrt_engine(__func__);
+  auto inspector = cuda_engine->createEngineInspector();
+  return inspector->getEngineInformation(nvinfer1::LayerInformationFormat::kJSON);
+}
+
+std::vector<at::Tensor> TRTEngine::infer_outputs(std::vector<std::vector<int64_t>> input_shapes) {
+  std::vector<at::Tensor> outputs;
+  TORCHTRT_CHECK(
+      (in_binding_names.size() == input_shapes.size()),
+      "The number of input shapes provided doesn't match with the number of input names registered.");
+  // Shapes are inferred for the bucket the batch would be padded to and the batch dimension is sliced back
+  int64_t batch = -1;
+  int64_t bucket = -1;
+  if (!batch_buckets.empty()) {
+    ensure_engine_loaded();
+    for (size_t i = 0; i < input_shapes.size(); i++) {
+      if (!binding_table.input_is_shape_tensor[i] && !input_shapes[i].empty()) {
+        batch = batch < 0 ? input_shapes[i][0] : batch;
+        if (input_shapes[i][0] == batch) {
+          input_shapes[i][0] = select_batch_bucket(batch);
+        }
+      }
+    }
+    bucket = batch < 0 ? -1 : select_batch_bucket(batch);
+  }
+  ensure_tensorrt_engine(__func__);
+  auto engine = cuda_engine;
+
+  std::vector<std::vector<int64_t>> output_shapes;
+  {
+    std::lock_guard<std::mutex> lock(shape_inference_mu);
+    if (shape_inference_engine != engine) {
+      shape_inference_engine = engine;
+      inferred_output_shapes.clear();
+      shape_inference_ctx = nullptr;
+    }
+    auto cached = inferred_output_shapes.find(input_shapes);
+    if (cached != inferred_output_shapes.end()) {
+      output_shapes = cached->second;
+    } else {
+      // The execution slots keep their shapes, and shape queries need no device memory
+      if (!shape_inference_ctx) {
+        shape_inference_ctx =
+            make_trt(engine->createExecutionContext(nvinfer1::ExecutionContextAllocationStrategy::kUSER_MANAGED));
+        TORCHTRT_CHECK(shape_inference_ctx, "Unable to create a shape inference context for engine " << name);
+        shape_inference_profile = 0;
+      }
+      if (num_optimization_profiles > 1) {
+        std::vector<c10::IntArrayRef> shapes(input_shapes.begin(), input_shapes.end());
+        auto profile = select_optimization_profile(shapes);
+        if (profile != shape_inference_profile) {
+          c10::cuda::CUDAGuard device_guard(static_cast<c10::DeviceIndex>(device_info.id));
+          TORCHTRT_CHECK(
+              shape_inference_ctx->setOptimizationProfileAsync(
+                  profile, c10::cuda::getCurrentCUDAStream(device_info.id)),
+              "Unable to select optimization profile " << profile << " for the shape inference of engine " << name);
+          shape_inference_profile = profile;
+        }
+      }
+      for (size_t i = 0; i < input_shapes.size(); i++) {
+        shape_inference_ctx->setInputShape(in_binding_names[i].c_str(), core::util::toDims(input_shapes[i]));
+      }
+      for (size_t i = 0; i < out_binding_names.size(); i++) {
+        output_shapes.push_back(core::util::toVec(shape_inference_ctx->getTensorShape(out_binding_names[i].c_str())));
+      }
+      // Tracing sees a bounded number of shapes, the memo is only a guard against unbounded growth
+      constexpr size_t kMaxInferredShapes = 1024;
+      if (inferred_output_shapes.size() >= kMaxInferredShapes) {
+        inferred_output_shapes.clear();
+      }
+      inferred_output_shapes.emplace(input_shapes, output_shapes);
+    }
+  }
+
+  for (size_t i = 0; i < out_binding_names.size(); i++) {
+    auto& output_shape = output_shapes[i];
+    if (bucket != batch && !output_shape.empty() && output_shape[0] == bucket) {
+      output_shape[0] = batch;
+    }
+    auto output_dtype = core::util::TRTDataTypeToScalarType(engine->getTensorDataType(out_binding_names[i].c_str()));
+    // Only the shape and dtype of the outputs are needed, meta tensors have no storage
+    outputs.push_back(at::empty(output_shape, at::TensorOptions().dtype(output_dtype).device(at::kMeta)));
+  }
+  TORCHTRT_CHECK(
+      (out_binding_names.size() == outputs.size()),
+      "The number of output shapes inferred doesn't match with the number of output names registered.");
+  return outputs;
+}
+
+void TRTEngine::set_profiling_paths() {
+  device_profile_path =
+      std::filesystem::path{profile_path_prefix + "/" + name + "_device_config_profile.trace"}.string();
+  input_profile_path = std::filesystem::path{profile_path_prefix + "/" + name + "_input_profile.trace"}.string();
+  output_profile_path = std::filesystem::path{profile_path_prefix + "/" + name + "_output_profile.trace"}.string();
+  enqueue_profile_path = std::filesystem::path{profile_path_prefix + "/" + name + "_enqueue_profile.trace"}.string();
+  trt_engine_profile_path =
+      std::filesystem::path{profile_path_prefix + "/" + name + "_engine_exectuion_profile.trace"}.string();
+  cuda_graph_debug_path = std::filesystem::path{profile_path_prefix + "/" + name + "_cudagraph.dot"}.string();
+}
+
+int64_t TRTEngine::get_device_memory_budget() {
+  ensure_tensorrt_engine(__func__);
+  return cuda_engine->getWeightStreamingBudgetV2();
+}
+
+bool TRTEngine::set_device_memory_budget(int64_t budget) {
+  ensure_tensorrt_engine(__func__);
+  std::unique_lock<std::mutex> lock(mu);
+  for (auto& slot : exec_slots) {
+    bool expected = false;
+    while (!slot->in_use.compare_exchange_strong(expected, true)) {
+      expected = false;
+      slot_waiters++;
+      slot_cv.wait(lock);
+      slot_waiters--;
+    }
+  }
+  bool result = false;
+  try {
+    result = set_device_memory_budget_locked(budget);
+  } catch (...) {
+    for (auto& slot : exec_slots) {
+      slot->in_use = false;
+    }
+    slot_cv.notify_all();
+    throw;
+  }
+  for (auto& slot : exec_slots) {
+    slot->in_use = false;
+  }
+  slot_cv.notify_all();
+
+  return result;
+}
+
+bool TRTEngine::set_device_memory_budget_locked(int64_t budget) {
+  // Recreating the contexts because weight streaming budget cannot be modified while there are active contexts.
+  for (auto& slot : exec_slots) {
+    slot->exec_ctx.reset();
+    slot->profile_contexts.clear();
+  }
+  bool result = cuda_engine->setWeightStreamingBudgetV2(budget);
+  if (!result && DEDUPLICATE_ENGINES) {
+    LOG_WARNING(
+        "Unable to set the weight streaming budget of engine " << name
+                                                               << ", deduplicated engines can only change their budget "
+                                                               << "while no other instance holds execution contexts");
+  }
+  recreate_execution_contexts();
+  return result;
+}
+
+void TRTEngine::apply_pending_device_memory_budget() {
+  // Budgets only change between executions, an engine which is running picks the budget up when it next starts one
+  for (auto& slot : exec_slots) {
+    if (slot->in_use) {
+      return;
+    }
+  }
+  auto budget = pending_device_memory_budget.exchange(-1);
+  if (budget < 0 || budget == cuda_engine->getWeightStreamingBudgetV2()) {
+    return;
+  }
+  LOG_DEBUG("Applying the weight streaming budget of " << budget << "B assigned to engine " << name);
+  set_device_memory_budget(budget);
+}
+
+c10::Dict<std::string, int64_t> TRTEngine::get_memory_usage() {
+  int64_t weights = 0, activations = 0, shared_activations = 0, cudagraphs = 0, shared_cudagraphs = 0, io_buffers = 0;
+  if (is_engine_loaded() && !dla_loadable) {
+    weights = serialized_engine_size;
+    int64_t streamable = cuda_engine->getStreamableWeightsSize();
+    if (streamable > 0) {
+      weights = std::max<int64_t>(
+          weights - streamable + std::min<int64_t>(cuda_engine->getWeightStreamingBudgetV2(), streamable), 0);
+    }
+    if (shared_device_memory) {
+      shared_activations = shared_device_memory->size();
+    }
+    if (cudagraph_pool) {
+      auto pool_lock = cudagraph_pool->lock();
+      shared_cudagraphs = cudagraph_pool->size();
+    }
+    // Contexts with shape sized device memory share the memory of their slot
+    int64_t context_memory =
+        shared_device_memory || shape_sized_device_memory ? 0 : cuda_engine->getDeviceMemorySizeV2();
+
+    auto storage_bytes = [](const at::Tensor& t) -> int64_t {
+      return t.defined() ? static_cast<int64_t>(t.storage().nbytes()) : 0;
+    };
+    for (auto& slot : exec_slots) {
+      // Claim the slot so its buffers are not changed by an execution while they are counted
+      {
+        std::unique_lock<std::mutex> lock(mu);
+        bool expected = false;
+        while (!slot->in_use.compare_exchange_strong(expected, true)) {
+          expected = false;
+          slot_waiters++;
+          slot_cv.wait(lock);
+          slot_waiters--;
+        }
+      }
+      ExecutionSlotGuard guard(this, slot);
+
+      int64_t contexts = 0;
+      for (const auto& ctx : slot->profile_contexts) {
+        contexts += ctx != nullptr;
+      }
+      activations += std::max<int64_t>(contexts, slot->exec_ctx != nullptr) * context_memory;
+      activations += storage_bytes(slot->shape_sized_device_memory);
+      cudagraphs += slot->cudagraph_cache.total_bytes;
+      for (const auto& ring : slot->pre_allocated_outputs) {
+        for (const auto& set : ring.second.sets) {
+          for (const auto& out : set) {
+            io_buffers += storage_bytes(out);
+          }
+        }
+      }
+      for (const auto& arena : slot->output_arena) {
+        for (const auto& buffer : arena) {
+          io_buffers += storage_bytes(buffer);
+        }
+      }
+      if (slot->output_allocator) {
+        for (size_t i = 0; i < out_binding_names.size(); i++) {
+          io_buffers += storage_bytes(slot->output_allocator->buffer(i));
+        }
+      }
+    }
+    if (state_bindings) {
+      io_buffers += state_bindings->nbytes();
+    }
+  }
+
+  c10::Dict<std::string, int64_t> usage;
+  usage.insert("weights", weights);
+  usage.insert("activations", activations);
+  usage.insert("shared_activations", shared_activations);
+  usage.insert("cudagraphs", cudagraphs);
+  usage.insert("shared_cudagraphs", shared_cudagraphs);
+  usage.insert("io_buffers", io_buffers);
+  usage.insert("total", weights + activations + cudagraphs + io_buffers);
+  return usage;
+}
+
+namespace {
+// Releases what stage covers from a slot checked out by the caller, returns the bytes released
+int64_t release_slot_memory(TRTExecutionSlot& slot, ReclaimStage stage, int64_t context_memory) {
+  int64_t released = slot.cudagraph_cache.evict_all_except(nullptr);
+  if (stage < RECLAIM_BUFFERS) {
+    return released;
+  }
+  // Outputs the caller still holds stay allocated, only the reference of the slot is dropped
+  auto idle_bytes = [](const at::Tensor& t) -> int64_t {
+    return t.defined() && t.storage().use_count() == 1 ? static_cast<int64_t>(t.storage().nbytes()) : 0;
+  };
+  for (const auto& ring : slot.pre_allocated_outputs) {
+    for (const auto& set : ring.second.sets) {
+      for (const auto& out : set) {
+        released += idle_bytes(out);
+      }
+    }
+  }
+  slot.pre_allocated_outputs.clear();
+  for (auto& arena : slot.output_arena) {
+    for (const auto& buffer : arena) {
+      released += idle_bytes(buffer);
+    }
+    arena.clear();
+  }
+  if (slot.output_allocator) {
+    released += slot.output_allocator->release_idle_buffers();
+  }
+  // Contexts of the other profiles are created again when the slot switches back to them, their graphs are gone
+  for (size_t profile = 0; profile < slot.profile_contexts.size(); profile++) {
+    if (static_cast<int32_t>(profile) != slot.active_profile && slot.profile_contexts[profile]) {
+      slot.profile_contexts[profile].reset();
+      slot.profile_device_memory[profile] = nullptr;
+      released += context_memory;
+    }
+  }
+  // Shape sized device memory is allocated again for the shapes of the next execution of the slot
+  if (slot.shape_sized_device_memory.defined()) {
+    if (slot.trt_exec_complete.isCreated()) {
+      slot.trt_exec_complete.synchronize();
+    }
+    released += static_cast<int64_t>(slot.shape_sized_device_memory.nbytes());
+    slot.shape_sized_device_memory = at::Tensor();
+    slot.bound_device_memory = nullptr;
+    std::fill(slot.profile_device_memory.begin(), slot.profile_device_memory.end(), nullptr);
+    slot.runtime_states.context_changed = true;
+  }
+  return released;
+}
+} // namespace
+
+int64_t TRTEngine::reclaim_device_memory(ReclaimStage stage, TRTExecutionSlot* requester) {
+  if (!is_engine_loaded() || dla_loadable) {
+    return 0;
+  }
+  // The pool is locked while slots are added or contexts are recreated, waiting for it could deadlock with the
+  // execution that ran out of memory
+  std::unique_lock<std::mutex> lock(mu, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    return 0;
+  }
+  int64_t context_memory =
+      shared_device_memory || shape_sized_device_memory ? 0 : cuda_engine->getDeviceMemorySizeV2();
+  int64_t released = 0;
+  bool all_claimed = true;
+  std::vector<TRTExecutionSlot*> claimed;
+  auto release_claimed = [&]() {
+    for (auto slot : claimed) {
+      slot->in_use = false;
+    }
+    if (slot_waiters.load() > 0) {
+      slot_cv.notify_all();
+    }
+  };
+  try {
+    for (auto& slot : exec_slots) {
+      if (slot.get() == requester) {
+        // Part way through an execution, only the graphs it is not using can go
+        released += slot->cudagraph_cache.evict_all_except(slot->cudagraph_in_use);
+        all_claimed = false;
+        continue;
+      }
+      bool expected = false;
+      if (!slot->in_use.compare_exchange_strong(expected, true)) {
+        all_claimed = false;
+        continue;
+      }
+      claimed.push_back(slot.get());
+      released += release_slot_memory(*slot, stage, context_memory);
+    }
+
+    int64_t budget = cuda_engine->getWeightStreamingBudgetV2();
+    if (stage >= RECLAIM_WEIGHT_STREAMING && all_claimed && !DEDUPLICATE_ENGINES &&
+        cuda_engine->getStreamableWeightsSize() > 0 && budget > 0) {
+      // The weight streaming arbiter may hand the memory back on its next rebalance, once it is free again
+      if (set_device_memory_budget_locked(budget / 2)) {
+        LOG_DEBUG("Reduced the weight streaming budget of engine " << name << " to " << budget / 2 << "B");
+        released += budget - budget / 2;
+      }
+    }
+  } catch (...) {
+    release_claimed();
+    throw;
+  }
+  release_claimed();
+  return released;
+}
+
+// Returns 0 if BuilderFlag::kWEIGHT_STREAMING is unset during engine building.
+int64_t TRTEngine::get_streamable_device_memory_budget() {
+  ensure_tensorrt_engine(__func__);
+  return cuda_engine->getStreamableWeightsSize();
+}
+
+int64_t TRTEngine::get_automatic_device_memory_budget() {
+  ensure_tensorrt_engine(__func__);
+  return cuda_engine->getWeightStreamingAutomaticBudget();
+}
+
+std::string TRTEngine::to_str() const {
+  // clang-format off
+  std::stringstream ss;
+  ss << "Torch-TensorRT TensorRT Engine:" << std::endl;
+  ss << "  Name: " << name << std::endl;
+  if (!engine_bundle.empty()) {
+    ss << "  Bundled Engines: [" << std::endl;
+    for (const auto& v : deserialize_engine_bundle(engine_bundle, /*with_engines=*/false)) {
+      ss << "    " << v.device << (v.hardware_compatible ? " (hardware compatible)" : "") << std::endl;
+    }
+    ss << "  ]" << std::endl;
+  }
+  if (!is_engine_loaded()) {
+    ss << "  Deserialization deferred until first execution" << std::endl;
+    ss << "  Device: " << device_info << std::endl;
+    return ss.str();
+  }
+  if (dla_loadable) {
+    ss << "  DLA Loadable (cuDLA): [" << std::endl;
+    for (size_t i = 0; i < num_io.first + num_io.second; i++) {
+      bool input = i < num_io.first;
+      const auto& desc = input ? dla_loadable->inputs()[dla_input_order[i]]
+                               : dla_loadable->outputs()[dla_output_order[i - num_io.first]];
+      ss << "    " << (input ? "input " : "output ") << desc.name << ": " << c10::IntArrayRef(desc.shape) << " "
+         << desc.dtype << std::endl;
+    }
+    ss << "  ]" << std::endl;
+    ss << "  Device: " << device_info << std::endl;
+    return ss.str();
+  }
+  ss << "  Inputs: [" << std::endl;
+  for (uint64_t i = 0; i < num_io.first; i++) {
+    ss << "    id: " << i << std::endl;
+    ss << "      name: " << in_binding_names[i].c_str() << std::endl;
+    ss << "      shape: " << primary_exec_ctx()->getTensorShape(in_binding_names[i].c_str()) << std::endl;
+    ss << "      dtype: "
+       << util::TRTDataTypeToScalarType(cuda_engine->getTensorDataType(in_binding_names[i].c_str()))
+       << std::endl;
+  }
+  ss << "  ]" << std::endl;
+  ss << "  Outputs: [" << std::endl;
+  for (uint64_t o = 0; o < num_io.second; o++) {
+    ss << "    id: " << o << std::endl;
+    ss << "      name: " << out_binding_names[o].c_str() << std::endl;
+    ss << "      shape: " << primary_exec_ctx()->getTensorShape(out_binding_names[o].c_str()) << std::endl;
+    ss << "      dtype: "
+       << util::TRTDataTypeToScalarType(cuda_engine->getTensorDataType(out_binding_names[o].c_str()))
+       << std::endl;
+  }
+  ss << "  ]" << std::endl;
+  if (!output_sources.empty()) {
+    ss << "  Returned Outputs: " << serialize_bindings(returned_output_names()) << std::endl;
+  }
+  ss << "  Execution Context Pool Size: " << exec_slots.size() << std::endl;
+  ss << "  Device: " << device_info << std::endl;
+  ss << "  Hardware Compatibility: " << (hardware_compatible ? "Enabled" : "Disabled") << std::endl;
+  if (!lean_runtime_path.empty()) {
+    ss << "  Lean Runtime: " << lean_runtime_path << std::endl;
+  }
+  ss << "  Target Platform: " << target_platform << std::endl;
+  // clang-format on
+  return ss.str();
+}
+
+std::ostream& operator<<(std::ostream& os, const TRTEngine& engine) {
+  os << engine.to_str();
+  return os;
+}
+
+TRTEngine& TRTEngine::operator=(const TRTEngine& other) {
+  rt = other.rt;
+  cuda_engine = other.cuda_engine;
+  dla_loadable = other.dla_loadable;
+  dla_input_order = other.dla_input_order;
+  dla_output_order = other.dla_output_order;
+  device_info = other.device_info;
+  exec_slots = other.exec_slots;
+  shared_device_memory = other.shared_device_memory;
+  shape_sized_device_memory = other.shape_sized_device_memory;
+  cudagraph_pool = other.cudagraph_pool;
+  num_io = other.num_io;
+  output_sources = other.output_sources;
+  serialized_engine_size = other.serialized_engine_size;
+  pending_serialized_engine = other.pending_serialized_engine;
+  engine_bundle = other.engine_bundle;
+  lean_runtime_path = other.lean_runtime_path;
+  engine_host_code_allowed = other.engine_host_code_allowed;
+  device_compatible = other.device_compatible;
+  weights_stripped = other.weights_stripped;
+  weights_missing = other.weights_missing;
+  engine_loaded = other.engine_loaded.load();
+  idle_offload_ms = other.idle_offload_ms.load();
+  offloaded = other.offloaded.load();
+  offloaded_pool_size = other.offloaded_pool_size;
+  return (*this);
+}
+
+void TRTEngine::verify_serialization_fmt(
+    const std::vector<std::string>& serialized_info,
+    const std::string& abi_version) {
+  TORCHTRT_CHECK(
+      serialized_info.size() == SERIALIZATION_LEN,
+      "Program to be deserialized targets an incompatible Torch-TensorRT ABI");
+  TORCHTRT_CHECK(
+      serialized_info[ABI_TARGET_IDX] == abi_version,
+      "Program to be deserialized targets a different Torch-TensorRT ABI Version ("
+          << serialized_info[ABI_TARGET_IDX] << ") than the Torch-TensorRT Runtime ABI Version (" << abi_version
+          << ")");
+}
+
+FlattenedState TRTEngine::__obj_flatten__() {
+  // This method would be called by meta kernel of this custom class and it only needs to return a tuple
+  std::vector<std::string> serialized_info = this->serialize();
+
+  return std::tuple(
+      std::tuple("version", serialized_info[ABI_TARGET_IDX]),
+      std::tuple("name", serialized_info[NAME_IDX]),
+      std::tuple("device_info", serialized_info[DEVICE_IDX]),
+      std::tuple("serialized_engine", serialized_info[ENGINE_IDX]),
+      std::tuple("in_binding_names", serialized_info[INPUT_BINDING_NAMES_IDX]),
+      std::tuple("out_binding_names", serialized_info[OUTPUT_BINDING_NAMES_IDX]),
+      std::tuple("hardware_compatible", serialized_info[HW_COMPATIBLE_IDX]),
+      std::tuple("serialized_metadata", serialized_info[SERIALIZED_METADATA_IDX]),
+      std::tuple("target_platform", serialized_info[TARGET_PLATFORM_IDX]));
+}
+
+SerializedState TRTEngine::serialize_state() {
+  std::string trt_engine;
+  at::Tensor engine_blob = at::empty({0}, at::TensorOptions().dtype(at::kByte));
+  ensure_stripped_plan();
+  if (!engine_bundle.empty()) {
+    // Bundles are always embedded, the engine to load is only known once the bundle has been read
+    engine_blob = at::empty({static_cast<int64_t>(engine_bundle.size())}, at::TensorOptions().dtype(at::kByte));
+    std::memcpy(engine_blob.data_ptr(), engine_bundle.data(), engine_bundle.size());
+  } else if (is_engine_loaded() && !dla_loadable) {
+    auto serialized_trt_engine = serialize_plan();
+    if (!EXTERNAL_ENGINE_DIR.empty()) {
+      trt_engine = write_engine_file(
+          EXTERNAL_ENGINE_DIR, this->name, serialized_trt_engine.data(), serialized_trt_engine.size());
+    } else {
+      // The tensor aliases the serialized engine, which is kept alive by the deleter until the pickler is done with it
+      engine_blob = at::from_blob(
+          const_cast<char*>(serialized_trt_engine.data()),
+          {static_cast<int64_t>(serialized_trt_engine.size())},
+          [serialized_trt_engine](void*) {},
+          at::TensorOptions().dtype(at::kByte));
+    }
+  } else if (is_engine_file_reference(pending_serialized_engine.view()) && !EXTERNAL_ENGINE_DIR.empty()) {
+    trt_engine = pending_serialized_engine.str();
+  } else if (is_engine_file_reference(pending_serialized_engine.view())) {
+    MappedEngineFile engine_file(engine_file_path(pending_serialized_engine.view()));
+    engine_blob = at::empty({static_cast<int64_t>(engine_file.size())}, at::TensorOptions().dtype(at::kByte));
+    std::memcpy(engine_blob.data_ptr(), engine_file.data(), engine_file.size());
+  } else {
+    // Aliased like the engine serialized above, the pickler only reads the tensor
+    auto pending = pending_serialized_engine;
+    engine_blob = at::from_blob(
+        const_cast<char*>(pending.data()),
+        {static_cast<int64_t>(pending.size())},
+        [pending](void*) {},
+        at::TensorOptions().dtype(at::kByte));
+  }
+
+  if (ENGINE_COMPRESSION_LEVEL > 0 && trt_engine.empty()) {
+    auto compressed = compress_engine(engine_blob.data_ptr(), engine_blob.numel(), ENGINE_COMPRESSION_LEVEL);
+    engine_blob = at::empty({static_cast<int64_t>(compressed.size())}, at::TensorOptions().dtype(at::kByte));
+    std::memcpy(engine_blob.data_ptr(), compressed.data(), compressed.size());
+  }
+  return std::make_tuple(serialize_info(std::move(trt_engine)), engine_blob);
+}
+
+std::vector<std::string> TRTEngine::serialize() {
+  std::string trt_engine;
+  ensure_stripped_plan();
+  if (!engine_bundle.empty()) {
+    trt_engine = encode_embedded_engine(engine_bundle.data(), engine_bundle.size());
+  } else if (is_engine_loaded() && !dla_loadable) {
+    // Serialize TensorRT engine
+    auto serialized_trt_engine = serialize_plan();
+    if (!EXTERNAL_ENGINE_DIR.empty()) {
+      trt_engine = write_engine_file(
+          EXTERNAL_ENGINE_DIR, this->name, serialized_trt_engine.data(), serialized_trt_engine.size());
+    } else {
+      trt_engine = encode_embedded_engine(serialized_trt_engine.data(), serialized_trt_engine.size());
+    }
+  } else if (is_engine_file_reference(pending_serialized_engine.view())) {
+    // Engines which were never executed can be saved again without being deserialized
+    if (!EXTERNAL_ENGINE_DIR.empty()) {
+      trt_engine = pending_serialized_engine.str();
+    } else {
+      MappedEngineFile engine_file(engine_file_path(pending_serialized_engine.view()));
+      trt_engine = encode_embedded_engine(engine_file.data(), engine_file.size());
+    }
+  } else {
+    trt_engine = encode_embedded_engine(pending_serialized_engine.data(), pending_serialized_engine.size());
+  }
+
+  return serialize_info(std::move(trt_engine));
+}
+
+void TRTEngine::ensure_stripped_plan() {
+  // Only engines compiled in this process can be marked before they are loaded, their pending plan has the weights
+  if (weights_stripped && engine_bundle.empty() && !is_engine_loaded()) {
+    ensure_tensorrt_engine("Weight stripping");
+  }
+}
+
+util::SerializedEngine TRTEngine::serialize_plan() {
+  if (!weights_stripped) {
+    return util::SerializedEngine(make_trt(cuda_engine->serialize()));
+  }
+#if NV_TENSORRT_MAJOR >= 10
+  auto config = make_trt(cuda_engine->createSerializationConfig());
+  config->setFlag(nvinfer1::SerializationFlag::kEXCLUDE_WEIGHTS);
+  auto plan = make_trt(cuda_engine->serializeWithConfig(*config));
+  TORCHTRT_CHECK((plan.get() != nullptr), "Unable to serialize engine " << name << " without its weights");
+  std::string stripped;
+  stripped.reserve(WEIGHTS_STRIPPED_MAGIC.size() + plan->size());
+  stripped.append(WEIGHTS_STRIPPED_MAGIC);
+  stripped.append(static_cast<const char*>(plan->data()), plan->size());
+  return util::SerializedEngine(std::move(stripped));
+#else
+  TORCHTRT_THROW_ERROR("Engine " << name << " can only be saved without its weights with TensorRT 10 or later");
+#endif
+}
+
+util::SerializedEngine TRTEngine::get_serialized_engine() {
+  if (is_engine_loaded() && !dla_loadable) {
+    return util::SerializedEngine(make_trt(this->cuda_engine->serialize()));
+  } else if (is_engine_file_reference(pending_serialized_engine.view())) {
+    MappedEngineFile engine_file(engine_file_path(pending_serialized_engine.view()));
+    return util::SerializedEngine(std::string((const char*)engine_file.data(), engine_file.size()));
+  }
+  return pending_serialized_engine;
+}
+
+std::vector<EngineBundleVariant> TRTEngine::get_bundle_variants() {
+  if (!engine_bundle.empty()) {
+    return deserialize_engine_bundle(engine_bundle);
+  }
+  return {{device_info, hardware_compatible, get_serialized_engine().str()}};
+}
+
+void TRTEngine::add_bundle_variants(const std::vector<EngineBundleVariant>& variants) {
+  auto bundled = get_bundle_variants();
+  auto num_bundled = bundled.size();
+  for (const auto& v : variants) {
+    bool duplicate = false;
+    for (const auto& b : bundled) {
+      duplicate |= b.device.device_type == v.device.device_type &&
+          b.device.getSMCapability() == v.device.getSMCapability() && b.hardware_compatible == v.hardware_compatible;
+    }
+    if (duplicate) {
+      LOG_WARNING(
+          "Engine " << name << " already bundles an engine built for " << v.device.getSMCapability()
+                    << (v.hardware_compatible ? " (hardware compatible)" : "") << ", skipping the one built for "
+                    << v.device);
+      continue;
+    }
+    bundled.push_back(v);
+  }
+  if (bundled.size() != num_bundled) {
+    engine_bundle = serialize_engine_bundle(bundled);
+  }
+}
+
+size_t TRTEngine::num_outputs() const {
+  return output_sources.empty() ? num_io.second : output_sources.size();
+}
+
+std::vector<std::string> TRTEngine::returned_output_names() const {
+  if (output_sources.empty()) {
+    return out_binding_names;
+  }
+  std::vector<std::string> names;
+  for (const auto& source : output_sources) {
+    names.push_back(
+        source.kind == OutputSource::kBinding ? out_binding_names[source.index]
+                                              : util::OutputAliasName(source.kind == OutputSource::kInput, source.index));
+  }
+  return names;
+}
+
+std::vector<std::string> TRTEngine::split_output_aliases(
+    const std::vector<std::string>& returned,
+    size_t num_inputs) {
+  output_sources.clear();
+  std::vector<std::string> bound;
+  bool aliased = false;
+  for (size_t o = 0; o < returned.size(); o++) {
+    bool of_input = false;
+    size_t index = 0;
+    if (util::ParseOutputAliasName(returned[o], of_input, index)) {
+      TORCHTRT_CHECK(
+          of_input ? index < num_inputs : index < o,
+          "Output " << o << " of engine " << name << " is returned as " << returned[o]
+                    << ", which is not an input or an earlier output");
+      output_sources.push_back({of_input ? OutputSource::kInput : OutputSource::kOutput, index});
+      aliased = true;
+    } else {
+      output_sources.push_back({OutputSource::kBinding, bound.size()});
+      bound.push_back(returned[o]);
+    }
+  }
+  if (!aliased) {
+    output_sources.clear();
+  }
+  return bound;
+}
 
+std::vector<std::string> TRTEngine::serialize_info(std::string serialized_engine) {
   // Adding device info related meta data to the serialized file
-  auto trt_engine = std::string((const char*)serialized_trt_engine->data(), serialized_trt_engine->size());
 
   std::vector<std::string> serialized_info;
   serialized_info.resize(SERIALIZATION_LEN);
@@ -413,9 +2539,9 @@ std::vector<std::string> TRTEngine::serialize() {
   serialized_info[ABI_TARGET_IDX] = ABI_VERSION;
   serialized_info[NAME_IDX] = this->name;
   serialized_info[DEVICE_IDX] = this->device_info.serialize();
-  serialized_info[ENGINE_IDX] = base64_encode(trt_engine);
+  serialized_info[ENGINE_IDX] = std::move(serialized_engine);
   serialized_info[INPUT_BINDING_NAMES_IDX] = serialize_bindings(this->in_binding_names);
-  serialized_info[OUTPUT_BINDING_NAMES_IDX] = serialize_bindings(this->out_binding_names);
+  serialized_info[OUTPUT_BINDING_NAMES_IDX] = serialize_bindings(returned_output_names());
   serialized_info[HW_COMPATIBLE_IDX] = this->hardware_compatible ? "1" : "0";
   serialized_info[SERIALIZED_METADATA_IDX] = this->serialized_metadata;
   serialized_info[TARGET_PLATFORM_IDX] = this->target_platform.serialize();
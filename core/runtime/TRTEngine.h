@@ -1,17 +1,39 @@
 #pragma once
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <filesystem>
 #include <fstream>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <unordered_map>
 #include <utility>
 
 #include "ATen/core/function_schema.h"
+#include "ATen/cuda/CUDAEvent.h"
 #include "ATen/cuda/CUDAGraph.h"
 #include "NvInfer.h"
 #include "c10/cuda/CUDAStream.h"
 #include "torch/custom_class.h"
 
+#include "core/runtime/BindingFormat.h"
+#include "core/runtime/CudaGraphAdmission.h"
+#include "core/runtime/CudaGraphCache.h"
+#include "core/runtime/CudaGraphPool.h"
+#include "core/runtime/CudlaLoadable.h"
+#include "core/runtime/DeviceMemoryArena.h"
+#include "core/runtime/DynamicBatcher.h"
+#include "core/runtime/EngineBundle.h"
+#include "core/runtime/EnqueueAdmission.h"
+#include "core/runtime/MemoryReclaimer.h"
+#include "core/runtime/OutputAllocator.h"
+#include "core/runtime/SampledLayerProfiler.h"
+#include "core/runtime/ShapeHistogram.h"
+#include "core/runtime/ShapeKey.h"
+#include "core/runtime/StateBindings.h"
+#include "core/runtime/TRTEngineMetrics.h"
 #include "core/runtime/TRTEngineProfiler.h"
 #include "core/util/prelude.h"
 
@@ -30,13 +52,21 @@ using FlattenedState = std::tuple<
     std::tuple<std::string, std::string>, // serialized metadata
     std::tuple<std::string, std::string>>; // Platform
 
+// Pickled state of an engine: the serialized info (with ENGINE_IDX left empty unless it holds an engine file
+// reference) and the engine itself as a uint8 tensor
+using SerializedState = std::tuple<std::vector<std::string>, at::Tensor>;
+
+// Plans saved without their weights (SerializationFlag::kEXCLUDE_WEIGHTS) are stored behind WEIGHTS_STRIPPED_MAGIC,
+// engines loaded from them have to be refit before they can run
+const std::string WEIGHTS_STRIPPED_MAGIC = "TORCHTRT_WEIGHTS_STRIPPED_1";
+
 struct TorchTRTRuntimeStates {
   // Indicates whether CUDAGraphs were enabled in the previous execute_engine
   bool old_cudagraphs;
   // Indicates whether pre-allocated output was enabled in the previous execute_engine
   bool old_pre_allocated_outputs;
   // Indicates whether context has changed
-  bool context_changed;
+  std::atomic<bool> context_changed;
 
   // Evaluates whether certain conditions are met to enable CUDA Graph recording/reset or to reuse pre-allocated outputs
   // based on the current and previous states, as well as input shape has changed
@@ -69,11 +99,143 @@ struct TorchTRTRuntimeStates {
   }
 };
 
+// Output sets pre-allocated for one shape key. Sets are handed out round robin and a set is only reused once the
+// caller has dropped every reference to it (and its storage), otherwise it is replaced with a new allocation. Reuse
+// is ordered after any work the caller enqueued on the outputs since the engine stream waits on the caller stream
+struct PreAllocatedOutputRing {
+  std::vector<std::vector<at::Tensor>> sets;
+  size_t next = 0;
+};
+
+// All of the state which is mutated by a single call to execute_engine. Each slot owns its own
+// execution context so that concurrent callers of the same engine do not need to serialize on one context
+struct TRTExecutionSlot {
+  std::shared_ptr<nvinfer1::IExecutionContext> exec_ctx;
+  TorchTRTRuntimeStates runtime_states;
+
+  // CUDAGraph-Related Functionality
+  CudaGraphCache cudagraph_cache;
+  CudaGraphAdmission cudagraph_admission;
+  // Entry of cudagraph_cache the current execution replays or captures, kept when the execution reclaims memory. Only
+  // compared against, it may be stale once the execution is done
+  const CudaGraphCacheEntry* cudagraph_in_use = nullptr;
+  at::cuda::CUDAStream engine_stream = c10::cuda::getDefaultCUDAStream();
+  at::cuda::CUDAStream caller_stream = c10::cuda::getDefaultCUDAStream();
+  // Streams from the c10 pool TensorRT runs independent branches of the engine on, forked from and joined back into
+  // the stream the engine is enqueued on. Bound to aux_streams_device
+  std::vector<cudaStream_t> aux_streams;
+  int64_t aux_streams_device = -1;
+  // Reused across executions to order the engine stream after the caller stream and back
+  at::cuda::CUDAEvent caller_exec_complete;
+  at::cuda::CUDAEvent trt_exec_complete;
+  ShapeKey shape_key;
+  // The dtypes and devices of the inputs of shape_key passed validation, reset when the key changes
+  bool inputs_validated = false;
+  // Device multi-device safe mode found all inputs of shape_key on without moving any, -1: none
+  int64_t inputs_on_device = -1;
+  std::unordered_map<ShapeKey, PreAllocatedOutputRing> pre_allocated_outputs;
+
+  // Per-call scratch state kept on the slot so the steady state path does not reallocate it
+  std::vector<at::Tensor> formatted_inputs;
+  // Pinned int64 host copies of shape tensor inputs (undefined for other inputs), TensorRT reads them from the host
+  std::vector<at::Tensor> shape_tensor_staging;
+  at::cuda::CUDAEvent shape_tensor_staged;
+  // Pinned buffers host inputs are packed into when the engine stages host inputs, used in turns so that filling one
+  // overlaps with the transfer out of the other. The transfers run on host_staging_stream
+  std::array<at::Tensor, 2> host_staging;
+  std::array<at::cuda::CUDAEvent, 2> host_staging_done;
+  size_t host_staging_next = 0;
+  std::optional<c10::cuda::CUDAStream> host_staging_stream;
+  // Output shapes inferred for the current shape key
+  std::vector<std::vector<int64_t>> output_shapes;
+  // Outputs whose shapes are only known once the engine has run, for the current shape key
+  std::vector<uint8_t> output_is_data_dependent;
+  // Memory for data dependent outputs, created on first use
+  std::unique_ptr<DynamicOutputAllocator> output_allocator;
+  // Recyclable output storage per output index, used when the engine's output arena is enabled
+  std::vector<std::vector<at::Tensor>> output_arena;
+
+  // Device memory currently bound to exec_ctx, only used when the engine runs out of a shared arena or shape sized
+  // device memory
+  void* bound_device_memory = nullptr;
+  // Device memory sized to the largest input shapes the slot ran with, used by engines with shape sized device memory.
+  // Shared by the contexts of every profile of the slot, which never run at the same time
+  at::Tensor shape_sized_device_memory;
+
+  // Engines with several optimization profiles keep one context per profile, created on first use, so switching
+  // profiles never invalidates the shapes or captured graphs of another profile. exec_ctx is the context of
+  // active_profile
+  std::vector<std::shared_ptr<nvinfer1::IExecutionContext>> profile_contexts;
+  std::vector<void*> profile_device_memory;
+  int32_t active_profile = 0;
+
+  // TRTEngine::persistent_cache_limit last applied to the contexts of the slot, contexts start without persisting L2
+  int64_t applied_persistent_cache_limit = 0;
+
+  // Set while a caller has the slot checked out
+  std::atomic<bool> in_use = {false};
+};
+
+// Per-binding metadata resolved once when the engine is constructed so that the execution hot path does not need
+// string keyed lookups into the engine. Stored as a struct of arrays indexed by PyTorch input / output index
+struct TRTBindingTable {
+  // Point into TRTEngine::in_binding_names / out_binding_names
+  std::vector<const char*> input_names;
+  std::vector<at::ScalarType> input_types;
+  std::vector<uint8_t> input_is_shape_tensor;
+  std::vector<int32_t> input_ranks;
+  std::vector<int32_t> input_trt_indices;
+  std::vector<BindingFormat> input_formats;
+
+  std::vector<const char*> output_names;
+  std::vector<at::ScalarType> output_types;
+  std::vector<int32_t> output_ranks;
+  std::vector<int32_t> output_trt_indices;
+  std::vector<BindingFormat> output_formats;
+
+  // Input shape ranges of each optimization profile, indexed by [profile][PyTorch input index]. Shape tensor inputs
+  // are not used to select profiles and have empty ranges
+  std::vector<std::vector<nvinfer1::Dims>> profile_min;
+  std::vector<std::vector<nvinfer1::Dims>> profile_opt;
+  std::vector<std::vector<nvinfer1::Dims>> profile_max;
+};
+
+struct TRTEngine;
+
+// RAII handle for a checked out execution slot, returns the slot to the pool on destruction
+class ExecutionSlotGuard {
+ public:
+  ExecutionSlotGuard(TRTEngine* engine, std::shared_ptr<TRTExecutionSlot> slot);
+  ExecutionSlotGuard(const ExecutionSlotGuard&) = delete;
+  ExecutionSlotGuard& operator=(const ExecutionSlotGuard&) = delete;
+  ~ExecutionSlotGuard();
+  TRTExecutionSlot* operator->() const {
+    return slot.get();
+  }
+  TRTExecutionSlot& operator*() const {
+    return *slot;
+  }
+
+ private:
+  TRTEngine* engine;
+  std::shared_ptr<TRTExecutionSlot> slot;
+};
+
+// Quality of service class of an engine, see TRTEngine::set_qos_class
+typedef enum {
+  QOS_DEFAULT = 0,
+  QOS_LATENCY_CRITICAL,
+  QOS_BACKGROUND,
+} EngineQoSClass;
+
 struct TRTEngine : torch::CustomClassHolder {
-  // Each engine needs it's own runtime object
+  // Shared with the other engines on the same device unless SHARE_TRT_RUNTIME is disabled
   std::shared_ptr<nvinfer1::IRuntime> rt;
   std::shared_ptr<nvinfer1::ICudaEngine> cuda_engine;
-  std::shared_ptr<nvinfer1::IExecutionContext> exec_ctx;
+  // Set instead of cuda_engine for DLA standalone loadables, which run through cuDLA (see CudlaLoadable)
+  std::shared_ptr<CudlaLoadable> dla_loadable;
+  // Pool of execution contexts, index 0 is always present and is the context used for profiling and introspection
+  std::vector<std::shared_ptr<TRTExecutionSlot>> exec_slots;
   std::pair<uint64_t, uint64_t> num_io;
   std::string name;
   RTDevice device_info;
@@ -85,15 +247,34 @@ struct TRTEngine : torch::CustomClassHolder {
 
   std::vector<std::string> in_binding_names = {}; // ITO: PYT IDX
   std::vector<std::string> out_binding_names = {}; // ITO: PYT IDX
+  // Where each returned output comes from (ITO: PYT IDX), empty if the engine returns exactly its output bindings. An
+  // output which TorchScript returns as an input of the block, or as an earlier output, is not bound by the engine and
+  // is returned as that tensor instead (see BuilderSettings::alias_outputs)
+  struct OutputSource {
+    enum { kBinding, kInput, kOutput } kind;
+    size_t index; // Into out_binding_names, the inputs or the returned outputs
+  };
+  std::vector<OutputSource> output_sources = {};
 
   bool hardware_compatible = false; // Whether the engine was compiled in hardware compatible mode
+  // Saved without its weights, which the engine keeps while it is in memory (see BuilderSettings::strip_weights)
+  bool weights_stripped = false;
+  // Loaded from a plan saved without its weights, the engine cannot run until it is refit
+  bool weights_missing = false;
+  bool has_shape_tensor_inputs = false; // Whether any input is a shape tensor (isShapeInferenceIO)
+  // Whether any output has a data dependent shape (e.g. aten::nonzero), such engines cannot run with CUDA graphs
+  bool has_data_dependent_outputs = false;
+  int32_t num_optimization_profiles = 1;
+  int32_t num_aux_streams = 0; // Auxiliary streams TensorRT runs the engine with (ICudaEngine::getNbAuxStreams)
+  int64_t serialized_engine_size = 0; // Size of the plan the engine was deserialized from
+  TRTBindingTable binding_table;
   std::string serialized_metadata; // This is a base64 encoded pkl object used to store metadata such as settings used
                                    // in compilation
   Platform target_platform;
 
   ~TRTEngine();
   TRTEngine(
-      const std::string& serialized_engine,
+      const util::SerializedEngine& serialized_engine,
       const RTDevice& cuda_device,
       const std::vector<std::string>& in_binding_names,
       const std::vector<std::string>& out_binding_names,
@@ -101,55 +282,331 @@ struct TRTEngine : torch::CustomClassHolder {
       bool hardware_compatible = false,
       const std::string& serialized_metadata = "");
 
+  // An engine bundle at ENGINE_IDX is resolved to the variant selected for this machine (see
+  // select_engine_bundle_variant), the engine keeps the whole bundle to save it again
   TRTEngine(std::vector<std::string> serialized_info);
+  // serialized_info of the selected variant of engine_bundle (empty if the engine is not bundled), the engine is moved
+  // out of serialized_info
+  TRTEngine(std::vector<std::string>& serialized_info, std::string engine_bundle);
 
   TRTEngine(
       const std::string& mod_name,
-      const std::string& serialized_engine,
+      const util::SerializedEngine& serialized_engine,
       const RTDevice& cuda_device,
       const std::vector<std::string>& in_binding_names,
       const std::vector<std::string>& out_binding_names,
       const Platform& target_platform = get_current_platform(),
       bool hardware_compatible = false,
-      const std::string& serialized_metadata = "");
+      const std::string& serialized_metadata = "",
+      bool lazy_deserialization = false);
 
   TRTEngine& operator=(const TRTEngine& other);
   std::string to_str() const;
-  static void verify_serialization_fmt(const std::vector<std::string>& serialized_info);
+  // Number of outputs the engine returns, including those which alias an input or another output
+  size_t num_outputs() const;
+  // Binding names of the returned outputs with util::OutputAliasName for the aliased ones, as they are serialized
+  std::vector<std::string> returned_output_names() const;
+  static void verify_serialization_fmt(
+      const std::vector<std::string>& serialized_info,
+      const std::string& abi_version);
   void enable_profiling();
   void disable_profiling();
+  // Time of every layer accumulated since profiling was enabled (or reset), by layer name in execution order:
+  // {"total_ms": ..., "count": ..., "mean_ms": ...}. Empty while profiling is off
+  c10::Dict<std::string, c10::Dict<std::string, double>> get_layer_profile();
+  void reset_layer_profile();
+  // Layer profiling of a sample of the executions, cheap enough for engines serving traffic (see SampledLayerProfiler).
+  // Ignored while enable_profiling is on and for executions replaying CUDA graphs, which report no layer times
+  void enable_layer_sampling(LayerSamplingConfig config);
+  void disable_layer_sampling();
+  // Statistics of the current report as JSON
+  std::string get_layer_samples();
   std::string get_engine_layer_info();
 
   void dump_engine_layer_info_to_file(const std::string& path);
   void dump_engine_layer_info();
   int64_t get_device_memory_budget();
+  // Waits for in-flight executions to finish since the execution contexts are recreated
   bool set_device_memory_budget(int64_t budget);
+  // Applies the budget assigned by the weight streaming arbiter if no execution is in flight, otherwise it is left
+  // pending for the next execution
+  void apply_pending_device_memory_budget();
   int64_t get_streamable_device_memory_budget();
   int64_t get_automatic_device_memory_budget();
+  // Meta tensors with the shapes and dtypes of the outputs for the given input shapes, used while tracing. Shapes are
+  // inferred on a context of their own, without device memory, and memoized per input shapes
   std::vector<at::Tensor> infer_outputs(std::vector<std::vector<int64_t>> input_shapes);
   void set_pre_allocated_outputs(bool enable);
-  TorchTRTRuntimeStates runtime_states;
+  // Device memory held by the engine on its own device, in bytes:
+  //  - weights: device resident weights, the size of the plan less the streamed out weights (engines deduplicated
+  //    through the engine registry share these)
+  //  - activations: scratch memory owned by the execution contexts of every slot
+  //  - shared_activations: size of the shared device memory arena the engine runs out of (shared with other engines)
+  //  - cudagraphs: input and output buffers held by captured CUDA graphs
+  //  - shared_cudagraphs: size of the buffer region of the shared CUDA graph pool (shared with other engines)
+  //  - io_buffers: pre-allocated outputs, output arena and data dependent output buffers
+  //  - total: everything but shared_activations and shared_cudagraphs
+  // Engines which are not loaded yet hold no device memory. Slots are inspected while they are idle so this waits for
+  // in-flight executions
+  c10::Dict<std::string, int64_t> get_memory_usage();
+  // Releases the device memory of the engine covered by stage (see ReclaimStage) from its idle slots, and the CUDA
+  // graphs of requester (other than the one it is using) if it is a slot of this engine. Weight streaming budgets are
+  // only shrunk while no slot is checked out. Never waits, returns 0 if the slot pool is locked. Returns the bytes of
+  // device memory the engine let go of
+  int64_t reclaim_device_memory(ReclaimStage stage, TRTExecutionSlot* requester = nullptr);
+
+  // Execution context pool. Resizing the pool waits for in-flight executions to finish, but it should be done
+  // before the engine is shared between threads since the fast checkout path does not take the lock
+  int64_t get_execution_context_pool_size();
+  void set_execution_context_pool_size(int64_t size);
+  // Checks out a free execution slot, blocking only if every slot in the pool is currently in use
+  std::unique_ptr<ExecutionSlotGuard> acquire_execution_slot();
+  void release_execution_slot(TRTExecutionSlot* slot);
+  // CUDA graph cache limits (applied to each execution slot) and counters (aggregated over all slots)
+  int64_t get_cudagraph_cache_max_entries();
+  void set_cudagraph_cache_max_entries(int64_t max_entries);
+  int64_t get_cudagraph_cache_max_bytes();
+  void set_cudagraph_cache_max_bytes(int64_t max_bytes);
+  c10::Dict<std::string, int64_t> get_cudagraph_cache_stats();
+  void reset_cudagraph_cache();
+  // Caller owned input tensors which are guaranteed to be passed again (same storage) on subsequent calls. CUDA graphs
+  // are captured directly against them so replay does not need a device to device copy. If a different tensor is
+  // passed for a registered input, its contents are copied into the registered tensor. Should be set before the
+  // engine is shared between threads
+  void register_cudagraph_inputs(std::vector<at::Tensor> inputs);
+  void clear_cudagraph_inputs();
+  bool is_registered_cudagraph_input(size_t pyt_idx, const at::Tensor& input) const;
+  // Run the engine out of device scratch memory shared with other engines instead of memory owned by each of its
+  // execution contexts. Engines sharing an arena are serialized on the GPU, so this is meant for engines which run
+  // one after another such as the segments of a partitioned module. Recreates the execution contexts, so it should
+  // be set before the engine is shared between threads
+  void set_shared_device_memory(std::shared_ptr<DeviceMemoryArena> arena);
+  // Attaches this engine to the arena of other (creating one if other does not use one yet)
+  void share_device_memory(c10::intrusive_ptr<TRTEngine> other);
+  // Run the engine out of device memory sized to the input shapes of each execution (from the caching allocator)
+  // instead of memory each execution context reserves for the largest shapes of its profile. The memory of an
+  // execution slot is only reallocated when a shape needs more than it has, so engines with wide dynamic ranges only
+  // pay for the shapes they run with. Ignored while the engine uses shared device memory. Recreates the execution
+  // contexts, so it should be set before the engine is shared between threads. Defaults to SHAPE_SIZED_DEVICE_MEMORY
+  bool get_shape_sized_device_memory();
+  void set_shape_sized_device_memory(bool enabled);
+  // Whether the contexts of the engine have their memory bound by bind_shape_sized_device_memory
+  bool uses_shape_sized_device_memory() const;
+  // Offload the engine once it has not executed for this long, 0: never (see EngineOffloader). Offloading releases the
+  // execution contexts and the ICudaEngine, with its weights, and keeps the plan in pinned host memory. The next
+  // execution deserializes it again, which restores the execution context pool but not the captured CUDA graphs.
+  // Defaults to IDLE_OFFLOAD_MS
+  int64_t get_idle_offload_ms();
+  void set_idle_offload_ms(int64_t timeout_ms);
+  // Offloads the engine right away. Returns false, leaving the engine loaded, if an execution is in flight or the
+  // engine cannot be offloaded (DLA loadables and engines still missing their weights)
+  bool offload();
+  // Whether the engine was offloaded and not executed since
+  bool is_offloaded() const;
+  // Capture the CUDA graphs of the engine into a graph memory pool shared with other engines, with the persistent
+  // buffers of the graphs carved from one region of the pool. Engines sharing a pool are serialized from the copy in
+  // of their inputs until the copy out of their outputs. Drops the captured graphs
+  void set_cudagraph_pool(std::shared_ptr<CudaGraphPool> pool);
+  // Attaches this engine to the CUDA graph pool of other (creating one if other does not use one yet)
+  void share_cudagraph_pool(c10::intrusive_ptr<TRTEngine> other);
+  // Replaces the weights of an engine built with refit enabled, weights maps every refittable weight name of the engine
+  // to its new values. Waits for in-flight executions. Engines sharing their ICudaEngine with other TRTEngines (see
+  // DEDUPLICATE_ENGINES) refit a private copy so the others keep their weights. Replicas are refit as well. Engines
+  // loaded without their weights run once refit. With TensorRT 10 the weights are read from the device of the engine
+  void refit(const std::unordered_map<std::string, at::Tensor>& weights);
+  // Exchanges the TensorRT engine of this engine with the one of replacement, which must have the same bindings, so
+  // a loaded module switches to an engine prepared (and warmed up) in the background. Waits for in-flight executions
+  // of both, which finish on the engine they started with. Runtime settings stay with each TRTEngine, replacement
+  // holds the previous engine afterwards: swap again to roll back, drop replacement to release it
+  void swap_engine(c10::intrusive_ptr<TRTEngine> replacement);
+  // Always-on runtime counters and latency histograms, cheap enough to scrape from a serving process
+  c10::Dict<std::string, int64_t> get_runtime_metrics();
+  c10::Dict<std::string, c10::List<int64_t>> get_latency_histograms();
+  void reset_runtime_metrics();
+  // Time spent decoding, deserializing and creating the first execution context of the engine, see EngineLoadTimes
+  c10::Dict<std::string, int64_t> get_load_times();
+  // Input shapes the engine (and its replicas) executed with while RECORD_INPUT_SHAPES was set, see
+  // derive_shape_profiles to turn them into optimization profiles
+  c10::Dict<std::string, int64_t> get_input_shape_histogram();
+  void reset_input_shape_histogram();
+  // Engines loaded with lazy deserialization enabled keep the serialized engine and only deserialize it (and create
+  // their execution contexts) on first use. warmup forces this ahead of the first execution and, for iterations > 0,
+  // also runs the engine that many times at the min, opt and max input shapes of every optimization profile (on every
+  // replica) so lazy kernel loading, tactic initialization and allocator growth are paid before serving traffic. CUDA
+  // graphs are captured for these shapes if they are enabled. Engines with shape tensor inputs are only loaded since
+  // there are no profile shapes for their values. Warmup executions are not kept in the runtime metrics
+  void warmup(int64_t iterations = 0);
+  // Runtime the engine is deserialized with, only settable before it is deserialized (see
+  // LAZY_ENGINE_DESERIALIZATION). With a lean runtime path, the engine is deserialized with the TensorRT lean runtime
+  // library at that path (IRuntime::loadRuntime), which runs version compatible engines built without their lean
+  // runtime. Allowing engine host code lets the runtime execute the lean runtime embedded in version compatible
+  // engines (IRuntime::setEngineHostCodeAllowed). Default to LEAN_RUNTIME_PATH and ENGINE_HOST_CODE_ALLOWED
+  std::string get_lean_runtime_path();
+  void set_lean_runtime_path(std::string path);
+  bool get_engine_host_code_allowed();
+  void set_engine_host_code_allowed(bool allowed);
+  bool is_engine_loaded() const;
+  // runtime: IRuntime to deserialize with, defaults to the shared runtime of the engine's device (see
+  // get_shared_trt_runtime)
+  void ensure_engine_loaded(std::shared_ptr<nvinfer1::IRuntime> runtime = nullptr);
+  // Executes a DLA loadable on the current CUDA stream, the engine execution features of IExecutionContext (CUDA
+  // graphs, batching, optimization profiles, state bindings) do not apply to loadables
+  std::vector<at::Tensor> run_dla_loadable(
+      const std::vector<at::Tensor>& inputs,
+      const std::vector<at::Tensor>* caller_outputs = nullptr);
+  // Returns the optimization profile whose ranges contain the given input shapes and whose optimal shapes are the
+  // closest to them, 0 if no profile contains them
+  int32_t select_optimization_profile(const std::vector<c10::IntArrayRef>& input_shapes) const;
+  // Makes profile the active profile of slot, creating the context for it if needed
+  void activate_optimization_profile(TRTExecutionSlot& slot, int32_t profile);
+  // Batch buckets. When set, batched inputs are padded along their first dimension up to the smallest bucket which
+  // holds them and outputs are sliced back, so dynamic batch traffic only ever runs (and captures CUDA graphs for)
+  // the bucket shapes. Batches larger than the largest bucket run unpadded. Should be set before the engine is shared
+  // between threads
+  std::vector<int64_t> get_batch_buckets();
+  void set_batch_buckets(std::vector<int64_t> buckets);
+  // Smallest bucket which holds batch, batch itself if there is none
+  int64_t select_batch_bucket(int64_t batch) const;
+  // Dynamic batching of concurrent executions (see DynamicBatcher). A window of 0 disables batching, a max batch size
+  // of 0 uses the largest batch size supported by the optimization profiles. Should be set before the engine is
+  // shared between threads
+  int64_t get_dynamic_batching_window_us();
+  void set_dynamic_batching_window_us(int64_t window_us);
+  int64_t get_dynamic_batching_max_batch_size();
+  void set_dynamic_batching_max_batch_size(int64_t max_batch_size);
+  // Multi-GPU replicas. The engine is deserialized once more on each of the given devices (other than its own) and
+  // executions are dispatched to the replica on the device holding the inputs, or to the least loaded replica for
+  // host inputs, relative to the number of SMs of each device so MIG instances of different sizes get their share.
+  // Replicas take over the runtime settings of the engine at the time they are created. Should be set before the
+  // engine is shared between threads
+  std::vector<int64_t> get_replica_devices();
+  void set_replica_devices(std::vector<int64_t> device_ids);
+  // The same devices by UUID (or an unambiguous prefix of it), which also identifies the MIG instances of a GPU
+  std::vector<std::string> get_replica_device_uuids();
+  void set_replica_device_uuids(std::vector<std::string> uuids);
+  // State bindings (see StateBindings). Output output_names[i] is fed back as input input_names[i] of the next
+  // execution, executions are serialized and only pass and return the other bindings. Not for engines run by the
+  // graph of a compiled module, which passes every binding. Engines with state bindings are not batched, padded or
+  // replicated. Empty names remove them. Should be set before the engine is shared between threads
+  void set_state_bindings(std::vector<std::string> output_names, std::vector<std::string> input_names);
+  // Sets the states to initial_states (one per state binding, in order) or, if empty, to zeros. States with dynamic
+  // shapes have to be set before the first execution
+  void reset_state(std::vector<at::Tensor> initial_states);
+  // Copies of the current states, in the order of the state bindings
+  std::vector<at::Tensor> get_state();
+  // Outputs returned on the host. They are copied into pinned memory on the caller stream as part of the execution,
+  // so they are valid once the caller stream is past it (e.g. an event recorded after the call has completed). State
+  // outputs cannot be host outputs. Empty names return every output on the device
+  void set_host_outputs(std::vector<std::string> output_names);
+  std::vector<std::string> get_host_outputs();
+  // Quality of service class. Latency critical engines enqueue on high priority streams so their kernels are
+  // scheduled ahead of those of other engines sharing the GPU, background engines are subject to the process wide
+  // limit on in-flight background executions per device (BACKGROUND_MAX_IN_FLIGHT). Has no effect on the stream
+  // priority in caller stream mode. Should be set before the engine is shared between threads
+  int64_t get_qos_class();
+  void set_qos_class(int64_t qos_class);
+  // Persisting L2 cache, in bytes, TensorRT may use for the execution contexts of the engine to keep tensors in L2
+  // between executions (IExecutionContext::setPersistentCacheLimit). -1 (automatic) uses the max persisting L2 size of
+  // the device, there is none before Ampere. The persisting L2 set-aside of the device is raised to the limit if it is
+  // smaller. Applied by each slot on its next execution
+  int64_t get_persistent_cache_limit();
+  void set_persistent_cache_limit(int64_t limit);
+  // Bytes persistent_cache_limit amounts to on the device of the engine
+  int64_t get_resolved_persistent_cache_limit();
+  void apply_persistent_cache_limit(TRTExecutionSlot& slot);
+  // Engine (this one or a replica) which should execute the given inputs
+  c10::intrusive_ptr<TRTEngine> select_replica(const std::vector<at::Tensor>& inputs);
+  // Primary execution context (slot 0)
+  std::shared_ptr<nvinfer1::IExecutionContext> primary_exec_ctx() const;
   friend std::ostream& operator<<(std::ostream& os, const TRTEngine& engine);
   static const char BINDING_DELIM = '%';
 
   // Serde re-export functionality
   FlattenedState __obj_flatten__();
+  // Embeds the engine as base64, or writes it to EXTERNAL_ENGINE_DIR and only stores a reference when set
   std::vector<std::string> serialize();
+  // Binary format used when pickling the engine, the engine bytes are stored as a tensor instead of base64
+  SerializedState serialize_state();
+  // Plan the engine was built as, read back from its engine file if it only holds a reference to one
+  util::SerializedEngine get_serialized_engine();
+  // Engines built for each GPU architecture the engine is bundled for, only this engine if it is not bundled
+  std::vector<EngineBundleVariant> get_bundle_variants();
+  // Adds engines built from the same segment for other GPUs to the bundle of the engine. Variants built for the same
+  // SM (and hardware compatibility) as one already in the bundle are skipped
+  void add_bundle_variants(const std::vector<EngineBundleVariant>& variants);
 
-  // CUDAGraph-Related Functionality
-  at::cuda::CUDAGraph cudagraph = {};
-  at::cuda::CUDAStream engine_stream = c10::cuda::getDefaultCUDAStream();
-  at::cuda::CUDAStream caller_stream = c10::cuda::getDefaultCUDAStream();
-  std::vector<at::Tensor> input_buffers = {};
-  std::vector<at::Tensor> output_buffers = {};
-  std::string shape_key = "None";
   bool use_pre_allocated_outputs = false;
-  std::vector<at::Tensor> pre_allocated_outputs;
+  int64_t pre_allocated_outputs_depth = 2; // Output sets kept per shape key, 2: double buffered
+  // Recycle output storage once callers have dropped the returned tensors. Outputs must only be consumed on the
+  // caller stream (or synchronized with it) for recycling to be safe
+  bool use_output_arena = false;
+  int64_t output_arena_depth = 4; // Max number of tensors tracked per output
+  // Enqueue directly on the caller's current stream instead of a separate engine stream, which removes the event
+  // record / wait pair on each side of the execution. For callers which already manage their own streams
+  bool use_caller_stream = false;
+  // Copy host inputs to the device through pinned staging buffers of the slot, all of them in one transfer on a side
+  // stream, instead of rejecting them (or moving each with a blocking copy in multi device safe mode)
+  bool stage_host_inputs = false;
+  EngineQoSClass qos_class = QOS_DEFAULT;
+  std::atomic<int64_t> persistent_cache_limit = {0}; // -1: automatic
+  std::atomic<int64_t> cudagraph_cache_max_entries = {8};
+  std::atomic<int64_t> cudagraph_cache_max_bytes = {0}; // 0: no limit
+  std::vector<at::Tensor> registered_cudagraph_inputs; // ITO: PYT IDX
+  std::vector<int64_t> batch_buckets; // Sorted, empty: inputs are never padded
+  std::shared_ptr<DynamicBatcher> dynamic_batcher; // nullptr: executions are not batched
+  int64_t dynamic_batching_max_batch_size = 0;
+  std::vector<c10::intrusive_ptr<TRTEngine>> replicas; // Empty: the engine only runs on device_info
+  std::atomic<int64_t> in_flight_executions = {0}; // Used to balance host inputs between replicas
+  std::atomic<bool> weight_streaming_arbitrated = {false}; // Registered with the WeightStreamingArbiter
+  std::atomic<int64_t> pending_device_memory_budget = {-1}; // Assigned by the arbiter, not applied yet. -1: none
+  std::shared_ptr<DeviceMemoryArena> shared_device_memory; // nullptr: each context allocates its own memory
+  bool shape_sized_device_memory = false;
+  std::atomic<int64_t> idle_offload_ms = {0};
+  std::atomic<int64_t> last_execution_ns = {0}; // steady_clock, the time the engine was loaded until it executes
+  std::shared_ptr<CudaGraphPool> cudagraph_pool; // nullptr: each graph has a private pool and its own buffers
+  std::shared_ptr<StateBindings> state_bindings; // nullptr: no state bindings
+  std::vector<uint8_t> host_outputs; // ITO: PYT IDX, empty: every output stays on the device
+  TRTEngineMetrics metrics;
+  EngineLoadTimes load_times;
+  // Index in the loadable of each input and output of a DLA loadable, ITO: PYT IDX
+  std::vector<size_t> dla_input_order;
+  std::vector<size_t> dla_output_order;
+  std::shared_ptr<InputShapeHistogram> input_shapes = std::make_shared<InputShapeHistogram>(); // Shared with replicas
+  // Shared with replicas
+  std::shared_ptr<SampledLayerProfiler> layer_sampler = std::make_shared<SampledLayerProfiler>();
 
   // TODO: Implement a call method
   // c10::List<at::Tensor> Run(c10::List<at::Tensor> inputs);
 
   void set_profiling_paths();
+  void load_engine(
+      const util::SerializedEngine& serialized_engine,
+      const std::vector<std::string>& in_binding_names,
+      const std::vector<std::string>& out_binding_names,
+      std::shared_ptr<nvinfer1::IRuntime> runtime = nullptr);
+  // ensure_engine_loaded for the features which need an ICudaEngine, which DLA loadables do not have
+  void ensure_tensorrt_engine(const char* feature);
+  void load_dla_loadable(
+      const util::SerializedEngine& serialized_engine,
+      const void* blob,
+      size_t blob_size,
+      const std::vector<std::string>& in_binding_names,
+      const std::vector<std::string>& out_binding_names);
+  // Sets output_sources from the returned output names and returns the names of the outputs the engine binds
+  std::vector<std::string> split_output_aliases(const std::vector<std::string>& returned, size_t num_inputs);
+  std::vector<std::string> serialize_info(std::string serialized_engine);
+  // Plan of the loaded engine as it is saved, behind WEIGHTS_STRIPPED_MAGIC and without its weights if weights_stripped
+  util::SerializedEngine serialize_plan();
+  // Loads engines marked weights_stripped which still hold the plan they were built as, so it can be stripped
+  void ensure_stripped_plan();
+  std::shared_ptr<TRTExecutionSlot> make_execution_slot();
+  void reset_profile_contexts(TRTExecutionSlot& slot);
+  std::shared_ptr<nvinfer1::IExecutionContext> create_execution_context();
+  void build_binding_table();
+  void detect_data_dependent_outputs();
+  void recreate_execution_contexts();
+  // Expects mu to be held and every slot to be checked out by the caller
+  bool set_device_memory_budget_locked(int64_t budget);
 #ifndef NDEBUG
   bool profile_execution = true;
 #else
@@ -161,8 +618,34 @@ struct TRTEngine : torch::CustomClassHolder {
   std::string enqueue_profile_path;
   std::string trt_engine_profile_path;
   std::string cuda_graph_debug_path;
+  // Guards changes to the slot pool and is used to wait for a slot to be returned when the pool is exhausted
   std::mutex mu;
+  std::condition_variable slot_cv;
+  std::atomic<int64_t> slot_waiters = {0};
+  // The profiler is shared by all slots so profiled executions are serialized
+  std::mutex profiling_mu;
+  // Lazy deserialization state
+  std::atomic<bool> engine_loaded = {false};
+  std::mutex load_mu;
+  // Either the engine itself or a reference to its engine file, shared with replicas and the engine cache. For
+  // offloaded engines, a copy of the plan in pinned host memory
+  util::SerializedEngine pending_serialized_engine;
+  std::atomic<bool> offloaded = {false};
+  int64_t offloaded_pool_size = 1; // Restored when an offloaded engine is loaded again
+  // Every variant of a bundled engine, saved in place of the loaded engine. Empty if the engine is not bundled
+  std::string engine_bundle;
+  // False for engines loaded with LOAD_INCOMPATIBLE_ENGINES on a machine none of whose devices can run them, which
+  // can only be saved or bundled
+  bool device_compatible = true;
+  std::string lean_runtime_path;
+  bool engine_host_code_allowed = false;
   std::unique_ptr<TRTEngineProfiler> trt_engine_profiler;
+  // Shape inference state (see infer_outputs), rebuilt when the engine is swapped or reloaded
+  std::mutex shape_inference_mu;
+  std::shared_ptr<nvinfer1::ICudaEngine> shape_inference_engine; // Engine the context and memoized shapes belong to
+  std::shared_ptr<nvinfer1::IExecutionContext> shape_inference_ctx;
+  int32_t shape_inference_profile = 0;
+  std::map<std::vector<std::vector<int64_t>>, std::vector<std::vector<int64_t>>> inferred_output_shapes;
 };
 
 } // namespace runtime
@@ -0,0 +1,121 @@
+#include "core/runtime/TRTEngineMetrics.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+void LatencyHistogram::record(int64_t ns) {
+  auto us = static_cast<uint64_t>(ns < 0 ? 0 : ns / 1000);
+  size_t bucket = 0;
+  while (us > 0 && bucket < kNumBuckets - 1) {
+    us >>= 1;
+    bucket++;
+  }
+  buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  count.fetch_add(1, std::memory_order_relaxed);
+  total_ns.fetch_add(ns, std::memory_order_relaxed);
+  auto prev_max = max_ns.load(std::memory_order_relaxed);
+  while (ns > prev_max && !max_ns.compare_exchange_weak(prev_max, ns, std::memory_order_relaxed)) {
+  }
+}
+
+void LatencyHistogram::reset() {
+  for (auto& b : buckets) {
+    b.store(0, std::memory_order_relaxed);
+  }
+  count.store(0, std::memory_order_relaxed);
+  total_ns.store(0, std::memory_order_relaxed);
+  max_ns.store(0, std::memory_order_relaxed);
+}
+
+std::vector<int64_t> LatencyHistogram::bucket_bounds_us() {
+  std::vector<int64_t> bounds(kNumBuckets);
+  for (size_t i = 0; i < kNumBuckets; i++) {
+    bounds[i] = int64_t(1) << i;
+  }
+  return bounds;
+}
+
+c10::List<int64_t> LatencyHistogram::bucket_counts() const {
+  c10::List<int64_t> counts;
+  counts.reserve(kNumBuckets);
+  for (const auto& b : buckets) {
+    counts.push_back(b.load(std::memory_order_relaxed));
+  }
+  return counts;
+}
+
+void TRTEngineMetrics::reset() {
+  executions = 0;
+  cudagraph_hits = 0;
+  cudagraph_misses = 0;
+  cudagraph_recaptures = 0;
+  cudagraph_deferrals = 0;
+  device_switches = 0;
+  input_moves = 0;
+  shape_changes = 0;
+  padded_executions = 0;
+  dynamic_batches = 0;
+  dynamic_batched_requests = 0;
+  device_memory_allocations = 0;
+  offloads = 0;
+  reloads = 0;
+  execute_latency.reset();
+  input_setup_latency.reset();
+  output_allocation_latency.reset();
+  enqueue_latency.reset();
+  slot_wait_latency.reset();
+}
+
+c10::Dict<std::string, int64_t> TRTEngineMetrics::counters() const {
+  c10::Dict<std::string, int64_t> c;
+  c.insert("executions", executions.load(std::memory_order_relaxed));
+  c.insert("cudagraph_hits", cudagraph_hits.load(std::memory_order_relaxed));
+  c.insert("cudagraph_misses", cudagraph_misses.load(std::memory_order_relaxed));
+  c.insert("cudagraph_recaptures", cudagraph_recaptures.load(std::memory_order_relaxed));
+  c.insert("cudagraph_deferrals", cudagraph_deferrals.load(std::memory_order_relaxed));
+  c.insert("device_switches", device_switches.load(std::memory_order_relaxed));
+  c.insert("input_moves", input_moves.load(std::memory_order_relaxed));
+  c.insert("shape_changes", shape_changes.load(std::memory_order_relaxed));
+  c.insert("padded_executions", padded_executions.load(std::memory_order_relaxed));
+  c.insert("dynamic_batches", dynamic_batches.load(std::memory_order_relaxed));
+  c.insert("dynamic_batched_requests", dynamic_batched_requests.load(std::memory_order_relaxed));
+  c.insert("device_memory_allocations", device_memory_allocations.load(std::memory_order_relaxed));
+  c.insert("offloads", offloads.load(std::memory_order_relaxed));
+  c.insert("reloads", reloads.load(std::memory_order_relaxed));
+
+  auto summarize = [&c](const std::string& name, const LatencyHistogram& h) {
+    c.insert(name + "_count", h.count.load(std::memory_order_relaxed));
+    c.insert(name + "_total_ns", h.total_ns.load(std::memory_order_relaxed));
+    c.insert(name + "_max_ns", h.max_ns.load(std::memory_order_relaxed));
+  };
+  summarize("execute", execute_latency);
+  summarize("input_setup", input_setup_latency);
+  summarize("output_allocation", output_allocation_latency);
+  summarize("enqueue", enqueue_latency);
+  summarize("slot_wait", slot_wait_latency);
+  return c;
+}
+
+c10::Dict<std::string, c10::List<int64_t>> TRTEngineMetrics::histograms() const {
+  c10::Dict<std::string, c10::List<int64_t>> h;
+  h.insert("bucket_bounds_us", c10::List<int64_t>(LatencyHistogram::bucket_bounds_us()));
+  h.insert("execute", execute_latency.bucket_counts());
+  h.insert("input_setup", input_setup_latency.bucket_counts());
+  h.insert("output_allocation", output_allocation_latency.bucket_counts());
+  h.insert("enqueue", enqueue_latency.bucket_counts());
+  h.insert("slot_wait", slot_wait_latency.bucket_counts());
+  return h;
+}
+
+c10::Dict<std::string, int64_t> EngineLoadTimes::to_dict() const {
+  c10::Dict<std::string, int64_t> d;
+  d.insert("decode_ns", decode_ns);
+  d.insert("deserialize_ns", deserialize_ns);
+  d.insert("create_context_ns", create_context_ns);
+  return d;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,107 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ATen/core/Dict.h"
+#include "ATen/core/List.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Fixed bucket latency histogram. Bucket i counts samples below 2^i microseconds (and at least 2^(i-1) for i > 0),
+// the last bucket also collects everything above its bound. Recording is lock free so it can be left on in production
+class LatencyHistogram {
+ public:
+  static constexpr size_t kNumBuckets = 24;
+
+  void record(int64_t ns);
+  void reset();
+  // Upper bounds of the buckets in microseconds
+  static std::vector<int64_t> bucket_bounds_us();
+  c10::List<int64_t> bucket_counts() const;
+
+  std::atomic<int64_t> count = {0};
+  std::atomic<int64_t> total_ns = {0};
+  std::atomic<int64_t> max_ns = {0};
+
+ private:
+  std::array<std::atomic<int64_t>, kNumBuckets> buckets = {};
+};
+
+// Records the time spent in a scope into a histogram
+class ScopedLatency {
+ public:
+  explicit ScopedLatency(LatencyHistogram& histogram)
+      : histogram(histogram), start(std::chrono::steady_clock::now()) {}
+  ScopedLatency(const ScopedLatency&) = delete;
+  ScopedLatency& operator=(const ScopedLatency&) = delete;
+  ~ScopedLatency() {
+    histogram.record(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+  }
+
+ private:
+  LatencyHistogram& histogram;
+  std::chrono::steady_clock::time_point start;
+};
+
+// Always-on per engine runtime counters, updated with relaxed atomics from every execution slot
+struct TRTEngineMetrics {
+  std::atomic<int64_t> executions = {0};
+  std::atomic<int64_t> cudagraph_hits = {0};
+  std::atomic<int64_t> cudagraph_misses = {0}; // Captures for a shape that was not in the cache
+  std::atomic<int64_t> cudagraph_recaptures = {0}; // Captures after the cache was invalidated
+  std::atomic<int64_t> cudagraph_deferrals = {0}; // Executions without a graph because their shape was not admitted
+  std::atomic<int64_t> device_switches = {0};
+  std::atomic<int64_t> input_moves = {0}; // Inputs moved to the engine device by multi-device safe mode
+  std::atomic<int64_t> shape_changes = {0};
+  std::atomic<int64_t> padded_executions = {0}; // Executions padded up to a batch bucket
+  std::atomic<int64_t> dynamic_batches = {0}; // Executions combining requests of concurrent callers
+  std::atomic<int64_t> dynamic_batched_requests = {0};
+  std::atomic<int64_t> device_memory_allocations = {0}; // Shape sized device memory allocated for a larger shape
+  std::atomic<int64_t> offloads = {0}; // Idle offloads to host memory
+  std::atomic<int64_t> reloads = {0}; // Executions which deserialized the engine again after it was offloaded
+
+  LatencyHistogram execute_latency; // Whole execute_engine call, including waiting for a free slot
+  LatencyHistogram input_setup_latency; // Binding inputs and shape inference
+  LatencyHistogram output_allocation_latency;
+  LatencyHistogram enqueue_latency; // enqueueV3, CUDA graph capture and replay
+  LatencyHistogram slot_wait_latency; // Waits for mu and a free slot by executions which found every slot checked out
+
+  void reset();
+  c10::Dict<std::string, int64_t> counters() const;
+  c10::Dict<std::string, c10::List<int64_t>> histograms() const;
+};
+
+// Time spent loading an engine, recorded once when it is loaded: decoding the saved payload (copying it out of the
+// pickle or base64 decoding it, then decompressing it), deserializing the plan and creating the execution context of
+// the primary slot. Deserializing is close to free for engines shared through the engine registry
+struct EngineLoadTimes {
+  int64_t decode_ns = 0;
+  int64_t deserialize_ns = 0;
+  int64_t create_context_ns = 0;
+
+  c10::Dict<std::string, int64_t> to_dict() const;
+};
+
+inline int64_t elapsed_ns(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline int64_t steady_now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+inline void increment(std::atomic<int64_t>& counter, int64_t n = 1) {
+  counter.fetch_add(n, std::memory_order_relaxed);
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
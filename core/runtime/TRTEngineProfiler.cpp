@@ -32,6 +32,19 @@ TRTEngineProfiler::TRTEngineProfiler(const std::string& name, const std::vector<
   }
 }
 
+const std::map<std::string, TRTEngineProfiler::Record>& TRTEngineProfiler::get_layer_times() const {
+  return profile;
+}
+
+const std::vector<std::string>& TRTEngineProfiler::get_layer_names() const {
+  return layer_names;
+}
+
+void TRTEngineProfiler::reset() {
+  profile.clear();
+  layer_names.clear();
+}
+
 void dump_trace(const std::string& path, const TRTEngineProfiler& value) {
   std::stringstream out;
   out << "[" << std::endl;
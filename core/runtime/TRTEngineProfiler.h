@@ -22,6 +22,11 @@ struct TRTEngineProfiler : public nvinfer1::IProfiler {
       const std::vector<TRTEngineProfiler>& srcProfilers = std::vector<TRTEngineProfiler>());
   friend std::ostream& operator<<(std::ostream& out, const TRTEngineProfiler& value);
   friend void dump_trace(const std::string& path, const TRTEngineProfiler& value);
+  // Accumulated time and number of executions of every layer, by layer name
+  const std::map<std::string, Record>& get_layer_times() const;
+  // Layer names in the order the layers first reported their time
+  const std::vector<std::string>& get_layer_names() const;
+  void reset();
 
  private:
   std::string name;
@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "c10/cuda/CUDAGuard.h"
+#include "cuda_runtime.h"
+
+#include "core/runtime/TRTEngine.h"
+#include "core/runtime/WeightStreamingArbiter.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+namespace {
+
+int64_t steady_now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+} // namespace
+
+bool WeightStreamingArbiter::register_engine(TRTEngine* engine) {
+  int64_t streamable = engine->cuda_engine->getStreamableWeightsSize();
+  if (streamable <= 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mu);
+  auto& entry = engines[engine];
+  entry.device_id = engine->device_info.id;
+  entry.streamable = streamable;
+  engine->weight_streaming_arbitrated = true;
+  LOG_DEBUG(
+      "Engine " << engine->name << " with " << streamable << "B of streamable weights registered with the weight "
+                << "streaming arbiter of device " << entry.device_id);
+  rebalance_locked(entry.device_id, steady_now_ns());
+  return true;
+}
+
+bool WeightStreamingArbiter::unregister_engine(TRTEngine* engine) {
+  std::lock_guard<std::mutex> lock(mu);
+  engine->weight_streaming_arbitrated = false;
+  return engines.erase(engine) > 0;
+}
+
+void WeightStreamingArbiter::on_execution(TRTEngine* engine) {
+  auto now = steady_now_ns();
+  auto idle_timeout_ns = idle_timeout_ms.load() * 1000000;
+  std::lock_guard<std::mutex> lock(mu);
+  auto entry = engines.find(engine);
+  if (entry == engines.end()) {
+    return;
+  }
+  bool was_idle = entry->second.last_execution_ns == 0 || now - entry->second.last_execution_ns > idle_timeout_ns;
+  entry->second.last_execution_ns = now;
+  if (was_idle) {
+    entry->second.active_since_ns = now;
+  }
+  // Engines going idle are only noticed by executions, check for them at most once per idle timeout
+  auto device_id = entry->second.device_id;
+  if (was_idle || now - last_rebalance_ns[device_id] > idle_timeout_ns) {
+    rebalance_locked(device_id, now);
+  }
+}
+
+void WeightStreamingArbiter::rebalance(int64_t device_id) {
+  std::lock_guard<std::mutex> lock(mu);
+  rebalance_locked(device_id, steady_now_ns());
+}
+
+void WeightStreamingArbiter::rebalance_locked(int64_t device_id, int64_t now_ns) {
+  last_rebalance_ns[device_id] = now_ns;
+  std::vector<std::pair<TRTEngine*, Entry*>> device_engines;
+  for (auto& e : engines) {
+    if (e.second.device_id == device_id) {
+      device_engines.push_back({e.first, &e.second});
+    }
+  }
+  if (device_engines.empty()) {
+    return;
+  }
+
+  int64_t pool = device_memory_limit;
+  if (pool == 0) {
+    size_t free_bytes = 0, total_bytes = 0;
+    {
+      c10::cuda::CUDAGuard guard(static_cast<c10::DeviceIndex>(device_id));
+      auto err = cudaMemGetInfo(&free_bytes, &total_bytes);
+      if (err != cudaSuccess) {
+        LOG_WARNING(
+            "Unable to query the free memory of device " << device_id << " (" << cudaGetErrorString(err)
+                                                         << "), weight streaming budgets are left unchanged");
+        return;
+      }
+    }
+    // The weights engines currently keep resident are free to be given out again
+    pool = static_cast<int64_t>(free_bytes) - reserved_bytes;
+    for (auto& e : device_engines) {
+      pool += std::min(e.first->cuda_engine->getWeightStreamingBudgetV2(), e.second->streamable);
+    }
+  }
+  pool = std::max<int64_t>(pool, 0);
+
+  auto idle_timeout_ns = idle_timeout_ms.load() * 1000000;
+  auto is_active = [&](const Entry* e) {
+    return e->last_execution_ns != 0 && now_ns - e->last_execution_ns <= idle_timeout_ns;
+  };
+  std::stable_sort(device_engines.begin(), device_engines.end(), [&](const auto& a, const auto& b) {
+    bool a_active = is_active(a.second), b_active = is_active(b.second);
+    if (a_active != b_active) {
+      return a_active;
+    }
+    return a_active ? a.second->active_since_ns < b.second->active_since_ns
+                    : a.second->last_execution_ns > b.second->last_execution_ns;
+  });
+  for (auto& e : device_engines) {
+    e.second->assigned = std::min(e.second->streamable, pool);
+    pool -= e.second->assigned;
+  }
+
+  // Engines giving up memory go first so it is released before others grow into it
+  std::stable_partition(device_engines.begin(), device_engines.end(), [](const auto& e) {
+    return e.second->assigned < e.first->cuda_engine->getWeightStreamingBudgetV2();
+  });
+  for (auto& e : device_engines) {
+    if (e.second->assigned == e.first->cuda_engine->getWeightStreamingBudgetV2()) {
+      continue;
+    }
+    LOG_DEBUG(
+        "Weight streaming arbiter assigns " << e.second->assigned << "B of " << e.second->streamable
+                                            << "B of streamable weights to engine " << e.first->name);
+    e.first->pending_device_memory_budget = e.second->assigned;
+    e.first->apply_pending_device_memory_budget();
+  }
+}
+
+int64_t WeightStreamingArbiter::get_assigned_budget(TRTEngine* engine) {
+  std::lock_guard<std::mutex> lock(mu);
+  auto entry = engines.find(engine);
+  return entry == engines.end() ? -1 : entry->second.assigned;
+}
+
+int64_t WeightStreamingArbiter::get_num_engines() {
+  std::lock_guard<std::mutex> lock(mu);
+  return static_cast<int64_t>(engines.size());
+}
+
+int64_t WeightStreamingArbiter::get_reserved_bytes() {
+  return reserved_bytes;
+}
+
+void WeightStreamingArbiter::set_reserved_bytes(int64_t reserved) {
+  TORCHTRT_CHECK(reserved >= 0, "Weight streaming arbiter reserve must not be negative, got " << reserved);
+  reserved_bytes = reserved;
+}
+
+int64_t WeightStreamingArbiter::get_device_memory_limit() {
+  return device_memory_limit;
+}
+
+void WeightStreamingArbiter::set_device_memory_limit(int64_t limit) {
+  TORCHTRT_CHECK(limit >= 0, "Weight streaming arbiter device memory limit must not be negative, got " << limit);
+  device_memory_limit = limit;
+}
+
+int64_t WeightStreamingArbiter::get_idle_timeout_ms() {
+  return idle_timeout_ms;
+}
+
+void WeightStreamingArbiter::set_idle_timeout_ms(int64_t timeout_ms) {
+  TORCHTRT_CHECK(timeout_ms >= 0, "Weight streaming arbiter idle timeout must not be negative, got " << timeout_ms);
+  idle_timeout_ms = timeout_ms;
+}
+
+WeightStreamingArbiter& get_weight_streaming_arbiter() {
+  // Never destroyed, engines held by other static objects unregister after static destruction
+  static auto arbiter = new WeightStreamingArbiter();
+  return *arbiter;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
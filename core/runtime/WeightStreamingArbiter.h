@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+struct TRTEngine;
+
+// Process wide arbiter of the device memory weight streaming engines keep their streamable weights in. Engines
+// register once they are deserialized (while WEIGHT_STREAMING_ARBITER is set) and unregister when destroyed. Whenever
+// an engine is registered or unregistered, an idle engine executes again, or active engines may have gone idle, the
+// memory of the device is redistributed. Engines are made fully resident in turn, active engines first in the order
+// they became active (an engine which keeps executing is not displaced by others waking up), then idle engines from
+// the most recently executed. The first engine which does not fit gets what is left, the others stream all weights.
+// Budgets are applied through set_device_memory_budget between executions, right away for engines with no execution
+// in flight and otherwise by the next execution of the engine which finds its slots idle. Engines deduplicated through
+// the engine registry (DEDUPLICATE_ENGINES) are not registered since their budget is shared with other instances
+class WeightStreamingArbiter {
+ public:
+  // Returns false if engine does not stream weights
+  bool register_engine(TRTEngine* engine);
+  // Returns false if engine was not registered. The engine is no longer touched by the arbiter once this returns, the
+  // memory it releases is redistributed by the next rebalance of its device
+  bool unregister_engine(TRTEngine* engine);
+  // Called by registered engines as they start an execution
+  void on_execution(TRTEngine* engine);
+  // Redistributes the memory of device_id between the engines registered on it
+  void rebalance(int64_t device_id);
+  // Budget last assigned to engine, -1 if it is not registered
+  int64_t get_assigned_budget(TRTEngine* engine);
+  int64_t get_num_engines();
+
+  // Device memory left free for activations and other allocations when budgets are sized from the free device memory
+  int64_t get_reserved_bytes();
+  void set_reserved_bytes(int64_t reserved);
+  // Device memory given to streamable weights on each device, 0: the free device memory less the reserve
+  int64_t get_device_memory_limit();
+  void set_device_memory_limit(int64_t limit);
+  // Engines which have not executed for this long are idle and only get the memory active engines leave
+  int64_t get_idle_timeout_ms();
+  void set_idle_timeout_ms(int64_t timeout_ms);
+
+ private:
+  struct Entry {
+    int64_t device_id = 0;
+    int64_t streamable = 0;
+    int64_t last_execution_ns = 0; // 0: never executed
+    int64_t active_since_ns = 0;
+    int64_t assigned = -1;
+  };
+  // Expects mu to be held
+  void rebalance_locked(int64_t device_id, int64_t now_ns);
+
+  std::mutex mu;
+  std::unordered_map<TRTEngine*, Entry> engines;
+  std::unordered_map<int64_t, int64_t> last_rebalance_ns; // By device
+  std::atomic<int64_t> reserved_bytes = {int64_t(512) << 20};
+  std::atomic<int64_t> device_memory_limit = {0};
+  std::atomic<int64_t> idle_timeout_ms = {10000};
+};
+
+WeightStreamingArbiter& get_weight_streaming_arbiter();
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
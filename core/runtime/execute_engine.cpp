@@ -1,10 +1,20 @@
+#include <algorithm>
+#include <cstring>
+#include <optional>
+
+#include "cuda_runtime.h"
+
 #include "ATen/cuda/CUDAEvent.h"
+#include "ATen/cuda/CachingHostAllocator.h"
+#include "c10/cuda/CUDACachingAllocator.h"
+#include "c10/cuda/CUDAGraphsC10Utils.h"
 #include "c10/cuda/CUDAGuard.h"
 #include "c10/cuda/CUDAStream.h"
 
 #include "torch/csrc/jit/runtime/custom_operator.h"
 #include "torch/torch.h"
 
+#include "core/runtime/MemoryReclaimer.h"
 #include "core/runtime/TRTEngineProfiler.h"
 #include "core/runtime/runtime.h"
 #include "core/util/prelude.h"
@@ -25,9 +35,9 @@ bool is_switch_required(const RTDevice& curr_device, const RTDevice& engine_devi
     return true;
   }
 
-  // GPU case
+  // GPU case, a MIG instance runs the engines of its GPU model
   if (engine_device.device_type == nvinfer1::DeviceType::kGPU) {
-    if (curr_device.device_name != engine_device.device_name) {
+    if (curr_device.getBaseName() != engine_device.getBaseName()) {
       LOG_WARNING(
           "Program compiled for " << engine_device.device_name << " but current CUDA device is " << curr_device
                                   << ". Attempting to switch device context for better compatibility");
@@ -60,134 +70,746 @@ RTDevice select_rt_device(const RTDevice& engine_device, const RTDevice& curr_de
   return new_target_device_opt.value();
 }
 
-bool _validate_shapes(std::vector<at::Tensor> inputs, c10::intrusive_ptr<TRTEngine> compiled_engine) {
-  // Validate whether the current input shapes to the engine has changed
+// Inputs produced by a pipeline stage on another GPU are copied on a side stream of that GPU, so the stage can go on
+// with its next execution while the copy waits for the work already enqueued on this GPU
+at::Tensor copy_from_peer(const at::Tensor& in, c10::DeviceIndex device) {
+  c10::DeviceIndex src = in.device().index();
+  auto copy_stream = c10::cuda::getStreamFromPool(false, src);
+  at::cuda::CUDAEvent produced;
+  produced.record(c10::cuda::getCurrentCUDAStream(src));
+  produced.block(copy_stream);
+  at::Tensor out;
+  {
+    c10::cuda::CUDAStreamGuard stream_guard(copy_stream);
+    out = in.to(torch::Device(torch::kCUDA, device), /*non_blocking=*/true);
+  }
+  // The producer may only reuse the memory of the input once the copy is done
+  c10::cuda::CUDACachingAllocator::recordStream(in.storage().data_ptr(), copy_stream);
+  return out;
+}
 
-  // Populate the shape key for the inputs
-  // x: (3, 4), y: (4, 5) --> Key: (3,4)(4,5)
-  std::stringstream new_shape_key_ss;
-  for (auto input : inputs) {
-    new_shape_key_ss << "(";
-    auto sizes = input.sizes();
-    auto rank = input.sizes().size();
-    for (size_t i = 0; i < rank; i++) {
-      new_shape_key_ss << sizes[i];
-      // For all but the final dimension in the shape key, add comma separator
-      if (i < rank - 1) {
-        new_shape_key_ss << ",";
+// Integrated GPUs share their DRAM with the host, so pinned (mapped) and managed host tensors already in the layout of
+// their binding are read by the engine in place instead of being copied to the device. Returns the device address of
+// such an input, nullptr otherwise
+void* mapped_host_input(const at::Tensor& in, const RTDevice& device, const BindingFormat& format) {
+  if (!device.integrated || in.is_cuda() || !format.is_linear() || !in.is_contiguous() || in.data_ptr() == nullptr) {
+    return nullptr;
+  }
+  cudaPointerAttributes attrs;
+  if (cudaPointerGetAttributes(&attrs, in.data_ptr()) != cudaSuccess) {
+    cudaGetLastError();
+    return nullptr;
+  }
+  if (attrs.type == cudaMemoryTypeManaged) {
+    return in.data_ptr();
+  }
+  return attrs.type == cudaMemoryTypeHost ? attrs.devicePointer : nullptr;
+}
+
+// Copies the host inputs of an execution to the device of the engine through the pinned staging buffers of the slot.
+// The inputs are packed into one buffer and moved with a single transfer, issued on a side stream so that it overlaps
+// with the previous execution still running on the engine stream
+void stage_host_inputs(
+    std::vector<at::Tensor>& inputs,
+    const c10::intrusive_ptr<TRTEngine>& compiled_engine,
+    TRTExecutionSlot& slot) {
+  constexpr int64_t kAlignment = 256;
+  const auto& bindings = compiled_engine->binding_table;
+  std::vector<size_t> staged;
+  std::vector<int64_t> offsets;
+  int64_t nbytes = 0;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (inputs[i].is_cuda() || bindings.input_is_shape_tensor[i] ||
+        mapped_host_input(inputs[i], compiled_engine->device_info, bindings.input_formats[i])) {
+      continue;
+    }
+    staged.push_back(i);
+    offsets.push_back(nbytes);
+    nbytes += (static_cast<int64_t>(inputs[i].nbytes()) + kAlignment - 1) / kAlignment * kAlignment;
+  }
+  if (staged.empty()) {
+    return;
+  }
+
+  auto device = static_cast<c10::DeviceIndex>(compiled_engine->device_info.id);
+  if (!slot.host_staging_stream || slot.host_staging_stream->device_index() != device) {
+    // Events are bound to the device they are first recorded on
+    for (auto& done : slot.host_staging_done) {
+      if (done.isCreated()) {
+        done.synchronize();
       }
+      done = at::cuda::CUDAEvent();
     }
-    new_shape_key_ss << ")";
+    slot.host_staging_stream = c10::cuda::getStreamFromPool(false, device);
+  }
+  auto& host = slot.host_staging[slot.host_staging_next];
+  auto& done = slot.host_staging_done[slot.host_staging_next];
+  slot.host_staging_next = (slot.host_staging_next + 1) % slot.host_staging.size();
+  // Only waits if the transfer out of this buffer two executions ago is still in flight
+  if (done.isCreated()) {
+    done.synchronize();
+  }
+  if (!host.defined() || static_cast<int64_t>(host.nbytes()) < nbytes) {
+    host = empty_pinned_host_buffer(nbytes, device);
+  }
+  auto* host_ptr = static_cast<uint8_t*>(host.data_ptr());
+  for (size_t k = 0; k < staged.size(); k++) {
+    auto src = inputs[staged[k]].contiguous();
+    std::memcpy(host_ptr + offsets[k], src.data_ptr(), src.nbytes());
   }
 
-  auto new_shape_key = new_shape_key_ss.str();
+  auto stream = slot.host_staging_stream.value();
+  at::Tensor staging;
+  {
+    // Allocated on the staging stream, which writes it first
+    c10::cuda::CUDAStreamGuard stream_guard(stream);
+    staging = at::empty({nbytes}, at::TensorOptions().dtype(at::kByte).device(at::kCUDA, device));
+  }
+  TORCHTRT_CHECK(
+      cudaMemcpyAsync(staging.data_ptr(), host_ptr, nbytes, cudaMemcpyHostToDevice, stream.stream()) == cudaSuccess,
+      "Unable to copy the host inputs of engine " << compiled_engine->name << " to the device");
+  done.record(stream);
+  auto caller_stream = c10::cuda::getCurrentCUDAStream(device);
+  done.block(caller_stream);
+  // The engine stream only reads the inputs between waiting on the caller stream and being waited on by it
+  c10::cuda::CUDACachingAllocator::recordStream(staging.storage().data_ptr(), caller_stream);
+  for (size_t k = 0; k < staged.size(); k++) {
+    auto& in = inputs[staged[k]];
+    in = staging.narrow(0, offsets[k], in.nbytes()).view(in.scalar_type()).view(in.sizes());
+  }
+}
+
+void stage_shape_tensor_inputs(
+    const std::vector<at::Tensor>& inputs,
+    const c10::intrusive_ptr<TRTEngine>& compiled_engine,
+    TRTExecutionSlot& slot) {
+  // Shape tensor inputs are casted to int64 explicitly.
+  // Refer to
+  // https://github.com/NVIDIA/TensorRT/blob/d2f4ef789a9a6ffdf37b55c3f81b486225f6b380/samples/common/sampleInference.cpp#L435
+  // Device values are copied asynchronously into reusable pinned buffers on the caller stream and the host only waits
+  // on an event recorded after the last copy, CPU values are converted in place without touching the device
+  const auto& bindings = compiled_engine->binding_table;
+  slot.shape_tensor_staging.resize(inputs.size());
+  c10::DeviceIndex pending_device = -1;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (!bindings.input_is_shape_tensor[i]) {
+      continue;
+    }
+    auto numel = inputs[i].numel();
+    auto& staging = slot.shape_tensor_staging[i];
+    if (!staging.defined() || staging.numel() != numel) {
+      staging = at::empty({numel}, at::TensorOptions().dtype(at::kLong).pinned_memory(true));
+    }
+    if (inputs[i].is_cuda()) {
+      staging.copy_(inputs[i].reshape({numel}), /*non_blocking=*/true);
+      pending_device = inputs[i].device().index();
+    } else {
+      staging.copy_(inputs[i].reshape({numel}));
+    }
+  }
+
+  if (pending_device >= 0) {
+    slot.shape_tensor_staged.record(c10::cuda::getCurrentCUDAStream(pending_device));
+    slot.shape_tensor_staged.synchronize();
+  }
+}
+
+bool _validate_shapes(
+    const std::vector<at::Tensor>& inputs,
+    const c10::intrusive_ptr<TRTEngine>& compiled_engine,
+    TRTExecutionSlot& slot) {
+  // Validate whether the current input shapes to the engine has changed
+  ShapeKey new_shape_key(inputs);
+  if (RECORD_INPUT_SHAPES) {
+    compiled_engine->input_shapes->record(new_shape_key);
+  }
+  if (compiled_engine->has_shape_tensor_inputs) {
+    // Shape tensor values determine output shapes too, so they are part of the key
+    stage_shape_tensor_inputs(inputs, compiled_engine, slot);
+    for (size_t i = 0; i < inputs.size(); i++) {
+      if (compiled_engine->binding_table.input_is_shape_tensor[i]) {
+        const auto& staging = slot.shape_tensor_staging[i];
+        new_shape_key.append_values(staging.data_ptr<int64_t>(), staging.numel());
+      }
+    }
+  }
 
   // Compare the shape key to the original key
-  if (new_shape_key != compiled_engine->shape_key) {
-    LOG_DEBUG("Input shape changed " << compiled_engine->shape_key << " -> " << new_shape_key);
-    compiled_engine->shape_key = new_shape_key;
+  if (new_shape_key != slot.shape_key) {
+    LOG_DEBUG("Input shape changed " << slot.shape_key << " -> " << new_shape_key);
+    slot.shape_key = std::move(new_shape_key);
+    slot.inputs_validated = false;
+    slot.inputs_on_device = -1;
     return true;
   }
 
   return false;
 }
+
 void setup_input_tensors(
-    std::vector<at::Tensor> inputs,
-    c10::intrusive_ptr<TRTEngine> compiled_engine,
-    bool cudagraphs_enabled,
-    bool need_cudagraphs_record) {
-  // this is a buffer to store shape tensor input addresses throughout the runtime scope
-  std::list<std::vector<int64_t>> inputShapeTensorValues;
-  std::list<at::Tensor> formatted_inputs(compiled_engine->num_io.first);
+    const std::vector<at::Tensor>& inputs,
+    const c10::intrusive_ptr<TRTEngine>& compiled_engine,
+    TRTExecutionSlot& slot,
+    CudaGraphCacheEntry* cudagraph_entry,
+    bool need_cudagraphs_record,
+    bool need_shape_update) {
+  bool cudagraphs_enabled = cudagraph_entry != nullptr;
+  const auto& bindings = compiled_engine->binding_table;
+  // Dtypes and devices are part of the shape key, so inputs are only validated the first time the slot sees their key
+  bool validate = !slot.inputs_validated || VALIDATE_INPUTS_EVERY_CALL;
+  // Formatted inputs need to stay alive until the engine has been enqueued, they are kept on the slot and cleared
+  // once execution is done (retaining their capacity for the next call)
+  slot.formatted_inputs.resize(inputs.size());
 
   for (size_t i = 0; i < inputs.size(); i++) {
-    std::string name = compiled_engine->in_binding_names[i];
-
-    TORCHTRT_CHECK(
-        inputs[i].is_cuda(), "Expected input tensors to have device cuda, found device " << inputs[i].device());
+    const char* name = bindings.input_names[i];
 
-    auto expected_type =
-        util::TRTDataTypeToScalarType(compiled_engine->exec_ctx->getEngine().getTensorDataType(name.c_str()));
-    TORCHTRT_CHECK(
-        inputs[i].dtype() == expected_type,
-        "Expected input tensors to have type " << expected_type << ", found type " << inputs[i].dtype());
-
-    auto dims = core::util::toDims(inputs[i].sizes());
-    auto shape = core::util::toVec(dims);
-    LOG_DEBUG("Input Name: " << name << " Shape: " << dims);
-
-    if (compiled_engine->cuda_engine->isShapeInferenceIO(name.c_str())) {
-      // Shape tensor inputs are casted to int64 explicitly.
-      // Refer to
-      // https://github.com/NVIDIA/TensorRT/blob/d2f4ef789a9a6ffdf37b55c3f81b486225f6b380/samples/common/sampleInference.cpp#L435
-      auto input_cpu = inputs[i].clone().contiguous().cpu().to(torch::kInt64);
-      std::vector<int64_t> inputs_cpu_vec(
-          input_cpu.data_ptr<int64_t>(), input_cpu.data_ptr<int64_t>() + input_cpu.numel());
-      inputShapeTensorValues.emplace_back(inputs_cpu_vec);
+    if (validate) {
+      auto expected_type = bindings.input_types[i];
       TORCHTRT_CHECK(
-          compiled_engine->exec_ctx->setTensorAddress(name.c_str(), inputShapeTensorValues.back().data()),
-          "Error while setting the tensor address for shape inputs");
+          inputs[i].scalar_type() == expected_type,
+          "Expected input tensors to have type " << expected_type << ", found type " << inputs[i].dtype());
+    }
 
+    if (bindings.input_is_shape_tensor[i]) {
+      // Values were staged on the host by _validate_shapes, the staging buffer is stable until the next call
+      const auto& staging = slot.shape_tensor_staging[i];
       if (cudagraphs_enabled) {
         // @peri044 I dont know if this makes sense since they are supposed to be GPU buffers
-        compiled_engine->input_buffers[i] = input_cpu;
+        cudagraph_entry->input_buffers[i] = staging;
       }
       TORCHTRT_CHECK(
-          compiled_engine->exec_ctx->setTensorAddress(name.c_str(), inputShapeTensorValues.back().data()),
+          slot.exec_ctx->setTensorAddress(name, staging.data_ptr()),
           "Error while setting the tensor address for shape inputs");
 
     } else {
-      at::Tensor contig_input = inputs[i].view(shape).contiguous();
-      formatted_inputs.emplace_back(std::move(contig_input));
+      void* mapped = mapped_host_input(inputs[i], compiled_engine->device_info, bindings.input_formats[i]);
+      TORCHTRT_CHECK(
+          !validate || inputs[i].is_cuda() || mapped,
+          "Expected input tensors to have device cuda, found device " << inputs[i].device()
+                                                                      << " (host inputs need to be pinned or managed "
+                                                                      << "memory on integrated GPUs)");
+
+      // Inputs already laid out in the format of the binding (contiguous for linear bindings, the outputs of an
+      // engine with the same channel last format otherwise) are bound directly
+      slot.formatted_inputs[i] = mapped ? inputs[i] : to_format(inputs[i], bindings.input_formats[i]);
 
       if (need_cudagraphs_record) {
-        // Create a new persistent input buffer
-        compiled_engine->input_buffers[i] = std::move(formatted_inputs.back().clone());
+        if (mapped) {
+          // Graphs replay from device buffers, the mapped input is copied in like any other
+          cudagraph_entry->input_buffers[i] =
+              at::empty(inputs[i].sizes(), inputs[i].options().device(at::kCUDA, compiled_engine->device_info.id));
+        } else if (compiled_engine->is_registered_cudagraph_input(i, slot.formatted_inputs[i])) {
+          // Registered inputs are stable for the lifetime of the graph, capture directly against them
+          cudagraph_entry->input_buffers[i] = slot.formatted_inputs[i];
+        } else {
+          // Create a new persistent input buffer
+          cudagraph_entry->input_buffers[i] = clone_in_format(slot.formatted_inputs[i], bindings.input_formats[i]);
+        }
       }
 
-      TORCHTRT_CHECK(
-          compiled_engine->exec_ctx->setInputShape(name.c_str(), dims), "Error while setting the input shape");
+      if (need_shape_update) {
+        // Shapes only need to be set on the context when they differ from the previous execution on this slot
+        TORCHTRT_CHECK(
+            inputs[i].dim() == bindings.input_ranks[i],
+            "Expected input " << name << " to have rank " << bindings.input_ranks[i] << ", found rank "
+                              << inputs[i].dim());
+        auto dims = core::util::toDims(inputs[i].sizes());
+        LOG_DEBUG("Input Name: " << name << " Shape: " << dims);
+        TORCHTRT_CHECK(slot.exec_ctx->setInputShape(name, dims), "Error while setting the input shape");
+      }
 
       if (cudagraphs_enabled) {
-        // If using CUDAGraphs copy formatted input to the corresponding persistent input buffer
-        compiled_engine->input_buffers[i].copy_(formatted_inputs.back(), true);
+        // If using CUDAGraphs copy formatted input to the corresponding persistent input buffer, unless the caller
+        // passed the persistent buffer itself (registered inputs), in which case replay needs no copy
+        if (cudagraph_entry->input_buffers[i].data_ptr() != slot.formatted_inputs[i].data_ptr()) {
+          cudagraph_entry->input_buffers[i].copy_(slot.formatted_inputs[i], true);
+        }
         TORCHTRT_CHECK(
-            compiled_engine->exec_ctx->setTensorAddress(name.c_str(), compiled_engine->input_buffers[i].data_ptr()),
+            slot.exec_ctx->setTensorAddress(name, cudagraph_entry->input_buffers[i].data_ptr()),
             "Error while setting the input tensor address for inputs");
       } else {
         // Otherwise use the formatted buffer directly
         TORCHTRT_CHECK(
-            compiled_engine->exec_ctx->setTensorAddress(name.c_str(), formatted_inputs.back().data_ptr()),
+            slot.exec_ctx->setTensorAddress(name, mapped ? mapped : slot.formatted_inputs[i].data_ptr()),
             "Error while setting the input tensor address for inputs");
       }
     }
   }
+  slot.inputs_validated = true;
 }
-std::vector<at::Tensor> create_output_tensors(c10::intrusive_ptr<TRTEngine> compiled_engine) {
-  std::vector<at::Tensor> outputs(compiled_engine->num_io.second);
-  for (auto output_indices : compiled_engine->out_binding_map) {
-    // out_binding_map stores TRT_IDX: PYT_IDX
-    auto pyt_idx = output_indices.second;
 
-    std::string name = compiled_engine->out_binding_names[pyt_idx];
-    auto out_shape = compiled_engine->exec_ctx->getTensorShape(name.c_str());
+void update_output_shapes(const c10::intrusive_ptr<TRTEngine>& compiled_engine, TRTExecutionSlot& slot) {
+  // Output shapes only change when input shapes do, so they are queried once per new shape key
+  slot.output_shapes.resize(compiled_engine->num_io.second);
+  slot.output_is_data_dependent.assign(compiled_engine->num_io.second, 0);
+  for (size_t pyt_idx = 0; pyt_idx < compiled_engine->num_io.second; pyt_idx++) {
+    const char* name = compiled_engine->binding_table.output_names[pyt_idx];
+    auto out_shape = slot.exec_ctx->getTensorShape(name);
     LOG_DEBUG("Output Name: " << name << " Shape: " << out_shape);
+    slot.output_shapes[pyt_idx] = core::util::toVec(out_shape);
+    // Dimensions which are still unknown once all input shapes are set depend on the input data
+    for (auto d : slot.output_shapes[pyt_idx]) {
+      slot.output_is_data_dependent[pyt_idx] |= d < 0;
+    }
+    TORCHTRT_CHECK(
+        !slot.output_is_data_dependent[pyt_idx] || compiled_engine->binding_table.output_formats[pyt_idx].is_linear(),
+        "Output " << name << " has a data dependent shape and a channel last format, only linear data dependent "
+                  << "outputs are supported");
+  }
+}
+
+at::Tensor allocate_output(
+    const c10::intrusive_ptr<TRTEngine>& compiled_engine,
+    TRTExecutionSlot& slot,
+    size_t pyt_idx,
+    at::ScalarType type) {
+  const auto& shape = slot.output_shapes[pyt_idx];
+  auto options = at::TensorOptions().device(at::kCUDA).dtype(type);
+  const auto& format = compiled_engine->binding_table.output_formats[pyt_idx];
+  if (!format.is_linear()) {
+    // Returned as a strided view, which the arena cannot resize in place
+    return empty_in_format(shape, options, format);
+  }
+  if (!compiled_engine->use_output_arena) {
+    // Allocate directly in the output dtype, avoids an intermediate float buffer and a conversion kernel
+    return at::empty(shape, options);
+  }
+
+  // An arena tensor can be recycled once the caller has dropped every reference to it and to its storage (views
+  // hold a reference to the storage but not to the tensor). Any work the caller enqueued on the tensor on its stream
+  // is complete before the engine writes to it since the engine stream waits on the caller stream first
+  auto& arena = slot.output_arena[pyt_idx];
+  for (auto& t : arena) {
+    if (t.use_count() == 1 && t.storage().use_count() == 1 && t.scalar_type() == type) {
+      t.resize_(shape);
+      return t;
+    }
+  }
+
+  auto t = at::empty(shape, options);
+  if (static_cast<int64_t>(arena.size()) < compiled_engine->output_arena_depth) {
+    arena.push_back(t);
+  }
+  return t;
+}
 
-    auto dims = core::util::toVec(out_shape);
-    auto type = util::TRTDataTypeToScalarType(compiled_engine->exec_ctx->getEngine().getTensorDataType(name.c_str()));
-    outputs[pyt_idx] = std::move(at::empty(dims, {at::kCUDA}).to(type).contiguous());
+// Outputs the activation arena plans for step are placed in it, when the engine runs as part of a hybrid graph
+std::vector<at::Tensor> create_output_tensors(
+    const c10::intrusive_ptr<TRTEngine>& compiled_engine,
+    TRTExecutionSlot& slot,
+    SegmentActivationArena* activation_arena = nullptr,
+    int64_t step = -1) {
+  std::vector<at::Tensor> outputs(compiled_engine->num_io.second);
+  slot.output_arena.resize(compiled_engine->num_io.second);
+  const auto& state = compiled_engine->state_bindings;
+  for (size_t pyt_idx = 0; pyt_idx < compiled_engine->num_io.second; pyt_idx++) {
+    // Data dependent outputs are allocated by TensorRT through the output allocator while the engine runs, state
+    // outputs are written to the state buffers
+    if (slot.output_is_data_dependent[pyt_idx] || (state && state->is_state_output(pyt_idx))) {
+      continue;
+    }
+    if (activation_arena != nullptr && compiled_engine->binding_table.output_formats[pyt_idx].is_linear()) {
+      outputs[pyt_idx] = activation_arena->allocate(
+          step, pyt_idx, slot.output_shapes[pyt_idx], compiled_engine->binding_table.output_types[pyt_idx]);
+      if (outputs[pyt_idx].defined()) {
+        continue;
+      }
+    }
+    retry_reclaiming_memory(
+        compiled_engine->device_info.id,
+        [&]() {
+          outputs[pyt_idx] =
+              allocate_output(compiled_engine, slot, pyt_idx, compiled_engine->binding_table.output_types[pyt_idx]);
+          return true;
+        },
+        &slot);
   }
 
   return outputs;
 }
 
-std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intrusive_ptr<TRTEngine> compiled_engine) {
+// Number of shape keys to keep pre-allocated outputs for, beyond which the outputs of all other shapes are dropped
+constexpr size_t kMaxPreAllocatedShapes = 8;
+
+bool is_released(const std::vector<at::Tensor>& outputs) {
+  for (auto& t : outputs) {
+    if (!t.defined()) {
+      continue;
+    }
+    if (t.use_count() != 1 || t.storage().use_count() != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<at::Tensor> acquire_pre_allocated_outputs(
+    const c10::intrusive_ptr<TRTEngine>& compiled_engine,
+    TRTExecutionSlot& slot) {
+  auto ring_it = slot.pre_allocated_outputs.find(slot.shape_key);
+  if (ring_it == slot.pre_allocated_outputs.end()) {
+    if (slot.pre_allocated_outputs.size() >= kMaxPreAllocatedShapes) {
+      slot.pre_allocated_outputs.clear();
+    }
+    ring_it = slot.pre_allocated_outputs.emplace(slot.shape_key, PreAllocatedOutputRing()).first;
+  }
+  auto& ring = ring_it->second;
+  auto depth = static_cast<size_t>(std::max<int64_t>(compiled_engine->pre_allocated_outputs_depth, 1));
+  if (ring.sets.size() > depth) {
+    ring.sets.resize(depth);
+    ring.next = 0;
+  }
+
+  // Prefer the oldest set the caller has released
+  for (size_t i = 0; i < ring.sets.size(); i++) {
+    size_t idx = (ring.next + i) % ring.sets.size();
+    if (is_released(ring.sets[idx])) {
+      ring.next = (idx + 1) % depth;
+      return ring.sets[idx];
+    }
+  }
+
+  // Every set is still held by the caller, grow the ring or hand the oldest set over to the caller for good
+  ScopedLatency output_allocation_timer(compiled_engine->metrics.output_allocation_latency);
+  TORCHTRT_NVTX_RANGE("output_allocation");
+  size_t idx = ring.sets.size() < depth ? ring.sets.size() : ring.next;
+  if (idx == ring.sets.size()) {
+    ring.sets.push_back(create_output_tensors(compiled_engine, slot));
+  } else {
+    ring.sets[idx] = create_output_tensors(compiled_engine, slot);
+  }
+  ring.next = (idx + 1) % depth;
+  return ring.sets[idx];
+}
+
+// Tracks the number of executions of an engine in flight, used to balance executions between replicas
+// Taken before the engine is checked to be loaded, see TRTEngine::offload
+struct InFlightExecution {
+  explicit InFlightExecution(std::atomic<int64_t>& counter) : counter(counter) {
+    counter.fetch_add(1);
+  }
+  ~InFlightExecution() {
+    counter.fetch_sub(1, std::memory_order_relaxed);
+  }
+  std::atomic<int64_t>& counter;
+};
+
+// Pads the batched inputs (the first dimension of every tensor input with the batch size of the first one) up to
+// the smallest batch bucket which holds them. Returns the original batch size, or -1 if no padding is needed
+int64_t pad_to_batch_bucket(std::vector<at::Tensor>& inputs, const c10::intrusive_ptr<TRTEngine>& compiled_engine) {
+  compiled_engine->ensure_engine_loaded();
+  const auto& is_shape_tensor = compiled_engine->binding_table.input_is_shape_tensor;
+  int64_t batch = -1;
+  for (size_t i = 0; i < inputs.size() && batch < 0; i++) {
+    if (!is_shape_tensor[i] && inputs[i].dim() > 0) {
+      batch = inputs[i].size(0);
+    }
+  }
+  int64_t bucket = compiled_engine->select_batch_bucket(batch);
+  if (batch < 0 || bucket == batch) {
+    return -1;
+  }
+
+  TORCHTRT_NVTX_RANGE("batch_padding");
+  LOG_DEBUG("Padding batch of " << batch << " to bucket " << bucket << " for engine " << compiled_engine->name);
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (is_shape_tensor[i] || inputs[i].dim() == 0 || inputs[i].size(0) != batch) {
+      continue;
+    }
+    auto shape = inputs[i].sizes().vec();
+    shape[0] = bucket;
+    auto padded = at::empty(shape, inputs[i].options());
+    padded.narrow(0, 0, batch).copy_(inputs[i]);
+    // Zero the padding so the engine never reads uninitialized (possibly non finite) values
+    padded.narrow(0, batch, bucket - batch).zero_();
+    inputs[i] = std::move(padded);
+  }
+  return batch;
+}
+
+// Captured graphs write to the buffers they were captured with, a graph captured against caller provided outputs can
+// only be replayed into those same tensors and one captured against persistent buffers only without caller outputs
+bool cudagraph_outputs_match(const CudaGraphCacheEntry& entry, const std::vector<at::Tensor>* caller_outputs) {
+  if (caller_outputs == nullptr || !entry.caller_outputs) {
+    return caller_outputs == nullptr && !entry.caller_outputs;
+  }
+  for (size_t i = 0; i < caller_outputs->size(); i++) {
+    if ((*caller_outputs)[i].data_ptr() != entry.output_buffers[i].data_ptr()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether a graph should be captured for the shape key of the slot, which has none yet
+bool admit_cudagraph(TRTExecutionSlot& slot) {
+  if (CUDAGRAPH_MAX_TOTAL_BYTES > 0 && CudaGraphCache::process_total_bytes() >= CUDAGRAPH_MAX_TOTAL_BYTES) {
+    slot.cudagraph_admission.tick();
+    return false;
+  }
+  return slot.cudagraph_admission.admit(slot.shape_key, CUDAGRAPH_MIN_EXECUTIONS, CUDAGRAPH_ADMISSION_WINDOW);
+}
+
+// Moves the persistent buffers of a graph being recorded into the shared region of the pool, each at its own offset.
+// Registered inputs, caller provided outputs, state buffers, shape tensors and non linear bindings keep their own
+// buffers. Returns
+// the bytes no longer owned by the cache entry
+int64_t place_cudagraph_buffers_in_pool(
+    const c10::intrusive_ptr<TRTEngine>& compiled_engine,
+    TRTExecutionSlot& slot,
+    CudaGraphCacheEntry& entry,
+    CudaGraphPool& pool) {
+  constexpr int64_t kAlignment = 256;
+  const auto& bindings = compiled_engine->binding_table;
+  auto padded_bytes = [](const at::Tensor& t) {
+    return (static_cast<int64_t>(t.nbytes()) + kAlignment - 1) / kAlignment * kAlignment;
+  };
+
+  std::vector<size_t> pooled_inputs, pooled_outputs;
+  int64_t nbytes = 0;
+  for (size_t i = 0; i < entry.input_buffers.size(); i++) {
+    const auto& buffer = entry.input_buffers[i];
+    if (!bindings.input_is_shape_tensor[i] && bindings.input_formats[i].is_linear() && buffer.numel() > 0 &&
+        buffer.data_ptr() != slot.formatted_inputs[i].data_ptr()) {
+      pooled_inputs.push_back(i);
+      nbytes += padded_bytes(buffer);
+    }
+  }
+  const auto& state = compiled_engine->state_bindings;
+  for (size_t o = 0; o < entry.output_buffers.size() && !entry.caller_outputs; o++) {
+    if (bindings.output_formats[o].is_linear() && entry.output_buffers[o].numel() > 0 &&
+        !(state && state->is_state_output(o))) {
+      pooled_outputs.push_back(o);
+      nbytes += padded_bytes(entry.output_buffers[o]);
+    }
+  }
+
+  const auto& region = pool.region(nbytes);
+  int64_t offset = 0, pooled_bytes = 0;
+  auto carve = [&](const at::Tensor& buffer) {
+    auto view = region.narrow(0, offset, buffer.nbytes()).view(buffer.scalar_type()).view(buffer.sizes());
+    offset += padded_bytes(buffer);
+    pooled_bytes += buffer.nbytes();
+    return view;
+  };
+  for (auto i : pooled_inputs) {
+    auto view = carve(entry.input_buffers[i]);
+    view.copy_(slot.formatted_inputs[i], true);
+    entry.input_buffers[i] = view;
+    TORCHTRT_CHECK(
+        slot.exec_ctx->setTensorAddress(bindings.input_names[i], view.data_ptr()),
+        "Error while setting the input tensor address for inputs");
+  }
+  for (auto o : pooled_outputs) {
+    entry.output_buffers[o] = carve(entry.output_buffers[o]);
+    TORCHTRT_CHECK(
+        slot.exec_ctx->setTensorAddress(bindings.output_names[o], entry.output_buffers[o].data_ptr()),
+        "Error while setting the output tensor address");
+  }
+  entry.pool_generation = pool.generation();
+  return pooled_bytes;
+}
+
+void check_caller_outputs(
+    const c10::intrusive_ptr<TRTEngine>& compiled_engine,
+    const TRTExecutionSlot& slot,
+    const std::vector<at::Tensor>& outputs,
+    const std::vector<at::Tensor>& inputs) {
+  TORCHTRT_CHECK(
+      outputs.size() == compiled_engine->num_io.second,
+      "Expected " << compiled_engine->num_io.second << " output tensors for engine " << compiled_engine->name
+                  << ", got " << outputs.size());
+  for (size_t pyt_idx = 0; pyt_idx < outputs.size(); pyt_idx++) {
+    const auto& out = outputs[pyt_idx];
+    const char* name = compiled_engine->binding_table.output_names[pyt_idx];
+    TORCHTRT_CHECK(
+        !slot.output_is_data_dependent[pyt_idx],
+        "Output tensor " << name << " has a data dependent shape and cannot be written into a caller provided tensor");
+    TORCHTRT_CHECK(
+        out.defined() && out.is_cuda() && has_format(out, compiled_engine->binding_table.output_formats[pyt_idx]),
+        "Output tensor " << name << " must be a CUDA tensor laid out in the format of the engine output, contiguous "
+                         << "for linear outputs");
+    TORCHTRT_CHECK(
+        inputs.empty() || out.device() == inputs[0].device(),
+        "Output tensor " << name << " is on " << out.device() << " but the inputs are on " << inputs[0].device());
+    TORCHTRT_CHECK(
+        out.scalar_type() == compiled_engine->binding_table.output_types[pyt_idx],
+        "Expected output tensor " << name << " to have dtype " << compiled_engine->binding_table.output_types[pyt_idx]
+                                  << ", found " << out.scalar_type());
+    TORCHTRT_CHECK(
+        out.sizes() == c10::IntArrayRef(slot.output_shapes[pyt_idx]),
+        "Expected output tensor " << name << " to have shape " << c10::IntArrayRef(slot.output_shapes[pyt_idx])
+                                  << ", found " << out.sizes());
+  }
+}
+
+// Runs the engine, writing into caller_outputs when the caller provides the output tensors, or placing outputs in the
+// activation arena when the engine runs as the step-th engine of a hybrid graph
+void bind_aux_streams(const c10::intrusive_ptr<TRTEngine>& compiled_engine, TRTExecutionSlot& slot, int64_t device) {
+  if (compiled_engine->num_aux_streams == 0) {
+    return;
+  }
+  // Otherwise TensorRT creates streams of its own, unknown to the caching allocator
+  if (slot.aux_streams_device != device) {
+    slot.aux_streams.clear();
+    for (int32_t i = 0; i < compiled_engine->num_aux_streams; i++) {
+      slot.aux_streams.push_back(
+          c10::cuda::getStreamFromPool(compiled_engine->qos_class == QOS_LATENCY_CRITICAL, device).stream());
+    }
+    slot.aux_streams_device = device;
+  }
+  // Set on every call, the active context changes with the optimization profile and contexts can be recreated
+  slot.exec_ctx->setAuxStreams(slot.aux_streams.data(), compiled_engine->num_aux_streams);
+}
+
+void reset_slot_events(TRTExecutionSlot& slot, int64_t device) {
+  // Events are bound to the device they are first recorded on
+  if ((slot.caller_exec_complete.isCreated() && slot.caller_exec_complete.device_index() != device) ||
+      (slot.trt_exec_complete.isCreated() && slot.trt_exec_complete.device_index() != device)) {
+    slot.caller_exec_complete = at::cuda::CUDAEvent();
+    slot.trt_exec_complete = at::cuda::CUDAEvent();
+  }
+}
+
+void check_weights_loaded(const c10::intrusive_ptr<TRTEngine>& compiled_engine) {
+  TORCHTRT_CHECK(
+      !compiled_engine->weights_missing,
+      "Engine " << compiled_engine->name << " was saved without its weights, refit the module with the weights of the "
+                << "module it was compiled from (torch_tensorrt::ts::refit) before running it");
+}
+
+// Binds the shared scratch memory of the engine to the context of the slot, the caller holds the lock of the arena
+void bind_shared_device_memory(const c10::intrusive_ptr<TRTEngine>& compiled_engine, TRTExecutionSlot& slot) {
+  void* device_memory = compiled_engine->shared_device_memory->data();
+  if (slot.bound_device_memory != device_memory) {
+    slot.exec_ctx->setDeviceMemoryV2(device_memory, compiled_engine->shared_device_memory->size());
+    // Captured graphs refer to the previous scratch memory, a context binding memory for the first time has none
+    if (slot.bound_device_memory != nullptr) {
+      slot.runtime_states.context_changed = true;
+    }
+    slot.bound_device_memory = device_memory;
+  }
+}
+
+// Binds device memory sized to the input shapes set on the context of the slot. The memory of the slot is only
+// reallocated when the shapes need more than it has, graphs captured against the previous memory are dropped other
+// than keep, which is captured after this
+void bind_shape_sized_device_memory(
+    const c10::intrusive_ptr<TRTEngine>& compiled_engine,
+    TRTExecutionSlot& slot,
+    const CudaGraphCacheEntry* keep) {
+  auto needed = static_cast<int64_t>(slot.exec_ctx->updateDeviceMemorySizeForShapes());
+  auto& memory = slot.shape_sized_device_memory;
+  if (!memory.defined() || static_cast<int64_t>(memory.nbytes()) < needed) {
+    if (memory.defined()) {
+      // The previous execution on the slot may still use the memory, which is released first so the caching allocator
+      // can reuse it
+      if (slot.trt_exec_complete.isCreated()) {
+        slot.trt_exec_complete.synchronize();
+      }
+      memory = at::Tensor();
+      slot.cudagraph_cache.evict_all_except(keep);
+    }
+    retry_reclaiming_memory(
+        compiled_engine->device_info.id,
+        [&]() {
+          memory = at::empty(
+              {std::max<int64_t>(needed, 1)},
+              at::TensorOptions().device(at::kCUDA, compiled_engine->device_info.id).dtype(at::kByte));
+          return true;
+        },
+        &slot);
+    // The contexts of the other profiles still point at the previous memory
+    std::fill(slot.profile_device_memory.begin(), slot.profile_device_memory.end(), nullptr);
+    slot.bound_device_memory = nullptr;
+    increment(compiled_engine->metrics.device_memory_allocations);
+    LOG_DEBUG(
+        "Allocated " << memory.nbytes() << "B of device memory for the input shapes of engine "
+                     << compiled_engine->name);
+  }
+  if (slot.bound_device_memory != memory.data_ptr()) {
+    slot.exec_ctx->setDeviceMemoryV2(memory.data_ptr(), static_cast<int64_t>(memory.nbytes()));
+    slot.bound_device_memory = memory.data_ptr();
+  }
+}
+
+std::vector<at::Tensor> execute_engine_impl(
+    std::vector<at::Tensor> inputs,
+    c10::intrusive_ptr<TRTEngine> compiled_engine,
+    const std::vector<at::Tensor>* caller_outputs,
+    SegmentActivationArena* activation_arena = nullptr,
+    int64_t step = -1) {
   LOG_DEBUG(
       "Attempting to run engine (ID: " << compiled_engine->name
                                        << "); Hardware Compatible: " << compiled_engine->hardware_compatible);
-  // nvinfer1::IExecutionContext::enqueue is not thread safe and we need a mutex for it.
-  // Other IExecutionContext methods and runtime states should be in same scope as well
-  std::unique_lock<std::mutex> lock(compiled_engine->mu);
+  TORCHTRT_NVTX_RANGE("torch_tensorrt::execute_engine");
+  if (!compiled_engine->replicas.empty()) {
+    auto replica = compiled_engine->select_replica(inputs);
+    c10::cuda::CUDAGuard device_guard(replica->device_info.id);
+    // Host inputs are moved to the selected replica, device inputs already are on it
+    replica->ensure_engine_loaded();
+    for (size_t i = 0; i < inputs.size(); i++) {
+      if (!inputs[i].is_cuda() && !replica->binding_table.input_is_shape_tensor[i]) {
+        inputs[i] = inputs[i].to(torch::Device(torch::kCUDA, replica->device_info.id), /*non_blocking=*/true);
+      }
+    }
+    if (replica.get() != compiled_engine.get()) {
+      return execute_engine_impl(std::move(inputs), std::move(replica), caller_outputs, activation_arena, step);
+    }
+  }
+  InFlightExecution in_flight(compiled_engine->in_flight_executions);
+  compiled_engine->ensure_engine_loaded();
+  compiled_engine->last_execution_ns.store(steady_now_ns(), std::memory_order_relaxed);
+  check_weights_loaded(compiled_engine);
+  if (compiled_engine->dla_loadable) {
+    return compiled_engine->run_dla_loadable(inputs, caller_outputs);
+  }
+  auto& metrics = compiled_engine->metrics;
+  // Executions of engines with state bindings are serialized, each reads the state the previous one wrote
+  auto state = compiled_engine->state_bindings;
+  std::unique_lock<std::mutex> state_lock;
+  if (state) {
+    TORCHTRT_CHECK(
+        caller_outputs == nullptr && activation_arena == nullptr,
+        "Engine " << compiled_engine->name << " has state bindings and cannot run into caller provided outputs");
+    state_lock = state->lock();
+    inputs = state->bind_inputs(std::move(inputs));
+  }
+  // Caller provided outputs have the shape of the caller's batch, so these executions are never batched or padded,
+  // nor are stateful executions whose state has the shape of a single stream
+  auto batcher = caller_outputs == nullptr && !state ? compiled_engine->dynamic_batcher : nullptr;
+  if (batcher && !DynamicBatcher::on_worker_thread()) {
+    if (auto outputs = batcher->submit(inputs, compiled_engine)) {
+      return std::move(*outputs);
+    }
+  }
+  if (caller_outputs == nullptr && !state && !compiled_engine->batch_buckets.empty()) {
+    auto batch = pad_to_batch_bucket(inputs, compiled_engine);
+    if (batch >= 0) {
+      // The padded inputs match their bucket exactly so they run (and capture CUDA graphs) like any static shape
+      increment(metrics.padded_executions);
+      auto bucket = compiled_engine->select_batch_bucket(batch);
+      auto outputs = execute_engine_impl(std::move(inputs), compiled_engine, nullptr);
+      for (auto& out : outputs) {
+        if (out.dim() > 0 && out.size(0) == bucket) {
+          out = out.narrow(0, 0, batch);
+        }
+      }
+      return outputs;
+    }
+  }
+  ScopedLatency execute_timer(metrics.execute_latency);
+  increment(metrics.executions);
+  // nvinfer1::IExecutionContext::enqueue is not thread safe, so each caller checks out its own execution slot
+  // (context, streams, CUDA graph and buffers) from the engine's pool for the duration of the call.
+  // The engine profiler is shared between slots so profiled executions are still serialized
+  std::unique_lock<std::mutex> profiling_lock(compiled_engine->profiling_mu, std::defer_lock);
+  if (compiled_engine->profile_execution) {
+    profiling_lock.lock();
+  }
+  auto slot_guard = compiled_engine->acquire_execution_slot();
+  TRTExecutionSlot& slot = **slot_guard;
   if (compiled_engine->profile_execution) {
     std::stringstream ss;
     ss << "Execution profiling is enabled, find results here:" << std::endl;
@@ -200,25 +822,117 @@ std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intr
     ss << "  CUDA Graph trace: " << compiled_engine->cuda_graph_debug_path << std::endl;
     auto log_info = ss.str();
     LOG_INFO("" << log_info);
-    compiled_engine->cudagraph.enable_debug_mode();
   }
-  bool cudagraphs_enabled = (CUDAGRAPHS_MODE == SUBGRAPH_CUDAGRAPHS);
-  bool shape_changed = _validate_shapes(inputs, compiled_engine);
+  // Engines run inside a capture of the caller (e.g. of the whole module) are part of that graph instead of capturing
+  // their own, and keep the graphs they captured before
+  bool outer_capture = CUDAGRAPHS_MODE == SUBGRAPH_CUDAGRAPHS &&
+      c10::cuda::currentStreamCaptureStatusMayInitCtx() != c10::cuda::CaptureStatus::None;
+  // Data dependent outputs are (re)allocated while the engine runs, which cannot be captured in a graph
+  bool cudagraphs_enabled =
+      (CUDAGRAPHS_MODE == SUBGRAPH_CUDAGRAPHS) && !compiled_engine->has_data_dependent_outputs && !outer_capture;
+  bool shape_changed = _validate_shapes(inputs, compiled_engine, slot);
 
-  // Whether cudagraphs needs to record the graph on this pass
-  auto result = compiled_engine->runtime_states.set_runtime_states(
-      cudagraphs_enabled, compiled_engine->use_pre_allocated_outputs, shape_changed);
+  // The profile is a function of the input shapes, so it only needs to be reselected when they change. Contexts are
+  // kept per profile, a switch only needs the shapes to be set again which a shape change already implies
+  if (compiled_engine->num_optimization_profiles > 1 && (shape_changed || slot.runtime_states.context_changed)) {
+    std::vector<c10::IntArrayRef> shapes;
+    shapes.reserve(inputs.size());
+    for (auto& in : inputs) {
+      shapes.push_back(in.sizes());
+    }
+    compiled_engine->activate_optimization_profile(slot, compiled_engine->select_optimization_profile(shapes));
+  }
+  compiled_engine->apply_persistent_cache_limit(slot);
 
-  bool need_cudagraphs_record = std::get<0>(result);
-  bool can_use_pre_allocated_outputs = std::get<1>(result);
-  bool need_cudagraphs_reset = std::get<2>(result);
+  // Engines running out of a shared arena hold it for the rest of the call, the memory bound to the context on the
+  // previous call may have been reallocated since if another engine grew the arena
+  std::unique_lock<std::mutex> device_memory_lock;
+  if (compiled_engine->shared_device_memory) {
+    device_memory_lock = compiled_engine->shared_device_memory->lock();
+    bind_shared_device_memory(compiled_engine, slot);
+  }
 
-  if (need_cudagraphs_reset) {
-    compiled_engine->cudagraph.reset();
+  // Engines capturing into a shared graph pool hold it from the copy in of their inputs until the copy out of their
+  // outputs, the persistent buffers of their graphs share one region
+  CudaGraphPool* cudagraph_pool = cudagraphs_enabled ? compiled_engine->cudagraph_pool.get() : nullptr;
+  std::unique_lock<std::mutex> cudagraph_pool_lock;
+  if (cudagraph_pool) {
+    cudagraph_pool_lock = cudagraph_pool->lock();
   }
 
+  bool context_changed = slot.runtime_states.context_changed;
+  if (shape_changed) {
+    increment(metrics.shape_changes);
+  }
+
+  slot.runtime_states.set_runtime_states(cudagraphs_enabled, compiled_engine->use_pre_allocated_outputs, shape_changed);
+
+  // Steady state fast path: if the shapes bound to this slot's context are unchanged, there is no need to set input
+  // shapes, run shape inference or query output shapes again, only tensor addresses need to be rebound. Shape tensor
+  // values are part of the shape key so this also holds for engines with shape tensor inputs
+  bool need_shape_update = shape_changed || context_changed;
+
+  // Captured graphs are keyed by input shape, so a change of shape only needs a new capture if that shape has not
+  // been seen before. Graphs are only invalidated when CUDA graphs are turned off or the context is recreated
+  if (context_changed || (!cudagraphs_enabled && !outer_capture)) {
+    slot.cudagraph_cache.clear();
+  }
+
+  CudaGraphCacheEntry* cudagraph_entry = nullptr;
+  bool need_cudagraphs_record = false;
+  // Engines with state bindings keep a graph for each buffer the states are read from, which alternates every call
+  const ShapeKey* cudagraph_key = &slot.shape_key;
+  ShapeKey state_key;
+  if (cudagraphs_enabled && state) {
+    state_key = slot.shape_key;
+    int64_t parity = state->parity();
+    state_key.append_values(&parity, 1);
+    cudagraph_key = &state_key;
+  }
+  if (cudagraphs_enabled) {
+    cudagraph_entry = slot.cudagraph_cache.find(*cudagraph_key);
+    bool outputs_changed = cudagraph_entry != nullptr && !cudagraph_outputs_match(*cudagraph_entry, caller_outputs);
+    // Graphs captured before another engine grew the shared region write to the previous one
+    bool pool_moved = cudagraph_entry != nullptr && cudagraph_entry->pool_generation >= 0 &&
+        (!cudagraph_pool || cudagraph_entry->pool_generation != cudagraph_pool->generation());
+    if (cudagraph_entry == nullptr && !admit_cudagraph(slot)) {
+      // Shapes which are not seen often enough, or which would exceed the memory cap, run without a graph
+      increment(metrics.cudagraph_deferrals);
+      cudagraphs_enabled = false;
+      cudagraph_pool = nullptr;
+      if (cudagraph_pool_lock.owns_lock()) {
+        cudagraph_pool_lock.unlock();
+      }
+    } else if (cudagraph_entry == nullptr || outputs_changed || pool_moved) {
+      need_cudagraphs_record = true;
+      if (cudagraph_entry != nullptr) {
+        // Recaptures of an admitted shape, admit_cudagraph counted new ones
+        slot.cudagraph_admission.tick();
+      }
+      increment(
+          context_changed || outputs_changed || pool_moved ? metrics.cudagraph_recaptures : metrics.cudagraph_misses);
+      cudagraph_entry = &slot.cudagraph_cache.emplace(*cudagraph_key);
+      cudagraph_entry->input_buffers.resize(compiled_engine->num_io.first);
+      cudagraph_entry->output_buffers.resize(compiled_engine->num_io.second);
+      if (compiled_engine->profile_execution) {
+        cudagraph_entry->cudagraph->enable_debug_mode();
+      }
+    } else {
+      increment(metrics.cudagraph_hits);
+      slot.cudagraph_admission.tick();
+    }
+  }
+  slot.cudagraph_in_use = cudagraph_entry;
+
   // Intialize inputs and outputs to be available throughout the succeeding scopes
   std::vector<at::Tensor> outputs(compiled_engine->num_io.second);
+  // Bytes of the persistent buffers of a new graph which live in the shared region of the pool
+  int64_t pooled_bytes = 0;
+
+  if (compiled_engine->stage_host_inputs) {
+    TORCHTRT_NVTX_RANGE("stage_host_inputs");
+    stage_host_inputs(inputs, compiled_engine, slot);
+  }
 
   if (MULTI_DEVICE_SAFE_MODE) {
     std::unique_ptr<torch::autograd::profiler::RecordProfile> device_profiler_guard;
@@ -226,46 +940,71 @@ std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intr
       device_profiler_guard =
           std::make_unique<torch::autograd::profiler::RecordProfile>(compiled_engine->device_profile_path);
     }
+    TORCHTRT_NVTX_RANGE("device_check");
 
-    RTDevice curr_device = get_current_device();
-    LOG_DEBUG("Current Device: " << curr_device);
-
-    // Generic Target Device Prefix
-    std::string target_device = "cuda:";
+    // The engine's device info is the device it was placed on, so a matching device index means the current device
+    // is the engine's device and the device properties do not need to be compared
+    int current_device_id = -1;
+    TORCHTRT_CHECK(cudaGetDevice(&current_device_id) == cudaSuccess, "Unable to get current device");
+    int64_t target_device_id = current_device_id;
 
-    if (is_switch_required(curr_device, compiled_engine->device_info)) {
-      // Scan through available CUDA devices and set the CUDA device context correctly
-      RTDevice device =
-          select_rt_device(compiled_engine->device_info, curr_device, compiled_engine->hardware_compatible);
-      set_rt_device(device);
+    if (current_device_id != compiled_engine->device_info.id) {
+      RTDevice curr_device = get_current_device();
+      LOG_DEBUG("Current Device: " << curr_device);
+      if (is_switch_required(curr_device, compiled_engine->device_info)) {
+        // Scan through available CUDA devices and set the CUDA device context correctly
+        RTDevice device =
+            select_rt_device(compiled_engine->device_info, curr_device, compiled_engine->hardware_compatible);
+        set_rt_device(device);
+        increment(metrics.device_switches);
 
-      // Target device is new device
-      target_device += std::to_string(device.id);
+        // Target device is new device
+        target_device_id = device.id;
 
-      for (auto& in : inputs) {
-        in = in.to(torch::Device(target_device));
+        for (auto& in : inputs) {
+          in = in.is_cuda() ? copy_from_peer(in, device.id) : in.to(torch::Device(torch::kCUDA, device.id));
+        }
+        increment(metrics.input_moves, static_cast<int64_t>(inputs.size()));
       }
-    } else {
-      // Target device is current device
-      target_device += std::to_string(curr_device.id);
     }
 
-    // For each input, ensure its current device is the desired target device
-    for (size_t i = 0; i < inputs.size(); i++) {
+    // For each input, ensure its current device is the desired target device. Input devices are part of the shape
+    // key, so they only need to be checked again if inputs with this key had to be moved or the target changed
+    bool inputs_on_device = slot.inputs_on_device == target_device_id && !VALIDATE_INPUTS_EVERY_CALL;
+    int64_t moved = 0;
+    for (size_t i = 0; i < inputs.size() && !inputs_on_device; i++) {
       at::Tensor* in = &inputs[i];
-      std::string current_tensor_device = in->device().str();
 
-      // If current device string does not match target device, display warning and move tensor accordingly
-      if (current_tensor_device != target_device) {
+      // Inputs on other GPUs come from pipeline stages and are moved silently, host inputs are moved with a warning.
+      // Shape tensor inputs are read from their host staging buffers so they may stay on the CPU
+      if (in->is_cuda() && in->device().index() != target_device_id &&
+          !compiled_engine->binding_table.input_is_shape_tensor[i]) {
+        *in = copy_from_peer(*in, target_device_id);
+        increment(metrics.input_moves);
+        moved++;
+      } else if (
+          !in->is_cuda() && !compiled_engine->binding_table.input_is_shape_tensor[i] &&
+          !mapped_host_input(*in, compiled_engine->device_info, compiled_engine->binding_table.input_formats[i])) {
+        torch::Device target_device(torch::kCUDA, target_device_id);
         LOG_WARNING(
-            "Input " << i << " of engine " << compiled_engine->name << " was found to be on " << current_tensor_device
+            "Input " << i << " of engine " << compiled_engine->name << " was found to be on " << in->device()
                      << " but should be on " << target_device << ". This tensor is being moved by the runtime but "
                      << "for performance considerations, ensure your inputs are all on GPU "
                      << "and open an issue here (https://github.com/pytorch/TensorRT/issues) if this "
                      << "warning persists.");
-        *in = in->to(torch::Device(target_device));
+        *in = in->to(target_device);
+        increment(metrics.input_moves);
+        moved++;
       }
     }
+    if (!inputs_on_device && moved == 0 && target_device_id == current_device_id) {
+      slot.inputs_on_device = target_device_id;
+    }
+  }
+
+  if (cudagraph_pool) {
+    // Wait for the previous user of the shared buffers before copying the inputs in
+    cudagraph_pool->wait(c10::cuda::getCurrentCUDAStream(cudagraph_pool->device()));
   }
 
   { // Input Setup
@@ -274,17 +1013,27 @@ std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intr
       input_profiler_guard =
           std::make_unique<torch::autograd::profiler::RecordProfile>(compiled_engine->input_profile_path);
     }
+    ScopedLatency input_setup_timer(metrics.input_setup_latency);
+    TORCHTRT_NVTX_RANGE("input_setup");
 
-    setup_input_tensors(inputs, compiled_engine, cudagraphs_enabled, need_cudagraphs_record);
-    // Check if input shapes can be inferred.
-    int32_t const io_size{compiled_engine->cuda_engine->getNbIOTensors()};
-    std::vector<char const*> names(io_size);
-    int32_t const nbNames = compiled_engine->exec_ctx->inferShapes(names.size(), names.data());
-    TORCHTRT_CHECK(
-        nbNames == 0,
-        "The shapes of the inputs: "
-            << names
-            << " cannot be inferred. This could happen if the input tensor addresses/shapes haven't been configured correctly");
+    setup_input_tensors(inputs, compiled_engine, slot, cudagraph_entry, need_cudagraphs_record, need_shape_update);
+
+    if (need_shape_update) {
+      TORCHTRT_NVTX_RANGE("inferShapes");
+      // Check if input shapes can be inferred.
+      int32_t const io_size{compiled_engine->cuda_engine->getNbIOTensors()};
+      std::vector<char const*> names(io_size);
+      int32_t const nbNames = slot.exec_ctx->inferShapes(names.size(), names.data());
+      TORCHTRT_CHECK(
+          nbNames == 0,
+          "The shapes of the inputs: "
+              << names
+              << " cannot be inferred. This could happen if the input tensor addresses/shapes haven't been configured correctly");
+      update_output_shapes(compiled_engine, slot);
+    }
+    if (compiled_engine->uses_shape_sized_device_memory() && (need_shape_update || !slot.bound_device_memory)) {
+      bind_shape_sized_device_memory(compiled_engine, slot, cudagraph_entry);
+    }
   }
 
   { // Output Setup
@@ -293,48 +1042,91 @@ std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intr
       output_profiler_guard =
           std::make_unique<torch::autograd::profiler::RecordProfile>(compiled_engine->output_profile_path);
     }
-    if (can_use_pre_allocated_outputs) {
-      outputs = compiled_engine->pre_allocated_outputs;
+    if (caller_outputs != nullptr) {
+      check_caller_outputs(compiled_engine, slot, *caller_outputs, inputs);
+      outputs = *caller_outputs;
+    } else if (compiled_engine->use_pre_allocated_outputs) {
+      outputs = acquire_pre_allocated_outputs(compiled_engine, slot);
     } else {
-      outputs = create_output_tensors(compiled_engine);
+      ScopedLatency output_allocation_timer(metrics.output_allocation_latency);
+      TORCHTRT_NVTX_RANGE("output_allocation");
+      outputs = create_output_tensors(compiled_engine, slot, activation_arena, step);
+    }
+    if (state) {
+      // State outputs are written to the buffers the next execution reads
+      state->bind_outputs(outputs, slot.output_shapes);
     }
 
-    for (auto output_indices : compiled_engine->out_binding_map) {
-      auto pyt_idx = output_indices.second;
-      std::string name = compiled_engine->out_binding_names[pyt_idx];
+    for (size_t pyt_idx = 0; pyt_idx < compiled_engine->num_io.second; pyt_idx++) {
+      const char* name = compiled_engine->binding_table.output_names[pyt_idx];
+      if (slot.output_is_data_dependent[pyt_idx]) {
+        TORCHTRT_CHECK(
+            !cudagraphs_enabled,
+            "Output " << name << " of engine " << compiled_engine->name
+                      << " has a data dependent shape, the engine cannot be run with CUDA graphs");
+        if (!slot.output_allocator) {
+          slot.output_allocator = std::make_unique<DynamicOutputAllocator>(compiled_engine->out_binding_names);
+        }
+        TORCHTRT_CHECK(
+            slot.exec_ctx->setOutputAllocator(name, slot.output_allocator.get()),
+            "Error while setting the output allocator");
+        continue;
+      }
       if (need_cudagraphs_record) {
-        // If we are recording the cuda graph then we need to update the persistent output buffer
-        compiled_engine->output_buffers[pyt_idx] = std::move(outputs[pyt_idx].clone());
+        // If we are recording the cuda graph then we need to update the persistent output buffer. Caller provided
+        // outputs and state buffers are captured against directly so that replay writes to them without a copy
+        cudagraph_entry->caller_outputs = caller_outputs != nullptr;
+        bool direct = caller_outputs != nullptr || (state && state->is_state_output(pyt_idx));
+        cudagraph_entry->output_buffers[pyt_idx] = direct
+            ? outputs[pyt_idx]
+            : clone_in_format(outputs[pyt_idx], compiled_engine->binding_table.output_formats[pyt_idx]);
       }
 
       if (cudagraphs_enabled) {
         TORCHTRT_CHECK(
-            compiled_engine->exec_ctx->setTensorAddress(
-                name.c_str(), compiled_engine->output_buffers[pyt_idx].data_ptr()),
+            slot.exec_ctx->setTensorAddress(name, cudagraph_entry->output_buffers[pyt_idx].data_ptr()),
             "Error while setting the output tensor address");
       } else {
         TORCHTRT_CHECK(
-            compiled_engine->exec_ctx->setTensorAddress(name.c_str(), outputs[pyt_idx].data_ptr()),
+            slot.exec_ctx->setTensorAddress(name, outputs[pyt_idx].data_ptr()),
             "Error while setting the output tensor address");
       }
     }
+    if (need_cudagraphs_record && cudagraph_pool) {
+      pooled_bytes = place_cudagraph_buffers_in_pool(compiled_engine, slot, *cudagraph_entry, *cudagraph_pool);
+    }
   }
 
   auto current_device_id = -1;
   if (inputs.size() > 0) {
-    current_device_id = inputs[0].device().index(); // Done this way to avoid a call to cudart
+    // Host inputs (shape tensors, mapped inputs on integrated GPUs) do not have a device index
+    current_device_id = inputs[0].is_cuda() ? inputs[0].device().index() : compiled_engine->device_info.id;
   } else if (outputs.size() > 0) {
     current_device_id = outputs[0].device().index(); // Done this way to avoid a call to cudart
   }
 
-  compiled_engine->caller_stream = c10::cuda::getCurrentCUDAStream(current_device_id);
-  if (compiled_engine->engine_stream == c10::cuda::getDefaultCUDAStream(current_device_id)) {
+  slot.caller_stream = c10::cuda::getCurrentCUDAStream(current_device_id);
+  // In caller stream mode TRT enqueues directly on the caller's stream and no cross stream synchronization is needed.
+  // Graphs cannot be captured on the legacy default stream, so that case still goes through the engine stream
+  bool use_caller_stream = compiled_engine->use_caller_stream &&
+      !(cudagraphs_enabled && slot.caller_stream == c10::cuda::getDefaultCUDAStream(current_device_id));
+  if (!use_caller_stream && slot.engine_stream == c10::cuda::getDefaultCUDAStream(current_device_id)) {
     // Create a new stream if the engine stream is the default stream
-    compiled_engine->engine_stream = c10::cuda::getStreamFromPool(false, current_device_id);
+    slot.engine_stream =
+        c10::cuda::getStreamFromPool(compiled_engine->qos_class == QOS_LATENCY_CRITICAL, current_device_id);
   }
+  c10::cuda::CUDAStream exec_stream = use_caller_stream ? slot.caller_stream : slot.engine_stream;
+  bind_aux_streams(compiled_engine, slot, current_device_id);
+  reset_slot_events(slot, current_device_id);
 
   { // Engine Execution (execute on engine stream)
-    c10::cuda::CUDAStreamGuard stream_guard(compiled_engine->engine_stream);
+    // Background engines wait for the device to have few enough background executions in flight before enqueueing
+    std::optional<EnqueueAdmission::Ticket> admission;
+    if (compiled_engine->qos_class == QOS_BACKGROUND && BACKGROUND_MAX_IN_FLIGHT > 0) {
+      TORCHTRT_NVTX_RANGE("admission");
+      admission.emplace(get_background_admission(current_device_id).acquire(BACKGROUND_MAX_IN_FLIGHT));
+    }
+    c10::cuda::CUDAStreamGuard stream_guard(exec_stream);
 
     std::unique_ptr<torch::autograd::profiler::RecordProfile> enqueue_profiler_guard;
     if (compiled_engine->profile_execution) {
@@ -342,48 +1134,139 @@ std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intr
           std::make_unique<torch::autograd::profiler::RecordProfile>(compiled_engine->enqueue_profile_path);
     }
 
-    // Block engine stream until results are available on caller stream
-    at::cuda::CUDAEvent caller_exec_complete;
-    caller_exec_complete.record(compiled_engine->caller_stream);
-    caller_exec_complete.block(compiled_engine->engine_stream);
+    if (!use_caller_stream) {
+      // Block engine stream until results are available on caller stream
+      slot.caller_exec_complete.record(slot.caller_stream);
+      slot.caller_exec_complete.block(exec_stream);
+    }
+    if (compiled_engine->shared_device_memory) {
+      // Wait for the previous user of the shared scratch memory
+      compiled_engine->shared_device_memory->wait(exec_stream);
+    }
 
+    ScopedLatency enqueue_timer(metrics.enqueue_latency);
     if (!cudagraphs_enabled) {
+      // Sampled executions run with the layer profiler attached, attaching it makes this one enqueue synchronous
+      bool sampled = !compiled_engine->profile_execution && compiled_engine->layer_sampler->sample();
+      if (sampled) {
+        slot.exec_ctx->setProfiler(compiled_engine->layer_sampler.get());
+      }
       // Direct execution uses the caller buffers directly
-      compiled_engine->exec_ctx->enqueueV3(compiled_engine->engine_stream);
+      TORCHTRT_NVTX_RANGE("enqueueV3");
+      slot.exec_ctx->enqueueV3(exec_stream);
+      if (sampled) {
+        slot.exec_ctx->setProfiler(nullptr);
+        compiled_engine->layer_sampler->end_sample();
+      }
     } else {
       if (need_cudagraphs_record) {
         // If cudagraphs needs to record a graph, capture the enqueueV3 call in a graph
-        c10::cuda::CUDAStream recording_stream = compiled_engine->engine_stream;
-        compiled_engine->cudagraph.capture_begin();
-        compiled_engine->exec_ctx->enqueueV3(recording_stream);
-        compiled_engine->cudagraph.capture_end();
+        TORCHTRT_NVTX_RANGE("cudagraph_capture");
+        c10::cuda::CUDAStream recording_stream = exec_stream;
+        bool first_capture = true;
+        retry_reclaiming_memory(
+            current_device_id,
+            [&]() {
+              if (!first_capture) {
+                // The graph of the failed capture cannot be instantiated again
+                cudagraph_entry->cudagraph = std::make_unique<at::cuda::CUDAGraph>();
+                if (compiled_engine->profile_execution) {
+                  cudagraph_entry->cudagraph->enable_debug_mode();
+                }
+              }
+              first_capture = false;
+              if (cudagraph_pool) {
+                cudagraph_entry->cudagraph->capture_begin(cudagraph_pool->id());
+              } else {
+                cudagraph_entry->cudagraph->capture_begin();
+              }
+              slot.exec_ctx->enqueueV3(recording_stream);
+              cudagraph_entry->cudagraph->capture_end();
+              return true;
+            },
+            &slot);
 
         if (compiled_engine->profile_execution) {
-          compiled_engine->cudagraph.debug_dump(compiled_engine->cuda_graph_debug_path);
+          cudagraph_entry->cudagraph->debug_dump(compiled_engine->cuda_graph_debug_path);
         }
       }
 
       // Replay the CUDAGraph
-      compiled_engine->cudagraph.replay(); // Has a cudaDeviceSynchronize internally
+      TORCHTRT_NVTX_RANGE("cudagraph_replay");
+      cudagraph_entry->cudagraph->replay(); // Has a cudaDeviceSynchronize internally
+    }
+
+    if (compiled_engine->shared_device_memory) {
+      compiled_engine->shared_device_memory->record(exec_stream);
+    }
+    if (admission) {
+      admission->complete(exec_stream);
     }
   } // End engine exeuction (resets to caller stream)
 
-  // Create output buffer for next execution of graph or trt context.
-  if (compiled_engine->use_pre_allocated_outputs) {
-    compiled_engine->pre_allocated_outputs = create_output_tensors(compiled_engine);
+  if (!use_caller_stream) {
+    // Block caller stream until engine execution is complete
+    slot.trt_exec_complete.record(exec_stream);
+    slot.trt_exec_complete.block(slot.caller_stream);
   }
 
-  // Block caller stream until engine execution is complete
-  at::cuda::CUDAEvent trt_exec_complete;
-  trt_exec_complete.record(compiled_engine->engine_stream);
-  trt_exec_complete.block(compiled_engine->caller_stream);
+  if (slot.output_allocator) {
+    // TensorRT has reported the final shapes of the data dependent outputs by the time enqueueV3 returns
+    for (size_t pyt_idx = 0; pyt_idx < compiled_engine->num_io.second; pyt_idx++) {
+      if (!slot.output_is_data_dependent[pyt_idx]) {
+        continue;
+      }
+      outputs[pyt_idx] =
+          slot.output_allocator->output(pyt_idx, compiled_engine->binding_table.output_types[pyt_idx]);
+      // The buffer was allocated on the engine stream but is consumed on the caller's
+      const auto& buffer = slot.output_allocator->buffer(pyt_idx);
+      if (!use_caller_stream && buffer.defined()) {
+        c10::cuda::CUDACachingAllocator::recordStream(buffer.storage().data_ptr(), slot.caller_stream);
+      }
+    }
+  }
 
   if (cudagraphs_enabled) {
     // If in CUDAGraph mode, results need to be copied to the result buffers (on caller stream)
-    for (size_t o = 0; o < compiled_engine->output_buffers.size(); o++) {
-      outputs[o].copy_(compiled_engine->output_buffers[o], false);
+    for (size_t o = 0; o < cudagraph_entry->output_buffers.size(); o++) {
+      if (cudagraph_entry->output_buffers[o].data_ptr() != outputs[o].data_ptr()) {
+        outputs[o].copy_(cudagraph_entry->output_buffers[o], false);
+      }
+    }
+    if (cudagraph_pool) {
+      cudagraph_pool->record(slot.caller_stream);
+    }
+
+    if (need_cudagraphs_record) {
+      // Account for the persistent buffers of the new graph, which may evict less recently used shapes
+      int64_t nbytes = 0;
+      for (auto& buffer : cudagraph_entry->input_buffers) {
+        nbytes += buffer.defined() ? buffer.nbytes() : 0;
+      }
+      for (size_t o = 0; o < cudagraph_entry->output_buffers.size(); o++) {
+        // Caller provided outputs and state buffers are not owned by the cache
+        const auto& buffer = cudagraph_entry->output_buffers[o];
+        bool owned = !cudagraph_entry->caller_outputs && !(state && state->is_state_output(o));
+        nbytes += buffer.defined() && owned ? buffer.nbytes() : 0;
+      }
+      // Nor are buffers in the shared region of the pool
+      slot.cudagraph_cache.commit(
+          *cudagraph_entry,
+          nbytes - pooled_bytes,
+          compiled_engine->cudagraph_cache_max_entries,
+          compiled_engine->cudagraph_cache_max_bytes);
+    }
+  }
+
+  // Inputs only needed to be kept alive until the engine was enqueued. Pinned host inputs read in place are only
+  // handed back to the host allocator once the caller stream is past the execution
+  for (const auto& in : slot.formatted_inputs) {
+    if (in.defined() && !in.is_cuda()) {
+      at::cuda::CachingHostAllocator_recordEvent(
+          in.storage().data_ptr().get(), in.storage().data_ptr().get_context(), slot.caller_stream);
     }
   }
+  std::fill(slot.formatted_inputs.begin(), slot.formatted_inputs.end(), at::Tensor());
 
   if (compiled_engine->profile_execution) {
     LOG_INFO(std::endl << *compiled_engine->trt_engine_profiler);
@@ -391,9 +1274,322 @@ std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intr
     compiled_engine->dump_engine_layer_info();
   }
 
+  if (!compiled_engine->host_outputs.empty() && caller_outputs == nullptr) {
+    TORCHTRT_NVTX_RANGE("host_outputs");
+    // Copied on the caller stream, which is past the execution, into pinned memory the host allocator only recycles
+    // once the copy is done
+    for (size_t o = 0; o < outputs.size(); o++) {
+      if (compiled_engine->host_outputs[o]) {
+        auto host = at::empty(outputs[o].sizes(), outputs[o].options().device(at::kCPU).pinned_memory(true));
+        host.copy_(outputs[o], /*non_blocking=*/true);
+        outputs[o] = std::move(host);
+      }
+    }
+  }
+
+  if (state) {
+    // The written buffers become the state once the caller stream is past this execution
+    return state->advance(std::move(outputs), slot.caller_stream);
+  }
+  return outputs;
+}
+
+// Outputs of the engine in the order it returns them from the outputs it binds, the others are the inputs or earlier
+// outputs they alias
+std::vector<at::Tensor> expand_output_aliases(
+    const TRTEngine& compiled_engine,
+    const std::vector<at::Tensor>& inputs,
+    std::vector<at::Tensor> bound) {
+  if (compiled_engine.output_sources.empty()) {
+    return bound;
+  }
+  std::vector<at::Tensor> outputs;
+  outputs.reserve(compiled_engine.output_sources.size());
+  for (const auto& source : compiled_engine.output_sources) {
+    at::Tensor out;
+    if (source.kind == TRTEngine::OutputSource::kBinding) {
+      out = std::move(bound[source.index]);
+    } else if (source.kind == TRTEngine::OutputSource::kInput) {
+      out = inputs[source.index];
+    } else {
+      out = outputs[source.index];
+    }
+    outputs.push_back(std::move(out));
+  }
   return outputs;
 }
 
+std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intrusive_ptr<TRTEngine> compiled_engine) {
+  if (compiled_engine->output_sources.empty()) {
+    return execute_engine_impl(std::move(inputs), std::move(compiled_engine), nullptr);
+  }
+  auto bound = execute_engine_impl(inputs, compiled_engine, nullptr);
+  return expand_output_aliases(*compiled_engine, inputs, std::move(bound));
+}
+
+std::vector<at::Tensor> execute_engine_bindings(
+    std::vector<at::Tensor> inputs,
+    c10::intrusive_ptr<TRTEngine> compiled_engine) {
+  return execute_engine_impl(std::move(inputs), std::move(compiled_engine), nullptr);
+}
+
+void execute_engine_out(
+    std::vector<at::Tensor> inputs,
+    std::vector<at::Tensor> outputs,
+    c10::intrusive_ptr<TRTEngine> compiled_engine) {
+  const auto& sources = compiled_engine->output_sources;
+  if (sources.empty()) {
+    execute_engine_impl(std::move(inputs), std::move(compiled_engine), &outputs);
+    return;
+  }
+  TORCHTRT_CHECK(
+      outputs.size() == sources.size(),
+      "Expected " << sources.size() << " output tensors for engine " << compiled_engine->name << ", got "
+                  << outputs.size());
+  std::vector<at::Tensor> bound;
+  for (size_t o = 0; o < sources.size(); o++) {
+    if (sources[o].kind == TRTEngine::OutputSource::kBinding) {
+      bound.push_back(outputs[o]);
+    }
+  }
+  execute_engine_impl(inputs, compiled_engine, &bound);
+  // The outputs the engine does not bind are written in order, an output aliasing an earlier one is written after it
+  for (size_t o = 0; o < sources.size(); o++) {
+    if (sources[o].kind != TRTEngine::OutputSource::kBinding) {
+      bool of_input = sources[o].kind == TRTEngine::OutputSource::kInput;
+      outputs[o].copy_(of_input ? inputs[sources[o].index] : outputs[sources[o].index], /*non_blocking=*/true);
+    }
+  }
+}
+
+std::vector<at::Tensor> execute_engine_in_arena(
+    std::vector<at::Tensor> inputs,
+    c10::intrusive_ptr<TRTEngine> compiled_engine,
+    c10::intrusive_ptr<SegmentActivationArena> arena,
+    int64_t step) {
+  if (compiled_engine->output_sources.empty()) {
+    return execute_engine_impl(std::move(inputs), std::move(compiled_engine), nullptr, arena.get(), step);
+  }
+  auto bound = execute_engine_impl(inputs, compiled_engine, nullptr, arena.get(), step);
+  return expand_output_aliases(*compiled_engine, inputs, std::move(bound));
+}
+
+ExecutionTicket::~ExecutionTicket() {
+  release();
+}
+
+void ExecutionTicket::release() {
+  if (slot) {
+    // Drops the inputs of a ticket which was never launched
+    std::fill((*slot)->formatted_inputs.begin(), (*slot)->formatted_inputs.end(), at::Tensor());
+    slot.reset();
+    engine->in_flight_executions.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+c10::intrusive_ptr<ExecutionTicket> prepare_execution(
+    std::vector<at::Tensor> inputs,
+    c10::intrusive_ptr<TRTEngine> compiled_engine) {
+  TORCHTRT_NVTX_RANGE("torch_tensorrt::prepare_execution");
+  if (!compiled_engine->replicas.empty()) {
+    compiled_engine = compiled_engine->select_replica(inputs);
+  }
+  // The ticket counts as in flight once it holds its slot
+  InFlightExecution preparing(compiled_engine->in_flight_executions);
+  compiled_engine->ensure_engine_loaded();
+  compiled_engine->last_execution_ns.store(steady_now_ns(), std::memory_order_relaxed);
+  check_weights_loaded(compiled_engine);
+  TORCHTRT_CHECK(
+      !compiled_engine->dla_loadable,
+      "Engine " << compiled_engine->name << " is a DLA loadable, its executions cannot be prepared ahead of launch");
+  TORCHTRT_CHECK(
+      !compiled_engine->state_bindings,
+      "Engine " << compiled_engine->name << " has state bindings, its executions cannot be prepared ahead of launch");
+  auto device = static_cast<c10::DeviceIndex>(compiled_engine->device_info.id);
+  c10::cuda::CUDAGuard device_guard(device);
+
+  auto ticket = c10::make_intrusive<ExecutionTicket>();
+  ticket->engine = compiled_engine;
+  if (!compiled_engine->output_sources.empty()) {
+    ticket->inputs = inputs;
+  }
+  ticket->slot = compiled_engine->acquire_execution_slot();
+  compiled_engine->in_flight_executions.fetch_add(1, std::memory_order_relaxed);
+  TRTExecutionSlot& slot = **ticket->slot;
+  const auto& bindings = compiled_engine->binding_table;
+
+  if (compiled_engine->stage_host_inputs) {
+    TORCHTRT_NVTX_RANGE("stage_host_inputs");
+    stage_host_inputs(inputs, compiled_engine, slot);
+  }
+  for (size_t i = 0; i < inputs.size(); i++) {
+    auto& in = inputs[i];
+    if (bindings.input_is_shape_tensor[i] || (in.is_cuda() && in.device().index() == device)) {
+      continue;
+    }
+    if (in.is_cuda()) {
+      in = copy_from_peer(in, device);
+    } else if (!mapped_host_input(in, compiled_engine->device_info, bindings.input_formats[i])) {
+      in = in.to(torch::Device(torch::kCUDA, device), /*non_blocking=*/true);
+    }
+  }
+
+  bool shape_changed = _validate_shapes(inputs, compiled_engine, slot);
+  if (compiled_engine->num_optimization_profiles > 1 && (shape_changed || slot.runtime_states.context_changed)) {
+    std::vector<c10::IntArrayRef> shapes;
+    shapes.reserve(inputs.size());
+    for (auto& in : inputs) {
+      shapes.push_back(in.sizes());
+    }
+    compiled_engine->activate_optimization_profile(slot, compiled_engine->select_optimization_profile(shapes));
+  }
+  compiled_engine->apply_persistent_cache_limit(slot);
+  bool need_shape_update = shape_changed || slot.runtime_states.context_changed;
+  if (slot.runtime_states.context_changed) {
+    slot.cudagraph_cache.clear();
+  }
+  slot.runtime_states.set_runtime_states(
+      slot.runtime_states.old_cudagraphs, compiled_engine->use_pre_allocated_outputs, shape_changed);
+  if (shape_changed) {
+    increment(compiled_engine->metrics.shape_changes);
+  }
+
+  {
+    ScopedLatency input_setup_timer(compiled_engine->metrics.input_setup_latency);
+    TORCHTRT_NVTX_RANGE("input_setup");
+    setup_input_tensors(inputs, compiled_engine, slot, nullptr, false, need_shape_update);
+    if (need_shape_update) {
+      TORCHTRT_NVTX_RANGE("inferShapes");
+      int32_t const io_size{compiled_engine->cuda_engine->getNbIOTensors()};
+      std::vector<char const*> names(io_size);
+      int32_t const nbNames = slot.exec_ctx->inferShapes(names.size(), names.data());
+      TORCHTRT_CHECK(nbNames == 0, "The shapes of the inputs: " << names << " cannot be inferred");
+      update_output_shapes(compiled_engine, slot);
+    }
+    if (compiled_engine->uses_shape_sized_device_memory() && (need_shape_update || !slot.bound_device_memory)) {
+      bind_shape_sized_device_memory(compiled_engine, slot, nullptr);
+    }
+  }
+
+  if (compiled_engine->use_pre_allocated_outputs) {
+    ticket->outputs = acquire_pre_allocated_outputs(compiled_engine, slot);
+  } else {
+    ScopedLatency output_allocation_timer(compiled_engine->metrics.output_allocation_latency);
+    TORCHTRT_NVTX_RANGE("output_allocation");
+    ticket->outputs = create_output_tensors(compiled_engine, slot);
+  }
+  for (size_t pyt_idx = 0; pyt_idx < compiled_engine->num_io.second; pyt_idx++) {
+    const char* name = bindings.output_names[pyt_idx];
+    if (slot.output_is_data_dependent[pyt_idx]) {
+      if (!slot.output_allocator) {
+        slot.output_allocator = std::make_unique<DynamicOutputAllocator>(compiled_engine->out_binding_names);
+      }
+      TORCHTRT_CHECK(
+          slot.exec_ctx->setOutputAllocator(name, slot.output_allocator.get()),
+          "Error while setting the output allocator");
+      continue;
+    }
+    TORCHTRT_CHECK(
+        slot.exec_ctx->setTensorAddress(name, ticket->outputs[pyt_idx].data_ptr()),
+        "Error while setting the output tensor address");
+  }
+
+  ticket->prepare_stream = c10::cuda::getCurrentCUDAStream(device);
+  ticket->prepared.record(ticket->prepare_stream);
+  return ticket;
+}
+
+std::vector<at::Tensor> launch_execution(const c10::intrusive_ptr<ExecutionTicket>& ticket, cudaStream_t stream) {
+  TORCHTRT_NVTX_RANGE("torch_tensorrt::launch_execution");
+  TORCHTRT_CHECK(ticket->slot, "The execution ticket was already launched");
+  auto& compiled_engine = ticket->engine;
+  auto device = static_cast<c10::DeviceIndex>(compiled_engine->device_info.id);
+  c10::cuda::CUDAGuard device_guard(device);
+  TRTExecutionSlot& slot = **ticket->slot;
+  auto& metrics = compiled_engine->metrics;
+  auto launch_stream =
+      stream != nullptr ? c10::cuda::getStreamFromExternal(stream, device) : c10::cuda::getCurrentCUDAStream(device);
+  increment(metrics.executions);
+
+  bind_aux_streams(compiled_engine, slot, device);
+  reset_slot_events(slot, device);
+  // Ordered after the preparation of the ticket and after the previous execution on the context of the slot, which
+  // may have been enqueued on another stream and still use its scratch memory
+  ticket->prepared.block(launch_stream);
+  if (slot.trt_exec_complete.isCreated()) {
+    slot.trt_exec_complete.block(launch_stream);
+  }
+
+  std::unique_lock<std::mutex> device_memory_lock;
+  if (compiled_engine->shared_device_memory) {
+    device_memory_lock = compiled_engine->shared_device_memory->lock();
+    bind_shared_device_memory(compiled_engine, slot);
+    compiled_engine->shared_device_memory->wait(launch_stream);
+  }
+  {
+    std::optional<EnqueueAdmission::Ticket> admission;
+    if (compiled_engine->qos_class == QOS_BACKGROUND && BACKGROUND_MAX_IN_FLIGHT > 0) {
+      TORCHTRT_NVTX_RANGE("admission");
+      admission.emplace(get_background_admission(device).acquire(BACKGROUND_MAX_IN_FLIGHT));
+    }
+    ScopedLatency enqueue_timer(metrics.enqueue_latency);
+    TORCHTRT_NVTX_RANGE("enqueueV3");
+    TORCHTRT_CHECK(slot.exec_ctx->enqueueV3(launch_stream), "Unable to enqueue engine " << compiled_engine->name);
+    if (compiled_engine->shared_device_memory) {
+      compiled_engine->shared_device_memory->record(launch_stream);
+    }
+    if (admission) {
+      admission->complete(launch_stream);
+    }
+  }
+  slot.trt_exec_complete.record(launch_stream);
+  if (device_memory_lock.owns_lock()) {
+    device_memory_lock.unlock();
+  }
+
+  auto outputs = std::move(ticket->outputs);
+  if (slot.output_allocator) {
+    for (size_t pyt_idx = 0; pyt_idx < compiled_engine->num_io.second; pyt_idx++) {
+      if (slot.output_is_data_dependent[pyt_idx]) {
+        outputs[pyt_idx] =
+            slot.output_allocator->output(pyt_idx, compiled_engine->binding_table.output_types[pyt_idx]);
+      }
+    }
+  }
+  // The outputs were allocated, and the inputs formatted, on the stream the ticket was prepared on
+  bool other_stream = launch_stream != ticket->prepare_stream;
+  for (const auto& t : outputs) {
+    if (other_stream && t.defined() && t.is_cuda()) {
+      c10::cuda::CUDACachingAllocator::recordStream(t.storage().data_ptr(), launch_stream);
+    }
+  }
+  for (const auto& in : slot.formatted_inputs) {
+    if (!in.defined()) {
+      continue;
+    } else if (!in.is_cuda()) {
+      at::cuda::CachingHostAllocator_recordEvent(
+          in.storage().data_ptr().get(), in.storage().data_ptr().get_context(), launch_stream);
+    } else if (other_stream) {
+      c10::cuda::CUDACachingAllocator::recordStream(in.storage().data_ptr(), launch_stream);
+    }
+  }
+  ticket->release();
+
+  if (!compiled_engine->host_outputs.empty()) {
+    TORCHTRT_NVTX_RANGE("host_outputs");
+    c10::cuda::CUDAStreamGuard stream_guard(launch_stream);
+    for (size_t o = 0; o < outputs.size(); o++) {
+      if (compiled_engine->host_outputs[o]) {
+        auto host = at::empty(outputs[o].sizes(), outputs[o].options().device(at::kCPU).pinned_memory(true));
+        host.copy_(outputs[o], /*non_blocking=*/true);
+        outputs[o] = std::move(host);
+      }
+    }
+  }
+  auto inputs = std::move(ticket->inputs);
+  return expand_output_aliases(*compiled_engine, inputs, std::move(outputs));
+}
+
 } // namespace runtime
 } // namespace core
 } // namespace torch_tensorrt
@@ -1,6 +1,19 @@
+#include <algorithm>
 #include <codecvt>
+#include <cstdint>
+#include <iterator>
 
+#include "core/runtime/DeferredEngineSegment.h"
+#include "core/runtime/EngineCompression.h"
+#include "core/runtime/EngineEnsemble.h"
+#include "core/runtime/EngineOffloader.h"
+#include "core/runtime/EngineSequence.h"
+#include "core/runtime/EngineVariants.h"
+#include "core/runtime/FusedTorchSegment.h"
+#include "core/runtime/MemoryReclaimer.h"
 #include "core/runtime/Platform.h"
+#include "core/runtime/SegmentStreams.h"
+#include "core/runtime/WeightStreamingArbiter.h"
 #include "core/runtime/runtime.h"
 #include "core/util/macros.h"
 
@@ -23,43 +36,89 @@ std::string serialize_bindings(const std::vector<std::string>& bindings) {
 }
 
 static const std::string sym_table = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"; //=
-std::string base64_encode(const std::string& in) {
-  std::string out;
-  int64_t val = 0, valb = -6;
-  for (unsigned char c : in) {
-    val = (val << 8) + c;
-    valb += 8;
-    while (valb >= 0) {
-      out.push_back(sym_table[(val >> valb) & 0x3F]);
-      valb -= 6;
+
+namespace {
+struct Base64DecodeTable {
+  uint8_t T[256];
+  Base64DecodeTable() {
+    std::fill(std::begin(T), std::end(T), kInvalid);
+    for (uint8_t i = 0; i < 64; i++) {
+      T[static_cast<unsigned char>(sym_table[i])] = i;
     }
   }
-  if (valb > -6) {
-    out.push_back(sym_table[((val << 8) >> (valb + 8)) & 0x3F]);
-  };
-  while (out.size() % 4) {
-    out.push_back('=');
+  static constexpr uint8_t kInvalid = 0xFF;
+};
+
+const Base64DecodeTable& base64_decode_table() {
+  static const Base64DecodeTable table;
+  return table;
+}
+} // namespace
+
+// Both directions work on whole blocks (3 bytes <-> 4 symbols) into a presized output so the inner loops have no
+// branches or reallocations, engines can be several GB
+std::string base64_encode(const void* data, size_t n) {
+  const auto* src = static_cast<const unsigned char*>(data);
+  std::string out(4 * ((n + 2) / 3), '=');
+  char* dst = &out[0];
+
+  size_t i = 0;
+  for (; i + 3 <= n; i += 3) {
+    uint32_t v = (uint32_t(src[i]) << 16) | (uint32_t(src[i + 1]) << 8) | uint32_t(src[i + 2]);
+    *dst++ = sym_table[(v >> 18) & 0x3F];
+    *dst++ = sym_table[(v >> 12) & 0x3F];
+    *dst++ = sym_table[(v >> 6) & 0x3F];
+    *dst++ = sym_table[v & 0x3F];
+  }
+  if (i < n) {
+    uint32_t v = uint32_t(src[i]) << 16;
+    if (i + 1 < n) {
+      v |= uint32_t(src[i + 1]) << 8;
+    }
+    *dst++ = sym_table[(v >> 18) & 0x3F];
+    *dst++ = sym_table[(v >> 12) & 0x3F];
+    if (i + 1 < n) {
+      *dst++ = sym_table[(v >> 6) & 0x3F];
+    }
   }
   return out;
 }
 
+std::string base64_encode(const std::string& in) {
+  return base64_encode(in.data(), in.size());
+}
+
 std::string base64_decode(const std::string& in) {
-  std::string out;
-  std::vector<int> T(256, -1);
-  for (int i = 0; i < 64; i++) {
-    T[sym_table[i]] = i;
+  const auto& T = base64_decode_table().T;
+  const auto* src = reinterpret_cast<const unsigned char*>(in.data());
+
+  // Decoding stops at the first symbol outside of the alphabet (padding included)
+  size_t n = 0;
+  while (n < in.size() && T[src[n]] != Base64DecodeTable::kInvalid) {
+    n++;
   }
 
-  int64_t val = 0, valb = -8;
-  for (unsigned char c : in) {
-    if (T[c] == -1) {
-      break;
+  std::string out((n / 4) * 3 + ((n % 4) * 3) / 4, '\0');
+  char* dst = &out[0];
+
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    uint32_t v = (uint32_t(T[src[i]]) << 18) | (uint32_t(T[src[i + 1]]) << 12) | (uint32_t(T[src[i + 2]]) << 6) |
+        uint32_t(T[src[i + 3]]);
+    *dst++ = char((v >> 16) & 0xFF);
+    *dst++ = char((v >> 8) & 0xFF);
+    *dst++ = char(v & 0xFF);
+  }
+  // Trailing 2 or 3 symbols encode 1 or 2 bytes, a single trailing symbol carries no full byte
+  size_t rem = n - i;
+  if (rem >= 2) {
+    uint32_t v = (uint32_t(T[src[i]]) << 18) | (uint32_t(T[src[i + 1]]) << 12);
+    if (rem == 3) {
+      v |= uint32_t(T[src[i + 2]]) << 6;
     }
-    val = (val << 6) + T[c];
-    valb += 6;
-    if (valb >= 0) {
-      out.push_back(char((val >> valb) & 0xFF));
-      valb -= 8;
+    *dst++ = char((v >> 16) & 0xFF);
+    if (rem == 3) {
+      *dst++ = char((v >> 8) & 0xFF);
     }
   }
   return out;
@@ -73,6 +132,13 @@ namespace {
 //
 //     return c10::List<at::Tensor>(output_vec);
 // }
+// Registered before the engine, whose prepare method returns it
+static auto TORCHTRT_UNUSED ExecutionTicketTSRegistration =
+    torch::class_<ExecutionTicket>("tensorrt", "ExecutionTicket")
+        .def("launch", [](const c10::intrusive_ptr<ExecutionTicket>& self) -> std::vector<at::Tensor> {
+          return launch_execution(self);
+        });
+
 static auto TORCHTRT_UNUSED TRTEngineTSRegistrtion =
     torch::class_<TRTEngine>("tensorrt", "Engine")
         .def(torch::init<std::vector<std::string>>())
@@ -83,28 +149,315 @@ static auto TORCHTRT_UNUSED TRTEngineTSRegistrtion =
         .def("__obj_flatten__", &TRTEngine::__obj_flatten__)
         .def("enable_profiling", &TRTEngine::enable_profiling)
         .def("disable_profiling", &TRTEngine::disable_profiling)
+        .def("get_layer_profile", &TRTEngine::get_layer_profile)
+        .def("reset_layer_profile", &TRTEngine::reset_layer_profile)
+        .def(
+            "enable_layer_sampling",
+            [](const c10::intrusive_ptr<TRTEngine>& self,
+               int64_t every_n,
+               int64_t window_ms,
+               std::string output_dir,
+               int64_t report_every,
+               int64_t max_reports) -> void {
+              self->enable_layer_sampling({every_n, window_ms, std::move(output_dir), report_every, max_reports});
+            },
+            "",
+            {torch::arg("every_n") = 100,
+             torch::arg("window_ms") = 0,
+             torch::arg("output_dir") = "",
+             torch::arg("report_every") = 1000,
+             torch::arg("max_reports") = 4})
+        .def("disable_layer_sampling", &TRTEngine::disable_layer_sampling)
+        .def("get_layer_samples", &TRTEngine::get_layer_samples)
         .def_readwrite("profile_path_prefix", &TRTEngine::profile_path_prefix)
         .def("dump_engine_layer_info_to_file", &TRTEngine::dump_engine_layer_info_to_file)
         .def("dump_engine_layer_info", &TRTEngine::dump_engine_layer_info)
         .def("get_engine_layer_info", &TRTEngine::get_engine_layer_info)
         .def("infer_outputs", &TRTEngine::infer_outputs)
+        .def(
+            "prepare",
+            [](const c10::intrusive_ptr<TRTEngine>& self,
+               std::vector<at::Tensor> inputs) -> c10::intrusive_ptr<ExecutionTicket> {
+              return prepare_execution(std::move(inputs), self);
+            })
         .def_readwrite("use_pre_allocated_outputs", &TRTEngine::use_pre_allocated_outputs)
+        .def_readwrite("pre_allocated_outputs_depth", &TRTEngine::pre_allocated_outputs_depth)
+        .def_readwrite("use_output_arena", &TRTEngine::use_output_arena)
+        .def_readwrite("output_arena_depth", &TRTEngine::output_arena_depth)
+        .def_readwrite("use_caller_stream", &TRTEngine::use_caller_stream)
+        .def_readwrite("stage_host_inputs", &TRTEngine::stage_host_inputs)
         .def_property(
             "device_memory_budget",
             &TRTEngine::get_device_memory_budget,
             &TRTEngine::set_device_memory_budget)
         .def_property("streamable_device_memory_budget", &TRTEngine::get_streamable_device_memory_budget)
         .def_property("automatic_device_memory_budget", &TRTEngine::get_automatic_device_memory_budget)
+        .def("get_memory_usage", &TRTEngine::get_memory_usage)
+        .def_property(
+            "execution_context_pool_size",
+            &TRTEngine::get_execution_context_pool_size,
+            &TRTEngine::set_execution_context_pool_size)
+        .def_property(
+            "cudagraph_cache_max_entries",
+            &TRTEngine::get_cudagraph_cache_max_entries,
+            &TRTEngine::set_cudagraph_cache_max_entries)
+        .def_property(
+            "cudagraph_cache_max_bytes",
+            &TRTEngine::get_cudagraph_cache_max_bytes,
+            &TRTEngine::set_cudagraph_cache_max_bytes)
+        .def_property("batch_buckets", &TRTEngine::get_batch_buckets, &TRTEngine::set_batch_buckets)
+        .def_property(
+            "dynamic_batching_window_us",
+            &TRTEngine::get_dynamic_batching_window_us,
+            &TRTEngine::set_dynamic_batching_window_us)
+        .def_property(
+            "dynamic_batching_max_batch_size",
+            &TRTEngine::get_dynamic_batching_max_batch_size,
+            &TRTEngine::set_dynamic_batching_max_batch_size)
+        .def_property("replica_devices", &TRTEngine::get_replica_devices, &TRTEngine::set_replica_devices)
+        .def_property(
+            "replica_device_uuids", &TRTEngine::get_replica_device_uuids, &TRTEngine::set_replica_device_uuids)
+        .def_property("qos_class", &TRTEngine::get_qos_class, &TRTEngine::set_qos_class)
+        .def_property(
+            "persistent_cache_limit", &TRTEngine::get_persistent_cache_limit, &TRTEngine::set_persistent_cache_limit)
+        .def("get_resolved_persistent_cache_limit", &TRTEngine::get_resolved_persistent_cache_limit)
+        .def_property("lean_runtime_path", &TRTEngine::get_lean_runtime_path, &TRTEngine::set_lean_runtime_path)
+        .def_property(
+            "engine_host_code_allowed",
+            &TRTEngine::get_engine_host_code_allowed,
+            &TRTEngine::set_engine_host_code_allowed)
+        .def("get_cudagraph_cache_stats", &TRTEngine::get_cudagraph_cache_stats)
+        .def("reset_cudagraph_cache", &TRTEngine::reset_cudagraph_cache)
+        .def("register_cudagraph_inputs", &TRTEngine::register_cudagraph_inputs)
+        .def("clear_cudagraph_inputs", &TRTEngine::clear_cudagraph_inputs)
+        .def("share_device_memory", &TRTEngine::share_device_memory)
+        .def_property(
+            "shape_sized_device_memory",
+            &TRTEngine::get_shape_sized_device_memory,
+            &TRTEngine::set_shape_sized_device_memory)
+        .def_property("idle_offload_ms", &TRTEngine::get_idle_offload_ms, &TRTEngine::set_idle_offload_ms)
+        .def("offload", &TRTEngine::offload)
+        .def("is_offloaded", &TRTEngine::is_offloaded)
+        .def("share_cudagraph_pool", &TRTEngine::share_cudagraph_pool)
+        .def("swap_engine", &TRTEngine::swap_engine)
+        .def("set_state_bindings", &TRTEngine::set_state_bindings)
+        .def("reset_state", &TRTEngine::reset_state)
+        .def("get_state", &TRTEngine::get_state)
+        .def("set_host_outputs", &TRTEngine::set_host_outputs)
+        .def("get_host_outputs", &TRTEngine::get_host_outputs)
+        .def("warmup", &TRTEngine::warmup, "", {torch::arg("iterations") = 0})
+        .def("is_engine_loaded", &TRTEngine::is_engine_loaded)
+        .def("get_runtime_metrics", &TRTEngine::get_runtime_metrics)
+        .def("get_latency_histograms", &TRTEngine::get_latency_histograms)
+        .def("reset_runtime_metrics", &TRTEngine::reset_runtime_metrics)
+        .def("get_load_times", &TRTEngine::get_load_times)
+        .def("get_input_shape_histogram", &TRTEngine::get_input_shape_histogram)
+        .def("reset_input_shape_histogram", &TRTEngine::reset_input_shape_histogram)
+        .def_pickle(
+            [](const c10::intrusive_ptr<TRTEngine>& self) -> SerializedState { return self->serialize_state(); },
+            [](c10::IValue state) -> c10::intrusive_ptr<TRTEngine> {
+              auto decode_start = std::chrono::steady_clock::now();
+              std::vector<std::string> serialized_info;
+              if (state.isTuple()) {
+                const auto& elements = state.toTupleRef().elements();
+                TORCHTRT_CHECK(elements.size() == 2, "Program to be deserialized has a malformed TensorRT engine");
+                serialized_info = elements[0].to<std::vector<std::string>>();
+                TRTEngine::verify_serialization_fmt(serialized_info, ABI_VERSION);
+                // Engines stored in side files are loaded from the reference directly
+                if (!is_engine_file_reference(serialized_info[ENGINE_IDX])) {
+                  auto engine_blob = elements[1].toTensor().contiguous();
+                  serialized_info[ENGINE_IDX] =
+                      std::string(static_cast<const char*>(engine_blob.data_ptr()), engine_blob.numel());
+                }
+              } else {
+                // Programs saved before the binary format store the engine as base64
+                serialized_info = state.to<std::vector<std::string>>();
+                TRTEngine::verify_serialization_fmt(serialized_info, BASE64_ENGINE_ABI_VERSION);
+                if (!is_engine_file_reference(serialized_info[ENGINE_IDX])) {
+                  serialized_info[ENGINE_IDX] = base64_decode(serialized_info[ENGINE_IDX]);
+                }
+              }
+              // Decompressed here rather than by the constructor so it is part of the decode time
+              if (is_compressed_engine(serialized_info[ENGINE_IDX])) {
+                serialized_info[ENGINE_IDX] = decompress_engine(serialized_info[ENGINE_IDX]);
+              }
+              auto decode_ns = elapsed_ns(decode_start);
+              auto engine = c10::make_intrusive<TRTEngine>(std::move(serialized_info));
+              engine->load_times.decode_ns = decode_ns;
+              return engine;
+            });
+
+static auto TORCHTRT_UNUSED FusedTorchSegmentTSRegistration =
+    torch::class_<FusedTorchSegment>("tensorrt", "FusedTorchSegment")
+        .def(torch::init<std::vector<std::string>>())
+        .def("__str__", &FusedTorchSegment::to_str)
+        .def("__repr__", &FusedTorchSegment::to_str)
+        .def_pickle(
+            [](const c10::intrusive_ptr<FusedTorchSegment>& self) -> std::vector<std::string> {
+              return self->serialize();
+            },
+            [](std::vector<std::string> serialized_info) -> c10::intrusive_ptr<FusedTorchSegment> {
+              return c10::make_intrusive<FusedTorchSegment>(std::move(serialized_info));
+            });
+
+using EngineSequenceState = std::tuple<
+    int64_t,
+    std::vector<c10::intrusive_ptr<TRTEngine>>,
+    std::vector<std::vector<int64_t>>,
+    std::vector<int64_t>,
+    bool>;
+
+static auto TORCHTRT_UNUSED EngineSequenceTSRegistration =
+    torch::class_<EngineSequence>("tensorrt", "EngineSequence")
+        .def(torch::init<
+             int64_t,
+             std::vector<c10::intrusive_ptr<TRTEngine>>,
+             std::vector<std::vector<int64_t>>,
+             std::vector<int64_t>>())
+        .def("__str__", &EngineSequence::to_str)
+        .def("__repr__", &EngineSequence::to_str)
+        .def("run", &EngineSequence::run)
+        .def_readwrite("use_cudagraph", &EngineSequence::use_cudagraph)
+        .def_pickle(
+            [](const c10::intrusive_ptr<EngineSequence>& self) -> EngineSequenceState {
+              return {self->num_inputs, self->engines, self->engine_inputs, self->outputs, self->use_cudagraph};
+            },
+            [](EngineSequenceState state) -> c10::intrusive_ptr<EngineSequence> {
+              auto sequence = c10::make_intrusive<EngineSequence>(
+                  std::get<0>(state),
+                  std::move(std::get<1>(state)),
+                  std::move(std::get<2>(state)),
+                  std::move(std::get<3>(state)));
+              sequence->use_cudagraph = std::get<4>(state);
+              return sequence;
+            });
+
+using EngineEnsembleState = std::tuple<std::vector<c10::intrusive_ptr<TRTEngine>>, bool>;
+
+static auto TORCHTRT_UNUSED EngineEnsembleTSRegistration =
+    torch::class_<EngineEnsemble>("tensorrt", "EngineEnsemble")
+        .def(torch::init<std::vector<c10::intrusive_ptr<TRTEngine>>>())
+        .def("__str__", &EngineEnsemble::to_str)
+        .def("__repr__", &EngineEnsemble::to_str)
+        .def("run", &EngineEnsemble::run)
+        .def_readwrite("use_cudagraph", &EngineEnsemble::use_cudagraph)
+        .def_pickle(
+            [](const c10::intrusive_ptr<EngineEnsemble>& self) -> EngineEnsembleState {
+              return {self->engines, self->use_cudagraph};
+            },
+            [](EngineEnsembleState state) -> c10::intrusive_ptr<EngineEnsemble> {
+              auto ensemble = c10::make_intrusive<EngineEnsemble>(std::move(std::get<0>(state)));
+              ensemble->use_cudagraph = std::get<1>(state);
+              return ensemble;
+            });
+
+using EngineVariantsState =
+    std::tuple<std::vector<c10::intrusive_ptr<TRTEngine>>, int64_t, int64_t, std::vector<double>, double, int64_t>;
+
+static auto TORCHTRT_UNUSED EngineVariantsTSRegistration =
+    torch::class_<EngineVariants>("tensorrt", "EngineVariants")
+        .def(torch::init<std::vector<c10::intrusive_ptr<TRTEngine>>>())
+        .def("__str__", &EngineVariants::to_str)
+        .def("__repr__", &EngineVariants::to_str)
+        .def("run", &EngineVariants::run)
+        .def(
+            "select",
+            [](const c10::intrusive_ptr<EngineVariants>& self, std::vector<at::Tensor> inputs) -> int64_t {
+              return self->select(inputs);
+            })
+        .def("run_variant", &EngineVariants::run_variant)
+        .def("get_routed_counts", &EngineVariants::get_routed_counts)
+        .def("get_accuracy_spent", &EngineVariants::get_accuracy_spent)
+        .def("reset_stats", &EngineVariants::reset_stats)
+        .def_readwrite("max_in_flight", &EngineVariants::max_in_flight)
+        .def_readwrite("latency_target_us", &EngineVariants::latency_target_us)
+        .def_readwrite("accuracy_costs", &EngineVariants::accuracy_costs)
+        .def_readwrite("accuracy_budget", &EngineVariants::accuracy_budget)
+        .def_readwrite("accuracy_window", &EngineVariants::accuracy_window)
         .def_pickle(
-            [](const c10::intrusive_ptr<TRTEngine>& self) -> std::vector<std::string> { return self->serialize(); },
-            [](std::vector<std::string> serialized_info) -> c10::intrusive_ptr<TRTEngine> {
-              serialized_info[ENGINE_IDX] = base64_decode(serialized_info[ENGINE_IDX]);
-              TRTEngine::verify_serialization_fmt(serialized_info);
-              return c10::make_intrusive<TRTEngine>(serialized_info);
+            [](const c10::intrusive_ptr<EngineVariants>& self) -> EngineVariantsState {
+              return {
+                  self->engines,
+                  self->max_in_flight,
+                  self->latency_target_us,
+                  self->accuracy_costs,
+                  self->accuracy_budget,
+                  self->accuracy_window};
+            },
+            [](EngineVariantsState state) -> c10::intrusive_ptr<EngineVariants> {
+              auto variants = c10::make_intrusive<EngineVariants>(std::move(std::get<0>(state)));
+              variants->max_in_flight = std::get<1>(state);
+              variants->latency_target_us = std::get<2>(state);
+              variants->accuracy_costs = std::move(std::get<3>(state));
+              variants->accuracy_budget = std::get<4>(state);
+              variants->accuracy_window = std::get<5>(state);
+              return variants;
+            });
+
+static auto TORCHTRT_UNUSED DeferredEngineSegmentTSRegistration =
+    torch::class_<DeferredEngineSegment>("tensorrt", "DeferredEngineSegment")
+        .def(torch::init<std::vector<std::string>>())
+        .def("__str__", &DeferredEngineSegment::to_str)
+        .def("__repr__", &DeferredEngineSegment::to_str)
+        .def("is_ready", &DeferredEngineSegment::is_ready)
+        .def("wait", &DeferredEngineSegment::wait)
+        .def_pickle(
+            [](const c10::intrusive_ptr<DeferredEngineSegment>& self) -> std::vector<std::string> {
+              return self->serialize();
+            },
+            [](std::vector<std::string> serialized_info) -> c10::intrusive_ptr<DeferredEngineSegment> {
+              return c10::make_intrusive<DeferredEngineSegment>(std::move(serialized_info));
+            });
+
+static auto TORCHTRT_UNUSED SegmentActivationArenaTSRegistration =
+    torch::class_<SegmentActivationArena>("tensorrt", "SegmentActivationArena")
+        .def(torch::init<std::vector<std::string>>())
+        .def("__str__", &SegmentActivationArena::to_str)
+        .def("__repr__", &SegmentActivationArena::to_str)
+        .def("get_size", &SegmentActivationArena::get_size)
+        .def_pickle(
+            [](const c10::intrusive_ptr<SegmentActivationArena>& self) -> std::vector<std::string> {
+              return self->serialize();
+            },
+            [](std::vector<std::string> serialized_info) -> c10::intrusive_ptr<SegmentActivationArena> {
+              return c10::make_intrusive<SegmentActivationArena>(std::move(serialized_info));
             });
 
 TORCH_LIBRARY(tensorrt, m) {
   m.def("execute_engine(Tensor[] input_tensors, __torch__.torch.classes.tensorrt.Engine engine) -> Tensor[]");
+  m.def(
+      "execute_engine_out(Tensor[] input_tensors, Tensor(a!)[] output_tensors, "
+      "__torch__.torch.classes.tensorrt.Engine engine) -> ()");
+  m.def(
+      "execute_fused_torch_segment(Tensor[] inputs, __torch__.torch.classes.tensorrt.FusedTorchSegment segment) -> "
+      "Tensor[]");
+  m.def(
+      "execute_deferred_engine_segment(Tensor[] inputs, "
+      "__torch__.torch.classes.tensorrt.DeferredEngineSegment segment) -> Tensor[]");
+  m.def(
+      "execute_engines(Tensor[] input_tensors, __torch__.torch.classes.tensorrt.EngineSequence sequence) -> Tensor[]");
+  m.def(
+      "execute_ensemble(Tensor[] input_tensors, __torch__.torch.classes.tensorrt.EngineEnsemble ensemble) -> Tensor[]");
+  m.def(
+      "execute_engine_variants(Tensor[] input_tensors, __torch__.torch.classes.tensorrt.EngineVariants variants) -> "
+      "Tensor[]");
+  m.def(
+      "execute_engine_in_arena(Tensor[] input_tensors, __torch__.torch.classes.tensorrt.Engine engine, "
+      "__torch__.torch.classes.tensorrt.SegmentActivationArena arena, int step) -> Tensor[]");
+  // Inserted around the engines of hybrid graphs scheduled on several streams, conservative so that passes do not
+  // move or merge them
+  m.def(
+      torch::schema(
+          "enter_segment_stream(Tensor[] inputs, int branch) -> Tensor[]", c10::AliasAnalysisKind::CONSERVATIVE),
+      enter_segment_stream);
+  m.def(
+      torch::schema(
+          "exit_segment_stream(Tensor[] outputs, int branch) -> Tensor[]", c10::AliasAnalysisKind::CONSERVATIVE),
+      exit_segment_stream);
+  m.def(
+      torch::schema(
+          "join_segment_stream(Tensor[] values, int branch) -> Tensor[]", c10::AliasAnalysisKind::CONSERVATIVE),
+      join_segment_stream);
   m.def("SERIALIZED_ENGINE_BINDING_DELIM", []() -> std::string { return std::string(1, TRTEngine::BINDING_DELIM); });
   m.def("SERIALIZED_RT_DEVICE_DELIM", []() -> std::string { return DEVICE_INFO_DELIM; });
   m.def("ABI_VERSION", []() -> std::string { return ABI_VERSION; });
@@ -112,10 +465,124 @@ TORCH_LIBRARY(tensorrt, m) {
   m.def("set_multi_device_safe_mode", [](bool multi_device_safe_mode) -> void {
     MULTI_DEVICE_SAFE_MODE = multi_device_safe_mode;
   });
+  m.def("get_validate_inputs_every_call", []() -> bool { return VALIDATE_INPUTS_EVERY_CALL; });
+  m.def("set_validate_inputs_every_call", [](bool validate_inputs_every_call) -> void {
+    VALIDATE_INPUTS_EVERY_CALL = validate_inputs_every_call;
+  });
+  m.def("get_record_input_shapes", []() -> bool { return RECORD_INPUT_SHAPES; });
+  m.def("set_record_input_shapes", [](bool record_input_shapes) -> void { RECORD_INPUT_SHAPES = record_input_shapes; });
+  m.def("get_lazy_engine_deserialization", []() -> bool { return LAZY_ENGINE_DESERIALIZATION; });
+  m.def("set_lazy_engine_deserialization", [](bool lazy_engine_deserialization) -> void {
+    LAZY_ENGINE_DESERIALIZATION = lazy_engine_deserialization;
+  });
+  m.def("get_share_trt_runtime", []() -> bool { return SHARE_TRT_RUNTIME; });
+  m.def("set_share_trt_runtime", [](bool share_trt_runtime) -> void { SHARE_TRT_RUNTIME = share_trt_runtime; });
+  m.def("get_deduplicate_engines", []() -> bool { return DEDUPLICATE_ENGINES; });
+  m.def("set_deduplicate_engines", [](bool deduplicate_engines) -> void {
+    DEDUPLICATE_ENGINES = deduplicate_engines;
+  });
+  m.def("get_external_engine_dir", []() -> std::string { return EXTERNAL_ENGINE_DIR; });
+  m.def("set_external_engine_dir", [](std::string external_engine_dir) -> void {
+    EXTERNAL_ENGINE_DIR = external_engine_dir;
+  });
+  m.def("get_engine_compression_level", []() -> int64_t { return ENGINE_COMPRESSION_LEVEL; });
+  m.def("set_engine_compression_level", [](int64_t engine_compression_level) -> void {
+    TORCHTRT_CHECK(
+        engine_compression_level >= 0,
+        "Engine compression level must not be negative, got " << engine_compression_level);
+    ENGINE_COMPRESSION_LEVEL = engine_compression_level;
+  });
+  m.def("get_lean_runtime_path", []() -> std::string { return LEAN_RUNTIME_PATH; });
+  m.def("set_lean_runtime_path", [](std::string lean_runtime_path) -> void { LEAN_RUNTIME_PATH = lean_runtime_path; });
+  m.def("get_engine_host_code_allowed", []() -> bool { return ENGINE_HOST_CODE_ALLOWED; });
+  m.def("set_engine_host_code_allowed", [](bool engine_host_code_allowed) -> void {
+    ENGINE_HOST_CODE_ALLOWED = engine_host_code_allowed;
+  });
+  m.def("get_weight_streaming_arbiter", []() -> bool { return WEIGHT_STREAMING_ARBITER; });
+  m.def("set_weight_streaming_arbiter", [](bool weight_streaming_arbiter) -> void {
+    WEIGHT_STREAMING_ARBITER = weight_streaming_arbiter;
+  });
+  m.def("get_weight_streaming_arbiter_reserved_bytes", []() -> int64_t {
+    return get_weight_streaming_arbiter().get_reserved_bytes();
+  });
+  m.def("set_weight_streaming_arbiter_reserved_bytes", [](int64_t reserved) -> void {
+    get_weight_streaming_arbiter().set_reserved_bytes(reserved);
+  });
+  m.def("get_weight_streaming_arbiter_device_memory_limit", []() -> int64_t {
+    return get_weight_streaming_arbiter().get_device_memory_limit();
+  });
+  m.def("set_weight_streaming_arbiter_device_memory_limit", [](int64_t limit) -> void {
+    get_weight_streaming_arbiter().set_device_memory_limit(limit);
+  });
+  m.def("get_weight_streaming_arbiter_idle_timeout_ms", []() -> int64_t {
+    return get_weight_streaming_arbiter().get_idle_timeout_ms();
+  });
+  m.def("set_weight_streaming_arbiter_idle_timeout_ms", [](int64_t timeout_ms) -> void {
+    get_weight_streaming_arbiter().set_idle_timeout_ms(timeout_ms);
+  });
+  m.def("get_background_max_in_flight", []() -> int64_t { return BACKGROUND_MAX_IN_FLIGHT; });
+  m.def("set_background_max_in_flight", [](int64_t max_in_flight) -> void {
+    TORCHTRT_CHECK(max_in_flight >= 0, "Background max in flight must not be negative, got " << max_in_flight);
+    BACKGROUND_MAX_IN_FLIGHT = max_in_flight;
+  });
+  m.def("get_numa_local_host_staging", []() -> bool { return NUMA_LOCAL_HOST_STAGING; });
+  m.def("set_numa_local_host_staging", [](bool numa_local_host_staging) -> void {
+    NUMA_LOCAL_HOST_STAGING = numa_local_host_staging;
+  });
+  m.def("get_reclaim_memory_on_oom", []() -> bool { return RECLAIM_MEMORY_ON_OOM; });
+  m.def("set_reclaim_memory_on_oom", [](bool reclaim_memory_on_oom) -> void {
+    RECLAIM_MEMORY_ON_OOM = reclaim_memory_on_oom;
+  });
+  m.def("get_shape_sized_device_memory", []() -> bool { return SHAPE_SIZED_DEVICE_MEMORY; });
+  m.def("set_shape_sized_device_memory", [](bool shape_sized_device_memory) -> void {
+    SHAPE_SIZED_DEVICE_MEMORY = shape_sized_device_memory;
+  });
+  m.def("get_idle_offload_ms", []() -> int64_t { return IDLE_OFFLOAD_MS; });
+  m.def("set_idle_offload_ms", [](int64_t timeout_ms) -> void {
+    TORCHTRT_CHECK(timeout_ms >= 0, "Idle offload timeout must not be negative, got " << timeout_ms);
+    IDLE_OFFLOAD_MS = timeout_ms;
+  });
+  m.def("offload_idle_engines", []() -> int64_t { return get_engine_offloader().offload_idle_engines(); });
+  m.def("reclaim_device_memory", [](int64_t device_id, int64_t stage) -> int64_t {
+    TORCHTRT_CHECK(
+        stage >= RECLAIM_CUDAGRAPHS && stage <= RECLAIM_WEIGHT_STREAMING,
+        "Reclaim stage must be between " << RECLAIM_CUDAGRAPHS << " and " << RECLAIM_WEIGHT_STREAMING << ", got "
+                                         << stage);
+    return get_memory_reclaimer().reclaim(device_id, static_cast<ReclaimStage>(stage));
+  });
+  m.def("get_memory_reclaim_stats", []() -> c10::Dict<std::string, int64_t> {
+    c10::Dict<std::string, int64_t> stats;
+    stats.insert("reclaims", get_memory_reclaimer().get_num_reclaims());
+    stats.insert("reclaimed_bytes", get_memory_reclaimer().get_reclaimed_bytes());
+    return stats;
+  });
+  m.def("get_device_topology", []() -> std::string { return DeviceTopology::get().dump(); });
   m.def("get_cudagraphs_mode", []() -> int64_t { return CUDAGRAPHS_MODE; });
   m.def("set_cudagraphs_mode", [](int64_t cudagraphs_mode) -> void {
     CUDAGRAPHS_MODE = CudaGraphsMode(cudagraphs_mode);
   });
+  m.def("get_cudagraph_min_executions", []() -> int64_t { return CUDAGRAPH_MIN_EXECUTIONS; });
+  m.def("set_cudagraph_min_executions", [](int64_t min_executions) -> void {
+    TORCHTRT_CHECK(min_executions >= 0, "CUDA graph min executions must not be negative, got " << min_executions);
+    CUDAGRAPH_MIN_EXECUTIONS = min_executions;
+  });
+  m.def("get_cudagraph_admission_window", []() -> int64_t { return CUDAGRAPH_ADMISSION_WINDOW; });
+  m.def("set_cudagraph_admission_window", [](int64_t window) -> void {
+    TORCHTRT_CHECK(window >= 0, "CUDA graph admission window must not be negative, got " << window);
+    CUDAGRAPH_ADMISSION_WINDOW = window;
+  });
+  m.def("get_cudagraph_max_total_bytes", []() -> int64_t { return CUDAGRAPH_MAX_TOTAL_BYTES; });
+  m.def("set_cudagraph_max_total_bytes", [](int64_t max_bytes) -> void {
+    TORCHTRT_CHECK(max_bytes >= 0, "CUDA graph max total bytes must not be negative, got " << max_bytes);
+    CUDAGRAPH_MAX_TOTAL_BYTES = max_bytes;
+  });
+  m.def("get_cudagraph_total_bytes", []() -> int64_t { return CudaGraphCache::process_total_bytes(); });
+  m.def("get_nvtx_enabled", []() -> bool { return util::nvtx_enabled(); });
+  m.def("set_nvtx_enabled", [](bool enabled) -> void { util::set_nvtx_enabled(enabled); });
+  m.def("get_torch_gpu_allocator_enabled", []() -> bool { return util::torch_gpu_allocator_enabled(); });
+  m.def("set_torch_gpu_allocator_enabled", [](bool enabled) -> void {
+    util::set_torch_gpu_allocator_enabled(enabled);
+  });
   m.def("set_logging_level", [](int64_t level) -> void {
     util::logging::get_logger().set_reportable_log_level(util::logging::LogLevel(level));
   });
@@ -155,6 +622,13 @@ TORCH_LIBRARY(tensorrt, m) {
 
 TORCH_LIBRARY_IMPL(tensorrt, CompositeExplicitAutograd, m) {
   m.impl("execute_engine", execute_engine);
+  m.impl("execute_engine_out", execute_engine_out);
+  m.impl("execute_fused_torch_segment", execute_fused_torch_segment);
+  m.impl("execute_deferred_engine_segment", execute_deferred_engine_segment);
+  m.impl("execute_engines", execute_engines);
+  m.impl("execute_ensemble", execute_ensemble);
+  m.impl("execute_engine_variants", execute_engine_variants);
+  m.impl("execute_engine_in_arena", execute_engine_in_arena);
 }
 
 } // namespace
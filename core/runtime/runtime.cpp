@@ -1,3 +1,11 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <string_view>
+#include <thread>
+#include <tuple>
+
 #include "cuda_runtime.h"
 
 #include "core/runtime/runtime.h"
@@ -8,7 +16,26 @@ namespace core {
 namespace runtime {
 
 bool MULTI_DEVICE_SAFE_MODE = false;
+bool LAZY_ENGINE_DESERIALIZATION = false;
+bool SHARE_TRT_RUNTIME = true;
+bool DEDUPLICATE_ENGINES = false;
+std::string EXTERNAL_ENGINE_DIR = "";
+int64_t ENGINE_COMPRESSION_LEVEL = 0;
+bool WEIGHT_STREAMING_ARBITER = false;
+std::string LEAN_RUNTIME_PATH = "";
+bool ENGINE_HOST_CODE_ALLOWED = false;
+thread_local bool LOAD_INCOMPATIBLE_ENGINES = false;
+bool VALIDATE_INPUTS_EVERY_CALL = false;
+bool RECORD_INPUT_SHAPES = false;
+int64_t BACKGROUND_MAX_IN_FLIGHT = 0;
+bool NUMA_LOCAL_HOST_STAGING = false;
+bool RECLAIM_MEMORY_ON_OOM = true;
+bool SHAPE_SIZED_DEVICE_MEMORY = false;
+int64_t IDLE_OFFLOAD_MS = 0;
 CudaGraphsMode CUDAGRAPHS_MODE = STANDARD;
+int64_t CUDAGRAPH_MIN_EXECUTIONS = 1;
+int64_t CUDAGRAPH_ADMISSION_WINDOW = 0;
+int64_t CUDAGRAPH_MAX_TOTAL_BYTES = 0;
 
 c10::optional<RTDevice> get_most_compatible_device(
     const RTDevice& target_device,
@@ -17,7 +44,7 @@ c10::optional<RTDevice> get_most_compatible_device(
   LOG_DEBUG("Target Device: " << target_device);
   auto device_options = find_compatible_devices(target_device, hardware_compatible);
   RTDevice current_device;
-  if (current_device.id == -1) {
+  if (curr_device.id == -1) {
     current_device = get_current_device();
   } else {
     current_device = curr_device;
@@ -29,28 +56,44 @@ c10::optional<RTDevice> get_most_compatible_device(
     return {device_options[0]};
   }
 
+  // MIG instances are named after their GPU, an instance of the target's GPU model is as valid as the full GPU. If the
+  // model is hardware compatible, any compatible device should be valid
+  auto rank = [&](const RTDevice& device) {
+    if (device.getBaseName() != target_device.getBaseName() && !hardware_compatible) {
+      return 0;
+    }
+    // An engine placed on a specific GPU or MIG instance of this machine stays on it
+    if (!target_device.uuid.empty() && device.uuid == target_device.uuid) {
+      return 5;
+    }
+    // Then the candidate which agrees with the current device ID
+    if (device.id == current_device.id) {
+      return 4;
+    }
+    // Then the candidate which agrees with the target device ID, at deserialization time the current device and target
+    // device may not agree
+    if (device.id == target_device.id) {
+      return 3;
+    }
+    // Then the first candidate of the same model, and of the same MIG profile on MIG instances
+    return device.device_name == target_device.device_name ? 2 : 1;
+  };
+
+  // Among equally ranked candidates the one nearest to the current device, which holds the inputs to move
+  const auto& topology = DeviceTopology::get();
   RTDevice best_match;
+  int best_rank = 0;
+  auto best_link = HOST_CROSS_NUMA_NODE;
   std::stringstream dev_list;
   dev_list << "[" << std::endl;
   for (auto device : device_options) {
     dev_list << "    " << device << ',' << std::endl;
-    // If the model is hardware compatible, any compatible device should be valid
-    if ((device.device_name == target_device.device_name) || hardware_compatible) {
-      // First priority is selecting a candidate which agrees with the current device ID
-      // If such a device is found, we can select it and break out of the loop
-      if (device.id == current_device.id) {
-        best_match = device;
-        break;
-      }
-      // Second priority is selecting a candidate which agrees with the target device ID
-      // At deserialization time, the current device and target device may not agree
-      else if (device.id == target_device.id) {
-        best_match = device;
-      }
-      // If no such GPU ID is found, select the first available candidate GPU
-      else if (best_match.device_name != target_device.device_name) {
-        best_match = device;
-      }
+    auto device_rank = rank(device);
+    auto device_link = topology.link(current_device.id, device.id);
+    if (device_rank > best_rank || (device_rank > 0 && device_rank == best_rank && device_link < best_link)) {
+      best_match = device;
+      best_rank = device_rank;
+      best_link = device_link;
     }
   }
   dev_list << ']';
@@ -94,6 +137,18 @@ std::vector<RTDevice> find_compatible_devices(const RTDevice& target_device, boo
   return compatible_devices;
 }
 
+c10::optional<RTDevice> find_device_by_uuid(const std::string& uuid) {
+  c10::optional<RTDevice> found;
+  for (auto& device : get_available_device_list().get_devices()) {
+    // A prefix is enough as long as it is unambiguous, like nvidia-smi accepts
+    if (!uuid.empty() && device.second.uuid.compare(0, uuid.size(), uuid) == 0) {
+      TORCHTRT_CHECK(!found, "Device UUID " << uuid << " matches both " << *found << " and " << device.second);
+      found = device.second;
+    }
+  }
+  return found;
+}
+
 void set_rt_device(RTDevice& cuda_device) {
   TORCHTRT_CHECK(
       (cudaSetDevice(cuda_device.id) == cudaSuccess), "Unable to set device: " << cuda_device << "as active device");
@@ -108,7 +163,12 @@ RTDevice get_current_device() {
 
   int64_t device_id = static_cast<int64_t>(device);
 
-  return RTDevice(device_id, nvinfer1::DeviceType::kGPU);
+  // Querying the device properties is expensive, they are only queried again when the thread switches devices
+  thread_local RTDevice current_device;
+  if (current_device.id != device_id) {
+    current_device = RTDevice(device_id, nvinfer1::DeviceType::kGPU);
+  }
+  return current_device;
 }
 
 void multi_gpu_device_check() {
@@ -122,6 +182,318 @@ void multi_gpu_device_check() {
   }
 }
 
+std::vector<c10::intrusive_ptr<TRTEngine>> collect_engines(const torch::jit::Module& mod) {
+  std::vector<c10::intrusive_ptr<TRTEngine>> engines;
+  auto engine_type = c10::getCustomClassType<c10::intrusive_ptr<TRTEngine>>();
+  auto segment_type = c10::getCustomClassType<c10::intrusive_ptr<DeferredEngineSegment>>();
+  for (const auto& attr : mod.named_attributes(/*recurse=*/true)) {
+    if (!attr.value.isCustomClass()) {
+      continue;
+    }
+    if (*attr.value.type() == *engine_type) {
+      engines.push_back(attr.value.toCustomClass<TRTEngine>());
+    } else if (*attr.value.type() == *segment_type) {
+      if (auto engine = attr.value.toCustomClass<DeferredEngineSegment>()->get_engine()) {
+        engines.push_back(engine);
+      }
+    }
+  }
+  return engines;
+}
+
+std::vector<c10::intrusive_ptr<DeferredEngineSegment>> collect_deferred_engine_segments(const torch::jit::Module& mod) {
+  std::vector<c10::intrusive_ptr<DeferredEngineSegment>> segments;
+  auto segment_type = c10::getCustomClassType<c10::intrusive_ptr<DeferredEngineSegment>>();
+  for (const auto& attr : mod.named_attributes(/*recurse=*/true)) {
+    if (attr.value.isCustomClass() && *attr.value.type() == *segment_type) {
+      segments.push_back(attr.value.toCustomClass<DeferredEngineSegment>());
+    }
+  }
+  return segments;
+}
+
+c10::intrusive_ptr<TRTEngine> get_single_engine(const torch::jit::Module& mod) {
+  auto method = mod.find_method("forward");
+  if (!method) {
+    return {};
+  }
+  auto g = method->graph();
+  std::vector<torch::jit::Node*> nodes(g->nodes().begin(), g->nodes().end());
+  // self.<engine>, prim::ListConstruct(inputs) -> tensorrt::execute_engine -> prim::ListUnpack [-> TupleConstruct]
+  if (nodes.size() != 4 && nodes.size() != 5) {
+    return {};
+  }
+  auto get_engine = nodes[0], input_list = nodes[1], execute = nodes[2], unpack = nodes[3];
+  if (get_engine->kind() != torch::jit::prim::GetAttr || get_engine->input() != g->inputs()[0] ||
+      input_list->kind() != torch::jit::prim::ListConstruct ||
+      execute->kind() != c10::Symbol::fromQualString("tensorrt::execute_engine") || execute->inputs().size() != 2 ||
+      execute->inputs()[0] != input_list->output() || execute->inputs()[1] != get_engine->output() ||
+      unpack->kind() != torch::jit::prim::ListUnpack || unpack->input() != execute->output()) {
+    return {};
+  }
+  auto graph_inputs = g->inputs().slice(1);
+  if (!std::equal(graph_inputs.begin(), graph_inputs.end(), input_list->inputs().begin(), input_list->inputs().end())) {
+    return {};
+  }
+  auto outputs = g->outputs();
+  if (nodes.size() == 5) {
+    auto tuple = nodes[4];
+    if (tuple->kind() != torch::jit::prim::TupleConstruct || outputs.size() != 1 || outputs[0] != tuple->output()) {
+      return {};
+    }
+    outputs = tuple->inputs();
+  }
+  if (!std::equal(outputs.begin(), outputs.end(), unpack->outputs().begin(), unpack->outputs().end())) {
+    return {};
+  }
+
+  auto engine = mod.attr(get_engine->s(torch::jit::attr::name));
+  if (!engine.isCustomClass() || *engine.type() != *c10::getCustomClassType<c10::intrusive_ptr<TRTEngine>>()) {
+    return {};
+  }
+  return engine.toCustomClass<TRTEngine>();
+}
+
+void bundle_engines(const torch::jit::Module& mod, const std::vector<torch::jit::Module>& variants) {
+  auto engines = collect_engines(mod);
+  for (const auto& variant : variants) {
+    auto variant_engines = collect_engines(variant);
+    TORCHTRT_CHECK(
+        variant_engines.size() == engines.size(),
+        "Module to bundle has " << variant_engines.size() << " TensorRT engines, expected " << engines.size()
+                                << ". Bundled modules must be compiled from the same program with the same settings");
+    for (size_t i = 0; i < engines.size(); i++) {
+      TORCHTRT_CHECK(
+          variant_engines[i]->in_binding_names == engines[i]->in_binding_names &&
+              variant_engines[i]->returned_output_names() == engines[i]->returned_output_names(),
+          "Engine " << variant_engines[i]->name << " of the module to bundle does not have the same bindings as engine "
+                    << engines[i]->name);
+      engines[i]->add_bundle_variants(variant_engines[i]->get_bundle_variants());
+    }
+  }
+}
+
+void swap_engines(const torch::jit::Module& mod, const torch::jit::Module& replacement, int64_t warmup_iterations) {
+  auto engines = collect_engines(mod);
+  auto replacement_engines = collect_engines(replacement);
+  TORCHTRT_CHECK(
+      replacement_engines.size() == engines.size(),
+      "Module to swap in has " << replacement_engines.size() << " TensorRT engines, expected " << engines.size()
+                               << ". Swapped modules must be compiled from the same program with the same settings");
+  // Engines are prepared up front so the module keeps serving from its current engines until every swap is ready
+  for (auto& engine : replacement_engines) {
+    engine->warmup(warmup_iterations);
+  }
+  for (size_t i = 0; i < engines.size(); i++) {
+    engines[i]->swap_engine(replacement_engines[i]);
+  }
+}
+
+int64_t get_streamable_weights_size(const torch::jit::Module& mod) {
+  int64_t size = 0;
+  for (auto& engine : collect_engines(mod)) {
+    size += engine->get_streamable_device_memory_budget();
+  }
+  return size;
+}
+
+int64_t get_weight_streaming_budget(const torch::jit::Module& mod) {
+  int64_t budget = 0;
+  for (auto& engine : collect_engines(mod)) {
+    if (engine->get_streamable_device_memory_budget() > 0) {
+      budget += engine->get_device_memory_budget();
+    }
+  }
+  return budget;
+}
+
+bool set_weight_streaming_budget(const torch::jit::Module& mod, int64_t budget) {
+  std::vector<c10::intrusive_ptr<TRTEngine>> streaming;
+  int64_t streamable = 0;
+  for (auto& engine : collect_engines(mod)) {
+    auto size = engine->get_streamable_device_memory_budget();
+    if (size > 0) {
+      streaming.push_back(engine);
+      streamable += size;
+    }
+  }
+  if (streaming.empty()) {
+    LOG_WARNING("No engine of the module was built with weight streaming, the weight streaming budget is not set");
+    return false;
+  }
+
+  bool result = true;
+  int64_t remaining = std::min(budget, streamable);
+  for (size_t i = 0; i < streaming.size(); i++) {
+    auto& engine = streaming[i];
+    int64_t share = engine->get_automatic_device_memory_budget();
+    if (budget >= 0) {
+      // The last engine takes what the rounding down of the others left
+      auto size = engine->get_streamable_device_memory_budget();
+      share = i + 1 == streaming.size()
+          ? remaining
+          : static_cast<int64_t>(static_cast<double>(std::min(budget, streamable)) * size / streamable);
+      remaining -= share;
+    }
+    LOG_DEBUG("Weight streaming budget of engine " << engine->name << " set to " << share << "B");
+    result &= engine->set_device_memory_budget(share);
+  }
+  return result;
+}
+
+std::shared_ptr<nvinfer1::IRuntime> create_trt_runtime(
+    nvinfer1::ILogger& logger,
+    const std::string& lean_runtime_path,
+    bool host_code_allowed) {
+  auto runtime = make_trt(nvinfer1::createInferRuntime(logger));
+  TORCHTRT_CHECK(runtime, "Unable to create a TensorRT runtime");
+  util::apply_torch_gpu_allocator(*runtime);
+  if (!lean_runtime_path.empty()) {
+    auto lean = make_trt(runtime->loadRuntime(lean_runtime_path.c_str()));
+    TORCHTRT_CHECK(lean, "Unable to load the TensorRT lean runtime from " << lean_runtime_path);
+    LOG_DEBUG("Loaded TensorRT lean runtime from " << lean_runtime_path);
+    util::apply_torch_gpu_allocator(*lean);
+    // The lean runtime is loaded through the runtime, keep it alive alongside
+    using RuntimeOwner = std::pair<std::shared_ptr<nvinfer1::IRuntime>, std::shared_ptr<nvinfer1::IRuntime>>;
+    auto owner = std::make_shared<RuntimeOwner>(runtime, lean);
+    runtime = std::shared_ptr<nvinfer1::IRuntime>(owner, lean.get());
+  }
+  runtime->setEngineHostCodeAllowed(host_code_allowed);
+  return runtime;
+}
+
+std::shared_ptr<nvinfer1::IRuntime> get_shared_trt_runtime(
+    int64_t device_id,
+    nvinfer1::ILogger& logger,
+    const std::string& lean_runtime_path,
+    bool host_code_allowed) {
+  // Runtimes keep the allocator they were created with
+  using RuntimeKey = std::tuple<int64_t, nvinfer1::ILogger*, std::string, bool, bool>;
+  static std::mutex cache_mu;
+  static std::map<RuntimeKey, std::weak_ptr<nvinfer1::IRuntime>> cache;
+
+  std::lock_guard<std::mutex> lock(cache_mu);
+  auto& entry =
+      cache[{device_id, &logger, lean_runtime_path, host_code_allowed, util::torch_gpu_allocator_enabled()}];
+  if (auto runtime = entry.lock()) {
+    return runtime;
+  }
+  LOG_DEBUG("Creating shared TensorRT runtime for device " << device_id);
+  auto runtime = create_trt_runtime(logger, lean_runtime_path, host_code_allowed);
+  entry = runtime;
+  return runtime;
+}
+
+namespace {
+struct EngineKey {
+  int64_t device_id;
+  size_t size;
+  size_t hash;
+  uint64_t checksum;
+
+  bool operator<(const EngineKey& other) const {
+    return std::tie(device_id, size, hash, checksum) <
+        std::tie(other.device_id, other.size, other.hash, other.checksum);
+  }
+};
+
+// Word wise FNV-1a, a second independent hash which makes collisions between different engines of the same size
+// practically impossible
+uint64_t engine_checksum(const void* data, size_t size) {
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  uint64_t h = 0xcbf29ce484222325ULL;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytes + i, sizeof(word));
+    h = (h ^ word) * 0x100000001b3ULL;
+  }
+  for (; i < size; i++) {
+    h = (h ^ bytes[i]) * 0x100000001b3ULL;
+  }
+  return h;
+}
+} // namespace
+
+std::shared_ptr<nvinfer1::ICudaEngine> get_shared_cuda_engine(
+    int64_t device_id,
+    const void* serialized_engine,
+    size_t size,
+    const std::function<std::shared_ptr<nvinfer1::ICudaEngine>()>& deserialize) {
+  static std::mutex registry_mu;
+  static std::map<EngineKey, std::weak_ptr<nvinfer1::ICudaEngine>> registry;
+
+  EngineKey key = {
+      device_id,
+      size,
+      std::hash<std::string_view>{}(std::string_view(static_cast<const char*>(serialized_engine), size)),
+      engine_checksum(serialized_engine, size)};
+  {
+    std::lock_guard<std::mutex> lock(registry_mu);
+    if (auto engine = registry[key].lock()) {
+      LOG_DEBUG("Reusing already deserialized engine (" << size << "B) on device " << device_id);
+      return engine;
+    }
+  }
+
+  // Deserialize outside of the lock so engines with different contents load concurrently, if another thread loaded
+  // the same engine in the meantime its copy wins and this one is dropped
+  auto engine = deserialize();
+  std::lock_guard<std::mutex> lock(registry_mu);
+  auto& entry = registry[key];
+  if (auto existing = entry.lock()) {
+    return existing;
+  }
+  entry = engine;
+  for (auto it = registry.begin(); it != registry.end();) {
+    it = it->second.expired() ? registry.erase(it) : std::next(it);
+  }
+  return engine;
+}
+
+void load_engines(const torch::jit::Module& mod, int64_t num_threads) {
+  std::vector<c10::intrusive_ptr<TRTEngine>> pending;
+  for (auto& engine : collect_engines(mod)) {
+    if (!engine->is_engine_loaded()) {
+      pending.push_back(std::move(engine));
+    }
+  }
+  if (pending.empty()) {
+    return;
+  }
+
+  size_t num_workers = num_threads > 0 ? static_cast<size_t>(num_threads) : std::thread::hardware_concurrency();
+  num_workers = std::max<size_t>(1, std::min(num_workers, pending.size()));
+  LOG_DEBUG("Deserializing " << pending.size() << " TensorRT engines on " << num_workers << " threads");
+
+  // Engines pick up the shared runtime of their device, which TensorRT allows to deserialize concurrently
+  std::atomic<size_t> next = {0};
+  std::vector<std::exception_ptr> errors(num_workers);
+  auto worker = [&](size_t worker_id) {
+    try {
+      for (size_t i = next++; i < pending.size(); i = next++) {
+        pending[i]->ensure_engine_loaded();
+      }
+    } catch (...) {
+      errors[worker_id] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t w = 1; w < num_workers; w++) {
+    threads.emplace_back(worker, w);
+  }
+  worker(0);
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (auto& e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+}
+
 bool get_multi_device_safe_mode() {
   return MULTI_DEVICE_SAFE_MODE;
 }
@@ -1,14 +1,20 @@
 #pragma once
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <utility>
 #include "ATen/core/function_schema.h"
 #include "NvInfer.h"
+#include "core/runtime/DeferredEngineSegment.h"
+#include "core/runtime/DeviceTopology.h"
+#include "core/runtime/EngineFile.h"
 #include "core/runtime/Platform.h"
 #include "core/runtime/RTDevice.h"
+#include "core/runtime/SegmentActivationArena.h"
 #include "core/runtime/TRTEngine.h"
 #include "core/util/prelude.h"
+#include "torch/csrc/jit/api/module.h"
 #include "torch/custom_class.h"
 
 namespace torch_tensorrt {
@@ -16,8 +22,46 @@ namespace core {
 namespace runtime {
 
 using EngineID = int64_t;
-const std::string ABI_VERSION = "6";
+const std::string ABI_VERSION = "7";
+// Last ABI version which pickled engines as a list of strings with the engine base64 encoded at ENGINE_IDX
+const std::string BASE64_ENGINE_ABI_VERSION = "6";
 extern bool MULTI_DEVICE_SAFE_MODE;
+// Defer deserializing engines loaded from a serialized module until their first execution
+extern bool LAZY_ENGINE_DESERIALIZATION;
+// Engines on the same device share one IRuntime, disable to give each engine its own runtime for isolation
+extern bool SHARE_TRT_RUNTIME;
+// Engines loaded with the same contents on the same device share one ICudaEngine (and its weights), each TRTEngine
+// still creates its own execution contexts
+extern bool DEDUPLICATE_ENGINES;
+// When non empty, serialized engines are written to files in this directory and modules only store a reference to them
+extern std::string EXTERNAL_ENGINE_DIR;
+// zstd level embedded engines are compressed with when modules are saved, 0: engines are stored uncompressed. Loading
+// decompresses them regardless of this setting. Engines written to EXTERNAL_ENGINE_DIR stay uncompressed to be mapped
+extern int64_t ENGINE_COMPRESSION_LEVEL;
+// Engines built with weight streaming register with the process wide WeightStreamingArbiter as they are loaded, which
+// redistributes device memory between them instead of each keeping the automatic budget
+extern bool WEIGHT_STREAMING_ARBITER;
+// Defaults of TRTEngine::lean_runtime_path and TRTEngine::engine_host_code_allowed for the engines created afterwards
+extern std::string LEAN_RUNTIME_PATH;
+extern bool ENGINE_HOST_CODE_ALLOWED;
+// Engines loaded on this thread while set are kept serialized instead of failing to load if no device of this
+// machine can run them, so programs compiled for other GPUs can be loaded to be bundled (see bundle_engines)
+extern thread_local bool LOAD_INCOMPATIBLE_ENGINES;
+// Validate the dtype and device of the inputs on every execution instead of once per shape key, for debugging
+extern bool VALIDATE_INPUTS_EVERY_CALL;
+// Record a histogram of the input shapes of every engine execution (see TRTEngine::get_input_shape_histogram)
+extern bool RECORD_INPUT_SHAPES;
+// Max number of executions of background QoS engines which may be queued or running on a device at once, 0: no limit
+extern int64_t BACKGROUND_MAX_IN_FLIGHT;
+// Place the pinned buffers host inputs are staged in on the NUMA node of the engine's GPU (see DeviceTopology)
+extern bool NUMA_LOCAL_HOST_STAGING;
+// When the runtime runs out of device memory creating execution contexts, capturing CUDA graphs or allocating outputs,
+// reclaim the memory engines hold without needing it and retry (see MemoryReclaimer) instead of failing the execution
+extern bool RECLAIM_MEMORY_ON_OOM;
+// Default of TRTEngine::shape_sized_device_memory for the engines created afterwards
+extern bool SHAPE_SIZED_DEVICE_MEMORY;
+// Default of TRTEngine::idle_offload_ms for the engines created afterwards, 0: engines are never offloaded
+extern int64_t IDLE_OFFLOAD_MS;
 
 typedef enum {
   STANDARD = 0,
@@ -26,6 +70,13 @@ typedef enum {
 } CudaGraphsMode;
 
 extern CudaGraphsMode CUDAGRAPHS_MODE;
+// Admission of input shapes to CUDA graphs in subgraph mode (see CudaGraphAdmission): a graph is only captured for a
+// shape once an execution slot ran it CUDAGRAPH_MIN_EXECUTIONS times within its last CUDAGRAPH_ADMISSION_WINDOW
+// executions (0: no window), and while the graphs of the process hold less than CUDAGRAPH_MAX_TOTAL_BYTES of
+// persistent buffers (0: no limit). Other executions run without a graph
+extern int64_t CUDAGRAPH_MIN_EXECUTIONS;
+extern int64_t CUDAGRAPH_ADMISSION_WINDOW;
+extern int64_t CUDAGRAPH_MAX_TOTAL_BYTES;
 
 typedef enum {
   ABI_TARGET_IDX = 0,
@@ -40,6 +91,7 @@ typedef enum {
   SERIALIZATION_LEN, // NEVER USED FOR DATA, USED TO DETERMINE LENGTH OF SERIALIZED INFO
 } SerializedInfoIndex;
 
+std::string base64_encode(const void* data, size_t size);
 std::string base64_encode(const std::string& in);
 std::string base64_decode(const std::string& in);
 std::string serialize_bindings(const std::vector<std::string>& bindings);
@@ -50,10 +102,117 @@ c10::optional<RTDevice> get_most_compatible_device(
     bool hardware_compatible = false);
 std::vector<RTDevice> find_compatible_devices(const RTDevice& target_device, bool hardware_compatible);
 
+// Device (a GPU or, on MIG enabled GPUs, a MIG instance) of this process whose UUID is uuid or starts with it
+c10::optional<RTDevice> find_device_by_uuid(const std::string& uuid);
+
 std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intrusive_ptr<TRTEngine> compiled_engine);
+// execute_engine returning only the outputs the engine binds, without those which alias an input or another output
+// (see TRTEngine::output_sources)
+std::vector<at::Tensor> execute_engine_bindings(
+    std::vector<at::Tensor> inputs,
+    c10::intrusive_ptr<TRTEngine> compiled_engine);
+// Writes the outputs of the engine directly into the given tensors, which must be contiguous CUDA tensors with the
+// output shapes and dtypes of the engine. With CUDA graphs, graphs are captured against the given tensors (keeping
+// them alive) and replayed into them without a copy as long as the same tensors are passed on each call
+void execute_engine_out(
+    std::vector<at::Tensor> inputs,
+    std::vector<at::Tensor> outputs,
+    c10::intrusive_ptr<TRTEngine> compiled_engine);
+
+// Runs the engine as the step-th engine of a hybrid graph, placing the outputs arena plans for that step in the arena
+std::vector<at::Tensor> execute_engine_in_arena(
+    std::vector<at::Tensor> inputs,
+    c10::intrusive_ptr<TRTEngine> compiled_engine,
+    c10::intrusive_ptr<SegmentActivationArena> arena,
+    int64_t step);
+
+// Execution of an engine whose bindings (input shapes, output allocation and tensor addresses) were set up by
+// prepare_execution on one of its execution slots. The slot stays checked out until the ticket is launched or
+// destroyed, so that the next execution can be prepared on another slot while this one is enqueued and running
+struct ExecutionTicket : torch::CustomClassHolder {
+  ~ExecutionTicket();
+  // Returns the slot to the pool of its engine
+  void release();
+
+  c10::intrusive_ptr<TRTEngine> engine;
+  std::unique_ptr<ExecutionSlotGuard> slot;
+  std::vector<at::Tensor> outputs;
+  // Caller inputs, kept for the outputs which alias them (see TRTEngine::output_sources)
+  std::vector<at::Tensor> inputs;
+  // Recorded on prepare_stream once the inputs were formatted and the outputs allocated
+  at::cuda::CUDAEvent prepared;
+  c10::cuda::CUDAStream prepare_stream = c10::cuda::getDefaultCUDAStream();
+};
+
+// Prepares an execution of the engine with the inputs, which are read when the ticket is launched. Tickets run without
+// CUDA graphs, profiling or dynamic batching and are not supported for DLA loadables or engines with state bindings
+c10::intrusive_ptr<ExecutionTicket> prepare_execution(
+    std::vector<at::Tensor> inputs,
+    c10::intrusive_ptr<TRTEngine> compiled_engine);
+// Enqueues a prepared execution on stream (the current stream of the engine's device if null) and returns its outputs,
+// which are ready once stream is past the execution. A ticket can only be launched once
+std::vector<at::Tensor> launch_execution(
+    const c10::intrusive_ptr<ExecutionTicket>& ticket,
+    cudaStream_t stream = nullptr);
 
 void multi_gpu_device_check();
 
+// Process wide cache of TensorRT runtimes keyed by device, logger and runtime options. Runtimes are released once the
+// last engine using them is destroyed. With a lean_runtime_path, the runtime is the lean runtime loaded from that
+// library (IRuntime::loadRuntime), host_code_allowed lets it run the lean runtime of version compatible engines
+std::shared_ptr<nvinfer1::IRuntime> get_shared_trt_runtime(
+    int64_t device_id,
+    nvinfer1::ILogger& logger = util::logging::get_logger(),
+    const std::string& lean_runtime_path = "",
+    bool host_code_allowed = false);
+// Creates a runtime with the given options which is not shared with other engines
+std::shared_ptr<nvinfer1::IRuntime> create_trt_runtime(
+    nvinfer1::ILogger& logger,
+    const std::string& lean_runtime_path = "",
+    bool host_code_allowed = false);
+
+// Process wide registry of deserialized engines keyed by device and a hash of the serialized engine. deserialize is
+// only invoked if no live engine with the same contents exists on the device, entries are released with the last
+// TRTEngine using them
+std::shared_ptr<nvinfer1::ICudaEngine> get_shared_cuda_engine(
+    int64_t device_id,
+    const void* serialized_engine,
+    size_t size,
+    const std::function<std::shared_ptr<nvinfer1::ICudaEngine>()>& deserialize);
+
+// Returns the TensorRT engines held as attributes by mod and its submodules, including the engines deferred engine
+// segments have switched to so far
+std::vector<c10::intrusive_ptr<TRTEngine>> collect_engines(const torch::jit::Module& mod);
+
+// Returns the deferred engine segments (see CompileSpec::background_build) held by mod and its submodules
+std::vector<c10::intrusive_ptr<DeferredEngineSegment>> collect_deferred_engine_segments(const torch::jit::Module& mod);
+
+// Returns the engine of mod if its forward method only executes that engine on its inputs, in order, and returns the
+// engine outputs (the graph AddEngineToGraph creates for fully converted modules). nullptr otherwise
+c10::intrusive_ptr<TRTEngine> get_single_engine(const torch::jit::Module& mod);
+
+// Adds the engines of each of variants, compiled from the same program for other GPUs, to the engine bundles of the
+// engines of mod. Engines are matched in collect_engines order and must have the same bindings
+void bundle_engines(const torch::jit::Module& mod, const std::vector<torch::jit::Module>& variants);
+
+// Warms up the engines of replacement (see TRTEngine::warmup) and then swaps them one by one with the engines of mod,
+// matched in collect_engines order, so mod runs the engines of replacement and replacement holds the previous ones.
+// An execution of mod in flight during the swap may run some of its engines before and others after their swap
+void swap_engines(const torch::jit::Module& mod, const torch::jit::Module& replacement, int64_t warmup_iterations = 0);
+
+// Total size of the weights the engines of mod, built with weight streaming, can stream from host memory
+int64_t get_streamable_weights_size(const torch::jit::Module& mod);
+// Device memory the engines of mod currently budget for streamable weights, summed over the engines
+int64_t get_weight_streaming_budget(const torch::jit::Module& mod);
+// Splits budget bytes of device memory for streamable weights across the engines of mod in proportion to their
+// streamable weights, a negative budget gives each engine its automatic budget. Returns false if any engine rejected
+// its share
+bool set_weight_streaming_budget(const torch::jit::Module& mod, int64_t budget);
+
+// Deserializes all engines of mod which have not been loaded yet (see LAZY_ENGINE_DESERIALIZATION) on a pool of
+// num_threads threads (0: one per hardware thread)
+void load_engines(const torch::jit::Module& mod, int64_t num_threads = 0);
+
 bool get_multi_device_safe_mode();
 
 void set_multi_device_safe_mode(bool multi_device_safe_mode);
@@ -0,0 +1,173 @@
+#include "core/sparsity.h"
+
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/torch.h"
+
+#include "core/engine_lint.h"
+#include "core/ir/ir.h"
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace {
+
+// Moves reduction_dim last, zero pads it to a multiple of four and splits it into rows of four
+at::Tensor groups_of_four(const at::Tensor& weight, int64_t reduction_dim) {
+  auto t = weight.movedim(reduction_dim, -1);
+  auto pad = (4 - t.size(-1) % 4) % 4;
+  if (pad) {
+    t = at::constant_pad_nd(t, {0, pad});
+  }
+  return t.reshape({-1, 4});
+}
+
+c10::optional<at::Tensor> weight_tensor(torch::jit::Value* v, ir::StaticParams& static_params) {
+  if (v->node()->kind() == torch::jit::prim::Constant) {
+    auto ivalue = torch::jit::toIValue(v);
+    if (ivalue && ivalue->isTensor()) {
+      return ivalue->toTensor();
+    }
+  } else if (static_params.count(v) && static_params[v].isTensor()) {
+    return static_params[v].toTensor();
+  }
+  return {};
+}
+
+// Weight of a convolution or matrix multiply and the dimension TensorRT groups by four for sparse tactics
+struct WeightUse {
+  torch::jit::Value* weight;
+  int64_t reduction_dim;
+};
+
+c10::optional<WeightUse> find_weight(torch::jit::Node* n) {
+  auto kind = n->kind();
+  if (kind == torch::jit::aten::_convolution) {
+    auto transposed = torch::jit::toIValue(n->input(6));
+    if (transposed && transposed->isBool() && transposed->toBool()) {
+      return {};
+    }
+    return WeightUse{n->input(1), 1};
+  } else if (
+      kind == torch::jit::aten::conv1d || kind == torch::jit::aten::conv2d || kind == torch::jit::aten::conv3d ||
+      kind == torch::jit::aten::linear) {
+    return WeightUse{n->input(1), 1};
+  }
+
+  torch::jit::Value* other = nullptr;
+  if (kind == torch::jit::aten::matmul || kind == torch::jit::aten::mm) {
+    other = n->input(1);
+  } else if (kind == torch::jit::aten::addmm) {
+    other = n->input(2);
+  } else {
+    return {};
+  }
+  // Linear layers are lowered to a matrix multiply with the transposed weight
+  if (other->node()->kind() == torch::jit::aten::t) {
+    return WeightUse{other->node()->input(0), 1};
+  }
+  return WeightUse{other, 0};
+}
+
+} // namespace
+
+bool Is2To4Sparse(const at::Tensor& weight, int64_t reduction_dim) {
+  auto groups = groups_of_four(weight, reduction_dim);
+  return groups.ne(0).sum(1).le(2).all().item<bool>();
+}
+
+at::Tensor Prune2To4(const at::Tensor& weight, int64_t reduction_dim) {
+  auto channels = weight.size(reduction_dim);
+  auto moved_sizes = weight.movedim(reduction_dim, -1).sizes().vec();
+  auto groups = groups_of_four(weight, reduction_dim);
+
+  auto keep = std::get<1>(groups.abs().topk(2, 1));
+  auto mask = at::zeros_like(groups, groups.options().dtype(at::kBool)).scatter_(1, keep, true);
+  auto pruned = groups.masked_fill(mask.logical_not(), 0);
+
+  auto padded_sizes = moved_sizes;
+  padded_sizes.back() = (channels + 3) / 4 * 4;
+  return pruned.reshape(padded_sizes).narrow(-1, 0, channels).movedim(-1, reduction_dim).contiguous();
+}
+
+std::vector<WeightSparsity> CheckWeightSparsity(
+    const torch::jit::Module& mod,
+    const std::string& method_name,
+    const lowering::LowerInfo& lower_info) {
+  auto graph_and_parameters = lowering::Lower(mod, method_name, lower_info);
+  auto g = graph_and_parameters.first;
+  auto static_params = ir::get_static_params(g->inputs(), graph_and_parameters.second);
+
+  std::vector<WeightSparsity> report;
+  for (auto n : g->block()->nodes()) {
+    auto use = find_weight(n);
+    if (!use) {
+      continue;
+    }
+    auto weight = weight_tensor(use->weight, static_params);
+    if (!weight || weight->dim() < 2) {
+      continue;
+    }
+    WeightSparsity w;
+    w.name = use->weight->debugName();
+    w.op = n->kind().toQualString();
+    w.shape = weight->sizes().vec();
+    w.zero_fraction = weight->eq(0).sum().item<double>() / weight->numel();
+    w.is_2_4_sparse = Is2To4Sparse(*weight, use->reduction_dim);
+    if (!w.is_2_4_sparse) {
+      LOG_DEBUG("Weight " << w.name << " of " << w.op << " is not 2:4 sparse");
+    }
+    report.push_back(std::move(w));
+  }
+  return report;
+}
+
+int64_t PruneWeights2To4(torch::jit::Module& mod) {
+  torch::NoGradGuard no_grad;
+  int64_t num_pruned = 0;
+  for (const auto& sub : mod.named_modules()) {
+    auto type_name = sub.value.type()->name();
+    if (!type_name || type_name->qualifiedName().find("torch.nn.modules.") == std::string::npos) {
+      continue;
+    }
+    auto cls = type_name->name();
+    if (cls != "Conv1d" && cls != "Conv2d" && cls != "Conv3d" && cls != "Linear") {
+      continue;
+    }
+    if (!sub.value.hasattr("weight") || !sub.value.attr("weight").isTensor()) {
+      continue;
+    }
+    auto weight = sub.value.attr("weight").toTensor();
+    weight.copy_(Prune2To4(weight, 1));
+    LOG_DEBUG("Pruned " << (sub.name.empty() ? "weight" : sub.name + ".weight") << " to 2:4 sparsity");
+    num_pruned++;
+  }
+  LOG_INFO("Pruned the weights of " << num_pruned << " Conv and Linear modules to 2:4 sparsity");
+  return num_pruned;
+}
+
+std::vector<std::string> GetSparseEngineLayers(const torch::jit::Module& compiled_mod) {
+  std::vector<std::string> sparse_layers;
+  for (auto& engine : runtime::collect_engines(compiled_mod)) {
+    bool has_tactics = false;
+    for (auto& layer : ParseEngineLayers(engine->get_engine_layer_info())) {
+      auto tactic = layer.fields.find("TacticName");
+      if (tactic == layer.fields.end()) {
+        continue;
+      }
+      has_tactics = true;
+      if (tactic->second.find("sparse") != std::string::npos) {
+        sparse_layers.push_back(engine->name + ": " + layer.fields["Name"]);
+      }
+    }
+    if (!has_tactics) {
+      LOG_WARNING(
+          "Engine " << engine->name << " does not record the tactics of its layers, build it with sparse_weights "
+                    << "enabled to find its sparse layers");
+    }
+  }
+  return sparse_layers;
+}
+
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/lowering/lowering.h"
+#include "torch/csrc/jit/api/module.h"
+
+namespace torch_tensorrt {
+namespace core {
+
+// 2:4 structured sparsity of the weight of one convolution or matrix multiply of a lowered graph
+struct WeightSparsity {
+  // Debug name of the weight in the lowered graph, e.g. self.conv1.weight
+  std::string name;
+  // Operator consuming the weight
+  std::string op;
+  std::vector<int64_t> shape;
+  // Fraction of the weight that is zero
+  double zero_fraction = 0.0;
+  // Every group of four consecutive input channels holds at most two non zero values, as sparse tactics require
+  bool is_2_4_sparse = false;
+};
+
+// Whether weight is 2:4 sparse along reduction_dim, a trailing group of fewer than four channels counts as zero padded
+bool Is2To4Sparse(const at::Tensor& weight, int64_t reduction_dim);
+
+// Keeps the two values of largest magnitude of every group of four along reduction_dim and zeroes the others
+at::Tensor Prune2To4(const at::Tensor& weight, int64_t reduction_dim);
+
+// Checks the weights of the convolutions and matrix multiplies of method_name after lowering, which are the
+// weights TensorRT sees when sparse_weights is enabled
+std::vector<WeightSparsity> CheckWeightSparsity(
+    const torch::jit::Module& mod,
+    const std::string& method_name,
+    const lowering::LowerInfo& lower_info);
+
+// Applies magnitude based 2:4 pruning in place to the weights of the Conv1d/2d/3d and Linear submodules of mod.
+// Returns the number of weights pruned
+int64_t PruneWeights2To4(torch::jit::Module& mod);
+
+// Names of the layers of the TensorRT engines in compiled_mod that run sparse tactics. Tactic names are only recorded
+// in engines built with sparse_weights enabled
+std::vector<std::string> GetSparseEngineLayers(const torch::jit::Module& compiled_mod);
+
+} // namespace core
+} // namespace torch_tensorrt
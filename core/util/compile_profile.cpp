@@ -0,0 +1,126 @@
+#include <algorithm>
+
+#include <cuda_runtime.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "core/util/compile_profile.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace util {
+
+namespace {
+thread_local CompileProfiler* tls_profiler = nullptr;
+thread_local std::string tls_segment;
+thread_local CompilePhase* tls_phase = nullptr;
+} // namespace
+
+void CompileProfiler::record(CompilePhaseRecord r) {
+  std::lock_guard<std::mutex> lock(mu);
+  phases.push_back(std::move(r));
+}
+
+std::vector<CompilePhaseRecord> CompileProfiler::records() const {
+  std::lock_guard<std::mutex> lock(mu);
+  return phases;
+}
+
+CompileProfileScope::CompileProfileScope(CompileProfiler* profiler, std::string segment)
+    : prev_profiler(tls_profiler), prev_segment(std::move(tls_segment)) {
+  tls_profiler = profiler;
+  tls_segment = std::move(segment);
+}
+
+CompileProfileScope::~CompileProfileScope() {
+  tls_profiler = prev_profiler;
+  tls_segment = std::move(prev_segment);
+}
+
+CompileProfiler* current_compile_profiler() {
+  return tls_profiler;
+}
+
+const std::string& current_compile_segment() {
+  return tls_segment;
+}
+
+CompilePhase::CompilePhase(std::string name) {
+  if (!tls_profiler) {
+    return;
+  }
+  profiler = tls_profiler;
+  parent = tls_phase;
+  this->name = std::move(name);
+  peak_gpu_bytes = gpu_memory_in_use();
+  tls_phase = this;
+  start = std::chrono::steady_clock::now();
+}
+
+CompilePhase::~CompilePhase() {
+  if (!profiler) {
+    return;
+  }
+  auto wall_time = std::chrono::steady_clock::now() - start;
+  update_peak(gpu_memory_in_use());
+  // The phase is still recorded if it is left by an exception, so the report shows where a failed compilation was
+  CompilePhaseRecord r;
+  r.phase = std::move(name);
+  r.segment = tls_segment;
+  r.wall_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(wall_time).count();
+  r.peak_host_bytes = host_peak_rss_bytes();
+  r.peak_gpu_bytes = peak_gpu_bytes;
+  profiler->record(std::move(r));
+  if (parent) {
+    parent->update_peak(peak_gpu_bytes);
+  }
+  tls_phase = parent;
+}
+
+void CompilePhase::update_peak(int64_t gpu_bytes) {
+  peak_gpu_bytes = std::max(peak_gpu_bytes, gpu_bytes);
+}
+
+void sample_compile_gpu_memory() {
+  if (tls_phase) {
+    tls_phase->update_peak(gpu_memory_in_use());
+  }
+}
+
+int64_t host_peak_rss_bytes() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return static_cast<int64_t>(counters.PeakWorkingSetSize);
+  }
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#ifdef __APPLE__
+  return static_cast<int64_t>(usage.ru_maxrss);
+#else
+  return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+int64_t gpu_memory_in_use() {
+  size_t free_bytes = 0;
+  size_t total_bytes = 0;
+  if (cudaMemGetInfo(&free_bytes, &total_bytes) != cudaSuccess) {
+    cudaGetLastError();
+    return 0;
+  }
+  return static_cast<int64_t>(total_bytes - free_bytes);
+}
+
+} // namespace util
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,88 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace torch_tensorrt {
+namespace core {
+namespace util {
+
+// Wall time and memory of one phase of a compilation
+struct CompilePhaseRecord {
+  std::string phase;
+  // TensorRT segment the phase ran for, empty for phases covering the whole module
+  std::string segment;
+  int64_t wall_time_ns = 0;
+  // Peak resident set size of the process when the phase finished
+  int64_t peak_host_bytes = 0;
+  // Highest device memory in use on the current GPU sampled during the phase. The device is sampled when the phase
+  // starts and finishes and at every TensorRT builder step, so short spikes in between can be missed
+  int64_t peak_gpu_bytes = 0;
+};
+
+// Collects the phases of one compilation in the order they finished. Phases are recorded from every thread
+// compiling for the module (e.g. the parallel engine build workers)
+class CompileProfiler {
+ public:
+  void record(CompilePhaseRecord r);
+  std::vector<CompilePhaseRecord> records() const;
+
+ private:
+  mutable std::mutex mu;
+  std::vector<CompilePhaseRecord> phases;
+};
+
+// Makes profiler the one phases on this thread are recorded in, under segment, until the end of the scope. Compile
+// phases are not recorded on threads without a profiler, a phase then costs a single thread local load
+class CompileProfileScope {
+ public:
+  CompileProfileScope(CompileProfiler* profiler, std::string segment);
+  CompileProfileScope(const CompileProfileScope&) = delete;
+  CompileProfileScope& operator=(const CompileProfileScope&) = delete;
+  ~CompileProfileScope();
+
+ private:
+  CompileProfiler* prev_profiler;
+  std::string prev_segment;
+};
+
+CompileProfiler* current_compile_profiler();
+const std::string& current_compile_segment();
+
+// Records the enclosing scope as a phase with the profiler of this thread. Phases nest, the GPU memory peak of a
+// phase includes that of the phases inside it
+class CompilePhase {
+ public:
+  explicit CompilePhase(std::string name);
+  CompilePhase(const CompilePhase&) = delete;
+  CompilePhase& operator=(const CompilePhase&) = delete;
+  ~CompilePhase();
+
+ private:
+  friend void sample_compile_gpu_memory();
+  void update_peak(int64_t gpu_bytes);
+
+  CompileProfiler* profiler = nullptr;
+  CompilePhase* parent = nullptr;
+  std::string name;
+  std::chrono::steady_clock::time_point start;
+  int64_t peak_gpu_bytes = 0;
+};
+
+// Samples the device memory in use into the innermost phase open on this thread
+void sample_compile_gpu_memory();
+
+int64_t host_peak_rss_bytes();
+int64_t gpu_memory_in_use();
+
+} // namespace util
+} // namespace core
+} // namespace torch_tensorrt
+
+#define TORCHTRT_COMPILE_PHASE_CONCAT_IMPL(a, b) a##b
+#define TORCHTRT_COMPILE_PHASE_CONCAT(a, b) TORCHTRT_COMPILE_PHASE_CONCAT_IMPL(a, b)
+// Records the rest of the enclosing scope as a compile phase
+#define TORCHTRT_COMPILE_PHASE(name) \
+  torch_tensorrt::core::util::CompilePhase TORCHTRT_COMPILE_PHASE_CONCAT(_torchtrt_compile_phase_, __LINE__)(name)
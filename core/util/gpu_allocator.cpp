@@ -0,0 +1,127 @@
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#include "c10/cuda/CUDACachingAllocator.h"
+#include "c10/cuda/CUDAStream.h"
+
+#include "core/util/gpu_allocator.h"
+#include "core/util/logging/TorchTRTLogger.h"
+#include "core/util/macros.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace util {
+
+namespace {
+bool torch_gpu_allocator_enabled_from_env() {
+  const char* env = std::getenv("TORCHTRT_TORCH_GPU_ALLOCATOR");
+  return env != nullptr && std::strcmp(env, "0") != 0;
+}
+
+std::atomic<bool>& torch_gpu_allocator_flag() {
+  static std::atomic<bool> flag(torch_gpu_allocator_enabled_from_env());
+  return flag;
+}
+} // namespace
+
+bool torch_gpu_allocator_enabled() {
+  return torch_gpu_allocator_flag().load(std::memory_order_relaxed);
+}
+
+void set_torch_gpu_allocator_enabled(bool enabled) {
+  torch_gpu_allocator_flag().store(enabled, std::memory_order_relaxed);
+}
+
+#if NV_TENSORRT_MAJOR >= 10
+void* TorchGpuAllocator::allocateAsync(
+    uint64_t size,
+    uint64_t alignment,
+    nvinfer1::AllocatorFlags flags,
+    cudaStream_t stream) noexcept {
+  return allocate_on(size, alignment, stream);
+}
+
+bool TorchGpuAllocator::deallocateAsync(void* memory, cudaStream_t stream) noexcept {
+  return release_on(memory, stream);
+}
+#else
+void* TorchGpuAllocator::allocate(uint64_t size, uint64_t alignment, nvinfer1::AllocatorFlags flags) noexcept {
+  return allocate_on(size, alignment, c10::cuda::getCurrentCUDAStream().stream());
+}
+
+bool TorchGpuAllocator::deallocate(void* memory) noexcept {
+  return release_on(memory, c10::cuda::getCurrentCUDAStream().stream());
+}
+
+void TorchGpuAllocator::free(void* memory) noexcept {
+  deallocate(memory);
+}
+#endif
+
+size_t TorchGpuAllocator::num_allocations() {
+  std::lock_guard<std::mutex> lock(mu);
+  return allocations.size();
+}
+
+void* TorchGpuAllocator::allocate_on(uint64_t size, uint64_t alignment, cudaStream_t stream) noexcept {
+  if (size == 0) {
+    return nullptr;
+  }
+  void* memory = nullptr;
+  try {
+    memory = c10::cuda::CUDACachingAllocator::raw_alloc_with_stream(size, stream);
+  } catch (const std::exception& e) {
+    // TensorRT handles failed allocations itself, for instance by skipping tactics which need too much memory
+    LOG_DEBUG("The Torch caching allocator could not allocate " << size << "B for TensorRT: " << e.what());
+    return nullptr;
+  }
+  // Blocks of the caching allocator are 512B aligned, which covers what TensorRT asks for
+  if (alignment > 0 && reinterpret_cast<uintptr_t>(memory) % alignment != 0) {
+    LOG_ERROR("Block of the Torch caching allocator is not aligned to the " << alignment << "B TensorRT requested");
+    c10::cuda::CUDACachingAllocator::raw_delete(memory);
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mu);
+  allocations[memory] = stream;
+  return memory;
+}
+
+bool TorchGpuAllocator::release_on(void* memory, cudaStream_t stream) noexcept {
+  if (memory == nullptr) {
+    return true;
+  }
+  cudaStream_t allocation_stream;
+  {
+    std::lock_guard<std::mutex> lock(mu);
+    auto it = allocations.find(memory);
+    if (it == allocations.end()) {
+      LOG_ERROR("TensorRT released memory which was not allocated by the Torch caching allocator");
+      return false;
+    }
+    allocation_stream = it->second;
+    allocations.erase(it);
+  }
+  try {
+    // The block is reused in the order of the stream it was allocated on, work still queued on another stream has to
+    // complete first
+    if (stream != allocation_stream && cudaStreamSynchronize(stream) != cudaSuccess) {
+      LOG_ERROR("Unable to synchronize the stream TensorRT released memory on");
+      return false;
+    }
+    c10::cuda::CUDACachingAllocator::raw_delete(memory);
+  } catch (const std::exception& e) {
+    LOG_ERROR("Unable to return memory of TensorRT to the Torch caching allocator: " << e.what());
+    return false;
+  }
+  return true;
+}
+
+TorchGpuAllocator* get_torch_gpu_allocator() {
+  static auto* allocator = new TorchGpuAllocator();
+  return allocator;
+}
+
+} // namespace util
+} // namespace core
+} // namespace torch_tensorrt
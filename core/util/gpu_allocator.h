@@ -0,0 +1,64 @@
+#pragma once
+#include <mutex>
+#include <unordered_map>
+
+#include "NvInfer.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace util {
+
+// Device memory TensorRT allocates for itself (engine weights, execution context scratch, builder tactics) is by
+// default taken from a pool of its own, which fragments the GPU against the PyTorch caching allocator. When enabled,
+// the runtimes and builders created afterwards allocate from the caching allocator instead, so the Torch and
+// TensorRT parts of a hybrid module share one pool. Off by default, can be enabled with the
+// TORCHTRT_TORCH_GPU_ALLOCATOR=1 environment variable or at runtime
+bool torch_gpu_allocator_enabled();
+void set_torch_gpu_allocator_enabled(bool enabled);
+
+#if NV_TENSORRT_MAJOR >= 10
+using GpuAllocatorBase = nvinfer1::IGpuAsyncAllocator;
+#else
+using GpuAllocatorBase = nvinfer1::IGpuAllocator;
+#endif
+
+// Stream ordered allocator on top of c10::cuda::CUDACachingAllocator. Blocks are allocated on the stream TensorRT
+// requests them for and are returned to the pool of that stream, a block released on another stream waits for that
+// stream first
+class TorchGpuAllocator : public GpuAllocatorBase {
+ public:
+#if NV_TENSORRT_MAJOR >= 10
+  void* allocateAsync(uint64_t size, uint64_t alignment, nvinfer1::AllocatorFlags flags, cudaStream_t stream) noexcept
+      override;
+  bool deallocateAsync(void* memory, cudaStream_t stream) noexcept override;
+#else
+  void* allocate(uint64_t size, uint64_t alignment, nvinfer1::AllocatorFlags flags) noexcept override;
+  bool deallocate(void* memory) noexcept override;
+  void free(void* memory) noexcept override;
+#endif
+
+  // Number of blocks TensorRT holds
+  size_t num_allocations();
+
+ private:
+  void* allocate_on(uint64_t size, uint64_t alignment, cudaStream_t stream) noexcept;
+  bool release_on(void* memory, cudaStream_t stream) noexcept;
+
+  std::mutex mu;
+  std::unordered_map<void*, cudaStream_t> allocations;
+};
+
+// Process wide allocator, never destroyed since runtimes and engines may release memory during static destruction
+TorchGpuAllocator* get_torch_gpu_allocator();
+
+// Sets the Torch allocator on a runtime or builder if it is enabled
+template <class T>
+void apply_torch_gpu_allocator(T& trt_object) {
+  if (torch_gpu_allocator_enabled()) {
+    trt_object.setGpuAllocator(get_torch_gpu_allocator());
+  }
+}
+
+} // namespace util
+} // namespace core
+} // namespace torch_tensorrt
@@ -1,7 +1,16 @@
 #include "core/util/logging/TorchTRTLogger.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #define TERM_NORMAL "\033[0m";
 #define TERM_RED "\033[0;31m";
@@ -16,37 +25,210 @@ namespace trt = nvinfer1;
 namespace util {
 namespace logging {
 
+namespace {
+
+// Bounded multi producer, single consumer queue of log lines (after Vyukov's bounded MPMC queue). A producer claims a
+// slot with one compare and swap and never waits, it drops its line if the queue is full
+class LineQueue {
+ public:
+  explicit LineQueue(size_t capacity) : slots_(capacity) {
+    for (size_t i = 0; i < capacity; i++) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  bool push(std::string&& line) {
+    auto pos = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      auto& slot = slots_[pos % slots_.size()];
+      auto diff = static_cast<int64_t>(slot.seq.load(std::memory_order_acquire)) - static_cast<int64_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          slot.line = std::move(line);
+          slot.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Only called by the consumer
+  bool pop(std::string& line) {
+    auto& slot = slots_[head_ % slots_.size()];
+    if (slot.seq.load(std::memory_order_acquire) != head_ + 1) {
+      return false;
+    }
+    line = std::move(slot.line);
+    slot.seq.store(head_ + slots_.size(), std::memory_order_release);
+    head_++;
+    return true;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> seq;
+    std::string line;
+  };
+  std::vector<Slot> slots_;
+  std::atomic<size_t> tail_ = {0};
+  size_t head_ = 0;
+};
+
+// Writes the lines of async loggers to stderr on a background thread. Call sites are hashed into a fixed table of
+// message budgets, so rate limiting a message takes no lock either. Sites sharing a slot share its budget
+class AsyncSink {
+ public:
+  // Never destroyed, loggers may still log while other statics are destroyed. The thread is stopped at exit, lines
+  // logged after that are written right away
+  static AsyncSink& get() {
+    static AsyncSink* sink = [] {
+      auto s = new AsyncSink();
+      std::atexit([] { get().stop(); });
+      return s;
+    }();
+    return *sink;
+  }
+
+  // Whether a message of site is written, suppressed is set to the number of messages of the site dropped since the
+  // last one written
+  bool admit(const char* site, const std::string& msg, uint32_t max_per_second, uint32_t& suppressed) {
+    auto& budget = budgets_[std::hash<const void*>()(site) % kNumBudgets];
+    auto second = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch())
+                      .count();
+    auto window = budget.window.load(std::memory_order_relaxed);
+    if (window != second && budget.window.compare_exchange_strong(window, second)) {
+      budget.count.store(0, std::memory_order_relaxed);
+      budget.last_msg.store(0, std::memory_order_relaxed);
+    }
+    auto msg_hash = std::hash<std::string>()(msg);
+    bool repeated = budget.last_msg.exchange(msg_hash, std::memory_order_relaxed) == msg_hash;
+    if (repeated || budget.count.fetch_add(1, std::memory_order_relaxed) >= max_per_second) {
+      budget.suppressed.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    suppressed = budget.suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+  }
+
+  void write(std::string line) {
+    if (stopped_.load(std::memory_order_acquire)) {
+      std::cerr << line << std::flush;
+      return;
+    }
+    if (!queue_.push(std::move(line))) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    // Only an idle writer needs to be woken up, a busy one drains the queue before it waits again
+    if (pushed_.fetch_add(1, std::memory_order_acq_rel) == written_.load(std::memory_order_acquire)) {
+      wake_.notify_one();
+    }
+  }
+
+  void flush() {
+    if (stopped_.load(std::memory_order_acquire)) {
+      return;
+    }
+    auto target = pushed_.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(mu_);
+    wake_.notify_one();
+    drained_.wait(lock, [&] { return written_.load(std::memory_order_acquire) >= target || stopped_.load(); });
+  }
+
+ private:
+  static constexpr size_t kCapacity = 4096;
+  static constexpr size_t kNumBudgets = 256;
+
+  struct Budget {
+    std::atomic<int64_t> window = {0};
+    std::atomic<uint32_t> count = {0};
+    std::atomic<uint32_t> suppressed = {0};
+    std::atomic<size_t> last_msg = {0};
+  };
+
+  AsyncSink() : queue_(kCapacity), budgets_(kNumBudgets), thread_([this] { run(); }) {}
+
+  void run() {
+    std::string line;
+    while (true) {
+      while (queue_.pop(line)) {
+        std::cerr << line;
+        written_.fetch_add(1, std::memory_order_acq_rel);
+      }
+      if (auto dropped = dropped_.exchange(0, std::memory_order_relaxed)) {
+        std::cerr << "WARNING: [Torch-TensorRT] - " << dropped << " log messages were dropped, the log queue was full"
+                  << std::endl;
+      }
+      std::cerr << std::flush;
+      std::unique_lock<std::mutex> lock(mu_);
+      drained_.notify_all();
+      if (stopping_) {
+        return;
+      }
+      // Bounded so that a wake up missed between the check of a writer and this wait only delays its line
+      wake_.wait_for(lock, std::chrono::milliseconds(50), [&] {
+        return stopping_ || pushed_.load(std::memory_order_acquire) != written_.load(std::memory_order_acquire);
+      });
+    }
+  }
+
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    stopped_.store(true, std::memory_order_release);
+    drained_.notify_all();
+  }
+
+  LineQueue queue_;
+  std::vector<Budget> budgets_;
+  std::atomic<size_t> pushed_ = {0};
+  std::atomic<size_t> written_ = {0};
+  std::atomic<size_t> dropped_ = {0};
+  std::atomic<bool> stopped_ = {false};
+  std::mutex mu_;
+  std::condition_variable wake_;
+  std::condition_variable drained_;
+  bool stopping_ = false;
+  std::thread thread_;
+};
+
+} // namespace
+
 TorchTRTLogger::TorchTRTLogger(std::string prefix, Severity severity, bool color)
     : prefix_(prefix), reportable_severity_((LogLevel)severity), color_(color) {}
 
 TorchTRTLogger::TorchTRTLogger(std::string prefix, LogLevel lvl, bool color)
     : prefix_(prefix), reportable_severity_(lvl), color_(color) {}
 
-void TorchTRTLogger::log(LogLevel lvl, std::string msg) {
-  // suppress messages with severity enum value greater than the reportable
-  if (lvl > reportable_severity_) {
-    return;
-  }
-
+std::string TorchTRTLogger::format(LogLevel lvl, const std::string& msg) {
+  std::ostringstream ss;
   if (color_) {
     switch (lvl) {
       case LogLevel::kINTERNAL_ERROR:
-        std::cerr << TERM_RED;
+        ss << TERM_RED;
         break;
       case LogLevel::kERROR:
-        std::cerr << TERM_RED;
+        ss << TERM_RED;
         break;
       case LogLevel::kWARNING:
-        std::cerr << TERM_YELLOW;
+        ss << TERM_YELLOW;
         break;
       case LogLevel::kINFO:
-        std::cerr << TERM_GREEN;
+        ss << TERM_GREEN;
         break;
       case LogLevel::kDEBUG:
-        std::cerr << TERM_MAGENTA;
+        ss << TERM_MAGENTA;
         break;
       case LogLevel::kGRAPH:
-        std::cerr << TERM_NORMAL;
+        ss << TERM_NORMAL;
         break;
       default:
         break;
@@ -55,33 +237,66 @@ void TorchTRTLogger::log(LogLevel lvl, std::string msg) {
 
   switch (lvl) {
     case LogLevel::kINTERNAL_ERROR:
-      std::cerr << "INTERNAL_ERROR: ";
+      ss << "INTERNAL_ERROR: ";
       break;
     case LogLevel::kERROR:
-      std::cerr << "ERROR: ";
+      ss << "ERROR: ";
       break;
     case LogLevel::kWARNING:
-      std::cerr << "WARNING: ";
+      ss << "WARNING: ";
       break;
     case LogLevel::kINFO:
-      std::cerr << "INFO: ";
+      ss << "INFO: ";
       break;
     case LogLevel::kDEBUG:
-      std::cerr << "DEBUG: ";
+      ss << "DEBUG: ";
       break;
     case LogLevel::kGRAPH:
-      std::cerr << "GRAPH: ";
+      ss << "GRAPH: ";
       break;
     default:
-      std::cerr << "UNKNOWN: ";
+      ss << "UNKNOWN: ";
       break;
   }
 
   if (color_) {
-    std::cerr << TERM_NORMAL;
+    ss << TERM_NORMAL;
+  }
+
+  ss << prefix_ << msg << std::endl;
+  return ss.str();
+}
+
+void TorchTRTLogger::log(LogLevel lvl, std::string msg) {
+  log(lvl, std::move(msg), nullptr);
+}
+
+void TorchTRTLogger::log(LogLevel lvl, std::string msg, const char* site) {
+  // suppress messages with severity enum value greater than the reportable
+  if (lvl > reportable_severity_) {
+    return;
+  }
+
+  if (!async_) {
+    // Written as one line so that messages of concurrent threads do not interleave
+    std::cerr << format(lvl, msg) << std::flush;
+    return;
   }
 
-  std::cerr << prefix_ << msg << std::endl;
+  auto& sink = AsyncSink::get();
+  if (lvl <= LogLevel::kERROR) {
+    sink.flush();
+    std::cerr << format(lvl, msg) << std::flush;
+    return;
+  }
+  uint32_t suppressed = 0;
+  if (site && max_messages_per_second_ > 0 && !sink.admit(site, msg, max_messages_per_second_, suppressed)) {
+    return;
+  }
+  if (suppressed > 0) {
+    msg += " (" + std::to_string(suppressed) + " more messages from here were suppressed)";
+  }
+  sink.write(format(lvl, msg));
 }
 
 void TorchTRTLogger::log(Severity severity, const char* msg) noexcept {
@@ -121,6 +336,31 @@ bool TorchTRTLogger::get_is_colored_output_on() {
   return color_;
 }
 
+void TorchTRTLogger::set_is_async_output_on(bool async_output_on) {
+  if (async_ && !async_output_on) {
+    flush();
+  }
+  async_ = async_output_on;
+}
+
+bool TorchTRTLogger::get_is_async_output_on() {
+  return async_;
+}
+
+void TorchTRTLogger::set_max_messages_per_second(uint32_t max_messages_per_second) {
+  max_messages_per_second_ = max_messages_per_second;
+}
+
+uint32_t TorchTRTLogger::get_max_messages_per_second() {
+  return max_messages_per_second_;
+}
+
+void TorchTRTLogger::flush() {
+  if (async_) {
+    AsyncSink::get().flush();
+  }
+}
+
 namespace {
 
 TorchTRTLogger& get_global_logger() {
@@ -132,10 +372,24 @@ TorchTRTLogger& get_global_logger() {
   return global_logger;
 }
 
+thread_local TorchTRTLogger* thread_logger = nullptr;
+
 } // namespace
 
 TorchTRTLogger& get_logger() {
-  return get_global_logger();
+  return thread_logger ? *thread_logger : get_global_logger();
+}
+
+ScopedLogger::ScopedLogger() : owned_(std::make_unique<TorchTRTLogger>(get_logger())), previous_(thread_logger) {
+  thread_logger = owned_.get();
+}
+
+ScopedLogger::ScopedLogger(TorchTRTLogger& logger) : previous_(thread_logger) {
+  thread_logger = &logger;
+}
+
+ScopedLogger::~ScopedLogger() {
+  thread_logger = previous_;
 }
 
 } // namespace logging
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include "NvInfer.h"
 
@@ -24,23 +26,61 @@ class TorchTRTLogger : public nvinfer1::ILogger {
   TorchTRTLogger(std::string prefix = "[Torch-TensorRT] - ", LogLevel lvl = LogLevel::kWARNING, bool color = true);
   void log(Severity severity, const char* msg) noexcept override;
   void log(LogLevel lvl, std::string msg);
+  // site identifies the call site of the message (a string literal), repeated messages of a site are rate limited
+  // when async output is on
+  void log(LogLevel lvl, std::string msg, const char* site);
   void set_logging_prefix(std::string prefix);
   void set_reportable_severity(Severity severity);
   void set_reportable_log_level(LogLevel severity);
   void set_is_colored_output_on(bool colored_output_on);
+  // Hand messages to a background thread writing them to stderr instead of writing them on the logging thread. Errors
+  // are still written right away, after the queued messages
+  void set_is_async_output_on(bool async_output_on);
+  // Messages of one call site written per second when async output is on, repeats of the previous message of the site
+  // within the second are dropped as well. 0 writes every message
+  void set_max_messages_per_second(uint32_t max_messages_per_second);
   std::string get_logging_prefix();
   Severity get_reportable_severity();
   LogLevel get_reportable_log_level();
   bool get_is_colored_output_on();
+  bool get_is_async_output_on();
+  uint32_t get_max_messages_per_second();
+  // Blocks until the messages queued for async output are written
+  void flush();
+  // Whether messages of level lvl are reported, the logging macros check it before formatting their message
+  bool is_enabled(LogLevel lvl) const {
+    return lvl <= reportable_severity_;
+  }
 
  private:
+  std::string format(LogLevel lvl, const std::string& msg);
+
   std::string prefix_;
   LogLevel reportable_severity_;
   bool color_;
+  bool async_ = false;
+  uint32_t max_messages_per_second_ = 10;
 };
 
+// The logger of the current thread: the one of the innermost ScopedLogger of the thread, else the global logger
 TorchTRTLogger& get_logger();
 
+// Makes get_logger() return another logger on this thread while the scope lives. By default the scope gets its own
+// copy of the current logger, so a compilation keeps the level and prefix it started with while other threads change
+// the global logger or compile with other settings. Threads started by a compilation enter a scope of its logger
+class ScopedLogger {
+ public:
+  ScopedLogger();
+  explicit ScopedLogger(TorchTRTLogger& logger);
+  ScopedLogger(const ScopedLogger&) = delete;
+  ScopedLogger& operator=(const ScopedLogger&) = delete;
+  ~ScopedLogger();
+
+ private:
+  std::unique_ptr<TorchTRTLogger> owned_;
+  TorchTRTLogger* previous_;
+};
+
 } // namespace logging
 } // namespace util
 } // namespace core
@@ -9,11 +9,19 @@
 #define DLA_LOCAL_DRAM_SIZE 1073741824
 #define DLA_GLOBAL_DRAM_SIZE 536870912
 
-#define TORCHTRT_LOG(l, sev, msg) \
-  do {                            \
-    std::stringstream ss{};       \
-    ss << msg;                    \
-    l.log(sev, ss.str());         \
+#define TORCHTRT_STRINGIFY_(x) #x
+#define TORCHTRT_STRINGIFY(x) TORCHTRT_STRINGIFY_(x)
+
+// The message is only formatted if the logger reports sev, so arguments like node_info(n) or graph dumps cost nothing
+// when they are filtered out. The call site lets the logger rate limit messages repeated on a hot path
+#define TORCHTRT_LOG(l, sev, msg)                                                     \
+  do {                                                                                \
+    auto& _torchtrt_logger = l;                                                       \
+    if (_torchtrt_logger.is_enabled(sev)) {                                           \
+      std::stringstream ss{};                                                         \
+      ss << msg;                                                                      \
+      _torchtrt_logger.log(sev, ss.str(), __FILE__ ":" TORCHTRT_STRINGIFY(__LINE__)); \
+    }                                                                                 \
   } while (0)
 
 #define LOG_GRAPH_GLOBAL(s) \
@@ -0,0 +1,51 @@
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#include "torch/csrc/profiler/stubs/base.h"
+
+#include "core/util/nvtx.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace util {
+
+namespace {
+bool nvtx_enabled_from_env() {
+  const char* env = std::getenv("TORCHTRT_NVTX");
+  return env != nullptr && std::strcmp(env, "0") != 0;
+}
+
+std::atomic<bool>& nvtx_flag() {
+  static std::atomic<bool> flag(nvtx_enabled_from_env());
+  return flag;
+}
+} // namespace
+
+bool nvtx_enabled() {
+  return nvtx_flag().load(std::memory_order_relaxed);
+}
+
+void set_nvtx_enabled(bool enabled) {
+  nvtx_flag().store(enabled, std::memory_order_relaxed);
+}
+
+NVTXRange::NVTXRange(const char* name) {
+  if (nvtx_enabled()) {
+    auto stubs = torch::profiler::impl::cudaStubs();
+    if (stubs->enabled()) {
+      stubs->rangePush(name);
+      active = true;
+    }
+  }
+}
+
+NVTXRange::~NVTXRange() {
+  if (active) {
+    torch::profiler::impl::cudaStubs()->rangePop();
+  }
+}
+
+} // namespace util
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+
+namespace torch_tensorrt {
+namespace core {
+namespace util {
+
+// NVTX ranges around compiler and runtime phases so they show up in Nsight Systems timelines. Ranges are emitted
+// through PyTorch's CUDA profiler stubs and are off by default, when disabled a range costs a single relaxed load
+bool nvtx_enabled();
+void set_nvtx_enabled(bool enabled);
+
+class NVTXRange {
+ public:
+  explicit NVTXRange(const char* name);
+  explicit NVTXRange(const std::string& name) : NVTXRange(name.c_str()) {}
+  NVTXRange(const NVTXRange&) = delete;
+  NVTXRange& operator=(const NVTXRange&) = delete;
+  ~NVTXRange();
+
+ private:
+  bool active = false;
+};
+
+} // namespace util
+} // namespace core
+} // namespace torch_tensorrt
+
+#define TORCHTRT_NVTX_CONCAT_IMPL(a, b) a##b
+#define TORCHTRT_NVTX_CONCAT(a, b) TORCHTRT_NVTX_CONCAT_IMPL(a, b)
+// Opens a range which is closed at the end of the enclosing scope
+#define TORCHTRT_NVTX_RANGE(name) \
+  torch_tensorrt::core::util::NVTXRange TORCHTRT_NVTX_CONCAT(_torchtrt_nvtx_range_, __LINE__)(name)
@@ -5,7 +5,10 @@
 #include <cstdint>
 #include "core/util/Exception.h"
 #include "core/util/build_info.h"
+#include "core/util/compile_profile.h"
+#include "core/util/gpu_allocator.h"
 #include "core/util/jit_util.h"
 #include "core/util/logging/TorchTRTLogger.h"
 #include "core/util/macros.h"
+#include "core/util/nvtx.h"
 #include "core/util/trt_util.h"
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cctype>
+
 #include "core/util/trt_util.h"
 #include "core/util/logging/TorchTRTLogger.h"
 #include "core/util/macros.h"
@@ -296,7 +299,8 @@ const std::unordered_map<at::ScalarType, nvinfer1::DataType>& get_at_trt_type_ma
       {at::kChar, nvinfer1::DataType::kINT8},
       {at::kByte, nvinfer1::DataType::kINT8},
       {at::kBool, nvinfer1::DataType::kBOOL},
-      {at::kBFloat16, nvinfer1::DataType::kBF16}};
+      {at::kBFloat16, nvinfer1::DataType::kBF16},
+      {at::kFloat8_e4m3fn, nvinfer1::DataType::kFP8}};
   return at_trt_type_map;
 }
 
@@ -307,8 +311,10 @@ const std::unordered_map<nvinfer1::DataType, at::ScalarType>& get_trt_at_type_ma
       {nvinfer1::DataType::kINT32, at::kInt},
       {nvinfer1::DataType::kINT64, at::kLong},
       {nvinfer1::DataType::kINT8, at::kChar},
+      {nvinfer1::DataType::kUINT8, at::kByte},
       {nvinfer1::DataType::kBOOL, at::kBool},
-      {nvinfer1::DataType::kBF16, at::kBFloat16}};
+      {nvinfer1::DataType::kBF16, at::kBFloat16},
+      {nvinfer1::DataType::kFP8, at::kFloat8_e4m3fn}};
   return trt_at_type_map;
 }
 } // namespace
@@ -397,6 +403,113 @@ torch::jit::Node* cloneNode(
   return new_node;
 }
 
+SerializedEngine::SerializedEngine(std::shared_ptr<nvinfer1::IHostMemory> memory) {
+  if (memory) {
+    bytes = static_cast<const char*>(memory->data());
+    nbytes = memory->size();
+    owner = std::move(memory);
+  }
+}
+
+SerializedEngine::SerializedEngine(std::string bytes) {
+  auto str = std::make_shared<const std::string>(std::move(bytes));
+  this->bytes = str->data();
+  nbytes = str->size();
+  owner = std::move(str);
+}
+
+SerializedEngine::SerializedEngine(std::shared_ptr<const void> owner, const char* bytes, size_t nbytes)
+    : owner(std::move(owner)), bytes(bytes), nbytes(nbytes) {}
+
+const char* SerializedEngine::data() const {
+  return bytes;
+}
+
+size_t SerializedEngine::size() const {
+  return nbytes;
+}
+
+bool SerializedEngine::empty() const {
+  return nbytes == 0;
+}
+
+std::string_view SerializedEngine::view() const {
+  return std::string_view(bytes, nbytes);
+}
+
+std::string SerializedEngine::str() const {
+  return std::string(bytes, nbytes);
+}
+
+bool SerializedEngine::operator==(const SerializedEngine& other) const {
+  return view() == other.view();
+}
+
+bool SerializedEngine::operator!=(const SerializedEngine& other) const {
+  return !(*this == other);
+}
+
+std::string OutputAliasName(bool of_input, size_t index) {
+  return OUTPUT_ALIAS_PREFIX + (of_input ? "input_" : "output_") + std::to_string(index);
+}
+
+bool ParseOutputAliasName(const std::string& name, bool& of_input, size_t& index) {
+  if (name.rfind(OUTPUT_ALIAS_PREFIX, 0) != 0) {
+    return false;
+  }
+  auto target = name.substr(OUTPUT_ALIAS_PREFIX.size());
+  of_input = target.rfind("input_", 0) == 0;
+  auto digits = target.substr(target.find('_') + 1);
+  TORCHTRT_CHECK(
+      (of_input || target.rfind("output_", 0) == 0) && !digits.empty() &&
+          std::all_of(digits.begin(), digits.end(), ::isdigit),
+      "Invalid output alias " << name);
+  index = std::stoull(digits);
+  return true;
+}
+
+SerializedEngine AddOutputAliases(
+    const SerializedEngine& plan,
+    const std::vector<std::string>& input_names,
+    const std::vector<std::string>& output_names) {
+  std::string serialized = OUTPUT_ALIASES_MAGIC;
+  for (const auto* names : {&input_names, &output_names}) {
+    for (size_t i = 0; i < names->size(); i++) {
+      serialized += (i == 0 ? "" : std::string(1, OUTPUT_ALIASES_DELIM)) + (*names)[i];
+    }
+    serialized += '\n';
+  }
+  serialized.append(plan.data(), plan.size());
+  return SerializedEngine(std::move(serialized));
+}
+
+bool SplitOutputAliases(
+    std::string_view serialized,
+    std::vector<std::string>& input_names,
+    std::vector<std::string>& output_names,
+    std::string_view& plan) {
+  if (serialized.substr(0, OUTPUT_ALIASES_MAGIC.size()) != OUTPUT_ALIASES_MAGIC) {
+    return false;
+  }
+  auto rest = serialized.substr(OUTPUT_ALIASES_MAGIC.size());
+  std::vector<std::string> lists[2];
+  for (auto& list : lists) {
+    auto end = rest.find('\n');
+    TORCHTRT_CHECK(end != std::string_view::npos, "Malformed output aliases of a serialized engine");
+    auto line = rest.substr(0, end);
+    while (!line.empty()) {
+      auto delim = std::min(line.find(OUTPUT_ALIASES_DELIM), line.size());
+      list.emplace_back(line.substr(0, delim));
+      line = line.substr(std::min(delim + 1, line.size()));
+    }
+    rest = rest.substr(end + 1);
+  }
+  input_names = std::move(lists[0]);
+  output_names = std::move(lists[1]);
+  plan = rest;
+  return true;
+}
+
 } // namespace util
 } // namespace core
 } // namespace torch_tensorrt
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <memory>
+#include <string>
+#include <string_view>
+
 #include "ATen/Tensor.h"
 #include "ATen/core/List.h"
 #include "NvInfer.h"
@@ -38,6 +42,12 @@ inline std::ostream& operator<<(std::ostream& os, const nvinfer1::TensorFormat&
       return os << "NCHW\\Contiguous\\Linear";
     case nvinfer1::TensorFormat::kHWC:
       return os << "NHWC\\Channel Last";
+    case nvinfer1::TensorFormat::kHWC8:
+      return os << "NHWC8\\Channel Last Padded to 8";
+    case nvinfer1::TensorFormat::kHWC16:
+      return os << "NHWC16\\Channel Last Padded to 16";
+    case nvinfer1::TensorFormat::kDHWC8:
+      return os << "NDHWC8\\Channel Last 3D Padded to 8";
     default:
       return os << "Unknown Tensor Format";
   }
@@ -59,6 +69,12 @@ inline std::ostream& operator<<(std::ostream& stream, const nvinfer1::DataType&
       return stream << "BFloat16";
     case nvinfer1::DataType::kBOOL:
       return stream << "Bool";
+    case nvinfer1::DataType::kFP8:
+      return stream << "FP8";
+#if NV_TENSORRT_MAJOR >= 10
+    case nvinfer1::DataType::kINT4:
+      return stream << "Int4";
+#endif
     default:
       return stream << "Unknown Data Type";
   }
@@ -165,6 +181,57 @@ torch::jit::Node* cloneNode(
     std::unordered_map<torch::jit::Value*, torch::jit::Value*>& old_to_new);
 const std::unordered_map<at::ScalarType, nvinfer1::DataType>& get_aten_trt_type_map();
 
+// Immutable, reference counted bytes of a serialized engine. Copies share one buffer, which is either the IHostMemory
+// the builder returned or a string the engine was read into, so plans of several GB are not copied on their way from
+// the builder through engine caches into TRTEngines and the saved module
+class SerializedEngine {
+ public:
+  SerializedEngine() = default;
+  explicit SerializedEngine(std::shared_ptr<nvinfer1::IHostMemory> memory);
+  // Takes ownership of the bytes, e.g. an engine read from a file or decoded from a saved module
+  SerializedEngine(std::string bytes);
+  // Aliases nbytes at bytes, which stay alive as long as owner does (e.g. a pinned host tensor)
+  SerializedEngine(std::shared_ptr<const void> owner, const char* bytes, size_t nbytes);
+
+  const char* data() const;
+  size_t size() const;
+  bool empty() const;
+  std::string_view view() const;
+  // Copies the bytes, only for APIs which hand out engines as strings
+  std::string str() const;
+
+  bool operator==(const SerializedEngine& other) const;
+  bool operator!=(const SerializedEngine& other) const;
+
+ private:
+  std::shared_ptr<const void> owner;
+  const char* bytes = nullptr;
+  size_t nbytes = 0;
+};
+
+// Plans of engines which return some of their outputs as an alias of one of their inputs or of an earlier output,
+// instead of binding them, are built behind OUTPUT_ALIASES_MAGIC, followed by the binding names of the inputs and the
+// names of the outputs the engine returns (a binding name or an OutputAliasName), each list ended by '\n'
+const std::string OUTPUT_ALIASES_MAGIC = "TORCHTRT_OUTPUT_ALIASES_1\n";
+const std::string OUTPUT_ALIAS_PREFIX = "alias_of:";
+const char OUTPUT_ALIASES_DELIM = '%';
+
+// Name of a returned output which aliases the input (of_input) or the earlier returned output at index
+std::string OutputAliasName(bool of_input, size_t index);
+// Whether name is an OutputAliasName, in which case of_input and index are set to what it aliases
+bool ParseOutputAliasName(const std::string& name, bool& of_input, size_t& index);
+SerializedEngine AddOutputAliases(
+    const SerializedEngine& plan,
+    const std::vector<std::string>& input_names,
+    const std::vector<std::string>& output_names);
+// Splits the lists of AddOutputAliases off serialized and points plan at the plan behind them, returns false (leaving
+// everything untouched) for plans without them
+bool SplitOutputAliases(
+    std::string_view serialized,
+    std::vector<std::string>& input_names,
+    std::vector<std::string>& output_names,
+    std::string_view& plan);
+
 } // namespace util
 } // namespace core
 } // namespace torch_tensorrt
@@ -6,17 +6,60 @@
 namespace torchtrtc {
 namespace accuracy {
 
-bool check_rtol(const at::Tensor& diff, const std::vector<at::Tensor> inputs, float threshold) {
-  double maxValue = 0.0;
-  for (auto& tensor : inputs) {
-    maxValue = fmax(tensor.abs().max().item<float>(), maxValue);
+std::vector<OutputError> compare_outputs(
+    const std::vector<at::Tensor>& computed_tensors,
+    const std::vector<at::Tensor>& gt_tensors,
+    float atol,
+    float rtol) {
+  TORCH_CHECK(
+      computed_tensors.size() == gt_tensors.size(),
+      "Got ",
+      computed_tensors.size(),
+      " computed tensors for ",
+      gt_tensors.size(),
+      " ground truth tensors");
+  if (gt_tensors.empty()) {
+    return {};
   }
-  torchtrt::logging::log(
-      torchtrt::logging::Level::kDEBUG,
-      std::string("Max Difference: ") + std::to_string(diff.abs().max().item<float>()));
-  torchtrt::logging::log(
-      torchtrt::logging::Level::kDEBUG, std::string("Acceptable Threshold: ") + std::to_string(threshold));
-  return diff.abs().max().item<float>() <= threshold * maxValue;
+
+  // Per output {max abs error, threshold, num over threshold, max rel error}, left on the device
+  std::vector<at::Tensor> stats;
+  for (size_t i = 0; i < gt_tensors.size(); i++) {
+    const auto& gt = gt_tensors[i];
+    auto computed = computed_tensors[i].reshape_as(gt);
+    if (gt.numel() == 0) {
+      stats.push_back(at::zeros({4}, gt.options().dtype(at::kDouble)));
+      continue;
+    }
+    auto type = at::promote_types(computed.scalar_type(), gt.scalar_type());
+    if (!at::isFloatingType(type)) {
+      type = at::kFloat;
+    }
+    // The only temporaries as large as the outputs are the difference and the mask of elements over the threshold
+    auto diff = at::sub(computed.to(type), gt.to(type)).abs_();
+    auto gt_min_max = at::aminmax(gt);
+    auto gt_abs_max = at::maximum(std::get<1>(gt_min_max), std::get<0>(gt_min_max).neg()).to(at::kDouble);
+    auto threshold = gt_abs_max.mul(rtol).add_(atol);
+    auto max_abs = diff.max().to(at::kDouble);
+    auto num_over = diff.gt(threshold).sum().to(at::kDouble);
+    // |diff| / |gt| in place, elements with a zero ground truth are left out
+    auto max_rel = at::nan_to_num_(diff.div_(gt).abs_(), 0, 0).max().to(at::kDouble);
+    stats.push_back(at::stack({max_abs, threshold, num_over, max_rel}));
+  }
+
+  auto host_stats = at::stack(stats).cpu();
+  auto s = host_stats.accessor<double, 2>();
+  std::vector<OutputError> errors;
+  for (size_t i = 0; i < gt_tensors.size(); i++) {
+    OutputError e;
+    e.max_abs_error = s[i][0];
+    e.threshold = s[i][1];
+    e.num_over_threshold = static_cast<int64_t>(s[i][2]);
+    e.max_rel_error = s[i][3];
+    e.numel = gt_tensors[i].numel();
+    errors.push_back(e);
+  }
+  return errors;
 }
 
 bool almost_equal(
@@ -24,18 +67,12 @@ bool almost_equal(
     const at::Tensor& gt_tensor, // gt_tensor : Ground Truth Tensor
     float atol,
     float rtol) {
-  auto computed_tensor_float = computed_tensor.toType(at::kFloat);
-  auto gt_tensor_float = gt_tensor.toType(at::kFloat);
-
-  auto diff = computed_tensor_float - gt_tensor_float;
-  auto result = diff.abs().max().item<float>();
-  auto threshold = atol + (rtol * gt_tensor.abs().max().item<float>());
-
-  torchtrt::logging::log(torchtrt::logging::Level::kDEBUG, std::string("Max Difference: ") + std::to_string(result));
+  auto error = compare_outputs({computed_tensor}, {gt_tensor}, atol, rtol)[0];
   torchtrt::logging::log(
-      torchtrt::logging::Level::kDEBUG, std::string("Acceptable Threshold: ") + std::to_string(threshold));
-
-  return result <= threshold;
+      torchtrt::logging::Level::kDEBUG, std::string("Max Difference: ") + std::to_string(error.max_abs_error));
+  torchtrt::logging::log(
+      torchtrt::logging::Level::kDEBUG, std::string("Acceptable Threshold: ") + std::to_string(error.threshold));
+  return error.within_tolerance();
 }
 
 } // namespace accuracy
@@ -11,7 +11,29 @@
 namespace torchtrtc {
 namespace accuracy {
 
-bool check_rtol(const at::Tensor& diff, const std::vector<at::Tensor> inputs, float threshold);
+// Error of one computed output against its ground truth. Elements are over the threshold if their absolute error
+// exceeds atol + rtol * max(|ground truth|), the output is within tolerance if none are
+struct OutputError {
+  double max_abs_error = 0;
+  // Over the elements whose ground truth is non zero
+  double max_rel_error = 0;
+  double threshold = 0;
+  int64_t num_over_threshold = 0;
+  int64_t numel = 0;
+
+  bool within_tolerance() const {
+    return num_over_threshold == 0;
+  }
+};
+
+// Compares every computed tensor with the ground truth tensor of the same index on the device the tensors live on,
+// without converting them to float32 unless they are not floating point, and copies all the statistics to the host at
+// once. Computed tensors are reshaped to their ground truth
+std::vector<OutputError> compare_outputs(
+    const std::vector<at::Tensor>& computed_tensors,
+    const std::vector<at::Tensor>& gt_tensors,
+    float atol = 1e-8,
+    float rtol = 1e-5);
 bool almost_equal(const at::Tensor& computed_tensor, const at::Tensor& gt_tensor, float atol = 1e-8, float rtol = 1e-5);
 
 } // namespace accuracy
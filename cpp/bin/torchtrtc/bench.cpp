@@ -0,0 +1,332 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "ATen/cuda/CUDAEvent.h"
+#include "c10/cuda/CUDACachingAllocator.h"
+#include "c10/cuda/CUDAGuard.h"
+#include "c10/cuda/CUDAStream.h"
+#include "cuda_runtime_api.h"
+#include "third_party/args/args.hpp"
+#include "torch/script.h"
+
+#include "torch_tensorrt/logging.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#include "bench.h"
+#include "fileio.h"
+#include "luts.h"
+#include "parser_util.h"
+
+namespace torchtrtc {
+namespace bench {
+namespace {
+
+struct Options {
+  int64_t warmup_iters = 20;
+  int64_t iters = 100;
+  double duration_s = 0; // 0: run iters iterations
+  int64_t threads = 1;
+  int64_t streams = 0; // 0: one per thread
+};
+
+struct Results {
+  int64_t threads = 0;
+  int64_t streams = 0;
+  int64_t batch_size = 1;
+  std::vector<float> latencies_ms; // Sorted
+  double wall_time_s = 0;
+  int64_t peak_allocated_bytes = 0;
+  int64_t peak_reserved_bytes = 0;
+  int64_t device_used_bytes = 0;
+  std::vector<torchtrt::ts::EngineRuntimeMetrics> engines;
+
+  // Nearest rank
+  float percentile(double p) const {
+    auto rank = static_cast<size_t>(std::ceil(p / 100.0 * latencies_ms.size()));
+    return latencies_ms[std::max<size_t>(rank, 1) - 1];
+  }
+  float mean() const {
+    double total = 0;
+    for (auto l : latencies_ms) {
+      total += l;
+    }
+    return static_cast<float>(total / latencies_ms.size());
+  }
+  double throughput() const {
+    return latencies_ms.size() / wall_time_s;
+  }
+};
+
+// Runs fn(t) on threads threads and waits for them, rethrowing the first error
+void on_threads(int64_t threads, const std::function<void(int64_t)>& fn) {
+  std::vector<std::exception_ptr> errors(threads);
+  std::vector<std::thread> pool;
+  for (int64_t t = 0; t < threads; t++) {
+    pool.emplace_back([&, t]() {
+      try {
+        fn(t);
+      } catch (...) {
+        errors[t] = std::current_exception();
+      }
+    });
+  }
+  for (auto& thread : pool) {
+    thread.join();
+  }
+  for (auto& e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+}
+
+Results run_benchmark(torch::jit::Module& mod, const std::vector<torchtrt::Input>& specs, const Options& opts) {
+  auto device = c10::cuda::current_device();
+  std::vector<std::vector<torch::jit::IValue>> thread_inputs(opts.threads);
+  for (auto& inputs : thread_inputs) {
+    for (const auto& spec : specs) {
+      auto in = at::randn(spec.opt_shape, {at::kCUDA}).to(torchtrtc::luts::to_torch_dtype(spec.dtype));
+      inputs.push_back(in);
+    }
+  }
+  int64_t num_streams = opts.streams > 0 ? opts.streams : opts.threads;
+  std::vector<c10::cuda::CUDAStream> streams;
+  for (int64_t s = 0; s < num_streams; s++) {
+    streams.push_back(c10::cuda::getStreamFromPool(false, device));
+  }
+
+  Results results;
+  results.threads = opts.threads;
+  results.streams = num_streams;
+  if (!specs.empty() && !specs[0].opt_shape.empty()) {
+    results.batch_size = specs[0].opt_shape[0];
+  }
+
+  on_threads(opts.threads, [&](int64_t t) {
+    torch::NoGradGuard no_grad;
+    c10::cuda::CUDAStreamGuard stream_guard(streams[t % num_streams]);
+    for (int64_t i = 0; i < opts.warmup_iters; i++) {
+      mod.forward(thread_inputs[t]);
+    }
+  });
+  cudaDeviceSynchronize();
+  // Only the timed iterations are kept in the metrics of the engines and the memory peaks
+  torchtrt::ts::reset_runtime_metrics(mod);
+  c10::cuda::CUDACachingAllocator::resetPeakStats(device);
+
+  std::vector<std::vector<float>> thread_latencies(opts.threads);
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                              std::chrono::duration<double>(opts.duration_s));
+  on_threads(opts.threads, [&](int64_t t) {
+    torch::NoGradGuard no_grad;
+    auto stream = streams[t % num_streams];
+    c10::cuda::CUDAStreamGuard stream_guard(stream);
+    at::cuda::CUDAEvent begin(cudaEventDefault), end(cudaEventDefault);
+    for (int64_t i = 0; opts.duration_s > 0 ? std::chrono::steady_clock::now() < deadline : i < opts.iters; i++) {
+      begin.record(stream);
+      mod.forward(thread_inputs[t]);
+      end.record(stream);
+      end.synchronize();
+      thread_latencies[t].push_back(begin.elapsed_time(end));
+    }
+  });
+  results.wall_time_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  for (auto& l : thread_latencies) {
+    results.latencies_ms.insert(results.latencies_ms.end(), l.begin(), l.end());
+  }
+  std::sort(results.latencies_ms.begin(), results.latencies_ms.end());
+
+  auto stats = c10::cuda::CUDACachingAllocator::getDeviceStats(device);
+  auto aggregate = static_cast<size_t>(c10::CachingAllocator::StatType::AGGREGATE);
+  results.peak_allocated_bytes = stats.allocated_bytes[aggregate].peak;
+  results.peak_reserved_bytes = stats.reserved_bytes[aggregate].peak;
+  size_t free_bytes = 0, total_bytes = 0;
+  if (cudaMemGetInfo(&free_bytes, &total_bytes) == cudaSuccess) {
+    results.device_used_bytes = static_cast<int64_t>(total_bytes - free_bytes);
+  }
+  results.engines = torchtrt::ts::get_runtime_metrics(mod);
+  return results;
+}
+
+std::string to_text(const Results& r) {
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3);
+  ss << "Iterations: " << r.latencies_ms.size() << " on " << r.threads << " threads and " << r.streams << " streams in "
+     << r.wall_time_s << " s" << std::endl;
+  ss << "Latency (ms): mean " << r.mean() << ", min " << r.latencies_ms.front() << ", p50 " << r.percentile(50)
+     << ", p90 " << r.percentile(90) << ", p99 " << r.percentile(99) << ", max " << r.latencies_ms.back()
+     << std::endl;
+  ss << "Throughput: " << r.throughput() << " iterations/s, " << r.throughput() * r.batch_size << " samples/s"
+     << std::endl;
+  ss << "GPU memory (bytes): peak allocated " << r.peak_allocated_bytes << ", peak reserved " << r.peak_reserved_bytes
+     << ", device used " << r.device_used_bytes << std::endl;
+  for (const auto& e : r.engines) {
+    ss << "Engine " << e.name << ":";
+    for (const auto& c : e.counters) {
+      ss << " " << c.first << "=" << c.second;
+    }
+    ss << std::endl;
+  }
+  return ss.str();
+}
+
+std::string to_json(const Results& r) {
+  std::stringstream ss;
+  ss << "{\n  \"iterations\": " << r.latencies_ms.size() << ", \"threads\": " << r.threads
+     << ", \"streams\": " << r.streams << ", \"batch_size\": " << r.batch_size
+     << ", \"wall_time_s\": " << r.wall_time_s << ",\n";
+  ss << "  \"latency_ms\": {\"mean\": " << r.mean() << ", \"min\": " << r.latencies_ms.front()
+     << ", \"p50\": " << r.percentile(50) << ", \"p90\": " << r.percentile(90) << ", \"p99\": " << r.percentile(99)
+     << ", \"max\": " << r.latencies_ms.back() << "},\n";
+  ss << "  \"throughput\": {\"iterations_per_s\": " << r.throughput()
+     << ", \"samples_per_s\": " << r.throughput() * r.batch_size << "},\n";
+  ss << "  \"gpu_memory_bytes\": {\"peak_allocated\": " << r.peak_allocated_bytes
+     << ", \"peak_reserved\": " << r.peak_reserved_bytes << ", \"device_used\": " << r.device_used_bytes << "},\n";
+  ss << "  \"engines\": [";
+  for (size_t i = 0; i < r.engines.size(); i++) {
+    const auto& e = r.engines[i];
+    ss << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << e.name << "\", \"counters\": {";
+    bool first = true;
+    for (const auto& c : e.counters) {
+      ss << (first ? "" : ", ") << "\"" << c.first << "\": " << c.second;
+      first = false;
+    }
+    ss << "}, \"latency_histograms\": {";
+    first = true;
+    for (const auto& h : e.latency_histograms) {
+      ss << (first ? "" : ", ") << "\"" << h.first << "\": [";
+      for (size_t b = 0; b < h.second.size(); b++) {
+        ss << (b == 0 ? "" : ", ") << h.second[b];
+      }
+      ss << "]";
+      first = false;
+    }
+    ss << "}}";
+  }
+  ss << "\n  ]\n}\n";
+  return ss.str();
+}
+
+} // namespace
+
+int run(int argc, char** argv) {
+  args::ArgumentParser parser(
+      "torchtrtc bench measures the latency and throughput of a compiled TorchScript module, timing every iteration with CUDA events",
+      "");
+  parser.Prog("torchtrtc bench");
+  args::HelpFlag help(parser, "help", "Display this help menu", {'h', "help"});
+  args::Flag verbose(
+      parser, "verbose", "Dumps debugging information about the runtime onto the console", {'v', "verbose"});
+  args::ValueFlag<int64_t> warmup_iters(
+      parser, "iters", "Untimed iterations run on every thread first (default 20)", {"warmup-iters"});
+  args::ValueFlag<int64_t> iters(parser, "iters", "Timed iterations run on every thread (default 100)", {"iters"});
+  args::ValueFlag<double> duration(
+      parser, "seconds", "Run timed iterations on every thread for this long instead of a fixed count", {"duration"});
+  args::ValueFlag<int64_t> threads(
+      parser, "num_threads", "Threads running the module concurrently (default 1)", {"threads"});
+  args::ValueFlag<int64_t> streams(
+      parser,
+      "num_streams",
+      "CUDA streams the threads are spread across round robin (default one per thread)",
+      {"streams"});
+  args::ValueFlag<int> gpu_id(parser, "gpu_id", "GPU the module runs on (default 0)", {"gpu-id"});
+  args::ValueFlag<std::string> json_report(
+      parser, "json_report_path", "Also write the results as JSON to this file", {"json-report"});
+  args::ValueFlag<double> max_p99_ms(
+      parser, "ms", "Exit with an error if the p99 latency exceeds this many milliseconds", {"max-p99-ms"});
+  args::Positional<std::string> module_path(
+      parser, "module_file_path", "Path to a compiled TorchScript module", args::Options::Required);
+  args::PositionalList<std::string> input_shapes(
+      parser,
+      "input_specs",
+      "Specs of the inputs the module is run with, in the format of the input specs of torchtrtc. Dynamic inputs run at their optimal shape");
+
+  try {
+    parser.ParseCLI(argc, argv);
+  } catch (args::Help const&) {
+    std::cout << parser;
+    return 0;
+  } catch (args::Error const& e) {
+    torchtrt::logging::log(torchtrt::logging::Level::kERROR, e.what());
+    std::cerr << std::endl << parser;
+    return 1;
+  }
+
+  if (verbose) {
+    torchtrt::logging::set_reportable_log_level(torchtrt::logging::Level::kDEBUG);
+  }
+
+  Options opts;
+  if (warmup_iters) {
+    opts.warmup_iters = args::get(warmup_iters);
+  }
+  if (iters) {
+    opts.iters = args::get(iters);
+  }
+  if (duration) {
+    opts.duration_s = args::get(duration);
+  }
+  if (threads) {
+    opts.threads = args::get(threads);
+  }
+  if (streams) {
+    opts.streams = args::get(streams);
+  }
+  if (opts.warmup_iters < 0 || opts.iters <= 0 || opts.duration_s < 0 || opts.threads <= 0 || opts.streams < 0) {
+    torchtrt::logging::log(
+        torchtrt::logging::Level::kERROR,
+        "Iteration counts, duration, threads and streams must be positive (warmup iterations may be 0)");
+    return 1;
+  }
+
+  if (gpu_id) {
+    torchtrt::set_device(args::get(gpu_id));
+  }
+
+  std::vector<torchtrt::Input> specs;
+  for (const auto& spec : args::get(input_shapes)) {
+    specs.push_back(torchtrtc::parserutil::parse_input(spec));
+  }
+
+  torch::jit::Module mod;
+  try {
+    mod = torchtrt::ts::load(torchtrtc::fileio::resolve_path(args::get(module_path)));
+  } catch (const c10::Error& e) {
+    torchtrt::logging::log(torchtrt::logging::Level::kERROR, "Error loading the module (path may be incorrect)");
+    return 1;
+  }
+  mod.eval();
+
+  auto results = run_benchmark(mod, specs, opts);
+  if (results.latencies_ms.empty()) {
+    torchtrt::logging::log(torchtrt::logging::Level::kERROR, "No timed iteration completed");
+    return 1;
+  }
+  std::cout << to_text(results);
+  if (json_report) {
+    std::ofstream out(torchtrtc::fileio::resolve_path(args::get(json_report)));
+    out << to_json(results);
+  }
+
+  if (max_p99_ms && results.percentile(99) > args::get(max_p99_ms)) {
+    std::stringstream ss;
+    ss << "p99 latency " << results.percentile(99) << " ms exceeds the limit of " << args::get(max_p99_ms) << " ms";
+    torchtrt::logging::log(torchtrt::logging::Level::kERROR, ss.str());
+    return 1;
+  }
+  return 0;
+}
+
+} // namespace bench
+} // namespace torchtrtc
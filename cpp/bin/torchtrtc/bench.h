@@ -0,0 +1,11 @@
+#pragma once
+
+namespace torchtrtc {
+namespace bench {
+
+// Entry point of `torchtrtc bench`, argv[0] being "bench". Loads a compiled module and measures its latency and
+// throughput, returns the exit code of torchtrtc
+int run(int argc, char** argv);
+
+} // namespace bench
+} // namespace torchtrtc
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "third_party/args/args.hpp"
+#include "torch/script.h"
+
+#include "torch_tensorrt/logging.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#include "bundle.h"
+#include "fileio.h"
+
+namespace torchtrtc {
+namespace bundle {
+
+int run(int argc, char** argv) {
+  args::ArgumentParser parser(
+      "torchtrtc bundle merges TorchScript modules compiled from the same program for different GPUs into one module which loads the engines built for the GPU it runs on",
+      "");
+  parser.Prog("torchtrtc bundle");
+  args::HelpFlag help(parser, "help", "Display this help menu", {'h', "help"});
+  args::Flag verbose(
+      parser, "verbose", "Dumps debugging information about the bundled engines onto the console", {'v', "verbose"});
+  args::Positional<std::string> output_path(
+      parser, "output_file_path", "Path to save the bundled module to", args::Options::Required);
+  args::PositionalList<std::string> module_paths(
+      parser,
+      "module_file_paths",
+      "Paths of the compiled modules to bundle, compiled with the same settings each for another GPU",
+      args::Options::Required);
+
+  try {
+    parser.ParseCLI(argc, argv);
+  } catch (args::Help const&) {
+    std::cout << parser;
+    return 0;
+  } catch (args::Error const& e) {
+    torchtrt::logging::log(torchtrt::logging::Level::kERROR, e.what());
+    std::cerr << std::endl << parser;
+    return 1;
+  }
+
+  if (verbose) {
+    torchtrt::logging::set_reportable_log_level(torchtrt::logging::Level::kDEBUG);
+  }
+
+  std::vector<std::string> paths;
+  for (const auto& path : args::get(module_paths)) {
+    paths.push_back(torchtrtc::fileio::resolve_path(path));
+  }
+
+  try {
+    auto mod = torchtrt::ts::bundle_engines(paths);
+    mod.save(torchtrtc::fileio::resolve_path(args::get(output_path)));
+  } catch (const c10::Error& e) {
+    torchtrt::logging::log(torchtrt::logging::Level::kERROR, e.what_without_backtrace());
+    return 1;
+  }
+  return 0;
+}
+
+} // namespace bundle
+} // namespace torchtrtc
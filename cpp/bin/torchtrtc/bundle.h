@@ -0,0 +1,11 @@
+#pragma once
+
+namespace torchtrtc {
+namespace bundle {
+
+// Entry point of `torchtrtc bundle`, argv[0] being "bundle". Merges modules compiled for different GPUs into one
+// module, returns the exit code of torchtrtc
+int run(int argc, char** argv);
+
+} // namespace bundle
+} // namespace torchtrtc
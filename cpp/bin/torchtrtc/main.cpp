@@ -4,6 +4,7 @@
 
 #include "NvInfer.h"
 #include "third_party/args/args.hpp"
+#include "torch/cuda.h"
 #include "torch/script.h"
 
 #include "torch_tensorrt/logging.h"
@@ -11,9 +12,12 @@
 #include "torch_tensorrt/torch_tensorrt.h"
 
 #include "accuracy.h"
+#include "bench.h"
+#include "bundle.h"
 #include "fileio.h"
 #include "luts.h"
 #include "parser_util.h"
+#include "precision_search.h"
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -42,11 +46,50 @@ bool unload_library(void* custom_lib) {
   return success;
 }
 
+// Each file is one batch, a tensor or a list of tensors saved with torch.save. Without files, one batch of random
+// inputs at the opt shapes
+std::vector<std::vector<torch::jit::IValue>> load_input_batches(
+    const std::vector<std::string>& paths,
+    const std::vector<torchtrt::Input>& ranges) {
+  std::vector<std::vector<torch::jit::IValue>> batches;
+  for (const auto& path : paths) {
+    auto buf = torchtrtc::fileio::read_buf(torchtrtc::fileio::resolve_path(path));
+    auto value = torch::pickle_load(std::vector<char>(buf.begin(), buf.end()));
+    std::vector<torch::jit::IValue> batch;
+    if (value.isTensor()) {
+      batch.push_back(value.toTensor().to(at::kCUDA));
+    } else {
+      for (const auto& t : value.isTuple() ? value.toTuple()->elements().vec() : value.toList().vec()) {
+        batch.push_back(t.toTensor().to(at::kCUDA));
+      }
+    }
+    batches.push_back(std::move(batch));
+  }
+  if (batches.empty()) {
+    torchtrt::logging::log(
+        torchtrt::logging::Level::kWARNING,
+        "No --validation-inputs given, using random inputs which may not be realistic");
+    std::vector<torch::jit::IValue> batch;
+    for (auto i : ranges) {
+      batch.push_back(at::randn(i.opt_shape, {at::kCUDA}).to(torchtrtc::luts::to_torch_dtype(i.dtype)));
+    }
+    batches.push_back(std::move(batch));
+  }
+  return batches;
+}
+
 int main(int argc, char** argv) {
   torchtrt::logging::set_is_colored_output_on(true);
   torchtrt::logging::set_reportable_log_level(torchtrt::logging::Level::kWARNING);
   torchtrt::logging::set_logging_prefix("");
 
+  if (argc > 1 && std::string(argv[1]) == "bench") {
+    return torchtrtc::bench::run(argc - 1, argv + 1);
+  }
+  if (argc > 1 && std::string(argv[1]) == "bundle") {
+    return torchtrtc::bundle::run(argc - 1, argv + 1);
+  }
+
   args::ArgumentParser parser(
       "torchtrtc is a compiler for TorchScript, it will compile and optimize TorchScript programs to run on NVIDIA GPUs using TensorRT",
       "");
@@ -64,6 +107,11 @@ int main(int argc, char** argv) {
 
   args::Flag build_debuggable_engine(
       parser, "build-debuggable-engine", "Creates a debuggable engine", {"build-debuggable-engine"});
+  args::Flag detailed_layer_info(
+      parser,
+      "detailed-layer-info",
+      "Record the type, formats, tactic and source node of every layer in the engines",
+      {"detailed-layer-info"});
 
   args::Flag allow_gpu_fallback(
       parser,
@@ -89,10 +137,40 @@ int main(int argc, char** argv) {
   args::Flag sparse_weights(
       parser, "sparse-weights", "Enable sparsity for weights of conv and FC layers", {"sparse-weights"});
 
+  args::Flag prune_2_4(
+      parser,
+      "prune-2-4",
+      "Prune the weights of Conv and Linear modules to 2:4 structured sparsity by magnitude before compiling",
+      {"prune-2-4"});
+
+  args::ValueFlag<std::string> sparsity_report(
+      parser,
+      "sparsity_report",
+      "Write the 2:4 sparsity of every conv and FC weight, and with --sparse-weights the engine layers that run sparse tactics, to this JSON file",
+      {"sparsity-report"});
+
+  args::Flag strongly_typed(
+      parser,
+      "strongly-typed",
+      "Build strongly typed networks, running each layer in the type of its inputs in the graph instead of choosing among the enabled precisions",
+      {"strongly-typed"});
+
+  args::Flag weight_streaming(
+      parser,
+      "weight-streaming",
+      "Build engines whose weights can be streamed from host memory within a device memory budget set at runtime (requires --strongly-typed)",
+      {"weight-streaming"});
+
+  args::Flag strip_engine_weights(
+      parser,
+      "strip-engine-weights",
+      "Save the engines without their weights, the loaded module runs once refit with the weights of the input module (requires TensorRT 10)",
+      {"strip-engine-weights"});
+
   args::ValueFlagList<std::string> enabled_precisions(
       parser,
       "precision",
-      "(Repeatable) Enabling an operating precision for kernels to use when building the engine (Int8 requires a calibration-cache argument) [ float | float32 | f32 | fp32 | half | float16 | f16 | fp16 | int8 | i8 | char ] (default: float)",
+      "(Repeatable) Enabling an operating precision for kernels to use when building the engine (Int8 requires a calibration-cache argument) [ float | float32 | f32 | fp32 | half | float16 | f16 | fp16 | bfloat16 | bf16 | int8 | i8 | char ] (default: float)",
       {'p', "enable-precision"});
   args::ValueFlag<std::string> device_type(
       parser,
@@ -134,6 +212,96 @@ int main(int argc, char** argv) {
       "Minimum number of contiguous TensorRT supported ops to compile a subgraph to TensorRT",
       {"mbs", "min-block-size"});
 
+  args::ValueFlag<uint64_t> loop_unroll_max_trip_count(
+      parser,
+      "num_iterations",
+      "Unroll loops with a constant trip count of at most this many iterations whose body fully converts to TensorRT (default: 16, 0 disables unrolling)",
+      {"loop-unroll-max-trip-count"});
+
+  args::ValueFlag<uint64_t> loop_unroll_max_body_size(
+      parser,
+      "num_nodes",
+      "Maximum number of nodes in the body of an unrolled loop (default: 32)",
+      {"loop-unroll-max-body-size"});
+
+  args::Flag cost_model_partitioning(
+      parser,
+      "cost-model-partitioning",
+      "Compile a subgraph to TensorRT only if its estimated latency savings exceed the cost of its Torch <-> TensorRT boundaries, instead of using min-block-size",
+      {"cost-model-partitioning"});
+
+  args::Flag symbolic_shape_analysis(
+      parser,
+      "symbolic-shape-analysis",
+      "Infer the input shapes of subgraphs from operator shape functions, running only the PyTorch subgraphs they cannot resolve",
+      {"symbolic-shape-analysis"});
+
+  args::ValueFlag<uint64_t> num_shape_analysis_workers(
+      parser,
+      "num_workers",
+      "Number of independent subgraphs run concurrently during shape analysis (0 uses one per CPU thread, defaults to 1)",
+      {"num-shape-analysis-workers"});
+
+  args::Flag merge_non_tensor_boundaries(
+      parser,
+      "merge-non-tensor-boundaries",
+      "Recompute non-tensor values in the TensorRT subgraphs consuming them and merge the TensorRT subgraphs around PyTorch subgraphs they do not depend on",
+      {"merge-non-tensor-boundaries"});
+
+  args::Flag bridge_unsupported_ops(
+      parser,
+      "bridge-unsupported-ops",
+      "Run a single unsupported operator between two large TensorRT subgraphs inside the engine with the TorchOp plugin instead of splitting the graph around it (static shapes only)",
+      {"bridge-unsupported-ops"});
+
+  args::ValueFlag<uint64_t> concurrent_segment_streams(
+      parser,
+      "num_streams",
+      "Number of CUDA streams the TensorRT subgraphs of a partially compiled module are spread over so that independent subgraphs run concurrently (defaults to 0, run in order)",
+      {"concurrent-segment-streams"});
+
+  args::Flag overlap_torch_segments(
+      parser,
+      "overlap-torch-segments",
+      "Let PyTorch subgraphs run while TensorRT subgraphs they do not depend on are executing on other streams",
+      {"overlap-torch-segments"});
+
+  args::Flag share_segment_weights(
+      parser,
+      "share-segment-weights",
+      "Bind large weights read by several TensorRT subgraphs, such as tied embeddings, from one device copy instead of building them into each engine",
+      {"share-segment-weights"});
+
+  args::Flag fuse_torch_segments(
+      parser,
+      "fuse-torch-segments",
+      "Compile PyTorch subgraphs supported by the TorchScript tensor expression fuser into one kernel each, specialized for the opt input shapes",
+      {"fuse-torch-segments"});
+
+  args::Flag background_build(
+      parser,
+      "background-build",
+      "Build the TensorRT engines of a partially compiled module in the background, running its TensorRT subgraphs in PyTorch until their engines are ready",
+      {"background-build"});
+
+  args::Flag plan_segment_activations(
+      parser,
+      "plan-segment-activations",
+      "Place the tensors TensorRT subgraphs only pass to each other in one preallocated arena",
+      {"plan-segment-activations"});
+
+  args::Flag low_memory(
+      parser,
+      "low-memory",
+      "Build TensorRT subgraphs one at a time and release the weights of each once its engine is built",
+      {"low-memory"});
+
+  args::ValueFlag<std::string> partitioning_report(
+      parser,
+      "file_path",
+      "Write a JSON report of the subgraphs, their boundary tensors and why each node runs in PyTorch to this file",
+      {"partitioning-report"});
+
   args::Flag embed_engine(
       parser,
       "embed-engine",
@@ -142,8 +310,120 @@ int main(int argc, char** argv) {
 
   args::ValueFlag<uint64_t> num_avg_timing_iters(
       parser, "num_iters", "Number of averaging timing iterations used to select kernels", {"num-avg-timing-iters"});
+  args::Flag fast_build(
+      parser,
+      "fast-build",
+      "Build engines as fast as possible at the cost of runtime performance, for development and experiments",
+      {"fast-build"});
+  args::ValueFlag<int64_t> max_aux_streams(
+      parser,
+      "num_streams",
+      "Maximum number of auxiliary streams TensorRT may run independent branches of an engine on (default: chosen by TensorRT)",
+      {"max-aux-streams"});
+  args::Flag version_compatible(
+      parser,
+      "version-compatible",
+      "Build engines which later TensorRT versions can run through the lean runtime embedded in them",
+      {"version-compatible"});
+  args::Flag exclude_lean_runtime(
+      parser,
+      "exclude-lean-runtime",
+      "Leave the lean runtime out of version compatible engines, the runtime has to load a lean runtime library to run them",
+      {"exclude-lean-runtime"});
+  args::ValueFlag<std::string> timing_cache_path(
+      parser,
+      "timing_cache_path",
+      "TensorRT timing cache file, loaded before and updated after building to speed up later compilations",
+      {"timing-cache-path"});
+  args::ValueFlag<std::string> record_tactics(
+      parser,
+      "tactic_file",
+      "Record the tactics TensorRT chooses for every layer to a file, to replay them in later builds",
+      {"record-tactics"});
+  args::ValueFlag<std::string> replay_tactics(
+      parser,
+      "tactic_file",
+      "Restrict every layer to the tactic recorded for it in a file, reproducing the recorded engines",
+      {"replay-tactics"});
+  args::ValueFlag<std::string> engine_cache_dir(
+      parser,
+      "engine_cache_dir",
+      "Directory of a cache of built engines, TensorRT segments which are already cached are not rebuilt",
+      {"engine-cache-dir"});
+  args::ValueFlag<uint64_t> engine_cache_size(
+      parser, "engine_cache_size", "Maximum size of the engine cache in bytes (default 5GB)", {"engine-cache-size"});
+  args::ValueFlag<uint64_t> num_build_workers(
+      parser,
+      "num_workers",
+      "Number of TensorRT segments built concurrently (0 uses one per CPU thread, defaults to 1)",
+      {"num-build-workers"});
+  args::ValueFlagList<int64_t> build_gpu_ids(
+      parser,
+      "gpu_id",
+      "(Repeatable) GPU to spread engine builds across, must be the same model as the target GPU",
+      {"build-gpu-id"});
+  args::ValueFlag<std::string> batch_manifest(
+      parser,
+      "manifest_path",
+      "Compile every variant listed in the manifest from one load of the input file, sharing lowering and the timing cache, one variant per line: the output path, optional precision=<p> tokens overriding the enabled precisions, then the input specs. Variants are built concurrently on the build GPUs (default: every visible GPU)",
+      {"batch-manifest"});
+  args::ValueFlagList<std::string> segment_devices(
+      parser,
+      "device",
+      "(Repeatable) Device the next TensorRT segment is built for [ gpu | gpu:<id> | dla:<core> ], later segments use the target device",
+      {"segment-device"});
+  args::ValueFlagList<std::string> output_formats(
+      parser,
+      "format",
+      "(Repeatable) Format of the next output of the module [ linear | nchw | contiguous | nhwc | channels_last | hwc8 | hwc16 | dhwc8 ]",
+      {"output-format"});
+  args::ValueFlag<std::string> segment_boundary_format(
+      parser,
+      "format",
+      "Format of the tensors TensorRT segments pass to each other, e.g. hwc8 for FP16 convolutional networks",
+      {"segment-boundary-format"});
+  args::ValueFlag<std::string> compile_report(
+      parser,
+      "compile_report",
+      "Write the wall time and peak host/GPU memory of every compilation phase and segment to this JSON file",
+      {"compile-report"});
+  args::ValueFlag<std::string> lint_report(
+      parser,
+      "lint_report",
+      "Profile the compiled module once and write the reformats, FP32 layers, unfused elementwise chains, host shape computations and plugins of its engines, with their source nodes, to this JSON file",
+      {"lint-report"});
+  args::Flag precision_search(
+      parser,
+      "precision-search",
+      "Compile with the fastest enabled precisions and promote the fewest layers (leaf modules with parameters) to FP32 needed for the outputs to stay within --atol / --rtol of the TorchScript module on the validation inputs",
+      {"precision-search"});
+  args::ValueFlagList<std::string> validation_inputs(
+      parser,
+      "path",
+      "(Repeatable) Batch of inputs to check the accuracy of --precision-search on or to benchmark --autotune on, a tensor or a list of tensors saved with torch.save (default: one batch of random inputs at the opt shapes)",
+      {"validation-inputs"});
+  args::Flag autotune(
+      parser,
+      "autotune",
+      "Compile with each combination of a few min block sizes (and without and with truncating 64 bit types if --truncate-long-double is not given), benchmark each with and without CUDA graphs and pre-allocated outputs on the validation inputs and save the fastest",
+      {"autotune"});
+  args::ValueFlagList<uint64_t> autotune_min_block_sizes(
+      parser,
+      "size",
+      "(Repeatable) Min block size tried by --autotune (default: 1, 3 and 8)",
+      {"autotune-min-block-size"});
+  args::ValueFlag<std::string> autotune_report(
+      parser,
+      "autotune_report",
+      "Write the settings, build time and latency of every configuration tried by --autotune to this JSON file",
+      {"autotune-report"});
   args::ValueFlag<uint64_t> workspace_size(
       parser, "workspace_size", "Maximum size of workspace given to TensorRT", {"workspace-size"});
+  args::ValueFlag<uint64_t> device_memory_budget(
+      parser,
+      "device_memory_budget",
+      "Device memory all TensorRT engines of the module may use together for their activations and scratch, split across the segments of a partially compiled module in proportion to their activations",
+      {"device-memory-budget"});
   args::ValueFlag<uint64_t> dla_sram_size(parser, "dla_sram_size", "DLA managed SRAM size", {"dla-sram-size"});
   args::ValueFlag<uint64_t> dla_local_dram_size(
       parser, "dla_local_dram_size", "DLA Local DRAM size", {"dla-local-dram-size"});
@@ -179,6 +459,11 @@ int main(int argc, char** argv) {
       "save_engine",
       "Instead of compiling a full a TorchScript program, save the created engine to the path specified as the output path",
       {"save-engine"});
+  args::Flag dry_run(
+      parser,
+      "dry_run",
+      "Stop after lowering and partitioning without building any engine, print the segments with their node counts, estimated FLOPs, boundary bytes and engine weight sizes and the unsupported ops, and write them as JSON to the output path",
+      {"dry-run"});
   args::ValueFlagList<std::string> custom_torch_ops(
       parser,
       "custom-torch-ops",
@@ -318,6 +603,10 @@ int main(int argc, char** argv) {
     compile_settings.debug = true;
   }
 
+  if (detailed_layer_info || lint_report) {
+    compile_settings.detailed_layer_info = true;
+  }
+
   if (allow_gpu_fallback) {
     compile_settings.device.allow_gpu_fallback = true;
   }
@@ -330,6 +619,18 @@ int main(int argc, char** argv) {
     compile_settings.sparse_weights = true;
   }
 
+  if (strongly_typed) {
+    compile_settings.strongly_typed = true;
+  }
+
+  if (weight_streaming) {
+    compile_settings.weight_streaming = true;
+  }
+
+  if (strip_engine_weights) {
+    compile_settings.strip_engine_weights = true;
+  }
+
   std::string calibration_cache_file_path = "";
   if (calibration_cache_file) {
     calibration_cache_file_path = torchtrtc::fileio::resolve_path(args::get(calibration_cache_file));
@@ -338,6 +639,31 @@ int main(int argc, char** argv) {
   auto calibrator = torchtrt::ptq::make_int8_cache_calibrator(calibration_cache_file_path);
 
   compile_settings.require_full_compilation = require_full_compilation;
+  compile_settings.cost_model_partitioning = cost_model_partitioning;
+  compile_settings.symbolic_shape_analysis = symbolic_shape_analysis;
+  compile_settings.merge_non_tensor_boundaries = merge_non_tensor_boundaries;
+  compile_settings.bridge_unsupported_ops = bridge_unsupported_ops;
+  if (num_shape_analysis_workers) {
+    compile_settings.num_shape_analysis_workers = args::get(num_shape_analysis_workers);
+  }
+  if (concurrent_segment_streams) {
+    compile_settings.concurrent_segment_streams = args::get(concurrent_segment_streams);
+  }
+  compile_settings.overlap_torch_segments = overlap_torch_segments;
+  compile_settings.share_segment_weights = share_segment_weights;
+  compile_settings.fuse_torch_segments = fuse_torch_segments;
+  compile_settings.background_build = background_build;
+  compile_settings.plan_segment_activations = plan_segment_activations;
+  compile_settings.low_memory = low_memory;
+  if (loop_unroll_max_trip_count) {
+    compile_settings.loop_unroll_max_trip_count = args::get(loop_unroll_max_trip_count);
+  }
+  if (loop_unroll_max_body_size) {
+    compile_settings.loop_unroll_max_body_size = args::get(loop_unroll_max_body_size);
+  }
+  if (partitioning_report) {
+    compile_settings.partitioning_report_path = torchtrtc::fileio::resolve_path(args::get(partitioning_report));
+  }
 
   if (torch_executed_ops || torch_executed_mods) {
     if (require_full_compilation) {
@@ -365,6 +691,8 @@ int main(int argc, char** argv) {
         compile_settings.enabled_precisions.insert(torch::kF32);
       } else if (dtype == torchtrt::DataType::kHalf) {
         compile_settings.enabled_precisions.insert(torch::kF16);
+      } else if (dtype == torchtrt::DataType::kBFloat16) {
+        compile_settings.enabled_precisions.insert(torch::kBFloat16);
       } else if (dtype == torchtrt::DataType::kChar) {
         compile_settings.enabled_precisions.insert(torch::kI8);
         if (calibration_cache_file) {
@@ -376,7 +704,7 @@ int main(int argc, char** argv) {
         }
       } else {
         std::stringstream ss;
-        ss << "Invalid precision given for enabled kernel precision, options are [ float | float32 | f32 | fp32 | half | float16 | f16 | fp16 | char | int8 | i8 ], found: ";
+        ss << "Invalid precision given for enabled kernel precision, options are [ float | float32 | f32 | fp32 | half | float16 | f16 | fp16 | bfloat16 | bf16 | char | int8 | i8 ], found: ";
         ss << dtype;
         torchtrt::logging::log(torchtrt::logging::Level::kERROR, ss.str());
         std::cerr << std::endl << parser;
@@ -441,10 +769,94 @@ int main(int argc, char** argv) {
     compile_settings.num_avg_timing_iters = args::get(num_avg_timing_iters);
   }
 
+  if (fast_build) {
+    compile_settings.fast_build = true;
+  }
+
+  if (max_aux_streams) {
+    compile_settings.max_aux_streams = args::get(max_aux_streams);
+  }
+
+  if (version_compatible) {
+    compile_settings.version_compatible = true;
+  }
+
+  if (exclude_lean_runtime) {
+    compile_settings.exclude_lean_runtime = true;
+  }
+
+  if (timing_cache_path) {
+    compile_settings.timing_cache_path = args::get(timing_cache_path);
+  }
+
+  if (record_tactics) {
+    compile_settings.tactic_record_path = args::get(record_tactics);
+  }
+
+  if (replay_tactics) {
+    compile_settings.tactic_replay_path = args::get(replay_tactics);
+  }
+
+  if (engine_cache_dir) {
+    compile_settings.engine_cache_dir = args::get(engine_cache_dir);
+  }
+
+  if (engine_cache_size) {
+    compile_settings.engine_cache_size = args::get(engine_cache_size);
+  }
+
+  if (num_build_workers) {
+    compile_settings.num_build_workers = args::get(num_build_workers);
+  }
+
+  for (const auto id : args::get(build_gpu_ids)) {
+    compile_settings.build_gpu_ids.push_back(id);
+  }
+
+  for (auto d : args::get(segment_devices)) {
+    std::transform(d.begin(), d.end(), d.begin(), [](unsigned char c) { return std::tolower(c); });
+    auto device = compile_settings.device;
+    if (d == "gpu") {
+      device.device_type = torchtrt::Device::DeviceType::kGPU;
+    } else if (d.rfind("gpu:", 0) == 0 && d.size() > 4 && std::all_of(d.begin() + 4, d.end(), ::isdigit)) {
+      device.device_type = torchtrt::Device::DeviceType::kGPU;
+      device.gpu_id = std::stoi(d.substr(4));
+    } else if (d.rfind("dla:", 0) == 0 && d.size() > 4 && std::all_of(d.begin() + 4, d.end(), ::isdigit)) {
+      device.device_type = torchtrt::Device::DeviceType::kDLA;
+      device.dla_core = std::stoi(d.substr(4));
+    } else {
+      torchtrt::logging::log(
+          torchtrt::logging::Level::kERROR, "Invalid segment device, options are [ gpu | gpu:<id> | dla:<core> ] found: " + d);
+      std::cerr << std::endl << parser;
+      return 1;
+    }
+    compile_settings.segment_devices.push_back(device);
+  }
+
+  for (const auto& f : args::get(output_formats)) {
+    auto format = torchtrtc::parserutil::parse_tensor_format(f);
+    if (format == torchtrt::TensorFormat::kUnknown) {
+      return 1;
+    }
+    compile_settings.output_formats.push_back(format);
+  }
+
+  if (segment_boundary_format) {
+    auto format = torchtrtc::parserutil::parse_tensor_format(args::get(segment_boundary_format));
+    if (format == torchtrt::TensorFormat::kUnknown) {
+      return 1;
+    }
+    compile_settings.segment_boundary_format = format;
+  }
+
   if (workspace_size) {
     compile_settings.workspace_size = args::get(workspace_size);
   }
 
+  if (device_memory_budget) {
+    compile_settings.device_memory_budget = args::get(device_memory_budget);
+  }
+
   if (truncate_long_and_double) {
     compile_settings.truncate_long_and_double = true;
   }
@@ -462,6 +874,28 @@ int main(int argc, char** argv) {
     return 1;
   }
 
+  if (prune_2_4) {
+    torchtrt::ts::prune_2_4(mod);
+  }
+
+  torchtrt::ts::SparsityReport sparsity;
+  if (sparsity_report) {
+    sparsity = torchtrt::ts::check_sparsity(mod, compile_settings);
+    size_t num_sparse = std::count_if(
+        sparsity.weights.begin(), sparsity.weights.end(), [](const auto& w) { return w.is_2_4_sparse; });
+    std::stringstream ss;
+    ss << num_sparse << " of " << sparsity.weights.size() << " conv and FC weights are 2:4 sparse";
+    torchtrt::logging::log(torchtrt::logging::Level::kINFO, ss.str());
+  }
+
+  if (dry_run) {
+    auto report = torchtrt::ts::dry_run(mod, compile_settings);
+    std::cout << report.to_str();
+    std::ofstream out(real_output_path);
+    out << report.to_json();
+    return 0;
+  }
+
   if (require_full_compilation) {
     if (!torchtrt::ts::check_method_operator_support(mod, "forward")) {
       torchtrt::logging::log(torchtrt::logging::Level::kERROR, "Module is not currently supported by Torch-TensorRT");
@@ -469,14 +903,146 @@ int main(int argc, char** argv) {
     }
   }
 
-  if (save_engine) {
+  if (lint_report && (batch_manifest || save_engine)) {
+    torchtrt::logging::log(
+        torchtrt::logging::Level::kWARNING, "--lint-report is only written for compiled modules, it is ignored");
+  }
+
+  if (batch_manifest) {
+    if (save_engine) {
+      torchtrt::logging::log(torchtrt::logging::Level::kERROR, "--save-engine cannot be used with --batch-manifest");
+      return 1;
+    }
+    auto manifest = torchtrtc::fileio::read_buf(torchtrtc::fileio::resolve_path(args::get(batch_manifest)));
+    auto variants = torchtrtc::parserutil::parse_batch_manifest(manifest);
+
+    // The build GPUs are where variants are built instead of where the engines of each variant are spread
+    std::vector<int64_t> gpu_ids = compile_settings.build_gpu_ids;
+    compile_settings.build_gpu_ids.clear();
+    if (gpu_ids.empty()) {
+      for (int64_t i = 0; i < static_cast<int64_t>(torch::cuda::device_count()); i++) {
+        gpu_ids.push_back(i);
+      }
+    }
+
+    std::vector<torchtrt::ts::CompileSpec> specs;
+    for (const auto& v : variants) {
+      auto spec = compile_settings;
+      spec.graph_inputs.inputs = v.inputs;
+      if (!v.precisions.empty()) {
+        spec.enabled_precisions.clear();
+      }
+      for (auto dtype : v.precisions) {
+        if (dtype != torchtrt::DataType::kFloat && dtype != torchtrt::DataType::kHalf &&
+            dtype != torchtrt::DataType::kChar) {
+          torchtrt::logging::log(
+              torchtrt::logging::Level::kERROR,
+              "Invalid precision for variant " + v.output_path + ", options are [ float | half | int8 ]");
+          return 1;
+        }
+        if (dtype == torchtrt::DataType::kChar && calibration_cache_file) {
+          spec.ptq_calibrator = calibrator;
+        }
+        spec.enabled_precisions.insert(dtype);
+      }
+      specs.push_back(spec);
+    }
+
+    std::stringstream ss;
+    ss << "Compiling " << specs.size() << " variants on " << gpu_ids.size() << " GPUs";
+    torchtrt::logging::log(torchtrt::logging::Level::kINFO, ss.str());
+    auto trt_mods = torchtrt::ts::compile_variants(mod, specs, gpu_ids);
+    for (size_t i = 0; i < trt_mods.size(); i++) {
+      trt_mods[i].save(torchtrtc::fileio::resolve_path(variants[i].output_path));
+    }
+    torchtrt::logging::log(
+        torchtrt::logging::Level::kWARNING,
+        "Threshold check skipped for batch compilation, numerical precision is not checked");
+  } else if (save_engine) {
     auto engine = torchtrt::ts::convert_method_to_trt_engine(mod, "forward", compile_settings);
     std::ofstream out(real_output_path);
     out << engine;
     out.close();
+    if (sparsity_report) {
+      std::ofstream report_out(torchtrtc::fileio::resolve_path(args::get(sparsity_report)));
+      report_out << sparsity.to_json();
+    }
     return 0;
   } else {
-    auto trt_mod = torchtrt::ts::compile(mod, compile_settings);
+    torch::jit::Module trt_mod;
+    if (precision_search) {
+      auto batches = load_input_batches(args::get(validation_inputs), ranges);
+      auto result = torchtrtc::precision_search::search(
+          mod, compile_settings, batches, atol ? args::get(atol) : 1e-8, rtol ? args::get(rtol) : 1e-5);
+      trt_mod = result.trt_mod;
+      std::stringstream ss;
+      ss << "Precision search promoted " << result.promoted.size() << " layers to FP32 in " << result.num_compiles
+         << " compilations" << (result.within_tolerance ? "" : ", the outputs are still not within tolerance") << ":";
+      for (const auto& p : result.promoted) {
+        ss << " " << p.first;
+      }
+      torchtrt::logging::log(
+          result.within_tolerance ? torchtrt::logging::Level::kINFO : torchtrt::logging::Level::kWARNING, ss.str());
+      for (const auto& p : result.promoted) {
+        compile_settings.layer_precisions[p.first] = p.second;
+      }
+    } else if (autotune) {
+      torchtrt::ts::AutotuneOptions options;
+      if (autotune_min_block_sizes) {
+        options.min_block_sizes = args::get(autotune_min_block_sizes);
+      }
+      options.tune_truncate_long_and_double = !truncate_long_and_double;
+      torchtrt::ts::AutotuneReport report;
+      trt_mod = torchtrt::ts::autotune(
+          mod, compile_settings, load_input_batches(args::get(validation_inputs), ranges), report, options);
+      const auto& best = report.candidates[report.best];
+      std::stringstream ss;
+      ss << std::boolalpha << "Fastest of " << report.candidates.size() << " configurations (" << best.p50_latency_ms
+         << " ms): min block size " << best.min_block_size << ", truncate long and double "
+         << best.truncate_long_and_double << ", CUDA graphs " << best.cudagraphs << ", pre-allocated outputs "
+         << best.pre_allocated_outputs;
+      if (best.cudagraphs || best.pre_allocated_outputs) {
+        ss << ". CUDA graphs and pre-allocated outputs are runtime settings, enable them where the module is run";
+      }
+      torchtrt::logging::log(torchtrt::logging::Level::kINFO, ss.str());
+      if (autotune_report) {
+        std::ofstream report_out(torchtrtc::fileio::resolve_path(args::get(autotune_report)));
+        report_out << report.to_json();
+      }
+      compile_settings.min_block_size = best.min_block_size;
+      compile_settings.truncate_long_and_double = best.truncate_long_and_double;
+    } else if (compile_report) {
+      torchtrt::ts::CompileReport report;
+      trt_mod = torchtrt::ts::compile(mod, compile_settings, report);
+      std::ofstream report_out(torchtrtc::fileio::resolve_path(args::get(compile_report)));
+      report_out << report.to_json();
+    } else {
+      trt_mod = torchtrt::ts::compile(mod, compile_settings);
+    }
+
+    if (sparsity_report) {
+      if (sparse_weights) {
+        torchtrt::ts::find_sparse_layers(trt_mod, sparsity);
+        std::stringstream ss;
+        ss << sparsity.sparse_engine_layers.size() << " TensorRT layers run sparse tactics";
+        torchtrt::logging::log(torchtrt::logging::Level::kINFO, ss.str());
+      }
+      std::ofstream report_out(torchtrtc::fileio::resolve_path(args::get(sparsity_report)));
+      report_out << sparsity.to_json();
+    }
+
+    if (lint_report) {
+      std::vector<at::Tensor> profile_inputs;
+      for (auto i : ranges) {
+        profile_inputs.push_back(at::randn(i.opt_shape, {at::kCUDA}).to(torchtrtc::luts::to_torch_dtype(i.dtype)));
+      }
+      auto lint = torchtrt::ts::lint_engines(trt_mod, compile_settings, profile_inputs);
+      std::stringstream ss;
+      ss << "Found " << lint.findings.size() << " performance problems in the TensorRT engines";
+      torchtrt::logging::log(torchtrt::logging::Level::kINFO, ss.str());
+      std::ofstream report_out(torchtrtc::fileio::resolve_path(args::get(lint_report)));
+      report_out << lint.to_json();
+    }
 
     if (!no_threshold_check &&
         (compile_settings.enabled_precisions.size() == 1 &&
@@ -524,19 +1090,22 @@ int main(int argc, char** argv) {
         }
       }
 
-      for (size_t i = 0; i < trt_results.size(); i++) {
-        std::ostringstream threshold_ss;
-        threshold_ss << "atol: " << atol_val << " rtol: " << rtol_val;
-        if (!torchtrtc::accuracy::almost_equal(
-                jit_results[i], trt_results[i].reshape_as(jit_results[i]), atol_val, rtol_val)) {
+      // All outputs are checked on the device, only their statistics are copied back
+      auto errors = torchtrtc::accuracy::compare_outputs(trt_results, jit_results, atol_val, rtol_val);
+      for (size_t i = 0; i < errors.size(); i++) {
+        const auto& e = errors[i];
+        std::ostringstream error_ss;
+        error_ss << "output " << i << " (atol: " << atol_val << " rtol: " << rtol_val << "): max abs error "
+                 << e.max_abs_error << ", max rel error " << e.max_rel_error << ", " << e.num_over_threshold << "/"
+                 << e.numel << " elements over the threshold " << e.threshold;
+        if (!e.within_tolerance()) {
           torchtrt::logging::log(
               torchtrt::logging::Level::kWARNING,
-              std::string("Maximum numerical deviation for output exceeds tolerance thresholds (") +
-                  threshold_ss.str() + std::string(")"));
+              std::string("Maximum numerical deviation exceeds tolerance thresholds for ") + error_ss.str());
         } else {
           torchtrt::logging::log(
               torchtrt::logging::Level::kDEBUG,
-              std::string("Maximum numerical deviation within threshold limits ") + threshold_ss.str());
+              std::string("Maximum numerical deviation within threshold limits for ") + error_ss.str());
         }
       }
     } else {
@@ -10,10 +10,17 @@ torchtrt::TensorFormat parse_tensor_format(std::string str) {
     return torchtrt::TensorFormat::kContiguous;
   } else if (str == "nhwc" || str == "hwc" || str == "channels_last") {
     return torchtrt::TensorFormat::kChannelsLast;
+  } else if (str == "hwc8") {
+    return torchtrt::TensorFormat::kHWC8;
+  } else if (str == "hwc16") {
+    return torchtrt::TensorFormat::kHWC16;
+  } else if (str == "dhwc8") {
+    return torchtrt::TensorFormat::kDHWC8;
   } else {
     torchtrt::logging::log(
         torchtrt::logging::Level::kERROR,
-        "Invalid tensor format, options are [ linear | nchw | chw | contiguous | nhwc | hwc | channels_last ], found: " +
+        "Invalid tensor format, options are [ linear | nchw | chw | contiguous | nhwc | hwc | channels_last | hwc8 | "
+        "hwc16 | dhwc8 ], found: " +
             str);
     return torchtrt::TensorFormat::kUnknown;
   }
@@ -26,6 +33,8 @@ torchtrt::DataType parse_dtype(std::string dtype_str) {
     return torchtrt::DataType::kFloat;
   } else if (dtype_str == "half" || dtype_str == "float16" || dtype_str == "f16" || dtype_str == "fp16") {
     return torchtrt::DataType::kHalf;
+  } else if (dtype_str == "bfloat16" || dtype_str == "bf16") {
+    return torchtrt::DataType::kBFloat16;
   } else if (dtype_str == "char" || dtype_str == "int8" || dtype_str == "i8") {
     return torchtrt::DataType::kChar;
   } else if (dtype_str == "int" || dtype_str == "int32" || dtype_str == "i32") {
@@ -35,7 +44,7 @@ torchtrt::DataType parse_dtype(std::string dtype_str) {
   } else {
     torchtrt::logging::log(
         torchtrt::logging::Level::kERROR,
-        "Invalid precision, options are [ float | float32 | fp32 | f32 | half | float16 | fp16 | f16 | char | int8 | i8 | int | int32 | i32 | bool | b], found: " +
+        "Invalid precision, options are [ float | float32 | fp32 | f32 | half | float16 | fp16 | f16 | bfloat16 | bf16 | char | int8 | i8 | int | int32 | i32 | bool | b], found: " +
             dtype_str);
     return torchtrt::DataType::kUnknown;
   }
@@ -186,5 +195,44 @@ torchtrt::Input parse_input(std::string spec) {
   }
 }
 
+std::vector<BatchVariant> parse_batch_manifest(std::string manifest) {
+  const std::string precision_tag = "precision=";
+  std::vector<BatchVariant> variants;
+  std::istringstream lines(manifest);
+  std::string line;
+  for (size_t line_no = 1; std::getline(lines, line); line_no++) {
+    std::istringstream tokens(line);
+    std::string token;
+    if (!(tokens >> token) || token[0] == '#') {
+      continue;
+    }
+    BatchVariant variant;
+    variant.output_path = token;
+    while (tokens >> token) {
+      if (token.rfind(precision_tag, 0) == 0) {
+        auto dtype = parse_dtype(token.substr(precision_tag.size()));
+        if (dtype == torchtrt::DataType::kUnknown) {
+          torchtrt::logging::log(
+              torchtrt::logging::Level::kERROR,
+              "Invalid precision on line " + std::to_string(line_no) + " of the batch manifest");
+          exit(1);
+        }
+        variant.precisions.push_back(dtype);
+      } else {
+        variant.inputs.push_back(parse_input(token));
+      }
+    }
+    if (variant.inputs.empty()) {
+      torchtrt::logging::log(
+          torchtrt::logging::Level::kERROR,
+          "Line " + std::to_string(line_no) + " of the batch manifest gives no input specs for " +
+              variant.output_path);
+      exit(1);
+    }
+    variants.push_back(variant);
+  }
+  return variants;
+}
+
 } // namespace parserutil
 } // namespace torchtrtc
@@ -30,5 +30,17 @@ std::vector<std::vector<int64_t>> parse_dynamic_dim(std::string shape_str);
 // String to a torchtrt::Input
 torchtrt::Input parse_input(std::string input_specs);
 
+// One module to build in a batch compilation
+struct BatchVariant {
+  std::string output_path;
+  // Empty keeps the precisions given on the command line
+  std::vector<torchtrt::DataType> precisions;
+  std::vector<torchtrt::Input> inputs;
+};
+
+// Contents of a batch manifest to the variants it lists, one per line: the output path, optional precision=<p>
+// tokens, then the input specs, separated by whitespace. Blank lines and lines starting with # are skipped
+std::vector<BatchVariant> parse_batch_manifest(std::string manifest);
+
 } // namespace parserutil
 } // namespace torchtrtc
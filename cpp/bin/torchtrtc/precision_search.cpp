@@ -0,0 +1,166 @@
+#include "precision_search.h"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+#include "torch_tensorrt/logging.h"
+
+#include "accuracy.h"
+
+namespace torchtrtc {
+namespace precision_search {
+namespace {
+std::vector<at::Tensor> to_tensors(const torch::jit::IValue& results) {
+  std::vector<at::Tensor> tensors;
+  if (results.isTensor()) {
+    tensors.push_back(results.toTensor());
+  } else {
+    for (auto r : results.toTuple()->elements()) {
+      tensors.push_back(r.toTensor());
+    }
+  }
+  return tensors;
+}
+
+struct Evaluation {
+  torch::jit::Module trt_mod;
+  // Largest ratio of the max abs error of an output to its threshold, <= 1 if within tolerance
+  double error = 0;
+  bool within_tolerance = true;
+};
+
+class Searcher {
+ public:
+  Searcher(
+      torch::jit::Module& mod,
+      const torchtrt::ts::CompileSpec& spec,
+      const std::vector<std::vector<torch::jit::IValue>>& batches,
+      float atol,
+      float rtol)
+      : mod(mod), spec(spec), batches(batches), atol(atol), rtol(rtol) {
+    mod.to(at::kCUDA);
+    for (const auto& batch : batches) {
+      reference_outputs.push_back(to_tensors(mod.forward(batch)));
+    }
+  }
+
+  Evaluation evaluate(const std::vector<std::string>& promoted) {
+    auto s = spec;
+    for (const auto& layer : promoted) {
+      s.layer_precisions[layer] = torchtrt::DataType::kFloat;
+    }
+    Evaluation eval;
+    eval.trt_mod = torchtrt::ts::compile(mod, s);
+    num_compiles++;
+    for (size_t b = 0; b < batches.size(); b++) {
+      auto outputs = to_tensors(eval.trt_mod.forward(batches[b]));
+      auto errors = accuracy::compare_outputs(outputs, reference_outputs[b], atol, rtol);
+      for (const auto& e : errors) {
+        eval.within_tolerance &= e.within_tolerance();
+        auto ratio = e.threshold > 0 ? e.max_abs_error / e.threshold
+                                     : (e.within_tolerance() ? 0 : std::numeric_limits<double>::infinity());
+        eval.error = std::max(eval.error, ratio);
+      }
+    }
+    std::stringstream ss;
+    ss << "Precision search: " << promoted.size() << " layers in FP32, error " << eval.error << " of the tolerance";
+    torchtrt::logging::log(torchtrt::logging::Level::kINFO, ss.str());
+    return eval;
+  }
+
+  int64_t num_compiles = 0;
+
+ private:
+  torch::jit::Module& mod;
+  const torchtrt::ts::CompileSpec& spec;
+  const std::vector<std::vector<torch::jit::IValue>>& batches;
+  float atol;
+  float rtol;
+  std::vector<std::vector<at::Tensor>> reference_outputs;
+};
+
+SearchResult make_result(Evaluation eval, const std::vector<std::string>& promoted, int64_t num_compiles) {
+  SearchResult result;
+  result.trt_mod = eval.trt_mod;
+  for (const auto& layer : promoted) {
+    result.promoted[layer] = torchtrt::DataType::kFloat;
+  }
+  result.within_tolerance = eval.within_tolerance;
+  result.num_compiles = num_compiles;
+  return result;
+}
+} // namespace
+
+std::vector<std::string> candidate_layers(const torch::jit::Module& mod, const torchtrt::ts::CompileSpec& spec) {
+  std::vector<std::string> layers;
+  for (const auto& sub : mod.named_modules()) {
+    if (sub.name.empty() || sub.value.named_children().size() > 0 ||
+        sub.value.named_parameters(/*recurse=*/false).size() == 0) {
+      continue;
+    }
+    if (spec.layer_precisions.find(sub.name) == spec.layer_precisions.end()) {
+      layers.push_back(sub.name);
+    }
+  }
+  return layers;
+}
+
+SearchResult search(
+    torch::jit::Module& mod,
+    const torchtrt::ts::CompileSpec& spec,
+    const std::vector<std::vector<torch::jit::IValue>>& batches,
+    float atol,
+    float rtol) {
+  Searcher searcher(mod, spec, batches, atol, rtol);
+  auto fastest = searcher.evaluate({});
+  if (fastest.within_tolerance) {
+    return make_result(fastest, {}, searcher.num_compiles);
+  }
+
+  auto candidates = candidate_layers(mod, spec);
+  if (candidates.empty()) {
+    torchtrt::logging::log(
+        torchtrt::logging::Level::kWARNING, "Precision search: the module has no layers which can be promoted");
+    return make_result(fastest, {}, searcher.num_compiles);
+  }
+  auto all_promoted = searcher.evaluate(candidates);
+  if (!all_promoted.within_tolerance) {
+    torchtrt::logging::log(
+        torchtrt::logging::Level::kWARNING,
+        "Precision search: the outputs are not within tolerance even with every layer in FP32");
+    return make_result(all_promoted, candidates, searcher.num_compiles);
+  }
+
+  // Layers whose promotion alone reduces the error the most are the most sensitive
+  std::vector<std::pair<double, std::string>> sensitivity;
+  for (const auto& layer : candidates) {
+    sensitivity.emplace_back(searcher.evaluate({layer}).error, layer);
+  }
+  std::stable_sort(sensitivity.begin(), sensitivity.end(), [](const auto& a, const auto& b) {
+    return a.first < b.first;
+  });
+  std::vector<std::string> ranked;
+  for (const auto& s : sensitivity) {
+    ranked.push_back(s.second);
+  }
+
+  // Fewest of the most sensitive layers within tolerance, assuming that promoting more layers does not add error
+  size_t lo = 1;
+  size_t hi = ranked.size();
+  auto best = all_promoted;
+  while (lo < hi) {
+    auto mid = lo + (hi - lo) / 2;
+    auto eval = searcher.evaluate({ranked.begin(), ranked.begin() + mid});
+    if (eval.within_tolerance) {
+      hi = mid;
+      best = eval;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return make_result(best, {ranked.begin(), ranked.begin() + hi}, searcher.num_compiles);
+}
+
+} // namespace precision_search
+} // namespace torchtrtc
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "torch/script.h"
+
+#include "torch_tensorrt/torch_tensorrt.h"
+
+namespace torchtrtc {
+namespace precision_search {
+
+struct SearchResult {
+  torch::jit::Module trt_mod;
+  // Layers promoted to FP32, by module path
+  std::map<std::string, torch_tensorrt::DataType> promoted;
+  // Whether every output of every batch is within tolerance, false if promoting every layer was not enough
+  bool within_tolerance = false;
+  int64_t num_compiles = 0;
+};
+
+// Leaf submodules holding parameters (convolutions, linear layers, norms...) which are not pinned to a precision yet
+std::vector<std::string> candidate_layers(const torch::jit::Module& mod, const torch_tensorrt::ts::CompileSpec& spec);
+
+// Searches for the layers to run in FP32 so the outputs of the engines built with the fastest precisions of spec stay
+// within atol / rtol (as checked by accuracy::compare_outputs) of the outputs of mod on every batch. The module is
+// first compiled as is, then every candidate layer is promoted on its own to rank the layers by how much promoting
+// them reduces the error, and the fewest of the most sensitive layers which meet the tolerance are found by bisection.
+// This takes 2 + number of candidates + log2(number of candidates) compilations
+SearchResult search(
+    torch::jit::Module& mod,
+    const torch_tensorrt::ts::CompileSpec& spec,
+    const std::vector<std::vector<torch::jit::IValue>>& batches,
+    float atol,
+    float rtol);
+
+} // namespace precision_search
+} // namespace torchtrtc
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) NVIDIA Corporation.
+ * All rights reserved.
+ *
+ * This library is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ATen/Tensor.h"
+#include "torch/csrc/jit/api/module.h"
+
+#include "torch_tensorrt/macros.h"
+
+namespace torch_tensorrt {
+namespace runtime {
+
+/**
+ * @brief Runs a compiled TorchScript module as one CUDA graph per input shape
+ *
+ * The whole forward method is captured, the TensorRT engines as well as the Torch fallback segments and the
+ * interpreter steps between them, so a partitioned module is replayed with a single graph launch. The first call with
+ * a new input shape (and dtype and device) runs the module eagerly and then captures it into a graph reading from
+ * static input buffers, later calls with the same shapes copy their inputs into these buffers and replay the graph.
+ * Engines executed inside a capture do not capture graphs of their own, regardless of the CUDA graphs mode.
+ *
+ * Everything the module computes on the host is frozen into a graph when it is captured, so the module must not
+ * branch on the values of its inputs. Graphs also reference the execution contexts of the engines as they were at
+ * capture time: call reset after changing the engines of the module (e.g. their weight streaming budget or weights),
+ * and do not execute the module outside of the wrapper concurrently with it.
+ */
+class TORCHTRT_API CudaGraphsModule {
+ public:
+  /**
+   * @brief Wrap module, which is shared with the wrapper
+   *
+   * @param module: Module compiled by Torch-TensorRT. Modules with engines whose output shapes depend on the input
+   * data cannot be captured
+   * @param max_graphs: Max number of graphs kept, least recently used graphs are dropped first. 0: no limit
+   * @param max_bytes: Max number of bytes held by the static input and output buffers of the graphs. 0: no limit
+   */
+  explicit CudaGraphsModule(torch::jit::Module module, int64_t max_graphs = 0, int64_t max_bytes = 0);
+
+  ~CudaGraphsModule();
+
+  CudaGraphsModule(const CudaGraphsModule&) = delete;
+  CudaGraphsModule& operator=(const CudaGraphsModule&) = delete;
+
+  /**
+   * @brief Run the forward method of the module on the current CUDA stream
+   *
+   * @param inputs: Inputs of forward, on the GPU
+   * @return std::vector<at::Tensor> Outputs of forward, tuples and lists flattened in order. The outputs are copies of
+   * the output buffers of the graph and stay valid after the next call
+   */
+  std::vector<at::Tensor> forward(std::vector<at::Tensor> inputs);
+
+  /**
+   * @brief Drop the captured graphs, the next call with each input shape captures it again
+   */
+  void reset();
+
+  /**
+   * @brief Number of graphs currently captured
+   */
+  int64_t get_num_graphs() const;
+
+  /**
+   * @brief Number of calls which replayed a graph and which had to capture one
+   */
+  int64_t get_num_replays() const;
+  int64_t get_num_captures() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl;
+};
+
+} // namespace runtime
+} // namespace torch_tensorrt
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) NVIDIA Corporation.
+ * All rights reserved.
+ *
+ * This library is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "c10/cuda/CUDAStream.h"
+#include "torch/csrc/jit/api/module.h"
+
+#include "torch_tensorrt/macros.h"
+
+namespace torch_tensorrt {
+namespace runtime {
+
+/**
+ * @brief Asynchronous inference on a compiled TorchScript module
+ *
+ * enqueue returns as soon as the work of a request is enqueued on a stream, its future is fulfilled once the stream
+ * reaches the end of the request. A single host thread can therefore keep many requests in flight, for instance one
+ * per stream. Completion is signaled by a host function enqueued after the request, which hands the request to a
+ * completion thread owned by the session so that tensors are never released from inside a CUDA callback.
+ *
+ * Outputs are ready to be read on any stream or from the host once the future is fulfilled.
+ */
+class TORCHTRT_API InferenceSession {
+ public:
+  /**
+   * @brief Create a session running module
+   *
+   * @param module: Module compiled by Torch-TensorRT, shared with the session
+   * @param use_caller_stream: Have the engines of module enqueue directly on the stream of each request instead of
+   * synchronizing with their own engine streams. This changes a property of the engines which is seen by other users
+   * of module
+   */
+  explicit InferenceSession(torch::jit::Module module, bool use_caller_stream = true);
+
+  /**
+   * @brief Waits for the requests still in flight
+   */
+  ~InferenceSession();
+
+  InferenceSession(const InferenceSession&) = delete;
+  InferenceSession& operator=(const InferenceSession&) = delete;
+
+  /**
+   * @brief Enqueue the forward method of the module on stream
+   *
+   * Requests enqueued on the same stream complete in order. Exceptions raised while enqueueing are returned through
+   * the future
+   *
+   * @param inputs: Inputs of forward, must not be modified until the future is fulfilled
+   * @param stream: Stream the request is enqueued on
+   * @return std::future<std::vector<at::Tensor>> Outputs of forward, tuples and lists flattened in order
+   */
+  std::future<std::vector<at::Tensor>> enqueue(std::vector<at::Tensor> inputs, c10::cuda::CUDAStream stream);
+
+  /**
+   * @brief Enqueue the forward method of the module on the current CUDA stream
+   */
+  std::future<std::vector<at::Tensor>> enqueue(std::vector<at::Tensor> inputs);
+
+  /**
+   * @brief Number of requests enqueued whose future is not fulfilled yet
+   */
+  int64_t get_num_in_flight() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl;
+};
+
+} // namespace runtime
+} // namespace torch_tensorrt
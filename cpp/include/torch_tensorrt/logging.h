@@ -7,6 +7,7 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include "torch_tensorrt/macros.h"
 
@@ -65,6 +66,47 @@ TORCHTRT_API Level get_reportable_log_level();
  */
 TORCHTRT_API bool get_is_colored_output_on();
 
+/**
+ * @brief Sets if messages are written to stderr by a background thread instead
+ * of the thread logging them, so threads logging on a hot path (e.g. runtime
+ * warnings fired on every inference) never wait on the output. While it is on,
+ * messages repeated by one call site are rate limited (see
+ * set_max_messages_per_second) and messages logged while the queue is full are
+ * dropped and counted. Errors are still written right away
+ *
+ * @param async_output_on: bool - If the output will be asynchronous or not
+ */
+TORCHTRT_API void set_is_async_output_on(bool async_output_on);
+
+/**
+ * @brief Is asynchronous output enabled?
+ *
+ * @return TORCHTRT_API get_is_async_output_on
+ */
+TORCHTRT_API bool get_is_async_output_on();
+
+/**
+ * @brief Sets how many messages one call site writes per second when
+ * asynchronous output is on. Repeats of the previous message of a site within
+ * the same second are dropped too, the next message written by the site reports
+ * how many were suppressed. 0 writes every message (default 10)
+ *
+ * @param max_messages_per_second: uint32_t - Messages per call site and second
+ */
+TORCHTRT_API void set_max_messages_per_second(uint32_t max_messages_per_second);
+
+/**
+ * @brief Get the number of messages one call site writes per second
+ *
+ * @return TORCHTRT_API get_max_messages_per_second
+ */
+TORCHTRT_API uint32_t get_max_messages_per_second();
+
+/**
+ * @brief Blocks until the messages queued for asynchronous output are written
+ */
+TORCHTRT_API void flush();
+
 /**
  * @brief Adds a message to the global log
  *
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) NVIDIA Corporation.
+ * All rights reserved.
+ *
+ * This library is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ATen/Tensor.h"
+#include "torch/csrc/jit/api/module.h"
+
+#include "torch_tensorrt/macros.h"
+
+namespace torch_tensorrt {
+namespace runtime {
+
+/**
+ * @brief Pipelines micro-batches through a compiled module whose TensorRT segments are placed on several GPUs
+ *
+ * Modules too large for one GPU are compiled with their segments spread over GPUs of the same model
+ * (CompileSpec::segment_devices), each GPU running a stage of the pipeline. forward splits its inputs along the batch
+ * dimension and issues the micro-batches one after another without waiting for them: the engines of each stage
+ * enqueue on their own GPU and the activations are copied to the next stage on a side stream, so a stage runs the
+ * next micro-batch while the later stages are still busy with the previous ones. Multi device safe mode has to be
+ * enabled for the engines to switch to the GPU of their stage.
+ */
+class TORCHTRT_API PipelineParallelModule {
+ public:
+  /**
+   * @brief Wrap module, which is shared with the wrapper
+   *
+   * @param module: Module compiled by Torch-TensorRT, with its segments placed on the GPUs of the stages
+   * @param num_micro_batches: Number of micro-batches the inputs of each call are split into, batches smaller than
+   * that are split into one micro-batch per sample
+   */
+  explicit PipelineParallelModule(torch::jit::Module module, int64_t num_micro_batches);
+
+  ~PipelineParallelModule();
+
+  PipelineParallelModule(const PipelineParallelModule&) = delete;
+  PipelineParallelModule& operator=(const PipelineParallelModule&) = delete;
+
+  /**
+   * @brief Run the forward method of the module on micro-batches of the inputs
+   *
+   * @param inputs: Inputs of forward, all batched along their first dimension
+   * @return std::vector<at::Tensor> Outputs of forward, tuples and lists flattened in order, with the outputs of the
+   * micro-batches concatenated along the first dimension on the GPU of the last stage
+   */
+  std::vector<at::Tensor> forward(std::vector<at::Tensor> inputs);
+
+  /**
+   * @brief Number of micro-batches the inputs are split into
+   */
+  int64_t get_num_micro_batches() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl;
+};
+
+} // namespace runtime
+} // namespace torch_tensorrt
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <memory>
@@ -24,7 +25,70 @@
 namespace torch_tensorrt {
 namespace ptq {
 TORCHTRT_API bool get_batch_impl(void* bindings[], const char* names[], int nbBindings, torch::Tensor& data);
+
+// Binds a batch already on the current GPU, one tensor per binding, without copying it (tensors which are not
+// contiguous are made so on the device). Waits for the work queued on the current stream so that batches computed on
+// it are complete before TensorRT reads them. Returns false if the batch does not match the bindings
+TORCHTRT_API bool bind_device_batch(
+    void* bindings[],
+    const char* names[],
+    int nbBindings,
+    std::vector<torch::Tensor>& batch);
+
+// Pulls batches from a source on a background thread and stages up to depth of them on the GPU ahead of the
+// calibrator asking for them. The host copy goes through pinned memory and a side CUDA stream
+class TORCHTRT_API BatchPrefetcher {
+ public:
+  // Called on the prefetch thread before the first batch of each pass over the data
+  using EpochStart = std::function<void()>;
+  // Called on the prefetch thread, fills the inputs of the next batch or returns false at the end of the data
+  using BatchSource = std::function<bool(std::vector<torch::Tensor>&)>;
+
+  BatchPrefetcher(EpochStart start_epoch, BatchSource next_batch, size_t depth);
+  BatchPrefetcher(const BatchPrefetcher&) = delete;
+  BatchPrefetcher& operator=(const BatchPrefetcher&) = delete;
+  ~BatchPrefetcher();
+
+  // Binds the inputs of the next staged batch, one tensor per binding, and keeps them alive until the following call.
+  // Returns false at the end of the data, the next call starts a new pass
+  bool next(void* bindings[], const char* names[], int nbBindings);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+inline std::vector<torch::Tensor> batch_inputs(const torch::Tensor& data) {
+  return {data};
+}
+
+inline std::vector<torch::Tensor> batch_inputs(const std::vector<torch::Tensor>& data) {
+  return data;
+}
+
+template <typename Data, typename Target>
+std::vector<torch::Tensor> batch_inputs(const torch::data::Example<Data, Target>& batch) {
+  return batch_inputs(batch.data);
+}
+
+// Batches of a DataLoader without a Stack transform are vectors of examples, stack each input across them
+template <typename Data, typename Target>
+std::vector<torch::Tensor> batch_inputs(const std::vector<torch::data::Example<Data, Target>>& examples) {
+  std::vector<std::vector<torch::Tensor>> per_input;
+  for (const auto& example : examples) {
+    auto inputs = batch_inputs(example.data);
+    per_input.resize(inputs.size());
+    for (size_t i = 0; i < inputs.size(); i++) {
+      per_input[i].push_back(inputs[i]);
+    }
+  }
+  std::vector<torch::Tensor> stacked;
+  for (const auto& tensors : per_input) {
+    stacked.push_back(torch::stack(tensors));
+  }
+  return stacked;
 }
+} // namespace ptq
 } // namespace torch_tensorrt
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
@@ -176,6 +240,166 @@ class Int8Calibrator : Algorithm {
   std::vector<torch::Tensor>::iterator it_;
 };
 
+/**
+ * @brief Int8Calibrator implementation based on a specified TensorRT
+ * calibration algorithm and a LibTorch DataLoader which streams the data
+ *
+ * Unlike Int8Calibrator, batches are pulled from the DataLoader as calibration
+ * runs instead of being read into host memory up front. A background thread
+ * loads the next batches, copies them through pinned memory on a side CUDA
+ * stream and keeps up to prefetch_depth of them ready on the GPU, so loading
+ * overlaps with calibration.
+ *
+ * Each batch is fed as is, so its batch dimension is the one the engine runs
+ * calibration with and has to match the input shape of the CompileSpec. The
+ * data of a batch can be a tensor or, for models with several inputs, a
+ * std::vector<torch::Tensor> holding one tensor per input in the order of the
+ * module's arguments. Batches of a DataLoader without a Stack transform are
+ * stacked per input.
+ *
+ * @tparam Algorithm: class nvinfer1::IInt8Calibrator (Default:
+ * nvinfer1::IInt8EntropyCalibrator2) - Algorithm to use
+ * @tparam DataLoaderUniquePtr: std::unique_ptr<torch::data::DataLoader> -
+ * DataLoader type
+ */
+template <typename Algorithm, typename DataLoaderUniquePtr>
+class Int8StreamingCalibrator : Algorithm {
+  using DataLoader = typename DataLoaderUniquePtr::element_type;
+  using Batch = typename DataLoader::super::BatchType;
+
+ public:
+  /**
+   * @brief Construct a new Int8StreamingCalibrator object
+   *
+   * @param dataloader: std::unqiue_ptr<torch::data::DataLoader> - A unique
+   * pointer to the DataLoader, should be what is returned from the
+   * make_data_loader factory. The calibrator takes ownership of it
+   * @param cache_file_path: const std::string& - A path to store / find the
+   * calibration cache
+   * @param use_cache : bool - Whether to use the cache (if it exists)
+   * @param prefetch_depth: size_t - Number of batches staged on the GPU ahead
+   * of the calibrator (Default: 2)
+   */
+  Int8StreamingCalibrator(
+      DataLoaderUniquePtr dataloader,
+      const std::string& cache_file_path,
+      bool use_cache,
+      size_t prefetch_depth = 2)
+      : dataloader_(std::move(dataloader)),
+        cache_file_path_(cache_file_path),
+        use_cache_(use_cache),
+        prefetcher_(
+            [this]() { it_ = std::make_unique<torch::data::Iterator<Batch>>(dataloader_->begin()); },
+            [this](std::vector<torch::Tensor>& inputs) {
+              if (*it_ == dataloader_->end()) {
+                return false;
+              }
+              inputs = batch_inputs(**it_);
+              ++(*it_);
+              return true;
+            },
+            prefetch_depth) {}
+
+  /**
+   * @brief Get the Batch Size for the next batch (always 1 due to issues with
+   * TRT and explicit batch)
+   *
+   * The real batch size is carried by the batch dimension of the data
+   *
+   * @return int
+   */
+  int getBatchSize() const noexcept override {
+    // HACK: Torch-TensorRT only uses explict batch sizing, INT8 Calibrator does not
+    // work when reporting the batch size here and having explicity batching.
+    // So we just report batch size 1 (warnings will still be printed out).
+    return 1;
+  }
+
+  /**
+   * @brief Get the next Batch
+   *
+   * @param bindings: void*[] - An array of binding pointers (fed in from
+   * TensorRT calibrator), these buffers should be filed with batch data for
+   * each input
+   * @param names: const char*[] - Names of bindings
+   * @param nbBindings: int - Number of bindings
+   * @return true - There is a new batch for the calibrator to consume
+   * @return false - There is not a new batch for the calibrator to consume
+   */
+  bool getBatch(void* bindings[], const char* names[], int nbBindings) noexcept override {
+    return prefetcher_.next(bindings, names, nbBindings);
+  }
+
+  /**
+   * @brief Read calibration cache
+   *
+   * How to read from the calibration cache, only enabled if use_cache is set
+   *
+   * @param length
+   * @return const void* - Pointer to cache data
+   */
+  const void* readCalibrationCache(size_t& length) noexcept override {
+    if (use_cache_) {
+      std::stringstream ss;
+      ss << "Reading Calibration Cache from " << cache_file_path_;
+      logging::log(logging::Level::kINFO, ss.str());
+
+      cache_.clear();
+      std::ifstream input(cache_file_path_, std::ios::binary);
+      input >> std::noskipws;
+      if (input.good()) {
+        std::copy(std::istream_iterator<char>(input), std::istream_iterator<char>(), std::back_inserter(cache_));
+        logging::log(logging::Level::kDEBUG, "Cache read");
+      }
+      length = cache_.size();
+      return length ? cache_.data() : nullptr;
+    }
+    return nullptr;
+  }
+
+  /**
+   * @brief Write calibration cache
+   *
+   * Write a the calibration cache provided by TensorRT to a specified file
+   *
+   * @param cache: const void* - cache data
+   * @param length: size_t - length of cache
+   */
+  void writeCalibrationCache(const void* cache, size_t length) noexcept override {
+    std::ofstream cache_file(cache_file_path_, std::ios::binary);
+    cache_file.write(reinterpret_cast<const char*>(cache), length);
+    std::stringstream ss;
+    ss << "Saved Calibration Cache to " << cache_file_path_;
+    logging::log(logging::Level::kINFO, ss.str());
+  }
+
+  /**
+   * @brief operator to cast to nvinfer1::IInt8Calibrator*
+   *
+   * Convience function to convert to a IInt8Calibrator* to easily be assigned
+   * to the ptq_calibrator field in CompileSpec
+   *
+   * @return nvinfer1::IInt8Calibrator*
+   */
+  operator nvinfer1::IInt8Calibrator*() {
+    return reinterpret_cast<nvinfer1::IInt8Calibrator*>(this);
+  }
+
+ private:
+  /// The dataloader
+  DataLoaderUniquePtr dataloader_;
+  /// Position in the current pass over the dataloader, only used by the prefetch thread
+  std::unique_ptr<torch::data::Iterator<Batch>> it_;
+  /// Path to cache file
+  std::string cache_file_path_;
+  /// Whether to use the cache or not
+  bool use_cache_;
+  /// Cache data
+  std::vector<char> cache_;
+  /// Loads and stages batches ahead of getBatch, declared last so its thread stops before the members it uses go away
+  BatchPrefetcher prefetcher_;
+};
+
 /**
  * @brief Generic Int8Calibrator implementation based on a specified
  * TensorRT calibration algorithm that only reads from a calibration file
@@ -283,6 +507,177 @@ class Int8CacheCalibrator : Algorithm {
   std::vector<char> cache_;
 };
 
+/**
+ * @brief Int8Calibrator implementation based on a specified TensorRT
+ * calibration algorithm which takes batches already on the GPU and keeps its
+ * calibration cache in memory
+ *
+ * Batches are lists of tensors on the current CUDA device, one per input in
+ * the order of the module's arguments, such as the outputs of a preceding
+ * model. They are bound as they are instead of being copied to the device
+ * first. The batches are either given up front or produced by a callback
+ * each time TensorRT asks for the next one.
+ *
+ * The calibration cache is read from and written to a blob in memory instead
+ * of a file, so it can be kept, sent or stored by the application however it
+ * likes.
+ *
+ * @tparam Algorithm: class nvinfer1::IInt8Calibrator (Default:
+ * nvinfer1::IInt8EntropyCalibrator2) - Algorithm to use
+ */
+template <typename Algorithm>
+class Int8DeviceCalibrator : Algorithm {
+ public:
+  /// Fills the inputs of the next batch or returns false at the end of the data, the next call starts a new pass
+  using BatchSource = std::function<bool(std::vector<torch::Tensor>&)>;
+
+  /**
+   * @brief Construct a new Int8DeviceCalibrator object from a list of batches
+   *
+   * @param batches: std::vector<std::vector<torch::Tensor>> - Batches on the
+   * GPU, each holding one tensor per input
+   * @param cache: std::string - Calibration cache to start from (may be empty)
+   * @param use_cache : bool - Whether to use the cache (if it is not empty)
+   */
+  Int8DeviceCalibrator(std::vector<std::vector<torch::Tensor>> batches, std::string cache, bool use_cache)
+      : batches_(std::move(batches)), cache_(std::move(cache)), use_cache_(use_cache) {
+    next_batch_ = [this](std::vector<torch::Tensor>& inputs) {
+      if (it_ == batches_.size()) {
+        it_ = 0;
+        return false;
+      }
+      inputs = batches_[it_++];
+      return true;
+    };
+  }
+
+  /**
+   * @brief Construct a new Int8DeviceCalibrator object from a batch source
+   *
+   * @param next_batch: BatchSource - Called on the calibrating thread each
+   * time TensorRT asks for a batch, may run other models on the current stream
+   * to produce it
+   * @param cache: std::string - Calibration cache to start from (may be empty)
+   * @param use_cache : bool - Whether to use the cache (if it is not empty)
+   */
+  Int8DeviceCalibrator(BatchSource next_batch, std::string cache, bool use_cache)
+      : next_batch_(std::move(next_batch)), cache_(std::move(cache)), use_cache_(use_cache) {}
+
+  Int8DeviceCalibrator(const Int8DeviceCalibrator&) = delete;
+  Int8DeviceCalibrator& operator=(const Int8DeviceCalibrator&) = delete;
+
+  /**
+   * @brief Get the Batch Size for the next batch (always 1 due to issues with
+   * TRT and explicit batch)
+   *
+   * The real batch size is carried by the batch dimension of the data
+   *
+   * @return int
+   */
+  int getBatchSize() const noexcept override {
+    // HACK: Torch-TensorRT only uses explict batch sizing, INT8 Calibrator does not
+    // work when reporting the batch size here and having explicity batching.
+    // So we just report batch size 1 (warnings will still be printed out).
+    return 1;
+  }
+
+  /**
+   * @brief Get the next Batch
+   *
+   * @param bindings: void*[] - An array of binding pointers (fed in from
+   * TensorRT calibrator), these buffers should be filed with batch data for
+   * each input
+   * @param names: const char*[] - Names of bindings
+   * @param nbBindings: int - Number of bindings
+   * @return true - There is a new batch for the calibrator to consume
+   * @return false - There is not a new batch for the calibrator to consume
+   */
+  bool getBatch(void* bindings[], const char* names[], int nbBindings) noexcept override {
+    // TensorRT is done with the previous batch once it asks for the next one
+    current_.clear();
+    try {
+      if (!next_batch_(current_)) {
+        return false;
+      }
+    } catch (const std::exception& e) {
+      logging::log(logging::Level::kERROR, std::string("Failed to get calibration batch: ") + e.what());
+      return false;
+    }
+    return bind_device_batch(bindings, names, nbBindings, current_);
+  }
+
+  /**
+   * @brief Read calibration cache
+   *
+   * Returns the cache blob the calibrator holds, only enabled if use_cache is
+   * set
+   *
+   * @param length
+   * @return const void* - Pointer to cache data
+   */
+  const void* readCalibrationCache(size_t& length) noexcept override {
+    if (use_cache_ && !cache_.empty()) {
+      logging::log(logging::Level::kINFO, "Reading Calibration Cache from memory");
+      length = cache_.size();
+      return cache_.data();
+    }
+    length = 0;
+    return nullptr;
+  }
+
+  /**
+   * @brief Write calibration cache
+   *
+   * Keeps the calibration cache provided by TensorRT in memory, see
+   * get_calibration_cache
+   *
+   * @param cache: const void* - cache data
+   * @param length: size_t - length of cache
+   */
+  void writeCalibrationCache(const void* cache, size_t length) noexcept override {
+    cache_.assign(reinterpret_cast<const char*>(cache), length);
+    std::stringstream ss;
+    ss << "Saved Calibration Cache of " << length << " bytes to memory";
+    logging::log(logging::Level::kINFO, ss.str());
+  }
+
+  /**
+   * @brief Get the calibration cache
+   *
+   * @return const std::string& - The cache the calibrator was created with or
+   * the one last written by TensorRT
+   */
+  const std::string& get_calibration_cache() const {
+    return cache_;
+  }
+
+  /**
+   * @brief operator to cast to nvinfer1::IInt8Calibrator*
+   *
+   * Convience function to convert to a IInt8Calibrator* to easily be assigned
+   * to the ptq_calibrator field in CompileSpec
+   *
+   * @return nvinfer1::IInt8Calibrator*
+   */
+  operator nvinfer1::IInt8Calibrator*() {
+    return reinterpret_cast<nvinfer1::IInt8Calibrator*>(this);
+  }
+
+ private:
+  /// Batches given up front, empty when the calibrator has a batch source
+  std::vector<std::vector<torch::Tensor>> batches_;
+  /// Position in batches_
+  size_t it_ = 0;
+  /// Produces the next batch
+  BatchSource next_batch_;
+  /// Batch TensorRT is reading, kept alive until the next call to getBatch
+  std::vector<torch::Tensor> current_;
+  /// Cache data
+  std::string cache_;
+  /// Whether to use the cache or not
+  bool use_cache_;
+};
+
 /**
  * @brief A factory to build a post training quantization calibrator from a
  * torch dataloader
@@ -316,6 +711,42 @@ TORCH_TENSORRT_PTQ_DEPRECATION inline Int8Calibrator<Algorithm, DataLoader> make
   return Int8Calibrator<Algorithm, DataLoader>(std::move(dataloader), cache_file_path, use_cache);
 }
 
+/**
+ * @brief A factory to build a streaming post training quantization calibrator
+ * from a torch dataloader
+ *
+ * Creates an Int8StreamingCalibrator, which reads batches from the dataloader
+ * as calibration runs and prefetches them onto the GPU instead of holding the
+ * whole dataset in host memory. Use this for large calibration sets or models
+ * with several inputs. The calibrator cannot be copied or moved, so bind the
+ * result directly:
+ *
+ * e.g.
+ * ``auto calibrator = torch_tensorrt::ptq::make_int8_streaming_calibrator(std::move(calibration_dataloader),
+ * calibration_cache_file, use_cache);``
+ * @tparam Algorithm: class nvinfer1::IInt8Calibrator (Default:
+ * nvinfer1::IInt8EntropyCalibrator2) - Algorithm to use
+ * @tparam DataLoader: std::unique_ptr<torch::data::DataLoader> - DataLoader
+ * type
+ * @param dataloader: std::unique_ptr<torch::data::DataLoader> - DataLoader
+ * containing data
+ * @param cache_file_path: const std::string& - Path to read/write calibration
+ * cache
+ * @param use_cache: bool - use calibration cache
+ * @param prefetch_depth: size_t - Number of batches staged on the GPU ahead of
+ * the calibrator (Default: 2)
+ * @return Int8StreamingCalibrator<Algorithm, DataLoader>
+ */
+template <typename Algorithm = nvinfer1::IInt8EntropyCalibrator2, typename DataLoader>
+TORCH_TENSORRT_PTQ_DEPRECATION inline Int8StreamingCalibrator<Algorithm, DataLoader> make_int8_streaming_calibrator(
+    DataLoader dataloader,
+    const std::string& cache_file_path,
+    bool use_cache,
+    size_t prefetch_depth = 2) {
+  return Int8StreamingCalibrator<Algorithm, DataLoader>(
+      std::move(dataloader), cache_file_path, use_cache, prefetch_depth);
+}
+
 /**
  * @brief A factory to build a post training quantization calibrator from a
  * torch dataloader that only uses the calibration cache
@@ -342,6 +773,59 @@ TORCH_TENSORRT_PTQ_DEPRECATION inline Int8Calibrator<Algorithm, DataLoader> make
  * cache
  * @return Int8CacheCalibrator<Algorithm>
  */
+/**
+ * @brief A factory to build a post training quantization calibrator from
+ * batches already on the GPU
+ *
+ * Creates an Int8DeviceCalibrator, which binds the given batches directly
+ * instead of copying them to the device, and reads and writes the calibration
+ * cache from a blob in memory. Get the cache written by calibration with
+ * get_calibration_cache to reuse it later. The calibrator cannot be copied or
+ * moved, so bind the result directly:
+ *
+ * e.g.
+ * ``auto calibrator = torch_tensorrt::ptq::make_int8_device_calibrator(std::move(gpu_batches), "", false);``
+ * @tparam Algorithm: class nvinfer1::IInt8Calibrator (Default:
+ * nvinfer1::IInt8EntropyCalibrator2) - Algorithm to use
+ * @param batches: std::vector<std::vector<torch::Tensor>> - Batches on the
+ * GPU, each holding one tensor per input
+ * @param cache: std::string - Calibration cache to start from (may be empty)
+ * @param use_cache: bool - use calibration cache
+ * @return Int8DeviceCalibrator<Algorithm>
+ */
+template <typename Algorithm = nvinfer1::IInt8EntropyCalibrator2>
+TORCH_TENSORRT_PTQ_DEPRECATION inline Int8DeviceCalibrator<Algorithm> make_int8_device_calibrator(
+    std::vector<std::vector<torch::Tensor>> batches,
+    std::string cache,
+    bool use_cache) {
+  return Int8DeviceCalibrator<Algorithm>(std::move(batches), std::move(cache), use_cache);
+}
+
+/**
+ * @brief A factory to build a post training quantization calibrator from a
+ * source of batches on the GPU
+ *
+ * Like make_int8_device_calibrator with a list of batches, but the batches are
+ * produced by next_batch each time TensorRT asks for one, for example by
+ * running a preceding model on the current stream. next_batch returns false
+ * at the end of the data.
+ *
+ * @tparam Algorithm: class nvinfer1::IInt8Calibrator (Default:
+ * nvinfer1::IInt8EntropyCalibrator2) - Algorithm to use
+ * @param next_batch: std::function<bool(std::vector<torch::Tensor>&)> -
+ * Fills the inputs of the next batch
+ * @param cache: std::string - Calibration cache to start from (may be empty)
+ * @param use_cache: bool - use calibration cache
+ * @return Int8DeviceCalibrator<Algorithm>
+ */
+template <typename Algorithm = nvinfer1::IInt8EntropyCalibrator2>
+TORCH_TENSORRT_PTQ_DEPRECATION inline Int8DeviceCalibrator<Algorithm> make_int8_device_calibrator(
+    typename Int8DeviceCalibrator<Algorithm>::BatchSource next_batch,
+    std::string cache,
+    bool use_cache) {
+  return Int8DeviceCalibrator<Algorithm>(std::move(next_batch), std::move(cache), use_cache);
+}
+
 template <typename Algorithm = nvinfer1::IInt8EntropyCalibrator2>
 TORCH_TENSORRT_PTQ_DEPRECATION inline Int8CacheCalibrator<Algorithm> make_int8_cache_calibrator(
     const std::string& cache_file_path) {
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) NVIDIA Corporation.
+ * All rights reserved.
+ *
+ * This library is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "ATen/Tensor.h"
+#include "torch/csrc/jit/api/module.h"
+
+#include "torch_tensorrt/macros.h"
+
+namespace torch_tensorrt {
+namespace runtime {
+
+/**
+ * @brief Runs the tensor parallel shards of a model together, one shard per GPU
+ *
+ * Each shard is a module compiled by Torch-TensorRT for its own GPU from one rank of a tensor parallel program, whose
+ * engines exchange activations through collective communication plugins (e.g. NCCL all-reduce plugins registered with
+ * TensorRT). A collective only completes once every rank has launched it, so the shards are launched concurrently,
+ * each from a worker thread of its own bound to its device. The inputs are replicated to every shard.
+ *
+ * Communicators are set up once per rank before the first execution by the init_rank callback, which runs on the
+ * worker thread of each rank concurrently with the other ranks, as collective communicator creation (e.g.
+ * ncclCommInitRank) blocks until all ranks have joined.
+ */
+class TORCHTRT_API TensorParallelModule {
+ public:
+  /**
+   * @brief Callback setting up the communicators of a rank, called with the rank and the device of its shard
+   */
+  using InitRank = std::function<void(int64_t rank, int64_t device)>;
+
+  /**
+   * @brief Start a worker per shard and set up the ranks
+   *
+   * @param shards: Modules compiled by Torch-TensorRT, one per rank in rank order, each with all of its engines on a
+   * device no other shard uses
+   * @param init_rank: Sets up the communicators of each rank, see InitRank. Errors are rethrown once every rank is done
+   */
+  explicit TensorParallelModule(std::vector<torch::jit::Module> shards, InitRank init_rank = nullptr);
+
+  ~TensorParallelModule();
+
+  TensorParallelModule(const TensorParallelModule&) = delete;
+  TensorParallelModule& operator=(const TensorParallelModule&) = delete;
+
+  /**
+   * @brief Run the forward method of every shard on the inputs, ordered after the current CUDA stream
+   *
+   * @param inputs: Inputs of forward, copied to the device of each shard
+   * @return std::vector<at::Tensor> Outputs of the shard of rank 0, on its device, tuples and lists flattened in order.
+   * The outputs of a tensor parallel program are gathered or reduced onto every rank. The current CUDA stream is
+   * ordered after all shards
+   */
+  std::vector<at::Tensor> forward(std::vector<at::Tensor> inputs);
+
+  /**
+   * @brief Number of ranks and the device of each rank
+   */
+  int64_t get_world_size() const;
+  std::vector<int64_t> get_devices() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl;
+};
+
+} // namespace runtime
+} // namespace torch_tensorrt
@@ -10,9 +10,12 @@
 
 #include <cuda_runtime.h>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "torch/custom_class.h"
 
@@ -72,6 +75,14 @@ class DataType {
     kInt,
     /// Bool
     kBool,
+    /// FP8 (E4M3)
+    kFloat8,
+    /// INT4, only usable as an enabled precision for block quantized weights
+    kInt4,
+    /// UINT8, only usable as an input type, the engine casts the input to FP32 as it reads it
+    kUInt8,
+    /// BF16, 16 bit brain floating point with the exponent range of FP32
+    kBFloat16,
     /// Sentinel value
     kUnknown
   };
@@ -286,6 +297,12 @@ class TensorFormat {
     kContiguous,
     /// Channel Last / NHWC
     kChannelsLast,
+    /// Channel Last with the channels padded to a multiple of 8 / HWC8 (FP16 only)
+    kHWC8,
+    /// Channel Last with the channels padded to a multiple of 16 / HWC16 (FP16 only)
+    kHWC16,
+    /// 3D Channel Last with the channels padded to a multiple of 8 / DHWC8 (FP16 only)
+    kDHWC8,
     /// Sentinel value
     kUnknown,
   };
@@ -385,6 +402,9 @@ struct Input : torch::CustomClassHolder {
   TensorFormat format;
   /// Expected allowed domain for tensor input
   std::vector<double> tensor_domain;
+  /// Additional optimization profiles as {min, opt, max} shapes, the engine is built with one profile for the range
+  /// above and one for each of these (see add_profile)
+  std::vector<std::vector<std::vector<int64_t>>> additional_profiles;
 
   Input() {}
   /**
@@ -661,6 +681,23 @@ struct Input : torch::CustomClassHolder {
    */
   TORCHTRT_API Input(at::Tensor tensor);
 
+  /**
+   * @brief Add an optimization profile for this input on top of the range the spec was constructed with
+   *
+   * The engine is built with one optimization profile per range and the runtime selects the profile best matching
+   * the shape of each execution, so for instance small and large batches can both run tuned kernels. All inputs of a
+   * module which describe more than one range must describe the same number of ranges
+   *
+   * @param min_shape Minimum shape for input tensor in this profile
+   * @param opt_shape Target optimization shape for input tensor in this profile
+   * @param max_shape Maximum acceptible shape for input tensor in this profile
+   * @return Input& this spec, to chain calls
+   */
+  TORCHTRT_API Input& add_profile(
+      c10::ArrayRef<int64_t> min_shape,
+      c10::ArrayRef<int64_t> opt_shape,
+      c10::ArrayRef<int64_t> max_shape);
+
  private:
   friend TORCHTRT_API std::ostream& operator<<(std::ostream& os, const Input& input);
   bool input_is_dynamic;
@@ -764,6 +801,32 @@ struct CompileSpec {
    */
   std::set<DataType> enabled_precisions = {DataType::kFloat};
 
+  /**
+   * @brief Precisions individual layers are pinned to, overriding enabled_precisions for them
+   *
+   * Keys are either node kinds (e.g. "aten::layer_norm", "aten::softmax") or module paths (e.g. "encoder.layers.0",
+   * which also covers the submodules of the path). Node kinds take priority, then the longest matching module path.
+   * Values are DataType::kFloat, or DataType::kHalf or DataType::kBFloat16 if it is also enabled. TensorRT is then
+   * required to obey the constraints, e.g. to keep numerically sensitive layers in FP32 while the rest of the network
+   * runs in FP16
+   */
+  std::map<std::string, DataType> layer_precisions;
+
+  /**
+   * Build strongly typed networks: each layer runs in the type its inputs have in the TorchScript graph (as set by
+   * the input dtypes and the casts of the model) instead of TensorRT choosing among enabled_precisions. Meant for
+   * mixed precision models that are already cast where needed, it shrinks the tactic search and makes engines
+   * reproducible. Cannot be combined with layer_precisions or INT8 calibration. Requires TensorRT 10
+   */
+  bool strongly_typed = false;
+
+  /**
+   * Build engines with weight streaming: weights stay in host memory and are streamed to the device while the engine
+   * runs, within a device memory budget set with set_weight_streaming_budget. Lets models larger than the GPU memory
+   * run, at the cost of throughput the smaller the budget. Requires strongly_typed and TensorRT 10
+   */
+  bool weight_streaming = false;
+
   /**
    * Prevent Float32 layers from using TF32 data format
    *
@@ -783,13 +846,27 @@ struct CompileSpec {
    */
   bool refit = false;
 
+  /**
+   * Save the engines of the compiled module without their weights, which shrinks the saved module to the structure of
+   * its engines. A loaded module runs once refit (see refit) with the weights of the module it was compiled from.
+   * Unless refit is set as well, the engines can only be refit with these weights. Requires TensorRT 10
+   */
+  bool strip_engine_weights = false;
+
   /**
    * Build a debugable engine
    */
   bool debug = false;
 
   /**
-   * Truncate long/double type to int/float type
+   * Record the type, formats, tactic and source TorchScript node of every layer in the engines, which lint_engines
+   * and the engine inspector report
+   */
+  bool detailed_layer_info = false;
+
+  /**
+   * Truncate long/double type to int/float type. With TensorRT 10 and newer, Int64 inputs are bound by the engines
+   * natively and do not need this
    */
   bool truncate_long_and_double = false;
 
@@ -798,11 +875,77 @@ struct CompileSpec {
    */
   bool allow_shape_tensors = false;
 
+  /**
+   * Share one device scratch memory arena between the TensorRT engines of a partitioned module instead of giving
+   * each engine its own. The engines run one after another so this reduces the memory footprint to that of the
+   * largest engine
+   */
+  bool share_device_memory = false;
+
+  /**
+   * Capture the CUDA graphs of the TensorRT engines of a partitioned module (in subgraph CUDA graphs mode) into one
+   * shared graph memory pool instead of a private pool each. The engines run one after another, so the persistent
+   * input and output buffers of their graphs are placed in one region sized for the largest engine rather than
+   * allocated per engine and input shape
+   */
+  bool share_cudagraph_pool = false;
+
+  /**
+   * Compile the PyTorch subgraphs of a partially compiled module which NNC (the TorchScript tensor expression fuser)
+   * supports, e.g. short chains of elementwise ops between TensorRT engines, into a single kernel each instead of
+   * running them op by op through the TorchScript interpreter. Kernels are specialized for the opt input shapes,
+   * inputs of other shapes run through the interpreter
+   */
+  bool fuse_torch_segments = false;
+
+  /**
+   * Return the compiled module as soon as it is partitioned instead of once its engines are built. The TensorRT
+   * segments run their original PyTorch subgraphs until their engines, built on a background thread (with
+   * num_build_workers workers and through the engine cache if one is set), are ready, each segment then switches to its
+   * engine between two executions. Segments whose build fails keep running in PyTorch. Requires partial compilation
+   */
+  bool background_build = false;
+
+  /**
+   * Place the tensors the TensorRT engines of a partially compiled module only pass to each other in one preallocated
+   * arena, reusing the memory of tensors no later engine reads, instead of allocating each engine output separately.
+   * Has no effect when engines are scheduled on concurrent streams
+   */
+  bool plan_segment_activations = false;
+
+  /**
+   * Lower the peak host memory of compiling a large partially compiled module. TensorRT segments are built one at a
+   * time, so only one segment's host copy of its weights exists at once, and the compiler drops its references to the
+   * weights of a segment as soon as its engine is built. Ignored for partitioned modules built in the background
+   */
+  bool low_memory = false;
+
+  /**
+   * Number of TensorRT segments of a partitioned module built concurrently, 0 uses one worker per hardware thread
+   */
+  uint64_t num_build_workers = 1;
+
+  /**
+   * GPUs the build workers are spread across round robin, needs to be the same model as the target device since
+   * engines are only portable between identical GPUs. A fully compiled module is built on the first. Empty builds
+   * every engine on the target device
+   */
+  std::vector<int64_t> build_gpu_ids = {};
+
   /**
    * Target Device
    */
   Device device;
 
+  /**
+   * Device each TensorRT segment of a partitioned module is built for, in segment order, e.g. a DLA core for a
+   * backbone and the GPU for the rest of the network. Segments past the end of the list use the target device. All
+   * devices need to be a DLA core of the target device or a GPU of the same model, so a model too large for one GPU
+   * can be split into pipeline stages on several GPUs (see runtime::PipelineParallelModule). Engines on different
+   * devices run on their own streams, so executions issued on different CUDA streams pipeline across the devices
+   */
+  std::vector<Device> segment_devices = {};
+
   /**
    * Sets the restrictions for the engine (CUDA Safety)
    */
@@ -813,11 +956,85 @@ struct CompileSpec {
    */
   uint64_t num_avg_timing_iters = 1;
 
+  /**
+   * Build engines as fast as possible at the cost of runtime performance, for development and experiments. Uses
+   * the lowest builder optimization level, only TensorRT's own tactics and a single timing iteration (overriding
+   * num_avg_timing_iters)
+   */
+  bool fast_build = false;
+
+  /**
+   * Maximum number of auxiliary streams TensorRT may run independent branches of an engine on, concurrently with
+   * the main stream. -1 lets TensorRT choose, 0 runs every layer on the main stream. At runtime the auxiliary streams
+   * are taken from the PyTorch CUDA stream pool
+   */
+  int64_t max_aux_streams = -1;
+
+  /**
+   * Build engines which later TensorRT versions can run. Such engines embed the TensorRT lean runtime, which is
+   * trusted host code the runtime only executes once allowed to (see set_engine_host_code_allowed)
+   */
+  bool version_compatible = false;
+
+  /**
+   * Leave the lean runtime out of version compatible engines, the runtime then loads the lean runtime library given
+   * by set_lean_runtime_path to run them. Makes engines smaller and runs their host code from a library of the
+   * deployment instead of the plan
+   */
+  bool exclude_lean_runtime = false;
+
+  /**
+   * TensorRT timing cache file to reuse tactic timings from previous compilations. It is loaded once, shared by all
+   * engines built for the module and written back once compilation is done. Empty disables the timing cache
+   */
+  std::string timing_cache_path = "";
+
+  /**
+   * File the tactics TensorRT chooses for every layer are recorded to, per engine keyed by the engine fingerprint.
+   * Existing entries of other engines are kept. Empty disables recording
+   */
+  std::string tactic_record_path = "";
+
+  /**
+   * File of recorded tactics every layer of the engines is restricted to, so rebuilding an unchanged segment
+   * reproduces the recorded engine instead of whatever tactics win the timing this time. Layers without a usable
+   * recorded tactic (e.g. on another GPU or TensorRT version) are left to TensorRT. Empty disables replay
+   */
+  std::string tactic_replay_path = "";
+
+  /**
+   * Directory of a cache of built engines shared between compilations and processes. TensorRT segments whose graph,
+   * weights, input specs and settings match a cached engine reuse it instead of being rebuilt. Empty disables the
+   * engine cache
+   */
+  std::string engine_cache_dir = "";
+
+  /**
+   * Maximum size in bytes of the engine cache, the least recently used engines are evicted beyond it
+   */
+  uint64_t engine_cache_size = 5368709120;
+
+  /**
+   * Module previously compiled by Torch-TensorRT from an earlier revision of the model. TensorRT segments whose graph,
+   * weights, input specs and settings are unchanged reuse its engines instead of being rebuilt, so only the changed
+   * segments pay for an engine build. Not owned, it only has to outlive the call to compile
+   */
+  const torch::jit::Module* previous_module = nullptr;
+
   /**
    * Maximum size of workspace given to TensorRT
    */
   uint64_t workspace_size = 0;
 
+  /**
+   * Device memory all TensorRT engines of the module may use together for their activations and scratch, 0 leaves each
+   * engine to workspace_size. The engines of a partially compiled module get shares in proportion to the memory of
+   * their activations (all of it each with share_device_memory), which caps the workspace their kernels are selected
+   * under. Activation memory itself cannot be bounded, whether the engines fit is logged and reported by
+   * compile(module, info, report)
+   */
+  uint64_t device_memory_budget = 0;
+
   /**
    * Fast software managed RAM used by DLA to communicate within a layer.
    */
@@ -838,6 +1055,35 @@ struct CompileSpec {
    */
   nvinfer1::IInt8Calibrator* ptq_calibrator = nullptr;
 
+  /**
+   * Calibrate all TensorRT segments of a partitioned module from a single pass of ptq_calibrator over the module
+   * instead of one pass per segment. The inputs of every segment are recorded on the host while the module runs in
+   * PyTorch and replayed to each segment build. The segment caches are written to ptq_calibrator as one cache, so
+   * later compilations that read it skip calibration
+   */
+  bool shared_segment_calibration = false;
+
+  /**
+   * Formats the outputs of the module are returned in, by output index (outputs past the end are contiguous). The
+   * padded channel last formats are returned as channels last strided views over a buffer with the padded channels,
+   * which engines taking an input in the same format bind without a reformat
+   */
+  std::vector<TensorFormat> output_formats;
+
+  /**
+   * Return outputs which the program returns more than once, or which are one of its inputs, as the tensor they alias
+   * like TorchScript does, instead of having the engine copy them into outputs of their own. Engines which alias some
+   * of their outputs cannot have state bindings
+   */
+  bool alias_outputs = true;
+
+  /**
+   * Format of the tensors the TensorRT segments of a partitioned module pass to each other (e.g. TensorFormat::kHWC8
+   * for FP16 convolutional networks), so the engines do not reformat them to and from NCHW at every segment boundary.
+   * Tensors whose type or shape the format does not support are passed contiguous
+   */
+  TensorFormat segment_boundary_format = TensorFormat::kContiguous;
+
   /**
    * Require the full module be compiled to TensorRT instead of potentially running unsupported operations in PyTorch
    */
@@ -848,6 +1094,85 @@ struct CompileSpec {
    */
   uint64_t min_block_size = 3;
 
+  /**
+   * Unroll loops with a constant trip count of at most this many iterations (0 disables unrolling), so that their
+   * iterations compile into one engine instead of running the loop in PyTorch. A loop is only unrolled if every node of
+   * its body converts to TensorRT
+   */
+  uint64_t loop_unroll_max_trip_count = 16;
+
+  /**
+   * Maximum number of nodes in the body of a loop unrolled under ``loop_unroll_max_trip_count``
+   */
+  uint64_t loop_unroll_max_body_size = 32;
+
+  /**
+   * Choose the subgraphs compiled to TensorRT with a latency cost model instead of ``min_block_size``. A subgraph is
+   * compiled when the latency its ops are estimated to save in TensorRT exceeds the overhead of its Torch <-> TensorRT
+   * boundaries (engine launch, syncs, casts and packing of inputs and outputs)
+   */
+  bool cost_model_partitioning = false;
+
+  /**
+   * Measured latency in microseconds saved by running an op kind in TensorRT rather than PyTorch, e.g.
+   * ``{"aten::conv2d", 40.0}``, replacing the built-in estimate of the cost model for that op
+   */
+  std::unordered_map<std::string, double> op_latency_savings_us = {};
+
+  /**
+   * Infer the input shapes of the segments of a partially compiled module with the TorchScript shape and dtype
+   * functions instead of running every PyTorch segment on example inputs for each of the min, opt and max shapes.
+   * Segments with outputs the functions cannot resolve are still run
+   */
+  bool symbolic_shape_analysis = false;
+
+  /**
+   * Number of independent segments of a partitioned module run concurrently, each on its own CUDA stream, when shape
+   * analysis runs segments on example inputs. 0 uses one worker per hardware thread
+   */
+  uint64_t num_shape_analysis_workers = 1;
+
+  /**
+   * Recompute non-tensor values (sizes, lists, scalars) inside the TensorRT subgraphs which consume them instead of
+   * falling back their consumers to PyTorch, and merge the TensorRT subgraphs around PyTorch subgraphs they do not
+   * depend on into one engine
+   */
+  bool merge_non_tensor_boundaries = false;
+
+  /**
+   * Keep a single operator without a converter between two TensorRT subgraphs which are each large enough to be
+   * converted in TensorRT, calling its PyTorch kernel inside the engine through the TorchOp plugin, instead of
+   * splitting the graph into two engines around a PyTorch subgraph. The operator must not modify its inputs and its
+   * non-tensor arguments must be constants. Only for static input shapes
+   */
+  bool bridge_unsupported_ops = false;
+
+  /**
+   * Number of CUDA streams the TensorRT subgraphs of a partially compiled module are spread over so that subgraphs
+   * which do not depend on each other (e.g. the branches of a multi-branch model) run concurrently. 0 or 1 runs them
+   * one after another
+   */
+  uint64_t concurrent_segment_streams = 0;
+
+  /**
+   * Let PyTorch subgraphs run while TensorRT subgraphs they do not depend on are executing on other streams, instead
+   * of waiting for all of them first
+   */
+  bool overlap_torch_segments = false;
+
+  /**
+   * Pass large weights read by several TensorRT subgraphs (e.g. tied input and output embeddings split by a PyTorch
+   * subgraph) to their engines as inputs bound to a single device copy, instead of building a copy of them into each
+   * engine. Ignored for refittable engines
+   */
+  bool share_segment_weights = false;
+
+  /**
+   * Path of a JSON report written during partitioning, listing each subgraph with its node count, its boundary tensors
+   * (shape, dtype, bytes and casts) and why each node runs in PyTorch. Not written if empty
+   */
+  std::string partitioning_report_path = "";
+
   /**
    * List of aten operators that must be run in PyTorch. An error will be thrown if this list is not empty but
    * ``require_full_compilation`` is True
@@ -872,6 +1197,9 @@ struct CompileSpec {
  *
  * Will print out a list of unsupported operators if the graph is unsupported
  *
+ * The lowered graph is kept so that compiling the module next, while its weights
+ * are unchanged and with the default lowering settings, does not lower it again
+ *
  * @returns bool: Method is supported by Torch-TensorRT.TorchScript
  */
 TORCHTRT_API bool check_method_operator_support(const torch::jit::Module& module, std::string method_name);
@@ -888,55 +1216,917 @@ TORCHTRT_API bool check_method_operator_support(const torch::jit::Module& module
  *
  * Converts specifically the forward method of a TorchScript Module
  *
+ * Several modules can be compiled on different threads at once, e.g. one per GPU. Each compilation logs with the
+ * logging settings in place when it started and leaves the current CUDA device of its thread as it found it
+ *
  * @return: A new module trageting a TensorRT engine
  */
 TORCHTRT_API torch::jit::Module compile(const torch::jit::Module& module, CompileSpec info);
 
 /**
- * @brief Compile a TorchScript method for NVIDIA GPUs using TensorRT
+ * @brief Wall time and memory of one phase of a TorchScript compilation
+ */
+struct CompilePhaseReport {
+  /**
+   * Name of the phase: "compile" (the whole compilation), "lowering", "partitioning",
+   * "shape_analysis/{min,opt,max}", "conversion" (building the TensorRT network), "build" (building the engine) and
+   * the TensorRT builder's own phases "build/<phase>"
+   */
+  std::string phase;
+
+  /**
+   * TensorRT segment of a partitioned module the phase ran for ("segment_<index>"), empty for phases covering the
+   * whole module
+   */
+  std::string segment;
+
+  /**
+   * Wall time of the phase in nanoseconds
+   */
+  int64_t wall_time_ns = 0;
+
+  /**
+   * Peak resident set size of the process in bytes when the phase finished
+   */
+  int64_t peak_host_bytes = 0;
+
+  /**
+   * Highest device memory in use in bytes sampled during the phase (at its start, its end and every TensorRT builder
+   * step)
+   */
+  int64_t peak_gpu_bytes = 0;
+};
+
+/**
+ * @brief Device memory a TensorRT engine was budgeted under CompileSpec::device_memory_budget and needs
+ */
+struct CompileEngineMemoryReport {
+  int64_t budget = 0;
+
+  /**
+   * Device memory of the execution context of the engine (activations and scratch), -1 if the engine is still being
+   * built in the background
+   */
+  int64_t device_memory = -1;
+};
+
+/**
+ * @brief Per phase and per segment profile of a TorchScript compilation
+ */
+struct CompileReport {
+  /**
+   * Phases in the order they finished. Phases nest, e.g. shape analysis runs within partitioning and every phase
+   * within compile
+   */
+  std::vector<CompilePhaseReport> phases;
+
+  /**
+   * Engines in the order of the segments of the module, empty without a device_memory_budget
+   */
+  std::vector<CompileEngineMemoryReport> engine_memory;
+
+  /**
+   * Whether the engines need no more device memory than device_memory_budget together (as much as the largest of them
+   * with share_device_memory)
+   */
+  bool device_memory_budget_met = true;
+
+  /**
+   * @brief Serialize the report as a JSON list of phases
+   */
+  TORCHTRT_API std::string to_json() const;
+};
+
+/**
+ * @brief Compile a TorchScript module for NVIDIA GPUs using TensorRT and profile the compilation
  *
  * @param module: torch::jit::Module - Existing TorchScript module
- * @param method_name: std::string - Name of method to compile
  * @param info: torch_tensorrt::CompileSpec - Compilation settings
+ * @param report: torch_tensorrt::CompileReport - Filled with the wall time and memory of every compilation phase
  *
- * Takes a existing TorchScript module and a set of settings to configure the
- * compiler and will convert selected method to a serialized TensorRT engine
- * which can be run with TensorRT
+ * Compiles the module like compile(module, info)
  *
- * @return: std::string: Serialized TensorRT engine equivilant to the method
- * graph
+ * @return: A new module trageting a TensorRT engine
  */
-TORCHTRT_API std::string convert_method_to_trt_engine(
-    const torch::jit::Module& module,
-    std::string method_name,
-    CompileSpec info);
+TORCHTRT_API torch::jit::Module compile(const torch::jit::Module& module, CompileSpec info, CompileReport& report);
 
 /**
- * @brief Take a previously created TensorRT engine and embed it in
- * in a TorchScript module
+ * @brief Segment of a module as compiling it would partition it
+ */
+struct DryRunSegment {
+  /// "graph" for the top level block of the module, the node owning the block otherwise
+  std::string block;
+
+  /// Runs as a TensorRT engine, in PyTorch otherwise
+  bool tensorrt = false;
+
+  int64_t num_nodes = 0;
+
+  /**
+   * FLOPs at the opt input shapes, estimated from the shapes propagated through the segment. Convolutions and matrix
+   * multiplications count two per multiply-accumulate, other ops one per output element
+   */
+  double flops = 0;
+
+  /// Bytes of the weights the engine of a TensorRT segment embeds
+  int64_t weight_bytes = 0;
+
+  /// Bytes of the inputs of the segment produced by a segment of the other kind, at the opt input shapes
+  int64_t boundary_bytes = 0;
+};
+
+/**
+ * @brief Outcome of a compilation, previewed without building any engine
+ */
+struct DryRunReport {
+  /// Segments of every partitioned block, in order
+  std::vector<DryRunSegment> segments;
+
+  /// Bytes crossing the boundaries between PyTorch and TensorRT per execution, at the opt input shapes
+  int64_t boundary_bytes = 0;
+
+  /// Number of nodes of each op kind which have no converter
+  std::map<std::string, int64_t> unsupported_ops;
+
+  /**
+   * @brief Serialize the report as JSON
+   */
+  TORCHTRT_API std::string to_json() const;
+
+  /**
+   * @brief Summary of the report, one line per segment
+   */
+  TORCHTRT_API std::string to_str() const;
+};
+
+/**
+ * @brief Preview the compilation of a TorchScript module
  *
- * @param engine: std::string - Pre-built serialized TensorRT engine
- * @param device: CompileSepc::Device - Device information
- * @param input_binding_names: std::vector<std::string> - Name of TensorRT bindings in order passed in by original
- * PyTorch function (defaults to assuming convention below)
- * @param output_binding_names: std::vector<std::string> - Name of TensorRT bindings in order returned by original
- * PyTorch function (defaults to assuming convention below)
+ * @param module: torch::jit::Module - Existing TorchScript module
+ * @param info: torch_tensorrt::CompileSpec - Compilation settings
  *
- * Takes a pre-built serialized TensorRT engine and embeds it in a TorchScript
- * module. Registers execution of the engine as the forward method of the module
- * Forward is defined as: forward(Tensor[]) -> Tensor[]
+ * Lowers and partitions the module like compile(module, info), running shape analysis for the segments, and stops
+ * before any TensorRT network is converted or engine built. Graphs compile would convert whole are reported as the
+ * single TensorRT segment they would be built as, unsupported ops are reported even if full compilation is required
  *
- * If binding names not specified TensorRT bindings must have names with the following format:
- * - [symbol].[index in input / output array]
- * ex.
- * - [x.0, x.1, x.2] -> [y.0]
+ * @return: torch_tensorrt::DryRunReport - Segments compile would build
+ */
+TORCHTRT_API DryRunReport dry_run(const torch::jit::Module& module, CompileSpec info);
+
+/**
+ * @brief Compile a TorchScript module once for each of a set of compile specs
  *
- * @return: A new module targeting a TensorRT engine
+ * @param module: torch::jit::Module - Existing TorchScript module
+ * @param specs: std::vector<torch_tensorrt::CompileSpec> - Compilation settings of each variant, e.g. different input
+ * shapes or precisions
+ * @param gpu_ids: std::vector<int64_t> - GPUs the variants are built on concurrently, one variant per GPU at a time.
+ * Empty builds them one after the other on the current device
+ *
+ * The module is lowered once per distinct lowering configuration instead of once per spec, and specs with the same
+ * timing_cache_path share one timing cache so tactics timed for one variant are not timed again for the next. A spec
+ * without build_gpu_ids is built on the GPU its worker runs on, which has to be the same model as its target device
+ *
+ * @return: The compiled modules, in the order of specs
  */
-TORCHTRT_API torch::jit::Module embed_engine_in_new_module(
-    const std::string& engine,
-    Device device,
-    const std::vector<std::string>& input_binding_names = std::vector<std::string>(),
-    const std::vector<std::string>& output_binding_names = std::vector<std::string>());
+TORCHTRT_API std::vector<torch::jit::Module> compile_variants(
+    const torch::jit::Module& module,
+    std::vector<CompileSpec> specs,
+    std::vector<int64_t> gpu_ids = {});
+
+/**
+ * @brief Candidate configurations tried by autotune
+ *
+ * Compile time settings are combined into a grid of at most max_builds builds, each of which is benchmarked under
+ * every combination of the runtime settings
+ */
+struct AutotuneOptions {
+  /// Values of min_block_size tried
+  std::vector<uint64_t> min_block_sizes = {1, 3, 8};
+
+  /// Sets of operators tried in Torch, each added to the torch_executed_ops of the spec. {} tries the spec as is
+  std::vector<std::vector<std::string>> torch_executed_ops = {{}};
+
+  /// Also try the opposite of the truncate_long_and_double of the spec
+  bool tune_truncate_long_and_double = false;
+
+  /// Benchmark every build with and without CUDA graphs
+  bool tune_cudagraphs = true;
+
+  /// Benchmark every build with and without pre-allocated outputs
+  bool tune_pre_allocated_outputs = true;
+
+  /// Maximum number of modules built, the grid is cut short beyond it
+  int64_t max_builds = 12;
+
+  /// Untimed executions of each configuration before it is timed, which also records its CUDA graphs
+  int64_t warmup_iters = 10;
+
+  /// Timed executions of each configuration, cycling through the inputs
+  int64_t iters = 100;
+};
+
+/**
+ * @brief Compile and runtime settings of one configuration tried by autotune, and how it performed
+ */
+struct AutotuneCandidate {
+  uint64_t min_block_size = 0;
+  std::vector<std::string> torch_executed_ops;
+  bool truncate_long_and_double = false;
+  bool cudagraphs = false;
+  bool pre_allocated_outputs = false;
+
+  /// Why the configuration failed to compile or run, empty if it succeeded
+  std::string error;
+
+  /// Time taken to compile the module of the configuration, shared by the configurations differing in runtime settings
+  double build_time_s = 0;
+
+  /// Median and mean latency of one execution, including the host overhead of the call
+  double p50_latency_ms = 0;
+  double mean_latency_ms = 0;
+};
+
+/**
+ * @brief Every configuration tried by autotune
+ */
+struct AutotuneReport {
+  std::vector<AutotuneCandidate> candidates;
+
+  /// Index of the configuration with the lowest median latency in candidates, -1 if none succeeded
+  int64_t best = -1;
+
+  /**
+   * @brief Serialize the report as JSON of the form {"best": ..., "candidates": [{"min_block_size": ..., ...}, ...]}
+   */
+  TORCHTRT_API std::string to_json() const;
+};
+
+/**
+ * @brief Compile a TorchScript module with each of a bounded set of configurations and return the fastest
+ *
+ * @param module: torch::jit::Module - Existing TorchScript module
+ * @param info: torch_tensorrt::CompileSpec - Compilation settings the candidate configurations are derived from
+ * @param inputs: std::vector<std::vector<torch::jit::IValue>> - Representative inputs, one list per call of forward
+ * @param report: torch_tensorrt::AutotuneReport - Filled with the settings and latency of every configuration
+ * @param options: torch_tensorrt::AutotuneOptions - Configurations to try and how long to time them
+ *
+ * Builds share the engine and timing caches of info so TensorRT segments which come out the same in several
+ * configurations are built once; if info sets neither, a temporary engine cache and timing cache are used for the
+ * duration of the search. The returned module has the pre-allocated outputs setting of the best configuration
+ * applied. CUDA graphs are a process wide setting which is restored once the search is done, apply the one of the
+ * best configuration with set_cudagraphs_enabled
+ *
+ * @return: The module of the configuration with the lowest median latency
+ */
+TORCHTRT_API torch::jit::Module autotune(
+    const torch::jit::Module& module,
+    CompileSpec info,
+    const std::vector<std::vector<torch::jit::IValue>>& inputs,
+    AutotuneReport& report,
+    AutotuneOptions options = {});
+
+/**
+ * @brief Refit the TensorRT engines of a compiled module with the weights of another module
+ *
+ * @param compiled_module: torch::jit::Module - Module returned by compile, built with refit or strip_engine_weights
+ * enabled. Modules saved with strip_engine_weights can only run once loaded and refit
+ * @param new_module: torch::jit::Module - TorchScript module with the same architecture as the module compiled_module
+ * was compiled from, holding the new weights
+ * @param info: torch_tensorrt::CompileSpec - Compilation settings compiled_module was compiled with
+ *
+ * Updates the weights of the TensorRT engines of compiled_module in place, without rebuilding them. new_module
+ * is lowered and partitioned the same way the original module was, so info needs to match the original compilation
+ */
+TORCHTRT_API void refit(torch::jit::Module& compiled_module, const torch::jit::Module& new_module, CompileSpec info);
+
+/**
+ * @brief 2:4 structured sparsity of the weight of a convolution or fully connected layer
+ */
+struct WeightSparsity {
+  /**
+   * Name of the weight in the lowered graph, e.g. self.conv1.weight
+   */
+  std::string name;
+
+  /**
+   * Operator consuming the weight
+   */
+  std::string op;
+
+  /**
+   * Shape of the weight
+   */
+  std::vector<int64_t> shape;
+
+  /**
+   * Fraction of the weight that is zero
+   */
+  double zero_fraction = 0.0;
+
+  /**
+   * Every group of four consecutive input channels holds at most two non zero values, which TensorRT requires to pick
+   * sparse tactics for the layer
+   */
+  bool is_2_4_sparse = false;
+};
+
+/**
+ * @brief 2:4 structured sparsity of the weights of a module and of the TensorRT layers built from them
+ */
+struct SparsityReport {
+  /**
+   * Weights of the convolutions and fully connected layers of the lowered graph, in graph order
+   */
+  std::vector<WeightSparsity> weights;
+
+  /**
+   * Layers of the TensorRT engines of a compiled module that run sparse tactics ("<engine>: <layer>"), filled by
+   * find_sparse_layers
+   */
+  std::vector<std::string> sparse_engine_layers;
+
+  /**
+   * @brief Serialize the report as JSON
+   */
+  TORCHTRT_API std::string to_json() const;
+};
+
+/**
+ * @brief Check the conv and linear weights of a module for 2:4 structured sparsity
+ *
+ * @param module: torch::jit::Module - Existing TorchScript module
+ * @param info: torch_tensorrt::CompileSpec - Compilation settings, the weights are checked after lowering with them
+ *
+ * Only 2:4 sparse weights run sparse tactics when sparse_weights is enabled
+ *
+ * @return: torch_tensorrt::SparsityReport with the sparsity of every weight
+ */
+TORCHTRT_API SparsityReport check_sparsity(const torch::jit::Module& module, CompileSpec info);
+
+/**
+ * @brief Prune the weights of the Conv1d/2d/3d and Linear submodules of a module to 2:4 structured sparsity
+ *
+ * @param module: torch::jit::Module - Existing TorchScript module, its weights are modified in place
+ *
+ * Keeps the two values of largest magnitude of every group of four input channels. Pruning changes the results of
+ * the module, its accuracy should be checked (or the module fine tuned) afterwards
+ *
+ * @return: Number of weights pruned
+ */
+TORCHTRT_API int64_t prune_2_4(torch::jit::Module& module);
+
+/**
+ * @brief Find the layers of the TensorRT engines of a compiled module that run sparse tactics
+ *
+ * @param compiled_module: torch::jit::Module - Module returned by compile, built with sparse_weights enabled
+ * @param report: torch_tensorrt::SparsityReport - sparse_engine_layers is set to the sparse layers
+ */
+TORCHTRT_API void find_sparse_layers(const torch::jit::Module& compiled_module, SparsityReport& report);
+
+/**
+ * @brief Performance problem found in the layers of a TensorRT engine
+ */
+struct EngineLintFinding {
+  /**
+   * Name of the engine
+   */
+  std::string engine;
+
+  /**
+   * One of "reformat" (a copy or format conversion TensorRT inserted), "fp32_layer" (a layer computing in FP32 while
+   * FP16 is enabled), "unfused_elementwise" (a chain of elementwise layers TensorRT did not fuse), "shape_subgraph"
+   * (layers computing shape tensors on the host) or "plugin"
+   */
+  std::string kind;
+
+  /**
+   * Names of the engine layers involved
+   */
+  std::vector<std::string> layers;
+
+  /**
+   * Description of the problem
+   */
+  std::string message;
+
+  /**
+   * TorchScript nodes the layers were converted from, i.e. the converters to look at
+   */
+  std::vector<std::string> nodes;
+
+  /**
+   * Average time of the layers per execution in milliseconds, -1 if the engine was not profiled
+   */
+  double time_ms = -1;
+};
+
+/**
+ * @brief Performance problems found in the layers of the TensorRT engines of a compiled module
+ */
+struct EngineLintReport {
+  /**
+   * Findings of all engines, slowest first for profiled engines
+   */
+  std::vector<EngineLintFinding> findings;
+
+  /**
+   * @brief Serialize the report as JSON
+   */
+  TORCHTRT_API std::string to_json() const;
+};
+
+/**
+ * @brief Check the layers of the TensorRT engines of a compiled module for performance problems
+ *
+ * @param compiled_module: torch::jit::Module - Module returned by compile, built with detailed_layer_info enabled
+ * @param info: torch_tensorrt::CompileSpec - Settings the module was compiled with, FP32 layers are flagged if half
+ * is an enabled precision
+ * @param profile_inputs: std::vector<at::Tensor> - If set, the module is run on these inputs with profiling enabled
+ * and the findings are ranked by the time of their layers
+ *
+ * Parses the engine inspector output and maps each problem back to the TorchScript nodes the layers came from
+ *
+ * @return: torch_tensorrt::EngineLintReport with the problems found
+ */
+TORCHTRT_API EngineLintReport lint_engines(
+    const torch::jit::Module& compiled_module,
+    CompileSpec info,
+    std::vector<at::Tensor> profile_inputs = {});
+
+/**
+ * @brief Compile a TorchScript method for NVIDIA GPUs using TensorRT
+ *
+ * @param module: torch::jit::Module - Existing TorchScript module
+ * @param method_name: std::string - Name of method to compile
+ * @param info: torch_tensorrt::CompileSpec - Compilation settings
+ *
+ * Takes a existing TorchScript module and a set of settings to configure the
+ * compiler and will convert selected method to a serialized TensorRT engine
+ * which can be run with TensorRT
+ *
+ * @return: std::string: Serialized TensorRT engine equivilant to the method
+ * graph
+ */
+TORCHTRT_API std::string convert_method_to_trt_engine(
+    const torch::jit::Module& module,
+    std::string method_name,
+    CompileSpec info);
+
+/**
+ * @brief Take a previously created TensorRT engine and embed it in
+ * in a TorchScript module
+ *
+ * @param engine: std::string - Pre-built serialized TensorRT engine
+ * @param device: CompileSepc::Device - Device information
+ * @param input_binding_names: std::vector<std::string> - Name of TensorRT bindings in order passed in by original
+ * PyTorch function (defaults to assuming convention below)
+ * @param output_binding_names: std::vector<std::string> - Name of TensorRT bindings in order returned by original
+ * PyTorch function (defaults to assuming convention below)
+ *
+ * Takes a pre-built serialized TensorRT engine and embeds it in a TorchScript
+ * module. Registers execution of the engine as the forward method of the module
+ * Forward is defined as: forward(Tensor[]) -> Tensor[]
+ *
+ * If binding names not specified TensorRT bindings must have names with the following format:
+ * - [symbol].[index in input / output array]
+ * ex.
+ * - [x.0, x.1, x.2] -> [y.0]
+ *
+ * @return: A new module targeting a TensorRT engine
+ */
+TORCHTRT_API torch::jit::Module embed_engine_in_new_module(
+    const std::string& engine,
+    Device device,
+    const std::vector<std::string>& input_binding_names = std::vector<std::string>(),
+    const std::vector<std::string>& output_binding_names = std::vector<std::string>());
+
+/**
+ * @brief Load a TorchScript module containing TensorRT engines, deserializing the engines concurrently
+ *
+ * @param path: std::string - Path to the serialized module
+ * @param num_threads: int64_t - Number of threads used to deserialize engines (0: one per hardware thread)
+ *
+ * Engines are deserialized on a thread pool sharing a single TensorRT runtime once the module has been unpickled,
+ * instead of one after another while unpickling. Should not be called concurrently with other module loads
+ *
+ * @return: The loaded module with all engines ready to execute
+ */
+TORCHTRT_API torch::jit::Module load(const std::string& path, int64_t num_threads = 0);
+
+/**
+ * @brief Merge modules compiled from the same program for different GPU architectures into one module
+ *
+ * @param module_paths: std::vector<std::string> - Paths of the serialized modules, each compiled for another GPU
+ *
+ * Each TensorRT engine of the returned module bundles the engines built for every module, the engine built for the SM
+ * of the GPU the module is loaded on is selected when it is deserialized. Hardware compatible engines are only
+ * selected if no engine was built for the SM of an available GPU. Engines are not deserialized while bundling, so
+ * modules compiled for GPUs this machine does not have can be bundled. Modules must be compiled with the same
+ * settings so that their engines match one to one
+ *
+ * @return: The module at the first path with bundled engines, to be saved with torch::jit::Module::save
+ */
+TORCHTRT_API torch::jit::Module bundle_engines(const std::vector<std::string>& module_paths);
+
+/**
+ * @brief Switch a loaded module to the TensorRT engines of another module compiled from the same program
+ *
+ * @param module: torch::jit::Module - Module compiled by Torch-TensorRT which keeps serving
+ * @param replacement: torch::jit::Module - Module compiled from the same program with the same settings, e.g. loaded
+ * with new weights on a background thread
+ * @param warmup_iterations: int64_t - Executions of each engine of replacement per profile shape before it is swapped
+ * in, see TRTEngine::warmup. 0 only deserializes the engines
+ *
+ * Each engine of module exchanges its TensorRT engine with the matching engine of replacement once the in-flight
+ * executions of both have finished, executions started afterwards run the new engine. Runtime settings such as
+ * CUDA graphs, pre-allocated outputs or execution context pools stay with module. replacement holds the previous
+ * engines afterwards: swap again to roll back, or drop replacement to release them. Engines are swapped one by one,
+ * an execution of module in flight during the swap may run its earlier engines before and later ones after their swap
+ */
+TORCHTRT_API void swap_engines(
+    const torch::jit::Module& module,
+    const torch::jit::Module& replacement,
+    int64_t warmup_iterations = 0);
+
+/**
+ * @brief Size of the weights the TensorRT engines of a compiled module can stream from host memory
+ *
+ * @param module: torch::jit::Module - Module compiled with weight_streaming enabled
+ *
+ * @return: Streamable weights in bytes, 0 if no engine of the module was built with weight streaming
+ */
+TORCHTRT_API int64_t get_streamable_weights_size(const torch::jit::Module& module);
+
+/**
+ * @brief Device memory the TensorRT engines of a compiled module currently use for streamable weights
+ *
+ * @param module: torch::jit::Module - Module compiled with weight_streaming enabled
+ *
+ * @return: Weight streaming budget in bytes, summed over the engines of the module
+ */
+TORCHTRT_API int64_t get_weight_streaming_budget(const torch::jit::Module& module);
+
+/**
+ * @brief Set the device memory the TensorRT engines of a compiled module use for streamable weights
+ *
+ * @param module: torch::jit::Module - Module compiled with weight_streaming enabled, loaded or just compiled
+ * @param budget: int64_t - Budget in bytes, split across the engines in proportion to their streamable weights. A
+ * negative budget gives each engine the automatic budget chosen by TensorRT, which engines also start with once they
+ * are deserialized
+ *
+ * A budget of get_streamable_weights_size keeps all weights on the device. The execution contexts of the engines are
+ * recreated, the budget should not be changed while the module runs
+ */
+TORCHTRT_API void set_weight_streaming_budget(torch::jit::Module& module, int64_t budget);
+
+/**
+ * @brief Runtime counters and latency histograms of one TensorRT engine of a compiled module
+ */
+struct EngineRuntimeMetrics {
+  /**
+   * Name of the engine
+   */
+  std::string name;
+
+  /**
+   * Counters since the engine was loaded or its metrics were last reset, e.g. executions, cudagraph_hits, and the
+   * count, total and max of every latency histogram (execute_total_ns, ...)
+   */
+  std::map<std::string, int64_t> counters;
+
+  /**
+   * Bucket counts of the execute, input_setup, output_allocation and enqueue latency histograms. Bucket i counts
+   * samples below bucket_bounds_us[i] microseconds
+   */
+  std::map<std::string, std::vector<int64_t>> latency_histograms;
+};
+
+/**
+ * @brief Runtime metrics of the TensorRT engines of a compiled module
+ *
+ * @param module: torch::jit::Module - Compiled or loaded module
+ *
+ * @return: Metrics of each engine, in the order the engines are registered in the module
+ */
+TORCHTRT_API std::vector<EngineRuntimeMetrics> get_runtime_metrics(const torch::jit::Module& module);
+
+/**
+ * @brief Reset the runtime metrics of the TensorRT engines of a compiled module, e.g. after warming it up
+ */
+TORCHTRT_API void reset_runtime_metrics(const torch::jit::Module& module);
+
+/**
+ * @brief Settings of sampled layer profiling, see enable_layer_sampling
+ */
+struct LayerSamplingOptions {
+  /// Profile 1 in every_n executions, 0 to only profile during the window
+  int64_t every_n = 100;
+  /// Profile every execution for this many milliseconds after sampling is enabled, 0 for no window
+  int64_t window_ms = 0;
+  /// Directory the reports are written to as <engine>_layer_samples_<n>.json, none are written if empty
+  std::string output_dir = "";
+  /// Sampled executions per report, the statistics start over after each report
+  int64_t report_every = 1000;
+  /// Reports kept per engine, n cycles through [0, max_reports)
+  int64_t max_reports = 4;
+};
+
+/**
+ * @brief Profile the layers of a sample of the executions of the TensorRT engines of a compiled module
+ *
+ * Unlike execution profiling, only sampled executions run with the TensorRT profiler attached (which makes them
+ * synchronous) and layer times are accumulated into per layer statistics in memory, so sampling can be left on while
+ * serving traffic. Executions replaying CUDA graphs are not sampled
+ *
+ * @param module: torch::jit::Module - Compiled or loaded module
+ * @param options: LayerSamplingOptions - How executions are sampled and where reports are written
+ */
+TORCHTRT_API void enable_layer_sampling(const torch::jit::Module& module, LayerSamplingOptions options = {});
+
+/**
+ * @brief Stop sampling the layers of the engines of a compiled module, pending statistics are written out
+ */
+TORCHTRT_API void disable_layer_sampling(const torch::jit::Module& module);
+
+/**
+ * @brief Per layer statistics of the current report of each engine of a compiled module
+ *
+ * @return: JSON of the form {"engine": ..., "report": ..., "sampled_executions": ..., "layers": [{"name": ...,
+ * "count": ..., "mean_ms": ..., "min_ms": ..., "max_ms": ...}, ...]} by engine name
+ */
+TORCHTRT_API std::map<std::string, std::string> get_layer_samples(const torch::jit::Module& module);
+
+/**
+ * @brief Enable or disable CUDA graphs for every TensorRT engine of the process
+ *
+ * While enabled, engines record a CUDA graph per input shape on their first execution and replay it afterwards.
+ * Engines with data dependent output shapes always run without CUDA graphs
+ */
+TORCHTRT_API void set_cudagraphs_enabled(bool enabled);
+
+/**
+ * @brief Whether TensorRT engines run with CUDA graphs
+ */
+TORCHTRT_API bool get_cudagraphs_enabled();
+
+/**
+ * @brief Enable or disable multi device safe mode for every TensorRT engine of the process
+ *
+ * While enabled, engines switch to the device they were placed on and move their inputs there, as needed by modules
+ * whose segments run on several GPUs
+ */
+TORCHTRT_API void set_multi_device_safe_mode(bool enabled);
+
+/**
+ * @brief Whether TensorRT engines check the current device before every execution
+ */
+TORCHTRT_API bool get_multi_device_safe_mode();
+
+/**
+ * @brief Only capture CUDA graphs for the input shapes an engine runs often
+ *
+ * @param min_executions: Number of executions of an input shape (per execution context) before a graph is captured
+ * for it, rarer shapes run without a graph. 1: capture on the first execution [Default]
+ * @param window: Only count the executions of a shape among the last window executions of the context. 0: no window
+ * @param max_total_bytes: Stop capturing new graphs while the persistent buffers of the graphs of every engine exceed
+ * this many bytes. 0: no limit
+ */
+TORCHTRT_API void set_cudagraph_admission(int64_t min_executions, int64_t window = 0, int64_t max_total_bytes = 0);
+
+/**
+ * @brief Deserialize the TensorRT engines loaded afterwards with a TensorRT lean runtime library
+ *
+ * @param path: std::string - Path of the lean runtime library (e.g. libnvinfer_lean.so), empty for the full runtime
+ *
+ * The lean runtime runs version compatible engines built with exclude_lean_runtime, including engines built with an
+ * older TensorRT version. Engines loaded lazily can also be given a runtime of their own through their
+ * lean_runtime_path property before their first execution
+ */
+TORCHTRT_API void set_lean_runtime_path(const std::string& path);
+
+/**
+ * @brief Let the runtime of the TensorRT engines loaded afterwards execute the lean runtime embedded in version
+ * compatible engines
+ *
+ * The embedded lean runtime is host code from the engine file, only allow it for trusted engines
+ */
+TORCHTRT_API void set_engine_host_code_allowed(bool allowed);
+
+/**
+ * @brief Make the TensorRT engines of a compiled module reuse the output tensors of previous executions
+ *
+ * @param module: torch::jit::Module - Compiled or loaded module
+ * @param enable: bool - Whether engines keep pre-allocated outputs per input shape instead of allocating new ones
+ *
+ * A set of outputs is only reused once the caller has dropped every reference to it, otherwise it is replaced with a
+ * new allocation
+ */
+TORCHTRT_API void set_pre_allocated_outputs(const torch::jit::Module& module, bool enable);
+
+/**
+ * @brief Record a histogram of the input shapes of every TensorRT engine execution
+ *
+ * Recording takes a lock per execution, enable it while sampling traffic (see EngineHandle::get_input_shape_histogram)
+ */
+TORCHTRT_API void set_record_input_shapes(bool record);
+
+/**
+ * @brief Place the pinned buffers host inputs are staged in on the NUMA node of the engine's GPU
+ *
+ * On multi socket servers, host inputs are otherwise staged in memory of the socket the buffer was first allocated
+ * from, and a transfer from the other socket's memory crosses the socket interconnect. Only buffers allocated after
+ * the call are affected, and only on Linux where the NUMA node of the GPU is known
+ */
+TORCHTRT_API void set_numa_local_host_staging(bool enabled);
+
+/**
+ * @brief Allocate the device memory of TensorRT from the PyTorch caching allocator
+ *
+ * Applies to the TensorRT runtimes and builders created afterwards, so Torch and TensorRT share one memory pool instead
+ * of fragmenting the GPU against each other. Off by default, engines which are already loaded keep their allocator
+ */
+TORCHTRT_API void set_torch_gpu_allocator_enabled(bool enabled);
+
+/**
+ * @brief Input shapes of an engine execution and how many executions had them
+ */
+struct InputShapeSample {
+  /// Shape of each input of the engine, in the order of its input bindings
+  std::vector<std::vector<int64_t>> shapes;
+  int64_t count = 0;
+};
+
+/**
+ * @brief Execution of an engine prepared by EngineHandle::prepare, run with EngineHandle::launch
+ *
+ * The ticket holds one of the execution contexts of the engine from prepare until it is launched or destroyed
+ */
+class TORCHTRT_API ExecutionTicket {
+ public:
+  explicit ExecutionTicket(c10::intrusive_ptr<torch::CustomClassHolder> ticket);
+
+ private:
+  friend class EngineHandle;
+  c10::intrusive_ptr<torch::CustomClassHolder> ticket;
+};
+
+/**
+ * @brief Handle on one TensorRT engine of a compiled module
+ *
+ * Executing the handle calls the engine directly with a vector of tensors, skipping the TorchScript interpreter and the
+ * boxing of inputs and outputs into lists and tuples. The handle shares the engine with the module
+ */
+class TORCHTRT_API EngineHandle {
+ public:
+  explicit EngineHandle(c10::intrusive_ptr<torch::CustomClassHolder> engine);
+
+  /**
+   * @brief Execute the engine on the current CUDA stream
+   *
+   * @param inputs: std::vector<at::Tensor> - Inputs of the engine, in the order of get_input_binding_names. Inputs
+   * bound to a state (see set_state_bindings) are left out
+   *
+   * @return std::vector<at::Tensor> Outputs of the engine, in the order of get_output_binding_names. Outputs bound to
+   * a state are left out
+   */
+  std::vector<at::Tensor> execute(std::vector<at::Tensor> inputs) const;
+
+  /**
+   * @brief Do the host side work of an execution (input validation, shape inference, output allocation and binding)
+   * without enqueueing it
+   *
+   * @param inputs: std::vector<at::Tensor> - Inputs of the engine, as for execute. They must not be modified before
+   * the ticket is launched
+   *
+   * Lets a host thread prepare the next request while the previous one is running. Each ticket holds one of the
+   * execution contexts of the engine (the execution_context_pool_size of the engine, 1 by default) until it is
+   * launched, prepare waits for one to be free, so a thread holding one ticket per context must launch one before
+   * preparing another. Prepared executions run without CUDA graphs, and are not supported for engines with state
+   * bindings or DLA loadables
+   *
+   * @return ExecutionTicket - The prepared execution, to launch with launch
+   */
+  ExecutionTicket prepare(std::vector<at::Tensor> inputs) const;
+
+  /**
+   * @brief Enqueue an execution prepared by prepare
+   *
+   * @param ticket: ExecutionTicket - Ticket returned by prepare, each ticket can be launched once
+   * @param stream: cudaStream_t - Stream to enqueue the execution on, the current CUDA stream if null. The launch is
+   * ordered after the work prepare enqueued on the stream that was current then
+   *
+   * @return std::vector<at::Tensor> Outputs of the engine, ready once stream is past the execution
+   */
+  std::vector<at::Tensor> launch(const ExecutionTicket& ticket, cudaStream_t stream = nullptr) const;
+
+  /**
+   * @brief Feed outputs of the engine back as inputs of its next execution, e.g. the hidden state of a recurrent model
+   *
+   * @param output_names: std::vector<std::string> - Outputs holding the new state
+   * @param input_names: std::vector<std::string> - Input each output is fed back as, with the same dtype and rank
+   *
+   * The states stay on the GPU in two buffers per state which executions alternate between, one read as the input
+   * while the other is written as the output, so they are never copied, also when the engine runs in CUDA graphs.
+   * execute then only takes and returns the other bindings, and executions of the engine are serialized. Engines with
+   * state bindings are not batched, padded to batch buckets or replicated, and must not be run by the module they
+   * belong to since its graph passes every binding. States start at zero, empty names remove the state bindings
+   */
+  void set_state_bindings(std::vector<std::string> output_names, std::vector<std::string> input_names) const;
+
+  /**
+   * @brief Set the states to initial_states, one per state binding in order, or to zeros if empty
+   *
+   * States whose input has a dynamic shape cannot start at zero and must be set before the first execution
+   */
+  void reset_state(std::vector<at::Tensor> initial_states = {}) const;
+
+  /**
+   * @brief Copies of the current states, one per state binding in order
+   */
+  std::vector<at::Tensor> get_state() const;
+
+  /**
+   * @brief Return the given outputs on the host, empty names return every output on the device
+   *
+   * The outputs are copied into pinned memory on the caller's stream as part of the execution instead of a blocking
+   * pageable copy afterwards. They are valid once the caller's stream is past the call, e.g. once an event recorded
+   * on it after execute has completed, so the host can prepare the next request in the meantime
+   */
+  void set_host_outputs(std::vector<std::string> output_names) const;
+
+  /**
+   * @brief Name of the engine attribute in the module
+   */
+  std::string get_name() const;
+
+  std::vector<std::string> get_input_binding_names() const;
+
+  /**
+   * @brief Names of the outputs the engine returns, outputs which are returned as one of the inputs or as an earlier
+   * output are named "alias_of:input_<i>" / "alias_of:output_<j>" and are not bound by the engine
+   */
+  std::vector<std::string> get_output_binding_names() const;
+
+  /**
+   * @brief Input shapes the engine was executed with while recording was enabled (see set_record_input_shapes)
+   */
+  std::vector<InputShapeSample> get_input_shape_histogram() const;
+
+  void reset_input_shape_histogram() const;
+
+ private:
+  c10::intrusive_ptr<torch::CustomClassHolder> engine;
+};
+
+/**
+ * @brief Handles on the TensorRT engines of a compiled module
+ *
+ * @param module: torch::jit::Module - Compiled or loaded module
+ *
+ * @return: Handles in the order the engines are registered in the module and its submodules
+ */
+TORCHTRT_API std::vector<EngineHandle> get_engine_handles(const torch::jit::Module& module);
+
+/**
+ * @brief Handle on the engine of a module running a single TensorRT engine
+ *
+ * @param module: torch::jit::Module - Compiled or loaded module
+ *
+ * @return: The engine if forward only executes it on the module inputs and returns its outputs, as for fully converted
+ * modules with tensor inputs. Executing it is then equivalent to calling forward, with tuple outputs flattened.
+ * std::nullopt for modules with fallback to PyTorch, several engines or input / output collections
+ */
+TORCHTRT_API std::optional<EngineHandle> get_single_engine(const torch::jit::Module& module);
+
+/**
+ * @brief Waits for the engines of a module compiled with background_build
+ *
+ * The background build outlives the compile call, processes should wait for it before exiting
+ *
+ * @param module: torch::jit::Module - Module compiled with background_build
+ *
+ * @return: Whether every TensorRT segment of the module runs its engine, false if a build failed
+ */
+TORCHTRT_API bool wait_for_background_builds(const torch::jit::Module& module);
+
+/**
+ * @brief Derive optimization profiles for the inputs of an engine from the shapes it was executed with
+ *
+ * The recorded shapes are clustered with a k-means over their sizes (e.g. batch size and sequence length) weighted by
+ * how often they occurred. Each cluster becomes one optimization profile spanning its shapes, optimized for the most
+ * frequent of them since TensorRT tunes its kernels for the opt shape. The returned specs can be passed to CompileSpec
+ * to recompile the module, e.g. the module of get_single_engine whose engine inputs are the module inputs
+ *
+ * @param histogram: std::vector<InputShapeSample> - Recorded shapes, see EngineHandle::get_input_shape_histogram
+ * @param num_profiles: int64_t - Maximum number of optimization profiles. Fewer are derived if fewer shapes were seen
+ * @param inputs: std::vector<Input> - Specs the engine was compiled with, their dtype, format and tensor domain are
+ * kept. Empty uses the defaults
+ *
+ * @return: One spec per input, describing every derived profile
+ */
+TORCHTRT_API std::vector<Input> derive_input_profiles(
+    const std::vector<InputShapeSample>& histogram,
+    int64_t num_profiles,
+    const std::vector<Input>& inputs = {});
 } // namespace torchscript
 } // namespace torch_tensorrt
@@ -86,13 +86,34 @@ torchtrt::core::CompileSpec to_internal_compile_spec(CompileSpec external, bool
   for (auto p : external.enabled_precisions) {
     internal.convert_info.engine_settings.enabled_precisions.insert(toTRTDataType(p));
   }
+  for (auto& c : external.layer_precisions) {
+    internal.convert_info.engine_settings.layer_precisions[c.first] = toTRTDataType(c.second);
+  }
+  internal.convert_info.engine_settings.strongly_typed = external.strongly_typed;
+  internal.convert_info.engine_settings.weight_streaming = external.weight_streaming;
 
   internal.convert_info.engine_settings.sparse_weights = external.sparse_weights;
   internal.convert_info.engine_settings.disable_tf32 = external.disable_tf32;
   internal.convert_info.engine_settings.refit = external.refit;
+  internal.convert_info.engine_settings.strip_weights = external.strip_engine_weights;
   internal.convert_info.engine_settings.debug = external.debug;
+  internal.convert_info.engine_settings.detailed_layer_info = external.detailed_layer_info;
   internal.convert_info.engine_settings.truncate_long_and_double = external.truncate_long_and_double;
   internal.convert_info.engine_settings.allow_shape_tensors = external.allow_shape_tensors;
+  internal.share_device_memory = external.share_device_memory;
+  internal.share_cudagraph_pool = external.share_cudagraph_pool;
+  internal.fuse_torch_segments = external.fuse_torch_segments;
+  internal.background_build = external.background_build;
+  internal.plan_segment_activations = external.plan_segment_activations;
+  internal.low_memory = external.low_memory;
+  internal.shared_segment_calibration = external.shared_segment_calibration;
+  for (auto f : external.output_formats) {
+    internal.convert_info.engine_settings.output_formats.push_back(toTRTTensorFormat(f));
+  }
+  internal.convert_info.engine_settings.alias_outputs = external.alias_outputs;
+  internal.segment_boundary_format = toTRTTensorFormat(external.segment_boundary_format);
+  internal.num_build_workers = external.num_build_workers;
+  internal.build_gpu_ids = external.build_gpu_ids;
   internal.convert_info.engine_settings.device.allow_gpu_fallback = external.device.allow_gpu_fallback;
   internal.lower_info.target_device.allow_gpu_fallback = external.device.allow_gpu_fallback;
   internal.partitioning_info.target_device.allow_gpu_fallback = external.device.allow_gpu_fallback;
@@ -109,9 +130,21 @@ torchtrt::core::CompileSpec to_internal_compile_spec(CompileSpec external, bool
 
   internal.partitioning_info.enabled = !external.require_full_compilation;
   internal.partitioning_info.min_block_size = external.min_block_size;
+  internal.partitioning_info.cost_model_partitioning = external.cost_model_partitioning;
+  internal.partitioning_info.op_latency_savings_us = external.op_latency_savings_us;
+  internal.partitioning_info.symbolic_shape_analysis = external.symbolic_shape_analysis;
+  internal.partitioning_info.num_shape_analysis_workers = external.num_shape_analysis_workers;
+  internal.partitioning_info.merge_non_tensor_boundaries = external.merge_non_tensor_boundaries;
+  internal.partitioning_info.bridge_unsupported_ops = external.bridge_unsupported_ops;
+  internal.partitioning_info.concurrent_segment_streams = external.concurrent_segment_streams;
+  internal.partitioning_info.overlap_torch_segments = external.overlap_torch_segments;
+  internal.partitioning_info.share_segment_weights = external.share_segment_weights;
+  internal.partitioning_info.report_path = external.partitioning_report_path;
   internal.partitioning_info.forced_fallback_operators = std::move(external.torch_executed_ops);
   internal.partitioning_info.truncate_long_and_double = external.truncate_long_and_double;
   internal.lower_info.forced_fallback_modules = std::move(external.torch_executed_modules);
+  internal.lower_info.max_unroll_trip_count = external.loop_unroll_max_trip_count;
+  internal.lower_info.max_unroll_body_size = external.loop_unroll_max_body_size;
 
   switch (external.device.device_type) {
     case Device::DeviceType::kDLA:
@@ -145,8 +178,33 @@ torchtrt::core::CompileSpec to_internal_compile_spec(CompileSpec external, bool
   internal.partitioning_info.target_device.gpu_id = external.device.gpu_id;
   internal.partitioning_info.target_device.dla_core = external.device.dla_core;
 
+  for (auto& d : external.segment_devices) {
+    core::ir::Device device;
+    device.device_type =
+        d.device_type == Device::DeviceType::kDLA ? nvinfer1::DeviceType::kDLA : nvinfer1::DeviceType::kGPU;
+    device.gpu_id = d.gpu_id;
+    device.dla_core = d.dla_core;
+    device.allow_gpu_fallback = d.allow_gpu_fallback;
+    internal.partitioning_info.segment_devices.push_back(device);
+  }
+
   internal.convert_info.engine_settings.num_avg_timing_iters = external.num_avg_timing_iters;
+  internal.convert_info.engine_settings.fast_build = external.fast_build;
+  internal.convert_info.engine_settings.max_aux_streams = external.max_aux_streams;
+  internal.convert_info.engine_settings.version_compatible = external.version_compatible;
+  internal.convert_info.engine_settings.exclude_lean_runtime = external.exclude_lean_runtime;
+  internal.convert_info.engine_settings.timing_cache_path = external.timing_cache_path;
+  internal.convert_info.engine_settings.tactic_record_path = external.tactic_record_path;
+  internal.convert_info.engine_settings.tactic_replay_path = external.tactic_replay_path;
+  if (!external.engine_cache_dir.empty()) {
+    internal.convert_info.engine_cache =
+        std::make_shared<core::conversion::DiskEngineCache>(external.engine_cache_dir, external.engine_cache_size);
+  }
+  if (external.previous_module) {
+    internal.previous_module = *external.previous_module;
+  }
   internal.convert_info.engine_settings.workspace_size = external.workspace_size;
+  internal.device_memory_budget = external.device_memory_budget;
   internal.convert_info.engine_settings.dla_sram_size = external.dla_sram_size;
   internal.convert_info.engine_settings.dla_local_dram_size = external.dla_local_dram_size;
   internal.convert_info.engine_settings.dla_global_dram_size = external.dla_global_dram_size;
@@ -0,0 +1,200 @@
+#include "torch_tensorrt/cudagraphs_module.h"
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+#include "ATen/cuda/CUDAEvent.h"
+#include "c10/cuda/CUDAGuard.h"
+#include "c10/cuda/CUDAStream.h"
+
+#include "core/runtime/CudaGraphCache.h"
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace runtime {
+namespace {
+
+void flatten_outputs(const c10::IValue& value, std::vector<at::Tensor>& outputs) {
+  if (value.isTensor()) {
+    outputs.push_back(value.toTensor());
+  } else if (value.isTuple()) {
+    for (const auto& e : value.toTupleRef().elements()) {
+      flatten_outputs(e, outputs);
+    }
+  } else if (value.isList()) {
+    for (const auto& e : value.toListRef()) {
+      flatten_outputs(e, outputs);
+    }
+  } else {
+    TORCHTRT_THROW_ERROR("CudaGraphsModule only supports tensor outputs, found an output of type " << value.tagKind());
+  }
+}
+
+int64_t buffer_bytes(const std::vector<at::Tensor>& buffers) {
+  int64_t nbytes = 0;
+  for (const auto& buffer : buffers) {
+    nbytes += buffer.nbytes();
+  }
+  return nbytes;
+}
+
+} // namespace
+
+struct CudaGraphsModule::Impl {
+  Impl(torch::jit::Module module, int64_t max_graphs, int64_t max_bytes)
+      : module(std::move(module)), max_graphs(max_graphs), max_bytes(max_bytes) {}
+
+  std::vector<at::Tensor> run_eager(const std::vector<at::Tensor>& inputs) {
+    std::vector<c10::IValue> args(inputs.begin(), inputs.end());
+    std::vector<at::Tensor> outputs;
+    flatten_outputs(module.forward(args), outputs);
+    return outputs;
+  }
+
+  // Captures forward on the capture stream reading from copies of inputs, returns false if the module cannot be
+  // captured
+  bool capture(const core::runtime::ShapeKey& key, const std::vector<at::Tensor>& inputs) {
+    TORCHTRT_NVTX_RANGE("torch_tensorrt::whole_graph_cudagraph_capture");
+    core::runtime::CudaGraphCacheEntry entry;
+    for (const auto& in : inputs) {
+      entry.input_buffers.push_back(in.clone());
+    }
+    caller_ready.record(c10::cuda::getCurrentCUDAStream());
+    {
+      // Graphs cannot be captured on the legacy default stream
+      c10::cuda::CUDAStreamGuard stream_guard(capture_stream);
+      caller_ready.block(capture_stream);
+      entry.cudagraph->capture_begin();
+      try {
+        entry.output_buffers = run_eager(entry.input_buffers);
+        entry.cudagraph->capture_end();
+      } catch (const std::exception& e) {
+        try {
+          entry.cudagraph->capture_end();
+        } catch (const std::exception&) {
+        }
+        // Clear the capture error, the eager run of this call already succeeded
+        (void)cudaGetLastError();
+        LOG_WARNING(
+            "Unable to capture the module in a CUDA graph for input shapes " << key << ", running them eagerly: "
+                                                                             << e.what());
+        return false;
+      }
+    }
+    int64_t nbytes = buffer_bytes(entry.input_buffers) + buffer_bytes(entry.output_buffers);
+    auto& cached = graphs.emplace(key);
+    cached = std::move(entry);
+    graphs.commit(cached, nbytes, max_graphs, max_bytes);
+    captures++;
+    LOG_DEBUG("Captured the module in a CUDA graph for input shapes " << key);
+    return true;
+  }
+
+  std::vector<at::Tensor> replay(core::runtime::CudaGraphCacheEntry& entry, const std::vector<at::Tensor>& inputs) {
+    TORCHTRT_NVTX_RANGE("torch_tensorrt::whole_graph_cudagraph_replay");
+    auto caller_stream = c10::cuda::getCurrentCUDAStream();
+    for (size_t i = 0; i < inputs.size(); i++) {
+      entry.input_buffers[i].copy_(inputs[i], true);
+    }
+    caller_ready.record(caller_stream);
+    {
+      c10::cuda::CUDAStreamGuard stream_guard(capture_stream);
+      caller_ready.block(capture_stream);
+      entry.cudagraph->replay();
+      replay_complete.record(capture_stream);
+    }
+    replay_complete.block(caller_stream);
+    // The buffers are overwritten by the next replay
+    std::vector<at::Tensor> outputs;
+    for (const auto& out : entry.output_buffers) {
+      outputs.push_back(out.clone());
+    }
+    return outputs;
+  }
+
+  void set_device(c10::DeviceIndex device) {
+    if (device == capture_device) {
+      return;
+    }
+    graphs.clear();
+    uncapturable.clear();
+    capture_stream = c10::cuda::getStreamFromPool(false, device);
+    // Events are bound to the device they are first recorded on
+    caller_ready = at::cuda::CUDAEvent();
+    replay_complete = at::cuda::CUDAEvent();
+    capture_device = device;
+  }
+
+  torch::jit::Module module;
+  int64_t max_graphs;
+  int64_t max_bytes;
+
+  std::mutex mu;
+  core::runtime::CudaGraphCache graphs;
+  std::atomic<int64_t> captures = {0};
+  // Input shapes the module could not be captured for, which run eagerly
+  std::unordered_set<core::runtime::ShapeKey> uncapturable;
+  c10::DeviceIndex capture_device = -1;
+  c10::cuda::CUDAStream capture_stream = c10::cuda::getDefaultCUDAStream();
+  at::cuda::CUDAEvent caller_ready;
+  at::cuda::CUDAEvent replay_complete;
+};
+
+CudaGraphsModule::CudaGraphsModule(torch::jit::Module module, int64_t max_graphs, int64_t max_bytes) {
+  TORCHTRT_CHECK(max_graphs >= 0, "The max number of CUDA graphs must not be negative, got " << max_graphs);
+  TORCHTRT_CHECK(max_bytes >= 0, "The max bytes of the CUDA graph buffers must not be negative, got " << max_bytes);
+  for (auto& engine : core::runtime::collect_engines(module)) {
+    // Data dependent outputs are (re)allocated while the engine runs, which cannot be captured
+    TORCHTRT_CHECK(
+        !engine->has_data_dependent_outputs,
+        "Engine " << engine->name << " has outputs with data dependent shapes and cannot be captured in a CUDA graph");
+  }
+  impl = std::make_unique<Impl>(std::move(module), max_graphs, max_bytes);
+}
+
+CudaGraphsModule::~CudaGraphsModule() = default;
+
+std::vector<at::Tensor> CudaGraphsModule::forward(std::vector<at::Tensor> inputs) {
+  std::lock_guard<std::mutex> lock(impl->mu);
+  for (size_t i = 0; i < inputs.size(); i++) {
+    TORCHTRT_CHECK(inputs[i].is_cuda(), "Input " << i << " of CudaGraphsModule is not on a CUDA device");
+    inputs[i] = inputs[i].contiguous();
+  }
+  auto device = inputs.size() > 0 ? inputs[0].device().index() : c10::cuda::current_device();
+  c10::cuda::CUDAGuard device_guard(device);
+  impl->set_device(device);
+
+  core::runtime::ShapeKey key(inputs);
+  if (auto entry = impl->graphs.find(key)) {
+    return impl->replay(*entry, inputs);
+  }
+
+  // A first eager run sets the shapes of the engines and lets them and the Torch segments allocate what they keep
+  // outside of the graph
+  auto outputs = impl->run_eager(inputs);
+  if (impl->uncapturable.count(key) == 0 && !impl->capture(key, inputs)) {
+    impl->uncapturable.insert(key);
+  }
+  return outputs;
+}
+
+void CudaGraphsModule::reset() {
+  std::lock_guard<std::mutex> lock(impl->mu);
+  impl->graphs.clear();
+  impl->uncapturable.clear();
+}
+
+int64_t CudaGraphsModule::get_num_graphs() const {
+  return impl->graphs.num_entries;
+}
+
+int64_t CudaGraphsModule::get_num_replays() const {
+  return impl->graphs.hits;
+}
+
+int64_t CudaGraphsModule::get_num_captures() const {
+  return impl->captures;
+}
+
+} // namespace runtime
+} // namespace torch_tensorrt
@@ -0,0 +1,160 @@
+#include "torch_tensorrt/inference_session.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include "c10/cuda/CUDAGuard.h"
+#include "cuda_runtime.h"
+
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+namespace torch_tensorrt {
+namespace runtime {
+namespace {
+
+void flatten_outputs(const c10::IValue& value, std::vector<at::Tensor>& outputs) {
+  if (value.isTensor()) {
+    outputs.push_back(value.toTensor());
+  } else if (value.isTuple()) {
+    for (const auto& e : value.toTupleRef().elements()) {
+      flatten_outputs(e, outputs);
+    }
+  } else if (value.isList()) {
+    for (const auto& e : value.toListRef()) {
+      flatten_outputs(e, outputs);
+    }
+  } else {
+    TORCHTRT_THROW_ERROR("InferenceSession only supports tensor outputs, found an output of type " << value.tagKind());
+  }
+}
+
+} // namespace
+
+struct InferenceSession::Impl {
+  struct Request {
+    std::promise<std::vector<at::Tensor>> promise;
+    // Kept alive until the stream reaches the end of the request
+    std::vector<at::Tensor> inputs;
+    std::vector<at::Tensor> outputs;
+    Impl* session;
+  };
+
+  explicit Impl(torch::jit::Module module)
+      : module(std::move(module)), engine(torch_tensorrt::torchscript::get_single_engine(this->module)) {
+    completer = std::thread(&Impl::complete_requests, this);
+  }
+
+  ~Impl() {
+    {
+      std::unique_lock<std::mutex> lock(mu);
+      cv.wait(lock, [&] { return in_flight == 0; });
+      stop = true;
+    }
+    cv.notify_all();
+    completer.join();
+  }
+
+  // Runs on a CUDA driver thread, which must not call into CUDA. Only hands the request over to the completer
+  static void CUDART_CB on_request_complete(void* data) {
+    auto request = static_cast<Request*>(data);
+    auto session = request->session;
+    {
+      std::lock_guard<std::mutex> lock(session->mu);
+      session->completed.push_back(request);
+    }
+    session->cv.notify_all();
+  }
+
+  void complete_requests() {
+    std::unique_lock<std::mutex> lock(mu);
+    while (true) {
+      cv.wait(lock, [&] { return stop || !completed.empty(); });
+      if (completed.empty()) {
+        return;
+      }
+      std::unique_ptr<Request> request(completed.front());
+      completed.pop_front();
+      lock.unlock();
+      request->promise.set_value(std::move(request->outputs));
+      // Tensors may be freed here, releasing memory to the caching allocator is not allowed in a CUDA callback
+      request.reset();
+      lock.lock();
+      in_flight--;
+      cv.notify_all();
+    }
+  }
+
+  torch::jit::Module module;
+  // Set for modules running a single engine, which is then executed directly instead of through forward
+  std::optional<torch_tensorrt::torchscript::EngineHandle> engine;
+
+  std::mutex mu;
+  std::condition_variable cv;
+  std::deque<Request*> completed;
+  std::atomic<int64_t> in_flight = {0};
+  bool stop = false;
+  std::thread completer;
+};
+
+InferenceSession::InferenceSession(torch::jit::Module module, bool use_caller_stream) {
+  if (use_caller_stream) {
+    for (auto& engine : torch_tensorrt::core::runtime::collect_engines(module)) {
+      engine->use_caller_stream = true;
+    }
+  }
+  impl = std::make_unique<Impl>(std::move(module));
+}
+
+InferenceSession::~InferenceSession() = default;
+
+std::future<std::vector<at::Tensor>> InferenceSession::enqueue(
+    std::vector<at::Tensor> inputs,
+    c10::cuda::CUDAStream stream) {
+  auto request = std::make_unique<Impl::Request>();
+  request->session = impl.get();
+  auto future = request->promise.get_future();
+  try {
+    {
+      c10::cuda::CUDAStreamGuard stream_guard(stream);
+      if (impl->engine) {
+        request->outputs = impl->engine->execute(inputs);
+      } else {
+        std::vector<c10::IValue> args(inputs.begin(), inputs.end());
+        flatten_outputs(impl->module.forward(args), request->outputs);
+      }
+    }
+    request->inputs = std::move(inputs);
+    impl->in_flight++;
+    auto err = cudaLaunchHostFunc(stream.stream(), &Impl::on_request_complete, request.get());
+    if (err != cudaSuccess) {
+      {
+        std::lock_guard<std::mutex> lock(impl->mu);
+        impl->in_flight--;
+      }
+      impl->cv.notify_all();
+      TORCHTRT_THROW_ERROR(
+          "Unable to enqueue the completion of the request on stream " << stream.id() << " ("
+                                                                      << cudaGetErrorString(err) << ")");
+    }
+    // Owned by the completer from now on
+    request.release();
+  } catch (...) {
+    request->promise.set_exception(std::current_exception());
+  }
+  return future;
+}
+
+std::future<std::vector<at::Tensor>> InferenceSession::enqueue(std::vector<at::Tensor> inputs) {
+  return enqueue(std::move(inputs), c10::cuda::getCurrentCUDAStream());
+}
+
+int64_t InferenceSession::get_num_in_flight() const {
+  return impl->in_flight;
+}
+
+} // namespace runtime
+} // namespace torch_tensorrt
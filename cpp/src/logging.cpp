@@ -63,6 +63,26 @@ bool get_is_colored_output_on() {
   return torchtrt::core::util::logging::get_logger().get_is_colored_output_on();
 }
 
+void set_is_async_output_on(bool async_output_on) {
+  torchtrt::core::util::logging::get_logger().set_is_async_output_on(async_output_on);
+}
+
+bool get_is_async_output_on() {
+  return torchtrt::core::util::logging::get_logger().get_is_async_output_on();
+}
+
+void set_max_messages_per_second(uint32_t max_messages_per_second) {
+  torchtrt::core::util::logging::get_logger().set_max_messages_per_second(max_messages_per_second);
+}
+
+uint32_t get_max_messages_per_second() {
+  return torchtrt::core::util::logging::get_logger().get_max_messages_per_second();
+}
+
+void flush() {
+  torchtrt::core::util::logging::get_logger().flush();
+}
+
 void log(Level lvl, std::string msg) {
   torchtrt::core::util::logging::get_logger().log((torchtrt::core::util::logging::LogLevel)(lvl), msg);
 }
@@ -0,0 +1,93 @@
+#include "torch_tensorrt/pipeline_parallel_module.h"
+#include <algorithm>
+#include "ATen/ATen.h"
+
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace runtime {
+namespace {
+
+void flatten_outputs(const c10::IValue& value, std::vector<at::Tensor>& outputs) {
+  if (value.isTensor()) {
+    outputs.push_back(value.toTensor());
+  } else if (value.isTuple()) {
+    for (const auto& e : value.toTupleRef().elements()) {
+      flatten_outputs(e, outputs);
+    }
+  } else if (value.isList()) {
+    for (const auto& e : value.toListRef()) {
+      flatten_outputs(e, outputs);
+    }
+  } else {
+    TORCHTRT_THROW_ERROR(
+        "PipelineParallelModule only supports tensor outputs, found an output of type " << value.tagKind());
+  }
+}
+
+} // namespace
+
+struct PipelineParallelModule::Impl {
+  torch::jit::Module module;
+  int64_t num_micro_batches;
+};
+
+PipelineParallelModule::PipelineParallelModule(torch::jit::Module module, int64_t num_micro_batches) {
+  TORCHTRT_CHECK(num_micro_batches > 0, "PipelineParallelModule needs at least one micro-batch");
+  impl = std::make_unique<Impl>();
+  impl->module = std::move(module);
+  impl->num_micro_batches = num_micro_batches;
+}
+
+PipelineParallelModule::~PipelineParallelModule() = default;
+
+std::vector<at::Tensor> PipelineParallelModule::forward(std::vector<at::Tensor> inputs) {
+  TORCHTRT_CHECK(!inputs.empty(), "PipelineParallelModule needs batched inputs to split into micro-batches");
+  int64_t batch = inputs[0].dim() > 0 ? inputs[0].size(0) : 0;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    TORCHTRT_CHECK(
+        inputs[i].dim() > 0 && inputs[i].size(0) == batch,
+        "Input " << i << " of PipelineParallelModule is not batched like input 0, expected a first dimension of "
+                 << batch);
+  }
+  int64_t num_micro_batches = std::max<int64_t>(1, std::min(impl->num_micro_batches, batch));
+
+  std::vector<std::vector<at::Tensor>> splits;
+  for (const auto& in : inputs) {
+    splits.push_back(in.tensor_split(num_micro_batches, /*dim=*/0));
+  }
+
+  // The micro-batches are only issued here, each stage picks up the next one as soon as it is done with the last
+  std::vector<std::vector<at::Tensor>> micro_outputs(num_micro_batches);
+  for (int64_t m = 0; m < num_micro_batches; m++) {
+    std::vector<c10::IValue> args;
+    for (const auto& split : splits) {
+      args.push_back(split[m].contiguous());
+    }
+    flatten_outputs(impl->module.forward(args), micro_outputs[m]);
+    TORCHTRT_CHECK(
+        micro_outputs[m].size() == micro_outputs[0].size(),
+        "Micro-batch " << m << " of PipelineParallelModule has " << micro_outputs[m].size() << " outputs, expected "
+                       << micro_outputs[0].size());
+  }
+  if (num_micro_batches == 1) {
+    return std::move(micro_outputs[0]);
+  }
+
+  std::vector<at::Tensor> outputs;
+  for (size_t o = 0; o < micro_outputs[0].size(); o++) {
+    std::vector<at::Tensor> parts;
+    for (auto& micro : micro_outputs) {
+      parts.push_back(std::move(micro[o]));
+    }
+    outputs.push_back(at::cat(parts, /*dim=*/0));
+  }
+  return outputs;
+}
+
+int64_t PipelineParallelModule::get_num_micro_batches() const {
+  return impl->num_micro_batches;
+}
+
+} // namespace runtime
+} // namespace torch_tensorrt
@@ -1,4 +1,11 @@
 #include "torch_tensorrt/ptq.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "c10/cuda/CUDAGuard.h"
+#include "c10/cuda/CUDAStream.h"
 #include "torch/torch.h"
 
 namespace torch_tensorrt {
@@ -12,5 +19,177 @@ bool get_batch_impl(void* bindings[], const char* names[], int nbBindings, torch
   return true;
 }
 
+bool bind_device_batch(void* bindings[], const char* names[], int nbBindings, std::vector<torch::Tensor>& batch) {
+  if (batch.size() != static_cast<size_t>(nbBindings)) {
+    std::stringstream ss;
+    ss << "Calibration batch holds " << batch.size() << " tensors but the network has " << nbBindings << " inputs (";
+    for (int i = 0; i < nbBindings; i++) {
+      ss << (i ? ", " : "") << names[i];
+    }
+    ss << "), stopping calibration";
+    logging::log(logging::Level::kERROR, ss.str());
+    return false;
+  }
+  auto device = c10::cuda::current_device();
+  for (int i = 0; i < nbBindings; i++) {
+    auto& t = batch[i];
+    if (!t.is_cuda() || t.device().index() != device) {
+      std::stringstream ss;
+      ss << "Calibration input " << names[i] << " is on " << t.device() << " instead of cuda:" << device
+         << ", stopping calibration";
+      logging::log(logging::Level::kERROR, ss.str());
+      return false;
+    }
+    if (!t.is_contiguous()) {
+      t = t.contiguous();
+    }
+    bindings[i] = t.data_ptr();
+  }
+  // The calibrator executes on a stream of its own, the batch may still be computed on the current one
+  c10::cuda::getCurrentCUDAStream(device).synchronize();
+  return true;
+}
+
+struct BatchPrefetcher::Impl {
+  Impl(EpochStart start_epoch, BatchSource next_batch, size_t depth)
+      : start_epoch(std::move(start_epoch)),
+        next_batch(std::move(next_batch)),
+        depth(std::max<size_t>(depth, 1)),
+        device(c10::cuda::current_device()) {}
+
+  ~Impl() {
+    stop_worker();
+  }
+
+  void produce() {
+    c10::cuda::CUDAGuard device_guard(device);
+    auto stream = c10::cuda::getStreamFromPool(false, device);
+    c10::cuda::CUDAStreamGuard stream_guard(stream);
+    try {
+      start_epoch();
+      std::vector<torch::Tensor> inputs;
+      while (true) {
+        {
+          std::unique_lock<std::mutex> lock(mu);
+          cv.wait(lock, [&] { return stop || ready.size() < depth; });
+          if (stop) {
+            break;
+          }
+        }
+        inputs.clear();
+        if (!next_batch(inputs)) {
+          break;
+        }
+        std::vector<torch::Tensor> staged;
+        for (auto& t : inputs) {
+          auto src = t.is_cuda() || t.is_pinned() ? t : t.pin_memory();
+          auto options = torch::TensorOptions().device(torch::kCUDA, device);
+          staged.push_back(src.to(options, /*non_blocking=*/true).contiguous());
+        }
+        // The calibrator executes on a stream of its own, so the batch has to be on the device before it is handed
+        // out. Only this thread waits, calibration of the previous batch carries on meanwhile
+        stream.synchronize();
+        {
+          std::lock_guard<std::mutex> lock(mu);
+          ready.push_back(std::move(staged));
+        }
+        cv.notify_all();
+      }
+    } catch (const std::exception& e) {
+      std::lock_guard<std::mutex> lock(mu);
+      error = e.what();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mu);
+      epoch_done = true;
+    }
+    cv.notify_all();
+  }
+
+  void stop_worker() {
+    {
+      std::lock_guard<std::mutex> lock(mu);
+      stop = true;
+    }
+    cv.notify_all();
+    if (worker.joinable()) {
+      worker.join();
+    }
+    ready.clear();
+    current.clear();
+    stop = false;
+  }
+
+  bool next(void* bindings[], const char* names[], int nbBindings) {
+    std::unique_lock<std::mutex> lock(mu);
+    if (!worker.joinable()) {
+      epoch_done = false;
+      error.clear();
+      worker = std::thread(&Impl::produce, this);
+    }
+    // TensorRT is done with the previous batch once it asks for the next one
+    current.clear();
+    cv.wait(lock, [&] { return !ready.empty() || epoch_done; });
+    if (ready.empty()) {
+      auto err = error;
+      lock.unlock();
+      worker.join();
+      if (!err.empty()) {
+        logging::log(logging::Level::kERROR, "Failed to load calibration batch: " + err);
+      }
+      return false;
+    }
+    current = std::move(ready.front());
+    ready.pop_front();
+    lock.unlock();
+    cv.notify_all();
+
+    if (current.size() != static_cast<size_t>(nbBindings)) {
+      std::stringstream ss;
+      ss << "Calibration batch holds " << current.size() << " tensors but the network has " << nbBindings
+         << " inputs (";
+      for (int i = 0; i < nbBindings; i++) {
+        ss << (i ? ", " : "") << names[i];
+      }
+      ss << "), stopping calibration";
+      logging::log(logging::Level::kERROR, ss.str());
+      stop_worker();
+      return false;
+    }
+    for (int i = 0; i < nbBindings; i++) {
+      bindings[i] = current[i].data_ptr();
+    }
+    return true;
+  }
+
+  EpochStart start_epoch;
+  BatchSource next_batch;
+  size_t depth;
+  c10::DeviceIndex device;
+
+  std::mutex mu;
+  std::condition_variable cv;
+  std::deque<std::vector<torch::Tensor>> ready;
+  std::vector<torch::Tensor> current;
+  bool epoch_done = false;
+  bool stop = false;
+  std::string error;
+  std::thread worker;
+};
+
+BatchPrefetcher::BatchPrefetcher(EpochStart start_epoch, BatchSource next_batch, size_t depth)
+    : impl_(std::make_unique<Impl>(std::move(start_epoch), std::move(next_batch), depth)) {}
+
+BatchPrefetcher::~BatchPrefetcher() = default;
+
+bool BatchPrefetcher::next(void* bindings[], const char* names[], int nbBindings) {
+  try {
+    return impl_->next(bindings, names, nbBindings);
+  } catch (const std::exception& e) {
+    logging::log(logging::Level::kERROR, std::string("Failed to get calibration batch: ") + e.what());
+    return false;
+  }
+}
+
 } // namespace ptq
 } // namespace torch_tensorrt
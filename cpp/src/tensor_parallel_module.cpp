@@ -0,0 +1,237 @@
+#include "torch_tensorrt/tensor_parallel_module.h"
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+#include "ATen/cuda/CUDAEvent.h"
+#include "c10/cuda/CUDACachingAllocator.h"
+#include "c10/cuda/CUDAGuard.h"
+#include "c10/cuda/CUDAStream.h"
+
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace runtime {
+namespace {
+
+void flatten_outputs(const c10::IValue& value, std::vector<at::Tensor>& outputs) {
+  if (value.isTensor()) {
+    outputs.push_back(value.toTensor());
+  } else if (value.isTuple()) {
+    for (const auto& e : value.toTupleRef().elements()) {
+      flatten_outputs(e, outputs);
+    }
+  } else if (value.isList()) {
+    for (const auto& e : value.toListRef()) {
+      flatten_outputs(e, outputs);
+    }
+  } else {
+    TORCHTRT_THROW_ERROR(
+        "TensorParallelModule only supports tensor outputs, found an output of type " << value.tagKind());
+  }
+}
+
+} // namespace
+
+struct TensorParallelModule::Impl {
+  struct Rank {
+    torch::jit::Module module;
+    c10::DeviceIndex device;
+    std::vector<at::Tensor> outputs;
+    std::exception_ptr error;
+    at::cuda::CUDAEvent done;
+    std::thread worker;
+  };
+
+  Impl(std::vector<torch::jit::Module> shards, std::vector<c10::DeviceIndex> devices, InitRank init_rank) {
+    for (size_t r = 0; r < shards.size(); r++) {
+      ranks.push_back(std::make_unique<Rank>());
+      ranks[r]->module = std::move(shards[r]);
+      ranks[r]->device = devices[r];
+    }
+    // Ranks set up their communicators concurrently, creating one waits for every rank to join
+    pending = ranks.size();
+    for (size_t r = 0; r < ranks.size(); r++) {
+      ranks[r]->worker = std::thread(&Impl::run_rank, this, r, init_rank);
+    }
+    try {
+      wait_for_ranks();
+    } catch (...) {
+      // The destructor does not run for a partly constructed Impl
+      stop_ranks();
+      throw;
+    }
+  }
+
+  ~Impl() {
+    stop_ranks();
+  }
+
+  void stop_ranks() {
+    {
+      std::lock_guard<std::mutex> lock(mu);
+      stop = true;
+    }
+    cv.notify_all();
+    for (auto& rank : ranks) {
+      if (rank->worker.joinable()) {
+        rank->worker.join();
+      }
+    }
+  }
+
+  void run_rank(size_t r, InitRank init_rank) {
+    auto& rank = *ranks[r];
+    c10::cuda::CUDAGuard device_guard(rank.device);
+    // Each rank enqueues on a stream of its own, the shards only synchronize with each other through their collectives
+    c10::cuda::CUDAStream stream = c10::cuda::getStreamFromPool(false, rank.device);
+    c10::cuda::CUDAStreamGuard stream_guard(stream);
+    try {
+      if (init_rank) {
+        init_rank(static_cast<int64_t>(r), rank.device);
+      }
+    } catch (...) {
+      rank.error = std::current_exception();
+    }
+    finish_rank();
+
+    int64_t seen = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mu);
+        cv.wait(lock, [&] { return stop || generation != seen; });
+        if (stop) {
+          return;
+        }
+        seen = generation;
+      }
+      try {
+        inputs_ready.block(stream);
+        std::vector<c10::IValue> args;
+        for (const auto& in : inputs) {
+          args.push_back(in.to(at::Device(at::kCUDA, rank.device), /*non_blocking=*/true));
+        }
+        rank.outputs.clear();
+        flatten_outputs(rank.module.forward(args), rank.outputs);
+        rank.done.record(stream);
+      } catch (...) {
+        rank.error = std::current_exception();
+      }
+      finish_rank();
+    }
+  }
+
+  void finish_rank() {
+    std::lock_guard<std::mutex> lock(mu);
+    if (--pending == 0) {
+      cv.notify_all();
+    }
+  }
+
+  // Waits for every rank to be done with the current step, rethrows the error of the lowest failed rank
+  void wait_for_ranks() {
+    std::unique_lock<std::mutex> lock(mu);
+    cv.wait(lock, [&] { return pending == 0; });
+    for (size_t r = 0; r < ranks.size(); r++) {
+      if (auto error = std::exchange(ranks[r]->error, nullptr)) {
+        for (auto& rank : ranks) {
+          rank->error = nullptr;
+        }
+        LOG_ERROR("Rank " << r << " of the tensor parallel module failed");
+        std::rethrow_exception(error);
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<Rank>> ranks;
+  // Guards generation, pending and stop, which the workers wait on
+  std::mutex mu;
+  std::condition_variable cv;
+  int64_t generation = 0;
+  size_t pending = 0;
+  bool stop = false;
+
+  // Only one step runs at a time, the inputs are read by the workers until it is done
+  std::mutex forward_mu;
+  std::vector<at::Tensor> inputs;
+  at::cuda::CUDAEvent inputs_ready;
+  c10::DeviceIndex inputs_ready_device = -1;
+};
+
+TensorParallelModule::TensorParallelModule(std::vector<torch::jit::Module> shards, InitRank init_rank) {
+  TORCHTRT_CHECK(!shards.empty(), "TensorParallelModule needs at least one shard");
+  std::vector<c10::DeviceIndex> devices;
+  std::set<c10::DeviceIndex> used;
+  for (size_t r = 0; r < shards.size(); r++) {
+    auto engines = core::runtime::collect_engines(shards[r]);
+    TORCHTRT_CHECK(!engines.empty(), "Shard " << r << " of TensorParallelModule has no TensorRT engines");
+    auto device = static_cast<c10::DeviceIndex>(engines[0]->device_info.id);
+    for (auto& engine : engines) {
+      TORCHTRT_CHECK(
+          engine->device_info.id == device,
+          "The engines of shard " << r << " are on devices " << device << " and " << engine->device_info.id
+                                  << ", each shard must run on one device");
+    }
+    TORCHTRT_CHECK(used.insert(device).second, "Shards of TensorParallelModule share device " << device);
+    devices.push_back(device);
+  }
+  impl = std::make_unique<Impl>(std::move(shards), std::move(devices), std::move(init_rank));
+}
+
+TensorParallelModule::~TensorParallelModule() = default;
+
+std::vector<at::Tensor> TensorParallelModule::forward(std::vector<at::Tensor> inputs) {
+  std::lock_guard<std::mutex> forward_lock(impl->forward_mu);
+  auto caller_stream = c10::cuda::getCurrentCUDAStream();
+  if (impl->inputs_ready_device != caller_stream.device_index()) {
+    // Events are bound to the device they are first recorded on
+    impl->inputs_ready = at::cuda::CUDAEvent();
+    impl->inputs_ready_device = caller_stream.device_index();
+  }
+  impl->inputs = std::move(inputs);
+  impl->inputs_ready.record(caller_stream);
+  {
+    std::lock_guard<std::mutex> lock(impl->mu);
+    impl->pending = impl->ranks.size();
+    impl->generation++;
+  }
+  impl->cv.notify_all();
+  try {
+    impl->wait_for_ranks();
+  } catch (...) {
+    impl->inputs.clear();
+    throw;
+  }
+  impl->inputs.clear();
+
+  // The inputs are read by every rank, the caller may only reuse them once all are done
+  for (auto& rank : impl->ranks) {
+    rank->done.block(caller_stream);
+  }
+  auto outputs = std::move(impl->ranks[0]->outputs);
+  for (auto& out : outputs) {
+    if (out.is_cuda() && out.device().index() == caller_stream.device_index()) {
+      // Allocated on the stream of rank 0 but consumed on the caller's
+      c10::cuda::CUDACachingAllocator::recordStream(out.storage().data_ptr(), caller_stream);
+    }
+  }
+  return outputs;
+}
+
+int64_t TensorParallelModule::get_world_size() const {
+  return static_cast<int64_t>(impl->ranks.size());
+}
+
+std::vector<int64_t> TensorParallelModule::get_devices() const {
+  std::vector<int64_t> devices;
+  for (const auto& rank : impl->ranks) {
+    devices.push_back(rank->device);
+  }
+  return devices;
+}
+
+} // namespace runtime
+} // namespace torch_tensorrt
@@ -1,6 +1,18 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+
 #include "torch/csrc/jit/api/module.h"
+#include "torch/csrc/jit/serialization/import.h"
+#include "torch/cuda.h"
 
 #include "core/compiler.h"
+#include "core/engine_lint.h"
+#include "core/partitioning/partitioning_report.h"
+#include "core/runtime/runtime.h"
+#include "core/sparsity.h"
 #include "core/util/prelude.h"
 
 #include "torch_tensorrt/torch_tensorrt.h"
@@ -24,7 +36,8 @@ std::string convert_method_to_trt_engine(
   // Want to export a much simpler (non TRT header dependent) API so doing the
   // type conversion here
   return torch_tensorrt::core::ConvertGraphToTRTEngine(
-      module, method_name, to_internal_compile_spec(info, /*bool converting_to_trt_engine=*/true));
+             module, method_name, to_internal_compile_spec(info, /*bool converting_to_trt_engine=*/true))
+      .str();
 }
 
 torch::jit::script::Module compile(const torch::jit::script::Module& module, CompileSpec info) {
@@ -34,6 +47,442 @@ torch::jit::script::Module compile(const torch::jit::script::Module& module, Com
   return torch_tensorrt::core::CompileGraph(module, to_internal_compile_spec(info));
 }
 
+torch::jit::script::Module compile(
+    const torch::jit::script::Module& module,
+    CompileSpec info,
+    CompileReport& report) {
+  LOG_DEBUG(get_build_info());
+  auto internal = to_internal_compile_spec(info);
+  internal.profiler = std::make_shared<torch_tensorrt::core::util::CompileProfiler>();
+  internal.device_memory_report = std::make_shared<torch_tensorrt::core::DeviceMemoryBudgetReport>();
+  auto compiled = torch_tensorrt::core::CompileGraph(module, internal);
+  report.phases.clear();
+  for (const auto& r : internal.profiler->records()) {
+    report.phases.push_back({r.phase, r.segment, r.wall_time_ns, r.peak_host_bytes, r.peak_gpu_bytes});
+  }
+  report.engine_memory.clear();
+  for (const auto& e : internal.device_memory_report->engines) {
+    report.engine_memory.push_back({e.budget, e.device_memory});
+  }
+  report.device_memory_budget_met = internal.device_memory_report->met;
+  return compiled;
+}
+
+std::string CompileReport::to_json() const {
+  std::stringstream ss;
+  ss << "[";
+  for (size_t i = 0; i < phases.size(); i++) {
+    const auto& p = phases[i];
+    ss << (i == 0 ? "\n" : ",\n") << "  {\"phase\": \"" << p.phase << "\", \"segment\": \"" << p.segment
+       << "\", \"wall_time_ns\": " << p.wall_time_ns << ", \"peak_host_bytes\": " << p.peak_host_bytes
+       << ", \"peak_gpu_bytes\": " << p.peak_gpu_bytes << "}";
+  }
+  ss << "\n]\n";
+  return ss.str();
+}
+
+DryRunReport dry_run(const torch::jit::script::Module& module, CompileSpec info) {
+  LOG_DEBUG(get_build_info());
+  auto internal = to_internal_compile_spec(info);
+  internal.dry_run_report = std::make_shared<torch_tensorrt::core::partitioning::PartitioningReport>();
+  torch_tensorrt::core::CompileGraph(module, internal);
+
+  const auto& partitioning = *internal.dry_run_report;
+  DryRunReport report;
+  report.boundary_bytes = partitioning.boundary_bytes;
+  for (const auto& block : partitioning.blocks) {
+    for (const auto& seg : block.segments) {
+      DryRunSegment segment;
+      segment.block = block.owner;
+      segment.tensorrt = seg.target == torch_tensorrt::core::partitioning::SegmentedBlock::kTensorRT;
+      segment.num_nodes = static_cast<int64_t>(seg.num_nodes);
+      segment.flops = seg.flops;
+      segment.weight_bytes = seg.weight_bytes;
+      for (const auto& in : seg.inputs) {
+        segment.boundary_bytes += in.crossing ? in.bytes : 0;
+      }
+      report.segments.push_back(segment);
+    }
+  }
+  for (const auto& op : partitioning.fallback_ops) {
+    auto unsupported = op.second.decisions.find(torch_tensorrt::core::partitioning::kUNSUPPORTED);
+    if (unsupported != op.second.decisions.end()) {
+      report.unsupported_ops[op.first] = unsupported->second;
+    }
+  }
+  return report;
+}
+
+std::string DryRunReport::to_json() const {
+  std::stringstream ss;
+  ss << "{\n  \"boundary_bytes\": " << boundary_bytes << ",\n  \"unsupported_ops\": {";
+  size_t i = 0;
+  for (const auto& op : unsupported_ops) {
+    ss << (i++ == 0 ? "\n" : ",\n") << "    \"" << op.first << "\": " << op.second;
+  }
+  ss << "\n  },\n  \"segments\": [";
+  for (i = 0; i < segments.size(); i++) {
+    const auto& seg = segments[i];
+    // Blocks are named by the node owning them, which can contain quotes
+    std::string block;
+    for (auto c : seg.block) {
+      if (c == '"' || c == '\\') {
+        block += '\\';
+      }
+      block += c == '\n' ? ' ' : c;
+    }
+    ss << (i == 0 ? "\n" : ",\n") << "    {\"block\": \"" << block << "\", \"tensorrt\": "
+       << (seg.tensorrt ? "true" : "false") << ", \"num_nodes\": " << seg.num_nodes << ", \"flops\": " << seg.flops
+       << ", \"weight_bytes\": " << seg.weight_bytes << ", \"boundary_bytes\": " << seg.boundary_bytes << "}";
+  }
+  ss << "\n  ]\n}\n";
+  return ss.str();
+}
+
+std::string DryRunReport::to_str() const {
+  int64_t num_trt_segments = 0;
+  for (const auto& seg : segments) {
+    num_trt_segments += seg.tensorrt;
+  }
+  std::stringstream ss;
+  ss << num_trt_segments << " TensorRT and " << segments.size() - num_trt_segments << " PyTorch segments, "
+     << std::fixed << std::setprecision(2) << boundary_bytes / 1e6 << " MB crossing their boundaries per execution"
+     << std::endl;
+  for (size_t i = 0; i < segments.size(); i++) {
+    const auto& seg = segments[i];
+    ss << "  Segment " << i << " (" << seg.block << "): " << (seg.tensorrt ? "TensorRT" : "PyTorch") << ", "
+       << seg.num_nodes << " nodes, " << seg.flops / 1e9 << " GFLOPs, " << seg.boundary_bytes / 1e6
+       << " MB of inputs from the other kind";
+    if (seg.tensorrt) {
+      ss << ", " << seg.weight_bytes / 1e6 << " MB of weights";
+    }
+    ss << std::endl;
+  }
+  if (!unsupported_ops.empty()) {
+    ss << "Unsupported ops:";
+    for (const auto& op : unsupported_ops) {
+      ss << " " << op.first << " (" << op.second << " nodes)";
+    }
+    ss << std::endl;
+  }
+  return ss.str();
+}
+
+SparsityReport check_sparsity(const torch::jit::script::Module& module, CompileSpec info) {
+  auto internal = to_internal_compile_spec(info);
+  SparsityReport report;
+  for (auto& w : torch_tensorrt::core::CheckWeightSparsity(module, "forward", internal.lower_info)) {
+    report.weights.push_back({w.name, w.op, w.shape, w.zero_fraction, w.is_2_4_sparse});
+  }
+  return report;
+}
+
+int64_t prune_2_4(torch::jit::script::Module& module) {
+  return torch_tensorrt::core::PruneWeights2To4(module);
+}
+
+void find_sparse_layers(const torch::jit::script::Module& compiled_module, SparsityReport& report) {
+  report.sparse_engine_layers = torch_tensorrt::core::GetSparseEngineLayers(compiled_module);
+}
+
+std::string SparsityReport::to_json() const {
+  std::stringstream ss;
+  ss << "{\n  \"weights\": [";
+  for (size_t i = 0; i < weights.size(); i++) {
+    const auto& w = weights[i];
+    ss << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << w.name << "\", \"op\": \"" << w.op << "\", \"shape\": [";
+    for (size_t d = 0; d < w.shape.size(); d++) {
+      ss << (d == 0 ? "" : ", ") << w.shape[d];
+    }
+    ss << "], \"zero_fraction\": " << w.zero_fraction << ", \"is_2_4_sparse\": " << (w.is_2_4_sparse ? "true" : "false")
+       << "}";
+  }
+  ss << "\n  ],\n  \"sparse_engine_layers\": [";
+  for (size_t i = 0; i < sparse_engine_layers.size(); i++) {
+    ss << (i == 0 ? "\n" : ",\n") << "    \"" << sparse_engine_layers[i] << "\"";
+  }
+  ss << "\n  ]\n}\n";
+  return ss.str();
+}
+
+namespace {
+std::string json_escape(const std::string& s) {
+  std::stringstream ss;
+  for (auto c : s) {
+    if (c == '"' || c == '\\') {
+      ss << '\\' << c;
+    } else if (c == '\n') {
+      ss << "\\n";
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      ss << ' ';
+    } else {
+      ss << c;
+    }
+  }
+  return ss.str();
+}
+
+void write_json_strings(std::stringstream& ss, const std::vector<std::string>& strings) {
+  ss << "[";
+  for (size_t i = 0; i < strings.size(); i++) {
+    ss << (i == 0 ? "" : ", ") << "\"" << json_escape(strings[i]) << "\"";
+  }
+  ss << "]";
+}
+} // namespace
+
+EngineLintReport lint_engines(
+    const torch::jit::script::Module& compiled_module,
+    CompileSpec info,
+    std::vector<at::Tensor> profile_inputs) {
+  auto internal = to_internal_compile_spec(info);
+  const auto& precisions = internal.convert_info.engine_settings.enabled_precisions;
+  bool half_enabled = precisions.count(nvinfer1::DataType::kHALF) || precisions.count(nvinfer1::DataType::kBF16);
+
+  // Engines which were not profiled already are profiled for one execution and restored afterwards
+  std::vector<c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine>> profiled;
+  auto restore_profiling = [&]() {
+    for (auto& engine : profiled) {
+      engine->disable_profiling();
+    }
+  };
+  std::vector<torch_tensorrt::core::EngineLintFinding> findings;
+  try {
+    if (!profile_inputs.empty()) {
+      for (auto& engine : torch_tensorrt::core::runtime::collect_engines(compiled_module)) {
+        if (!engine->profile_execution) {
+          engine->enable_profiling();
+          profiled.push_back(engine);
+        }
+      }
+      torch::jit::Module mod = compiled_module;
+      mod.forward(std::vector<c10::IValue>(profile_inputs.begin(), profile_inputs.end()));
+      torch::cuda::synchronize();
+    }
+    findings = torch_tensorrt::core::LintEngines(compiled_module, half_enabled);
+  } catch (...) {
+    restore_profiling();
+    throw;
+  }
+  restore_profiling();
+
+  EngineLintReport report;
+  for (auto& f : findings) {
+    report.findings.push_back({f.engine, f.kind, f.layers, f.message, f.nodes, f.time_ms});
+  }
+  return report;
+}
+
+std::string EngineLintReport::to_json() const {
+  std::stringstream ss;
+  ss << "[";
+  for (size_t i = 0; i < findings.size(); i++) {
+    const auto& f = findings[i];
+    ss << (i == 0 ? "\n" : ",\n") << "  {\"engine\": \"" << json_escape(f.engine) << "\", \"kind\": \"" << f.kind
+       << "\", \"message\": \"" << json_escape(f.message) << "\", \"time_ms\": " << f.time_ms << ", \"layers\": ";
+    write_json_strings(ss, f.layers);
+    ss << ", \"nodes\": ";
+    write_json_strings(ss, f.nodes);
+    ss << "}";
+  }
+  ss << "\n]\n";
+  return ss.str();
+}
+
+std::vector<torch::jit::Module> compile_variants(
+    const torch::jit::Module& module,
+    std::vector<CompileSpec> specs,
+    std::vector<int64_t> gpu_ids) {
+  LOG_DEBUG(get_build_info());
+  std::vector<torch_tensorrt::core::CompileSpec> internal;
+  for (auto& spec : specs) {
+    internal.push_back(to_internal_compile_spec(spec));
+  }
+  return torch_tensorrt::core::CompileVariants(module, internal, gpu_ids);
+}
+
+namespace {
+// Median and mean latency in ms of calling forward iters times, cycling through inputs
+std::pair<double, double> time_forward(
+    torch::jit::Module& mod,
+    const std::vector<std::vector<torch::jit::IValue>>& inputs,
+    int64_t warmup_iters,
+    int64_t iters) {
+  for (int64_t i = 0; i < warmup_iters; i++) {
+    mod.forward(inputs[i % inputs.size()]);
+  }
+  torch::cuda::synchronize();
+  std::vector<double> latencies;
+  for (int64_t i = 0; i < iters; i++) {
+    auto begin = std::chrono::steady_clock::now();
+    mod.forward(inputs[i % inputs.size()]);
+    torch::cuda::synchronize();
+    latencies.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count());
+  }
+  std::sort(latencies.begin(), latencies.end());
+  double total = 0;
+  for (auto l : latencies) {
+    total += l;
+  }
+  return {latencies[latencies.size() / 2], total / latencies.size()};
+}
+
+const char* bool_str(bool b) {
+  return b ? "true" : "false";
+}
+} // namespace
+
+torch::jit::Module autotune(
+    const torch::jit::Module& module,
+    CompileSpec info,
+    const std::vector<std::vector<torch::jit::IValue>>& inputs,
+    AutotuneReport& report,
+    AutotuneOptions options) {
+  TORCHTRT_CHECK(!inputs.empty(), "autotune needs at least one set of inputs to benchmark the configurations on");
+  TORCHTRT_CHECK(options.iters > 0 && options.max_builds > 0, "autotune needs positive iters and max_builds");
+  LOG_DEBUG(get_build_info());
+
+  // Segments which are the same across builds come out of the engine cache, tactics out of the timing cache
+  std::filesystem::path scratch_dir;
+  if (info.engine_cache_dir.empty() || info.timing_cache_path.empty()) {
+    scratch_dir = std::filesystem::temp_directory_path() /
+        ("torch_tensorrt_autotune_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(scratch_dir);
+    if (info.engine_cache_dir.empty()) {
+      info.engine_cache_dir = (scratch_dir / "engines").string();
+    }
+    if (info.timing_cache_path.empty()) {
+      info.timing_cache_path = (scratch_dir / "timing.cache").string();
+    }
+  }
+
+  std::vector<bool> truncate = {info.truncate_long_and_double};
+  if (options.tune_truncate_long_and_double) {
+    truncate.push_back(!info.truncate_long_and_double);
+  }
+  std::vector<bool> cudagraphs = {false};
+  if (options.tune_cudagraphs) {
+    cudagraphs.push_back(true);
+  }
+  std::vector<bool> pre_allocated_outputs = {false};
+  if (options.tune_pre_allocated_outputs) {
+    pre_allocated_outputs.push_back(true);
+  }
+  auto torch_executed_ops = options.torch_executed_ops.empty() ? std::vector<std::vector<std::string>>({{}})
+                                                               : options.torch_executed_ops;
+  auto min_block_sizes =
+      options.min_block_sizes.empty() ? std::vector<uint64_t>({info.min_block_size}) : options.min_block_sizes;
+
+  std::vector<CompileSpec> builds;
+  std::vector<AutotuneCandidate> build_settings;
+  for (auto t : truncate) {
+    for (const auto& ops : torch_executed_ops) {
+      for (auto min_block_size : min_block_sizes) {
+        auto spec = info;
+        spec.truncate_long_and_double = t;
+        spec.torch_executed_ops.insert(spec.torch_executed_ops.end(), ops.begin(), ops.end());
+        spec.min_block_size = min_block_size;
+        AutotuneCandidate settings;
+        settings.min_block_size = min_block_size;
+        settings.torch_executed_ops = spec.torch_executed_ops;
+        settings.truncate_long_and_double = t;
+        builds.push_back(std::move(spec));
+        build_settings.push_back(std::move(settings));
+      }
+    }
+  }
+  if (builds.size() > static_cast<size_t>(options.max_builds)) {
+    LOG_WARNING(
+        "autotune only builds " << options.max_builds << " of " << builds.size() << " candidate configurations");
+    builds.resize(options.max_builds);
+  }
+
+  bool cudagraphs_enabled = get_cudagraphs_enabled();
+  report.candidates.clear();
+  report.best = -1;
+  torch::jit::Module best_mod;
+  for (size_t b = 0; b < builds.size(); b++) {
+    torch::jit::Module trt_mod;
+    double build_time_s = 0;
+    try {
+      auto begin = std::chrono::steady_clock::now();
+      trt_mod = compile(module, builds[b]);
+      build_time_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    } catch (const std::exception& e) {
+      auto failed = build_settings[b];
+      failed.error = e.what();
+      LOG_WARNING("autotune configuration " << b << " failed to compile: " << e.what());
+      report.candidates.push_back(std::move(failed));
+      continue;
+    }
+    for (auto cg : cudagraphs) {
+      for (auto pao : pre_allocated_outputs) {
+        auto candidate = build_settings[b];
+        candidate.cudagraphs = cg;
+        candidate.pre_allocated_outputs = pao;
+        candidate.build_time_s = build_time_s;
+        try {
+          set_cudagraphs_enabled(cg);
+          set_pre_allocated_outputs(trt_mod, pao);
+          std::tie(candidate.p50_latency_ms, candidate.mean_latency_ms) =
+              time_forward(trt_mod, inputs, options.warmup_iters, options.iters);
+        } catch (const std::exception& e) {
+          candidate.error = e.what();
+        }
+        std::stringstream ss;
+        ss << "autotune min_block_size " << candidate.min_block_size << ", " << candidate.torch_executed_ops.size()
+           << " ops in Torch, truncate_long_and_double " << bool_str(candidate.truncate_long_and_double)
+           << ", cudagraphs " << bool_str(cg) << ", pre-allocated outputs " << bool_str(pao) << ": ";
+        if (candidate.error.empty()) {
+          ss << candidate.p50_latency_ms << " ms";
+        } else {
+          ss << candidate.error;
+        }
+        LOG_INFO(ss.str());
+        bool is_best = candidate.error.empty() &&
+            (report.best < 0 || candidate.p50_latency_ms < report.candidates[report.best].p50_latency_ms);
+        report.candidates.push_back(std::move(candidate));
+        if (is_best) {
+          report.best = report.candidates.size() - 1;
+          best_mod = trt_mod;
+        }
+      }
+    }
+  }
+  set_cudagraphs_enabled(cudagraphs_enabled);
+  if (!scratch_dir.empty()) {
+    std::error_code ec;
+    std::filesystem::remove_all(scratch_dir, ec);
+  }
+
+  TORCHTRT_CHECK(
+      report.best >= 0, "None of the autotune configurations compiled and ran, see the errors of the report");
+  set_pre_allocated_outputs(best_mod, report.candidates[report.best].pre_allocated_outputs);
+  return best_mod;
+}
+
+std::string AutotuneReport::to_json() const {
+  std::stringstream ss;
+  ss << "{\"best\": " << best << ", \"candidates\": [";
+  for (size_t i = 0; i < candidates.size(); i++) {
+    const auto& c = candidates[i];
+    ss << (i == 0 ? "\n" : ",\n") << "  {\"min_block_size\": " << c.min_block_size << ", \"torch_executed_ops\": ";
+    write_json_strings(ss, c.torch_executed_ops);
+    ss << ", \"truncate_long_and_double\": " << bool_str(c.truncate_long_and_double)
+       << ", \"cudagraphs\": " << bool_str(c.cudagraphs)
+       << ", \"pre_allocated_outputs\": " << bool_str(c.pre_allocated_outputs)
+       << ", \"build_time_s\": " << c.build_time_s << ", \"p50_latency_ms\": " << c.p50_latency_ms
+       << ", \"mean_latency_ms\": " << c.mean_latency_ms << ", \"error\": \"" << json_escape(c.error) << "\"}";
+  }
+  ss << "\n]}\n";
+  return ss.str();
+}
+
+void refit(torch::jit::script::Module& compiled_module, const torch::jit::script::Module& new_module, CompileSpec info) {
+  LOG_DEBUG(get_build_info());
+  torch_tensorrt::core::RefitGraph(compiled_module, new_module, to_internal_compile_spec(info));
+}
+
 torch::jit::Module embed_engine_in_new_module(
     const std::string& engine,
     Device device,
@@ -43,6 +492,290 @@ torch::jit::Module embed_engine_in_new_module(
       engine, to_internal_rt_device(device), input_binding_names, output_binding_names);
 }
 
+torch::jit::Module load(const std::string& path, int64_t num_threads) {
+  // Engines are only collected while unpickling, deserialization happens afterwards on the loader threads
+  bool lazy = torch_tensorrt::core::runtime::LAZY_ENGINE_DESERIALIZATION;
+  torch_tensorrt::core::runtime::LAZY_ENGINE_DESERIALIZATION = true;
+  torch::jit::Module mod;
+  try {
+    mod = torch::jit::load(path);
+  } catch (...) {
+    torch_tensorrt::core::runtime::LAZY_ENGINE_DESERIALIZATION = lazy;
+    throw;
+  }
+  torch_tensorrt::core::runtime::LAZY_ENGINE_DESERIALIZATION = lazy;
+
+  torch_tensorrt::core::runtime::load_engines(mod, num_threads);
+  return mod;
+}
+
+torch::jit::Module bundle_engines(const std::vector<std::string>& module_paths) {
+  TORCHTRT_CHECK(!module_paths.empty(), "No modules to bundle");
+  // Engines are kept serialized, those built for GPUs this machine does not have included
+  bool lazy = torch_tensorrt::core::runtime::LAZY_ENGINE_DESERIALIZATION;
+  torch_tensorrt::core::runtime::LAZY_ENGINE_DESERIALIZATION = true;
+  torch_tensorrt::core::runtime::LOAD_INCOMPATIBLE_ENGINES = true;
+  std::vector<torch::jit::Module> mods;
+  try {
+    for (const auto& path : module_paths) {
+      mods.push_back(torch::jit::load(path));
+    }
+  } catch (...) {
+    torch_tensorrt::core::runtime::LAZY_ENGINE_DESERIALIZATION = lazy;
+    torch_tensorrt::core::runtime::LOAD_INCOMPATIBLE_ENGINES = false;
+    throw;
+  }
+  torch_tensorrt::core::runtime::LAZY_ENGINE_DESERIALIZATION = lazy;
+  torch_tensorrt::core::runtime::LOAD_INCOMPATIBLE_ENGINES = false;
+
+  std::vector<torch::jit::Module> variants(mods.begin() + 1, mods.end());
+  torch_tensorrt::core::runtime::bundle_engines(mods[0], variants);
+  return mods[0];
+}
+
+void swap_engines(const torch::jit::Module& module, const torch::jit::Module& replacement, int64_t warmup_iterations) {
+  torch_tensorrt::core::runtime::swap_engines(module, replacement, warmup_iterations);
+}
+
+int64_t get_streamable_weights_size(const torch::jit::Module& module) {
+  return torch_tensorrt::core::runtime::get_streamable_weights_size(module);
+}
+
+int64_t get_weight_streaming_budget(const torch::jit::Module& module) {
+  return torch_tensorrt::core::runtime::get_weight_streaming_budget(module);
+}
+
+void set_weight_streaming_budget(torch::jit::Module& module, int64_t budget) {
+  TORCHTRT_CHECK(
+      torch_tensorrt::core::runtime::set_weight_streaming_budget(module, budget),
+      "Unable to set the weight streaming budget of the module to " << budget << "B");
+}
+
+std::vector<EngineRuntimeMetrics> get_runtime_metrics(const torch::jit::Module& module) {
+  std::vector<EngineRuntimeMetrics> metrics;
+  for (auto& engine : torch_tensorrt::core::runtime::collect_engines(module)) {
+    EngineRuntimeMetrics m;
+    m.name = engine->name;
+    for (const auto& c : engine->get_runtime_metrics()) {
+      m.counters[c.key()] = c.value();
+    }
+    for (const auto& h : engine->get_latency_histograms()) {
+      m.latency_histograms[h.key()] = h.value().vec();
+    }
+    metrics.push_back(m);
+  }
+  return metrics;
+}
+
+void reset_runtime_metrics(const torch::jit::Module& module) {
+  for (auto& engine : torch_tensorrt::core::runtime::collect_engines(module)) {
+    engine->reset_runtime_metrics();
+  }
+}
+
+void enable_layer_sampling(const torch::jit::Module& module, LayerSamplingOptions options) {
+  for (auto& engine : torch_tensorrt::core::runtime::collect_engines(module)) {
+    engine->enable_layer_sampling(
+        {options.every_n, options.window_ms, options.output_dir, options.report_every, options.max_reports});
+  }
+}
+
+void disable_layer_sampling(const torch::jit::Module& module) {
+  for (auto& engine : torch_tensorrt::core::runtime::collect_engines(module)) {
+    engine->disable_layer_sampling();
+  }
+}
+
+std::map<std::string, std::string> get_layer_samples(const torch::jit::Module& module) {
+  std::map<std::string, std::string> samples;
+  for (auto& engine : torch_tensorrt::core::runtime::collect_engines(module)) {
+    samples[engine->name] = engine->get_layer_samples();
+  }
+  return samples;
+}
+
+void set_cudagraphs_enabled(bool enabled) {
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE =
+      enabled ? torch_tensorrt::core::runtime::SUBGRAPH_CUDAGRAPHS : torch_tensorrt::core::runtime::STANDARD;
+}
+
+bool get_cudagraphs_enabled() {
+  return torch_tensorrt::core::runtime::CUDAGRAPHS_MODE == torch_tensorrt::core::runtime::SUBGRAPH_CUDAGRAPHS;
+}
+
+void set_multi_device_safe_mode(bool enabled) {
+  torch_tensorrt::core::runtime::set_multi_device_safe_mode(enabled);
+}
+
+bool get_multi_device_safe_mode() {
+  return torch_tensorrt::core::runtime::get_multi_device_safe_mode();
+}
+
+void set_cudagraph_admission(int64_t min_executions, int64_t window, int64_t max_total_bytes) {
+  TORCHTRT_CHECK(
+      min_executions >= 0 && window >= 0 && max_total_bytes >= 0,
+      "CUDA graph admission settings must not be negative");
+  torch_tensorrt::core::runtime::CUDAGRAPH_MIN_EXECUTIONS = min_executions;
+  torch_tensorrt::core::runtime::CUDAGRAPH_ADMISSION_WINDOW = window;
+  torch_tensorrt::core::runtime::CUDAGRAPH_MAX_TOTAL_BYTES = max_total_bytes;
+}
+
+void set_lean_runtime_path(const std::string& path) {
+  torch_tensorrt::core::runtime::LEAN_RUNTIME_PATH = path;
+}
+
+void set_engine_host_code_allowed(bool allowed) {
+  torch_tensorrt::core::runtime::ENGINE_HOST_CODE_ALLOWED = allowed;
+}
+
+void set_record_input_shapes(bool record) {
+  torch_tensorrt::core::runtime::RECORD_INPUT_SHAPES = record;
+}
+
+void set_numa_local_host_staging(bool enabled) {
+  torch_tensorrt::core::runtime::NUMA_LOCAL_HOST_STAGING = enabled;
+}
+
+void set_torch_gpu_allocator_enabled(bool enabled) {
+  torch_tensorrt::core::util::set_torch_gpu_allocator_enabled(enabled);
+}
+
+void set_pre_allocated_outputs(const torch::jit::Module& module, bool enable) {
+  for (auto& engine : torch_tensorrt::core::runtime::collect_engines(module)) {
+    engine->use_pre_allocated_outputs = enable;
+  }
+}
+
+EngineHandle::EngineHandle(c10::intrusive_ptr<torch::CustomClassHolder> engine) : engine(std::move(engine)) {
+  TORCHTRT_CHECK(
+      this->engine && dynamic_cast<torch_tensorrt::core::runtime::TRTEngine*>(this->engine.get()),
+      "EngineHandle must be created from a TensorRT engine");
+}
+
+std::vector<at::Tensor> EngineHandle::execute(std::vector<at::Tensor> inputs) const {
+  return torch_tensorrt::core::runtime::execute_engine(
+      std::move(inputs), c10::static_intrusive_pointer_cast<torch_tensorrt::core::runtime::TRTEngine>(engine));
+}
+
+ExecutionTicket::ExecutionTicket(c10::intrusive_ptr<torch::CustomClassHolder> ticket) : ticket(std::move(ticket)) {
+  TORCHTRT_CHECK(
+      this->ticket && dynamic_cast<torch_tensorrt::core::runtime::ExecutionTicket*>(this->ticket.get()),
+      "ExecutionTicket must be created from a prepared execution");
+}
+
+ExecutionTicket EngineHandle::prepare(std::vector<at::Tensor> inputs) const {
+  return ExecutionTicket(torch_tensorrt::core::runtime::prepare_execution(
+      std::move(inputs), c10::static_intrusive_pointer_cast<torch_tensorrt::core::runtime::TRTEngine>(engine)));
+}
+
+std::vector<at::Tensor> EngineHandle::launch(const ExecutionTicket& ticket, cudaStream_t stream) const {
+  auto prepared = c10::static_intrusive_pointer_cast<torch_tensorrt::core::runtime::ExecutionTicket>(ticket.ticket);
+  auto self = static_cast<torch_tensorrt::core::runtime::TRTEngine*>(engine.get());
+  // Tickets of engines with replicas are prepared on the replica they run on
+  auto prepared_by = [&](const auto& e) { return e.get() == prepared->engine.get(); };
+  TORCHTRT_CHECK(
+      prepared->engine.get() == self || std::any_of(self->replicas.begin(), self->replicas.end(), prepared_by),
+      "The execution ticket was prepared by another engine than " << self->name);
+  return torch_tensorrt::core::runtime::launch_execution(prepared, stream);
+}
+
+void EngineHandle::set_state_bindings(std::vector<std::string> output_names, std::vector<std::string> input_names)
+    const {
+  static_cast<torch_tensorrt::core::runtime::TRTEngine*>(engine.get())
+      ->set_state_bindings(std::move(output_names), std::move(input_names));
+}
+
+void EngineHandle::reset_state(std::vector<at::Tensor> initial_states) const {
+  static_cast<torch_tensorrt::core::runtime::TRTEngine*>(engine.get())->reset_state(std::move(initial_states));
+}
+
+std::vector<at::Tensor> EngineHandle::get_state() const {
+  return static_cast<torch_tensorrt::core::runtime::TRTEngine*>(engine.get())->get_state();
+}
+
+void EngineHandle::set_host_outputs(std::vector<std::string> output_names) const {
+  static_cast<torch_tensorrt::core::runtime::TRTEngine*>(engine.get())->set_host_outputs(std::move(output_names));
+}
+
+std::string EngineHandle::get_name() const {
+  return static_cast<torch_tensorrt::core::runtime::TRTEngine*>(engine.get())->name;
+}
+
+std::vector<std::string> EngineHandle::get_input_binding_names() const {
+  return static_cast<torch_tensorrt::core::runtime::TRTEngine*>(engine.get())->in_binding_names;
+}
+
+std::vector<std::string> EngineHandle::get_output_binding_names() const {
+  return static_cast<torch_tensorrt::core::runtime::TRTEngine*>(engine.get())->returned_output_names();
+}
+
+std::vector<InputShapeSample> EngineHandle::get_input_shape_histogram() const {
+  auto trt_engine = static_cast<torch_tensorrt::core::runtime::TRTEngine*>(engine.get());
+  std::vector<InputShapeSample> histogram;
+  for (auto& sample : trt_engine->input_shapes->samples()) {
+    histogram.push_back({std::move(sample.shapes), sample.count});
+  }
+  return histogram;
+}
+
+void EngineHandle::reset_input_shape_histogram() const {
+  static_cast<torch_tensorrt::core::runtime::TRTEngine*>(engine.get())->reset_input_shape_histogram();
+}
+
+std::vector<EngineHandle> get_engine_handles(const torch::jit::Module& module) {
+  std::vector<EngineHandle> handles;
+  for (auto& engine : torch_tensorrt::core::runtime::collect_engines(module)) {
+    handles.emplace_back(std::move(engine));
+  }
+  return handles;
+}
+
+std::optional<EngineHandle> get_single_engine(const torch::jit::Module& module) {
+  auto engine = torch_tensorrt::core::runtime::get_single_engine(module);
+  if (!engine) {
+    return std::nullopt;
+  }
+  return EngineHandle(std::move(engine));
+}
+
+bool wait_for_background_builds(const torch::jit::Module& module) {
+  bool all_built = true;
+  for (auto& segment : torch_tensorrt::core::runtime::collect_deferred_engine_segments(module)) {
+    all_built &= segment->wait();
+  }
+  return all_built;
+}
+
+std::vector<Input> derive_input_profiles(
+    const std::vector<InputShapeSample>& histogram,
+    int64_t num_profiles,
+    const std::vector<Input>& inputs) {
+  std::vector<torch_tensorrt::core::runtime::InputShapeSample> samples;
+  for (const auto& sample : histogram) {
+    samples.push_back({sample.shapes, sample.count});
+  }
+  auto profiles = torch_tensorrt::core::runtime::derive_shape_profiles(samples, num_profiles);
+  auto num_inputs = profiles[0].opt.size();
+  TORCHTRT_CHECK(
+      inputs.empty() || inputs.size() == num_inputs,
+      "Expected a spec for each of the " << num_inputs << " recorded inputs, got " << inputs.size());
+
+  std::vector<Input> derived;
+  for (size_t i = 0; i < num_inputs; i++) {
+    auto dtype = inputs.empty() ? DataType::kUnknown : inputs[i].dtype;
+    auto format = inputs.empty() ? TensorFormat::kContiguous : inputs[i].format;
+    Input spec(profiles[0].min[i], profiles[0].opt[i], profiles[0].max[i], dtype, format);
+    if (!inputs.empty()) {
+      spec.tensor_domain = inputs[i].tensor_domain;
+    }
+    for (size_t p = 1; p < profiles.size(); p++) {
+      spec.add_profile(profiles[p].min[i], profiles[p].opt[i], profiles[p].max[i]);
+    }
+    derived.push_back(std::move(spec));
+  }
+  return derived;
+}
+
 } // namespace torchscript
 
 std::string get_build_info() {
@@ -25,6 +25,18 @@ std::ostream& operator<<(std::ostream& os, const DataType& dtype) {
     case DataType::kFloat:
       os << "float";
       break;
+    case DataType::kFloat8:
+      os << "float8";
+      break;
+    case DataType::kInt4:
+      os << "int4";
+      break;
+    case DataType::kUInt8:
+      os << "uint8";
+      break;
+    case DataType::kBFloat16:
+      os << "bfloat16";
+      break;
     case DataType::kUnknown:
     default:
       os << "unknown";
@@ -41,6 +53,15 @@ std::ostream& operator<<(std::ostream& os, const TensorFormat& format) {
     case TensorFormat::kContiguous:
       os << "contiguous";
       break;
+    case TensorFormat::kHWC8:
+      os << "channels last padded to 8";
+      break;
+    case TensorFormat::kHWC16:
+      os << "channels last padded to 16";
+      break;
+    case TensorFormat::kDHWC8:
+      os << "3d channels last padded to 8";
+      break;
     case TensorFormat::kUnknown:
     default:
       os << "unknown";
@@ -65,8 +86,12 @@ std::ostream& operator<<(std::ostream& os, const Input& input) {
        << ')';
   } else {
     os << "Input(shape: " << vec_to_str(input.shape) << ", min: " << vec_to_str(input.min_shape)
-       << ", opt: " << vec_to_str(input.opt_shape) << ", max: " << vec_to_str(input.max_shape)
-       << ", dtype: " << input.dtype << ", format: " << input.format << ')';
+       << ", opt: " << vec_to_str(input.opt_shape) << ", max: " << vec_to_str(input.max_shape);
+    for (auto& profile : input.additional_profiles) {
+      os << ", profile: (" << vec_to_str(profile[0]) << ", " << vec_to_str(profile[1]) << ", "
+         << vec_to_str(profile[2]) << ')';
+    }
+    os << ", dtype: " << input.dtype << ", format: " << input.format << ')';
   }
   return os;
 }
@@ -81,6 +106,16 @@ nvinfer1::DataType toTRTDataType(DataType value) {
       return nvinfer1::DataType::kINT32;
     case DataType::kBool:
       return nvinfer1::DataType::kBOOL;
+    case DataType::kFloat8:
+      return nvinfer1::DataType::kFP8;
+#if NV_TENSORRT_MAJOR >= 10
+    case DataType::kInt4:
+      return nvinfer1::DataType::kINT4;
+#endif
+    case DataType::kUInt8:
+      return nvinfer1::DataType::kUINT8;
+    case DataType::kBFloat16:
+      return nvinfer1::DataType::kBF16;
     case DataType::kFloat:
     default:
       return nvinfer1::DataType::kFLOAT;
@@ -101,6 +136,14 @@ at::ScalarType toAtenDataType(DataType value) {
       return at::kDouble;
     case DataType::kBool:
       return at::kBool;
+    case DataType::kFloat8:
+      return at::kFloat8_e4m3fn;
+    case DataType::kUInt8:
+      return at::kByte;
+    case DataType::kBFloat16:
+      return at::kBFloat16;
+    case DataType::kInt4:
+      TORCHTRT_THROW_ERROR("Int4 has no Torch equivalent, it can only be used as an enabled precision");
     case DataType::kFloat:
     case DataType::kUnknown:
     default:
@@ -113,6 +156,12 @@ nvinfer1::TensorFormat toTRTTensorFormat(TensorFormat value) {
   switch (value) {
     case TensorFormat::kChannelsLast:
       return nvinfer1::TensorFormat::kHWC;
+    case TensorFormat::kHWC8:
+      return nvinfer1::TensorFormat::kHWC8;
+    case TensorFormat::kHWC16:
+      return nvinfer1::TensorFormat::kHWC16;
+    case TensorFormat::kDHWC8:
+      return nvinfer1::TensorFormat::kDHWC8;
     case TensorFormat::kContiguous:
     default:
       return nvinfer1::TensorFormat::kLINEAR;
@@ -122,7 +171,8 @@ nvinfer1::TensorFormat toTRTTensorFormat(TensorFormat value) {
 DataType::DataType(c10::ScalarType t) {
   TORCHTRT_CHECK(
       t == at::kHalf || t == at::kFloat || t == at::kChar || t == at::kLong || t == at::kDouble || t == at::kInt ||
-          t == at::kBool,
+          t == at::kBool || t == at::kFloat8_e4m3fn || t == at::kByte ||
+          t == at::kBFloat16,
       "Data type is unsupported (" << t << ")");
   switch (t) {
     case at::kHalf:
@@ -143,6 +193,15 @@ DataType::DataType(c10::ScalarType t) {
     case at::kBool:
       value = DataType::kBool;
       break;
+    case at::kFloat8_e4m3fn:
+      value = DataType::kFloat8;
+      break;
+    case at::kByte:
+      value = DataType::kUInt8;
+      break;
+    case at::kBFloat16:
+      value = DataType::kBFloat16;
+      break;
     case at::kFloat:
     default:
       value = DataType::kFloat;
@@ -411,10 +470,27 @@ Input::Input(at::Tensor tensor) {
   this->tensor_domain = std::vector<double>{0, 2};
 }
 
+Input& Input::add_profile(
+    c10::ArrayRef<int64_t> min_shape,
+    c10::ArrayRef<int64_t> opt_shape,
+    c10::ArrayRef<int64_t> max_shape) {
+  TORCHTRT_CHECK(
+      min_shape.size() == shape.size() && opt_shape.size() == shape.size() && max_shape.size() == shape.size(),
+      "Expected all optimization profiles of an input to have " << shape.size() << " dimensions");
+  additional_profiles.push_back({min_shape.vec(), opt_shape.vec(), max_shape.vec()});
+  for (size_t i = 0; i < shape.size(); i++) {
+    if (shape[i] != min_shape[i] || shape[i] != opt_shape[i] || shape[i] != max_shape[i]) {
+      shape[i] = -1;
+    }
+  }
+  this->input_is_dynamic = true;
+  return *this;
+}
+
 /* ==========================================*/
 
 torch_tensorrt::core::ir::Input to_internal_input(Input& i) {
-  return torch_tensorrt::core::ir::Input(
+  auto internal = torch_tensorrt::core::ir::Input(
       i.min_shape,
       i.opt_shape,
       i.max_shape,
@@ -422,6 +498,10 @@ torch_tensorrt::core::ir::Input to_internal_input(Input& i) {
       toTRTTensorFormat(i.format),
       !(i.dtype == DataType::kUnknown),
       i.tensor_domain);
+  for (auto& profile : i.additional_profiles) {
+    internal.add_profile(profile[0], profile[1], profile[2]);
+  }
+  return internal;
 }
 
 std::vector<torch_tensorrt::core::ir::Input> to_vec_internal_inputs(std::vector<Input>& external) {
@@ -442,6 +522,10 @@ torch_tensorrt::core::runtime::RTDevice to_internal_rt_device(Device device) {
     default:
       device_type = nvinfer1::DeviceType::kGPU;
   }
-  return torch_tensorrt::core::runtime::RTDevice(device.gpu_id, device_type);
+  auto rt_device = torch_tensorrt::core::runtime::RTDevice(device.gpu_id, device_type);
+  if (device_type == nvinfer1::DeviceType::kDLA) {
+    rt_device.dla_core = device.dla_core;
+  }
+  return rt_device;
 }
 } // namespace torch_tensorrt
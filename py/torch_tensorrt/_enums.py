@@ -80,6 +80,12 @@ class dtype(Enum):
     :meta hide-value:
     """
 
+    i4 = auto()
+    """Signed 4 bit integer, equivalent to ``dtype.int4``, as a kernel precision it enables block quantized INT4 weights
+
+    :meta hide-value:
+    """
+
     uint8 = u8
     int8 = i8
 
@@ -91,6 +97,8 @@ class dtype(Enum):
     float8 = f8
     fp8 = f8
 
+    int4 = i4
+
     half = f16
     fp16 = f16
     float16 = f16
@@ -200,6 +208,8 @@ class dtype(Enum):
                 return dtype.b
             elif t == trt.DataType.BF16:
                 return dtype.bf16
+            elif t == trt.DataType.INT4:
+                return dtype.i4
             else:
                 raise TypeError(
                     f"Provided an unsupported data type as a data type for translation (support: bool, int, half, float, bfloat16), got: {t}"
@@ -250,14 +260,22 @@ class dtype(Enum):
                     return dtype.i32
                 elif t == _C.dtype.int8:
                     return dtype.i8
+                elif t == _C.dtype.uint8:
+                    return dtype.u8
                 elif t == _C.dtype.half:
                     return dtype.f16
+                elif t == _C.dtype.bfloat16:
+                    return dtype.bf16
                 elif t == _C.dtype.float:
                     return dtype.f32
                 elif t == _C.dtype.double:
                     return dtype.f64
                 elif t == _C.dtype.bool:
                     return dtype.b
+                elif t == _C.dtype.float8:
+                    return dtype.f8
+                elif t == _C.dtype.int4:
+                    return dtype.i4
                 elif t == _C.dtype.unknown:
                     return dtype.unknown
                 else:
@@ -394,6 +412,8 @@ class dtype(Enum):
                 return trt.DataType.BOOL
             elif self == dtype.bf16:
                 return trt.DataType.BF16
+            elif self == dtype.i4:
+                return trt.DataType.INT4
             elif use_default:
                 return trt.DataType.FLOAT
             else:
@@ -436,16 +456,24 @@ class dtype(Enum):
                     return _C.dtype.long
                 elif self == dtype.i8:
                     return _C.dtype.int8
+                elif self == dtype.u8:
+                    return _C.dtype.uint8
                 elif self == dtype.i32:
                     return _C.dtype.int32
                 elif self == dtype.f16:
                     return _C.dtype.half
+                elif self == dtype.bf16:
+                    return _C.dtype.bfloat16
                 elif self == dtype.f32:
                     return _C.dtype.float
                 elif self == dtype.f64:
                     return _C.dtype.double
                 elif self == dtype.b:
                     return _C.dtype.bool
+                elif self == dtype.f8:
+                    return _C.dtype.float8
+                elif self == dtype.i4:
+                    return _C.dtype.int4
                 elif self == dtype.unknown:
                     return _C.dtype.unknown
                 else:
@@ -723,9 +751,15 @@ class memory_format(Enum):
                     return memory_format.contiguous
                 elif f == _C.TensorFormat.channels_last:
                     return memory_format.channels_last
+                elif f == _C.TensorFormat.hwc8:
+                    return memory_format.hwc8
+                elif f == _C.TensorFormat.hwc16:
+                    return memory_format.hwc16
+                elif f == _C.TensorFormat.dhwc8:
+                    return memory_format.dhwc8
                 else:
                     raise ValueError(
-                        "Provided an unsupported tensor format (support: NCHW/contiguous_format, NHWC/channel_last)"
+                        "Provided an unsupported tensor format (support: NCHW/contiguous_format, NHWC/channel_last, HWC8, HWC16, DHWC8)"
                     )
         # else: # commented out for mypy
         raise TypeError("Provided unsupported source type for memory_format conversion")
@@ -846,9 +880,15 @@ class memory_format(Enum):
                     return _C.TensorFormat.contiguous
                 elif self == memory_format.channels_last:
                     return _C.TensorFormat.channels_last
+                elif self == memory_format.hwc8:
+                    return _C.TensorFormat.hwc8
+                elif self == memory_format.hwc16:
+                    return _C.TensorFormat.hwc16
+                elif self == memory_format.dhwc8:
+                    return _C.TensorFormat.dhwc8
                 else:
                     raise ValueError(
-                        "Provided an unsupported tensor format (support: NCHW/contiguous_format, NHWC/channel_last)"
+                        "Provided an unsupported tensor format (support: NCHW/contiguous_format, NHWC/channel_last, HWC8, HWC16, DHWC8)"
                     )
         # else: # commented out for mypy
         raise TypeError(
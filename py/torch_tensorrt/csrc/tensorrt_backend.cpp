@@ -20,7 +20,6 @@ c10::impl::GenericDict TensorRTBackend::compile(c10::IValue mod_val, c10::impl::
       c10::StringType::get(), c10::getCustomClassType<c10::intrusive_ptr<core::runtime::TRTEngine>>());
 
   for (auto it = spec.begin(), end = spec.end(); it != end; ++it) {
-    auto mod_ = mod.clone();
     const auto& method_name = it->key();
     auto raw_spec = it->value().toCustomClass<torch_tensorrt::pyapi::CompileSpec>();
     LOG_DEBUG(raw_spec->stringify());
@@ -29,7 +28,7 @@ c10::impl::GenericDict TensorRTBackend::compile(c10::IValue mod_val, c10::impl::
     auto convert_cfg = std::move(cfg.convert_info);
     auto device_spec = convert_cfg.engine_settings.device;
     auto device = core::runtime::RTDevice(device_spec.gpu_id, device_spec.device_type);
-    auto serialized_engine = core::ConvertGraphToTRTEngine(mod_, method_name, cfg);
+    auto serialized_engine = core::ConvertGraphToTRTEngine(mod, method_name, cfg);
     auto engine_handle = c10::make_intrusive<core::runtime::TRTEngine>(
         it->key(), serialized_engine, device, std::vector<std::string>(), std::vector<std::string>());
     handles.insert(method_name, at::IValue(engine_handle));
@@ -65,8 +64,10 @@ c10::IValue preprocess(
 #endif
 ) {
   for (auto it = method_compile_spec.begin(), end = method_compile_spec.end(); it != end; ++it) {
+    // Checked under the lowering settings of the spec, so that compile reuses the lowered graph
+    auto raw_spec = it->value().toCustomClass<torch_tensorrt::pyapi::CompileSpec>();
     TORCHTRT_CHECK(
-        core::CheckMethodOperatorSupport(mod, it->key().toStringRef()),
+        core::CheckMethodOperatorSupport(mod, it->key().toStringRef(), raw_spec->toInternalCompileSpec().lower_info),
         "Method " << it->key().toStringRef() << "cannot be compiled by Torch-TensorRT");
   }
   return mod._ivalue();
@@ -20,6 +20,14 @@ std::string to_str(DataType value) {
       return "Long";
     case DataType::kDouble:
       return "Double";
+    case DataType::kFloat8:
+      return "Float8";
+    case DataType::kInt4:
+      return "Int4";
+    case DataType::kUInt8:
+      return "UInt8";
+    case DataType::kBFloat16:
+      return "BFloat16";
     default:
       return "Unknown data type";
   }
@@ -41,6 +49,16 @@ nvinfer1::DataType toTRTDataType(DataType value) {
       return nvinfer1::DataType::kBOOL;
     case DataType::kFloat:
       return nvinfer1::DataType::kFLOAT;
+    case DataType::kFloat8:
+      return nvinfer1::DataType::kFP8;
+#if NV_TENSORRT_MAJOR >= 10
+    case DataType::kInt4:
+      return nvinfer1::DataType::kINT4;
+#endif
+    case DataType::kUInt8:
+      return nvinfer1::DataType::kUINT8;
+    case DataType::kBFloat16:
+      return nvinfer1::DataType::kBF16;
     case DataType::kUnknown:
       return nvinfer1::DataType::kFLOAT;
     default:
@@ -64,6 +82,12 @@ at::ScalarType toAtenDataType(DataType value) {
       return at::kFloat;
     case DataType::kDouble:
       return at::kDouble;
+    case DataType::kFloat8:
+      return at::kFloat8_e4m3fn;
+    case DataType::kUInt8:
+      return at::kByte;
+    case DataType::kBFloat16:
+      return at::kBFloat16;
     case DataType::kUnknown:
       return at::kFloat;
     default:
@@ -82,6 +106,12 @@ nvinfer1::TensorFormat toTRTTensorFormat(TensorFormat value) {
   switch (value) {
     case TensorFormat::kChannelsLast:
       return nvinfer1::TensorFormat::kHWC;
+    case TensorFormat::kHWC8:
+      return nvinfer1::TensorFormat::kHWC8;
+    case TensorFormat::kHWC16:
+      return nvinfer1::TensorFormat::kHWC16;
+    case TensorFormat::kDHWC8:
+      return nvinfer1::TensorFormat::kDHWC8;
     case TensorFormat::kContiguous:
     default:
       return nvinfer1::TensorFormat::kLINEAR;
@@ -94,6 +124,12 @@ std::string to_str(TensorFormat value) {
       return "Contiguous/Linear/NCHW";
     case TensorFormat::kChannelsLast:
       return "Channel Last/NHWC";
+    case TensorFormat::kHWC8:
+      return "Channel Last Padded to 8/HWC8";
+    case TensorFormat::kHWC16:
+      return "Channel Last Padded to 16/HWC16";
+    case TensorFormat::kDHWC8:
+      return "3D Channel Last Padded to 8/DHWC8";
     default:
       return "UNKNOWN";
   }
@@ -214,7 +250,11 @@ nvinfer1::DeviceType toTRTDeviceType(DeviceType value) {
 }
 
 core::runtime::RTDevice Device::toInternalRTDevice() {
-  return core::runtime::RTDevice(gpu_id, toTRTDeviceType(device_type));
+  auto rt_device = core::runtime::RTDevice(gpu_id, toTRTDeviceType(device_type));
+  if (device_type == DeviceType::kDLA) {
+    rt_device.dla_core = dla_core;
+  }
+  return rt_device;
 }
 
 std::string Device::toSerializedRTDevice() {
@@ -263,6 +303,15 @@ std::string TorchFallback::to_str() {
   ss << " {" << std::endl;
   ss << "        \"enabled\": " << e << std::endl;
   ss << "        \"min_block_size\": " << min_block_size << std::endl;
+  ss << "        \"cost_model_partitioning\": " << (cost_model_partitioning ? "True" : "False") << std::endl;
+  ss << "        \"symbolic_shape_analysis\": " << (symbolic_shape_analysis ? "True" : "False") << std::endl;
+  ss << "        \"num_shape_analysis_workers\": " << num_shape_analysis_workers << std::endl;
+  ss << "        \"merge_non_tensor_boundaries\": " << (merge_non_tensor_boundaries ? "True" : "False") << std::endl;
+  ss << "        \"bridge_unsupported_ops\": " << (bridge_unsupported_ops ? "True" : "False") << std::endl;
+  ss << "        \"concurrent_segment_streams\": " << concurrent_segment_streams << std::endl;
+  ss << "        \"overlap_torch_segments\": " << (overlap_torch_segments ? "True" : "False") << std::endl;
+  ss << "        \"share_segment_weights\": " << (share_segment_weights ? "True" : "False") << std::endl;
+  ss << "        \"partitioning_report_path\": " << partitioning_report_path << std::endl;
   ss << "        \"forced_fallback_operators\": [" << std::endl;
   for (auto i : forced_fallback_operators) {
     ss << "            " << i << ',' << std::endl;
@@ -340,6 +389,11 @@ core::CompileSpec CompileSpec::toInternalCompileSpec(bool converting_to_trt_engi
   for (auto p : enabled_precisions) {
     info.convert_info.engine_settings.enabled_precisions.insert(toTRTDataType(p));
   }
+  for (auto& c : layer_precisions) {
+    info.convert_info.engine_settings.layer_precisions[c.first] = toTRTDataType(c.second);
+  }
+  info.convert_info.engine_settings.strongly_typed = strongly_typed;
+  info.convert_info.engine_settings.weight_streaming = weight_streaming;
 
   info.partitioning_info.cast_int8_inputs = true;
 
@@ -357,7 +411,14 @@ core::CompileSpec CompileSpec::toInternalCompileSpec(bool converting_to_trt_engi
   info.convert_info.engine_settings.sparse_weights = sparse_weights;
   info.convert_info.engine_settings.disable_tf32 = disable_tf32;
   info.convert_info.engine_settings.refit = refit;
+  info.convert_info.engine_settings.strip_weights = strip_engine_weights;
+  TORCHTRT_CHECK(
+      loop_unroll_max_trip_count >= 0 && loop_unroll_max_body_size >= 0,
+      "loop_unroll_max_trip_count and loop_unroll_max_body_size must be non negative");
+  info.lower_info.max_unroll_trip_count = loop_unroll_max_trip_count;
+  info.lower_info.max_unroll_body_size = loop_unroll_max_body_size;
   info.convert_info.engine_settings.debug = debug;
+  info.convert_info.engine_settings.detailed_layer_info = detailed_layer_info;
 
   // Specify + replicate device settings for phases requiring it
   info.convert_info.engine_settings.device.device_type = toTRTDeviceType(device.device_type);
@@ -375,19 +436,70 @@ core::CompileSpec CompileSpec::toInternalCompileSpec(bool converting_to_trt_engi
   info.partitioning_info.target_device.dla_core = device.dla_core;
   info.partitioning_info.target_device.allow_gpu_fallback = device.allow_gpu_fallback;
 
+  for (auto& d : segment_devices) {
+    core::ir::Device segment_device;
+    segment_device.device_type = toTRTDeviceType(d.device_type);
+    segment_device.gpu_id = d.gpu_id;
+    segment_device.dla_core = d.dla_core;
+    segment_device.allow_gpu_fallback = d.allow_gpu_fallback;
+    info.partitioning_info.segment_devices.push_back(segment_device);
+  }
+
   info.partitioning_info.enabled = torch_fallback.enabled;
   info.partitioning_info.min_block_size = torch_fallback.min_block_size;
+  info.partitioning_info.cost_model_partitioning = torch_fallback.cost_model_partitioning;
+  info.partitioning_info.op_latency_savings_us = torch_fallback.op_latency_savings_us;
+  info.partitioning_info.symbolic_shape_analysis = torch_fallback.symbolic_shape_analysis;
+  TORCHTRT_CHECK(torch_fallback.num_shape_analysis_workers >= 0, "num_shape_analysis_workers must be 0 or greater");
+  info.partitioning_info.num_shape_analysis_workers = torch_fallback.num_shape_analysis_workers;
+  info.partitioning_info.merge_non_tensor_boundaries = torch_fallback.merge_non_tensor_boundaries;
+  info.partitioning_info.bridge_unsupported_ops = torch_fallback.bridge_unsupported_ops;
+  TORCHTRT_CHECK(torch_fallback.concurrent_segment_streams >= 0, "concurrent_segment_streams must be 0 or greater");
+  info.partitioning_info.concurrent_segment_streams = torch_fallback.concurrent_segment_streams;
+  info.partitioning_info.overlap_torch_segments = torch_fallback.overlap_torch_segments;
+  info.partitioning_info.share_segment_weights = torch_fallback.share_segment_weights;
+  info.partitioning_info.report_path = torch_fallback.partitioning_report_path;
   info.partitioning_info.forced_fallback_operators = torch_fallback.forced_fallback_operators;
   info.partitioning_info.truncate_long_and_double = truncate_long_and_double;
   info.lower_info.forced_fallback_modules = torch_fallback.forced_fallback_modules;
   info.convert_info.engine_settings.truncate_long_and_double = truncate_long_and_double;
   info.convert_info.engine_settings.allow_shape_tensors = allow_shape_tensors;
+  info.share_device_memory = share_device_memory;
+  info.share_cudagraph_pool = share_cudagraph_pool;
+  info.fuse_torch_segments = fuse_torch_segments;
+  info.background_build = background_build;
+  info.plan_segment_activations = plan_segment_activations;
+  info.low_memory = low_memory;
+  info.shared_segment_calibration = shared_segment_calibration;
+  for (auto f : output_formats) {
+    info.convert_info.engine_settings.output_formats.push_back(toTRTTensorFormat(f));
+  }
+  info.segment_boundary_format = toTRTTensorFormat(segment_boundary_format);
+  TORCHTRT_CHECK(num_build_workers >= 0, "num_build_workers must be 0 or greater");
+  info.num_build_workers = num_build_workers;
+  info.build_gpu_ids = build_gpu_ids;
+  info.convert_info.engine_settings.timing_cache_path = timing_cache_path;
+  info.convert_info.engine_settings.tactic_record_path = tactic_record_path;
+  info.convert_info.engine_settings.tactic_replay_path = tactic_replay_path;
+  TORCHTRT_CHECK(engine_cache_size >= 0, "engine_cache_size must be 0 or greater");
+  if (!engine_cache_dir.empty()) {
+    info.convert_info.engine_cache =
+        std::make_shared<core::conversion::DiskEngineCache>(engine_cache_dir, engine_cache_size);
+  }
+  info.previous_module = previous_module;
 
   info.convert_info.engine_settings.capability = toTRTEngineCapability(capability);
   TORCHTRT_CHECK(num_avg_timing_iters >= 0, "num_avg_timing_iters must be 0 or greater");
   info.convert_info.engine_settings.num_avg_timing_iters = num_avg_timing_iters;
+  info.convert_info.engine_settings.fast_build = fast_build;
+  TORCHTRT_CHECK(max_aux_streams >= -1, "max_aux_streams must be -1 (chosen by TensorRT) or greater");
+  info.convert_info.engine_settings.max_aux_streams = max_aux_streams;
+  info.convert_info.engine_settings.version_compatible = version_compatible;
+  info.convert_info.engine_settings.exclude_lean_runtime = exclude_lean_runtime;
   TORCHTRT_CHECK(workspace_size >= 0, "workspace_size must be 0 or greater");
   info.convert_info.engine_settings.workspace_size = workspace_size;
+  TORCHTRT_CHECK(device_memory_budget >= 0, "device_memory_budget must be 0 or greater");
+  info.device_memory_budget = device_memory_budget;
   TORCHTRT_CHECK(
       dla_sram_size >= 4096,
       "DLA managed SRAM size must be at least 4 KiB and must be a power of 2. This defaults to 1 MiB");
@@ -420,19 +532,64 @@ std::string CompileSpec::stringify() {
     ss << to_str(p) << ", ";
   }
   ss << "]" << std::endl;
+  ss << "    \"Layer Precisions\": {";
+  for (auto& c : layer_precisions) {
+    ss << c.first << ": " << to_str(c.second) << ", ";
+  }
+  ss << "}" << std::endl;
+  ss << "    \"Strongly Typed\": " << strongly_typed << std::endl;
+  ss << "    \"Weight Streaming\": " << weight_streaming << std::endl;
   ss << "    \"TF32 Disabled\": " << disable_tf32 << std::endl;
   ss << "    \"Sparsity\": " << sparse_weights << std::endl;
   ss << "    \"Refit\": " << refit << std::endl;
+  ss << "    \"Strip Engine Weights\": " << strip_engine_weights << std::endl;
+  ss << "    \"Loop Unroll Max Trip Count\": " << loop_unroll_max_trip_count << std::endl;
+  ss << "    \"Loop Unroll Max Body Size\": " << loop_unroll_max_body_size << std::endl;
   ss << "    \"Debug\": " << debug << std::endl;
+  ss << "    \"Detailed Layer Info\": " << detailed_layer_info << std::endl;
   ss << "    \"Device\": " << device.to_str() << std::endl;
+  ss << "    \"Segment Devices\": [";
+  for (auto& d : segment_devices) {
+    ss << d.to_str() << ", ";
+  }
+  ss << "]" << std::endl;
   ss << "    \"Engine Capability\": " << to_str(capability) << std::endl;
   ss << "    \"Num Avg Timing Iters\": " << num_avg_timing_iters << std::endl;
+  ss << "    \"Fast Build\": " << fast_build << std::endl;
+  ss << "    \"Max Aux Streams\": " << max_aux_streams << std::endl;
+  ss << "    \"Version Compatible\": " << version_compatible << std::endl;
+  ss << "    \"Exclude Lean Runtime\": " << exclude_lean_runtime << std::endl;
   ss << "    \"Workspace Size\": " << workspace_size << std::endl;
+  ss << "    \"Device Memory Budget\": " << device_memory_budget << std::endl;
   ss << "    \"DLA SRAM Size\": " << dla_sram_size << std::endl;
   ss << "    \"DLA Local DRAM Size\": " << dla_local_dram_size << std::endl;
   ss << "    \"DLA Global DRAM Size\": " << dla_global_dram_size << std::endl;
   ss << "    \"Truncate long and double\": " << truncate_long_and_double << std::endl;
   ss << "    \"Allow Shape tensors\": " << allow_shape_tensors << std::endl;
+  ss << "    \"Share Device Memory\": " << share_device_memory << std::endl;
+  ss << "    \"Share CUDA Graph Pool\": " << share_cudagraph_pool << std::endl;
+  ss << "    \"Fuse Torch Segments\": " << fuse_torch_segments << std::endl;
+  ss << "    \"Background Build\": " << background_build << std::endl;
+  ss << "    \"Plan Segment Activations\": " << plan_segment_activations << std::endl;
+  ss << "    \"Low Memory\": " << low_memory << std::endl;
+  ss << "    \"Shared Segment Calibration\": " << shared_segment_calibration << std::endl;
+  ss << "    \"Output Formats\": [";
+  for (auto f : output_formats) {
+    ss << to_str(f) << ", ";
+  }
+  ss << "]" << std::endl;
+  ss << "    \"Segment Boundary Format\": " << to_str(segment_boundary_format) << std::endl;
+  ss << "    \"Num Build Workers\": " << num_build_workers << std::endl;
+  ss << "    \"Build GPU IDs\": [";
+  for (auto id : build_gpu_ids) {
+    ss << id << ", ";
+  }
+  ss << "]" << std::endl;
+  ss << "    \"Timing Cache Path\": " << timing_cache_path << std::endl;
+  ss << "    \"Tactic Record Path\": " << tactic_record_path << std::endl;
+  ss << "    \"Tactic Replay Path\": " << tactic_replay_path << std::endl;
+  ss << "    \"Engine Cache Dir\": " << engine_cache_dir << std::endl;
+  ss << "    \"Engine Cache Size\": " << engine_cache_size << std::endl;
   ss << "    \"Torch Fallback\": " << torch_fallback.to_str();
   ss << "}";
   return ss.str();
@@ -27,12 +27,25 @@ namespace pyapi {
     return static_cast<int64_t>(field_name);                                    \
   }
 
-enum class DataType : int8_t { kLong, kDouble, kFloat, kHalf, kChar, kInt32, kBool, kUnknown };
+enum class DataType : int8_t {
+  kLong,
+  kDouble,
+  kFloat,
+  kHalf,
+  kChar,
+  kInt32,
+  kBool,
+  kFloat8,
+  kInt4,
+  kUInt8,
+  kBFloat16,
+  kUnknown
+};
 std::string to_str(DataType value);
 nvinfer1::DataType toTRTDataType(DataType value);
 at::ScalarType toAtenDataType(DataType value);
 
-enum class TensorFormat : int8_t { kContiguous, kChannelsLast };
+enum class TensorFormat : int8_t { kContiguous, kChannelsLast, kHWC8, kHWC16, kDHWC8 };
 std::string to_str(TensorFormat value);
 nvinfer1::TensorFormat toTRTTensorFormat(TensorFormat value);
 
@@ -54,7 +67,7 @@ struct Input : torch::CustomClassHolder {
   ADD_FIELD_GET_SET(input_is_dynamic, bool);
   ADD_FIELD_GET_SET(explicit_set_dtype, bool);
   ADD_ENUM_GET_SET(dtype, DataType, static_cast<int64_t>(DataType::kUnknown));
-  ADD_ENUM_GET_SET(format, TensorFormat, static_cast<int64_t>(TensorFormat::kContiguous));
+  ADD_ENUM_GET_SET(format, TensorFormat, static_cast<int64_t>(TensorFormat::kDHWC8));
 
   core::ir::Input toInternalInput();
   std::string to_str();
@@ -101,6 +114,16 @@ nvinfer1::DeviceType toTRTDeviceType(DeviceType value);
 struct TorchFallback : torch::CustomClassHolder {
   bool enabled;
   int64_t min_block_size;
+  bool cost_model_partitioning = false;
+  std::unordered_map<std::string, double> op_latency_savings_us;
+  bool symbolic_shape_analysis = false;
+  int64_t num_shape_analysis_workers = 1;
+  bool merge_non_tensor_boundaries = false;
+  bool bridge_unsupported_ops = false;
+  int64_t concurrent_segment_streams = 0;
+  bool overlap_torch_segments = false;
+  bool share_segment_weights = false;
+  std::string partitioning_report_path;
   std::vector<std::string> forced_fallback_operators;
   std::vector<std::string> forced_fallback_modules;
   TorchFallback() : enabled(false), min_block_size(1) {}
@@ -156,19 +179,49 @@ struct CompileSpec : torch::CustomClassHolder {
     ptq_calibrator = (nvinfer1::IInt8Calibrator*)handle;
   }
 
+  void setPreviousModule(const torch::jit::Module& mod) {
+    previous_module = mod;
+  }
+
   ADD_FIELD_GET_SET(disable_tf32, bool);
   ADD_FIELD_GET_SET(sparse_weights, bool);
   ADD_FIELD_GET_SET(refit, bool);
   ADD_FIELD_GET_SET(debug, bool);
+  ADD_FIELD_GET_SET(detailed_layer_info, bool);
   ADD_ENUM_GET_SET(capability, EngineCapability, static_cast<int64_t>(EngineCapability::kSTANDARD));
   ADD_FIELD_GET_SET(num_avg_timing_iters, int64_t);
+  ADD_FIELD_GET_SET(fast_build, bool);
+  ADD_FIELD_GET_SET(max_aux_streams, int64_t);
+  ADD_FIELD_GET_SET(version_compatible, bool);
+  ADD_FIELD_GET_SET(exclude_lean_runtime, bool);
   ADD_FIELD_GET_SET(workspace_size, int64_t);
+  ADD_FIELD_GET_SET(device_memory_budget, int64_t);
   ADD_FIELD_GET_SET(dla_sram_size, int64_t);
   ADD_FIELD_GET_SET(dla_local_dram_size, int64_t);
   ADD_FIELD_GET_SET(dla_global_dram_size, int64_t);
   ADD_FIELD_GET_SET(truncate_long_and_double, bool);
   ADD_FIELD_GET_SET(allow_shape_tensors, bool);
+  ADD_FIELD_GET_SET(share_device_memory, bool);
+  ADD_FIELD_GET_SET(share_cudagraph_pool, bool);
+  ADD_FIELD_GET_SET(fuse_torch_segments, bool);
+  ADD_FIELD_GET_SET(background_build, bool);
+  ADD_FIELD_GET_SET(plan_segment_activations, bool);
+  ADD_FIELD_GET_SET(low_memory, bool);
+  ADD_FIELD_GET_SET(shared_segment_calibration, bool);
+  ADD_FIELD_GET_SET(output_formats, std::vector<TensorFormat>);
+  ADD_ENUM_GET_SET(segment_boundary_format, TensorFormat, static_cast<int64_t>(TensorFormat::kDHWC8));
+  ADD_FIELD_GET_SET(num_build_workers, int64_t);
+  ADD_FIELD_GET_SET(build_gpu_ids, std::vector<int64_t>);
+  ADD_FIELD_GET_SET(layer_precisions, std::map<std::string, DataType>);
+  ADD_FIELD_GET_SET(strongly_typed, bool);
+  ADD_FIELD_GET_SET(weight_streaming, bool);
+  ADD_FIELD_GET_SET(timing_cache_path, std::string);
+  ADD_FIELD_GET_SET(tactic_record_path, std::string);
+  ADD_FIELD_GET_SET(tactic_replay_path, std::string);
+  ADD_FIELD_GET_SET(engine_cache_dir, std::string);
+  ADD_FIELD_GET_SET(engine_cache_size, int64_t);
   ADD_FIELD_GET_SET(device, Device);
+  ADD_FIELD_GET_SET(segment_devices, std::vector<Device>);
   ADD_FIELD_GET_SET(torch_fallback, TorchFallback);
   ADD_FIELD_GET_SET(ptq_calibrator, nvinfer1::IInt8Calibrator*);
 
@@ -176,17 +229,47 @@ struct CompileSpec : torch::CustomClassHolder {
   InputSignature input_signature;
   nvinfer1::IInt8Calibrator* ptq_calibrator = nullptr;
   std::set<DataType> enabled_precisions = {};
+  std::map<std::string, DataType> layer_precisions;
+  bool strongly_typed = false;
+  bool weight_streaming = false;
   bool sparse_weights = false;
   bool disable_tf32 = false;
   bool refit = false;
+  bool strip_engine_weights = false;
+  int64_t loop_unroll_max_trip_count = 16;
+  int64_t loop_unroll_max_body_size = 32;
   bool debug = false;
+  bool detailed_layer_info = false;
   bool truncate_long_and_double = false;
   bool allow_shape_tensors = false;
+  bool share_device_memory = false;
+  bool share_cudagraph_pool = false;
+  bool fuse_torch_segments = false;
+  bool background_build = false;
+  bool plan_segment_activations = false;
+  bool low_memory = false;
+  bool shared_segment_calibration = false;
+  std::vector<TensorFormat> output_formats;
+  TensorFormat segment_boundary_format = TensorFormat::kContiguous;
+  int64_t num_build_workers = 1;
+  std::vector<int64_t> build_gpu_ids;
+  std::string timing_cache_path = "";
+  std::string tactic_record_path = "";
+  std::string tactic_replay_path = "";
+  std::string engine_cache_dir = "";
+  int64_t engine_cache_size = 5368709120;
+  c10::optional<torch::jit::Module> previous_module = {};
   Device device;
+  std::vector<Device> segment_devices;
   TorchFallback torch_fallback;
   EngineCapability capability = EngineCapability::kSTANDARD;
   int64_t num_avg_timing_iters = 1;
+  bool fast_build = false;
+  int64_t max_aux_streams = -1;
+  bool version_compatible = false;
+  bool exclude_lean_runtime = false;
   int64_t workspace_size = 0;
+  int64_t device_memory_budget = 0;
   int64_t dla_sram_size = 1048576;
   int64_t dla_local_dram_size = 1073741824;
   int64_t dla_global_dram_size = 536870912;
@@ -155,20 +155,27 @@ Device get_current_device() {
   return Device(core::runtime::get_current_device());
 }
 
+// Compilation, lowering and engine building do not touch Python objects, so they run without the GIL and other Python
+// threads keep running meanwhile. The only calls back into Python are the methods of Python calibrators, which take
+// the GIL themselves (see pyCalibratorTrampoline), including from build worker threads
 torch::jit::Module CompileGraph(const torch::jit::Module& mod, CompileSpec& info) {
-  py::gil_scoped_acquire gil;
-  auto trt_mod = core::CompileGraph(mod, info.toInternalCompileSpec());
-  return trt_mod;
+  auto internal_info = info.toInternalCompileSpec();
+  py::gil_scoped_release no_gil;
+  return core::CompileGraph(mod, internal_info);
 }
 
 py::bytes ConvertGraphToTRTEngine(const torch::jit::Module& mod, const std::string& method_name, CompileSpec& info) {
-  py::gil_scoped_acquire gil;
-  auto trt_engine = core::ConvertGraphToTRTEngine(
-      mod, method_name, info.toInternalCompileSpec(/*bool converting_to_trt_engine=*/true));
-  return py::bytes(trt_engine);
+  auto internal_info = info.toInternalCompileSpec(/*bool converting_to_trt_engine=*/true);
+  std::string trt_engine;
+  {
+    py::gil_scoped_release no_gil;
+    trt_engine = core::ConvertGraphToTRTEngine(mod, method_name, internal_info);
+  }
+  return py::bytes(trt_engine.data(), trt_engine.size());
 }
 
 bool CheckMethodOperatorSupport(const torch::jit::Module& module, const std::string& method_name) {
+  py::gil_scoped_release no_gil;
   return core::CheckMethodOperatorSupport(module, method_name);
 }
 
@@ -177,7 +184,10 @@ torch::jit::Module EmbedEngineInNewModule(
     Device& device,
     const std::vector<std::string>& input_binding_names,
     const std::vector<std::string>& output_binding_names) {
-  return core::EmbedEngineInNewModule(engine, device.toInternalRTDevice(), input_binding_names, output_binding_names);
+  std::string serialized_engine = engine;
+  auto rt_device = device.toInternalRTDevice();
+  py::gil_scoped_release no_gil;
+  return core::EmbedEngineInNewModule(serialized_engine, rt_device, input_binding_names, output_binding_names);
 }
 
 std::string get_build_info() {
@@ -212,6 +222,26 @@ bool get_is_colored_output_on() {
   return core::util::logging::get_logger().get_is_colored_output_on();
 }
 
+void set_is_async_output_on(bool async_output_on) {
+  core::util::logging::get_logger().set_is_async_output_on(async_output_on);
+}
+
+bool get_is_async_output_on() {
+  return core::util::logging::get_logger().get_is_async_output_on();
+}
+
+void set_max_messages_per_second(uint32_t max_messages_per_second) {
+  core::util::logging::get_logger().set_max_messages_per_second(max_messages_per_second);
+}
+
+uint32_t get_max_messages_per_second() {
+  return core::util::logging::get_logger().get_max_messages_per_second();
+}
+
+void flush() {
+  core::util::logging::get_logger().flush();
+}
+
 void log(core::util::logging::LogLevel lvl, const std::string& msg) {
   std::string m;
   m.assign(msg);
@@ -247,13 +277,17 @@ PYBIND11_MODULE(_C, m) {
       .value("float32", DataType::kFloat, "32 bit floating point number")
       .value("half", DataType::kHalf, "16 bit floating point number")
       .value("float16", DataType::kHalf, "16 bit floating point number")
+      .value("bfloat16", DataType::kBFloat16, "16 bit brain floating point number")
       .value("int8", DataType::kChar, "8 bit integer number")
+      .value("uint8", DataType::kUInt8, "8 bit unsigned integer number, only for inputs")
       .value("int32", DataType::kInt32, "32 bit integer number")
       .value("long", DataType::kLong, "64 bit integer number")
       .value("int64", DataType::kLong, "64 bit integer number")
       .value("double", DataType::kDouble, "64 bit floating point number")
       .value("float64", DataType::kDouble, "64 bit floating point number")
       .value("bool", DataType::kBool, "Boolean value")
+      .value("float8", DataType::kFloat8, "8 bit floating point number (E4M3)")
+      .value("int4", DataType::kInt4, "4 bit integer number, only for block quantized weights")
       .value("unknown", DataType::kUnknown, "Unknown data type")
       .export_values();
 
@@ -273,6 +307,10 @@ PYBIND11_MODULE(_C, m) {
   py::enum_<TensorFormat>(m, "TensorFormat", "Enum to specify the memory layout of tensors")
       .value("contiguous", TensorFormat::kContiguous, "Contiguous memory layout (NCHW / Linear)")
       .value("channels_last", TensorFormat::kChannelsLast, "Channels last memory layout (NHWC)")
+      .value("hwc8", TensorFormat::kHWC8, "Channels last memory layout with the channels padded to a multiple of 8")
+      .value("hwc16", TensorFormat::kHWC16, "Channels last memory layout with the channels padded to a multiple of 16")
+      .value(
+          "dhwc8", TensorFormat::kDHWC8, "3D channels last memory layout with the channels padded to a multiple of 8")
       .export_values();
 
   py::enum_<nvinfer1::CalibrationAlgoType>(m, "CalibrationAlgo", py::module_local(), "Type of calibration algorithm")
@@ -342,6 +380,20 @@ PYBIND11_MODULE(_C, m) {
       "Set the level required to be met for a log message to be printed");
   m.def("_get_is_colored_output_on", &logging::get_is_colored_output_on, "Get if the logging output will be colored");
   m.def("_set_is_colored_output_on", &logging::set_is_colored_output_on, "Set if the logging output should be colored");
+  m.def("_get_is_async_output_on", &logging::get_is_async_output_on, "Get if the logging output is asynchronous");
+  m.def(
+      "_set_is_async_output_on",
+      &logging::set_is_async_output_on,
+      "Set if the logging output should be written by a background thread");
+  m.def(
+      "_get_max_messages_per_second",
+      &logging::get_max_messages_per_second,
+      "Get the number of messages one call site logs per second with asynchronous output");
+  m.def(
+      "_set_max_messages_per_second",
+      &logging::set_max_messages_per_second,
+      "Set the number of messages one call site logs per second with asynchronous output");
+  m.def("_flush", &logging::flush, "Wait for the messages queued for asynchronous output to be written");
   m.def("_log", &logging::log, "Add a message to the logger");
   m.def("set_device", &torch_tensorrt::pyapi::set_device, "Set CUDA device id");
   m.def("_get_current_device", &torch_tensorrt::pyapi::get_current_device, "Get the current active CUDA device");
@@ -363,30 +415,70 @@ PYBIND11_MODULE(_C, m) {
       .def(py::init<>())
       .def("__str__", &torch_tensorrt::pyapi::CompileSpec::stringify)
       .def("_get_calibrator_handle", &CompileSpec::getPTQCalibratorHandle, "[Internal] gets a handle from a calibrator")
+      .def("_set_previous_module", &CompileSpec::setPreviousModule, "[Internal] sets the module to reuse engines from")
       .def_readwrite("inputs", &CompileSpec::inputs)
       .def_readwrite("input_signature", &CompileSpec::input_signature)
       .def_readwrite("enabled_precisions", &CompileSpec::enabled_precisions)
+      .def_readwrite("layer_precisions", &CompileSpec::layer_precisions)
+      .def_readwrite("strongly_typed", &CompileSpec::strongly_typed)
+      .def_readwrite("weight_streaming", &CompileSpec::weight_streaming)
       .def_readwrite("ptq_calibrator", &CompileSpec::ptq_calibrator)
       .def_readwrite("refit", &CompileSpec::refit)
+      .def_readwrite("strip_engine_weights", &CompileSpec::strip_engine_weights)
+      .def_readwrite("loop_unroll_max_trip_count", &CompileSpec::loop_unroll_max_trip_count)
+      .def_readwrite("loop_unroll_max_body_size", &CompileSpec::loop_unroll_max_body_size)
       .def_readwrite("sparse_weights", &CompileSpec::sparse_weights)
       .def_readwrite("disable_tf32", &CompileSpec::disable_tf32)
       .def_readwrite("debug", &CompileSpec::debug)
+      .def_readwrite("detailed_layer_info", &CompileSpec::detailed_layer_info)
       .def_readwrite("device", &CompileSpec::device)
       .def_readwrite("capability", &CompileSpec::capability)
       .def_readwrite("num_avg_timing_iters", &CompileSpec::num_avg_timing_iters)
+      .def_readwrite("fast_build", &CompileSpec::fast_build)
+      .def_readwrite("max_aux_streams", &CompileSpec::max_aux_streams)
+      .def_readwrite("version_compatible", &CompileSpec::version_compatible)
+      .def_readwrite("exclude_lean_runtime", &CompileSpec::exclude_lean_runtime)
       .def_readwrite("workspace_size", &CompileSpec::workspace_size)
+      .def_readwrite("device_memory_budget", &CompileSpec::device_memory_budget)
       .def_readwrite("dla_sram_size", &CompileSpec::dla_sram_size)
       .def_readwrite("dla_local_dram_size", &CompileSpec::dla_local_dram_size)
       .def_readwrite("dla_global_dram_size", &CompileSpec::dla_global_dram_size)
       .def_readwrite("torch_fallback", &CompileSpec::torch_fallback)
       .def_readwrite("truncate_long_and_double", &CompileSpec::truncate_long_and_double)
-      .def_readwrite("allow_shape_tensors", &CompileSpec::allow_shape_tensors);
+      .def_readwrite("allow_shape_tensors", &CompileSpec::allow_shape_tensors)
+      .def_readwrite("share_device_memory", &CompileSpec::share_device_memory)
+      .def_readwrite("share_cudagraph_pool", &CompileSpec::share_cudagraph_pool)
+      .def_readwrite("fuse_torch_segments", &CompileSpec::fuse_torch_segments)
+      .def_readwrite("background_build", &CompileSpec::background_build)
+      .def_readwrite("plan_segment_activations", &CompileSpec::plan_segment_activations)
+      .def_readwrite("low_memory", &CompileSpec::low_memory)
+      .def_readwrite("shared_segment_calibration", &CompileSpec::shared_segment_calibration)
+      .def_readwrite("output_formats", &CompileSpec::output_formats)
+      .def_readwrite("segment_boundary_format", &CompileSpec::segment_boundary_format)
+      .def_readwrite("num_build_workers", &CompileSpec::num_build_workers)
+      .def_readwrite("build_gpu_ids", &CompileSpec::build_gpu_ids)
+      .def_readwrite("segment_devices", &CompileSpec::segment_devices)
+      .def_readwrite("timing_cache_path", &CompileSpec::timing_cache_path)
+      .def_readwrite("tactic_record_path", &CompileSpec::tactic_record_path)
+      .def_readwrite("tactic_replay_path", &CompileSpec::tactic_replay_path)
+      .def_readwrite("engine_cache_dir", &CompileSpec::engine_cache_dir)
+      .def_readwrite("engine_cache_size", &CompileSpec::engine_cache_size);
 
   py::class_<TorchFallback>(ts_sub_mod, "TorchFallback")
       .def(py::init<>())
       .def("__str__", &torch_tensorrt::pyapi::TorchFallback::to_str)
       .def_readwrite("enabled", &TorchFallback::enabled)
       .def_readwrite("min_block_size", &TorchFallback::min_block_size)
+      .def_readwrite("cost_model_partitioning", &TorchFallback::cost_model_partitioning)
+      .def_readwrite("op_latency_savings_us", &TorchFallback::op_latency_savings_us)
+      .def_readwrite("symbolic_shape_analysis", &TorchFallback::symbolic_shape_analysis)
+      .def_readwrite("num_shape_analysis_workers", &TorchFallback::num_shape_analysis_workers)
+      .def_readwrite("merge_non_tensor_boundaries", &TorchFallback::merge_non_tensor_boundaries)
+      .def_readwrite("bridge_unsupported_ops", &TorchFallback::bridge_unsupported_ops)
+      .def_readwrite("concurrent_segment_streams", &TorchFallback::concurrent_segment_streams)
+      .def_readwrite("overlap_torch_segments", &TorchFallback::overlap_torch_segments)
+      .def_readwrite("share_segment_weights", &TorchFallback::share_segment_weights)
+      .def_readwrite("partitioning_report_path", &TorchFallback::partitioning_report_path)
       .def_readwrite("forced_fallback_operators", &TorchFallback::forced_fallback_operators)
       .def_readwrite("forced_fallback_modules", &TorchFallback::forced_fallback_modules);
 
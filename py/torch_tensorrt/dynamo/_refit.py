@@ -32,6 +32,7 @@ from torch_tensorrt.dynamo.runtime._TorchTensorRTModule import (
     ENGINE_IDX,
     SERIALIZED_METADATA_IDX,
     TorchTensorRTModule,
+    get_engine_info,
 )
 from torch_tensorrt.dynamo.utils import (
     check_module_output,
@@ -258,7 +259,7 @@ def refit_module_weights(
             if "engine" in name
         ]
         # [('_run_on_acc_0', inline_module)]
-        encoded_metadata = compiled_submodules[0][1].__getstate__()[0][
+        encoded_metadata = get_engine_info(compiled_submodules[0][1])[
             SERIALIZED_METADATA_IDX
         ]
         assert (
@@ -372,12 +373,12 @@ def refit_module_weights(
                     compiled_submodule.load_state_dict(new_submodule.state_dict())
                     continue
                 else:
-                    engine_info = compiled_submodule.__getstate__()[0]
+                    engine_info = get_engine_info(compiled_submodule)
                     engine = get_engine_from_encoded_engine(
                         engine_info[ENGINE_IDX], runtime
                     )
                     if use_weight_map_cache:
-                        encoded_metadata = compiled_submodule.__getstate__()[0][
+                        encoded_metadata = get_engine_info(compiled_submodule)[
                             SERIALIZED_METADATA_IDX
                         ]
                         weight_name_map = TorchTensorRTModule.decode_metadata(
@@ -406,7 +407,7 @@ def refit_module_weights(
                 if isinstance(compiled_submodule, PythonTorchTensorRTModule):
                     engine = compiled_submodule.engine
                 elif isinstance(compiled_submodule, TorchTensorRTModule):
-                    engine_info = compiled_submodule.engine.__getstate__()[0]
+                    engine_info = get_engine_info(compiled_submodule.engine)
                     engine = get_engine_from_encoded_engine(
                         engine_info[ENGINE_IDX], runtime
                     )
@@ -4,7 +4,7 @@ import base64
 import copy
 import logging
 import pickle
-from typing import Any, List, Optional, Tuple, Union
+from typing import Any, Dict, List, Optional, Tuple, Union
 
 import torch
 from torch_tensorrt._Device import Device
@@ -49,6 +49,15 @@ if ENABLED_FEATURES.torch_tensorrt_runtime:
     SERIALIZATION_LEN = torch.ops.tensorrt.SERIALIZATION_LEN()  # 9
 
 
+def get_engine_info(engine: Any) -> SerializedTensorRTEngineFmt:
+    """Returns the serialized info of a ``torch.classes.tensorrt.Engine`` with the engine base64 encoded at ENGINE_IDX
+
+    The pickled state of an engine (``__getstate__``) stores the engine as a uint8 tensor since ABI version 7, this
+    accessor provides the list of strings format expected by the Python side
+    """
+    return [value for _, value in engine.__obj_flatten__()]
+
+
 @for_all_methods(needs_torch_tensorrt_runtime)
 class TorchTensorRTModule(torch.nn.Module):  # type: ignore[misc]
     """TorchTensorRTModule is a PyTorch module which encompasses an arbitrary TensorRT Engine.
@@ -225,7 +234,7 @@ class TorchTensorRTModule(torch.nn.Module):  # type: ignore[misc]
         if self.engine:
             return (
                 self.name,
-                self.engine.__getstate__(),
+                get_engine_info(self.engine),
                 self.input_binding_names,
                 self.output_binding_names,
             )
@@ -275,6 +284,25 @@ class TorchTensorRTModule(torch.nn.Module):  # type: ignore[misc]
     def set_pre_allocated_outputs(self, enable: bool) -> None:
         self.engine.use_pre_allocated_outputs = enable
 
+    def get_memory_usage(self) -> Dict[str, int]:
+        """Device memory held by the engine in bytes, split into weights, activations, shared_activations, cudagraphs,
+        shared_cudagraphs, io_buffers and their total (which excludes shared_activations and shared_cudagraphs)
+        """
+        if self.engine is None:
+            raise RuntimeError("Engine has not been setup yet.")
+        return dict(self.engine.get_memory_usage())
+
+    def warmup(self, iterations: int = 1) -> None:
+        """Runs the engine at the shapes of its optimization profiles so the first requests do not pay for lazy
+        initialization. CUDA graphs are captured for these shapes if they are enabled
+
+        Args:
+            iterations (int): Number of executions per shape, 0 only deserializes the engine
+        """
+        if self.engine is None:
+            raise RuntimeError("Engine has not been setup yet.")
+        self.engine.warmup(iterations)
+
     def forward(self, *inputs: Any) -> torch.Tensor | Tuple[torch.Tensor, ...]:
         """Implementation of the forward pass for a TensorRT engine
 
@@ -76,6 +76,16 @@ def fake_tensorrt_execute_engine(
     return fake_outputs
 
 
+@torch.library.register_fake("tensorrt::execute_engine_out")  # type: ignore
+def fake_tensorrt_execute_engine_out(
+    inputs: List[torch.Tensor], outputs: List[torch.Tensor], fake_trt_engine: Any
+) -> None:
+    """
+    The outputs are written in place into the caller provided tensors, there is nothing to infer
+    """
+    return None
+
+
 @torch._library.register_fake_class("tensorrt::Engine")
 class FakeTRTEngine:
     def __init__(self, engine_info: List[str]) -> None:
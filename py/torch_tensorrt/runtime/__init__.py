@@ -6,8 +6,29 @@ from torch_tensorrt.runtime._cudagraphs import (
     enable_cudagraphs,
     get_cudagraphs_mode,
     get_whole_cudagraphs_mode,
+    set_cudagraph_admission,
     set_cudagraphs_mode,
 )
+from torch_tensorrt.runtime._engine_ensemble import TorchTensorRTEngineEnsemble
+from torch_tensorrt.runtime._engine_sequence import (
+    TorchTensorRTEngineSequence,
+    fuse_engine_calls,
+)
+from torch_tensorrt.runtime._engine_variants import TorchTensorRTEngineVariants
+from torch_tensorrt.runtime._hot_swap import swap_engines
+from torch_tensorrt.runtime._l2_persistence import set_persistent_cache_limit
+from torch_tensorrt.runtime._memory_usage import get_memory_usage
 from torch_tensorrt.runtime._multi_device_safe_mode import set_multi_device_safe_mode
 from torch_tensorrt.runtime._pre_allocated_outputs import enable_pre_allocated_outputs
+from torch_tensorrt.runtime._qos import set_background_max_in_flight, set_qos_class
+from torch_tensorrt.runtime._shape_histogram import (
+    get_input_shape_histograms,
+    set_record_input_shapes,
+)
+from torch_tensorrt.runtime._topology import (
+    get_device_topology,
+    set_numa_local_host_staging,
+)
+from torch_tensorrt.runtime._torch_gpu_allocator import set_torch_gpu_allocator_enabled
+from torch_tensorrt.runtime._warmup import warmup
 from torch_tensorrt.runtime._weight_streaming import weight_streaming
@@ -40,6 +40,22 @@ def set_cudagraphs_mode(mode: bool) -> None:
     logger.info(f"Set Cudagraphs usage to {mode}")
 
 
+def set_cudagraph_admission(
+    min_executions: int = 1, window: int = 0, max_total_bytes: int = 0
+) -> None:
+    """Only capture CUDA graphs for the input shapes TensorRT engines run often
+
+    Args:
+        min_executions (int): Executions of an input shape (per execution context) before a graph is captured for it, rarer shapes run without a graph. 1: capture on the first execution
+        window (int): Only count the executions of a shape among the last ``window`` executions of the context. 0: no window
+        max_total_bytes (int): Stop capturing new graphs while the persistent buffers of all captured graphs exceed this many bytes. 0: no limit
+    """
+    if torch_tensorrt.ENABLED_FEATURES.torch_tensorrt_runtime:
+        torch.ops.tensorrt.set_cudagraph_min_executions(min_executions)
+        torch.ops.tensorrt.set_cudagraph_admission_window(window)
+        torch.ops.tensorrt.set_cudagraph_max_total_bytes(max_total_bytes)
+
+
 def get_whole_cudagraphs_mode() -> bool:
     # check if whole cudagraphs mode is enabled or not
     global _PY_RT_CUDAGRAPHS
@@ -0,0 +1,25 @@
+from typing import Any, Sequence, Tuple
+
+import torch
+from torch_tensorrt.dynamo.runtime import TorchTensorRTModule
+
+
+class TorchTensorRTEngineEnsemble(torch.nn.Module):  # type: ignore[misc]
+    """Runs independent TensorRT engines on the same inputs with one ``torch.ops.tensorrt.execute_ensemble`` call
+
+    ``members`` are engines (or ``TorchTensorRTModule`` s) taking the same inputs, e.g. the models of an ensemble. They
+    run concurrently on streams of their own, the inputs are moved to the device once for all of them and their outputs
+    are placed in one arena. Returns the outputs of every member, member by member. With ``use_cudagraph`` the fan out
+    to the members and the join of their streams are replayed as one CUDA graph.
+    """
+
+    def __init__(self, members: Sequence[Any], use_cudagraph: bool = False):
+        super(TorchTensorRTEngineEnsemble, self).__init__()
+        engines = [
+            m.engine if isinstance(m, TorchTensorRTModule) else m for m in members
+        ]
+        self.ensemble = torch.classes.tensorrt.EngineEnsemble(engines)
+        self.ensemble.use_cudagraph = use_cudagraph
+
+    def forward(self, *inputs: torch.Tensor) -> Tuple[torch.Tensor, ...]:
+        return tuple(torch.ops.tensorrt.execute_ensemble(list(inputs), self.ensemble))
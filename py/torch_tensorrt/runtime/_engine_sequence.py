@@ -0,0 +1,173 @@
+import logging
+import operator
+from typing import Any, Dict, List, Set, Tuple
+
+import torch
+from torch_tensorrt.dynamo.runtime import TorchTensorRTModule
+
+logger = logging.getLogger(__name__)
+
+
+class TorchTensorRTEngineSequence(torch.nn.Module):  # type: ignore[misc]
+    """Runs several TensorRT engines back to back with a single ``torch.ops.tensorrt.execute_engines`` call
+
+    Values are numbered in order: the ``num_inputs`` inputs of the sequence, then the outputs of each engine.
+    ``engine_inputs[k]`` are the values engine ``k`` is executed on and ``outputs`` the values returned.
+    """
+
+    def __init__(
+        self,
+        num_inputs: int,
+        engines: List[Any],
+        engine_inputs: List[List[int]],
+        outputs: List[int],
+        use_cudagraph: bool = False,
+    ):
+        super(TorchTensorRTEngineSequence, self).__init__()
+        self.sequence = torch.classes.tensorrt.EngineSequence(
+            num_inputs, engines, engine_inputs, outputs
+        )
+        self.sequence.use_cudagraph = use_cudagraph
+
+    def forward(self, *inputs: torch.Tensor) -> Tuple[torch.Tensor, ...]:
+        return tuple(torch.ops.tensorrt.execute_engines(list(inputs), self.sequence))
+
+
+def _is_engine_call(gm: torch.fx.GraphModule, node: torch.fx.Node) -> bool:
+    if node.op != "call_module" or node.kwargs:
+        return False
+    submodule = gm.get_submodule(node.target)
+    return (
+        isinstance(submodule, TorchTensorRTModule)
+        and submodule.engine is not None
+        and all(isinstance(a, torch.fx.Node) for a in node.args)
+    )
+
+
+def _num_outputs(gm: torch.fx.GraphModule, node: torch.fx.Node) -> int:
+    return len(gm.get_submodule(node.target).output_binding_names)
+
+
+def _fuse_group(
+    gm: torch.fx.GraphModule,
+    group: List[torch.fx.Node],
+    index: int,
+    use_cudagraph: bool,
+) -> None:
+    members = [n for n in group if n.op == "call_module"]
+    group_set = set(group)
+    external: List[torch.fx.Node] = []
+    value_ids: Dict[torch.fx.Node, int] = {}
+
+    for node in members:
+        for arg in node.args:
+            if arg not in group_set and arg not in external:
+                external.append(arg)
+
+    next_id = len(external)
+    engines = []
+    engine_inputs = []
+    for node in members:
+        engine_inputs.append(
+            [value_ids[a] if a in group_set else external.index(a) for a in node.args]
+        )
+        engines.append(gm.get_submodule(node.target).engine)
+        num_outputs = _num_outputs(gm, node)
+        if num_outputs == 1:
+            value_ids[node] = next_id
+        else:
+            for user in node.users:
+                if user in group_set:
+                    value_ids[user] = next_id + user.args[1]
+        next_id += num_outputs
+
+    # Values read after the sequence are its outputs
+    returned = [
+        n
+        for n in group
+        if n in value_ids and any(user not in group_set for user in n.users)
+    ]
+    name = f"_run_engine_sequence_{index}"
+    gm.add_submodule(
+        name,
+        TorchTensorRTEngineSequence(
+            len(external),
+            engines,
+            engine_inputs,
+            [value_ids[n] for n in returned],
+            use_cudagraph,
+        ),
+    )
+    with gm.graph.inserting_after(group[-1]):
+        fused = gm.graph.call_module(name, tuple(external))
+    with gm.graph.inserting_after(fused):
+        for i, node in enumerate(returned):
+            out = gm.graph.call_function(operator.getitem, (fused, i))
+            node.replace_all_uses_with(
+                out, delete_user_cb=lambda user: user not in group_set
+            )
+    for node in reversed(group):
+        gm.graph.erase_node(node)
+
+
+def fuse_engine_calls(module: torch.fx.GraphModule, use_cudagraph: bool = False) -> int:
+    """Replaces runs of TensorRT engine calls in a compiled module by single calls executing them back to back in C++
+
+    Graphs made of many small TensorRT submodules otherwise pay the Python, dispatcher and lock overhead of
+    ``torch.ops.tensorrt.execute_engine`` once per engine. Engine calls are grouped as long as the operations between
+    them do not read their outputs, these operations then run before the group. Apply it to a compiled module for
+    execution, the fused module is not meant to be traced or exported again.
+
+    Args:
+        module (torch.fx.GraphModule): Module compiled with Torch-TensorRT, modified in place
+        use_cudagraph (bool): Replay each group of engines as one CUDA graph
+
+    Returns:
+        int: Number of groups of engines fused
+    """
+    groups: List[List[torch.fx.Node]] = []
+    group: List[torch.fx.Node] = []
+    group_values: Set[torch.fx.Node] = set()
+
+    def close() -> None:
+        nonlocal group, group_values
+        if sum(1 for n in group if n.op == "call_module") > 1:
+            groups.append(group)
+        group = []
+        group_values = set()
+
+    for node in module.graph.nodes:
+        if _is_engine_call(module, node):
+            group.append(node)
+            group_values.add(node)
+        elif (
+            node.op == "call_function"
+            and node.target is operator.getitem
+            and node.args[0] in group_values
+            and node.args[0].op == "call_module"
+            and _num_outputs(module, node.args[0]) > 1
+        ):
+            group.append(node)
+            group_values.add(node)
+        elif any(n in group_values for n in node.all_input_nodes):
+            close()
+    close()
+
+    # Engines returning a tuple can only be fused if the tuple is only unpacked
+    groups = [
+        g
+        for g in groups
+        if all(
+            _num_outputs(module, n) == 1
+            or all(user.target is operator.getitem for user in n.users)
+            for n in g
+            if n.op == "call_module"
+        )
+    ]
+    for i, g in enumerate(groups):
+        _fuse_group(module, g, i, use_cudagraph)
+    if groups:
+        module.delete_all_unused_submodules()
+        module.recompile()
+        logger.debug(f"Fused {len(groups)} groups of TensorRT engine calls")
+    return len(groups)
@@ -0,0 +1,60 @@
+from typing import Any, Callable, List, Optional, Sequence, Tuple
+
+import torch
+from torch_tensorrt.dynamo.runtime import TorchTensorRTModule
+
+
+class TorchTensorRTEngineVariants(torch.nn.Module):  # type: ignore[misc]
+    """Serves one TensorRT segment from several precision variants of it, e.g. its FP16 and INT8 builds
+
+    ``variants`` are engines (or ``TorchTensorRTModule`` s) with the same inputs and outputs, ordered from the most to
+    the least precise. Calls run on the first variant and move on to the next ones while it has ``max_in_flight``
+    executions in flight or the smoothed call latency is above ``latency_target_us`` (0 disables either). Calls only
+    move while the average ``accuracy_costs`` (by default the variant index) of the last ``accuracy_window`` calls stays
+    within ``accuracy_budget`` (negative is unlimited). ``admit(variant, inputs)`` can further keep a call on a more
+    precise variant, e.g. for inputs outside of the range an INT8 variant was calibrated for.
+    """
+
+    def __init__(
+        self,
+        variants: Sequence[Any],
+        max_in_flight: int = 0,
+        latency_target_us: int = 0,
+        accuracy_costs: Optional[List[float]] = None,
+        accuracy_budget: float = -1.0,
+        accuracy_window: int = 1000,
+        admit: Optional[Callable[[int, List[torch.Tensor]], bool]] = None,
+    ):
+        super(TorchTensorRTEngineVariants, self).__init__()
+        engines = [
+            v.engine if isinstance(v, TorchTensorRTModule) else v for v in variants
+        ]
+        self.variants = torch.classes.tensorrt.EngineVariants(engines)
+        self.variants.max_in_flight = max_in_flight
+        self.variants.latency_target_us = latency_target_us
+        if accuracy_costs is not None:
+            self.variants.accuracy_costs = accuracy_costs
+        self.variants.accuracy_budget = accuracy_budget
+        self.variants.accuracy_window = accuracy_window
+        self.admit = admit
+
+    def forward(self, *inputs: torch.Tensor) -> Tuple[torch.Tensor, ...]:
+        if self.admit is None:
+            return tuple(
+                torch.ops.tensorrt.execute_engine_variants(list(inputs), self.variants)
+            )
+        variant = self.variants.select(list(inputs))
+        while variant > 0 and not self.admit(variant, list(inputs)):
+            variant -= 1
+        return tuple(self.variants.run_variant(variant, list(inputs)))
+
+    def get_routed_counts(self) -> List[int]:
+        """Calls run by each variant since the variants were created or ``reset_stats`` was called"""
+        return list(self.variants.get_routed_counts())
+
+    def get_accuracy_spent(self) -> float:
+        """Average accuracy cost of the recent calls"""
+        return float(self.variants.get_accuracy_spent())
+
+    def reset_stats(self) -> None:
+        self.variants.reset_stats()
@@ -0,0 +1,50 @@
+import logging
+
+import torch
+from torch_tensorrt.dynamo.runtime import PythonTorchTensorRTModule, TorchTensorRTModule
+
+logger = logging.getLogger(__name__)
+
+
+def swap_engines(
+    module: torch.nn.Module, replacement: torch.nn.Module, warmup_iterations: int = 0
+) -> None:
+    """Switches a loaded module to the TensorRT engines of another module compiled from the same program
+
+    The engines of ``replacement`` are warmed up first, then each engine of ``module`` exchanges its TensorRT engine with the engine of the ``replacement`` submodule of the same name once the in-flight executions of both have finished. Executions started afterwards run the new engine. Runtime settings stay with ``module``, ``replacement`` holds the previous engines afterwards: swap again to roll back, or drop it to release them.
+
+    Args:
+        module (torch.nn.Module): Module compiled with Torch-TensorRT which keeps serving
+        replacement (torch.nn.Module): Module compiled from the same program with the same settings
+        warmup_iterations (int): Executions of each new engine per profile shape before it is swapped in, 0 only deserializes the engines
+    """
+    engines = {}
+    for name, rt_mod in replacement.named_modules():
+        if isinstance(rt_mod, TorchTensorRTModule):
+            engines[name] = rt_mod
+        elif isinstance(rt_mod, PythonTorchTensorRTModule):
+            raise RuntimeError(
+                f"Cannot swap {name}, engine swaps are only supported for TorchTensorRTModule"
+            )
+
+    swaps = []
+    for name, rt_mod in module.named_modules():
+        if isinstance(rt_mod, TorchTensorRTModule):
+            if name not in engines:
+                raise RuntimeError(
+                    f"The module to swap in has no TensorRT engine named {name}, modules must be compiled from the same program with the same settings"
+                )
+            swaps.append((name, rt_mod, engines.pop(name)))
+    if engines:
+        raise RuntimeError(
+            f"The module to swap in has TensorRT engines {list(engines)} which the module does not have"
+        )
+
+    # Every new engine is prepared before the first swap, the module keeps running its current engines until then
+    for _, _, new_mod in swaps:
+        new_mod.setup_engine()
+        new_mod.engine.warmup(warmup_iterations)
+    for name, rt_mod, new_mod in swaps:
+        logger.debug(f"Swapping the engine of {name}")
+        rt_mod.setup_engine()
+        rt_mod.engine.swap_engine(new_mod.engine)
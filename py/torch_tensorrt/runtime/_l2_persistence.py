@@ -0,0 +1,30 @@
+import logging
+
+import torch
+from torch_tensorrt.dynamo.runtime import PythonTorchTensorRTModule, TorchTensorRTModule
+
+logger = logging.getLogger(__name__)
+
+
+def set_persistent_cache_limit(module: torch.nn.Module, limit: int) -> None:
+    """Sets how much persisting L2 cache every TensorRT engine of a compiled module may use
+
+    TensorRT keeps tensors of the engine (for example weights reused by every execution) in the persisting part of
+    the L2 cache, up to the limit, so they are not evicted by activations between executions. Requires an Ampere or
+    newer GPU, the limit has no effect on older devices.
+
+    Args:
+        module (torch.nn.Module): Module compiled with Torch-TensorRT
+        limit (int): Limit in bytes, 0 disables persistence and -1 uses the maximum persisting L2 size of the device
+    """
+    if limit < -1:
+        raise ValueError(
+            f"Invalid persistent cache limit {limit}, expected -1 (automatic) or a size in bytes"
+        )
+    for name, rt_mod in module.named_modules():
+        if isinstance(rt_mod, TorchTensorRTModule):
+            rt_mod.engine.persistent_cache_limit = limit
+        elif isinstance(rt_mod, PythonTorchTensorRTModule):
+            logger.warning(
+                f"Persistent cache limits are only supported for TorchTensorRTModule, {name} is unaffected"
+            )
@@ -0,0 +1,38 @@
+import logging
+from collections import defaultdict
+from typing import Dict
+
+import torch
+from torch_tensorrt.dynamo.runtime import PythonTorchTensorRTModule, TorchTensorRTModule
+
+logger = logging.getLogger(__name__)
+
+
+def get_memory_usage(module: torch.nn.Module) -> Dict[str, int]:
+    """Device memory held by the TensorRT engines of a compiled module
+
+    Sums the memory usage of every engine of the module, see ``TorchTensorRTModule.get_memory_usage`` for the
+    categories. ``shared_activations`` and ``shared_cudagraphs`` are the largest arena and CUDA graph buffer region
+    reported by an engine rather than the sum, since the engines of a module which share them all report the same one.
+
+    Args:
+        module (torch.nn.Module): Module compiled with Torch-TensorRT
+
+    Returns:
+        Dict[str, int]: Bytes per category
+    """
+    usage: Dict[str, int] = defaultdict(int)
+    shared: Dict[str, int] = {"shared_activations": 0, "shared_cudagraphs": 0}
+    for name, rt_mod in module.named_modules():
+        if isinstance(rt_mod, TorchTensorRTModule):
+            for category, nbytes in rt_mod.get_memory_usage().items():
+                if category in shared:
+                    shared[category] = max(shared[category], nbytes)
+                else:
+                    usage[category] += nbytes
+        elif isinstance(rt_mod, PythonTorchTensorRTModule):
+            logger.debug(
+                f"Skipping {name}, memory usage is only reported for TorchTensorRTModule"
+            )
+    usage.update(shared)
+    return dict(usage)
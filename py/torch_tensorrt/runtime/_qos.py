@@ -0,0 +1,40 @@
+import logging
+
+import torch
+import torch_tensorrt
+from torch_tensorrt.dynamo.runtime import PythonTorchTensorRTModule, TorchTensorRTModule
+
+logger = logging.getLogger(__name__)
+
+# Matches EngineQoSClass in core/runtime/TRTEngine.h
+_QOS_CLASSES = {"default": 0, "latency_critical": 1, "background": 2}
+
+
+def set_qos_class(module: torch.nn.Module, qos_class: str) -> None:
+    """Sets the quality of service class of every TensorRT engine of a compiled module
+
+    ``latency_critical`` engines run on high priority CUDA streams so their kernels are scheduled ahead of other work
+    on the GPU. ``background`` engines are limited to ``set_background_max_in_flight`` executions queued or running
+    per device, so they cannot queue unbounded work ahead of latency critical engines.
+
+    Args:
+        module (torch.nn.Module): Module compiled with Torch-TensorRT
+        qos_class (str): One of ``default``, ``latency_critical`` or ``background``
+    """
+    if qos_class not in _QOS_CLASSES:
+        raise ValueError(
+            f"Invalid QoS class {qos_class}, expected one of {list(_QOS_CLASSES)}"
+        )
+    for name, rt_mod in module.named_modules():
+        if isinstance(rt_mod, TorchTensorRTModule):
+            rt_mod.engine.qos_class = _QOS_CLASSES[qos_class]
+        elif isinstance(rt_mod, PythonTorchTensorRTModule):
+            logger.warning(
+                f"QoS classes are only supported for TorchTensorRTModule, {name} is unaffected"
+            )
+
+
+def set_background_max_in_flight(max_in_flight: int) -> None:
+    """Limits how many executions of ``background`` engines may be queued or running on each device (0: no limit)"""
+    if torch_tensorrt.ENABLED_FEATURES.torch_tensorrt_runtime:
+        torch.ops.tensorrt.set_background_max_in_flight(max_in_flight)
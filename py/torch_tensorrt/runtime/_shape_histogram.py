@@ -0,0 +1,37 @@
+import logging
+from typing import Dict
+
+import torch
+import torch_tensorrt
+from torch_tensorrt.dynamo.runtime import PythonTorchTensorRTModule, TorchTensorRTModule
+
+logger = logging.getLogger(__name__)
+
+
+def set_record_input_shapes(record: bool) -> None:
+    """Records a histogram of the input shapes of every TensorRT engine execution
+
+    Recording takes a lock per execution, enable it while sampling traffic.
+    """
+    if torch_tensorrt.ENABLED_FEATURES.torch_tensorrt_runtime:
+        torch.ops.tensorrt.set_record_input_shapes(record)
+
+
+def get_input_shape_histograms(module: torch.nn.Module) -> Dict[str, Dict[str, int]]:
+    """Input shapes the TensorRT engines of a compiled module were executed with while recording was enabled
+
+    Args:
+        module (torch.nn.Module): Module compiled with Torch-TensorRT
+
+    Returns:
+        Dict[str, Dict[str, int]]: Per submodule, the number of executions per input shapes, e.g. ``{"(8,128)": 3}``
+    """
+    histograms = {}
+    for name, rt_mod in module.named_modules():
+        if isinstance(rt_mod, TorchTensorRTModule):
+            histograms[name] = dict(rt_mod.engine.get_input_shape_histogram())
+        elif isinstance(rt_mod, PythonTorchTensorRTModule):
+            logger.debug(
+                f"Skipping {name}, input shapes are only recorded for TorchTensorRTModule"
+            )
+    return histograms
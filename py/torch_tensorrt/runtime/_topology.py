@@ -0,0 +1,23 @@
+import torch
+import torch_tensorrt
+
+
+def set_numa_local_host_staging(enabled: bool) -> None:
+    """Places the pinned buffers host inputs are staged in on the NUMA node of the engine's GPU
+
+    On multi socket servers this keeps the transfer of host inputs from crossing the socket interconnect. Only
+    buffers allocated after the call are affected, and only on Linux where the NUMA node of the GPU is known.
+    """
+    if torch_tensorrt.ENABLED_FEATURES.torch_tensorrt_runtime:
+        torch.ops.tensorrt.set_numa_local_host_staging(enabled)
+
+
+def get_device_topology() -> str:
+    """Interconnect of the visible GPUs as the runtime sees it, one row per GPU with its NUMA node
+
+    Links are ``X`` (same GPU), ``NV`` (NVLink), ``PCIE`` (peer to peer over PCIe), ``NODE`` (through host memory
+    of the same NUMA node) and ``SYS`` (through host memory across NUMA nodes).
+    """
+    if torch_tensorrt.ENABLED_FEATURES.torch_tensorrt_runtime:
+        return str(torch.ops.tensorrt.get_device_topology())
+    return ""
@@ -0,0 +1,12 @@
+import torch
+import torch_tensorrt
+
+
+def set_torch_gpu_allocator_enabled(enabled: bool) -> None:
+    """Allocates the device memory of TensorRT from the PyTorch caching allocator
+
+    Applies to the TensorRT runtimes and builders created afterwards. Torch and TensorRT then share one memory pool instead of fragmenting the GPU against each other.
+    Engines which are already loaded keep the allocator of their runtime.
+    """
+    if torch_tensorrt.ENABLED_FEATURES.torch_tensorrt_runtime:
+        torch.ops.tensorrt.set_torch_gpu_allocator_enabled(enabled)
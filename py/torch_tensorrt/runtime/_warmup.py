@@ -0,0 +1,25 @@
+import logging
+
+import torch
+from torch_tensorrt.dynamo.runtime import PythonTorchTensorRTModule, TorchTensorRTModule
+
+logger = logging.getLogger(__name__)
+
+
+def warmup(module: torch.nn.Module, iterations: int = 1) -> None:
+    """Warms up every TensorRT engine of a compiled module
+
+    Each engine is run ``iterations`` times at the min, opt and max input shapes of its optimization profiles so lazy
+    kernel loading, tactic initialization and allocator growth happen before the module serves traffic. CUDA graphs are
+    captured for these shapes if they are enabled.
+
+    Args:
+        module (torch.nn.Module): Module compiled with Torch-TensorRT
+        iterations (int): Number of executions per shape, 0 only deserializes the engines
+    """
+    for name, rt_mod in module.named_modules():
+        if isinstance(rt_mod, TorchTensorRTModule):
+            logger.debug(f"Warming up {name}")
+            rt_mod.warmup(iterations)
+        elif isinstance(rt_mod, PythonTorchTensorRTModule):
+            logger.debug(f"Skipping warmup of {name}, only supported for TorchTensorRTModule")
@@ -7,7 +7,7 @@ import torch
 import torch_tensorrt._C.ts as _ts_C
 from torch_tensorrt import _C
 from torch_tensorrt._Device import Device
-from torch_tensorrt._enums import DeviceType, EngineCapability, dtype
+from torch_tensorrt._enums import DeviceType, EngineCapability, dtype, memory_format
 from torch_tensorrt._Input import Input
 from torch_tensorrt.ts._Device import TorchScriptDevice
 from torch_tensorrt.ts._Input import TorchScriptInput
@@ -105,6 +105,48 @@ def _parse_torch_fallback(fallback_info: Dict[str, Any]) -> _ts_C.TorchFallback:
         assert isinstance(fallback_info["min_block_size"], int)
         info.min_block_size = fallback_info["min_block_size"]
 
+    if "cost_model_partitioning" in fallback_info:
+        assert isinstance(fallback_info["cost_model_partitioning"], bool)
+        info.cost_model_partitioning = fallback_info["cost_model_partitioning"]
+
+    if "op_latency_savings_us" in fallback_info:
+        assert isinstance(fallback_info["op_latency_savings_us"], dict)
+        info.op_latency_savings_us = {
+            str(op): float(us)
+            for op, us in fallback_info["op_latency_savings_us"].items()
+        }
+
+    if "symbolic_shape_analysis" in fallback_info:
+        assert isinstance(fallback_info["symbolic_shape_analysis"], bool)
+        info.symbolic_shape_analysis = fallback_info["symbolic_shape_analysis"]
+
+    if "num_shape_analysis_workers" in fallback_info:
+        assert isinstance(fallback_info["num_shape_analysis_workers"], int)
+        info.num_shape_analysis_workers = fallback_info["num_shape_analysis_workers"]
+
+    if "merge_non_tensor_boundaries" in fallback_info:
+        assert isinstance(fallback_info["merge_non_tensor_boundaries"], bool)
+        info.merge_non_tensor_boundaries = fallback_info["merge_non_tensor_boundaries"]
+    if "bridge_unsupported_ops" in fallback_info:
+        assert isinstance(fallback_info["bridge_unsupported_ops"], bool)
+        info.bridge_unsupported_ops = fallback_info["bridge_unsupported_ops"]
+
+    if "concurrent_segment_streams" in fallback_info:
+        assert isinstance(fallback_info["concurrent_segment_streams"], int)
+        info.concurrent_segment_streams = fallback_info["concurrent_segment_streams"]
+
+    if "overlap_torch_segments" in fallback_info:
+        assert isinstance(fallback_info["overlap_torch_segments"], bool)
+        info.overlap_torch_segments = fallback_info["overlap_torch_segments"]
+
+    if "share_segment_weights" in fallback_info:
+        assert isinstance(fallback_info["share_segment_weights"], bool)
+        info.share_segment_weights = fallback_info["share_segment_weights"]
+
+    if "partitioning_report_path" in fallback_info:
+        assert isinstance(fallback_info["partitioning_report_path"], str)
+        info.partitioning_report_path = fallback_info["partitioning_report_path"]
+
     if "forced_fallback_ops" in fallback_info:
         assert isinstance(fallback_info["forced_fallback_ops"], list)
         info.forced_fallback_operators = fallback_info["forced_fallback_ops"]
@@ -240,6 +282,22 @@ def _parse_compile_spec(compile_spec_: Dict[str, Any]) -> _ts_C.CompileSpec:
             compile_spec["enabled_precisions"]
         )
 
+    if "layer_precisions" in compile_spec:
+        assert isinstance(compile_spec["layer_precisions"], dict)
+        assert all(isinstance(k, str) for k in compile_spec["layer_precisions"])
+        info.layer_precisions = {
+            k: _parse_op_precision(p)
+            for k, p in compile_spec["layer_precisions"].items()
+        }
+
+    if "strongly_typed" in compile_spec:
+        assert isinstance(compile_spec["strongly_typed"], bool)
+        info.strongly_typed = compile_spec["strongly_typed"]
+
+    if "weight_streaming" in compile_spec:
+        assert isinstance(compile_spec["weight_streaming"], bool)
+        info.weight_streaming = compile_spec["weight_streaming"]
+
     if "calibrator" in compile_spec and compile_spec["calibrator"]:
         info.ptq_calibrator = compile_spec["calibrator"]
 
@@ -255,17 +313,106 @@ def _parse_compile_spec(compile_spec_: Dict[str, Any]) -> _ts_C.CompileSpec:
         assert isinstance(compile_spec["refit"], bool)
         info.refit = compile_spec["refit"]
 
+    if "strip_engine_weights" in compile_spec:
+        assert isinstance(compile_spec["strip_engine_weights"], bool)
+        info.strip_engine_weights = compile_spec["strip_engine_weights"]
+
+    if "loop_unroll_max_trip_count" in compile_spec:
+        assert isinstance(compile_spec["loop_unroll_max_trip_count"], int)
+        info.loop_unroll_max_trip_count = compile_spec["loop_unroll_max_trip_count"]
+
+    if "loop_unroll_max_body_size" in compile_spec:
+        assert isinstance(compile_spec["loop_unroll_max_body_size"], int)
+        info.loop_unroll_max_body_size = compile_spec["loop_unroll_max_body_size"]
+
     if "debug" in compile_spec:
         assert isinstance(compile_spec["debug"], bool)
         info.debug = compile_spec["debug"]
 
+    if "detailed_layer_info" in compile_spec:
+        assert isinstance(compile_spec["detailed_layer_info"], bool)
+        info.detailed_layer_info = compile_spec["detailed_layer_info"]
+
     if "allow_shape_tensors" in compile_spec:
         assert isinstance(compile_spec["allow_shape_tensors"], bool)
         info.allow_shape_tensors = compile_spec["allow_shape_tensors"]
 
+    if "share_device_memory" in compile_spec:
+        assert isinstance(compile_spec["share_device_memory"], bool)
+        info.share_device_memory = compile_spec["share_device_memory"]
+
+    if "share_cudagraph_pool" in compile_spec:
+        assert isinstance(compile_spec["share_cudagraph_pool"], bool)
+        info.share_cudagraph_pool = compile_spec["share_cudagraph_pool"]
+
+    if "fuse_torch_segments" in compile_spec:
+        assert isinstance(compile_spec["fuse_torch_segments"], bool)
+        info.fuse_torch_segments = compile_spec["fuse_torch_segments"]
+
+    if "background_build" in compile_spec:
+        assert isinstance(compile_spec["background_build"], bool)
+        info.background_build = compile_spec["background_build"]
+
+    if "plan_segment_activations" in compile_spec:
+        assert isinstance(compile_spec["plan_segment_activations"], bool)
+        info.plan_segment_activations = compile_spec["plan_segment_activations"]
+
+    if "low_memory" in compile_spec:
+        assert isinstance(compile_spec["low_memory"], bool)
+        info.low_memory = compile_spec["low_memory"]
+
+    if "shared_segment_calibration" in compile_spec:
+        assert isinstance(compile_spec["shared_segment_calibration"], bool)
+        info.shared_segment_calibration = compile_spec["shared_segment_calibration"]
+
+    if "output_formats" in compile_spec:
+        assert isinstance(compile_spec["output_formats"], (list, tuple))
+        info.output_formats = [
+            memory_format._from(f).to(_C.TensorFormat)
+            for f in compile_spec["output_formats"]
+        ]
+
+    if "segment_boundary_format" in compile_spec:
+        info.segment_boundary_format = memory_format._from(
+            compile_spec["segment_boundary_format"]
+        ).to(_C.TensorFormat)
+
+    if "num_build_workers" in compile_spec:
+        assert type(compile_spec["num_build_workers"]) is int
+        info.num_build_workers = compile_spec["num_build_workers"]
+
+    if "build_gpu_ids" in compile_spec:
+        assert isinstance(compile_spec["build_gpu_ids"], list)
+        assert all(type(i) is int for i in compile_spec["build_gpu_ids"])
+        info.build_gpu_ids = compile_spec["build_gpu_ids"]
+
+    if "timing_cache_path" in compile_spec:
+        assert isinstance(compile_spec["timing_cache_path"], str)
+        info.timing_cache_path = compile_spec["timing_cache_path"]
+
+    if "tactic_record_path" in compile_spec:
+        assert isinstance(compile_spec["tactic_record_path"], str)
+        info.tactic_record_path = compile_spec["tactic_record_path"]
+
+    if "tactic_replay_path" in compile_spec:
+        assert isinstance(compile_spec["tactic_replay_path"], str)
+        info.tactic_replay_path = compile_spec["tactic_replay_path"]
+
+    if "engine_cache_dir" in compile_spec:
+        assert isinstance(compile_spec["engine_cache_dir"], str)
+        info.engine_cache_dir = compile_spec["engine_cache_dir"]
+
+    if "engine_cache_size" in compile_spec:
+        assert type(compile_spec["engine_cache_size"]) is int
+        info.engine_cache_size = compile_spec["engine_cache_size"]
+
     if "device" in compile_spec:
         info.device = _parse_device(compile_spec["device"])
 
+    if "segment_devices" in compile_spec:
+        assert isinstance(compile_spec["segment_devices"], list)
+        info.segment_devices = [_parse_device(d) for d in compile_spec["segment_devices"]]
+
     if "capability" in compile_spec:
         capability = EngineCapability._from(compile_spec["capability"]).to(
             _C.EngineCapability
@@ -276,10 +423,30 @@ def _parse_compile_spec(compile_spec_: Dict[str, Any]) -> _ts_C.CompileSpec:
         assert type(compile_spec["num_avg_timing_iters"]) is int
         info.num_avg_timing_iters = compile_spec["num_avg_timing_iters"]
 
+    if "fast_build" in compile_spec:
+        assert isinstance(compile_spec["fast_build"], bool)
+        info.fast_build = compile_spec["fast_build"]
+
+    if "max_aux_streams" in compile_spec:
+        assert type(compile_spec["max_aux_streams"]) is int
+        info.max_aux_streams = compile_spec["max_aux_streams"]
+
+    if "version_compatible" in compile_spec:
+        assert isinstance(compile_spec["version_compatible"], bool)
+        info.version_compatible = compile_spec["version_compatible"]
+
+    if "exclude_lean_runtime" in compile_spec:
+        assert isinstance(compile_spec["exclude_lean_runtime"], bool)
+        info.exclude_lean_runtime = compile_spec["exclude_lean_runtime"]
+
     if "workspace_size" in compile_spec:
         assert type(compile_spec["workspace_size"]) is int
         info.workspace_size = compile_spec["workspace_size"]
 
+    if "device_memory_budget" in compile_spec:
+        assert type(compile_spec["device_memory_budget"]) is int
+        info.device_memory_budget = compile_spec["device_memory_budget"]
+
     if "dla_sram_size" in compile_spec:
         assert type(compile_spec["dla_sram_size"]) is int
         info.dla_sram_size = compile_spec["dla_sram_size"]
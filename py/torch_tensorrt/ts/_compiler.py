@@ -1,12 +1,12 @@
 from __future__ import annotations
 
 import warnings
-from typing import Any, List, Optional, Sequence, Set, Tuple
+from typing import Any, Dict, List, Optional, Sequence, Set, Tuple
 
 import torch
 import torch_tensorrt._C.ts as _C
 from torch_tensorrt._Device import Device
-from torch_tensorrt._enums import EngineCapability, dtype
+from torch_tensorrt._enums import EngineCapability, dtype, memory_format
 from torch_tensorrt._Input import Input
 from torch_tensorrt.ts._compile_spec import _parse_compile_spec, _parse_device
 
@@ -19,11 +19,21 @@ def compile(
     disable_tf32: bool = False,
     sparse_weights: bool = False,
     enabled_precisions: Optional[Set[torch.dtype | dtype]] = None,
+    layer_precisions: Optional[Dict[str, torch.dtype | dtype]] = None,
+    strongly_typed: bool = False,
+    weight_streaming: bool = False,
     refit: bool = False,
+    strip_engine_weights: bool = False,
     debug: bool = False,
+    detailed_layer_info: bool = False,
     capability: EngineCapability = EngineCapability.STANDARD,
     num_avg_timing_iters: int = 1,
+    fast_build: bool = False,
+    max_aux_streams: int = -1,
+    version_compatible: bool = False,
+    exclude_lean_runtime: bool = False,
     workspace_size: int = 0,
+    device_memory_budget: int = 0,
     dla_sram_size: int = 1048576,
     dla_local_dram_size: int = 1073741824,
     dla_global_dram_size: int = 536870912,
@@ -31,9 +41,39 @@ def compile(
     truncate_long_and_double: bool = False,
     require_full_compilation: bool = False,
     min_block_size: int = 3,
+    loop_unroll_max_trip_count: int = 16,
+    loop_unroll_max_body_size: int = 32,
+    cost_model_partitioning: bool = False,
+    op_latency_savings_us: Optional[Dict[str, float]] = None,
+    symbolic_shape_analysis: bool = False,
+    num_shape_analysis_workers: int = 1,
+    merge_non_tensor_boundaries: bool = False,
+    bridge_unsupported_ops: bool = False,
+    concurrent_segment_streams: int = 0,
+    overlap_torch_segments: bool = False,
+    share_segment_weights: bool = False,
+    partitioning_report_path: str = "",
     torch_executed_ops: Optional[List[str]] = None,
     torch_executed_modules: Optional[List[str]] = None,
     allow_shape_tensors: bool = False,
+    share_device_memory: bool = False,
+    share_cudagraph_pool: bool = False,
+    fuse_torch_segments: bool = False,
+    background_build: bool = False,
+    plan_segment_activations: bool = False,
+    low_memory: bool = False,
+    shared_segment_calibration: bool = False,
+    output_formats: Optional[List[torch.memory_format | memory_format]] = None,
+    segment_boundary_format: torch.memory_format | memory_format = memory_format.linear,
+    num_build_workers: int = 1,
+    build_gpu_ids: Optional[List[int]] = None,
+    segment_devices: Optional[List[Device]] = None,
+    timing_cache_path: str = "",
+    tactic_record_path: str = "",
+    tactic_replay_path: str = "",
+    engine_cache_dir: str = "",
+    engine_cache_size: int = 5368709120,
+    previous_module: Optional[torch.jit.ScriptModule] = None,
 ) -> torch.jit.ScriptModule:
     """Compile a TorchScript module for NVIDIA GPUs using TensorRT
 
@@ -42,6 +82,10 @@ def compile(
 
     Converts specifically the forward method of a TorchScript Module
 
+    The GIL is released while the module is compiled, so other Python threads (e.g. ones serving requests) keep running
+    and several modules can be compiled concurrently from different threads. The module must not be modified while it is
+    compiled. Calibrators are called with the GIL held, from the thread building their engine.
+
     Arguments:
         module (torch.jit.ScriptModule): Source module, a result of tracing or scripting a PyTorch
             ``torch.nn.Module``
@@ -83,21 +127,61 @@ def compile(
         disable_tf32 (bool): Force FP32 layers to use traditional as FP32 format vs the default behavior of rounding the inputs to 10-bit mantissas before multiplying, but accumulates the sum using 23-bit mantissas
         sparse_weights (bool): Enable sparsity for convolution and fully connected layers.
         enabled_precision (Set(Union(torch.dtype, torch_tensorrt.dtype))): The set of datatypes that TensorRT can use when selecting kernels
+        layer_precisions (Dict[str, Union(torch.dtype, torch_tensorrt.dtype)]): Precision layers are pinned to regardless of ``enabled_precisions``, keyed by node kind (e.g. ``"aten::layer_norm"``) or module path (e.g. ``"encoder.layers.0"``, covering its submodules). Values are ``torch.float``, or ``torch.half`` or ``torch.bfloat16`` if it is enabled
+        strongly_typed (bool): Build strongly typed networks, where every layer runs in the type its inputs have in the graph (set by the input dtypes and the casts of the model) instead of TensorRT choosing among ``enabled_precisions``. Cannot be combined with ``layer_precisions`` or calibration. Requires TensorRT 10
+        weight_streaming (bool): Build engines whose weights stay in host memory and are streamed to the device while they run, within a budget set at runtime with the ``device_memory_budget`` of their engines. Lets models larger than the GPU memory run. Requires ``strongly_typed`` and TensorRT 10
         refit (bool): Enable refitting
+        strip_engine_weights (bool): Save the engines without their weights, which shrinks the saved module to the structure of its engines. A loaded module runs once refit from the module it was compiled from (``torch_tensorrt::ts::refit`` of the C++ API), the engines can only be refit with other weights if ``refit`` is set as well. Requires TensorRT 10
         debug (bool): Enable debuggable engine
+        detailed_layer_info (bool): Record the type, formats, tactic and source node of every layer in the engines for the engine inspector
         capability (torch_tensorrt.EngineCapability): Restrict kernel selection to safe gpu kernels or safe dla kernels
         num_avg_timing_iters (int): Number of averaging timing iterations used to select kernels
+        fast_build (bool): Build engines as fast as possible at the cost of runtime performance (lowest builder optimization level, TensorRT's own tactics only, a single timing iteration). Meant for development and experiments
+        max_aux_streams (int): Maximum number of auxiliary streams TensorRT may run independent branches of an engine on, concurrently with the main stream. -1 lets TensorRT choose, 0 runs every layer on the main stream. The streams are taken from the PyTorch CUDA stream pool at runtime
+        version_compatible (bool): Build engines which later TensorRT versions can run through the lean runtime embedded in them. Running embedded lean runtimes has to be allowed at runtime
+        exclude_lean_runtime (bool): Leave the lean runtime out of version compatible engines, the runtime then has to load a lean runtime library to run them
         workspace_size (int): Maximum size of workspace given to TensorRT
+        device_memory_budget (int): Device memory in bytes all TensorRT engines of the module may use together for their activations and scratch, 0 leaves each engine to ``workspace_size``. The engines of a partitioned module get shares in proportion to the memory of their activations (all of it each with ``share_device_memory``), which caps the workspace their kernels are selected under. A warning is logged if the engines need more
         dla_sram_size (int): Fast software managed RAM used by DLA to communicate within a layer.
         dla_local_dram_size (int): Host RAM used by DLA to share intermediate tensor data across operations
         dla_global_dram_size (int): Host RAM used by DLA to store weights and metadata for execution
-        truncate_long_and_double (bool): Truncate weights provided in int64 or double (float64) to int32 and float32
+        truncate_long_and_double (bool): Truncate weights provided in int64 or double (float64) to int32 and float32. With TensorRT 10 and newer, int64 inputs are bound by the engines natively and do not need this
         calibrator (Union(torch_tensorrt._C.IInt8Calibrator, tensorrt.IInt8Calibrator)): Calibrator object which will provide data to the PTQ system for INT8 Calibration
         require_full_compilation (bool): Require modules to be compiled end to end or return an error as opposed to returning a hybrid graph where operations that cannot be run in TensorRT are run in PyTorch
         min_block_size (int): The minimum number of contiguous TensorRT convertible operations in order to run a set of operations in TensorRT
+        loop_unroll_max_trip_count (int): Unroll loops with a constant trip count of at most this many iterations so that they compile into one engine instead of running in PyTorch, only if every node of their body converts to TensorRT. 0 disables unrolling
+        loop_unroll_max_body_size (int): Maximum number of nodes in the body of a loop unrolled under ``loop_unroll_max_trip_count``
+        cost_model_partitioning (bool): Instead of ``min_block_size``, run a set of operations in TensorRT only if the latency they are estimated to save exceeds the overhead of the Torch <-> TensorRT boundaries around them
+        op_latency_savings_us (Dict[str, float]): Measured latency in microseconds saved per op kind (e.g. ``{"aten::conv2d": 40.0}``) by running it in TensorRT, replacing the cost model's built-in estimates
+        symbolic_shape_analysis (bool): Infer the input shapes of the segments of a partially compiled module from operator shape functions instead of running every PyTorch segment on example inputs, only segments the shape functions cannot resolve are run
+        num_shape_analysis_workers (int): Number of independent segments run concurrently, each on its own CUDA stream, when shape analysis runs segments on example inputs, 0 uses one worker per CPU thread
+        merge_non_tensor_boundaries (bool): Recompute non-tensor values (sizes, lists, scalars) inside the TensorRT segments which consume them instead of running their consumers in PyTorch, and merge the TensorRT segments around PyTorch segments they do not depend on
+        bridge_unsupported_ops (bool): Keep a single unsupported operator between two large TensorRT segments in TensorRT, calling its PyTorch kernel inside the engine through the TorchOp plugin, instead of splitting the graph around it. Only for static input shapes
+        concurrent_segment_streams (int): Number of CUDA streams the TensorRT segments of a partially compiled module are spread over so that segments which do not depend on each other, such as the branches of a multi-branch model, run concurrently. 0 or 1 runs them one after another
+        overlap_torch_segments (bool): Let PyTorch segments run while TensorRT segments they do not depend on are executing on other streams, instead of waiting for all of them first
+        share_segment_weights (bool): Pass large weights read by several TensorRT segments, such as tied input and output embeddings split by a PyTorch segment, to their engines as inputs bound to a single device copy instead of building a copy of them into each engine. Ignored for refittable engines
+        partitioning_report_path (str): File a JSON report of the partitioning is written to, listing each segment with its node count, its boundary tensors (shape, dtype, bytes moved and casts inserted) and why each node runs in PyTorch, with the fallback cost summarized per op kind
         torch_executed_ops (List[str]): List of aten operators that must be run in PyTorch. An error will be thrown if this list is not empty but ``require_full_compilation`` is True
         torch_executed_modules (List[str]): List of modules that must be run in PyTorch. An error will be thrown if this list is not empty but ``require_full_compilation`` is True
         allow_shape_tensors: (Experimental) Allow aten::size to output shape tensors using IShapeLayer in TensorRT
+        share_device_memory (bool): Run all TensorRT engines of a partitioned module out of one shared device scratch memory arena instead of one per engine
+        share_cudagraph_pool (bool): Capture the CUDA graphs of all TensorRT engines of a partitioned module (in subgraph CUDA graphs mode) into one shared graph memory pool, with the persistent input and output buffers of the graphs placed in one region sized for the largest engine instead of allocated per engine and input shape
+        fuse_torch_segments (bool): Compile the PyTorch subgraphs of a partitioned module which NNC supports (e.g. short chains of elementwise ops between TensorRT engines) into one kernel each instead of running them op by op through the TorchScript interpreter. Kernels are specialized for the opt input shapes, other shapes run through the interpreter
+        background_build (bool): Return the module as soon as it is partitioned and build its TensorRT engines on a background thread. TensorRT segments run their PyTorch subgraphs until their engines are ready, then switch to them. Requires partial compilation
+        plan_segment_activations (bool): Place the tensors the TensorRT engines of a partitioned module only pass to each other in one preallocated arena instead of allocating each engine output separately. Has no effect when engines are scheduled on concurrent streams
+        low_memory (bool): Lower the peak host memory of compiling a large partitioned module. TensorRT segments are built one at a time and the compiler drops its references to the weights of each segment as soon as its engine is built. Ignored with ``background_build``
+        shared_segment_calibration (bool): Calibrate all TensorRT segments of a partitioned module from a single pass of the calibrator over the module and write one calibration cache for all of them, instead of one pass per segment
+        output_formats (List[Union(torch.memory_format, torch_tensorrt.memory_format)]): Formats the outputs are returned in, by output index (later outputs are contiguous). ``hwc8``, ``hwc16`` and ``dhwc8`` (FP16 only) are returned as channels last strided views over a buffer with the channels padded to the vector width, which engines taking the same input format bind without a reformat
+        segment_boundary_format (Union(torch.memory_format, torch_tensorrt.memory_format)): Format of the tensors the TensorRT segments of a partitioned module pass to each other, e.g. ``torch_tensorrt.memory_format.hwc8`` for FP16 convolutional networks, which removes the reformat layers at the segment boundaries. Tensors whose type or shape the format does not support are passed contiguous
+        num_build_workers (int): Number of TensorRT segments of a partitioned module built concurrently, 0 uses one worker per CPU thread
+        build_gpu_ids (List[int]): GPUs the build workers are spread across, they must be the same model as the target device. By default every engine is built on the target device
+        segment_devices (List[Union(torch_tensorrt.Device, dict)]): Device each TensorRT segment of a partitioned module is built for, in segment order, e.g. a DLA core for the backbone and the GPU for the rest of the network. Later segments are built for the target device. Every device has to be a DLA core of the target device or a GPU of the same model, segments on other GPUs form the stages of a pipeline (requires multi device safe mode). Engines on different devices run on their own streams, so executions issued on different CUDA streams pipeline across the devices
+        timing_cache_path (str): Path of a TensorRT timing cache file which is loaded before building the engines and updated with the new tactic timings afterwards. Disabled if empty
+        tactic_record_path (str): File the tactics TensorRT chooses for every layer are recorded to, per engine. Disabled if empty
+        tactic_replay_path (str): File of recorded tactics every layer is restricted to, reproducing the recorded engines. Layers without a usable recorded tactic are left to TensorRT. Disabled if empty
+        engine_cache_dir (str): Directory of a cache of built engines shared between compilations and processes, engines whose graph, weights, input specs and settings are already cached are reused instead of rebuilt. Disabled if empty
+        engine_cache_size (int): Maximum size in bytes of the engine cache, the least recently used engines are evicted beyond it
+        previous_module (torch.jit.ScriptModule): Module previously compiled from an earlier revision of the model, TensorRT segments whose graph, weights, input specs and settings are unchanged reuse its engines instead of being rebuilt
 
     Returns:
         torch.jit.ScriptModule: Compiled TorchScript Module, when run it will execute via TensorRT
@@ -139,11 +223,23 @@ def compile(
         "disable_tf32": disable_tf32,  # Force FP32 layers to use traditional as FP32 format
         "sparse_weights": sparse_weights,  # Enable sparsity for convolution and fully connected layers.
         "enabled_precisions": enabled_precisions_set,  # Enabling FP16 kernels
+        "layer_precisions": layer_precisions if layer_precisions is not None else {},
+        "strongly_typed": strongly_typed,
+        "weight_streaming": weight_streaming,
         "refit": refit,  # enable refit
+        "strip_engine_weights": strip_engine_weights,
+        "loop_unroll_max_trip_count": loop_unroll_max_trip_count,
+        "loop_unroll_max_body_size": loop_unroll_max_body_size,
         "debug": debug,  # enable debuggable engine
+        "detailed_layer_info": detailed_layer_info,
         "capability": capability,  # Restrict kernel selection to safe gpu kernels or safe dla kernels
         "num_avg_timing_iters": num_avg_timing_iters,  # Number of averaging timing iterations used to select kernels
+        "fast_build": fast_build,
+        "max_aux_streams": max_aux_streams,
+        "version_compatible": version_compatible,
+        "exclude_lean_runtime": exclude_lean_runtime,
         "workspace_size": workspace_size,  # Maximum size of workspace given to TensorRT
+        "device_memory_budget": device_memory_budget,
         "dla_sram_size": dla_sram_size,
         "dla_local_dram_size": dla_local_dram_size,
         "dla_global_dram_size": dla_global_dram_size,
@@ -154,11 +250,46 @@ def compile(
             "forced_fallback_ops": torch_executed_op_list,
             "forced_fallback_modules": torch_executed_module_list,
             "min_block_size": min_block_size,
+            "cost_model_partitioning": cost_model_partitioning,
+            "op_latency_savings_us": (
+                op_latency_savings_us if op_latency_savings_us is not None else {}
+            ),
+            "symbolic_shape_analysis": symbolic_shape_analysis,
+            "num_shape_analysis_workers": num_shape_analysis_workers,
+            "merge_non_tensor_boundaries": merge_non_tensor_boundaries,
+            "bridge_unsupported_ops": bridge_unsupported_ops,
+            "concurrent_segment_streams": concurrent_segment_streams,
+            "overlap_torch_segments": overlap_torch_segments,
+            "share_segment_weights": share_segment_weights,
+            "partitioning_report_path": partitioning_report_path,
         },
         "allow_shape_tensors": allow_shape_tensors,
+        "share_device_memory": share_device_memory,
+        "share_cudagraph_pool": share_cudagraph_pool,
+        "fuse_torch_segments": fuse_torch_segments,
+        "background_build": background_build,
+        "plan_segment_activations": plan_segment_activations,
+        "low_memory": low_memory,
+        "shared_segment_calibration": shared_segment_calibration,
+        "output_formats": output_formats if output_formats is not None else [],
+        "segment_boundary_format": segment_boundary_format,
+        "num_build_workers": num_build_workers,
+        "build_gpu_ids": build_gpu_ids if build_gpu_ids is not None else [],
+        "segment_devices": segment_devices if segment_devices is not None else [],
+        "timing_cache_path": timing_cache_path,
+        "tactic_record_path": tactic_record_path,
+        "tactic_replay_path": tactic_replay_path,
+        "engine_cache_dir": engine_cache_dir,
+        "engine_cache_size": engine_cache_size,
     }
 
-    compiled_cpp_mod = _C.compile_graph(module._c, _parse_compile_spec(spec))
+    parsed_spec = _parse_compile_spec(spec)
+    # Passed separately as the spec is deep copied while parsing, which would reload the engines of the module
+    if previous_module is not None:
+        assert isinstance(previous_module, torch.jit.ScriptModule)
+        parsed_spec._set_previous_module(previous_module._c)
+
+    compiled_cpp_mod = _C.compile_graph(module._c, parsed_spec)
     compiled_module: torch.jit.ScriptModule = torch.jit._recursive.wrap_cpp_module(
         compiled_cpp_mod
     )
@@ -173,22 +304,39 @@ def convert_method_to_trt_engine(
     disable_tf32: bool = False,
     sparse_weights: bool = False,
     enabled_precisions: Optional[Set[torch.dtype | dtype]] = None,
+    layer_precisions: Optional[Dict[str, torch.dtype | dtype]] = None,
+    strongly_typed: bool = False,
+    weight_streaming: bool = False,
     refit: bool = False,
     debug: bool = False,
+    detailed_layer_info: bool = False,
     capability: EngineCapability = EngineCapability.STANDARD,
     num_avg_timing_iters: int = 1,
+    fast_build: bool = False,
+    max_aux_streams: int = -1,
+    version_compatible: bool = False,
+    exclude_lean_runtime: bool = False,
     workspace_size: int = 0,
+    device_memory_budget: int = 0,
     dla_sram_size: int = 1048576,
     dla_local_dram_size: int = 1073741824,
     dla_global_dram_size: int = 536870912,
     truncate_long_and_double: int = False,
     calibrator: object = None,
     allow_shape_tensors: bool = False,
+    timing_cache_path: str = "",
+    tactic_record_path: str = "",
+    tactic_replay_path: str = "",
+    engine_cache_dir: str = "",
+    engine_cache_size: int = 5368709120,
+    output_formats: Optional[List[torch.memory_format | memory_format]] = None,
 ) -> bytes:
     """Convert a TorchScript module method to a serialized TensorRT engine
 
     Converts a specified method of a module to a serialized TensorRT engine given a dictionary of conversion settings
 
+    Like :func:`compile`, the conversion runs without holding the GIL and must not race with modifications of the module
+
     Arguments:
         module (torch.jit.ScriptModule): Source module, a result of tracing or scripting a PyTorch
             ``torch.nn.Module``
@@ -232,17 +380,32 @@ def convert_method_to_trt_engine(
         disable_tf32 (bool): Force FP32 layers to use traditional as FP32 format vs the default behavior of rounding the inputs to 10-bit mantissas before multiplying, but accumulates the sum using 23-bit mantissas
         sparse_weights (bool): Enable sparsity for convolution and fully connected layers.
         enabled_precision (Set(Union(torch.dtype, torch_tensorrt.dtype))): The set of datatypes that TensorRT can use when selecting kernels
+        layer_precisions (Dict[str, Union(torch.dtype, torch_tensorrt.dtype)]): Precision layers are pinned to regardless of ``enabled_precisions``, keyed by node kind (e.g. ``"aten::layer_norm"``) or module path (e.g. ``"encoder.layers.0"``, covering its submodules). Values are ``torch.float``, or ``torch.half`` or ``torch.bfloat16`` if it is enabled
+        strongly_typed (bool): Build strongly typed networks, where every layer runs in the type its inputs have in the graph (set by the input dtypes and the casts of the model) instead of TensorRT choosing among ``enabled_precisions``. Cannot be combined with ``layer_precisions`` or calibration. Requires TensorRT 10
+        weight_streaming (bool): Build engines whose weights stay in host memory and are streamed to the device while they run, within a budget set at runtime with the ``device_memory_budget`` of their engines. Lets models larger than the GPU memory run. Requires ``strongly_typed`` and TensorRT 10
         refit (bool): Enable refitting
         debug (bool): Enable debuggable engine
+        detailed_layer_info (bool): Record the type, formats, tactic and source node of every layer in the engines for the engine inspector
         capability (torch_tensorrt.EngineCapability): Restrict kernel selection to safe gpu kernels or safe dla kernels
         num_avg_timing_iters (int): Number of averaging timing iterations used to select kernels
+        fast_build (bool): Build engines as fast as possible at the cost of runtime performance (lowest builder optimization level, TensorRT's own tactics only, a single timing iteration). Meant for development and experiments
+        max_aux_streams (int): Maximum number of auxiliary streams TensorRT may run independent branches of an engine on, concurrently with the main stream. -1 lets TensorRT choose, 0 runs every layer on the main stream. The streams are taken from the PyTorch CUDA stream pool at runtime
+        version_compatible (bool): Build engines which later TensorRT versions can run through the lean runtime embedded in them. Running embedded lean runtimes has to be allowed at runtime
+        exclude_lean_runtime (bool): Leave the lean runtime out of version compatible engines, the runtime then has to load a lean runtime library to run them
         workspace_size (int): Maximum size of workspace given to TensorRT
+        device_memory_budget (int): Device memory in bytes all TensorRT engines of the module may use together for their activations and scratch, 0 leaves each engine to ``workspace_size``. The engines of a partitioned module get shares in proportion to the memory of their activations (all of it each with ``share_device_memory``), which caps the workspace their kernels are selected under. A warning is logged if the engines need more
         dla_sram_size (int): Fast software managed RAM used by DLA to communicate within a layer.
         dla_local_dram_size (int): Host RAM used by DLA to share intermediate tensor data across operations
         dla_global_dram_size (int): Host RAM used by DLA to store weights and metadata for execution
-        truncate_long_and_double (bool): Truncate weights provided in int64 or double (float64) to int32 and float32
+        truncate_long_and_double (bool): Truncate weights provided in int64 or double (float64) to int32 and float32. With TensorRT 10 and newer, int64 inputs are bound by the engines natively and do not need this
         calibrator (Union(torch_tensorrt._C.IInt8Calibrator, tensorrt.IInt8Calibrator)): Calibrator object which will provide data to the PTQ system for INT8 Calibration
         allow_shape_tensors: (Experimental) Allow aten::size to output shape tensors using IShapeLayer in TensorRT
+        timing_cache_path (str): Path of a TensorRT timing cache file which is loaded before building the engine and updated with the new tactic timings afterwards. Disabled if empty
+        tactic_record_path (str): File the tactics TensorRT chooses for every layer are recorded to, per engine. Disabled if empty
+        tactic_replay_path (str): File of recorded tactics every layer is restricted to, reproducing the recorded engines. Layers without a usable recorded tactic are left to TensorRT. Disabled if empty
+        engine_cache_dir (str): Directory of a cache of built engines shared between compilations and processes, engines whose graph, weights, input specs and settings are already cached are reused instead of rebuilt. Disabled if empty
+        engine_cache_size (int): Maximum size in bytes of the engine cache, the least recently used engines are evicted beyond it
+        output_formats (List[Union(torch.memory_format, torch_tensorrt.memory_format)]): Formats the engine outputs are bound in, by output index (later outputs are linear). ``hwc8``, ``hwc16`` and ``dhwc8`` are only supported for FP16 outputs
 
     Returns:
         bytes: Serialized TensorRT engine, can either be saved to a file or deserialized via TensorRT APIs
@@ -269,14 +432,29 @@ def convert_method_to_trt_engine(
         "disable_tf32": disable_tf32,  # Force FP32 layers to use traditional as FP32 format vs the default behavior of rounding the inputs to 10-bit mantissas before multiplying, but accumulates the sum using 23-bit mantissas
         "sparse_weights": sparse_weights,  # Enable sparsity for convolution and fully connected layers.
         "enabled_precisions": enabled_precisions_set,  # Enabling FP16 kernels
+        "layer_precisions": layer_precisions if layer_precisions is not None else {},
+        "strongly_typed": strongly_typed,
+        "weight_streaming": weight_streaming,
         "refit": refit,  # enable refit
         "debug": debug,  # enable debuggable engine
+        "detailed_layer_info": detailed_layer_info,
         "capability": capability,  # Restrict kernel selection to safe gpu kernels or safe dla kernels
         "num_avg_timing_iters": num_avg_timing_iters,  # Number of averaging timing iterations used to select kernels
+        "fast_build": fast_build,
+        "max_aux_streams": max_aux_streams,
+        "version_compatible": version_compatible,
+        "exclude_lean_runtime": exclude_lean_runtime,
         "workspace_size": workspace_size,  # Maximum size of workspace given to TensorRT
+        "device_memory_budget": device_memory_budget,
         "calibrator": calibrator,
         "truncate_long_and_double": truncate_long_and_double,
         "allow_shape_tensors": allow_shape_tensors,
+        "timing_cache_path": timing_cache_path,
+        "tactic_record_path": tactic_record_path,
+        "tactic_replay_path": tactic_replay_path,
+        "engine_cache_dir": engine_cache_dir,
+        "engine_cache_size": engine_cache_size,
+        "output_formats": output_formats if output_formats is not None else [],
     }
 
     engine_str = _C.convert_graph_to_trt_engine(
@@ -344,7 +522,9 @@ def check_method_op_support(
     """Checks to see if a method is fully supported by torch_tensorrt
 
     Checks if a method of a TorchScript module can be compiled by torch_tensorrt, if not, a list of operators
-    that are not supported are printed out and the function returns false, else true.
+    that are not supported are printed out and the function returns false, else true. The lowered graph
+    is kept so that compiling the module next, while its weights are unchanged and with the default
+    lowering settings, does not lower it again.
 
     Arguments:
         module (torch.jit.ScriptModule): Source module, a result of tracing or scripting a PyTorch
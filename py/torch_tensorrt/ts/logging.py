@@ -2,12 +2,17 @@ from enum import Enum
 
 from torch_tensorrt._C import (
     LogLevel,
+    _flush,
+    _get_is_async_output_on,
     _get_is_colored_output_on,
     _get_logging_prefix,
+    _get_max_messages_per_second,
     _get_reportable_log_level,
     _log,
+    _set_is_async_output_on,
     _set_is_colored_output_on,
     _set_logging_prefix,
+    _set_max_messages_per_second,
     _set_reportable_log_level,
 )
 
@@ -95,6 +100,54 @@ def set_is_colored_output_on(colored_output_on: bool) -> None:
     _set_is_colored_output_on(colored_output_on)
 
 
+def get_is_async_output_on() -> bool:
+    """Get if messages are written to the log by a background thread
+
+    Returns:
+        bool: If asynchronous output is on
+    """
+    return bool(_get_is_async_output_on())
+
+
+def set_is_async_output_on(async_output_on: bool) -> None:
+    """Enable or disable writing messages to the log on a background thread
+
+    Threads logging on a hot path, like runtime warnings fired on every inference, then never wait on the output.
+    While it is on, messages repeated by one call site are rate limited (see ``set_max_messages_per_second``) and
+    messages logged while the queue is full are dropped and counted. Errors are still written right away
+
+    Args:
+        async_output_on (bool): If asynchronous output should be enabled or not
+    """
+    _set_is_async_output_on(async_output_on)
+
+
+def get_max_messages_per_second() -> int:
+    """Get the number of messages one call site writes per second with asynchronous output
+
+    Returns:
+        int: Messages per call site and second, 0 if they are not limited
+    """
+    return int(_get_max_messages_per_second())
+
+
+def set_max_messages_per_second(max_messages_per_second: int) -> None:
+    """Set the number of messages one call site writes per second with asynchronous output
+
+    Repeats of the previous message of a call site within the same second are dropped too, the next message written
+    by the site reports how many were suppressed
+
+    Args:
+        max_messages_per_second (int): Messages per call site and second, 0 writes every message
+    """
+    _set_max_messages_per_second(max_messages_per_second)
+
+
+def flush() -> None:
+    """Block until the messages queued for asynchronous output are written"""
+    _flush()
+
+
 def log(level: Level, msg: str) -> None:
     """Add a new message to the log
 
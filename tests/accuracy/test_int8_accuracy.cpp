@@ -74,6 +74,120 @@ TEST_P(AccuracyTests, INT8AccuracyIsClose) {
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_accuracy, trt_accuracy, 3));
 }
 
+TEST_P(AccuracyTests, INT8StreamingCalibratorAccuracyIsClose) {
+  // No Stack transform, so the calibrator stacks the examples of each batch itself
+  auto calibration_dataset =
+      datasets::CIFAR10("tests/accuracy/datasets/data/cifar-10-batches-bin/", datasets::CIFAR10::Mode::kTest)
+          .use_subset(320)
+          .map(torch::data::transforms::Normalize<>({0.4914, 0.4822, 0.4465}, {0.2023, 0.1994, 0.2010}));
+  auto calibration_dataloader = torch::data::make_data_loader(
+      std::move(calibration_dataset), torch::data::DataLoaderOptions().batch_size(32).workers(2));
+
+  std::string calibration_cache_file = "/tmp/vgg16_TRT_ptq_streaming_calibration.cache";
+
+  auto calibrator = torch_tensorrt::ptq::make_int8_streaming_calibrator(
+      std::move(calibration_dataloader), calibration_cache_file, false);
+
+  std::vector<torch_tensorrt::Input> inputs = {
+      torch_tensorrt::Input(std::vector<int64_t>({32, 3, 32, 32}), torch_tensorrt::DataType::kFloat)};
+  auto compile_spec = torch_tensorrt::ts::CompileSpec(inputs);
+  compile_spec.enabled_precisions.insert(torch::kF16);
+  compile_spec.enabled_precisions.insert(torch::kI8);
+  compile_spec.ptq_calibrator = calibrator;
+
+  mod.eval();
+
+  auto eval_dataset =
+      datasets::CIFAR10("tests/accuracy/datasets/data/cifar-10-batches-bin/", datasets::CIFAR10::Mode::kTest)
+          .use_subset(3200)
+          .map(torch::data::transforms::Normalize<>({0.4914, 0.4822, 0.4465}, {0.2023, 0.1994, 0.2010}))
+          .map(torch::data::transforms::Stack<>());
+  auto eval_dataloader = torch::data::make_data_loader(
+      std::move(eval_dataset), torch::data::DataLoaderOptions().batch_size(32).workers(2));
+
+  auto trt_mod = torch_tensorrt::ts::compile(mod, compile_spec);
+
+  torch::Tensor jit_correct = torch::zeros({1}, {torch::kCUDA}), trt_correct = torch::zeros({1}, {torch::kCUDA});
+  torch::Tensor total = torch::zeros({1}, {torch::kCUDA});
+  for (auto batch : *eval_dataloader) {
+    auto images = batch.data.to(torch::kCUDA);
+    auto targets = batch.target.to(torch::kCUDA);
+
+    auto jit_predictions = std::get<1>(torch::max(mod.forward({images}).toTensor(), 1, false));
+    auto trt_predictions = std::get<1>(torch::max(trt_mod.forward({images}).toTensor(), 1, false));
+    trt_predictions = trt_predictions.reshape(trt_predictions.sizes()[0]);
+
+    total += targets.sizes()[0];
+    jit_correct += torch::sum(torch::eq(jit_predictions, targets));
+    trt_correct += torch::sum(torch::eq(trt_predictions, targets));
+  }
+  torch::Tensor jit_accuracy = (jit_correct / total) * 100;
+  torch::Tensor trt_accuracy = (trt_correct / total) * 100;
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_accuracy, trt_accuracy, 3));
+}
+
+TEST_P(AccuracyTests, INT8DeviceCalibratorAccuracyIsClose) {
+  auto calibration_dataset =
+      datasets::CIFAR10("tests/accuracy/datasets/data/cifar-10-batches-bin/", datasets::CIFAR10::Mode::kTest)
+          .use_subset(320)
+          .map(torch::data::transforms::Normalize<>({0.4914, 0.4822, 0.4465}, {0.2023, 0.1994, 0.2010}))
+          .map(torch::data::transforms::Stack<>());
+  auto calibration_dataloader = torch::data::make_data_loader(
+      std::move(calibration_dataset), torch::data::DataLoaderOptions().batch_size(32).workers(2));
+  std::vector<std::vector<torch::Tensor>> batches;
+  for (auto batch : *calibration_dataloader) {
+    batches.push_back({batch.data.to(torch::kCUDA)});
+  }
+
+  std::vector<torch_tensorrt::Input> inputs = {
+      torch_tensorrt::Input(std::vector<int64_t>({32, 3, 32, 32}), torch_tensorrt::DataType::kFloat)};
+  auto compile_spec = torch_tensorrt::ts::CompileSpec(inputs);
+  compile_spec.enabled_precisions.insert(torch::kF16);
+  compile_spec.enabled_precisions.insert(torch::kI8);
+
+  mod.eval();
+
+  auto calibrator = torch_tensorrt::ptq::make_int8_device_calibrator(std::move(batches), "", false);
+  compile_spec.ptq_calibrator = calibrator;
+  auto calibrated_mod = torch_tensorrt::ts::compile(mod, compile_spec);
+  auto cache = calibrator.get_calibration_cache();
+  ASSERT_FALSE(cache.empty());
+
+  // Calibrating from the cache kept in memory needs no batches
+  auto cache_calibrator = torch_tensorrt::ptq::make_int8_device_calibrator(
+      std::vector<std::vector<torch::Tensor>>(), cache, true);
+  compile_spec.ptq_calibrator = cache_calibrator;
+  auto trt_mod = torch_tensorrt::ts::compile(mod, compile_spec);
+
+  auto eval_dataset =
+      datasets::CIFAR10("tests/accuracy/datasets/data/cifar-10-batches-bin/", datasets::CIFAR10::Mode::kTest)
+          .use_subset(3200)
+          .map(torch::data::transforms::Normalize<>({0.4914, 0.4822, 0.4465}, {0.2023, 0.1994, 0.2010}))
+          .map(torch::data::transforms::Stack<>());
+  auto eval_dataloader = torch::data::make_data_loader(
+      std::move(eval_dataset), torch::data::DataLoaderOptions().batch_size(32).workers(2));
+
+  torch::Tensor jit_correct = torch::zeros({1}, {torch::kCUDA}), trt_correct = torch::zeros({1}, {torch::kCUDA});
+  torch::Tensor total = torch::zeros({1}, {torch::kCUDA});
+  for (auto batch : *eval_dataloader) {
+    auto images = batch.data.to(torch::kCUDA);
+    auto targets = batch.target.to(torch::kCUDA);
+
+    auto jit_predictions = std::get<1>(torch::max(mod.forward({images}).toTensor(), 1, false));
+    auto trt_predictions = std::get<1>(torch::max(trt_mod.forward({images}).toTensor(), 1, false));
+    trt_predictions = trt_predictions.reshape(trt_predictions.sizes()[0]);
+
+    total += targets.sizes()[0];
+    jit_correct += torch::sum(torch::eq(jit_predictions, targets));
+    trt_correct += torch::sum(torch::eq(trt_predictions, targets));
+  }
+  torch::Tensor jit_accuracy = (jit_correct / total) * 100;
+  torch::Tensor trt_accuracy = (trt_correct / total) * 100;
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_accuracy, trt_accuracy, 3));
+}
+
 INSTANTIATE_TEST_SUITE_P(
     INT8AccuracyIsCloseSuite,
     AccuracyTests,
@@ -279,3 +279,50 @@ TEST(Converters, ATenGELUConvertsCorrectly) {
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0], 5e-2));
 }
 #endif
+
+#if NV_TENSORRT_MAJOR >= 10
+TEST(Converters, ATenGELUConvertsToNativeActivation) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : str = prim::Constant[value="none"]()
+        %3 : Tensor = aten::gelu(%0, %1)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto in = at::randn({4, 16}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  in = at::clone(in);
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in});
+
+  // The erf form is exact, unlike the tanh approximation aten::gelu used to be lowered to
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+}
+
+TEST(Converters, ATenGELUTanhApproximationConvertsToNativeActivation) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : str = prim::Constant[value="tanh"]()
+        %3 : Tensor = aten::gelu(%0, %1)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto in = at::randn({4, 16}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  in = at::clone(in);
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+}
+#endif
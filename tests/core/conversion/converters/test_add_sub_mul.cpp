@@ -189,3 +189,55 @@ TEST(Converters, ElementWiseTypePromotionDisambiguatesCastNames) {
         return (%5))IR";
   pointwise_test_helper(graph, false, false, {4, 3, 3, 3}, {4, 3, 3, 3}, false, at::kInt, at::kFloat);
 }
+
+TEST(Converters, ATenAddLargeUniformConstantConvertsCorrectly) {
+  // The evaluated tensor is generated in the engine instead of stored in it
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : None = prim::Constant()
+        %2 : float = prim::Constant[value=0.5]()
+        %3 : int = prim::Constant[value=1]()
+        %4 : int[] = aten::size(%0)
+        %5 : Tensor = aten::full(%4, %2, %1, %1, %1, %1)
+        %6 : Tensor = aten::add(%0, %5, %3)
+        return (%6))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in = at::randn({32, 64}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+}
+
+TEST(Converters, ATenAddLargeArithmeticConstantConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : None = prim::Constant()
+        %2 : float = prim::Constant[value=2048.]()
+        %3 : int = prim::Constant[value=1]()
+        %4 : int[] = aten::size(%0)
+        %5 : Tensor = aten::arange(%2, %1, %1, %1, %1)
+        %6 : Tensor = aten::reshape(%5, %4)
+        %7 : Tensor = aten::add(%0, %6, %3)
+        return (%7))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in = at::randn({32, 64}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+}
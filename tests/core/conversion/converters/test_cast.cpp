@@ -220,3 +220,32 @@ TEST(Converters, ATenTypeAsConvertsCorrectly) {
   ASSERT_TRUE(trt_results[0].scalar_type() == trt_results[1].scalar_type());
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape_as(jit_results[0])));
 }
+
+TEST(Converters, ATenToHalfInStronglyTypedNetworkConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%x.1 : Tensor):
+        %2 : int = prim::Constant[value=5]()
+        %3 : bool = prim::Constant[value=0]()
+        %4 : None = prim::Constant()
+        %5 : int = prim::Constant[value=6]()
+        %6 : Tensor = aten::to(%x.1, %2, %3, %3, %4)
+        %7 : Tensor = aten::relu(%6)
+        %8 : Tensor = aten::to(%7, %5, %3, %3, %4)
+        return (%8))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto in = at::randn({3, 4, 3}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  torch_tensorrt::core::conversion::BuilderSettings settings;
+  settings.strongly_typed = true;
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngineWithSettings(g, params, {in}, settings);
+
+  ASSERT_TRUE(trt_results[0].scalar_type() == at::kFloat);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+}
@@ -0,0 +1,62 @@
+#include <string>
+#include "core/compiler.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+TEST(Converters, DataDependentConditionalConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%x : Tensor, %y : Tensor):
+        %none : None = prim::Constant()
+        %zero : int = prim::Constant[value=0]()
+        %one : int = prim::Constant[value=1]()
+        %sum : Tensor = aten::sum(%x, %none)
+        %positive : Tensor = aten::gt(%sum, %zero)
+        %cond : bool = aten::Bool(%positive)
+        %out : Tensor = prim::If(%cond)
+          block0():
+            %a : Tensor = aten::mul(%x, %y)
+            -> (%a)
+          block1():
+            %b : Tensor = aten::sub(%x, %y, %one)
+            -> (%b)
+        %res : Tensor = aten::relu(%out)
+        return (%res))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto y = at::randn({3, 4}, {at::kCUDA});
+  // One input for each branch of the conditional
+  for (auto x : {at::rand({3, 4}, {at::kCUDA}), -at::rand({3, 4}, {at::kCUDA})}) {
+    auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+    auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {x, y});
+    auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {x, y});
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0], 2e-6));
+  }
+}
+
+TEST(Converters, CountedLoopCarryingTensorsConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%x : Tensor, %y : Tensor):
+        %trips : int = prim::Constant[value=4]()
+        %true : bool = prim::Constant[value=1]()
+        %one : int = prim::Constant[value=1]()
+        %acc : Tensor, %scale : Tensor = prim::Loop(%trips, %true, %x, %y)
+          block0(%i : int, %acc.1 : Tensor, %scale.1 : Tensor):
+            %next : Tensor = aten::mul(%acc.1, %scale.1)
+            %bias : Tensor = aten::add(%next, %y, %one)
+            -> (%true, %bias, %scale.1)
+        return (%acc))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto x = at::randn({2, 5}, {at::kCUDA});
+  auto y = at::rand({2, 5}, {at::kCUDA});
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {x, y});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {x, y});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0], 2e-6));
+}
@@ -78,6 +78,41 @@ TEST(Converters, ATenConvolutionConvertsCorrectly) {
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt));
 }
 
+TEST(Converters, ATenConvolutionWithHWC8OutputConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %1 : Half(6, 3, 3, 3, strides=[27, 9, 3, 1]),
+            %2 : Half(6)):
+        %3 : int = prim::Constant[value=1]()
+        %4 : int = prim::Constant[value=0]()
+        %7 : bool = prim::Constant[value=0]()
+        %8 : int[] = prim::ListConstruct(%3, %3)
+        %9 : int[] = prim::ListConstruct(%4, %4)
+        %12 : Tensor = aten::_convolution(%0, %1, %2, %8, %9, %8, %7, %9, %3, %7, %7, %7, %7)
+        return (%12))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in = at::randn({1, 3, 10, 10}, {at::kCUDA}).to(at::kHalf);
+  auto w = at::randn({6, 3, 3, 3}, {at::kCUDA}).to(at::kHalf);
+  auto b = at::randn({6}, {at::kCUDA}).to(at::kHalf);
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w, b});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  torch_tensorrt::core::conversion::BuilderSettings settings;
+  settings.enabled_precisions.insert(nvinfer1::DataType::kHALF);
+  settings.output_formats = {nvinfer1::TensorFormat::kHWC8};
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w, b});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngineWithSettings(g, params, {in}, settings);
+
+  // The output is a channels last view over channels padded to eight
+  ASSERT_EQ(trt_results[0].stride(1), 1);
+  ASSERT_EQ(trt_results[0].stride(3), 8);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].contiguous(), 2e-2));
+}
+
 TEST(Converters, ATenConvolution1dConvertsCorrectly) {
   const auto graph = R"IR(
       graph(%0 : Tensor,
@@ -935,3 +970,34 @@ TEST(Converters, ATenConvTransposeWithGroupConvertsCorrectly) {
 
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt));
 }
+
+TEST(Converters, ATenConvolutionWithNonContiguousDeviceWeightsConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %1 : Float(8, 3, 5, 5),
+            %2 : Float(8)):
+        %3 : int = prim::Constant[value=1]()
+        %4 : int = prim::Constant[value=0]()
+        %7 : bool = prim::Constant[value=0]()
+        %8 : int[] = prim::ListConstruct(%3, %3)
+        %9 : int[] = prim::ListConstruct(%4, %4)
+        %12 : Tensor = aten::_convolution(%0, %1, %2, %8, %9, %8, %7, %9, %3, %7, %7, %7, %7)
+        return (%12))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  // The weights are permuted views on the GPU, they are made contiguous there and copied to the host asynchronously
+  auto in = at::randint(1, 10, {1, 3, 10, 10}, {at::kCUDA});
+  auto w = at::randint(1, 10, {5, 5, 3, 8}, {at::kCUDA}).permute({3, 2, 0, 1});
+  auto b = at::randint(1, 10, {8}, {at::kCUDA});
+  ASSERT_FALSE(w.is_contiguous());
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w, b});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {at::clone(in)});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {at::clone(in)});
+
+  auto trt = trt_results[0].reshape(jit_results[0].sizes());
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt));
+}
@@ -102,3 +102,80 @@ TEST(Converters, ATenEinsumConvertsVectorsCorrectly) {
 
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape_as(jit_results[0])));
 }
+
+TEST(Converters, ATenEinsumConvertsThreeOperandChainCorrectly) {
+  const auto graph = R"IR(
+      graph(%x.1 : Tensor, %x.2 : Tensor, %x.3 : Tensor):
+        %0 : str = prim::Constant[value="ij,jk,kl->il"]()
+        %3 : Tensor[] = prim::ListConstruct(%x.1, %x.2, %x.3)
+        %none : NoneType = prim::Constant()
+        %4 : Tensor = aten::einsum(%0, %3, %none)
+        return (%4))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  // Contracting the last two operands first is cheaper
+  auto in_0 = at::rand({32, 64}, {at::kCUDA});
+  auto in_1 = at::rand({64, 48}, {at::kCUDA});
+  auto in_2 = at::rand({48, 4}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in_0, in_1, in_2});
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in_0, in_1, in_2});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape_as(jit_results[0])));
+}
+
+TEST(Converters, ATenEinsumConvertsBatchedContractionWithPathCorrectly) {
+  const auto graph = R"IR(
+      graph(%x.1 : Tensor, %x.2 : Tensor, %x.3 : Tensor):
+        %0 : str = prim::Constant[value="bhqd,bhkd,bhkv->bqhv"]()
+        %3 : Tensor[] = prim::ListConstruct(%x.1, %x.2, %x.3)
+        %p0 : int = prim::Constant[value=0]()
+        %p1 : int = prim::Constant[value=1]()
+        %path : int[] = prim::ListConstruct(%p0, %p1, %p0, %p1)
+        %4 : Tensor = aten::einsum(%0, %3, %path)
+        return (%4))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in_0 = at::rand({2, 4, 8, 16}, {at::kCUDA});
+  auto in_1 = at::rand({2, 4, 10, 16}, {at::kCUDA});
+  auto in_2 = at::rand({2, 4, 10, 6}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in_0, in_1, in_2});
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in_0, in_1, in_2});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape_as(jit_results[0])));
+}
+
+TEST(Converters, ATenEinsumConvertsEllipsisCorrectlyWithDynamicInput) {
+  const auto graph = R"IR(
+      graph(%x.1 : Tensor, %x.2 : Tensor):
+        %0 : str = prim::Constant[value="...ij,jk"]()
+        %3 : Tensor[] = prim::ListConstruct(%x.1, %x.2)
+        %none : NoneType = prim::Constant()
+        %4 : Tensor = aten::einsum(%0, %3, %none)
+        return (%4))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in_0 = at::rand({3, 5, 7, 9}, {at::kCUDA});
+  auto in_1 = at::rand({9, 4}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in_0, in_1});
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngineDynamic(g, params, {in_0, in_1}, true);
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape_as(jit_results[0])));
+}
@@ -830,3 +830,53 @@ TEST(Converters, ATenMeshGridConvertsCorrectly) {
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[1], trt_results[1]));
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[2], trt_results[2]));
 }
+
+TEST(Converters, ATenExpandIntoElementwiseBroadcastsCorrectly) {
+  const auto graph = R"IR(
+    graph(%x : Tensor, %mask : Tensor):
+            %2 : int[] = prim::Constant[value=[2, 3, 4]]()
+            %3 : bool = prim::Constant[value=0]()
+            %4 : Tensor = aten::expand(%mask, %2, %3)
+            %5 : Tensor = aten::mul(%x, %4)
+            return (%5))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+
+  torch::jit::parseIR(graph, g.get());
+
+  auto x = at::randn({2, 3, 4}, {at::kCUDA});
+  auto mask = at::randint(0, 2, {3, 1}, {at::kCUDA}).to(torch::kFloat);
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {x, mask});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {x, mask});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+}
+
+TEST(Converters, ATenExpandIntoElementwiseKeepsExpandedShapeCorrectly) {
+  // The other operand does not cover the expanded dims, so the expansion is still what sets the output shape
+  const auto graph = R"IR(
+    graph(%x : Tensor, %y : Tensor):
+            %2 : int[] = prim::Constant[value=[4, 5]]()
+            %3 : bool = prim::Constant[value=0]()
+            %4 : Tensor = aten::expand(%x, %2, %3)
+            %5 : Tensor = aten::mul(%4, %y)
+            %6 : Tensor = aten::relu(%4)
+            return (%5, %6))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+
+  torch::jit::parseIR(graph, g.get());
+
+  auto x = at::randn({1, 5}, {at::kCUDA});
+  auto y = at::randn({1, 5}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {x, y});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {x, y});
+
+  ASSERT_EQ(jit_results[0].sizes(), trt_results[0].sizes());
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[1], trt_results[1]));
+}
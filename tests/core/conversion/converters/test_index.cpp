@@ -287,4 +287,93 @@ TEST(Converters, ATenIndexTensorNoneIdx1ConvertsCorrectly) {
   auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in1, index0_trt});
 
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
-}
\ No newline at end of file
+}
+TEST(Converters, ATenIndexTensorBroadcastNegativeIndicesConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%x.1 : Tensor,
+            %index0 : Tensor,
+            %index1 : Tensor):
+        %5 : NoneType = prim::Constant()
+        %18 : Tensor?[] = prim::ListConstruct(%5, %index0, %index1)
+        %19 : Tensor = aten::index(%x.1, %18)
+        return (%19))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  // [3, 1] and [4] indices broadcast to [3, 4]
+  auto in1 = at::randint(1, 10, {2, 5, 6, 3}, {at::kCUDA});
+  auto index0 = at::tensor({{0}, {-1}, {3}}, {at::kCUDA}).to(torch::kLong);
+  auto index1 = at::tensor({1, -2, 5, 0}, {at::kCUDA}).to(torch::kLong);
+  auto index0_trt = index0.to(torch::kInt32);
+  auto index1_trt = index1.to(torch::kInt32);
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in1, index0, index1});
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in1, index0_trt, index1_trt});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape_as(jit_results[0])));
+}
+
+TEST(Converters, ATenIndexPutConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%x.1 : Tensor,
+            %index0 : Tensor,
+            %index1 : Tensor,
+            %values : Tensor):
+        %false : bool = prim::Constant[value=0]()
+        %18 : Tensor?[] = prim::ListConstruct(%index0, %index1)
+        %19 : Tensor = aten::index_put(%x.1, %18, %values, %false)
+        return (%19))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in1 = at::rand({5, 6, 3}, {at::kCUDA});
+  auto index0 = at::tensor({0, 4, -2}, {at::kCUDA}).to(torch::kLong);
+  auto index1 = at::tensor({1, 3, 5}, {at::kCUDA}).to(torch::kLong);
+  // Broadcast over the trailing dimension that is not indexed
+  auto values = at::rand({3, 1}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in1, index0, index1, values});
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(
+      g, params, {in1, index0.to(torch::kInt32), index1.to(torch::kInt32), values});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape_as(jit_results[0])));
+}
+
+TEST(Converters, ATenIndexPutAccumulateNonConsecutiveConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%x.1 : Tensor,
+            %index0 : Tensor,
+            %index1 : Tensor,
+            %values : Tensor):
+        %true : bool = prim::Constant[value=1]()
+        %5 : NoneType = prim::Constant()
+        %18 : Tensor?[] = prim::ListConstruct(%index0, %5, %index1)
+        %19 : Tensor = aten::index_put_(%x.1, %18, %values, %true)
+        return (%19))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  // Non consecutive indexed axes put the index dimension first, the values are [2, 4]
+  auto in1 = at::rand({3, 4, 5}, {at::kCUDA});
+  auto index0 = at::tensor({0, 2}, {at::kCUDA}).to(torch::kLong);
+  auto index1 = at::tensor({4, 1}, {at::kCUDA}).to(torch::kLong);
+  auto values = at::rand({2, 4}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in1.clone(), index0, index1, values});
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(
+      g, params, {in1, index0.to(torch::kInt32), index1.to(torch::kInt32), values});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape_as(jit_results[0])));
+}
@@ -145,3 +145,88 @@ TEST(Converters, ATenLayerNormConvertsCorrectly3dInput1dNormalizedShape) {
 
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
 }
+
+TEST(Converters, ATenLayerNormPinnedToFloatInHalfEngineConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %gamma: Float(197, 768),
+            %beta: Float(197, 768)):
+        %1: int = prim::Constant[value=768]()
+        %4 : int[] = prim::ListConstruct(%1)
+        %7 : bool = prim::Constant[value=0]()
+        %8 : float = prim::Constant[value=1.0000000000000001e-05]()
+        %9 : Tensor = aten::layer_norm(%0, %4, %gamma, %beta, %8, %7)
+        return (%9))IR";
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in = at::randn({1, 197, 768}, {at::kCUDA}) * 100;
+  auto gamma = at::randn({768}, {at::kCUDA});
+  auto beta = at::randn({768}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {gamma, beta});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  torch_tensorrt::core::conversion::BuilderSettings settings;
+  settings.enabled_precisions = {nvinfer1::DataType::kHALF};
+  settings.layer_precisions = {{"aten::layer_norm", nvinfer1::DataType::kFLOAT}};
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {gamma, beta});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngineWithSettings(g, params, {in}, settings);
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0], 1e-5, 1e-5));
+}
+
+TEST(Converters, ATenLayerNormPinnedToHalfWithoutHalfEnabledThrows) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %gamma : None = prim::Constant()
+        %beta : None = prim::Constant()
+        %1: int = prim::Constant[value=100]()
+        %4 : int[] = prim::ListConstruct(%1)
+        %7 : bool = prim::Constant[value=0]()
+        %8 : float = prim::Constant[value=1.0000000000000001e-05]()
+        %9 : Tensor = aten::layer_norm(%0, %4, %gamma, %beta, %8, %7)
+        return (%9))IR";
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in = at::randn({4, 100}, {at::kCUDA});
+
+  torch_tensorrt::core::conversion::BuilderSettings settings;
+  settings.layer_precisions = {{"aten::layer_norm", nvinfer1::DataType::kHALF}};
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  EXPECT_THROW(
+      torch_tensorrt::tests::util::RunGraphEngineWithSettings(g, params, {in}, settings), torch_tensorrt::Error);
+}
+
+TEST(Converters, ATenLayerNormInBFloat16EngineConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %gamma: Tensor,
+            %beta: Tensor):
+        %1: int = prim::Constant[value=768]()
+        %4 : int[] = prim::ListConstruct(%1)
+        %7 : bool = prim::Constant[value=0]()
+        %8 : float = prim::Constant[value=1.0000000000000001e-05]()
+        %9 : Tensor = aten::layer_norm(%0, %4, %gamma, %beta, %8, %7)
+        return (%9))IR";
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  // Large activations which would overflow FP16
+  auto in = (at::randn({1, 197, 768}, {at::kCUDA}) * 1e5).to(at::kBFloat16);
+  auto gamma = at::randn({768}, {at::kCUDA}).to(at::kBFloat16);
+  auto beta = at::randn({768}, {at::kCUDA}).to(at::kBFloat16);
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {gamma, beta});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  torch_tensorrt::core::conversion::BuilderSettings settings;
+  settings.enabled_precisions = {nvinfer1::DataType::kBF16};
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {gamma, beta});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngineWithSettings(g, params, {in}, settings);
+
+  ASSERT_EQ(trt_results[0].scalar_type(), at::kBFloat16);
+  ASSERT_TRUE(
+      torch_tensorrt::tests::util::cosineSimEqual(jit_results[0].to(at::kFloat), trt_results[0].to(at::kFloat)));
+}
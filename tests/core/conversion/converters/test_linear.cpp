@@ -62,3 +62,34 @@ TEST(Converters, ATenLinearBiasConvertsCorrectly) {
 
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape_as(jit_results[0])));
 }
+
+TEST(Converters, ATenLinearSharedWeightsConvertsCorrectly) {
+  // Both linear layers freeze the same weight tensor, which is interned into a single constant
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %1 : Tensor,
+            %2 : Float(3, 2, strides=[2, 1])):
+        %3 : None = prim::Constant()
+        %4 : Tensor = aten::linear(%0, %2, %3)
+        %5 : Tensor = aten::linear(%1, %2, %3)
+        %6 : int = prim::Constant[value=1]()
+        %7 : Tensor = aten::add(%4, %5, %6)
+        return (%4, %7))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in0 = at::randint(1, 10, {1, 2}, {at::kCUDA});
+  auto in1 = at::randint(1, 10, {1, 2}, {at::kCUDA});
+  auto w = at::randint(1, 10, {3, 2}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in0, in1});
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in0, in1});
+
+  for (size_t i = 0; i < jit_results.size(); i++) {
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[i], trt_results[i].reshape_as(jit_results[i])));
+  }
+}
@@ -76,6 +76,57 @@ ATEN_INTERPOLATE_TESTS(
               return (%5))IR",
     std::vector<int64_t>({3, 4, 3}));
 
+ATEN_INTERPOLATE_TESTS(
+    ATenNormOrder3RemoveDims,
+    R"IR(
+      graph(%x.1 : Tensor):
+              %2 : int[] = prim::Constant[value=[1, 2]]()
+              %3 : int = prim::Constant[value=3]()
+              %4 : bool = prim::Constant[value=0]()
+              %5 : Tensor = aten::norm(%x.1, %3, %2, %4)
+              return (%5))IR",
+    std::vector<int64_t>({3, 4, 3}));
+
+ATEN_INTERPOLATE_TESTS(
+    ATenNormOrder0KeepDims,
+    R"IR(
+      graph(%x.1 : Tensor):
+              %2 : int[] = prim::Constant[value=[1]]()
+              %3 : int = prim::Constant[value=0]()
+              %4 : bool = prim::Constant[value=1]()
+              %5 : Tensor = aten::norm(%x.1, %3, %2, %4)
+              return (%5))IR",
+    std::vector<int64_t>({3, 4, 3}));
+
+TEST(Converters, ATenNormL2NormalizeFP16ConvertsCorrectly) {
+  // F.normalize(x, dim=1) as scripted for an embedding output
+  const auto graph = R"IR(
+      graph(%x.1 : Tensor):
+              %2 : int[] = prim::Constant[value=[1]]()
+              %3 : int = prim::Constant[value=2]()
+              %4 : bool = prim::Constant[value=1]()
+              %eps : float = prim::Constant[value=9.9999999999999998e-13]()
+              %5 : Tensor = aten::norm(%x.1, %3, %2, %4)
+              %6 : Tensor = aten::clamp_min(%5, %eps)
+              %7 : Tensor = aten::expand_as(%6, %x.1)
+              %8 : Tensor = aten::div(%x.1, %7)
+              return (%8))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in = at::randn({8, 256}, {at::kCUDA}).to(at::kHalf);
+  auto jit_in = at::clone(in);
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {jit_in});
+
+  auto trt_in = at::clone(in);
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {trt_in}, nvinfer1::DataType::kHALF);
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0], 2e-3));
+}
+
 TEST(Converters, ATenFrobeniusNorm) {
   const auto graph = R"IR(
       graph(%x : Tensor):
@@ -95,3 +95,60 @@ TEST(Converters, ATenFakeQuantizePerChannelConvertsCorrectly) {
 
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape_as(jit_results[0])));
 }
+
+TEST(Converters, TRTFakeQuantizeFP8PerTensorConvertsCorrectly) {
+  cudaDeviceProp prop;
+  ASSERT_EQ(cudaGetDeviceProperties(&prop, 0), cudaSuccess);
+  if (prop.major * 10 + prop.minor < 89) {
+    GTEST_SKIP() << "FP8 requires compute capability 8.9 or newer";
+  }
+
+  const auto graph = R"IR(
+    graph(%x.1 : Tensor,
+          %scale : Float(1, strides=[1])):
+      %axis : int = prim::Constant[value=0]()
+      %out : Tensor = trt::fake_quantize_fp8(%x.1, %scale, %axis)
+      return (%out))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in = at::randn({1, 5, 5, 5}, {at::kCUDA}) * 4;
+  auto scale = at::tensor({0.05f}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {scale});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {scale});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in}, nvinfer1::DataType::kFP8);
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape_as(jit_results[0])));
+}
+
+TEST(Converters, TRTDequantizeINT4BlockWeightsConvertsCorrectly) {
+  const auto graph = R"IR(
+    graph(%x.1 : Tensor,
+          %w : Char(64, 16, strides=[16, 1]),
+          %scale : Float(64, 2, strides=[2, 1])):
+      %block_size : int = prim::Constant[value=8]()
+      %none : None = prim::Constant()
+      %wd : Tensor = trt::dequantize_int4(%w, %scale, %block_size)
+      %out : Tensor = aten::linear(%x.1, %wd, %none)
+      return (%out))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto w = at::randint(-8, 8, {64, 16}, {at::kCUDA}).to(at::kChar);
+  auto scale = at::rand({64, 2}, {at::kCUDA}) * 0.1;
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w, scale});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w, scale});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in}, nvinfer1::DataType::kINT4);
+
+  ASSERT_TRUE(
+      torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape_as(jit_results[0]), 2e-4));
+}
@@ -392,3 +392,56 @@ TEST(Converters, ATenAllDimDynamicConvertsCorrectly) {
   auto in = at::randint(0, 2, {64, 2}, at::kCUDA).to(torch::kHalf);
   test_body(graph, in, true);
 }
+
+TEST(Converters, ATenVarDimConvertsCorrectly) {
+  const auto graph = R"IR(
+    graph(%0 : Tensor):
+      %1 : int = prim::Constant[value=1]()
+      %2 : int[] = prim::ListConstruct(%1)
+      %3 : bool = prim::Constant[value=1]()
+      %4 : bool = prim::Constant[value=0]()
+      %5 : Tensor = aten::var(%0, %2, %3, %4)
+      return (%5))IR";
+  auto in = at::randn({4, 16, 8}, at::kCUDA);
+  test_body(graph, in);
+}
+
+TEST(Converters, ATenVarBiasedKeepDimConvertsCorrectly) {
+  const auto graph = R"IR(
+    graph(%0 : Tensor):
+      %1 : int = prim::Constant[value=0]()
+      %2 : int = prim::Constant[value=-1]()
+      %3 : int[] = prim::ListConstruct(%1, %2)
+      %4 : bool = prim::Constant[value=0]()
+      %5 : bool = prim::Constant[value=1]()
+      %6 : Tensor = aten::var(%0, %3, %4, %5)
+      return (%6))IR";
+  auto in = at::randn({4, 16, 8}, at::kCUDA);
+  test_body(graph, in);
+}
+
+TEST(Converters, ATenStdDimConvertsCorrectly) {
+  const auto graph = R"IR(
+    graph(%0 : Tensor):
+      %1 : int = prim::Constant[value=2]()
+      %2 : int[] = prim::ListConstruct(%1)
+      %3 : bool = prim::Constant[value=1]()
+      %4 : bool = prim::Constant[value=0]()
+      %5 : Tensor = aten::std(%0, %2, %3, %4)
+      return (%5))IR";
+  auto in = at::randn({4, 16, 8}, at::kCUDA);
+  test_body(graph, in);
+}
+
+TEST(Converters, ATenVarDimDynamicConvertsCorrectly) {
+  const auto graph = R"IR(
+    graph(%0 : Tensor):
+      %1 : int = prim::Constant[value=1]()
+      %2 : int[] = prim::ListConstruct(%1)
+      %3 : bool = prim::Constant[value=1]()
+      %4 : bool = prim::Constant[value=1]()
+      %5 : Tensor = aten::var(%0, %2, %3, %4)
+      return (%5))IR";
+  auto in = at::randn({4, 16, 8}, at::kCUDA);
+  test_body(graph, in, true);
+}
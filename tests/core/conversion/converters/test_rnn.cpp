@@ -0,0 +1,116 @@
+#include <string>
+#include "core/compiler.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+TEST(Converters, ATenLSTMConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %1 : Tensor,
+            %2 : Tensor,
+            %3 : Float(80, 10, strides=[10, 1]),
+            %4 : Float(80, 20, strides=[20, 1]),
+            %5 : Float(80),
+            %6 : Float(80)):
+        %hx : Tensor[] = prim::ListConstruct(%1, %2)
+        %params : Tensor[] = prim::ListConstruct(%3, %4, %5, %6)
+        %true : bool = prim::Constant[value=1]()
+        %false : bool = prim::Constant[value=0]()
+        %layers : int = prim::Constant[value=1]()
+        %dropout : float = prim::Constant[value=0.]()
+        %out : Tensor, %h : Tensor, %c : Tensor = aten::lstm(%0, %hx, %params, %true, %layers, %dropout, %false, %false, %false)
+        return (%out, %h, %c))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto input = at::randn({5, 3, 10}, {at::kCUDA});
+  auto h0 = at::randn({1, 3, 20}, {at::kCUDA});
+  auto c0 = at::randn({1, 3, 20}, {at::kCUDA});
+  auto w_ih = at::randn({4 * 20, 10}, {at::kCUDA});
+  auto w_hh = at::randn({4 * 20, 20}, {at::kCUDA});
+  auto b_ih = at::randn({4 * 20}, {at::kCUDA});
+  auto b_hh = at::randn({4 * 20}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w_ih, w_hh, b_ih, b_hh});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {input, h0, c0});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {input, h0, c0});
+
+  for (size_t i = 0; i < jit_results.size(); i++) {
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[i], trt_results[i], 2e-5));
+  }
+}
+
+TEST(Converters, ATenGRUBidirectionalBatchFirstConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %1 : Tensor,
+            %2 : Float(48, 10, strides=[10, 1]),
+            %3 : Float(48, 16, strides=[16, 1]),
+            %4 : Float(48, 10, strides=[10, 1]),
+            %5 : Float(48, 16, strides=[16, 1])):
+        %params : Tensor[] = prim::ListConstruct(%2, %3, %4, %5)
+        %true : bool = prim::Constant[value=1]()
+        %false : bool = prim::Constant[value=0]()
+        %layers : int = prim::Constant[value=1]()
+        %dropout : float = prim::Constant[value=0.]()
+        %out : Tensor, %h : Tensor = aten::gru(%0, %1, %params, %false, %layers, %dropout, %false, %true, %true)
+        return (%out, %h))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto input = at::randn({3, 7, 10}, {at::kCUDA});
+  auto h0 = at::randn({2, 3, 16}, {at::kCUDA});
+  auto w_ih = at::randn({3 * 16, 10}, {at::kCUDA});
+  auto w_hh = at::randn({3 * 16, 16}, {at::kCUDA});
+  auto w_ih_reverse = at::randn({3 * 16, 10}, {at::kCUDA});
+  auto w_hh_reverse = at::randn({3 * 16, 16}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w_ih, w_hh, w_ih_reverse, w_hh_reverse});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {input, h0});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {input, h0});
+
+  for (size_t i = 0; i < jit_results.size(); i++) {
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[i], trt_results[i], 2e-5));
+  }
+}
+
+TEST(Converters, ATenMultiLayerLSTMConvertsCorrectlyWithDynamicSequenceLength) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %1 : Tensor,
+            %2 : Tensor,
+            %3 : Float(64, 8, strides=[8, 1]),
+            %4 : Float(64, 16, strides=[16, 1]),
+            %5 : Float(64, 16, strides=[16, 1]),
+            %6 : Float(64, 16, strides=[16, 1])):
+        %hx : Tensor[] = prim::ListConstruct(%1, %2)
+        %params : Tensor[] = prim::ListConstruct(%3, %4, %5, %6)
+        %false : bool = prim::Constant[value=0]()
+        %layers : int = prim::Constant[value=2]()
+        %dropout : float = prim::Constant[value=0.]()
+        %out : Tensor, %h : Tensor, %c : Tensor = aten::lstm(%0, %hx, %params, %false, %layers, %dropout, %false, %false, %false)
+        return (%out, %h, %c))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto input = at::randn({6, 4, 8}, {at::kCUDA});
+  auto h0 = at::randn({2, 4, 16}, {at::kCUDA});
+  auto c0 = at::randn({2, 4, 16}, {at::kCUDA});
+  auto w_ih0 = at::randn({4 * 16, 8}, {at::kCUDA});
+  auto w_hh0 = at::randn({4 * 16, 16}, {at::kCUDA});
+  auto w_ih1 = at::randn({4 * 16, 16}, {at::kCUDA});
+  auto w_hh1 = at::randn({4 * 16, 16}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w_ih0, w_hh0, w_ih1, w_hh1});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {input, h0, c0});
+  // The sequence length (dimension 0) of the input is dynamic
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngineDynamic(g, params, {input, h0, c0}, true);
+
+  for (size_t i = 0; i < jit_results.size(); i++) {
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[i], trt_results[i], 2e-5));
+  }
+}
@@ -245,3 +245,115 @@ TEST(Converters, ATenEmbeddingConvertsCorrectly) {
 
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt));
 }
+
+TEST(Converters, ATenEmbeddingBagSumWithFrozenOffsetsConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%1 : Tensor, %emb_weight : Float(10, 3, strides=[3, 1]), %offsets : Long(3, strides=[1])):
+            %false : bool = prim::Constant[value=0]()
+            %mode : int = prim::Constant[value=0]()
+            %none : NoneType = prim::Constant()
+            %5 : Tensor, %6 : Tensor, %7 : Tensor, %8 : Tensor = aten::embedding_bag(%emb_weight, %1, %offsets, %false, %mode, %false, %none, %false)
+            return (%5))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto options_pyt = torch::TensorOptions().device(torch::kCUDA, 0).dtype(torch::kLong);
+  auto jit_in = at::tensor({4, 1, 2, 9, 0, 3, 3}, options_pyt);
+  auto emb_weight = at::randn({10, 3}, {at::kCUDA});
+  auto offsets = at::tensor({0, 2, 2}, options_pyt);
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {emb_weight, offsets});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {jit_in});
+
+  auto trt_in = at::tensor({4, 1, 2, 9, 0, 3, 3}, {at::kCUDA}).to(torch::kInt32);
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {trt_in});
+
+  ASSERT_TRUE(
+      torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape(jit_results[0].sizes())));
+}
+
+TEST(Converters, ATenEmbeddingBagMeanWithLastOffsetConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%1 : Tensor, %offsets : Tensor, %emb_weight : Float(10, 4, strides=[4, 1])):
+            %false : bool = prim::Constant[value=0]()
+            %true : bool = prim::Constant[value=1]()
+            %mode : int = prim::Constant[value=1]()
+            %none : NoneType = prim::Constant()
+            %5 : Tensor, %6 : Tensor, %7 : Tensor, %8 : Tensor = aten::embedding_bag(%emb_weight, %1, %offsets, %false, %mode, %false, %none, %true)
+            return (%5))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto options_pyt = torch::TensorOptions().device(torch::kCUDA, 0).dtype(torch::kLong);
+  auto jit_in = at::tensor({4, 1, 2, 9, 0, 3}, options_pyt);
+  auto jit_offsets = at::tensor({0, 3, 3, 6}, options_pyt);
+  auto emb_weight = at::randn({10, 4}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {emb_weight});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {jit_in, jit_offsets});
+
+  auto trt_in = jit_in.to(torch::kInt32);
+  auto trt_offsets = jit_offsets.to(torch::kInt32);
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {trt_in, trt_offsets});
+
+  ASSERT_TRUE(
+      torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape(jit_results[0].sizes())));
+}
+
+TEST(Converters, ATenEmbeddingBagPerSampleWeightsConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%1 : Tensor, %offsets : Tensor, %weights : Tensor, %emb_weight : Float(10, 3, strides=[3, 1])):
+            %false : bool = prim::Constant[value=0]()
+            %mode : int = prim::Constant[value=0]()
+            %5 : Tensor, %6 : Tensor, %7 : Tensor, %8 : Tensor = aten::embedding_bag(%emb_weight, %1, %offsets, %false, %mode, %false, %weights, %false)
+            return (%5))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto options_pyt = torch::TensorOptions().device(torch::kCUDA, 0).dtype(torch::kLong);
+  auto jit_in = at::tensor({4, 1, 2, 9, 0}, options_pyt);
+  auto jit_offsets = at::tensor({0, 1, 4}, options_pyt);
+  auto per_sample_weights = at::rand({5}, {at::kCUDA});
+  auto emb_weight = at::randn({10, 3}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {emb_weight});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {jit_in, jit_offsets, per_sample_weights});
+
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(
+      g, params, {jit_in.to(torch::kInt32), jit_offsets.to(torch::kInt32), per_sample_weights});
+
+  ASSERT_TRUE(
+      torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape(jit_results[0].sizes())));
+}
+
+TEST(Converters, ATenEmbeddingBagMaxWithPaddingIdxConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%1 : Tensor, %offsets : Tensor, %emb_weight : Float(10, 3, strides=[3, 1])):
+            %false : bool = prim::Constant[value=0]()
+            %mode : int = prim::Constant[value=2]()
+            %pad : int = prim::Constant[value=0]()
+            %none : NoneType = prim::Constant()
+            %5 : Tensor, %6 : Tensor, %7 : Tensor, %8 : Tensor = aten::embedding_bag(%emb_weight, %1, %offsets, %false, %mode, %false, %none, %false, %pad)
+            return (%5))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  // The second bag only holds the padding index and comes out as zeros
+  auto options_pyt = torch::TensorOptions().device(torch::kCUDA, 0).dtype(torch::kLong);
+  auto jit_in = at::tensor({4, 1, 0, 9, 0, 3}, options_pyt);
+  auto jit_offsets = at::tensor({0, 2, 3}, options_pyt);
+  auto emb_weight = at::randn({10, 3}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {emb_weight});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {jit_in, jit_offsets});
+
+  auto trt_results =
+      torch_tensorrt::tests::util::RunGraphEngine(g, params, {jit_in.to(torch::kInt32), jit_offsets.to(torch::kInt32)});
+
+  ASSERT_TRUE(
+      torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape(jit_results[0].sizes())));
+}
@@ -0,0 +1,82 @@
+#include <string>
+#include "core/compiler.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+// Packed tokens of sequences of lengths 5, 17, 1 and 9
+std::vector<at::Tensor> packed_inputs() {
+  auto cu_seqlens = at::tensor({0, 5, 22, 23, 32}, {at::kCUDA}).to(at::kInt);
+  auto query = at::rand({32, 4, 16}, {at::kCUDA});
+  auto key = at::rand({32, 4, 16}, {at::kCUDA});
+  auto value = at::rand({32, 4, 16}, {at::kCUDA});
+  return {query, key, value, cu_seqlens};
+}
+} // namespace
+
+TEST(Converters, TRTVarlenAttentionConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor, %cu_seqlens : Tensor):
+        %max_seqlen : int = prim::Constant[value=24]()
+        %scale : NoneType = prim::Constant()
+        %out : Tensor = trt::varlen_attention(%query, %key, %value, %cu_seqlens, %max_seqlen, %scale)
+        return (%out))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto inputs = packed_inputs();
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, inputs);
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, inputs);
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+}
+
+TEST(Converters, TRTVarlenAttentionMatchesPaddedAttention) {
+  const auto graph = R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor, %cu_seqlens : Tensor):
+        %max_seqlen : int = prim::Constant[value=17]()
+        %scale : float = prim::Constant[value=0.5]()
+        %out : Tensor = trt::varlen_attention(%query, %key, %value, %cu_seqlens, %max_seqlen, %scale)
+        return (%out))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto inputs = packed_inputs();
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, inputs);
+
+  // Each sequence attended on its own, as if padded with its keys masked out
+  auto cu_seqlens = inputs[3].cpu();
+  for (int64_t b = 0; b + 1 < cu_seqlens.size(0); b++) {
+    auto start = cu_seqlens[b].item<int64_t>();
+    auto len = cu_seqlens[b + 1].item<int64_t>() - start;
+    auto seq = [&](const at::Tensor& t) { return t.narrow(0, start, len).transpose(0, 1); };
+    auto expected =
+        at::scaled_dot_product_attention(seq(inputs[0]), seq(inputs[1]), seq(inputs[2]), {}, 0.0, false, 0.5);
+    ASSERT_TRUE(
+        torch_tensorrt::tests::util::almostEqual(expected.transpose(0, 1), trt_results[0].narrow(0, start, len)));
+  }
+}
+
+TEST(Converters, TRTVarlenAttentionConvertsCorrectlyWithDynamicTokens) {
+  const auto graph = R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor, %cu_seqlens : Tensor):
+        %max_seqlen : int = prim::Constant[value=32]()
+        %scale : NoneType = prim::Constant()
+        %out : Tensor = trt::varlen_attention(%query, %key, %value, %cu_seqlens, %max_seqlen, %scale)
+        return (%out))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto inputs = packed_inputs();
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, inputs);
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngineDynamic(g, params, inputs, true);
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+}
@@ -1150,3 +1150,31 @@ TEST(Evaluators, IsAtenListEvaluateCorrectly) {
 
   ASSERT_TRUE(jit_results[0] == trt_results[0]);
 }
+
+TEST(Evaluators, DeepDependencyChainsAreEvaluatedOnce) {
+  // x_i = (x_{i-1} + x_{i-1}) // 2, every step uses the previous one twice so a naive recursive evaluation takes
+  // 2^depth steps. The chain also runs well past the old recursion limit
+  const int64_t depth = 64;
+  auto g = std::make_shared<torch::jit::Graph>();
+  auto two = g->insertConstant(2);
+  auto v = g->insertConstant(1);
+  std::vector<torch::jit::Value*> chain;
+  for (int64_t i = 0; i < depth; i++) {
+    auto sum = g->insert(torch::jit::aten::add, {v, v});
+    v = g->insert(torch::jit::aten::floordiv, {sum, two});
+    chain.push_back(sum);
+    chain.push_back(v);
+  }
+  g->registerOutput(v);
+
+  torch_tensorrt::core::conversion::ConversionCtx ctx({});
+  auto eval = torch_tensorrt::core::conversion::EvaluateNode(&ctx, v->node());
+  ASSERT_TRUE(eval);
+  ASSERT_EQ(eval.value().toInt(), 1);
+
+  // Every dependency is memoized in the context
+  for (size_t i = 0; i + 1 < chain.size(); i++) {
+    ASSERT_NE(ctx.evaluated_value_map.find(chain[i]), ctx.evaluated_value_map.end());
+    ASSERT_EQ(ctx.evaluated_value_map[chain[i]].toInt(), i % 2 == 0 ? 2 : 1);
+  }
+}
@@ -0,0 +1,121 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/passes/passes.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/csrc/jit/ir/subgraph_matcher.h"
+
+TEST(LoweringPasses, CoalesceShufflesComposesPermutesCorrectly) {
+  std::string source_graph = R"IR(
+    graph(%x : Tensor):
+        %1 : int[] = prim::Constant[value=[0, 2, 3, 1]]()
+        %2 : int = prim::Constant[value=1]()
+        %3 : int = prim::Constant[value=-1]()
+        %4 : Tensor = aten::permute(%x, %1)
+        %5 : Tensor = aten::transpose(%4, %2, %3)
+        return (%5))IR";
+  std::string target_graph = R"IR(
+    graph(%x : Tensor):
+        %1 : int[] = prim::Constant[value=[0, 1, 3, 2]]()
+        %2 : Tensor = aten::permute(%x, %1)
+        return (%2))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, &*sg);
+  auto in = at::randint(5, {2, 3, 4, 5}, {at::kCUDA});
+  auto jit_pre_results = torch_tensorrt::tests::util::EvaluateGraphJIT(sg, {in});
+  torch_tensorrt::core::lowering::passes::CoalesceShuffles(sg);
+  auto jit_post_results = torch_tensorrt::tests::util::EvaluateGraphJIT(sg, {in});
+
+  auto tg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(target_graph, &*tg);
+
+  ASSERT_TRUE(!torch::jit::findPatternMatches(*tg, *sg).empty());
+  ASSERT_TRUE(torch_tensorrt::tests::util::exactlyEqual(jit_pre_results[0].toTensor(), jit_post_results[0].toTensor()));
+}
+
+TEST(LoweringPasses, CoalesceShufflesRemovesInversePermutesCorrectly) {
+  std::string source_graph = R"IR(
+    graph(%x : Tensor):
+        %1 : int[] = prim::Constant[value=[0, 2, 3, 1]]()
+        %2 : int[] = prim::Constant[value=[0, 3, 1, 2]]()
+        %3 : int = prim::Constant[value=2]()
+        %4 : Tensor = aten::permute(%x, %1)
+        %5 : Tensor = aten::permute(%4, %2)
+        %6 : Tensor = aten::transpose(%5, %3, %3)
+        %7 : Tensor = aten::relu(%6)
+        return (%7))IR";
+  std::string target_graph = R"IR(
+    graph(%x : Tensor):
+        %1 : Tensor = aten::relu(%x)
+        return (%1))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, &*sg);
+  torch_tensorrt::core::lowering::passes::CoalesceShuffles(sg);
+
+  auto tg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(target_graph, &*tg);
+
+  ASSERT_TRUE(!torch::jit::findPatternMatches(*tg, *sg).empty());
+  ASSERT_EQ(sg->nodes().begin()->kind(), torch::jit::aten::relu);
+}
+
+TEST(LoweringPasses, CoalesceShufflesFoldsReshapeChainCorrectly) {
+  std::string source_graph = R"IR(
+    graph(%x : Tensor):
+        %1 : int = prim::Constant[value=1]()
+        %2 : int = prim::Constant[value=-1]()
+        %3 : int[] = prim::Constant[value=[6, 20]]()
+        %4 : int[] = prim::Constant[value=[4, 30]]()
+        %5 : Tensor = aten::flatten(%x, %1, %2)
+        %6 : Tensor = aten::unsqueeze(%5, %1)
+        %7 : Tensor = aten::reshape(%6, %3)
+        %8 : Tensor = aten::reshape(%7, %4)
+        return (%8))IR";
+  std::string target_graph = R"IR(
+    graph(%x : Tensor):
+        %1 : int[] = prim::Constant[value=[4, 30]]()
+        %2 : Tensor = aten::reshape(%x, %1)
+        return (%2))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, &*sg);
+  auto in = at::randint(5, {2, 3, 4, 5}, {at::kCUDA});
+  auto jit_pre_results = torch_tensorrt::tests::util::EvaluateGraphJIT(sg, {in});
+  torch_tensorrt::core::lowering::passes::CoalesceShuffles(sg);
+  auto jit_post_results = torch_tensorrt::tests::util::EvaluateGraphJIT(sg, {in});
+
+  auto tg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(target_graph, &*tg);
+
+  ASSERT_TRUE(!torch::jit::findPatternMatches(*tg, *sg).empty());
+  ASSERT_TRUE(torch_tensorrt::tests::util::exactlyEqual(jit_pre_results[0].toTensor(), jit_post_results[0].toTensor()));
+}
+
+TEST(LoweringPasses, CoalesceShufflesKeepsPermuteBeforeReshape) {
+  std::string source_graph = R"IR(
+    graph(%x : Tensor):
+        %1 : int[] = prim::Constant[value=[0, 2, 1]]()
+        %2 : int[] = prim::Constant[value=[2, -1]]()
+        %3 : Tensor = aten::permute(%x, %1)
+        %4 : Tensor = aten::reshape(%3, %2)
+        return (%4))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, &*sg);
+  auto tg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, &*tg);
+  torch_tensorrt::core::lowering::passes::CoalesceShuffles(sg);
+
+  ASSERT_TRUE(!torch::jit::findPatternMatches(*tg, *sg).empty());
+}
@@ -0,0 +1,78 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/passes/passes.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/csrc/jit/ir/subgraph_matcher.h"
+
+namespace {
+// Swaps the graph inputs standing for mean and std for constant tensors, the way freezing leaves them
+void freeze_mean_and_std(std::shared_ptr<torch::jit::Graph>& g, at::Tensor mean, at::Tensor std) {
+  torch::jit::WithInsertPoint guard(*g->block()->nodes().begin());
+  g->inputs()[1]->replaceAllUsesWith(g->insertConstant(mean));
+  g->inputs()[2]->replaceAllUsesWith(g->insertConstant(std));
+  g->eraseInput(2);
+  g->eraseInput(1);
+}
+} // namespace
+
+TEST(LoweringPasses, FoldInputNormalizationCorrectly) {
+  std::string source_graph = R"IR(
+    graph(%x : Tensor, %mean : Tensor, %std : Tensor):
+        %scale : float = prim::Constant[value=255.]()
+        %alpha : int = prim::Constant[value=1]()
+        %1 : Tensor = aten::div(%x, %scale)
+        %2 : Tensor = aten::sub(%1, %mean, %alpha)
+        %3 : Tensor = aten::div(%2, %std)
+        return (%3))IR";
+  std::string target_graph = R"IR(
+    graph(%x : Tensor, %mean : Tensor, %std : Tensor, %scale : float, %alpha : int):
+        %1 : Tensor = aten::mul(%mean, %scale)
+        %2 : Tensor = aten::mul(%std, %scale)
+        %3 : Tensor = aten::sub(%x, %1, %alpha)
+        %4 : Tensor = aten::div(%3, %2)
+        return (%4))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, sg.get());
+  auto mean = at::tensor({0.485, 0.456, 0.406}, {at::kFloat}).view({1, 3, 1, 1}).to(at::kCUDA);
+  auto std = at::tensor({0.229, 0.224, 0.225}, {at::kFloat}).view({1, 3, 1, 1}).to(at::kCUDA);
+  freeze_mean_and_std(sg, mean, std);
+
+  auto in = at::randint(0, 256, {1, 3, 4, 4}, {at::kCUDA}).to(at::kFloat);
+  auto sg_params = torch_tensorrt::core::ir::get_static_params(sg->inputs(), {});
+  auto sg_results = torch_tensorrt::tests::util::RunGraph(sg, sg_params, {in});
+  torch_tensorrt::core::lowering::passes::FoldInputNormalization(sg);
+  auto folded_results = torch_tensorrt::tests::util::RunGraph(sg, sg_params, {at::clone(in)});
+
+  auto tg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(target_graph, tg.get());
+
+  ASSERT_TRUE(!torch::jit::findPatternMatches(*tg, *sg).empty());
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(sg_results[0], folded_results[0]));
+}
+
+TEST(LoweringPasses, FoldInputNormalizationSkipsRuntimeStatistics) {
+  std::string source_graph = R"IR(
+    graph(%x : Tensor, %mean : Tensor, %std : Tensor):
+        %scale : float = prim::Constant[value=255.]()
+        %alpha : int = prim::Constant[value=1]()
+        %1 : Tensor = aten::div(%x, %scale)
+        %2 : Tensor = aten::sub(%1, %mean, %alpha)
+        %3 : Tensor = aten::div(%2, %std)
+        return (%3))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, sg.get());
+  torch_tensorrt::core::lowering::passes::FoldInputNormalization(sg);
+
+  auto tg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, tg.get());
+
+  ASSERT_TRUE(!torch::jit::findPatternMatches(*tg, *sg).empty());
+}
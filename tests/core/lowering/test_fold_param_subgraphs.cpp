@@ -0,0 +1,84 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/passes/passes.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/csrc/jit/ir/subgraph_matcher.h"
+
+namespace {
+// Swaps the graph input standing for a weight for a constant, the way freezing leaves it
+void freeze_weight(std::shared_ptr<torch::jit::Graph>& g, at::Tensor weight) {
+  torch::jit::WithInsertPoint guard(*g->block()->nodes().begin());
+  g->inputs()[1]->replaceAllUsesWith(g->insertConstant(weight));
+  g->eraseInput(1);
+}
+
+size_t count_nodes(const std::shared_ptr<torch::jit::Graph>& g, c10::Symbol kind) {
+  size_t count = 0;
+  for (auto n : g->nodes()) {
+    count += n->kind() == kind;
+  }
+  return count;
+}
+} // namespace
+
+TEST(LoweringPasses, FoldParamSubgraphsFoldsWeightOpsCorrectly) {
+  std::string source_graph = R"IR(
+    graph(%x : Tensor, %w : Tensor):
+        %scale : float = prim::Constant[value=0.5]()
+        %1 : Tensor = aten::t(%w)
+        %2 : Tensor = aten::mul(%1, %scale)
+        %3 : Tensor = aten::matmul(%x, %2)
+        return (%3))IR";
+  std::string target_graph = R"IR(
+    graph(%x : Tensor, %w : Tensor):
+        %3 : Tensor = aten::matmul(%x, %w)
+        return (%3))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, sg.get());
+  freeze_weight(sg, at::randn({32, 16}, {at::kCUDA}));
+
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto sg_params = torch_tensorrt::core::ir::get_static_params(sg->inputs(), {});
+  auto sg_results = torch_tensorrt::tests::util::RunGraph(sg, sg_params, {in});
+
+  torch_tensorrt::core::lowering::passes::FoldParamSubgraphs(sg);
+
+  auto tg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(target_graph, tg.get());
+  ASSERT_TRUE(!torch::jit::findPatternMatches(*tg, *sg).empty());
+  ASSERT_EQ(count_nodes(sg, torch::jit::aten::t), 0);
+  ASSERT_EQ(count_nodes(sg, torch::jit::aten::mul), 0);
+
+  auto folded_results = torch_tensorrt::tests::util::RunGraph(sg, sg_params, {at::clone(in)});
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(sg_results[0], folded_results[0], 1e-6, 1e-6));
+}
+
+TEST(LoweringPasses, FoldParamSubgraphsKeepsQuantizationAndBroadcasts) {
+  std::string source_graph = R"IR(
+    graph(%x : Tensor, %w : Tensor):
+        %scale : float = prim::Constant[value=0.02]()
+        %zero : int = prim::Constant[value=0]()
+        %qmin : int = prim::Constant[value=-128]()
+        %qmax : int = prim::Constant[value=127]()
+        %reps : int[] = prim::Constant[value=[4, 1]]()
+        %1 : Tensor = aten::fake_quantize_per_tensor_affine(%w, %scale, %zero, %qmin, %qmax)
+        %2 : Tensor = aten::matmul(%x, %1)
+        %3 : Tensor = aten::repeat(%w, %reps)
+        return (%2, %3))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, sg.get());
+  freeze_weight(sg, at::randn({16, 8}, {at::kCUDA}));
+  torch_tensorrt::core::lowering::passes::FoldParamSubgraphs(sg);
+
+  ASSERT_EQ(count_nodes(sg, torch::jit::aten::fake_quantize_per_tensor_affine), 1);
+  ASSERT_EQ(count_nodes(sg, torch::jit::aten::repeat), 1);
+}
@@ -0,0 +1,68 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/lowering.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+
+size_t count_nodes(const std::shared_ptr<torch::jit::Graph>& g, c10::Symbol kind) {
+  size_t count = 0;
+  for (auto n : g->nodes()) {
+    count += n->kind() == kind;
+  }
+  return count;
+}
+
+} // namespace
+
+TEST(LoweringPasses, FoldStaticShapesFoldsDimsInvariantAcrossProfile) {
+  std::string source_graph = R"IR(
+    graph(%x : Tensor):
+      %zero : int = prim::Constant[value=0]()
+      %one : int = prim::Constant[value=1]()
+      %two : int = prim::Constant[value=2]()
+      %y : Tensor = aten::relu(%x)
+      %batch : int = aten::size(%y, %zero)
+      %channels : int = aten::size(%y, %one)
+      %width : int = aten::size(%y, %two)
+      %flat : int = aten::mul(%channels, %width)
+      %shape : int[] = prim::ListConstruct(%batch, %flat)
+      %out : Tensor = aten::reshape(%y, %shape)
+      return (%out))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, g.get());
+
+  torch_tensorrt::core::ir::CollectionInputSpecMap specs;
+  specs[g->inputs()[0]] = {torch_tensorrt::core::ir::Input({1, 3, 16}, {4, 3, 16}, {8, 3, 16})};
+  auto num_folded = torch_tensorrt::core::lowering::FoldStaticShapes(g, specs);
+
+  // Only the batch dim varies, channels * width becomes the constant 48
+  ASSERT_EQ(num_folded, 2);
+  ASSERT_EQ(count_nodes(g, torch::jit::aten::size), 1);
+  ASSERT_EQ(count_nodes(g, torch::jit::aten::mul), 0);
+  ASSERT_TRUE(g->inputs()[0]->type()->castRaw<c10::TensorType>()->symbolic_sizes().rank() == c10::nullopt);
+}
+
+TEST(LoweringPasses, FoldStaticShapesMergesQueriesOfTheSameDynamicDim) {
+  std::string source_graph = R"IR(
+    graph(%x : Tensor):
+      %zero : int = prim::Constant[value=0]()
+      %a : int = aten::size(%x, %zero)
+      %y : Tensor = aten::sigmoid(%x)
+      %b : int = aten::size(%y, %zero)
+      %sum : int = aten::add(%a, %b)
+      return (%sum))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, g.get());
+
+  torch_tensorrt::core::ir::CollectionInputSpecMap specs;
+  specs[g->inputs()[0]] = {torch_tensorrt::core::ir::Input({1, 3}, {4, 3}, {8, 3})};
+  auto num_folded = torch_tensorrt::core::lowering::FoldStaticShapes(g, specs);
+
+  ASSERT_EQ(num_folded, 1);
+  ASSERT_EQ(count_nodes(g, torch::jit::aten::size), 1);
+}
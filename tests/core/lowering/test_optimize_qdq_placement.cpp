@@ -0,0 +1,108 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/passes/passes.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/csrc/jit/ir/subgraph_matcher.h"
+
+namespace {
+size_t count_fake_quantize(const std::shared_ptr<torch::jit::Graph>& g) {
+  size_t count = 0;
+  for (auto n : g->nodes()) {
+    count += n->kind() == torch::jit::aten::fake_quantize_per_tensor_affine;
+  }
+  return count;
+}
+} // namespace
+
+TEST(LoweringPasses, OptimizeQDQPlacementHoistsAcrossPoolingCorrectly) {
+  std::string source_graph = R"IR(
+    graph(%x : Tensor):
+        %scale : float = prim::Constant[value=0.02]()
+        %zero : int = prim::Constant[value=0]()
+        %qmin : int = prim::Constant[value=-128]()
+        %qmax : int = prim::Constant[value=127]()
+        %k : int[] = prim::Constant[value=[2, 2]]()
+        %p : int[] = prim::Constant[value=[0, 0]]()
+        %d : int[] = prim::Constant[value=[1, 1]]()
+        %false : bool = prim::Constant[value=0]()
+        %1 : Tensor = aten::relu(%x)
+        %2 : Tensor = aten::max_pool2d(%1, %k, %k, %p, %d, %false)
+        %3 : Tensor = aten::fake_quantize_per_tensor_affine(%2, %scale, %zero, %qmin, %qmax)
+        return (%3))IR";
+  std::string target_graph = R"IR(
+    graph(%x : Tensor, %scale : float, %zero : int, %qmin : int, %qmax : int, %k : int[], %p : int[], %d : int[], %false : bool):
+        %1 : Tensor = aten::relu(%x)
+        %2 : Tensor = aten::fake_quantize_per_tensor_affine(%1, %scale, %zero, %qmin, %qmax)
+        %3 : Tensor = aten::max_pool2d(%2, %k, %k, %p, %d, %false)
+        return (%3))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, sg.get());
+
+  auto in = at::randn({1, 4, 8, 8}, {at::kCUDA});
+  auto sg_params = torch_tensorrt::core::ir::get_static_params(sg->inputs(), {});
+  auto sg_results = torch_tensorrt::tests::util::RunGraph(sg, sg_params, {in});
+
+  torch_tensorrt::core::lowering::passes::OptimizeQDQPlacement(sg);
+
+  auto tg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(target_graph, tg.get());
+  ASSERT_TRUE(!torch::jit::findPatternMatches(*tg, *sg).empty());
+
+  auto hoisted_results = torch_tensorrt::tests::util::RunGraph(sg, sg_params, {at::clone(in)});
+  ASSERT_TRUE(torch_tensorrt::tests::util::exactlyEqual(sg_results[0], hoisted_results[0]));
+}
+
+TEST(LoweringPasses, OptimizeQDQPlacementRemovesRepeatedPairCorrectly) {
+  std::string source_graph = R"IR(
+    graph(%x : Tensor):
+        %scale : float = prim::Constant[value=0.02]()
+        %zero : int = prim::Constant[value=0]()
+        %qmin : int = prim::Constant[value=-128]()
+        %qmax : int = prim::Constant[value=127]()
+        %1 : Tensor = aten::fake_quantize_per_tensor_affine(%x, %scale, %zero, %qmin, %qmax)
+        %2 : Tensor = aten::fake_quantize_per_tensor_affine(%1, %scale, %zero, %qmin, %qmax)
+        %3 : Tensor = aten::relu(%2)
+        return (%3))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, sg.get());
+  torch_tensorrt::core::lowering::passes::OptimizeQDQPlacement(sg);
+
+  ASSERT_EQ(count_fake_quantize(sg), 1);
+}
+
+TEST(LoweringPasses, OptimizeQDQPlacementUnifiesConcatScalesCorrectly) {
+  std::string source_graph = R"IR(
+    graph(%x : Tensor, %y : Tensor):
+        %small : float = prim::Constant[value=0.01]()
+        %large : float = prim::Constant[value=0.04]()
+        %zero : int = prim::Constant[value=0]()
+        %qmin : int = prim::Constant[value=-128]()
+        %qmax : int = prim::Constant[value=127]()
+        %dim : int = prim::Constant[value=1]()
+        %1 : Tensor = aten::fake_quantize_per_tensor_affine(%x, %small, %zero, %qmin, %qmax)
+        %2 : Tensor = aten::fake_quantize_per_tensor_affine(%y, %large, %zero, %qmin, %qmax)
+        %3 : Tensor[] = prim::ListConstruct(%1, %2)
+        %4 : Tensor = aten::cat(%3, %dim)
+        return (%4))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, sg.get());
+  torch_tensorrt::core::lowering::passes::OptimizeQDQPlacement(sg);
+
+  for (auto n : sg->nodes()) {
+    if (n->kind() == torch::jit::aten::fake_quantize_per_tensor_affine) {
+      ASSERT_DOUBLE_EQ(torch::jit::toIValue(n->input(1))->toDouble(), 0.04);
+    }
+  }
+}
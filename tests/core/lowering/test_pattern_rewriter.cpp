@@ -0,0 +1,74 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/passes/passes.h"
+#include "core/util/prelude.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/csrc/jit/ir/subgraph_matcher.h"
+
+TEST(LoweringPasses, PatternRewriterMatchesSequentialPasses) {
+  std::string source_graph = R"IR(
+    graph(%x.1 : Tensor, %y.1 : Tensor):
+      %0 : Tensor = aten::rsqrt(%x.1)
+      %1 : Tensor = aten::silu(%y.1)
+      %2 : Tensor = aten::multiply(%0, %1)
+      return (%2))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, sg.get());
+  torch_tensorrt::core::lowering::passes::PatternRewriter rewriter;
+  torch_tensorrt::core::lowering::passes::AddUnpackRsqrtPatterns(rewriter);
+  torch_tensorrt::core::lowering::passes::AddAliasOperatorsPatterns(rewriter);
+  torch_tensorrt::core::lowering::passes::AddSiluToSigmoidMultipicationPatterns(rewriter);
+  rewriter.runOnGraph(sg);
+
+  auto tg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, tg.get());
+  torch_tensorrt::core::lowering::passes::UnpackRsqrt(tg);
+  torch_tensorrt::core::lowering::passes::AliasOperators(tg);
+  torch_tensorrt::core::lowering::passes::SiluToSigmoidMultipication(tg);
+
+  ASSERT_TRUE(!torch::jit::findPatternMatches(*tg, *sg).empty());
+  ASSERT_EQ(std::distance(sg->nodes().begin(), sg->nodes().end()), 5);
+}
+
+TEST(LoweringPasses, PatternRewriterAppliesPatternsProducedByLaterPatterns) {
+  // aten::sigmoid is only produced by the silu pattern, which is registered after the sigmoid one
+  std::string sigmoid_pattern = R"IR(
+    graph(%x):
+      %1 : Tensor = aten::sigmoid(%x)
+      return (%1))IR";
+  std::string tanh_pattern = R"IR(
+    graph(%x):
+      %1 : Tensor = aten::tanh(%x)
+      return (%1))IR";
+  std::string source_graph = R"IR(
+    graph(%x.1 : Tensor):
+      %1 : Tensor = aten::silu(%x.1)
+      return (%1))IR";
+  std::string target_graph = R"IR(
+    graph(%x.1 : Tensor):
+      %1 : Tensor = aten::tanh(%x.1)
+      %2 : Tensor = aten::mul(%x.1, %1)
+      return (%2))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, sg.get());
+  torch_tensorrt::core::lowering::passes::PatternRewriter rewriter;
+  rewriter.RegisterRewritePattern("SigmoidToTanh", sigmoid_pattern, tanh_pattern);
+  torch_tensorrt::core::lowering::passes::AddSiluToSigmoidMultipicationPatterns(rewriter);
+  rewriter.runOnGraph(sg);
+
+  auto tg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(target_graph, tg.get());
+
+  ASSERT_TRUE(!torch::jit::findPatternMatches(*tg, *sg).empty());
+  for (auto n : sg->nodes()) {
+    ASSERT_NE(n->kind(), torch::jit::aten::sigmoid);
+  }
+}
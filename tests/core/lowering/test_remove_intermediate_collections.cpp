@@ -0,0 +1,95 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/passes/passes.h"
+#include "core/util/prelude.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/csrc/jit/ir/subgraph_matcher.h"
+
+TEST(LoweringPasses, RemoveIntermediateTupleLowersCorrectly) {
+  std::string source_graph = R"IR(
+    graph(%x.1 : Tensor, %y.1 : Tensor):
+      %0 : int = prim::Constant[value=-1]()
+      %1 : Tensor = aten::relu(%x.1)
+      %2 : Tensor = aten::relu(%y.1)
+      %3 : (Tensor, Tensor) = prim::TupleConstruct(%1, %2)
+      %4 : Tensor, %5 : Tensor = prim::TupleUnpack(%3)
+      %6 : Tensor = prim::TupleIndex(%3, %0)
+      %7 : Tensor = aten::mul(%4, %6)
+      return (%7))IR";
+  std::string target_graph = R"IR(
+    graph(%x.1 : Tensor, %y.1 : Tensor):
+      %1 : Tensor = aten::relu(%x.1)
+      %2 : Tensor = aten::relu(%y.1)
+      %7 : Tensor = aten::mul(%1, %2)
+      return (%7))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, sg.get());
+  torch_tensorrt::core::lowering::passes::RemoveIntermediateCollections(sg);
+
+  auto tg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(target_graph, tg.get());
+
+  ASSERT_TRUE(!torch::jit::findPatternMatches(*tg, *sg).empty());
+  for (auto n : sg->nodes()) {
+    ASSERT_NE(n->kind(), torch::jit::prim::TupleConstruct);
+  }
+}
+
+TEST(LoweringPasses, RemoveIntermediateListLowersCorrectly) {
+  std::string source_graph = R"IR(
+    graph(%x.1 : Tensor, %y.1 : Tensor):
+      %0 : int = prim::Constant[value=1]()
+      %1 : Tensor = aten::relu(%x.1)
+      %2 : Tensor = aten::relu(%y.1)
+      %3 : Tensor[] = prim::ListConstruct(%1, %2)
+      %4 : Tensor = aten::__getitem__(%3, %0)
+      %5 : Tensor = aten::mul(%1, %4)
+      return (%5))IR";
+  std::string target_graph = R"IR(
+    graph(%x.1 : Tensor, %y.1 : Tensor):
+      %1 : Tensor = aten::relu(%x.1)
+      %2 : Tensor = aten::relu(%y.1)
+      %5 : Tensor = aten::mul(%1, %2)
+      return (%5))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, sg.get());
+  torch_tensorrt::core::lowering::passes::RemoveIntermediateCollections(sg);
+
+  auto tg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(target_graph, tg.get());
+
+  ASSERT_TRUE(!torch::jit::findPatternMatches(*tg, *sg).empty());
+  for (auto n : sg->nodes()) {
+    ASSERT_NE(n->kind(), torch::jit::prim::ListConstruct);
+  }
+}
+
+TEST(LoweringPasses, RemoveIntermediateCollectionsKeepsMutatedList) {
+  std::string source_graph = R"IR(
+    graph(%x.1 : Tensor, %y.1 : Tensor):
+      %0 : int = prim::Constant[value=0]()
+      %1 : Tensor[] = prim::ListConstruct(%x.1)
+      %2 : Tensor[] = aten::append(%1, %y.1)
+      %3 : Tensor = aten::__getitem__(%1, %0)
+      return (%3))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, sg.get());
+  torch_tensorrt::core::lowering::passes::RemoveIntermediateCollections(sg);
+
+  size_t num_getitem = 0;
+  for (auto n : sg->nodes()) {
+    num_getitem += n->kind() == torch::jit::aten::__getitem__;
+  }
+  ASSERT_EQ(num_getitem, 1);
+}
@@ -0,0 +1,66 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/conversion/conversion.h"
+#include "core/lowering/passes/passes.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+const std::string kLoopGraph = R"IR(
+    graph(%x : Tensor):
+        %trips : int = prim::Constant[value=3]()
+        %true : bool = prim::Constant[value=1]()
+        %out : Tensor = prim::Loop(%trips, %true, %x)
+          block0(%i : int, %acc : Tensor):
+            %y : Tensor = aten::add(%acc, %acc, %i)
+            %z : Tensor = aten::relu(%y)
+            -> (%true, %z)
+        return (%out))IR";
+
+size_t count_nodes(const std::shared_ptr<torch::jit::Graph>& g, c10::Symbol kind) {
+  size_t count = 0;
+  for (auto n : g->nodes()) {
+    count += n->kind() == kind;
+  }
+  return count;
+}
+
+bool op_supported(const torch::jit::Node* n) {
+  return torch_tensorrt::core::conversion::OpSupported(n);
+}
+} // namespace
+
+TEST(LoweringPasses, UnrollStaticLoopsUnrollsConvertibleLoops) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(kLoopGraph, g.get());
+
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto loop_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  torch_tensorrt::core::lowering::passes::UnrollStaticLoops(g, 16, 32, op_supported);
+  ASSERT_EQ(count_nodes(g, torch::jit::prim::Loop), 0);
+  ASSERT_EQ(count_nodes(g, torch::jit::aten::add), 3);
+  ASSERT_EQ(count_nodes(g, torch::jit::aten::relu), 3);
+
+  auto unrolled_results = torch_tensorrt::tests::util::RunGraph(g, params, {at::clone(in)});
+  ASSERT_TRUE(torch_tensorrt::tests::util::exactlyEqual(loop_results[0], unrolled_results[0]));
+}
+
+TEST(LoweringPasses, UnrollStaticLoopsKeepsLoopsOverTheLimits) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(kLoopGraph, g.get());
+  torch_tensorrt::core::lowering::passes::UnrollStaticLoops(g, 2, 32, op_supported);
+  ASSERT_EQ(count_nodes(g, torch::jit::prim::Loop), 1);
+  torch_tensorrt::core::lowering::passes::UnrollStaticLoops(g, 16, 1, op_supported);
+  ASSERT_EQ(count_nodes(g, torch::jit::prim::Loop), 1);
+}
+
+TEST(LoweringPasses, UnrollStaticLoopsKeepsLoopsWhichDoNotConvert) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(kLoopGraph, g.get());
+  torch_tensorrt::core::lowering::passes::UnrollStaticLoops(
+      g, 16, 32, [](const torch::jit::Node* n) { return n->kind() != torch::jit::aten::relu; });
+  ASSERT_EQ(count_nodes(g, torch::jit::prim::Loop), 1);
+}
@@ -3,6 +3,7 @@
 #include "core/compiler.h"
 #include "gtest/gtest.h"
 #include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
 #include "torch/script.h"
 
 size_t count_trt_engines_in_conditionals(std::shared_ptr<torch::jit::Graph> g) {
@@ -74,3 +75,59 @@ TEST(Partitioning, FallbackInplaceOPInConditionalsCorrectly) {
   auto trt_results = trt_mod.forward(trt_inputs_ivalues).toTensor();
   ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(jit_results, trt_results));
 }
+
+TEST(Partitioning, DataDependentConditionalStaysInOneEngine) {
+  const auto graph = R"IR(
+        graph(%x : Tensor, %y : Tensor):
+          %none : None = prim::Constant()
+          %zero : int = prim::Constant[value=0]()
+          %one : int = prim::Constant[value=1]()
+          %a : Tensor = aten::add(%x, %y, %one)
+          %sum : Tensor = aten::sum(%a, %none)
+          %positive : Tensor = aten::gt(%sum, %zero)
+          %cond : bool = aten::Bool(%positive)
+          %2 : Tensor = prim::If(%cond)
+            block0():
+                %2.1 : Tensor = aten::mul(%a, %y)
+                -> (%2.1)
+            block1():
+                %2.2 : Tensor = aten::sub(%a, %y, %one)
+                -> (%2.2)
+          %3 : Tensor = aten::relu(%2)
+          return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  std::vector<torch_tensorrt::core::ir::Input> inputs{
+      torch_tensorrt::core::ir::Input({3, 4}), torch_tensorrt::core::ir::Input({3, 4})};
+  torch_tensorrt::core::CompileSpec cfg(inputs);
+  cfg.partitioning_info.enabled = true;
+
+  torch::jit::script::Module mod(c10::QualifiedName("module"));
+  auto self = g->insertInput(0, "self_1");
+  self->setType(mod.type());
+  auto cur_method = mod._ivalue()->compilation_unit()->create_function(c10::QualifiedName("forward"), g);
+  auto schema = torch_tensorrt::core::util::GenerateGraphSchema(cur_method->name(), g);
+  mod.type()->addMethod(cur_method);
+  cur_method->setSchema(schema);
+
+  auto trt_mod = torch_tensorrt::core::CompileGraph(mod, cfg);
+  auto new_g = trt_mod.get_method("forward").graph();
+  size_t num_engines = 0;
+  for (auto n : new_g->nodes()) {
+    ASSERT_NE(n->kind(), torch::jit::prim::If);
+    if (n->kind().toQualString() == std::string("tensorrt::execute_engine")) {
+      num_engines++;
+    }
+  }
+  ASSERT_EQ(num_engines, 1);
+
+  for (auto sign : {1, -1}) {
+    auto x = at::rand({3, 4}, {at::kCUDA}) * sign;
+    auto y = at::rand({3, 4}, {at::kCUDA}) * sign;
+    auto jit_results = mod.forward({x, y}).toTensor();
+    auto trt_results = trt_mod.forward({x, y}).toTensor();
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results, trt_results, 2e-6));
+  }
+}
@@ -0,0 +1,116 @@
+#include <string>
+#include "core/partitioning/partitioning.h"
+#include "core/partitioning/segment_calibration.h"
+#include "gtest/gtest.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/script.h"
+
+namespace {
+
+// Feeds num_batches batches filled with the batch index + 1 and keeps the cache it is given in memory
+class CountingCalibrator : public nvinfer1::IInt8EntropyCalibrator2 {
+ public:
+  CountingCalibrator(int num_batches, std::vector<int64_t> shape) : num_batches_(num_batches), shape_(shape) {}
+
+  int32_t getBatchSize() const noexcept override {
+    return 1;
+  }
+
+  bool getBatch(void* bindings[], const char* names[], int32_t nbBindings) noexcept override {
+    calls++;
+    if (next_ == num_batches_) {
+      next_ = 0;
+      return false;
+    }
+    batch_ = at::full(shape_, next_ + 1, {at::kCUDA});
+    next_++;
+    for (int32_t i = 0; i < nbBindings; i++) {
+      bindings[i] = batch_.data_ptr();
+    }
+    return true;
+  }
+
+  const void* readCalibrationCache(std::size_t& length) noexcept override {
+    length = cache.size();
+    return length ? cache.data() : nullptr;
+  }
+
+  void writeCalibrationCache(const void* ptr, std::size_t length) noexcept override {
+    cache.assign(static_cast<const char*>(ptr), length);
+  }
+
+  int calls = 0;
+  std::string cache;
+
+ private:
+  int num_batches_;
+  int next_ = 0;
+  std::vector<int64_t> shape_;
+  at::Tensor batch_;
+};
+
+} // namespace
+
+TEST(Partitioning, SharedSegmentCalibrationRunsCalibrationDataOnce) {
+  const auto graph = R"IR(
+          graph(%0 : Tensor):
+            %1 : Tensor = aten::relu(%0)
+            %2 : Tensor = aten::log_sigmoid(%1)
+            %3 : Tensor = aten::relu(%2)
+            return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  torch_tensorrt::core::partitioning::PartitioningInfo partitioning_info;
+  partitioning_info.enabled = true;
+  partitioning_info.forced_fallback_operators = {"aten::log_sigmoid"};
+  partitioning_info.collection_input_spec_map = {{g->inputs()[0], {torch_tensorrt::core::ir::Input({2, 8})}}};
+  torch_tensorrt::core::partitioning::PartitioningCtx ctx(g->block(), partitioning_info);
+  ctx.input_types_map = {{g->inputs()[0], {{at::kFloat}}}};
+
+  torch_tensorrt::core::partitioning::populateInputIValues(&ctx);
+  torch_tensorrt::core::partitioning::partition(&ctx);
+
+  std::vector<torch_tensorrt::core::partitioning::SegmentedBlock*> trt_segments;
+  for (auto& seg : ctx.partitioned_blocks[g->block()]) {
+    if (seg.target() == torch_tensorrt::core::partitioning::SegmentedBlock::kTensorRT) {
+      trt_segments.push_back(&seg);
+    }
+  }
+  ASSERT_EQ(trt_segments.size(), 2);
+
+  CountingCalibrator user_calibrator(3, {2, 8});
+  auto shared = torch_tensorrt::core::partitioning::SharedSegmentCalibration::create(
+      &user_calibrator, &ctx, g->block(), trt_segments, {{at::kFloat}, {at::kFloat}});
+  ASSERT_TRUE(shared);
+  // Three batches and the call that ends the data
+  ASSERT_EQ(user_calibrator.calls, 4);
+
+  // The second segment sees the output of the Torch segment for each batch
+  void* bindings[1];
+  const char* names[] = {"input_0"};
+  for (int b = 0; b < 3; b++) {
+    ASSERT_TRUE(shared->calibrator(1)->getBatch(bindings, names, 1));
+    auto expected = at::log_sigmoid(at::full({2, 8}, b + 1, {at::kCUDA}));
+    auto fed = at::from_blob(bindings[0], {2, 8}, {at::kCUDA});
+    ASSERT_TRUE(at::allclose(fed, expected));
+  }
+  ASSERT_FALSE(shared->calibrator(1)->getBatch(bindings, names, 1));
+
+  // The segment caches are written as one cache which a later compilation reads instead of calibrating
+  std::string seg0 = "segment 0 cache";
+  std::string seg1 = "segment 1 cache";
+  shared->calibrator(0)->writeCalibrationCache(seg0.data(), seg0.size());
+  shared->calibrator(1)->writeCalibrationCache(seg1.data(), seg1.size());
+  shared->write_cache();
+  ASSERT_FALSE(user_calibrator.cache.empty());
+
+  auto cached = torch_tensorrt::core::partitioning::SharedSegmentCalibration::create(
+      &user_calibrator, &ctx, g->block(), trt_segments, {{at::kFloat}, {at::kFloat}});
+  ASSERT_TRUE(cached);
+  ASSERT_EQ(user_calibrator.calls, 4);
+  size_t length = 0;
+  auto cache = static_cast<const char*>(cached->calibrator(1)->readCalibrationCache(length));
+  ASSERT_EQ(std::string(cache, length), seg1);
+}
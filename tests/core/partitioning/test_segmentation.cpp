@@ -1,4 +1,6 @@
+#include <sstream>
 #include <string>
+#include "core/conversion/converters/converters.h"
 #include "core/partitioning/partitioning.h"
 #include "gtest/gtest.h"
 #include "tests/util/util.h"
@@ -159,6 +161,42 @@ TEST(Partitioning, SegmentModelWithMinBlockSizeCausedFallbackCorrectly) {
   ASSERT_TRUE(checkSegmentedBlockNodesMapping(ctx.partitioned_blocks.begin()->second, g, {{0, 1, 2, 3}, {4, 5, 6, 7}}));
 }
 
+TEST(Partitioning, SegmentModelWithCascadingMinBlockSizeFallbackCorrectly) {
+  // In every unit the first run of TensorRT nodes is too small, the size it computes then makes the add fallback, which
+  // splits the next run into one that is too small and one that is kept
+  const int64_t num_units = 50;
+  std::stringstream graph;
+  graph << "graph(%x0 : Tensor):\n";
+  graph << "  %zero : int = prim::Constant[value=0]()\n";
+  for (int64_t k = 0; k < num_units; k++) {
+    graph << "  %a" << k << " : Tensor = aten::relu(%x" << k << ")\n";
+    graph << "  %s" << k << " : int = aten::size(%a" << k << ", %zero)\n";
+    graph << "  %b" << k << " : Tensor = aten::log_sigmoid(%a" << k << ")\n";
+    graph << "  %c" << k << " : Tensor = aten::relu(%b" << k << ")\n";
+    graph << "  %d" << k << " : Tensor = aten::relu(%c" << k << ")\n";
+    graph << "  %e" << k << " : Tensor = aten::add(%d" << k << ", %d" << k << ", %s" << k << ")\n";
+    graph << "  %f" << k << " : Tensor = aten::relu(%e" << k << ")\n";
+    graph << "  %h" << k << " : Tensor = aten::relu(%f" << k << ")\n";
+    graph << "  %i" << k << " : Tensor = aten::relu(%h" << k << ")\n";
+    graph << "  %x" << k + 1 << " : Tensor = aten::log_sigmoid(%i" << k << ")\n";
+  }
+  graph << "  return (%x" << num_units << ")";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph.str(), g.get());
+
+  PartitioningInfo partitioning_info;
+  partitioning_info.enabled = true;
+  partitioning_info.min_block_size = 3;
+  partitioning_info.forced_fallback_operators.push_back("aten::log_sigmoid");
+  PartitioningCtx ctx(g->block(), partitioning_info);
+  segmentGraph(&ctx, g->block());
+  auto& segmented_blocks = ctx.partitioned_blocks.begin()->second;
+  ASSERT_TRUE(checkSegmentedBlockNumber(segmented_blocks, SegmentedBlock::kTensorRT, num_units));
+  ASSERT_TRUE(checkSegmentedBlockNumber(segmented_blocks, SegmentedBlock::kTorch, num_units + 1));
+  ASSERT_TRUE(checkSegmentedBlockNodesMapping(segmented_blocks, g, {{0, 1, 2, 3, 4, 5}, {6, 7, 8}}));
+}
+
 TEST(Partitioning, SegmentSequentialModelWithForcedOPCorrectly) {
   const auto graph = R"IR(
             graph(%0 : Tensor,
@@ -331,6 +369,128 @@ TEST(Partitioning, SegmentModelWithDependencyAwareness) {
       checkSegmentedBlockNodesMapping(ctx.partitioned_blocks.begin()->second, g, {{0, 2, 4}, {1, 3, 5}, {6, 7}}));
 }
 
+TEST(Partitioning, SegmentModelWithCostModelCorrectly) {
+  const auto graph = R"IR(
+          graph(%0 : Tensor,
+                %w1 : Float(32, 3, 3, 3, strides=[27, 9, 3, 1]),
+                %b1 : Float(32),
+                %w2 : Float(16, 32, 3, 3, strides=[288, 9, 3, 1]),
+                %b2 : Float(16)):
+            %2 : int[] = prim::Constant[value=[1, 1]]()
+            %3 : int = prim::Constant[value=1]()
+            %10 : bool = prim::Constant[value=0]()
+            %11 : int[] = prim::Constant[value=[0, 0]]()
+            %12: Tensor = aten::_convolution(%0, %w1, %b1, %2, %2, %2, %10, %11, %3, %10, %10, %10, %10)
+            %13 : Tensor = aten::log_sigmoid(%12)
+            %14 : Tensor = aten::relu(%13)
+            %15 : Tensor = aten::log_sigmoid(%14)
+            %16 : Tensor = aten::_convolution(%15, %w2, %b2, %2, %2, %2, %10, %11, %3, %10, %10, %10, %10)
+            return (%16))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  LOG_GRAPH(*g);
+
+  // A lone relu saves less than its boundaries cost, the convolutions pay for theirs
+  PartitioningInfo partitioning_info;
+  partitioning_info.enabled = true;
+  partitioning_info.cost_model_partitioning = true;
+  PartitioningCtx ctx(g->block(), partitioning_info);
+  segmentGraph(&ctx, g->block());
+  ASSERT_TRUE(checkSegmentedBlockNumber(ctx.partitioned_blocks.begin()->second, SegmentedBlock::kTensorRT, 2));
+  ASSERT_TRUE(checkSegmentedBlockNumber(ctx.partitioned_blocks.begin()->second, SegmentedBlock::kTorch, 1));
+  ASSERT_TRUE(checkSegmentedBlockNodesMapping(ctx.partitioned_blocks.begin()->second, g, {{0}, {1, 2, 3}, {4}}));
+
+  // Measured savings take precedence over the built-in estimates
+  partitioning_info.op_latency_savings_us["aten::relu"] = 100.0;
+  PartitioningCtx measured_ctx(g->block(), partitioning_info);
+  segmentGraph(&measured_ctx, g->block());
+  ASSERT_TRUE(
+      checkSegmentedBlockNumber(measured_ctx.partitioned_blocks.begin()->second, SegmentedBlock::kTensorRT, 3));
+  ASSERT_TRUE(
+      checkSegmentedBlockNodesMapping(measured_ctx.partitioned_blocks.begin()->second, g, {{0}, {1}, {2}, {3}, {4}}));
+}
+
+TEST(Partitioning, SegmentModelMergingAcrossNonTensorBoundariesCorrectly) {
+  const auto graph = R"IR(
+          graph(%x : Tensor,
+                %y : Tensor):
+            %0 : int = prim::Constant[value=0]()
+            %1 : int = prim::Constant[value=-1]()
+            %2 : int[] = prim::Constant[value=[0]]()
+            %3 : Tensor = aten::relu(%x)
+            %4 : int = aten::size(%3, %0)
+            %5 : int[] = prim::ListConstruct(%4)
+            %6 : Tensor = aten::roll(%3, %5, %2)
+            %7 : int[] = prim::ListConstruct(%4, %1)
+            %8 : Tensor = aten::reshape(%y, %7)
+            %9 : Tensor = aten::sigmoid(%8)
+            return (%9, %6))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  LOG_GRAPH(*g);
+
+  PartitioningInfo partitioning_info;
+  partitioning_info.enabled = true;
+  partitioning_info.forced_fallback_operators = {"aten::roll"};
+  PartitioningCtx ctx(g->block(), partitioning_info);
+  segmentGraph(&ctx, g->block());
+  ASSERT_TRUE(checkSegmentedBlockNumber(ctx.partitioned_blocks.begin()->second, SegmentedBlock::kTensorRT, 2));
+
+  // The size falls back with the roll consuming it, the reshape recomputes it instead of falling back as well, so the
+  // Torch segment moves behind the reshape and both TensorRT segments merge
+  partitioning_info.merge_non_tensor_boundaries = true;
+  PartitioningCtx merged_ctx(g->block(), partitioning_info);
+  segmentGraph(&merged_ctx, g->block());
+  ASSERT_TRUE(checkSegmentedBlockNumber(merged_ctx.partitioned_blocks.begin()->second, SegmentedBlock::kTensorRT, 1));
+  ASSERT_TRUE(checkSegmentedBlockNumber(merged_ctx.partitioned_blocks.begin()->second, SegmentedBlock::kTorch, 1));
+  ASSERT_TRUE(
+      checkSegmentedBlockNodesMapping(merged_ctx.partitioned_blocks.begin()->second, g, {{0, 4, 5, 6}, {1, 2, 3}}));
+}
+
+TEST(Partitioning, SegmentModelBridgingUnsupportedOpCorrectly) {
+  const auto graph = R"IR(
+          graph(%x : Tensor):
+            %0 : Tensor = aten::relu(%x)
+            %1 : Tensor = aten::sigmoid(%0)
+            %2 : Tensor = aten::tanh(%1)
+            %3 : Tensor = aten::erfinv(%2)
+            %4 : Tensor = aten::relu(%3)
+            %5 : Tensor = aten::sigmoid(%4)
+            %6 : Tensor = aten::tanh(%5)
+            %7 : Tensor = aten::erfinv(%6)
+            %8 : Tensor = aten::relu(%7)
+            return (%8))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  LOG_GRAPH(*g);
+
+  PartitioningInfo partitioning_info;
+  partitioning_info.enabled = true;
+  partitioning_info.min_block_size = 3;
+  PartitioningCtx ctx(g->block(), partitioning_info);
+  segmentGraph(&ctx, g->block());
+  ASSERT_TRUE(checkSegmentedBlockNumber(ctx.partitioned_blocks.begin()->second, SegmentedBlock::kTensorRT, 2));
+  ASSERT_TRUE(checkSegmentedBlockNumber(ctx.partitioned_blocks.begin()->second, SegmentedBlock::kTorch, 2));
+
+  // The first erfinv sits between two runs of min_block_size nodes and runs in the engine, the second one is followed
+  // by a single node so the last relu still falls back with it
+  partitioning_info.bridge_unsupported_ops = true;
+  PartitioningCtx bridged_ctx(g->block(), partitioning_info);
+  segmentGraph(&bridged_ctx, g->block());
+  ASSERT_TRUE(checkSegmentedBlockNumber(bridged_ctx.partitioned_blocks.begin()->second, SegmentedBlock::kTensorRT, 1));
+  ASSERT_TRUE(checkSegmentedBlockNumber(bridged_ctx.partitioned_blocks.begin()->second, SegmentedBlock::kTorch, 1));
+  ASSERT_TRUE(checkSegmentedBlockNodesMapping(
+      bridged_ctx.partitioned_blocks.begin()->second, g, {{0, 1, 2, 3, 4, 5, 6}, {7, 8}}));
+  size_t num_bridged = 0;
+  for (const auto n : g->nodes()) {
+    num_bridged += n->hasAttribute(torch_tensorrt::core::conversion::converters::kTorchOpPluginAttr);
+  }
+  ASSERT_EQ(num_bridged, 1u);
+}
+
 } // namespace tests
 } // namespace partitioning
 } // namespace core
@@ -1,5 +1,6 @@
 #include <string>
 #include "core/partitioning/partitioning.h"
+#include "core/partitioning/partitioning_report.h"
 #include "core/util/trt_util.h"
 #include "gtest/gtest.h"
 #include "torch/csrc/jit/ir/irparser.h"
@@ -138,6 +139,105 @@ TEST(Partitioning, InferBranchModelSegmentedBlockShapeCorrectly) {
        {{3, 32, 16, 16}, {16, 32, 3, 3}, {16}, {3, 16, 16, 16}}}));
 }
 
+TEST(Partitioning, InferSegmentedBlockShapeSymbolicallyCorrectly) {
+  const auto graph = R"IR(
+          graph(%0 : Tensor,
+                %w1 : Float(32, 3, 3, 3, strides=[27, 9, 3, 1]),
+                %b1 : Float(32),
+                %w2 : Float(16, 32, 3, 3, strides=[288, 9, 3, 1]),
+                %b2 : Float(16),
+                %w3 : Float(8, 16, 3, 3, strides=[144, 9, 3, 1]),
+                %b3 : Float(8)):
+            %2 : int[] = prim::Constant[value=[1, 1]]()
+            %3 : int = prim::Constant[value=1]()
+            %10 : bool = prim::Constant[value=0]()
+            %11 : int[] = prim::Constant[value=[0, 0]]()
+            %12: Tensor = aten::_convolution(%0, %w1, %b1, %2, %2, %2, %10, %11, %3, %10, %10, %10, %10)
+            %13 : Tensor = aten::relu(%12)
+            %14 : Tensor = aten::_convolution(%13, %w2, %b2, %2, %2, %2, %10, %11, %3, %10, %10, %10, %10)
+            %15 : Tensor = aten::log_sigmoid(%14)
+            %16 : Tensor = aten::_convolution(%15, %w3, %b3, %2, %2, %2, %10, %11, %3, %10, %10, %10, %10)
+            return (%16))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  torch_tensorrt::core::partitioning::PartitioningInfo partitioning_info;
+  partitioning_info.enabled = true;
+  partitioning_info.symbolic_shape_analysis = true;
+  std::vector<torch_tensorrt::core::ir::Input> inputs;
+  inputs.push_back(torch_tensorrt::core::ir::Input({3, 3, 16, 16}));
+  inputs.push_back(torch_tensorrt::core::ir::Input({32, 3, 3, 3}));
+  inputs.push_back(torch_tensorrt::core::ir::Input({32}));
+  inputs.push_back(torch_tensorrt::core::ir::Input({16, 32, 3, 3}));
+  inputs.push_back(torch_tensorrt::core::ir::Input({16}));
+  inputs.push_back(torch_tensorrt::core::ir::Input({8, 16, 3, 3}));
+  inputs.push_back(torch_tensorrt::core::ir::Input({8}));
+
+  std::unordered_map<const torch::jit::Value*, std::vector<torch_tensorrt::core::ir::Input>> inputs_map;
+  std::unordered_map<const torch::jit::Value*, std::vector<c10::optional<at::ScalarType>>> input_types;
+
+  for (size_t i = 0; i < g->inputs().size(); ++i) {
+    inputs_map.insert({g->inputs()[i], {inputs[i]}});
+    input_types.insert({g->inputs()[i], {{at::kFloat}}});
+  }
+  partitioning_info.collection_input_spec_map = inputs_map;
+  torch_tensorrt::core::partitioning::PartitioningCtx ctx(g->block(), partitioning_info);
+  ctx.input_types_map = input_types;
+
+  torch_tensorrt::core::partitioning::populateInputIValues(&ctx);
+  torch_tensorrt::core::partitioning::partition(&ctx);
+  auto segmented_blocks = ctx.partitioned_blocks.begin()->second;
+
+  ASSERT_TRUE(checkSegmentedBlockInputShape(
+      segmented_blocks,
+      {{{3, 3, 16, 16}, {32, 3, 3, 3}, {32}, {16, 32, 3, 3}, {16}},
+       {{3, 16, 16, 16}},
+       {{3, 16, 16, 16}, {8, 16, 3, 3}, {8}}}));
+  // Convolutions have shape functions, the last TensorRT segment is not run
+  ASSERT_TRUE(ctx.opt_input_ivalues_map[g->outputs()[0]].toTensor().is_meta());
+  // The propagated shapes are not left on the graph
+  ASSERT_FALSE(g->inputs()[0]->type()->cast<c10::TensorType>()->sizes().concrete_sizes());
+}
+
+TEST(Partitioning, InferIndependentSegmentShapesConcurrentlyCorrectly) {
+  const auto graph = R"IR(
+          graph(%a : Tensor,
+                %b : Tensor):
+            %1 : int = prim::Constant[value=1]()
+            %2 : Tensor = aten::relu(%b)
+            %3 : Tensor = aten::log_sigmoid(%a)
+            %4 : Tensor = aten::add(%3, %2, %1)
+            return (%4))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  torch_tensorrt::core::partitioning::PartitioningInfo partitioning_info;
+  partitioning_info.enabled = true;
+  partitioning_info.num_shape_analysis_workers = 2;
+  partitioning_info.forced_fallback_operators = {"aten::log_sigmoid"};
+
+  std::unordered_map<const torch::jit::Value*, std::vector<torch_tensorrt::core::ir::Input>> inputs_map;
+  std::unordered_map<const torch::jit::Value*, std::vector<c10::optional<at::ScalarType>>> input_types;
+  for (size_t i = 0; i < g->inputs().size(); ++i) {
+    inputs_map.insert({g->inputs()[i], {torch_tensorrt::core::ir::Input({3, 4})}});
+    input_types.insert({g->inputs()[i], {{at::kFloat}}});
+  }
+  partitioning_info.collection_input_spec_map = inputs_map;
+  torch_tensorrt::core::partitioning::PartitioningCtx ctx(g->block(), partitioning_info);
+  ctx.input_types_map = input_types;
+
+  torch_tensorrt::core::partitioning::populateInputIValues(&ctx);
+  torch_tensorrt::core::partitioning::partition(&ctx);
+  auto segmented_blocks = ctx.partitioned_blocks.begin()->second;
+
+  ASSERT_TRUE(checkSegmentedBlockInputShape(segmented_blocks, {{{3, 4}}, {{3, 4}}, {{3, 4}, {3, 4}}}));
+  // Only the graph inputs and output are left once the segments consuming the intermediates are analyzed
+  ASSERT_EQ(ctx.opt_input_ivalues_map.size(), 3UL);
+  ASSERT_TRUE(ctx.opt_input_ivalues_map.count(g->outputs()[0]));
+}
+
 TEST(Partitioning, PopulateInputIValuesDynamic) {
   const auto graph = R"IR(
           graph(%0 : Tensor, %1 : Tensor):
@@ -171,3 +271,80 @@ TEST(Partitioning, PopulateInputIValuesDynamic) {
   ASSERT_EQ(ctx.min_input_ivalues_map.size(), 2UL);
   ASSERT_EQ(ctx.max_input_ivalues_map.size(), 2UL);
 }
+
+TEST(Partitioning, GeneratePartitioningReportCorrectly) {
+  const auto graph = R"IR(
+          graph(%0 : Tensor,
+                %w1 : Float(32, 3, 3, 3, strides=[27, 9, 3, 1]),
+                %b1 : Float(32),
+                %w2 : Float(16, 32, 3, 3, strides=[288, 9, 3, 1]),
+                %b2 : Float(16),
+                %w3 : Float(8, 16, 3, 3, strides=[144, 9, 3, 1]),
+                %b3 : Float(8)):
+            %2 : int[] = prim::Constant[value=[1, 1]]()
+            %3 : int = prim::Constant[value=1]()
+            %10 : bool = prim::Constant[value=0]()
+            %11 : int[] = prim::Constant[value=[0, 0]]()
+            %12: Tensor = aten::_convolution(%0, %w1, %b1, %2, %2, %2, %10, %11, %3, %10, %10, %10, %10)
+            %13 : Tensor = aten::relu(%12)
+            %14 : Tensor = aten::_convolution(%13, %w2, %b2, %2, %2, %2, %10, %11, %3, %10, %10, %10, %10)
+            %15 : Tensor = aten::log_sigmoid(%14)
+            %16 : Tensor = aten::_convolution(%15, %w3, %b3, %2, %2, %2, %10, %11, %3, %10, %10, %10, %10)
+            return (%16))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  torch_tensorrt::core::partitioning::PartitioningInfo partitioning_info;
+  partitioning_info.enabled = true;
+  partitioning_info.forced_fallback_operators = {"aten::log_sigmoid"};
+  std::vector<torch_tensorrt::core::ir::Input> inputs;
+  inputs.push_back(torch_tensorrt::core::ir::Input({3, 3, 16, 16}));
+  inputs.push_back(torch_tensorrt::core::ir::Input({32, 3, 3, 3}));
+  inputs.push_back(torch_tensorrt::core::ir::Input({32}));
+  inputs.push_back(torch_tensorrt::core::ir::Input({16, 32, 3, 3}));
+  inputs.push_back(torch_tensorrt::core::ir::Input({16}));
+  inputs.push_back(torch_tensorrt::core::ir::Input({8, 16, 3, 3}));
+  inputs.push_back(torch_tensorrt::core::ir::Input({8}));
+
+  std::unordered_map<const torch::jit::Value*, std::vector<torch_tensorrt::core::ir::Input>> inputs_map;
+  std::unordered_map<const torch::jit::Value*, std::vector<c10::optional<at::ScalarType>>> input_types;
+  for (size_t i = 0; i < g->inputs().size(); ++i) {
+    inputs_map.insert({g->inputs()[i], {inputs[i]}});
+    input_types.insert({g->inputs()[i], {{at::kFloat}}});
+  }
+  partitioning_info.collection_input_spec_map = inputs_map;
+  torch_tensorrt::core::partitioning::PartitioningCtx ctx(g->block(), partitioning_info);
+  ctx.input_types_map = input_types;
+
+  torch_tensorrt::core::partitioning::populateInputIValues(&ctx);
+  torch_tensorrt::core::partitioning::partition(&ctx);
+  auto report = torch_tensorrt::core::partitioning::generatePartitioningReport(&ctx);
+
+  // The output of the first engine goes to Torch and the output of Torch to the second engine, each a
+  // [3, 16, 16, 16] Float tensor
+  ASSERT_EQ(report.blocks.size(), 1UL);
+  auto& segments = report.blocks[0].segments;
+  ASSERT_EQ(segments.size(), 3UL);
+  ASSERT_EQ(segments[1].target, torch_tensorrt::core::partitioning::SegmentedBlock::kTorch);
+  ASSERT_EQ(segments[1].num_nodes, 1UL);
+  ASSERT_EQ(segments[1].inputs.size(), 1UL);
+  ASSERT_EQ(segments[1].inputs[0].producer, 0);
+  ASSERT_TRUE(segments[1].inputs[0].crossing);
+  ASSERT_EQ(segments[1].inputs[0].shape, std::vector<int64_t>({3, 16, 16, 16}));
+  ASSERT_EQ(segments[1].inputs[0].dtype, at::kFloat);
+  ASSERT_EQ(segments[1].fallback_nodes.size(), 1UL);
+  ASSERT_EQ(
+      segments[1].fallback_nodes[0].decision,
+      torch_tensorrt::core::partitioning::NodeExecutorDecision::kOPERATOR_FALLBACK);
+  ASSERT_EQ(report.num_boundaries, 2);
+  ASSERT_EQ(report.boundary_bytes, 2 * 3 * 16 * 16 * 16 * 4);
+  ASSERT_EQ(report.boundary_casts, 0);
+  ASSERT_EQ(report.fallback_ops.count("aten::log_sigmoid"), 1UL);
+  ASSERT_EQ(report.fallback_ops["aten::log_sigmoid"].num_nodes, 1);
+  ASSERT_EQ(report.fallback_ops["aten::log_sigmoid"].boundary_bytes, 2 * 3 * 16 * 16 * 16 * 4);
+
+  std::stringstream ss;
+  ss << report;
+  ASSERT_NE(ss.str().find("\"reason\": \"operator_fallback\""), std::string::npos);
+}
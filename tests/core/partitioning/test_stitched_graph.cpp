@@ -3,6 +3,7 @@
 #include "core/compiler.h"
 #include "core/util/trt_util.h"
 #include "gtest/gtest.h"
+#include "tests/util/util.h"
 #include "torch/csrc/jit/ir/constants.h"
 #include "torch/csrc/jit/ir/irparser.h"
 #include "torch/script.h"
@@ -138,3 +139,82 @@ TEST(Partitioning, StitchBranchModelSegmentedBlockCorrectly) {
   auto fallback_g = new_mod.get_method("forward").graph();
   ASSERT_TRUE(checkAllInputsExistInStitchedGraph(fallback_g));
 }
+
+TEST(Partitioning, ScheduleIndependentSegmentsOnSeparateStreamsCorrectly) {
+  const auto graph = R"IR(
+                  graph(%0 : Tensor,
+                        %1 : Float(8, 3, 3, 3, strides=[27, 9, 3, 1]),
+                        %2 : Float(8),
+                        %3 : Float(4, 3, 3, 3, strides=[27, 9, 3, 1]),
+                        %4 : Float(4)):
+                    %5 : int[] = prim::Constant[value=[0, 0]]()
+                    %7 : bool = prim::Constant[value=0]()
+                    %8 : int[] = prim::Constant[value=[1, 1]]()
+                    %9 : int = prim::Constant[value=1]()
+                    %10 : Tensor = aten::_convolution(%0, %1, %2, %8, %8, %8, %7, %5, %9, %7, %7, %7, %7)
+                    %11 : Tensor = aten::relu(%10)
+                    %12 : Tensor = aten::log_sigmoid(%0)
+                    %13 : Tensor = aten::_convolution(%12, %3, %4, %8, %8, %8, %7, %5, %9, %7, %7, %7, %7)
+                    %14 : Tensor = aten::relu(%13)
+                    %15 : (Tensor, Tensor) = prim::TupleConstruct(%11, %14)
+                    return (%15))IR";
+
+  auto parsed_g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, parsed_g.get());
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  std::vector<std::vector<int64_t>> all_shapes{{8, 3, 3, 3}, {8}, {4, 3, 3, 3}, {4}};
+  std::unordered_map<torch::jit::Value*, torch::jit::Value*> tensor_to_constant;
+  for (size_t i = 0; i < all_shapes.size(); ++i) {
+    auto in = at::randint(5, all_shapes[i], {at::kCUDA});
+    torch::jit::IValue cur_val = in.clone();
+    auto new_val = g->insertConstant(cur_val);
+    tensor_to_constant[parsed_g->inputs()[i + 1]] = new_val;
+  }
+  for (auto node : parsed_g->nodes()) {
+    if (node->kind() == torch::jit::prim::Constant)
+      continue;
+    torch_tensorrt::core::util::cloneNode(node, g, tensor_to_constant);
+  }
+  g->registerOutput(tensor_to_constant[parsed_g->outputs()[0]]);
+
+  torch::jit::script::Module mod(c10::QualifiedName("module"));
+
+  auto self = g->insertInput(0, "self_1");
+  self->setType(mod.type());
+  auto cur_method = mod._ivalue()->compilation_unit()->create_function(c10::QualifiedName("forward"), g);
+  auto schema = torch_tensorrt::core::util::GenerateGraphSchema(cur_method->name(), g);
+  mod.type()->addMethod(cur_method);
+  cur_method->setSchema(schema);
+
+  std::vector<torch_tensorrt::core::ir::Input> inputs;
+  inputs.push_back(torch_tensorrt::core::ir::Input({3, 3, 16, 16}));
+  torch_tensorrt::core::CompileSpec cfg(inputs);
+  cfg.partitioning_info.enabled = true;
+  cfg.partitioning_info.forced_fallback_operators.push_back("aten::log_sigmoid");
+  cfg.partitioning_info.concurrent_segment_streams = 2;
+  cfg.partitioning_info.overlap_torch_segments = true;
+  torch::jit::script::Module new_mod = torch_tensorrt::core::CompileGraph(mod, cfg);
+  auto fallback_g = new_mod.get_method("forward").graph();
+  ASSERT_TRUE(checkAllInputsExistInStitchedGraph(fallback_g));
+
+  // The two engines go to different streams and are only joined where their outputs are packed into the tuple
+  std::vector<int64_t> entered_branches;
+  size_t num_joins = 0;
+  for (auto n : fallback_g->nodes()) {
+    if (n->kind() == c10::Symbol::fromQualString("tensorrt::enter_segment_stream")) {
+      entered_branches.push_back(torch::jit::toIValue(n->input(1))->toInt());
+    } else if (n->kind() == c10::Symbol::fromQualString("tensorrt::join_segment_stream")) {
+      num_joins++;
+    }
+  }
+  ASSERT_EQ(entered_branches, std::vector<int64_t>({0, 1}));
+  ASSERT_EQ(num_joins, 2);
+
+  auto in = at::randint(5, {3, 3, 16, 16}, {at::kCUDA});
+  auto jit_results = mod.forward({in}).toTuple()->elements();
+  auto trt_results = new_mod.forward({in}).toTuple()->elements();
+  for (size_t i = 0; i < jit_results.size(); i++) {
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[i].toTensor(), trt_results[i].toTensor(), 2e-6));
+  }
+}
@@ -167,3 +167,104 @@ TEST(Partitioning, ExplicitNodeAutoInt8ConversionCorrectly) {
   // Seeking 1 inserted aten::to converting Byte to Int (%k_.1 is a Byte Tensor)
   ASSERT_TRUE(checkInsertedCastNodeNumber(segmented_blocks[0], 1));
 }
+
+TEST(Partitioning, BoundaryTruncationPushedIntoEngineCorrectly) {
+  const auto graph = R"IR(
+          graph(%0 : Tensor,
+                %1 : Tensor):
+            %2 : int = prim::Constant[value=4]()
+            %3 : bool = prim::Constant[value=0]()
+            %4 : NoneType = prim::Constant()
+            %5 : int = prim::Constant[value=1]()
+            %7: Tensor = aten::to(%1, %2, %3, %3, %4)
+            %8 : Tensor = aten::mul(%0, %0)
+            %9 : Tensor = aten::scatter(%8, %5, %7, %5)
+            %10 : Tensor = aten::scatter(%7, %5, %7, %5)
+            %12 : Tensor = aten::add(%10, %10, %5)
+            return (%9, %12))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get(), true);
+
+  torch_tensorrt::core::partitioning::PartitioningInfo partitioning_info;
+  partitioning_info.enabled = true;
+  partitioning_info.forced_fallback_operators = {"aten::scatter"};
+  partitioning_info.truncate_long_and_double = true;
+  std::vector<torch_tensorrt::core::ir::Input> inputs;
+  inputs.push_back(torch_tensorrt::core::ir::Input({5, 5}));
+  inputs.push_back(torch_tensorrt::core::ir::Input({5, 5}));
+
+  std::unordered_map<const torch::jit::Value*, std::vector<torch_tensorrt::core::ir::Input>> inputs_map;
+  std::unordered_map<const torch::jit::Value*, std::vector<c10::optional<at::ScalarType>>> input_types;
+  inputs_map.insert({g->inputs()[0], {inputs[0]}});
+  input_types.insert({g->inputs()[0], {{at::kFloat}}});
+  inputs_map.insert({g->inputs()[1], {inputs[1]}});
+  input_types.insert({g->inputs()[1], {{at::kInt}}});
+
+  partitioning_info.collection_input_spec_map = inputs_map;
+  torch_tensorrt::core::partitioning::PartitioningCtx ctx(g->block(), partitioning_info);
+  ctx.input_types_map = input_types;
+  torch_tensorrt::core::partitioning::populateInputIValues(&ctx);
+  torch_tensorrt::core::partitioning::partition(&ctx);
+  torch_tensorrt::core::partitioning::eliminateBoundaryCasts(&ctx);
+  auto segmented_blocks = ctx.partitioned_blocks.begin()->second;
+
+  for (auto& seg_block : segmented_blocks) {
+    LOG_DEBUG(seg_block << " cur seg block");
+  }
+#if NV_TENSORRT_MAJOR >= 10
+  // Only the cast of the Int engine output to Long is left, the Long output goes to the engine as is
+  ASSERT_TRUE(checkInsertedCastNodeNumber(segmented_blocks[1], 1));
+  auto& engine_in_types = segmented_blocks[2].in_types();
+  ASSERT_TRUE(std::find(engine_in_types.begin(), engine_in_types.end(), at::kLong) != engine_in_types.end());
+#else
+  ASSERT_TRUE(checkInsertedCastNodeNumber(segmented_blocks[1], 2));
+#endif
+}
+
+#if NV_TENSORRT_MAJOR >= 10
+TEST(Partitioning, LongInputBoundNativelyWithoutTruncation) {
+  const auto graph = R"IR(
+          graph(%0 : Tensor,
+                %1 : Tensor):
+            %2 : int = prim::Constant[value=6]()
+            %3 : bool = prim::Constant[value=0]()
+            %4 : NoneType = prim::Constant()
+            %5 : int = prim::Constant[value=1]()
+            %7 : Tensor = aten::add(%1, %1, %5)
+            %8 : Tensor = aten::to(%7, %2, %3, %3, %4)
+            %9 : Tensor = aten::mul(%0, %8)
+            %10 : Tensor = aten::relu(%9)
+            return (%10))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get(), true);
+
+  torch_tensorrt::core::partitioning::PartitioningInfo partitioning_info;
+  partitioning_info.enabled = true;
+  partitioning_info.forced_fallback_operators = {"aten::relu"};
+  std::vector<torch_tensorrt::core::ir::Input> inputs;
+  inputs.push_back(torch_tensorrt::core::ir::Input({5, 5}));
+  inputs.push_back(torch_tensorrt::core::ir::Input({5, 5}));
+
+  std::unordered_map<const torch::jit::Value*, std::vector<torch_tensorrt::core::ir::Input>> inputs_map;
+  std::unordered_map<const torch::jit::Value*, std::vector<c10::optional<at::ScalarType>>> input_types;
+  inputs_map.insert({g->inputs()[0], {inputs[0]}});
+  input_types.insert({g->inputs()[0], {{at::kFloat}}});
+  inputs_map.insert({g->inputs()[1], {inputs[1]}});
+  input_types.insert({g->inputs()[1], {{at::kLong}}});
+
+  partitioning_info.collection_input_spec_map = inputs_map;
+  torch_tensorrt::core::partitioning::PartitioningCtx ctx(g->block(), partitioning_info);
+  ctx.input_types_map = input_types;
+  torch_tensorrt::core::partitioning::populateInputIValues(&ctx);
+  torch_tensorrt::core::partitioning::partition(&ctx);
+  auto segmented_blocks = ctx.partitioned_blocks.begin()->second;
+
+  // The engine takes the Long input without truncate_long_and_double and without a Torch cast in front of it
+  ASSERT_EQ(segmented_blocks[0].target(), torch_tensorrt::core::partitioning::SegmentedBlock::kTensorRT);
+  ASSERT_TRUE(checkInsertedCastNodeNumber(segmented_blocks[0], 1));
+  auto& engine_in_types = segmented_blocks[0].in_types();
+  ASSERT_TRUE(std::find(engine_in_types.begin(), engine_in_types.end(), at::kLong) != engine_in_types.end());
+}
+#endif
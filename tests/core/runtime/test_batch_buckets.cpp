@@ -0,0 +1,64 @@
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_relu_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+} // namespace
+
+TEST(Runtime, BatchBucketsAreSortedAndValidated) {
+  auto engine = build_relu_engine(at::randn({4, 16}, {at::kCUDA}));
+  engine->set_batch_buckets({4, 4});
+  ASSERT_EQ(engine->get_batch_buckets(), std::vector<int64_t>({4}));
+  ASSERT_EQ(engine->select_batch_bucket(1), 4);
+  ASSERT_EQ(engine->select_batch_bucket(4), 4);
+  ASSERT_EQ(engine->select_batch_bucket(5), 5);
+
+  // A static engine can only run its own batch size
+  ASSERT_ANY_THROW(engine->set_batch_buckets({8}));
+  ASSERT_ANY_THROW(engine->set_batch_buckets({0}));
+}
+
+TEST(Runtime, SmallerBatchesArePaddedToTheirBucket) {
+  auto engine = build_relu_engine(at::randn({4, 16}, {at::kCUDA}));
+  engine->set_batch_buckets({4});
+
+  for (int64_t batch : {3, 1, 4}) {
+    auto in = at::randn({batch, 16}, {at::kCUDA});
+    auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+    ASSERT_EQ(out.sizes(), in.sizes());
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  }
+  ASSERT_EQ(engine->get_runtime_metrics().at("padded_executions"), 2);
+
+  auto inferred = engine->infer_outputs({{3, 16}})[0];
+  ASSERT_EQ(inferred.sizes(), at::IntArrayRef({3, 16}));
+}
+
+TEST(Runtime, PaddedBatchesReplayTheBucketCudaGraph) {
+  auto engine = build_relu_engine(at::randn({4, 16}, {at::kCUDA}));
+  engine->set_batch_buckets({4});
+
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::SUBGRAPH_CUDAGRAPHS;
+  for (int64_t batch : {2, 3, 1}) {
+    auto in = at::randn({batch, 16}, {at::kCUDA});
+    auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  }
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::STANDARD;
+
+  auto stats = engine->get_cudagraph_cache_stats();
+  ASSERT_EQ(stats.at("misses"), 1);
+  ASSERT_EQ(stats.at("hits"), 2);
+}
@@ -0,0 +1,53 @@
+#include "core/runtime/BindingFormat.h"
+#include "gtest/gtest.h"
+#include "torch/torch.h"
+
+using torch_tensorrt::core::runtime::BindingFormat;
+
+namespace {
+BindingFormat hwc(int64_t components) {
+  BindingFormat format;
+  format.format = components == 1 ? nvinfer1::TensorFormat::kHWC : nvinfer1::TensorFormat::kHWC8;
+  format.channel_dim = 1;
+  format.components = components;
+  return format;
+}
+} // namespace
+
+TEST(Runtime, BindingFormatStridesPadTheChannels) {
+  using torch_tensorrt::core::runtime::format_strides;
+  ASSERT_EQ(format_strides({2, 3, 4, 5}, BindingFormat()), std::vector<int64_t>({60, 20, 5, 1}));
+  ASSERT_EQ(format_strides({2, 3, 4, 5}, hwc(1)), std::vector<int64_t>({60, 1, 15, 3}));
+  ASSERT_EQ(format_strides({2, 3, 4, 5}, hwc(8)), std::vector<int64_t>({160, 1, 40, 8}));
+  ASSERT_EQ(format_strides({2, 16, 4, 5}, hwc(8)), std::vector<int64_t>({320, 1, 80, 16}));
+}
+
+TEST(Runtime, BindingFormatChannelsLastMatchesTorch) {
+  auto t = at::randn({2, 3, 4, 5}, {at::kCUDA}).contiguous(at::MemoryFormat::ChannelsLast);
+  ASSERT_TRUE(torch_tensorrt::core::runtime::has_format(t, hwc(1)));
+  ASSERT_FALSE(torch_tensorrt::core::runtime::has_format(t, BindingFormat()));
+  ASSERT_EQ(torch_tensorrt::core::runtime::to_format(t, hwc(1)).data_ptr(), t.data_ptr());
+}
+
+TEST(Runtime, BindingFormatPaddedViewsRoundTrip) {
+  auto format = hwc(8);
+  auto t = at::randn({2, 3, 4, 5}, {at::kCUDA}).to(at::kHalf);
+  ASSERT_FALSE(torch_tensorrt::core::runtime::has_format(t, format));
+
+  auto formatted = torch_tensorrt::core::runtime::to_format(t, format);
+  ASSERT_TRUE(torch_tensorrt::core::runtime::has_format(formatted, format));
+  ASSERT_TRUE(at::equal(formatted, t));
+  // The storage holds the padded channels, which are zero
+  ASSERT_EQ(formatted.storage().nbytes(), 2 * 4 * 5 * 8 * formatted.element_size());
+  auto storage = at::empty({0}, formatted.options()).set_(formatted.storage()).view({2, 4, 5, 8});
+  ASSERT_TRUE(storage.narrow(3, 3, 5).eq(0).all().item<bool>());
+
+  // Tensors already in the format are passed through, views without the padded storage are not
+  ASSERT_EQ(torch_tensorrt::core::runtime::to_format(formatted, format).data_ptr(), formatted.data_ptr());
+  ASSERT_FALSE(torch_tensorrt::core::runtime::has_format(formatted.narrow(0, 1, 1).clone(), format));
+
+  auto copy = torch_tensorrt::core::runtime::clone_in_format(formatted, format);
+  ASSERT_NE(copy.data_ptr(), formatted.data_ptr());
+  ASSERT_TRUE(torch_tensorrt::core::runtime::has_format(copy, format));
+  ASSERT_TRUE(at::equal(copy.contiguous(), t));
+}
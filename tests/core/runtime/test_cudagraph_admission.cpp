@@ -0,0 +1,96 @@
+#include "core/runtime/CudaGraphAdmission.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+using torch_tensorrt::core::runtime::CudaGraphAdmission;
+using torch_tensorrt::core::runtime::ShapeKey;
+
+namespace {
+ShapeKey key(std::vector<int64_t> shape) {
+  return ShapeKey(std::vector<at::Tensor>{at::empty(shape)});
+}
+} // namespace
+
+TEST(Runtime, CudaGraphAdmissionAdmitsEveryShapeByDefault) {
+  CudaGraphAdmission admission;
+  ASSERT_TRUE(admission.admit(key({1, 3}), 1, 0));
+  ASSERT_TRUE(admission.admit(key({2, 3}), 0, 0));
+}
+
+TEST(Runtime, CudaGraphAdmissionAdmitsShapesSeenOftenEnough) {
+  CudaGraphAdmission admission;
+  ASSERT_FALSE(admission.admit(key({1, 3}), 3, 0));
+  ASSERT_FALSE(admission.admit(key({2, 3}), 3, 0));
+  ASSERT_FALSE(admission.admit(key({1, 3}), 3, 0));
+  ASSERT_TRUE(admission.admit(key({1, 3}), 3, 0));
+  // Counting starts over once a shape was admitted
+  ASSERT_FALSE(admission.admit(key({1, 3}), 3, 0));
+}
+
+TEST(Runtime, CudaGraphAdmissionOnlyCountsExecutionsWithinTheWindow) {
+  CudaGraphAdmission admission;
+  ASSERT_FALSE(admission.admit(key({1, 3}), 2, 4));
+  for (int i = 0; i < 4; i++) {
+    admission.tick();
+  }
+  // The first execution fell out of the window
+  ASSERT_FALSE(admission.admit(key({1, 3}), 2, 4));
+  admission.tick();
+  ASSERT_TRUE(admission.admit(key({1, 3}), 2, 4));
+}
+
+TEST(Runtime, RareShapesRunWithoutCudaGraphs) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::SUBGRAPH_CUDAGRAPHS;
+  torch_tensorrt::core::runtime::CUDAGRAPH_MIN_EXECUTIONS = 2;
+  std::vector<at::Tensor> outs;
+  for (int i = 0; i < 3; i++) {
+    outs.push_back(torch_tensorrt::core::runtime::execute_engine({in}, engine)[0]);
+  }
+  torch_tensorrt::core::runtime::CUDAGRAPH_MIN_EXECUTIONS = 1;
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::STANDARD;
+
+  for (auto& out : outs) {
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  }
+  // The first execution runs without a graph, the second captures one which the third replays
+  auto metrics = engine->get_runtime_metrics();
+  ASSERT_EQ(metrics.at("cudagraph_deferrals"), 1);
+  ASSERT_EQ(metrics.at("cudagraph_misses"), 1);
+  ASSERT_EQ(metrics.at("cudagraph_hits"), 1);
+}
+
+TEST(Runtime, NoCudaGraphsAreCapturedAboveTheMemoryCap) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::SUBGRAPH_CUDAGRAPHS;
+  torch_tensorrt::core::runtime::CUDAGRAPH_MAX_TOTAL_BYTES = 1;
+  auto other = torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+  // The first graph of the process is admitted and takes it over the cap
+  torch_tensorrt::core::runtime::execute_engine({in}, other);
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  torch_tensorrt::core::runtime::CUDAGRAPH_MAX_TOTAL_BYTES = 0;
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::STANDARD;
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  ASSERT_EQ(engine->get_runtime_metrics().at("cudagraph_deferrals"), 1);
+}
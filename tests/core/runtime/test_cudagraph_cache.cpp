@@ -0,0 +1,110 @@
+#include "core/runtime/CudaGraphCache.h"
+#include "gtest/gtest.h"
+
+using torch_tensorrt::core::runtime::CudaGraphCache;
+using torch_tensorrt::core::runtime::ShapeKey;
+
+namespace {
+ShapeKey key(std::vector<int64_t> shape) {
+  return ShapeKey(std::vector<at::Tensor>{at::empty(shape)});
+}
+} // namespace
+
+TEST(Runtime, CudaGraphCacheHitsAndMisses) {
+  CudaGraphCache cache;
+  ASSERT_EQ(cache.find(key({1, 3})), nullptr);
+  auto& entry = cache.emplace(key({1, 3}));
+  cache.commit(entry, 16, 8, 0);
+  ASSERT_EQ(cache.find(key({1, 3})), &entry);
+  ASSERT_EQ(cache.find(key({2, 3})), nullptr);
+
+  ASSERT_EQ(cache.hits, 1);
+  ASSERT_EQ(cache.misses, 2);
+  ASSERT_EQ(cache.num_entries, 1);
+  ASSERT_EQ(cache.total_bytes, 16);
+}
+
+TEST(Runtime, CudaGraphCacheEvictsLeastRecentlyUsedEntry) {
+  CudaGraphCache cache;
+  cache.commit(cache.emplace(key({1, 3})), 16, 2, 0);
+  cache.commit(cache.emplace(key({2, 3})), 16, 2, 0);
+  // Touch the first entry so the second becomes least recently used
+  ASSERT_NE(cache.find(key({1, 3})), nullptr);
+  cache.commit(cache.emplace(key({4, 3})), 16, 2, 0);
+
+  ASSERT_EQ(cache.num_entries, 2);
+  ASSERT_EQ(cache.evictions, 1);
+  ASSERT_NE(cache.find(key({1, 3})), nullptr);
+  ASSERT_EQ(cache.find(key({2, 3})), nullptr);
+  ASSERT_NE(cache.find(key({4, 3})), nullptr);
+}
+
+TEST(Runtime, CudaGraphCacheRespectsByteLimit) {
+  CudaGraphCache cache;
+  cache.commit(cache.emplace(key({1, 3})), 64, 0, 100);
+  cache.commit(cache.emplace(key({2, 3})), 64, 0, 100);
+  ASSERT_EQ(cache.num_entries, 1);
+  ASSERT_EQ(cache.total_bytes, 64);
+  ASSERT_NE(cache.find(key({2, 3})), nullptr);
+
+  // The entry being committed is never evicted even if it alone exceeds the limit
+  cache.commit(cache.emplace(key({8, 3})), 256, 0, 100);
+  ASSERT_EQ(cache.num_entries, 1);
+  ASSERT_NE(cache.find(key({8, 3})), nullptr);
+
+  cache.clear();
+  ASSERT_EQ(cache.num_entries, 0);
+  ASSERT_EQ(cache.total_bytes, 0);
+}
+
+TEST(Runtime, ShapeKeyDistinguishesRankAndInputBoundaries) {
+  ASSERT_EQ(key({2, 3}), key({2, 3}));
+  ASSERT_NE(key({2, 3}), key({3, 2}));
+  ASSERT_NE(key({2, 3}), key({2, 3, 1}));
+  ASSERT_NE(
+      ShapeKey(std::vector<at::Tensor>{at::empty({2}), at::empty({3})}),
+      ShapeKey(std::vector<at::Tensor>{at::empty({2, 3})}));
+  ASSERT_NE(ShapeKey(), ShapeKey(std::vector<at::Tensor>()));
+  ASSERT_EQ(ShapeKey(std::vector<at::Tensor>{at::empty({3, 4}), at::empty({4, 5})}).str(), "(3,4)(4,5)");
+}
+
+TEST(Runtime, ShapeKeyIncludesInputDtypesAndDevices) {
+  auto f32 = ShapeKey(std::vector<at::Tensor>{at::empty({2, 3})});
+  auto f16 = ShapeKey(std::vector<at::Tensor>{at::empty({2, 3}, at::kHalf)});
+  auto cuda = ShapeKey(std::vector<at::Tensor>{at::empty({2, 3}, {at::kCUDA})});
+  ASSERT_NE(f32, f16);
+  ASSERT_NE(f32, cuda);
+  ASSERT_EQ(cuda, ShapeKey(std::vector<at::Tensor>{at::empty({2, 3}, {at::kCUDA})}));
+  ASSERT_EQ(f16.str(), f32.str());
+}
+
+TEST(Runtime, ShapeKeyIncludesShapeTensorValues) {
+  std::vector<int64_t> a = {2, 8};
+  std::vector<int64_t> b = {2, 4};
+  auto with_a = key({2});
+  with_a.append_values(a.data(), a.size());
+  auto with_b = key({2});
+  with_b.append_values(b.data(), b.size());
+  auto with_a_again = key({2});
+  with_a_again.append_values(a.data(), a.size());
+
+  ASSERT_NE(with_a, key({2}));
+  ASSERT_NE(with_a, with_b);
+  ASSERT_EQ(with_a, with_a_again);
+  ASSERT_EQ(std::hash<ShapeKey>()(with_a), std::hash<ShapeKey>()(with_a_again));
+  ASSERT_EQ(with_a.str(), "(2)[2,8]");
+}
+
+TEST(Runtime, CudaGraphCacheBytesCountTowardsTheProcessTotal) {
+  auto before = CudaGraphCache::process_total_bytes();
+  {
+    CudaGraphCache cache;
+    cache.commit(cache.emplace(key({1, 3})), 16, 0, 0);
+    cache.commit(cache.emplace(key({2, 3})), 32, 0, 0);
+    ASSERT_EQ(CudaGraphCache::process_total_bytes(), before + 48);
+    cache.commit(cache.emplace(key({2, 3})), 8, 0, 0);
+    ASSERT_EQ(CudaGraphCache::process_total_bytes(), before + 24);
+  }
+  // Destroyed caches release their bytes
+  ASSERT_EQ(CudaGraphCache::process_total_bytes(), before);
+}
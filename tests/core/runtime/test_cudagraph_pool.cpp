@@ -0,0 +1,67 @@
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_engine(const std::string& graph, at::Tensor in) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+
+const auto relu_graph = R"IR(
+    graph(%0 : Tensor):
+      %1 : Tensor = aten::relu(%0)
+      return (%1))IR";
+const auto mm_graph = R"IR(
+    graph(%0 : Tensor):
+      %1 : Tensor = aten::matmul(%0, %0)
+      return (%1))IR";
+} // namespace
+
+TEST(Runtime, EnginesSharingCudaGraphPoolProduceCorrectResults) {
+  auto in = at::randn({64, 64}, {at::kCUDA});
+  auto relu_engine = build_engine(relu_graph, in);
+  auto mm_engine = build_engine(mm_graph, in);
+  mm_engine->share_cudagraph_pool(relu_engine);
+  ASSERT_NE(relu_engine->cudagraph_pool, nullptr);
+  ASSERT_EQ(relu_engine->cudagraph_pool, mm_engine->cudagraph_pool);
+
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::SUBGRAPH_CUDAGRAPHS;
+  for (int i = 0; i < 4; i++) {
+    auto x = at::randn({64, 64}, {at::kCUDA});
+    auto relu_out = torch_tensorrt::core::runtime::execute_engine({x}, relu_engine)[0];
+    auto mm_out = torch_tensorrt::core::runtime::execute_engine({relu_out}, mm_engine)[0];
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(mm_out, at::matmul(at::relu(x), at::relu(x))));
+  }
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::STANDARD;
+
+  // Each engine captured once, its buffers live in the shared region rather than in its cache
+  ASSERT_EQ(relu_engine->get_cudagraph_cache_stats().at("entries"), 1);
+  ASSERT_EQ(mm_engine->get_cudagraph_cache_stats().at("entries"), 1);
+  ASSERT_EQ(relu_engine->get_cudagraph_cache_stats().at("bytes"), 0);
+  ASSERT_EQ(mm_engine->get_cudagraph_cache_stats().at("bytes"), 0);
+  auto usage = relu_engine->get_memory_usage();
+  ASSERT_EQ(usage.at("shared_cudagraphs"), mm_engine->get_memory_usage().at("shared_cudagraphs"));
+  ASSERT_GE(usage.at("shared_cudagraphs"), 2 * 64 * 64 * 4);
+}
+
+TEST(Runtime, GraphsCapturedBeforeTheSharedRegionGrowsAreRecaptured) {
+  auto small = at::randn({16, 16}, {at::kCUDA});
+  auto large = at::randn({64, 64}, {at::kCUDA});
+  auto small_engine = build_engine(relu_graph, small);
+  auto large_engine = build_engine(relu_graph, large);
+  large_engine->share_cudagraph_pool(small_engine);
+
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::SUBGRAPH_CUDAGRAPHS;
+  torch_tensorrt::core::runtime::execute_engine({small}, small_engine);
+  // Grows the region the graph of small_engine was captured against
+  torch_tensorrt::core::runtime::execute_engine({large}, large_engine);
+  auto out = torch_tensorrt::core::runtime::execute_engine({small}, small_engine)[0];
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::STANDARD;
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(small)));
+  ASSERT_EQ(small_engine->get_runtime_metrics().at("cudagraph_recaptures"), 1);
+}
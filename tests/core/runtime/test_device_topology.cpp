@@ -0,0 +1,33 @@
+#include "c10/cuda/CUDAFunctions.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+
+using torch_tensorrt::core::runtime::DeviceTopology;
+
+TEST(Runtime, DeviceTopologyCoversEveryDevice) {
+  const auto& topology = DeviceTopology::get();
+  ASSERT_EQ(topology.num_devices(), static_cast<int64_t>(c10::cuda::device_count()));
+  for (int64_t from = 0; from < topology.num_devices(); from++) {
+    ASSERT_EQ(topology.link(from, from), torch_tensorrt::core::runtime::SAME_DEVICE);
+    ASSERT_TRUE(topology.is_local(from, topology.numa_node(from)));
+    for (int64_t to = 0; to < topology.num_devices(); to++) {
+      ASSERT_EQ(topology.can_access_peer(from, to), topology.can_access_peer(to, from));
+    }
+  }
+  // Devices the process does not see are as far as can be
+  ASSERT_EQ(topology.link(0, topology.num_devices()), torch_tensorrt::core::runtime::HOST_CROSS_NUMA_NODE);
+  ASSERT_EQ(topology.numa_node(-1), -1);
+}
+
+TEST(Runtime, NUMALocalHostBuffersArePinned) {
+  torch_tensorrt::core::runtime::NUMA_LOCAL_HOST_STAGING = true;
+  auto buffer = torch_tensorrt::core::runtime::empty_pinned_host_buffer(1 << 20, 0);
+  torch_tensorrt::core::runtime::NUMA_LOCAL_HOST_STAGING = false;
+  ASSERT_EQ(buffer.nbytes(), 1u << 20);
+  ASSERT_FALSE(buffer.is_cuda());
+  ASSERT_TRUE(buffer.is_pinned());
+
+  auto device = at::arange(1 << 20, {at::kCUDA}).to(at::kByte);
+  buffer.copy_(device);
+  ASSERT_TRUE(buffer.equal(device.cpu()));
+}
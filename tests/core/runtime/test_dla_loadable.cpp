@@ -0,0 +1,56 @@
+#include "core/runtime/CudlaLoadable.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_relu_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+} // namespace
+
+TEST(Runtime, DLALoadablesAreToldApartFromTensorRTEngines) {
+  auto engine = build_relu_engine(at::randn({4, 16}, {at::kCUDA}));
+  auto plan = engine->get_serialized_engine();
+  ASSERT_FALSE(torch_tensorrt::core::runtime::is_dla_loadable(plan.data(), plan.size()));
+
+  std::string loadable = "not a TensorRT plan";
+  auto wrapped = torch_tensorrt::core::runtime::wrap_dla_loadable(loadable.data(), loadable.size());
+  ASSERT_TRUE(torch_tensorrt::core::runtime::is_dla_loadable(wrapped.data(), wrapped.size()));
+  ASSERT_EQ(wrapped.substr(torch_tensorrt::core::runtime::DLA_LOADABLE_MAGIC.size()), loadable);
+  ASSERT_FALSE(torch_tensorrt::core::runtime::is_dla_loadable(wrapped.data(), 4));
+}
+
+TEST(Runtime, DLALoadableIsSavedAsLoadedAndNeedsADLACore) {
+  std::string loadable = "not a TensorRT plan";
+  auto wrapped = torch_tensorrt::core::runtime::wrap_dla_loadable(loadable.data(), loadable.size());
+  auto engine = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(
+      "dla_loadable",
+      torch_tensorrt::core::util::SerializedEngine(wrapped),
+      torch_tensorrt::core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU),
+      std::vector<std::string>{"input_0"},
+      std::vector<std::string>{"output_0"},
+      torch_tensorrt::core::runtime::get_current_platform(),
+      false,
+      "",
+      /*lazy_deserialization=*/true);
+
+  // Deferred loadables are saved without being loaded
+  auto serialized_info = engine->serialize();
+  ASSERT_EQ(
+      torch_tensorrt::core::runtime::base64_decode(serialized_info[torch_tensorrt::core::runtime::ENGINE_IDX]),
+      wrapped);
+
+  // Loadables run on the DLA core they were built for, never on the GPU
+  ASSERT_ANY_THROW(engine->warmup());
+  ASSERT_FALSE(engine->is_engine_loaded());
+}
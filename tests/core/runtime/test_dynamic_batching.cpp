@@ -0,0 +1,86 @@
+#include <thread>
+
+#include "core/conversion/conversion.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_dynamic_relu_engine() {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+
+  auto spec = torch_tensorrt::core::ir::Input({1, 16}, {8, 16}, {16, 16});
+  std::vector<const torch::jit::Value*> var_ins = {g->inputs()[0]};
+  auto info = torch_tensorrt::core::conversion::ConversionInfo();
+  info.inputs = torch_tensorrt::core::ir::pair_input_vals_with_specs(var_ins, {spec});
+  auto eng = torch_tensorrt::core::conversion::ConvertBlockToEngine(g->block(), info, params);
+
+  auto cuda_device = torch_tensorrt::core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU);
+  return c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(
+      "test_engine", eng, cuda_device, std::vector<std::string>(), std::vector<std::string>());
+}
+} // namespace
+
+TEST(Runtime, DynamicBatchingDefaultsToTheProfileMaxBatchSize) {
+  auto engine = build_dynamic_relu_engine();
+  ASSERT_EQ(engine->get_dynamic_batching_window_us(), 0);
+  engine->set_dynamic_batching_window_us(100);
+  ASSERT_EQ(engine->get_dynamic_batching_window_us(), 100);
+  ASSERT_EQ(engine->dynamic_batcher->max_batch_size, 16);
+  engine->set_dynamic_batching_max_batch_size(4);
+  ASSERT_EQ(engine->dynamic_batcher->max_batch_size, 4);
+  engine->set_dynamic_batching_window_us(0);
+  ASSERT_EQ(engine->dynamic_batcher, nullptr);
+}
+
+TEST(Runtime, ConcurrentCallersAreBatchedTogether) {
+  auto engine = build_dynamic_relu_engine();
+  // The batch is dispatched as soon as it is full, the window only bounds how long the first caller waits
+  engine->set_dynamic_batching_max_batch_size(8);
+  engine->set_dynamic_batching_window_us(200000);
+
+  const int64_t num_callers = 8;
+  std::vector<at::Tensor> inputs;
+  for (int64_t i = 0; i < num_callers; i++) {
+    inputs.push_back(at::randn({1, 16}, {at::kCUDA}));
+  }
+  std::vector<at::Tensor> outputs(num_callers);
+  std::vector<std::thread> callers;
+  for (int64_t i = 0; i < num_callers; i++) {
+    callers.emplace_back(
+        [&, i]() { outputs[i] = torch_tensorrt::core::runtime::execute_engine({inputs[i]}, engine)[0]; });
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+
+  for (int64_t i = 0; i < num_callers; i++) {
+    ASSERT_EQ(outputs[i].sizes(), inputs[i].sizes());
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(outputs[i], at::relu(inputs[i])));
+  }
+  auto metrics = engine->get_runtime_metrics();
+  ASSERT_EQ(metrics.at("dynamic_batches"), 1);
+  ASSERT_EQ(metrics.at("dynamic_batched_requests"), num_callers);
+  ASSERT_EQ(metrics.at("executions"), 1);
+}
+
+TEST(Runtime, RequestsLargerThanTheMaxBatchSizeRunDirectly) {
+  auto engine = build_dynamic_relu_engine();
+  engine->set_dynamic_batching_max_batch_size(8);
+  engine->set_dynamic_batching_window_us(100);
+
+  auto in = at::randn({12, 16}, {at::kCUDA});
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  auto metrics = engine->get_runtime_metrics();
+  ASSERT_EQ(metrics.at("dynamic_batches"), 0);
+  ASSERT_EQ(metrics.at("executions"), 1);
+}
@@ -0,0 +1,105 @@
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_relu_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+
+// Serialized info as unpickled, with the engine (or bundle) bytes at ENGINE_IDX
+std::vector<std::string> unpickled_info(const c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine>& engine) {
+  auto state = engine->serialize_state();
+  auto info = std::get<0>(state);
+  auto blob = std::get<1>(state).contiguous();
+  info[torch_tensorrt::core::runtime::ENGINE_IDX] =
+      std::string(static_cast<const char*>(blob.data_ptr()), blob.numel());
+  return info;
+}
+
+// Variant no device can run
+torch_tensorrt::core::runtime::EngineBundleVariant foreign_variant(
+    const c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine>& engine) {
+  torch_tensorrt::core::runtime::EngineBundleVariant v;
+  v.device = engine->device_info;
+  v.device.major = 1;
+  v.device.minor = 0;
+  v.device.device_name = "Foreign GPU";
+  v.serialized_engine = "not an engine";
+  return v;
+}
+} // namespace
+
+TEST(Runtime, EngineBundleRoundTrips) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_relu_engine(in);
+  auto foreign = foreign_variant(engine);
+  auto variants = std::vector<torch_tensorrt::core::runtime::EngineBundleVariant>{foreign};
+  variants.push_back(engine->get_bundle_variants()[0]);
+
+  auto bundle = torch_tensorrt::core::runtime::serialize_engine_bundle(variants);
+  ASSERT_TRUE(torch_tensorrt::core::runtime::is_engine_bundle(bundle));
+  auto read = torch_tensorrt::core::runtime::deserialize_engine_bundle(bundle);
+  ASSERT_EQ(read.size(), 2);
+  ASSERT_EQ(read[0].device.getSMCapability(), "1.0");
+  ASSERT_EQ(read[0].serialized_engine, foreign.serialized_engine);
+  ASSERT_EQ(read[1].serialized_engine, variants[1].serialized_engine);
+  ASSERT_EQ(torch_tensorrt::core::runtime::select_engine_bundle_variant(read).value(), 1);
+
+  auto headers = torch_tensorrt::core::runtime::deserialize_engine_bundle(bundle, /*with_engines=*/false);
+  ASSERT_EQ(headers.size(), 2);
+  ASSERT_TRUE(headers[1].serialized_engine.empty());
+}
+
+TEST(Runtime, BundledEngineLoadsTheVariantOfTheCurrentDevice) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_relu_engine(in);
+  engine->add_bundle_variants({foreign_variant(engine)});
+  ASSERT_EQ(engine->get_bundle_variants().size(), 2);
+  // A variant for an SM already bundled is skipped
+  engine->add_bundle_variants({foreign_variant(engine)});
+  ASSERT_EQ(engine->get_bundle_variants().size(), 2);
+
+  auto info = unpickled_info(engine);
+  ASSERT_TRUE(torch_tensorrt::core::runtime::is_engine_bundle(info[torch_tensorrt::core::runtime::ENGINE_IDX]));
+  auto loaded = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(info);
+  ASSERT_EQ(loaded->device_info.getSMCapability(), engine->device_info.getSMCapability());
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, loaded)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+
+  // Saving the loaded engine keeps every variant
+  ASSERT_EQ(loaded->get_bundle_variants().size(), 2);
+  ASSERT_EQ(
+      unpickled_info(loaded)[torch_tensorrt::core::runtime::ENGINE_IDX],
+      info[torch_tensorrt::core::runtime::ENGINE_IDX]);
+}
+
+TEST(Runtime, BundleWithoutCompatibleVariantCanOnlyBeLoadedForBundling) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_relu_engine(in);
+  auto info = unpickled_info(engine);
+  info[torch_tensorrt::core::runtime::ENGINE_IDX] =
+      torch_tensorrt::core::runtime::serialize_engine_bundle({foreign_variant(engine)});
+  EXPECT_THROW(c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(info), c10::Error);
+
+  torch_tensorrt::core::runtime::LOAD_INCOMPATIBLE_ENGINES = true;
+  auto loaded = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(info);
+  torch_tensorrt::core::runtime::LOAD_INCOMPATIBLE_ENGINES = false;
+  ASSERT_FALSE(loaded->is_engine_loaded());
+  EXPECT_THROW(torch_tensorrt::core::runtime::execute_engine({in}, loaded), c10::Error);
+
+  // The engine of this device can still be bundled into it
+  loaded->add_bundle_variants(engine->get_bundle_variants());
+  auto bundled = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(unpickled_info(loaded));
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, bundled)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+}
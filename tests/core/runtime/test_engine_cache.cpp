@@ -0,0 +1,159 @@
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <thread>
+
+#include "core/conversion/conversion.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+std::string temp_cache_dir() {
+  auto dir = std::filesystem::temp_directory_path() / ("torchtrt_engine_cache_" + std::to_string(std::random_device{}()));
+  std::filesystem::remove_all(dir);
+  return dir.string();
+}
+
+size_t num_cached_engines(const std::string& dir) {
+  size_t n = 0;
+  for (const auto& f : std::filesystem::directory_iterator(dir)) {
+    n += f.path().extension() == ".engine";
+  }
+  return n;
+}
+
+struct ReluGraph {
+  std::shared_ptr<torch::jit::Graph> g = std::make_shared<torch::jit::Graph>();
+  torch_tensorrt::core::ir::StaticParams params;
+  torch_tensorrt::core::conversion::ConversionInfo info;
+
+  ReluGraph(const std::string& ir, std::vector<int64_t> shape) {
+    torch::jit::parseIR(ir, g.get());
+    params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+    std::vector<const torch::jit::Value*> var_ins = {g->inputs()[0]};
+    info.inputs =
+        torch_tensorrt::core::ir::pair_input_vals_with_specs(var_ins, {torch_tensorrt::core::ir::Input(shape)});
+  }
+
+  std::string key() {
+    return torch_tensorrt::core::conversion::EngineCacheKey(
+        g->block(), info.engine_settings, info.inputs, info.collection_input_spec_map, params);
+  }
+};
+
+const auto relu_graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+} // namespace
+
+TEST(Runtime, EngineCacheKeyIgnoresValueNames) {
+  const auto renamed_graph = R"IR(
+      graph(%x.1 : Tensor):
+        %out : Tensor = aten::relu(%x.1)
+        return (%out))IR";
+
+  ReluGraph a(relu_graph, {4, 16});
+  ReluGraph b(renamed_graph, {4, 16});
+  ASSERT_EQ(a.key(), b.key());
+}
+
+TEST(Runtime, EngineCacheKeyDependsOnInputsAndSettings) {
+  ReluGraph a(relu_graph, {4, 16});
+  ReluGraph b(relu_graph, {8, 16});
+  ASSERT_NE(a.key(), b.key());
+
+  ReluGraph c(relu_graph, {4, 16});
+  c.info.engine_settings.enabled_precisions.insert(nvinfer1::DataType::kHALF);
+  ASSERT_NE(a.key(), c.key());
+
+  ReluGraph e(relu_graph, {4, 16});
+  e.info.engine_settings.fast_build = true;
+  ASSERT_NE(a.key(), e.key());
+
+  // The timing cache does not change the engine
+  ReluGraph d(relu_graph, {4, 16});
+  d.info.engine_settings.timing_cache_path = "timing.cache";
+  ASSERT_EQ(a.key(), d.key());
+}
+
+TEST(Runtime, DiskEngineCacheEvictsLeastRecentlyUsedEngines) {
+  auto dir = temp_cache_dir();
+  torch_tensorrt::core::conversion::DiskEngineCache cache(dir, 10);
+  ASSERT_FALSE(cache.load("a").has_value());
+
+  cache.save("a", std::string("aaaa"));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  cache.save("b", std::string("bbbb"));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_EQ(cache.load("a").value().str(), "aaaa");
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  cache.save("c", std::string("cccc"));
+
+  ASSERT_TRUE(cache.load("a").has_value());
+  ASSERT_FALSE(cache.load("b").has_value());
+  ASSERT_TRUE(cache.load("c").has_value());
+
+  // Engines larger than the cache are not stored
+  cache.save("d", std::string("ddddddddddddd"));
+  ASSERT_FALSE(cache.load("d").has_value());
+  std::filesystem::remove_all(dir);
+}
+
+TEST(Runtime, ConvertBlockToEngineReusesCachedEngines) {
+  auto dir = temp_cache_dir();
+  auto cache = std::make_shared<torch_tensorrt::core::conversion::DiskEngineCache>(dir, 1ull << 30);
+
+  ReluGraph a(relu_graph, {4, 16});
+  a.info.engine_cache = cache;
+  auto built = torch_tensorrt::core::conversion::ConvertBlockToEngine(a.g->block(), a.info, a.params);
+  ASSERT_EQ(num_cached_engines(dir), 1);
+
+  ReluGraph b(relu_graph, {4, 16});
+  b.info.engine_cache = cache;
+  auto reused = torch_tensorrt::core::conversion::ConvertBlockToEngine(b.g->block(), b.info, b.params);
+  ASSERT_TRUE(reused == built);
+  ASSERT_EQ(num_cached_engines(dir), 1);
+
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(
+      "cached_engine",
+      reused,
+      torch_tensorrt::core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU),
+      std::vector<std::string>(),
+      std::vector<std::string>());
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  std::filesystem::remove_all(dir);
+}
+
+TEST(Runtime, MemoryEngineCacheServesHeldEnginesBeforeBackingCache) {
+  auto dir = temp_cache_dir();
+  auto backing = std::make_shared<torch_tensorrt::core::conversion::DiskEngineCache>(dir, 1ull << 30);
+  backing->save("b", std::string("bbbb"));
+
+  ReluGraph a(relu_graph, {4, 16});
+  auto cache = std::make_shared<torch_tensorrt::core::conversion::MemoryEngineCache>(
+      std::unordered_map<std::string, torch_tensorrt::core::util::SerializedEngine>{
+          {a.key(), std::string("previous plan")}},
+      backing);
+  ASSERT_EQ(cache->load("b").value().str(), "bbbb");
+  ASSERT_FALSE(cache->load("c").has_value());
+  ASSERT_EQ(cache->num_hits(), 0);
+
+  // Blocks matching a held engine are not rebuilt
+  a.info.engine_cache = cache;
+  auto engine = torch_tensorrt::core::conversion::ConvertBlockToEngine(a.g->block(), a.info, a.params, a.key());
+  ASSERT_EQ(engine.str(), "previous plan");
+  ASSERT_EQ(cache->num_hits(), 1);
+
+  // New engines go to the backing cache only
+  ReluGraph b(relu_graph, {8, 16});
+  b.info.engine_cache = cache;
+  torch_tensorrt::core::conversion::ConvertBlockToEngine(b.g->block(), b.info, b.params);
+  ASSERT_EQ(num_cached_engines(dir), 2);
+  ASSERT_EQ(cache->size(), 1);
+  std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,60 @@
+#include "core/runtime/EngineCompression.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_relu_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+} // namespace
+
+TEST(Runtime, CompressedEnginePayloadRoundTripsAcrossChunks) {
+  // Spans several chunks, the last one partial
+  std::string engine(2 * torch_tensorrt::core::runtime::COMPRESSED_ENGINE_CHUNK_SIZE + 12345, '\0');
+  for (size_t i = 0; i < engine.size(); i++) {
+    engine[i] = static_cast<char>((i / 64) % 7);
+  }
+  auto payload = torch_tensorrt::core::runtime::compress_engine(engine.data(), engine.size(), 3, 2);
+  ASSERT_TRUE(torch_tensorrt::core::runtime::is_compressed_engine(payload));
+  ASSERT_FALSE(torch_tensorrt::core::runtime::is_compressed_engine(engine));
+  ASSERT_LT(payload.size(), engine.size() / 10);
+  ASSERT_EQ(torch_tensorrt::core::runtime::decompress_engine(payload), engine);
+
+  // Truncated payloads are rejected instead of producing a partial engine
+  ASSERT_ANY_THROW(torch_tensorrt::core::runtime::decompress_engine(payload.substr(0, payload.size() - 1)));
+}
+
+TEST(Runtime, CompressedEmbeddedEngineLoadsTransparently) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_relu_engine(in);
+
+  torch_tensorrt::core::runtime::ENGINE_COMPRESSION_LEVEL = 3;
+  auto serialized_info = engine->serialize();
+  auto state = engine->serialize_state();
+  torch_tensorrt::core::runtime::ENGINE_COMPRESSION_LEVEL = 0;
+
+  auto& embedded = serialized_info[torch_tensorrt::core::runtime::ENGINE_IDX];
+  embedded = torch_tensorrt::core::runtime::base64_decode(embedded);
+  ASSERT_TRUE(torch_tensorrt::core::runtime::is_compressed_engine(embedded));
+  auto blob = std::get<1>(state);
+  ASSERT_TRUE(torch_tensorrt::core::runtime::is_compressed_engine(blob.data_ptr(), blob.numel()));
+
+  auto loaded = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(serialized_info);
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, loaded)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+
+  // Saving again without compression stores the plain engine
+  auto plain =
+      torch_tensorrt::core::runtime::base64_decode(loaded->serialize()[torch_tensorrt::core::runtime::ENGINE_IDX]);
+  ASSERT_FALSE(torch_tensorrt::core::runtime::is_compressed_engine(plain));
+}
@@ -0,0 +1,55 @@
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+std::vector<std::string> serialized_relu_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto engine = torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+  auto serialized_info = engine->serialize();
+  serialized_info[torch_tensorrt::core::runtime::ENGINE_IDX] =
+      torch_tensorrt::core::runtime::base64_decode(serialized_info[torch_tensorrt::core::runtime::ENGINE_IDX]);
+  return serialized_info;
+}
+} // namespace
+
+TEST(Runtime, IdenticalEnginesShareOneCudaEngine) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto serialized_info = serialized_relu_engine(in);
+
+  torch_tensorrt::core::runtime::DEDUPLICATE_ENGINES = true;
+  auto a = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(serialized_info);
+  auto b = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(serialized_info);
+  torch_tensorrt::core::runtime::DEDUPLICATE_ENGINES = false;
+
+  ASSERT_EQ(a->cuda_engine.get(), b->cuda_engine.get());
+  // Each instance still has its own execution context
+  ASSERT_NE(a->primary_exec_ctx(), b->primary_exec_ctx());
+
+  auto out_a = torch_tensorrt::core::runtime::execute_engine({in}, a)[0];
+  auto out_b = torch_tensorrt::core::runtime::execute_engine({in}, b)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out_a, at::relu(in)));
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out_b, at::relu(in)));
+
+  // The shared engine outlives the instance which deserialized it
+  a.reset();
+  out_b = torch_tensorrt::core::runtime::execute_engine({in}, b)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out_b, at::relu(in)));
+}
+
+TEST(Runtime, EnginesAreNotDeduplicatedByDefault) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto serialized_info = serialized_relu_engine(in);
+
+  auto a = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(serialized_info);
+  auto b = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(serialized_info);
+  ASSERT_NE(a->cuda_engine.get(), b->cuda_engine.get());
+}
@@ -0,0 +1,92 @@
+#include "core/runtime/EngineEnsemble.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_engine(const std::string& graph, at::Tensor in) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+
+// Three members: relu(x), (x * x, x) and neg(x)
+c10::intrusive_ptr<torch_tensorrt::core::runtime::EngineEnsemble> build_ensemble(at::Tensor in) {
+  const auto relu_graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+  const auto square_graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::mul(%0, %0)
+        return (%1, %0))IR";
+  const auto neg_graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::neg(%0)
+        return (%1))IR";
+  return c10::make_intrusive<torch_tensorrt::core::runtime::EngineEnsemble>(
+      std::vector<c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine>>(
+          {build_engine(relu_graph, in), build_engine(square_graph, in), build_engine(neg_graph, in)}));
+}
+
+void expect_outputs(const std::vector<at::Tensor>& out, const at::Tensor& in) {
+  ASSERT_EQ(out.size(), 4);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out[0], at::relu(in)));
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out[1], in * in));
+  ASSERT_TRUE(torch_tensorrt::tests::util::exactlyEqual(out[2], in));
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out[3], at::neg(in)));
+}
+} // namespace
+
+TEST(Runtime, EngineEnsemblesRunTheirMembersOnTheSameInputs) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto ensemble = build_ensemble(in);
+  auto out = torch_tensorrt::core::runtime::execute_ensemble({in}, ensemble);
+  expect_outputs(out, in);
+  // The outputs of the members share one arena
+  ASSERT_TRUE(out[0].storage().is_alias_of(out[3].storage()));
+
+  // Host inputs are moved to the device once for all members
+  auto host_in = at::randn({4, 16});
+  expect_outputs(torch_tensorrt::core::runtime::execute_ensemble({host_in}, ensemble), host_in.cuda());
+}
+
+TEST(Runtime, EngineEnsemblesReplayOneCUDAGraph) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto ensemble = build_ensemble(in);
+  ensemble->use_cudagraph = true;
+  // Warmup, capture and replays
+  std::vector<at::Tensor> previous;
+  for (int i = 0; i < 4; i++) {
+    auto x = at::randn({4, 16}, {at::kCUDA});
+    auto out = torch_tensorrt::core::runtime::execute_ensemble({x}, ensemble);
+    expect_outputs(out, x);
+    // Outputs returned by earlier replays are not overwritten
+    if (!previous.empty()) {
+      ASSERT_FALSE(out[0].storage().is_alias_of(previous[0].storage()));
+    }
+    previous = out;
+  }
+}
+
+TEST(Runtime, EngineEnsemblesNeedMembersTakingTheSameInputs) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  const auto add_graph = R"IR(
+      graph(%x : Tensor, %y : Tensor):
+        %one : int = prim::Constant[value=1]()
+        %z : Tensor = aten::add(%x, %y, %one)
+        return (%z))IR";
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(add_graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto add = torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in, in});
+  const auto relu_graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+  std::vector<c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine>> engines = {
+      build_engine(relu_graph, in), add};
+  ASSERT_THROW(c10::make_intrusive<torch_tensorrt::core::runtime::EngineEnsemble>(engines), c10::Error);
+}
@@ -0,0 +1,91 @@
+#include "core/conversion/conversion.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_engine(
+    const std::string& graph,
+    size_t num_inputs = 1) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+
+  std::vector<const torch::jit::Value*> var_ins;
+  std::vector<torch_tensorrt::core::ir::Input> specs;
+  for (size_t i = 0; i < num_inputs; i++) {
+    var_ins.push_back(g->inputs()[i]);
+    specs.push_back(torch_tensorrt::core::ir::Input({1, 16}, {8, 16}, {16, 16}));
+  }
+  auto info = torch_tensorrt::core::conversion::ConversionInfo();
+  info.inputs = torch_tensorrt::core::ir::pair_input_vals_with_specs(var_ins, specs);
+  auto eng = torch_tensorrt::core::conversion::ConvertBlockToEngine(g->block(), info, params);
+
+  auto cuda_device = torch_tensorrt::core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU);
+  return c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(
+      "test_engine", eng, cuda_device, std::vector<std::string>(), std::vector<std::string>());
+}
+
+const std::string relu_graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+const std::string sigmoid_graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::sigmoid(%0)
+        return (%1))IR";
+} // namespace
+
+TEST(Runtime, SwappedEngineRunsTheReplacementAndSwapsBack) {
+  auto engine = build_engine(relu_graph);
+  auto replacement = build_engine(sigmoid_graph);
+  engine->set_execution_context_pool_size(2);
+  auto in = at::randn({8, 16}, {at::kCUDA});
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+
+  engine->swap_engine(replacement);
+  out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::sigmoid(in)));
+  out = torch_tensorrt::core::runtime::execute_engine({in}, replacement)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  // Runtime settings stay with the engine
+  ASSERT_EQ(engine->get_execution_context_pool_size(), 2);
+  ASSERT_EQ(replacement->get_execution_context_pool_size(), 1);
+
+  engine->swap_engine(replacement);
+  out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+}
+
+TEST(Runtime, SwappedEngineRecapturesCudaGraphs) {
+  auto engine = build_engine(relu_graph);
+  auto replacement = build_engine(sigmoid_graph);
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::SUBGRAPH_CUDAGRAPHS;
+  auto in = at::randn({8, 16}, {at::kCUDA});
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+
+  engine->swap_engine(replacement);
+  out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::STANDARD;
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::sigmoid(in)));
+}
+
+TEST(Runtime, EnginesWithOtherBindingsCannotBeSwapped) {
+  const auto add_graph = R"IR(
+      graph(%0 : Tensor, %1 : Tensor):
+        %2 : int = prim::Constant[value=1]()
+        %3 : Tensor = aten::add(%0, %1, %2)
+        return (%3))IR";
+  auto engine = build_engine(relu_graph);
+  auto replacement = build_engine(add_graph, 2);
+  ASSERT_ANY_THROW(engine->swap_engine(replacement));
+  ASSERT_ANY_THROW(engine->swap_engine(engine));
+
+  auto in = at::randn({8, 16}, {at::kCUDA});
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+}
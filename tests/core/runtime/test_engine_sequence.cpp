@@ -0,0 +1,74 @@
+#include "core/runtime/EngineSequence.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_engine(
+    const std::string& graph,
+    const std::vector<at::Tensor>& inputs) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, inputs);
+}
+
+const auto relu_graph = R"IR(
+    graph(%0 : Tensor):
+      %1 : Tensor = aten::relu(%0)
+      return (%1))IR";
+
+const auto add_graph = R"IR(
+    graph(%x : Tensor, %y : Tensor):
+      %one : int = prim::Constant[value=1]()
+      %z : Tensor = aten::add(%x, %y, %one)
+      return (%z))IR";
+
+// relu(x) + y, then relu of the sum. Values: 0 x, 1 y, 2 relu(x), 3 relu(x) + y, 4 relu(relu(x) + y)
+c10::intrusive_ptr<torch_tensorrt::core::runtime::EngineSequence> build_sequence() {
+  auto x = at::randn({4, 16}, {at::kCUDA});
+  auto relu = build_engine(relu_graph, {x});
+  auto add = build_engine(add_graph, {x, x});
+  return c10::make_intrusive<torch_tensorrt::core::runtime::EngineSequence>(
+      2,
+      std::vector<c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine>>{relu, add, relu},
+      std::vector<std::vector<int64_t>>{{0}, {2, 1}, {3}},
+      std::vector<int64_t>{4, 2});
+}
+} // namespace
+
+TEST(Runtime, EngineSequencesRunTheirEnginesInOneCall) {
+  auto sequence = build_sequence();
+  auto x = at::randn({4, 16}, {at::kCUDA});
+  auto y = at::randn({4, 16}, {at::kCUDA});
+  auto out = torch_tensorrt::core::runtime::execute_engines({x, y}, sequence);
+  ASSERT_EQ(out.size(), 2);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out[0], at::relu(at::relu(x) + y)));
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out[1], at::relu(x)));
+}
+
+TEST(Runtime, EngineSequencesReplayOneCUDAGraph) {
+  auto sequence = build_sequence();
+  sequence->use_cudagraph = true;
+  // Warmup, capture and replays
+  for (int i = 0; i < 4; i++) {
+    auto x = at::randn({4, 16}, {at::kCUDA});
+    auto y = at::randn({4, 16}, {at::kCUDA});
+    auto out = torch_tensorrt::core::runtime::execute_engines({x, y}, sequence);
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out[0], at::relu(at::relu(x) + y)));
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out[1], at::relu(x)));
+  }
+}
+
+TEST(Runtime, EngineSequencesRejectInvalidWiring) {
+  auto x = at::randn({4, 16}, {at::kCUDA});
+  auto relu = build_engine(relu_graph, {x});
+  using Engines = std::vector<c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine>>;
+  // Engine input produced after the engine
+  ASSERT_ANY_THROW(torch_tensorrt::core::runtime::EngineSequence(1, Engines{relu, relu}, {{2}, {0}}, {2}));
+  // Wrong number of engine inputs
+  ASSERT_ANY_THROW(torch_tensorrt::core::runtime::EngineSequence(2, Engines{relu}, {{0, 1}}, {2}));
+  // Output which is not a value
+  ASSERT_ANY_THROW(torch_tensorrt::core::runtime::EngineSequence(1, Engines{relu}, {{0}}, {2}));
+}
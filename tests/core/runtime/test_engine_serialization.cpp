@@ -0,0 +1,72 @@
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+TEST(Runtime, Base64MatchesReferenceEncoding) {
+  ASSERT_EQ(torch_tensorrt::core::runtime::base64_encode(""), "");
+  ASSERT_EQ(torch_tensorrt::core::runtime::base64_encode("f"), "Zg==");
+  ASSERT_EQ(torch_tensorrt::core::runtime::base64_encode("fo"), "Zm8=");
+  ASSERT_EQ(torch_tensorrt::core::runtime::base64_encode("foo"), "Zm9v");
+  ASSERT_EQ(torch_tensorrt::core::runtime::base64_encode("foobar"), "Zm9vYmFy");
+  ASSERT_EQ(torch_tensorrt::core::runtime::base64_decode("Zg=="), "f");
+  ASSERT_EQ(torch_tensorrt::core::runtime::base64_decode("Zm8="), "fo");
+  ASSERT_EQ(torch_tensorrt::core::runtime::base64_decode("Zm9vYmFy"), "foobar");
+}
+
+TEST(Runtime, Base64RoundTripsBinaryData) {
+  for (int64_t len = 0; len < 64; len++) {
+    auto bytes = at::randint(256, {len}, at::TensorOptions().dtype(at::kByte));
+    std::string in(static_cast<const char*>(bytes.data_ptr()), len);
+    auto encoded = torch_tensorrt::core::runtime::base64_encode(in);
+    ASSERT_EQ(encoded.size() % 4, 0);
+    ASSERT_EQ(torch_tensorrt::core::runtime::base64_decode(encoded), in);
+  }
+}
+
+TEST(Runtime, SerializedStateStoresEngineAsBytes) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto engine = torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+
+  auto [serialized_info, engine_blob] = engine->serialize_state();
+  ASSERT_EQ(serialized_info[torch_tensorrt::core::runtime::ABI_TARGET_IDX], torch_tensorrt::core::runtime::ABI_VERSION);
+  ASSERT_TRUE(serialized_info[torch_tensorrt::core::runtime::ENGINE_IDX].empty());
+  ASSERT_EQ(engine_blob.scalar_type(), at::kByte);
+
+  std::string raw_engine(static_cast<const char*>(engine_blob.data_ptr()), engine_blob.numel());
+  ASSERT_EQ(
+      torch_tensorrt::core::runtime::base64_encode(raw_engine),
+      engine->serialize()[torch_tensorrt::core::runtime::ENGINE_IDX]);
+
+  serialized_info[torch_tensorrt::core::runtime::ENGINE_IDX] = raw_engine;
+  auto loaded = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(serialized_info);
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, loaded)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+}
+
+TEST(Runtime, DeviceInfoRecordsTheDLACore) {
+  auto dla = torch_tensorrt::core::runtime::RTDevice("0%8%7%1%Orin");
+  ASSERT_EQ(dla.device_type, nvinfer1::DeviceType::kDLA);
+  // Device info written before the DLA core was recorded runs on the default core
+  ASSERT_EQ(dla.dla_core, -1);
+
+  dla.dla_core = 1;
+  auto serialized = dla.serialize();
+  ASSERT_EQ(serialized, "0%8%7%1%Orin%1");
+  auto loaded = torch_tensorrt::core::runtime::RTDevice(serialized);
+  ASSERT_EQ(loaded.device_type, nvinfer1::DeviceType::kDLA);
+  ASSERT_EQ(loaded.dla_core, 1);
+  ASSERT_EQ(loaded.device_name, "Orin");
+
+  // GPU device info keeps its format
+  auto gpu = torch_tensorrt::core::runtime::RTDevice("0%8%6%0%NVIDIA A10");
+  ASSERT_EQ(gpu.serialize(), "0%8%6%0%NVIDIA A10");
+}
@@ -0,0 +1,82 @@
+#include "core/runtime/EngineVariants.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_engine(const char* graph, at::Tensor in) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+
+const char* kRelu = R"IR(
+    graph(%0 : Tensor):
+      %1 : Tensor = aten::relu(%0)
+      return (%1))IR";
+
+c10::intrusive_ptr<torch_tensorrt::core::runtime::EngineVariants> build_variants(at::Tensor in) {
+  return c10::make_intrusive<torch_tensorrt::core::runtime::EngineVariants>(
+      std::vector<c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine>>(
+          {build_engine(kRelu, in), build_engine(kRelu, in)}));
+}
+} // namespace
+
+TEST(Runtime, EngineVariantsServeFromTheFirstVariantWhenIdle) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto variants = build_variants(in);
+  variants->max_in_flight = 2;
+  auto out = torch_tensorrt::core::runtime::execute_engine_variants({in}, variants)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  ASSERT_EQ(variants->get_routed_counts(), std::vector<int64_t>({1, 0}));
+}
+
+TEST(Runtime, EngineVariantsMoveOnWhileTheFirstIsLoaded) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto variants = build_variants(in);
+  variants->max_in_flight = 2;
+  // Two executions in flight on the first variant
+  variants->engines[0]->in_flight_executions += 2;
+  ASSERT_EQ(variants->select({in}), 1);
+  auto out = torch_tensorrt::core::runtime::execute_engine_variants({in}, variants)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  ASSERT_EQ(variants->get_routed_counts(), std::vector<int64_t>({0, 1}));
+  variants->engines[0]->in_flight_executions -= 2;
+  ASSERT_EQ(variants->select({in}), 0);
+}
+
+TEST(Runtime, EngineVariantsStayWithinTheAccuracyBudget) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto variants = build_variants(in);
+  variants->max_in_flight = 1;
+  variants->engines[0]->in_flight_executions += 1;
+  // At most a tenth of the last 10 calls may be served by the second variant
+  variants->accuracy_budget = 0.1;
+  variants->accuracy_window = 10;
+  torch_tensorrt::core::runtime::execute_engine_variants({in}, variants);
+  ASSERT_DOUBLE_EQ(variants->get_accuracy_spent(), 0.1);
+  ASSERT_EQ(variants->select({in}), 0);
+
+  // The admission hook keeps calls on the precise variant regardless of the budget
+  variants->accuracy_budget = -1;
+  ASSERT_EQ(variants->select({in}), 1);
+  variants->admit = [](int64_t, const std::vector<at::Tensor>& inputs) {
+    return inputs[0].abs().max().item<float>() < 100;
+  };
+  ASSERT_EQ(variants->select({in * 1000}), 0);
+  variants->engines[0]->in_flight_executions -= 1;
+}
+
+TEST(Runtime, EngineVariantsNeedTheSameBindings) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  const auto two_outputs = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        %2 : Tensor = aten::neg(%0)
+        return (%1, %2))IR";
+  std::vector<c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine>> engines = {
+      build_engine(kRelu, in), build_engine(two_outputs, in)};
+  ASSERT_THROW(c10::make_intrusive<torch_tensorrt::core::runtime::EngineVariants>(engines), c10::Error);
+}
@@ -0,0 +1,44 @@
+#include <thread>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+TEST(Runtime, ExecutionContextPoolRunsConcurrentCallersCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  auto engine = torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+  engine->set_execution_context_pool_size(4);
+  ASSERT_EQ(engine->get_execution_context_pool_size(), 4);
+
+  int num_threads = 8;
+  std::vector<std::vector<at::Tensor>> trt_results(num_threads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; i++) {
+    threads.push_back(std::thread([&, i]() {
+      for (int iter = 0; iter < 10; iter++) {
+        trt_results[i] = torch_tensorrt::core::runtime::execute_engine({in}, engine);
+      }
+    }));
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  for (int i = 0; i < num_threads; i++) {
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[i][0]));
+  }
+
+  engine->set_execution_context_pool_size(1);
+  ASSERT_EQ(engine->get_execution_context_pool_size(), 1);
+}
@@ -0,0 +1,100 @@
+#include "c10/cuda/CUDAGuard.h"
+#include "c10/cuda/CUDAStream.h"
+#include "core/conversion/conversion.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        %2 : Tensor = aten::mul(%1, %1)
+        return (%2))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+
+// Two independent matmuls TensorRT can run concurrently
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_branching_engine(
+    at::Tensor in,
+    std::vector<at::Tensor> weights,
+    int64_t max_aux_streams) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor, %1 : Float(256, 256, strides=[256, 1]), %2 : Float(256, 256, strides=[256, 1])):
+        %3 : Tensor = aten::matmul(%0, %1)
+        %4 : Tensor = aten::matmul(%0, %2)
+        %5 : int = prim::Constant[value=1]()
+        %6 : Tensor = aten::add(%3, %4, %5)
+        return (%6))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {weights[0], weights[1]});
+  auto info = torch_tensorrt::core::conversion::ConversionInfo();
+  info.inputs = torch_tensorrt::core::ir::pair_input_vals_with_specs(
+      {g->inputs()[0]}, {torch_tensorrt::core::ir::Input(in.sizes().vec())});
+  info.engine_settings.max_aux_streams = max_aux_streams;
+  auto eng = torch_tensorrt::core::conversion::ConvertBlockToEngine(g->block(), info, params);
+  auto cuda_device = torch_tensorrt::core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU);
+  return c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(
+      "test_engine", eng, cuda_device, std::vector<std::string>(), std::vector<std::string>());
+}
+} // namespace
+
+TEST(Runtime, EngineExecutesOnCallerStream) {
+  auto in = at::randn({8, 32}, {at::kCUDA});
+  auto engine = build_engine(in);
+  engine->use_caller_stream = true;
+
+  auto stream = c10::cuda::getStreamFromPool(false, in.device().index());
+  c10::cuda::CUDAStreamGuard guard(stream);
+  for (int i = 0; i < 4; i++) {
+    auto x = in * (i + 1);
+    auto out = torch_tensorrt::core::runtime::execute_engine({x}, engine)[0];
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(x) * at::relu(x)));
+  }
+  // The engine never needed a stream of its own
+  ASSERT_EQ((*engine->acquire_execution_slot())->engine_stream, c10::cuda::getDefaultCUDAStream(in.device().index()));
+}
+
+TEST(Runtime, EngineStreamEventsAreReused) {
+  auto in = at::randn({8, 32}, {at::kCUDA});
+  auto engine = build_engine(in);
+
+  for (int i = 0; i < 4; i++) {
+    auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in) * at::relu(in)));
+  }
+  auto slot = engine->acquire_execution_slot();
+  ASSERT_TRUE((*slot)->caller_exec_complete.isCreated());
+  ASSERT_TRUE((*slot)->trt_exec_complete.isCreated());
+}
+
+TEST(Runtime, EngineRunsBranchesOnPooledAuxStreams) {
+  auto in = at::randn({64, 256}, {at::kCUDA});
+  std::vector<at::Tensor> weights = {at::randn({256, 256}, {at::kCUDA}), at::randn({256, 256}, {at::kCUDA})};
+  auto expected = at::matmul(in, weights[0]) + at::matmul(in, weights[1]);
+
+  auto serial = build_branching_engine(in, weights, 0);
+  ASSERT_EQ(serial->num_aux_streams, 0);
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, serial)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(out, expected));
+  ASSERT_TRUE((*serial->acquire_execution_slot())->aux_streams.empty());
+
+  auto parallel = build_branching_engine(in, weights, 2);
+  ASSERT_LE(parallel->num_aux_streams, 2);
+  for (int i = 0; i < 2; i++) {
+    out = torch_tensorrt::core::runtime::execute_engine({in}, parallel)[0];
+    ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(out, expected));
+  }
+  // The streams TensorRT forks onto come from the c10 pool and are kept by the slot
+  auto slot = parallel->acquire_execution_slot();
+  ASSERT_EQ(static_cast<int32_t>((*slot)->aux_streams.size()), parallel->num_aux_streams);
+  ASSERT_EQ((*slot)->aux_streams_device, in.device().index());
+}
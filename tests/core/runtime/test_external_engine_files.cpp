@@ -0,0 +1,78 @@
+#include <cstdio>
+
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_relu_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+} // namespace
+
+TEST(Runtime, EngineFileReferenceRoundTrips) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_relu_engine(in);
+
+  torch_tensorrt::core::runtime::EXTERNAL_ENGINE_DIR = ".";
+  auto serialized_info = engine->serialize();
+  torch_tensorrt::core::runtime::EXTERNAL_ENGINE_DIR = "";
+
+  auto& reference = serialized_info[torch_tensorrt::core::runtime::ENGINE_IDX];
+  ASSERT_TRUE(torch_tensorrt::core::runtime::is_engine_file_reference(reference));
+  auto path = torch_tensorrt::core::runtime::engine_file_path(reference);
+
+  // Saving the same engine again reuses the same file
+  torch_tensorrt::core::runtime::EXTERNAL_ENGINE_DIR = ".";
+  ASSERT_EQ(engine->serialize()[torch_tensorrt::core::runtime::ENGINE_IDX], reference);
+  torch_tensorrt::core::runtime::EXTERNAL_ENGINE_DIR = "";
+
+  auto loaded = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(serialized_info);
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, loaded)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+
+  // Without an engine directory the engine is embedded again
+  auto embedded = loaded->serialize()[torch_tensorrt::core::runtime::ENGINE_IDX];
+  ASSERT_FALSE(torch_tensorrt::core::runtime::is_engine_file_reference(embedded));
+
+  std::remove(path.c_str());
+}
+
+TEST(Runtime, LazyEngineFileIsOnlyMappedOnFirstExecution) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_relu_engine(in);
+
+  torch_tensorrt::core::runtime::EXTERNAL_ENGINE_DIR = ".";
+  auto serialized_info = engine->serialize();
+  torch_tensorrt::core::runtime::EXTERNAL_ENGINE_DIR = "";
+  auto path =
+      torch_tensorrt::core::runtime::engine_file_path(serialized_info[torch_tensorrt::core::runtime::ENGINE_IDX]);
+
+  torch_tensorrt::core::runtime::LAZY_ENGINE_DESERIALIZATION = true;
+  auto loaded = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(serialized_info);
+  torch_tensorrt::core::runtime::LAZY_ENGINE_DESERIALIZATION = false;
+  ASSERT_FALSE(loaded->is_engine_loaded());
+
+  // An unloaded engine is embedded by reading its engine file
+  torch_tensorrt::core::runtime::MappedEngineFile engine_file(path);
+  ASSERT_EQ(
+      loaded->serialize()[torch_tensorrt::core::runtime::ENGINE_IDX],
+      torch_tensorrt::core::runtime::base64_encode(
+          std::string(static_cast<const char*>(engine_file.data()), engine_file.size())));
+  ASSERT_FALSE(loaded->is_engine_loaded());
+
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, loaded)[0];
+  ASSERT_TRUE(loaded->is_engine_loaded());
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+
+  std::remove(path.c_str());
+}
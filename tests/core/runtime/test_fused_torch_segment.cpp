@@ -0,0 +1,56 @@
+#include "core/runtime/FusedTorchSegment.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/csrc/jit/passes/shape_analysis.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::FusedTorchSegment> mul_add_relu_segment() {
+  const auto graph = R"IR(
+      graph(%x : Float(4, 16, strides=[16, 1], requires_grad=0, device=cuda:0),
+            %y : Float(4, 16, strides=[16, 1], requires_grad=0, device=cuda:0)):
+        %1 : int = prim::Constant[value=1]()
+        %a : Tensor = aten::mul(%x, %y)
+        %b : Tensor = aten::add(%a, %x, %1)
+        %c : Tensor = aten::relu(%b)
+        return (%c))IR";
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  torch::jit::PropagateInputShapes(g);
+  return c10::make_intrusive<torch_tensorrt::core::runtime::FusedTorchSegment>("mul_add_relu", g);
+}
+
+at::Tensor reference(const at::Tensor& x, const at::Tensor& y) {
+  return at::relu(x * y + x);
+}
+} // namespace
+
+TEST(Runtime, FusedTorchSegmentMatchesTheInterpreter) {
+  auto segment = mul_add_relu_segment();
+  auto x = at::randn({4, 16}, {at::kCUDA});
+  auto y = at::randn({4, 16}, {at::kCUDA});
+  auto out = torch_tensorrt::core::runtime::execute_fused_torch_segment({x, y}, segment);
+  ASSERT_EQ(out.size(), 1);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out[0], reference(x, y)));
+
+  // Inputs the kernel is not specialized for run through the interpreter
+  auto x8 = at::randn({8, 16}, {at::kCUDA});
+  auto y8 = at::randn({8, 16}, {at::kCUDA});
+  out = segment->run({x8, y8});
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out[0], reference(x8, y8)));
+
+  auto xt = at::randn({16, 4}, {at::kCUDA}).t();
+  out = segment->run({xt, y});
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out[0], reference(xt, y)));
+}
+
+TEST(Runtime, FusedTorchSegmentSerializesItsGraph) {
+  auto segment = mul_add_relu_segment();
+  auto restored = c10::make_intrusive<torch_tensorrt::core::runtime::FusedTorchSegment>(segment->serialize());
+  ASSERT_EQ(restored->name, segment->name);
+
+  auto x = at::randn({4, 16}, {at::kCUDA});
+  auto y = at::randn({4, 16}, {at::kCUDA});
+  auto out = restored->run({x, y});
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out[0], reference(x, y)));
+}
@@ -0,0 +1,74 @@
+#include "c10/cuda/CUDAStream.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_add_engine() {
+  const auto graph = R"IR(
+      graph(%x : Tensor, %y : Tensor):
+        %one : int = prim::Constant[value=1]()
+        %z : Tensor = aten::add(%x, %y, %one)
+        return (%z))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto x = at::randn({8, 3}, {at::kCUDA});
+  auto y = at::randn({8, 3}, {at::kCUDA});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {x, y});
+}
+} // namespace
+
+TEST(Runtime, StagedHostInputsAreCopiedInOneTransfer) {
+  auto engine = build_add_engine();
+  engine->stage_host_inputs = true;
+  // More executions than staging buffers, so the buffers are reused
+  for (int i = 0; i < 4; i++) {
+    auto x = at::randn({8, 3});
+    auto y = at::randn({8, 3});
+    auto out = torch_tensorrt::core::runtime::execute_engine({x, y}, engine)[0];
+    ASSERT_TRUE(out.is_cuda());
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, (x + y).to(at::kCUDA)));
+  }
+}
+
+TEST(Runtime, StagedHostInputsMixWithDeviceInputs) {
+  auto engine = build_add_engine();
+  engine->stage_host_inputs = true;
+  auto x = at::randn({8, 3}).t().contiguous().t();
+  auto y = at::randn({8, 3}, {at::kCUDA});
+  auto out = torch_tensorrt::core::runtime::execute_engine({x, y}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, x.to(at::kCUDA) + y));
+}
+
+TEST(Runtime, HostOutputsAreReturnedInPinnedMemory) {
+  auto engine = build_add_engine();
+  engine->set_host_outputs({engine->out_binding_names[0]});
+  ASSERT_EQ(engine->get_host_outputs(), engine->out_binding_names);
+  auto x = at::randn({8, 3}, {at::kCUDA});
+  auto y = at::randn({8, 3}, {at::kCUDA});
+  auto out = torch_tensorrt::core::runtime::execute_engine({x, y}, engine)[0];
+  ASSERT_FALSE(out.is_cuda());
+  ASSERT_TRUE(out.is_pinned());
+  c10::cuda::getCurrentCUDAStream().synchronize();
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, (x + y).cpu()));
+
+  engine->set_host_outputs({});
+  ASSERT_TRUE(torch_tensorrt::core::runtime::execute_engine({x, y}, engine)[0].is_cuda());
+  ASSERT_ANY_THROW(engine->set_host_outputs({"not_an_output"}));
+}
+
+TEST(Runtime, HostInputsAreStagedOnTheNUMANodeOfTheGPU) {
+  auto engine = build_add_engine();
+  engine->stage_host_inputs = true;
+  torch_tensorrt::core::runtime::NUMA_LOCAL_HOST_STAGING = true;
+  for (int i = 0; i < 4; i++) {
+    auto x = at::randn({8, 3});
+    auto y = at::randn({8, 3});
+    auto out = torch_tensorrt::core::runtime::execute_engine({x, y}, engine)[0];
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, (x + y).to(at::kCUDA)));
+  }
+  torch_tensorrt::core::runtime::NUMA_LOCAL_HOST_STAGING = false;
+}
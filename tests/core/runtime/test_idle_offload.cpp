@@ -0,0 +1,86 @@
+#include <chrono>
+#include <thread>
+
+#include "core/runtime/EngineOffloader.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_linear_engine(at::Tensor in, at::Tensor w) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor, %1 : Float(16, 16, strides=[16, 1])):
+        %2 : None = prim::Constant()
+        %3 : Tensor = aten::linear(%0, %1, %2)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+} // namespace
+
+TEST(Runtime, OffloadedEnginesAreReloadedByTheirNextExecution) {
+  using namespace torch_tensorrt::core::runtime;
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto w = at::randn({16, 16}, {at::kCUDA});
+  auto engine = build_linear_engine(in, w);
+  engine->set_execution_context_pool_size(2);
+  auto expected = execute_engine({in}, engine)[0];
+
+  ASSERT_TRUE(engine->offload());
+  ASSERT_TRUE(engine->is_offloaded());
+  ASSERT_FALSE(engine->is_engine_loaded());
+  ASSERT_FALSE(engine->cuda_engine);
+  ASSERT_TRUE(engine->exec_slots.empty());
+  ASSERT_EQ(engine->get_memory_usage().at("total"), 0);
+  // Offloaded engines have nothing to offload
+  ASSERT_FALSE(engine->offload());
+
+  auto out = execute_engine({in}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::exactlyEqual(expected, out));
+  ASSERT_FALSE(engine->is_offloaded());
+  ASSERT_EQ(engine->get_execution_context_pool_size(), 2);
+  auto metrics = engine->get_runtime_metrics();
+  ASSERT_EQ(metrics.at("offloads"), 1);
+  ASSERT_EQ(metrics.at("reloads"), 1);
+}
+
+TEST(Runtime, EnginesInFlightAreNotOffloaded) {
+  using namespace torch_tensorrt::core::runtime;
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto w = at::randn({16, 16}, {at::kCUDA});
+  auto engine = build_linear_engine(in, w);
+  engine->in_flight_executions += 1;
+  ASSERT_FALSE(engine->offload());
+  ASSERT_TRUE(engine->is_engine_loaded());
+  engine->in_flight_executions -= 1;
+  ASSERT_TRUE(engine->offload());
+}
+
+TEST(Runtime, IdleEnginesAreOffloadedAfterTheirTimeout) {
+  using namespace torch_tensorrt::core::runtime;
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto w = at::randn({16, 16}, {at::kCUDA});
+  auto idle = build_linear_engine(in, w);
+  auto busy = build_linear_engine(in, w);
+  idle->set_idle_offload_ms(50);
+  busy->set_idle_offload_ms(60000);
+  execute_engine({in}, idle);
+  execute_engine({in}, busy);
+
+  // Offloaded by the background thread of the offloader
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!idle->is_offloaded() && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_TRUE(idle->is_offloaded());
+  ASSERT_FALSE(busy->is_offloaded());
+  ASSERT_EQ(get_engine_offloader().offload_idle_engines(), 0);
+
+  auto out = execute_engine({in}, idle)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::linear(in, w)));
+  ASSERT_EQ(idle->get_runtime_metrics().at("reloads"), 1);
+}
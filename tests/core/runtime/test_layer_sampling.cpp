@@ -0,0 +1,118 @@
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+#include "core/conversion/conversion.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_relu_engine() {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+
+  std::vector<const torch::jit::Value*> var_ins = {g->inputs()[0]};
+  auto info = torch_tensorrt::core::conversion::ConversionInfo();
+  info.inputs = torch_tensorrt::core::ir::pair_input_vals_with_specs(
+      var_ins, {torch_tensorrt::core::ir::Input(std::vector<int64_t>({4, 16}))});
+  auto eng = torch_tensorrt::core::conversion::ConvertBlockToEngine(g->block(), info, params);
+
+  auto cuda_device = torch_tensorrt::core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU);
+  return c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(
+      "sampled_engine", eng, cuda_device, std::vector<std::string>(), std::vector<std::string>());
+}
+
+void run(c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> engine, int64_t executions) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  for (int64_t i = 0; i < executions; i++) {
+    auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  }
+}
+
+bool contains(const std::string& json, const std::string& s) {
+  return json.find(s) != std::string::npos;
+}
+} // namespace
+
+TEST(Runtime, LayerSamplingProfilesOneInEveryNExecutions) {
+  auto engine = build_relu_engine();
+  torch_tensorrt::core::runtime::LayerSamplingConfig config;
+  config.every_n = 2;
+  engine->enable_layer_sampling(config);
+  run(engine, 10);
+
+  auto samples = engine->get_layer_samples();
+  ASSERT_TRUE(contains(samples, "\"engine\": \"sampled_engine\"")) << samples;
+  ASSERT_TRUE(contains(samples, "\"sampled_executions\": 5")) << samples;
+  ASSERT_TRUE(contains(samples, "\"count\": 5")) << samples;
+
+  engine->disable_layer_sampling();
+  run(engine, 4);
+  ASSERT_FALSE(engine->layer_sampler->is_enabled());
+}
+
+TEST(Runtime, LayerSamplingRotatesItsReports) {
+  auto dir = std::filesystem::temp_directory_path() / "torchtrt_test_layer_sampling";
+  std::filesystem::remove_all(dir);
+
+  auto engine = build_relu_engine();
+  torch_tensorrt::core::runtime::LayerSamplingConfig config;
+  config.every_n = 1;
+  config.output_dir = dir.string();
+  config.report_every = 2;
+  config.max_reports = 3;
+  engine->enable_layer_sampling(config);
+  // 5 full reports and one pending sample written out by disable
+  run(engine, 11);
+  engine->disable_layer_sampling();
+
+  size_t reports = 0;
+  for (const auto& f : std::filesystem::directory_iterator(dir)) {
+    ASSERT_EQ(f.path().filename().string().rfind("sampled_engine_layer_samples_", 0), 0u);
+    reports++;
+  }
+  ASSERT_EQ(reports, 3u);
+  std::filesystem::remove_all(dir);
+}
+
+TEST(Runtime, LayerSamplingWindowProfilesEveryExecutionUntilItEnds) {
+  auto engine = build_relu_engine();
+  torch_tensorrt::core::runtime::LayerSamplingConfig config;
+  config.every_n = 0;
+  config.window_ms = 200;
+  engine->enable_layer_sampling(config);
+  run(engine, 3);
+  ASSERT_TRUE(contains(engine->get_layer_samples(), "\"sampled_executions\": 3"));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(250));
+  run(engine, 1);
+  ASSERT_FALSE(engine->layer_sampler->is_enabled());
+}
+
+TEST(Runtime, LayerProfileIsReadableWhileProfiling) {
+  auto engine = build_relu_engine();
+  ASSERT_EQ(engine->get_layer_profile().size(), 0u);
+  engine->profile_path_prefix = std::filesystem::temp_directory_path().string();
+  engine->enable_profiling();
+  run(engine, 3);
+
+  auto layers = engine->get_layer_profile();
+  ASSERT_GT(layers.size(), 0u);
+  for (const auto& layer : layers) {
+    ASSERT_EQ(layer.value().at("count"), 3);
+    ASSERT_NEAR(layer.value().at("mean_ms"), layer.value().at("total_ms") / 3, 1e-6);
+  }
+
+  engine->reset_layer_profile();
+  ASSERT_EQ(engine->get_layer_profile().size(), 0u);
+  engine->disable_profiling();
+}
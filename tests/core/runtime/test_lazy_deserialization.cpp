@@ -0,0 +1,60 @@
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+std::vector<std::string> serialized_relu_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto engine = torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+  auto serialized_info = engine->serialize();
+  // Mirrors the unpickling path in register_jit_hooks.cpp
+  serialized_info[torch_tensorrt::core::runtime::ENGINE_IDX] =
+      torch_tensorrt::core::runtime::base64_decode(serialized_info[torch_tensorrt::core::runtime::ENGINE_IDX]);
+  return serialized_info;
+}
+} // namespace
+
+TEST(Runtime, LazyEngineIsDeserializedOnFirstExecution) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto serialized_info = serialized_relu_engine(in);
+
+  torch_tensorrt::core::runtime::LAZY_ENGINE_DESERIALIZATION = true;
+  auto engine = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(serialized_info);
+  torch_tensorrt::core::runtime::LAZY_ENGINE_DESERIALIZATION = false;
+
+  ASSERT_FALSE(engine->is_engine_loaded());
+  ASSERT_EQ(engine->num_io.first, 1);
+  ASSERT_EQ(engine->num_io.second, 1);
+  // An engine which was never executed serializes its original blob
+  auto reserialized = engine->serialize();
+  ASSERT_EQ(
+      reserialized[torch_tensorrt::core::runtime::ENGINE_IDX],
+      torch_tensorrt::core::runtime::base64_encode(serialized_info[torch_tensorrt::core::runtime::ENGINE_IDX]));
+  ASSERT_FALSE(engine->is_engine_loaded());
+
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_TRUE(engine->is_engine_loaded());
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+}
+
+TEST(Runtime, WarmupForcesLazyDeserialization) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto serialized_info = serialized_relu_engine(in);
+
+  torch_tensorrt::core::runtime::LAZY_ENGINE_DESERIALIZATION = true;
+  auto engine = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(serialized_info);
+  torch_tensorrt::core::runtime::LAZY_ENGINE_DESERIALIZATION = false;
+
+  engine->warmup();
+  ASSERT_TRUE(engine->is_engine_loaded());
+  ASSERT_NE(engine->cuda_engine, nullptr);
+  ASSERT_EQ(engine->get_execution_context_pool_size(), 1);
+}
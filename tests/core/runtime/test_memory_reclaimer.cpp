@@ -0,0 +1,103 @@
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_linear_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor, %1 : Float(32, 16, strides=[16, 1])):
+        %2 : None = prim::Constant()
+        %3 : Tensor = aten::linear(%0, %1, %2)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto w = at::randn({32, 16}, {at::kCUDA});
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+
+void throw_out_of_memory() {
+  TORCH_CHECK_WITH(OutOfMemoryError, false, "CUDA out of memory. Tried to allocate 2.00 GiB");
+}
+} // namespace
+
+TEST(Runtime, ReclaimReleasesCudaGraphsAndBuffersOfIdleEngines) {
+  using namespace torch_tensorrt::core::runtime;
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_linear_engine(in);
+  auto expected = execute_engine({in}, engine)[0];
+
+  engine->use_pre_allocated_outputs = true;
+  CUDAGRAPHS_MODE = SUBGRAPH_CUDAGRAPHS;
+  for (int i = 0; i < 2; i++) {
+    execute_engine({in}, engine);
+  }
+  ASSERT_EQ(engine->get_cudagraph_cache_stats().at("entries"), 1);
+  ASSERT_GT(engine->get_memory_usage().at("io_buffers"), 0);
+
+  auto device_id = engine->device_info.id;
+  ASSERT_GT(get_memory_reclaimer().reclaim(device_id, RECLAIM_CUDAGRAPHS), 0);
+  ASSERT_EQ(engine->get_cudagraph_cache_stats().at("entries"), 0);
+  ASSERT_GT(engine->get_memory_usage().at("io_buffers"), 0);
+
+  get_memory_reclaimer().reclaim(device_id, RECLAIM_BUFFERS);
+  ASSERT_EQ(engine->get_memory_usage().at("io_buffers"), 0);
+
+  // The graph and the outputs are created again by the next execution
+  auto out = execute_engine({in}, engine)[0];
+  CUDAGRAPHS_MODE = STANDARD;
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(expected, out));
+}
+
+TEST(Runtime, RetryReclaimingMemoryRetriesOutOfMemoryErrors) {
+  using namespace torch_tensorrt::core::runtime;
+  auto reclaims = get_memory_reclaimer().get_num_reclaims();
+  int attempts = 0;
+  ASSERT_TRUE(retry_reclaiming_memory(0, [&]() {
+    if (++attempts == 1) {
+      throw_out_of_memory();
+    }
+    return true;
+  }));
+  ASSERT_EQ(attempts, 2);
+  ASSERT_EQ(get_memory_reclaimer().get_num_reclaims(), reclaims + 1);
+
+  // Every stage is tried once before the failure is reported
+  attempts = 0;
+  ASSERT_FALSE(retry_reclaiming_memory(0, [&]() {
+    attempts++;
+    return false;
+  }));
+  ASSERT_EQ(attempts, RECLAIM_WEIGHT_STREAMING + 2);
+}
+
+TEST(Runtime, RetryReclaimingMemoryRethrowsOtherErrors) {
+  using namespace torch_tensorrt::core::runtime;
+  int attempts = 0;
+  EXPECT_THROW(
+      retry_reclaiming_memory(
+          0,
+          [&]() -> bool {
+            attempts++;
+            TORCHTRT_THROW_ERROR("Not a memory error");
+            return true;
+          }),
+      c10::Error);
+  ASSERT_EQ(attempts, 1);
+
+  RECLAIM_MEMORY_ON_OOM = false;
+  attempts = 0;
+  EXPECT_THROW(
+      retry_reclaiming_memory(
+          0,
+          [&]() -> bool {
+            attempts++;
+            throw_out_of_memory();
+            return true;
+          }),
+      c10::OutOfMemoryError);
+  RECLAIM_MEMORY_ON_OOM = true;
+  ASSERT_EQ(attempts, 1);
+}
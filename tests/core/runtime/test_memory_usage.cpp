@@ -0,0 +1,61 @@
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_linear_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor, %1 : Float(32, 16, strides=[16, 1])):
+        %2 : None = prim::Constant()
+        %3 : Tensor = aten::linear(%0, %1, %2)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto w = at::randn({32, 16}, {at::kCUDA});
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+
+int64_t sum_of_categories(const c10::Dict<std::string, int64_t>& usage) {
+  return usage.at("weights") + usage.at("activations") + usage.at("cudagraphs") + usage.at("io_buffers");
+}
+} // namespace
+
+TEST(Runtime, MemoryUsageReportsWeightsAndActivations) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_linear_engine(in);
+
+  auto usage = engine->get_memory_usage();
+  // The plan holds the 32x16 float weights
+  ASSERT_GE(usage.at("weights"), 32 * 16 * 4);
+  ASSERT_EQ(usage.at("shared_activations"), 0);
+  ASSERT_EQ(usage.at("total"), sum_of_categories(usage));
+
+  // Every slot owns the scratch memory of its context
+  engine->set_execution_context_pool_size(2);
+  ASSERT_EQ(engine->get_memory_usage().at("activations"), 2 * usage.at("activations"));
+}
+
+TEST(Runtime, MemoryUsageCountsPersistentBuffers) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_linear_engine(in);
+  ASSERT_EQ(engine->get_memory_usage().at("io_buffers"), 0);
+
+  // Pre-allocated outputs are kept by the engine between executions
+  engine->use_pre_allocated_outputs = true;
+  for (int i = 0; i < 2; i++) {
+    torch_tensorrt::core::runtime::execute_engine({in}, engine);
+  }
+  ASSERT_GE(engine->get_memory_usage().at("io_buffers"), 4 * 32 * 4);
+  engine->use_pre_allocated_outputs = false;
+
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::SUBGRAPH_CUDAGRAPHS;
+  torch_tensorrt::core::runtime::execute_engine({in}, engine);
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::STANDARD;
+  auto usage = engine->get_memory_usage();
+  ASSERT_EQ(usage.at("cudagraphs"), engine->get_cudagraph_cache_stats().at("bytes"));
+  ASSERT_GT(usage.at("cudagraphs"), 0);
+  ASSERT_EQ(usage.at("total"), sum_of_categories(usage));
+}
@@ -1,8 +1,46 @@
 #include "core/runtime/runtime.h"
 #include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
 
 TEST(Runtime, MultiDeviceSafeMode) {
   ASSERT_TRUE(!torch_tensorrt::core::runtime::get_multi_device_safe_mode());
   torch_tensorrt::core::runtime::set_multi_device_safe_mode(true);
   ASSERT_TRUE(torch_tensorrt::core::runtime::get_multi_device_safe_mode());
+  torch_tensorrt::core::runtime::set_multi_device_safe_mode(false);
+}
+
+TEST(Runtime, CurrentDeviceMatchesDeviceProperties) {
+  auto current = torch_tensorrt::core::runtime::get_current_device();
+  auto expected = torch_tensorrt::core::runtime::RTDevice(current.id, nvinfer1::DeviceType::kGPU);
+  ASSERT_EQ(current.major, expected.major);
+  ASSERT_EQ(current.minor, expected.minor);
+  ASSERT_EQ(current.device_name, expected.device_name);
+  // Served from the per thread cache
+  ASSERT_EQ(torch_tensorrt::core::runtime::get_current_device().device_name, expected.device_name);
+}
+
+TEST(Runtime, SafeModeDoesNotMoveInputsOnTheEngineDevice) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto engine = torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+
+  torch_tensorrt::core::runtime::set_multi_device_safe_mode(true);
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  // Host inputs are still moved to the engine device
+  auto host_out = torch_tensorrt::core::runtime::execute_engine({in.cpu()}, engine)[0];
+  torch_tensorrt::core::runtime::set_multi_device_safe_mode(false);
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(host_out, at::relu(in)));
+  auto metrics = engine->get_runtime_metrics();
+  ASSERT_EQ(metrics.at("device_switches"), 0);
+  ASSERT_EQ(metrics.at("input_moves"), 1);
 }
@@ -0,0 +1,58 @@
+#include "core/conversion/conversion.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_two_profile_relu_engine() {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+
+  // Latency profile for small batches, throughput profile for large ones
+  auto spec = torch_tensorrt::core::ir::Input({1, 16}, {1, 16}, {4, 16});
+  spec.add_profile({8, 16}, {32, 16}, {64, 16});
+  std::vector<const torch::jit::Value*> var_ins = {g->inputs()[0]};
+  auto info = torch_tensorrt::core::conversion::ConversionInfo();
+  info.inputs = torch_tensorrt::core::ir::pair_input_vals_with_specs(var_ins, {spec});
+  auto eng = torch_tensorrt::core::conversion::ConvertBlockToEngine(g->block(), info, params);
+
+  auto cuda_device = torch_tensorrt::core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU);
+  return c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(
+      "test_engine", eng, cuda_device, std::vector<std::string>(), std::vector<std::string>());
+}
+} // namespace
+
+TEST(Runtime, InputProfilesWidenTheInputShape) {
+  auto spec = torch_tensorrt::core::ir::Input({1, 16});
+  ASSERT_FALSE(spec.input_is_dynamic);
+  spec.add_profile({8, 16}, {32, 16}, {64, 16});
+  ASSERT_TRUE(spec.input_is_dynamic);
+  ASSERT_EQ(spec.num_profiles(), 2);
+  ASSERT_EQ(spec.input_shape.d[0], -1);
+  ASSERT_EQ(spec.input_shape.d[1], 16);
+  ASSERT_EQ(spec.profile(1).opt.d[0], 32);
+}
+
+TEST(Runtime, ExecutionSelectsTheBestMatchingProfile) {
+  auto engine = build_two_profile_relu_engine();
+  ASSERT_EQ(engine->num_optimization_profiles, 2);
+
+  std::vector<int64_t> small = {2, 16};
+  std::vector<int64_t> large = {48, 16};
+  ASSERT_EQ(engine->select_optimization_profile({small}), 0);
+  ASSERT_EQ(engine->select_optimization_profile({large}), 1);
+
+  for (int64_t batch : {2, 48, 3, 64}) {
+    auto in = at::randn({batch, 16}, {at::kCUDA});
+    auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+    ASSERT_EQ(engine->exec_slots[0]->active_profile, batch <= 4 ? 0 : 1);
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  }
+}
@@ -0,0 +1,59 @@
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+// Returns its input and the same product twice, only the first product is bound by the engine
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_aliasing_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::mul(%0, %0)
+        return (%0, %1, %1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+} // namespace
+
+TEST(Runtime, PassthroughAndDuplicateOutputsAreNotBound) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_aliasing_engine(in);
+  ASSERT_EQ(engine->num_io.second, 1);
+  ASSERT_EQ(engine->num_outputs(), 3);
+  ASSERT_EQ(
+      engine->returned_output_names(), std::vector<std::string>({"alias_of:input_0", "output_0", "alias_of:output_1"}));
+
+  auto outs = torch_tensorrt::core::runtime::execute_engine({in}, engine);
+  ASSERT_EQ(outs.size(), 3);
+  // Like TorchScript, the returned tensors are the input and the same product twice
+  ASSERT_EQ(outs[0].data_ptr(), in.data_ptr());
+  ASSERT_EQ(outs[2].data_ptr(), outs[1].data_ptr());
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(outs[1], in * in));
+}
+
+TEST(Runtime, AliasedOutputsAreWrittenIntoCallerTensors) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_aliasing_engine(in);
+  std::vector<at::Tensor> outs = {at::empty_like(in), at::empty_like(in), at::empty_like(in)};
+  torch_tensorrt::core::runtime::execute_engine_out({in}, outs, engine);
+  ASSERT_TRUE(torch_tensorrt::tests::util::exactlyEqual(outs[0], in));
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(outs[1], in * in));
+  ASSERT_TRUE(torch_tensorrt::tests::util::exactlyEqual(outs[2], outs[1]));
+}
+
+TEST(Runtime, OutputAliasesSurviveSerialization) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_aliasing_engine(in);
+  auto serialized_info = engine->serialize();
+  serialized_info[torch_tensorrt::core::runtime::ENGINE_IDX] =
+      torch_tensorrt::core::runtime::base64_decode(serialized_info[torch_tensorrt::core::runtime::ENGINE_IDX]);
+
+  auto loaded = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(serialized_info);
+  ASSERT_EQ(loaded->returned_output_names(), engine->returned_output_names());
+  auto outs = torch_tensorrt::core::runtime::execute_engine({in}, loaded);
+  ASSERT_EQ(outs[0].data_ptr(), in.data_ptr());
+  ASSERT_EQ(outs[2].data_ptr(), outs[1].data_ptr());
+}
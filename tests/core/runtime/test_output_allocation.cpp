@@ -0,0 +1,107 @@
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::mul(%0, %0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+} // namespace
+
+TEST(Runtime, OutputsAreAllocatedInEngineDtype) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA}).to(at::kInt);
+  auto engine = build_engine(in);
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_EQ(out.scalar_type(), at::kInt);
+  ASSERT_TRUE(torch_tensorrt::tests::util::exactlyEqual(out, in * in));
+}
+
+TEST(Runtime, OutputArenaRecyclesDroppedOutputs) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine = build_engine(in);
+  engine->use_output_arena = true;
+
+  void* first_ptr = nullptr;
+  {
+    auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+    first_ptr = out.data_ptr();
+  }
+  // The first output was dropped so its storage is reused
+  auto held = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_EQ(held.data_ptr(), first_ptr);
+
+  // While the output is still held, a new buffer has to be handed out
+  auto second = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_NE(second.data_ptr(), held.data_ptr());
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(held, second));
+}
+
+TEST(Runtime, PreAllocatedOutputsRotateBetweenBuffers) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine = build_engine(in);
+  engine->use_pre_allocated_outputs = true;
+
+  // A pipelined caller holding on to the previous outputs alternates between two buffers
+  auto first = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  auto second = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_NE(first.data_ptr(), second.data_ptr());
+  void* first_ptr = first.data_ptr();
+  first = at::Tensor();
+  auto third = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_EQ(third.data_ptr(), first_ptr);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(third, in * in));
+
+  // Outputs which are still held are never overwritten
+  auto fourth = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_NE(fourth.data_ptr(), second.data_ptr());
+  ASSERT_NE(fourth.data_ptr(), third.data_ptr());
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(second, in * in));
+}
+
+TEST(Runtime, OutputsAreWrittenIntoCallerTensors) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_engine(in);
+  auto out = at::empty({4, 16}, {at::kCUDA});
+  torch_tensorrt::core::runtime::execute_engine_out({in}, {out}, engine);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, in * in));
+
+  // Slices of a larger tensor can be written to as long as they are contiguous
+  auto batched = at::zeros({2, 4, 16}, {at::kCUDA});
+  torch_tensorrt::core::runtime::execute_engine_out({in}, {batched[1]}, engine);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(batched[1], in * in));
+  ASSERT_TRUE(torch_tensorrt::tests::util::exactlyEqual(batched[0], at::zeros({4, 16}, {at::kCUDA})));
+
+  ASSERT_ANY_THROW(torch_tensorrt::core::runtime::execute_engine_out({in}, {at::empty({2, 16}, {at::kCUDA})}, engine));
+  ASSERT_ANY_THROW(
+      torch_tensorrt::core::runtime::execute_engine_out({in}, {at::empty({4, 16}, {at::kCUDA}).to(at::kHalf)}, engine));
+}
+
+TEST(Runtime, CudaGraphsReplayIntoCallerTensors) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_engine(in);
+  auto out = at::empty({4, 16}, {at::kCUDA});
+
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::SUBGRAPH_CUDAGRAPHS;
+  torch_tensorrt::core::runtime::execute_engine_out({in}, {out}, engine);
+  auto next_in = at::randn({4, 16}, {at::kCUDA});
+  torch_tensorrt::core::runtime::execute_engine_out({next_in}, {out}, engine);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, next_in * next_in));
+  ASSERT_EQ(engine->get_runtime_metrics().at("cudagraph_hits"), 1);
+
+  // Different output tensors need a graph of their own
+  auto other = at::empty({4, 16}, {at::kCUDA});
+  torch_tensorrt::core::runtime::execute_engine_out({in}, {other}, engine);
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::STANDARD;
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(other, in * in));
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, next_in * next_in));
+  ASSERT_EQ(engine->get_runtime_metrics().at("cudagraph_recaptures"), 1);
+}
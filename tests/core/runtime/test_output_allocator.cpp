@@ -0,0 +1,54 @@
+#include "c10/cuda/CUDAStream.h"
+#include "core/runtime/OutputAllocator.h"
+#include "gtest/gtest.h"
+#include "torch/torch.h"
+
+using torch_tensorrt::core::runtime::DynamicOutputAllocator;
+
+namespace {
+nvinfer1::Dims dims(std::vector<int64_t> shape) {
+  nvinfer1::Dims d;
+  d.nbDims = static_cast<int32_t>(shape.size());
+  for (size_t i = 0; i < shape.size(); i++) {
+    d.d[i] = shape[i];
+  }
+  return d;
+}
+} // namespace
+
+TEST(Runtime, OutputAllocatorReturnsRightSizedViews) {
+  DynamicOutputAllocator allocator({"output0", "output1"});
+  auto stream = c10::cuda::getCurrentCUDAStream().stream();
+  void* ptr = allocator.reallocateOutputAsync("output1", nullptr, 5 * 2 * sizeof(int64_t), 256, stream);
+  ASSERT_NE(ptr, nullptr);
+  allocator.notifyShape("output1", dims({5, 2}));
+  ASSERT_EQ(allocator.reallocateOutputAsync("unknown", nullptr, 16, 256, stream), nullptr);
+
+  auto out = allocator.output(1, at::kLong);
+  ASSERT_EQ(out.sizes(), at::IntArrayRef({5, 2}));
+  ASSERT_EQ(out.scalar_type(), at::kLong);
+  ASSERT_EQ(out.data_ptr(), ptr);
+
+  allocator.notifyShape("output0", dims({0, 2}));
+  ASSERT_EQ(allocator.output(0, at::kFloat).numel(), 0);
+}
+
+TEST(Runtime, OutputAllocatorOnlyReusesReleasedBuffers) {
+  DynamicOutputAllocator allocator({"output0"});
+  auto stream = c10::cuda::getCurrentCUDAStream().stream();
+  void* first = allocator.reallocateOutputAsync("output0", nullptr, 64, 256, stream);
+  allocator.notifyShape("output0", dims({16}));
+
+  // While the caller holds the previous output a new buffer is handed out
+  auto held = allocator.output(0, at::kFloat);
+  void* second = allocator.reallocateOutputAsync("output0", nullptr, 64, 256, stream);
+  ASSERT_NE(second, first);
+  ASSERT_EQ(held.data_ptr(), first);
+
+  // Once released, smaller outputs reuse the buffer and larger ones grow it
+  held = at::Tensor();
+  ASSERT_EQ(allocator.reallocateOutputAsync("output0", nullptr, 32, 256, stream), second);
+  ASSERT_GE(allocator.buffer(0).nbytes(), 64);
+  allocator.reallocateOutputAsync("output0", nullptr, 96, 256, stream);
+  ASSERT_GE(allocator.buffer(0).nbytes(), 128);
+}
@@ -0,0 +1,47 @@
+#include "core/runtime/runtime.h"
+#include "cuda_runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_relu_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+} // namespace
+
+TEST(Runtime, PersistentCacheLimitIsAppliedOnNextExecution) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_relu_engine(in);
+  ASSERT_ANY_THROW(engine->set_persistent_cache_limit(-2));
+
+  int max_persisting = 0;
+  ASSERT_EQ(cudaDeviceGetAttribute(&max_persisting, cudaDevAttrMaxPersistingL2CacheSize, 0), cudaSuccess);
+  engine->set_persistent_cache_limit(-1);
+  ASSERT_EQ(engine->get_resolved_persistent_cache_limit(), max_persisting);
+  engine->set_persistent_cache_limit(int64_t(max_persisting) + 1);
+  ASSERT_EQ(engine->get_resolved_persistent_cache_limit(), max_persisting);
+
+  engine->set_persistent_cache_limit(-1);
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  ASSERT_EQ(engine->exec_slots[0]->applied_persistent_cache_limit, -1);
+  if (max_persisting > 0) {
+    size_t set_aside = 0;
+    ASSERT_EQ(cudaDeviceGetLimit(&set_aside, cudaLimitPersistingL2CacheSize), cudaSuccess);
+    ASSERT_GE(set_aside, static_cast<size_t>(max_persisting));
+  }
+
+  engine->set_persistent_cache_limit(0);
+  out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  ASSERT_EQ(engine->exec_slots[0]->applied_persistent_cache_limit, 0);
+}
@@ -0,0 +1,68 @@
+#include <thread>
+
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_relu_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+} // namespace
+
+TEST(Runtime, LatencyCriticalEnginesRunOnHighPriorityStreams) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_relu_engine(in);
+  ASSERT_ANY_THROW(engine->set_qos_class(7));
+
+  torch_tensorrt::core::runtime::execute_engine({in}, engine);
+  auto default_priority = engine->exec_slots[0]->engine_stream.priority();
+
+  engine->set_qos_class(torch_tensorrt::core::runtime::QOS_LATENCY_CRITICAL);
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  // Lower numbers are higher priorities
+  ASSERT_LT(engine->exec_slots[0]->engine_stream.priority(), default_priority);
+}
+
+TEST(Runtime, BackgroundEnginesAreLimitedInFlight) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = build_relu_engine(in);
+  engine->set_execution_context_pool_size(4);
+  engine->set_qos_class(torch_tensorrt::core::runtime::QOS_BACKGROUND);
+  torch_tensorrt::core::runtime::BACKGROUND_MAX_IN_FLIGHT = 1;
+
+  auto& admission = torch_tensorrt::core::runtime::get_background_admission(0);
+  std::vector<std::thread> callers;
+  std::vector<int> correct(4, 0);
+  for (size_t t = 0; t < correct.size(); t++) {
+    callers.emplace_back([&, t]() {
+      for (int i = 0; i < 8; i++) {
+        auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+        correct[t] = torch_tensorrt::tests::util::almostEqual(out, at::relu(in)) && admission.in_flight() <= 1;
+        if (!correct[t]) {
+          return;
+        }
+      }
+    });
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+  torch_tensorrt::core::runtime::BACKGROUND_MAX_IN_FLIGHT = 0;
+  for (int c : correct) {
+    ASSERT_TRUE(c);
+  }
+
+  torch::cuda::synchronize();
+  ASSERT_EQ(admission.in_flight(), 0);
+}
@@ -0,0 +1,74 @@
+#include "c10/cuda/CUDAFunctions.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_relu_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+} // namespace
+
+TEST(Runtime, EngineIsNotReplicatedOnItsOwnDevice) {
+  auto engine = build_relu_engine(at::randn({4, 16}, {at::kCUDA}));
+  engine->set_replica_devices({0, 0});
+  ASSERT_TRUE(engine->replicas.empty());
+  ASSERT_TRUE(engine->get_replica_devices().empty());
+  ASSERT_ANY_THROW(engine->set_replica_devices({-1}));
+}
+
+TEST(Runtime, ExecutionsAreDispatchedToTheReplicaHoldingTheInputs) {
+  if (c10::cuda::device_count() < 2) {
+    GTEST_SKIP() << "Requires at least two GPUs";
+  }
+  auto engine = build_relu_engine(at::randn({4, 16}, {at::kCUDA}));
+  engine->set_replica_devices({0, 1});
+  ASSERT_EQ(engine->get_replica_devices(), std::vector<int64_t>({0, 1}));
+
+  auto in = at::randn({4, 16}, at::TensorOptions().device(at::Device(at::kCUDA, 1)));
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_EQ(out.device(), in.device());
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  ASSERT_EQ(engine->replicas[0]->get_runtime_metrics().at("executions"), 1);
+  ASSERT_EQ(engine->get_runtime_metrics().at("executions"), 0);
+
+  // Host inputs go to the least loaded engine, which is the engine itself when nothing is in flight
+  auto host_in = at::randn({4, 16});
+  auto host_out = torch_tensorrt::core::runtime::execute_engine({host_in}, engine)[0];
+  ASSERT_EQ(host_out.device(), at::Device(at::kCUDA, 0));
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(host_out.cpu(), at::relu(host_in)));
+  ASSERT_EQ(engine->get_runtime_metrics().at("executions"), 1);
+}
+
+TEST(Runtime, DevicesAreFoundByTheirUUID) {
+  auto device = torch_tensorrt::core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU);
+  ASSERT_EQ(device.uuid.size(), std::string("GPU-xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx").size());
+  auto found = torch_tensorrt::core::runtime::find_device_by_uuid(device.uuid);
+  ASSERT_TRUE(found);
+  ASSERT_EQ(found->id, 0);
+  ASSERT_FALSE(torch_tensorrt::core::runtime::find_device_by_uuid("GPU-not-a-device"));
+
+  auto engine = build_relu_engine(at::randn({4, 16}, {at::kCUDA}));
+  engine->set_replica_device_uuids({device.uuid});
+  ASSERT_TRUE(engine->replicas.empty());
+  ASSERT_ANY_THROW(engine->set_replica_device_uuids({"GPU-not-a-device"}));
+}
+
+TEST(Runtime, MIGInstancesAreIdentifiedByTheirName) {
+  auto mig = torch_tensorrt::core::runtime::RTDevice("0%8%0%0%NVIDIA A100-SXM4-40GB MIG 1g.5gb");
+  ASSERT_EQ(mig.getMIGProfile(), "1g.5gb");
+  ASSERT_EQ(mig.getBaseName(), "NVIDIA A100-SXM4-40GB");
+
+  auto gpu = torch_tensorrt::core::runtime::RTDevice("0%8%0%0%NVIDIA A100-SXM4-40GB");
+  ASSERT_EQ(gpu.getMIGProfile(), "");
+  ASSERT_EQ(gpu.getBaseName(), gpu.device_name);
+}
@@ -0,0 +1,60 @@
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+using torch_tensorrt::core::runtime::LatencyHistogram;
+
+TEST(Runtime, LatencyHistogramBucketsByPowerOfTwoMicroseconds) {
+  LatencyHistogram h;
+  h.record(500); // < 1us
+  h.record(1500); // 1us
+  h.record(3000); // 3us
+  h.record(int64_t(1) << 62); // Overflow bucket
+
+  auto counts = h.bucket_counts();
+  ASSERT_EQ(counts.size(), LatencyHistogram::kNumBuckets);
+  ASSERT_EQ(counts.get(0), 1);
+  ASSERT_EQ(counts.get(1), 1);
+  ASSERT_EQ(counts.get(2), 1);
+  ASSERT_EQ(counts.get(LatencyHistogram::kNumBuckets - 1), 1);
+  ASSERT_EQ(h.count, 4);
+  ASSERT_EQ(h.max_ns, int64_t(1) << 62);
+
+  h.reset();
+  ASSERT_EQ(h.count, 0);
+  ASSERT_EQ(h.bucket_counts().get(0), 0);
+}
+
+TEST(Runtime, EngineRecordsRuntimeMetrics) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto engine = torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+
+  for (int i = 0; i < 3; i++) {
+    torch_tensorrt::core::runtime::execute_engine({in}, engine);
+  }
+
+  auto counters = engine->get_runtime_metrics();
+  ASSERT_EQ(counters.at("executions"), 3);
+  ASSERT_EQ(counters.at("shape_changes"), 1);
+  ASSERT_EQ(counters.at("execute_count"), 3);
+  ASSERT_EQ(counters.at("enqueue_count"), 3);
+
+  auto histograms = engine->get_latency_histograms();
+  int64_t total = 0;
+  for (auto c : histograms.at("execute")) {
+    total += c;
+  }
+  ASSERT_EQ(total, 3);
+
+  engine->reset_runtime_metrics();
+  ASSERT_EQ(engine->get_runtime_metrics().at("executions"), 0);
+}
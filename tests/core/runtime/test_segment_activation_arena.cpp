@@ -0,0 +1,73 @@
+#include "core/runtime/SegmentActivationArena.h"
+#include "gtest/gtest.h"
+
+namespace {
+// Two outputs of step 0 read by steps 1 and 2, one output of step 1 and one of step 2 read by step 2 and 3
+c10::intrusive_ptr<torch_tensorrt::core::runtime::SegmentActivationArena> chain_arena() {
+  return c10::make_intrusive<torch_tensorrt::core::runtime::SegmentActivationArena>(
+      "chain",
+      std::vector<torch_tensorrt::core::runtime::ActivationLifetime>{{0, 0, 1}, {0, 1, 2}, {1, 0, 2}, {2, 0, 3}});
+}
+
+std::vector<at::Tensor> run_chain(torch_tensorrt::core::runtime::SegmentActivationArena& arena) {
+  return {
+      arena.allocate(0, 0, {256}, at::kFloat),
+      arena.allocate(0, 1, {256}, at::kFloat),
+      arena.allocate(1, 0, {16, 16}, at::kHalf),
+      arena.allocate(2, 0, {256}, at::kFloat)};
+}
+
+bool overlap(const at::Tensor& a, const at::Tensor& b) {
+  auto a_begin = static_cast<const char*>(a.data_ptr());
+  auto b_begin = static_cast<const char*>(b.data_ptr());
+  return a_begin < b_begin + b.nbytes() && b_begin < a_begin + a.nbytes();
+}
+} // namespace
+
+TEST(Runtime, SegmentActivationArenaReusesMemoryOfDeadTensors) {
+  auto arena = chain_arena();
+  run_chain(*arena);
+  // The arena is sized to the peak of the first call from the second call on
+  auto outputs = run_chain(*arena);
+  ASSERT_EQ(arena->get_size(), 2 * 1024 + 512);
+  for (auto& t : outputs) {
+    ASSERT_TRUE(t.defined());
+    ASSERT_TRUE(t.is_cuda());
+    ASSERT_TRUE(t.is_contiguous());
+  }
+  ASSERT_EQ(outputs[2].scalar_type(), at::kHalf);
+  ASSERT_EQ(outputs[2].sizes(), c10::IntArrayRef({16, 16}));
+
+  // Tensors which are live at the same time never overlap
+  ASSERT_FALSE(overlap(outputs[0], outputs[1]));
+  ASSERT_FALSE(overlap(outputs[0], outputs[2]));
+  ASSERT_FALSE(overlap(outputs[1], outputs[2]));
+  ASSERT_FALSE(overlap(outputs[1], outputs[3]));
+  ASSERT_FALSE(overlap(outputs[2], outputs[3]));
+  // Output 0 of step 0 was last read by step 1
+  ASSERT_EQ(outputs[3].data_ptr(), outputs[0].data_ptr());
+
+  // The placements are stable across calls with the same shapes
+  auto next = run_chain(*arena);
+  for (size_t i = 0; i < outputs.size(); i++) {
+    ASSERT_EQ(next[i].data_ptr(), outputs[i].data_ptr());
+  }
+}
+
+TEST(Runtime, SegmentActivationArenaOnlyPlacesPlannedOutputs) {
+  auto arena = chain_arena();
+  ASSERT_FALSE(arena->allocate(1, 1, {256}, at::kFloat).defined());
+  ASSERT_FALSE(arena->allocate(3, 0, {256}, at::kFloat).defined());
+}
+
+TEST(Runtime, SegmentActivationArenaSerializesItsPlan) {
+  auto arena = chain_arena();
+  torch_tensorrt::core::runtime::SegmentActivationArena deserialized(arena->serialize());
+  ASSERT_EQ(deserialized.name, "chain");
+  ASSERT_EQ(deserialized.lifetimes.size(), arena->lifetimes.size());
+  for (size_t i = 0; i < arena->lifetimes.size(); i++) {
+    ASSERT_EQ(deserialized.lifetimes[i].step, arena->lifetimes[i].step);
+    ASSERT_EQ(deserialized.lifetimes[i].output, arena->lifetimes[i].output);
+    ASSERT_EQ(deserialized.lifetimes[i].last_use, arena->lifetimes[i].last_use);
+  }
+}
@@ -0,0 +1,58 @@
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+TEST(Runtime, InputShapesAreRecordedPerEngine) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto engine = torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+
+  torch_tensorrt::core::runtime::execute_engine({in}, engine);
+  ASSERT_EQ(engine->get_input_shape_histogram().size(), 0);
+
+  torch_tensorrt::core::runtime::RECORD_INPUT_SHAPES = true;
+  for (int i = 0; i < 3; i++) {
+    torch_tensorrt::core::runtime::execute_engine({in}, engine);
+  }
+  torch_tensorrt::core::runtime::RECORD_INPUT_SHAPES = false;
+  auto histogram = engine->get_input_shape_histogram();
+  ASSERT_EQ(histogram.size(), 1);
+  ASSERT_EQ(histogram.at("(4,16)"), 3);
+
+  engine->reset_input_shape_histogram();
+  ASSERT_EQ(engine->get_input_shape_histogram().size(), 0);
+}
+
+TEST(Runtime, ShapeProfilesAreDerivedFromClustersOfRecordedShapes) {
+  using torch_tensorrt::core::runtime::InputShapeSample;
+  // Small batches of short sequences and large batches of long sequences
+  std::vector<InputShapeSample> samples = {
+      {{{1, 32}}, 50},
+      {{{2, 48}}, 10},
+      {{{4, 64}}, 5},
+      {{{32, 512}}, 20},
+      {{{64, 384}}, 2},
+      {{{48, 512}}, 4},
+  };
+  auto profiles = torch_tensorrt::core::runtime::derive_shape_profiles(samples, 2);
+  ASSERT_EQ(profiles.size(), 2);
+  ASSERT_EQ(profiles[0].min[0], std::vector<int64_t>({1, 32}));
+  ASSERT_EQ(profiles[0].opt[0], std::vector<int64_t>({1, 32}));
+  ASSERT_EQ(profiles[0].max[0], std::vector<int64_t>({4, 64}));
+  ASSERT_EQ(profiles[1].min[0], std::vector<int64_t>({32, 384}));
+  ASSERT_EQ(profiles[1].opt[0], std::vector<int64_t>({32, 512}));
+  ASSERT_EQ(profiles[1].max[0], std::vector<int64_t>({64, 512}));
+
+  // No more profiles than distinct shapes
+  ASSERT_EQ(torch_tensorrt::core::runtime::derive_shape_profiles(samples, 10).size(), samples.size());
+  ASSERT_ANY_THROW(torch_tensorrt::core::runtime::derive_shape_profiles({}, 2));
+  ASSERT_ANY_THROW(torch_tensorrt::core::runtime::derive_shape_profiles({{{{1, 2}}, 1}, {{{1, 2, 3}}, 1}}, 2));
+}
@@ -0,0 +1,43 @@
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_dynamic_relu_engine() {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  // Batch sizes 2 to 8
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {at::randn({4, 16}, {at::kCUDA})}, true);
+}
+} // namespace
+
+TEST(Runtime, InferredOutputsAreMetaTensors) {
+  auto engine = build_dynamic_relu_engine();
+  for (int64_t batch : {2, 8, 2}) {
+    auto inferred = engine->infer_outputs({{batch, 16}});
+    ASSERT_EQ(inferred.size(), 1);
+    ASSERT_TRUE(inferred[0].is_meta());
+    ASSERT_EQ(inferred[0].sizes(), at::IntArrayRef({batch, 16}));
+    ASSERT_EQ(inferred[0].scalar_type(), at::kFloat);
+  }
+}
+
+TEST(Runtime, ShapeInferenceLeavesTheExecutionContextsAlone) {
+  auto engine = build_dynamic_relu_engine();
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  torch_tensorrt::core::runtime::execute_engine({in}, engine);
+  auto shape_changes = engine->get_runtime_metrics().at("shape_changes");
+
+  ASSERT_EQ(engine->infer_outputs({{8, 16}})[0].sizes(), at::IntArrayRef({8, 16}));
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  // The slot still has the shapes of the previous execution
+  ASSERT_EQ(engine->get_runtime_metrics().at("shape_changes"), shape_changes);
+}
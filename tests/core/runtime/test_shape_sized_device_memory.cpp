@@ -0,0 +1,78 @@
+#include <algorithm>
+
+#include "core/conversion/conversion.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+// Linear layer over batches of 1 to 256
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_dynamic_linear_engine(at::Tensor w) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor, %1 : Float(64, 64, strides=[64, 1])):
+        %2 : None = prim::Constant()
+        %3 : Tensor = aten::linear(%0, %1, %2)
+        %4 : Tensor = aten::relu(%3)
+        return (%4))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w});
+  auto spec = torch_tensorrt::core::ir::Input({1, 64}, {8, 64}, {256, 64});
+  std::vector<const torch::jit::Value*> var_ins = {g->inputs()[0]};
+  auto info = torch_tensorrt::core::conversion::ConversionInfo();
+  info.inputs = torch_tensorrt::core::ir::pair_input_vals_with_specs(var_ins, {spec});
+  auto eng = torch_tensorrt::core::conversion::ConvertBlockToEngine(g->block(), info, params);
+
+  auto cuda_device = torch_tensorrt::core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU);
+  return c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(
+      "test_engine", eng, cuda_device, std::vector<std::string>(), std::vector<std::string>());
+}
+} // namespace
+
+TEST(Runtime, ShapeSizedDeviceMemoryOnlyGrowsForLargerShapes) {
+  using namespace torch_tensorrt::core::runtime;
+  auto w = at::randn({64, 64}, {at::kCUDA});
+  auto engine = build_dynamic_linear_engine(w);
+  engine->set_shape_sized_device_memory(true);
+  auto& slot = *engine->exec_slots[0];
+
+  auto allocations = [&]() { return engine->get_runtime_metrics().at("device_memory_allocations"); };
+  int64_t largest = 0, allocated = 0;
+  for (int64_t batch : {8, 2, 8, 256, 4, 256}) {
+    auto in = at::randn({batch, 64}, {at::kCUDA});
+    auto out = execute_engine({in}, engine)[0];
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(at::linear(in, w))));
+    // Smaller shapes run out of the memory allocated for the larger ones
+    if (batch <= largest) {
+      ASSERT_EQ(allocations(), allocated);
+    }
+    largest = std::max(largest, batch);
+    allocated = allocations();
+  }
+  ASSERT_GE(allocated, 1);
+  ASSERT_LE(
+      static_cast<int64_t>(slot.shape_sized_device_memory.nbytes()), engine->cuda_engine->getDeviceMemorySizeV2());
+  ASSERT_EQ(
+      engine->get_memory_usage().at("activations"), static_cast<int64_t>(slot.shape_sized_device_memory.nbytes()));
+}
+
+TEST(Runtime, ReclaimReleasesShapeSizedDeviceMemory) {
+  using namespace torch_tensorrt::core::runtime;
+  auto w = at::randn({64, 64}, {at::kCUDA});
+  auto engine = build_dynamic_linear_engine(w);
+  engine->set_shape_sized_device_memory(true);
+  auto in = at::randn({16, 64}, {at::kCUDA});
+  auto expected = execute_engine({in}, engine)[0];
+  ASSERT_TRUE(engine->exec_slots[0]->shape_sized_device_memory.defined());
+
+  get_memory_reclaimer().reclaim(engine->device_info.id, RECLAIM_BUFFERS);
+  ASSERT_FALSE(engine->exec_slots[0]->shape_sized_device_memory.defined());
+  ASSERT_EQ(engine->get_memory_usage().at("activations"), 0);
+
+  // Allocated again for the shapes of the next execution
+  auto out = execute_engine({in}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::exactlyEqual(expected, out));
+  ASSERT_EQ(engine->get_runtime_metrics().at("device_memory_allocations"), 2);
+}
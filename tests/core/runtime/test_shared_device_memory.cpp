@@ -0,0 +1,39 @@
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_engine(const std::string& graph, at::Tensor in) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+} // namespace
+
+TEST(Runtime, EnginesSharingDeviceMemoryProduceCorrectResults) {
+  const auto relu_graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+  const auto mm_graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::matmul(%0, %0)
+        return (%1))IR";
+
+  auto in = at::randn({64, 64}, {at::kCUDA});
+  auto relu_engine = build_engine(relu_graph, in);
+  auto mm_engine = build_engine(mm_graph, in);
+  mm_engine->share_device_memory(relu_engine);
+  ASSERT_NE(relu_engine->shared_device_memory, nullptr);
+  ASSERT_EQ(relu_engine->shared_device_memory, mm_engine->shared_device_memory);
+
+  // Chain the engines the way segments of a partitioned module are executed
+  for (int i = 0; i < 4; i++) {
+    auto relu_out = torch_tensorrt::core::runtime::execute_engine({in}, relu_engine)[0];
+    auto mm_out = torch_tensorrt::core::runtime::execute_engine({relu_out}, mm_engine)[0];
+    auto expected = at::matmul(at::relu(in), at::relu(in));
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(mm_out, expected));
+  }
+}
@@ -0,0 +1,85 @@
+#include "core/conversion/conversion.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_relu_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+
+torch_tensorrt::core::util::SerializedEngine build_version_compatible_relu_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto info = torch_tensorrt::core::conversion::ConversionInfo();
+  info.inputs = torch_tensorrt::core::ir::pair_input_vals_with_specs(
+      {g->inputs()[0]}, {torch_tensorrt::core::ir::Input(in.sizes().vec())});
+  info.engine_settings.version_compatible = true;
+  return torch_tensorrt::core::conversion::ConvertBlockToEngine(g->block(), info, params);
+}
+} // namespace
+
+TEST(Runtime, EnginesOnTheSameDeviceShareARuntime) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto a = build_relu_engine(in);
+  auto b = build_relu_engine(in);
+
+  ASSERT_EQ(a->rt, b->rt);
+  ASSERT_EQ(a->rt, torch_tensorrt::core::runtime::get_shared_trt_runtime(a->device_info.id));
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(
+      torch_tensorrt::core::runtime::execute_engine({in}, b)[0], at::relu(in)));
+}
+
+TEST(Runtime, EnginesCanOptOutOfTheSharedRuntime) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto shared = build_relu_engine(in);
+
+  torch_tensorrt::core::runtime::SHARE_TRT_RUNTIME = false;
+  auto isolated = build_relu_engine(in);
+  torch_tensorrt::core::runtime::SHARE_TRT_RUNTIME = true;
+
+  ASSERT_NE(shared->rt, isolated->rt);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(
+      torch_tensorrt::core::runtime::execute_engine({in}, isolated)[0], at::relu(in)));
+}
+
+TEST(Runtime, VersionCompatibleEnginesRunWithEngineHostCodeAllowed) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto shared = build_relu_engine(in);
+  auto engine = build_version_compatible_relu_engine(in);
+  auto cuda_device = torch_tensorrt::core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU);
+
+  auto trt_engine = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(
+      "version_compatible",
+      engine,
+      cuda_device,
+      std::vector<std::string>{"input_0"},
+      std::vector<std::string>{"output_0"},
+      torch_tensorrt::core::runtime::get_current_platform(),
+      /*hardware_compatible=*/false,
+      /*serialized_metadata=*/"",
+      /*lazy_deserialization=*/true);
+  ASSERT_FALSE(trt_engine->get_engine_host_code_allowed());
+  trt_engine->set_engine_host_code_allowed(true);
+
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, trt_engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  // Runtimes with other options are not shared with the default one
+  ASSERT_NE(trt_engine->rt, shared->rt);
+  ASSERT_THROW(trt_engine->set_engine_host_code_allowed(false), c10::Error);
+}
@@ -0,0 +1,66 @@
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+// Accumulates x into the state h and returns the new state along with twice its value
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_accumulator_engine() {
+  const auto graph = R"IR(
+      graph(%x : Tensor, %h : Tensor):
+        %one : int = prim::Constant[value=1]()
+        %two : float = prim::Constant[value=2.]()
+        %s : Tensor = aten::add(%x, %h, %one)
+        %y : Tensor = aten::mul(%s, %two)
+        return (%s, %y))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto engine = torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in, in});
+  engine->set_state_bindings({engine->out_binding_names[0]}, {engine->in_binding_names[1]});
+  return engine;
+}
+
+void run_steps(const c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine>& engine) {
+  auto h = at::zeros({4, 16}, {at::kCUDA});
+  for (int i = 0; i < 5; i++) {
+    auto x = at::randn({4, 16}, {at::kCUDA});
+    auto outputs = torch_tensorrt::core::runtime::execute_engine({x}, engine);
+    h = h + x;
+    // Only the output which is not a state is returned
+    ASSERT_EQ(outputs.size(), 1);
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(outputs[0], h * 2));
+  }
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(engine->get_state()[0], h));
+}
+} // namespace
+
+TEST(Runtime, StateBindingsFeedOutputsBackAsInputs) {
+  auto engine = build_accumulator_engine();
+  run_steps(engine);
+
+  engine->reset_state({});
+  run_steps(engine);
+}
+
+TEST(Runtime, StateBindingsReplayCudaGraphsAgainstTheStateBuffers) {
+  auto engine = build_accumulator_engine();
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::SUBGRAPH_CUDAGRAPHS;
+  run_steps(engine);
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::STANDARD;
+  // One graph for each buffer the state is read from
+  ASSERT_EQ(engine->get_cudagraph_cache_stats().at("entries"), 2);
+  ASSERT_EQ(engine->get_runtime_metrics().at("cudagraph_misses"), 2);
+}
+
+TEST(Runtime, StateBindingsStartFromTheInitialState) {
+  auto engine = build_accumulator_engine();
+  auto h0 = at::randn({4, 16}, {at::kCUDA});
+  engine->reset_state({h0});
+  auto x = at::randn({4, 16}, {at::kCUDA});
+  auto out = torch_tensorrt::core::runtime::execute_engine({x}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, (h0 + x) * 2));
+  ASSERT_ANY_THROW(torch_tensorrt::core::runtime::execute_engine({x, h0}, engine));
+}
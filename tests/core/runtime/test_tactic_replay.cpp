@@ -0,0 +1,92 @@
+#include <filesystem>
+#include <random>
+
+#include "core/conversion/conversion.h"
+#include "core/conversion/conversionctx/TacticSelector.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+std::string temp_tactic_file() {
+  auto path =
+      std::filesystem::temp_directory_path() / ("torchtrt_tactics_" + std::to_string(std::random_device{}()) + ".txt");
+  std::filesystem::remove(path);
+  return path.string();
+}
+
+struct ConvGraph {
+  std::shared_ptr<torch::jit::Graph> g = std::make_shared<torch::jit::Graph>();
+  torch_tensorrt::core::ir::StaticParams params;
+  torch_tensorrt::core::conversion::ConversionInfo info;
+
+  explicit ConvGraph(at::Tensor w) {
+    const auto ir = R"IR(
+      graph(%0 : Tensor, %1 : Float(8, 3, 3, 3, strides=[27, 9, 3, 1])):
+        %2 : NoneType = prim::Constant()
+        %3 : int[] = prim::Constant[value=[1, 1]]()
+        %4 : int[] = prim::Constant[value=[0, 0]]()
+        %5 : bool = prim::Constant[value=0]()
+        %6 : int = prim::Constant[value=1]()
+        %7 : Tensor = aten::_convolution(%0, %1, %2, %3, %4, %3, %5, %4, %6, %5, %5, %5, %5)
+        %8 : Tensor = aten::relu(%7)
+        return (%8))IR";
+    torch::jit::parseIR(ir, g.get());
+    params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w});
+    std::vector<const torch::jit::Value*> var_ins = {g->inputs()[0]};
+    info.inputs = torch_tensorrt::core::ir::pair_input_vals_with_specs(
+        var_ins, {torch_tensorrt::core::ir::Input({1, 3, 16, 16})});
+  }
+
+  std::string key() {
+    return torch_tensorrt::core::conversion::EngineCacheKey(
+        g->block(), info.engine_settings, info.inputs, info.collection_input_spec_map, params);
+  }
+};
+} // namespace
+
+TEST(Runtime, TacticFileRoundTripsThroughDisk) {
+  auto path = temp_tactic_file();
+  {
+    torch_tensorrt::core::conversion::TacticFile file(path);
+    ASSERT_FALSE(file.has_engine("engine"));
+    file.set("engine", "conv\tlayer", "1:2|float");
+    file.set("engine", "relu", "3:4|float");
+    file.save();
+  }
+  torch_tensorrt::core::conversion::TacticFile file(path);
+  ASSERT_TRUE(file.has_engine("engine"));
+  ASSERT_EQ(file.find("engine", "conv\tlayer"), "1:2|float");
+  ASSERT_EQ(file.find("engine", "relu"), "3:4|float");
+  ASSERT_EQ(file.find("engine", "pool"), "");
+  ASSERT_EQ(file.find("other", "relu"), "");
+  std::filesystem::remove(path);
+}
+
+TEST(Runtime, RecordedTacticsAreReplayedForTheSameEngine) {
+  auto path = temp_tactic_file();
+  auto w = at::randn({8, 3, 3, 3}, {at::kCUDA});
+  ConvGraph record(w);
+  record.info.engine_settings.tactic_record_path = path;
+  torch_tensorrt::core::conversion::ConvertBlockToEngine(record.g->block(), record.info, record.params);
+  ASSERT_TRUE(torch_tensorrt::core::conversion::TacticFile(path).has_engine(record.key()));
+
+  // The tactic paths are not part of the key, recording and replaying builds look up the same entry
+  ConvGraph replay(w);
+  replay.info.engine_settings.tactic_replay_path = path;
+  ASSERT_EQ(replay.key(), record.key());
+  auto serialized =
+      torch_tensorrt::core::conversion::ConvertBlockToEngine(replay.g->block(), replay.info, replay.params);
+
+  auto in = at::randn({1, 3, 16, 16}, {at::kCUDA});
+  auto engine = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(
+      "replayed_engine",
+      serialized,
+      torch_tensorrt::core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU),
+      std::vector<std::string>(),
+      std::vector<std::string>());
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(at::conv2d(in, w)), 2e-5));
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,41 @@
+#include "core/runtime/runtime.h"
+#include "core/util/gpu_allocator.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_relu_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+} // namespace
+
+TEST(Runtime, EnginesAllocateFromTheTorchCachingAllocatorWhenEnabled) {
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  auto allocator = torch_tensorrt::core::util::get_torch_gpu_allocator();
+  auto default_engine = build_relu_engine(in);
+  auto before = allocator->num_allocations();
+
+  torch_tensorrt::core::util::set_torch_gpu_allocator_enabled(true);
+  auto engine = build_relu_engine(in);
+  torch_tensorrt::core::util::set_torch_gpu_allocator_enabled(false);
+
+  // Runtimes keep the allocator they were created with, so the engines do not share one
+  ASSERT_NE(default_engine->rt, engine->rt);
+  ASSERT_GT(allocator->num_allocations(), before);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(
+      torch_tensorrt::core::runtime::execute_engine({in}, engine)[0], at::relu(in)));
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(
+      torch_tensorrt::core::runtime::execute_engine({in}, default_engine)[0], at::relu(in)));
+
+  engine.reset();
+  ASSERT_EQ(allocator->num_allocations(), before);
+}
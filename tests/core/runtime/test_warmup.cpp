@@ -0,0 +1,55 @@
+#include "core/conversion/conversion.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_dynamic_relu_engine() {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+
+  auto spec = torch_tensorrt::core::ir::Input({1, 16}, {8, 16}, {16, 16});
+  std::vector<const torch::jit::Value*> var_ins = {g->inputs()[0]};
+  auto info = torch_tensorrt::core::conversion::ConversionInfo();
+  info.inputs = torch_tensorrt::core::ir::pair_input_vals_with_specs(var_ins, {spec});
+  auto eng = torch_tensorrt::core::conversion::ConvertBlockToEngine(g->block(), info, params);
+
+  auto cuda_device = torch_tensorrt::core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU);
+  return c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(
+      "test_engine", eng, cuda_device, std::vector<std::string>(), std::vector<std::string>());
+}
+} // namespace
+
+TEST(Runtime, WarmupRunsTheProfileShapesWithoutCountingThem) {
+  auto engine = build_dynamic_relu_engine();
+  engine->warmup(2);
+  ASSERT_EQ(engine->get_runtime_metrics().at("executions"), 0);
+
+  auto in = at::randn({8, 16}, {at::kCUDA});
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  ASSERT_EQ(engine->get_runtime_metrics().at("executions"), 1);
+}
+
+TEST(Runtime, WarmupCapturesCudaGraphsForTheProfileShapes) {
+  auto engine = build_dynamic_relu_engine();
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::SUBGRAPH_CUDAGRAPHS;
+  engine->warmup(1);
+  // min, opt and max shapes
+  ASSERT_EQ(engine->get_cudagraph_cache_stats().at("entries"), 3);
+
+  for (int64_t batch : {1, 8, 16}) {
+    auto in = at::randn({batch, 16}, {at::kCUDA});
+    auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in)));
+  }
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::STANDARD;
+  ASSERT_EQ(engine->get_runtime_metrics().at("cudagraph_misses"), 0);
+}
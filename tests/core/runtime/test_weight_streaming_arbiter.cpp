@@ -0,0 +1,95 @@
+#include "core/conversion/conversion.h"
+#include "core/runtime/WeightStreamingArbiter.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+#if NV_TENSORRT_MAJOR >= 10
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_streaming_engine(at::Tensor in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor, %1 : Float(1024, 1024, strides=[1024, 1])):
+        %2 : None = prim::Constant()
+        %3 : Tensor = aten::linear(%0, %1, %2)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto w = at::randn({1024, 1024}, {at::kCUDA});
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w});
+  auto info = torch_tensorrt::core::conversion::ConversionInfo();
+  info.inputs = torch_tensorrt::core::ir::pair_input_vals_with_specs(
+      {g->inputs()[0]}, {torch_tensorrt::core::ir::Input(in.sizes().vec())});
+  info.engine_settings.strongly_typed = true;
+  info.engine_settings.weight_streaming = true;
+  auto eng = torch_tensorrt::core::conversion::ConvertBlockToEngine(g->block(), info, params);
+  auto cuda_device = torch_tensorrt::core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU);
+  return c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(
+      "test_engine", eng, cuda_device, std::vector<std::string>(), std::vector<std::string>());
+}
+} // namespace
+
+TEST(Runtime, WeightStreamingArbiterKeepsActiveEnginesResident) {
+  auto& arbiter = torch_tensorrt::core::runtime::get_weight_streaming_arbiter();
+  auto in = at::randn({8, 1024}, {at::kCUDA});
+  torch_tensorrt::core::runtime::WEIGHT_STREAMING_ARBITER = true;
+  auto a = build_streaming_engine(in);
+  auto b = build_streaming_engine(in);
+  torch_tensorrt::core::runtime::WEIGHT_STREAMING_ARBITER = false;
+  ASSERT_EQ(arbiter.get_num_engines(), 2);
+
+  // Only one engine fits
+  auto streamable = a->get_streamable_device_memory_budget();
+  ASSERT_GT(streamable, 0);
+  arbiter.set_device_memory_limit(streamable);
+  arbiter.set_idle_timeout_ms(60000);
+
+  torch_tensorrt::core::runtime::execute_engine({in}, a);
+  ASSERT_EQ(a->get_device_memory_budget(), streamable);
+  ASSERT_EQ(b->get_device_memory_budget(), 0);
+
+  // a is still active, b waking up does not displace it
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, b)[0];
+  ASSERT_EQ(a->get_device_memory_budget(), streamable);
+  ASSERT_EQ(b->get_device_memory_budget(), 0);
+  ASSERT_TRUE(out.defined());
+
+  // Once a is idle, the memory goes to the engine which executes
+  arbiter.set_idle_timeout_ms(0);
+  torch_tensorrt::core::runtime::execute_engine({in}, b);
+  ASSERT_EQ(a->get_device_memory_budget(), 0);
+  ASSERT_EQ(b->get_device_memory_budget(), streamable);
+
+  // The weights of destroyed engines are handed to the others
+  b.reset();
+  ASSERT_EQ(arbiter.get_num_engines(), 1);
+  ASSERT_EQ(a->get_device_memory_budget(), streamable);
+  arbiter.set_device_memory_limit(0);
+  arbiter.set_idle_timeout_ms(10000);
+}
+
+TEST(Runtime, WeightStreamingArbiterAppliesBudgetsBetweenExecutions) {
+  auto& arbiter = torch_tensorrt::core::runtime::get_weight_streaming_arbiter();
+  auto in = at::randn({8, 1024}, {at::kCUDA});
+  torch_tensorrt::core::runtime::WEIGHT_STREAMING_ARBITER = true;
+  auto engine = build_streaming_engine(in);
+  torch_tensorrt::core::runtime::WEIGHT_STREAMING_ARBITER = false;
+  auto expected = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0].clone();
+
+  // A budget assigned while an execution is in flight waits for the next execution
+  auto streamable = engine->get_streamable_device_memory_budget();
+  auto budget = engine->get_device_memory_budget() == 0 ? streamable : int64_t(0);
+  {
+    auto slot = engine->acquire_execution_slot();
+    engine->pending_device_memory_budget = budget;
+    engine->apply_pending_device_memory_budget();
+    ASSERT_NE(engine->get_device_memory_budget(), budget);
+  }
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine)[0];
+  ASSERT_EQ(engine->get_device_memory_budget(), budget);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, expected));
+  engine.reset();
+  ASSERT_EQ(arbiter.get_num_engines(), 0);
+}
+#endif
@@ -0,0 +1,47 @@
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine> build_scale_engine() {
+  const auto graph = R"IR(
+      graph(%x : Tensor):
+        %two : float = prim::Constant[value=2.]()
+        %y : Tensor = aten::mul(%x, %two)
+        return (%y))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto in = at::randn({4, 16}, {at::kCUDA});
+  return torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+}
+} // namespace
+
+TEST(Runtime, IntegratedGPUsReadPinnedHostInputsInPlace) {
+  auto engine = build_scale_engine();
+  if (!engine->device_info.integrated) {
+    GTEST_SKIP() << "Zero copy inputs are only bound on integrated GPUs";
+  }
+  auto x = at::randn({4, 16}, at::TensorOptions().pinned_memory(true));
+  auto moves = engine->get_runtime_metrics().at("input_moves");
+  auto out = torch_tensorrt::core::runtime::execute_engine({x}, engine)[0];
+  ASSERT_TRUE(out.is_cuda());
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, x.to(at::kCUDA) * 2));
+  ASSERT_EQ(engine->get_runtime_metrics().at("input_moves"), moves);
+
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::SUBGRAPH_CUDAGRAPHS;
+  for (int i = 0; i < 2; i++) {
+    x = at::randn({4, 16}, at::TensorOptions().pinned_memory(true));
+    out = torch_tensorrt::core::runtime::execute_engine({x}, engine)[0];
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, x.to(at::kCUDA) * 2));
+  }
+  torch_tensorrt::core::runtime::CUDAGRAPHS_MODE = torch_tensorrt::core::runtime::STANDARD;
+}
+
+TEST(Runtime, PageableHostInputsAreRejected) {
+  auto engine = build_scale_engine();
+  auto x = at::randn({4, 16});
+  ASSERT_ANY_THROW(torch_tensorrt::core::runtime::execute_engine({x}, engine));
+}
@@ -0,0 +1,68 @@
+#include <string>
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+TEST(CppAPITest, AutotuneReturnsTheFastestConfiguration) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+  mod.to(at::kCUDA);
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  torch_tensorrt::ts::AutotuneOptions options;
+  options.min_block_sizes = {1, 3};
+  options.warmup_iters = 2;
+  options.iters = 5;
+  auto in = at::randn({1, 3, 224, 224}, {at::kCUDA});
+  torch_tensorrt::ts::AutotuneReport report;
+  auto trt_mod = torch_tensorrt::ts::autotune(mod, spec, {{in}}, report, options);
+  ASSERT_FALSE(torch_tensorrt::ts::get_cudagraphs_enabled());
+
+  // 2 builds, each with and without CUDA graphs and pre-allocated outputs
+  ASSERT_EQ(report.candidates.size(), 8u);
+  ASSERT_GE(report.best, 0);
+  for (const auto& c : report.candidates) {
+    ASSERT_TRUE(c.error.empty()) << c.error;
+    ASSERT_GE(c.p50_latency_ms, report.candidates[report.best].p50_latency_ms);
+  }
+  ASSERT_NE(report.to_json().find("\"best\": " + std::to_string(report.best)), std::string::npos);
+
+  auto jit_results = torch_tensorrt::tests::util::RunModuleForward(mod, {in.clone()}).toTensor();
+  auto trt_results = torch_tensorrt::tests::util::RunModuleForward(trt_mod, {in.clone()}).toTensor();
+  ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(jit_results, trt_results));
+}
+
+TEST(CppAPITest, AutotuneBoundsTheNumberOfBuilds) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+  mod.to(at::kCUDA);
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  torch_tensorrt::ts::AutotuneOptions options;
+  options.min_block_sizes = {1, 3, 8};
+  options.tune_cudagraphs = false;
+  options.tune_pre_allocated_outputs = false;
+  options.max_builds = 2;
+  options.warmup_iters = 1;
+  options.iters = 2;
+  torch_tensorrt::ts::AutotuneReport report;
+  torch_tensorrt::ts::autotune(mod, spec, {{at::randn({1, 3, 224, 224}, {at::kCUDA})}}, report, options);
+  ASSERT_EQ(report.candidates.size(), 2u);
+}
+
+#endif
@@ -0,0 +1,51 @@
+#include <string>
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+TEST(CppAPITest, BackgroundBuildRunsTorchUntilEnginesAreReady) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+  mod.to(torch::kCUDA);
+
+  auto in = at::randint(5, {1, 3, 224, 224}, {at::kCUDA});
+  auto expected = torch_tensorrt::tests::util::RunModuleForward(mod, {in.clone()}).toTensor();
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  spec.background_build = true;
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+  // Runs either in Torch or on the engines built so far
+  auto out = torch_tensorrt::tests::util::RunModuleForward(trt_mod, {in.clone()}).toTensor();
+  ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(out, expected));
+
+  ASSERT_TRUE(torch_tensorrt::ts::wait_for_background_builds(trt_mod));
+  ASSERT_GE(torch_tensorrt::ts::get_engine_handles(trt_mod).size(), 1);
+  out = torch_tensorrt::tests::util::RunModuleForward(trt_mod, {in.clone()}).toTensor();
+  ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(out, expected));
+}
+
+TEST(CppAPITest, BackgroundBuildRequiresPartialCompilation) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  spec.background_build = true;
+  spec.require_full_compilation = true;
+  ASSERT_ANY_THROW(torch_tensorrt::ts::compile(mod, spec));
+}
+#endif
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <string>
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+namespace {
+bool has_phase(const torch_tensorrt::ts::CompileReport& report, const std::string& phase, const std::string& segment) {
+  return std::any_of(report.phases.begin(), report.phases.end(), [&](const auto& p) {
+    return p.phase == phase && p.segment == segment;
+  });
+}
+} // namespace
+
+TEST(CppAPITest, CompileReportCoversEveryPhase) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  torch_tensorrt::ts::CompileReport report;
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec, report);
+
+  ASSERT_TRUE(has_phase(report, "lowering", ""));
+  ASSERT_TRUE(has_phase(report, "conversion", ""));
+  ASSERT_TRUE(has_phase(report, "build", ""));
+  // The whole compilation finishes last and contains every other phase
+  ASSERT_EQ(report.phases.back().phase, "compile");
+  for (const auto& p : report.phases) {
+    ASSERT_LE(p.wall_time_ns, report.phases.back().wall_time_ns);
+    ASSERT_GT(p.peak_host_bytes, 0);
+    ASSERT_GT(p.peak_gpu_bytes, 0);
+  }
+}
+
+TEST(CppAPITest, CompileReportRecordsPhasesPerSegment) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  spec.torch_executed_ops.push_back("aten::max_pool2d");
+  spec.min_block_size = 1;
+  torch_tensorrt::ts::CompileReport report;
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec, report);
+
+  ASSERT_TRUE(has_phase(report, "partitioning", ""));
+  ASSERT_TRUE(has_phase(report, "shape_analysis/opt", ""));
+  ASSERT_TRUE(has_phase(report, "build", "segment_0"));
+  ASSERT_TRUE(has_phase(report, "build", "segment_1"));
+  ASSERT_NE(report.to_json().find("\"segment\": \"segment_1\""), std::string::npos);
+}
+
+TEST(CppAPITest, CompileReportSplitsDeviceMemoryBudgetAcrossSegments) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  spec.torch_executed_ops.push_back("aten::max_pool2d");
+  spec.min_block_size = 1;
+  spec.device_memory_budget = 1 << 30;
+  torch_tensorrt::ts::CompileReport report;
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec, report);
+
+  ASSERT_EQ(report.engine_memory.size(), 2);
+  int64_t budgeted = 0;
+  int64_t device_memory = 0;
+  for (const auto& e : report.engine_memory) {
+    ASSERT_GT(e.budget, 0);
+    ASSERT_GE(e.device_memory, 0);
+    budgeted += e.budget;
+    device_memory += e.device_memory;
+  }
+  ASSERT_LE(budgeted, spec.device_memory_budget);
+  ASSERT_EQ(report.device_memory_budget_met, device_memory <= static_cast<int64_t>(spec.device_memory_budget));
+}
+
+TEST(CppAPITest, CompileReportFlagsExceededDeviceMemoryBudget) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{8, 3, 224, 224}});
+  // Too little for the activations of the network alone
+  spec.device_memory_budget = 1 << 20;
+  torch_tensorrt::ts::CompileReport report;
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec, report);
+
+  ASSERT_EQ(report.engine_memory.size(), 1);
+  ASSERT_EQ(report.engine_memory[0].budget, 1 << 20);
+  ASSERT_GT(report.engine_memory[0].device_memory, 1 << 20);
+  ASSERT_FALSE(report.device_memory_budget_met);
+}
+#endif
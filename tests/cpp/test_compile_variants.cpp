@@ -0,0 +1,95 @@
+#include <string>
+#include <thread>
+#include "c10/cuda/CUDAFunctions.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+TEST(CppAPITest, CompileVariantsMatchesSeparateCompilations) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+
+  std::vector<torch_tensorrt::ts::CompileSpec> specs;
+  specs.push_back(torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}}));
+  specs.push_back(torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{4, 3, 224, 224}}));
+  specs.push_back(torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{4, 3, 224, 224}}));
+  specs[2].enabled_precisions = {torch_tensorrt::DataType::kHalf};
+  for (auto& spec : specs) {
+    spec.timing_cache_path = "/tmp/test_compile_variants.cache";
+  }
+  auto trt_mods = torch_tensorrt::ts::compile_variants(mod, specs);
+  ASSERT_EQ(trt_mods.size(), specs.size());
+
+  for (size_t i = 0; i < specs.size(); i++) {
+    auto in = at::randint(5, specs[i].graph_inputs.inputs[0].shape, {at::kCUDA});
+    auto jit_results = torch_tensorrt::tests::util::RunModuleForward(mod, {in.clone()}).toTensor();
+    auto trt_results = torch_tensorrt::tests::util::RunModuleForward(trt_mods[i], {in.clone()}).toTensor();
+    ASSERT_EQ(trt_results.sizes(), jit_results.sizes());
+    ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(jit_results, trt_results.to(jit_results.scalar_type())));
+  }
+}
+
+TEST(CppAPITest, CompileVariantsRethrowsBuildErrors) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+
+  std::vector<torch_tensorrt::ts::CompileSpec> specs;
+  specs.push_back(torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}}));
+  specs.push_back(torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}}));
+  // Not a GPU of this system
+  specs[1].build_gpu_ids = {1024};
+  ASSERT_THROW(torch_tensorrt::ts::compile_variants(mod, specs), c10::Error);
+}
+
+TEST(CppAPITest, ConcurrentCompilationsKeepTheDeviceOfTheirThread) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+
+  std::vector<torch::jit::Module> trt_mods(2);
+  std::vector<c10::DeviceIndex> devices_after(2, -1);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < trt_mods.size(); t++) {
+    threads.emplace_back([&, t]() {
+      auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+      if (t == 1) {
+        spec.enabled_precisions = {torch_tensorrt::DataType::kHalf};
+      }
+      c10::cuda::set_device(0);
+      trt_mods[t] = torch_tensorrt::ts::compile(mod, spec);
+      devices_after[t] = c10::cuda::current_device();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto in = at::randint(5, {1, 3, 224, 224}, {at::kCUDA});
+  auto jit_results = torch_tensorrt::tests::util::RunModuleForward(mod, {in.clone()}).toTensor();
+  for (size_t t = 0; t < trt_mods.size(); t++) {
+    ASSERT_EQ(devices_after[t], 0);
+    auto trt_results = torch_tensorrt::tests::util::RunModuleForward(trt_mods[t], {in.clone()}).toTensor();
+    ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(jit_results, trt_results.to(jit_results.scalar_type())));
+  }
+}
+#endif
@@ -0,0 +1,68 @@
+#include <string>
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/cudagraphs_module.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+TEST(CppAPITest, CudaGraphsModuleReplaysPartitionedModulesPerInputShape) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_scripted.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    ASSERT_TRUE(false);
+  }
+  mod.eval();
+
+  const std::vector<std::vector<int64_t>> input_shapes = {{1, 3, 224, 224}, {2, 3, 224, 224}, {2, 3, 224, 224}};
+  std::vector<torch_tensorrt::Input> inputs;
+  inputs.push_back(torch_tensorrt::Input(input_shapes[0], input_shapes[1], input_shapes[2]));
+  torch_tensorrt::ts::CompileSpec spec(inputs);
+  spec.torch_executed_modules.push_back("torchvision.models.resnet.BasicBlock");
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+
+  torch_tensorrt::runtime::CudaGraphsModule graphs(trt_mod);
+  for (int64_t batch : {1, 2, 1, 2}) {
+    auto in = at::randint(5, {batch, 3, 224, 224}, {at::kCUDA});
+    auto expected = mod.forward({in.clone()}).toTensor();
+    auto out = graphs.forward({in});
+    ASSERT_EQ(out.size(), 1);
+    ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(out[0], expected));
+  }
+  ASSERT_EQ(graphs.get_num_graphs(), 2);
+  ASSERT_EQ(graphs.get_num_captures(), 2);
+  ASSERT_EQ(graphs.get_num_replays(), 2);
+
+  graphs.reset();
+  ASSERT_EQ(graphs.get_num_graphs(), 0);
+}
+
+TEST(CppAPITest, CudaGraphsModuleEvictsLeastRecentlyUsedGraphs) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_scripted.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    ASSERT_TRUE(false);
+  }
+  mod.eval();
+
+  const std::vector<std::vector<int64_t>> input_shapes = {{1, 3, 224, 224}, {2, 3, 224, 224}, {2, 3, 224, 224}};
+  std::vector<torch_tensorrt::Input> inputs;
+  inputs.push_back(torch_tensorrt::Input(input_shapes[0], input_shapes[1], input_shapes[2]));
+  torch_tensorrt::ts::CompileSpec spec(inputs);
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+
+  torch_tensorrt::runtime::CudaGraphsModule graphs(trt_mod, /*max_graphs=*/1);
+  for (int64_t batch : {1, 2, 1}) {
+    graphs.forward({at::randn({batch, 3, 224, 224}, {at::kCUDA})});
+  }
+  ASSERT_EQ(graphs.get_num_graphs(), 1);
+  ASSERT_EQ(graphs.get_num_captures(), 3);
+  ASSERT_EQ(graphs.get_num_replays(), 0);
+}
+
+#endif
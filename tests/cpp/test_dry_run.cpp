@@ -0,0 +1,59 @@
+#include <string>
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+TEST(CppAPITest, DryRunReportsFullySupportedModuleAsOneEngine) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  auto report = torch_tensorrt::ts::dry_run(mod, spec);
+
+  ASSERT_EQ(report.segments.size(), 1);
+  auto& seg = report.segments[0];
+  ASSERT_TRUE(seg.tensorrt);
+  ASSERT_GT(seg.num_nodes, 0);
+  // ResNet18 runs about 1.8 GMACs on 11.7M parameters
+  ASSERT_GT(seg.flops, 3e9);
+  ASSERT_LT(seg.flops, 4.5e9);
+  ASSERT_GT(seg.weight_bytes, 11e6 * sizeof(float));
+  ASSERT_EQ(report.boundary_bytes, 0);
+  ASSERT_TRUE(report.unsupported_ops.empty());
+}
+
+TEST(CppAPITest, DryRunReportsSegmentsOfPartitionedModule) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  spec.torch_executed_ops.push_back("aten::max_pool2d");
+  spec.min_block_size = 1;
+  auto report = torch_tensorrt::ts::dry_run(mod, spec);
+
+  ASSERT_EQ(report.segments.size(), 3);
+  ASSERT_TRUE(report.segments[0].tensorrt);
+  ASSERT_FALSE(report.segments[1].tensorrt);
+  ASSERT_TRUE(report.segments[2].tensorrt);
+  ASSERT_EQ(report.segments[1].weight_bytes, 0);
+  // The input of the pooling and its output cross a boundary
+  ASSERT_GT(report.segments[1].boundary_bytes, 0);
+  ASSERT_GT(report.segments[2].boundary_bytes, 0);
+  ASSERT_EQ(report.boundary_bytes, report.segments[1].boundary_bytes + report.segments[2].boundary_bytes);
+  ASSERT_NE(report.to_json().find("\"tensorrt\": false"), std::string::npos);
+  ASSERT_NE(report.to_str().find("2 TensorRT and 1 PyTorch segments"), std::string::npos);
+}
+#endif
@@ -0,0 +1,86 @@
+#include <string>
+#include "c10/cuda/CUDAStream.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+TEST(CppAPITest, SingleEngineOfFullyConvertedModuleExecutesLikeForward) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+  auto handles = torch_tensorrt::ts::get_engine_handles(trt_mod);
+  ASSERT_EQ(handles.size(), 1);
+  auto engine = torch_tensorrt::ts::get_single_engine(trt_mod);
+  ASSERT_TRUE(engine.has_value());
+  ASSERT_EQ(engine->get_name(), handles[0].get_name());
+  ASSERT_EQ(engine->get_input_binding_names().size(), 1);
+
+  auto in = at::randint(5, {1, 3, 224, 224}, {at::kCUDA});
+  auto expected = torch_tensorrt::tests::util::RunModuleForward(trt_mod, {in.clone()}).toTensor();
+  auto out = engine->execute({in.clone()});
+  ASSERT_EQ(out.size(), 1);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out[0], expected));
+}
+
+TEST(CppAPITest, PartiallyConvertedModuleHasNoSingleEngine) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  spec.torch_executed_ops.push_back("aten::max_pool2d");
+  spec.min_block_size = 1;
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+  ASSERT_GE(torch_tensorrt::ts::get_engine_handles(trt_mod).size(), 1);
+  ASSERT_FALSE(torch_tensorrt::ts::get_single_engine(trt_mod).has_value());
+}
+
+TEST(CppAPITest, PreparedExecutionsLaunchLikeExecute) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+  auto engine = torch_tensorrt::ts::get_single_engine(trt_mod);
+  ASSERT_TRUE(engine.has_value());
+
+  auto first_in = at::randint(5, {1, 3, 224, 224}, {at::kCUDA});
+  auto second_in = at::randint(5, {1, 3, 224, 224}, {at::kCUDA});
+  auto first_expected = engine->execute({first_in.clone()});
+  auto second_expected = engine->execute({second_in.clone()});
+
+  // The second request is prepared while the first one runs on a side stream
+  auto stream = c10::cuda::getStreamFromPool();
+  auto first = engine->prepare({first_in});
+  auto first_out = engine->launch(first, stream.stream());
+  auto second = engine->prepare({second_in});
+  auto second_out = engine->launch(second, stream.stream());
+  ASSERT_THROW(engine->launch(second, stream.stream()), c10::Error);
+  stream.synchronize();
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(first_out[0], first_expected[0]));
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(second_out[0], second_expected[0]));
+}
+#endif
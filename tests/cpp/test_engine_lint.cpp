@@ -0,0 +1,55 @@
+#include <algorithm>
+#include <string>
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+TEST(CppAPITest, EngineLintMapsFP32LayersBackToTheirNodes) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  spec.enabled_precisions = {torch::kFloat, torch::kHalf};
+  spec.layer_precisions = {{"aten::_convolution", torch_tensorrt::DataType::kFloat}};
+  spec.detailed_layer_info = true;
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+
+  auto report = torch_tensorrt::ts::lint_engines(trt_mod, spec, {at::randn({1, 3, 224, 224}, {at::kCUDA})});
+  auto fp32_conv = std::find_if(report.findings.begin(), report.findings.end(), [](const auto& f) {
+    return f.kind == "fp32_layer" && std::any_of(f.nodes.begin(), f.nodes.end(), [](const auto& n) {
+             return n.find("aten::_convolution") != std::string::npos;
+           });
+  });
+  ASSERT_NE(fp32_conv, report.findings.end());
+  ASSERT_FALSE(fp32_conv->layers.empty());
+  for (size_t i = 1; i < report.findings.size(); i++) {
+    ASSERT_GE(report.findings[i - 1].time_ms, report.findings[i].time_ms);
+  }
+  ASSERT_NE(report.to_json().find("\"fp32_layer\""), std::string::npos);
+}
+
+TEST(CppAPITest, EngineLintNeedsDetailedLayerInfo) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  spec.enabled_precisions = {torch::kHalf};
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+  ASSERT_TRUE(torch_tensorrt::ts::lint_engines(trt_mod, spec).findings.empty());
+}
+#endif
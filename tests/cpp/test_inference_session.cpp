@@ -0,0 +1,60 @@
+#include <string>
+#include "c10/cuda/CUDAStream.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/inference_session.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+TEST(CppAPITest, InferenceSessionKeepsRequestsInFlightOnSeveralStreams) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+  std::vector<at::Tensor> inputs;
+  std::vector<at::Tensor> expected;
+  for (int i = 0; i < 4; i++) {
+    inputs.push_back(at::randint(5, {1, 3, 224, 224}, {at::kCUDA}));
+    expected.push_back(torch_tensorrt::tests::util::RunModuleForward(trt_mod, {inputs[i].clone()}).toTensor());
+  }
+  torch::cuda::synchronize();
+
+  torch_tensorrt::runtime::InferenceSession session(trt_mod);
+  std::vector<std::future<std::vector<at::Tensor>>> futures;
+  for (int i = 0; i < 4; i++) {
+    futures.push_back(session.enqueue({inputs[i]}, c10::cuda::getStreamFromPool()));
+  }
+  for (int i = 0; i < 4; i++) {
+    auto out = futures[i].get();
+    ASSERT_EQ(out.size(), 1);
+    ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(out[0], expected[i]));
+  }
+}
+
+TEST(CppAPITest, InferenceSessionReturnsErrorsThroughTheFuture) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+  torch_tensorrt::runtime::InferenceSession session(trt_mod);
+  auto future = session.enqueue({});
+  ASSERT_ANY_THROW(future.get());
+  ASSERT_EQ(session.get_num_in_flight(), 0);
+}
+#endif
@@ -0,0 +1,55 @@
+#include <string>
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+TEST(CppAPITest, CompileAfterSupportCheckMatchesModule) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+
+  ASSERT_TRUE(torch_tensorrt::ts::check_method_operator_support(mod, "forward"));
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+
+  auto in = at::randint(5, {1, 3, 224, 224}, {at::kCUDA});
+  auto jit_results = torch_tensorrt::tests::util::RunModuleForward(mod, {in.clone()}).toTensor();
+  auto trt_results = torch_tensorrt::tests::util::RunModuleForward(trt_mod, {in.clone()}).toTensor();
+  ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(jit_results, trt_results));
+}
+
+TEST(CppAPITest, CompileAfterSupportCheckUsesUpdatedWeights) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+
+  ASSERT_TRUE(torch_tensorrt::ts::check_method_operator_support(mod, "forward"));
+  {
+    // The lowering of the support check folded the old weights, it must not be reused
+    torch::NoGradGuard no_grad;
+    for (auto p : mod.parameters()) {
+      p.mul_(0.5);
+    }
+  }
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+
+  auto in = at::randint(5, {1, 3, 224, 224}, {at::kCUDA});
+  auto jit_results = torch_tensorrt::tests::util::RunModuleForward(mod, {in.clone()}).toTensor();
+  auto trt_results = torch_tensorrt::tests::util::RunModuleForward(trt_mod, {in.clone()}).toTensor();
+  ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(jit_results, trt_results));
+}
+#endif
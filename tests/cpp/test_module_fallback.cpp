@@ -33,6 +33,30 @@ TEST(CppAPITest, ResNetModuleFallbacksCorrectly) {
   ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(jit_results, trt_results));
 }
 
+TEST(CppAPITest, ResNetModuleFallbacksCorrectlyInLowMemoryMode) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_scripted.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    ASSERT_TRUE(false);
+  }
+
+  const std::vector<std::vector<int64_t>> input_shapes = {{1, 3, 224, 224}};
+  auto in = at::randint(5, input_shapes[0], {at::kCUDA});
+
+  torch_tensorrt::ts::CompileSpec cfg(input_shapes);
+  cfg.torch_executed_modules.push_back("torchvision.models.resnet.BasicBlock");
+  cfg.low_memory = true;
+
+  auto jit_results = mod.forward({in.clone()}).toTensor();
+  auto trt_mod = torch_tensorrt::ts::compile(mod, cfg);
+  auto trt_results = trt_mod.forward({in.clone()}).toTensor();
+  ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(jit_results, trt_results));
+  // The weights the compiler dropped are not the ones of the source module
+  ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(mod.forward({in.clone()}).toTensor(), trt_results));
+}
+
 TEST(CppAPITest, MobileNetModuleFallbacksCorrectlyWithOneEngine) {
   torch::jit::script::Module mod;
   try {
@@ -71,4 +95,35 @@ TEST(CppAPITest, MobileNetModuleFallbacksCorrectlyWithOneEngine) {
   auto trt_results = trt_mod.forward(trt_inputs_ivalues).toTensor();
   ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(jit_results, trt_results));
 }
+
+TEST(CppAPITest, SharedWeightsAcrossSegmentsRunCorrectly) {
+  // Both TensorRT segments gather from the 2 MB table, split by the sigmoid running in PyTorch
+  torch::jit::Module mod("SharedTable");
+  mod.register_parameter("table", torch::randn({4096, 128}), /*is_buffer=*/false);
+  mod.define(R"(
+    def forward(self, x, y):
+        a = torch.sigmoid(torch.embedding(self.table, x))
+        return torch.embedding(self.table, y) + a
+  )");
+  mod.to(torch::kCUDA);
+  mod.eval();
+
+  auto x = at::randint(4096, {8}, {at::kCUDA}).to(at::kInt);
+  auto y = at::randint(4096, {8}, {at::kCUDA}).to(at::kInt);
+  auto jit_results = mod.forward({x, y}).toTensor();
+
+  std::vector<torch_tensorrt::Input> inputs = {
+      torch_tensorrt::Input({8}, torch_tensorrt::DataType::kInt),
+      torch_tensorrt::Input({8}, torch_tensorrt::DataType::kInt)};
+  for (bool low_memory : {false, true}) {
+    torch_tensorrt::ts::CompileSpec cfg(inputs);
+    cfg.min_block_size = 1;
+    cfg.torch_executed_ops.push_back("aten::sigmoid");
+    cfg.share_segment_weights = true;
+    cfg.low_memory = low_memory;
+    auto trt_mod = torch_tensorrt::ts::compile(mod, cfg);
+    auto trt_results = trt_mod.forward({x, y}).toTensor();
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results, trt_results));
+  }
+}
 #endif
@@ -0,0 +1,82 @@
+#include <string>
+#include "c10/cuda/CUDAFunctions.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/pipeline_parallel_module.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+namespace {
+
+torch::jit::script::Module load_resnet18() {
+  auto mod = torch::jit::load("tests/modules/resnet18_scripted.jit.pt");
+  mod.eval();
+  return mod;
+}
+
+torch_tensorrt::ts::CompileSpec batched_spec() {
+  std::vector<torch_tensorrt::Input> inputs;
+  std::vector<int64_t> min_shape = {1, 3, 224, 224};
+  std::vector<int64_t> opt_shape = {2, 3, 224, 224};
+  std::vector<int64_t> max_shape = {4, 3, 224, 224};
+  inputs.push_back(torch_tensorrt::Input(min_shape, opt_shape, max_shape));
+  return torch_tensorrt::ts::CompileSpec(inputs);
+}
+
+} // namespace
+
+TEST(CppAPITest, PipelineParallelModuleConcatenatesMicroBatches) {
+  torch::jit::script::Module mod;
+  try {
+    mod = load_resnet18();
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    ASSERT_TRUE(false);
+  }
+  auto trt_mod = torch_tensorrt::ts::compile(mod, batched_spec());
+
+  torch_tensorrt::runtime::PipelineParallelModule pipeline(trt_mod, /*num_micro_batches=*/2);
+  ASSERT_EQ(pipeline.get_num_micro_batches(), 2);
+  for (int64_t batch : {4, 3, 1}) {
+    auto in = at::randint(5, {batch, 3, 224, 224}, {at::kCUDA});
+    auto expected = mod.forward({in.clone()}).toTensor();
+    auto out = pipeline.forward({in});
+    ASSERT_EQ(out.size(), 1);
+    ASSERT_EQ(out[0].size(0), batch);
+    ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(out[0], expected));
+  }
+}
+
+TEST(CppAPITest, PipelineParallelModuleRunsStagesOnTheirGPUs) {
+  if (c10::cuda::device_count() < 2) {
+    GTEST_SKIP() << "Pipeline stages need two GPUs";
+  }
+  torch::jit::script::Module mod;
+  try {
+    mod = load_resnet18();
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    ASSERT_TRUE(false);
+  }
+  auto spec = batched_spec();
+  spec.torch_executed_modules.push_back("torchvision.models.resnet.BasicBlock");
+  torch_tensorrt::Device stage1;
+  stage1.gpu_id = 1;
+  spec.segment_devices = {torch_tensorrt::Device(), stage1};
+
+  bool multi_device_safe_mode = torch_tensorrt::ts::get_multi_device_safe_mode();
+  torch_tensorrt::ts::set_multi_device_safe_mode(true);
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+  torch_tensorrt::runtime::PipelineParallelModule pipeline(trt_mod, /*num_micro_batches=*/4);
+  auto in = at::randint(5, {4, 3, 224, 224}, {at::kCUDA});
+  auto expected = mod.forward({in.clone()}).toTensor();
+  auto out = pipeline.forward({in});
+  torch_tensorrt::ts::set_multi_device_safe_mode(multi_device_safe_mode);
+
+  ASSERT_EQ(out.size(), 1);
+  ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(out[0].to(expected.device()), expected));
+}
+
+#endif
@@ -0,0 +1,90 @@
+#include <sstream>
+#include <string>
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+TEST(CppAPITest, RefitCompiledModuleWithNewWeights) {
+  torch::jit::script::Module mod;
+  torch::jit::script::Module new_mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+    new_mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+  new_mod.eval();
+
+  {
+    torch::NoGradGuard no_grad;
+    for (auto p : new_mod.parameters()) {
+      p.mul_(0.5);
+    }
+  }
+
+  auto in = at::randint(5, {1, 3, 224, 224}, {at::kCUDA});
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  spec.refit = true;
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+
+  auto jit_results = torch_tensorrt::tests::util::RunModuleForward(new_mod, {in.clone()}).toTensor();
+  auto trt_results = torch_tensorrt::tests::util::RunModuleForward(trt_mod, {in.clone()}).toTensor();
+  ASSERT_FALSE(torch_tensorrt::tests::util::cosineSimEqual(jit_results, trt_results));
+
+  torch_tensorrt::ts::refit(trt_mod, new_mod, spec);
+  trt_results = torch_tensorrt::tests::util::RunModuleForward(trt_mod, {in.clone()}).toTensor();
+  ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(jit_results, trt_results));
+}
+
+TEST(CppAPITest, RefitFailsForModuleWithDifferentArchitecture) {
+  torch::jit::script::Module mod;
+  torch::jit::script::Module other_mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+    other_mod = torch::jit::load("tests/modules/mobilenet_v2_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  spec.refit = true;
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+  ASSERT_THROW(torch_tensorrt::ts::refit(trt_mod, other_mod, spec), c10::Error);
+}
+
+TEST(CppAPITest, WeightStrippedModuleRunsOnceRefit) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+
+  auto in = at::randint(5, {1, 3, 224, 224}, {at::kCUDA});
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  std::stringstream full;
+  torch_tensorrt::ts::compile(mod, spec).save(full);
+
+  spec.strip_engine_weights = true;
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+  auto trt_results = torch_tensorrt::tests::util::RunModuleForward(trt_mod, {in.clone()}).toTensor();
+  std::stringstream stripped;
+  trt_mod.save(stripped);
+  ASSERT_LT(stripped.str().size(), full.str().size() / 2);
+
+  auto loaded_mod = torch::jit::load(stripped);
+  ASSERT_THROW(torch_tensorrt::tests::util::RunModuleForward(loaded_mod, {in.clone()}), c10::Error);
+
+  torch_tensorrt::ts::refit(loaded_mod, mod, spec);
+  auto loaded_results = torch_tensorrt::tests::util::RunModuleForward(loaded_mod, {in.clone()}).toTensor();
+  ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(trt_results, loaded_results));
+}
+#endif
@@ -0,0 +1,40 @@
+#include <string>
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+TEST(CppAPITest, RuntimeMetricsCountExecutionsSinceReset) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+  auto in = at::randint(5, {1, 3, 224, 224}, {at::kCUDA});
+  torch_tensorrt::tests::util::RunModuleForward(trt_mod, {in.clone()});
+  torch_tensorrt::ts::reset_runtime_metrics(trt_mod);
+  for (int i = 0; i < 3; i++) {
+    torch_tensorrt::tests::util::RunModuleForward(trt_mod, {in.clone()});
+  }
+
+  auto metrics = torch_tensorrt::ts::get_runtime_metrics(trt_mod);
+  ASSERT_EQ(metrics.size(), 1);
+  ASSERT_EQ(metrics[0].counters.at("executions"), 3);
+  ASSERT_EQ(metrics[0].counters.at("execute_count"), 3);
+  auto& execute = metrics[0].latency_histograms.at("execute");
+  ASSERT_EQ(execute.size(), metrics[0].latency_histograms.at("bucket_bounds_us").size());
+  int64_t samples = 0;
+  for (auto c : execute) {
+    samples += c;
+  }
+  ASSERT_EQ(samples, 3);
+}
+#endif
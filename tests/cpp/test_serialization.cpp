@@ -47,6 +47,29 @@ TEST_P(CppAPITests, SerializedModuleIsStillCorrect) {
   }
 }
 
+TEST_P(CppAPITests, ParallelLoadedModuleIsStillCorrect) {
+  std::vector<torch::jit::IValue> post_serialized_inputs_ivalues;
+  std::vector<torch::jit::IValue> pre_serialized_inputs_ivalues;
+  for (uint64_t i = 0; i < input_shapes.size(); i++) {
+    auto in = at::randint(5, input_shapes[i], {at::kCUDA}).to(input_types[i]);
+    post_serialized_inputs_ivalues.push_back(in.clone());
+    pre_serialized_inputs_ivalues.push_back(in.clone());
+  }
+
+  auto pre_serialized_mod = torch_tensorrt::ts::compile(mod, input_shapes);
+  torch::jit::IValue pre_serialized_results_ivalues =
+      torch_tensorrt::tests::util::RunModuleForward(pre_serialized_mod, pre_serialized_inputs_ivalues);
+
+  pre_serialized_mod.save("test_parallel_load_mod.ts");
+  auto post_serialized_mod = torch_tensorrt::ts::load("test_parallel_load_mod.ts", 4);
+
+  torch::jit::IValue post_serialized_results_ivalues =
+      torch_tensorrt::tests::util::RunModuleForward(post_serialized_mod, post_serialized_inputs_ivalues);
+  auto post = post_serialized_results_ivalues.toTensor();
+  ASSERT_TRUE(
+      torch_tensorrt::tests::util::cosineSimEqual(post, pre_serialized_results_ivalues.toTensor().reshape_as(post)));
+}
+
 TEST_P(CppAPITests, SerializedDynamicModuleIsStillCorrect) {
   std::vector<torch::jit::IValue> post_serialized_inputs_ivalues;
   std::vector<torch::jit::IValue> pre_serialized_inputs_ivalues;
@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <string>
+#include "cuda_runtime_api.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+TEST(CppAPITest, PrunedModuleWeightsAre2To4Sparse) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  auto dense = torch_tensorrt::ts::check_sparsity(mod, spec);
+  ASSERT_FALSE(dense.weights.empty());
+  ASSERT_TRUE(std::none_of(dense.weights.begin(), dense.weights.end(), [](const auto& w) { return w.is_2_4_sparse; }));
+
+  ASSERT_GT(torch_tensorrt::ts::prune_2_4(mod), 0);
+  auto pruned = torch_tensorrt::ts::check_sparsity(mod, spec);
+  ASSERT_EQ(pruned.weights.size(), dense.weights.size());
+  for (const auto& w : pruned.weights) {
+    ASSERT_TRUE(w.is_2_4_sparse) << w.name << " is not 2:4 sparse after pruning";
+    ASSERT_GE(w.zero_fraction, 0.25) << w.name;
+  }
+}
+
+TEST(CppAPITest, SparseWeightsRunSparseTactics) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  cudaDeviceProp prop;
+  ASSERT_EQ(cudaGetDeviceProperties(&prop, 0), cudaSuccess);
+  if (prop.major < 8) {
+    GTEST_SKIP() << "Sparse tensor cores require compute capability 8.0 or newer";
+  }
+
+  torch_tensorrt::ts::prune_2_4(mod);
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{32, 3, 224, 224}});
+  spec.enabled_precisions = {torch::kHalf};
+  spec.sparse_weights = true;
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+
+  torch_tensorrt::ts::SparsityReport report;
+  torch_tensorrt::ts::find_sparse_layers(trt_mod, report);
+  ASSERT_FALSE(report.sparse_engine_layers.empty());
+  ASSERT_NE(report.to_json().find("sparse_engine_layers"), std::string::npos);
+}
+
+#endif
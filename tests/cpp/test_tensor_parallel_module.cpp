@@ -0,0 +1,89 @@
+#include <mutex>
+#include <set>
+#include <string>
+#include "c10/cuda/CUDAFunctions.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/tensor_parallel_module.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+namespace {
+
+torch::jit::Module compile_for_device(const torch::jit::Module& mod, int64_t device) {
+  std::vector<torch_tensorrt::Input> inputs;
+  inputs.push_back(torch_tensorrt::Input(std::vector<int64_t>{1, 3, 224, 224}));
+  torch_tensorrt::ts::CompileSpec spec(inputs);
+  spec.device.gpu_id = device;
+  return torch_tensorrt::ts::compile(mod, spec);
+}
+
+} // namespace
+
+TEST(CppAPITest, TensorParallelModuleRunsShardsOnTheirDevices) {
+  if (c10::cuda::device_count() < 2) {
+    GTEST_SKIP() << "TensorParallelModule needs two GPUs";
+  }
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_scripted.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    ASSERT_TRUE(false);
+  }
+  mod.eval();
+
+  std::mutex mu;
+  std::set<std::pair<int64_t, int64_t>> initialized;
+  torch_tensorrt::runtime::TensorParallelModule tp(
+      {compile_for_device(mod, 0), compile_for_device(mod, 1)}, [&](int64_t rank, int64_t device) {
+        std::lock_guard<std::mutex> lock(mu);
+        initialized.insert({rank, device});
+      });
+  ASSERT_EQ(tp.get_world_size(), 2);
+  ASSERT_EQ(tp.get_devices(), (std::vector<int64_t>{0, 1}));
+  ASSERT_EQ(initialized, (std::set<std::pair<int64_t, int64_t>>{{0, 0}, {1, 1}}));
+
+  for (int i = 0; i < 3; i++) {
+    auto in = at::randint(5, {1, 3, 224, 224}, {at::kCUDA});
+    auto expected = mod.forward({in.clone()}).toTensor();
+    auto out = tp.forward({in});
+    ASSERT_EQ(out.size(), 1);
+    ASSERT_EQ(out[0].device().index(), 0);
+    ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(out[0], expected));
+  }
+}
+
+TEST(CppAPITest, TensorParallelModuleRejectsShardsSharingADevice) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_scripted.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    ASSERT_TRUE(false);
+  }
+  mod.eval();
+
+  auto shard = compile_for_device(mod, 0);
+  EXPECT_THROW(torch_tensorrt::runtime::TensorParallelModule({shard, shard.clone()}), c10::Error);
+}
+
+TEST(CppAPITest, TensorParallelModuleRethrowsRankInitErrors) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_scripted.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    ASSERT_TRUE(false);
+  }
+  mod.eval();
+
+  EXPECT_THROW(
+      torch_tensorrt::runtime::TensorParallelModule(
+          {compile_for_device(mod, 0)}, [](int64_t, int64_t) { throw std::runtime_error("no communicator"); }),
+      std::runtime_error);
+}
+
+#endif
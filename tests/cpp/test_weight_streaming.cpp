@@ -0,0 +1,50 @@
+#include <string>
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+TEST(CppAPITest, WeightStreamingBudgetOfCompiledModule) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+  mod.eval();
+
+  auto in = at::randint(5, {1, 3, 224, 224}, {at::kCUDA});
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  spec.strongly_typed = true;
+  spec.weight_streaming = true;
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+
+  auto streamable = torch_tensorrt::ts::get_streamable_weights_size(trt_mod);
+  ASSERT_GT(streamable, 0);
+
+  auto jit_results = torch_tensorrt::tests::util::RunModuleForward(mod, {in.clone()}).toTensor();
+  for (auto budget : {streamable / 2, int64_t(0), streamable}) {
+    torch_tensorrt::ts::set_weight_streaming_budget(trt_mod, budget);
+    ASSERT_EQ(torch_tensorrt::ts::get_weight_streaming_budget(trt_mod), budget);
+    auto trt_results = torch_tensorrt::tests::util::RunModuleForward(trt_mod, {in.clone()}).toTensor();
+    ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(jit_results, trt_results));
+  }
+}
+
+TEST(CppAPITest, WeightStreamingRequiresStronglyTypedNetwork) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_traced.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    return;
+  }
+
+  auto spec = torch_tensorrt::ts::CompileSpec({std::vector<int64_t>{1, 3, 224, 224}});
+  spec.weight_streaming = true;
+  ASSERT_THROW(torch_tensorrt::ts::compile(mod, spec), c10::Error);
+}
+#endif
@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "core/compiler.h"
+#include "core/util/compile_profile.h"
+#include "core/util/prelude.h"
+#include "torch/cuda.h"
+#include "torch/script.h"
+
+// Compiles synthetic TorchScript modules of growing size and reports the wall time and memory of each phase of the
+// compilation (lowering, partitioning, shape analysis, conversion and engine builds), to find phases which scale
+// super-linearly with the number of nodes of the graph.
+//
+//   bazel run //tests/performance:compile_benchmark -- [--filter=<pattern substring>] [--max_nodes=<n>] [--detail]
+//
+// Every case is compiled in a child process so its peak host memory is its own. Units of the graphs fall back to
+// Torch at the given fallback density, through an activation the compiler is forced to run in Torch. --detail lists
+// the individual lowering passes and shape analysis modes instead of their totals
+
+namespace {
+namespace core = torch_tensorrt::core;
+
+constexpr int64_t WIDTH = 16;
+constexpr int64_t ROWS = 16;
+const std::vector<int64_t> NUM_NODES = {1000, 10000, 100000};
+const std::vector<double> FALLBACK_DENSITIES = {0.0, 0.01, 0.1};
+
+// Whether unit i falls back, spread evenly over the graph at the fallback density
+std::string activation(int64_t i, double density) {
+  return std::floor((i + 1) * density) > std::floor(i * density) ? "torch.sigmoid" : "torch.relu";
+}
+
+std::string add_param(torch::jit::Module& mod, const std::string& name, int64_t i, std::vector<int64_t> shape) {
+  auto param = name + std::to_string(i);
+  mod.register_parameter(param, torch::randn(shape) * 0.1, /*is_buffer=*/false);
+  return "self." + param;
+}
+
+struct Pattern {
+  std::string name;
+  int64_t nodes_per_unit;
+  // Appends unit i to the body of forward, which reads and updates x (the chain) and y (the sum of the branches)
+  std::function<void(torch::jit::Module&, std::stringstream&, int64_t, double)> unit;
+};
+
+const std::vector<Pattern> PATTERNS = {
+    // Chain of fully connected layers
+    {"deep_mlp",
+     2,
+     [](torch::jit::Module& mod, std::stringstream& src, int64_t i, double density) {
+       auto w = add_param(mod, "w", i, {WIDTH, WIDTH});
+       auto b = add_param(mod, "b", i, {WIDTH});
+       src << "    x = " << activation(i, density) << "(torch.addmm(" << b << ", x, " << w << "))\n";
+     }},
+    // Branches which all read the input, summed into the output
+    {"wide_branchy",
+     4,
+     [](torch::jit::Module& mod, std::stringstream& src, int64_t i, double density) {
+       auto s = add_param(mod, "s", i, {WIDTH});
+       auto t = add_param(mod, "t", i, {WIDTH});
+       src << "    y = y + " << activation(i, density) << "(x * " << s << " + " << t << ")\n";
+     }},
+    // Single head attention and feed forward blocks
+    {"transformer",
+     16,
+     [](torch::jit::Module& mod, std::stringstream& src, int64_t i, double density) {
+       auto wq = add_param(mod, "wq", i, {WIDTH, WIDTH});
+       auto wk = add_param(mod, "wk", i, {WIDTH, WIDTH});
+       auto wv = add_param(mod, "wv", i, {WIDTH, WIDTH});
+       auto wo = add_param(mod, "wo", i, {WIDTH, WIDTH});
+       auto w1 = add_param(mod, "w1_", i, {WIDTH, 4 * WIDTH});
+       auto w2 = add_param(mod, "w2_", i, {4 * WIDTH, WIDTH});
+       src << "    q = torch.matmul(x, " << wq << ")\n";
+       src << "    k = torch.matmul(x, " << wk << ")\n";
+       src << "    v = torch.matmul(x, " << wv << ")\n";
+       src << "    a = torch.softmax(torch.matmul(q, torch.transpose(k, 0, 1)) * 0.25, -1)\n";
+       src << "    x = torch.layer_norm(x + torch.matmul(torch.matmul(a, v), " << wo << "), [" << WIDTH << "])\n";
+       src << "    h = " << activation(i, density) << "(torch.matmul(x, " << w1 << "))\n";
+       src << "    x = torch.layer_norm(x + torch.matmul(h, " << w2 << "), [" << WIDTH << "])\n";
+     }},
+};
+
+torch::jit::Module build_module(const Pattern& pattern, int64_t num_nodes, double density) {
+  torch::jit::Module mod(pattern.name);
+  std::stringstream src;
+  src << "def forward(self, x):\n";
+  src << "    y = x\n";
+  for (int64_t i = 0; i < std::max<int64_t>(num_nodes / pattern.nodes_per_unit, 1); i++) {
+    pattern.unit(mod, src, i, density);
+  }
+  src << "    return x + y\n";
+  mod.define(src.str());
+  mod.to(torch::kCUDA);
+  mod.eval();
+  return mod;
+}
+
+struct Stage {
+  std::string phase;
+  int64_t calls = 0;
+  int64_t wall_time_ns = 0;
+  int64_t peak_host_bytes = 0;
+  int64_t peak_gpu_bytes = 0;
+};
+
+// Phases recorded for several segments or modes are summed, their memory is the highest they reached
+std::vector<Stage> aggregate(const std::vector<core::util::CompilePhaseRecord>& records, bool detail) {
+  std::vector<std::string> recorded;
+  for (const auto& r : records) {
+    recorded.push_back(r.phase);
+  }
+  std::vector<Stage> stages;
+  for (const auto& r : records) {
+    auto phase = r.phase;
+    auto slash = phase.find('/');
+    if (!detail && slash != std::string::npos) {
+      phase = phase.substr(0, slash);
+      // Nested in a phase which is reported itself
+      if (std::find(recorded.begin(), recorded.end(), phase) != recorded.end()) {
+        continue;
+      }
+    }
+    auto stage = std::find_if(stages.begin(), stages.end(), [&](const Stage& s) { return s.phase == phase; });
+    if (stage == stages.end()) {
+      stages.push_back({phase});
+      stage = std::prev(stages.end());
+    }
+    stage->calls++;
+    stage->wall_time_ns += r.wall_time_ns;
+    stage->peak_host_bytes = std::max(stage->peak_host_bytes, r.peak_host_bytes);
+    stage->peak_gpu_bytes = std::max(stage->peak_gpu_bytes, r.peak_gpu_bytes);
+  }
+  return stages;
+}
+
+int run_case(const std::string& name, int64_t num_nodes, double density, bool detail) {
+  auto pattern = std::find_if(PATTERNS.begin(), PATTERNS.end(), [&](const Pattern& p) { return p.name == name; });
+  if (pattern == PATTERNS.end()) {
+    std::cerr << "Unknown pattern " << name << std::endl;
+    return 1;
+  }
+  auto mod = build_module(*pattern, num_nodes, density);
+  auto graph = mod.get_method("forward").graph();
+  auto graph_nodes = std::distance(graph->nodes().begin(), graph->nodes().end());
+
+  core::CompileSpec cfg({core::ir::Input({ROWS, WIDTH})});
+  cfg.partitioning_info.enabled = true;
+  cfg.partitioning_info.forced_fallback_operators.push_back("aten::sigmoid");
+  cfg.profiler = std::make_shared<core::util::CompileProfiler>();
+  core::CompileGraph(mod, cfg);
+
+  std::cout << name << ", " << graph_nodes << " nodes, fallback density " << density << std::endl;
+  for (const auto& s : aggregate(cfg.profiler->records(), detail)) {
+    std::cout << "    " << std::left << std::setw(32) << s.phase << std::right << std::setw(8) << s.calls << std::fixed
+              << std::setprecision(1) << std::setw(14) << s.wall_time_ns / 1e6 << std::setw(16)
+              << s.peak_host_bytes / 1e6 << std::setw(16) << s.peak_gpu_bytes / 1e6 << std::endl;
+  }
+  return 0;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  std::string filter;
+  int64_t max_nodes = NUM_NODES.back();
+  bool detail = false;
+  std::string single_case;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg.rfind("--filter=", 0) == 0) {
+      filter = arg.substr(9);
+    } else if (arg.rfind("--max_nodes=", 0) == 0) {
+      max_nodes = std::stoll(arg.substr(12));
+    } else if (arg == "--detail") {
+      detail = true;
+    } else if (arg.rfind("--case=", 0) == 0) {
+      // <pattern>:<nodes>:<fallback density>, run by the parent process in a child
+      single_case = arg.substr(7);
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--filter=<pattern substring>] [--max_nodes=<n>] [--detail]" << std::endl;
+      return 1;
+    }
+  }
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kERROR);
+
+  if (!single_case.empty()) {
+    auto first = single_case.find(':');
+    auto second = single_case.find(':', first + 1);
+    try {
+      return run_case(
+          single_case.substr(0, first),
+          std::stoll(single_case.substr(first + 1, second - first - 1)),
+          std::stod(single_case.substr(second + 1)),
+          detail);
+    } catch (const std::exception& e) {
+      std::cerr << single_case << ": " << e.what() << std::endl;
+      return 1;
+    }
+  }
+
+  if (!torch::cuda::is_available()) {
+    std::cerr << "The compile benchmark needs a GPU" << std::endl;
+    return 1;
+  }
+  auto self = std::filesystem::read_symlink("/proc/self/exe").string();
+  std::cout << std::left << std::setw(36) << "phase" << std::right << std::setw(8) << "calls" << std::setw(14)
+            << "wall ms" << std::setw(16) << "peak host MB" << std::setw(16) << "peak GPU MB" << std::endl;
+  for (const auto& pattern : PATTERNS) {
+    if (pattern.name.find(filter) == std::string::npos) {
+      continue;
+    }
+    for (auto num_nodes : NUM_NODES) {
+      if (num_nodes > max_nodes) {
+        continue;
+      }
+      for (auto density : FALLBACK_DENSITIES) {
+        std::stringstream cmd;
+        cmd << self << " --case=" << pattern.name << ":" << num_nodes << ":" << density
+            << (detail ? " --detail" : "");
+        std::cout << std::flush;
+        if (std::system(cmd.str().c_str()) != 0) {
+          std::cerr << "Unable to compile " << pattern.name << " with " << num_nodes << " nodes at fallback density "
+                    << density << std::endl;
+        }
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,333 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "core/conversion/conversion.h"
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/csrc/jit/runtime/graph_executor.h"
+#include "torch/cuda.h"
+
+// Times the TensorRT layers each converter produces against ATen running the same graph, for the ops the converter
+// tests in tests/core/conversion/converters cover, over common shapes in FP32 and FP16.
+//
+//   bazel run //tests/performance:converter_benchmark -- [--filter=<converter substring>] [--json=<path>]
+//
+// Graphs take their weights as their last inputs, which are frozen as static params like in the converter tests
+
+namespace {
+constexpr int WARMUP_ITERS = 10;
+constexpr int ITERS = 100;
+constexpr int PROFILE_ITERS = 10;
+
+struct Shapes {
+  std::string label;
+  std::vector<std::vector<int64_t>> inputs;
+  // Shapes of the weights, the last graph inputs
+  std::vector<std::vector<int64_t>> params;
+};
+
+struct ConverterCase {
+  std::string converter;
+  std::string graph;
+  std::vector<Shapes> sweep;
+};
+
+struct Measurement {
+  std::string converter;
+  std::string shapes;
+  std::string dtype;
+  double build_ms = 0;
+  double trt_us = 0;
+  double aten_us = 0;
+  int64_t num_layers = 0;
+  std::string slowest_layer;
+  double slowest_layer_us = 0;
+};
+
+const std::vector<ConverterCase> CASES = {
+    {"aten::_convolution",
+     R"IR(
+      graph(%0 : Tensor, %1 : Tensor, %2 : Tensor):
+        %3 : int = prim::Constant[value=1]()
+        %4 : int = prim::Constant[value=0]()
+        %5 : bool = prim::Constant[value=0]()
+        %6 : int[] = prim::ListConstruct(%3, %3)
+        %7 : int[] = prim::ListConstruct(%4, %4)
+        %8 : Tensor = aten::_convolution(%0, %1, %2, %6, %6, %6, %5, %7, %3, %5, %5, %5, %5)
+        return (%8))IR",
+     {{"1x64x56x56 k3", {{1, 64, 56, 56}}, {{64, 64, 3, 3}, {64}}},
+      {"8x64x56x56 k3", {{8, 64, 56, 56}}, {{64, 64, 3, 3}, {64}}},
+      {"8x256x14x14 k3", {{8, 256, 14, 14}}, {{256, 256, 3, 3}, {256}}}}},
+    {"aten::linear",
+     R"IR(
+      graph(%0 : Tensor, %1 : Tensor, %2 : Tensor):
+        %3 : Tensor = aten::linear(%0, %1, %2)
+        return (%3))IR",
+     {{"1x1024 -> 1024", {{1, 1024}}, {{1024, 1024}, {1024}}},
+      {"64x1024 -> 1024", {{64, 1024}}, {{1024, 1024}, {1024}}},
+      {"8x128x768 -> 3072", {{8, 128, 768}}, {{3072, 768}, {3072}}}}},
+    {"aten::matmul",
+     R"IR(
+      graph(%0 : Tensor, %1 : Tensor):
+        %2 : Tensor = aten::matmul(%0, %1)
+        return (%2))IR",
+     {{"8x128x64 @ 8x64x128", {{8, 128, 64}, {8, 64, 128}}, {}},
+      {"16x512x64 @ 16x64x512", {{16, 512, 64}, {16, 64, 512}}, {}}}},
+    {"aten::batch_norm",
+     R"IR(
+      graph(%0 : Tensor, %1 : Tensor, %2 : Tensor, %3 : Tensor, %4 : Tensor):
+        %5 : bool = prim::Constant[value=0]()
+        %6 : float = prim::Constant[value=1.0000000000000001e-05]()
+        %7 : float = prim::Constant[value=0.10000000000000001]()
+        %8 : Tensor = aten::batch_norm(%0, %1, %2, %3, %4, %5, %6, %7, %5)
+        return (%8))IR",
+     {{"8x64x56x56", {{8, 64, 56, 56}}, {{64}, {64}, {64}, {64}}}}},
+    {"aten::layer_norm",
+     R"IR(
+      graph(%0 : Tensor, %1 : Tensor, %2 : Tensor):
+        %3 : int = prim::Constant[value=768]()
+        %4 : int[] = prim::ListConstruct(%3)
+        %5 : bool = prim::Constant[value=0]()
+        %6 : float = prim::Constant[value=1.0000000000000001e-05]()
+        %7 : Tensor = aten::layer_norm(%0, %4, %1, %2, %6, %5)
+        return (%7))IR",
+     {{"8x128x768", {{8, 128, 768}}, {{768}, {768}}}, {"32x128x768", {{32, 128, 768}}, {{768}, {768}}}}},
+    {"aten::softmax",
+     R"IR(
+      graph(%0 : Tensor):
+        %1 : None = prim::Constant()
+        %2 : int = prim::Constant[value=-1]()
+        %3 : Tensor = aten::softmax(%0, %2, %1)
+        return (%3))IR",
+     {{"64x1000", {{64, 1000}}, {}}, {"8x12x128x128", {{8, 12, 128, 128}}, {}}}},
+    {"aten::relu",
+     R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR",
+     {{"8x64x56x56", {{8, 64, 56, 56}}, {}}, {"1x1024x1024", {{1, 1024, 1024}}, {}}}},
+    {"aten::gelu",
+     R"IR(
+      graph(%0 : Tensor):
+        %1 : str = prim::Constant[value="none"]()
+        %2 : Tensor = aten::gelu(%0, %1)
+        return (%2))IR",
+     {{"8x128x3072", {{8, 128, 3072}}, {}}}},
+    {"aten::add",
+     R"IR(
+      graph(%0 : Tensor, %1 : Tensor):
+        %2 : int = prim::Constant[value=1]()
+        %3 : Tensor = aten::add(%0, %1, %2)
+        return (%3))IR",
+     {{"8x64x56x56", {{8, 64, 56, 56}, {8, 64, 56, 56}}, {}},
+      {"8x64x56x56 + 64x1x1", {{8, 64, 56, 56}, {64, 1, 1}}, {}}}},
+    {"aten::max_pool2d",
+     R"IR(
+      graph(%0 : Tensor):
+        %1 : int = prim::Constant[value=3]()
+        %2 : int = prim::Constant[value=2]()
+        %3 : int = prim::Constant[value=1]()
+        %4 : bool = prim::Constant[value=0]()
+        %5 : int[] = prim::ListConstruct(%1, %1)
+        %6 : int[] = prim::ListConstruct(%2, %2)
+        %7 : int[] = prim::ListConstruct(%3, %3)
+        %8 : Tensor = aten::max_pool2d(%0, %5, %6, %7, %7, %4)
+        return (%8))IR",
+     {{"8x64x112x112 k3 s2", {{8, 64, 112, 112}}, {}}}},
+    {"aten::adaptive_avg_pool2d",
+     R"IR(
+      graph(%0 : Tensor):
+        %1 : int = prim::Constant[value=1]()
+        %2 : int[] = prim::ListConstruct(%1, %1)
+        %3 : Tensor = aten::adaptive_avg_pool2d(%0, %2)
+        return (%3))IR",
+     {{"8x2048x7x7 -> 1x1", {{8, 2048, 7, 7}}, {}}}},
+    {"aten::cat",
+     R"IR(
+      graph(%0 : Tensor, %1 : Tensor):
+        %2 : Tensor[] = prim::ListConstruct(%0, %1)
+        %3 : int = prim::Constant[value=1]()
+        %4 : Tensor = aten::cat(%2, %3)
+        return (%4))IR",
+     {{"2 x 8x64x56x56 dim 1", {{8, 64, 56, 56}, {8, 64, 56, 56}}, {}}}},
+    {"aten::sum",
+     R"IR(
+      graph(%0 : Tensor):
+        %1 : int = prim::Constant[value=-1]()
+        %2 : int[] = prim::ListConstruct(%1)
+        %3 : bool = prim::Constant[value=0]()
+        %4 : None = prim::Constant()
+        %5 : Tensor = aten::sum(%0, %2, %3, %4)
+        return (%5))IR",
+     {{"64x4096 dim -1", {{64, 4096}}, {}}, {"8x128x768 dim -1", {{8, 128, 768}}, {}}}},
+};
+
+// Average wall time per call in microseconds of running fn back to back, which includes the host overhead of each call
+template <typename F>
+double time_us(F fn) {
+  for (int i = 0; i < WARMUP_ITERS; i++) {
+    fn();
+  }
+  torch::cuda::synchronize();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERS; i++) {
+    fn();
+  }
+  torch::cuda::synchronize();
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / ITERS;
+}
+
+Measurement run_case(const ConverterCase& c, const Shapes& shapes, at::ScalarType dtype) {
+  Measurement m;
+  m.converter = c.converter;
+  m.shapes = shapes.label;
+  m.dtype = dtype == at::kHalf ? "fp16" : "fp32";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(c.graph, g.get());
+  auto opts = at::TensorOptions().device(at::kCUDA).dtype(dtype);
+  std::vector<at::Tensor> inputs;
+  for (const auto& s : shapes.inputs) {
+    inputs.push_back(at::randn(s, opts));
+  }
+  // Positive weights keep the running variance of batch norm valid
+  std::vector<torch::jit::IValue> weights;
+  for (const auto& s : shapes.params) {
+    weights.push_back(at::rand(s, opts).add_(0.5));
+  }
+  torch_tensorrt::core::ir::StaticParams params;
+  for (size_t i = 0; i < weights.size(); i++) {
+    params[g->inputs()[inputs.size() + i]] = weights[i];
+  }
+
+  torch::jit::GraphExecutor executor(g, "");
+  m.aten_us = time_us([&]() {
+    torch::jit::Stack stack(inputs.begin(), inputs.end());
+    stack.insert(stack.end(), weights.begin(), weights.end());
+    executor.run(stack);
+  });
+
+  std::vector<const torch::jit::Value*> var_ins(g->inputs().begin(), g->inputs().begin() + inputs.size());
+  std::vector<torch_tensorrt::core::ir::Input> specs;
+  for (const auto& in : inputs) {
+    specs.push_back(torch_tensorrt::core::ir::Input(torch_tensorrt::core::util::toVec(in.sizes()), dtype));
+  }
+  auto info = torch_tensorrt::core::conversion::ConversionInfo();
+  info.inputs = torch_tensorrt::core::ir::pair_input_vals_with_specs(var_ins, specs);
+  if (dtype == at::kHalf) {
+    info.engine_settings.enabled_precisions.insert(nvinfer1::DataType::kHALF);
+  }
+  auto build_start = std::chrono::steady_clock::now();
+  auto serialized = torch_tensorrt::core::conversion::ConvertBlockToEngine(g->block(), info, params);
+  m.build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build_start).count();
+
+  auto engine = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(
+      "converter_benchmark",
+      serialized,
+      torch_tensorrt::core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU),
+      std::vector<std::string>(),
+      std::vector<std::string>());
+  m.trt_us = time_us([&]() { torch_tensorrt::core::runtime::execute_engine(inputs, engine); });
+
+  // Which of the layers the converter produced take the time
+  engine->profile_path_prefix = std::filesystem::temp_directory_path().string();
+  engine->enable_profiling();
+  for (int i = 0; i < PROFILE_ITERS; i++) {
+    torch_tensorrt::core::runtime::execute_engine(inputs, engine);
+  }
+  for (const auto& layer : engine->get_layer_profile()) {
+    m.num_layers++;
+    auto us = layer.value().at("mean_ms") * 1000;
+    if (us > m.slowest_layer_us) {
+      m.slowest_layer = layer.key();
+      m.slowest_layer_us = us;
+    }
+  }
+  engine->disable_profiling();
+  return m;
+}
+
+std::string json_escape(const std::string& s) {
+  std::stringstream ss;
+  for (auto c : s) {
+    if (c == '"' || c == '\\') {
+      ss << '\\';
+    }
+    ss << c;
+  }
+  return ss.str();
+}
+
+std::string to_json(const std::vector<Measurement>& results) {
+  std::stringstream ss;
+  ss << "[";
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& m = results[i];
+    ss << (i == 0 ? "\n" : ",\n") << "  {\"converter\": \"" << m.converter << "\", \"shapes\": \"" << m.shapes
+       << "\", \"dtype\": \"" << m.dtype << "\", \"build_ms\": " << m.build_ms << ", \"trt_us\": " << m.trt_us
+       << ", \"aten_us\": " << m.aten_us << ", \"speedup\": " << m.aten_us / m.trt_us
+       << ", \"num_layers\": " << m.num_layers << ", \"slowest_layer\": \"" << json_escape(m.slowest_layer)
+       << "\", \"slowest_layer_us\": " << m.slowest_layer_us << "}";
+  }
+  ss << "\n]\n";
+  return ss.str();
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  std::string filter;
+  std::string json_path;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg.rfind("--filter=", 0) == 0) {
+      filter = arg.substr(9);
+    } else if (arg.rfind("--json=", 0) == 0) {
+      json_path = arg.substr(7);
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--filter=<converter substring>] [--json=<path>]" << std::endl;
+      return 1;
+    }
+  }
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kERROR);
+
+  std::vector<Measurement> results;
+  std::cout << std::left << std::setw(28) << "converter" << std::setw(24) << "shapes" << std::setw(6) << "dtype"
+            << std::right << std::setw(11) << "build ms" << std::setw(11) << "trt us" << std::setw(11) << "aten us"
+            << std::setw(9) << "speedup" << std::setw(8) << "layers" << "  slowest layer" << std::endl;
+  for (const auto& c : CASES) {
+    if (c.converter.find(filter) == std::string::npos) {
+      continue;
+    }
+    for (const auto& shapes : c.sweep) {
+      for (auto dtype : {at::kFloat, at::kHalf}) {
+        Measurement m;
+        try {
+          m = run_case(c, shapes, dtype);
+        } catch (const std::exception& e) {
+          std::cerr << c.converter << " " << shapes.label << ": " << e.what() << std::endl;
+          continue;
+        }
+        std::cout << std::left << std::setw(28) << m.converter << std::setw(24) << m.shapes << std::setw(6) << m.dtype
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(11) << m.build_ms << std::setw(11)
+                  << m.trt_us << std::setw(11) << m.aten_us << std::setprecision(2) << std::setw(9)
+                  << m.aten_us / m.trt_us << std::setw(8) << m.num_layers << "  " << m.slowest_layer << " ("
+                  << std::setprecision(1) << m.slowest_layer_us << " us)" << std::endl;
+        results.push_back(std::move(m));
+      }
+    }
+  }
+
+  if (!json_path.empty()) {
+    std::ofstream f(json_path);
+    f << to_json(results);
+  }
+  return 0;
+}
@@ -0,0 +1,116 @@
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "core/partitioning/partitioning.h"
+#include "core/util/prelude.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+// Times the segmentation of synthetic graphs of growing size with min_block_size fallback, to check partitioning
+// scales linearly with the number of nodes (the time per node stays flat).
+//
+//   bazel run //tests/performance:partitioning_benchmark -- [--max_nodes=<n>]
+//
+// Graphs are chains of units of nodes separated by forced fallback ops, in which the fallback of one TensorRT run
+// makes nodes of another one fallback through their NonTensor connections
+
+namespace {
+namespace partitioning = torch_tensorrt::core::partitioning;
+
+const std::vector<int64_t> NUM_NODES = {1000, 10000, 100000, 200000};
+
+struct Pattern {
+  std::string name;
+  int64_t nodes_per_unit;
+  std::function<void(std::stringstream&, int64_t)> unit;
+};
+
+const std::vector<Pattern> PATTERNS = {
+    // The fallback of each unit makes the next unit fallback, one unit after the other
+    {"cascading",
+     4,
+     [](std::stringstream& g, int64_t k) {
+       g << "  %e" << k << " : Tensor = aten::add(%x" << k << ", %x" << k << ", %t" << k << ")\n";
+       g << "  %f" << k << " : Tensor = aten::relu(%e" << k << ")\n";
+       g << "  %t" << k + 1 << " : int = aten::size(%f" << k << ", %zero)\n";
+       g << "  %x" << k + 1 << " : Tensor = aten::log_sigmoid(%f" << k << ")\n";
+     }},
+    // Every unit falls back independently of the others, with a run that is too small splitting the next one
+    {"independent",
+     10,
+     [](std::stringstream& g, int64_t k) {
+       g << "  %a" << k << " : Tensor = aten::relu(%x" << k << ")\n";
+       g << "  %s" << k << " : int = aten::size(%a" << k << ", %zero)\n";
+       g << "  %b" << k << " : Tensor = aten::log_sigmoid(%a" << k << ")\n";
+       g << "  %c" << k << " : Tensor = aten::relu(%b" << k << ")\n";
+       g << "  %d" << k << " : Tensor = aten::relu(%c" << k << ")\n";
+       g << "  %e" << k << " : Tensor = aten::add(%d" << k << ", %d" << k << ", %s" << k << ")\n";
+       g << "  %f" << k << " : Tensor = aten::relu(%e" << k << ")\n";
+       g << "  %h" << k << " : Tensor = aten::relu(%f" << k << ")\n";
+       g << "  %i" << k << " : Tensor = aten::relu(%h" << k << ")\n";
+       g << "  %x" << k + 1 << " : Tensor = aten::log_sigmoid(%i" << k << ")\n";
+     }},
+};
+
+std::shared_ptr<torch::jit::Graph> build_graph(const Pattern& pattern, int64_t num_units) {
+  std::stringstream ss;
+  ss << "graph(%in : Tensor):\n";
+  ss << "  %zero : int = prim::Constant[value=0]()\n";
+  // The first run is too small and its size starts the fallback of the units
+  ss << "  %p : Tensor = aten::relu(%in)\n";
+  ss << "  %t0 : int = aten::size(%p, %zero)\n";
+  ss << "  %x0 : Tensor = aten::log_sigmoid(%p)\n";
+  for (int64_t k = 0; k < num_units; k++) {
+    pattern.unit(ss, k);
+  }
+  ss << "  return (%x" << num_units << ")";
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(ss.str(), g.get());
+  return g;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  int64_t max_nodes = NUM_NODES.back();
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg.rfind("--max_nodes=", 0) == 0) {
+      max_nodes = std::stoll(arg.substr(12));
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--max_nodes=<n>]" << std::endl;
+      return 1;
+    }
+  }
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kERROR);
+
+  std::cout << std::left << std::setw(14) << "pattern" << std::right << std::setw(10) << "nodes" << std::setw(10)
+            << "segments" << std::setw(14) << "partition ms" << std::setw(10) << "us/node" << std::endl;
+  for (const auto& pattern : PATTERNS) {
+    for (auto num_nodes : NUM_NODES) {
+      if (num_nodes > max_nodes) {
+        continue;
+      }
+      auto g = build_graph(pattern, num_nodes / pattern.nodes_per_unit);
+      partitioning::PartitioningInfo partitioning_info;
+      partitioning_info.enabled = true;
+      partitioning_info.min_block_size = 3;
+      partitioning_info.forced_fallback_operators.push_back("aten::log_sigmoid");
+      partitioning::PartitioningCtx ctx(g->block(), partitioning_info);
+
+      auto start = std::chrono::steady_clock::now();
+      partitioning::segmentGraph(&ctx, g->block());
+      std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+      std::cout << std::left << std::setw(14) << pattern.name << std::right << std::setw(10) << num_nodes
+                << std::setw(10) << ctx.partitioned_blocks.begin()->second.size() << std::fixed << std::setprecision(1)
+                << std::setw(14) << elapsed.count() << std::setprecision(2) << std::setw(10)
+                << elapsed.count() * 1000 / num_nodes << std::endl;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,140 @@
+#pragma once
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "c10/cuda/CUDACachingAllocator.h"
+#include "cuda_runtime_api.h"
+#include "gtest/gtest.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+// Name of the test, module path, input shape and precision the module is compiled with
+using ModelAndSettings = std::tuple<std::string, std::string, std::vector<int64_t>, c10::ScalarType>;
+
+// Expected value of one metric of one model on one GPU and the fraction it may regress by
+struct PerformanceBudget {
+  double baseline = 0;
+  double tolerance = 0;
+};
+
+// Tolerances of the metrics recorded to a new baseline file
+const std::map<std::string, double> DEFAULT_TOLERANCES = {
+    {"build_time_s", 0.5},
+    {"module_bytes", 0.05},
+    {"throughput", 0.1},
+    {"latency_p50_ms", 0.1},
+    {"host_overhead_us", 0.25},
+};
+
+// Throughput regresses when it drops, every other metric when it grows
+inline bool higher_is_better(const std::string& metric) {
+  return metric == "throughput";
+}
+
+// Baselines are stored per GPU in baselines/<name>.txt, e.g. baselines/nvidia_a100_sxm4_80gb.txt
+inline std::string gpu_baseline_name() {
+  cudaDeviceProp prop;
+  if (cudaGetDeviceProperties(&prop, 0) != cudaSuccess) {
+    return "unknown_gpu";
+  }
+  std::string name;
+  for (const char* c = prop.name; *c; c++) {
+    name.push_back(std::isalnum(static_cast<unsigned char>(*c)) ? std::tolower(static_cast<unsigned char>(*c)) : '_');
+  }
+  return name;
+}
+
+inline std::string baseline_path() {
+  auto dir = std::getenv("TORCHTRT_PERF_BASELINE_DIR");
+  return std::string(dir ? dir : "tests/performance/baselines") + "/" + gpu_baseline_name() + ".txt";
+}
+
+// Every line of a baseline file holds "<model> <metric> <baseline> <tolerance>", lines starting with # are comments
+inline std::map<std::string, PerformanceBudget> load_budgets(const std::string& path) {
+  std::map<std::string, PerformanceBudget> budgets;
+  std::ifstream f(path);
+  std::string line;
+  while (std::getline(f, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::stringstream ss(line);
+    std::string model, metric;
+    PerformanceBudget budget;
+    if (ss >> model >> metric >> budget.baseline >> budget.tolerance) {
+      budgets[model + " " + metric] = budget;
+    }
+  }
+  return budgets;
+}
+
+// With TORCHTRT_PERF_RECORD set to a file, measurements are appended to it in the baseline format so a baseline for a
+// new GPU (or a new release) can be recorded by running the suite
+inline void record_measurements(const std::string& model, const std::map<std::string, double>& metrics) {
+  auto path = std::getenv("TORCHTRT_PERF_RECORD");
+  if (!path) {
+    return;
+  }
+  std::ofstream f(path, std::ios::app);
+  for (const auto& m : metrics) {
+    f << model << " " << m.first << " " << m.second << " " << DEFAULT_TOLERANCES.at(m.first) << "\n";
+  }
+}
+
+class PerformanceTests : public testing::TestWithParam<ModelAndSettings> {
+ public:
+  void SetUp() override {
+    auto params = GetParam();
+    model = std::get<0>(params);
+    try {
+      mod = torch::jit::load(std::get<1>(params));
+    } catch (const c10::Error& e) {
+      std::cerr << "error loading the model\n";
+      ASSERT_TRUE(false);
+    }
+    mod.eval();
+    input_shape = std::get<2>(params);
+    precision = std::get<3>(params);
+  }
+
+  void TearDown() {
+    cudaDeviceSynchronize();
+    c10::cuda::CUDACachingAllocator::emptyCache();
+  }
+
+  // Fails every metric which regressed beyond its budget, skips the test if the GPU has no baselines
+  void check_budgets(const std::map<std::string, double>& metrics) {
+    record_measurements(model, metrics);
+    auto path = baseline_path();
+    auto budgets = load_budgets(path);
+    if (budgets.empty()) {
+      GTEST_SKIP() << "No performance baselines in " << path << ", record them with TORCHTRT_PERF_RECORD";
+    }
+    for (const auto& m : metrics) {
+      auto budget = budgets.find(model + " " + m.first);
+      if (budget == budgets.end()) {
+        std::cerr << "No baseline for " << m.first << " of " << model << " in " << path << std::endl;
+        continue;
+      }
+      const auto& b = budget->second;
+      if (higher_is_better(m.first)) {
+        EXPECT_GE(m.second, b.baseline * (1 - b.tolerance))
+            << m.first << " of " << model << " regressed from " << b.baseline << " to " << m.second;
+      } else {
+        EXPECT_LE(m.second, b.baseline * (1 + b.tolerance))
+            << m.first << " of " << model << " regressed from " << b.baseline << " to " << m.second;
+      }
+    }
+  }
+
+ protected:
+  std::string model;
+  torch::jit::script::Module mod;
+  std::vector<int64_t> input_shape;
+  c10::ScalarType precision;
+};
@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <chrono>
+#include "ATen/cuda/CUDAEvent.h"
+#include "c10/cuda/CUDAStream.h"
+#include "performance_test.h"
+
+namespace {
+constexpr int WARMUP_ITERS = 20;
+constexpr int ITERS = 200;
+} // namespace
+
+TEST_P(PerformanceTests, StaysWithinBudgets) {
+  auto spec = torch_tensorrt::ts::CompileSpec(std::vector<std::vector<int64_t>>{input_shape});
+  spec.enabled_precisions = {precision};
+
+  std::map<std::string, double> metrics;
+  auto build_start = std::chrono::steady_clock::now();
+  auto trt_mod = torch_tensorrt::ts::compile(mod, spec);
+  metrics["build_time_s"] = std::chrono::duration<double>(std::chrono::steady_clock::now() - build_start).count();
+
+  std::stringstream serialized;
+  trt_mod.save(serialized);
+  metrics["module_bytes"] = serialized.str().size();
+
+  std::vector<torch::jit::IValue> inputs = {at::randn(input_shape, {at::kCUDA})};
+  for (int i = 0; i < WARMUP_ITERS; i++) {
+    trt_mod.forward(inputs);
+  }
+  auto stream = c10::cuda::getCurrentCUDAStream();
+  stream.synchronize();
+
+  // Back to back executions: the GPU time gives the throughput, the time forward takes to return (the engine is
+  // enqueued asynchronously) the host overhead per call
+  at::cuda::CUDAEvent start(cudaEventDefault);
+  at::cuda::CUDAEvent end(cudaEventDefault);
+  double host_ns = 0;
+  start.record(stream);
+  for (int i = 0; i < ITERS; i++) {
+    auto call_start = std::chrono::steady_clock::now();
+    trt_mod.forward(inputs);
+    host_ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - call_start).count();
+  }
+  end.record(stream);
+  end.synchronize();
+  metrics["throughput"] = ITERS * input_shape[0] / (start.elapsed_time(end) / 1000.0);
+  metrics["host_overhead_us"] = host_ns / ITERS / 1000.0;
+
+  // One execution at a time for the latency
+  std::vector<float> latencies_ms;
+  for (int i = 0; i < ITERS; i++) {
+    start.record(stream);
+    trt_mod.forward(inputs);
+    end.record(stream);
+    end.synchronize();
+    latencies_ms.push_back(start.elapsed_time(end));
+  }
+  std::sort(latencies_ms.begin(), latencies_ms.end());
+  metrics["latency_p50_ms"] = latencies_ms[latencies_ms.size() / 2];
+
+  for (const auto& m : metrics) {
+    std::cout << model << " " << m.first << ": " << m.second << std::endl;
+  }
+  check_budgets(metrics);
+}
+
+#ifdef DISABLE_TEST_IN_CI
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(PerformanceTests);
+
+#else
+
+INSTANTIATE_TEST_SUITE_P(
+    ModelPerformanceSuite,
+    PerformanceTests,
+    testing::Values(
+        ModelAndSettings({"resnet18_fp32", "tests/modules/resnet18_traced.jit.pt", {8, 3, 224, 224}, at::kFloat}),
+        ModelAndSettings({"resnet18_fp16", "tests/modules/resnet18_traced.jit.pt", {8, 3, 224, 224}, at::kHalf}),
+        ModelAndSettings(
+            {"mobilenet_v2_fp16", "tests/modules/mobilenet_v2_traced.jit.pt", {8, 3, 224, 224}, at::kHalf}),
+        ModelAndSettings(
+            {"efficientnet_b0_fp16", "tests/modules/efficientnet_b0_scripted.jit.pt", {8, 3, 224, 224}, at::kHalf}),
+        ModelAndSettings({"vit_fp16", "tests/modules/vit_scripted.jit.pt", {1, 3, 224, 224}, at::kHalf})),
+    [](const testing::TestParamInfo<ModelAndSettings>& info) { return std::get<0>(info.param); });
+
+#endif
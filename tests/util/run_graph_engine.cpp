@@ -54,7 +54,7 @@ std::vector<core::ir::Input> toInputsDynamic(std::vector<at::Tensor> ten, bool d
   return a;
 }
 
-std::vector<at::Tensor> RunEngine(std::string& eng, std::vector<at::Tensor> inputs) {
+std::vector<at::Tensor> RunEngine(const core::util::SerializedEngine& eng, std::vector<at::Tensor> inputs) {
   LOG_DEBUG("Running TRT version");
   auto cuda_device = core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU);
   auto engine_ptr = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(
@@ -86,7 +86,22 @@ std::vector<at::Tensor> RunGraphEngine(
   auto info = core::conversion::ConversionInfo();
   info.inputs = std::move(in);
   info.engine_settings.enabled_precisions.insert(op_precision);
-  std::string eng = core::conversion::ConvertBlockToEngine(g->block(), info, named_params);
+  auto eng = core::conversion::ConvertBlockToEngine(g->block(), info, named_params);
+  return RunEngine(eng, inputs);
+}
+
+std::vector<at::Tensor> RunGraphEngineWithSettings(
+    std::shared_ptr<torch::jit::Graph>& g,
+    core::ir::StaticParams& named_params,
+    std::vector<at::Tensor> inputs,
+    core::conversion::BuilderSettings settings) {
+  LOG_DEBUG("Running TRT version");
+  auto var_ins = get_var_inputs(g->inputs(), named_params);
+  auto in = core::ir::pair_input_vals_with_specs(var_ins, toInputs(inputs));
+  auto info = core::conversion::ConversionInfo();
+  info.inputs = std::move(in);
+  info.engine_settings = std::move(settings);
+  auto eng = core::conversion::ConvertBlockToEngine(g->block(), info, named_params);
   return RunEngine(eng, inputs);
 }
 
@@ -102,10 +117,26 @@ std::vector<at::Tensor> RunGraphEngineDynamic(
   auto info = core::conversion::ConversionInfo();
   info.inputs = std::move(in);
   info.engine_settings.allow_shape_tensors = allow_shape_tensors;
-  std::string eng = core::conversion::ConvertBlockToEngine(g->block(), info, named_params);
+  auto eng = core::conversion::ConvertBlockToEngine(g->block(), info, named_params);
   return RunEngine(eng, inputs);
 }
 
+c10::intrusive_ptr<core::runtime::TRTEngine> BuildGraphEngine(
+    std::shared_ptr<torch::jit::Graph>& g,
+    core::ir::StaticParams& named_params,
+    std::vector<at::Tensor> inputs,
+    bool dynamic_batch) {
+  auto var_ins = get_var_inputs(g->inputs(), named_params);
+  auto specs = dynamic_batch ? toInputsDynamic(inputs, true) : toInputs(inputs);
+  auto in = core::ir::pair_input_vals_with_specs(var_ins, specs);
+  auto info = core::conversion::ConversionInfo();
+  info.inputs = std::move(in);
+  auto eng = core::conversion::ConvertBlockToEngine(g->block(), info, named_params);
+  auto cuda_device = core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU);
+  return c10::make_intrusive<core::runtime::TRTEngine>(
+      "test_engine", eng, cuda_device, std::vector<std::string>(), std::vector<std::string>());
+}
+
 } // namespace util
 } // namespace tests
 } // namespace torch_tensorrt
@@ -4,7 +4,9 @@
 #include <string>
 #include <vector>
 #include "ATen/Tensor.h"
+#include "core/conversion/conversion.h"
 #include "core/ir/ir.h"
+#include "core/runtime/runtime.h"
 #include "core/util/prelude.h"
 #include "torch/csrc/jit/ir/irparser.h"
 
@@ -35,7 +37,7 @@ void pointwise_test_helper(
     at::ScalarType type1 = at::kFloat,
     at::ScalarType type2 = at::kFloat);
 
-std::vector<at::Tensor> RunEngine(std::string& eng, std::vector<at::Tensor> inputs);
+std::vector<at::Tensor> RunEngine(const core::util::SerializedEngine& eng, std::vector<at::Tensor> inputs);
 
 // Runs an arbitrary JIT graph and returns results
 std::vector<at::Tensor> RunGraph(
@@ -51,6 +53,14 @@ std::vector<at::Tensor> RunGraphEngine(
     std::vector<at::Tensor> inputs,
     nvinfer1::DataType dtype = nvinfer1::DataType::kFLOAT);
 
+// Runs an arbitrary JIT graph by converting it to TensorRT with the given builder settings
+// and running inference and returns results
+std::vector<at::Tensor> RunGraphEngineWithSettings(
+    std::shared_ptr<torch::jit::Graph>& g,
+    core::ir::StaticParams& named_params,
+    std::vector<at::Tensor> inputs,
+    core::conversion::BuilderSettings settings);
+
 // Runs an arbitrary JIT graph with dynamic input sizes by converting it to
 // TensorRT and running inference and returns results
 std::vector<at::Tensor> RunGraphEngineDynamic(
@@ -60,6 +70,14 @@ std::vector<at::Tensor> RunGraphEngineDynamic(
     bool dynamic_batch = false,
     bool allow_shape_tensors = false);
 
+// Converts an arbitrary JIT graph to TensorRT and returns a runtime engine handle for it
+// (optionally built with a dynamic batch dimension)
+c10::intrusive_ptr<core::runtime::TRTEngine> BuildGraphEngine(
+    std::shared_ptr<torch::jit::Graph>& g,
+    core::ir::StaticParams& named_params,
+    std::vector<at::Tensor> inputs,
+    bool dynamic_batch = false);
+
 // Run the forward method of a module and return results
 torch::jit::IValue RunModuleForward(torch::jit::Module& mod, std::vector<torch::jit::IValue> inputs);
 
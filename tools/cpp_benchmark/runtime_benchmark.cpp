@@ -0,0 +1,234 @@
+#include "ATen/Context.h"
+#include "c10/cuda/CUDACachingAllocator.h"
+#include "cuda_runtime_api.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/script.h"
+
+#include "core/conversion/conversion.h"
+#include "core/runtime/runtime.h"
+#include "timer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Microbenchmarks of the host side cost of execute_engine. The engines are tiny so the GPU time is negligible and the
+// measured latency is the time the calling thread spends in execute_engine (the GPU is only synchronized between
+// batches of calls, outside of the timed region)
+
+namespace {
+// Host allocations made by the current thread, counted by the replaced global operator new below
+thread_local int64_t thread_allocations = 0;
+} // namespace
+
+void* operator new(std::size_t size) {
+  thread_allocations++;
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+namespace rt = torch_tensorrt::core::runtime;
+
+const int64_t kSyncInterval = 64;
+
+struct Options {
+  int64_t iterations = 2000;
+  int64_t warmup = 200;
+  std::vector<int64_t> threads = {1, 2, 4, 8};
+  std::string filter = "";
+};
+
+struct Mode {
+  std::string name;
+  std::function<void(c10::intrusive_ptr<rt::TRTEngine>&)> setup;
+  std::function<void(c10::intrusive_ptr<rt::TRTEngine>&)> teardown;
+};
+
+struct Result {
+  std::vector<float> latencies_us;
+  int64_t host_allocations = 0;
+  int64_t device_allocations = 0;
+};
+
+c10::intrusive_ptr<rt::TRTEngine> build_relu_engine(const at::Tensor& in) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  std::vector<const torch::jit::Value*> var_ins = {g->inputs()[0]};
+  auto info = torch_tensorrt::core::conversion::ConversionInfo();
+  info.inputs = torch_tensorrt::core::ir::pair_input_vals_with_specs(
+      var_ins, {torch_tensorrt::core::ir::Input(in.sizes().vec())});
+  std::string eng = torch_tensorrt::core::conversion::ConvertBlockToEngine(g->block(), info, params);
+  return c10::make_intrusive<rt::TRTEngine>(
+      "benchmark_engine",
+      eng,
+      rt::RTDevice(0, nvinfer1::DeviceType::kGPU),
+      std::vector<std::string>(),
+      std::vector<std::string>());
+}
+
+int64_t device_allocation_count() {
+  auto stats = c10::cuda::CUDACachingAllocator::getDeviceStats(0);
+  return stats.allocation[static_cast<size_t>(c10::CachingAllocator::StatType::AGGREGATE)].allocated;
+}
+
+// Runs fn(t) on threads threads and waits for them
+void on_threads(int64_t threads, const std::function<void(int64_t)>& fn) {
+  std::vector<std::thread> pool;
+  for (int64_t t = 0; t < threads; t++) {
+    pool.emplace_back(fn, t);
+  }
+  for (auto& thread : pool) {
+    thread.join();
+  }
+  cudaDeviceSynchronize();
+}
+
+Result run(c10::intrusive_ptr<rt::TRTEngine>& engine, const at::Tensor& in, const Options& opts, int64_t threads) {
+  on_threads(threads, [&](int64_t) {
+    for (int64_t i = 0; i < opts.warmup; i++) {
+      rt::execute_engine({in}, engine);
+    }
+  });
+  // The phase metrics should only cover the timed calls
+  engine->reset_runtime_metrics();
+
+  std::vector<Result> per_thread(threads);
+  int64_t device_allocations = device_allocation_count();
+  on_threads(threads, [&](int64_t t) {
+    std::vector<at::Tensor> inputs = {in};
+    auto& result = per_thread[t];
+    result.latencies_us.reserve(opts.iterations);
+    auto timer = timers::PreciseCPUTimer();
+    for (int64_t i = 0; i < opts.iterations; i++) {
+      int64_t allocations = thread_allocations;
+      timer.start();
+      rt::execute_engine(inputs, engine);
+      timer.stop();
+      result.host_allocations += thread_allocations - allocations;
+      result.latencies_us.push_back(timer.microseconds());
+      timer.reset();
+      if ((i + 1) % kSyncInterval == 0) {
+        cudaDeviceSynchronize();
+      }
+    }
+  });
+
+  Result merged;
+  for (auto& result : per_thread) {
+    merged.latencies_us.insert(merged.latencies_us.end(), result.latencies_us.begin(), result.latencies_us.end());
+    merged.host_allocations += result.host_allocations;
+  }
+  // The caching allocator is process wide so this is only attributed to the calls as a whole
+  merged.device_allocations = device_allocation_count() - device_allocations;
+  return merged;
+}
+
+float percentile(std::vector<float>& sorted, double p) {
+  size_t idx = std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()));
+  return sorted[idx];
+}
+
+double mean_phase_us(const c10::Dict<std::string, int64_t>& metrics, const std::string& phase) {
+  int64_t count = metrics.at(phase + "_count");
+  return count > 0 ? metrics.at(phase + "_total_ns") / 1000.0 / count : 0.0;
+}
+
+void report(const std::string& name, Result& result, const c10::Dict<std::string, int64_t>& metrics) {
+  auto& latencies = result.latencies_us;
+  std::sort(latencies.begin(), latencies.end());
+  double calls = static_cast<double>(latencies.size());
+  std::cout << std::left << std::setw(48) << name << std::right << std::fixed << std::setprecision(2) << std::setw(10)
+            << percentile(latencies, 0.5) << std::setw(10) << percentile(latencies, 0.99) << std::setw(12)
+            << result.host_allocations / calls << std::setw(12) << result.device_allocations / calls << std::setw(10)
+            << mean_phase_us(metrics, "input_setup") << std::setw(10) << mean_phase_us(metrics, "output_allocation")
+            << std::setw(10) << mean_phase_us(metrics, "enqueue") << std::endl;
+}
+
+Options parse_options(int argc, const char* argv[]) {
+  Options opts;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    std::string value = argv[i + 1];
+    if (flag == "--iterations") {
+      opts.iterations = std::stoll(value);
+    } else if (flag == "--warmup") {
+      opts.warmup = std::stoll(value);
+    } else if (flag == "--filter") {
+      opts.filter = value;
+    } else if (flag == "--threads") {
+      opts.threads.clear();
+      std::istringstream iss(value);
+      std::string n;
+      while (std::getline(iss, n, ',')) {
+        opts.threads.push_back(std::stoll(n));
+      }
+    } else {
+      std::cerr << "Unknown option " << flag << std::endl;
+      std::exit(1);
+    }
+  }
+  return opts;
+}
+} // namespace
+
+int main(int argc, const char* argv[]) {
+  auto opts = parse_options(argc, argv);
+  auto in = at::randn({1, 16}, {at::kCUDA});
+
+  std::vector<Mode> modes = {
+      {"plain", [](auto&) {}, [](auto&) {}},
+      {"cudagraphs",
+       [](auto&) { rt::CUDAGRAPHS_MODE = rt::SUBGRAPH_CUDAGRAPHS; },
+       [](auto&) { rt::CUDAGRAPHS_MODE = rt::STANDARD; }},
+      {"pre_allocated_outputs",
+       [](auto& engine) { engine->use_pre_allocated_outputs = true; },
+       [](auto& engine) { engine->use_pre_allocated_outputs = false; }},
+      {"multi_device_safe_mode",
+       [](auto&) { rt::MULTI_DEVICE_SAFE_MODE = true; },
+       [](auto&) { rt::MULTI_DEVICE_SAFE_MODE = false; }},
+  };
+
+  std::cout << std::left << std::setw(48) << "Benchmark" << std::right << std::setw(10) << "p50(us)" << std::setw(10)
+            << "p99(us)" << std::setw(12) << "host_alloc" << std::setw(12) << "dev_alloc" << std::setw(10)
+            << "input" << std::setw(10) << "output" << std::setw(10) << "enqueue" << std::endl;
+  for (auto& mode : modes) {
+    for (auto threads : opts.threads) {
+      std::string name = "BM_execute_engine/" + mode.name + "/threads:" + std::to_string(threads);
+      if (name.find(opts.filter) == std::string::npos) {
+        continue;
+      }
+      // A fresh engine per case so the phase metrics and caches only cover this case
+      auto engine = build_relu_engine(in);
+      engine->set_execution_context_pool_size(threads);
+      mode.setup(engine);
+      auto result = run(engine, in, opts, threads);
+      mode.teardown(engine);
+      report(name, result, engine->get_runtime_metrics());
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,278 @@
+#include "ATen/Context.h"
+#include "c10/cuda/CUDAGuard.h"
+#include "c10/cuda/CUDAStream.h"
+#include "cuda_runtime_api.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/script.h"
+
+#include "core/conversion/conversion.h"
+#include "core/runtime/runtime.h"
+#include "timer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Scaling of the runtime with the number of calling threads and CUDA streams. Every case runs a module, either one
+// engine or a chain of engines run one after another like the segments of a partitioned module, from a number of
+// threads spread over a number of caller streams (threads on the same stream are serialized on the GPU), and reports
+// the throughput, the latency of the calls and the time executions waited for the slot pool (mu and a free execution
+// slot, see TRTEngine::acquire_execution_slot)
+
+namespace {
+namespace rt = torch_tensorrt::core::runtime;
+
+const int64_t kSyncInterval = 64;
+
+struct Options {
+  int64_t iterations = 500; // Calls per thread
+  int64_t warmup = 20;
+  std::vector<int64_t> threads = {1, 2, 4, 8, 16, 32, 64};
+  std::vector<int64_t> streams = {1, 2, 4, 8};
+  int64_t engines = 4; // Engines of the multi engine module
+  int64_t batch = 8;
+  int64_t width = 512;
+  std::string filter = "";
+};
+
+struct Mode {
+  std::string name;
+  std::function<void(rt::TRTEngine&, int64_t threads)> setup;
+  std::function<void(rt::TRTEngine&)> teardown;
+};
+
+struct Topology {
+  std::string name;
+  std::vector<c10::intrusive_ptr<rt::TRTEngine>> engines;
+};
+
+struct Result {
+  std::vector<float> latencies_us;
+  float wall_s = 0;
+  int64_t executions = 0; // Engine executions, one per engine of the module per call
+  int64_t slot_waits = 0;
+  int64_t slot_wait_ns = 0;
+  int64_t slot_wait_max_ns = 0;
+};
+
+// relu(linear(x)) with a width x width weight, a module of these keeps the shape of its input
+c10::intrusive_ptr<rt::TRTEngine> build_linear_engine(const at::Tensor& in, const at::Tensor& w) {
+  auto width = std::to_string(w.size(0));
+  const auto graph = "graph(%0 : Tensor, %1 : Float(" + width + ", " + width + ", strides=[" + width + R"IR(, 1])):
+        %2 : None = prim::Constant()
+        %3 : Tensor = aten::linear(%0, %1, %2)
+        %4 : Tensor = aten::relu(%3)
+        return (%4))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w});
+  std::vector<const torch::jit::Value*> var_ins = {g->inputs()[0]};
+  auto info = torch_tensorrt::core::conversion::ConversionInfo();
+  info.inputs = torch_tensorrt::core::ir::pair_input_vals_with_specs(
+      var_ins, {torch_tensorrt::core::ir::Input(in.sizes().vec())});
+  std::string eng = torch_tensorrt::core::conversion::ConvertBlockToEngine(g->block(), info, params);
+  return c10::make_intrusive<rt::TRTEngine>(
+      "scaling_engine",
+      eng,
+      rt::RTDevice(0, nvinfer1::DeviceType::kGPU),
+      std::vector<std::string>(),
+      std::vector<std::string>());
+}
+
+at::Tensor run_module(const std::vector<c10::intrusive_ptr<rt::TRTEngine>>& engines, at::Tensor x) {
+  for (const auto& engine : engines) {
+    x = rt::execute_engine({x}, engine)[0];
+  }
+  return x;
+}
+
+// Runs fn(t) on threads threads and waits for them
+void on_threads(int64_t threads, const std::function<void(int64_t)>& fn) {
+  std::vector<std::thread> pool;
+  for (int64_t t = 0; t < threads; t++) {
+    pool.emplace_back(fn, t);
+  }
+  for (auto& thread : pool) {
+    thread.join();
+  }
+  cudaDeviceSynchronize();
+}
+
+Result run(Topology& topology, const at::Tensor& in, const Options& opts, int64_t threads, int64_t streams) {
+  std::vector<c10::cuda::CUDAStream> caller_streams;
+  for (int64_t s = 0; s < streams; s++) {
+    caller_streams.push_back(c10::cuda::getStreamFromPool(false, 0));
+  }
+  std::vector<std::vector<float>> latencies(threads);
+  auto calls = [&](int64_t t, int64_t iterations, bool timed) {
+    auto stream = caller_streams[t % streams];
+    c10::cuda::CUDAStreamGuard stream_guard(stream);
+    auto timer = timers::PreciseCPUTimer();
+    if (timed) {
+      latencies[t].reserve(iterations);
+    }
+    for (int64_t i = 0; i < iterations; i++) {
+      timer.start();
+      run_module(topology.engines, in);
+      timer.stop();
+      if (timed) {
+        latencies[t].push_back(timer.microseconds());
+      }
+      timer.reset();
+      // Keeps the queue of the stream bounded, outside of the timed region
+      if ((i + 1) % kSyncInterval == 0) {
+        stream.synchronize();
+      }
+    }
+    stream.synchronize();
+  };
+
+  on_threads(threads, [&](int64_t t) { calls(t, opts.warmup, false); });
+  // The metrics should only cover the timed calls
+  for (auto& engine : topology.engines) {
+    engine->reset_runtime_metrics();
+  }
+
+  Result result;
+  auto wall = timers::PreciseCPUTimer();
+  wall.start();
+  on_threads(threads, [&](int64_t t) { calls(t, opts.iterations, true); });
+  wall.stop();
+  result.wall_s = wall.seconds();
+  for (auto& l : latencies) {
+    result.latencies_us.insert(result.latencies_us.end(), l.begin(), l.end());
+  }
+  for (auto& engine : topology.engines) {
+    auto metrics = engine->get_runtime_metrics();
+    result.executions += metrics.at("execute_count");
+    result.slot_waits += metrics.at("slot_wait_count");
+    result.slot_wait_ns += metrics.at("slot_wait_total_ns");
+    result.slot_wait_max_ns = std::max(result.slot_wait_max_ns, metrics.at("slot_wait_max_ns"));
+  }
+  return result;
+}
+
+float percentile(std::vector<float>& sorted, double p) {
+  size_t idx = std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()));
+  return sorted[idx];
+}
+
+void report(const std::string& name, Result& result) {
+  auto& latencies = result.latencies_us;
+  std::sort(latencies.begin(), latencies.end());
+  double calls = static_cast<double>(latencies.size());
+  double executions = std::max<double>(static_cast<double>(result.executions), 1.0);
+  std::cout << std::left << std::setw(56) << name << std::right << std::fixed << std::setprecision(2) << std::setw(12)
+            << calls / result.wall_s << std::setw(10) << percentile(latencies, 0.5) << std::setw(10)
+            << percentile(latencies, 0.99) << std::setw(10) << percentile(latencies, 0.999) << std::setw(10)
+            << 100.0 * result.slot_waits / executions << std::setw(12) << result.slot_wait_ns / 1000.0 / executions
+            << std::setw(12) << result.slot_wait_max_ns / 1000.0 << std::endl;
+}
+
+std::vector<int64_t> parse_list(const std::string& value) {
+  std::vector<int64_t> list;
+  std::istringstream iss(value);
+  std::string n;
+  while (std::getline(iss, n, ',')) {
+    list.push_back(std::stoll(n));
+  }
+  return list;
+}
+
+Options parse_options(int argc, const char* argv[]) {
+  Options opts;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    std::string value = argv[i + 1];
+    if (flag == "--iterations") {
+      opts.iterations = std::stoll(value);
+    } else if (flag == "--warmup") {
+      opts.warmup = std::stoll(value);
+    } else if (flag == "--engines") {
+      opts.engines = std::stoll(value);
+    } else if (flag == "--batch") {
+      opts.batch = std::stoll(value);
+    } else if (flag == "--width") {
+      opts.width = std::stoll(value);
+    } else if (flag == "--filter") {
+      opts.filter = value;
+    } else if (flag == "--threads") {
+      opts.threads = parse_list(value);
+    } else if (flag == "--streams") {
+      opts.streams = parse_list(value);
+    } else {
+      std::cerr << "Unknown option " << flag << std::endl;
+      std::exit(1);
+    }
+  }
+  return opts;
+}
+} // namespace
+
+int main(int argc, const char* argv[]) {
+  auto opts = parse_options(argc, argv);
+  auto in = at::randn({opts.batch, opts.width}, {at::kCUDA});
+
+  // Engines are built once, the metrics and CUDA graphs of each case are reset before it runs
+  std::vector<Topology> topologies = {{"single_engine", {}}, {"multi_engine", {}}};
+  topologies[0].engines.push_back(build_linear_engine(in, at::randn({opts.width, opts.width}, {at::kCUDA})));
+  for (int64_t e = 0; e < opts.engines; e++) {
+    topologies[1].engines.push_back(build_linear_engine(in, at::randn({opts.width, opts.width}, {at::kCUDA})));
+  }
+
+  // The modes other than context_pool share one execution context between all threads
+  std::vector<Mode> modes = {
+      {"plain", [](auto& engine, int64_t) { engine.set_execution_context_pool_size(1); }, [](auto&) {}},
+      {"cudagraphs",
+       [](auto& engine, int64_t) {
+         engine.set_execution_context_pool_size(1);
+         rt::CUDAGRAPHS_MODE = rt::SUBGRAPH_CUDAGRAPHS;
+       },
+       [](auto& engine) {
+         rt::CUDAGRAPHS_MODE = rt::STANDARD;
+         engine.reset_cudagraph_cache();
+       }},
+      {"pre_allocated_outputs",
+       [](auto& engine, int64_t) {
+         engine.set_execution_context_pool_size(1);
+         engine.use_pre_allocated_outputs = true;
+       },
+       [](auto& engine) { engine.use_pre_allocated_outputs = false; }},
+      {"context_pool",
+       [](auto& engine, int64_t threads) { engine.set_execution_context_pool_size(threads); },
+       [](auto& engine) { engine.set_execution_context_pool_size(1); }},
+  };
+
+  std::cout << std::left << std::setw(56) << "Benchmark" << std::right << std::setw(12) << "calls/s" << std::setw(10)
+            << "p50(us)" << std::setw(10) << "p99(us)" << std::setw(10) << "p99.9(us)" << std::setw(10) << "waits(%)"
+            << std::setw(12) << "wait(us)" << std::setw(12) << "max_wait(us)" << std::endl;
+  for (auto& topology : topologies) {
+    for (auto& mode : modes) {
+      for (auto threads : opts.threads) {
+        for (auto streams : opts.streams) {
+          std::string name = "BM_scaling/" + topology.name + "/" + mode.name + "/threads:" + std::to_string(threads) +
+              "/streams:" + std::to_string(streams);
+          if (name.find(opts.filter) == std::string::npos || streams > threads) {
+            continue;
+          }
+          for (auto& engine : topology.engines) {
+            mode.setup(*engine, threads);
+          }
+          auto result = run(topology, in, opts, threads, streams);
+          for (auto& engine : topology.engines) {
+            mode.teardown(*engine);
+          }
+          report(name, result);
+        }
+      }
+    }
+  }
+  return 0;
+}
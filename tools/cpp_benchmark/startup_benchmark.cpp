@@ -0,0 +1,186 @@
+#include "ATen/Context.h"
+#include "c10/cuda/CUDACachingAllocator.h"
+#include "c10/cuda/CUDAFunctions.h"
+#include "cuda_runtime_api.h"
+#include "torch/script.h"
+
+#include "core/runtime/runtime.h"
+#include "timer.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Breaks the time to first inference of a module compiled with Torch-TensorRT down into the phases of loading it.
+// Engines are loaded with lazy deserialization so unpickling the module and loading its engines are timed apart, the
+// per engine times of decoding, deserializing and creating the execution context come from TRTEngine::load_times
+
+namespace {
+namespace rt = torch_tensorrt::core::runtime;
+
+struct Memory {
+  int64_t host_rss = 0;
+  int64_t device_used = 0; // Whole device as reported by the driver, including other processes
+  int64_t torch_reserved = 0; // Held by PyTorch's caching allocator
+};
+
+struct Phase {
+  std::string name;
+  float ms = 0;
+  c10::optional<Memory> memory; // Unset for phases which run inside another phase
+};
+
+int64_t host_rss_bytes() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind("VmRSS:", 0) == 0) {
+      return std::stoll(line.substr(6)) * 1024;
+    }
+  }
+  return 0;
+}
+
+Memory sample_memory() {
+  cudaDeviceSynchronize();
+  Memory m;
+  m.host_rss = host_rss_bytes();
+  size_t free = 0, total = 0;
+  cudaMemGetInfo(&free, &total);
+  m.device_used = static_cast<int64_t>(total - free);
+  auto stats = c10::cuda::CUDACachingAllocator::getDeviceStats(c10::cuda::current_device());
+  m.torch_reserved = stats.reserved_bytes[static_cast<size_t>(c10::CachingAllocator::StatType::AGGREGATE)].current;
+  return m;
+}
+
+// <dims>[@dtype], e.g. 1x3x224x224@f16
+at::Tensor make_input(const std::string& spec) {
+  auto sep = spec.find('@');
+  std::string dtype = sep == std::string::npos ? "f32" : spec.substr(sep + 1);
+  std::vector<int64_t> dims;
+  std::istringstream ss(spec.substr(0, sep));
+  std::string dim;
+  while (std::getline(ss, dim, 'x')) {
+    dims.push_back(std::stoll(dim));
+  }
+  if (dtype == "f32") {
+    return at::randn(dims, {at::kCUDA});
+  } else if (dtype == "f16") {
+    return at::randn(dims, {at::kCUDA}).to(at::kHalf);
+  } else if (dtype == "i32" || dtype == "i64") {
+    return at::randint(0, 5, dims, {at::kCUDA}).to(dtype == "i32" ? at::kInt : at::kLong);
+  } else if (dtype == "bool") {
+    return at::randint(0, 2, dims, {at::kCUDA}).to(at::kBool);
+  }
+  std::cerr << "Invalid data type " << dtype << ", options are [ f32 | f16 | i32 | i64 | bool ]" << std::endl;
+  std::exit(1);
+}
+
+double mb(int64_t bytes) {
+  return bytes / (1024.0 * 1024.0);
+}
+
+void report(const std::vector<Phase>& phases) {
+  std::cout << std::left << std::setw(28) << "Phase" << std::right << std::setw(12) << "time(ms)" << std::setw(14)
+            << "host_rss(MB)" << std::setw(14) << "gpu_used(MB)" << std::setw(16) << "torch_rsvd(MB)" << std::endl;
+  float total = 0;
+  for (const auto& p : phases) {
+    std::cout << std::left << std::setw(28) << p.name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << p.ms;
+    // Phases without a memory sample are part of the phase above them
+    if (p.memory) {
+      std::cout << std::setw(14) << mb(p.memory->host_rss) << std::setw(14) << mb(p.memory->device_used)
+                << std::setw(16) << mb(p.memory->torch_reserved);
+      total += p.ms;
+    }
+    std::cout << std::endl;
+  }
+  std::cout << std::left << std::setw(28) << "Time to second inference" << std::right << std::setw(12) << total
+            << std::endl;
+}
+} // namespace
+
+int main(int argc, const char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "usage: startup_benchmark <path to compiled module> [input spec, e.g. 1x3x224x224@f16]..."
+              << std::endl;
+    return 1;
+  }
+  std::vector<Phase> phases;
+  auto timer = timers::PreciseCPUTimer();
+  auto end_phase = [&](const std::string& name) {
+    timer.stop();
+    phases.push_back({name, timer.milliseconds(), sample_memory()});
+    timer.reset();
+  };
+  phases.push_back({"process start", 0, sample_memory()});
+
+  timer.start();
+  at::globalContext().lazyInitCUDA();
+  cudaFree(nullptr);
+  end_phase("cuda init");
+
+  // Inputs are made up front so the inference phases only time the module
+  std::vector<torch::jit::IValue> inputs;
+  for (int i = 2; i < argc; i++) {
+    inputs.push_back(make_input(argv[i]));
+  }
+  cudaDeviceSynchronize();
+
+  timer.start();
+  std::ifstream file(argv[1], std::ios::binary);
+  if (!file) {
+    std::cerr << "Unable to open " << argv[1] << std::endl;
+    return 1;
+  }
+  std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  end_phase("file read");
+
+  // The engines are only decoded while unpickling, deserializing them is left to ensure_engine_loaded
+  rt::LAZY_ENGINE_DESERIALIZATION = true;
+  timer.start();
+  std::istringstream stream(bytes);
+  auto mod = torch::jit::load(stream);
+  end_phase("unpickle");
+  bytes.clear();
+  bytes.shrink_to_fit();
+
+  auto engines = rt::collect_engines(mod);
+  timer.start();
+  for (auto& engine : engines) {
+    engine->ensure_engine_loaded();
+  }
+  end_phase("engine load");
+
+  int64_t decode_ns = 0, deserialize_ns = 0, create_context_ns = 0, context_memory = 0;
+  for (auto& engine : engines) {
+    decode_ns += engine->load_times.decode_ns;
+    deserialize_ns += engine->load_times.deserialize_ns;
+    create_context_ns += engine->load_times.create_context_ns;
+    if (engine->cuda_engine) {
+      context_memory += engine->cuda_engine->getDeviceMemorySizeV2();
+    }
+  }
+  // Decoding is part of unpickling
+  phases.insert(phases.end() - 1, {"  engine decode", decode_ns / 1e6f, c10::nullopt});
+  phases.push_back({"  deserializeCudaEngine", deserialize_ns / 1e6f, c10::nullopt});
+  phases.push_back({"  context creation", create_context_ns / 1e6f, c10::nullopt});
+
+  torch::NoGradGuard no_grad;
+  for (auto which : {"first inference", "second inference"}) {
+    timer.start();
+    mod.forward(inputs);
+    cudaDeviceSynchronize();
+    end_phase(which);
+  }
+
+  std::cout << "Module " << argv[1] << ": " << engines.size() << " engines, " << mb(context_memory)
+            << " MB of execution context device memory" << std::endl;
+  report(phases);
+  return 0;
+}
@@ -0,0 +1,548 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ATen/cuda/CUDAEvent.h"
+#include "c10/cuda/CUDAStream.h"
+#include "third_party/args/args.hpp"
+#include "torch/csrc/jit/serialization/pickle.h"
+#include "torch/script.h"
+
+#include "torch_tensorrt/logging.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+namespace torchtrt = torch_tensorrt;
+
+namespace {
+
+// Shape range of one input, min == opt == max for static inputs
+struct InputSpec {
+  std::vector<int64_t> min;
+  std::vector<int64_t> opt;
+  std::vector<int64_t> max;
+  at::ScalarType dtype = at::kFloat;
+};
+
+// Inputs the modules are run with and their label in the report, e.g. "opt"
+struct RunPoint {
+  std::string label;
+  std::vector<torch::jit::IValue> inputs;
+};
+
+struct Latency {
+  std::vector<float> ms; // Sorted
+  double wall_time_s = 0;
+
+  // Nearest rank
+  float percentile(double p) const {
+    auto rank = static_cast<size_t>(std::ceil(p / 100.0 * ms.size()));
+    return ms[std::max<size_t>(rank, 1) - 1];
+  }
+  float mean() const {
+    double total = 0;
+    for (auto l : ms) {
+      total += l;
+    }
+    return static_cast<float>(total / ms.size());
+  }
+  double throughput() const {
+    return ms.size() / wall_time_s;
+  }
+};
+
+struct OutputAccuracy {
+  double max_abs_diff = 0;
+  double max_rel_diff = 0;
+  double cosine_similarity = 1;
+  bool passed = true;
+};
+
+struct RunResult {
+  RunPoint point;
+  c10::optional<Latency> torch_latency;
+  Latency trt_latency;
+  std::vector<OutputAccuracy> accuracy;
+};
+
+at::ScalarType parse_dtype(std::string str) {
+  std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return std::tolower(c); });
+  if (str == "float" || str == "float32" || str == "f32" || str == "fp32") {
+    return at::kFloat;
+  } else if (str == "half" || str == "float16" || str == "f16" || str == "fp16") {
+    return at::kHalf;
+  } else if (str == "char" || str == "int8" || str == "i8") {
+    return at::kChar;
+  } else if (str == "int" || str == "int32" || str == "i32") {
+    return at::kInt;
+  } else if (str == "long" || str == "int64" || str == "i64") {
+    return at::kLong;
+  }
+  TORCH_CHECK(
+      str == "bool" || str == "b", "Invalid data type ", str, ", options are [ f32 | f16 | i8 | i32 | i64 | bool ]");
+  return at::kBool;
+}
+
+std::vector<int64_t> parse_dims(const std::string& str) {
+  std::vector<int64_t> dims;
+  std::istringstream ss(str);
+  std::string dim;
+  while (std::getline(ss, dim, 'x')) {
+    TORCH_CHECK(
+        !dim.empty() && std::all_of(dim.begin(), dim.end(), ::isdigit),
+        "Invalid dimensions ",
+        str,
+        ", expected e.g. 1x3x224x224");
+    dims.push_back(std::stoll(dim));
+  }
+  return dims;
+}
+
+// <dims>[:<dims>:<dims>][@dtype], the shape or the min:opt:max shape range of one input
+InputSpec parse_input_spec(const std::string& str) {
+  InputSpec spec;
+  auto shapes = str.substr(0, str.find('@'));
+  if (str.find('@') != std::string::npos) {
+    spec.dtype = parse_dtype(str.substr(str.find('@') + 1));
+  }
+  std::vector<std::string> ranges;
+  std::istringstream ss(shapes);
+  std::string range;
+  while (std::getline(ss, range, ':')) {
+    ranges.push_back(range);
+  }
+  TORCH_CHECK(
+      ranges.size() == 1 || ranges.size() == 3,
+      "Invalid input spec ",
+      str,
+      ", expected <dims> or <min dims>:<opt dims>:<max dims>");
+  spec.min = parse_dims(ranges[0]);
+  spec.opt = parse_dims(ranges.size() == 3 ? ranges[1] : ranges[0]);
+  spec.max = parse_dims(ranges.size() == 3 ? ranges[2] : ranges[0]);
+  return spec;
+}
+
+// Tensors saved with torch.save are loaded as is, other files are read as raw data of the shape and type of spec
+at::Tensor load_input(const std::string& path, const c10::optional<InputSpec>& spec) {
+  std::ifstream file(path, std::ios::binary);
+  TORCH_CHECK(file, "Unable to open input file ", path);
+  std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  if (path.size() > 3 && (path.substr(path.size() - 3) == ".pt" || path.substr(path.size() - 4) == ".pth")) {
+    auto value = torch::pickle_load(data);
+    TORCH_CHECK(value.isTensor(), "Input file ", path, " does not hold a tensor");
+    return value.toTensor().to(at::kCUDA);
+  }
+  TORCH_CHECK(spec, "Raw input file ", path, " needs an input spec giving its shape and type");
+  auto t = at::empty(spec->opt, at::TensorOptions().dtype(spec->dtype));
+  TORCH_CHECK(
+      data.size() == t.nbytes(),
+      "Input file ",
+      path,
+      " holds ",
+      data.size(),
+      "B, an input of shape ",
+      t.sizes(),
+      " and type ",
+      spec->dtype,
+      " needs ",
+      t.nbytes(),
+      "B");
+  std::memcpy(t.data_ptr(), data.data(), data.size());
+  return t.to(at::kCUDA);
+}
+
+at::Tensor random_input(const std::vector<int64_t>& shape, at::ScalarType dtype) {
+  if (at::isFloatingType(dtype)) {
+    return at::randn(shape, {at::kCUDA}).to(dtype);
+  }
+  return at::randint(0, dtype == at::kBool ? 2 : 5, shape, {at::kCUDA}).to(dtype);
+}
+
+std::string shape_str(const std::vector<torch::jit::IValue>& inputs) {
+  std::stringstream ss;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    ss << (i == 0 ? "" : ", ");
+    auto sizes = inputs[i].toTensor().sizes();
+    for (size_t d = 0; d < sizes.size(); d++) {
+      ss << (d == 0 ? "" : "x") << sizes[d];
+    }
+  }
+  return ss.str();
+}
+
+void collect_tensors(const torch::jit::IValue& value, std::vector<at::Tensor>& tensors) {
+  if (value.isTensor()) {
+    tensors.push_back(value.toTensor());
+  } else if (value.isTuple()) {
+    for (const auto& e : value.toTupleRef().elements()) {
+      collect_tensors(e, tensors);
+    }
+  } else if (value.isList()) {
+    for (const auto& e : value.toListRef()) {
+      collect_tensors(e, tensors);
+    }
+  } else if (value.isGenericDict()) {
+    for (const auto& e : value.toGenericDict()) {
+      collect_tensors(e.value(), tensors);
+    }
+  }
+}
+
+std::vector<torch::jit::IValue> clone_inputs(const std::vector<torch::jit::IValue>& inputs) {
+  std::vector<torch::jit::IValue> clones;
+  for (const auto& in : inputs) {
+    clones.push_back(in.toTensor().clone());
+  }
+  return clones;
+}
+
+// Times forward on the current stream with CUDA events, iters iterations or for duration_s seconds if set
+Latency time_module(
+    torch::jit::Module& mod,
+    const std::vector<torch::jit::IValue>& inputs,
+    int64_t warmup,
+    int64_t iters,
+    double duration_s) {
+  torch::NoGradGuard no_grad;
+  for (int64_t i = 0; i < warmup; i++) {
+    mod.forward(inputs);
+  }
+  auto stream = c10::cuda::getCurrentCUDAStream();
+  stream.synchronize();
+
+  Latency latency;
+  at::cuda::CUDAEvent begin(cudaEventDefault), end(cudaEventDefault);
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                              std::chrono::duration<double>(duration_s));
+  for (int64_t i = 0; duration_s > 0 ? std::chrono::steady_clock::now() < deadline : i < iters; i++) {
+    begin.record(stream);
+    mod.forward(inputs);
+    end.record(stream);
+    end.synchronize();
+    latency.ms.push_back(begin.elapsed_time(end));
+  }
+  latency.wall_time_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::sort(latency.ms.begin(), latency.ms.end());
+  return latency;
+}
+
+std::vector<OutputAccuracy> compare_outputs(
+    const torch::jit::IValue& reference,
+    const torch::jit::IValue& result,
+    double atol,
+    double rtol) {
+  std::vector<at::Tensor> expected, actual;
+  collect_tensors(reference, expected);
+  collect_tensors(result, actual);
+  TORCH_CHECK(
+      expected.size() == actual.size(),
+      "The PyTorch module returns ",
+      expected.size(),
+      " tensors but the TensorRT module returns ",
+      actual.size());
+  std::vector<OutputAccuracy> accuracy;
+  for (size_t i = 0; i < expected.size(); i++) {
+    auto a = expected[i].to(at::kDouble).flatten();
+    auto b = actual[i].to(at::kDouble).reshape_as(expected[i]).flatten();
+    OutputAccuracy acc;
+    if (a.numel() > 0) {
+      auto diff = (a - b).abs();
+      acc.max_abs_diff = diff.max().item<double>();
+      acc.max_rel_diff = (diff / a.abs().clamp_min(1e-12)).max().item<double>();
+      acc.cosine_similarity = at::cosine_similarity(a, b, 0).item<double>();
+      acc.passed = at::allclose(b, a, rtol, atol);
+    }
+    accuracy.push_back(acc);
+  }
+  return accuracy;
+}
+
+void print_latency(std::ostream& os, const std::string& name, const Latency& l) {
+  os << "  " << name << ": mean " << l.mean() << " ms, p50 " << l.percentile(50) << " ms, p90 " << l.percentile(90)
+     << " ms, p99 " << l.percentile(99) << " ms, min " << l.ms.front() << " ms, max " << l.ms.back() << " ms, "
+     << l.throughput() << " iterations/s" << std::endl;
+}
+
+std::string latency_json(const Latency& l) {
+  std::stringstream ss;
+  ss << "{\"iterations\": " << l.ms.size() << ", \"mean\": " << l.mean() << ", \"p50\": " << l.percentile(50)
+     << ", \"p90\": " << l.percentile(90) << ", \"p99\": " << l.percentile(99) << ", \"min\": " << l.ms.front()
+     << ", \"max\": " << l.ms.back() << ", \"iterations_per_s\": " << l.throughput() << "}";
+  return ss.str();
+}
+
+std::string to_json(double compile_time_s, const std::vector<RunResult>& results) {
+  std::stringstream ss;
+  ss << "{\n  \"compile_time_s\": " << compile_time_s << ",\n  \"runs\": [";
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& r = results[i];
+    ss << (i == 0 ? "\n" : ",\n") << "    {\"inputs\": \"" << r.point.label << "\", \"shapes\": \""
+       << shape_str(r.point.inputs) << "\", \"tensorrt_latency_ms\": " << latency_json(r.trt_latency);
+    if (r.torch_latency) {
+      ss << ", \"pytorch_latency_ms\": " << latency_json(*r.torch_latency)
+         << ", \"speedup\": " << r.torch_latency->percentile(50) / r.trt_latency.percentile(50) << ", \"outputs\": [";
+      for (size_t o = 0; o < r.accuracy.size(); o++) {
+        const auto& a = r.accuracy[o];
+        ss << (o == 0 ? "" : ", ") << "{\"max_abs_diff\": " << a.max_abs_diff << ", \"max_rel_diff\": "
+           << a.max_rel_diff << ", \"cosine_similarity\": " << a.cosine_similarity
+           << ", \"passed\": " << (a.passed ? "true" : "false") << "}";
+      }
+      ss << "]";
+    }
+    ss << "}";
+  }
+  ss << "\n  ]\n}\n";
+  return ss.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  torchtrt::logging::set_is_colored_output_on(true);
+  torchtrt::logging::set_reportable_log_level(torchtrt::logging::Level::kWARNING);
+  torchtrt::logging::set_logging_prefix("");
+
+  args::ArgumentParser parser(
+      "torchtrtexec compiles a TorchScript module with Torch-TensorRT, including modules which are only partially supported, and compares the latency and outputs of the compiled module with PyTorch",
+      "");
+  args::HelpFlag help(parser, "help", "Display this help menu", {'h', "help"});
+  args::Flag verbose(parser, "verbose", "Dumps debugging information onto the console", {'v', "verbose"});
+  args::Flag compiled(
+      parser,
+      "compiled",
+      "The module file is already compiled with Torch-TensorRT, it is loaded instead of compiled",
+      {"compiled"});
+  args::ValueFlag<std::string> reference(
+      parser,
+      "path",
+      "TorchScript module a --compiled module is compared with, no PyTorch comparison is run without it",
+      {"reference"});
+  args::ValueFlagList<std::string> precisions(
+      parser,
+      "precision",
+      "(Repeatable) Enabled kernel precision [ f32 | f16 | i8 ] (default: f32)",
+      {'p', "precision"});
+  args::Flag require_full_compilation(
+      parser,
+      "require-full-compilation",
+      "Fail if some operators have to run in PyTorch",
+      {"require-full-compilation"});
+  args::ValueFlag<uint64_t> min_block_size(
+      parser, "num_ops", "Minimum number of operators of a TensorRT segment (default 3)", {"min-block-size"});
+  args::ValueFlagList<std::string> torch_executed_ops(
+      parser, "op", "(Repeatable) Operator to run in PyTorch", {"torch-executed-op"});
+  args::ValueFlag<std::string> timing_cache(
+      parser, "path", "TensorRT timing cache loaded before and updated after building", {"timing-cache"});
+  args::ValueFlag<std::string> save(parser, "path", "Save the compiled module to this file", {"save"});
+  args::ValueFlagList<std::string> load_inputs(
+      parser,
+      "path",
+      "(Repeatable) File holding the next input, a tensor saved with torch.save (.pt) or raw data of the shape and type of the optimal shape of its input spec. The modules only run with these inputs",
+      {"load-inputs"});
+  args::ValueFlag<int64_t> warmup(parser, "iters", "Untimed iterations before timing (default 10)", {"warmup"});
+  args::ValueFlag<int64_t> iterations(parser, "iters", "Timed iterations (default 100)", {"iterations"});
+  args::ValueFlag<double> duration(
+      parser, "seconds", "Run timed iterations for this long instead of a fixed count", {"duration"});
+  args::Flag use_cuda_graph(
+      parser, "use-cuda-graph", "Run the TensorRT engines with CUDA graphs", {"use-cuda-graph"});
+  args::Flag use_pre_allocated_outputs(
+      parser,
+      "use-pre-allocated-outputs",
+      "TensorRT engines reuse the outputs of previous executions",
+      {"use-pre-allocated-outputs"});
+  args::Flag no_pytorch(parser, "no-pytorch", "Only run the TensorRT module", {"no-pytorch"});
+  args::ValueFlag<double> atol(parser, "atol", "Absolute tolerance of the outputs (default 1e-3)", {"atol"});
+  args::ValueFlag<double> rtol(parser, "rtol", "Relative tolerance of the outputs (default 1e-3)", {"rtol"});
+  args::Flag fail_on_mismatch(
+      parser, "fail-on-mismatch", "Exit with an error if an output is outside the tolerances", {"fail-on-mismatch"});
+  args::ValueFlag<int> gpu_id(parser, "gpu_id", "GPU to compile for and run on (default 0)", {"gpu-id"});
+  args::ValueFlag<std::string> json_report(
+      parser, "path", "Also write the results as JSON to this file", {"json-report"});
+  args::Positional<std::string> module_path(
+      parser, "module_file_path", "Path to the TorchScript module", args::Options::Required);
+  args::PositionalList<std::string> input_specs(
+      parser,
+      "input_specs",
+      "Spec of each input, <dims> or <min dims>:<opt dims>:<max dims> optionally followed by @<dtype>, e.g. 1x3x224x224@f16 or 1x3x224x224:8x3x224x224:16x3x224x224. Modules with dynamic inputs are run at the min, opt and max shapes");
+
+  try {
+    parser.ParseCLI(argc, argv);
+  } catch (args::Help const&) {
+    std::cout << parser;
+    return 0;
+  } catch (args::Error const& e) {
+    torchtrt::logging::log(torchtrt::logging::Level::kERROR, e.what());
+    std::cerr << std::endl << parser;
+    return 1;
+  }
+  if (verbose) {
+    torchtrt::logging::set_reportable_log_level(torchtrt::logging::Level::kDEBUG);
+  }
+
+  try {
+    if (gpu_id) {
+      torchtrt::set_device(args::get(gpu_id));
+    }
+
+    std::vector<InputSpec> specs;
+    for (const auto& s : args::get(input_specs)) {
+      specs.push_back(parse_input_spec(s));
+    }
+    std::vector<at::Tensor> file_inputs;
+    auto input_files = args::get(load_inputs);
+    for (size_t i = 0; i < input_files.size(); i++) {
+      file_inputs.push_back(
+          load_input(input_files[i], i < specs.size() ? c10::optional<InputSpec>(specs[i]) : c10::nullopt));
+    }
+    TORCH_CHECK(
+        file_inputs.empty() || specs.empty() || file_inputs.size() == specs.size(),
+        "Got ",
+        file_inputs.size(),
+        " input files for ",
+        specs.size(),
+        " input specs");
+    // The inputs of the files are the specs if none are given
+    if (specs.empty()) {
+      for (auto& t : file_inputs) {
+        specs.push_back({t.sizes().vec(), t.sizes().vec(), t.sizes().vec(), t.scalar_type()});
+      }
+    }
+
+    c10::optional<torch::jit::Module> torch_mod;
+    torch::jit::Module trt_mod;
+    double compile_time_s = 0;
+    if (compiled) {
+      trt_mod = torchtrt::ts::load(args::get(module_path));
+      if (reference) {
+        torch_mod = torch::jit::load(args::get(reference));
+      }
+    } else {
+      TORCH_CHECK(!specs.empty(), "Input specs or input files are needed to compile the module");
+      torch_mod = torch::jit::load(args::get(module_path));
+      torch_mod->to(at::kCUDA);
+      torch_mod->eval();
+
+      std::vector<torchtrt::Input> inputs;
+      for (const auto& s : specs) {
+        inputs.push_back(torchtrt::Input(s.min, s.opt, s.max, torchtrt::DataType(s.dtype)));
+      }
+      auto compile_spec = torchtrt::ts::CompileSpec(inputs);
+      if (gpu_id) {
+        compile_spec.device.gpu_id = args::get(gpu_id);
+      }
+      for (const auto& p : args::get(precisions)) {
+        compile_spec.enabled_precisions.insert(torchtrt::DataType(parse_dtype(p)));
+      }
+      compile_spec.require_full_compilation = require_full_compilation;
+      if (min_block_size) {
+        compile_spec.min_block_size = args::get(min_block_size);
+      }
+      compile_spec.torch_executed_ops = args::get(torch_executed_ops);
+      if (timing_cache) {
+        compile_spec.timing_cache_path = args::get(timing_cache);
+      }
+
+      auto start = std::chrono::steady_clock::now();
+      trt_mod = torchtrt::ts::compile(*torch_mod, compile_spec);
+      compile_time_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      std::cout << "Compiled in " << compile_time_s << " s" << std::endl;
+      if (save) {
+        trt_mod.save(args::get(save));
+      }
+    }
+    if (no_pytorch) {
+      torch_mod = c10::nullopt;
+    }
+    if (torch_mod) {
+      torch_mod->to(at::kCUDA);
+      torch_mod->eval();
+    }
+    torchtrt::ts::set_cudagraphs_enabled(use_cuda_graph);
+    torchtrt::ts::set_pre_allocated_outputs(trt_mod, use_pre_allocated_outputs);
+
+    // The inputs from files, otherwise random inputs at every distinct shape of the ranges
+    std::vector<RunPoint> points;
+    if (!file_inputs.empty()) {
+      points.push_back({"files", std::vector<torch::jit::IValue>(file_inputs.begin(), file_inputs.end())});
+    } else {
+      for (auto which : {"opt", "min", "max"}) {
+        RunPoint point{which, {}};
+        for (const auto& s : specs) {
+          auto& shape = std::string(which) == "min" ? s.min : std::string(which) == "opt" ? s.opt : s.max;
+          point.inputs.push_back(random_input(shape, s.dtype));
+        }
+        bool duplicate = std::any_of(points.begin(), points.end(), [&](const RunPoint& p) {
+          return shape_str(p.inputs) == shape_str(point.inputs);
+        });
+        if (!duplicate) {
+          points.push_back(point);
+        }
+      }
+    }
+
+    int64_t warmup_iters = warmup ? args::get(warmup) : 10;
+    int64_t timed_iters = iterations ? args::get(iterations) : 100;
+    double duration_s = duration ? args::get(duration) : 0;
+    TORCH_CHECK(
+        warmup_iters >= 0 && timed_iters > 0 && duration_s >= 0,
+        "Warmup iterations may not be negative, timed iterations and the duration must be positive");
+    double atol_val = atol ? args::get(atol) : 1e-3;
+    double rtol_val = rtol ? args::get(rtol) : 1e-3;
+
+    std::vector<RunResult> results;
+    bool all_passed = true;
+    std::cout << std::fixed << std::setprecision(3);
+    for (const auto& point : points) {
+      RunResult r;
+      r.point = point;
+      std::cout << "Inputs " << point.label << " [" << shape_str(point.inputs) << "]" << std::endl;
+      r.trt_latency = time_module(trt_mod, point.inputs, warmup_iters, timed_iters, duration_s);
+      print_latency(std::cout, "TensorRT", r.trt_latency);
+      if (torch_mod) {
+        r.torch_latency = time_module(*torch_mod, point.inputs, warmup_iters, timed_iters, duration_s);
+        print_latency(std::cout, "PyTorch", *r.torch_latency);
+        std::cout << "  Speedup (p50): " << r.torch_latency->percentile(50) / r.trt_latency.percentile(50) << "x"
+                  << std::endl;
+
+        torch::NoGradGuard no_grad;
+        auto expected = torch_mod->forward(clone_inputs(point.inputs));
+        auto actual = trt_mod.forward(clone_inputs(point.inputs));
+        r.accuracy = compare_outputs(expected, actual, atol_val, rtol_val);
+        for (size_t o = 0; o < r.accuracy.size(); o++) {
+          const auto& a = r.accuracy[o];
+          std::cout << "  Output " << o << ": max abs diff " << std::scientific << a.max_abs_diff << ", max rel diff "
+                    << a.max_rel_diff << std::fixed << ", cosine similarity " << a.cosine_similarity << ", "
+                    << (a.passed ? "PASSED" : "FAILED") << std::endl;
+          all_passed &= a.passed;
+        }
+      }
+      results.push_back(r);
+    }
+
+    if (json_report) {
+      std::ofstream out(args::get(json_report));
+      out << to_json(compile_time_s, results);
+    }
+    if (!all_passed) {
+      std::stringstream ss;
+      ss << "Outputs of the TensorRT module are outside of the tolerances (atol: " << atol_val << " rtol: " << rtol_val
+         << ")";
+      torchtrt::logging::log(torchtrt::logging::Level::kWARNING, ss.str());
+      if (fail_on_mismatch) {
+        return 1;
+      }
+    }
+  } catch (const c10::Error& e) {
+    torchtrt::logging::log(torchtrt::logging::Level::kERROR, e.what());
+    return 1;
+  }
+  return 0;
+}